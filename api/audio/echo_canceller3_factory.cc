@@ -26,4 +26,12 @@ std::unique_ptr<EchoControl> EchoCanceller3Factory::Create(int sample_rate_hz) {
                                           /*num_capture_channels=*/1);
 }
 
+std::unique_ptr<EchoControl> EchoCanceller3Factory::Create(
+    int sample_rate_hz,
+    int num_render_channels,
+    int num_capture_channels) {
+  return std::make_unique<EchoCanceller3>(
+      config_, sample_rate_hz, num_render_channels, num_capture_channels);
+}
+
 }  // namespace webrtc
@@ -32,6 +32,12 @@ class RTC_EXPORT EchoCanceller3Factory : public EchoControlFactory {
   // mono setup
   std::unique_ptr<EchoControl> Create(int sample_rate_hz) override;
 
+  // Creates an EchoCanceller3 running at the specified sampling rate. The
+  // render signal is analyzed once and shared by all the capture channels.
+  std::unique_ptr<EchoControl> Create(int sample_rate_hz,
+                                      int num_render_channels,
+                                      int num_capture_channels) override;
+
  private:
   const EchoCanceller3Config config_;
 };
@@ -48,6 +48,17 @@ class EchoControl {
 class EchoControlFactory {
  public:
   virtual std::unique_ptr<EchoControl> Create(int sample_rate_hz) = 0;
+
+  // Creates an echo controller for |num_capture_channels| capture channels
+  // that all contain echo of the same |num_render_channels| render signal.
+  // An echo controller that supports several capture channels analyzes the
+  // render signal once for all of them. By default, a mono echo controller is
+  // created.
+  virtual std::unique_ptr<EchoControl> Create(int sample_rate_hz,
+                                              int num_render_channels,
+                                              int num_capture_channels) {
+    return Create(sample_rate_hz);
+  }
   virtual ~EchoControlFactory() = default;
 };
 }  // namespace webrtc
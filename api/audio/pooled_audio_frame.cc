@@ -0,0 +1,223 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/audio/pooled_audio_frame.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr size_t kMinCapacity = 128;
+// Buffers returned beyond this many per size class are freed.
+constexpr size_t kMaxFreeBuffersPerClass = 64;
+
+size_t SizeClass(size_t num_samples) {
+  size_t size_class = 0;
+  while ((kMinCapacity << size_class) < num_samples)
+    ++size_class;
+  return size_class;
+}
+
+const int16_t* ZeroData() {
+  static int16_t* zero_data = new int16_t[AudioFrame::kMaxDataSizeSamples]();
+  return zero_data;
+}
+
+}  // namespace
+
+// static
+rtc::scoped_refptr<AudioFrameBufferPool> AudioFrameBufferPool::Create() {
+  return new rtc::RefCountedObject<AudioFrameBufferPool>();
+}
+
+AudioFrameBufferPool::AudioFrameBufferPool()
+    : free_buffers_(SizeClass(AudioFrame::kMaxDataSizeSamples) + 1) {}
+
+AudioFrameBufferPool::~AudioFrameBufferPool() = default;
+
+std::unique_ptr<int16_t[]> AudioFrameBufferPool::GetBuffer(
+    size_t num_samples,
+    size_t* capacity) {
+  RTC_CHECK_LE(num_samples, AudioFrame::kMaxDataSizeSamples);
+  const size_t size_class = SizeClass(num_samples);
+  *capacity = kMinCapacity << size_class;
+  {
+    rtc::CritScope lock(&crit_);
+    std::vector<std::unique_ptr<int16_t[]>>& buffers =
+        free_buffers_[size_class];
+    if (!buffers.empty()) {
+      std::unique_ptr<int16_t[]> buffer = std::move(buffers.back());
+      buffers.pop_back();
+      return buffer;
+    }
+  }
+  return std::unique_ptr<int16_t[]>(new int16_t[*capacity]);
+}
+
+void AudioFrameBufferPool::ReturnBuffer(std::unique_ptr<int16_t[]> buffer,
+                                        size_t capacity) {
+  if (!buffer)
+    return;
+  const size_t size_class = SizeClass(capacity);
+  RTC_DCHECK_EQ(kMinCapacity << size_class, capacity);
+  rtc::CritScope lock(&crit_);
+  std::vector<std::unique_ptr<int16_t[]>>& buffers = free_buffers_[size_class];
+  if (buffers.size() < kMaxFreeBuffersPerClass)
+    buffers.push_back(std::move(buffer));
+}
+
+size_t AudioFrameBufferPool::num_free_buffers() const {
+  rtc::CritScope lock(&crit_);
+  size_t num_buffers = 0;
+  for (const auto& buffers : free_buffers_)
+    num_buffers += buffers.size();
+  return num_buffers;
+}
+
+PooledAudioFrame::PooledAudioFrame(
+    rtc::scoped_refptr<AudioFrameBufferPool> pool)
+    : pool_(std::move(pool)) {
+  RTC_DCHECK(pool_);
+}
+
+PooledAudioFrame::~PooledAudioFrame() {
+  Mute();
+}
+
+PooledAudioFrame::PooledAudioFrame(PooledAudioFrame&& other)
+    : timestamp_(other.timestamp_),
+      elapsed_time_ms_(other.elapsed_time_ms_),
+      ntp_time_ms_(other.ntp_time_ms_),
+      speech_type_(other.speech_type_),
+      vad_activity_(other.vad_activity_),
+      packet_infos_(std::move(other.packet_infos_)),
+      pool_(other.pool_),
+      buffer_(std::move(other.buffer_)),
+      capacity_(other.capacity_),
+      samples_per_channel_(other.samples_per_channel_),
+      sample_rate_hz_(other.sample_rate_hz_),
+      num_channels_(other.num_channels_) {
+  other.capacity_ = 0;
+}
+
+PooledAudioFrame& PooledAudioFrame::operator=(PooledAudioFrame&& other) {
+  if (this == &other)
+    return *this;
+  Mute();
+  timestamp_ = other.timestamp_;
+  elapsed_time_ms_ = other.elapsed_time_ms_;
+  ntp_time_ms_ = other.ntp_time_ms_;
+  speech_type_ = other.speech_type_;
+  vad_activity_ = other.vad_activity_;
+  packet_infos_ = std::move(other.packet_infos_);
+  pool_ = other.pool_;
+  buffer_ = std::move(other.buffer_);
+  capacity_ = other.capacity_;
+  other.capacity_ = 0;
+  samples_per_channel_ = other.samples_per_channel_;
+  sample_rate_hz_ = other.sample_rate_hz_;
+  num_channels_ = other.num_channels_;
+  return *this;
+}
+
+void PooledAudioFrame::UpdateFrame(uint32_t timestamp,
+                                   const int16_t* data,
+                                   size_t samples_per_channel,
+                                   int sample_rate_hz,
+                                   AudioFrame::SpeechType speech_type,
+                                   AudioFrame::VADActivity vad_activity,
+                                   size_t num_channels) {
+  timestamp_ = timestamp;
+  speech_type_ = speech_type;
+  vad_activity_ = vad_activity;
+  SetFormat(samples_per_channel, sample_rate_hz, num_channels);
+  if (data != nullptr) {
+    EnsureCapacity();
+    memcpy(buffer_.get(), data,
+           sizeof(int16_t) * samples_per_channel_ * num_channels_);
+  } else {
+    Mute();
+  }
+}
+
+void PooledAudioFrame::CopyFrom(const AudioFrame& src) {
+  UpdateFrame(src.timestamp_, src.muted() ? nullptr : src.data(),
+              src.samples_per_channel(), src.sample_rate_hz(),
+              src.speech_type_, src.vad_activity_, src.num_channels());
+  elapsed_time_ms_ = src.elapsed_time_ms_;
+  ntp_time_ms_ = src.ntp_time_ms_;
+  packet_infos_ = src.packet_infos_;
+}
+
+void PooledAudioFrame::CopyFrom(const PooledAudioFrame& src) {
+  if (this == &src)
+    return;
+  UpdateFrame(src.timestamp_, src.muted() ? nullptr : src.buffer_.get(),
+              src.samples_per_channel_, src.sample_rate_hz_, src.speech_type_,
+              src.vad_activity_, src.num_channels_);
+  elapsed_time_ms_ = src.elapsed_time_ms_;
+  ntp_time_ms_ = src.ntp_time_ms_;
+  packet_infos_ = src.packet_infos_;
+}
+
+void PooledAudioFrame::CopyTo(AudioFrame* dst) const {
+  RTC_DCHECK(dst);
+  dst->UpdateFrame(timestamp_, muted() ? nullptr : buffer_.get(),
+                   samples_per_channel_, sample_rate_hz_, speech_type_,
+                   vad_activity_, num_channels_);
+  dst->elapsed_time_ms_ = elapsed_time_ms_;
+  dst->ntp_time_ms_ = ntp_time_ms_;
+  dst->packet_infos_ = packet_infos_;
+}
+
+InterleavedAudioView PooledAudioFrame::view() const {
+  return InterleavedAudioView(muted() ? ZeroData() : buffer_.get(),
+                              samples_per_channel_, num_channels_);
+}
+
+int16_t* PooledAudioFrame::mutable_data() {
+  if (muted()) {
+    EnsureCapacity();
+    memset(buffer_.get(), 0, sizeof(int16_t) * capacity_);
+  }
+  return buffer_.get();
+}
+
+void PooledAudioFrame::Mute() {
+  pool_->ReturnBuffer(std::move(buffer_), capacity_);
+  capacity_ = 0;
+}
+
+void PooledAudioFrame::SetFormat(size_t samples_per_channel,
+                                 int sample_rate_hz,
+                                 size_t num_channels) {
+  RTC_CHECK_LE(samples_per_channel * num_channels,
+               AudioFrame::kMaxDataSizeSamples);
+  samples_per_channel_ = samples_per_channel;
+  sample_rate_hz_ = sample_rate_hz;
+  num_channels_ = num_channels;
+}
+
+void PooledAudioFrame::EnsureCapacity() {
+  const size_t num_samples = samples_per_channel_ * num_channels_;
+  if (buffer_ && capacity_ >= num_samples)
+    return;
+  Mute();
+  buffer_ = pool_->GetBuffer(num_samples, &capacity_);
+}
+
+}  // namespace webrtc
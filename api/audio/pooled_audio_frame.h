@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_AUDIO_POOLED_AUDIO_FRAME_H_
+#define API_AUDIO_POOLED_AUDIO_FRAME_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "api/rtp_packet_infos.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Read-only view of interleaved 16-bit samples, for passing the content of an
+// AudioFrame or a PooledAudioFrame without copying it. The view does not own
+// the samples, which must outlive it.
+class InterleavedAudioView {
+ public:
+  InterleavedAudioView() = default;
+  InterleavedAudioView(const int16_t* data,
+                       size_t samples_per_channel,
+                       size_t num_channels)
+      : data_(data),
+        samples_per_channel_(samples_per_channel),
+        num_channels_(num_channels) {}
+  explicit InterleavedAudioView(const AudioFrame& frame)
+      : InterleavedAudioView(frame.data(),
+                             frame.samples_per_channel(),
+                             frame.num_channels()) {}
+
+  const int16_t* data() const { return data_; }
+  size_t samples_per_channel() const { return samples_per_channel_; }
+  size_t num_channels() const { return num_channels_; }
+  size_t size() const { return samples_per_channel_ * num_channels_; }
+  bool empty() const { return size() == 0; }
+
+ private:
+  const int16_t* data_ = nullptr;
+  size_t samples_per_channel_ = 0;
+  size_t num_channels_ = 0;
+};
+
+// Thread-safe pool of sample buffers. Buffer capacities are powers of two, so
+// that a 10 ms frame at 48 kHz mono takes 1 KB instead of the 15 KB of an
+// AudioFrame, and buffers of a given format are recycled across frames and
+// streams instead of being allocated every 10 ms.
+class AudioFrameBufferPool : public rtc::RefCountInterface {
+ public:
+  static rtc::scoped_refptr<AudioFrameBufferPool> Create();
+
+  // Returns a buffer of at least |num_samples| samples, which must not be
+  // larger than AudioFrame::kMaxDataSizeSamples. |*capacity| is set to the
+  // actual size of the buffer, to be passed back to ReturnBuffer().
+  std::unique_ptr<int16_t[]> GetBuffer(size_t num_samples, size_t* capacity);
+  void ReturnBuffer(std::unique_ptr<int16_t[]> buffer, size_t capacity);
+
+  // Number of buffers currently waiting in the pool.
+  size_t num_free_buffers() const;
+
+ protected:
+  AudioFrameBufferPool();
+  ~AudioFrameBufferPool() override;
+
+ private:
+  rtc::CriticalSection crit_;
+  // Free buffers per size class, the capacity of class i being
+  // kMinCapacity << i.
+  std::vector<std::vector<std::unique_ptr<int16_t[]>>> free_buffers_
+      RTC_GUARDED_BY(crit_);
+};
+
+// Counterpart of AudioFrame whose samples are held in a buffer from an
+// AudioFrameBufferPool that is sized for the current format. Muted frames
+// hold no buffer at all. Existing AudioFrame based interfaces are served with
+// CopyFrom() and CopyTo(), and view() gives zero-copy access to the samples.
+class PooledAudioFrame {
+ public:
+  explicit PooledAudioFrame(rtc::scoped_refptr<AudioFrameBufferPool> pool);
+  ~PooledAudioFrame();
+
+  PooledAudioFrame(PooledAudioFrame&& other);
+  PooledAudioFrame& operator=(PooledAudioFrame&& other);
+
+  // Same as the AudioFrame counterparts.
+  void UpdateFrame(uint32_t timestamp,
+                   const int16_t* data,
+                   size_t samples_per_channel,
+                   int sample_rate_hz,
+                   AudioFrame::SpeechType speech_type,
+                   AudioFrame::VADActivity vad_activity,
+                   size_t num_channels = 1);
+  void CopyFrom(const AudioFrame& src);
+  void CopyFrom(const PooledAudioFrame& src);
+
+  // Compatibility with AudioFrame based interfaces.
+  void CopyTo(AudioFrame* dst) const;
+
+  // Zeros when muted.
+  InterleavedAudioView view() const;
+  // Sized for samples_per_channel() * num_channels(), and zeroed if the frame
+  // was muted.
+  int16_t* mutable_data();
+
+  // Gives the buffer back to the pool.
+  void Mute();
+  bool muted() const { return !buffer_; }
+
+  size_t samples_per_channel() const { return samples_per_channel_; }
+  size_t num_channels() const { return num_channels_; }
+  int sample_rate_hz() const { return sample_rate_hz_; }
+  size_t capacity() const { return capacity_; }
+
+  uint32_t timestamp_ = 0;
+  int64_t elapsed_time_ms_ = -1;
+  int64_t ntp_time_ms_ = -1;
+  AudioFrame::SpeechType speech_type_ = AudioFrame::kUndefined;
+  AudioFrame::VADActivity vad_activity_ = AudioFrame::kVadUnknown;
+  RtpPacketInfos packet_infos_;
+
+ private:
+  void SetFormat(size_t samples_per_channel,
+                 int sample_rate_hz,
+                 size_t num_channels);
+  // Makes sure that the buffer holds the current format, without zeroing it.
+  void EnsureCapacity();
+
+  rtc::scoped_refptr<AudioFrameBufferPool> pool_;
+  std::unique_ptr<int16_t[]> buffer_;
+  size_t capacity_ = 0;
+  size_t samples_per_channel_ = 0;
+  int sample_rate_hz_ = 0;
+  size_t num_channels_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PooledAudioFrame);
+};
+
+}  // namespace webrtc
+
+#endif  // API_AUDIO_POOLED_AUDIO_FRAME_H_
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/audio/pooled_audio_frame.h"
+
+#include <stdint.h>
+#include <string.h>  // memcmp
+
+#include <utility>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr uint32_t kTimestamp = 27;
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumChannelsStereo = 2;
+constexpr size_t kSamplesPerChannel = kSampleRateHz / 100;
+
+}  // namespace
+
+TEST(PooledAudioFrameTest, FrameStartsMutedWithoutBuffer) {
+  PooledAudioFrame frame(AudioFrameBufferPool::Create());
+  EXPECT_TRUE(frame.muted());
+  EXPECT_EQ(0u, frame.capacity());
+}
+
+TEST(PooledAudioFrameTest, BufferIsSizedForTheFormat) {
+  PooledAudioFrame frame(AudioFrameBufferPool::Create());
+  int16_t samples[kSamplesPerChannel] = {17};
+  frame.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kNormalSpeech, AudioFrame::kVadActive);
+  EXPECT_FALSE(frame.muted());
+  EXPECT_EQ(512u, frame.capacity());
+  EXPECT_EQ(17, frame.view().data()[0]);
+  EXPECT_EQ(kSamplesPerChannel, frame.view().size());
+}
+
+TEST(PooledAudioFrameTest, MutedFrameViewIsZeroed) {
+  PooledAudioFrame frame(AudioFrameBufferPool::Create());
+  frame.UpdateFrame(kTimestamp, nullptr, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kNormalSpeech, AudioFrame::kVadPassive,
+                    kNumChannelsStereo);
+  const InterleavedAudioView view = frame.view();
+  ASSERT_EQ(kSamplesPerChannel * kNumChannelsStereo, view.size());
+  for (size_t i = 0; i < view.size(); ++i)
+    EXPECT_EQ(0, view.data()[i]);
+}
+
+TEST(PooledAudioFrameTest, MutedBuffersAreReused) {
+  rtc::scoped_refptr<AudioFrameBufferPool> pool =
+      AudioFrameBufferPool::Create();
+  PooledAudioFrame frame(pool);
+  frame.UpdateFrame(kTimestamp, nullptr, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kNormalSpeech, AudioFrame::kVadActive);
+  const int16_t* buffer = frame.mutable_data();
+  frame.Mute();
+  EXPECT_EQ(1u, pool->num_free_buffers());
+
+  PooledAudioFrame other_frame(pool);
+  other_frame.UpdateFrame(kTimestamp, nullptr, kSamplesPerChannel,
+                          kSampleRateHz, AudioFrame::kNormalSpeech,
+                          AudioFrame::kVadActive);
+  EXPECT_EQ(buffer, other_frame.mutable_data());
+  EXPECT_EQ(0u, pool->num_free_buffers());
+}
+
+TEST(PooledAudioFrameTest, ConvertsToAndFromAudioFrame) {
+  AudioFrame frame;
+  int16_t samples[kSamplesPerChannel * kNumChannelsStereo] = {1, 2, 3};
+  frame.UpdateFrame(kTimestamp, samples, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kPLC, AudioFrame::kVadActive,
+                    kNumChannelsStereo);
+  frame.ntp_time_ms_ = 1234;
+
+  PooledAudioFrame pooled_frame(AudioFrameBufferPool::Create());
+  pooled_frame.CopyFrom(frame);
+  EXPECT_EQ(kTimestamp, pooled_frame.timestamp_);
+  EXPECT_EQ(1234, pooled_frame.ntp_time_ms_);
+  EXPECT_EQ(AudioFrame::kPLC, pooled_frame.speech_type_);
+  EXPECT_EQ(kNumChannelsStereo, pooled_frame.num_channels());
+
+  AudioFrame copy;
+  pooled_frame.CopyTo(&copy);
+  EXPECT_EQ(kTimestamp, copy.timestamp_);
+  EXPECT_EQ(1234, copy.ntp_time_ms_);
+  EXPECT_EQ(kSampleRateHz, copy.sample_rate_hz());
+  EXPECT_EQ(0, memcmp(samples, copy.data(), sizeof(samples)));
+}
+
+TEST(PooledAudioFrameTest, MoveKeepsTheBuffer) {
+  PooledAudioFrame frame(AudioFrameBufferPool::Create());
+  frame.UpdateFrame(kTimestamp, nullptr, kSamplesPerChannel, kSampleRateHz,
+                    AudioFrame::kNormalSpeech, AudioFrame::kVadActive);
+  const int16_t* buffer = frame.mutable_data();
+  PooledAudioFrame moved(std::move(frame));
+  EXPECT_EQ(buffer, moved.view().data());
+  EXPECT_FALSE(moved.muted());
+}
+
+}  // namespace webrtc
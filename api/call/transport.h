@@ -35,6 +35,11 @@ struct PacketOptions {
   bool is_retransmit = false;
   bool included_in_feedback = false;
   bool included_in_allocation = false;
+  // Whether this packet may be held back by the socket and sent together with
+  // the following packets of the same burst, see rtc::PacketOptions.
+  bool batchable = false;
+  // Whether this packet ends a burst, any batched packets should be flushed.
+  bool last_packet_in_batch = false;
 };
 
 class Transport {
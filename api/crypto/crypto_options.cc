@@ -58,6 +58,9 @@ bool CryptoOptions::operator==(const CryptoOptions& other) const {
     struct SFrame {
       bool require_frame_encryption;
     } sframe;
+    struct Dtls {
+      bool enable_session_resumption;
+    } dtls;
   };
   static_assert(sizeof(data_being_tested_for_equality) == sizeof(*this),
                 "Did you add something to CryptoOptions and forget to "
@@ -69,7 +72,9 @@ bool CryptoOptions::operator==(const CryptoOptions& other) const {
          srtp.enable_encrypted_rtp_header_extensions ==
              other.srtp.enable_encrypted_rtp_header_extensions &&
          sframe.require_frame_encryption ==
-             other.sframe.require_frame_encryption;
+             other.sframe.require_frame_encryption &&
+         dtls.enable_session_resumption ==
+             other.dtls.enable_session_resumption;
 }
 
 bool CryptoOptions::operator!=(const CryptoOptions& other) const {
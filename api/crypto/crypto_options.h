@@ -59,6 +59,14 @@ struct CryptoOptions {
     // FrameDecryptor attached to them before they are able to receive packets.
     bool require_frame_encryption = false;
   } sframe;
+
+  // DTLS Related Peer Connection options.
+  struct Dtls {
+    // If set to true, DTLS sessions are cached and resumed when reconnecting
+    // to a peer with the same certificates, which saves a round trip and the
+    // key exchange. It will only be used if both peers enable it.
+    bool enable_session_resumption = false;
+  } dtls;
 };
 
 }  // namespace webrtc
@@ -40,4 +40,13 @@ bool DataChannelInterface::negotiated() const {
   return false;
 }
 
+bool DataChannelInterface::SendMultiple(
+    const std::vector<DataBuffer>& buffers) {
+  for (const DataBuffer& buffer : buffers) {
+    if (!Send(buffer))
+      return false;
+  }
+  return true;
+}
+
 }  // namespace webrtc
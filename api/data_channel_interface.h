@@ -18,6 +18,7 @@
 #include <stdint.h>
 
 #include <string>
+#include <vector>
 
 #include "absl/types/optional.h"
 #include "rtc_base/checks.h"
@@ -177,6 +178,12 @@ class DataChannelInterface : public rtc::RefCountInterface {
   // buffer.
   virtual bool Send(const DataBuffer& buffer) = 0;
 
+  // Sends |buffers| in order, with the same semantics as calling Send for
+  // each of them, but hands them to the transport together. Cheaper than many
+  // Send calls when sending many small messages at once. Returns false if the
+  // channel isn't open.
+  virtual bool SendMultiple(const std::vector<DataBuffer>& buffers);
+
  protected:
   ~DataChannelInterface() override = default;
 };
@@ -49,7 +49,11 @@ class JsepSessionDescription : public SessionDescriptionInterface {
                   const std::string& session_id,
                   const std::string& session_version);
 
+  // Changes made through the returned pointer are only guaranteed to be
+  // serialized by ToString() if they are made before the next ToString() call.
   virtual cricket::SessionDescription* description() {
+    // The caller may change any m= section.
+    serialized_sections_.clear();
     return description_.get();
   }
   virtual const cricket::SessionDescription* description() const {
@@ -77,10 +81,15 @@ class JsepSessionDescription : public SessionDescriptionInterface {
   std::string session_version_;
   SdpType type_;
   std::vector<JsepCandidateCollection> candidate_collection_;
+  // The text of each m= section as of the last ToString(), or an empty string
+  // if the section changed since. Lets ToString() re-serialize only the
+  // sections whose candidates changed, as candidates trickle in.
+  mutable std::vector<std::string> serialized_sections_;
 
   bool GetMediasectionIndex(const IceCandidateInterface* candidate,
                             size_t* index);
   int GetMediasectionIndex(const cricket::Candidate& candidate);
+  void InvalidateSerializedSection(size_t index);
 
   RTC_DISALLOW_COPY_AND_ASSIGN(JsepSessionDescription);
 };
@@ -0,0 +1,45 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_MEMORY_USAGE_REPORT_H_
+#define API_MEMORY_USAGE_REPORT_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace webrtc {
+
+// Approximate breakdown of the memory held by the media streams of one
+// PeerConnection, together with the caps that bound each component. The byte
+// counts are estimates of the buffered payloads and bookkeeping; they do not
+// include allocator overhead or memory shared between PeerConnections, such as
+// the audio processing module and the codec factories.
+struct MemoryUsageReport {
+  // Packets stored for retransmission by the audio and video senders.
+  uint64_t audio_rtp_packet_history_bytes = 0;
+  uint64_t video_rtp_packet_history_bytes = 0;
+  // Sum over all senders of the maximum number of stored packets.
+  uint64_t rtp_packet_history_max_packets = 0;
+
+  // Packets waiting for decoding in the NetEq packet buffers of the audio
+  // receivers.
+  uint64_t audio_jitter_buffer_bytes = 0;
+  // Sum over all audio receivers of the maximum number of buffered packets.
+  uint64_t audio_jitter_buffer_max_packets = 0;
+
+  uint64_t total_bytes() const {
+    return audio_rtp_packet_history_bytes + video_rtp_packet_history_bytes +
+           audio_jitter_buffer_bytes;
+  }
+};
+
+}  // namespace webrtc
+
+#endif  // API_MEMORY_USAGE_REPORT_H_
@@ -70,6 +70,7 @@
 #include <stdio.h>
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -85,6 +86,7 @@
 #include "api/fec_controller.h"
 #include "api/jsep.h"
 #include "api/media_stream_interface.h"
+#include "api/memory_usage_report.h"
 #include "api/network_state_predictor.h"
 #include "api/packet_socket_factory.h"
 #include "api/rtc_error.h"
@@ -913,10 +915,22 @@ class RTC_EXPORT PeerConnectionInterface : public rtc::RefCountInterface {
   virtual void GetStats(
       rtc::scoped_refptr<RtpReceiverInterface> selector,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) = 0;
+  // Spec-compliant getStats() that only reports the stats objects whose type
+  // is in |stats_types|, e.g. {"candidate-pair"}. Only the stats needed for
+  // these types are gathered, which makes it cheap to poll a few stats often.
+  // Default implementation for the sake of existing implementations of this
+  // interface; it never invokes |callback|.
+  virtual void GetStats(
+      const std::set<std::string>& stats_types,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {}
   // Clear cached stats in the RTCStatsCollector.
   // Exposed for testing while waiting for automatic cache clear to work.
   // https://bugs.webrtc.org/8693
   virtual void ClearStatsCache() {}
+  // Returns an approximate breakdown of the memory held by the media streams
+  // of this PeerConnection, see MemoryUsageReport. Blocks on the worker
+  // thread.
+  virtual MemoryUsageReport GetMemoryUsageReport() { return {}; }
 
   // Create a data channel with the provided config, or default config if none
   // is provided. Note that an offer/answer negotiation is still necessary
@@ -1345,6 +1359,12 @@ class PeerConnectionFactoryInterface : public rtc::RefCountInterface {
 
     // Sets crypto related options, e.g. enabled cipher suites.
     CryptoOptions crypto_options = CryptoOptions::NoGcm();
+
+    // If non-zero, the factory generates this many default certificates ahead
+    // of time, and hands them to PeerConnections created without a
+    // certificate or |cert_generator|, so that their first offer or answer
+    // doesn't wait for key generation.
+    int certificate_pool_size = 0;
   };
 
   // Set the options to be used for subsequently created PeerConnections.
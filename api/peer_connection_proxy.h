@@ -12,6 +12,7 @@
 #define API_PEER_CONNECTION_PROXY_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -72,7 +73,12 @@ PROXY_METHOD2(void,
               GetStats,
               rtc::scoped_refptr<RtpReceiverInterface>,
               rtc::scoped_refptr<RTCStatsCollectorCallback>)
+PROXY_METHOD2(void,
+              GetStats,
+              const std::set<std::string>&,
+              rtc::scoped_refptr<RTCStatsCollectorCallback>)
 PROXY_METHOD0(void, ClearStatsCache)
+PROXY_METHOD0(MemoryUsageReport, GetMemoryUsageReport)
 PROXY_METHOD2(rtc::scoped_refptr<DataChannelInterface>,
               CreateDataChannel,
               const std::string&,
@@ -13,6 +13,8 @@
 
 #include <cstdint>
 
+#include "rtc_base/memory/small_object_pool.h"
+
 namespace webrtc {
 
 // This class allows us to store unencoded RTC events. Subclasses of this class
@@ -21,7 +23,10 @@ namespace webrtc {
 // Additionally, it prevents dependency leaking - a module that only logs
 // events of type RtcEvent_A doesn't need to know about anything associated
 // with events of type RtcEvent_B.
-class RtcEvent {
+// Events are allocated on the threads that log them and freed on the event
+// log's task queue once encoded, at up to a few per packet. They come from
+// rtc::SmallObjectPool so that the blocks are reused.
+class RtcEvent : public rtc::SmallObject {
  public:
   // Subclasses of this class have to associate themselves with a unique value
   // of Type. This leaks the information of existing subclasses into the
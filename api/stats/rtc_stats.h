@@ -78,6 +78,10 @@ class RTC_EXPORT RTCStats {
   // Creates a JSON readable string representation of the stats
   // object, listing all of its members (names and values).
   std::string ToJson() const;
+  // Like |ToJson|, but only lists the members whose values differ from those
+  // of |previous|, which must be of the same type. Members that are no longer
+  // defined are listed as null. Returns an empty string if no member changed.
+  std::string ToJsonDelta(const RTCStats& previous) const;
 
   // Downcasts the stats object to an |RTCStats| subclass |T|. DCHECKs that the
   // object is of type |T|.
@@ -106,6 +106,12 @@ class RTC_EXPORT RTCStatsReport : public rtc::RefCountInterface {
   // Creates a JSON readable string representation of the report,
   // listing all of its stats objects.
   std::string ToJson() const;
+  // Creates a JSON readable string of the changes since |previous|, for
+  // polling at a high rate: {"timestamp":..,"changed":[..],"removed":[..]}.
+  // "changed" lists the stats objects that are new, in full, and those with
+  // members that changed, with |RTCStats::ToJsonDelta|. "removed" lists the
+  // IDs of the stats objects of |previous| that are not in this report.
+  std::string ToJsonDelta(const RTCStatsReport& previous) const;
 
   friend class rtc::RefCountedObject<RTCStatsReport>;
 
@@ -0,0 +1,430 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/task_queue/thread_pool_task_queue_factory.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+namespace {
+
+// Number of tasks a worker runs from one task queue before moving on to the
+// next runnable task queue, so that a busy task queue can't starve others.
+constexpr int kMaxTasksPerSlice = 16;
+
+class ThreadPool;
+
+class PooledTaskQueue final : public TaskQueueBase {
+ public:
+  explicit PooledTaskQueue(ThreadPool* pool);
+
+  void Delete() override;
+  void PostTask(std::unique_ptr<QueuedTask> task) override;
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override;
+
+  // The task queue is referenced by its owner until Delete() and by the
+  // thread pool while it is runnable or has delayed tasks pending.
+  void AddRef() { ref_count_.IncRef(); }
+  void Release();
+
+  // Runs pending tasks on the calling worker thread. Returns true if tasks
+  // are still pending and the task queue should be run again.
+  bool RunSlice();
+
+ private:
+  ~PooledTaskQueue() override = default;
+
+  ThreadPool* const pool_;
+  webrtc_impl::RefCounter ref_count_{1};
+
+  // Signaled when the task that was running when Delete() was called is done.
+  rtc::Event stopped_;
+
+  rtc::CriticalSection lock_;
+  std::queue<std::unique_ptr<QueuedTask>> pending_ RTC_GUARDED_BY(lock_);
+  // True while the task queue is in a worker's run queue or being run, which
+  // guarantees that at most one worker runs its tasks at a time.
+  bool scheduled_ RTC_GUARDED_BY(lock_) = false;
+  bool running_ RTC_GUARDED_BY(lock_) = false;
+  bool deleted_ RTC_GUARDED_BY(lock_) = false;
+};
+
+class ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+  ~ThreadPool();
+
+  // Makes |queue| runnable. Must only be called when |queue| is not already
+  // runnable.
+  void Schedule(PooledTaskQueue* queue);
+  void ScheduleDelayed(PooledTaskQueue* queue,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds);
+
+ private:
+  using OrderId = uint64_t;
+
+  struct DelayedEntryTimeout {
+    int64_t next_fire_at_ms_{};
+    OrderId order_{};
+
+    bool operator<(const DelayedEntryTimeout& o) const {
+      return std::tie(next_fire_at_ms_, order_) <
+             std::tie(o.next_fire_at_ms_, o.order_);
+    }
+  };
+
+  struct Worker {
+    Worker(ThreadPool* pool, size_t index);
+
+    ThreadPool* const pool;
+    const size_t index;
+    rtc::CriticalSection lock;
+    // Runnable task queues. The owning worker takes them from the front and
+    // other workers steal them from the back.
+    std::deque<PooledTaskQueue*> runnable RTC_GUARDED_BY(lock);
+    std::atomic<bool> idle{false};
+    rtc::Event wake;
+    rtc::PlatformThread thread;
+  };
+
+  static void WorkerMain(void* context);
+  void RunWorker(Worker* worker);
+  PooledTaskQueue* NextRunnable(Worker* worker);
+  void Enqueue(Worker* worker, PooledTaskQueue* queue, bool from_worker);
+
+  static void TimerMain(void* context);
+  void RunTimer();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<size_t> next_worker_{0};
+  std::atomic<bool> quit_{false};
+
+  rtc::CriticalSection delayed_lock_;
+  OrderId next_order_ RTC_GUARDED_BY(delayed_lock_) = 0;
+  std::map<DelayedEntryTimeout,
+           std::pair<PooledTaskQueue*, std::unique_ptr<QueuedTask>>>
+      delayed_queue_ RTC_GUARDED_BY(delayed_lock_);
+  rtc::Event timer_wake_;
+  rtc::PlatformThread timer_thread_;
+};
+
+PooledTaskQueue::PooledTaskQueue(ThreadPool* pool) : pool_(pool) {}
+
+void PooledTaskQueue::Release() {
+  if (ref_count_.DecRef() == rtc::RefCountReleaseStatus::kDroppedLastRef)
+    delete this;
+}
+
+void PooledTaskQueue::Delete() {
+  RTC_DCHECK(!IsCurrent());
+
+  std::queue<std::unique_ptr<QueuedTask>> pending;
+  bool task_running;
+  {
+    rtc::CritScope lock(&lock_);
+    deleted_ = true;
+    pending_.swap(pending);
+    task_running = running_;
+  }
+
+  if (task_running)
+    stopped_.Wait(rtc::Event::kForever);
+  Release();
+}
+
+void PooledTaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
+  {
+    rtc::CritScope lock(&lock_);
+    if (deleted_)
+      return;
+    pending_.push(std::move(task));
+    if (scheduled_)
+      return;
+    scheduled_ = true;
+  }
+
+  pool_->Schedule(this);
+}
+
+void PooledTaskQueue::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                      uint32_t milliseconds) {
+  if (milliseconds == 0) {
+    PostTask(std::move(task));
+    return;
+  }
+  pool_->ScheduleDelayed(this, std::move(task), milliseconds);
+}
+
+bool PooledTaskQueue::RunSlice() {
+  CurrentTaskQueueSetter set_current(this);
+
+  for (int i = 0; i < kMaxTasksPerSlice; ++i) {
+    std::unique_ptr<QueuedTask> task;
+    {
+      rtc::CritScope lock(&lock_);
+      if (deleted_ || pending_.empty()) {
+        scheduled_ = false;
+        return false;
+      }
+      task = std::move(pending_.front());
+      pending_.pop();
+      running_ = true;
+    }
+
+    QueuedTask* release_ptr = task.release();
+    if (release_ptr->Run())
+      delete release_ptr;
+
+    rtc::CritScope lock(&lock_);
+    running_ = false;
+    if (deleted_) {
+      scheduled_ = false;
+      stopped_.Set();
+      return false;
+    }
+  }
+
+  rtc::CritScope lock(&lock_);
+  if (deleted_ || pending_.empty()) {
+    scheduled_ = false;
+    return false;
+  }
+  return true;
+}
+
+ThreadPool::Worker::Worker(ThreadPool* pool, size_t index)
+    : pool(pool),
+      index(index),
+      thread(&ThreadPool::WorkerMain, this, "TaskQueuePool") {}
+
+ThreadPool::ThreadPool(int num_threads)
+    : timer_thread_(&ThreadPool::TimerMain, this, "TaskQueuePoolTimer") {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i)
+    workers_.push_back(std::make_unique<Worker>(this, i));
+  for (auto& worker : workers_)
+    worker->thread.Start();
+  timer_thread_.Start();
+}
+
+ThreadPool::~ThreadPool() {
+  quit_.store(true);
+  timer_wake_.Set();
+  timer_thread_.Stop();
+  for (auto& worker : workers_)
+    worker->wake.Set();
+  for (auto& worker : workers_)
+    worker->thread.Stop();
+
+  // Only task queues that have been deleted but not yet been visited by a
+  // worker or the timer may be left.
+  {
+    rtc::CritScope lock(&delayed_lock_);
+    for (auto& entry : delayed_queue_)
+      entry.second.first->Release();
+    delayed_queue_.clear();
+  }
+  for (auto& worker : workers_) {
+    rtc::CritScope lock(&worker->lock);
+    for (PooledTaskQueue* queue : worker->runnable)
+      queue->Release();
+  }
+}
+
+void ThreadPool::Schedule(PooledTaskQueue* queue) {
+  queue->AddRef();
+  size_t index = next_worker_.fetch_add(1) % workers_.size();
+  Enqueue(workers_[index].get(), queue, /*from_worker=*/false);
+}
+
+void ThreadPool::ScheduleDelayed(PooledTaskQueue* queue,
+                                 std::unique_ptr<QueuedTask> task,
+                                 uint32_t milliseconds) {
+  DelayedEntryTimeout delay;
+  delay.next_fire_at_ms_ = rtc::TimeMillis() + milliseconds;
+
+  queue->AddRef();
+  {
+    rtc::CritScope lock(&delayed_lock_);
+    delay.order_ = next_order_++;
+    delayed_queue_[delay] = std::make_pair(queue, std::move(task));
+  }
+  timer_wake_.Set();
+}
+
+void ThreadPool::Enqueue(Worker* worker,
+                         PooledTaskQueue* queue,
+                         bool from_worker) {
+  size_t runnable;
+  {
+    rtc::CritScope lock(&worker->lock);
+    worker->runnable.push_back(queue);
+    runnable = worker->runnable.size();
+  }
+
+  if (worker->idle.load()) {
+    worker->wake.Set();
+    return;
+  }
+  // A worker re-enqueueing its own task queue picks it up again right away,
+  // unless other task queues are waiting on it. In all other cases the worker
+  // may be busy for a while, so let an idle worker steal the task queue.
+  if (from_worker && runnable == 1)
+    return;
+  for (auto& other : workers_) {
+    if (other->idle.load()) {
+      other->wake.Set();
+      return;
+    }
+  }
+}
+
+PooledTaskQueue* ThreadPool::NextRunnable(Worker* worker) {
+  {
+    rtc::CritScope lock(&worker->lock);
+    if (!worker->runnable.empty()) {
+      PooledTaskQueue* queue = worker->runnable.front();
+      worker->runnable.pop_front();
+      return queue;
+    }
+  }
+
+  for (size_t i = 1; i < workers_.size(); ++i) {
+    Worker* victim = workers_[(worker->index + i) % workers_.size()].get();
+    rtc::CritScope lock(&victim->lock);
+    if (!victim->runnable.empty()) {
+      PooledTaskQueue* queue = victim->runnable.back();
+      victim->runnable.pop_back();
+      return queue;
+    }
+  }
+  return nullptr;
+}
+
+// static
+void ThreadPool::WorkerMain(void* context) {
+  Worker* worker = static_cast<Worker*>(context);
+  worker->pool->RunWorker(worker);
+}
+
+void ThreadPool::RunWorker(Worker* worker) {
+  while (!quit_.load()) {
+    PooledTaskQueue* queue = NextRunnable(worker);
+    if (!queue) {
+      // Publish that this worker is idle before looking for work one last
+      // time. A concurrent Enqueue() either makes its task queue visible to
+      // that search or sees the flag and wakes a worker up.
+      worker->idle.store(true);
+      queue = NextRunnable(worker);
+      if (!queue) {
+        worker->wake.Wait(rtc::Event::kForever, rtc::Event::kForever);
+        worker->idle.store(false);
+        continue;
+      }
+      worker->idle.store(false);
+    }
+
+    if (queue->RunSlice()) {
+      Enqueue(worker, queue, /*from_worker=*/true);
+    } else {
+      queue->Release();
+    }
+  }
+}
+
+// static
+void ThreadPool::TimerMain(void* context) {
+  static_cast<ThreadPool*>(context)->RunTimer();
+}
+
+void ThreadPool::RunTimer() {
+  while (!quit_.load()) {
+    std::vector<std::pair<PooledTaskQueue*, std::unique_ptr<QueuedTask>>>
+        ready;
+    int wait_ms = rtc::Event::kForever;
+    {
+      rtc::CritScope lock(&delayed_lock_);
+      int64_t now_ms = rtc::TimeMillis();
+      while (!delayed_queue_.empty()) {
+        auto it = delayed_queue_.begin();
+        if (it->first.next_fire_at_ms_ > now_ms) {
+          wait_ms =
+              rtc::dchecked_cast<int>(it->first.next_fire_at_ms_ - now_ms);
+          break;
+        }
+        ready.push_back(std::move(it->second));
+        delayed_queue_.erase(it);
+      }
+    }
+
+    // Posting to a deleted task queue destroys the task.
+    for (auto& entry : ready) {
+      entry.first->PostTask(std::move(entry.second));
+      entry.first->Release();
+    }
+    if (ready.empty())
+      timer_wake_.Wait(wait_ms, rtc::Event::kForever);
+  }
+}
+
+class ThreadPoolTaskQueueFactory final : public TaskQueueFactory {
+ public:
+  explicit ThreadPoolTaskQueueFactory(int num_threads)
+      : pool_(std::make_unique<ThreadPool>(num_threads)) {}
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+        new PooledTaskQueue(pool_.get()));
+  }
+
+ private:
+  const std::unique_ptr<ThreadPool> pool_;
+};
+
+}  // namespace
+
+std::unique_ptr<TaskQueueFactory> CreateThreadPoolTaskQueueFactory(
+    int num_threads) {
+  return std::make_unique<ThreadPoolTaskQueueFactory>(num_threads);
+}
+
+std::unique_ptr<TaskQueueFactory> CreateThreadPoolTaskQueueFactory() {
+  return CreateThreadPoolTaskQueueFactory(
+      rtc::dchecked_cast<int>(CpuInfo::DetectNumberOfCores()));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,35 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef API_TASK_QUEUE_THREAD_POOL_TASK_QUEUE_FACTORY_H_
+#define API_TASK_QUEUE_THREAD_POOL_TASK_QUEUE_FACTORY_H_
+
+#include <memory>
+
+#include "api/task_queue/task_queue_factory.h"
+
+namespace webrtc {
+
+// Creates a factory whose task queues don't own a thread. Each task queue is
+// a sequence of tasks that is multiplexed onto a pool of |num_threads| worker
+// threads shared by all task queues created by the factory, and idle workers
+// steal runnable task queues from busy ones. Tasks posted to one task queue
+// still run in FIFO order, never overlap, and see that task queue as
+// TaskQueueBase::Current().
+// Task queue priorities are ignored. The factory must outlive all the task
+// queues it created.
+std::unique_ptr<TaskQueueFactory> CreateThreadPoolTaskQueueFactory(
+    int num_threads);
+
+// Same as above, with one worker thread per CPU core.
+std::unique_ptr<TaskQueueFactory> CreateThreadPoolTaskQueueFactory();
+
+}  // namespace webrtc
+
+#endif  // API_TASK_QUEUE_THREAD_POOL_TASK_QUEUE_FACTORY_H_
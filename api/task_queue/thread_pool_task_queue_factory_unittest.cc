@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/task_queue/thread_pool_task_queue_factory.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_test.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+std::unique_ptr<TaskQueueFactory> CreatePerCoreFactory() {
+  return CreateThreadPoolTaskQueueFactory();
+}
+
+std::unique_ptr<TaskQueueFactory> CreateSingleThreadFactory() {
+  return CreateThreadPoolTaskQueueFactory(1);
+}
+
+INSTANTIATE_TEST_SUITE_P(ThreadPool,
+                         TaskQueueTest,
+                         ::testing::Values(CreatePerCoreFactory,
+                                           CreateSingleThreadFactory));
+
+// Posts |kTasksPerQueue| tasks to each of |kNumQueues| task queues from the
+// test thread and measures the time until all of them have run.
+int64_t FanOutTimeUs(TaskQueueFactory* factory) {
+  static constexpr int kNumQueues = 500;
+  static constexpr int kTasksPerQueue = 200;
+
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> queues;
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues.push_back(factory->CreateTaskQueue(
+        "FanOut", TaskQueueFactory::Priority::NORMAL));
+  }
+
+  webrtc_impl::RefCounter remaining(kNumQueues * kTasksPerQueue);
+  rtc::Event done;
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kTasksPerQueue; ++i) {
+    for (auto& queue : queues) {
+      queue->PostTask(ToQueuedTask([&remaining, &done] {
+        if (remaining.DecRef() == rtc::RefCountReleaseStatus::kDroppedLastRef)
+          done.Set();
+      }));
+    }
+  }
+  EXPECT_TRUE(done.Wait(60000));
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  queues.clear();
+  return elapsed_us;
+}
+
+TEST(ThreadPoolTaskQueueFactoryTest, DISABLED_FanOutPerf) {
+  std::unique_ptr<TaskQueueFactory> default_factory =
+      CreateDefaultTaskQueueFactory();
+  std::unique_ptr<TaskQueueFactory> pool_factory =
+      CreateThreadPoolTaskQueueFactory();
+
+  int64_t default_us = FanOutTimeUs(default_factory.get());
+  int64_t pool_us = FanOutTimeUs(pool_factory.get());
+  RTC_LOG(LS_INFO) << "Fan-out to 500 task queues: default factory "
+                   << default_us << " us, thread pool factory " << pool_us
+                   << " us.";
+}
+
+}  // namespace
+}  // namespace webrtc
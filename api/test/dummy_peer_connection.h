@@ -12,6 +12,7 @@
 #define API_TEST_DUMMY_PEER_CONNECTION_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -112,6 +113,11 @@ class DummyPeerConnection : public PeerConnectionInterface {
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override {
     FATAL() << "Not implemented";
   }
+  void GetStats(
+      const std::set<std::string>& stats_types,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override {
+    FATAL() << "Not implemented";
+  }
   void ClearStatsCache() override {}
 
   rtc::scoped_refptr<DataChannelInterface> CreateDataChannel(
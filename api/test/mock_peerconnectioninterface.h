@@ -12,6 +12,7 @@
 #define API_TEST_MOCK_PEERCONNECTIONINTERFACE_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -77,6 +78,9 @@ class MockPeerConnectionInterface
   MOCK_METHOD2(GetStats,
                void(rtc::scoped_refptr<RtpReceiverInterface>,
                     rtc::scoped_refptr<RTCStatsCollectorCallback>));
+  MOCK_METHOD2(GetStats,
+               void(const std::set<std::string>&,
+                    rtc::scoped_refptr<RTCStatsCollectorCallback>));
   MOCK_METHOD0(ClearStatsCache, void());
   MOCK_CONST_METHOD0(GetSctpTransport,
                      rtc::scoped_refptr<SctpTransportInterface>());
@@ -103,6 +103,10 @@ class VideoCodecTestFixture {
     // Force the encoder and decoder to use a single core for processing.
     bool use_single_core = false;
 
+    // Number of cores the encoder and decoder may use, if not zero. Takes
+    // precedence over |use_single_core|.
+    size_t num_cores = 0;
+
     // Should cpu usage be measured?
     // If set to true, the encoding will run in real-time.
     bool measure_cpu = false;
@@ -110,6 +114,12 @@ class VideoCodecTestFixture {
     // Simulate frames arriving in real-time by adding delays between frames.
     bool encode_in_real_time = false;
 
+    // Should the maximum throughput be measured? If set to true, frames are
+    // processed as fast as possible, the quality analysis is skipped, and the
+    // number of frames encoded and decoded per second of wall-clock time is
+    // reported as a perf result.
+    bool measure_throughput = false;
+
     // Codec settings to use.
     webrtc::VideoCodec codec_settings;
 
@@ -111,6 +111,8 @@ struct SentPacket {
   int64_t sequence_number;
   // Tracked data in flight when the packet was sent, excluding unacked data.
   DataSize data_in_flight = DataSize::Zero();
+  // True if the packet carried padding rather than new media.
+  bool is_padding = false;
 };
 
 struct ReceivedPacket {
@@ -170,6 +172,12 @@ struct TransportPacketsFeedback {
   // Arrival times for messages without send time information.
   std::vector<Timestamp> sendless_arrival_times;
 
+  // Number of ECN capable packets, and of those the number marked as
+  // congestion experienced, that the receiver reported since the previous
+  // feedback. Both are zero if the receiver doesn't report ECN.
+  int64_t ecn_capable_packets = 0;
+  int64_t ecn_ce_packets = 0;
+
   std::vector<PacketResult> ReceivedWithSendInfo() const;
   std::vector<PacketResult> LostWithSendInfo() const;
   std::vector<PacketResult> PacketsWithFeedback() const;
@@ -197,6 +205,9 @@ struct PacerConfig {
   TimeDelta time_window = TimeDelta::PlusInfinity();
   // Pacer should send at least pad_window data over time_window duration.
   DataSize pad_window = DataSize::Zero();
+  // If set, the pacer sends bursts of up to send_quantum data at a time and
+  // carries unused budget over, rather than pacing in fixed intervals.
+  DataSize send_quantum = DataSize::Zero();
   DataRate data_rate() const { return data_window / time_window; }
   DataRate pad_rate() const { return pad_window / time_window; }
 };
@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/nv12_buffer.h"
+
+#include "api/video/i420_buffer.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+// Fills |buffer| with a color per quadrant, so that cropping and scaling can
+// be checked.
+void FillQuadrants(NV12Buffer* buffer) {
+  for (int y = 0; y < buffer->height(); ++y) {
+    for (int x = 0; x < buffer->width(); ++x) {
+      buffer->MutableDataY()[y * buffer->StrideY() + x] =
+          (x < buffer->width() / 2 ? 10 : 20) +
+          (y < buffer->height() / 2 ? 0 : 100);
+    }
+  }
+  for (int y = 0; y < buffer->ChromaHeight(); ++y) {
+    for (int x = 0; x < buffer->ChromaWidth(); ++x) {
+      uint8_t* uv = buffer->MutableDataUV() + y * buffer->StrideUV() + 2 * x;
+      uv[0] = x < buffer->ChromaWidth() / 2 ? 30 : 40;
+      uv[1] = y < buffer->ChromaHeight() / 2 ? 50 : 60;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(NV12BufferTest, InitialData) {
+  rtc::scoped_refptr<NV12Buffer> buffer = NV12Buffer::Create(7, 5);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, buffer->type());
+  EXPECT_EQ(7, buffer->width());
+  EXPECT_EQ(5, buffer->height());
+  EXPECT_EQ(4, buffer->ChromaWidth());
+  EXPECT_EQ(3, buffer->ChromaHeight());
+  EXPECT_EQ(7, buffer->StrideY());
+  EXPECT_EQ(8, buffer->StrideUV());
+  EXPECT_EQ(buffer.get(), buffer->GetNV12());
+}
+
+TEST(NV12BufferTest, ConvertsToAndFromI420) {
+  rtc::scoped_refptr<I420Buffer> i420 = I420Buffer::Create(6, 4);
+  for (int y = 0; y < i420->height(); ++y) {
+    for (int x = 0; x < i420->width(); ++x)
+      i420->MutableDataY()[y * i420->StrideY() + x] = x + 10 * y;
+  }
+  for (int y = 0; y < i420->ChromaHeight(); ++y) {
+    for (int x = 0; x < i420->ChromaWidth(); ++x) {
+      i420->MutableDataU()[y * i420->StrideU() + x] = 100 + x + 10 * y;
+      i420->MutableDataV()[y * i420->StrideV() + x] = 200 + x + 10 * y;
+    }
+  }
+
+  rtc::scoped_refptr<NV12Buffer> nv12 = NV12Buffer::Copy(*i420);
+  EXPECT_EQ(101, nv12->DataUV()[2]);
+  EXPECT_EQ(201, nv12->DataUV()[3]);
+  rtc::scoped_refptr<I420BufferInterface> converted = nv12->ToI420();
+  EXPECT_EQ(6, converted->width());
+  EXPECT_EQ(4, converted->height());
+  for (int y = 0; y < i420->height(); ++y) {
+    for (int x = 0; x < i420->width(); ++x) {
+      EXPECT_EQ(i420->DataY()[y * i420->StrideY() + x],
+                converted->DataY()[y * converted->StrideY() + x]);
+    }
+  }
+  for (int y = 0; y < i420->ChromaHeight(); ++y) {
+    for (int x = 0; x < i420->ChromaWidth(); ++x) {
+      EXPECT_EQ(i420->DataU()[y * i420->StrideU() + x],
+                converted->DataU()[y * converted->StrideU() + x]);
+      EXPECT_EQ(i420->DataV()[y * i420->StrideV() + x],
+                converted->DataV()[y * converted->StrideV() + x]);
+    }
+  }
+}
+
+TEST(NV12BufferTest, Crops) {
+  rtc::scoped_refptr<NV12Buffer> source = NV12Buffer::Create(16, 8);
+  FillQuadrants(source.get());
+
+  // The bottom right quadrant.
+  rtc::scoped_refptr<NV12Buffer> cropped = NV12Buffer::Create(8, 4);
+  cropped->CropAndScaleFrom(*source, 8, 4, 8, 4);
+  for (int y = 0; y < cropped->height(); ++y) {
+    for (int x = 0; x < cropped->width(); ++x)
+      EXPECT_EQ(120, cropped->DataY()[y * cropped->StrideY() + x]);
+  }
+  for (int y = 0; y < cropped->ChromaHeight(); ++y) {
+    for (int x = 0; x < cropped->ChromaWidth(); ++x) {
+      EXPECT_EQ(40, cropped->DataUV()[y * cropped->StrideUV() + 2 * x]);
+      EXPECT_EQ(60, cropped->DataUV()[y * cropped->StrideUV() + 2 * x + 1]);
+    }
+  }
+}
+
+TEST(NV12BufferTest, Scales) {
+  rtc::scoped_refptr<NV12Buffer> source = NV12Buffer::Create(16, 8);
+  FillQuadrants(source.get());
+
+  rtc::scoped_refptr<NV12Buffer> scaled = NV12Buffer::Create(8, 4);
+  scaled->ScaleFrom(*source);
+  // Each quadrant keeps its color.
+  EXPECT_EQ(10, scaled->DataY()[0]);
+  EXPECT_EQ(20, scaled->DataY()[7]);
+  EXPECT_EQ(110, scaled->DataY()[3 * scaled->StrideY()]);
+  EXPECT_EQ(120, scaled->DataY()[3 * scaled->StrideY() + 7]);
+  const uint8_t* last_uv_row = scaled->DataUV() + scaled->StrideUV();
+  EXPECT_EQ(30, scaled->DataUV()[0]);
+  EXPECT_EQ(50, scaled->DataUV()[1]);
+  EXPECT_EQ(40, last_uv_row[6]);
+  EXPECT_EQ(60, last_uv_row[7]);
+}
+
+}  // namespace webrtc
@@ -11,6 +11,8 @@
 #ifndef API_VIDEO_VIDEO_SINK_INTERFACE_H_
 #define API_VIDEO_VIDEO_SINK_INTERFACE_H_
 
+#include <stdint.h>
+
 #include "rtc_base/checks.h"
 
 namespace rtc {
@@ -25,6 +27,12 @@ class VideoSinkInterface {
   // Should be called by the source when it discards the frame due to rate
   // limiting.
   virtual void OnDiscardedFrame() {}
+
+  // May be called by the source before it converts or scales a frame with
+  // capture time |time_us|, so that frames the sink would drop anyway are not
+  // processed at all. Returning false means that the sink has accounted for
+  // the frame as dropped, and the source must not pass it to OnFrame().
+  virtual bool WantsFrame(int64_t time_us) { return true; }
 };
 
 }  // namespace rtc
@@ -37,7 +37,9 @@ bool VideoCodecVP9::operator==(const VideoCodecVP9& other) const {
           adaptiveQpMode == other.adaptiveQpMode &&
           automaticResizeOn == other.automaticResizeOn &&
           numberOfSpatialLayers == other.numberOfSpatialLayers &&
-          flexibleMode == other.flexibleMode);
+          flexibleMode == other.flexibleMode &&
+          numberOfTileColumns == other.numberOfTileColumns &&
+          rowMultithreadedDecoding == other.rowMultithreadedDecoding);
 }
 
 bool VideoCodecH264::operator==(const VideoCodecH264& other) const {
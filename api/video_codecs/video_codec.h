@@ -70,6 +70,13 @@ struct VideoCodecVP9 {
   unsigned char numberOfSpatialLayers;
   bool flexibleMode;
   InterLayerPredMode interLayerPred;
+  // Number of tile columns the encoder splits frames into, which lets both
+  // the encoder and the decoder work on them in parallel. Rounded down to a
+  // power of two, and capped by libvpx to columns at least 256 pixels wide.
+  // 0 picks it from the number of encoder threads.
+  unsigned char numberOfTileColumns;
+  // Lets the decoder also spread the rows of each tile over its threads.
+  bool rowMultithreadedDecoding;
 };
 
 // H264 specific.
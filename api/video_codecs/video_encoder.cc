@@ -43,6 +43,8 @@ VideoCodecVP9 VideoEncoder::GetDefaultVp9Settings() {
   vp9_settings.numberOfSpatialLayers = 1;
   vp9_settings.flexibleMode = false;
   vp9_settings.interLayerPred = InterLayerPredMode::kOn;
+  vp9_settings.numberOfTileColumns = 0;
+  vp9_settings.rowMultithreadedDecoding = true;
 
   return vp9_settings;
 }
@@ -84,10 +86,12 @@ constexpr uint8_t VideoEncoder::EncoderInfo::kMaxFramerateFraction;
 VideoEncoder::EncoderInfo::EncoderInfo()
     : scaling_settings(VideoEncoder::ScalingSettings::kOff),
       supports_native_handle(false),
+      supports_nv12_input(false),
       implementation_name("unknown"),
       has_trusted_rate_controller(false),
       is_hardware_accelerated(true),
       has_internal_source(false),
+      max_frames_in_flight(0),
       fps_allocation{absl::InlinedVector<uint8_t, kMaxTemporalStreams>(
           1,
           kMaxFramerateFraction)} {}
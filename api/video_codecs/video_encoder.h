@@ -161,6 +161,11 @@ class RTC_EXPORT VideoEncoder {
     // handle for hw codecs) rather than requiring a raw I420 buffer.
     bool supports_native_handle;
 
+    // If true, encoder accepts NV12 buffers (VideoFrameBuffer::Type::kNV12)
+    // as they are, e.g. because it's what hardware encoders take. Otherwise
+    // they are converted to I420 before being passed to the encoder.
+    bool supports_nv12_input;
+
     // The name of this particular encoder implementation, e.g. "libvpx".
     std::string implementation_name;
 
@@ -188,6 +193,14 @@ class RTC_EXPORT VideoEncoder {
     // phased out.
     bool has_internal_source;
 
+    // If greater than zero, Encode() may return before the frame is encoded,
+    // and the encoder can have up to this many frames in flight, delivering
+    // them later through the EncodedImageCallback. This is typical for
+    // hardware encoders. While that many frames are in flight, new input
+    // frames are dropped rather than queued behind them. Zero means that the
+    // number of frames in flight is not limited.
+    int max_frames_in_flight;
+
     // For each spatial layer (simulcast stream or SVC layer), represented as an
     // element in |fps_allocation| a vector indicates how many temporal layers
     // the encoder is using for that spatial layer.
@@ -228,6 +228,8 @@ webrtc::AudioReceiveStream::Stats AudioReceiveStream::GetStats() const {
   stats.accelerate_rate = Q14ToFloat(ns.currentAccelerateRate);
   stats.preemptive_expand_rate = Q14ToFloat(ns.currentPreemptiveRate);
   stats.jitter_buffer_flushes = ns.packetBufferFlushes;
+  stats.jitter_buffer_bytes = ns.packetBufferBytes;
+  stats.jitter_buffer_max_packets = config_.jitter_buffer_max_packets;
   stats.delayed_packet_outage_samples = ns.delayedPacketOutageSamples;
   stats.relative_packet_arrival_delay_seconds =
       static_cast<double>(ns.relativePacketArrivalDelayMs) /
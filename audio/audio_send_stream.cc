@@ -80,6 +80,16 @@ void UpdateEventLogStreamConfig(RtcEventLog* event_log,
       std::move(rtclog_config)));
 }
 
+TaskQueueFactory* EncoderTaskQueueFactory(
+    const rtc::scoped_refptr<webrtc::AudioState>& audio_state,
+    TaskQueueFactory* task_queue_factory) {
+  TaskQueueFactory* encoder_task_queue_factory =
+      static_cast<internal::AudioState*>(audio_state.get())
+          ->encoder_task_queue_factory();
+  return encoder_task_queue_factory ? encoder_task_queue_factory
+                                    : task_queue_factory;
+}
+
 }  // namespace
 
 AudioSendStream::AudioSendStream(
@@ -102,19 +112,21 @@ AudioSendStream::AudioSendStream(
                       event_log,
                       rtcp_rtt_stats,
                       suspended_rtp_state,
-                      voe::CreateChannelSend(clock,
-                                             task_queue_factory,
-                                             module_process_thread,
-                                             config.media_transport_config,
-                                             /*overhead_observer=*/this,
-                                             config.send_transport,
-                                             rtcp_rtt_stats,
-                                             event_log,
-                                             config.frame_encryptor,
-                                             config.crypto_options,
-                                             config.rtp.extmap_allow_mixed,
-                                             config.rtcp_report_interval_ms,
-                                             config.rtp.ssrc)) {}
+                      voe::CreateChannelSend(
+                          clock,
+                          EncoderTaskQueueFactory(audio_state,
+                                                  task_queue_factory),
+                          module_process_thread,
+                          config.media_transport_config,
+                          /*overhead_observer=*/this,
+                          config.send_transport,
+                          rtcp_rtt_stats,
+                          event_log,
+                          config.frame_encryptor,
+                          config.crypto_options,
+                          config.rtp.extmap_allow_mixed,
+                          config.rtcp_report_interval_ms,
+                          config.rtp.ssrc)) {}
 
 AudioSendStream::AudioSendStream(
     Clock* clock,
@@ -428,6 +440,9 @@ webrtc::AudioSendStream::Stats AudioSendStream::GetStats(
   stats.retransmitted_bytes_sent = call_stats.retransmitted_bytes_sent;
   stats.packets_sent = call_stats.packetsSent;
   stats.retransmitted_packets_sent = call_stats.retransmitted_packets_sent;
+  stats.rtp_packet_history_bytes = call_stats.packet_history.stored_bytes;
+  stats.rtp_packet_history_max_packets =
+      call_stats.packet_history.max_packets;
   // RTT isn't known until a RTCP report is received. Until then, VoiceEngine
   // returns 0 to indicate an error value.
   if (call_stats.rttMs > 0) {
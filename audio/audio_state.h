@@ -48,6 +48,10 @@ class AudioState : public webrtc::AudioState {
     return config_.audio_device_module.get();
   }
 
+  TaskQueueFactory* encoder_task_queue_factory() const {
+    return config_.encoder_task_queue_factory;
+  }
+
   bool typing_noise_detected() const;
 
   void AddReceivingStream(webrtc::AudioReceiveStream* stream);
@@ -326,6 +326,13 @@ class TransportFeedbackProxy : public TransportFeedbackObserver {
       feedback_observer_->OnTransportFeedback(feedback);
   }
 
+  void OnEcnFeedback(const rtcp::EcnFeedback& feedback) override {
+    RTC_DCHECK(network_thread_.IsCurrent());
+    rtc::CritScope lock(&crit_);
+    if (feedback_observer_)
+      feedback_observer_->OnEcnFeedback(feedback);
+  }
+
  private:
   rtc::CriticalSection crit_;
   rtc::ThreadChecker thread_checker_;
@@ -1036,6 +1043,7 @@ CallSendStatistics ChannelSend::GetRTCPStatistics() const {
       rtp_stats.transmitted.packets + rtx_stats.transmitted.packets;
   stats.retransmitted_packets_sent = rtp_stats.retransmitted.packets;
   stats.report_block_datas = _rtpRtcpModule->GetLatestReportBlockData();
+  stats.packet_history = _rtpRtcpModule->GetPacketHistoryStats();
 
   return stats;
 }
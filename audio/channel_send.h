@@ -47,6 +47,8 @@ struct CallSendStatistics {
   // ReportBlockData represents the latest Report Block that was received for
   // that pair.
   std::vector<ReportBlockData> report_block_datas;
+  // Memory used by the packets stored for retransmission.
+  RtpPacketHistoryStats packet_history;
 };
 
 // See section 6.4.2 in http://www.ietf.org/rfc/rfc3550.txt for details.
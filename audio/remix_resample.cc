@@ -42,11 +42,6 @@ void RemixAndResample(const int16_t* src_data,
 
   // Downmix before resampling.
   if (num_channels > dst_frame->num_channels_) {
-    RTC_DCHECK(num_channels == 2 || num_channels == 4)
-        << "num_channels: " << num_channels;
-    RTC_DCHECK(dst_frame->num_channels_ == 1 || dst_frame->num_channels_ == 2)
-        << "dst_frame->num_channels_: " << dst_frame->num_channels_;
-
     AudioFrameOperations::DownmixChannels(
         src_data, num_channels, samples_per_channel, dst_frame->num_channels_,
         downmixed_audio);
@@ -77,11 +72,12 @@ void RemixAndResample(const int16_t* src_data,
   dst_frame->samples_per_channel_ = out_length / audio_ptr_num_channels;
 
   // Upmix after resampling.
-  if (num_channels == 1 && dst_frame->num_channels_ == 2) {
-    // The audio in dst_frame really is mono at this point; MonoToStereo will
-    // set this back to stereo.
+  if (num_channels == 1 && dst_frame->num_channels_ > 1) {
+    // The audio in dst_frame really is mono at this point; UpmixChannels will
+    // set the channel count back.
+    const size_t dst_num_channels = dst_frame->num_channels_;
     dst_frame->num_channels_ = 1;
-    AudioFrameOperations::UpmixChannels(2, dst_frame);
+    AudioFrameOperations::UpmixChannels(dst_num_channels, dst_frame);
   }
 }
 
@@ -27,6 +27,34 @@ namespace {
 const size_t kMuteFadeFrames = 128;
 const float kMuteFadeInc = 1.0f / kMuteFadeFrames;
 
+// Downmixes by averaging adjacent groups of source channels, so that
+// destination channel k is the mean of source channels
+// [k * src_channels / dst_channels, (k + 1) * src_channels / dst_channels).
+// This keeps the spatial order of e.g. a linear microphone array. Every
+// destination sample is written after its whole group has been read, and
+// never ahead of the next group, so |src_audio| and |dst_audio| may alias.
+void DownmixToChannelGroups(const int16_t* src_audio,
+                            size_t src_channels,
+                            size_t samples_per_channel,
+                            size_t dst_channels,
+                            int16_t* dst_audio) {
+  RTC_DCHECK_GT(dst_channels, 0);
+  RTC_DCHECK_GT(src_channels, dst_channels);
+  for (size_t i = 0; i < samples_per_channel; ++i) {
+    const int16_t* src_frame = src_audio + i * src_channels;
+    int16_t* dst_frame = dst_audio + i * dst_channels;
+    for (size_t k = 0; k < dst_channels; ++k) {
+      const size_t begin = k * src_channels / dst_channels;
+      const size_t end = (k + 1) * src_channels / dst_channels;
+      int32_t sum = 0;
+      for (size_t c = begin; c < end; ++c)
+        sum += src_frame[c];
+      dst_frame[k] =
+          static_cast<int16_t>(sum / static_cast<int32_t>(end - begin));
+    }
+  }
+}
+
 }  // namespace
 
 void AudioFrameOperations::Add(const AudioFrame& frame_to_add,
@@ -129,6 +157,10 @@ void AudioFrameOperations::DownmixChannels(const int16_t* src_audio,
   } else if (src_channels == 4 && dst_channels == 2) {
     QuadToStereo(src_audio, samples_per_channel, dst_audio);
     return;
+  } else if (src_channels > dst_channels && dst_channels > 1) {
+    DownmixToChannelGroups(src_audio, src_channels, samples_per_channel,
+                           dst_channels, dst_audio);
+    return;
   }
 
   RTC_NOTREACHED() << "src_channels: " << src_channels
@@ -148,6 +180,13 @@ void AudioFrameOperations::DownmixChannels(size_t dst_channels,
   } else if (frame->num_channels_ == 4 && dst_channels == 2) {
     int err = QuadToStereo(frame);
     RTC_DCHECK_EQ(err, 0);
+  } else if (frame->num_channels_ > dst_channels && dst_channels > 1) {
+    if (!frame->muted()) {
+      DownmixToChannelGroups(frame->data(), frame->num_channels_,
+                             frame->samples_per_channel_, dst_channels,
+                             frame->mutable_data());
+    }
+    frame->num_channels_ = dst_channels;
   } else {
     RTC_NOTREACHED() << "src_channels: " << frame->num_channels_
                      << ", dst_channels: " << dst_channels;
@@ -56,8 +56,9 @@ class AudioFrameOperations {
 
   // Downmixes |src_channels| |src_audio| to |dst_channels| |dst_audio|.
   // This is an in-place operation, meaning |src_audio| and |dst_audio|
-  // may point to the same buffer. Supported channel combinations are
-  // Stereo to Mono, Quad to Mono, and Quad to Stereo.
+  // may point to the same buffer. Any downmix is supported: N channels to
+  // Mono averages all channels, and N to M channels averages groups of
+  // adjacent channels, e.g. channels 0-2 and 3-5 for 6 to 2.
   static void DownmixChannels(const int16_t* src_audio,
                               size_t src_channels,
                               size_t samples_per_channel,
@@ -66,7 +67,7 @@ class AudioFrameOperations {
 
   // |frame.num_channels_| will be updated. This version checks that
   // |num_channels_| and |dst_channels| are valid and performs relevant downmix.
-  // Supported channel combinations are N channels to Mono, and Quad to Stereo.
+  // Any downmix is supported, as for the version above.
   static void DownmixChannels(size_t dst_channels, AudioFrame* frame);
 
   // |frame.num_channels_| will be updated. This version checks that
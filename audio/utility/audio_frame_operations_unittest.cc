@@ -298,6 +298,71 @@ TEST_F(AudioFrameOperationsTest, QuadToStereoDoesNotWrapAround) {
   VerifyFramesAreEqual(stereo_frame, frame_);
 }
 
+TEST_F(AudioFrameOperationsTest, SixToStereoAveragesAdjacentChannels) {
+  frame_.num_channels_ = 6;
+  int16_t* frame_data = frame_.mutable_data();
+  for (size_t i = 0; i < frame_.samples_per_channel_; ++i) {
+    for (size_t ch = 0; ch < 6; ++ch)
+      frame_data[6 * i + ch] = static_cast<int16_t>(10 * (ch + 1));
+  }
+  AudioFrameOperations::DownmixChannels(2, &frame_);
+  EXPECT_EQ(2u, frame_.num_channels_);
+
+  AudioFrame stereo_frame;
+  stereo_frame.samples_per_channel_ = 320;
+  stereo_frame.num_channels_ = 2;
+  SetFrameData(20, 50, &stereo_frame);
+  VerifyFramesAreEqual(stereo_frame, frame_);
+}
+
+TEST_F(AudioFrameOperationsTest, EightToQuadBufferSucceeds) {
+  frame_.num_channels_ = 8;
+  frame_.samples_per_channel_ = 480;
+  int16_t* frame_data = frame_.mutable_data();
+  for (size_t i = 0; i < frame_.samples_per_channel_; ++i) {
+    for (size_t ch = 0; ch < 8; ++ch)
+      frame_data[8 * i + ch] = static_cast<int16_t>(ch % 2 == 0 ? -32768 : 2);
+  }
+  AudioFrame target_frame;
+  target_frame.num_channels_ = 4;
+  target_frame.samples_per_channel_ = frame_.samples_per_channel_;
+  AudioFrameOperations::DownmixChannels(frame_.data(), 8,
+                                        frame_.samples_per_channel_, 4,
+                                        target_frame.mutable_data());
+
+  AudioFrame quad_frame;
+  quad_frame.samples_per_channel_ = 480;
+  quad_frame.num_channels_ = 4;
+  SetFrameData(-16383, -16383, -16383, -16383, &quad_frame);
+  VerifyFramesAreEqual(quad_frame, target_frame);
+}
+
+TEST_F(AudioFrameOperationsTest, FiveToStereoUsesUnevenGroups) {
+  frame_.num_channels_ = 5;
+  int16_t* frame_data = frame_.mutable_data();
+  const int16_t kSamples[] = {2, 4, 6, 9, 12};
+  for (size_t i = 0; i < frame_.samples_per_channel_; ++i) {
+    for (size_t ch = 0; ch < 5; ++ch)
+      frame_data[5 * i + ch] = kSamples[ch];
+  }
+  AudioFrameOperations::DownmixChannels(2, &frame_);
+
+  // Channels 0-1 and 2-4.
+  AudioFrame stereo_frame;
+  stereo_frame.samples_per_channel_ = 320;
+  stereo_frame.num_channels_ = 2;
+  SetFrameData(3, 9, &stereo_frame);
+  VerifyFramesAreEqual(stereo_frame, frame_);
+}
+
+TEST_F(AudioFrameOperationsTest, MultichannelDownmixMuted) {
+  frame_.num_channels_ = 8;
+  ASSERT_TRUE(frame_.muted());
+  AudioFrameOperations::DownmixChannels(2, &frame_);
+  EXPECT_EQ(2u, frame_.num_channels_);
+  EXPECT_TRUE(frame_.muted());
+}
+
 TEST_F(AudioFrameOperationsTest, SwapStereoChannelsSucceedsOnStereo) {
   SetFrameData(0, 1, &frame_);
 
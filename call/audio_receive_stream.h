@@ -86,6 +86,10 @@ class AudioReceiveStream {
     double relative_packet_arrival_delay_seconds = 0.0;
     int32_t interruption_count = 0;
     int32_t total_interruption_duration_ms = 0;
+    // Approximate memory held by the jitter buffer packets, and the configured
+    // cap on the number of buffered packets.
+    uint64_t jitter_buffer_bytes = 0;
+    size_t jitter_buffer_max_packets = 0;
   };
 
   struct Config {
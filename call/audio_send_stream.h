@@ -71,6 +71,10 @@ class AudioSendStream {
     // per-pair the ReportBlockData represents the latest Report Block that was
     // received for that pair.
     std::vector<ReportBlockData> report_block_datas;
+    // Approximate memory held by the packets stored for retransmission, and
+    // the configured cap on the number of stored packets.
+    size_t rtp_packet_history_bytes = 0;
+    size_t rtp_packet_history_max_packets = 0;
   };
 
   struct Config {
@@ -12,6 +12,7 @@
 
 #include "api/audio/audio_mixer.h"
 #include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "modules/audio_device/include/audio_device.h"
 #include "modules/audio_processing/include/audio_processing.h"
 #include "rtc_base/ref_count.h"
@@ -37,6 +38,12 @@ class AudioState : public rtc::RefCountInterface {
 
     // TODO(solenberg): Temporary: audio device module.
     rtc::scoped_refptr<webrtc::AudioDeviceModule> audio_device_module;
+
+    // Factory for the audio encoder task queues of the send streams using this
+    // AudioState. With e.g. CreateThreadPoolTaskQueueFactory(), many streams
+    // share a pool of threads instead of each owning one. If null, the task
+    // queue factory of the Call is used. Must outlive all send streams.
+    TaskQueueFactory* encoder_task_queue_factory = nullptr;
   };
 
   virtual AudioProcessing* audio_processing() = 0;
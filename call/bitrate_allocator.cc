@@ -15,6 +15,7 @@
 #include <cmath>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "api/units/data_rate.h"
@@ -30,6 +31,7 @@ namespace webrtc {
 
 namespace {
 using bitrate_allocator_impl::AllocatableTrack;
+using bitrate_allocator_impl::AllocationBuffers;
 
 // Allow packets to be transmitted in up to 2 times max video bitrate if the
 // bandwidth estimate allows it.
@@ -79,34 +81,38 @@ void DistributeBitrateEvenly(
     uint32_t bitrate,
     bool include_zero_allocations,
     int max_multiplier,
-    std::map<BitrateAllocatorObserver*, int>* allocation) {
+    AllocationBuffers* buffers,
+    std::vector<int>* allocation) {
   RTC_DCHECK_EQ(allocation->size(), allocatable_tracks.size());
 
-  std::multimap<uint32_t, const AllocatableTrack*> list_max_bitrates;
-  for (const auto& observer_config : allocatable_tracks) {
-    if (include_zero_allocations ||
-        allocation->at(observer_config.observer) != 0) {
-      list_max_bitrates.insert(
-          {observer_config.config.max_bitrate_bps, &observer_config});
-    }
+  // Sorted by max bitrate, and in insertion order for equal max bitrates.
+  std::vector<size_t>& order = buffers->order;
+  order.clear();
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    if (include_zero_allocations || (*allocation)[i] != 0)
+      order.push_back(i);
   }
-  auto it = list_max_bitrates.begin();
-  while (it != list_max_bitrates.end()) {
+  absl::c_sort(order, [&allocatable_tracks](size_t a, size_t b) {
+    uint32_t max_a = allocatable_tracks[a].config.max_bitrate_bps;
+    uint32_t max_b = allocatable_tracks[b].config.max_bitrate_bps;
+    return max_a < max_b || (max_a == max_b && a < b);
+  });
+  for (size_t j = 0; j < order.size(); ++j) {
     RTC_DCHECK_GT(bitrate, 0);
+    const size_t i = order[j];
+    const uint32_t max_bitrate = allocatable_tracks[i].config.max_bitrate_bps;
     uint32_t extra_allocation =
-        bitrate / static_cast<uint32_t>(list_max_bitrates.size());
-    uint32_t total_allocation =
-        extra_allocation + allocation->at(it->second->observer);
+        bitrate / static_cast<uint32_t>(order.size() - j);
+    uint32_t total_allocation = extra_allocation + (*allocation)[i];
     bitrate -= extra_allocation;
-    if (total_allocation > max_multiplier * it->first) {
+    if (total_allocation > max_multiplier * max_bitrate) {
       // There is more than we can fit for this observer, carry over to the
       // remaining observers.
-      bitrate += total_allocation - max_multiplier * it->first;
-      total_allocation = max_multiplier * it->first;
+      bitrate += total_allocation - max_multiplier * max_bitrate;
+      total_allocation = max_multiplier * max_bitrate;
     }
     // Finally, update the allocation for this observer.
-    allocation->at(it->second->observer) = total_allocation;
-    it = list_max_bitrates.erase(it);
+    (*allocation)[i] = total_allocation;
   }
 }
 
@@ -119,26 +125,19 @@ void DistributeBitrateEvenly(
 void DistributeBitrateRelatively(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t remaining_bitrate,
-    const std::map<BitrateAllocatorObserver*, int>& observers_capacities,
-    std::map<BitrateAllocatorObserver*, int>* allocation) {
+    AllocationBuffers* buffers,
+    std::vector<int>* allocation) {
   RTC_DCHECK_EQ(allocation->size(), allocatable_tracks.size());
-  RTC_DCHECK_EQ(observers_capacities.size(), allocatable_tracks.size());
-
-  struct PriorityRateObserverConfig {
-    BitrateAllocatorObserver* allocation_key;
-    // The amount of bitrate bps that can be allocated to this observer.
-    int capacity_bps;
-    double bitrate_priority;
-  };
+  // The amount of bitrate bps that can be allocated to each observer.
+  const std::vector<int>& capacities = buffers->capacities;
+  RTC_DCHECK_EQ(capacities.size(), allocatable_tracks.size());
 
   double bitrate_priority_sum = 0;
-  std::vector<PriorityRateObserverConfig> priority_rate_observers;
-  for (const auto& observer_config : allocatable_tracks) {
-    priority_rate_observers.push_back(PriorityRateObserverConfig{
-        observer_config.observer,
-        observers_capacities.at(observer_config.observer),
-        observer_config.config.bitrate_priority});
-    bitrate_priority_sum += observer_config.config.bitrate_priority;
+  std::vector<size_t>& order = buffers->order;
+  order.clear();
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    order.push_back(i);
+    bitrate_priority_sum += allocatable_tracks[i].config.bitrate_priority;
   }
 
   // Iterate in the order observers can be allocated their full capacity.
@@ -149,69 +148,69 @@ void DistributeBitrateRelatively(
   // filled. This is because the amount allocated is based upon bitrate
   // priority. We allocate twice as much bitrate to an observer with twice the
   // bitrate priority of another.
-  absl::c_sort(priority_rate_observers, [](const auto& a, const auto& b) {
-    return a.capacity_bps / a.bitrate_priority <
-           b.capacity_bps / b.bitrate_priority;
+  absl::c_sort(order, [&](size_t a, size_t b) {
+    return capacities[a] / allocatable_tracks[a].config.bitrate_priority <
+           capacities[b] / allocatable_tracks[b].config.bitrate_priority;
   });
-  size_t i;
-  for (i = 0; i < priority_rate_observers.size(); ++i) {
-    const auto& priority_rate_observer = priority_rate_observers[i];
+  size_t j;
+  for (j = 0; j < order.size(); ++j) {
+    const size_t i = order[j];
+    const double bitrate_priority =
+        allocatable_tracks[i].config.bitrate_priority;
     // We allocate the full capacity to an observer only if its relative
     // portion from the remaining bitrate is sufficient to allocate its full
     // capacity. This means we aren't greedily allocating the full capacity, but
     // that it is only done when there is also enough bitrate to allocate the
     // proportional amounts to all other observers.
-    double observer_share =
-        priority_rate_observer.bitrate_priority / bitrate_priority_sum;
+    double observer_share = bitrate_priority / bitrate_priority_sum;
     double allocation_bps = observer_share * remaining_bitrate;
-    bool enough_bitrate = allocation_bps >= priority_rate_observer.capacity_bps;
+    bool enough_bitrate = allocation_bps >= capacities[i];
     if (!enough_bitrate)
       break;
-    allocation->at(priority_rate_observer.allocation_key) +=
-        priority_rate_observer.capacity_bps;
-    remaining_bitrate -= priority_rate_observer.capacity_bps;
-    bitrate_priority_sum -= priority_rate_observer.bitrate_priority;
+    (*allocation)[i] += capacities[i];
+    remaining_bitrate -= capacities[i];
+    bitrate_priority_sum -= bitrate_priority;
   }
 
   // From the remaining bitrate, allocate the proportional amounts to the
   // observers that aren't allocated their max capacity.
-  for (; i < priority_rate_observers.size(); ++i) {
-    const auto& priority_rate_observer = priority_rate_observers[i];
+  for (; j < order.size(); ++j) {
+    const size_t i = order[j];
     double fraction_allocated =
-        priority_rate_observer.bitrate_priority / bitrate_priority_sum;
-    allocation->at(priority_rate_observer.allocation_key) +=
-        fraction_allocated * remaining_bitrate;
+        allocatable_tracks[i].config.bitrate_priority / bitrate_priority_sum;
+    (*allocation)[i] += fraction_allocated * remaining_bitrate;
   }
 }
 
 // Allocates bitrate to observers when there isn't enough to allocate the
 // minimum to all observers.
-std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
+void LowRateAllocation(const std::vector<AllocatableTrack>& allocatable_tracks,
+                       uint32_t bitrate,
+                       AllocationBuffers* buffers,
+                       std::vector<int>* allocation) {
   // Start by allocating bitrate to observers enforcing a min bitrate, hence
   // remaining_bitrate might turn negative.
   int64_t remaining_bitrate = bitrate;
-  for (const auto& observer_config : allocatable_tracks) {
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
     int32_t allocated_bitrate = 0;
-    if (observer_config.config.enforce_min_bitrate)
-      allocated_bitrate = observer_config.config.min_bitrate_bps;
+    if (allocatable_tracks[i].config.enforce_min_bitrate)
+      allocated_bitrate = allocatable_tracks[i].config.min_bitrate_bps;
 
-    allocation[observer_config.observer] = allocated_bitrate;
+    (*allocation)[i] = allocated_bitrate;
     remaining_bitrate -= allocated_bitrate;
   }
 
   // Allocate bitrate to all previously active streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : allocatable_tracks) {
+    for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+      const AllocatableTrack& observer_config = allocatable_tracks[i];
       if (observer_config.config.enforce_min_bitrate ||
           observer_config.LastAllocatedBitrate() == 0)
         continue;
 
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -219,14 +218,15 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
 
   // Allocate bitrate to previously paused streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : allocatable_tracks) {
+    for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+      const AllocatableTrack& observer_config = allocatable_tracks[i];
       if (observer_config.LastAllocatedBitrate() != 0)
         continue;
 
       // Add a hysteresis to avoid toggling.
       uint32_t required_bitrate = observer_config.MinBitrateWithHysteresis();
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        (*allocation)[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -235,10 +235,7 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
   // Split a possible remainder evenly on all streams with an allocation.
   if (remaining_bitrate > 0)
     DistributeBitrateEvenly(allocatable_tracks, remaining_bitrate, false, 1,
-                            &allocation);
-
-  RTC_DCHECK_EQ(allocation.size(), allocatable_tracks.size());
-  return allocation;
+                            buffers, allocation);
 }
 
 // Allocates bitrate to all observers when the available bandwidth is enough
@@ -252,32 +249,31 @@ std::map<BitrateAllocatorObserver*, int> LowRateAllocation(
 // bitrate_priority = 2.0, the expected behavior is that observer 2 will be
 // allocated twice the bitrate as observer 1 above the each observer's
 // min_bitrate_bps values, until one of the observers hits its max_bitrate_bps.
-std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
+void NormalRateAllocation(
     const std::vector<AllocatableTrack>& allocatable_tracks,
     uint32_t bitrate,
-    uint32_t sum_min_bitrates) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-  std::map<BitrateAllocatorObserver*, int> observers_capacities;
-  for (const auto& observer_config : allocatable_tracks) {
-    allocation[observer_config.observer] =
-        observer_config.config.min_bitrate_bps;
-    observers_capacities[observer_config.observer] =
-        observer_config.config.max_bitrate_bps -
-        observer_config.config.min_bitrate_bps;
+    uint32_t sum_min_bitrates,
+    AllocationBuffers* buffers,
+    std::vector<int>* allocation) {
+  std::vector<int>& capacities = buffers->capacities;
+  capacities.resize(allocatable_tracks.size());
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    const MediaStreamAllocationConfig& config = allocatable_tracks[i].config;
+    (*allocation)[i] = config.min_bitrate_bps;
+    capacities[i] = config.max_bitrate_bps - config.min_bitrate_bps;
   }
 
   bitrate -= sum_min_bitrates;
 
   // TODO(srte): Implement fair sharing between prioritized streams, currently
   // they are treated on a first come first serve basis.
-  for (const auto& observer_config : allocatable_tracks) {
-    int64_t priority_margin = observer_config.config.priority_bitrate_bps -
-                              allocation[observer_config.observer];
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    int64_t priority_margin =
+        allocatable_tracks[i].config.priority_bitrate_bps - (*allocation)[i];
     if (priority_margin > 0 && bitrate > 0) {
       int64_t extra_bitrate = std::min<int64_t>(priority_margin, bitrate);
-      allocation[observer_config.observer] +=
-          rtc::dchecked_cast<int>(extra_bitrate);
-      observers_capacities[observer_config.observer] -= extra_bitrate;
+      (*allocation)[i] += rtc::dchecked_cast<int>(extra_bitrate);
+      capacities[i] -= extra_bitrate;
       bitrate -= extra_bitrate;
     }
   }
@@ -285,47 +281,37 @@ std::map<BitrateAllocatorObserver*, int> NormalRateAllocation(
   // From the remaining bitrate, allocate a proportional amount to each observer
   // above the min bitrate already allocated.
   if (bitrate > 0)
-    DistributeBitrateRelatively(allocatable_tracks, bitrate,
-                                observers_capacities, &allocation);
-
-  return allocation;
+    DistributeBitrateRelatively(allocatable_tracks, bitrate, buffers,
+                                allocation);
 }
 
 // Allocates bitrate to observers when there is enough available bandwidth
 // for all observers to be allocated their max bitrate.
-std::map<BitrateAllocatorObserver*, int> MaxRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate,
-    uint32_t sum_max_bitrates) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-
-  for (const auto& observer_config : allocatable_tracks) {
-    allocation[observer_config.observer] =
-        observer_config.config.max_bitrate_bps;
-    bitrate -= observer_config.config.max_bitrate_bps;
+void MaxRateAllocation(const std::vector<AllocatableTrack>& allocatable_tracks,
+                       uint32_t bitrate,
+                       uint32_t sum_max_bitrates,
+                       AllocationBuffers* buffers,
+                       std::vector<int>* allocation) {
+  for (size_t i = 0; i < allocatable_tracks.size(); ++i) {
+    (*allocation)[i] = allocatable_tracks[i].config.max_bitrate_bps;
+    bitrate -= allocatable_tracks[i].config.max_bitrate_bps;
   }
   DistributeBitrateEvenly(allocatable_tracks, bitrate, true,
-                          kTransmissionMaxBitrateMultiplier, &allocation);
-  return allocation;
-}
-
-// Allocates zero bitrate to all observers.
-std::map<BitrateAllocatorObserver*, int> ZeroRateAllocation(
-    const std::vector<AllocatableTrack>& allocatable_tracks) {
-  std::map<BitrateAllocatorObserver*, int> allocation;
-  for (const auto& observer_config : allocatable_tracks)
-    allocation[observer_config.observer] = 0;
-  return allocation;
+                          kTransmissionMaxBitrateMultiplier, buffers,
+                          allocation);
 }
 
-std::map<BitrateAllocatorObserver*, int> AllocateBitrates(
-    const std::vector<AllocatableTrack>& allocatable_tracks,
-    uint32_t bitrate) {
-  if (allocatable_tracks.empty())
-    return std::map<BitrateAllocatorObserver*, int>();
-
-  if (bitrate == 0)
-    return ZeroRateAllocation(allocatable_tracks);
+// Allocates bitrate to |allocatable_tracks| into |allocation|, which gets the
+// bitrate of each track at the index of the track. The vectors in |buffers|
+// and |allocation| keep their capacity between calls, so that allocating
+// doesn't need heap allocations once the number of tracks has settled.
+void AllocateBitrates(const std::vector<AllocatableTrack>& allocatable_tracks,
+                      uint32_t bitrate,
+                      AllocationBuffers* buffers,
+                      std::vector<int>* allocation) {
+  allocation->assign(allocatable_tracks.size(), 0);
+  if (allocatable_tracks.empty() || bitrate == 0)
+    return;
 
   uint32_t sum_min_bitrates = 0;
   uint32_t sum_max_bitrates = 0;
@@ -338,16 +324,22 @@ std::map<BitrateAllocatorObserver*, int> AllocateBitrates(
   // enforced min bitrate -> allocated bitrate previous round -> restart paused
   // streams.
   if (!EnoughBitrateForAllObservers(allocatable_tracks, bitrate,
-                                    sum_min_bitrates))
-    return LowRateAllocation(allocatable_tracks, bitrate);
+                                    sum_min_bitrates)) {
+    LowRateAllocation(allocatable_tracks, bitrate, buffers, allocation);
+    return;
+  }
 
   // All observers will get their min bitrate plus a share of the rest. This
   // share is allocated to each observer based on its bitrate_priority.
-  if (bitrate <= sum_max_bitrates)
-    return NormalRateAllocation(allocatable_tracks, bitrate, sum_min_bitrates);
+  if (bitrate <= sum_max_bitrates) {
+    NormalRateAllocation(allocatable_tracks, bitrate, sum_min_bitrates,
+                         buffers, allocation);
+    return;
+  }
 
   // All observers will get up to transmission_max_bitrate_multiplier_ x max.
-  return MaxRateAllocation(allocatable_tracks, bitrate, sum_max_bitrates);
+  MaxRateAllocation(allocatable_tracks, bitrate, sum_max_bitrates, buffers,
+                    allocation);
 }
 
 }  // namespace
@@ -395,14 +387,14 @@ void BitrateAllocator::OnNetworkEstimateChanged(TargetTransferRate msg) {
     last_bwe_log_time_ = now;
   }
 
-  auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
-  auto stable_bitrate_allocation =
-      AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
+  const std::vector<int>& allocation = AllocateTargetBitrates();
+  const std::vector<int>& stable_bitrate_allocation =
+      AllocateStableTargetBitrates();
 
-  for (auto& config : allocatable_tracks_) {
-    uint32_t allocated_bitrate = allocation[config.observer];
-    uint32_t allocated_stable_target_rate =
-        stable_bitrate_allocation[config.observer];
+  for (size_t i = 0; i < allocatable_tracks_.size(); ++i) {
+    AllocatableTrack& config = allocatable_tracks_[i];
+    uint32_t allocated_bitrate = allocation[i];
+    uint32_t allocated_stable_target_rate = stable_bitrate_allocation[i];
     BitrateAllocationUpdate update;
     update.target_bitrate = DataRate::bps(allocated_bitrate);
     update.stable_target_bitrate = DataRate::bps(allocated_stable_target_rate);
@@ -460,13 +452,13 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   if (last_target_bps_ > 0) {
     // Calculate a new allocation and update all observers.
 
-    auto allocation = AllocateBitrates(allocatable_tracks_, last_target_bps_);
-    auto stable_bitrate_allocation =
-        AllocateBitrates(allocatable_tracks_, last_stable_target_bps_);
-    for (auto& config : allocatable_tracks_) {
-      uint32_t allocated_bitrate = allocation[config.observer];
-      uint32_t allocated_stable_bitrate =
-          stable_bitrate_allocation[config.observer];
+    const std::vector<int>& allocation = AllocateTargetBitrates();
+    const std::vector<int>& stable_bitrate_allocation =
+        AllocateStableTargetBitrates();
+    for (size_t i = 0; i < allocatable_tracks_.size(); ++i) {
+      AllocatableTrack& config = allocatable_tracks_[i];
+      uint32_t allocated_bitrate = allocation[i];
+      uint32_t allocated_stable_bitrate = stable_bitrate_allocation[i];
       BitrateAllocationUpdate update;
       update.target_bitrate = DataRate::bps(allocated_bitrate);
       update.stable_target_bitrate = DataRate::bps(allocated_stable_bitrate);
@@ -494,6 +486,22 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   UpdateAllocationLimits();
 }
 
+const std::vector<int>& BitrateAllocator::AllocateTargetBitrates() {
+  AllocateBitrates(allocatable_tracks_, last_target_bps_, &buffers_,
+                   &allocation_);
+  return allocation_;
+}
+
+const std::vector<int>& BitrateAllocator::AllocateStableTargetBitrates() {
+  // The stable target often equals the target, and then so do the
+  // allocations. Must be called after AllocateTargetBitrates().
+  if (last_stable_target_bps_ == last_target_bps_)
+    return allocation_;
+  AllocateBitrates(allocatable_tracks_, last_stable_target_bps_, &buffers_,
+                   &stable_allocation_);
+  return stable_allocation_;
+}
+
 void BitrateAllocator::UpdateAllocationLimits() {
   BitrateAllocationLimits limits;
   for (const auto& config : allocatable_tracks_) {
@@ -13,7 +13,6 @@
 
 #include <stdint.h>
 
-#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -92,6 +91,16 @@ struct AllocatableTrack {
   // enable-hysteresis if the observer is in a paused state.
   uint32_t MinBitrateWithHysteresis() const;
 };
+
+// Scratch space for computing an allocation, kept between allocations to
+// avoid heap allocations. Indices refer to positions in the track list.
+struct AllocationBuffers {
+  // Track indices, in the order a pass allocates bitrate to the tracks.
+  std::vector<size_t> order;
+  // The bitrate that can be allocated to each track above its current
+  // allocation.
+  std::vector<int> capacities;
+};
 }  // namespace bitrate_allocator_impl
 
 // Usage: this class will register multiple RtcpBitrateObserver's one at each
@@ -138,6 +147,14 @@ class BitrateAllocator : public BitrateAllocatorInterface {
  private:
   using AllocatableTrack = bitrate_allocator_impl::AllocatableTrack;
 
+  // Allocate last_target_bps_ and last_stable_target_bps_ respectively,
+  // returning the allocated bitrate of each track by its index in
+  // |allocatable_tracks_|. The result is valid until the next call.
+  const std::vector<int>& AllocateTargetBitrates()
+      RTC_RUN_ON(&sequenced_checker_);
+  const std::vector<int>& AllocateStableTargetBitrates()
+      RTC_RUN_ON(&sequenced_checker_);
+
   // Calculates the minimum requested send bitrate and max padding bitrate and
   // calls LimitObserver::OnAllocationLimitsChanged.
   void UpdateAllocationLimits() RTC_RUN_ON(&sequenced_checker_);
@@ -163,6 +180,11 @@ class BitrateAllocator : public BitrateAllocatorInterface {
   int num_pause_events_ RTC_GUARDED_BY(&sequenced_checker_);
   int64_t last_bwe_log_time_ RTC_GUARDED_BY(&sequenced_checker_);
   BitrateAllocationLimits current_limits_ RTC_GUARDED_BY(&sequenced_checker_);
+
+  bitrate_allocator_impl::AllocationBuffers buffers_
+      RTC_GUARDED_BY(&sequenced_checker_);
+  std::vector<int> allocation_ RTC_GUARDED_BY(&sequenced_checker_);
+  std::vector<int> stable_allocation_ RTC_GUARDED_BY(&sequenced_checker_);
 };
 
 }  // namespace webrtc
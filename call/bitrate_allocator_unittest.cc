@@ -14,6 +14,8 @@
 #include <memory>
 #include <vector>
 
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -1030,4 +1032,49 @@ TEST_F(BitrateAllocatorTest, PriorityRateThreeObserversTwoAllocatedToMax) {
   allocator_->RemoveObserver(&observer_high);
 }
 
+// Measures the cost of an allocation with many observers, with estimates that
+// cover the low, normal and max rate allocations. Run with
+// --gtest_also_run_disabled_tests to get the timings logged.
+class BitrateAllocatorPerfTest : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(NumObservers,
+                         BitrateAllocatorPerfTest,
+                         ::testing::Values(10, 100, 1000));
+
+TEST_P(BitrateAllocatorPerfTest, DISABLED_OnNetworkEstimateChangedPerf) {
+  const int num_observers = GetParam();
+  const int kIterations = 1000;
+  NiceMock<MockLimitObserver> limit_observer;
+  BitrateAllocator allocator(&limit_observer);
+  std::vector<TestBitrateObserver> observers(num_observers);
+  uint32_t sum_max_bitrates = 0;
+  for (int i = 0; i < num_observers; ++i) {
+    uint32_t min_bitrate_bps = 30000 + 1000 * (i % 7);
+    uint32_t max_bitrate_bps = 300000 + 100000 * (i % 11);
+    allocator.AddObserver(&observers[i],
+                          {min_bitrate_bps, max_bitrate_bps, 0,
+                           /* priority_bitrate */ (i % 5) ? 0 : 100000,
+                           /* enforce_min_bitrate */ i % 3 == 0,
+                           /* bitrate_priority */ 1.0 + i % 4});
+    sum_max_bitrates += max_bitrate_bps;
+  }
+
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kIterations; ++i) {
+    uint32_t target_bps =
+        static_cast<uint64_t>(sum_max_bitrates) * 3 * (i % 100) / 200;
+    TargetTransferRate msg = CreateTargetRateMessage(
+        target_bps, 0, 0, kDefaultProbingIntervalMs);
+    msg.stable_target_rate = msg.target_rate * 0.9;
+    allocator.OnNetworkEstimateChanged(msg);
+  }
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  RTC_LOG(LS_INFO) << num_observers << " observers: "
+                   << static_cast<double>(elapsed_us) / kIterations
+                   << " us per estimate";
+
+  for (auto& observer : observers)
+    allocator.RemoveObserver(&observer);
+}
+
 }  // namespace webrtc
@@ -59,6 +59,8 @@
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
 #include "video/call_stats.h"
+#include "video/decode_thread_pool.h"
+#include "video/keyframe_request_coordinator.h"
 #include "video/send_delay_stats.h"
 #include "video/stats_counter.h"
 #include "video/video_receive_stream.h"
@@ -213,6 +215,9 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverPacket(MediaType media_type,
                                rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) override;
+  DeliveryStatus DeliverRtpPacket(MediaType media_type,
+                                  RtpPacketReceived packet,
+                                  int64_t packet_time_us) override;
 
   // Implements RecoveredPacketReceiver.
   void OnRecoveredPacket(const uint8_t* packet, size_t length) override;
@@ -240,6 +245,9 @@ class Call final : public webrtc::Call,
   DeliveryStatus DeliverRtp(MediaType media_type,
                             rtc::CopyOnWriteBuffer packet,
                             int64_t packet_time_us);
+  DeliveryStatus DeliverParsedRtp(MediaType media_type,
+                                  RtpPacketReceived parsed_packet,
+                                  int64_t packet_time_us);
   void ConfigureSync(const std::string& sync_group)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(receive_crit_);
 
@@ -289,6 +297,10 @@ class Call final : public webrtc::Call,
   // with a single object in the bundled case.
   RtpStreamReceiverController audio_receiver_controller_;
   RtpStreamReceiverController video_receiver_controller_;
+  // Shared by the video receive streams, if enabled in the config.
+  const std::unique_ptr<DecodeThreadPool> decode_thread_pool_;
+  const std::unique_ptr<KeyFrameRequestCoordinator>
+      keyframe_request_coordinator_;
 
   // This extra map is used for receive processing which is
   // independent of media type.
@@ -447,6 +459,17 @@ Call::Call(Clock* clock,
       video_network_state_(kNetworkDown),
       aggregate_network_up_(false),
       receive_crit_(RWLockWrapper::CreateRWLock()),
+      video_receiver_controller_(task_queue_factory,
+                                 config.num_video_receive_shards),
+      decode_thread_pool_(config.num_video_decode_threads > 0
+                              ? std::make_unique<DecodeThreadPool>(
+                                    config.num_video_decode_threads)
+                              : nullptr),
+      keyframe_request_coordinator_(
+          config.keyframe_request_min_interval_ms > 0
+              ? std::make_unique<KeyFrameRequestCoordinator>(
+                    clock_, config.keyframe_request_min_interval_ms)
+              : nullptr),
       send_crit_(RWLockWrapper::CreateRWLock()),
       event_log_(config.event_log),
       received_bytes_per_second_counter_(clock_, nullptr, true),
@@ -836,9 +859,11 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
   RegisterRateObserver();
 
   VideoReceiveStream* receive_stream = new VideoReceiveStream(
-      task_queue_factory_, &video_receiver_controller_, num_cpu_cores_,
-      transport_send_ptr_->packet_router(), std::move(configuration),
-      module_process_thread_.get(), call_stats_.get(), clock_);
+      task_queue_factory_, decode_thread_pool_.get(),
+      keyframe_request_coordinator_.get(), &video_receiver_controller_,
+      num_cpu_cores_, transport_send_ptr_->packet_router(),
+      std::move(configuration), module_process_thread_.get(), call_stats_.get(),
+      clock_);
 
   const webrtc::VideoReceiveStream::Config& config = receive_stream->config();
   {
@@ -1222,6 +1247,14 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   if (!parsed_packet.Parse(std::move(packet)))
     return DELIVERY_PACKET_ERROR;
 
+  return DeliverParsedRtp(media_type, std::move(parsed_packet),
+                          packet_time_us);
+}
+
+PacketReceiver::DeliveryStatus Call::DeliverParsedRtp(
+    MediaType media_type,
+    RtpPacketReceived parsed_packet,
+    int64_t packet_time_us) {
   if (packet_time_us != -1) {
     if (receive_time_calculator_) {
       // Repair packet_time_us for clock resets by comparing a new read of
@@ -1305,6 +1338,15 @@ PacketReceiver::DeliveryStatus Call::DeliverPacket(
   return DeliverRtp(media_type, std::move(packet), packet_time_us);
 }
 
+PacketReceiver::DeliveryStatus Call::DeliverRtpPacket(
+    MediaType media_type,
+    RtpPacketReceived packet,
+    int64_t packet_time_us) {
+  RTC_DCHECK_RUN_ON(&configuration_sequence_checker_);
+  TRACE_EVENT0("webrtc", "Call::DeliverRtpPacket");
+  return DeliverParsedRtp(media_type, std::move(packet), packet_time_us);
+}
+
 void Call::OnRecoveredPacket(const uint8_t* packet, size_t length) {
   RtpPacketReceived parsed_packet;
   if (!parsed_packet.Parse(packet, length))
@@ -1364,7 +1406,7 @@ void Call::NotifyBweOfReceivedPacket(const RtpPacketReceived& packet,
       (use_send_side_bwe && header.extension.hasTransportSequenceNumber)) {
     receive_side_cc_.OnReceivedPacket(
         packet.arrival_time_ms(), packet.payload_size() + packet.padding_size(),
-        header);
+        header, packet.ecn());
   }
 }
 
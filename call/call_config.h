@@ -56,6 +56,22 @@ struct CallConfig {
 
   // Network controller factory to use for this call.
   NetworkControllerFactoryInterface* network_controller_factory = nullptr;
+
+  // If greater than zero, incoming video RTP packets are delivered to the
+  // video receive streams on this many task queues instead of on the thread
+  // calling DeliverPacket(). Streams are assigned to a queue by SSRC, and a
+  // stream's RTX packets go to the same queue as its media packets.
+  int num_video_receive_shards = 0;
+
+  // If greater than zero, the video receive streams decode on a shared pool of
+  // this many threads, e.g. the number of CPU cores, instead of each on a
+  // thread of its own. Frames of a stream are still decoded in order.
+  int num_video_decode_threads = 0;
+
+  // If greater than zero, key frame requests of the video receive streams are
+  // coalesced per remote SSRC: a request is dropped if a request for the same
+  // SSRC was sent less than this many milliseconds ago.
+  int keyframe_request_min_interval_ms = 0;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,180 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef CALL_FLAT_SSRC_MAP_H_
+#define CALL_FLAT_SSRC_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Hash map from SSRC to V, stored in a single open-addressed array with
+// linear probing. Lookups touch one or two adjacent slots in the common case
+// instead of walking a tree, which matters for the per-packet demuxing lookups
+// when there are thousands of receive streams. Erasing uses backward shift
+// deletion, so there are no tombstones and lookups never slow down as streams
+// come and go.
+//
+// Pointers returned by Find() and Emplace() are invalidated by any later
+// Emplace() or Erase(). Iteration order is unspecified.
+template <typename V>
+class FlatSsrcMap {
+ public:
+  FlatSsrcMap() = default;
+  FlatSsrcMap(const FlatSsrcMap&) = delete;
+  FlatSsrcMap& operator=(const FlatSsrcMap&) = delete;
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Returns the value stored for |ssrc|, or null if there is none.
+  V* Find(uint32_t ssrc) {
+    if (slots_.empty())
+      return nullptr;
+    for (size_t i = HomeSlot(ssrc);; i = NextSlot(i)) {
+      Slot& slot = slots_[i];
+      if (!slot.used)
+        return nullptr;
+      if (slot.ssrc == ssrc)
+        return &slot.value;
+    }
+  }
+  const V* Find(uint32_t ssrc) const {
+    return const_cast<FlatSsrcMap*>(this)->Find(ssrc);
+  }
+
+  // Inserts |value| for |ssrc| unless there already is a value stored for it.
+  // Returns the stored value and whether an insertion took place, like
+  // std::map::emplace().
+  std::pair<V*, bool> Emplace(uint32_t ssrc, V value) {
+    if ((size_ + 1) * 2 > slots_.size())
+      Rehash(slots_.empty() ? kMinCapacity : slots_.size() * 2);
+    for (size_t i = HomeSlot(ssrc);; i = NextSlot(i)) {
+      Slot& slot = slots_[i];
+      if (!slot.used) {
+        slot.used = true;
+        slot.ssrc = ssrc;
+        slot.value = std::move(value);
+        ++size_;
+        return {&slot.value, true};
+      }
+      if (slot.ssrc == ssrc)
+        return {&slot.value, false};
+    }
+  }
+
+  // Returns a reference to the value stored for |ssrc|, inserting a default
+  // constructed value if there is none.
+  V& operator[](uint32_t ssrc) { return *Emplace(ssrc, V()).first; }
+
+  // Removes the value stored for |ssrc|. Returns true if there was one.
+  bool Erase(uint32_t ssrc) {
+    if (slots_.empty())
+      return false;
+    size_t hole = HomeSlot(ssrc);
+    for (;; hole = NextSlot(hole)) {
+      if (!slots_[hole].used)
+        return false;
+      if (slots_[hole].ssrc == ssrc)
+        break;
+    }
+    // Move later entries of the probe sequence into the hole, so that every
+    // entry stays reachable from its home slot without gaps.
+    for (size_t i = NextSlot(hole); slots_[i].used; i = NextSlot(i)) {
+      size_t home = HomeSlot(slots_[i].ssrc);
+      // Distances are computed modulo the capacity, as the probe sequence
+      // wraps around.
+      if (((i - home) & mask_) >= ((i - hole) & mask_)) {
+        slots_[hole] = std::move(slots_[i]);
+        hole = i;
+      }
+    }
+    slots_[hole].used = false;
+    slots_[hole].value = V();
+    --size_;
+    return true;
+  }
+
+  // Removes all entries for which |predicate(ssrc, value)| returns true, and
+  // returns the number of removed entries.
+  template <typename Predicate>
+  size_t EraseIf(Predicate predicate) {
+    std::vector<uint32_t> to_erase;
+    for (const Slot& slot : slots_) {
+      if (slot.used && predicate(slot.ssrc, slot.value))
+        to_erase.push_back(slot.ssrc);
+    }
+    for (uint32_t ssrc : to_erase)
+      Erase(ssrc);
+    return to_erase.size();
+  }
+
+  // Calls |function(ssrc, value)| for every entry.
+  template <typename Function>
+  void ForEach(Function function) const {
+    for (const Slot& slot : slots_) {
+      if (slot.used)
+        function(slot.ssrc, slot.value);
+    }
+  }
+
+  void Clear() {
+    slots_.clear();
+    size_ = 0;
+    mask_ = 0;
+    shift_ = 0;
+  }
+
+ private:
+  static constexpr size_t kMinCapacity = 16;
+
+  struct Slot {
+    uint32_t ssrc = 0;
+    bool used = false;
+    V value = V();
+  };
+
+  // Fibonacci hashing. SSRCs are random in theory, but some endpoints assign
+  // them sequentially; the multiplication spreads those over the table.
+  size_t HomeSlot(uint32_t ssrc) const {
+    return static_cast<uint32_t>(ssrc * 2654435769u) >> shift_;
+  }
+  size_t NextSlot(size_t index) const { return (index + 1) & mask_; }
+
+  void Rehash(size_t capacity) {
+    RTC_DCHECK_EQ(capacity & (capacity - 1), 0);
+    std::vector<Slot> old_slots(capacity);
+    old_slots.swap(slots_);
+    mask_ = capacity - 1;
+    shift_ = 32;
+    for (size_t c = capacity; c > 1; c >>= 1)
+      --shift_;
+    size_ = 0;
+    for (Slot& slot : old_slots) {
+      if (slot.used)
+        Emplace(slot.ssrc, std::move(slot.value));
+    }
+  }
+
+  std::vector<Slot> slots_;
+  size_t size_ = 0;
+  size_t mask_ = 0;
+  int shift_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // CALL_FLAT_SSRC_MAP_H_
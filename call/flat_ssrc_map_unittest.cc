@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/flat_ssrc_map.h"
+
+#include <map>
+#include <vector>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+
+TEST(FlatSsrcMapTest, EmptyMap) {
+  FlatSsrcMap<int> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_EQ(nullptr, map.Find(1234));
+  EXPECT_FALSE(map.Erase(1234));
+}
+
+TEST(FlatSsrcMapTest, EmplaceDoesNotOverwrite) {
+  FlatSsrcMap<int> map;
+  auto result = map.Emplace(1234, 1);
+  EXPECT_TRUE(result.second);
+  EXPECT_EQ(1, *result.first);
+
+  result = map.Emplace(1234, 2);
+  EXPECT_FALSE(result.second);
+  EXPECT_EQ(1, *result.first);
+  EXPECT_EQ(1u, map.size());
+
+  map[1234] = 3;
+  ASSERT_NE(nullptr, map.Find(1234));
+  EXPECT_EQ(3, *map.Find(1234));
+}
+
+TEST(FlatSsrcMapTest, EraseIfRemovesMatchingValues) {
+  FlatSsrcMap<int> map;
+  for (uint32_t ssrc = 0; ssrc < 100; ++ssrc)
+    map.Emplace(ssrc, ssrc % 2);
+  EXPECT_EQ(50u, map.EraseIf([](uint32_t ssrc, int value) {
+    return value == 1;
+  }));
+  EXPECT_EQ(50u, map.size());
+  for (uint32_t ssrc = 0; ssrc < 100; ++ssrc)
+    EXPECT_EQ(ssrc % 2 == 0, map.Find(ssrc) != nullptr);
+
+  size_t visited = 0;
+  map.ForEach([&](uint32_t ssrc, int value) {
+    EXPECT_EQ(0u, ssrc % 2);
+    ++visited;
+  });
+  EXPECT_EQ(50u, visited);
+}
+
+// Runs a random sequence of operations on a map with a small SSRC range, so
+// that there are many collisions and wrapping probe sequences, and checks the
+// result against std::map.
+TEST(FlatSsrcMapTest, MatchesStdMap) {
+  FlatSsrcMap<int> map;
+  std::map<uint32_t, int> reference;
+  Random random(0x5eed);
+  for (int i = 0; i < 20000; ++i) {
+    uint32_t ssrc = random.Rand(0, 200) * 0x10000;
+    int operation = random.Rand(0, 2);
+    if (operation == 0) {
+      int value = random.Rand(0, 1000);
+      bool inserted = reference.emplace(ssrc, value).second;
+      EXPECT_EQ(inserted, map.Emplace(ssrc, value).second);
+    } else if (operation == 1) {
+      EXPECT_EQ(reference.erase(ssrc) > 0, map.Erase(ssrc));
+    } else {
+      const auto it = reference.find(ssrc);
+      const int* value = map.Find(ssrc);
+      ASSERT_EQ(it != reference.end(), value != nullptr);
+      if (value)
+        EXPECT_EQ(it->second, *value);
+    }
+    ASSERT_EQ(reference.size(), map.size());
+  }
+  for (const auto& entry : reference) {
+    ASSERT_NE(nullptr, map.Find(entry.first));
+    EXPECT_EQ(entry.second, *map.Find(entry.first));
+  }
+}
+
+// Compares the lookup throughput with std::map, which the RtpDemuxer used
+// before. Run with --gtest_also_run_disabled_tests to get the timings logged.
+class FlatSsrcMapPerfTest : public ::testing::TestWithParam<int> {};
+
+INSTANTIATE_TEST_SUITE_P(NumSinks,
+                         FlatSsrcMapPerfTest,
+                         ::testing::Values(10, 1000, 10000));
+
+TEST_P(FlatSsrcMapPerfTest, DISABLED_LookupPerf) {
+  const int num_sinks = GetParam();
+  const int kLookups = 10000000;
+  Random random(0x1234);
+  std::vector<uint32_t> ssrcs;
+  FlatSsrcMap<int> flat_map;
+  std::map<uint32_t, int> tree_map;
+  for (int i = 0; i < num_sinks; ++i) {
+    uint32_t ssrc = random.Rand<uint32_t>();
+    ssrcs.push_back(ssrc);
+    flat_map.Emplace(ssrc, i);
+    tree_map.emplace(ssrc, i);
+  }
+
+  int64_t sum = 0;
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kLookups; ++i)
+    sum += *flat_map.Find(ssrcs[i % num_sinks]);
+  int64_t flat_us = rtc::TimeMicros() - start_us;
+
+  start_us = rtc::TimeMicros();
+  for (int i = 0; i < kLookups; ++i)
+    sum -= tree_map.find(ssrcs[i % num_sinks])->second;
+  int64_t tree_us = rtc::TimeMicros() - start_us;
+
+  EXPECT_EQ(0, sum);
+  RTC_LOG(LS_INFO) << num_sinks << " sinks: FlatSsrcMap "
+                   << (flat_us * 1000.0) / kLookups << " ns, std::map "
+                   << (tree_us * 1000.0) / kLookups << " ns per lookup";
+}
+
+}  // namespace webrtc
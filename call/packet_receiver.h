@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "api/media_types.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
@@ -32,6 +33,16 @@ class PacketReceiver {
                                        rtc::CopyOnWriteBuffer packet,
                                        int64_t packet_time_us) = 0;
 
+  // Delivers an RTP packet that has already been parsed, e.g. by the RTP
+  // transport for demuxing, so that it doesn't have to be parsed again. The
+  // header extensions are identified anew using the receiving stream's
+  // extension map. The default implementation delivers the serialized packet.
+  virtual DeliveryStatus DeliverRtpPacket(MediaType media_type,
+                                          RtpPacketReceived packet,
+                                          int64_t packet_time_us) {
+    return DeliverPacket(media_type, packet.Buffer(), packet_time_us);
+  }
+
  protected:
   virtual ~PacketReceiver() {}
 };
@@ -83,7 +83,7 @@ bool RtpDemuxer::AddSink(const RtpDemuxerCriteria& criteria,
   }
 
   for (uint32_t ssrc : criteria.ssrcs) {
-    sink_by_ssrc_.emplace(ssrc, sink);
+    sink_by_ssrc_.Emplace(ssrc, sink);
   }
 
   for (uint8_t payload_type : criteria.payload_types) {
@@ -123,7 +123,7 @@ bool RtpDemuxer::CriteriaWouldConflict(
   }
 
   for (uint32_t ssrc : criteria.ssrcs) {
-    if (sink_by_ssrc_.find(ssrc) != sink_by_ssrc_.end()) {
+    if (sink_by_ssrc_.Find(ssrc) != nullptr) {
       return true;
     }
   }
@@ -162,8 +162,12 @@ void RtpDemuxer::AddSink(const std::string& rsid,
 
 bool RtpDemuxer::RemoveSink(const RtpPacketSinkInterface* sink) {
   RTC_DCHECK(sink);
+  auto is_sink = [sink](uint32_t /*ssrc*/,
+                        const RtpPacketSinkInterface* bound_sink) {
+    return bound_sink == sink;
+  };
   size_t num_removed = RemoveFromMapByValue(&sink_by_mid_, sink) +
-                       RemoveFromMapByValue(&sink_by_ssrc_, sink) +
+                       sink_by_ssrc_.EraseIf(is_sink) +
                        RemoveFromMultimapByValue(&sinks_by_pt_, sink) +
                        RemoveFromMapByValue(&sink_by_mid_and_rsid_, sink) +
                        RemoveFromMapByValue(&sink_by_rsid_, sink);
@@ -205,29 +209,29 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
   // there isn't a rule/sink yet because we might add an MID/RSID rule after
   // learning an MID/RSID<->SSRC association.
 
-  std::string* mid = nullptr;
+  const std::string* mid = nullptr;
   if (has_mid) {
-    mid_by_ssrc_[ssrc] = packet_mid;
+    mid_by_ssrc_[ssrc] = InternId(packet_mid);
     mid = &packet_mid;
   } else {
     // If the packet does not include a MID header extension, check if there is
     // a latched MID for the SSRC.
-    const auto it = mid_by_ssrc_.find(ssrc);
-    if (it != mid_by_ssrc_.end()) {
-      mid = &it->second;
+    const int* mid_id = mid_by_ssrc_.Find(ssrc);
+    if (mid_id != nullptr) {
+      mid = &interned_ids_[*mid_id];
     }
   }
 
-  std::string* rsid = nullptr;
+  const std::string* rsid = nullptr;
   if (has_rsid) {
-    rsid_by_ssrc_[ssrc] = packet_rsid;
+    rsid_by_ssrc_[ssrc] = InternId(packet_rsid);
     rsid = &packet_rsid;
   } else {
     // If the packet does not include an RRID/RSID header extension, check if
     // there is a latched RSID for the SSRC.
-    const auto it = rsid_by_ssrc_.find(ssrc);
-    if (it != rsid_by_ssrc_.end()) {
-      rsid = &it->second;
+    const int* rsid_id = rsid_by_ssrc_.Find(ssrc);
+    if (rsid_id != nullptr) {
+      rsid = &interned_ids_[*rsid_id];
     }
   }
 
@@ -270,9 +274,9 @@ RtpPacketSinkInterface* RtpDemuxer::ResolveSink(
 
   // We trust signaled SSRC more than payload type which is likely to conflict
   // between streams.
-  const auto ssrc_sink_it = sink_by_ssrc_.find(ssrc);
-  if (ssrc_sink_it != sink_by_ssrc_.end()) {
-    return ssrc_sink_it->second;
+  RtpPacketSinkInterface* const* ssrc_sink = sink_by_ssrc_.Find(ssrc);
+  if (ssrc_sink != nullptr) {
+    return *ssrc_sink;
   }
 
   // Legacy senders will only signal payload type, support that as last resort.
@@ -366,19 +370,30 @@ bool RtpDemuxer::AddSsrcSinkBinding(uint32_t ssrc,
     return false;
   }
 
-  auto result = sink_by_ssrc_.emplace(ssrc, sink);
-  auto it = result.first;
+  auto result = sink_by_ssrc_.Emplace(ssrc, sink);
+  RtpPacketSinkInterface** bound_sink = result.first;
   bool inserted = result.second;
   if (inserted) {
     return true;
   }
-  if (it->second != sink) {
-    it->second = sink;
+  if (*bound_sink != sink) {
+    *bound_sink = sink;
     return true;
   }
   return false;
 }
 
+int RtpDemuxer::InternId(const std::string& id) {
+  const auto it = interned_id_by_string_.find(id);
+  if (it != interned_id_by_string_.end()) {
+    return it->second;
+  }
+  int index = static_cast<int>(interned_ids_.size());
+  interned_ids_.push_back(id);
+  interned_id_by_string_.emplace(id, index);
+  return index;
+}
+
 void RtpDemuxer::RegisterSsrcBindingObserver(SsrcBindingObserver* observer) {
   RTC_DCHECK(observer);
   RTC_DCHECK(!ContainerHasKey(ssrc_binding_observers_, observer));
@@ -11,12 +11,15 @@
 #ifndef CALL_RTP_DEMUXER_H_
 #define CALL_RTP_DEMUXER_H_
 
+#include <deque>
 #include <map>
 #include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "call/flat_ssrc_map.h"
+
 namespace webrtc {
 
 class RtpPacketReceived;
@@ -179,7 +182,7 @@ class RtpDemuxer {
   // SSRC mapping which receives all MID, payload type, or RSID to SSRC bindings
   // discovered when demuxing packets).
   std::map<std::string, RtpPacketSinkInterface*> sink_by_mid_;
-  std::map<uint32_t, RtpPacketSinkInterface*> sink_by_ssrc_;
+  FlatSsrcMap<RtpPacketSinkInterface*> sink_by_ssrc_;
   std::multimap<uint8_t, RtpPacketSinkInterface*> sinks_by_pt_;
   std::map<std::pair<std::string, std::string>, RtpPacketSinkInterface*>
       sink_by_mid_and_rsid_;
@@ -193,9 +196,20 @@ class RtpDemuxer {
   // Records learned mappings of MID --> SSRC and RSID --> SSRC as packets are
   // received.
   // This is stored separately from the sink mappings because if a sink is
-  // removed we want to still remember these associations.
-  std::map<uint32_t, std::string> mid_by_ssrc_;
-  std::map<uint32_t, std::string> rsid_by_ssrc_;
+  // removed we want to still remember these associations. The values are
+  // indices into |interned_ids_|.
+  FlatSsrcMap<int> mid_by_ssrc_;
+  FlatSsrcMap<int> rsid_by_ssrc_;
+
+  // Returns the index of |id| in |interned_ids_|, adding it if needed.
+  int InternId(const std::string& id);
+
+  // Every MID and RSID that has been latched to an SSRC, stored once so that
+  // latching a new SSRC, or refreshing the latch on every packet carrying the
+  // header extension, does not copy the string. A deque is used since
+  // ResolveSink() holds references to its elements while interning.
+  std::deque<std::string> interned_ids_;
+  std::map<std::string, int> interned_id_by_string_;
 
   // Adds a binding from the SSRC to the given sink. Returns true if there was
   // not already a sink bound to the SSRC or if the sink replaced a different
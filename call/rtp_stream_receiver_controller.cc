@@ -11,17 +11,22 @@
 #include "call/rtp_stream_receiver_controller.h"
 
 #include <memory>
+#include <utility>
 
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/strings/string_builder.h"
 
 namespace webrtc {
 
 RtpStreamReceiverController::Receiver::Receiver(
     RtpStreamReceiverController* controller,
     uint32_t ssrc,
+    uint32_t associated_ssrc,
     RtpPacketSinkInterface* sink)
     : controller_(controller), sink_(sink) {
-  const bool sink_added = controller_->AddSink(ssrc, sink_);
+  const bool sink_added =
+      controller_->AddAssociatedSink(ssrc, associated_ssrc, sink_);
   if (!sink_added) {
     RTC_LOG(LS_ERROR)
         << "RtpStreamReceiverController::Receiver::Receiver: Sink "
@@ -36,10 +41,32 @@ RtpStreamReceiverController::Receiver::~Receiver() {
   controller_->RemoveSink(sink_);
 }
 
-RtpStreamReceiverController::RtpStreamReceiverController() {
+RtpStreamReceiverController::Shard::Shard() {
+  // Each shard only demuxes by SSRC, like the unsharded demuxer.
+  demuxer.set_use_mid(false);
+}
+
+RtpStreamReceiverController::Shard::~Shard() = default;
+
+RtpStreamReceiverController::RtpStreamReceiverController()
+    : RtpStreamReceiverController(nullptr, 0) {}
+
+RtpStreamReceiverController::RtpStreamReceiverController(
+    TaskQueueFactory* task_queue_factory,
+    int num_shards) {
   // At this level the demuxer is only configured to demux by SSRC, so don't
   // worry about MIDs (MIDs are handled by upper layers).
   demuxer_.set_use_mid(false);
+  RTC_DCHECK(num_shards == 0 || task_queue_factory);
+  for (int i = 0; i < num_shards; ++i) {
+    auto shard = std::make_unique<Shard>();
+    rtc::StringBuilder name;
+    name << "RtpReceiveShard" << i;
+    shard->task_queue = std::make_unique<rtc::TaskQueue>(
+        task_queue_factory->CreateTaskQueue(name.str(),
+                                            TaskQueueFactory::Priority::HIGH));
+    shards_.push_back(std::move(shard));
+  }
 }
 
 RtpStreamReceiverController::~RtpStreamReceiverController() = default;
@@ -47,24 +74,89 @@ RtpStreamReceiverController::~RtpStreamReceiverController() = default;
 std::unique_ptr<RtpStreamReceiverInterface>
 RtpStreamReceiverController::CreateReceiver(uint32_t ssrc,
                                             RtpPacketSinkInterface* sink) {
-  return std::make_unique<Receiver>(this, ssrc, sink);
+  return std::make_unique<Receiver>(this, ssrc, ssrc, sink);
+}
+
+std::unique_ptr<RtpStreamReceiverInterface>
+RtpStreamReceiverController::CreateAssociatedReceiver(
+    uint32_t ssrc,
+    uint32_t associated_ssrc,
+    RtpPacketSinkInterface* sink) {
+  return std::make_unique<Receiver>(this, ssrc, associated_ssrc, sink);
 }
 
 bool RtpStreamReceiverController::OnRtpPacket(const RtpPacketReceived& packet) {
   rtc::CritScope cs(&lock_);
-  return demuxer_.OnRtpPacket(packet);
+  if (shards_.empty())
+    return demuxer_.OnRtpPacket(packet);
+
+  const ShardBinding* binding = shard_by_ssrc_.Find(packet.Ssrc());
+  if (!binding)
+    return false;
+  // The copy shares the packet buffer, it does not copy the payload.
+  Shard* shard = shards_[binding->shard].get();
+  shard->task_queue->PostTask([shard, packet]() {
+    rtc::CritScope cs(&shard->lock);
+    shard->demuxer.OnRtpPacket(packet);
+  });
+  return true;
 }
 
 bool RtpStreamReceiverController::AddSink(uint32_t ssrc,
                                           RtpPacketSinkInterface* sink) {
-  rtc::CritScope cs(&lock_);
-  return demuxer_.AddSink(ssrc, sink);
+  return AddAssociatedSink(ssrc, ssrc, sink);
+}
+
+bool RtpStreamReceiverController::AddAssociatedSink(
+    uint32_t ssrc,
+    uint32_t associated_ssrc,
+    RtpPacketSinkInterface* sink) {
+  Shard* shard;
+  {
+    rtc::CritScope cs(&lock_);
+    if (shards_.empty())
+      return demuxer_.AddSink(ssrc, sink);
+
+    ShardBinding binding;
+    binding.shard = ShardForSsrc(associated_ssrc);
+    binding.sink = sink;
+    if (!shard_by_ssrc_.Emplace(ssrc, binding).second)
+      return false;
+    shard = shards_[binding.shard].get();
+  }
+  // Shard locks are never taken while holding |lock_|, since sinks running on
+  // a shard may call back into OnRtpPacket(), e.g. with recovered packets.
+  rtc::CritScope shard_cs(&shard->lock);
+  return shard->demuxer.AddSink(ssrc, sink);
 }
 
 size_t RtpStreamReceiverController::RemoveSink(
     const RtpPacketSinkInterface* sink) {
-  rtc::CritScope cs(&lock_);
-  return demuxer_.RemoveSink(sink);
+  {
+    rtc::CritScope cs(&lock_);
+    if (shards_.empty())
+      return demuxer_.RemoveSink(sink);
+
+    shard_by_ssrc_.EraseIf(
+        [sink](uint32_t /*ssrc*/, const ShardBinding& binding) {
+          return binding.sink == sink;
+        });
+  }
+  // Taking the shard lock waits for any delivery to |sink| in progress.
+  // Packets that are still queued will find no sink and be dropped.
+  size_t num_removed = 0;
+  for (const auto& shard : shards_) {
+    rtc::CritScope shard_cs(&shard->lock);
+    num_removed += shard->demuxer.RemoveSink(sink);
+  }
+  return num_removed;
+}
+
+size_t RtpStreamReceiverController::ShardForSsrc(uint32_t ssrc) const {
+  const ShardBinding* binding = shard_by_ssrc_.Find(ssrc);
+  if (binding)
+    return binding->shard;
+  return ssrc % shards_.size();
 }
 
 }  // namespace webrtc
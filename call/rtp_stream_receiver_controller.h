@@ -11,10 +11,14 @@
 #define CALL_RTP_STREAM_RECEIVER_CONTROLLER_H_
 
 #include <memory>
+#include <vector>
 
+#include "api/task_queue/task_queue_factory.h"
+#include "call/flat_ssrc_map.h"
 #include "call/rtp_demuxer.h"
 #include "call/rtp_stream_receiver_controller_interface.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
@@ -30,18 +34,31 @@ class RtpStreamReceiverController
     : public RtpStreamReceiverControllerInterface {
  public:
   RtpStreamReceiverController();
+  // If |num_shards| is greater than zero, sinks are spread over that many
+  // task queues by SSRC, and OnRtpPacket() hands each packet over to the queue
+  // owning its SSRC instead of calling the sink directly. All packets for one
+  // SSRC, and for SSRCs associated with it, are delivered on the same queue
+  // and in order. A sink never gets packets after RemoveSink() returns.
+  RtpStreamReceiverController(TaskQueueFactory* task_queue_factory,
+                              int num_shards);
   ~RtpStreamReceiverController() override;
 
   // Implements RtpStreamReceiverControllerInterface.
   std::unique_ptr<RtpStreamReceiverInterface> CreateReceiver(
       uint32_t ssrc,
       RtpPacketSinkInterface* sink) override;
+  std::unique_ptr<RtpStreamReceiverInterface> CreateAssociatedReceiver(
+      uint32_t ssrc,
+      uint32_t associated_ssrc,
+      RtpPacketSinkInterface* sink) override;
 
   // Thread-safe wrappers for the corresponding RtpDemuxer methods.
   bool AddSink(uint32_t ssrc, RtpPacketSinkInterface* sink) override;
   size_t RemoveSink(const RtpPacketSinkInterface* sink) override;
 
   // TODO(nisse): Not yet responsible for parsing.
+  // When sharded, returns true if the packet was handed over to a shard; the
+  // sink may still drop it if it is removed in the meantime.
   bool OnRtpPacket(const RtpPacketReceived& packet);
 
  private:
@@ -49,6 +66,7 @@ class RtpStreamReceiverController
    public:
     Receiver(RtpStreamReceiverController* controller,
              uint32_t ssrc,
+             uint32_t associated_ssrc,
              RtpPacketSinkInterface* sink);
 
     ~Receiver() override;
@@ -65,6 +83,31 @@ class RtpStreamReceiverController
   // using Call may have use threads differently.
   rtc::CriticalSection lock_;
   RtpDemuxer demuxer_ RTC_GUARDED_BY(&lock_);
+
+  // A task queue delivering packets to the sinks of a subset of the SSRCs.
+  struct Shard {
+    Shard();
+    ~Shard();
+
+    rtc::CriticalSection lock;
+    RtpDemuxer demuxer RTC_GUARDED_BY(&lock);
+    // Destroyed first, so that no task is running while the demuxer goes.
+    std::unique_ptr<rtc::TaskQueue> task_queue;
+  };
+
+  struct ShardBinding {
+    size_t shard = 0;
+    RtpPacketSinkInterface* sink = nullptr;
+  };
+
+  bool AddAssociatedSink(uint32_t ssrc,
+                         uint32_t associated_ssrc,
+                         RtpPacketSinkInterface* sink);
+  size_t ShardForSsrc(uint32_t ssrc) const RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Empty unless sharding is used, in which case |demuxer_| is unused.
+  std::vector<std::unique_ptr<Shard>> shards_;
+  FlatSsrcMap<ShardBinding> shard_by_ssrc_ RTC_GUARDED_BY(&lock_);
 };
 
 }  // namespace webrtc
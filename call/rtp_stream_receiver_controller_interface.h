@@ -37,6 +37,14 @@ class RtpStreamReceiverControllerInterface {
   virtual std::unique_ptr<RtpStreamReceiverInterface> CreateReceiver(
       uint32_t ssrc,
       RtpPacketSinkInterface* sink) = 0;
+  // Like CreateReceiver(), but packets for |ssrc| are delivered on the same
+  // thread as packets for |associated_ssrc|, if the controller delivers
+  // packets on multiple threads. Used for RTX streams, whose sink forwards
+  // packets to the sink of the associated media stream.
+  virtual std::unique_ptr<RtpStreamReceiverInterface> CreateAssociatedReceiver(
+      uint32_t ssrc,
+      uint32_t associated_ssrc,
+      RtpPacketSinkInterface* sink) = 0;
   // For registering additional sinks, needed for FlexFEC.
   virtual bool AddSink(uint32_t ssrc, RtpPacketSinkInterface* sink) = 0;
   virtual size_t RemoveSink(const RtpPacketSinkInterface* sink) = 0;
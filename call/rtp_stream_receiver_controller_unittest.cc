@@ -0,0 +1,136 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "call/rtp_stream_receiver_controller.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumShards = 4;
+constexpr int kWaitMs = 5000;
+
+// Records on which task queue, and in which order, packets arrive.
+class RecordingSink : public RtpPacketSinkInterface {
+ public:
+  explicit RecordingSink(size_t expected_packets)
+      : expected_packets_(expected_packets) {}
+
+  void OnRtpPacket(const RtpPacketReceived& packet) override {
+    rtc::CritScope cs(&lock_);
+    queues_.push_back(TaskQueueBase::Current());
+    sequence_numbers_.push_back(packet.SequenceNumber());
+    if (sequence_numbers_.size() == expected_packets_)
+      done_.Set();
+  }
+
+  bool Wait() { return done_.Wait(kWaitMs); }
+
+  std::vector<TaskQueueBase*> queues() const {
+    rtc::CritScope cs(&lock_);
+    return queues_;
+  }
+  std::vector<uint16_t> sequence_numbers() const {
+    rtc::CritScope cs(&lock_);
+    return sequence_numbers_;
+  }
+
+ private:
+  const size_t expected_packets_;
+  rtc::CriticalSection lock_;
+  rtc::Event done_;
+  std::vector<TaskQueueBase*> queues_ RTC_GUARDED_BY(lock_);
+  std::vector<uint16_t> sequence_numbers_ RTC_GUARDED_BY(lock_);
+};
+
+RtpPacketReceived CreatePacket(uint32_t ssrc, uint16_t sequence_number) {
+  RtpPacketReceived packet;
+  packet.SetSsrc(ssrc);
+  packet.SetSequenceNumber(sequence_number);
+  return packet;
+}
+
+}  // namespace
+
+TEST(RtpStreamReceiverControllerTest, UnshardedDeliversSynchronously) {
+  RtpStreamReceiverController controller;
+  RecordingSink sink(1);
+  auto receiver = controller.CreateReceiver(1111, &sink);
+
+  EXPECT_TRUE(controller.OnRtpPacket(CreatePacket(1111, 1)));
+  EXPECT_FALSE(controller.OnRtpPacket(CreatePacket(2222, 1)));
+  ASSERT_EQ(1u, sink.sequence_numbers().size());
+  EXPECT_EQ(nullptr, sink.queues()[0]);
+}
+
+TEST(RtpStreamReceiverControllerTest, ShardedDeliversInOrderOnOneQueue) {
+  std::unique_ptr<TaskQueueFactory> factory = CreateDefaultTaskQueueFactory();
+  RtpStreamReceiverController controller(factory.get(), kNumShards);
+  const uint16_t kNumPackets = 100;
+  RecordingSink sink(kNumPackets);
+  auto receiver = controller.CreateReceiver(1111, &sink);
+
+  EXPECT_FALSE(controller.OnRtpPacket(CreatePacket(2222, 1)));
+  for (uint16_t i = 0; i < kNumPackets; ++i)
+    EXPECT_TRUE(controller.OnRtpPacket(CreatePacket(1111, i)));
+  ASSERT_TRUE(sink.Wait());
+
+  std::vector<uint16_t> sequence_numbers = sink.sequence_numbers();
+  std::vector<TaskQueueBase*> queues = sink.queues();
+  ASSERT_EQ(kNumPackets, sequence_numbers.size());
+  for (uint16_t i = 0; i < kNumPackets; ++i) {
+    EXPECT_EQ(i, sequence_numbers[i]);
+    EXPECT_NE(nullptr, queues[i]);
+    EXPECT_EQ(queues[0], queues[i]);
+  }
+}
+
+TEST(RtpStreamReceiverControllerTest, AssociatedReceiverUsesSameQueue) {
+  std::unique_ptr<TaskQueueFactory> factory = CreateDefaultTaskQueueFactory();
+  RtpStreamReceiverController controller(factory.get(), kNumShards);
+  RecordingSink media_sink(1);
+  RecordingSink rtx_sink(1);
+  // With SSRCs modulo the number of shards picking the shard, these two would
+  // otherwise end up on different queues.
+  auto media_receiver = controller.CreateReceiver(1000, &media_sink);
+  auto rtx_receiver =
+      controller.CreateAssociatedReceiver(1001, 1000, &rtx_sink);
+
+  EXPECT_TRUE(controller.OnRtpPacket(CreatePacket(1000, 1)));
+  EXPECT_TRUE(controller.OnRtpPacket(CreatePacket(1001, 1)));
+  ASSERT_TRUE(media_sink.Wait());
+  ASSERT_TRUE(rtx_sink.Wait());
+  EXPECT_EQ(media_sink.queues()[0], rtx_sink.queues()[0]);
+}
+
+TEST(RtpStreamReceiverControllerTest, ShardedNoDeliveryAfterRemoval) {
+  std::unique_ptr<TaskQueueFactory> factory = CreateDefaultTaskQueueFactory();
+  RtpStreamReceiverController controller(factory.get(), kNumShards);
+  RecordingSink sink(1);
+  auto receiver = controller.CreateReceiver(1111, &sink);
+  EXPECT_TRUE(controller.OnRtpPacket(CreatePacket(1111, 1)));
+  ASSERT_TRUE(sink.Wait());
+
+  receiver = nullptr;
+  EXPECT_FALSE(controller.OnRtpPacket(CreatePacket(1111, 2)));
+  EXPECT_EQ(1u, sink.sequence_numbers().size());
+}
+
+}  // namespace webrtc
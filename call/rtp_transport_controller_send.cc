@@ -9,6 +9,7 @@
  */
 #include "call/rtp_transport_controller_send.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -82,6 +83,8 @@ RtpTransportControllerSend::RtpTransportControllerSend(
           webrtc::field_trial::IsEnabled("WebRTC-SendSideBwe-WithOverhead")),
       add_pacing_to_cwin_(
           field_trial::IsEnabled("WebRTC-AddPacingToCongestionWindowPushback")),
+      use_route_state_cache_(
+          field_trial::IsEnabled("WebRTC-Bwe-RouteStateCache")),
       transport_overhead_bytes_per_packet_(0),
       network_available_(false),
       retransmission_rate_limiter_(clock, kRetransmitWindowSizeMs),
@@ -236,6 +239,14 @@ void RtpTransportControllerSend::OnNetworkRouteChanged(
   bool inserted = result.second;
   if (inserted) {
     // No need to reset BWE if this is the first time the network connects.
+    if (use_route_state_cache_) {
+      Timestamp now = Timestamp::ms(clock_->TimeInMilliseconds());
+      task_queue_.PostTask([this, network_route, now] {
+        RTC_DCHECK_RUN_ON(&task_queue_);
+        route_state_cache_.OnRouteChange(network_route.local_network_id,
+                                         network_route.remote_network_id, now);
+      });
+    }
     return;
   }
   if (kv->second.connected != network_route.connected ||
@@ -267,10 +278,38 @@ void RtpTransportControllerSend::OnNetworkRouteChanged(
     NetworkRouteChange msg;
     msg.at_time = Timestamp::ms(clock_->TimeInMilliseconds());
     msg.constraints = ConvertConstraints(bitrate_config, clock_);
-    task_queue_.PostTask([this, msg] {
+    task_queue_.PostTask([this, msg, network_route]() mutable {
       RTC_DCHECK_RUN_ON(&task_queue_);
+      absl::optional<RouteStateCache::RouteState> cached_state;
+      if (use_route_state_cache_) {
+        cached_state =
+            route_state_cache_.GetState(network_route.local_network_id,
+                                        network_route.remote_network_id,
+                                        msg.at_time);
+        route_state_cache_.OnRouteChange(network_route.local_network_id,
+                                         network_route.remote_network_id,
+                                         msg.at_time);
+      }
+      if (cached_state) {
+        TargetRateConstraints& constraints = msg.constraints;
+        DataRate starting_rate = cached_state->target_rate;
+        if (constraints.min_data_rate)
+          starting_rate = std::max(starting_rate, *constraints.min_data_rate);
+        if (constraints.max_data_rate)
+          starting_rate = std::min(starting_rate, *constraints.max_data_rate);
+        RTC_LOG(LS_INFO) << "Switched back to a recently used route, starting "
+                         << "at " << ToString(starting_rate) << ".";
+        constraints.starting_rate = starting_rate;
+      }
       if (controller_) {
         PostUpdates(controller_->OnNetworkRouteChange(msg));
+        if (cached_state && cached_state->round_trip_time.IsFinite()) {
+          RoundTripTimeUpdate rtt_update;
+          rtt_update.receive_time = msg.at_time;
+          rtt_update.round_trip_time = cached_state->round_trip_time;
+          rtt_update.smoothed = false;
+          PostUpdates(controller_->OnRoundTripTimeUpdate(rtt_update));
+        }
       } else {
         UpdateInitialConstraints(msg.constraints);
       }
@@ -470,6 +509,12 @@ void RtpTransportControllerSend::OnTransportFeedback(
       transport_feedback_adapter_.GetOutstandingData());
 }
 
+void RtpTransportControllerSend::OnEcnFeedback(
+    const rtcp::EcnFeedback& feedback) {
+  RTC_DCHECK_RUNS_SERIALIZED(&worker_race_);
+  transport_feedback_adapter_.ProcessEcnFeedback(feedback);
+}
+
 void RtpTransportControllerSend::OnRemoteNetworkEstimate(
     NetworkStateEstimate estimate) {
   if (event_log_) {
@@ -562,11 +607,14 @@ void RtpTransportControllerSend::PostUpdates(NetworkControlUpdate update) {
   if (update.pacer_config) {
     pacer()->SetPacingRates(update.pacer_config->data_rate(),
                             update.pacer_config->pad_rate());
+    pacer()->SetSendQuantum(update.pacer_config->send_quantum);
   }
   for (const auto& probe : update.probe_cluster_configs) {
     pacer()->CreateProbeCluster(probe.target_data_rate, probe.id);
   }
   if (update.target_rate) {
+    if (use_route_state_cache_)
+      route_state_cache_.OnTargetRate(*update.target_rate);
     control_handler_->SetTargetRate(*update.target_rate);
     UpdateControlState();
   }
@@ -763,6 +763,17 @@ uint32_t RtpVideoSender::GetProtectionBitrateBps() const {
   return protection_bitrate_bps_;
 }
 
+RtpPacketHistoryStats RtpVideoSender::GetPacketHistoryStats() const {
+  RtpPacketHistoryStats stats;
+  for (const RtpStreamSender& stream : rtp_streams_) {
+    RtpPacketHistoryStats stream_stats =
+        stream.rtp_rtcp->GetPacketHistoryStats();
+    stats.stored_bytes += stream_stats.stored_bytes;
+    stats.max_packets += stream_stats.max_packets;
+  }
+  return stats;
+}
+
 std::vector<RtpSequenceNumberMap::Info> RtpVideoSender::GetSentRtpPacketInfos(
     uint32_t ssrc,
     rtc::ArrayView<const uint16_t> sequence_numbers) const {
@@ -63,6 +63,9 @@ std::string VideoReceiveStream::Stats::ToString(int64_t time_ms) const {
   ss << "nack: " << rtcp_packet_type_counts.nack_packets << ", ";
   ss << "fir: " << rtcp_packet_type_counts.fir_packets << ", ";
   ss << "pli: " << rtcp_packet_type_counts.pli_packets;
+  if (capture_to_render_delay_ms) {
+    ss << ", capture_to_render_delay_ms: " << *capture_to_render_delay_ms;
+  }
   ss << '}';
   return ss.str();
 }
@@ -93,6 +96,8 @@ std::string VideoReceiveStream::Config::ToString() const {
   ss << ", rtp: " << rtp.ToString();
   ss << ", renderer: " << (renderer ? "(renderer)" : "nullptr");
   ss << ", render_delay_ms: " << render_delay_ms;
+  if (low_latency_rendering)
+    ss << ", low_latency_rendering: true";
   if (!sync_group.empty())
     ss << ", sync_group: " << sync_group;
   ss << ", target_delay_ms: " << target_delay_ms;
@@ -25,6 +25,7 @@
 #include "api/transport/media/media_transport_config.h"
 #include "api/transport/media/media_transport_interface.h"
 #include "api/transport/rtp/rtp_source.h"
+#include "api/video/encoded_image.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -36,6 +37,7 @@
 
 namespace webrtc {
 
+struct CodecSpecificInfo;
 class RtpPacketSinkInterface;
 class VideoDecoderFactory;
 
@@ -120,6 +122,29 @@ class VideoReceiveStream {
     // Timing frame info: all important timestamps for a full lifetime of a
     // single 'timing frame'.
     absl::optional<webrtc::TimingFrameInfo> timing_frame_info;
+
+    // Glass-to-glass delay of the last rendered frame, from its capture to
+    // the moment it was handed to the renderer. Measured from the absolute
+    // capture time header extension when the sender provides it, which
+    // assumes that the sender's and receiver's NTP clocks agree, and from the
+    // RTCP based capture time estimate otherwise.
+    absl::optional<int64_t> capture_to_render_delay_ms;
+    // Sum of the above over all rendered frames it could be measured for.
+    uint64_t total_capture_to_render_delay_ms = 0;
+    uint32_t capture_to_render_delay_count = 0;
+  };
+
+  // Receives the complete encoded frames of a stream, in decode order, e.g. to
+  // forward them to a VideoSendStream without transcoding. Called on the
+  // decode queue.
+  class EncodedFrameSink {
+   public:
+    virtual void OnEncodedFrame(
+        const EncodedImage& encoded_image,
+        const CodecSpecificInfo& codec_specific_info) = 0;
+
+   protected:
+    virtual ~EncodedFrameSink() = default;
   };
 
   struct Config {
@@ -222,6 +247,13 @@ class VideoReceiveStream {
     // available.
     bool enable_prerenderer_smoothing = true;
 
+    // If true, frames are decoded as soon as they are decodable and rendered
+    // right away instead of being scheduled to a render time. The jitter
+    // estimate is then only used to skip frames that have been waiting for
+    // longer than the target delay. Implies no prerenderer smoothing and
+    // disables audio/video synchronization of the stream.
+    bool low_latency_rendering = false;
+
     // Identifier for an A/V synchronization group. Empty string to disable.
     // TODO(pbos): Synchronize streams in a sync group, not just video streams
     // to one of the audio streams.
@@ -242,6 +274,13 @@ class VideoReceiveStream {
 
     // Per PeerConnection cryptography options.
     CryptoOptions crypto_options;
+
+    // If set, receives every frame before it is decoded.
+    EncodedFrameSink* encoded_frame_sink = nullptr;
+
+    // If false, frames are passed to |encoded_frame_sink| only, and are not
+    // decoded nor rendered, e.g. on a relay that only forwards them.
+    bool decode_frames = true;
   };
 
   // Starts stream activity.
@@ -277,6 +316,15 @@ class VideoReceiveStream {
   virtual void SetFrameDecryptor(
       rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor) = 0;
 
+  // Favors decoding this stream over the other streams that share its decode
+  // threads, e.g. when it shows the active speaker. Only has an effect when
+  // Call::Config::num_video_decode_threads is set.
+  virtual void SetDecodePrioritized(bool prioritized) {}
+
+  // Asks the sender for a key frame, e.g. when a receiver of the frames
+  // forwarded from this stream needs one.
+  virtual void GenerateKeyFrame() {}
+
  protected:
   virtual ~VideoReceiveStream() {}
 };
@@ -22,6 +22,7 @@
 #include "api/crypto/crypto_options.h"
 #include "api/rtp_parameters.h"
 #include "api/transport/media/media_transport_interface.h"
+#include "api/video/encoded_image.h"
 #include "api/video/video_content_type.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
@@ -36,6 +37,8 @@
 
 namespace webrtc {
 
+struct CodecSpecificInfo;
+
 class FrameEncryptorInterface;
 
 class VideoSendStream {
@@ -110,6 +113,19 @@ class VideoSendStream {
     webrtc::VideoContentType content_type =
         webrtc::VideoContentType::UNSPECIFIED;
     uint32_t huge_frames_sent = 0;
+    // Memory used by the packets stored for retransmission, and the maximum
+    // number of stored packets, summed over the RTP streams.
+    size_t rtp_packet_history_bytes = 0;
+    size_t rtp_packet_history_max_packets = 0;
+  };
+
+  // Notified when a receiver of the stream asks for a key frame.
+  class KeyFrameRequestObserver {
+   public:
+    virtual void OnKeyFrameRequested() = 0;
+
+   protected:
+    virtual ~KeyFrameRequestObserver() = default;
   };
 
   struct Config {
@@ -166,6 +182,11 @@ class VideoSendStream {
     // Per PeerConnection cryptography options.
     CryptoOptions crypto_options;
 
+    // If set, is told about key frame requests as well as the encoder. Set
+    // when forwarding frames with SendEncodedFrame(), to ask the source of the
+    // frames for a key frame, e.g. with VideoReceiveStream::GenerateKeyFrame().
+    KeyFrameRequestObserver* key_frame_request_observer = nullptr;
+
    private:
     // Access to the copy constructor is private to force use of the Copy()
     // method for those exceptional cases where we do use it.
@@ -200,6 +221,13 @@ class VideoSendStream {
 
   virtual Stats GetStats() = 0;
 
+  // Packetizes and sends |encoded_image| as if the encoder had produced it,
+  // e.g. to forward the frames of a VideoReceiveStream without transcoding
+  // them. The layer structure in |codec_specific_info| is kept. No source
+  // should be set while forwarding. May be called on any thread.
+  virtual void SendEncodedFrame(const EncodedImage& encoded_image,
+                                const CodecSpecificInfo& codec_specific_info) {}
+
  protected:
   virtual ~VideoSendStream() {}
 };
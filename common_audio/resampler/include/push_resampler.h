@@ -18,8 +18,8 @@ namespace webrtc {
 
 class PushSincResampler;
 
-// Wraps PushSincResampler to provide stereo support.
-// TODO(ajm): add support for an arbitrary number of channels.
+// Wraps PushSincResampler to provide multichannel support. Stereo is resampled
+// interleaved in one pass, other channel counts one channel at a time.
 template <typename T>
 class PushResampler {
  public:
@@ -48,6 +48,8 @@ class PushResampler {
   };
 
   std::vector<ChannelResampler> channel_resamplers_;
+  // Used instead of |channel_resamplers_| for stereo.
+  std::unique_ptr<PushSincResampler> interleaved_resampler_;
 };
 }  // namespace webrtc
 
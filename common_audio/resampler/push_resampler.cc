@@ -91,6 +91,12 @@ int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
   const size_t dst_size_10ms_mono =
       static_cast<size_t>(dst_sample_rate_hz / 100);
   channel_resamplers_.clear();
+  interleaved_resampler_.reset();
+  if (num_channels == 2) {
+    interleaved_resampler_ = std::make_unique<PushSincResampler>(
+        src_size_10ms_mono, dst_size_10ms_mono, num_channels);
+    return 0;
+  }
   for (size_t i = 0; i < num_channels; ++i) {
     channel_resamplers_.push_back(ChannelResampler());
     auto channel_resampler = channel_resamplers_.rbegin();
@@ -118,6 +124,11 @@ int PushResampler<T>::Resample(const T* src,
     return static_cast<int>(src_length);
   }
 
+  if (interleaved_resampler_) {
+    return static_cast<int>(interleaved_resampler_->Resample(
+        src, src_length, dst, dst_capacity));
+  }
+
   const size_t src_length_mono = src_length / num_channels_;
   const size_t dst_capacity_mono = dst_capacity / num_channels_;
 
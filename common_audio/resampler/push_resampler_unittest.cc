@@ -10,7 +10,10 @@
 
 #include "common_audio/resampler/include/push_resampler.h"
 
+#include <vector>
+
 #include "rtc_base/checks.h"  // RTC_DCHECK_IS_ON
+#include "rtc_base/random.h"
 #include "test/gtest.h"
 
 // Quality testing of PushResampler is handled through output_mixer_unittest.cc.
@@ -50,4 +53,46 @@ TEST(PushResamplerTest, VerifiesBadInputParameters3) {
 #endif
 #endif
 
+// Stereo is resampled interleaved, which must give the same output as
+// resampling each channel on its own.
+TEST(PushResamplerTest, StereoMatchesMono) {
+  const int kSrcRate = 44100;
+  const int kDstRate = 48000;
+  const size_t kSrcFrames = kSrcRate / 100;
+  const size_t kDstFrames = kDstRate / 100;
+  PushResampler<float> stereo_resampler;
+  PushResampler<float> left_resampler;
+  PushResampler<float> right_resampler;
+  ASSERT_EQ(0, stereo_resampler.InitializeIfNeeded(kSrcRate, kDstRate, 2));
+  ASSERT_EQ(0, left_resampler.InitializeIfNeeded(kSrcRate, kDstRate, 1));
+  ASSERT_EQ(0, right_resampler.InitializeIfNeeded(kSrcRate, kDstRate, 1));
+
+  Random random(42);
+  std::vector<float> stereo_src(2 * kSrcFrames);
+  std::vector<float> left_src(kSrcFrames);
+  std::vector<float> right_src(kSrcFrames);
+  std::vector<float> stereo_dst(2 * kDstFrames);
+  std::vector<float> left_dst(kDstFrames);
+  std::vector<float> right_dst(kDstFrames);
+  for (int block = 0; block < 10; ++block) {
+    for (size_t i = 0; i < kSrcFrames; ++i) {
+      left_src[i] = random.Rand(-32768, 32767);
+      right_src[i] = random.Rand(-32768, 32767);
+      stereo_src[2 * i] = left_src[i];
+      stereo_src[2 * i + 1] = right_src[i];
+    }
+    ASSERT_EQ(static_cast<int>(2 * kDstFrames),
+              stereo_resampler.Resample(stereo_src.data(), stereo_src.size(),
+                                        stereo_dst.data(), stereo_dst.size()));
+    left_resampler.Resample(left_src.data(), kSrcFrames, left_dst.data(),
+                            kDstFrames);
+    right_resampler.Resample(right_src.data(), kSrcFrames, right_dst.data(),
+                             kDstFrames);
+    for (size_t i = 0; i < kDstFrames; ++i) {
+      ASSERT_EQ(left_dst[i], stereo_dst[2 * i]);
+      ASSERT_EQ(right_dst[i], stereo_dst[2 * i + 1]);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -31,13 +31,19 @@ class PushSincResampler : public SincResamplerCallback {
   // must correspond to the same time duration (typically 10 ms) as the sample
   // ratio is inferred from them.
   PushSincResampler(size_t source_frames, size_t destination_frames);
+  // Like above, for |num_channels| interleaved channels. The block sizes are
+  // still given per channel.
+  PushSincResampler(size_t source_frames,
+                    size_t destination_frames,
+                    size_t num_channels);
   ~PushSincResampler() override;
 
   // Perform the resampling. |source_frames| must always equal the
-  // |source_frames| provided at construction. |destination_capacity| must be
-  // at least as large as |destination_frames|. Returns the number of samples
-  // provided in destination (for convenience, since this will always be equal
-  // to |destination_frames|).
+  // |source_frames| provided at construction times the number of channels.
+  // |destination_capacity| must be at least as large as |destination_frames|
+  // times the number of channels. Returns the number of samples provided in
+  // destination (for convenience, since this will always be equal to
+  // |destination_frames| times the number of channels).
   size_t Resample(const int16_t* source,
                   size_t source_frames,
                   int16_t* destination,
@@ -66,6 +72,7 @@ class PushSincResampler : public SincResamplerCallback {
   const float* source_ptr_;
   const int16_t* source_ptr_int_;
   const size_t destination_frames_;
+  const size_t num_channels_;
 
   // True on the first call to Resample(), to prime the SincResampler buffer.
   bool first_pass_;
@@ -81,6 +81,9 @@
 //
 // Note: we're glossing over how the sub-sample handling works with
 // |virtual_source_idx_|, etc.
+//
+// With more than one channel the buffer holds interleaved frames, and all the
+// sizes above are in frames.
 
 // MSVC++ requires this to be set before any other includes to get M_PI.
 #define _USE_MATH_DEFINES
@@ -123,54 +126,77 @@ const size_t SincResampler::kKernelSize;
 
 // If we know the minimum architecture at compile time, avoid CPU detection.
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-#if defined(__SSE2__)
-#define CONVOLVE_FUNC Convolve_SSE
-void SincResampler::InitializeCPUSpecificFeatures() {}
-#else
-// x86 CPU detection required.  Function will be set by
+// x86 CPU detection required for AVX2.  Functions will be set by
 // InitializeCPUSpecificFeatures().
-// TODO(dalecurtis): Once Chrome moves to an SSE baseline this can be removed.
 #define CONVOLVE_FUNC convolve_proc_
+#define CONVOLVE_STEREO_FUNC convolve_stereo_proc_
 
 void SincResampler::InitializeCPUSpecificFeatures() {
-  convolve_proc_ = WebRtc_GetCPUInfo(kSSE2) ? Convolve_SSE : Convolve_C;
-}
+#if defined(__SSE2__)
+  const bool has_sse2 = true;
+#else
+  // TODO(dalecurtis): Once Chrome moves to an SSE baseline this can be removed.
+  const bool has_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
 #endif
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+    convolve_proc_ = Convolve_AVX2;
+    convolve_stereo_proc_ = ConvolveStereo_AVX2;
+  } else if (has_sse2) {
+    convolve_proc_ = Convolve_SSE;
+    convolve_stereo_proc_ = ConvolveStereo_SSE;
+  } else {
+    convolve_proc_ = Convolve_C;
+    convolve_stereo_proc_ = ConvolveStereo_C;
+  }
+}
 #elif defined(WEBRTC_HAS_NEON)
 #define CONVOLVE_FUNC Convolve_NEON
+#define CONVOLVE_STEREO_FUNC ConvolveStereo_C
 void SincResampler::InitializeCPUSpecificFeatures() {}
 #else
 // Unknown architecture.
 #define CONVOLVE_FUNC Convolve_C
+#define CONVOLVE_STEREO_FUNC ConvolveStereo_C
 void SincResampler::InitializeCPUSpecificFeatures() {}
 #endif
 
 SincResampler::SincResampler(double io_sample_rate_ratio,
                              size_t request_frames,
                              SincResamplerCallback* read_cb)
+    : SincResampler(io_sample_rate_ratio, request_frames, read_cb, 1) {}
+
+SincResampler::SincResampler(double io_sample_rate_ratio,
+                             size_t request_frames,
+                             SincResamplerCallback* read_cb,
+                             size_t num_channels)
     : io_sample_rate_ratio_(io_sample_rate_ratio),
       read_cb_(read_cb),
       request_frames_(request_frames),
-      input_buffer_size_(request_frames_ + kKernelSize),
-      // Create input buffers with a 16-byte alignment for SSE optimizations.
+      num_channels_(num_channels),
+      input_buffer_size_((request_frames_ + kKernelSize) * num_channels_),
+      // Create input buffers with a 16-byte alignment for SSE optimizations,
+      // and the kernels with a 32-byte alignment for AVX2.
       kernel_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 16))),
+          AlignedMalloc(sizeof(float) * kKernelStorageSize, 32))),
       kernel_pre_sinc_storage_(static_cast<float*>(
           AlignedMalloc(sizeof(float) * kKernelStorageSize, 16))),
       kernel_window_storage_(static_cast<float*>(
           AlignedMalloc(sizeof(float) * kKernelStorageSize, 16))),
       input_buffer_(static_cast<float*>(
           AlignedMalloc(sizeof(float) * input_buffer_size_, 16))),
-#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(__SSE2__)
+#if defined(WEBRTC_ARCH_X86_FAMILY)
       convolve_proc_(nullptr),
+      convolve_stereo_proc_(nullptr),
 #endif
       r1_(input_buffer_.get()),
-      r2_(input_buffer_.get() + kKernelSize / 2) {
-#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(__SSE2__)
+      r2_(input_buffer_.get() + kKernelSize / 2 * num_channels_) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
   InitializeCPUSpecificFeatures();
   RTC_DCHECK(convolve_proc_);
+  RTC_DCHECK(convolve_stereo_proc_);
 #endif
   RTC_DCHECK_GT(request_frames_, 0);
+  RTC_DCHECK_GT(num_channels_, 0);
   Flush();
   RTC_DCHECK_GT(block_size_, kKernelSize);
 
@@ -189,10 +215,11 @@ SincResampler::~SincResampler() {}
 void SincResampler::UpdateRegions(bool second_load) {
   // Setup various region pointers in the buffer (see diagram above).  If we're
   // on the second load we need to slide r0_ to the right by kKernelSize / 2.
-  r0_ = input_buffer_.get() + (second_load ? kKernelSize : kKernelSize / 2);
-  r3_ = r0_ + request_frames_ - kKernelSize;
-  r4_ = r0_ + request_frames_ - kKernelSize / 2;
-  block_size_ = r4_ - r2_;
+  r0_ = input_buffer_.get() +
+        (second_load ? kKernelSize : kKernelSize / 2) * num_channels_;
+  r3_ = r0_ + (request_frames_ - kKernelSize) * num_channels_;
+  r4_ = r0_ + (request_frames_ - kKernelSize / 2) * num_channels_;
+  block_size_ = (r4_ - r2_) / num_channels_;
 
   // r1_ at the beginning of the buffer.
   RTC_DCHECK_EQ(r1_, input_buffer_.get());
@@ -308,13 +335,23 @@ void SincResampler::Resample(size_t frames, float* destination) {
       RTC_DCHECK_EQ(0, reinterpret_cast<uintptr_t>(k2) % 16);
 
       // Initialize input pointer based on quantized |virtual_source_idx_|.
-      const float* const input_ptr = r1_ + source_idx;
+      const float* const input_ptr = r1_ + source_idx * num_channels_;
 
       // Figure out how much to weight each kernel's "convolution".
       const double kernel_interpolation_factor =
           virtual_offset_idx - offset_idx;
-      *destination++ =
-          CONVOLVE_FUNC(input_ptr, k1, k2, kernel_interpolation_factor);
+      if (num_channels_ == 1) {
+        *destination++ =
+            CONVOLVE_FUNC(input_ptr, k1, k2, kernel_interpolation_factor);
+      } else if (num_channels_ == 2) {
+        CONVOLVE_STEREO_FUNC(input_ptr, k1, k2, kernel_interpolation_factor,
+                             destination);
+        destination += 2;
+      } else {
+        ConvolveInterleaved_C(input_ptr, k1, k2, kernel_interpolation_factor,
+                              num_channels_, destination);
+        destination += num_channels_;
+      }
 
       // Advance the virtual index.
       virtual_source_idx_ += current_io_ratio;
@@ -328,7 +365,8 @@ void SincResampler::Resample(size_t frames, float* destination) {
 
     // Step (3) -- Copy r3_, r4_ to r1_, r2_.
     // This wraps the last input frames back to the start of the buffer.
-    memcpy(r1_, r3_, sizeof(*input_buffer_.get()) * kKernelSize);
+    memcpy(r1_, r3_,
+           sizeof(*input_buffer_.get()) * kKernelSize * num_channels_);
 
     // Step (4) -- Reinitialize regions if necessary.
     if (r0_ == r2_)
@@ -340,6 +378,7 @@ void SincResampler::Resample(size_t frames, float* destination) {
 }
 
 #undef CONVOLVE_FUNC
+#undef CONVOLVE_STEREO_FUNC
 
 size_t SincResampler::ChunkSize() const {
   return static_cast<size_t>(block_size_ / io_sample_rate_ratio_);
@@ -373,4 +412,34 @@ float SincResampler::Convolve_C(const float* input_ptr,
                             kernel_interpolation_factor * sum2);
 }
 
+void SincResampler::ConvolveInterleaved_C(const float* input_ptr,
+                                          const float* k1,
+                                          const float* k2,
+                                          double kernel_interpolation_factor,
+                                          size_t num_channels,
+                                          float* destination) {
+  for (size_t channel = 0; channel < num_channels; ++channel) {
+    float sum1 = 0;
+    float sum2 = 0;
+    const float* input = input_ptr + channel;
+    for (size_t i = 0; i < kKernelSize; ++i) {
+      sum1 += *input * k1[i];
+      sum2 += *input * k2[i];
+      input += num_channels;
+    }
+    destination[channel] =
+        static_cast<float>((1.0 - kernel_interpolation_factor) * sum1 +
+                           kernel_interpolation_factor * sum2);
+  }
+}
+
+void SincResampler::ConvolveStereo_C(const float* input_ptr,
+                                     const float* k1,
+                                     const float* k2,
+                                     double kernel_interpolation_factor,
+                                     float* destination) {
+  ConvolveInterleaved_C(input_ptr, k1, k2, kernel_interpolation_factor, 2,
+                        destination);
+}
+
 }  // namespace webrtc
@@ -27,14 +27,18 @@ namespace webrtc {
 
 // Callback class for providing more data into the resampler.  Expects |frames|
 // of data to be rendered into |destination|; zero padded if not enough frames
-// are available to satisfy the request.
+// are available to satisfy the request.  With more than one channel the frames
+// are interleaved.
 class SincResamplerCallback {
  public:
   virtual ~SincResamplerCallback() {}
   virtual void Run(size_t frames, float* destination) = 0;
 };
 
-// SincResampler is a high-quality single-channel sample-rate converter.
+// SincResampler is a high-quality sample-rate converter.  It resamples a single
+// channel, or interleaved multichannel audio in one pass: all channels share
+// the kernel selection and the kernel loads of the convolution, which makes
+// e.g. stereo cheaper than two single-channel resamplers.
 class SincResampler {
  public:
   // The kernel size can be adjusted for quality (higher is better) at the
@@ -62,6 +66,12 @@ class SincResampler {
   SincResampler(double io_sample_rate_ratio,
                 size_t request_frames,
                 SincResamplerCallback* read_cb);
+  // Like above, for |num_channels| interleaved channels.  |read_cb| then
+  // provides, and Resample() produces, interleaved frames.
+  SincResampler(double io_sample_rate_ratio,
+                size_t request_frames,
+                SincResamplerCallback* read_cb,
+                size_t num_channels);
   virtual ~SincResampler();
 
   // Resample |frames| of data from |read_cb_| into |destination|.
@@ -72,6 +82,7 @@ class SincResampler {
   size_t ChunkSize() const;
 
   size_t request_frames() const { return request_frames_; }
+  size_t num_channels() const { return num_channels_; }
 
   // Flush all buffered data and reset internal indices.  Not thread safe, do
   // not call while Resample() is in progress.
@@ -90,6 +101,8 @@ class SincResampler {
  private:
   FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, Convolve);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, ConvolveBenchmark);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, ConvolveAvx2);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, ConvolveStereo);
 
   void InitializeKernel();
   void UpdateRegions(bool second_load);
@@ -112,6 +125,10 @@ class SincResampler {
                             const float* k1,
                             const float* k2,
                             double kernel_interpolation_factor);
+  static float Convolve_AVX2(const float* input_ptr,
+                             const float* k1,
+                             const float* k2,
+                             double kernel_interpolation_factor);
 #elif defined(WEBRTC_HAS_NEON)
   static float Convolve_NEON(const float* input_ptr,
                              const float* k1,
@@ -119,6 +136,33 @@ class SincResampler {
                              double kernel_interpolation_factor);
 #endif
 
+  // Like Convolve_C(), for |num_channels| interleaved channels in
+  // |input_ptr|.  Writes one output frame to |destination|.
+  static void ConvolveInterleaved_C(const float* input_ptr,
+                                    const float* k1,
+                                    const float* k2,
+                                    double kernel_interpolation_factor,
+                                    size_t num_channels,
+                                    float* destination);
+  // Stereo versions of the above, which is the common multichannel case.
+  static void ConvolveStereo_C(const float* input_ptr,
+                               const float* k1,
+                               const float* k2,
+                               double kernel_interpolation_factor,
+                               float* destination);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  static void ConvolveStereo_SSE(const float* input_ptr,
+                                 const float* k1,
+                                 const float* k2,
+                                 double kernel_interpolation_factor,
+                                 float* destination);
+  static void ConvolveStereo_AVX2(const float* input_ptr,
+                                  const float* k1,
+                                  const float* k2,
+                                  double kernel_interpolation_factor,
+                                  float* destination);
+#endif
+
   // The ratio of input / output sample rates.
   double io_sample_rate_ratio_;
 
@@ -132,9 +176,11 @@ class SincResampler {
   // Source of data for resampling.
   SincResamplerCallback* read_cb_;
 
-  // The size (in samples) to request from each |read_cb_| execution.
+  // The size (in frames) to request from each |read_cb_| execution.
   const size_t request_frames_;
 
+  const size_t num_channels_;
+
   // The number of source frames processed per pass.
   size_t block_size_;
 
@@ -155,16 +201,23 @@ class SincResampler {
 // TODO(ajm): Move to using a global static which must only be initialized
 // once by the user. We're not doing this initially, because we don't have
 // e.g. a LazyInstance helper in webrtc.
-#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(__SSE2__)
+#if defined(WEBRTC_ARCH_X86_FAMILY)
   typedef float (*ConvolveProc)(const float*,
                                 const float*,
                                 const float*,
                                 double);
   ConvolveProc convolve_proc_;
+  typedef void (*ConvolveStereoProc)(const float*,
+                                     const float*,
+                                     const float*,
+                                     double,
+                                     float*);
+  ConvolveStereoProc convolve_stereo_proc_;
 #endif
 
   // Pointers to the various regions inside |input_buffer_|.  See the diagram at
-  // the top of the .cc file for more information.
+  // the top of the .cc file for more information.  With more than one channel,
+  // the regions hold interleaved frames.
   float* r0_;
   float* const r1_;
   float* const r2_;
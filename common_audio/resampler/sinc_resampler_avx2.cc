@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "common_audio/resampler/sinc_resampler.h"
+
+namespace webrtc {
+
+float SincResampler::Convolve_AVX2(const float* input_ptr,
+                                   const float* k1,
+                                   const float* k2,
+                                   double kernel_interpolation_factor) {
+  __m256 m_sums1 = _mm256_setzero_ps();
+  __m256 m_sums2 = _mm256_setzero_ps();
+
+  // The kernels are 32-byte aligned, the input may not be.
+  for (size_t i = 0; i < kKernelSize; i += 8) {
+    const __m256 m_input = _mm256_loadu_ps(input_ptr + i);
+    m_sums1 = _mm256_fmadd_ps(m_input, _mm256_load_ps(k1 + i), m_sums1);
+    m_sums2 = _mm256_fmadd_ps(m_input, _mm256_load_ps(k2 + i), m_sums2);
+  }
+
+  // Linearly interpolate the two "convolutions".
+  m_sums1 = _mm256_mul_ps(
+      m_sums1,
+      _mm256_set1_ps(static_cast<float>(1.0 - kernel_interpolation_factor)));
+  m_sums1 = _mm256_fmadd_ps(
+      m_sums2, _mm256_set1_ps(static_cast<float>(kernel_interpolation_factor)),
+      m_sums1);
+
+  // Sum components together.
+  __m128 m_sum = _mm_add_ps(_mm256_castps256_ps128(m_sums1),
+                            _mm256_extractf128_ps(m_sums1, 1));
+  m_sum = _mm_add_ps(m_sum, _mm_movehl_ps(m_sum, m_sum));
+  m_sum = _mm_add_ss(m_sum, _mm_shuffle_ps(m_sum, m_sum, 1));
+  return _mm_cvtss_f32(m_sum);
+}
+
+void SincResampler::ConvolveStereo_AVX2(const float* input_ptr,
+                                        const float* k1,
+                                        const float* k2,
+                                        double kernel_interpolation_factor,
+                                        float* destination) {
+  // The lanes of the sums alternate between the left and the right channel,
+  // like the interleaved input, and each kernel value is duplicated to match.
+  // The low and high sums hold the same partial sums per channel as the lanes
+  // of Convolve_AVX2(), and are added in the same order, so that each channel
+  // is bitexact with resampling it on its own.
+  const __m256i m_duplicate = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+  __m256 m_sums1_low = _mm256_setzero_ps();
+  __m256 m_sums1_high = _mm256_setzero_ps();
+  __m256 m_sums2_low = _mm256_setzero_ps();
+  __m256 m_sums2_high = _mm256_setzero_ps();
+  for (size_t i = 0; i < kKernelSize; i += 8) {
+    const __m256 m_input_low = _mm256_loadu_ps(input_ptr + 2 * i);
+    const __m256 m_input_high = _mm256_loadu_ps(input_ptr + 2 * i + 8);
+    const __m256 m_k1 = _mm256_load_ps(k1 + i);
+    const __m256 m_k2 = _mm256_load_ps(k2 + i);
+    m_sums1_low = _mm256_fmadd_ps(
+        m_input_low,
+        _mm256_permutevar8x32_ps(m_k1, m_duplicate), m_sums1_low);
+    m_sums2_low = _mm256_fmadd_ps(
+        m_input_low,
+        _mm256_permutevar8x32_ps(m_k2, m_duplicate), m_sums2_low);
+    // Move the high half of the kernels down before duplicating.
+    m_sums1_high = _mm256_fmadd_ps(
+        m_input_high,
+        _mm256_permutevar8x32_ps(_mm256_permute2f128_ps(m_k1, m_k1, 1),
+                                 m_duplicate),
+        m_sums1_high);
+    m_sums2_high = _mm256_fmadd_ps(
+        m_input_high,
+        _mm256_permutevar8x32_ps(_mm256_permute2f128_ps(m_k2, m_k2, 1),
+                                 m_duplicate),
+        m_sums2_high);
+  }
+
+  // Linearly interpolate the two "convolutions".
+  const __m256 m_factor1 =
+      _mm256_set1_ps(static_cast<float>(1.0 - kernel_interpolation_factor));
+  const __m256 m_factor2 =
+      _mm256_set1_ps(static_cast<float>(kernel_interpolation_factor));
+  const __m256 m_sums_low = _mm256_fmadd_ps(
+      m_sums2_low, m_factor2, _mm256_mul_ps(m_sums1_low, m_factor1));
+  const __m256 m_sums_high = _mm256_fmadd_ps(
+      m_sums2_high, m_factor2, _mm256_mul_ps(m_sums1_high, m_factor1));
+
+  // Sum the components of each channel together.
+  const __m256 m_sums = _mm256_add_ps(m_sums_low, m_sums_high);
+  __m128 m_sum = _mm_add_ps(_mm256_castps256_ps128(m_sums),
+                            _mm256_extractf128_ps(m_sums, 1));
+  m_sum = _mm_add_ps(m_sum, _mm_movehl_ps(m_sum, m_sum));
+  _mm_storel_pi(reinterpret_cast<__m64*>(destination), m_sum);
+}
+
+}  // namespace webrtc
@@ -60,4 +60,51 @@ float SincResampler::Convolve_SSE(const float* input_ptr,
   return result;
 }
 
+void SincResampler::ConvolveStereo_SSE(const float* input_ptr,
+                                       const float* k1,
+                                       const float* k2,
+                                       double kernel_interpolation_factor,
+                                       float* destination) {
+  // The lanes of the sums alternate between the left and the right channel,
+  // like the interleaved input, and each kernel value is duplicated to match.
+  // The low and high sums hold the same partial sums per channel as the lanes
+  // of Convolve_SSE(), and are added in the same order, so that each channel
+  // is bitexact with resampling it on its own.
+  __m128 m_sums1_low = _mm_setzero_ps();
+  __m128 m_sums1_high = _mm_setzero_ps();
+  __m128 m_sums2_low = _mm_setzero_ps();
+  __m128 m_sums2_high = _mm_setzero_ps();
+  for (size_t i = 0; i < kKernelSize; i += 4) {
+    const __m128 m_input_low = _mm_loadu_ps(input_ptr + 2 * i);
+    const __m128 m_input_high = _mm_loadu_ps(input_ptr + 2 * i + 4);
+    const __m128 m_k1 = _mm_load_ps(k1 + i);
+    const __m128 m_k2 = _mm_load_ps(k2 + i);
+    m_sums1_low = _mm_add_ps(
+        m_sums1_low, _mm_mul_ps(m_input_low, _mm_unpacklo_ps(m_k1, m_k1)));
+    m_sums1_high = _mm_add_ps(
+        m_sums1_high, _mm_mul_ps(m_input_high, _mm_unpackhi_ps(m_k1, m_k1)));
+    m_sums2_low = _mm_add_ps(
+        m_sums2_low, _mm_mul_ps(m_input_low, _mm_unpacklo_ps(m_k2, m_k2)));
+    m_sums2_high = _mm_add_ps(
+        m_sums2_high, _mm_mul_ps(m_input_high, _mm_unpackhi_ps(m_k2, m_k2)));
+  }
+
+  // Linearly interpolate the two "convolutions".
+  const __m128 m_factor1 =
+      _mm_set_ps1(static_cast<float>(1.0 - kernel_interpolation_factor));
+  const __m128 m_factor2 =
+      _mm_set_ps1(static_cast<float>(kernel_interpolation_factor));
+  const __m128 m_sums_low =
+      _mm_add_ps(_mm_mul_ps(m_sums1_low, m_factor1),
+                 _mm_mul_ps(m_sums2_low, m_factor2));
+  const __m128 m_sums_high =
+      _mm_add_ps(_mm_mul_ps(m_sums1_high, m_factor1),
+                 _mm_mul_ps(m_sums2_high, m_factor2));
+
+  // Sum the components of each channel together.
+  __m128 m_sums = _mm_add_ps(m_sums_low, m_sums_high);
+  m_sums = _mm_add_ps(m_sums, _mm_movehl_ps(m_sums, m_sums));
+  _mm_storel_pi(reinterpret_cast<__m64*>(destination), m_sums);
+}
+
 }  // namespace webrtc
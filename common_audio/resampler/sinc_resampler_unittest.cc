@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <memory>
 #include <tuple>
+#include <vector>
 
 #include "common_audio/resampler/sinusoidal_linear_chirp_source.h"
 #include "rtc_base/stringize_macros.h"
@@ -164,6 +165,158 @@ TEST(SincResamplerTest, Convolve) {
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Ensure Convolve_AVX2() returns the same value as Convolve_C(), when AVX2 is
+// available.
+TEST(SincResamplerTest, ConvolveAvx2) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+
+  // Initialize a dummy resampler.
+  MockSource mock_source;
+  SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+
+  // Convolve_AVX2() uses fused multiply-adds, which are slightly more precise
+  // than Convolve_C().
+  static const double kEpsilon = 0.00000005;
+
+  const float* const kernel = resampler.kernel_storage_.get();
+  for (int offset = 0; offset < 2; ++offset) {
+    double result = resampler.Convolve_C(kernel + offset, kernel, kernel,
+                                         kKernelInterpolationFactor);
+    double result2 = resampler.Convolve_AVX2(kernel + offset, kernel, kernel,
+                                             kKernelInterpolationFactor);
+    EXPECT_NEAR(result2, result, kEpsilon);
+  }
+}
+#endif
+
+// Ensure the stereo Convolve() methods give each channel exactly the output of
+// the corresponding single channel method.
+TEST(SincResamplerTest, ConvolveStereo) {
+  MockSource mock_source;
+  SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+  const size_t kKernelSize = SincResampler::kKernelSize;
+  const float* const k1 = resampler.kernel_storage_.get();
+  const float* const k2 = k1 + kKernelSize;
+
+  // Use two different kernels as the input channels, and an extra frame to
+  // test unaligned input.
+  std::vector<float> left(kKernelSize + 1);
+  std::vector<float> right(kKernelSize + 1);
+  std::vector<float> interleaved(2 * (kKernelSize + 1));
+  for (size_t i = 0; i < kKernelSize + 1; ++i) {
+    left[i] = k1[2 * kKernelSize + i];
+    right[i] = -k1[4 * kKernelSize + i];
+    interleaved[2 * i] = left[i];
+    interleaved[2 * i + 1] = right[i];
+  }
+
+  for (size_t offset = 0; offset < 2; ++offset) {
+    const float* const input = interleaved.data() + 2 * offset;
+    float result[2];
+    resampler.ConvolveStereo_C(input, k1, k2, kKernelInterpolationFactor,
+                               result);
+    EXPECT_EQ(resampler.Convolve_C(left.data() + offset, k1, k2,
+                                   kKernelInterpolationFactor),
+              result[0]);
+    EXPECT_EQ(resampler.Convolve_C(right.data() + offset, k1, k2,
+                                   kKernelInterpolationFactor),
+              result[1]);
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (WebRtc_GetCPUInfo(kSSE2)) {
+      resampler.ConvolveStereo_SSE(input, k1, k2, kKernelInterpolationFactor,
+                                   result);
+      EXPECT_EQ(resampler.Convolve_SSE(left.data() + offset, k1, k2,
+                                       kKernelInterpolationFactor),
+                result[0]);
+      EXPECT_EQ(resampler.Convolve_SSE(right.data() + offset, k1, k2,
+                                       kKernelInterpolationFactor),
+                result[1]);
+    }
+    if (WebRtc_GetCPUInfo(kAVX2)) {
+      resampler.ConvolveStereo_AVX2(input, k1, k2, kKernelInterpolationFactor,
+                                    result);
+      EXPECT_EQ(resampler.Convolve_AVX2(left.data() + offset, k1, k2,
+                                        kKernelInterpolationFactor),
+                result[0]);
+      EXPECT_EQ(resampler.Convolve_AVX2(right.data() + offset, k1, k2,
+                                        kKernelInterpolationFactor),
+                result[1]);
+    }
+#endif
+  }
+}
+
+// Provides the interleaved output of two single channel sources.
+class StereoSource : public SincResamplerCallback {
+ public:
+  StereoSource(SincResamplerCallback* left, SincResamplerCallback* right)
+      : left_(left), right_(right) {}
+
+  void Run(size_t frames, float* destination) override {
+    left_buffer_.resize(frames);
+    right_buffer_.resize(frames);
+    left_->Run(frames, left_buffer_.data());
+    right_->Run(frames, right_buffer_.data());
+    for (size_t i = 0; i < frames; ++i) {
+      destination[2 * i] = left_buffer_[i];
+      destination[2 * i + 1] = right_buffer_[i];
+    }
+  }
+
+ private:
+  SincResamplerCallback* const left_;
+  SincResamplerCallback* const right_;
+  std::vector<float> left_buffer_;
+  std::vector<float> right_buffer_;
+};
+
+// Test that resampling interleaved stereo gives each channel exactly the
+// output of resampling it on its own.
+TEST(SincResamplerTest, StereoMatchesMono) {
+  const int kInputRate = 44100;
+  const int kOutputRate = 48000;
+  const size_t kInputFrames = kInputRate / 2;
+  const size_t kOutputFrames = kOutputRate / 2;
+  const double kIoRatio = kInputRate / static_cast<double>(kOutputRate);
+
+  // Use a chirp on one channel and a sped up chirp on the other.
+  SinusoidalLinearChirpSource left_source(kInputRate, kInputFrames,
+                                          0.5 * kInputRate, 0);
+  SinusoidalLinearChirpSource right_source(kInputRate, kInputFrames / 4,
+                                           0.5 * kInputRate, 0);
+  SincResampler left_resampler(kIoRatio, SincResampler::kDefaultRequestSize,
+                               &left_source);
+  SincResampler right_resampler(kIoRatio, SincResampler::kDefaultRequestSize,
+                                &right_source);
+  const size_t chunk_size = left_resampler.ChunkSize();
+  std::vector<float> left(kOutputFrames);
+  std::vector<float> right(kOutputFrames);
+  left_resampler.Resample(kOutputFrames, left.data());
+  right_resampler.Resample(kOutputFrames, right.data());
+
+  SinusoidalLinearChirpSource left_source2(kInputRate, kInputFrames,
+                                           0.5 * kInputRate, 0);
+  SinusoidalLinearChirpSource right_source2(kInputRate, kInputFrames / 4,
+                                            0.5 * kInputRate, 0);
+  StereoSource stereo_source(&left_source2, &right_source2);
+  SincResampler stereo_resampler(kIoRatio, SincResampler::kDefaultRequestSize,
+                                 &stereo_source, 2);
+  EXPECT_EQ(2u, stereo_resampler.num_channels());
+  EXPECT_EQ(chunk_size, stereo_resampler.ChunkSize());
+  std::vector<float> stereo(2 * kOutputFrames);
+  stereo_resampler.Resample(kOutputFrames, stereo.data());
+
+  for (size_t i = 0; i < kOutputFrames; ++i) {
+    ASSERT_EQ(left[i], stereo[2 * i]) << "frame " << i;
+    ASSERT_EQ(right[i], stereo[2 * i + 1]) << "frame " << i;
+  }
+}
+
 // Benchmark for the various Convolve() methods.  Make sure to build with
 // branding=Chrome so that RTC_DCHECKs are compiled out when benchmarking.
 // Original benchmarks were run with --convolve-iterations=50000000.
@@ -226,6 +379,23 @@ TEST(SincResamplerTest, ConvolveBenchmark) {
          total_time_c_us / total_time_optimized_aligned_us,
          total_time_optimized_unaligned_us / total_time_optimized_aligned_us);
 #endif
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2)) {
+    // Benchmark Convolve_AVX2(), the input is never aligned for it.
+    start = rtc::TimeNanos();
+    for (int j = 0; j < kConvolveIterations; ++j) {
+      resampler.Convolve_AVX2(
+          resampler.kernel_storage_.get() + 1, resampler.kernel_storage_.get(),
+          resampler.kernel_storage_.get(), kKernelInterpolationFactor);
+    }
+    double total_time_avx2_us =
+        (rtc::TimeNanos() - start) / rtc::kNumNanosecsPerMicrosec;
+    printf("Convolve_AVX2 took %.2fms; which is %.2fx faster than "
+           "Convolve_C.\n", total_time_avx2_us / 1000,
+           total_time_c_us / total_time_avx2_us);
+  }
+#endif
 }
 
 #undef CONVOLVE_FUNC
@@ -352,7 +522,7 @@ INSTANTIATE_TEST_SUITE_P(
         std::make_tuple(16000, 44100, kResamplingRMSError, -62.54),
         std::make_tuple(22050, 44100, kResamplingRMSError, -73.53),
         std::make_tuple(32000, 44100, kResamplingRMSError, -63.32),
-        std::make_tuple(44100, 44100, kResamplingRMSError, -73.53),
+        std::make_tuple(44100, 44100, kResamplingRMSError, -73.52),
         std::make_tuple(48000, 44100, -15.01, -64.04),
         std::make_tuple(96000, 44100, -18.49, -25.51),
         std::make_tuple(192000, 44100, -20.50, -13.31),
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+#include <stdlib.h>
+
+#include "rtc_base/checks.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Maximum absolute value of word16 vector. SSE2 version.
+int16_t WebRtcSpl_MaxAbsValueW16SSE2(const int16_t* vector, size_t length) {
+  int absolute = 0, maximum = 0;
+  size_t i = 0;
+  __m128i max_value = _mm_setzero_si128();
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    __m128i x = _mm_loadu_si128((const __m128i*)&vector[i]);
+    // The saturating subtraction turns -32768 into 32767, which is the value
+    // that the C version caps abs(-32768) to.
+    __m128i negated = _mm_subs_epi16(_mm_setzero_si128(), x);
+    max_value = _mm_max_epi16(max_value, _mm_max_epi16(x, negated));
+  }
+  max_value = _mm_max_epi16(
+      max_value, _mm_shuffle_epi32(max_value, _MM_SHUFFLE(1, 0, 3, 2)));
+  max_value = _mm_max_epi16(
+      max_value, _mm_shuffle_epi32(max_value, _MM_SHUFFLE(2, 3, 0, 1)));
+  max_value = _mm_max_epi16(max_value, _mm_srli_epi32(max_value, 16));
+  maximum = (int16_t)_mm_cvtsi128_si32(max_value);
+
+  // Second part, do the remaining iterations (if any).
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
@@ -11,6 +11,7 @@
 #include <algorithm>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "test/gtest.h"
 
@@ -491,7 +492,7 @@ TEST(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
   if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
@@ -503,6 +504,62 @@ TEST(SplTest, CrossCorrelationTest) {
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(SplTest, CrossCorrelationSSE2MatchesC) {
+  const size_t kMaxSeqDimension = 70;
+  const size_t kCrossCorrelationDimension = 10;
+  webrtc::Random random(42);
+  int16_t seq1[kMaxSeqDimension];
+  int16_t seq2[kMaxSeqDimension + 2 * kCrossCorrelationDimension];
+  for (int16_t& sample : seq1)
+    sample = random.Rand(WEBRTC_SPL_WORD16_MIN, WEBRTC_SPL_WORD16_MAX);
+  for (int16_t& sample : seq2)
+    sample = random.Rand(WEBRTC_SPL_WORD16_MIN, WEBRTC_SPL_WORD16_MAX);
+  seq1[3] = WEBRTC_SPL_WORD16_MIN;
+  seq2[3] = WEBRTC_SPL_WORD16_MIN;
+
+  // Cover the unrolled loops, the remaining samples and both step directions.
+  for (size_t dim_seq : {1, 7, 8, 9, 16, 61, 70}) {
+    for (int right_shifts = 0; right_shifts < 8; right_shifts += 3) {
+      for (int step : {1, -1}) {
+        const int16_t* seq2_start =
+            step > 0 ? seq2 : seq2 + kCrossCorrelationDimension;
+        int32_t expected[kCrossCorrelationDimension];
+        int32_t result[kCrossCorrelationDimension];
+        WebRtcSpl_CrossCorrelationC(expected, seq1, seq2_start, dim_seq,
+                                    kCrossCorrelationDimension, right_shifts,
+                                    step);
+        WebRtcSpl_CrossCorrelationSSE2(result, seq1, seq2_start, dim_seq,
+                                       kCrossCorrelationDimension,
+                                       right_shifts, step);
+        for (size_t i = 0; i < kCrossCorrelationDimension; ++i)
+          EXPECT_EQ(expected[i], result[i]) << dim_seq << " " << right_shifts;
+      }
+    }
+  }
+}
+
+TEST(SplTest, MaxAbsValueW16SSE2MatchesC) {
+  const size_t kVectorSize = 37;
+  webrtc::Random random(42);
+  int16_t vector[kVectorSize];
+  for (int16_t& sample : vector)
+    sample = random.Rand(-1000, 1000);
+
+  for (size_t length = 1; length <= kVectorSize; ++length) {
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(vector, length),
+              WebRtcSpl_MaxAbsValueW16SSE2(vector, length));
+  }
+  // abs(-32768) is capped, both in the unrolled loop and in the remaining
+  // samples.
+  vector[5] = WEBRTC_SPL_WORD16_MIN;
+  EXPECT_EQ(WEBRTC_SPL_WORD16_MAX, WebRtcSpl_MaxAbsValueW16SSE2(vector, 8));
+  EXPECT_EQ(WEBRTC_SPL_WORD16_MAX, WebRtcSpl_MaxAbsValueW16SSE2(vector, 6));
+  vector[5] = -1001;
+  EXPECT_EQ(1001, WebRtcSpl_MaxAbsValueW16SSE2(vector, kVectorSize));
+}
+#endif
+
 TEST(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
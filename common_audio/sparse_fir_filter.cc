@@ -12,8 +12,36 @@
 
 #include "rtc_base/checks.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include "common_audio/sparse_fir_filter_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "common_audio/sparse_fir_filter_sse.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"  // kSSE2, WebRtc_G...
+#endif
+
 namespace webrtc {
 
+namespace {
+
+#if !defined(WEBRTC_HAS_NEON)
+void SparseFirFilterC(const float* in,
+                      size_t length,
+                      const float* coeffs,
+                      size_t num_coeffs,
+                      size_t sparsity,
+                      size_t offset,
+                      float* out) {
+  for (size_t i = 0; i < length; ++i) {
+    out[i] = 0.f;
+    for (size_t j = 0; j < num_coeffs; ++j) {
+      out[i] += in[i - (j * sparsity + offset)] * coeffs[j];
+    }
+  }
+}
+#endif
+
+}  // namespace
+
 SparseFIRFilter::SparseFIRFilter(const float* nonzero_coeffs,
                                  size_t num_nonzero_coeffs,
                                  size_t sparsity,
@@ -21,40 +49,50 @@ SparseFIRFilter::SparseFIRFilter(const float* nonzero_coeffs,
     : sparsity_(sparsity),
       offset_(offset),
       nonzero_coeffs_(nonzero_coeffs, nonzero_coeffs + num_nonzero_coeffs),
-      state_(sparsity_ * (num_nonzero_coeffs - 1) + offset_, 0.f) {
+      history_length_(sparsity_ * (num_nonzero_coeffs - 1) + offset_),
+      buffer_(history_length_, 0.f) {
   RTC_CHECK_GE(num_nonzero_coeffs, 1);
   RTC_CHECK_GE(sparsity, 1);
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  use_sse2_ = true;
+#else
+  use_sse2_ = WebRtc_GetCPUInfo(kSSE2) != 0;
+#endif
+#endif
 }
 
 SparseFIRFilter::~SparseFIRFilter() = default;
 
 void SparseFIRFilter::Filter(const float* in, size_t length, float* out) {
+  if (buffer_.size() < history_length_ + length) {
+    buffer_.resize(history_length_ + length);
+  }
+  std::memcpy(&buffer_[history_length_], in, length * sizeof(*in));
+
   // Convolves the input signal |in| with the filter kernel |nonzero_coeffs_|
   // taking into account the previous state.
-  for (size_t i = 0; i < length; ++i) {
-    out[i] = 0.f;
-    size_t j;
-    for (j = 0; i >= j * sparsity_ + offset_ && j < nonzero_coeffs_.size();
-         ++j) {
-      out[i] += in[i - j * sparsity_ - offset_] * nonzero_coeffs_[j];
-    }
-    for (; j < nonzero_coeffs_.size(); ++j) {
-      out[i] += state_[i + (nonzero_coeffs_.size() - j - 1) * sparsity_] *
-                nonzero_coeffs_[j];
-    }
+  const float* current = buffer_.data() + history_length_;
+#if defined(WEBRTC_HAS_NEON)
+  SparseFirFilterNeon(current, length, nonzero_coeffs_.data(),
+                      nonzero_coeffs_.size(), sparsity_, offset_, out);
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (use_sse2_) {
+    SparseFirFilterSse2(current, length, nonzero_coeffs_.data(),
+                        nonzero_coeffs_.size(), sparsity_, offset_, out);
+  } else {
+    SparseFirFilterC(current, length, nonzero_coeffs_.data(),
+                     nonzero_coeffs_.size(), sparsity_, offset_, out);
   }
+#else
+  SparseFirFilterC(current, length, nonzero_coeffs_.data(),
+                   nonzero_coeffs_.size(), sparsity_, offset_, out);
+#endif
 
   // Update current state.
-  if (!state_.empty()) {
-    if (length >= state_.size()) {
-      std::memcpy(&state_[0], &in[length - state_.size()],
-                  state_.size() * sizeof(*in));
-    } else {
-      std::memmove(&state_[0], &state_[length],
-                   (state_.size() - length) * sizeof(state_[0]));
-      std::memcpy(&state_[state_.size() - length], in, length * sizeof(*in));
-    }
-  }
+  std::memmove(buffer_.data(), buffer_.data() + length,
+               history_length_ * sizeof(buffer_[0]));
 }
 
 }  // namespace webrtc
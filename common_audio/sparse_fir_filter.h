@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/system/arch.h"
 
 namespace webrtc {
 
@@ -43,7 +44,14 @@ class SparseFIRFilter final {
   const size_t sparsity_;
   const size_t offset_;
   const std::vector<float> nonzero_coeffs_;
-  std::vector<float> state_;
+  // Number of past input samples the filter depends on.
+  const size_t history_length_;
+  // The past input samples followed by the input being filtered, so that the
+  // convolution reads contiguous samples and can be vectorized.
+  std::vector<float> buffer_;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  bool use_sse2_ = false;
+#endif
 
   RTC_DISALLOW_COPY_AND_ASSIGN(SparseFIRFilter);
 };
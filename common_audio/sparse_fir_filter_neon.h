@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+#ifndef COMMON_AUDIO_SPARSE_FIR_FILTER_NEON_H_
+#define COMMON_AUDIO_SPARSE_FIR_FILTER_NEON_H_
+
+#include <stddef.h>
+
+namespace webrtc {
+
+// NEON implementation of the SparseFIRFilter convolution. Computes |length|
+// samples of |out| from |in|, where the sparsity * (num_coeffs - 1) + offset
+// samples preceding |in| hold the end of the previous input.
+void SparseFirFilterNeon(const float* in,
+                         size_t length,
+                         const float* coeffs,
+                         size_t num_coeffs,
+                         size_t sparsity,
+                         size_t offset,
+                         float* out);
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_SPARSE_FIR_FILTER_NEON_H_
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+#include "common_audio/sparse_fir_filter_sse.h"
+
+#include <xmmintrin.h>
+
+namespace webrtc {
+
+void SparseFirFilterSse2(const float* in,
+                         size_t length,
+                         const float* coeffs,
+                         size_t num_coeffs,
+                         size_t sparsity,
+                         size_t offset,
+                         float* out) {
+  // Four consecutive outputs are computed at once. Each of them uses the input
+  // at the same distance for a given coefficient, so the inputs are contiguous
+  // and the coefficient is broadcast.
+  size_t i = 0;
+  for (; i + 4 <= length; i += 4) {
+    __m128 m_sum = _mm_setzero_ps();
+    for (size_t j = 0; j < num_coeffs; ++j) {
+      const float* in_ptr = in + i - (j * sparsity + offset);
+      m_sum = _mm_add_ps(
+          m_sum, _mm_mul_ps(_mm_loadu_ps(in_ptr), _mm_set1_ps(coeffs[j])));
+    }
+    _mm_storeu_ps(out + i, m_sum);
+  }
+  for (; i < length; ++i) {
+    out[i] = 0.f;
+    for (size_t j = 0; j < num_coeffs; ++j) {
+      out[i] += in[i - (j * sparsity + offset)] * coeffs[j];
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -10,13 +10,24 @@
 
 #include "common_audio/sparse_fir_filter.h"
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "common_audio/fir_filter.h"
 #include "common_audio/fir_filter_factory.h"
 #include "rtc_base/arraysize.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
 #include "test/gtest.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include "common_audio/sparse_fir_filter_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "common_audio/sparse_fir_filter_sse.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#endif
+
 namespace webrtc {
 namespace {
 
@@ -24,6 +35,38 @@ static const float kCoeffs[] = {0.2f, 0.3f, 0.5f, 0.7f, 0.11f};
 static const float kInput[] = {1.f, 2.f, 3.f, 4.f, 5.f,
                                6.f, 7.f, 8.f, 9.f, 10.f};
 
+// Sparse filter shapes, the last ones being those of ThreeBandFilterBank.
+struct FilterShape {
+  size_t num_coeffs;
+  size_t sparsity;
+  size_t offset;
+};
+constexpr FilterShape kFilterShapes[] = {{1, 1, 0}, {5, 1, 0}, {5, 3, 2},
+                                         {4, 4, 0}, {4, 4, 1}, {4, 4, 3}};
+
+std::vector<float> RandomSignal(size_t length, Random* random) {
+  std::vector<float> signal(length);
+  for (float& sample : signal)
+    sample = random->Rand<float>() * 2.f - 1.f;
+  return signal;
+}
+
+// Straightforward convolution of |in| with the sparse kernel, starting from a
+// zero state.
+std::vector<float> ReferenceFilter(const std::vector<float>& in,
+                                   const std::vector<float>& coeffs,
+                                   const FilterShape& shape) {
+  std::vector<float> out(in.size(), 0.f);
+  for (size_t i = 0; i < in.size(); ++i) {
+    for (size_t j = 0; j < coeffs.size(); ++j) {
+      const size_t delay = j * shape.sparsity + shape.offset;
+      if (i >= delay)
+        out[i] += in[i - delay] * coeffs[j];
+    }
+  }
+  return out;
+}
+
 template <size_t N>
 void VerifyOutput(const float (&expected_output)[N], const float (&output)[N]) {
   EXPECT_EQ(0, memcmp(expected_output, output, sizeof(output)));
@@ -216,4 +259,70 @@ TEST(SparseFIRFilterTest, SameOutputAsFIRFilterWhenSparsityOneAndOffsetZero) {
   }
 }
 
+TEST(SparseFIRFilterTest, SameOutputAsReferenceForBlocksOfAnyLength) {
+  Random random(42);
+  for (const FilterShape& shape : kFilterShapes) {
+    const std::vector<float> coeffs = RandomSignal(shape.num_coeffs, &random);
+    const std::vector<float> input = RandomSignal(1000, &random);
+    const std::vector<float> expected = ReferenceFilter(input, coeffs, shape);
+
+    SparseFIRFilter filter(coeffs.data(), coeffs.size(), shape.sparsity,
+                           shape.offset);
+    std::vector<float> output(input.size());
+    // Blocks both shorter and longer than the filter history, and not
+    // multiples of the SIMD width.
+    const size_t kBlockLengths[] = {1, 3, 160, 7, 161, 2, 13};
+    size_t position = 0;
+    for (size_t k = 0; position < input.size(); ++k) {
+      const size_t length =
+          std::min(kBlockLengths[k % arraysize(kBlockLengths)],
+                   input.size() - position);
+      filter.Filter(&input[position], length, &output[position]);
+      position += length;
+    }
+    for (size_t i = 0; i < input.size(); ++i) {
+      EXPECT_NEAR(expected[i], output[i], 1e-6f);
+    }
+  }
+}
+
+#if defined(WEBRTC_HAS_NEON) || defined(WEBRTC_ARCH_X86_FAMILY)
+// The SIMD filter sums the products in the same order as the scalar one.
+TEST(SparseFIRFilterTest, SimdSameOutputAsScalar) {
+#if defined(WEBRTC_ARCH_X86_FAMILY) && !defined(WEBRTC_HAS_NEON)
+  if (!WebRtc_GetCPUInfo(kSSE2)) {
+    return;
+  }
+#endif
+  Random random(7);
+  for (const FilterShape& shape : kFilterShapes) {
+    const std::vector<float> coeffs = RandomSignal(shape.num_coeffs, &random);
+    const size_t history_length =
+        shape.sparsity * (shape.num_coeffs - 1) + shape.offset;
+    const std::vector<float> buffer =
+        RandomSignal(history_length + 163, &random);
+    const float* in = buffer.data() + history_length;
+    const size_t length = buffer.size() - history_length;
+
+    std::vector<float> expected(length, 0.f);
+    for (size_t i = 0; i < length; ++i) {
+      for (size_t j = 0; j < coeffs.size(); ++j)
+        expected[i] += in[i - (j * shape.sparsity + shape.offset)] * coeffs[j];
+    }
+
+    std::vector<float> output(length);
+#if defined(WEBRTC_HAS_NEON)
+    SparseFirFilterNeon(in, length, coeffs.data(), coeffs.size(),
+                        shape.sparsity, shape.offset, output.data());
+#else
+    SparseFirFilterSse2(in, length, coeffs.data(), coeffs.size(),
+                        shape.sparsity, shape.offset, output.data());
+#endif
+    for (size_t i = 0; i < length; ++i) {
+      EXPECT_FLOAT_EQ(expected[i], output[i]);
+    }
+  }
+}
+#endif
+
 }  // namespace webrtc
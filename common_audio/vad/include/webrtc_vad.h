@@ -71,6 +71,33 @@ int WebRtcVad_Process(VadInst* handle,
                       const int16_t* audio_frame,
                       size_t frame_length);
 
+// Calculates VAD decisions for |num_handles| instances, one audio frame each,
+// with the same results as calling WebRtcVad_Process() on every instance. The
+// filterbanks of several instances are run in parallel, which makes this
+// faster than separate calls when classifying many streams.
+//
+// - handles      [i/o] : VAD instances. Need to be initialized by
+//                        WebRtcVad_Init() before call.
+// - num_handles  [i]   : Number of instances.
+// - fs           [i]   : Sampling frequency (Hz) of all frames.
+// - audio_frames [i]   : Audio frame buffer of each instance.
+// - frame_length [i]   : Length of every audio frame buffer in number of
+//                        samples.
+// - decisions    [o]   : VAD decision of each instance, 1 - (Active Voice)
+//                        or 0 - (Non-active Voice).
+//
+// returns              : 0 - (OK),
+//                       -1 - (null pointer, an instance that has not been
+//                             initialized or an invalid rate and frame length
+//                             combination, in which case no instance is
+//                             updated)
+int WebRtcVad_ProcessBatch(VadInst* const* handles,
+                           size_t num_handles,
+                           int fs,
+                           const int16_t* const* audio_frames,
+                           size_t frame_length,
+                           int* decisions);
+
 // Checks for valid combinations of |rate| and |frame_length|. We support 10,
 // 20 and 30 ms frames and the rates 8000, 16000 and 32000 Hz.
 //
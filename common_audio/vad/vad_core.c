@@ -601,72 +601,90 @@ int WebRtcVad_set_mode_core(VadInstT* self, int mode) {
   return return_value;
 }
 
+// Downsamples |frame_length| samples of |speech_frame|, sampled at |fs|, to
+// 8 kHz. Returns the 8 kHz signal, which is written to |speech_nb| unless |fs|
+// is 8 kHz already, and sets |*nb_length| to its length.
+static const int16_t* DownsampleTo8khz(VadInstT* inst, int fs,
+                                       const int16_t* speech_frame,
+                                       size_t frame_length,
+                                       int16_t* speech_nb,
+                                       size_t* nb_length) {
+  size_t i;
+
+  if (fs == 48000) {
+    // |tmp_mem| is a temporary memory used by resample function, length is
+    // frame length in 10 ms (480 samples) + 256 extra.
+    int32_t tmp_mem[480 + 256] = { 0 };
+    const size_t kFrameLen10ms48khz = 480;
+    const size_t kFrameLen10ms8khz = 80;
+    size_t num_10ms_frames = frame_length / kFrameLen10ms48khz;
+
+    for (i = 0; i < num_10ms_frames; i++) {
+      WebRtcSpl_Resample48khzTo8khz(speech_frame,
+                                    &speech_nb[i * kFrameLen10ms8khz],
+                                    &inst->state_48_to_8,
+                                    tmp_mem);
+    }
+    *nb_length = frame_length / 6;
+  } else if (fs == 32000) {
+    // Downsampled speech frame: 960 samples (30ms in SWB).
+    int16_t speech_wb[480];
+
+    // Downsample signal 32->16->8.
+    WebRtcVad_Downsampling(speech_frame, speech_wb,
+                           &(inst->downsampling_filter_states[2]),
+                           frame_length);
+    WebRtcVad_Downsampling(speech_wb, speech_nb,
+                           inst->downsampling_filter_states, frame_length / 2);
+    *nb_length = frame_length / 4;
+  } else if (fs == 16000) {
+    WebRtcVad_Downsampling(speech_frame, speech_nb,
+                           inst->downsampling_filter_states, frame_length);
+    *nb_length = frame_length / 2;
+  } else {
+    *nb_length = frame_length;
+    return speech_frame;
+  }
+  return speech_nb;
+}
+
 // Calculate VAD decision by first extracting feature values and then calculate
 // probability for both speech and background noise.
 
 int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
                            size_t frame_length) {
-  int vad;
-  size_t i;
   int16_t speech_nb[240];  // 30 ms in 8 kHz.
-  // |tmp_mem| is a temporary memory used by resample function, length is
-  // frame length in 10 ms (480 samples) + 256 extra.
-  int32_t tmp_mem[480 + 256] = { 0 };
-  const size_t kFrameLen10ms48khz = 480;
-  const size_t kFrameLen10ms8khz = 80;
-  size_t num_10ms_frames = frame_length / kFrameLen10ms48khz;
-
-  for (i = 0; i < num_10ms_frames; i++) {
-    WebRtcSpl_Resample48khzTo8khz(speech_frame,
-                                  &speech_nb[i * kFrameLen10ms8khz],
-                                  &inst->state_48_to_8,
-                                  tmp_mem);
-  }
+  size_t nb_length;
+  const int16_t* nb_frame = DownsampleTo8khz(inst, 48000, speech_frame,
+                                             frame_length, speech_nb,
+                                             &nb_length);
 
   // Do VAD on an 8 kHz signal
-  vad = WebRtcVad_CalcVad8khz(inst, speech_nb, frame_length / 6);
-
-  return vad;
+  return WebRtcVad_CalcVad8khz(inst, nb_frame, nb_length);
 }
 
 int WebRtcVad_CalcVad32khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length)
-{
-    size_t len;
-    int vad;
-    int16_t speechWB[480]; // Downsampled speech frame: 960 samples (30ms in SWB)
-    int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
-
-
-    // Downsample signal 32->16->8 before doing VAD
-    WebRtcVad_Downsampling(speech_frame, speechWB, &(inst->downsampling_filter_states[2]),
-                           frame_length);
-    len = frame_length / 2;
-
-    WebRtcVad_Downsampling(speechWB, speechNB, inst->downsampling_filter_states, len);
-    len /= 2;
-
-    // Do VAD on an 8 kHz signal
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
+                           size_t frame_length) {
+  int16_t speech_nb[240];  // 30 ms in 8 kHz.
+  size_t nb_length;
+  const int16_t* nb_frame = DownsampleTo8khz(inst, 32000, speech_frame,
+                                             frame_length, speech_nb,
+                                             &nb_length);
 
-    return vad;
+  // Do VAD on an 8 kHz signal
+  return WebRtcVad_CalcVad8khz(inst, nb_frame, nb_length);
 }
 
 int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length)
-{
-    size_t len;
-    int vad;
-    int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
-
-    // Wideband: Downsample signal before doing VAD
-    WebRtcVad_Downsampling(speech_frame, speechNB, inst->downsampling_filter_states,
-                           frame_length);
-
-    len = frame_length / 2;
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
+                           size_t frame_length) {
+  int16_t speech_nb[240];  // 30 ms in 8 kHz.
+  size_t nb_length;
+  const int16_t* nb_frame = DownsampleTo8khz(inst, 16000, speech_frame,
+                                             frame_length, speech_nb,
+                                             &nb_length);
 
-    return vad;
+  // Do VAD on an 8 kHz signal
+  return WebRtcVad_CalcVad8khz(inst, nb_frame, nb_length);
 }
 
 int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
@@ -683,3 +701,39 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
 
     return inst->vad;
 }
+
+void WebRtcVad_CalcVadBatch(VadInstT* const* insts, size_t num_insts, int fs,
+                            const int16_t* const* speech_frames,
+                            size_t frame_length, int* vads) {
+  int16_t speech_nb[kNumBatchLanes][240];  // 30 ms in 8 kHz.
+  const int16_t* nb_frames[kNumBatchLanes];
+  int16_t feature_vectors[kNumBatchLanes * kNumChannels];
+  int16_t total_power[kNumBatchLanes];
+  size_t nb_length = 0;
+  size_t num_lanes;
+  size_t i, k;
+
+  // The filterbanks of |kNumBatchLanes| instances are run at a time, and the
+  // rest is done one instance at a time like in WebRtcVad_CalcVad8khz().
+  for (i = 0; i < num_insts; i += num_lanes) {
+    num_lanes = num_insts - i;
+    if (num_lanes > kNumBatchLanes) {
+      num_lanes = kNumBatchLanes;
+    }
+
+    for (k = 0; k < num_lanes; k++) {
+      nb_frames[k] = DownsampleTo8khz(insts[i + k], fs, speech_frames[i + k],
+                                      frame_length, speech_nb[k], &nb_length);
+    }
+
+    WebRtcVad_CalculateFeaturesBatch(&insts[i], nb_frames, num_lanes,
+                                     nb_length, feature_vectors, total_power);
+
+    for (k = 0; k < num_lanes; k++) {
+      VadInstT* inst = insts[i + k];
+      inst->vad = GmmProbability(inst, &feature_vectors[k * kNumChannels],
+                                 total_power[k], nb_length);
+      vads[i + k] = inst->vad;
+    }
+  }
+}
@@ -111,4 +111,15 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst,
                           const int16_t* speech_frame,
                           size_t frame_length);
 
+// Same as the WebRtcVad_CalcVadXXkhz() functions above, for |num_insts|
+// instances with one frame each. The frames are all sampled at |fs| (8000,
+// 16000, 32000 or 48000 Hz) and |frame_length| samples long. The VAD decision
+// of each instance is written to |vads|.
+void WebRtcVad_CalcVadBatch(VadInstT* const* insts,
+                            size_t num_insts,
+                            int fs,
+                            const int16_t* const* speech_frames,
+                            size_t frame_length,
+                            int* vads);
+
 #endif  // COMMON_AUDIO_VAD_VAD_CORE_H_
@@ -69,6 +69,18 @@ static void HighPassFilter(const int16_t* data_in, size_t data_length,
   }
 }
 
+// One sample of AllPassFilter(). |state32| is the filter state in Q15, and the
+// output is given in Q(-1).
+static int16_t AllPassStep(int16_t data_in, int16_t filter_coefficient,
+                           int32_t* state32) {
+  int32_t tmp32 = *state32 + filter_coefficient * data_in;
+  int16_t tmp16 = (int16_t) (tmp32 >> 16);  // Q(-1)
+
+  *state32 = (data_in * (1 << 14)) - filter_coefficient * tmp16;  // Q14
+  *state32 *= 2;  // Q15.
+  return tmp16;
+}
+
 // All pass filtering of |data_in|, used before splitting the signal into two
 // frequency bands (low pass vs high pass).
 // Note that |data_in| and |data_out| can NOT correspond to the same address.
@@ -88,16 +100,10 @@ static void AllPassFilter(const int16_t* data_in, size_t data_length,
   // 0.6399 0.5905 -0.3779 0.2418 -0.1547 0.0990
 
   size_t i;
-  int16_t tmp16 = 0;
-  int32_t tmp32 = 0;
   int32_t state32 = ((int32_t) (*filter_state) * (1 << 16));  // Q15
 
   for (i = 0; i < data_length; i++) {
-    tmp32 = state32 + filter_coefficient * *data_in;
-    tmp16 = (int16_t) (tmp32 >> 16);  // Q(-1)
-    *data_out++ = tmp16;
-    state32 = (*data_in * (1 << 14)) - filter_coefficient * tmp16;  // Q14
-    state32 *= 2;  // Q15.
+    *data_out++ = AllPassStep(*data_in, filter_coefficient, &state32);
     data_in += 2;
   }
 
@@ -327,3 +333,154 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
 
   return total_energy;
 }
+
+void WebRtcVad_SplitFilterBatchC(const int16_t* data_in, size_t data_length,
+                                 const int16_t* filter_coefficients,
+                                 int16_t* upper_state, int16_t* lower_state,
+                                 int16_t* hp_data_out, int16_t* lp_data_out) {
+  const size_t half_length = data_length >> 1;
+  size_t i, k;
+
+  for (k = 0; k < kNumBatchLanes; k++) {
+    int32_t upper_state32 = ((int32_t) upper_state[k] * (1 << 16));  // Q15
+    int32_t lower_state32 = ((int32_t) lower_state[k] * (1 << 16));  // Q15
+    const int16_t* in_ptr = &data_in[k];
+
+    for (i = 0; i < half_length; i++) {
+      int16_t hp = AllPassStep(in_ptr[0], filter_coefficients[0],
+                               &upper_state32);
+      int16_t lp = AllPassStep(in_ptr[kNumBatchLanes], filter_coefficients[1],
+                               &lower_state32);
+      hp_data_out[i * kNumBatchLanes + k] = hp - lp;
+      lp_data_out[i * kNumBatchLanes + k] = lp + hp;
+      in_ptr += 2 * kNumBatchLanes;
+    }
+
+    upper_state[k] = (int16_t) (upper_state32 >> 16);  // Q(-1)
+    lower_state[k] = (int16_t) (lower_state32 >> 16);  // Q(-1)
+  }
+}
+
+// SplitFilter() of |kNumBatchLanes| interleaved signals, with the fastest
+// implementation available.
+static void SplitFilterBatch(const int16_t* data_in, size_t data_length,
+                             int16_t* upper_state, int16_t* lower_state,
+                             int16_t* hp_data_out, int16_t* lp_data_out) {
+#if defined(WEBRTC_HAS_NEON)
+  WebRtcVad_SplitFilterBatchNeon(data_in, data_length, kAllPassCoefsQ15,
+                                 upper_state, lower_state, hp_data_out,
+                                 lp_data_out);
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  // SSE2 is always available on x86 and x64, so there's no need for runtime
+  // detection.
+  WebRtcVad_SplitFilterBatchSSE2(data_in, data_length, kAllPassCoefsQ15,
+                                 upper_state, lower_state, hp_data_out,
+                                 lp_data_out);
+#else
+  WebRtcVad_SplitFilterBatchC(data_in, data_length, kAllPassCoefsQ15,
+                              upper_state, lower_state, hp_data_out,
+                              lp_data_out);
+#endif
+}
+
+// Runs LogOfEnergy() on each of the first |num_instances| lanes of the
+// interleaved |data_in|. |total_energy| holds one value per instance, and
+// |features| |kNumChannels| values per instance.
+static void LogOfEnergyBatch(const int16_t* data_in, size_t data_length,
+                             size_t num_instances, int frequency_band,
+                             int16_t* total_energy, int16_t* features) {
+  int16_t lane_data[60];
+  size_t i, k;
+
+  RTC_DCHECK_LE(data_length, 60);
+
+  for (k = 0; k < num_instances; k++) {
+    for (i = 0; i < data_length; i++) {
+      lane_data[i] = data_in[i * kNumBatchLanes + k];
+    }
+    LogOfEnergy(lane_data, data_length, kOffsetVector[frequency_band],
+                &total_energy[k], &features[k * kNumChannels + frequency_band]);
+  }
+}
+
+void WebRtcVad_CalculateFeaturesBatch(VadInstT* const* selves,
+                                      const int16_t* const* data_in,
+                                      size_t num_instances,
+                                      size_t data_length,
+                                      int16_t* features,
+                                      int16_t* total_energy) {
+  // Same buffers as in WebRtcVad_CalculateFeatures(), holding the signals of
+  // all lanes interleaved sample by sample.
+  int16_t in[240 * kNumBatchLanes];
+  int16_t hp_120[120 * kNumBatchLanes], lp_120[120 * kNumBatchLanes];
+  int16_t hp_60[60 * kNumBatchLanes], lp_60[60 * kNumBatchLanes];
+  int16_t upper_state[5][kNumBatchLanes] = { { 0 } };
+  int16_t lower_state[5][kNumBatchLanes] = { { 0 } };
+  // The 0 Hz - 250 Hz band of a single instance, before and after high pass
+  // filtering.
+  int16_t lp_15[15], hp_15[15];
+  const size_t half_data_length = data_length >> 1;
+  size_t length = half_data_length;
+  int frequency_band;
+  size_t i, k;
+
+  RTC_DCHECK_LE(data_length, 240);
+  RTC_DCHECK_GT(num_instances, 0);
+  RTC_DCHECK_LE(num_instances, kNumBatchLanes);
+
+  // Lane |k| holds the signal of |selves[k]|. Unused lanes are fed with zeros
+  // and their output is dropped.
+  for (i = 0; i < data_length; i++) {
+    for (k = 0; k < kNumBatchLanes; k++) {
+      in[i * kNumBatchLanes + k] = k < num_instances ? data_in[k][i] : 0;
+    }
+  }
+  for (k = 0; k < num_instances; k++) {
+    total_energy[k] = 0;
+    for (frequency_band = 0; frequency_band < 5; frequency_band++) {
+      upper_state[frequency_band][k] = selves[k]->upper_state[frequency_band];
+      lower_state[frequency_band][k] = selves[k]->lower_state[frequency_band];
+    }
+  }
+
+  // The same split and energy calculations as WebRtcVad_CalculateFeatures(),
+  // in the same order.
+  SplitFilterBatch(in, data_length, upper_state[0], lower_state[0], hp_120,
+                   lp_120);
+  SplitFilterBatch(hp_120, length, upper_state[1], lower_state[1], hp_60,
+                   lp_60);
+  length >>= 1;
+  LogOfEnergyBatch(hp_60, length, num_instances, 5, total_energy, features);
+  LogOfEnergyBatch(lp_60, length, num_instances, 4, total_energy, features);
+
+  length = half_data_length;
+  SplitFilterBatch(lp_120, length, upper_state[2], lower_state[2], hp_60,
+                   lp_60);
+  length >>= 1;
+  LogOfEnergyBatch(hp_60, length, num_instances, 3, total_energy, features);
+
+  SplitFilterBatch(lp_60, length, upper_state[3], lower_state[3], hp_120,
+                   lp_120);
+  length >>= 1;
+  LogOfEnergyBatch(hp_120, length, num_instances, 2, total_energy, features);
+
+  SplitFilterBatch(lp_120, length, upper_state[4], lower_state[4], hp_60,
+                   lp_60);
+  length >>= 1;
+  LogOfEnergyBatch(hp_60, length, num_instances, 1, total_energy, features);
+
+  RTC_DCHECK_LE(length, 15);
+  for (k = 0; k < num_instances; k++) {
+    for (i = 0; i < length; i++) {
+      lp_15[i] = lp_60[i * kNumBatchLanes + k];
+    }
+    HighPassFilter(lp_15, length, selves[k]->hp_filter_state, hp_15);
+    LogOfEnergy(hp_15, length, kOffsetVector[0], &total_energy[k],
+                &features[k * kNumChannels]);
+
+    for (frequency_band = 0; frequency_band < 5; frequency_band++) {
+      selves[k]->upper_state[frequency_band] = upper_state[frequency_band][k];
+      selves[k]->lower_state[frequency_band] = lower_state[frequency_band][k];
+    }
+  }
+}
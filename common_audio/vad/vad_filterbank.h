@@ -42,4 +42,55 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self,
                                     size_t data_length,
                                     int16_t* features);
 
+// Number of VAD instances whose filterbanks are run in parallel by
+// WebRtcVad_CalculateFeaturesBatch().
+enum { kNumBatchLanes = 8 };
+
+// Same as WebRtcVad_CalculateFeatures() for up to |kNumBatchLanes| instances,
+// with bit exact results. The split filters of all instances are run in one
+// pass, with SSE2 or NEON where available.
+//
+// - selves        [i/o] : State information of the VAD instances.
+// - data_in       [i]   : Input audio data of each instance.
+// - num_instances [i]   : Number of instances, 1 to |kNumBatchLanes|.
+// - data_length   [i]   : Audio data size of each instance, in number of
+//                         samples.
+// - features      [o]   : |kNumChannels| features per instance, Q4.
+// - total_energy  [o]   : Total energy of the signal of each instance.
+void WebRtcVad_CalculateFeaturesBatch(VadInstT* const* selves,
+                                      const int16_t* const* data_in,
+                                      size_t num_instances,
+                                      size_t data_length,
+                                      int16_t* features,
+                                      int16_t* total_energy);
+
+// Split filters of |kNumBatchLanes| signals, which are interleaved sample by
+// sample in |data_in|, |hp_data_out| and |lp_data_out|. |upper_state| and
+// |lower_state| hold one state per signal, and |filter_coefficients| the upper
+// and lower all-pass filter coefficients in Q15. Exposed for testing.
+void WebRtcVad_SplitFilterBatchC(const int16_t* data_in,
+                                 size_t data_length,
+                                 const int16_t* filter_coefficients,
+                                 int16_t* upper_state,
+                                 int16_t* lower_state,
+                                 int16_t* hp_data_out,
+                                 int16_t* lp_data_out);
+#if defined(WEBRTC_HAS_NEON)
+void WebRtcVad_SplitFilterBatchNeon(const int16_t* data_in,
+                                    size_t data_length,
+                                    const int16_t* filter_coefficients,
+                                    int16_t* upper_state,
+                                    int16_t* lower_state,
+                                    int16_t* hp_data_out,
+                                    int16_t* lp_data_out);
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcVad_SplitFilterBatchSSE2(const int16_t* data_in,
+                                    size_t data_length,
+                                    const int16_t* filter_coefficients,
+                                    int16_t* upper_state,
+                                    int16_t* lower_state,
+                                    int16_t* hp_data_out,
+                                    int16_t* lp_data_out);
+#endif
+
 #endif  // COMMON_AUDIO_VAD_VAD_FILTERBANK_H_
@@ -0,0 +1,66 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <arm_neon.h>
+
+#include "common_audio/vad/vad_filterbank.h"
+
+// One step of AllPassFilter() in vad_filterbank.c for four lanes. Returns the
+// output in Q(-1) and updates |*state32|, in Q15.
+static int16x4_t AllPassStep(int16x4_t in,
+                             int16x4_t coefficient,
+                             int32x4_t* state32) {
+  // The narrowing shift truncates like the int16_t cast of the C version.
+  int16x4_t out = vshrn_n_s32(vmlal_s16(*state32, in, coefficient), 16);
+  // ((in << 14) - coefficient * out) * 2, in Q15.
+  *state32 = vshlq_n_s32(vmlsl_s16(vshll_n_s16(in, 14), out, coefficient), 1);
+  return out;
+}
+
+void WebRtcVad_SplitFilterBatchNeon(const int16_t* data_in,
+                                    size_t data_length,
+                                    const int16_t* filter_coefficients,
+                                    int16_t* upper_state,
+                                    int16_t* lower_state,
+                                    int16_t* hp_data_out,
+                                    int16_t* lp_data_out) {
+  const size_t half_length = data_length >> 1;
+  const int16x4_t upper_coefficient = vdup_n_s16(filter_coefficients[0]);
+  const int16x4_t lower_coefficient = vdup_n_s16(filter_coefficients[1]);
+  int16x8_t upper = vld1q_s16(upper_state);
+  int16x8_t lower = vld1q_s16(lower_state);
+  // The states in Q15, for lanes 0 - 3 and 4 - 7.
+  int32x4_t upper_low = vshll_n_s16(vget_low_s16(upper), 16);
+  int32x4_t upper_high = vshll_n_s16(vget_high_s16(upper), 16);
+  int32x4_t lower_low = vshll_n_s16(vget_low_s16(lower), 16);
+  int32x4_t lower_high = vshll_n_s16(vget_high_s16(lower), 16);
+  size_t i;
+
+  // Both the all-pass filters and the lanes are independent of each other, so
+  // the four recursions are interleaved.
+  for (i = 0; i < half_length; i++) {
+    int16x8_t even = vld1q_s16(&data_in[2 * i * kNumBatchLanes]);
+    int16x8_t odd = vld1q_s16(&data_in[(2 * i + 1) * kNumBatchLanes]);
+    int16x8_t hp = vcombine_s16(
+        AllPassStep(vget_low_s16(even), upper_coefficient, &upper_low),
+        AllPassStep(vget_high_s16(even), upper_coefficient, &upper_high));
+    int16x8_t lp = vcombine_s16(
+        AllPassStep(vget_low_s16(odd), lower_coefficient, &lower_low),
+        AllPassStep(vget_high_s16(odd), lower_coefficient, &lower_high));
+    // Wraps around like the int16_t arithmetic of SplitFilter().
+    vst1q_s16(&hp_data_out[i * kNumBatchLanes], vsubq_s16(hp, lp));
+    vst1q_s16(&lp_data_out[i * kNumBatchLanes], vaddq_s16(lp, hp));
+  }
+
+  vst1q_s16(upper_state, vcombine_s16(vshrn_n_s32(upper_low, 16),
+                                      vshrn_n_s32(upper_high, 16)));
+  vst1q_s16(lower_state, vcombine_s16(vshrn_n_s32(lower_low, 16),
+                                      vshrn_n_s32(lower_high, 16)));
+}
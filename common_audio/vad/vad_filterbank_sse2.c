@@ -0,0 +1,88 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "common_audio/vad/vad_filterbank.h"
+
+// Loads one int16_t per lane and sign-extends lanes 0 - 3 to |*low| and lanes
+// 4 - 7 to |*high|.
+static void LoadWidened(const int16_t* data, __m128i* low, __m128i* high) {
+  __m128i in = _mm_loadu_si128((const __m128i*)data);
+  *low = _mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16);
+  *high = _mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16);
+}
+
+// One step of AllPassFilter() in vad_filterbank.c for four lanes. |in| holds
+// sign-extended samples and |coefficient| the filter coefficient in the lower
+// 16 bits of each lane, so that _mm_madd_epi16() gives their 32-bit products.
+// Returns the sign-extended output in Q(-1) and updates |*state32|, in Q15.
+static __m128i AllPassStep(__m128i in, __m128i coefficient, __m128i* state32) {
+  __m128i tmp32 = _mm_add_epi32(*state32, _mm_madd_epi16(in, coefficient));
+  __m128i out = _mm_srai_epi32(tmp32, 16);  // Q(-1)
+  // ((in << 14) - coefficient * out) * 2, in Q15.
+  *state32 = _mm_slli_epi32(
+      _mm_sub_epi32(_mm_slli_epi32(in, 14), _mm_madd_epi16(out, coefficient)),
+      1);
+  return out;
+}
+
+void WebRtcVad_SplitFilterBatchSSE2(const int16_t* data_in,
+                                    size_t data_length,
+                                    const int16_t* filter_coefficients,
+                                    int16_t* upper_state,
+                                    int16_t* lower_state,
+                                    int16_t* hp_data_out,
+                                    int16_t* lp_data_out) {
+  const size_t half_length = data_length >> 1;
+  const __m128i upper_coefficient =
+      _mm_set1_epi32((uint16_t)filter_coefficients[0]);
+  const __m128i lower_coefficient =
+      _mm_set1_epi32((uint16_t)filter_coefficients[1]);
+  const __m128i zero = _mm_setzero_si128();
+  __m128i upper = _mm_loadu_si128((const __m128i*)upper_state);
+  __m128i lower = _mm_loadu_si128((const __m128i*)lower_state);
+  // The states in Q15, for lanes 0 - 3 and 4 - 7.
+  __m128i upper_low = _mm_unpacklo_epi16(zero, upper);
+  __m128i upper_high = _mm_unpackhi_epi16(zero, upper);
+  __m128i lower_low = _mm_unpacklo_epi16(zero, lower);
+  __m128i lower_high = _mm_unpackhi_epi16(zero, lower);
+  size_t i;
+
+  // Both the all-pass filters and the lanes are independent of each other, so
+  // the four recursions are interleaved.
+  for (i = 0; i < half_length; i++) {
+    __m128i even_low, even_high, odd_low, odd_high;
+    __m128i hp, lp;
+
+    LoadWidened(&data_in[2 * i * kNumBatchLanes], &even_low, &even_high);
+    LoadWidened(&data_in[(2 * i + 1) * kNumBatchLanes], &odd_low, &odd_high);
+    // The outputs are in the int16_t range, so the saturation of
+    // _mm_packs_epi32() never kicks in.
+    hp = _mm_packs_epi32(AllPassStep(even_low, upper_coefficient, &upper_low),
+                         AllPassStep(even_high, upper_coefficient,
+                                     &upper_high));
+    lp = _mm_packs_epi32(AllPassStep(odd_low, lower_coefficient, &lower_low),
+                         AllPassStep(odd_high, lower_coefficient,
+                                     &lower_high));
+    // Wraps around like the int16_t arithmetic of SplitFilter().
+    _mm_storeu_si128((__m128i*)&hp_data_out[i * kNumBatchLanes],
+                     _mm_sub_epi16(hp, lp));
+    _mm_storeu_si128((__m128i*)&lp_data_out[i * kNumBatchLanes],
+                     _mm_add_epi16(lp, hp));
+  }
+
+  upper = _mm_packs_epi32(_mm_srai_epi32(upper_low, 16),
+                          _mm_srai_epi32(upper_high, 16));
+  lower = _mm_packs_epi32(_mm_srai_epi32(lower_low, 16),
+                          _mm_srai_epi32(lower_high, 16));
+  _mm_storeu_si128((__m128i*)upper_state, upper);
+  _mm_storeu_si128((__m128i*)lower_state, lower);
+}
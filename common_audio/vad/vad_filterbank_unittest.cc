@@ -87,5 +87,95 @@ TEST_F(VadTest, vad_filterbank) {
 
   free(self);
 }
+
+TEST_F(VadTest, vad_filterbank_batch) {
+  // An incomplete batch and a full one.
+  const size_t kNumInstances[] = {3, kNumBatchLanes};
+  const int kNumFrames = 20;
+  VadInstT batch_selves[kNumBatchLanes];
+  VadInstT selves[kNumBatchLanes];
+  VadInstT* batch_self_ptrs[kNumBatchLanes];
+  int16_t speech[kNumBatchLanes][kMaxFrameLength];
+  const int16_t* speech_ptrs[kNumBatchLanes];
+  int16_t batch_features[kNumBatchLanes * kNumChannels];
+  int16_t batch_total_energy[kNumBatchLanes];
+  int16_t features[kNumChannels];
+
+  srand(17);
+  for (size_t num_instances : kNumInstances) {
+    for (size_t j = 0; j < kFrameLengthsSize; ++j) {
+      if (!ValidRatesAndFrameLengths(8000, kFrameLengths[j])) {
+        continue;
+      }
+      for (size_t k = 0; k < num_instances; ++k) {
+        ASSERT_EQ(0, WebRtcVad_InitCore(&batch_selves[k]));
+        ASSERT_EQ(0, WebRtcVad_InitCore(&selves[k]));
+        batch_self_ptrs[k] = &batch_selves[k];
+        speech_ptrs[k] = speech[k];
+      }
+      for (int frame = 0; frame < kNumFrames; ++frame) {
+        // Signals of different levels, including full scale noise which will
+        // wrap around in the filters.
+        for (size_t k = 0; k < num_instances; ++k) {
+          for (size_t i = 0; i < kFrameLengths[j]; ++i) {
+            speech[k][i] =
+                static_cast<int16_t>(rand() & 0xffff) >> (2 * k);
+          }
+        }
+        WebRtcVad_CalculateFeaturesBatch(batch_self_ptrs, speech_ptrs,
+                                         num_instances, kFrameLengths[j],
+                                         batch_features, batch_total_energy);
+        for (size_t k = 0; k < num_instances; ++k) {
+          EXPECT_EQ(WebRtcVad_CalculateFeatures(&selves[k], speech[k],
+                                                kFrameLengths[j], features),
+                    batch_total_energy[k]);
+          for (int c = 0; c < kNumChannels; ++c) {
+            EXPECT_EQ(features[c], batch_features[k * kNumChannels + c]);
+          }
+        }
+      }
+    }
+  }
+}
+
+#if defined(WEBRTC_HAS_NEON) || defined(WEBRTC_ARCH_X86_FAMILY)
+TEST_F(VadTest, vad_filterbank_batch_simd) {
+  const size_t kLength = 240;
+  const int16_t kCoefficients[2] = {20972, 5571};
+  int16_t in[kLength * kNumBatchLanes];
+  int16_t upper_state[kNumBatchLanes], lower_state[kNumBatchLanes];
+  int16_t upper_state_c[kNumBatchLanes], lower_state_c[kNumBatchLanes];
+  int16_t hp[kLength / 2 * kNumBatchLanes], lp[kLength / 2 * kNumBatchLanes];
+  int16_t hp_c[kLength / 2 * kNumBatchLanes];
+  int16_t lp_c[kLength / 2 * kNumBatchLanes];
+
+  srand(42);
+  for (int16_t& sample : in) {
+    sample = static_cast<int16_t>(rand() & 0xffff);
+  }
+  for (size_t k = 0; k < kNumBatchLanes; ++k) {
+    upper_state[k] = upper_state_c[k] = static_cast<int16_t>(rand() & 0xffff);
+    lower_state[k] = lower_state_c[k] = static_cast<int16_t>(rand() & 0xffff);
+  }
+
+#if defined(WEBRTC_HAS_NEON)
+  WebRtcVad_SplitFilterBatchNeon(in, kLength, kCoefficients, upper_state,
+                                 lower_state, hp, lp);
+#else
+  WebRtcVad_SplitFilterBatchSSE2(in, kLength, kCoefficients, upper_state,
+                                 lower_state, hp, lp);
+#endif
+  WebRtcVad_SplitFilterBatchC(in, kLength, kCoefficients, upper_state_c,
+                              lower_state_c, hp_c, lp_c);
+  for (size_t i = 0; i < kLength / 2 * kNumBatchLanes; ++i) {
+    EXPECT_EQ(hp_c[i], hp[i]);
+    EXPECT_EQ(lp_c[i], lp[i]);
+  }
+  for (size_t k = 0; k < kNumBatchLanes; ++k) {
+    EXPECT_EQ(upper_state_c[k], upper_state[k]);
+    EXPECT_EQ(lower_state_c[k], lower_state[k]);
+  }
+}
+#endif
 }  // namespace test
 }  // namespace webrtc
@@ -142,6 +142,82 @@ TEST_F(VadTest, ValidRatesFrameLengths) {
   }
 }
 
+TEST_F(VadTest, ProcessBatchMatchesProcess) {
+  // More instances than are processed in parallel, and not a multiple of it.
+  const size_t kNumHandles = 11;
+  const int kNumFrames = 10;
+  VadInst* batch_handles[kNumHandles];
+  VadInst* handles[kNumHandles];
+  int16_t speech[kNumHandles][kMaxFrameLength];
+  const int16_t* speech_ptrs[kNumHandles];
+  int decisions[kNumHandles];
+
+  for (size_t k = 0; k < kNumHandles; ++k) {
+    batch_handles[k] = WebRtcVad_Create();
+    handles[k] = WebRtcVad_Create();
+    speech_ptrs[k] = speech[k];
+  }
+
+  srand(17);
+  for (size_t i = 0; i < kRatesSize; ++i) {
+    for (size_t j = 0; j < kFrameLengthsSize; ++j) {
+      if (!ValidRatesAndFrameLengths(kRates[i], kFrameLengths[j])) {
+        EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kNumHandles,
+                                             kRates[i], speech_ptrs,
+                                             kFrameLengths[j], decisions));
+        continue;
+      }
+      for (size_t k = 0; k < kNumHandles; ++k) {
+        ASSERT_EQ(0, WebRtcVad_Init(batch_handles[k]));
+        ASSERT_EQ(0, WebRtcVad_Init(handles[k]));
+        const int mode = kModes[k % kModesSize];
+        ASSERT_EQ(0, WebRtcVad_set_mode(batch_handles[k], mode));
+        ASSERT_EQ(0, WebRtcVad_set_mode(handles[k], mode));
+      }
+      for (int frame = 0; frame < kNumFrames; ++frame) {
+        // Alternate between silence and noise of different levels, so that
+        // both decisions are seen.
+        for (size_t k = 0; k < kNumHandles; ++k) {
+          const bool active = (frame + k) % 4 < 2;
+          for (size_t n = 0; n < kFrameLengths[j]; ++n) {
+            speech[k][n] = active ? static_cast<int16_t>(rand() & 0xffff) >>
+                                        (k % 8)
+                                  : 0;
+          }
+        }
+        ASSERT_EQ(0, WebRtcVad_ProcessBatch(batch_handles, kNumHandles,
+                                            kRates[i], speech_ptrs,
+                                            kFrameLengths[j], decisions));
+        for (size_t k = 0; k < kNumHandles; ++k) {
+          EXPECT_EQ(WebRtcVad_Process(handles[k], kRates[i], speech[k],
+                                      kFrameLengths[j]),
+                    decisions[k]);
+        }
+      }
+    }
+  }
+
+  // Uninitialized instances and null pointers are rejected.
+  WebRtcVad_Free(batch_handles[0]);
+  batch_handles[0] = WebRtcVad_Create();
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kNumHandles, kRates[0],
+                                       speech_ptrs, kFrameLengths[0],
+                                       decisions));
+  ASSERT_EQ(0, WebRtcVad_Init(batch_handles[0]));
+  speech_ptrs[1] = nullptr;
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kNumHandles, kRates[0],
+                                       speech_ptrs, kFrameLengths[0],
+                                       decisions));
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kNumHandles, kRates[0],
+                                       speech_ptrs, kFrameLengths[0],
+                                       nullptr));
+
+  for (size_t k = 0; k < kNumHandles; ++k) {
+    WebRtcVad_Free(batch_handles[k]);
+    WebRtcVad_Free(handles[k]);
+  }
+}
+
 // TODO(bjornv): Add a process test, run on file.
 
 }  // namespace test
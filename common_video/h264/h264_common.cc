@@ -10,10 +10,21 @@
 
 #include "common_video/h264/h264_common.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <cstdint>
 
 namespace webrtc {
 namespace H264 {
+namespace {
+
+// Returns true if any of the eight bytes of |word| is zero.
+bool HasZeroByte(uint64_t word) {
+  return ((word - 0x0101010101010101ull) & ~word & 0x8080808080808080ull) != 0;
+}
+
+}  // namespace
 
 const uint8_t kNaluTypeMask = 0x1F;
 
@@ -22,31 +33,44 @@ std::vector<NaluIndex> FindNaluIndices(const uint8_t* buffer,
   // This is sorta like Boyer-Moore, but with only the first optimization step:
   // given a 3-byte sequence we're looking at, if the 3rd byte isn't 1 or 0,
   // skip ahead to the next 3-byte sequence. 0s and 1s are relatively rare, so
-  // this will skip the majority of reads/checks.
+  // this will skip the majority of reads/checks. Before that, eight bytes are
+  // checked at once for a zero: without one, no start sequence can begin at
+  // any of them.
   std::vector<NaluIndex> sequences;
   if (buffer_size < kNaluShortStartSequenceSize)
     return sequences;
 
   const size_t end = buffer_size - kNaluShortStartSequenceSize;
   for (size_t i = 0; i < end;) {
-    if (buffer[i + 2] > 1) {
-      i += 3;
-    } else if (buffer[i + 2] == 1 && buffer[i + 1] == 0 && buffer[i] == 0) {
-      // We found a start sequence, now check if it was a 3 of 4 byte one.
-      NaluIndex index = {i, i + 3, 0};
-      if (index.start_offset > 0 && buffer[index.start_offset - 1] == 0)
-        --index.start_offset;
-
-      // Update length of previous entry.
-      auto it = sequences.rbegin();
-      if (it != sequences.rend())
-        it->payload_size = index.start_offset - it->payload_start_offset;
-
-      sequences.push_back(index);
-
-      i += 3;
-    } else {
-      ++i;
+    uint64_t word;
+    if (i + sizeof(word) <= buffer_size) {
+      memcpy(&word, buffer + i, sizeof(word));
+      if (!HasZeroByte(word)) {
+        i += sizeof(word);
+        continue;
+      }
+    }
+    const size_t word_end = std::min(i + sizeof(word), end);
+    while (i < word_end) {
+      if (buffer[i + 2] > 1) {
+        i += 3;
+      } else if (buffer[i + 2] == 1 && buffer[i + 1] == 0 && buffer[i] == 0) {
+        // We found a start sequence, now check if it was a 3 of 4 byte one.
+        NaluIndex index = {i, i + 3, 0};
+        if (index.start_offset > 0 && buffer[index.start_offset - 1] == 0)
+          --index.start_offset;
+
+        // Update length of previous entry.
+        auto it = sequences.rbegin();
+        if (it != sequences.rend())
+          it->payload_size = index.start_offset - it->payload_start_offset;
+
+        sequences.push_back(index);
+
+        i += 3;
+      } else {
+        ++i;
+      }
     }
   }
 
@@ -66,22 +90,34 @@ std::vector<uint8_t> ParseRbsp(const uint8_t* data, size_t length) {
   std::vector<uint8_t> out;
   out.reserve(length);
 
-  for (size_t i = 0; i < length;) {
-    // Be careful about over/underflow here. byte_length_ - 3 can underflow, and
-    // i + 3 can overflow, but byte_length_ - i can't, because i < byte_length_
-    // above, and that expression will produce the number of bytes left in
-    // the stream including the byte at i.
-    if (length - i >= 3 && !data[i] && !data[i + 1] && data[i + 2] == 3) {
-      // Two rbsp bytes.
-      out.push_back(data[i++]);
-      out.push_back(data[i++]);
-      // Skip the emulation byte.
-      i++;
+  // Bytes are copied in runs between emulation bytes. Bytes before
+  // |copy_from| have been handled.
+  size_t copy_from = 0;
+  // Be careful about over/underflow here. length - 3 can underflow, and
+  // i + 3 can overflow, but length - i can't, because i never exceeds length,
+  // and that expression will produce the number of bytes left in the stream
+  // including the byte at i.
+  for (size_t i = 0; length - i >= 3;) {
+    // An emulation sequence starts with a zero byte, so it can't start at
+    // any of eight bytes without one.
+    uint64_t word;
+    if (length - i >= sizeof(word)) {
+      memcpy(&word, data + i, sizeof(word));
+      if (!HasZeroByte(word)) {
+        i += sizeof(word);
+        continue;
+      }
+    }
+    if (!data[i] && !data[i + 1] && data[i + 2] == 3) {
+      // Two rbsp bytes, then skip the emulation byte.
+      out.insert(out.end(), data + copy_from, data + i + 2);
+      i += 3;
+      copy_from = i;
     } else {
-      // Single rbsp byte.
-      out.push_back(data[i++]);
+      ++i;
     }
   }
+  out.insert(out.end(), data + copy_from, data + length);
   return out;
 }
 
@@ -91,21 +127,38 @@ void WriteRbsp(const uint8_t* bytes, size_t length, rtc::Buffer* destination) {
   size_t num_consecutive_zeros = 0;
   destination->EnsureCapacity(destination->size() + length);
 
-  for (size_t i = 0; i < length; ++i) {
+  // Bytes are copied in runs between escapes. Bytes before |copy_from| have
+  // been written.
+  size_t copy_from = 0;
+  for (size_t i = 0; i < length;) {
+    // Unless preceded by zeros, eight bytes without a zero need no escaping.
+    uint64_t word;
+    if (num_consecutive_zeros < kZerosInStartSequence &&
+        length - i >= sizeof(word)) {
+      memcpy(&word, bytes + i, sizeof(word));
+      if (!HasZeroByte(word)) {
+        i += sizeof(word);
+        num_consecutive_zeros = 0;
+        continue;
+      }
+    }
     uint8_t byte = bytes[i];
     if (byte <= kEmulationByte &&
         num_consecutive_zeros >= kZerosInStartSequence) {
       // Need to escape.
+      destination->AppendData(bytes + copy_from, i - copy_from);
       destination->AppendData(kEmulationByte);
+      copy_from = i;
       num_consecutive_zeros = 0;
     }
-    destination->AppendData(byte);
     if (byte == 0) {
       ++num_consecutive_zeros;
     } else {
       num_consecutive_zeros = 0;
     }
+    ++i;
   }
+  destination->AppendData(bytes + copy_from, length - copy_from);
 }
 
 }  // namespace H264
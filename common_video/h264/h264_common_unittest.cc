@@ -0,0 +1,193 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/h264/h264_common.h"
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace H264 {
+namespace {
+
+// Byte by byte version of FindNaluIndices().
+std::vector<NaluIndex> FindNaluIndicesSlow(const std::vector<uint8_t>& data) {
+  std::vector<NaluIndex> sequences;
+  for (size_t i = 0; i + kNaluShortStartSequenceSize < data.size(); ++i) {
+    if (data[i] != 0 || data[i + 1] != 0 || data[i + 2] != 1)
+      continue;
+    NaluIndex index = {i, i + 3, 0};
+    if (i > 0 && data[i - 1] == 0)
+      --index.start_offset;
+    if (!sequences.empty()) {
+      sequences.back().payload_size =
+          index.start_offset - sequences.back().payload_start_offset;
+    }
+    sequences.push_back(index);
+    i += 2;
+  }
+  if (!sequences.empty()) {
+    sequences.back().payload_size =
+        data.size() - sequences.back().payload_start_offset;
+  }
+  return sequences;
+}
+
+void ExpectSameIndices(const std::vector<NaluIndex>& expected,
+                       const std::vector<NaluIndex>& actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i].start_offset, actual[i].start_offset);
+    EXPECT_EQ(expected[i].payload_start_offset,
+              actual[i].payload_start_offset);
+    EXPECT_EQ(expected[i].payload_size, actual[i].payload_size);
+  }
+}
+
+// Random bytes with a start sequence about every |nalu_size| bytes. If
+// |extra_zeros| is set, one in 16 bytes is made zero to exercise partial
+// start sequences.
+std::vector<uint8_t> CreateBitstream(Random* random,
+                                     size_t size,
+                                     size_t nalu_size,
+                                     bool extra_zeros) {
+  std::vector<uint8_t> data(size);
+  for (uint8_t& byte : data) {
+    byte = random->Rand<uint8_t>();
+    if (extra_zeros && random->Rand(0, 15) == 0)
+      byte = 0;
+  }
+  for (size_t i = random->Rand(0, 7); i + 4 <= size; i += nalu_size) {
+    data[i] = 0;
+    data[i + 1] = 0;
+    data[i + 2] = random->Rand<bool>() ? 0 : 1;
+    data[i + 3] = 1;
+  }
+  return data;
+}
+
+TEST(H264CommonTest, FindsShortAndLongStartSequences) {
+  const uint8_t data[] = {0, 0, 1, 0x67, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+                          0, 0, 0, 1, 0x68, 0x11, 0x22, 0x33, 0x44, 0x55,
+                          0x66, 0x77, 0, 0, 1, 0x65, 0x88};
+  std::vector<NaluIndex> indices = FindNaluIndices(data, sizeof(data));
+  ASSERT_EQ(3u, indices.size());
+  EXPECT_EQ(0u, indices[0].start_offset);
+  EXPECT_EQ(3u, indices[0].payload_start_offset);
+  EXPECT_EQ(7u, indices[0].payload_size);
+  EXPECT_EQ(10u, indices[1].start_offset);
+  EXPECT_EQ(14u, indices[1].payload_start_offset);
+  EXPECT_EQ(8u, indices[1].payload_size);
+  EXPECT_EQ(22u, indices[2].start_offset);
+  EXPECT_EQ(25u, indices[2].payload_start_offset);
+  EXPECT_EQ(2u, indices[2].payload_size);
+}
+
+TEST(H264CommonTest, IgnoresStartSequenceWithoutPayload) {
+  const uint8_t data[] = {0, 0, 1, 0x67, 0x42, 0, 0, 1};
+  std::vector<NaluIndex> indices = FindNaluIndices(data, sizeof(data));
+  ASSERT_EQ(1u, indices.size());
+  EXPECT_EQ(sizeof(data) - 3, indices[0].payload_size);
+  EXPECT_TRUE(FindNaluIndices(data, 2).empty());
+}
+
+TEST(H264CommonTest, MatchesByteByByteSearch) {
+  Random random(0x1234);
+  for (size_t size : {3, 4, 7, 8, 9, 15, 16, 17, 100, 1000, 4096}) {
+    for (size_t nalu_size : {4, 5, 9, 31, 200}) {
+      std::vector<uint8_t> data = CreateBitstream(&random, size, nalu_size,
+                                                /*extra_zeros=*/true);
+      ExpectSameIndices(FindNaluIndicesSlow(data),
+                        FindNaluIndices(data.data(), data.size()));
+    }
+  }
+}
+
+TEST(H264CommonTest, ParseRbspRemovesEmulationBytes) {
+  const uint8_t data[] = {0x11, 0, 0, 3, 0, 0, 0, 3, 1, 0x22, 0, 0, 3};
+  const std::vector<uint8_t> expected = {0x11, 0, 0, 0, 0, 0, 1, 0x22, 0, 0};
+  EXPECT_EQ(expected, ParseRbsp(data, sizeof(data)));
+}
+
+TEST(H264CommonTest, WriteRbspEscapesStartSequences) {
+  const uint8_t data[] = {0x11, 0, 0, 0, 0, 0, 1, 0x22, 0, 0, 3, 0, 0, 4};
+  const uint8_t expected[] = {0x11, 0, 0, 3, 0, 0, 3, 0, 1, 0x22,
+                              0,    0, 3, 3, 0, 0, 4};
+  rtc::Buffer rbsp;
+  WriteRbsp(data, sizeof(data), &rbsp);
+  EXPECT_EQ(rtc::Buffer(expected), rbsp);
+}
+
+TEST(H264CommonTest, RbspRoundTrips) {
+  Random random(0x4321);
+  for (size_t size : {1, 2, 3, 7, 8, 9, 16, 17, 100, 1000, 4096}) {
+    std::vector<uint8_t> data = CreateBitstream(&random, size, 31,
+                                                /*extra_zeros=*/true);
+    rtc::Buffer rbsp;
+    WriteRbsp(data.data(), data.size(), &rbsp);
+    for (size_t i = 2; i < rbsp.size(); ++i) {
+      EXPECT_FALSE(rbsp[i - 2] == 0 && rbsp[i - 1] == 0 && rbsp[i] <= 2)
+          << "Unescaped sequence at " << i;
+    }
+    EXPECT_EQ(data, ParseRbsp(rbsp.data(), rbsp.size()));
+  }
+}
+
+TEST(H264CommonTest, DISABLED_FindNaluIndicesPerf) {
+  // About one 8 Mbps key frame.
+  constexpr size_t kFrameSize = 1000000;
+  constexpr int kNumIterations = 1000;
+  Random random(0x5678);
+  std::vector<uint8_t> data = CreateBitstream(&random, kFrameSize, 50000,
+                                              /*extra_zeros=*/false);
+  size_t num_nalus = 0;
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i)
+    num_nalus += FindNaluIndices(data.data(), data.size()).size();
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  RTC_LOG(LS_INFO) << "Found " << num_nalus / kNumIterations << " NALUs in "
+                   << elapsed_us / kNumIterations << " us per "
+                   << kFrameSize << " byte frame.";
+}
+
+TEST(H264CommonTest, DISABLED_RbspPerf) {
+  // One 8 Mbps key frame worth of slice data.
+  constexpr size_t kFrameSize = 1000000;
+  constexpr int kNumIterations = 1000;
+  Random random(0x8765);
+  std::vector<uint8_t> data = CreateBitstream(&random, kFrameSize, 50000,
+                                              /*extra_zeros=*/false);
+  rtc::Buffer rbsp;
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    rbsp.Clear();
+    WriteRbsp(data.data(), data.size(), &rbsp);
+  }
+  int64_t write_us = rtc::TimeMicros() - start_us;
+  size_t parsed_size = 0;
+  start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i)
+    parsed_size += ParseRbsp(rbsp.data(), rbsp.size()).size();
+  int64_t parse_us = rtc::TimeMicros() - start_us;
+  EXPECT_EQ(kNumIterations * kFrameSize, parsed_size);
+  RTC_LOG(LS_INFO) << "WriteRbsp: " << write_us / kNumIterations
+                   << " us, ParseRbsp: " << parse_us / kNumIterations
+                   << " us per " << kFrameSize << " byte frame.";
+}
+
+}  // namespace
+}  // namespace H264
+}  // namespace webrtc
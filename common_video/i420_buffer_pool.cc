@@ -21,12 +21,29 @@ I420BufferPool::I420BufferPool(bool zero_initialize)
     : I420BufferPool(zero_initialize, std::numeric_limits<size_t>::max()) {}
 I420BufferPool::I420BufferPool(bool zero_initialize,
                                size_t max_number_of_buffers)
+    : I420BufferPool(zero_initialize, max_number_of_buffers, 0) {}
+I420BufferPool::I420BufferPool(bool zero_initialize,
+                               size_t max_number_of_buffers,
+                               size_t max_retained_bytes)
     : zero_initialize_(zero_initialize),
-      max_number_of_buffers_(max_number_of_buffers) {}
+      max_number_of_buffers_(max_number_of_buffers),
+      max_retained_bytes_(max_retained_bytes) {}
 I420BufferPool::~I420BufferPool() = default;
 
 void I420BufferPool::Release() {
   buffers_.clear();
+  stats_.pool_bytes = 0;
+}
+
+I420BufferPool::Stats I420BufferPool::GetStats() const {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  return stats_;
+}
+
+size_t I420BufferPool::BufferBytes(const I420Buffer& buffer) {
+  int chroma_height = (buffer.height() + 1) / 2;
+  return buffer.StrideY() * buffer.height() +
+         (buffer.StrideU() + buffer.StrideV()) * chroma_height;
 }
 
 rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
@@ -41,27 +58,51 @@ rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
                                                             int stride_u,
                                                             int stride_v) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-  // Release buffers with wrong resolution.
+  auto has_wrong_resolution = [&](const PooledI420Buffer& buffer) {
+    return buffer.width() != width || buffer.height() != height ||
+           buffer.StrideY() != stride_y || buffer.StrideU() != stride_u ||
+           buffer.StrideV() != stride_v;
+  };
+  // Release the least recently used buffers with wrong resolution, until the
+  // rest fit within |max_retained_bytes_|.
+  size_t retained_bytes = 0;
   for (auto it = buffers_.begin(); it != buffers_.end();) {
-    const auto& buffer = *it;
-    if (buffer->width() != width || buffer->height() != height ||
-        buffer->StrideY() != stride_y || buffer->StrideU() != stride_u ||
-        buffer->StrideV() != stride_v) {
+    if (!has_wrong_resolution(**it)) {
+      ++it;
+      continue;
+    }
+    size_t buffer_bytes = BufferBytes(**it);
+    if (retained_bytes + buffer_bytes > max_retained_bytes_) {
+      stats_.pool_bytes -= buffer_bytes;
       it = buffers_.erase(it);
     } else {
+      retained_bytes += buffer_bytes;
       ++it;
     }
   }
   // Look for a free buffer.
-  for (const rtc::scoped_refptr<PooledI420Buffer>& buffer : buffers_) {
+  for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
     // If the buffer is in use, the ref count will be >= 2, one from the list we
     // are looping over and one from the application. If the ref count is 1,
     // then the list we are looping over holds the only reference and it's safe
     // to reuse.
-    if (buffer->HasOneRef())
-      return buffer;
+    if ((*it)->HasOneRef() && !has_wrong_resolution(**it)) {
+      buffers_.splice(buffers_.begin(), buffers_, it);
+      ++stats_.reused_buffers;
+      return buffers_.front();
+    }
   }
 
+  // Make room by releasing retained buffers with wrong resolution, least
+  // recently used first.
+  for (auto it = buffers_.end();
+       buffers_.size() >= max_number_of_buffers_ && it != buffers_.begin();) {
+    --it;
+    if (has_wrong_resolution(**it)) {
+      stats_.pool_bytes -= BufferBytes(**it);
+      it = buffers_.erase(it);
+    }
+  }
   if (buffers_.size() >= max_number_of_buffers_)
     return nullptr;
   // Allocate new buffer.
@@ -69,7 +110,9 @@ rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
       new PooledI420Buffer(width, height, stride_y, stride_u, stride_v);
   if (zero_initialize_)
     buffer->InitializeData();
-  buffers_.push_back(buffer);
+  buffers_.push_front(buffer);
+  ++stats_.allocated_buffers;
+  stats_.pool_bytes += BufferBytes(*buffer);
   return buffer;
 }
 
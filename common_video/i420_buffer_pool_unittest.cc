@@ -107,6 +107,58 @@ TEST(TestI420BufferPool, FrameValidAfterPoolDestruction) {
   memset(buffer->MutableDataY(), 0xA5, 16 * buffer->StrideY());
 }
 
+TEST(TestI420BufferPool, ReuseRetainedBufferOfOtherResolution) {
+  I420BufferPool pool(/*zero_initialize=*/false, 2,
+                      /*max_retained_bytes=*/384);
+  auto buffer = pool.CreateBuffer(16, 16);
+  const uint8_t* y_ptr = buffer->DataY();
+  buffer = nullptr;
+  // The 16x16 buffer takes 384 bytes, so it is kept.
+  buffer = pool.CreateBuffer(32, 32);
+  EXPECT_EQ(384u + 1536u, pool.GetStats().pool_bytes);
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(16, 16);
+  EXPECT_EQ(y_ptr, buffer->DataY());
+
+  I420BufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(1, stats.reused_buffers);
+  EXPECT_EQ(2, stats.allocated_buffers);
+  // The 32x32 buffer doesn't fit in the retained bytes.
+  EXPECT_EQ(384u, stats.pool_bytes);
+}
+
+TEST(TestI420BufferPool, ReleaseRetainedBufferToMakeRoom) {
+  I420BufferPool pool(/*zero_initialize=*/false, 1,
+                      /*max_retained_bytes=*/384);
+  auto buffer = pool.CreateBuffer(16, 16);
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(32, 32);
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(1536u, pool.GetStats().pool_bytes);
+  EXPECT_EQ(2, pool.GetStats().allocated_buffers);
+}
+
+TEST(TestI420BufferPool, ReleaseLeastRecentlyUsedOverRetainedBytes) {
+  I420BufferPool pool(/*zero_initialize=*/false, 10,
+                      /*max_retained_bytes=*/384 + 768);
+  auto buffer = pool.CreateBuffer(16, 16);
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(16, 32);
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(32, 16);
+  const uint8_t* y_ptr = buffer->DataY();
+  buffer = nullptr;
+  // The 16x32 and 32x16 buffers take 768 bytes each, so only the most recently
+  // used one of them is kept.
+  buffer = pool.CreateBuffer(16, 16);
+  EXPECT_EQ(384u + 768u, pool.GetStats().pool_bytes);
+  buffer = nullptr;
+  buffer = pool.CreateBuffer(32, 16);
+  EXPECT_EQ(y_ptr, buffer->DataY());
+  EXPECT_EQ(2, pool.GetStats().reused_buffers);
+  EXPECT_EQ(3, pool.GetStats().allocated_buffers);
+}
+
 TEST(TestI420BufferPool, MaxNumberOfBuffers) {
   I420BufferPool pool(false, 1);
   auto buffer1 = pool.CreateBuffer(16, 16);
@@ -12,6 +12,7 @@
 #define COMMON_VIDEO_INCLUDE_I420_BUFFER_POOL_H_
 
 #include <stddef.h>
+#include <stdint.h>
 
 #include <list>
 
@@ -26,14 +27,32 @@ namespace webrtc {
 // The pool manages the memory of the I420Buffer returned from CreateBuffer.
 // When the I420Buffer is destructed, the memory is returned to the pool for use
 // by subsequent calls to CreateBuffer. If the resolution passed to CreateBuffer
-// changes, old buffers will be purged from the pool.
+// changes, old buffers will be purged from the pool, unless the pool is allowed
+// to retain buffers of other resolutions.
 // Note that CreateBuffer will crash if more than kMaxNumberOfFramesBeforeCrash
 // are created. This is to prevent memory leaks where frames are not returned.
 class I420BufferPool {
  public:
+  struct Stats {
+    // Number of buffers returned by CreateBuffer that were reused from the
+    // pool, and that were allocated.
+    int64_t reused_buffers = 0;
+    int64_t allocated_buffers = 0;
+    // Total size of the buffers in the pool, in use or not.
+    size_t pool_bytes = 0;
+  };
+
   I420BufferPool();
   explicit I420BufferPool(bool zero_initialize);
   I420BufferPool(bool zero_initialze, size_t max_number_of_buffers);
+  // Buffers with another resolution or stride than requested by CreateBuffer
+  // are kept as long as they sum up to at most |max_retained_bytes|, least
+  // recently used buffers first out. That way, switching back and forth
+  // between resolutions, e.g. with simulcast or adaptive resolution, reuses
+  // buffers instead of allocating new ones.
+  I420BufferPool(bool zero_initialze,
+                 size_t max_number_of_buffers,
+                 size_t max_retained_bytes);
   ~I420BufferPool();
 
   // Returns a buffer from the pool. If no suitable buffer exist in the pool
@@ -52,13 +71,19 @@ class I420BufferPool {
   // later from another thread.
   void Release();
 
+  Stats GetStats() const;
+
  private:
   // Explicitly use a RefCountedObject to get access to HasOneRef,
   // needed by the pool to check exclusive access.
   using PooledI420Buffer = rtc::RefCountedObject<I420Buffer>;
+  using BufferList = std::list<rtc::scoped_refptr<PooledI420Buffer>>;
+
+  static size_t BufferBytes(const I420Buffer& buffer);
 
   rtc::RaceChecker race_checker_;
-  std::list<rtc::scoped_refptr<PooledI420Buffer>> buffers_;
+  // Most recently returned by CreateBuffer first.
+  BufferList buffers_;
   // If true, newly allocated buffers are zero-initialized. Note that recycled
   // buffers are not zero'd before reuse. This is required of buffers used by
   // FFmpeg according to http://crbug.com/390941, which only requires it for the
@@ -67,6 +92,8 @@ class I420BufferPool {
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
   const size_t max_number_of_buffers_;
+  const size_t max_retained_bytes_;
+  Stats stats_;
 };
 
 }  // namespace webrtc
@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "api/scoped_refptr.h"
+#include "api/video/i420_buffer.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_frame_buffer.h"
 
@@ -97,6 +98,14 @@ rtc::scoped_refptr<I420BufferInterface> ScaleVideoFrameBuffer(
     int dst_width,
     int dst_height);
 
+// Scales |source| into each of |dst_buffers|, which may have any sizes no
+// larger than |source|, e.g. one per simulcast layer. Each buffer is scaled
+// from the smallest buffer already scaled that is at least as large, rather
+// than from |source|, so that |source| is only read once when every size is
+// smaller than the next larger one.
+void ScaleI420Pyramid(const I420BufferInterface& source,
+                      const std::vector<I420Buffer*>& dst_buffers);
+
 double I420SSE(const I420BufferInterface& ref_buffer,
                const I420BufferInterface& test_buffer);
 
@@ -156,6 +165,52 @@ class NV12ToI420Scaler {
   std::vector<uint8_t> tmp_uv_planes_;
 };
 
+// Helper class for cropping and scaling an I420 buffer while converting it to
+// another format, e.g. ARGB for a renderer or NV12 for a hardware encoder,
+// instead of first writing the cropped and scaled I420 frame. Cropping only
+// offsets the source planes. Without scaling, the source is converted in a
+// single pass. With scaling, the Y plane is scaled straight into an NV12
+// destination and only the chroma planes go through temporary memory, which
+// is kept for the next call.
+class I420CropScaleConverter {
+ public:
+  I420CropScaleConverter();
+  ~I420CropScaleConverter();
+
+  // Scales the |crop_width|x|crop_height| rectangle of |src| at
+  // (|offset_x|, |offset_y|) to |dst_width|x|dst_height| and converts it to
+  // |dst_video_type| in |dst_frame|, with rows |dst_stride| bytes apart, or
+  // packed if |dst_stride| is 0. Odd offsets are rounded down, as by
+  // I420Buffer::CropAndScaleFrom.
+  // Return value: 0 if OK, < 0 otherwise.
+  int CropScaleAndConvert(const I420BufferInterface& src,
+                          int offset_x,
+                          int offset_y,
+                          int crop_width,
+                          int crop_height,
+                          VideoType dst_video_type,
+                          int dst_stride,
+                          int dst_width,
+                          int dst_height,
+                          uint8_t* dst_frame);
+
+  // As above, to an NV12 destination with separate planes.
+  int CropScaleAndConvertToNV12(const I420BufferInterface& src,
+                                int offset_x,
+                                int offset_y,
+                                int crop_width,
+                                int crop_height,
+                                uint8_t* dst_y,
+                                int dst_stride_y,
+                                uint8_t* dst_uv,
+                                int dst_stride_uv,
+                                int dst_width,
+                                int dst_height);
+
+ private:
+  std::vector<uint8_t> tmp_planes_;
+};
+
 // Convert VideoType to libyuv FourCC type
 int ConvertVideoType(VideoType video_type);
 
@@ -336,4 +336,59 @@ TEST_F(TestLibYuv, NV12Scale4x4to2x2) {
               ::testing::ElementsAre(Average(0, 2, 4, 6), Average(1, 3, 5, 7)));
 }
 
+TEST_F(TestLibYuv, ScaleI420PyramidMatchesDirectScaling) {
+  const I420BufferInterface& source =
+      *orig_frame_->video_frame_buffer()->GetI420();
+  // Given in increasing size order, and with one size that isn't nested in
+  // the others, to be scaled from the source.
+  std::vector<rtc::scoped_refptr<I420Buffer>> buffers = {
+      I420Buffer::Create(width_ / 4, height_ / 4),
+      I420Buffer::Create(width_ / 2, height_ / 2),
+      I420Buffer::Create(width_ / 2 + 2, height_ / 2 - 2),
+      I420Buffer::Create(width_, height_)};
+  std::vector<I420Buffer*> dst_buffers;
+  for (const auto& buffer : buffers)
+    dst_buffers.push_back(buffer.get());
+  ScaleI420Pyramid(source, dst_buffers);
+
+  EXPECT_EQ(48.0, I420PSNR(source, *buffers[3]));
+  for (const auto& buffer : buffers) {
+    rtc::scoped_refptr<I420BufferInterface> direct =
+        ScaleVideoFrameBuffer(source, buffer->width(), buffer->height());
+    EXPECT_GT(I420PSNR(*direct, *buffer), 30.0);
+  }
+}
+
+TEST_F(TestLibYuv, CropScaleAndConvertMatchesSeparateSteps) {
+  const I420BufferInterface& source =
+      *orig_frame_->video_frame_buffer()->GetI420();
+  const int kOffsetX = 11;
+  const int kOffsetY = 6;
+  const int kCropWidth = 300;
+  const int kCropHeight = 240;
+  I420CropScaleConverter converter;
+  for (const VideoType type : {VideoType::kARGB, VideoType::kNV12}) {
+    // Without and with scaling.
+    for (const int dst_width : {kCropWidth, width_ / 2}) {
+      const int dst_height = dst_width == kCropWidth ? kCropHeight : 144;
+      rtc::scoped_refptr<I420Buffer> cropped =
+          I420Buffer::Create(dst_width, dst_height);
+      cropped->CropAndScaleFrom(source, kOffsetX, kOffsetY, kCropWidth,
+                                kCropHeight);
+      const size_t size = CalcBufferSize(type, dst_width, dst_height);
+      std::vector<uint8_t> expected(size);
+      ASSERT_EQ(0, ConvertFromI420(VideoFrame::Builder()
+                                       .set_video_frame_buffer(cropped)
+                                       .build(),
+                                   type, 0, expected.data()));
+
+      std::vector<uint8_t> converted(size);
+      ASSERT_EQ(0, converter.CropScaleAndConvert(
+                       source, kOffsetX, kOffsetY, kCropWidth, kCropHeight,
+                       type, 0, dst_width, dst_height, converted.data()));
+      EXPECT_EQ(expected, converted);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "common_video/libyuv/include/webrtc_libyuv.h"
 
+#include <algorithm>
 #include <cstdint>
 
 #include "api/video/i420_buffer.h"
@@ -211,6 +212,37 @@ rtc::scoped_refptr<I420BufferInterface> ScaleVideoFrameBuffer(
   return scaled_buffer;
 }
 
+void ScaleI420Pyramid(const I420BufferInterface& source,
+                      const std::vector<I420Buffer*>& dst_buffers) {
+  // Largest first, so that every buffer can be scaled from a larger one.
+  std::vector<I420Buffer*> sorted_buffers = dst_buffers;
+  std::stable_sort(sorted_buffers.begin(), sorted_buffers.end(),
+                   [](const I420Buffer* a, const I420Buffer* b) {
+                     return a->width() * a->height() >
+                            b->width() * b->height();
+                   });
+  for (size_t i = 0; i < sorted_buffers.size(); ++i) {
+    I420Buffer* dst = sorted_buffers[i];
+    RTC_DCHECK_LE(dst->width(), source.width());
+    RTC_DCHECK_LE(dst->height(), source.height());
+    const I420BufferInterface* src = &source;
+    for (size_t j = i; j > 0; --j) {
+      const I420Buffer* scaled = sorted_buffers[j - 1];
+      if (scaled->width() >= dst->width() &&
+          scaled->height() >= dst->height()) {
+        src = scaled;
+        break;
+      }
+    }
+    libyuv::I420Scale(src->DataY(), src->StrideY(), src->DataU(),
+                      src->StrideU(), src->DataV(), src->StrideV(),
+                      src->width(), src->height(), dst->MutableDataY(),
+                      dst->StrideY(), dst->MutableDataU(), dst->StrideU(),
+                      dst->MutableDataV(), dst->StrideV(), dst->width(),
+                      dst->height(), libyuv::kFilterBilinear);
+  }
+}
+
 double I420SSE(const I420BufferInterface& ref_buffer,
                const I420BufferInterface& test_buffer) {
   RTC_DCHECK_EQ(ref_buffer.width(), test_buffer.width());
@@ -469,4 +501,141 @@ void NV12ToI420Scaler::NV12ToI420Scale(const uint8_t* src_y,
                     dst_height, libyuv::kFilterBox);
 }
 
+namespace {
+
+// Points |y|, |u| and |v| to the top left corner of the crop rectangle, with
+// the offsets rounded down to even values so that the u/v planes are aligned.
+bool CropPlanes(const I420BufferInterface& src,
+                int offset_x,
+                int offset_y,
+                int crop_width,
+                int crop_height,
+                const uint8_t** y,
+                const uint8_t** u,
+                const uint8_t** v) {
+  if (offset_x < 0 || offset_y < 0 || crop_width + offset_x > src.width() ||
+      crop_height + offset_y > src.height()) {
+    return false;
+  }
+  const int uv_offset_x = offset_x / 2;
+  const int uv_offset_y = offset_y / 2;
+  *y = src.DataY() + src.StrideY() * uv_offset_y * 2 + uv_offset_x * 2;
+  *u = src.DataU() + src.StrideU() * uv_offset_y + uv_offset_x;
+  *v = src.DataV() + src.StrideV() * uv_offset_y + uv_offset_x;
+  return true;
+}
+
+}  // namespace
+
+I420CropScaleConverter::I420CropScaleConverter() = default;
+I420CropScaleConverter::~I420CropScaleConverter() = default;
+
+int I420CropScaleConverter::CropScaleAndConvert(const I420BufferInterface& src,
+                                                int offset_x,
+                                                int offset_y,
+                                                int crop_width,
+                                                int crop_height,
+                                                VideoType dst_video_type,
+                                                int dst_stride,
+                                                int dst_width,
+                                                int dst_height,
+                                                uint8_t* dst_frame) {
+  if (dst_video_type == VideoType::kNV12) {
+    // Laid out as by libyuv::ConvertFromI420.
+    const int stride = dst_stride > 0 ? dst_stride : dst_width;
+    return CropScaleAndConvertToNV12(
+        src, offset_x, offset_y, crop_width, crop_height, dst_frame, stride,
+        dst_frame + stride * dst_height, stride, dst_width, dst_height);
+  }
+  const uint8_t* src_y;
+  const uint8_t* src_u;
+  const uint8_t* src_v;
+  if (!CropPlanes(src, offset_x, offset_y, crop_width, crop_height, &src_y,
+                  &src_u, &src_v)) {
+    return -1;
+  }
+  int src_stride_y = src.StrideY();
+  int src_stride_u = src.StrideU();
+  int src_stride_v = src.StrideV();
+
+  if (crop_width != dst_width || crop_height != dst_height) {
+    // The packed formats interleave the planes, so scale into temporary
+    // planes of the destination size first.
+    const int chroma_width = (dst_width + 1) / 2;
+    const int chroma_height = (dst_height + 1) / 2;
+    tmp_planes_.resize(dst_width * dst_height +
+                       2 * chroma_width * chroma_height);
+    uint8_t* const tmp_y = tmp_planes_.data();
+    uint8_t* const tmp_u = tmp_y + dst_width * dst_height;
+    uint8_t* const tmp_v = tmp_u + chroma_width * chroma_height;
+    int res = libyuv::I420Scale(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                                src_stride_v, crop_width, crop_height, tmp_y,
+                                dst_width, tmp_u, chroma_width, tmp_v,
+                                chroma_width, dst_width, dst_height,
+                                libyuv::kFilterBox);
+    if (res != 0)
+      return res;
+    src_y = tmp_y;
+    src_u = tmp_u;
+    src_v = tmp_v;
+    src_stride_y = dst_width;
+    src_stride_u = chroma_width;
+    src_stride_v = chroma_width;
+  }
+  return libyuv::ConvertFromI420(src_y, src_stride_y, src_u, src_stride_u,
+                                 src_v, src_stride_v, dst_frame, dst_stride,
+                                 dst_width, dst_height,
+                                 ConvertVideoType(dst_video_type));
+}
+
+int I420CropScaleConverter::CropScaleAndConvertToNV12(
+    const I420BufferInterface& src,
+    int offset_x,
+    int offset_y,
+    int crop_width,
+    int crop_height,
+    uint8_t* dst_y,
+    int dst_stride_y,
+    uint8_t* dst_uv,
+    int dst_stride_uv,
+    int dst_width,
+    int dst_height) {
+  const uint8_t* src_y;
+  const uint8_t* src_u;
+  const uint8_t* src_v;
+  if (!CropPlanes(src, offset_x, offset_y, crop_width, crop_height, &src_y,
+                  &src_u, &src_v)) {
+    return -1;
+  }
+
+  if (crop_width == dst_width && crop_height == dst_height) {
+    // No scaling.
+    tmp_planes_.clear();
+    tmp_planes_.shrink_to_fit();
+    return libyuv::I420ToNV12(src_y, src.StrideY(), src_u, src.StrideU(),
+                              src_v, src.StrideV(), dst_y, dst_stride_y, dst_uv,
+                              dst_stride_uv, dst_width, dst_height);
+  }
+
+  // Scaling. The Y plane is scaled into the destination, the U and V planes
+  // into temporary memory to be merged.
+  const int chroma_width = (dst_width + 1) / 2;
+  const int chroma_height = (dst_height + 1) / 2;
+  tmp_planes_.resize(2 * chroma_width * chroma_height);
+  tmp_planes_.shrink_to_fit();
+  uint8_t* const tmp_u = tmp_planes_.data();
+  uint8_t* const tmp_v = tmp_u + chroma_width * chroma_height;
+  libyuv::ScalePlane(src_y, src.StrideY(), crop_width, crop_height, dst_y,
+                     dst_stride_y, dst_width, dst_height, libyuv::kFilterBox);
+  libyuv::ScalePlane(src_u, src.StrideU(), (crop_width + 1) / 2,
+                     (crop_height + 1) / 2, tmp_u, chroma_width, chroma_width,
+                     chroma_height, libyuv::kFilterBox);
+  libyuv::ScalePlane(src_v, src.StrideV(), (crop_width + 1) / 2,
+                     (crop_height + 1) / 2, tmp_v, chroma_width, chroma_width,
+                     chroma_height, libyuv::kFilterBox);
+  libyuv::MergeUVPlane(tmp_u, chroma_width, tmp_v, chroma_width, dst_uv,
+                       dst_stride_uv, chroma_width, chroma_height);
+  return 0;
+}
+
 }  // namespace webrtc
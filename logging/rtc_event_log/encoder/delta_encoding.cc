@@ -106,6 +106,10 @@ constexpr bool kDefaultSignedDeltas = false;
 constexpr bool kDefaultValuesOptional = false;
 constexpr uint64_t kDefaultValueWidthBits = 64;
 
+// Deltas up to this wide are decoded through a 64-bit buffer that is refilled
+// a byte at a time, which can then hold up to this many bits plus seven.
+constexpr uint64_t kMaxBufferedDeltaWidthBits = 57;
+
 // Wrap BitBufferWriter and extend its functionality by (1) keeping track of
 // the number of bits written and (2) owning its buffer.
 class BitWriter final {
@@ -637,6 +641,8 @@ class FixedLengthDeltaDecoder final {
   // it reads, meaning the lifetime of |this| must not exceed the lifetime
   // of |reader|'s underlying buffer.
   FixedLengthDeltaDecoder(std::unique_ptr<rtc::BitBuffer> reader,
+                          const uint8_t* data,
+                          size_t size,
                           const FixedLengthEncodingParameters& params,
                           absl::optional<uint64_t> base,
                           size_t num_of_deltas);
@@ -644,6 +650,14 @@ class FixedLengthDeltaDecoder final {
   // Perform the decoding using the parameters given to the ctor.
   std::vector<absl::optional<uint64_t>> Decode();
 
+  // Decodes the deltas of the values in |existing_values| into |values|,
+  // reading |data_| a byte at a time into a 64-bit accumulator rather than
+  // calling into |reader_| for every delta. Only for when |base_| is known
+  // (so that no value is a varint) and deltas are at most
+  // kMaxBufferedDeltaWidthBits wide. Returns false if the input is too short.
+  bool DecodeBufferedDeltas(const std::vector<bool>& existing_values,
+                            std::vector<absl::optional<uint64_t>>* values);
+
   // Decode a varint and write it to |output|. Return value indicates success
   // or failure. In case of failure, no guarantees are made about the contents
   // of |output| or the results of additional reads.
@@ -668,6 +682,10 @@ class FixedLengthDeltaDecoder final {
   // See comment above ctor for details.
   const std::unique_ptr<rtc::BitBuffer> reader_;
 
+  // The buffer read by |reader_|, for DecodeBufferedDeltas().
+  const uint8_t* const data_;
+  const size_t size_;
+
   // The parameters according to which encoding will be done (width of
   // fields, whether signed deltas should be used, etc.)
   const FixedLengthEncodingParameters params_;
@@ -790,16 +808,21 @@ std::unique_ptr<FixedLengthDeltaDecoder> FixedLengthDeltaDecoder::Create(
 
   FixedLengthEncodingParameters params(delta_width_bits, signed_deltas,
                                        values_optional, value_width_bits);
-  return absl::WrapUnique(new FixedLengthDeltaDecoder(std::move(reader), params,
-                                                      base, num_of_deltas));
+  return absl::WrapUnique(new FixedLengthDeltaDecoder(
+      std::move(reader), reinterpret_cast<const uint8_t*>(&input[0]),
+      input.length(), params, base, num_of_deltas));
 }
 
 FixedLengthDeltaDecoder::FixedLengthDeltaDecoder(
     std::unique_ptr<rtc::BitBuffer> reader,
+    const uint8_t* data,
+    size_t size,
     const FixedLengthEncodingParameters& params,
     absl::optional<uint64_t> base,
     size_t num_of_deltas)
     : reader_(std::move(reader)),
+      data_(data),
+      size_(size),
       params_(params),
       base_(base),
       num_of_deltas_(num_of_deltas) {
@@ -824,9 +847,18 @@ std::vector<absl::optional<uint64_t>> FixedLengthDeltaDecoder::Decode() {
     std::fill(existing_values.begin(), existing_values.end(), true);
   }
 
-  absl::optional<uint64_t> previous = base_;
   std::vector<absl::optional<uint64_t>> values(num_of_deltas_);
 
+  if (base_.has_value() &&
+      params_.delta_width_bits() <= kMaxBufferedDeltaWidthBits) {
+    if (!DecodeBufferedDeltas(existing_values, &values)) {
+      return std::vector<absl::optional<uint64_t>>();
+    }
+    return values;
+  }
+
+  absl::optional<uint64_t> previous = base_;
+
   for (size_t i = 0; i < num_of_deltas_; ++i) {
     if (!existing_values[i]) {
       RTC_DCHECK(params_.values_optional());
@@ -857,6 +889,52 @@ std::vector<absl::optional<uint64_t>> FixedLengthDeltaDecoder::Decode() {
   return values;
 }
 
+bool FixedLengthDeltaDecoder::DecodeBufferedDeltas(
+    const std::vector<bool>& existing_values,
+    std::vector<absl::optional<uint64_t>>* values) {
+  RTC_DCHECK(base_.has_value());
+  RTC_DCHECK_LE(params_.delta_width_bits(), kMaxBufferedDeltaWidthBits);
+  RTC_DCHECK_EQ(values->size(), existing_values.size());
+
+  size_t byte_offset;
+  size_t bit_offset;
+  reader_->GetCurrentOffset(&byte_offset, &bit_offset);
+
+  // Bits are read higher before lower, as with BitBuffer. The lowest
+  // |buffered_bits| bits of |buffer| are the ones not yet consumed; the
+  // bits above them are stale, and are masked away when a delta is taken.
+  uint64_t buffer = 0;
+  size_t buffered_bits = 0;
+  if (bit_offset > 0) {
+    buffer = data_[byte_offset++];
+    buffered_bits = 8 - bit_offset;
+  }
+
+  const size_t delta_width_bits = params_.delta_width_bits();
+  const uint64_t delta_mask = params_.delta_mask();
+  uint64_t previous = base_.value();
+  for (size_t i = 0; i < existing_values.size(); ++i) {
+    if (!existing_values[i]) {
+      continue;
+    }
+    // Since fewer than |delta_width_bits| are buffered before the refill,
+    // this never buffers more than 64 bits.
+    while (buffered_bits < delta_width_bits) {
+      if (byte_offset == size_) {
+        RTC_LOG(LS_WARNING) << "Failed to read delta.";
+        return false;
+      }
+      buffer = (buffer << 8) | data_[byte_offset++];
+      buffered_bits += 8;
+    }
+    buffered_bits -= delta_width_bits;
+    const uint64_t delta = (buffer >> buffered_bits) & delta_mask;
+    previous = ApplyDelta(previous, delta);
+    (*values)[i] = previous;
+  }
+  return true;
+}
+
 bool FixedLengthDeltaDecoder::ParseVarInt(uint64_t* output) {
   RTC_DCHECK(reader_);
   return DecodeVarInt(reader_.get(), output) != 0;
@@ -20,7 +20,9 @@
 #include "absl/types/optional.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -686,8 +688,33 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(DeltaSignedness::kNoOverride,
                           DeltaSignedness::kForceUnsigned,
                           DeltaSignedness::kForceSigned),
-        ::testing::Values(1, 4, 8, 15, 16, 17, 31, 32, 33, 63, 64),
+        ::testing::Values(1, 4, 8, 15, 16, 17, 31, 32, 33, 56, 57, 58, 63, 64),
         ::testing::Bool()));
 
+TEST(DeltaEncodingPerfTest, DISABLED_DecodeDeltasPerf) {
+  constexpr size_t kNumValues = 1000;
+  constexpr int kIterations = 10000;
+  for (uint64_t delta_width : {8, 16, 32, 64}) {
+    Random prng(delta_width);
+    const uint64_t base = prng.Rand<uint32_t>();
+    std::vector<absl::optional<uint64_t>> values(kNumValues);
+    uint64_t previous = base;
+    for (absl::optional<uint64_t>& value : values) {
+      previous += RandomWithMaxBitWidth(&prng, delta_width - 1);
+      value = previous;
+    }
+    const std::string encoded = EncodeDeltas(base, values);
+
+    const int64_t start_ns = rtc::TimeNanos();
+    for (int i = 0; i < kIterations; ++i) {
+      ASSERT_EQ(DecodeDeltas(encoded, base, kNumValues).size(), kNumValues);
+    }
+    const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+    RTC_LOG(LS_INFO) << "Deltas of up to " << delta_width << " bits: "
+                     << elapsed_ns / (kIterations * kNumValues)
+                     << " ns per value.";
+  }
+}
+
 }  // namespace
 }  // namespace webrtc
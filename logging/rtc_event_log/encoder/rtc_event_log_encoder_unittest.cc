@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <deque>
 #include <limits>
 #include <memory>
@@ -1168,6 +1169,114 @@ TEST_P(RtcEventLogEncoderTest, RtcEventVideoSendStreamConfig) {
   verifier_.VerifyLoggedVideoSendConfig(*event, video_send_configs[0]);
 }
 
+TEST_P(RtcEventLogEncoderTest, ParseStringInBatches) {
+  rtc::ScopedFakeClock fake_clock;
+  fake_clock.SetTime(Timestamp::ms(prng_.Rand<uint32_t>()));
+
+  // Several outputs of the encoder, each with two types of events.
+  constexpr size_t kNumOutputs = 5;
+  std::vector<std::unique_ptr<RtcEventAlrState>> alr_events;
+  std::vector<std::unique_ptr<RtcEventBweUpdateDelayBased>> bwe_events;
+  std::string encoded;
+  for (size_t output = 0; output < kNumOutputs; ++output) {
+    history_.clear();
+    for (size_t i = 0; i < event_count_; ++i) {
+      alr_events.push_back(gen_.NewAlrState());
+      history_.push_back(alr_events.back()->Copy());
+      fake_clock.AdvanceTime(TimeDelta::ms(prng_.Rand(1, 1000)));
+      bwe_events.push_back(gen_.NewBweUpdateDelayBased());
+      history_.push_back(bwe_events.back()->Copy());
+      fake_clock.AdvanceTime(TimeDelta::ms(prng_.Rand(1, 1000)));
+    }
+    encoded += encoder_->EncodeBatch(history_.begin(), history_.end());
+  }
+
+  // With the smallest batch size, each batch holds a single legacy event or
+  // a single output of the new format encoder.
+  size_t num_batches = 0;
+  size_t alr_index = 0;
+  size_t bwe_index = 0;
+  int64_t last_batch_end_us = std::numeric_limits<int64_t>::min();
+  auto on_batch = [&] {
+    ++num_batches;
+    int64_t batch_start_us = std::numeric_limits<int64_t>::max();
+    int64_t batch_end_us = std::numeric_limits<int64_t>::min();
+    for (const LoggedAlrStateEvent& event : parsed_log_.alr_state_events()) {
+      ASSERT_LT(alr_index, alr_events.size());
+      verifier_.VerifyLoggedAlrStateEvent(*alr_events[alr_index++], event);
+      batch_start_us = std::min(batch_start_us, event.log_time_us());
+      batch_end_us = std::max(batch_end_us, event.log_time_us());
+    }
+    for (const LoggedBweDelayBasedUpdate& event :
+         parsed_log_.bwe_delay_updates()) {
+      ASSERT_LT(bwe_index, bwe_events.size());
+      verifier_.VerifyLoggedBweDelayBasedUpdate(*bwe_events[bwe_index++],
+                                                event);
+      batch_start_us = std::min(batch_start_us, event.log_time_us());
+      batch_end_us = std::max(batch_end_us, event.log_time_us());
+    }
+    EXPECT_GT(batch_start_us, last_batch_end_us);
+    last_batch_end_us = batch_end_us;
+  };
+  ASSERT_TRUE(parsed_log_.ParseStringInBatches(encoded, 1, on_batch));
+
+  EXPECT_EQ(alr_index, alr_events.size());
+  EXPECT_EQ(bwe_index, bwe_events.size());
+  EXPECT_EQ(num_batches,
+            new_encoding_ ? kNumOutputs : 2 * kNumOutputs * event_count_);
+}
+
+TEST_P(RtcEventLogEncoderTest, ParseStringWithDecodingThreads) {
+  // Several outputs of the encoder, each with RTP packets of a few SSRCs
+  // and another type of event.
+  constexpr size_t kNumOutputs = 5;
+  const std::vector<uint32_t> kSsrcPool = {0x00000000, 0x12345678,
+                                           0xffffffff};
+  RtpHeaderExtensionMap extension_map;
+  if (new_encoding_) {
+    extension_map = gen_.NewRtpHeaderExtensionMap(true);
+  }
+  std::map<uint32_t, std::vector<std::unique_ptr<RtcEventRtpPacketIncoming>>>
+      rtp_events_by_ssrc;
+  std::vector<std::unique_ptr<RtcEventAlrState>> alr_events;
+  std::string encoded;
+  for (size_t output = 0; output < kNumOutputs; ++output) {
+    history_.clear();
+    for (size_t i = 0; i < event_count_; ++i) {
+      const uint32_t ssrc = kSsrcPool[prng_.Rand(kSsrcPool.size() - 1)];
+      std::unique_ptr<RtcEventRtpPacketIncoming> rtp_event =
+          NewRtpPacket<RtcEventRtpPacketIncoming>(ssrc, extension_map);
+      history_.push_back(rtp_event->Copy());
+      rtp_events_by_ssrc[ssrc].push_back(std::move(rtp_event));
+      alr_events.push_back(gen_.NewAlrState());
+      history_.push_back(alr_events.back()->Copy());
+    }
+    encoded += encoder_->EncodeBatch(history_.begin(), history_.end());
+  }
+
+  ParsedRtcEventLog parsed_log(
+      ParsedRtcEventLog::UnconfiguredHeaderExtensions::kDontParse,
+      /*num_decoding_threads=*/4);
+  ASSERT_TRUE(parsed_log.ParseString(encoded));
+
+  for (const auto& kv : rtp_events_by_ssrc) {
+    const std::vector<LoggedRtpPacketIncoming>* parsed_rtp_packets =
+        GetRtpPacketsBySsrc<LoggedRtpPacketIncoming>(&parsed_log, kv.first);
+    ASSERT_NE(parsed_rtp_packets, nullptr);
+    ASSERT_EQ(kv.second.size(), parsed_rtp_packets->size());
+    for (size_t i = 0; i < kv.second.size(); ++i) {
+      verifier_.VerifyLoggedRtpPacket<RtcEventRtpPacketIncoming,
+                                      LoggedRtpPacketIncoming>(
+          *kv.second[i], (*parsed_rtp_packets)[i]);
+    }
+  }
+  const auto& alr_state_events = parsed_log.alr_state_events();
+  ASSERT_EQ(alr_state_events.size(), alr_events.size());
+  for (size_t i = 0; i < alr_events.size(); ++i) {
+    verifier_.VerifyLoggedAlrStateEvent(*alr_events[i], alr_state_events[i]);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     RandomSeeds,
     RtcEventLogEncoderTest,
@@ -0,0 +1,215 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/output/rtc_event_log_output_rotating_file.h"
+
+#include <limits>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/file_rotating_stream.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/time_utils.h"
+#include "third_party/zlib/zlib.h"
+
+namespace webrtc {
+
+namespace {
+
+const char kFilePrefix[] = "webrtc_event_log_segment";
+constexpr size_t kCompressedBufferSize = 16 * 1024;
+// Window bits for deflate() to write gzip rather than zlib headers.
+constexpr int kGzipWindowBits = 15 + 16;
+
+}  // namespace
+
+// One file per segment, rotated only by RtcEventLogOutputRotatingFile, so that
+// files always end between two gzip members.
+class RtcEventLogOutputRotatingFile::SegmentStream final
+    : public rtc::FileRotatingStream {
+ public:
+  explicit SegmentStream(const std::string& dir_path)
+      : rtc::FileRotatingStream(dir_path,
+                                kFilePrefix,
+                                std::numeric_limits<size_t>::max(),
+                                kNumWindowSegments + 2) {}
+
+  void Rotate() { RotateFiles(); }
+
+ protected:
+  void OnRotation() override {
+    ++num_rotations_;
+    if (num_rotations_ == GetNumFiles() - 1) {
+      // On the next rotation the first segment is going to be deleted. Change
+      // the rotation index so this doesn't happen.
+      SetRotationIndex(GetRotationIndex() - 1);
+    }
+  }
+
+ private:
+  size_t num_rotations_ = 0;
+};
+
+RtcEventLogOutputRotatingFile::RtcEventLogOutputRotatingFile(
+    const std::string& dir_path,
+    int64_t window_ms,
+    size_t max_total_size_bytes)
+    : segment_duration_ms_(window_ms / kNumWindowSegments),
+      max_segment_size_bytes_(max_total_size_bytes / (kNumWindowSegments + 2)),
+      stream_(std::make_unique<SegmentStream>(dir_path)),
+      zstream_(std::make_unique<z_stream_s>()),
+      compressed_(kCompressedBufferSize) {
+  RTC_DCHECK_GT(segment_duration_ms_, 0);
+  RTC_DCHECK_GT(max_segment_size_bytes_, 0);
+  rtc::CritScope lock(&lock_);
+  if (!stream_->Open()) {
+    RTC_LOG(LS_ERROR) << "Invalid directory. WebRTC event log not started.";
+    return;
+  }
+  if (deflateInit2(zstream_.get(), Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                   kGzipWindowBits, /*memLevel=*/8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    RTC_LOG(LS_ERROR) << "Failed to initialize compression.";
+    stream_->Close();
+    return;
+  }
+  active_ = true;
+}
+
+RtcEventLogOutputRotatingFile::~RtcEventLogOutputRotatingFile() {
+  rtc::CritScope lock(&lock_);
+  if (active_) {
+    FinishMember();
+    deflateEnd(zstream_.get());
+  }
+  stream_->Close();
+}
+
+bool RtcEventLogOutputRotatingFile::IsActive() const {
+  rtc::CritScope lock(&lock_);
+  return active_;
+}
+
+bool RtcEventLogOutputRotatingFile::Write(const std::string& output) {
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK(active_);
+
+  const int64_t now_ms = rtc::TimeMillis();
+  if (segment_started_ &&
+      (now_ms - segment_start_ms_ >= segment_duration_ms_ ||
+       segment_size_bytes_ >= max_segment_size_bytes_)) {
+    if (!FinishMember())
+      return Fail();
+    stream_->Rotate();
+    segment_started_ = false;
+    segment_size_bytes_ = 0;
+  }
+  if (!segment_started_) {
+    segment_started_ = true;
+    segment_start_ms_ = now_ms;
+  }
+  member_open_ = true;
+  if (!Deflate(output.data(), output.size(), Z_NO_FLUSH))
+    return Fail();
+  return true;
+}
+
+void RtcEventLogOutputRotatingFile::Flush() {
+  rtc::CritScope lock(&lock_);
+  if (!active_)
+    return;
+  if (member_open_ && !Deflate(nullptr, 0, Z_SYNC_FLUSH)) {
+    Fail();
+    return;
+  }
+  stream_->Flush();
+}
+
+bool RtcEventLogOutputRotatingFile::SaveWindow(const std::string& file_name) {
+  rtc::CritScope lock(&lock_);
+  if (!active_)
+    return false;
+  if (!FinishMember()) {
+    Fail();
+    return false;
+  }
+  stream_->Flush();
+
+  FileWrapper output = FileWrapper::OpenWriteOnly(file_name);
+  if (!output.is_open()) {
+    RTC_LOG(LS_ERROR) << "Failed to open " << file_name;
+    return false;
+  }
+  // The oldest file, i.e. the first segment, has the highest index.
+  for (size_t i = stream_->GetNumFiles(); i > 0; --i) {
+    FileWrapper segment =
+        FileWrapper::OpenReadOnly(stream_->GetFilePath(i - 1));
+    if (!segment.is_open())
+      continue;
+    size_t read;
+    while ((read = segment.Read(compressed_.data(), compressed_.size())) > 0) {
+      if (!output.Write(compressed_.data(), read)) {
+        RTC_LOG(LS_ERROR) << "Failed to write " << file_name;
+        return false;
+      }
+    }
+  }
+  return output.Close();
+}
+
+bool RtcEventLogOutputRotatingFile::Deflate(const void* data,
+                                            size_t size,
+                                            int flush) {
+  z_stream_s* zstream = zstream_.get();
+  zstream->next_in = static_cast<Bytef*>(const_cast<void*>(data));
+  zstream->avail_in = static_cast<uInt>(size);
+  int result;
+  do {
+    zstream->next_out = compressed_.data();
+    zstream->avail_out = static_cast<uInt>(compressed_.size());
+    result = deflate(zstream, flush);
+    if (result == Z_STREAM_ERROR) {
+      RTC_LOG(LS_ERROR) << "Failed to compress WebRTC event log.";
+      return false;
+    }
+    const size_t compressed_size = compressed_.size() - zstream->avail_out;
+    if (compressed_size > 0 &&
+        stream_->WriteAll(compressed_.data(), compressed_size, nullptr,
+                          nullptr) != rtc::SR_SUCCESS) {
+      RTC_LOG(LS_ERROR) << "Write to WebRtcEventLog file failed.";
+      return false;
+    }
+    segment_size_bytes_ += compressed_size;
+  } while (zstream->avail_out == 0 ||
+           (flush == Z_FINISH && result != Z_STREAM_END));
+  RTC_DCHECK_EQ(zstream->avail_in, 0);
+  return true;
+}
+
+bool RtcEventLogOutputRotatingFile::FinishMember() {
+  if (!member_open_)
+    return true;
+  member_open_ = false;
+  if (!Deflate(nullptr, 0, Z_FINISH))
+    return false;
+  deflateReset(zstream_.get());
+  return true;
+}
+
+bool RtcEventLogOutputRotatingFile::Fail() {
+  // As with RtcEventLogOutputFile, the first failure closes the output.
+  deflateEnd(zstream_.get());
+  stream_->Close();
+  active_ = false;
+  member_open_ = false;
+  return false;
+}
+
+}  // namespace webrtc
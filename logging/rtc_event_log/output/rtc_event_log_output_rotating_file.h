@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef LOGGING_RTC_EVENT_LOG_OUTPUT_RTC_EVENT_LOG_OUTPUT_ROTATING_FILE_H_
+#define LOGGING_RTC_EVENT_LOG_OUTPUT_RTC_EVENT_LOG_OUTPUT_ROTATING_FILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/rtc_event_log_output.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+struct z_stream_s;
+
+namespace webrtc {
+
+// Event log output that can stay enabled for the whole of a call at a
+// bounded cost, by keeping only the start of the log and its last
+// |window_ms| or so, gzip compressed, in |dir_path|. SaveWindow() persists
+// what is kept, e.g. when the quality of the call degrades.
+//
+// The log is written in segments of |window_ms| / kNumWindowSegments, each a
+// file holding one or more gzip members. As with
+// rtc::CallSessionFileRotatingStream, the first segment is kept for the
+// log start event and the configurations logged with it, and the oldest of
+// the others is deleted whenever a new one is started. A segment also ends
+// early once it holds its share of |max_total_size_bytes|, in which case the
+// window is shorter. Configurations logged later are lost along with their
+// segment.
+//
+// Decompressing the output, e.g. with gunzip, gives back an event log that
+// ParsedRtcEventLog reads.
+class RtcEventLogOutputRotatingFile final : public RtcEventLogOutput {
+ public:
+  // Number of segments making up the window, besides the first segment and
+  // the one being written.
+  static constexpr size_t kNumWindowSegments = 6;
+
+  // Files in |dir_path| from an earlier output are deleted.
+  RtcEventLogOutputRotatingFile(const std::string& dir_path,
+                                int64_t window_ms,
+                                size_t max_total_size_bytes);
+  ~RtcEventLogOutputRotatingFile() override;
+
+  bool IsActive() const override;
+
+  bool Write(const std::string& output) override;
+
+  void Flush() override;
+
+  // Writes the first segment and the current window to |file_name|, as one
+  // gzip file. Can be called on any thread. Returns true on success.
+  bool SaveWindow(const std::string& file_name);
+
+ private:
+  class SegmentStream;
+
+  // Compresses |size| bytes of |data| into the current segment. |flush| is
+  // passed on to deflate().
+  bool Deflate(const void* data, size_t size, int flush)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Ends the gzip member being written, if any, so that the files written so
+  // far can be decompressed.
+  bool FinishMember() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  bool Fail() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  const int64_t segment_duration_ms_;
+  const size_t max_segment_size_bytes_;
+
+  rtc::CriticalSection lock_;
+  const std::unique_ptr<SegmentStream> stream_ RTC_GUARDED_BY(lock_);
+  const std::unique_ptr<z_stream_s> zstream_ RTC_GUARDED_BY(lock_);
+  std::vector<uint8_t> compressed_ RTC_GUARDED_BY(lock_);
+  bool active_ RTC_GUARDED_BY(lock_) = false;
+  bool member_open_ RTC_GUARDED_BY(lock_) = false;
+  bool segment_started_ RTC_GUARDED_BY(lock_) = false;
+  int64_t segment_start_ms_ RTC_GUARDED_BY(lock_) = 0;
+  size_t segment_size_bytes_ RTC_GUARDED_BY(lock_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // LOGGING_RTC_EVENT_LOG_OUTPUT_RTC_EVENT_LOG_OUTPUT_ROTATING_FILE_H_
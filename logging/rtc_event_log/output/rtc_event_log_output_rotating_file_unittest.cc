@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "logging/rtc_event_log/output/rtc_event_log_output_rotating_file.h"
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/fake_clock.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+#include "third_party/zlib/zlib.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kWindowMs = 60000;
+constexpr int64_t kSegmentMs =
+    kWindowMs / RtcEventLogOutputRotatingFile::kNumWindowSegments;
+constexpr size_t kMaxTotalSize = 1024 * 1024;
+
+std::string ReadFile(const std::string& file_name) {
+  std::ifstream file(file_name, std::ios_base::in | std::ios_base::binary);
+  RTC_CHECK(file.is_open());
+  return std::string((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+}
+
+// Decompresses all gzip members in |compressed|.
+std::string Gunzip(const std::string& compressed) {
+  std::string result;
+  z_stream zstream = {};
+  RTC_CHECK_EQ(inflateInit2(&zstream, 15 + 16), Z_OK);
+  zstream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+  zstream.avail_in = static_cast<uInt>(compressed.size());
+  char buffer[1024];
+  while (zstream.avail_in > 0) {
+    zstream.next_out = reinterpret_cast<Bytef*>(buffer);
+    zstream.avail_out = sizeof(buffer);
+    const int status = inflate(&zstream, Z_NO_FLUSH);
+    RTC_CHECK(status == Z_OK || status == Z_STREAM_END);
+    result.append(buffer, sizeof(buffer) - zstream.avail_out);
+    if (status == Z_STREAM_END)
+      inflateReset(&zstream);
+  }
+  inflateEnd(&zstream);
+  return result;
+}
+
+class RtcEventLogOutputRotatingFileTest : public ::testing::Test {
+ public:
+  RtcEventLogOutputRotatingFileTest() {
+    auto test_info = ::testing::UnitTest::GetInstance()->current_test_info();
+    dir_path_ = test::OutputPath() + test_info->test_case_name() +
+                test_info->name() + test::kPathDelimiter;
+    RTC_CHECK(test::CreateDir(dir_path_));
+    saved_file_name_ = test::OutputPath() + test_info->name() + ".gz";
+    fake_clock_.SetTime(Timestamp::ms(1000));
+  }
+
+  ~RtcEventLogOutputRotatingFileTest() override {
+    for (const std::string& file : *test::ReadDirectory(dir_path_))
+      test::RemoveFile(file);
+    test::RemoveDir(dir_path_);
+    test::RemoveFile(saved_file_name_);
+  }
+
+ protected:
+  rtc::ScopedFakeClock fake_clock_;
+  std::string dir_path_;
+  std::string saved_file_name_;
+};
+
+TEST_F(RtcEventLogOutputRotatingFileTest, SavesEverythingWithinWindow) {
+  RtcEventLogOutputRotatingFile output(dir_path_, kWindowMs, kMaxTotalSize);
+  ASSERT_TRUE(output.IsActive());
+  EXPECT_TRUE(output.Write("start,"));
+  fake_clock_.AdvanceTime(TimeDelta::ms(kSegmentMs));
+  EXPECT_TRUE(output.Write("one,"));
+  EXPECT_TRUE(output.Write("two"));
+
+  ASSERT_TRUE(output.SaveWindow(saved_file_name_));
+  EXPECT_EQ(Gunzip(ReadFile(saved_file_name_)), "start,one,two");
+
+  // Writing continues after saving, in a new gzip member.
+  EXPECT_TRUE(output.Write(",three"));
+  ASSERT_TRUE(output.SaveWindow(saved_file_name_));
+  EXPECT_EQ(Gunzip(ReadFile(saved_file_name_)), "start,one,two,three");
+}
+
+TEST_F(RtcEventLogOutputRotatingFileTest, KeepsFirstSegmentAndWindow) {
+  RtcEventLogOutputRotatingFile output(dir_path_, kWindowMs, kMaxTotalSize);
+  ASSERT_TRUE(output.IsActive());
+  std::string expected = "start,";
+  EXPECT_TRUE(output.Write("start,"));
+  constexpr int kNumSegments = 20;
+  for (int i = 1; i <= kNumSegments; ++i) {
+    fake_clock_.AdvanceTime(TimeDelta::ms(kSegmentMs));
+    const std::string event = std::to_string(i) + ",";
+    EXPECT_TRUE(output.Write(event));
+    if (i > kNumSegments - 1 -
+                static_cast<int>(
+                    RtcEventLogOutputRotatingFile::kNumWindowSegments)) {
+      expected += event;
+    }
+  }
+
+  ASSERT_TRUE(output.SaveWindow(saved_file_name_));
+  EXPECT_EQ(Gunzip(ReadFile(saved_file_name_)), expected);
+}
+
+TEST_F(RtcEventLogOutputRotatingFileTest, SegmentsEndEarlyWhenFull) {
+  // Incompressible events, filling up the segments before they're due.
+  constexpr size_t kSegmentSize = 64 * 1024;
+  constexpr size_t kTotalSize =
+      kSegmentSize * (RtcEventLogOutputRotatingFile::kNumWindowSegments + 2);
+  RtcEventLogOutputRotatingFile output(dir_path_, kWindowMs, kTotalSize);
+  ASSERT_TRUE(output.IsActive());
+  uint32_t state = 1;
+  std::string events;
+  for (int i = 0; i < 1000; ++i) {
+    std::string event(4096, '\0');
+    for (char& c : event) {
+      state = state * 1664525 + 1013904223;
+      c = static_cast<char>(state >> 24);
+    }
+    EXPECT_TRUE(output.Write(event));
+    events += event;
+  }
+
+  ASSERT_TRUE(output.SaveWindow(saved_file_name_));
+  const std::string saved = ReadFile(saved_file_name_);
+  // Segments can overshoot by what the compressor buffers.
+  EXPECT_LT(saved.size(), kTotalSize + kTotalSize / 2);
+  // The newest events are all there.
+  const std::string decompressed = Gunzip(saved);
+  ASSERT_GT(decompressed.size(), kSegmentSize);
+  EXPECT_EQ(decompressed.substr(decompressed.size() - kSegmentSize),
+            events.substr(events.size() - kSegmentSize));
+}
+
+}  // namespace
+}  // namespace webrtc
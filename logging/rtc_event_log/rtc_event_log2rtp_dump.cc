@@ -69,6 +69,9 @@ namespace {
 
 using MediaType = webrtc::ParsedRtcEventLog::MediaType;
 
+// Bytes of the input log to parse before writing out the parsed packets.
+constexpr size_t kBatchSizeBytes = 16 * 1024 * 1024;
+
 // Parses the input string for a valid SSRC. If a valid SSRC is found, it is
 // written to the output variable |ssrc|, and true is returned. Otherwise,
 // false is returned.
@@ -185,12 +188,6 @@ int main(int argc, char* argv[]) {
     RTC_CHECK(ssrc_filter.has_value()) << "Failed to read SSRC filter flag.";
   }
 
-  webrtc::ParsedRtcEventLog parsed_stream;
-  if (!parsed_stream.ParseFile(input_file)) {
-    std::cerr << "Error while parsing input file: " << input_file << std::endl;
-    return -1;
-  }
-
   std::unique_ptr<webrtc::test::RtpFileWriter> rtp_writer(
       webrtc::test::RtpFileWriter::Create(
           webrtc::test::RtpFileWriter::FileFormat::kRtpDump, output_file));
@@ -230,21 +227,32 @@ int main(int argc, char* argv[]) {
     rtcp_counter++;
   };
 
-  webrtc::RtcEventProcessor event_processor;
-  for (const auto& stream : parsed_stream.incoming_rtp_packets_by_ssrc()) {
-    MediaType media_type =
-        parsed_stream.GetMediaType(stream.ssrc, webrtc::kIncomingPacket);
-    if (ShouldSkipStream(media_type, stream.ssrc, ssrc_filter))
-      continue;
-    event_processor.AddEvents(stream.incoming_packets, handle_rtp);
-  }
-  // Note that |packet_ssrc| is the sender SSRC. An RTCP message may contain
-  // report blocks for many streams, thus several SSRCs and they don't
-  // necessarily have to be of the same media type. We therefore don't
-  // support filtering of RTCP based on SSRC and media type.
-  event_processor.AddEvents(parsed_stream.incoming_rtcp_packets(), handle_rtcp);
+  // The log is parsed and written a batch at a time, so that long logs don't
+  // have to fit in memory.
+  webrtc::ParsedRtcEventLog parsed_stream;
+  auto handle_batch = [&]() {
+    webrtc::RtcEventProcessor event_processor;
+    for (const auto& stream : parsed_stream.incoming_rtp_packets_by_ssrc()) {
+      MediaType media_type =
+          parsed_stream.GetMediaType(stream.ssrc, webrtc::kIncomingPacket);
+      if (ShouldSkipStream(media_type, stream.ssrc, ssrc_filter))
+        continue;
+      event_processor.AddEvents(stream.incoming_packets, handle_rtp);
+    }
+    // Note that |packet_ssrc| is the sender SSRC. An RTCP message may contain
+    // report blocks for many streams, thus several SSRCs and they don't
+    // necessarily have to be of the same media type. We therefore don't
+    // support filtering of RTCP based on SSRC and media type.
+    event_processor.AddEvents(parsed_stream.incoming_rtcp_packets(),
+                              handle_rtcp);
 
-  event_processor.ProcessEventsInOrder();
+    event_processor.ProcessEventsInOrder();
+  };
+  if (!parsed_stream.ParseFileInBatches(input_file, kBatchSizeBytes,
+                                        handle_batch)) {
+    std::cerr << "Error while parsing input file: " << input_file << std::endl;
+    return -1;
+  }
 
   std::cout << "Wrote " << rtp_counter << (header_only ? " header-only" : "")
             << " RTP packets and " << rtcp_counter << " RTCP packets to the "
@@ -35,6 +35,10 @@ constexpr size_t kMaxEventsInHistory = 10000;
 // The config-history is supposed to be unbounded, but needs to have some bound
 // to prevent an attack via unreasonable memory use.
 constexpr size_t kMaxEventsInConfigHistory = 1000;
+// Number of events that can wait in the lock-free ingest queue for the next
+// drain before Log() falls back to posting a task per event. Covers well over
+// a second of full packet logging on a busy call.
+constexpr size_t kIngestQueueSize = 4096;
 
 std::unique_ptr<RtcEventLogEncoder> CreateEncoder(
     RtcEventLog::EncodingType type) {
@@ -60,6 +64,8 @@ RtcEventLogImpl::RtcEventLogImpl(RtcEventLog::EncodingType encoding_type,
       num_config_events_written_(0),
       last_output_ms_(rtc::TimeMillis()),
       output_scheduled_(false),
+      ingest_queue_(kIngestQueueSize),
+      drain_scheduled_(false),
       logging_state_started_(false),
       task_queue_(
           std::make_unique<rtc::TaskQueue>(task_queue_factory->CreateTaskQueue(
@@ -100,6 +106,9 @@ bool RtcEventLogImpl::StartLogging(std::unique_ptr<RtcEventLogOutput> output,
                          output = std::move(output)]() mutable {
     RTC_DCHECK_RUN_ON(task_queue_.get());
     RTC_DCHECK(output->IsActive());
+    // Events logged before logging started belong to the history that is
+    // written below.
+    DrainIngestQueue(/*wait_for_pending_pushes=*/true);
     output_period_ms_ = output_period_ms;
     event_output_ = std::move(output);
     num_config_events_written_ = 0;
@@ -131,6 +140,7 @@ void RtcEventLogImpl::StopLogging(std::function<void()> callback) {
   logging_state_started_ = false;
   task_queue_->PostTask([this, callback] {
     RTC_DCHECK_RUN_ON(task_queue_.get());
+    DrainIngestQueue(/*wait_for_pending_pushes=*/true);
     if (event_output_) {
       RTC_DCHECK(event_output_->IsActive());
       LogEventsFromMemoryToOutput();
@@ -143,15 +153,56 @@ void RtcEventLogImpl::StopLogging(std::function<void()> callback) {
 void RtcEventLogImpl::Log(std::unique_ptr<RtcEvent> event) {
   RTC_CHECK(event);
 
+  if (ingest_queue_.TryPush(&event)) {
+    // Only the push that finds no drain pending posts one; the events pushed
+    // until the drain starts are handled in the same batch.
+    if (!drain_scheduled_.exchange(true, std::memory_order_acq_rel)) {
+      // Binding to |this| is safe because |this| outlives the |task_queue_|.
+      task_queue_->PostTask([this] {
+        RTC_DCHECK_RUN_ON(task_queue_.get());
+        // Cleared before draining, so that an event pushed from here on
+        // posts a new drain if this one misses it.
+        drain_scheduled_.store(false, std::memory_order_release);
+        DrainIngestQueue(/*wait_for_pending_pushes=*/false);
+        if (event_output_)
+          ScheduleOutput();
+      });
+    }
+    return;
+  }
+
+  // The ingest queue is full. Empty it before logging the event so that
+  // events from this thread stay in order.
   // Binding to |this| is safe because |this| outlives the |task_queue_|.
   task_queue_->PostTask([this, event = std::move(event)]() mutable {
     RTC_DCHECK_RUN_ON(task_queue_.get());
+    DrainIngestQueue(/*wait_for_pending_pushes=*/true);
     LogToMemory(std::move(event));
     if (event_output_)
       ScheduleOutput();
   });
 }
 
+void RtcEventLogImpl::DrainIngestQueue(bool wait_for_pending_pushes) {
+  std::unique_ptr<RtcEvent> event;
+  while (!ingest_queue_.Empty()) {
+    if (!ingest_queue_.TryPop(&event)) {
+      if (!wait_for_pending_pushes) {
+        // The next event is still being written by its producer, which
+        // posts another drain once it is done.
+        break;
+      }
+      continue;
+    }
+    LogToMemory(std::move(event));
+    if (event_output_ && history_.size() >= kMaxEventsInHistory) {
+      // A batch may hold more events than fit in the history; write out
+      // what is there rather than dropping events.
+      LogEventsFromMemoryToOutput();
+    }
+  }
+}
+
 void RtcEventLogImpl::ScheduleOutput() {
   RTC_DCHECK(event_output_ && event_output_->IsActive());
   if (history_.size() >= kMaxEventsInHistory) {
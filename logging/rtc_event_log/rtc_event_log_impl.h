@@ -11,6 +11,7 @@
 #ifndef LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_IMPL_H_
 #define LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_IMPL_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
@@ -23,6 +24,7 @@
 #include "api/rtc_event_log_output.h"
 #include "api/task_queue/task_queue_factory.h"
 #include "logging/rtc_event_log/encoder/rtc_event_log_encoder.h"
+#include "rtc_base/bounded_mpsc_queue.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
@@ -49,6 +51,10 @@ class RtcEventLogImpl final : public RtcEventLog {
 
  private:
   void LogToMemory(std::unique_ptr<RtcEvent> event) RTC_RUN_ON(task_queue_);
+  // Moves the events waiting in |ingest_queue_| into memory, writing them to
+  // the output early if the history fills up. If |wait_for_pending_pushes|
+  // is false, stops at an event that is still being pushed.
+  void DrainIngestQueue(bool wait_for_pending_pushes) RTC_RUN_ON(task_queue_);
   void LogEventsFromMemoryToOutput() RTC_RUN_ON(task_queue_);
 
   void StopOutput() RTC_RUN_ON(task_queue_);
@@ -78,6 +84,12 @@ class RtcEventLogImpl final : public RtcEventLog {
   int64_t last_output_ms_ RTC_GUARDED_BY(*task_queue_);
   bool output_scheduled_ RTC_GUARDED_BY(*task_queue_);
 
+  // Events logged since the last drain. Log() pushes to it from any thread
+  // and posts one drain task per batch instead of one task per event.
+  BoundedMpscQueue<std::unique_ptr<RtcEvent>> ingest_queue_;
+  // Set while a drain task is posted and has not yet started to drain.
+  std::atomic<bool> drain_scheduled_;
+
   SequenceChecker logging_state_checker_;
   bool logging_state_started_ RTC_GUARDED_BY(logging_state_checker_);
 
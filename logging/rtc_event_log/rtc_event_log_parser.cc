@@ -13,11 +13,21 @@
 #include <stdint.h>
 #include <string.h>
 
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <istream>  // no-presubmit-check TODO(webrtc:8982)
+#include <iterator>
 #include <limits>
 #include <map>
+#include <memory>
 #include <utility>
 
 #include "absl/memory/memory.h"
@@ -41,6 +51,7 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/protobuf_utils.h"
 
 using webrtc_event_logging::ToSigned;
@@ -240,28 +251,21 @@ IceCandidatePairEventType GetRuntimeIceCandidatePairEventType(
   return IceCandidatePairEventType::kCheckSent;
 }
 
-// Reads a VarInt from |stream| and returns it. Also writes the read bytes to
-// |buffer| starting |bytes_written| bytes into the buffer. |bytes_written| is
-// incremented for each written byte.
-absl::optional<uint64_t> ParseVarInt(
-    std::istream& stream,  // no-presubmit-check TODO(webrtc:8982)
-    char* buffer,
-    size_t* bytes_written) {
+// Reads a VarInt starting |*bytes_read| bytes into |s| and returns it.
+// |bytes_read| is incremented for each read byte.
+absl::optional<uint64_t> ParseVarInt(absl::string_view s, size_t* bytes_read) {
   uint64_t varint = 0;
-  for (size_t bytes_read = 0; bytes_read < 10; ++bytes_read) {
+  for (size_t i = 0; i < 10; ++i) {
     // The most significant bit of each byte is 0 if it is the last byte in
     // the varint and 1 otherwise. Thus, we take the 7 least significant bits
     // of each byte and shift them 7 bits for each byte read previously to get
     // the (unsigned) integer.
-    int byte = stream.get();
-    if (stream.eof()) {
+    if (*bytes_read >= s.size()) {
       return absl::nullopt;
     }
-    RTC_DCHECK_GE(byte, 0);
-    RTC_DCHECK_LE(byte, 255);
-    varint |= static_cast<uint64_t>(byte & 0x7F) << (7 * bytes_read);
-    buffer[*bytes_written] = byte;
-    *bytes_written += 1;
+    const uint8_t byte = static_cast<uint8_t>(s[*bytes_read]);
+    varint |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+    *bytes_read += 1;
     if ((byte & 0x80) == 0) {
       return varint;
     }
@@ -269,6 +273,63 @@ absl::optional<uint64_t> ParseVarInt(
   return absl::nullopt;
 }
 
+// The contents of a file, memory-mapped where supported and read into memory
+// otherwise. Mapping lets the OS page the log in as it is parsed and drop the
+// pages again, instead of holding a copy of the whole file.
+class FileContents {
+ public:
+  FileContents() = default;
+  FileContents(const FileContents&) = delete;
+  FileContents& operator=(const FileContents&) = delete;
+  ~FileContents() {
+#if defined(WEBRTC_POSIX)
+    if (mapped_)
+      munmap(mapped_, mapped_size_);
+#endif
+  }
+
+  bool Open(const std::string& file_name) {
+#if defined(WEBRTC_POSIX)
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+      return false;
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      void* mapped = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE,
+                          fd, 0);
+      if (mapped != MAP_FAILED) {
+        // The log is read once from start to end.
+        madvise(mapped, file_stat.st_size, MADV_SEQUENTIAL);
+        mapped_ = mapped;
+        mapped_size_ = file_stat.st_size;
+      }
+    }
+    close(fd);
+    if (mapped_)
+      return true;
+    // Empty files and files that can't be mapped, e.g. pipes, are read.
+#endif
+    std::ifstream file(  // no-presubmit-check TODO(webrtc:8982)
+        file_name, std::ios_base::in | std::ios_base::binary);
+    if (!file.good() || !file.is_open())
+      return false;
+    contents_.assign(std::istreambuf_iterator<char>(file),
+                     std::istreambuf_iterator<char>());
+    return !file.bad();
+  }
+
+  absl::string_view data() const {
+    if (mapped_)
+      return absl::string_view(static_cast<const char*>(mapped_), mapped_size_);
+    return contents_;
+  }
+
+ private:
+  void* mapped_ = nullptr;
+  size_t mapped_size_ = 0;
+  std::string contents_;
+};
+
 void GetHeaderExtensions(std::vector<RtpExtension>* header_extensions,
                          const RepeatedPtrField<rtclog::RtpHeaderExtension>&
                              proto_header_extensions) {
@@ -282,6 +343,21 @@ void GetHeaderExtensions(std::vector<RtpExtension>* header_extensions,
   }
 }
 
+// Moves the packets of each SSRC in |from| to the end of those in |to|.
+template <typename LoggedType>
+void AppendRtpPackets(std::map<uint32_t, std::vector<LoggedType>>* from,
+                      std::map<uint32_t, std::vector<LoggedType>>* to) {
+  for (auto& kv : *from) {
+    std::vector<LoggedType>& packets = (*to)[kv.first];
+    if (packets.empty()) {
+      packets = std::move(kv.second);
+    } else {
+      packets.insert(packets.end(), std::make_move_iterator(kv.second.begin()),
+                     std::make_move_iterator(kv.second.end()));
+    }
+  }
+}
+
 template <typename ProtoType, typename LoggedType>
 void StoreRtpPackets(
     const ProtoType& proto,
@@ -958,9 +1034,11 @@ ParsedRtcEventLog::GetDefaultHeaderExtensionMap() {
 }
 
 ParsedRtcEventLog::ParsedRtcEventLog(
-    UnconfiguredHeaderExtensions parse_unconfigured_header_extensions)
+    UnconfiguredHeaderExtensions parse_unconfigured_header_extensions,
+    size_t num_decoding_threads)
     : parse_unconfigured_header_extensions_(
-          parse_unconfigured_header_extensions) {
+          parse_unconfigured_header_extensions),
+      num_decoding_threads_(std::max<size_t>(num_decoding_threads, 1)) {
   Clear();
 }
 
@@ -974,6 +1052,27 @@ void ParsedRtcEventLog::Clear() {
   outgoing_video_ssrcs_.clear();
   outgoing_audio_ssrcs_.clear();
 
+  ClearBatch();
+
+  start_log_events_.clear();
+  stop_log_events_.clear();
+  ice_candidate_pair_configs_.clear();
+  audio_recv_configs_.clear();
+  audio_send_configs_.clear();
+  video_recv_configs_.clear();
+  video_send_configs_.clear();
+
+  memset(last_incoming_rtcp_packet_, 0, IP_PACKET_SIZE);
+  last_incoming_rtcp_packet_length_ = 0;
+
+  first_timestamp_ = std::numeric_limits<int64_t>::max();
+  last_timestamp_ = std::numeric_limits<int64_t>::min();
+
+  incoming_rtp_extensions_maps_.clear();
+  outgoing_rtp_extensions_maps_.clear();
+}
+
+void ParsedRtcEventLog::ClearBatch() {
   incoming_rtp_packets_map_.clear();
   outgoing_rtp_packets_map_.clear();
   incoming_rtp_packets_by_ssrc_.clear();
@@ -996,9 +1095,13 @@ void ParsedRtcEventLog::Clear() {
   outgoing_transport_feedback_.clear();
   incoming_loss_notification_.clear();
   outgoing_loss_notification_.clear();
+  incoming_xr_.clear();
+  outgoing_xr_.clear();
+  incoming_fir_.clear();
+  outgoing_fir_.clear();
+  incoming_pli_.clear();
+  outgoing_pli_.clear();
 
-  start_log_events_.clear();
-  stop_log_events_.clear();
   audio_playout_events_.clear();
   audio_network_adaptation_events_.clear();
   bwe_probe_cluster_created_events_.clear();
@@ -1009,45 +1112,69 @@ void ParsedRtcEventLog::Clear() {
   dtls_transport_states_.clear();
   dtls_writable_states_.clear();
   alr_state_events_.clear();
-  ice_candidate_pair_configs_.clear();
   ice_candidate_pair_events_.clear();
-  audio_recv_configs_.clear();
-  audio_send_configs_.clear();
-  video_recv_configs_.clear();
-  video_send_configs_.clear();
-
-  memset(last_incoming_rtcp_packet_, 0, IP_PACKET_SIZE);
-  last_incoming_rtcp_packet_length_ = 0;
 
-  first_timestamp_ = std::numeric_limits<int64_t>::max();
-  last_timestamp_ = std::numeric_limits<int64_t>::min();
+  generic_packets_received_.clear();
+  generic_packets_sent_.clear();
+  generic_acks_received_.clear();
 
-  incoming_rtp_extensions_maps_.clear();
-  outgoing_rtp_extensions_maps_.clear();
+  route_change_events_.clear();
+  remote_estimate_events_.clear();
 }
 
 bool ParsedRtcEventLog::ParseFile(const std::string& filename) {
-  std::ifstream file(  // no-presubmit-check TODO(webrtc:8982)
-      filename, std::ios_base::in | std::ios_base::binary);
-  if (!file.good() || !file.is_open()) {
+  FileContents file;
+  if (!file.Open(filename)) {
     RTC_LOG(LS_WARNING) << "Could not open file for reading.";
     return false;
   }
 
-  return ParseStream(file);
+  Clear();
+  bool success = ParseStreamInternal(file.data(), 0, nullptr);
+  FinishBatch();
+  return success;
+}
+
+bool ParsedRtcEventLog::ParseFileInBatches(const std::string& file_name,
+                                           size_t batch_size_bytes,
+                                           rtc::FunctionView<void()> on_batch) {
+  FileContents file;
+  if (!file.Open(file_name)) {
+    RTC_LOG(LS_WARNING) << "Could not open file for reading.";
+    return false;
+  }
+
+  return ParseStringInBatches(file.data(), batch_size_bytes, on_batch);
 }
 
 bool ParsedRtcEventLog::ParseString(const std::string& s) {
-  std::istringstream stream(  // no-presubmit-check TODO(webrtc:8982)
-      s, std::ios_base::in | std::ios_base::binary);
-  return ParseStream(stream);
+  Clear();
+  bool success = ParseStreamInternal(s, 0, nullptr);
+  FinishBatch();
+  return success;
+}
+
+bool ParsedRtcEventLog::ParseStringInBatches(
+    absl::string_view s,
+    size_t batch_size_bytes,
+    rtc::FunctionView<void()> on_batch) {
+  RTC_DCHECK(on_batch);
+  Clear();
+  bool success = ParseStreamInternal(s, batch_size_bytes, on_batch);
+  FinishBatch();
+  on_batch();
+  ClearBatch();
+  return success;
 }
 
 bool ParsedRtcEventLog::ParseStream(
     std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
-  Clear();
-  bool success = ParseStreamInternal(stream);
+  const std::string s((std::istreambuf_iterator<char>(stream)),
+                      std::istreambuf_iterator<char>());
+  return ParseString(s);
+}
 
+void ParsedRtcEventLog::FinishBatch() {
   // Cache the configured SSRCs.
   for (const auto& video_recv_config : video_recv_configs()) {
     incoming_video_ssrcs_.insert(video_recv_config.config.remote_ssrc);
@@ -1126,8 +1253,6 @@ bool ParsedRtcEventLog::ParseStream(
   // stream configurations and starting/stopping the log.
   // TODO(terelius): Figure out if we actually need to find the first and last
   // timestamp in the parser. It seems like this could be done by the caller.
-  first_timestamp_ = std::numeric_limits<int64_t>::max();
-  last_timestamp_ = std::numeric_limits<int64_t>::min();
   StoreFirstAndLastTimestamp(alr_state_events());
   StoreFirstAndLastTimestamp(route_change_events());
   for (const auto& audio_stream : audio_playout_events()) {
@@ -1155,33 +1280,36 @@ bool ParsedRtcEventLog::ParseStream(
   StoreFirstAndLastTimestamp(generic_packets_sent_);
   StoreFirstAndLastTimestamp(generic_packets_received_);
   StoreFirstAndLastTimestamp(generic_acks_received_);
-
-  return success;
 }
 
 bool ParsedRtcEventLog::ParseStreamInternal(
-    std::istream& stream) {  // no-presubmit-check TODO(webrtc:8982)
+    absl::string_view s,
+    size_t batch_size_bytes,
+    rtc::FunctionView<void()> on_batch) {
   constexpr uint64_t kMaxEventSize = 10000000;  // Sanity check.
-  std::vector<char> buffer(0xFFFF);
-
-  RTC_DCHECK(stream.good());
-
-  while (1) {
-    // Check whether we have reached end of file.
-    stream.peek();
-    if (stream.eof()) {
-      break;
-    }
+  // New format messages decoded in parallel are held until this many bytes of
+  // them have been read, or until a legacy message or the end of a batch.
+  constexpr size_t kMaxPendingBytes = 4 * 1024 * 1024;
+  size_t batch_bytes = 0;
+  uint64_t last_field_number = 0;
+  std::vector<absl::string_view> pending_messages;
+  size_t pending_bytes = 0;
+  auto parse_pending_messages = [&]() {
+    const bool success = ParseNewFormatMessages(pending_messages);
+    pending_messages.clear();
+    pending_bytes = 0;
+    return success;
+  };
 
+  while (!s.empty()) {
     // Read the next message tag. Protobuf defines the message tag as
     // (field_number << 3) | wire_type. In the legacy encoding, the field number
     // is supposed to be 1 and the wire type for a length-delimited field is 2.
     // In the new encoding we still expect the wire type to be 2, but the field
     // number will be greater than 1.
     constexpr uint64_t kExpectedV1Tag = (1 << 3) | 2;
-    size_t bytes_written = 0;
-    absl::optional<uint64_t> tag =
-        ParseVarInt(stream, buffer.data(), &bytes_written);
+    size_t bytes_read = 0;
+    absl::optional<uint64_t> tag = ParseVarInt(s, &bytes_read);
     if (!tag) {
       RTC_LOG(LS_WARNING)
           << "Missing field tag from beginning of protobuf event.";
@@ -1197,30 +1325,48 @@ bool ParsedRtcEventLog::ParseStreamInternal(
     }
 
     // Read the length field.
-    absl::optional<uint64_t> message_length =
-        ParseVarInt(stream, buffer.data(), &bytes_written);
+    absl::optional<uint64_t> message_length = ParseVarInt(s, &bytes_read);
     if (!message_length) {
       RTC_LOG(LS_WARNING) << "Missing message length after protobuf field tag.";
       return false;
     } else if (*message_length > kMaxEventSize) {
       RTC_LOG(LS_WARNING) << "Protobuf message length is too large.";
       return false;
-    }
-
-    // Read the next protobuf event to a temporary char buffer.
-    if (buffer.size() < bytes_written + *message_length)
-      buffer.resize(bytes_written + *message_length);
-    stream.read(buffer.data() + bytes_written, *message_length);
-    if (stream.gcount() != static_cast<int>(*message_length)) {
+    } else if (*message_length > s.size() - bytes_read) {
       RTC_LOG(LS_WARNING) << "Failed to read protobuf message from file.";
       return false;
     }
-    size_t buffer_size = bytes_written + *message_length;
+
+    // Each output of the new format encoder is a single EventStream, whose
+    // fields are written in field number order. Ending a batch inside one
+    // would leave the events of the fields after it out of timestamp order,
+    // so batches end only between legacy events or where the field number
+    // goes down.
+    const uint64_t field_number = *tag >> 3;
+    if (on_batch && batch_bytes >= batch_size_bytes &&
+        (*tag == kExpectedV1Tag || field_number < last_field_number)) {
+      if (!parse_pending_messages())
+        return false;
+      FinishBatch();
+      on_batch();
+      ClearBatch();
+      batch_bytes = 0;
+    }
+    last_field_number = field_number;
+
+    // The message is parsed together with its tag and length, as an
+    // EventStream holding a single field.
+    const size_t buffer_size = bytes_read + *message_length;
+    const char* buffer = s.data();
+    s.remove_prefix(buffer_size);
+    batch_bytes += buffer_size;
 
     if (*tag == kExpectedV1Tag) {
+      if (!parse_pending_messages())
+        return false;
       // Parse the protobuf event from the buffer.
       rtclog::EventStream event_stream;
-      if (!event_stream.ParseFromArray(buffer.data(), buffer_size)) {
+      if (!event_stream.ParseFromArray(buffer, buffer_size)) {
         RTC_LOG(LS_WARNING)
             << "Failed to parse legacy-format protobuf message.";
         return false;
@@ -1228,16 +1374,97 @@ bool ParsedRtcEventLog::ParseStreamInternal(
 
       RTC_CHECK_EQ(event_stream.stream_size(), 1);
       StoreParsedLegacyEvent(event_stream.stream(0));
+    } else if (num_decoding_threads_ > 1) {
+      pending_messages.emplace_back(buffer, buffer_size);
+      pending_bytes += buffer_size;
+      if (pending_bytes >= kMaxPendingBytes && !parse_pending_messages())
+        return false;
     } else {
       // Parse the protobuf event from the buffer.
       rtclog2::EventStream event_stream;
-      if (!event_stream.ParseFromArray(buffer.data(), buffer_size)) {
+      if (!event_stream.ParseFromArray(buffer, buffer_size)) {
         RTC_LOG(LS_WARNING) << "Failed to parse new-format protobuf message.";
         return false;
       }
       StoreParsedNewFormatEvent(event_stream);
     }
   }
+  return parse_pending_messages();
+}
+
+bool ParsedRtcEventLog::ParseNewFormatMessages(
+    const std::vector<absl::string_view>& messages) {
+  if (messages.empty())
+    return true;
+
+  struct DecodedMessage {
+    bool parsed = false;
+    rtclog2::EventStream event_stream;
+    std::map<uint32_t, std::vector<LoggedRtpPacketIncoming>>
+        incoming_rtp_packets;
+    std::map<uint32_t, std::vector<LoggedRtpPacketOutgoing>>
+        outgoing_rtp_packets;
+  };
+  struct Decoder {
+    const std::vector<absl::string_view>* messages;
+    std::vector<DecodedMessage>* decoded;
+    std::atomic<size_t> next_index{0};
+
+    static void Run(void* obj) {
+      Decoder* decoder = static_cast<Decoder*>(obj);
+      const std::vector<absl::string_view>& messages = *decoder->messages;
+      for (size_t i = decoder->next_index.fetch_add(1); i < messages.size();
+           i = decoder->next_index.fetch_add(1)) {
+        DecodedMessage& decoded = (*decoder->decoded)[i];
+        decoded.parsed = decoded.event_stream.ParseFromArray(
+            messages[i].data(), messages[i].size());
+        if (!decoded.parsed)
+          continue;
+        // The packets are decoded here and the rest of the events later, in
+        // order, as they update state shared with the other messages.
+        const rtclog2::EventStream& stream = decoded.event_stream;
+        if (stream.incoming_rtp_packets_size() == 1) {
+          StoreRtpPackets(stream.incoming_rtp_packets(0),
+                          &decoded.incoming_rtp_packets);
+        } else if (stream.outgoing_rtp_packets_size() == 1) {
+          StoreRtpPackets(stream.outgoing_rtp_packets(0),
+                          &decoded.outgoing_rtp_packets);
+        }
+      }
+    }
+  };
+
+  std::vector<DecodedMessage> decoded(messages.size());
+  Decoder decoder;
+  decoder.messages = &messages;
+  decoder.decoded = &decoded;
+  const size_t num_threads = std::min(num_decoding_threads_, messages.size());
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &Decoder::Run, &decoder, "EventLogDecoder"));
+    threads.back()->Start();
+  }
+  Decoder::Run(&decoder);
+  for (auto& thread : threads)
+    thread->Stop();
+
+  for (DecodedMessage& message : decoded) {
+    if (!message.parsed) {
+      RTC_LOG(LS_WARNING) << "Failed to parse new-format protobuf message.";
+      return false;
+    }
+    const rtclog2::EventStream& stream = message.event_stream;
+    if (stream.incoming_rtp_packets_size() == 1) {
+      AppendRtpPackets(&message.incoming_rtp_packets,
+                       &incoming_rtp_packets_map_);
+    } else if (stream.outgoing_rtp_packets_size() == 1) {
+      AppendRtpPackets(&message.outgoing_rtp_packets,
+                       &outgoing_rtp_packets_map_);
+    } else {
+      StoreParsedNewFormatEvent(stream);
+    }
+  }
   return true;
 }
 
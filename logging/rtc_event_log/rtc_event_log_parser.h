@@ -18,6 +18,8 @@
 #include <utility>  // pair
 #include <vector>
 
+#include "absl/strings/string_view.h"
+#include "api/function_view.h"
 #include "api/rtc_event_log/rtc_event_log.h"
 #include "call/video_receive_stream.h"
 #include "call/video_send_stream.h"
@@ -290,9 +292,13 @@ class ParsedRtcEventLog {
 
   static webrtc::RtpHeaderExtensionMap GetDefaultHeaderExtensionMap();
 
+  // With |num_decoding_threads| greater than one, the RTP packet messages of
+  // new format logs, which make up the bulk of them, are decoded on that many
+  // threads in parallel. Everything else is parsed on the calling thread.
   explicit ParsedRtcEventLog(
       UnconfiguredHeaderExtensions parse_unconfigured_header_extensions =
-          UnconfiguredHeaderExtensions::kDontParse);
+          UnconfiguredHeaderExtensions::kDontParse,
+      size_t num_decoding_threads = 1);
 
   ~ParsedRtcEventLog();
 
@@ -301,8 +307,30 @@ class ParsedRtcEventLog {
   void Clear();
 
   // Reads an RtcEventLog file and returns true if parsing was successful.
+  // The file is memory-mapped where supported rather than read into memory.
   bool ParseFile(const std::string& file_name);
 
+  // Reads an RtcEventLog file a batch of events at a time, for logs too large
+  // to hold in memory once parsed. Each batch covers at least
+  // |batch_size_bytes| of the file, except for the last one. After parsing a
+  // batch, |on_batch| is called and the accessors return the events of that
+  // batch, as they would after ParseFile(). The events of the batch are then
+  // cleared. Stream configurations, ICE candidate pair configurations, log
+  // start and stop events, the configured SSRCs and first_timestamp() and
+  // last_timestamp() are kept and cover everything parsed so far.
+  //
+  // Batches only end between two outputs of the event log, so all events of
+  // a batch are newer than those of the previous one. Processing each batch
+  // with an RtcEventProcessor processes the whole log in timestamp order.
+  // Returns true if parsing was successful.
+  bool ParseFileInBatches(const std::string& file_name,
+                          size_t batch_size_bytes,
+                          rtc::FunctionView<void()> on_batch);
+  // As above, for a log held in memory.
+  bool ParseStringInBatches(absl::string_view s,
+                            size_t batch_size_bytes,
+                            rtc::FunctionView<void()> on_batch);
+
   // Reads an RtcEventLog from a string and returns true if successful.
   bool ParseString(const std::string& s);
 
@@ -567,8 +595,23 @@ class ParsedRtcEventLog {
   std::vector<InferredRouteChangeEvent> GetRouteChanges() const;
 
  private:
-  bool ParseStreamInternal(
-      std::istream& stream);  // no-presubmit-check TODO(webrtc:8982)
+  // Parses the protobuf messages in |s|. When |on_batch| is set, ends a batch
+  // after each |batch_size_bytes|, at the next point allowed, by calling
+  // FinishBatch(), |on_batch| and ClearBatch().
+  bool ParseStreamInternal(absl::string_view s,
+                           size_t batch_size_bytes,
+                           rtc::FunctionView<void()> on_batch);
+
+  // Parses and stores the new format messages in |messages|, in order,
+  // decoding the RTP packet messages on |num_decoding_threads_| threads.
+  bool ParseNewFormatMessages(const std::vector<absl::string_view>& messages);
+
+  // Derives the per SSRC streams, RTCP blocks and timestamps from the events
+  // parsed since the last ClearBatch().
+  void FinishBatch();
+  // Clears the events that ParseStringInBatches() doesn't keep across
+  // batches.
+  void ClearBatch();
 
   void StoreParsedLegacyEvent(const rtclog::Event& event);
 
@@ -683,6 +726,7 @@ class ParsedRtcEventLog {
   };
 
   const UnconfiguredHeaderExtensions parse_unconfigured_header_extensions_;
+  const size_t num_decoding_threads_;
 
   // Make a default extension map for streams without configuration information.
   // TODO(ivoc): Once configuration of audio streams is stored in the event log,
@@ -110,6 +110,12 @@ bool AdaptedVideoTrackSource::AdaptFrame(int width,
     return false;
   }
 
+  // Sinks may know that they would drop the frame anyway, e.g. an encoder
+  // that is over its target bitrate, in which case it is not worth converting
+  // or scaling it.
+  if (!broadcaster_.WantsFrame(time_us))
+    return false;
+
   *crop_x = (width - *crop_width) / 2;
   *crop_y = (height - *crop_height) / 2;
   return true;
@@ -48,7 +48,9 @@ class RTC_EXPORT AdaptedVideoTrackSource
 
   // Reports the appropriate frame size after adaptation. Returns true
   // if a frame is wanted. Returns false if there are no interested
-  // sinks, or if the VideoAdapter decides to drop the frame.
+  // sinks, if the VideoAdapter decides to drop the frame, or if all sinks
+  // would drop it anyway. Call it before converting or scaling the frame, and
+  // pass the frame to OnFrame() only if it returns true.
   bool AdaptFrame(int width,
                   int height,
                   int64_t time_us,
@@ -38,6 +38,7 @@
 #include "media/base/media_constants.h"
 #include "media/base/stream_params.h"
 #include "modules/audio_processing/include/audio_processing_statistics.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/include/report_block_data.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/buffer.h"
@@ -202,6 +203,13 @@ class MediaChannel : public sigslot::has_slots<> {
   // Called when a RTP packet is received.
   virtual void OnPacketReceived(rtc::CopyOnWriteBuffer packet,
                                 int64_t packet_time_us) = 0;
+  // Called when a RTP packet that the RTP transport has already parsed is
+  // received. The default implementation passes the serialized packet on to
+  // OnPacketReceived().
+  virtual void OnRtpPacketReceived(webrtc::RtpPacketReceived packet,
+                                   int64_t packet_time_us) {
+    OnPacketReceived(packet.Buffer(), packet_time_us);
+  }
   // Called when the socket's ability to send has changed.
   virtual void OnReadyToSend(bool ready) = 0;
   // Called when the network route used for sending packets changed.
@@ -409,6 +417,10 @@ struct MediaSenderInfo {
   // this list, the ReportBlockData::RTCPReportBlock::source_ssrc(), which is
   // the SSRC of the corresponding outbound RTP stream, is unique.
   std::vector<webrtc::ReportBlockData> report_block_datas;
+  // Approximate memory held by the packets stored for retransmission, and the
+  // configured cap on the number of stored packets.
+  size_t rtp_packet_history_bytes = 0;
+  size_t rtp_packet_history_max_packets = 0;
 };
 
 struct MediaReceiverInfo {
@@ -536,6 +548,10 @@ struct VoiceReceiverInfo : public MediaReceiverInfo {
   // longer than 150 ms).
   int32_t interruption_count = 0;
   int32_t total_interruption_duration_ms = 0;
+  // Approximate memory held by the jitter buffer packets, and the configured
+  // cap on the number of buffered packets.
+  uint64_t jitter_buffer_bytes = 0;
+  size_t jitter_buffer_max_packets = 0;
 };
 
 struct VideoSenderInfo : public MediaSenderInfo {
@@ -229,6 +229,62 @@ bool GetRtpHeaderLen(const void* data, size_t len, size_t* value) {
   return true;
 }
 
+bool GetRtpAudioLevel(const void* data,
+                      size_t len,
+                      int extension_id,
+                      uint8_t* level,
+                      bool* voice_activity) {
+  size_t header_len;
+  if (!GetRtpHeaderLen(data, len, &header_len))
+    return false;
+  const uint8_t* rtp = static_cast<const uint8_t*>(data);
+  if (!(rtp[0] & 0x10))
+    return false;
+  const uint8_t* extension_end = rtp + header_len;
+  const uint8_t* extension = rtp + kMinRtpPacketLen + 4 * (rtp[0] & 0x0F);
+  const uint16_t profile_id = rtc::GetBE16(extension);
+  extension += kRtpExtensionHeaderLen;
+  // One-byte headers have the profile 0xBEDE, two-byte headers 0x100X.
+  const bool one_byte_header = profile_id == 0xBEDE;
+  if (!one_byte_header && (profile_id & 0xFFF0) != 0x1000)
+    return false;
+  const size_t element_header_len = one_byte_header ? 1 : 2;
+  while (extension + element_header_len <= extension_end) {
+    int id;
+    size_t length;
+    if (one_byte_header) {
+      id = *extension >> 4;
+      length = (*extension & 0x0F) + 1;
+      if (id == 0) {
+        // Padding.
+        ++extension;
+        continue;
+      }
+      if (id == 15)
+        return false;
+    } else {
+      id = extension[0];
+      length = extension[1];
+      if (id == 0) {
+        ++extension;
+        continue;
+      }
+    }
+    extension += element_header_len;
+    if (extension + length > extension_end)
+      return false;
+    if (id == extension_id) {
+      if (length < 1)
+        return false;
+      *voice_activity = (extension[0] & 0x80) != 0;
+      *level = extension[0] & 0x7F;
+      return true;
+    }
+    extension += length;
+  }
+  return false;
+}
+
 bool GetRtpHeader(const void* data, size_t len, RtpHeader* header) {
   return (GetRtpPayloadType(data, len, &(header->payload_type)) &&
           GetRtpSeqNum(data, len, &(header->seq_num)) &&
@@ -81,6 +81,15 @@ bool RTC_EXPORT ValidateRtpHeader(const uint8_t* rtp,
                                   size_t length,
                                   size_t* header_length);
 
+// Reads the audio level extension (RFC 6464) with |extension_id| by offset,
+// without parsing the rest of the packet. Returns false if the packet is
+// malformed or doesn't carry the extension. |level| is in -dBov.
+bool GetRtpAudioLevel(const void* data,
+                      size_t len,
+                      int extension_id,
+                      uint8_t* level,
+                      bool* voice_activity);
+
 // Helper method which updates the absolute send time extension if present.
 bool UpdateRtpAbsSendTimeExtension(uint8_t* rtp,
                                    size_t length,
@@ -330,6 +330,35 @@ TEST(RtpUtilsTest, UpdateAbsSendTimeExtensionInRtpPacket) {
                       sizeof(kExpectedTimestamp)));
 }
 
+TEST(RtpUtilsTest, GetAudioLevelFromOneAndTwoByteExtensions) {
+  // Padding, an unrelated extension, then audio level 0x55 with the voice
+  // activity flag.
+  const uint8_t kOneByte[] = {0x90, 0x6f, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+                              0x12, 0x34, 0x56, 0x78, 0xbe, 0xde, 0x00, 0x02,
+                              0x00, 0x21, 0xaa, 0xbb, 0x30, 0xd5, 0x00, 0x00};
+  const uint8_t kTwoByte[] = {0x90, 0x6f, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00,
+                              0x12, 0x34, 0x56, 0x78, 0x10, 0x00, 0x00, 0x02,
+                              0x02, 0x01, 0xaa, 0x03, 0x01, 0x15, 0x00, 0x00};
+  uint8_t level = 0;
+  bool voice_activity = false;
+  EXPECT_TRUE(GetRtpAudioLevel(kOneByte, sizeof(kOneByte), 3, &level,
+                               &voice_activity));
+  EXPECT_EQ(0x55, level);
+  EXPECT_TRUE(voice_activity);
+  EXPECT_FALSE(GetRtpAudioLevel(kOneByte, sizeof(kOneByte), 4, &level,
+                                &voice_activity));
+  EXPECT_TRUE(GetRtpAudioLevel(kTwoByte, sizeof(kTwoByte), 3, &level,
+                               &voice_activity));
+  EXPECT_EQ(0x15, level);
+  EXPECT_FALSE(voice_activity);
+  // Truncated extension.
+  EXPECT_FALSE(GetRtpAudioLevel(kOneByte, sizeof(kOneByte) - 4, 3, &level,
+                                &voice_activity));
+  EXPECT_FALSE(GetRtpAudioLevel(kRtpPacketWithMarker,
+                                sizeof(kRtpPacketWithMarker), 3, &level,
+                                &voice_activity));
+}
+
 // Verify we update both AbsSendTime extension header and HMAC.
 TEST(RtpUtilsTest, ApplyPacketOptionsWithAuthParamsAndAbsSendTime) {
   rtc::PacketTimeUpdateParams packet_time_params;
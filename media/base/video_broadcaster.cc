@@ -10,10 +10,14 @@
 
 #include "media/base/video_broadcaster.h"
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/types/optional.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_rotation.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -41,6 +45,9 @@ void VideoBroadcaster::RemoveSink(
   RTC_DCHECK(sink != nullptr);
   rtc::CritScope cs(&sinks_and_wants_lock_);
   VideoSourceBase::RemoveSink(sink);
+  sinks_skipping_frame_.erase(std::remove(sinks_skipping_frame_.begin(),
+                                          sinks_skipping_frame_.end(), sink),
+                              sinks_skipping_frame_.end());
   UpdateWants();
 }
 
@@ -57,7 +64,16 @@ VideoSinkWants VideoBroadcaster::wants() const {
 void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
   rtc::CritScope cs(&sinks_and_wants_lock_);
   bool current_frame_was_discarded = false;
+  // Scaled versions of |frame|, shared by the sinks that want the same size.
+  std::vector<webrtc::VideoFrame> scaled_frames;
+  const bool can_scale = frame.video_frame_buffer()->type() !=
+                         webrtc::VideoFrameBuffer::Type::kNative;
   for (auto& sink_pair : sink_pairs()) {
+    if (absl::c_linear_search(sinks_skipping_frame_, sink_pair.sink)) {
+      // The sink has already dropped the frame in WantsFrame().
+      current_frame_was_discarded = true;
+      continue;
+    }
     if (sink_pair.wants.rotation_applied &&
         frame.rotation() != webrtc::kVideoRotation_0) {
       // Calls to OnFrame are not synchronized with changes to the sink wants.
@@ -79,6 +95,10 @@ void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
               .set_id(frame.id())
               .build();
       sink_pair.sink->OnFrame(black_frame);
+    } else if (can_scale && frame.width() * frame.height() >
+                                sink_pair.wants.max_pixel_count) {
+      sink_pair.sink->OnFrame(GetScaledFrame(
+          frame, sink_pair.wants.max_pixel_count, &scaled_frames));
     } else if (!previous_frame_sent_to_all_sinks_) {
       // Since last frame was not sent to some sinks, full update is needed.
       webrtc::VideoFrame copy = frame;
@@ -90,6 +110,7 @@ void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
     }
   }
   previous_frame_sent_to_all_sinks_ = !current_frame_was_discarded;
+  sinks_skipping_frame_.clear();
 }
 
 void VideoBroadcaster::OnDiscardedFrame() {
@@ -98,6 +119,20 @@ void VideoBroadcaster::OnDiscardedFrame() {
   }
 }
 
+bool VideoBroadcaster::WantsFrame(int64_t time_us) {
+  rtc::CritScope cs(&sinks_and_wants_lock_);
+  sinks_skipping_frame_.clear();
+  for (auto& sink_pair : sink_pairs()) {
+    if (!sink_pair.sink->WantsFrame(time_us))
+      sinks_skipping_frame_.push_back(sink_pair.sink);
+  }
+  if (sinks_skipping_frame_.size() < sink_pairs().size())
+    return true;
+  // No OnFrame() follows.
+  sinks_skipping_frame_.clear();
+  return false;
+}
+
 void VideoBroadcaster::UpdateWants() {
   VideoSinkWants wants;
   wants.rotation_applied = false;
@@ -132,6 +167,48 @@ void VideoBroadcaster::UpdateWants() {
   current_wants_ = wants;
 }
 
+const webrtc::VideoFrame& VideoBroadcaster::GetScaledFrame(
+    const webrtc::VideoFrame& frame,
+    int max_pixel_count,
+    std::vector<webrtc::VideoFrame>* scaled_frames) {
+  // Keep the aspect ratio, and round down to even dimensions.
+  const double scale =
+      std::sqrt(static_cast<double>(max_pixel_count) /
+                (static_cast<double>(frame.width()) * frame.height()));
+  const int width = std::max(2, static_cast<int>(frame.width() * scale) & ~1);
+  const int height =
+      std::max(2, static_cast<int>(frame.height() * scale) & ~1);
+  for (const webrtc::VideoFrame& scaled_frame : *scaled_frames) {
+    if (scaled_frame.width() == width && scaled_frame.height() == height)
+      return scaled_frame;
+  }
+
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer;
+  if (frame.video_frame_buffer()->type() ==
+      webrtc::VideoFrameBuffer::Type::kNV12) {
+    // Keep NV12 frames in NV12, rather than converting them.
+    rtc::scoped_refptr<webrtc::NV12Buffer> nv12_buffer =
+        webrtc::NV12Buffer::Create(width, height);
+    nv12_buffer->ScaleFrom(*frame.video_frame_buffer()->GetNV12());
+    buffer = nv12_buffer;
+  } else {
+    rtc::scoped_refptr<webrtc::I420Buffer> i420_buffer =
+        webrtc::I420Buffer::Create(width, height);
+    i420_buffer->ScaleFrom(*frame.video_frame_buffer()->ToI420());
+    buffer = i420_buffer;
+  }
+  scaled_frames->push_back(
+      webrtc::VideoFrame::Builder()
+          .set_video_frame_buffer(buffer)
+          .set_rotation(frame.rotation())
+          .set_timestamp_us(frame.timestamp_us())
+          .set_timestamp_rtp(frame.timestamp())
+          .set_ntp_time_ms(frame.ntp_time_ms())
+          .set_id(frame.id())
+          .build());
+  return scaled_frames->back();
+}
+
 const rtc::scoped_refptr<webrtc::VideoFrameBuffer>&
 VideoBroadcaster::GetBlackFrameBuffer(int width, int height) {
   if (!black_frame_buffer_ || black_frame_buffer_->width() != width ||
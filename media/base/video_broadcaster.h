@@ -11,7 +11,10 @@
 #ifndef MEDIA_BASE_VIDEO_BROADCASTER_H_
 #define MEDIA_BASE_VIDEO_BROADCASTER_H_
 
+#include <vector>
+
 #include "api/scoped_refptr.h"
+#include "api/video/video_frame.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_source_interface.h"
 #include "media/base/video_source_base.h"
@@ -46,15 +49,29 @@ class VideoBroadcaster : public VideoSourceBase,
   // it will never receive a frame with pending rotation. Our caller
   // may pass in frames without precise synchronization with changes
   // to the VideoSinkWants.
+  // Frames larger than a sink's max_pixel_count are scaled down for it, e.g.
+  // when the source doesn't adapt to the aggregated wants. Each distinct size
+  // is scaled once per frame, and the scaled buffer is shared by all sinks
+  // asking for that size.
   void OnFrame(const webrtc::VideoFrame& frame) override;
 
   void OnDiscardedFrame() override;
 
+  // Asks each sink, and returns false if no sink wants the frame. Otherwise,
+  // the next OnFrame() skips the sinks that did not want it.
+  bool WantsFrame(int64_t time_us) override;
+
  protected:
   void UpdateWants() RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
   const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& GetBlackFrameBuffer(
       int width,
       int height) RTC_EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
+  // Returns |frame| scaled down to at most |max_pixel_count| pixels. Reuses a
+  // frame in |scaled_frames| of the same size, or adds it there.
+  static const webrtc::VideoFrame& GetScaledFrame(
+      const webrtc::VideoFrame& frame,
+      int max_pixel_count,
+      std::vector<webrtc::VideoFrame>* scaled_frames);
 
   rtc::CriticalSection sinks_and_wants_lock_;
 
@@ -62,6 +79,9 @@ class VideoBroadcaster : public VideoSourceBase,
   rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_;
   bool previous_frame_sent_to_all_sinks_ RTC_GUARDED_BY(sinks_and_wants_lock_) =
       true;
+  // Sinks that returned false from WantsFrame() for the upcoming frame.
+  std::vector<VideoSinkInterface<webrtc::VideoFrame>*> sinks_skipping_frame_
+      RTC_GUARDED_BY(sinks_and_wants_lock_);
 };
 
 }  // namespace rtc
@@ -71,6 +71,57 @@ TEST(VideoBroadcasterTest, OnFrame) {
   EXPECT_EQ(3, sink2.num_rendered_frames());
 }
 
+namespace {
+
+// Sink that does not want frames while |wants_frames_| is false.
+class SelectiveVideoRenderer : public FakeVideoRenderer {
+ public:
+  bool WantsFrame(int64_t time_us) override { return wants_frames_; }
+  void set_wants_frames(bool wants_frames) { wants_frames_ = wants_frames; }
+
+ private:
+  bool wants_frames_ = true;
+};
+
+}  // namespace
+
+TEST(VideoBroadcasterTest, SkipsSinksThatDoNotWantFrame) {
+  VideoBroadcaster broadcaster;
+  SelectiveVideoRenderer sink1;
+  SelectiveVideoRenderer sink2;
+  broadcaster.AddOrUpdateSink(&sink1, rtc::VideoSinkWants());
+  broadcaster.AddOrUpdateSink(&sink2, rtc::VideoSinkWants());
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 50));
+  webrtc::I420Buffer::SetBlack(buffer);
+  webrtc::VideoFrame frame = webrtc::VideoFrame::Builder()
+                                 .set_video_frame_buffer(buffer)
+                                 .set_rotation(webrtc::kVideoRotation_0)
+                                 .set_timestamp_us(0)
+                                 .build();
+
+  sink1.set_wants_frames(false);
+  EXPECT_TRUE(broadcaster.WantsFrame(0));
+  broadcaster.OnFrame(frame);
+  EXPECT_EQ(0, sink1.num_rendered_frames());
+  EXPECT_EQ(1, sink2.num_rendered_frames());
+
+  // Skipping only applies to the frame that was asked about.
+  broadcaster.OnFrame(frame);
+  EXPECT_EQ(1, sink1.num_rendered_frames());
+  EXPECT_EQ(2, sink2.num_rendered_frames());
+
+  sink2.set_wants_frames(false);
+  EXPECT_FALSE(broadcaster.WantsFrame(0));
+
+  sink1.set_wants_frames(true);
+  EXPECT_TRUE(broadcaster.WantsFrame(0));
+  broadcaster.OnFrame(frame);
+  EXPECT_EQ(2, sink1.num_rendered_frames());
+  EXPECT_EQ(2, sink2.num_rendered_frames());
+}
+
 TEST(VideoBroadcasterTest, AppliesRotationIfAnySinkWantsRotationApplied) {
   VideoBroadcaster broadcaster;
   EXPECT_FALSE(broadcaster.wants().rotation_applied);
@@ -205,3 +256,45 @@ TEST(VideoBroadcasterTest, SinkWantsBlackFrames) {
   EXPECT_TRUE(sink2.black_frame());
   EXPECT_EQ(30, sink2.timestamp_us());
 }
+
+TEST(VideoBroadcasterTest, ScalesOncePerRequestedResolution) {
+  class BufferSink : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+   public:
+    void OnFrame(const webrtc::VideoFrame& frame) override {
+      buffer = frame.video_frame_buffer();
+    }
+    rtc::scoped_refptr<webrtc::VideoFrameBuffer> buffer;
+  };
+
+  VideoBroadcaster broadcaster;
+  BufferSink full_sink;
+  broadcaster.AddOrUpdateSink(&full_sink, VideoSinkWants());
+  BufferSink small_sink1;
+  BufferSink small_sink2;
+  VideoSinkWants small_wants;
+  small_wants.max_pixel_count = 320 * 180;
+  broadcaster.AddOrUpdateSink(&small_sink1, small_wants);
+  broadcaster.AddOrUpdateSink(&small_sink2, small_wants);
+  BufferSink medium_sink;
+  VideoSinkWants medium_wants;
+  medium_wants.max_pixel_count = 640 * 360;
+  broadcaster.AddOrUpdateSink(&medium_sink, medium_wants);
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(1280, 720));
+  webrtc::I420Buffer::SetBlack(buffer.get());
+  broadcaster.OnFrame(webrtc::VideoFrame::Builder()
+                          .set_video_frame_buffer(buffer)
+                          .set_rotation(webrtc::kVideoRotation_0)
+                          .set_timestamp_us(10)
+                          .build());
+
+  EXPECT_EQ(buffer, full_sink.buffer);
+  ASSERT_TRUE(small_sink1.buffer);
+  EXPECT_EQ(320, small_sink1.buffer->width());
+  EXPECT_EQ(180, small_sink1.buffer->height());
+  EXPECT_EQ(small_sink1.buffer, small_sink2.buffer);
+  ASSERT_TRUE(medium_sink.buffer);
+  EXPECT_EQ(640, medium_sink.buffer->width());
+  EXPECT_EQ(360, medium_sink.buffer->height());
+}
@@ -19,20 +19,22 @@
 #include <utility>
 
 #include "api/scoped_refptr.h"
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
+#include "common_video/libyuv/include/webrtc_libyuv.h"
 #include "modules/video_coding/include/video_error_codes.h"
 #include "modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
 #include "system_wrappers/include/field_trial.h"
-#include "third_party/libyuv/include/libyuv/scale.h"
 
 namespace {
 
@@ -52,6 +54,14 @@ absl::optional<unsigned int> GetScreenshareBoostedQpValue() {
   return qp;
 }
 
+std::unique_ptr<webrtc::TaskQueueFactory> CreateParallelEncodingFactory() {
+  if (!webrtc::field_trial::IsEnabled(
+          "WebRTC-SimulcastEncoderAdapter-ParallelEncoding")) {
+    return nullptr;
+  }
+  return webrtc::CreateDefaultTaskQueueFactory();
+}
+
 uint32_t SumStreamMaxBitrate(int streams, const webrtc::VideoCodec& codec) {
   uint32_t bitrate_sum = 0;
   for (int i = 0; i < streams; ++i) {
@@ -130,7 +140,8 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(VideoEncoderFactory* factory,
       encoded_complete_callback_(nullptr),
       experimental_boosted_screenshare_qp_(GetScreenshareBoostedQpValue()),
       boost_base_layer_quality_(RateControlSettings::ParseFromFieldTrials()
-                                    .Vp8BoostBaseLayerQuality()) {
+                                    .Vp8BoostBaseLayerQuality()),
+      task_queue_factory_(CreateParallelEncodingFactory()) {
   RTC_DCHECK(factory_);
   encoder_info_.implementation_name = "SimulcastEncoderAdapter";
 
@@ -300,12 +311,16 @@ int SimulcastEncoderAdapter::InitEncode(
 
         encoder_info_.supports_native_handle =
             encoder_impl_info.supports_native_handle;
+        encoder_info_.supports_nv12_input =
+            encoder_impl_info.supports_nv12_input;
         encoder_info_.has_trusted_rate_controller =
             encoder_impl_info.has_trusted_rate_controller;
         encoder_info_.is_hardware_accelerated =
             encoder_impl_info.is_hardware_accelerated;
         encoder_info_.has_internal_source =
             encoder_impl_info.has_internal_source;
+        encoder_info_.max_frames_in_flight =
+            encoder_impl_info.max_frames_in_flight;
       } else {
         encoder_info_.implementation_name += ", ";
         encoder_info_.implementation_name +=
@@ -314,6 +329,8 @@ int SimulcastEncoderAdapter::InitEncode(
         // Native handle supported only if all encoders supports it.
         encoder_info_.supports_native_handle &=
             encoder_impl_info.supports_native_handle;
+        encoder_info_.supports_nv12_input &=
+            encoder_impl_info.supports_nv12_input;
 
         // Trusted rate controller only if all encoders have it.
         encoder_info_.has_trusted_rate_controller &=
@@ -329,6 +346,17 @@ int SimulcastEncoderAdapter::InitEncode(
         // Has internal source only if all encoders have it.
         encoder_info_.has_internal_source &=
             encoder_impl_info.has_internal_source;
+
+        // Frames in flight are limited only if all encoders limit them, to
+        // the lowest limit.
+        if (encoder_info_.max_frames_in_flight == 0 ||
+            encoder_impl_info.max_frames_in_flight == 0) {
+          encoder_info_.max_frames_in_flight = 0;
+        } else {
+          encoder_info_.max_frames_in_flight =
+              std::min(encoder_info_.max_frames_in_flight,
+                       encoder_impl_info.max_frames_in_flight);
+        }
       }
       encoder_info_.fps_allocation[i] = encoder_impl_info.fps_allocation[0];
     }
@@ -338,6 +366,19 @@ int SimulcastEncoderAdapter::InitEncode(
     encoder_info_.implementation_name += ")";
   }
 
+  // Encoders that deliver their images asynchronously can't be waited for.
+  if (task_queue_factory_ && doing_simulcast &&
+      settings.number_of_cores > 1 && !encoder_info_.has_internal_source &&
+      !encoder_info_.is_hardware_accelerated) {
+    for (int i = 0; i < number_of_streams; ++i) {
+      if (i == highest_resolution_stream_index)
+        continue;
+      streaminfos_[i].encode_queue = std::make_unique<rtc::TaskQueue>(
+          task_queue_factory_->CreateTaskQueue(
+              "SimulcastEncoder", TaskQueueFactory::Priority::NORMAL));
+    }
+  }
+
   // To save memory, don't store encoders that we don't use.
   DestroyStoredEncoders();
 
@@ -379,72 +420,156 @@ int SimulcastEncoderAdapter::Encode(
 
   int src_width = input_image.width();
   int src_height = input_image.height();
+  // If scaling isn't required, because the input resolution
+  // matches the destination or the input image is empty (e.g.
+  // a keyframe request for encoders with internal camera
+  // sources), pass the image on directly. Otherwise, we'll scale it to match
+  // what the encoder expects (below).
+  // Texture frames are passed on directly to encoders that support native
+  // handles, which are expected to be able to correctly sample/scale the
+  // source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  // All other layers are scaled in one go, each from the next larger layer, so
+  // that the full resolution input is only read once. In particular, a texture
+  // frame is converted to I420 once for all the encoders that can't take it
+  // as is, rather than once by each of them.
+  const bool is_native = input_image.video_frame_buffer()->type() ==
+                         VideoFrameBuffer::Type::kNative;
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> stream_buffers(
+      streaminfos_.size());
+  std::vector<bool> is_scaled(streaminfos_.size(), false);
+  std::vector<I420Buffer*> dst_buffers;
+  // Streams that take a texture frame at its own resolution, but in I420.
+  std::vector<size_t> converted_streams;
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
-    // Don't encode frames in resolutions that we don't intend to send.
-    if (!streaminfos_[stream_idx].send_stream) {
+    const StreamInfo& streaminfo = streaminfos_[stream_idx];
+    if (!streaminfo.send_stream ||
+        (is_native &&
+         streaminfo.encoder->GetEncoderInfo().supports_native_handle)) {
+      continue;
+    }
+    if (streaminfo.width == src_width && streaminfo.height == src_height) {
+      if (is_native)
+        converted_streams.push_back(stream_idx);
       continue;
     }
+    rtc::scoped_refptr<I420Buffer> scaled_buffer =
+        I420Buffer::Create(streaminfo.width, streaminfo.height);
+    dst_buffers.push_back(scaled_buffer.get());
+    stream_buffers[stream_idx] = scaled_buffer;
+    is_scaled[stream_idx] = true;
+  }
+  if (!converted_streams.empty() || !dst_buffers.empty()) {
+    rtc::scoped_refptr<I420BufferInterface> src_buffer =
+        input_image.video_frame_buffer()->ToI420();
+    if (!dst_buffers.empty())
+      ScaleI420Pyramid(*src_buffer, dst_buffers);
+    for (size_t stream_idx : converted_streams)
+      stream_buffers[stream_idx] = src_buffer;
+  }
 
-    std::vector<VideoFrameType> stream_frame_types;
+  std::vector<VideoFrameType> stream_frame_types(
+      1, send_key_frame ? VideoFrameType::kVideoFrameKey
+                        : VideoFrameType::kVideoFrameDelta);
+  std::vector<VideoFrame> stream_frames(streaminfos_.size(), input_image);
+  int sending_streams = 0;
+  bool any_encode_queue = false;
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    StreamInfo& streaminfo = streaminfos_[stream_idx];
+    if (!streaminfo.send_stream) {
+      continue;
+    }
+    ++sending_streams;
+    any_encode_queue |= streaminfo.encode_queue != nullptr;
     if (send_key_frame) {
-      stream_frame_types.push_back(VideoFrameType::kVideoFrameKey);
-      streaminfos_[stream_idx].key_frame_request = false;
-    } else {
-      stream_frame_types.push_back(VideoFrameType::kVideoFrameDelta);
+      streaminfo.key_frame_request = false;
     }
-
-    int dst_width = streaminfos_[stream_idx].width;
-    int dst_height = streaminfos_[stream_idx].height;
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((dst_width == src_width && dst_height == src_height) ||
-        input_image.video_frame_buffer()->type() ==
-            VideoFrameBuffer::Type::kNative) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(input_image,
-                                                         &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height);
-      rtc::scoped_refptr<I420BufferInterface> src_buffer =
-          input_image.video_frame_buffer()->ToI420();
-      libyuv::I420Scale(src_buffer->DataY(), src_buffer->StrideY(),
-                        src_buffer->DataU(), src_buffer->StrideU(),
-                        src_buffer->DataV(), src_buffer->StrideV(), src_width,
-                        src_height, dst_buffer->MutableDataY(),
-                        dst_buffer->StrideY(), dst_buffer->MutableDataU(),
-                        dst_buffer->StrideU(), dst_buffer->MutableDataV(),
-                        dst_buffer->StrideV(), dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-
+    if (!stream_buffers[stream_idx]) {
+      continue;
+    }
+    VideoFrame& frame = stream_frames[stream_idx];
+    frame.set_video_frame_buffer(stream_buffers[stream_idx]);
+    if (is_scaled[stream_idx]) {
       // UpdateRect is not propagated to lower simulcast layers currently.
       // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
-      VideoFrame frame(input_image);
-      frame.set_video_frame_buffer(dst_buffer);
       frame.set_rotation(webrtc::kVideoRotation_0);
       frame.set_update_rect(
           VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret =
-          streaminfos_[stream_idx].encoder->Encode(frame, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+    }
+  }
+
+  if (sending_streams > 1 && any_encode_queue) {
+    return EncodeInParallel(stream_frames, stream_frame_types);
+  }
+
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    // Don't encode frames in resolutions that we don't intend to send.
+    if (!streaminfos_[stream_idx].send_stream) {
+      continue;
+    }
+    int ret = streaminfos_[stream_idx].encoder->Encode(
+        stream_frames[stream_idx], &stream_frame_types);
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
     }
   }
 
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+int SimulcastEncoderAdapter::EncodeInParallel(
+    const std::vector<VideoFrame>& frames,
+    const std::vector<VideoFrameType>& frame_types) {
+  rtc::Event done[kMaxSimulcastStreams];
+  int results[kMaxSimulcastStreams];
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    StreamInfo& streaminfo = streaminfos_[stream_idx];
+    if (!streaminfo.send_stream) {
+      continue;
+    }
+    streaminfo.defer_encoded_images = true;
+    if (streaminfo.encode_queue) {
+      streaminfo.encode_queue->PostTask(
+          [&streaminfo, &frames, &frame_types, &results, &done, stream_idx] {
+            results[stream_idx] =
+                streaminfo.encoder->Encode(frames[stream_idx], &frame_types);
+            done[stream_idx].Set();
+          });
+    }
+  }
+  // Meanwhile, encode the highest resolution stream on this queue.
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    StreamInfo& streaminfo = streaminfos_[stream_idx];
+    if (streaminfo.send_stream && !streaminfo.encode_queue) {
+      results[stream_idx] =
+          streaminfo.encoder->Encode(frames[stream_idx], &frame_types);
+    }
+  }
+
+  int ret = WEBRTC_VIDEO_CODEC_OK;
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    StreamInfo& streaminfo = streaminfos_[stream_idx];
+    if (!streaminfo.send_stream) {
+      continue;
+    }
+    if (streaminfo.encode_queue) {
+      done[stream_idx].Wait(rtc::Event::kForever);
+    }
+    streaminfo.defer_encoded_images = false;
+    if (ret == WEBRTC_VIDEO_CODEC_OK) {
+      ret = results[stream_idx];
+    }
+    for (const PendingImage& pending : streaminfo.pending_images) {
+      encoded_complete_callback_->OnEncodedImage(
+          pending.image, &pending.codec_specific_info,
+          pending.fragmentation.get());
+    }
+    streaminfo.pending_images.clear();
+  }
+  return ret;
+}
+
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
@@ -538,6 +663,22 @@ EncodedImageCallback::Result SimulcastEncoderAdapter::OnEncodedImage(
 
   stream_image.SetSpatialIndex(stream_idx);
 
+  StreamInfo& streaminfo = streaminfos_[stream_idx];
+  if (streaminfo.defer_encoded_images) {
+    // The encoder may reuse its buffers once this returns.
+    PendingImage pending;
+    pending.image = stream_image;
+    pending.image.SetEncodedData(EncodedImageBuffer::Create(
+        encodedImage.data(), encodedImage.size()));
+    pending.codec_specific_info = stream_codec_specific;
+    if (fragmentation) {
+      pending.fragmentation = std::make_unique<RTPFragmentationHeader>();
+      pending.fragmentation->CopyFrom(*fragmentation);
+    }
+    streaminfo.pending_images.push_back(std::move(pending));
+    return EncodedImageCallback::Result(EncodedImageCallback::Result::OK);
+  }
+
   return encoded_complete_callback_->OnEncodedImage(
       stream_image, &stream_codec_specific, fragmentation);
 }
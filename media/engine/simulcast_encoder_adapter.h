@@ -20,12 +20,15 @@
 
 #include "absl/types/optional.h"
 #include "api/fec_controller_override.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
+#include "modules/include/module_common_types.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
@@ -36,6 +39,13 @@ class VideoEncoderFactory;
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // The object is created and destroyed on the worker thread, but all public
 // interfaces should be called from the encoder task queue.
+//
+// With the field trial "WebRTC-SimulcastEncoderAdapter-ParallelEncoding"
+// enabled and more than one core available, all streams but the highest
+// resolution one are encoded on task queues of their own, concurrently with
+// the highest resolution stream, which is still encoded on the encoder task
+// queue. Encode() then waits for all streams and delivers their encoded
+// images in stream order, as if they had been encoded one after the other.
 class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
  public:
   explicit SimulcastEncoderAdapter(VideoEncoderFactory* factory,
@@ -68,6 +78,13 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   EncoderInfo GetEncoderInfo() const override;
 
  private:
+  // An encoded image held back until the preceding streams are delivered.
+  struct PendingImage {
+    EncodedImage image;
+    CodecSpecificInfo codec_specific_info;
+    std::unique_ptr<RTPFragmentationHeader> fragmentation;
+  };
+
   struct StreamInfo {
     StreamInfo(std::unique_ptr<VideoEncoder> encoder,
                std::unique_ptr<EncodedImageCallback> callback,
@@ -86,6 +103,12 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     uint16_t height;
     bool key_frame_request;
     bool send_stream;
+    // Only set when encoding in parallel.
+    std::unique_ptr<rtc::TaskQueue> encode_queue;
+    // Set for the duration of a parallel Encode(), during which encoded
+    // images are stored in |pending_images| rather than delivered.
+    bool defer_encoded_images = false;
+    std::vector<PendingImage> pending_images;
   };
 
   enum class StreamResolution {
@@ -105,6 +128,11 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   void DestroyStoredEncoders();
 
+  // Encodes |frames| with the streams' encoders concurrently, and returns the
+  // first error in stream order.
+  int EncodeInParallel(const std::vector<VideoFrame>& frames,
+                       const std::vector<VideoFrameType>& frame_types);
+
   volatile int inited_;  // Accessed atomically.
   VideoEncoderFactory* const factory_;
   const SdpVideoFormat video_format_;
@@ -122,6 +150,8 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   const absl::optional<unsigned int> experimental_boosted_screenshare_qp_;
   const bool boost_base_layer_quality_;
+  // Null unless parallel encoding is enabled.
+  const std::unique_ptr<TaskQueueFactory> task_queue_factory_;
 };
 
 }  // namespace webrtc
@@ -27,10 +27,13 @@
 #include "modules/video_coding/codecs/vp8/include/vp8.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
+#include "rtc_base/platform_thread_types.h"
+#include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
 using ::testing::_;
+using ::testing::Invoke;
 using ::testing::Return;
 using EncoderInfo = webrtc::VideoEncoder::EncoderInfo;
 using FramerateFractions =
@@ -379,6 +382,8 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
     last_encoded_image_height_ = encoded_image._encodedHeight;
     last_encoded_image_simulcast_index_ =
         encoded_image.SpatialIndex().value_or(-1);
+    encoded_image_simulcast_indices_.push_back(
+        last_encoded_image_simulcast_index_);
 
     return Result(Result::OK, encoded_image.Timestamp());
   }
@@ -481,6 +486,7 @@ class TestSimulcastEncoderAdapterFake : public ::testing::Test,
   int last_encoded_image_width_;
   int last_encoded_image_height_;
   int last_encoded_image_simulcast_index_;
+  std::vector<int> encoded_image_simulcast_indices_;
   std::unique_ptr<SimulcastRateAllocator> rate_allocator_;
 };
 
@@ -913,6 +919,77 @@ TEST_F(TestSimulcastEncoderAdapterFake,
   EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
 }
 
+class FakeNativeBufferCountingI420 : public VideoFrameBuffer {
+ public:
+  FakeNativeBufferCountingI420(int width, int height)
+      : width_(width), height_(height) {}
+
+  Type type() const override { return Type::kNative; }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override {
+    ++num_to_i420_calls_;
+    rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    buffer->InitializeData();
+    return buffer;
+  }
+
+  int num_to_i420_calls() const { return num_to_i420_calls_; }
+
+ private:
+  const int width_;
+  const int height_;
+  int num_to_i420_calls_ = 0;
+};
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ConvertsNativeHandleOnceForMultipleSoftwareStreams) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  codec_.numberOfSimulcastStreams = 3;
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  // The top stream takes textures, the lower ones need I420.
+  helper_->factory()->encoders()[2]->set_supports_native_handle(true);
+
+  rtc::scoped_refptr<FakeNativeBufferCountingI420> buffer(
+      new rtc::RefCountedObject<FakeNativeBufferCountingI420>(1280, 720));
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(buffer)
+                               .set_timestamp_rtp(100)
+                               .set_timestamp_ms(1000)
+                               .set_rotation(kVideoRotation_0)
+                               .build();
+  for (size_t i = 0; i < 2; ++i) {
+    MockVideoEncoder* encoder = helper_->factory()->encoders()[i];
+    const int width = encoder->codec().width;
+    const int height = encoder->codec().height;
+    EXPECT_CALL(*encoder, Encode(_, _))
+        .WillOnce([width, height](const VideoFrame& frame,
+                                  const std::vector<VideoFrameType>*) {
+          EXPECT_EQ(VideoFrameBuffer::Type::kI420,
+                    frame.video_frame_buffer()->type());
+          EXPECT_EQ(width, frame.width());
+          EXPECT_EQ(height, frame.height());
+          return WEBRTC_VIDEO_CODEC_OK;
+        });
+  }
+  EXPECT_CALL(*helper_->factory()->encoders()[2], Encode(_, _))
+      .WillOnce([&buffer](const VideoFrame& frame,
+                          const std::vector<VideoFrameType>*) {
+        EXPECT_EQ(buffer.get(), frame.video_frame_buffer().get());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  EXPECT_EQ(1, buffer->num_to_i420_calls());
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -940,6 +1017,58 @@ TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
             adapter_->Encode(input_frame, &frame_types));
 }
 
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelEncodingDeliversImagesInStreamOrder) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ParallelEncoding/Enabled/");
+  adapter_.reset(helper_->CreateMockEncoderAdapter());
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  rate_allocator_.reset(new SimulcastRateAllocator(codec_));
+  const VideoEncoder::Settings settings(kCapabilities, 4, 1200);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, settings));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(1200, 30)),
+      30.0));
+
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+  const rtc::PlatformThreadRef encoder_queue = rtc::CurrentThreadRef();
+  bool on_encoder_queue[3] = {};
+  for (int i = 0; i < 3; ++i) {
+    MockVideoEncoder* encoder = encoders[i];
+    EXPECT_CALL(*encoder, Encode(_, _))
+        .WillOnce(Invoke([encoder, i, encoder_queue, &on_encoder_queue](
+                             const VideoFrame& frame,
+                             const std::vector<VideoFrameType>* frame_types) {
+          on_encoder_queue[i] =
+              rtc::IsThreadRefEqual(rtc::CurrentThreadRef(), encoder_queue);
+          encoder->SendEncodedImage(frame.width(), frame.height());
+          return WEBRTC_VIDEO_CODEC_OK;
+        }));
+  }
+
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  VideoFrame input_frame = VideoFrame::Builder()
+                               .set_video_frame_buffer(input_buffer)
+                               .set_timestamp_rtp(0)
+                               .set_timestamp_us(0)
+                               .set_rotation(kVideoRotation_0)
+                               .build();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+
+  // Only the highest resolution stream is encoded on the encoder queue.
+  EXPECT_FALSE(on_encoder_queue[0]);
+  EXPECT_FALSE(on_encoder_queue[1]);
+  EXPECT_TRUE(on_encoder_queue[2]);
+  EXPECT_EQ(std::vector<int>({0, 1, 2}), encoded_image_simulcast_indices_);
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestInitFailureCleansUpEncoders) {
   SimulcastTestFixtureImpl::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
@@ -10,15 +10,16 @@
 
 #include "media/engine/unhandled_packets_buffer.h"
 
+#include <utility>
+#include <vector>
+
 #include "absl/algorithm/container.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 
 namespace cricket {
 
-UnhandledPacketsBuffer::UnhandledPacketsBuffer() {
-  buffer_.reserve(kMaxStashedPackets);
-}
+UnhandledPacketsBuffer::UnhandledPacketsBuffer() = default;
 
 UnhandledPacketsBuffer::~UnhandledPacketsBuffer() = default;
 
@@ -26,45 +27,58 @@ UnhandledPacketsBuffer::~UnhandledPacketsBuffer() = default;
 void UnhandledPacketsBuffer::AddPacket(uint32_t ssrc,
                                        int64_t packet_time_us,
                                        rtc::CopyOnWriteBuffer packet) {
-  if (buffer_.size() < kMaxStashedPackets) {
-    buffer_.push_back({ssrc, packet_time_us, packet});
-  } else {
-    RTC_DCHECK_LT(insert_pos_, kMaxStashedPackets);
-    buffer_[insert_pos_] = {ssrc, packet_time_us, packet};
+  auto it = packets_by_ssrc_.find(ssrc);
+  if (it == packets_by_ssrc_.end()) {
+    if (ssrcs_.size() >= kMaxStashedSsrcs) {
+      packets_by_ssrc_.erase(ssrcs_.front());
+      ssrcs_.pop_front();
+    }
+    ssrcs_.push_back(ssrc);
+    it = packets_by_ssrc_.emplace(ssrc, std::deque<PacketWithMetadata>())
+             .first;
+  }
+
+  std::deque<PacketWithMetadata>& packets = it->second;
+  if (packets.size() >= kMaxStashedPacketsPerSsrc) {
+    packets.pop_front();
   }
-  insert_pos_ = (insert_pos_ + 1) % kMaxStashedPackets;
+  packets.push_back({next_index_++, packet_time_us, std::move(packet)});
 }
 
 // Backfill |consumer| with all stored packet related |ssrcs|.
 void UnhandledPacketsBuffer::BackfillPackets(
     rtc::ArrayView<const uint32_t> ssrcs,
     std::function<void(uint32_t, int64_t, rtc::CopyOnWriteBuffer)> consumer) {
-  size_t start;
-  if (buffer_.size() < kMaxStashedPackets) {
-    start = 0;
-  } else {
-    start = insert_pos_;
+  std::vector<std::pair<uint32_t, std::deque<PacketWithMetadata>>> matching;
+  for (uint32_t ssrc : ssrcs) {
+    auto it = packets_by_ssrc_.find(ssrc);
+    if (it == packets_by_ssrc_.end()) {
+      continue;
+    }
+    matching.emplace_back(ssrc, std::move(it->second));
+    packets_by_ssrc_.erase(it);
+    ssrcs_.erase(absl::c_find(ssrcs_, ssrc));
   }
 
-  size_t count = 0;
-  std::vector<PacketWithMetadata> remaining;
-  remaining.reserve(kMaxStashedPackets);
-  for (size_t i = 0; i < buffer_.size(); ++i) {
-    const size_t pos = (i + start) % kMaxStashedPackets;
-
-    // One or maybe 2 ssrcs is expected => loop array instead of more elaborate
-    // scheme.
-    const uint32_t ssrc = buffer_[pos].ssrc;
-    if (absl::c_linear_search(ssrcs, ssrc)) {
-      ++count;
-      consumer(ssrc, buffer_[pos].packet_time_us, buffer_[pos].packet);
-    } else {
-      remaining.push_back(buffer_[pos]);
+  // Merge the packets of the SSRCs back into the order they were added. One
+  // or maybe 2 ssrcs is expected => loop array instead of more elaborate
+  // scheme.
+  while (true) {
+    std::pair<uint32_t, std::deque<PacketWithMetadata>>* next = nullptr;
+    for (auto& ssrc_packets : matching) {
+      if (!ssrc_packets.second.empty() &&
+          (next == nullptr ||
+           ssrc_packets.second.front().index < next->second.front().index)) {
+        next = &ssrc_packets;
+      }
     }
+    if (next == nullptr) {
+      break;
+    }
+    PacketWithMetadata& packet = next->second.front();
+    consumer(next->first, packet.packet_time_us, std::move(packet.packet));
+    next->second.pop_front();
   }
-
-  insert_pos_ = 0;  // insert_pos is only used when buffer is full.
-  buffer_.swap(remaining);
 }
 
 }  // namespace cricket
@@ -13,19 +13,25 @@
 
 #include <stdint.h>
 
+#include <deque>
 #include <functional>
-#include <tuple>
-#include <utility>
-#include <vector>
+#include <map>
 
+#include "api/array_view.h"
 #include "rtc_base/copy_on_write_buffer.h"
 
 namespace cricket {
 
+// Stashes packets of unknown SSRCs until their streams are created. The packets
+// are kept per SSRC, so that each stream gets the latest packets of its own
+// SSRCs no matter how many other SSRCs show up in the meantime.
 class UnhandledPacketsBuffer {
  public:
   // Visible for testing.
-  static constexpr size_t kMaxStashedPackets = 50;
+  static constexpr size_t kMaxStashedPacketsPerSsrc = 50;
+  // When packets of more SSRCs arrive, the packets of the SSRC that was first
+  // stashed are dropped.
+  static constexpr size_t kMaxStashedSsrcs = 16;
 
   UnhandledPacketsBuffer();
   ~UnhandledPacketsBuffer();
@@ -35,19 +41,24 @@ class UnhandledPacketsBuffer {
                  int64_t packet_time_us,
                  rtc::CopyOnWriteBuffer packet);
 
-  // Feed all packets with |ssrcs| into |consumer|.
+  // Feed all packets with |ssrcs| into |consumer|, in the order they were
+  // added, and remove them from the buffer.
   void BackfillPackets(
       rtc::ArrayView<const uint32_t> ssrcs,
       std::function<void(uint32_t, int64_t, rtc::CopyOnWriteBuffer)> consumer);
 
  private:
-  size_t insert_pos_ = 0;
   struct PacketWithMetadata {
-    uint32_t ssrc;
+    // Position in the order of all added packets.
+    uint64_t index;
     int64_t packet_time_us;
     rtc::CopyOnWriteBuffer packet;
   };
-  std::vector<PacketWithMetadata> buffer_;
+  uint64_t next_index_ = 0;
+  // Oldest packet first.
+  std::map<uint32_t, std::deque<PacketWithMetadata>> packets_by_ssrc_;
+  // The stashed SSRCs, in the order they were first stashed.
+  std::deque<uint32_t> ssrcs_;
 };
 
 }  // namespace cricket
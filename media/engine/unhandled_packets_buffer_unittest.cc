@@ -94,7 +94,7 @@ TEST(UnhandledPacketsBuffer, TwoPacketsTwoSsrcsOneMatch) {
 }
 
 TEST(UnhandledPacketsBuffer, Full) {
-  const size_t cnt = UnhandledPacketsBuffer::kMaxStashedPackets;
+  const size_t cnt = UnhandledPacketsBuffer::kMaxStashedPacketsPerSsrc;
   UnhandledPacketsBuffer buff;
   for (size_t i = 0; i < cnt; i++) {
     buff.AddPacket(2, kPacketTimeUs, Create(i));
@@ -122,7 +122,7 @@ TEST(UnhandledPacketsBuffer, Full) {
 
 TEST(UnhandledPacketsBuffer, Wrap) {
   UnhandledPacketsBuffer buff;
-  size_t cnt = UnhandledPacketsBuffer::kMaxStashedPackets + 10;
+  size_t cnt = UnhandledPacketsBuffer::kMaxStashedPacketsPerSsrc + 10;
   for (size_t i = 0; i < cnt; i++) {
     buff.AddPacket(2, kPacketTimeUs, Create(i));
   }
@@ -168,4 +168,60 @@ TEST(UnhandledPacketsBuffer, Interleaved) {
   });
 }
 
+TEST(UnhandledPacketsBuffer, KeepsOrderAcrossSsrcs) {
+  UnhandledPacketsBuffer buff;
+  buff.AddPacket(2, kPacketTimeUs, Create(1));
+  buff.AddPacket(3, kPacketTimeUs, Create(2));
+  buff.AddPacket(4, kPacketTimeUs, Create(3));
+  buff.AddPacket(2, kPacketTimeUs, Create(4));
+  buff.AddPacket(3, kPacketTimeUs, Create(5));
+
+  std::vector<uint32_t> ssrcs = {3, 2};
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  buff.BackfillPackets(ssrcs, [&packets](uint32_t ssrc, int64_t packet_time_us,
+                                         rtc::CopyOnWriteBuffer packet) {
+    packets.push_back(packet);
+  });
+  ASSERT_EQ(4u, packets.size());
+  EXPECT_EQ(Create(1), packets[0]);
+  EXPECT_EQ(Create(2), packets[1]);
+  EXPECT_EQ(Create(4), packets[2]);
+  EXPECT_EQ(Create(5), packets[3]);
+}
+
+TEST(UnhandledPacketsBuffer, OtherSsrcsDoNotEvictPackets) {
+  UnhandledPacketsBuffer buff;
+  buff.AddPacket(2, kPacketTimeUs, Create(2));
+  for (size_t i = 0; i < 10 * UnhandledPacketsBuffer::kMaxStashedPacketsPerSsrc;
+       i++) {
+    buff.AddPacket(3 + i % 3, kPacketTimeUs, Create(i));
+  }
+
+  std::vector<uint32_t> ssrcs = {2};
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  buff.BackfillPackets(ssrcs, [&packets](uint32_t ssrc, int64_t packet_time_us,
+                                         rtc::CopyOnWriteBuffer packet) {
+    packets.push_back(packet);
+  });
+  ASSERT_EQ(1u, packets.size());
+  EXPECT_EQ(Create(2), packets[0]);
+}
+
+TEST(UnhandledPacketsBuffer, TooManySsrcsDropsFirstSsrc) {
+  UnhandledPacketsBuffer buff;
+  for (uint32_t ssrc = 0; ssrc <= UnhandledPacketsBuffer::kMaxStashedSsrcs;
+       ssrc++) {
+    buff.AddPacket(ssrc, kPacketTimeUs, Create(ssrc));
+  }
+
+  std::vector<uint32_t> ssrcs = {0, 1};
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  buff.BackfillPackets(ssrcs, [&packets](uint32_t ssrc, int64_t packet_time_us,
+                                         rtc::CopyOnWriteBuffer packet) {
+    packets.push_back(packet);
+  });
+  ASSERT_EQ(1u, packets.size());
+  EXPECT_EQ(Create(1), packets[0]);
+}
+
 }  // namespace cricket
@@ -34,6 +34,7 @@
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/field_trial_units.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -579,6 +580,8 @@ WebRtcVideoChannel::WebRtcVideoChannel(
       last_stats_log_ms_(-1),
       discard_unknown_ssrc_packets_(webrtc::field_trial::IsEnabled(
           "WebRTC-Video-DiscardPacketsWithUnknownSsrc")),
+      create_receive_streams_on_first_packet_(webrtc::field_trial::IsEnabled(
+          "WebRTC-Video-CreateReceiveStreamsOnFirstPacket")),
       crypto_options_(crypto_options),
       unknown_ssrc_packet_buffer_(
           webrtc::field_trial::IsEnabled(
@@ -1358,7 +1361,8 @@ bool WebRtcVideoChannel::AddRecvStream(const StreamParams& sp,
 
   receive_streams_[ssrc] = new WebRtcVideoReceiveStream(
       this, call_, sp, std::move(config), decoder_factory_, default_stream,
-      recv_codecs_, flexfec_config);
+      recv_codecs_, flexfec_config,
+      create_receive_streams_on_first_packet_ && !default_stream);
 
   return true;
 }
@@ -1547,14 +1551,47 @@ void WebRtcVideoChannel::OnPacketReceived(rtc::CopyOnWriteBuffer packet,
     case webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC:
       break;
   }
+  OnUnknownSsrcPacket(std::move(packet), packet_time_us);
+}
 
+void WebRtcVideoChannel::OnRtpPacketReceived(webrtc::RtpPacketReceived packet,
+                                             int64_t packet_time_us) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  // Shares the payload with |packet|, in case it has to be delivered again.
+  rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+  if (call_->Receiver()->DeliverRtpPacket(webrtc::MediaType::VIDEO,
+                                          std::move(packet), packet_time_us) !=
+      webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC) {
+    return;
+  }
+  OnUnknownSsrcPacket(std::move(buffer), packet_time_us);
+}
+
+void WebRtcVideoChannel::OnUnknownSsrcPacket(rtc::CopyOnWriteBuffer packet,
+                                             int64_t packet_time_us) {
   uint32_t ssrc = 0;
   if (!GetRtpSsrc(packet.cdata(), packet.size(), &ssrc)) {
     return;
   }
 
+  // The packet may be the first one of a signaled stream that was waiting for
+  // it to be created.
+  if (create_receive_streams_on_first_packet_ &&
+      receive_ssrcs_.find(ssrc) != receive_ssrcs_.end()) {
+    for (auto& kv : receive_streams_) {
+      if (absl::c_linear_search(kv.second->GetSsrcs(), ssrc)) {
+        if (kv.second->CreateDeferredStream()) {
+          call_->Receiver()->DeliverPacket(webrtc::MediaType::VIDEO, packet,
+                                           packet_time_us);
+        }
+        return;
+      }
+    }
+  }
+
   if (unknown_ssrc_packet_buffer_) {
-    unknown_ssrc_packet_buffer_->AddPacket(ssrc, packet_time_us, packet);
+    unknown_ssrc_packet_buffer_->AddPacket(ssrc, packet_time_us,
+                                           std::move(packet));
     return;
   }
 
@@ -1799,6 +1836,8 @@ bool WebRtcVideoChannel::SendRtp(const uint8_t* data,
       options.included_in_feedback;
   rtc_options.info_signaled_after_sent.included_in_allocation =
       options.included_in_allocation;
+  rtc_options.batchable = options.batchable;
+  rtc_options.last_packet_in_batch = options.last_packet_in_batch;
   return MediaChannel::SendPacket(&packet, rtc_options);
 }
 
@@ -2393,6 +2432,8 @@ VideoSenderInfo WebRtcVideoChannel::WebRtcVideoSendStream::GetVideoSenderInfo(
   info.avg_encode_ms = stats.avg_encode_time_ms;
   info.encode_usage_percent = stats.encode_usage_percent;
   info.frames_encoded = stats.frames_encoded;
+  info.rtp_packet_history_bytes = stats.rtp_packet_history_bytes;
+  info.rtp_packet_history_max_packets = stats.rtp_packet_history_max_packets;
   // TODO(bugs.webrtc.org/9547): Populate individual outbound-rtp stats objects
   // for each simulcast stream, instead of accumulating all keyframes encoded
   // over all simulcast streams in the same outbound-rtp stats object.
@@ -2527,11 +2568,13 @@ WebRtcVideoChannel::WebRtcVideoReceiveStream::WebRtcVideoReceiveStream(
     webrtc::VideoDecoderFactory* decoder_factory,
     bool default_stream,
     const std::vector<VideoCodecSettings>& recv_codecs,
-    const webrtc::FlexfecReceiveStream::Config& flexfec_config)
+    const webrtc::FlexfecReceiveStream::Config& flexfec_config,
+    bool create_on_first_packet)
     : channel_(channel),
       call_(call),
       stream_params_(sp),
       stream_(NULL),
+      stream_deferred_(create_on_first_packet),
       default_stream_(default_stream),
       config_(std::move(config)),
       flexfec_config_(flexfec_config),
@@ -2554,7 +2597,20 @@ WebRtcVideoChannel::WebRtcVideoReceiveStream::~WebRtcVideoReceiveStream() {
     MaybeDissociateFlexfecFromVideo();
     call_->DestroyFlexfecReceiveStream(flexfec_stream_);
   }
-  call_->DestroyVideoReceiveStream(stream_);
+  if (stream_) {
+    call_->DestroyVideoReceiveStream(stream_);
+  }
+}
+
+bool WebRtcVideoChannel::WebRtcVideoReceiveStream::CreateDeferredStream() {
+  if (!stream_deferred_) {
+    return false;
+  }
+  RTC_LOG(LS_INFO) << "Creating receive stream on first packet, remote_ssrc="
+                   << config_.rtp.remote_ssrc;
+  stream_deferred_ = false;
+  RecreateWebRtcVideoStream();
+  return true;
 }
 
 const std::vector<uint32_t>&
@@ -2564,7 +2620,9 @@ WebRtcVideoChannel::WebRtcVideoReceiveStream::GetSsrcs() const {
 
 std::vector<webrtc::RtpSource>
 WebRtcVideoChannel::WebRtcVideoReceiveStream::GetSources() {
-  RTC_DCHECK(stream_);
+  if (!stream_) {
+    return {};
+  }
   return stream_->GetSources();
 }
 
@@ -2714,12 +2772,18 @@ void WebRtcVideoChannel::WebRtcVideoReceiveStream::SetRecvParameters(
 }
 
 void WebRtcVideoChannel::WebRtcVideoReceiveStream::RecreateWebRtcVideoStream() {
+  if (stream_deferred_) {
+    // |config_| is used as is once the stream is created.
+    return;
+  }
   absl::optional<int> base_minimum_playout_delay_ms;
   if (stream_) {
     base_minimum_playout_delay_ms = stream_->GetBaseMinimumPlayoutDelayMs();
     MaybeDissociateFlexfecFromVideo();
     call_->DestroyVideoReceiveStream(stream_);
     stream_ = nullptr;
+  } else if (deferred_base_minimum_playout_delay_ms_ != 0) {
+    base_minimum_playout_delay_ms = deferred_base_minimum_playout_delay_ms_;
   }
   webrtc::VideoReceiveStream::Config config = config_.Copy();
   config.rtp.protected_by_flexfec = (flexfec_stream_ != nullptr);
@@ -2801,11 +2865,18 @@ void WebRtcVideoChannel::WebRtcVideoReceiveStream::SetFrameDecryptor(
 
 bool WebRtcVideoChannel::WebRtcVideoReceiveStream::SetBaseMinimumPlayoutDelayMs(
     int delay_ms) {
+  if (stream_deferred_) {
+    deferred_base_minimum_playout_delay_ms_ = delay_ms;
+    return true;
+  }
   return stream_ ? stream_->SetBaseMinimumPlayoutDelayMs(delay_ms) : false;
 }
 
 int WebRtcVideoChannel::WebRtcVideoReceiveStream::GetBaseMinimumPlayoutDelayMs()
     const {
+  if (stream_deferred_) {
+    return deferred_base_minimum_playout_delay_ms_;
+  }
   return stream_ ? stream_->GetBaseMinimumPlayoutDelayMs() : 0;
 }
 
@@ -2832,6 +2903,10 @@ WebRtcVideoChannel::WebRtcVideoReceiveStream::GetVideoReceiverInfo(
   VideoReceiverInfo info;
   info.ssrc_groups = stream_params_.ssrc_groups;
   info.add_ssrc(config_.rtp.remote_ssrc);
+  if (!stream_) {
+    // Nothing has been received yet.
+    return info;
+  }
   webrtc::VideoReceiveStream::Stats stats = stream_->GetStats();
   info.decoder_implementation_name = stats.decoder_implementation_name;
   if (stats.current_payload_type != -1) {
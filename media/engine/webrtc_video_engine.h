@@ -163,6 +163,8 @@ class WebRtcVideoChannel : public VideoMediaChannel,
 
   void OnPacketReceived(rtc::CopyOnWriteBuffer packet,
                         int64_t packet_time_us) override;
+  void OnRtpPacketReceived(webrtc::RtpPacketReceived packet,
+                           int64_t packet_time_us) override;
   void OnReadyToSend(bool ready) override;
   void OnNetworkRouteChanged(const std::string& transport_name,
                              const rtc::NetworkRoute& network_route) override;
@@ -286,6 +288,11 @@ class WebRtcVideoChannel : public VideoMediaChannel,
       RTC_EXCLUSIVE_LOCKS_REQUIRED(thread_checker_);
   void DeleteReceiveStream(WebRtcVideoReceiveStream* stream)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(thread_checker_);
+  // Handles a packet that Call didn't know the SSRC of, e.g. by creating a
+  // receive stream for it and delivering it again.
+  void OnUnknownSsrcPacket(rtc::CopyOnWriteBuffer packet,
+                           int64_t packet_time_us)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(thread_checker_);
 
   static std::string CodecSettingsVectorToString(
       const std::vector<VideoCodecSettings>& codecs);
@@ -413,9 +420,14 @@ class WebRtcVideoChannel : public VideoMediaChannel,
         webrtc::VideoDecoderFactory* decoder_factory,
         bool default_stream,
         const std::vector<VideoCodecSettings>& recv_codecs,
-        const webrtc::FlexfecReceiveStream::Config& flexfec_config);
+        const webrtc::FlexfecReceiveStream::Config& flexfec_config,
+        bool create_on_first_packet);
     ~WebRtcVideoReceiveStream();
 
+    // Creates the webrtc::VideoReceiveStream if its creation was deferred
+    // until the first packet. Returns false if it already existed.
+    bool CreateDeferredStream();
+
     const std::vector<uint32_t>& GetSsrcs() const;
 
     std::vector<webrtc::RtpSource> GetSources();
@@ -465,6 +477,11 @@ class WebRtcVideoChannel : public VideoMediaChannel,
     // destroyed by calling call_->DestroyVideoReceiveStream and
     // call_->DestroyFlexfecReceiveStream, respectively.
     webrtc::VideoReceiveStream* stream_;
+    // True while |stream_| is not created yet because no packet has been
+    // received for it. Configuration changes only update |config_| meanwhile.
+    bool stream_deferred_;
+    // Applied to |stream_| once it is created.
+    int deferred_base_minimum_playout_delay_ms_ = 0;
     const bool default_stream_;
     webrtc::VideoReceiveStream::Config config_;
     webrtc::FlexfecReceiveStream::Config flexfec_config_;
@@ -572,6 +589,11 @@ class WebRtcVideoChannel : public VideoMediaChannel,
   VideoRecvParameters recv_params_ RTC_GUARDED_BY(thread_checker_);
   int64_t last_stats_log_ms_ RTC_GUARDED_BY(thread_checker_);
   const bool discard_unknown_ssrc_packets_ RTC_GUARDED_BY(thread_checker_);
+  // If set, the webrtc::VideoReceiveStream of a signaled receive stream is
+  // only created when its first packet is received, so that receive streams
+  // that never get any media don't cost decoders and Call streams.
+  const bool create_receive_streams_on_first_packet_
+      RTC_GUARDED_BY(thread_checker_);
   // This is a stream param that comes from the remote description, but wasn't
   // signaled with any a=ssrc lines. It holds information that was signaled
   // before the unsignaled receive stream is created when the first packet is
@@ -5511,6 +5511,38 @@ TEST_F(WebRtcVideoChannelTest, MapsReceivedPayloadTypeToCodecName) {
 // Tests that when we add a stream without SSRCs, but contains a stream_id
 // that it is stored and its stream id is later used when the first packet
 // arrives to properly create a receive stream with a sync label.
+// Tests that a signaled receive stream is only created in the Call when its
+// first packet is received, with the field trial.
+TEST_F(WebRtcVideoChannelTest, CreateReceiveStreamOnFirstPacket) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-Video-CreateReceiveStreamsOnFirstPacket/Enabled/");
+  SetUp();
+  const uint32_t kSsrc = 1234;
+  ASSERT_TRUE(channel_->AddRecvStream(StreamParams::CreateLegacy(kSsrc)));
+  EXPECT_EQ(0u, fake_call_->GetVideoReceiveStreams().size());
+  // Parameters and stats work before the stream exists.
+  EXPECT_TRUE(channel_->SetRecvParameters(recv_parameters_));
+  cricket::VideoMediaInfo info;
+  ASSERT_TRUE(channel_->GetStats(&info));
+  ASSERT_EQ(1u, info.receivers.size());
+  EXPECT_EQ(kSsrc, info.receivers[0].ssrc());
+
+  const size_t kDataLength = 12;
+  uint8_t data[kDataLength];
+  memset(data, 0, sizeof(data));
+  rtc::SetBE32(&data[8], kSsrc);
+  rtc::CopyOnWriteBuffer packet(data, kDataLength);
+  channel_->OnPacketReceived(packet, /* packet_time_us */ -1);
+  ASSERT_EQ(1u, fake_call_->GetVideoReceiveStreams().size());
+  FakeVideoReceiveStream* stream = fake_call_->GetVideoReceiveStreams()[0];
+  EXPECT_EQ(kSsrc, stream->GetConfig().rtp.remote_ssrc);
+  EXPECT_TRUE(stream->IsReceiving());
+
+  // Later packets don't create more streams.
+  channel_->OnPacketReceived(packet, /* packet_time_us */ -1);
+  EXPECT_EQ(1u, fake_call_->GetVideoReceiveStreams().size());
+}
+
 TEST_F(WebRtcVideoChannelTest, RecvUnsignaledSsrcWithSignaledStreamId) {
   const char kSyncLabel[] = "sync_label";
   cricket::StreamParams unsignaled_stream;
@@ -44,6 +44,7 @@
 #include "rtc_base/strings/audio_format_to_string.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/third_party/base64/base64.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/field_trial.h"
 #include "system_wrappers/include/metrics.h"
@@ -200,7 +201,9 @@ WebRtcVoiceEngine::WebRtcVoiceEngine(
       encoder_factory_(encoder_factory),
       decoder_factory_(decoder_factory),
       audio_mixer_(audio_mixer),
-      apm_(audio_processing) {
+      apm_(audio_processing),
+      lazy_audio_device_init_(
+          webrtc::field_trial::IsEnabled("WebRTC-Audio-LazyDeviceInit")) {
   // This may be called from any thread, so detach thread checkers.
   worker_thread_checker_.Detach();
   signal_thread_checker_.Detach();
@@ -234,18 +237,7 @@ void WebRtcVoiceEngine::Init() {
       new rtc::TaskQueue(task_queue_factory_->CreateTaskQueue(
           "rtc-low-prio", webrtc::TaskQueueFactory::Priority::LOW)));
 
-  // Load our audio codec lists.
-  RTC_LOG(LS_INFO) << "Supported send codecs in order of preference:";
-  send_codecs_ = CollectCodecs(encoder_factory_->GetSupportedEncoders());
-  for (const AudioCodec& codec : send_codecs_) {
-    RTC_LOG(LS_INFO) << ToString(codec);
-  }
-
-  RTC_LOG(LS_INFO) << "Supported recv codecs in order of preference:";
-  recv_codecs_ = CollectCodecs(decoder_factory_->GetSupportedDecoders());
-  for (const AudioCodec& codec : recv_codecs_) {
-    RTC_LOG(LS_INFO) << ToString(codec);
-  }
+  // The audio codec lists are loaded on first use.
 
 #if defined(WEBRTC_INCLUDE_INTERNAL_AUDIO_DEVICE)
   // No ADM supplied? Create a default one.
@@ -255,8 +247,6 @@ void WebRtcVoiceEngine::Init() {
   }
 #endif  // WEBRTC_INCLUDE_INTERNAL_AUDIO_DEVICE
   RTC_CHECK(adm());
-  webrtc::adm_helpers::Init(adm());
-  webrtc::apm_helpers::Init(apm());
 
   // Set up AudioState.
   {
@@ -274,6 +264,20 @@ void WebRtcVoiceEngine::Init() {
   // Connect the ADM to our audio path.
   adm()->RegisterAudioCallback(audio_state()->audio_transport());
 
+  initialized_ = true;
+  if (!lazy_audio_device_init_)
+    InitAudioDevice();
+}
+
+void WebRtcVoiceEngine::InitAudioDevice() {
+  RTC_DCHECK(worker_thread_checker_.IsCurrent());
+  RTC_DCHECK(initialized_);
+  if (audio_device_initialized_)
+    return;
+  const int64_t start_time_ms = rtc::TimeMillis();
+  webrtc::adm_helpers::Init(adm());
+  webrtc::apm_helpers::Init(apm());
+
   // Set default engine options.
   {
     AudioOptions options;
@@ -294,7 +298,11 @@ void WebRtcVoiceEngine::Init() {
     RTC_DCHECK(error);
   }
 
-  initialized_ = true;
+  audio_device_initialized_ = true;
+  const int64_t elapsed_ms = rtc::TimeMillis() - start_time_ms;
+  RTC_LOG(LS_INFO) << "Audio device and processing initialized in "
+                   << elapsed_ms << " ms";
+  RTC_HISTOGRAM_COUNTS_10000("WebRTC.Audio.DeviceInitTimeMs", elapsed_ms);
 }
 
 rtc::scoped_refptr<webrtc::AudioState> WebRtcVoiceEngine::GetAudioState()
@@ -309,6 +317,7 @@ VoiceMediaChannel* WebRtcVoiceEngine::CreateMediaChannel(
     const AudioOptions& options,
     const webrtc::CryptoOptions& crypto_options) {
   RTC_DCHECK(worker_thread_checker_.IsCurrent());
+  InitAudioDevice();
   return new WebRtcVoiceMediaChannel(this, config, options, crypto_options,
                                      call);
 }
@@ -513,12 +522,26 @@ bool WebRtcVoiceEngine::ApplyOptions(const AudioOptions& options_in) {
 
 const std::vector<AudioCodec>& WebRtcVoiceEngine::send_codecs() const {
   RTC_DCHECK(signal_thread_checker_.IsCurrent());
-  return send_codecs_;
+  if (!send_codecs_) {
+    send_codecs_ = CollectCodecs(encoder_factory_->GetSupportedEncoders());
+    RTC_LOG(LS_INFO) << "Supported send codecs in order of preference:";
+    for (const AudioCodec& codec : *send_codecs_) {
+      RTC_LOG(LS_INFO) << ToString(codec);
+    }
+  }
+  return *send_codecs_;
 }
 
 const std::vector<AudioCodec>& WebRtcVoiceEngine::recv_codecs() const {
   RTC_DCHECK(signal_thread_checker_.IsCurrent());
-  return recv_codecs_;
+  if (!recv_codecs_) {
+    recv_codecs_ = CollectCodecs(decoder_factory_->GetSupportedDecoders());
+    RTC_LOG(LS_INFO) << "Supported recv codecs in order of preference:";
+    for (const AudioCodec& codec : *recv_codecs_) {
+      RTC_LOG(LS_INFO) << ToString(codec);
+    }
+  }
+  return *recv_codecs_;
 }
 
 RtpCapabilities WebRtcVoiceEngine::GetCapabilities() const {
@@ -2048,13 +2071,38 @@ void WebRtcVoiceMediaChannel::OnPacketReceived(rtc::CopyOnWriteBuffer packet,
     return;
   }
 
-  // Create an unsignaled receive stream for this previously not received ssrc.
-  // If there already is N unsignaled receive streams, delete the oldest.
-  // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=5208
   uint32_t ssrc = 0;
   if (!GetRtpSsrc(packet.cdata(), packet.size(), &ssrc)) {
     return;
   }
+  OnUnknownSsrcPacket(ssrc, std::move(packet), packet_time_us);
+}
+
+void WebRtcVoiceMediaChannel::OnRtpPacketReceived(
+    webrtc::RtpPacketReceived packet,
+    int64_t packet_time_us) {
+  RTC_DCHECK(worker_thread_checker_.IsCurrent());
+  const uint32_t ssrc = packet.Ssrc();
+  // Shares the payload with |packet|, in case it has to be delivered again.
+  rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+
+  webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverRtpPacket(webrtc::MediaType::AUDIO,
+                                          std::move(packet), packet_time_us);
+
+  if (delivery_result != webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC) {
+    return;
+  }
+  OnUnknownSsrcPacket(ssrc, std::move(buffer), packet_time_us);
+}
+
+void WebRtcVoiceMediaChannel::OnUnknownSsrcPacket(
+    uint32_t ssrc,
+    rtc::CopyOnWriteBuffer packet,
+    int64_t packet_time_us) {
+  // Create an unsignaled receive stream for this previously not received ssrc.
+  // If there already is N unsignaled receive streams, delete the oldest.
+  // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=5208
   RTC_DCHECK(!absl::c_linear_search(unsignaled_recv_ssrcs_, ssrc));
 
   // Add new stream.
@@ -2094,8 +2142,9 @@ void WebRtcVoiceMediaChannel::OnPacketReceived(rtc::CopyOnWriteBuffer packet,
     SetRawAudioSink(ssrc, std::move(proxy_sink));
   }
 
-  delivery_result = call_->Receiver()->DeliverPacket(webrtc::MediaType::AUDIO,
-                                                     packet, packet_time_us);
+  webrtc::PacketReceiver::DeliveryStatus delivery_result =
+      call_->Receiver()->DeliverPacket(webrtc::MediaType::AUDIO,
+                                       std::move(packet), packet_time_us);
   RTC_DCHECK_NE(webrtc::PacketReceiver::DELIVERY_UNKNOWN_SSRC, delivery_result);
 }
 
@@ -2180,6 +2229,8 @@ bool WebRtcVoiceMediaChannel::GetStats(VoiceMediaInfo* info) {
     sinfo.ana_statistics = stats.ana_statistics;
     sinfo.apm_statistics = stats.apm_statistics;
     sinfo.report_block_datas = std::move(stats.report_block_datas);
+    sinfo.rtp_packet_history_bytes = stats.rtp_packet_history_bytes;
+    sinfo.rtp_packet_history_max_packets = stats.rtp_packet_history_max_packets;
     info->senders.push_back(sinfo);
   }
 
@@ -2250,6 +2301,8 @@ bool WebRtcVoiceMediaChannel::GetStats(VoiceMediaInfo* info) {
     rinfo.last_packet_received_timestamp_ms =
         stats.last_packet_received_timestamp_ms;
     rinfo.jitter_buffer_flushes = stats.jitter_buffer_flushes;
+    rinfo.jitter_buffer_bytes = stats.jitter_buffer_bytes;
+    rinfo.jitter_buffer_max_packets = stats.jitter_buffer_max_packets;
     rinfo.relative_packet_arrival_delay_seconds =
         stats.relative_packet_arrival_delay_seconds;
     rinfo.interruption_count = stats.interruption_count;
@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/audio_codecs/audio_encoder_factory.h"
 #include "api/scoped_refptr.h"
 #include "api/task_queue/task_queue_factory.h"
@@ -88,6 +89,12 @@ class WebRtcVoiceEngine final : public VoiceEngineInterface {
   // easily at any time.
   bool ApplyOptions(const AudioOptions& options);
 
+  // Initializes the audio device and audio processing modules and applies the
+  // default options. Called by Init(), or before the first media channel is
+  // created if the WebRTC-Audio-LazyDeviceInit field trial is enabled, so that
+  // processes that never use audio don't pay for opening the devices.
+  void InitAudioDevice();
+
   int CreateVoEChannel();
 
   webrtc::TaskQueueFactory* const task_queue_factory_;
@@ -112,11 +119,14 @@ class WebRtcVoiceEngine final : public VoiceEngineInterface {
   rtc::scoped_refptr<webrtc::AudioProcessing> apm_;
   // The primary instance of WebRtc VoiceEngine.
   rtc::scoped_refptr<webrtc::AudioState> audio_state_;
-  std::vector<AudioCodec> send_codecs_;
-  std::vector<AudioCodec> recv_codecs_;
+  // Collected on first use.
+  mutable absl::optional<std::vector<AudioCodec>> send_codecs_;
+  mutable absl::optional<std::vector<AudioCodec>> recv_codecs_;
   std::vector<WebRtcVoiceMediaChannel*> channels_;
   bool is_dumping_aec_ = false;
   bool initialized_ = false;
+  const bool lazy_audio_device_init_;
+  bool audio_device_initialized_ = false;
 
   // Cache experimental_ns and apply in case they are missing in the audio
   // options. We need to do this because SetExtraOptions() will revert to
@@ -193,6 +203,8 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
 
   void OnPacketReceived(rtc::CopyOnWriteBuffer packet,
                         int64_t packet_time_us) override;
+  void OnRtpPacketReceived(webrtc::RtpPacketReceived packet,
+                           int64_t packet_time_us) override;
   void OnNetworkRouteChanged(const std::string& transport_name,
                              const rtc::NetworkRoute& network_route) override;
   void OnReadyToSend(bool ready) override;
@@ -220,6 +232,8 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
         options.included_in_feedback;
     rtc_options.info_signaled_after_sent.included_in_allocation =
         options.included_in_allocation;
+    rtc_options.batchable = options.batchable;
+    rtc_options.last_packet_in_batch = options.last_packet_in_batch;
     return VoiceMediaChannel::SendPacket(&packet, rtc_options);
   }
 
@@ -249,6 +263,11 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   // Check if 'ssrc' is an unsignaled stream, and if so mark it as not being
   // unsignaled anymore (i.e. it is now removed, or signaled), and return true.
   bool MaybeDeregisterUnsignaledRecvStream(uint32_t ssrc);
+  // Creates an unsignaled receive stream for a packet that Call didn't know
+  // the SSRC of, and delivers the packet to it.
+  void OnUnknownSsrcPacket(uint32_t ssrc,
+                           rtc::CopyOnWriteBuffer packet,
+                           int64_t packet_time_us);
 
   rtc::ThreadChecker worker_thread_checker_;
 
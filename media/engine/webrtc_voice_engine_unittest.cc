@@ -2570,6 +2570,20 @@ TEST_F(WebRtcVoiceEngineTestFake, RecvUnsignaled) {
       GetRecvStream(kSsrc1).VerifyLastPacket(kPcmuFrame, sizeof(kPcmuFrame)));
 }
 
+// Tests that a packet parsed by the RTP transport creates an unsignaled stream
+// and is delivered to it.
+TEST_F(WebRtcVoiceEngineTestFake, RecvUnsignaledParsedPacket) {
+  EXPECT_TRUE(SetupChannel());
+  webrtc::RtpPacketReceived packet;
+  ASSERT_TRUE(packet.Parse(kPcmuFrame, sizeof(kPcmuFrame)));
+
+  channel_->OnRtpPacketReceived(std::move(packet), /*packet_time_us=*/-1);
+
+  EXPECT_EQ(1u, call_.GetAudioReceiveStreams().size());
+  EXPECT_TRUE(
+      GetRecvStream(kSsrc1).VerifyLastPacket(kPcmuFrame, sizeof(kPcmuFrame)));
+}
+
 // Tests that when we add a stream without SSRCs, but contains a stream_id
 // that it is stored and its stream id is later used when the first packet
 // arrives to properly create a receive stream with a sync label.
@@ -3462,6 +3476,38 @@ TEST(WebRtcVoiceEngineTest, StartupShutdown) {
   delete channel;
 }
 
+// Tests that the audio device is only initialized for the first channel when
+// lazy initialization is enabled.
+TEST(WebRtcVoiceEngineTest, LazyDeviceInitWaitsForFirstChannel) {
+  webrtc::test::ScopedFieldTrials override_field_trials(
+      "WebRTC-Audio-LazyDeviceInit/Enabled/");
+  std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory =
+      webrtc::CreateDefaultTaskQueueFactory();
+  ::testing::NiceMock<webrtc::test::MockAudioDeviceModule> adm;
+  rtc::scoped_refptr<webrtc::AudioProcessing> apm =
+      webrtc::AudioProcessingBuilder().Create();
+  cricket::WebRtcVoiceEngine engine(
+      task_queue_factory.get(), &adm,
+      webrtc::MockAudioEncoderFactory::CreateUnusedFactory(),
+      webrtc::MockAudioDecoderFactory::CreateUnusedFactory(), nullptr, apm);
+  EXPECT_CALL(adm, Init()).Times(0);
+  engine.Init();
+  ::testing::Mock::VerifyAndClearExpectations(&adm);
+
+  webrtc::RtcEventLogNull event_log;
+  webrtc::Call::Config call_config(&event_log);
+  call_config.task_queue_factory = task_queue_factory.get();
+  auto call = absl::WrapUnique(webrtc::Call::Create(call_config));
+  EXPECT_CALL(adm, Init()).WillOnce(Return(0));
+  for (int i = 0; i < 2; ++i) {
+    std::unique_ptr<cricket::VoiceMediaChannel> channel(
+        engine.CreateMediaChannel(call.get(), cricket::MediaConfig(),
+                                  cricket::AudioOptions(),
+                                  webrtc::CryptoOptions()));
+    EXPECT_TRUE(channel);
+  }
+}
+
 // Tests that reference counting on the external ADM is correct.
 TEST(WebRtcVoiceEngineTest, StartupShutdownWithExternalADM) {
   std::unique_ptr<webrtc::TaskQueueFactory> task_queue_factory =
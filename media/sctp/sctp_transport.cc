@@ -39,7 +39,9 @@ enum PreservedErrno {
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/string_utils.h"
 #include "rtc_base/thread_checker.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
+#include "system_wrappers/include/field_trial.h"
 #include "usrsctplib/usrsctp.h"
 
 namespace {
@@ -48,9 +50,47 @@ namespace {
 // take off 80 bytes for DTLS/TURN/TCP/IP overhead.
 static constexpr size_t kSctpMtu = 1200;
 
+// How often the usrsctp timers are run when usrsctp runs on the network
+// thread. usrsctp's own timer thread ticks every 10 ms as well.
+static constexpr int kSctpTimerIntervalMs = 10;
+
 // Set the initial value of the static SCTP Data Engines reference count.
 int g_usrsctp_usage_count = 0;
 rtc::GlobalLockPod g_usrsctp_lock_;
+// Whether usrsctp was initialized without its own threads, in which case
+// packets are processed and callbacks are made on the network thread.
+bool g_usrsctp_no_threads = false;
+
+// Runs the usrsctp timers on a thread of ours when usrsctp has no threads of
+// its own. Guarded by |g_usrsctp_lock_|; a driver that is no longer
+// |g_usrsctp_timer_driver| deletes itself the next time it runs.
+class UsrSctpTimerDriver : public rtc::MessageHandler {
+ public:
+  explicit UsrSctpTimerDriver(rtc::Thread* thread)
+      : thread_(thread), last_run_ms_(rtc::TimeMillis()) {
+    thread_->PostDelayed(RTC_FROM_HERE, kSctpTimerIntervalMs, this);
+  }
+
+  void OnMessage(rtc::Message* msg) override;
+
+ private:
+  rtc::Thread* const thread_;
+  int64_t last_run_ms_;
+};
+
+UsrSctpTimerDriver* g_usrsctp_timer_driver = nullptr;
+
+void UsrSctpTimerDriver::OnMessage(rtc::Message* msg) {
+  rtc::GlobalLockScope lock(&g_usrsctp_lock_);
+  if (g_usrsctp_timer_driver != this) {
+    delete this;
+    return;
+  }
+  int64_t now_ms = rtc::TimeMillis();
+  usrsctp_handle_timers(rtc::checked_cast<uint32_t>(now_ms - last_run_ms_));
+  last_run_ms_ = now_ms;
+  thread_->PostDelayed(RTC_FROM_HERE, kSctpTimerIntervalMs, this);
+}
 
 // DataMessageType is used for the SCTP "Payload Protocol Identifier", as
 // defined in http://tools.ietf.org/html/rfc4960#section-14.4
@@ -200,11 +240,25 @@ namespace cricket {
 // SctpTransport calls.
 class SctpTransport::UsrSctpWrapper {
  public:
-  static void InitializeUsrSctp() {
+  static void InitializeUsrSctp(rtc::Thread* network_thread) {
     RTC_LOG(LS_INFO) << __FUNCTION__;
+    // With "WebRTC-SctpRunOnNetworkThread", usrsctp doesn't start its timer
+    // and receive threads. Packets are then processed inline on the network
+    // thread that hands them to usrsctp, and the timers are run on the network
+    // thread of the transport that initializes usrsctp. SCTP transports are
+    // expected to share that thread, as they do within a PeerConnection
+    // factory.
+    g_usrsctp_no_threads =
+        webrtc::field_trial::IsEnabled("WebRTC-SctpRunOnNetworkThread");
     // First argument is udp_encapsulation_port, which is not releveant for our
     // AF_CONN use of sctp.
-    usrsctp_init(0, &UsrSctpWrapper::OnSctpOutboundPacket, &DebugSctpPrintf);
+    if (g_usrsctp_no_threads) {
+      usrsctp_init_nothreads(0, &UsrSctpWrapper::OnSctpOutboundPacket,
+                             &DebugSctpPrintf);
+      g_usrsctp_timer_driver = new UsrSctpTimerDriver(network_thread);
+    } else {
+      usrsctp_init(0, &UsrSctpWrapper::OnSctpOutboundPacket, &DebugSctpPrintf);
+    }
 
     // To turn on/off detailed SCTP debugging. You will also need to have the
     // SCTP_DEBUG cpp defines flag, which can be turned on in media/BUILD.gn.
@@ -245,6 +299,8 @@ class SctpTransport::UsrSctpWrapper {
 
   static void UninitializeUsrSctp() {
     RTC_LOG(LS_INFO) << __FUNCTION__;
+    // The timer driver deletes itself when it next runs.
+    g_usrsctp_timer_driver = nullptr;
     // usrsctp_finish() may fail if it's called too soon after the transports
     // are
     // closed. Wait and try again until it succeeds for up to 3 seconds.
@@ -258,10 +314,10 @@ class SctpTransport::UsrSctpWrapper {
     RTC_LOG(LS_ERROR) << "Failed to shutdown usrsctp.";
   }
 
-  static void IncrementUsrSctpUsageCount() {
+  static void IncrementUsrSctpUsageCount(rtc::Thread* network_thread) {
     rtc::GlobalLockScope lock(&g_usrsctp_lock_);
     if (!g_usrsctp_usage_count) {
-      InitializeUsrSctp();
+      InitializeUsrSctp(network_thread);
     }
     ++g_usrsctp_usage_count;
   }
@@ -290,6 +346,10 @@ class SctpTransport::UsrSctpWrapper {
     VerboseLogPacket(data, length, SCTP_DUMP_OUTBOUND);
     // Note: We have to copy the data; the caller will delete it.
     rtc::CopyOnWriteBuffer buf(reinterpret_cast<uint8_t*>(data), length);
+    if (g_usrsctp_no_threads && transport->network_thread_->IsCurrent()) {
+      transport->OnPacketFromSctpToNetwork(buf);
+      return 0;
+    }
     // TODO(deadbeef): Why do we need an AsyncInvoke here? We're already on the
     // right thread and don't need to unwind the stack.
     transport->invoker_.AsyncInvoke<void>(
@@ -298,10 +358,27 @@ class SctpTransport::UsrSctpWrapper {
     return 0;
   }
 
+  // Delivers a received message to |transport| on its network thread; inline if
+  // usrsctp runs on it.
+  static void DeliverInboundPacket(SctpTransport* transport,
+                                   const rtc::CopyOnWriteBuffer& buffer,
+                                   const ReceiveDataParams& params,
+                                   int flags) {
+    if (g_usrsctp_no_threads && transport->network_thread_->IsCurrent()) {
+      transport->OnInboundPacketFromSctpToTransport(buffer, params, flags);
+      return;
+    }
+    transport->invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, transport->network_thread_,
+        rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport,
+                  transport, buffer, params, flags));
+  }
+
   // This is the callback called from usrsctp when data has been received, after
   // a packet has been interpreted and parsed by usrsctp and found to contain
-  // payload data. It is called by a usrsctp thread. It is assumed this function
-  // will free the memory used by 'data'.
+  // payload data. It is called by a usrsctp thread, or by the network thread
+  // if usrsctp has no threads. It is assumed this function will free the
+  // memory used by 'data'.
   static int OnSctpInboundPacket(struct socket* sock,
                                  union sctp_sockstore addr,
                                  void* data,
@@ -337,13 +414,11 @@ class SctpTransport::UsrSctpWrapper {
         // A message with a new sid, but haven't seen the EOR for the
         // previous message. Deliver the previous partial message to avoid
         // merging messages from different sid's.
-        transport->invoker_.AsyncInvoke<void>(
-            RTC_FROM_HERE, transport->network_thread_,
-            rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport,
-                      transport, transport->partial_incoming_message_,
-                      transport->partial_params_, transport->partial_flags_));
-
-        transport->partial_incoming_message_.Clear();
+        rtc::CopyOnWriteBuffer previous_message;
+        swap(previous_message, transport->partial_incoming_message_);
+        DeliverInboundPacket(transport, previous_message,
+                             transport->partial_params_,
+                             transport->partial_flags_);
       }
 
       transport->partial_incoming_message_.AppendData(
@@ -370,15 +445,12 @@ class SctpTransport::UsrSctpWrapper {
         RTC_LOG(LS_WARNING) << "Chunking SCTP message without the EOR bit set.";
       }
 
-      // The ownership of the packet transfers to |invoker_|. Using
-      // CopyOnWriteBuffer is the most convenient way to do this.
-      transport->invoker_.AsyncInvoke<void>(
-          RTC_FROM_HERE, transport->network_thread_,
-          rtc::Bind(&SctpTransport::OnInboundPacketFromSctpToTransport,
-                    transport, transport->partial_incoming_message_, params,
-                    flags));
-
-      transport->partial_incoming_message_.Clear();
+      // The ownership of the packet transfers to |invoker_|, or to the
+      // inline delivery. Using CopyOnWriteBuffer is the most convenient way to
+      // do this.
+      rtc::CopyOnWriteBuffer message;
+      swap(message, transport->partial_incoming_message_);
+      DeliverInboundPacket(transport, message, params, flags);
     }
     return 1;
   }
@@ -728,7 +800,7 @@ bool SctpTransport::OpenSctpSocket() {
     return false;
   }
 
-  UsrSctpWrapper::IncrementUsrSctpUsageCount();
+  UsrSctpWrapper::IncrementUsrSctpUsageCount(network_thread_);
 
   // If kSctpSendBufferSize isn't reflective of reality, we log an error, but we
   // still have to do something reasonable here.  Look up what the buffer's real
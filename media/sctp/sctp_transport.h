@@ -63,6 +63,11 @@ struct SctpInboundPacket;
 //  12. SctpTransport::SignalDataReceived(data)
 // [from the same thread, methods registered/connected to
 //  SctpTransport are called with the recieved data]
+//
+// With the "WebRTC-SctpRunOnNetworkThread" field trial, usrsctp has no threads
+// of its own: the sctp thread steps above run inline on the network thread,
+// without the async invokes, and the SCTP timers are run by the network
+// thread.
 class SctpTransport : public SctpTransportInternal,
                       public sigslot::has_slots<> {
  public:
@@ -13,6 +13,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,8 @@
 #include "rtc_base/logging.h"
 #include "rtc_base/message_queue.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace {
@@ -520,6 +523,24 @@ TEST_F(SctpTransportTest, SendData) {
                       << ", recv1.last_data=" << receiver1()->last_data();
 }
 
+// Same as SendData, but with usrsctp driven from the network thread instead
+// of its own timer thread.
+TEST_F(SctpTransportTest, SendDataOnNetworkThread) {
+  webrtc::test::ScopedFieldTrials field_trials(
+      "WebRTC-SctpRunOnNetworkThread/Enabled/");
+  SetupConnectedTransportsWithTwoStreams();
+
+  SendDataResult result;
+  ASSERT_TRUE(SendData(transport1(), 1, "hello?", &result));
+  EXPECT_EQ(SDR_SUCCESS, result);
+  EXPECT_TRUE_WAIT(ReceivedData(receiver2(), 1, "hello?"), kDefaultTimeout);
+
+  ASSERT_TRUE(SendData(transport2(), 2, "hi transport1", &result));
+  EXPECT_EQ(SDR_SUCCESS, result);
+  EXPECT_TRUE_WAIT(ReceivedData(receiver1(), 2, "hi transport1"),
+                   kDefaultTimeout);
+}
+
 // Sends a lot of large messages at once and verifies SDR_BLOCK is returned.
 TEST_F(SctpTransportTest, SendDataBlocked) {
   SetupConnectedTransportsWithTwoStreams();
@@ -689,4 +710,65 @@ TEST_F(SctpTransportTest, RejectsSendTooLargeMessages) {
   EXPECT_FALSE(SendData(transport1(), 1, eleven_characters, &result));
 }
 
+// Measures the throughput and the latency of small unordered messages, the
+// workload of e.g. game state channels. Run with
+// --gtest_also_run_disabled_tests to get the results logged.
+TEST_F(SctpTransportTest, DISABLED_SmallUnorderedMessagesPerf) {
+  const size_t kNumMessages = 20000;
+  const size_t kNumLatencyMessages = 1000;
+  const std::vector<char> payload(64, 'x');
+  SetupConnectedTransportsWithTwoStreams();
+  ASSERT_TRUE_WAIT(transport1()->ReadyToSendData(), kDefaultTimeout);
+  SendDataParams params;
+  params.sid = 1;
+  params.ordered = false;
+  rtc::Thread* thread = rtc::Thread::Current();
+
+  // Throughput: send as fast as the transport accepts the messages.
+  int64_t start_us = rtc::TimeMicros();
+  size_t sent = 0;
+  while (sent < kNumMessages) {
+    SendDataResult result;
+    if (transport1()->SendData(
+            params, rtc::CopyOnWriteBuffer(payload.data(), payload.size()),
+            &result)) {
+      ++sent;
+      continue;
+    }
+    ASSERT_EQ(SDR_BLOCK, result);
+    thread->ProcessMessages(1);
+  }
+  EXPECT_EQ_WAIT(kNumMessages, receiver2()->num_messages_received(),
+                 kDefaultTimeout);
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  RTC_LOG(LS_INFO) << kNumMessages << " messages of " << payload.size()
+                   << " bytes in " << elapsed_us / 1000 << " ms: "
+                   << static_cast<int64_t>(kNumMessages) *
+                          rtc::kNumMicrosecsPerSec /
+                          std::max<int64_t>(1, elapsed_us)
+                   << " messages/s";
+
+  // Latency: send one message at a time and wait until it is received.
+  receiver2()->Clear();
+  int64_t total_latency_us = 0;
+  for (size_t i = 0; i < kNumLatencyMessages; ++i) {
+    SendDataResult result;
+    int64_t send_us = rtc::TimeMicros();
+    ASSERT_TRUE(transport1()->SendData(
+        params, rtc::CopyOnWriteBuffer(payload.data(), payload.size()),
+        &result));
+    while (receiver2()->num_messages_received() <= i) {
+      ASSERT_LT(rtc::TimeMicros() - send_us,
+                kDefaultTimeout * rtc::kNumMicrosecsPerMillisec);
+      thread->ProcessMessages(0);
+    }
+    total_latency_us += rtc::TimeMicros() - send_us;
+  }
+  RTC_LOG(LS_INFO) << "Average latency of a " << payload.size()
+                   << " bytes message: "
+                   << total_latency_us /
+                          static_cast<int64_t>(kNumLatencyMessages)
+                   << " us";
+}
+
 }  // namespace cricket
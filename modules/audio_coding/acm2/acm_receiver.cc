@@ -275,6 +275,7 @@ void AcmReceiver::GetNetworkStatistics(NetworkStatistics* acm_stat) const {
       neteq_->GetOperationsAndState();
   acm_stat->packetBufferFlushes =
       neteq_operations_and_state.packet_buffer_flushes;
+  acm_stat->packetBufferBytes = neteq_operations_and_state.packet_buffer_bytes;
 }
 
 int AcmReceiver::EnableNack(size_t max_nack_list_size) {
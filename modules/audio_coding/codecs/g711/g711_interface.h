@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_CODING_CODECS_G711_G711_INTERFACE_H_
 #define MODULES_AUDIO_CODING_CODECS_G711_G711_INTERFACE_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
 // Comfort noise constants
@@ -63,6 +64,36 @@ size_t WebRtcG711_EncodeU(const int16_t* speechIn,
                           size_t len,
                           uint8_t* encoded);
 
+/****************************************************************************
+ * WebRtcG711_EncodeABatch(...)
+ * WebRtcG711_EncodeUBatch(...)
+ *
+ * These functions encode one A-law or U-law frame for each of a number of
+ * independent channels, e.g. the calls of a gateway, in one call. All frames
+ * have the same length.
+ *
+ * Input:
+ *      - speechIn           : Input speech vector of each channel
+ *      - numChannels        : Number of channels
+ *      - len                : Samples in each input speech vector
+ *
+ * Output:
+ *      - encoded            : The encoded data vector of each channel
+ *
+ * Return value              : Length (in bytes) of coded data per channel.
+ *                             Always equal to len input parameter.
+ */
+
+size_t WebRtcG711_EncodeABatch(const int16_t* const* speechIn,
+                               size_t numChannels,
+                               size_t len,
+                               uint8_t* const* encoded);
+
+size_t WebRtcG711_EncodeUBatch(const int16_t* const* speechIn,
+                               size_t numChannels,
+                               size_t len,
+                               uint8_t* const* encoded);
+
 /****************************************************************************
  * WebRtcG711_DecodeA(...)
  *
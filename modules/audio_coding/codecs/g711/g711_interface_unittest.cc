@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/g711/g711_interface.h"
+
+#include <limits>
+#include <vector>
+
+#include "modules/third_party/g711/g711.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Every int16_t value, in an order that puts both signs and all segments in
+// each 16 sample chunk.
+std::vector<int16_t> AllSamples() {
+  std::vector<int16_t> samples;
+  for (int i = 0; i <= std::numeric_limits<uint16_t>::max(); ++i)
+    samples.push_back(static_cast<int16_t>(i * 40503));
+  return samples;
+}
+
+}  // namespace
+
+TEST(G711InterfaceTest, EncodesLikeReference) {
+  const std::vector<int16_t> samples = AllSamples();
+  // An odd length, to also cover the samples left over by the SIMD loops.
+  const size_t length = samples.size() - 3;
+  std::vector<uint8_t> a_law(length);
+  std::vector<uint8_t> u_law(length);
+  EXPECT_EQ(length, WebRtcG711_EncodeA(samples.data(), length, a_law.data()));
+  EXPECT_EQ(length, WebRtcG711_EncodeU(samples.data(), length, u_law.data()));
+  for (size_t i = 0; i < length; ++i) {
+    ASSERT_EQ(linear_to_alaw(samples[i]), a_law[i]) << samples[i];
+    ASSERT_EQ(linear_to_ulaw(samples[i]), u_law[i]) << samples[i];
+  }
+}
+
+TEST(G711InterfaceTest, DecodesLikeReference) {
+  std::vector<uint8_t> codes;
+  for (int i = 0; i <= std::numeric_limits<uint8_t>::max(); ++i)
+    codes.push_back(static_cast<uint8_t>(i));
+  std::vector<int16_t> a_law(codes.size());
+  std::vector<int16_t> u_law(codes.size());
+  int16_t speech_type;
+  WebRtcG711_DecodeA(codes.data(), codes.size(), a_law.data(), &speech_type);
+  WebRtcG711_DecodeU(codes.data(), codes.size(), u_law.data(), &speech_type);
+  for (size_t i = 0; i < codes.size(); ++i) {
+    EXPECT_EQ(alaw_to_linear(codes[i]), a_law[i]);
+    EXPECT_EQ(ulaw_to_linear(codes[i]), u_law[i]);
+  }
+}
+
+TEST(G711InterfaceTest, BatchEncodesEachChannel) {
+  constexpr size_t kNumChannels = 3;
+  constexpr size_t kLength = 160;
+  const std::vector<int16_t> samples = AllSamples();
+  std::vector<const int16_t*> speech_in;
+  std::vector<std::vector<uint8_t>> encoded(kNumChannels,
+                                            std::vector<uint8_t>(kLength));
+  std::vector<uint8_t*> encoded_out;
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    speech_in.push_back(&samples[i * kLength]);
+    encoded_out.push_back(encoded[i].data());
+  }
+
+  EXPECT_EQ(kLength, WebRtcG711_EncodeUBatch(speech_in.data(), kNumChannels,
+                                             kLength, encoded_out.data()));
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    std::vector<uint8_t> expected(kLength);
+    WebRtcG711_EncodeU(speech_in[i], kLength, expected.data());
+    EXPECT_EQ(expected, encoded[i]);
+  }
+
+  EXPECT_EQ(kLength, WebRtcG711_EncodeABatch(speech_in.data(), kNumChannels,
+                                             kLength, encoded_out.data()));
+  for (size_t i = 0; i < kNumChannels; ++i) {
+    std::vector<uint8_t> expected(kLength);
+    WebRtcG711_EncodeA(speech_in[i], kLength, expected.data());
+    EXPECT_EQ(expected, encoded[i]);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <emmintrin.h>
+
+#include "modules/audio_coding/codecs/g711/g711_sse2.h"
+
+// The segment and quantization bits of both laws are the exponent and the
+// four leading mantissa bits of the magnitude converted to float, which is
+// exact for 16-bit values. Returns, for the non-negative magnitudes of
+// |magnitude|, ((top bit - 7) << 4) | (the four bits below the top bit).
+static __m128i SegmentAndQuantization(__m128i magnitude) {
+  const __m128i zero = _mm_setzero_si128();
+  // (127 + 7) << 4, for an exponent field of 127 + the top bit.
+  const __m128i offset = _mm_set1_epi16(0x860);
+  __m128i low = _mm_castps_si128(
+      _mm_cvtepi32_ps(_mm_unpacklo_epi16(magnitude, zero)));
+  __m128i high = _mm_castps_si128(
+      _mm_cvtepi32_ps(_mm_unpackhi_epi16(magnitude, zero)));
+  return _mm_sub_epi16(
+      _mm_packs_epi32(_mm_srli_epi32(low, 19), _mm_srli_epi32(high, 19)),
+      offset);
+}
+
+// linear_to_alaw() of eight samples, in the lower byte of each lane.
+static __m128i EncodeA(__m128i linear) {
+  const __m128i sign = _mm_srai_epi16(linear, 15);
+  // -linear - 1 for negative samples.
+  const __m128i magnitude = _mm_xor_si128(linear, sign);
+  const __m128i mask = _mm_or_si128(
+      _mm_set1_epi16(0x55), _mm_andnot_si128(sign, _mm_set1_epi16(0x80)));
+  // Below 256 the code is |magnitude| >> 4 in segment 0, which is never less
+  // than what SegmentAndQuantization() gives there. Clamped, it is also less
+  // than the 16 or more given from 256 up, so the maximum picks the right one.
+  const __m128i segment0 =
+      _mm_srli_epi16(_mm_min_epi16(magnitude, _mm_set1_epi16(0xFF)), 4);
+  return _mm_xor_si128(
+      _mm_max_epi16(segment0, SegmentAndQuantization(magnitude)), mask);
+}
+
+// linear_to_ulaw() of eight samples, in the lower byte of each lane.
+static __m128i EncodeU(__m128i linear) {
+  const __m128i sign = _mm_srai_epi16(linear, 15);
+  // Saturating at 0x7FFF gives segment 7 with all quantization bits set, which
+  // is what linear_to_ulaw() returns for the clipped segment 8.
+  const __m128i biased =
+      _mm_adds_epi16(_mm_xor_si128(linear, sign), _mm_set1_epi16(0x84));
+  const __m128i mask = _mm_or_si128(
+      _mm_set1_epi16(0x7F), _mm_andnot_si128(sign, _mm_set1_epi16(0x80)));
+  return _mm_xor_si128(SegmentAndQuantization(biased), mask);
+}
+
+size_t WebRtcG711_EncodeASSE2(const int16_t* speech_in,
+                              size_t len,
+                              uint8_t* encoded) {
+  size_t n;
+  for (n = 0; n + 16 <= len; n += 16) {
+    __m128i first = _mm_loadu_si128((const __m128i*)&speech_in[n]);
+    __m128i second = _mm_loadu_si128((const __m128i*)&speech_in[n + 8]);
+    _mm_storeu_si128((__m128i*)&encoded[n],
+                     _mm_packus_epi16(EncodeA(first), EncodeA(second)));
+  }
+  return n;
+}
+
+size_t WebRtcG711_EncodeUSSE2(const int16_t* speech_in,
+                              size_t len,
+                              uint8_t* encoded) {
+  size_t n;
+  for (n = 0; n + 16 <= len; n += 16) {
+    __m128i first = _mm_loadu_si128((const __m128i*)&speech_in[n]);
+    __m128i second = _mm_loadu_si128((const __m128i*)&speech_in[n + 8]);
+    _mm_storeu_si128((__m128i*)&encoded[n],
+                     _mm_packus_epi16(EncodeU(first), EncodeU(second)));
+  }
+  return n;
+}
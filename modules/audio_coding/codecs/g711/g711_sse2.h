@@ -0,0 +1,35 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_G711_G711_SSE2_H_
+#define MODULES_AUDIO_CODING_CODECS_G711_G711_SSE2_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Bit-exact SSE2 versions of the encoding loops of WebRtcG711_EncodeA() and
+// WebRtcG711_EncodeU(). They encode 16 samples at a time and return the number
+// of samples encoded, leaving the last len % 16 samples to the caller.
+size_t WebRtcG711_EncodeASSE2(const int16_t* speech_in,
+                              size_t len,
+                              uint8_t* encoded);
+size_t WebRtcG711_EncodeUSSE2(const int16_t* speech_in,
+                              size_t len,
+                              uint8_t* encoded);
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#endif  // MODULES_AUDIO_CODING_CODECS_G711_G711_SSE2_H_
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "modules/audio_coding/codecs/g711/g711_interface.h"
+#include "modules/audio_coding/codecs/tools/audio_codec_speed_test.h"
+
+using ::std::string;
+
+namespace webrtc {
+
+static const int kG711BlockDurationMs = 20;
+static const int kG711SamplingKhz = 8;
+
+// Transcoding throughput of a gateway, where the "channels" of the test are
+// independent calls. Each block holds one frame per call, which are encoded
+// with one batch call.
+class G711SpeedTest : public AudioCodecSpeedTest {
+ protected:
+  G711SpeedTest();
+  void SetUp() override;
+  float EncodeABlock(int16_t* in_data,
+                     uint8_t* bit_stream,
+                     size_t max_bytes,
+                     size_t* encoded_bytes) override;
+  float DecodeABlock(const uint8_t* bit_stream,
+                     size_t encoded_bytes,
+                     int16_t* out_data) override;
+
+  bool a_law_;
+  std::vector<const int16_t*> speech_in_;
+  std::vector<uint8_t*> encoded_;
+};
+
+G711SpeedTest::G711SpeedTest()
+    : AudioCodecSpeedTest(kG711BlockDurationMs,
+                          kG711SamplingKhz,
+                          kG711SamplingKhz),
+      a_law_(false) {}
+
+void G711SpeedTest::SetUp() {
+  AudioCodecSpeedTest::SetUp();
+  speech_in_.resize(channels_);
+  encoded_.resize(channels_);
+}
+
+float G711SpeedTest::EncodeABlock(int16_t* in_data,
+                                  uint8_t* bit_stream,
+                                  size_t max_bytes,
+                                  size_t* encoded_bytes) {
+  for (size_t i = 0; i < channels_; ++i) {
+    speech_in_[i] = &in_data[i * input_length_sample_];
+    encoded_[i] = &bit_stream[i * input_length_sample_];
+  }
+  clock_t clocks = clock();
+  size_t value =
+      a_law_ ? WebRtcG711_EncodeABatch(&speech_in_[0], channels_,
+                                       input_length_sample_, &encoded_[0])
+             : WebRtcG711_EncodeUBatch(&speech_in_[0], channels_,
+                                       input_length_sample_, &encoded_[0]);
+  clocks = clock() - clocks;
+  EXPECT_EQ(input_length_sample_, value);
+  *encoded_bytes = value * channels_;
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+float G711SpeedTest::DecodeABlock(const uint8_t* bit_stream,
+                                  size_t encoded_bytes,
+                                  int16_t* out_data) {
+  int16_t speech_type;
+  clock_t clocks = clock();
+  size_t value =
+      a_law_ ? WebRtcG711_DecodeA(bit_stream, encoded_bytes, out_data,
+                                  &speech_type)
+             : WebRtcG711_DecodeU(bit_stream, encoded_bytes, out_data,
+                                  &speech_type);
+  clocks = clock() - clocks;
+  EXPECT_EQ(output_length_sample_ * channels_, value);
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+/* Test audio length in second. */
+constexpr size_t kDurationSec = 400;
+
+TEST_P(G711SpeedTest, ALaw) {
+  a_law_ = true;
+  EncodeDecode(kDurationSec);
+}
+
+TEST_P(G711SpeedTest, ULaw) {
+  EncodeDecode(kDurationSec);
+}
+
+// List all test cases: (calls, bit rate, filename, extension).
+const coding_param param_set[] = {
+    std::make_tuple(100,
+                    64000,
+                    string("audio_coding/speech_mono_16kHz"),
+                    string("pcm"),
+                    false),
+    std::make_tuple(1000,
+                    64000,
+                    string("audio_coding/speech_mono_16kHz"),
+                    string("pcm"),
+                    false)};
+
+INSTANTIATE_TEST_SUITE_P(AllTest,
+                         G711SpeedTest,
+                         ::testing::ValuesIn(param_set));
+
+}  // namespace webrtc
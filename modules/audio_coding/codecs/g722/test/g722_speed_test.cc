@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "modules/audio_coding/codecs/g722/g722_interface.h"
+#include "modules/audio_coding/codecs/tools/audio_codec_speed_test.h"
+
+using ::std::string;
+
+namespace webrtc {
+
+static const int kG722BlockDurationMs = 20;
+static const int kG722SamplingKhz = 16;
+
+// Transcoding throughput of a gateway, where the "channels" of the test are
+// independent calls, each with its own encoder and decoder.
+class G722SpeedTest : public AudioCodecSpeedTest {
+ protected:
+  G722SpeedTest();
+  void SetUp() override;
+  void TearDown() override;
+  float EncodeABlock(int16_t* in_data,
+                     uint8_t* bit_stream,
+                     size_t max_bytes,
+                     size_t* encoded_bytes) override;
+  float DecodeABlock(const uint8_t* bit_stream,
+                     size_t encoded_bytes,
+                     int16_t* out_data) override;
+
+  std::vector<G722EncInst*> encoders_;
+  std::vector<G722DecInst*> decoders_;
+};
+
+G722SpeedTest::G722SpeedTest()
+    : AudioCodecSpeedTest(kG722BlockDurationMs,
+                          kG722SamplingKhz,
+                          kG722SamplingKhz) {}
+
+void G722SpeedTest::SetUp() {
+  AudioCodecSpeedTest::SetUp();
+  encoders_.resize(channels_);
+  decoders_.resize(channels_);
+  for (size_t i = 0; i < channels_; ++i) {
+    ASSERT_EQ(0, WebRtcG722_CreateEncoder(&encoders_[i]));
+    ASSERT_EQ(0, WebRtcG722_EncoderInit(encoders_[i]));
+    ASSERT_EQ(0, WebRtcG722_CreateDecoder(&decoders_[i]));
+    WebRtcG722_DecoderInit(decoders_[i]);
+  }
+}
+
+void G722SpeedTest::TearDown() {
+  AudioCodecSpeedTest::TearDown();
+  for (size_t i = 0; i < channels_; ++i) {
+    EXPECT_EQ(0, WebRtcG722_FreeEncoder(encoders_[i]));
+    EXPECT_EQ(0, WebRtcG722_FreeDecoder(decoders_[i]));
+  }
+}
+
+float G722SpeedTest::EncodeABlock(int16_t* in_data,
+                                  uint8_t* bit_stream,
+                                  size_t max_bytes,
+                                  size_t* encoded_bytes) {
+  const size_t bytes_per_call = input_length_sample_ / 2;
+  clock_t clocks = clock();
+  for (size_t i = 0; i < channels_; ++i) {
+    size_t value = WebRtcG722_Encode(
+        encoders_[i], &in_data[i * input_length_sample_], input_length_sample_,
+        &bit_stream[i * bytes_per_call]);
+    EXPECT_EQ(bytes_per_call, value);
+  }
+  clocks = clock() - clocks;
+  *encoded_bytes = bytes_per_call * channels_;
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+float G722SpeedTest::DecodeABlock(const uint8_t* bit_stream,
+                                  size_t encoded_bytes,
+                                  int16_t* out_data) {
+  const size_t bytes_per_call = encoded_bytes / channels_;
+  int16_t speech_type;
+  clock_t clocks = clock();
+  for (size_t i = 0; i < channels_; ++i) {
+    size_t value = WebRtcG722_Decode(
+        decoders_[i], &bit_stream[i * bytes_per_call], bytes_per_call,
+        &out_data[i * output_length_sample_], &speech_type);
+    EXPECT_EQ(output_length_sample_, value);
+  }
+  clocks = clock() - clocks;
+  return 1000.0 * clocks / CLOCKS_PER_SEC;
+}
+
+/* Test audio length in second. */
+constexpr size_t kDurationSec = 400;
+
+TEST_P(G722SpeedTest, G722) {
+  EncodeDecode(kDurationSec);
+}
+
+// List all test cases: (calls, bit rate, filename, extension).
+const coding_param param_set[] = {
+    std::make_tuple(1,
+                    64000,
+                    string("audio_coding/speech_mono_16kHz"),
+                    string("pcm"),
+                    false),
+    std::make_tuple(100,
+                    64000,
+                    string("audio_coding/speech_mono_16kHz"),
+                    string("pcm"),
+                    false)};
+
+INSTANTIATE_TEST_SUITE_P(AllTest,
+                         G722SpeedTest,
+                         ::testing::ValuesIn(param_set));
+
+}  // namespace webrtc
@@ -46,13 +46,17 @@ class OpusFrame : public AudioDecoder::EncodedAudioFrame {
         is_primary_payload_(is_primary_payload) {}
 
   size_t Duration() const override {
-    int ret;
-    if (is_primary_payload_) {
-      ret = decoder_->PacketDuration(payload_.data(), payload_.size());
-    } else {
-      ret = decoder_->PacketDurationRedundant(payload_.data(), payload_.size());
+    if (!duration_) {
+      int ret;
+      if (is_primary_payload_) {
+        ret = decoder_->PacketDuration(payload_.data(), payload_.size());
+      } else {
+        ret = decoder_->PacketDurationRedundant(payload_.data(),
+                                                payload_.size());
+      }
+      duration_ = (ret < 0) ? 0 : static_cast<size_t>(ret);
     }
-    return (ret < 0) ? 0 : static_cast<size_t>(ret);
+    return *duration_;
   }
 
   bool IsDtxPacket() const override { return payload_.size() <= 2; }
@@ -81,6 +85,10 @@ class OpusFrame : public AudioDecoder::EncodedAudioFrame {
   AudioDecoder* const decoder_;
   const rtc::Buffer payload_;
   const bool is_primary_payload_;
+  // The duration is parsed from the payload on first use. NetEq asks for it
+  // every time it measures the packet buffer, which adds up when many packets
+  // are queued.
+  mutable absl::optional<size_t> duration_;
 };
 
 }  // namespace webrtc
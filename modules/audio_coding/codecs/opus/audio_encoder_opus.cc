@@ -255,6 +255,30 @@ GetNewPacketLossRateOptimizer() {
   return nullptr;
 }
 
+std::unique_ptr<AudioEncoderOpusImpl::ComplexityLoadAdapter>
+GetComplexityLoadAdapter() {
+  constexpr char kLoadAdaptiveComplexityName[] =
+      "WebRTC-Audio-OpusLoadAdaptiveComplexity";
+  if (!webrtc::field_trial::IsEnabled(kLoadAdaptiveComplexityName))
+    return nullptr;
+  const std::string field_trial_string =
+      webrtc::field_trial::FindFullName(kLoadAdaptiveComplexityName);
+  int high_load;
+  int low_load;
+  int min_complexity;
+  if (sscanf(field_trial_string.c_str(), "Enabled-%d-%d-%d", &high_load,
+             &low_load, &min_complexity) == 3 &&
+      low_load > 0 && low_load < high_load && high_load <= 100 &&
+      min_complexity >= 0 && min_complexity <= 10) {
+    return std::make_unique<AudioEncoderOpusImpl::ComplexityLoadAdapter>(
+        ToFraction(high_load), ToFraction(low_load), min_complexity);
+  }
+  RTC_LOG(LS_WARNING) << "Invalid parameters for "
+                      << kLoadAdaptiveComplexityName
+                      << ", using default values.";
+  return std::make_unique<AudioEncoderOpusImpl::ComplexityLoadAdapter>();
+}
+
 }  // namespace
 
 AudioEncoderOpusImpl::NewPacketLossRateOptimizer::NewPacketLossRateOptimizer(
@@ -272,6 +296,46 @@ float AudioEncoderOpusImpl::NewPacketLossRateOptimizer::OptimizePacketLossRate(
                   max_packet_loss_rate_);
 }
 
+AudioEncoderOpusImpl::ComplexityLoadAdapter::ComplexityLoadAdapter(
+    float high_load,
+    float low_load,
+    int min_complexity)
+    : high_load_(high_load),
+      low_load_(low_load),
+      min_complexity_(min_complexity),
+      load_(0.9f) {
+  RTC_DCHECK_LT(low_load_, high_load_);
+}
+
+void AudioEncoderOpusImpl::ComplexityLoadAdapter::OnPacketEncoded(
+    int64_t encode_time_us,
+    int packet_duration_ms) {
+  RTC_DCHECK_GT(packet_duration_ms, 0);
+  // Each change is held for about a second of 20 ms packets, which also lets
+  // the smoothed load settle at the new complexity.
+  constexpr int kMinPacketsBetweenChanges = 50;
+  load_.Apply(1.0f, static_cast<float>(encode_time_us) /
+                        (packet_duration_ms * rtc::kNumMicrosecsPerMillisec));
+  if (++packets_since_change_ < kMinPacketsBetweenChanges)
+    return;
+  if (load_.filtered() > high_load_ &&
+      complexity_reduction_ < max_complexity_reduction_) {
+    ++complexity_reduction_;
+    packets_since_change_ = 0;
+  } else if (load_.filtered() < low_load_ && complexity_reduction_ > 0) {
+    --complexity_reduction_;
+    packets_since_change_ = 0;
+  }
+}
+
+int AudioEncoderOpusImpl::ComplexityLoadAdapter::GetComplexity(
+    int complexity) {
+  max_complexity_reduction_ = std::max(complexity - min_complexity_, 0);
+  if (complexity <= min_complexity_)
+    return complexity;
+  return std::max(complexity - complexity_reduction_, min_complexity_);
+}
+
 void AudioEncoderOpusImpl::AppendSupportedEncoders(
     std::vector<AudioCodecSpec>* specs) {
   const SdpAudioFormat fmt = {"opus",
@@ -434,6 +498,7 @@ AudioEncoderOpusImpl::AudioEncoderOpusImpl(
       min_packet_loss_rate_(GetMinPacketLossRate()),
       new_packet_loss_optimizer_(GetNewPacketLossRateOptimizer()),
       inst_(nullptr),
+      complexity_load_adapter_(GetComplexityLoadAdapter()),
       packet_loss_fraction_smoother_(new PacketLossFractionSmoother()),
       audio_network_adaptor_creator_(audio_network_adaptor_creator),
       bitrate_smoother_(std::move(bitrate_smoother)),
@@ -663,6 +728,8 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
                Num10msFramesPerPacket() * SamplesPer10msFrame());
 
   const size_t max_encoded_bytes = SufficientOutputBufferSize();
+  const int64_t encode_start_us =
+      complexity_load_adapter_ ? rtc::TimeMicros() : 0;
   EncodedInfo info;
   info.encoded_bytes = encoded->AppendData(
       max_encoded_bytes, [&](rtc::ArrayView<uint8_t> encoded) {
@@ -677,6 +744,12 @@ AudioEncoder::EncodedInfo AudioEncoderOpusImpl::EncodeImpl(
       });
   input_buffer_.clear();
 
+  if (complexity_load_adapter_) {
+    complexity_load_adapter_->OnPacketEncoded(
+        rtc::TimeMicros() - encode_start_us, config_.frame_size_ms);
+    UpdateComplexity();
+  }
+
   bool dtx_frame = (info.encoded_bytes <= 2);
 
   // Will use new packet size for next encoding.
@@ -756,7 +829,11 @@ bool AudioEncoderOpusImpl::RecreateEncoderInstance(
   // Use the default complexity if the start bitrate is within the hysteresis
   // window.
   complexity_ = GetNewComplexity(config).value_or(config.complexity);
-  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+  applied_complexity_ =
+      complexity_load_adapter_
+          ? complexity_load_adapter_->GetComplexity(complexity_)
+          : complexity_;
+  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, applied_complexity_));
   bitrate_changed_ = true;
   if (config.dtx_enabled) {
     RTC_CHECK_EQ(0, WebRtcOpus_EnableDtx(inst_));
@@ -823,7 +900,18 @@ void AudioEncoderOpusImpl::SetTargetBitrate(int bits_per_second) {
   const auto new_complexity = GetNewComplexity(config_);
   if (new_complexity && complexity_ != *new_complexity) {
     complexity_ = *new_complexity;
-    RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+    UpdateComplexity();
+  }
+}
+
+void AudioEncoderOpusImpl::UpdateComplexity() {
+  const int complexity =
+      complexity_load_adapter_
+          ? complexity_load_adapter_->GetComplexity(complexity_)
+          : complexity_;
+  if (complexity != applied_complexity_) {
+    applied_complexity_ = complexity;
+    RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, applied_complexity_));
   }
 }
 
@@ -24,6 +24,7 @@
 #include "modules/audio_coding/audio_network_adaptor/include/audio_network_adaptor.h"
 #include "modules/audio_coding/codecs/opus/opus_interface.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/numerics/exp_filter.h"
 
 namespace webrtc {
 
@@ -51,6 +52,43 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
     RTC_DISALLOW_COPY_AND_ASSIGN(NewPacketLossRateOptimizer);
   };
 
+  // Lowers the complexity, one step at a time, while encoding takes more than
+  // |high_load| of the duration of the audio it encodes, e.g. on a loaded
+  // server encoding many streams, and raises it again while the load is below
+  // |low_load|. The load is smoothed over packets, and the complexity is held
+  // for a while after each change so that its effect can be measured.
+  class ComplexityLoadAdapter {
+   public:
+    ComplexityLoadAdapter(float high_load = 0.1f,
+                          float low_load = 0.04f,
+                          int min_complexity = 1);
+
+    // Updates the load with the time spent encoding a packet of
+    // |packet_duration_ms|.
+    void OnPacketEncoded(int64_t encode_time_us, int packet_duration_ms);
+
+    // Returns the complexity to use instead of |complexity|, which is the
+    // one the encoder would use without load adaptation. The complexity is
+    // not lowered further than |min_complexity| below that, so that raising
+    // it again takes effect on the first step.
+    int GetComplexity(int complexity);
+
+    // Getters for testing.
+    float high_load() const { return high_load_; }
+    float low_load() const { return low_load_; }
+    int min_complexity() const { return min_complexity_; }
+
+   private:
+    const float high_load_;
+    const float low_load_;
+    const int min_complexity_;
+    rtc::ExpFilter load_;
+    int packets_since_change_ = 0;
+    int complexity_reduction_ = 0;
+    int max_complexity_reduction_ = 0;
+    RTC_DISALLOW_COPY_AND_ASSIGN(ComplexityLoadAdapter);
+  };
+
   // Returns empty if the current bitrate falls within the hysteresis window,
   // defined by complexity_threshold_bps +/- complexity_threshold_window_bps.
   // Otherwise, returns the current complexity depending on whether the
@@ -124,6 +162,10 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   NewPacketLossRateOptimizer* new_packet_loss_optimizer() const {
     return new_packet_loss_optimizer_.get();
   }
+  ComplexityLoadAdapter* complexity_load_adapter() const {
+    return complexity_load_adapter_.get();
+  }
+  int complexity() const { return applied_complexity_; }
   AudioEncoderOpusConfig::ApplicationMode application() const {
     return config_.application;
   }
@@ -171,6 +213,9 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
 
   void MaybeUpdateUplinkBandwidth();
 
+  // Applies |complexity_|, lowered by |complexity_load_adapter_| if set.
+  void UpdateComplexity();
+
   AudioEncoderOpusConfig config_;
   const int payload_type_;
   const bool send_side_bwe_with_overhead_;
@@ -186,6 +231,8 @@ class AudioEncoderOpusImpl final : public AudioEncoder {
   size_t num_channels_to_encode_;
   int next_frame_length_ms_;
   int complexity_;
+  int applied_complexity_;
+  const std::unique_ptr<ComplexityLoadAdapter> complexity_load_adapter_;
   std::unique_ptr<PacketLossFractionSmoother> packet_loss_fraction_smoother_;
   const AudioNetworkAdaptorCreator audio_network_adaptor_creator_;
   std::unique_ptr<AudioNetworkAdaptor> audio_network_adaptor_;
@@ -551,6 +551,77 @@ TEST_P(AudioEncoderOpusTest, NewPacketLossRateOptimizer) {
   }
 }
 
+TEST_P(AudioEncoderOpusTest, ComplexityLoadAdapterFieldTrial) {
+  {
+    auto states = CreateCodec(sample_rate_hz_, 1);
+    EXPECT_EQ(nullptr, states->encoder->complexity_load_adapter());
+  }
+  {
+    test::ScopedFieldTrials override_field_trials(
+        "WebRTC-Audio-OpusLoadAdaptiveComplexity/Enabled/");
+    auto states = CreateCodec(sample_rate_hz_, 1);
+    auto adapter = states->encoder->complexity_load_adapter();
+    ASSERT_NE(nullptr, adapter);
+    EXPECT_FLOAT_EQ(0.10, adapter->high_load());
+    EXPECT_FLOAT_EQ(0.04, adapter->low_load());
+    EXPECT_EQ(1, adapter->min_complexity());
+  }
+  {
+    test::ScopedFieldTrials override_field_trials(
+        "WebRTC-Audio-OpusLoadAdaptiveComplexity/Enabled-20-5-3/");
+    auto states = CreateCodec(sample_rate_hz_, 1);
+    auto adapter = states->encoder->complexity_load_adapter();
+    ASSERT_NE(nullptr, adapter);
+    EXPECT_FLOAT_EQ(0.20, adapter->high_load());
+    EXPECT_FLOAT_EQ(0.05, adapter->low_load());
+    EXPECT_EQ(3, adapter->min_complexity());
+  }
+}
+
+TEST(AudioEncoderOpusTest, ComplexityLoadAdapterLowersAndRestoresComplexity) {
+  constexpr int kPacketDurationMs = 20;
+  constexpr int kComplexity = 9;
+  AudioEncoderOpusImpl::ComplexityLoadAdapter adapter(0.1f, 0.04f, 5);
+  EXPECT_EQ(kComplexity, adapter.GetComplexity(kComplexity));
+
+  // 4 ms per 20 ms packet is a load of 0.2, so the complexity is lowered once
+  // per hold period down to the minimum.
+  int previous_complexity = kComplexity;
+  for (int i = 0; i < 1000; ++i) {
+    adapter.OnPacketEncoded(4000, kPacketDurationMs);
+    const int complexity = adapter.GetComplexity(kComplexity);
+    EXPECT_GE(complexity, previous_complexity - 1);
+    EXPECT_LE(complexity, previous_complexity);
+    previous_complexity = complexity;
+  }
+  EXPECT_EQ(5, adapter.GetComplexity(kComplexity));
+
+  // A load between the thresholds keeps the complexity.
+  for (int i = 0; i < 1000; ++i)
+    adapter.OnPacketEncoded(1400, kPacketDurationMs);
+  EXPECT_EQ(5, adapter.GetComplexity(kComplexity));
+
+  // With headroom, the complexity is restored.
+  for (int i = 0; i < 1000; ++i)
+    adapter.OnPacketEncoded(200, kPacketDurationMs);
+  EXPECT_EQ(kComplexity, adapter.GetComplexity(kComplexity));
+  // A complexity below the minimum is left alone.
+  EXPECT_EQ(2, adapter.GetComplexity(2));
+}
+
+TEST(AudioEncoderOpusTest, ComplexityLoadAdapterHoldsAfterChange) {
+  AudioEncoderOpusImpl::ComplexityLoadAdapter adapter(0.1f, 0.04f, 0);
+  EXPECT_EQ(10, adapter.GetComplexity(10));
+  for (int i = 0; i < 49; ++i)
+    adapter.OnPacketEncoded(10000, 20);
+  EXPECT_EQ(10, adapter.GetComplexity(10));
+  adapter.OnPacketEncoded(10000, 20);
+  EXPECT_EQ(9, adapter.GetComplexity(10));
+  for (int i = 0; i < 49; ++i)
+    adapter.OnPacketEncoded(10000, 20);
+  EXPECT_EQ(9, adapter.GetComplexity(10));
+}
+
 // Verifies that the complexity adaptation in the config works as intended.
 TEST(AudioEncoderOpusTest, ConfigComplexityAdaptation) {
   AudioEncoderOpusConfig config;
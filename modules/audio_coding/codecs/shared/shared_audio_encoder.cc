@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/shared/shared_audio_encoder.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+
+namespace webrtc {
+
+namespace {
+
+// Number of blocks kept for subscribers that encode later than the others,
+// 500 ms.
+constexpr size_t kNumBlocks = 50;
+
+}  // namespace
+
+class SharedAudioEncoder::Subscriber final : public AudioEncoder {
+ public:
+  Subscriber(rtc::scoped_refptr<SharedAudioEncoder> shared, int payload_type)
+      : shared_(std::move(shared)),
+        payload_type_(payload_type),
+        block_index_(shared_->next_block_index()) {}
+
+  int SampleRateHz() const override { return shared_->sample_rate_hz_; }
+  size_t NumChannels() const override { return shared_->num_channels_; }
+  int RtpTimestampRateHz() const override {
+    return shared_->rtp_timestamp_rate_hz_;
+  }
+  size_t Num10MsFramesInNextPacket() const override {
+    return shared_->Num10MsFramesInNextPacket();
+  }
+  size_t Max10MsFramesInAPacket() const override {
+    return shared_->max_10ms_frames_in_a_packet_;
+  }
+  int GetTargetBitrate() const override { return shared_->GetTargetBitrate(); }
+  // The shared encoder is not reset by one of its streams.
+  void Reset() override {}
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    EncodedInfo info =
+        shared_->Encode(&block_index_, rtp_timestamp, audio, encoded);
+    if (info.encoded_bytes > 0)
+      info.payload_type = payload_type_;
+    return info;
+  }
+
+ private:
+  const rtc::scoped_refptr<SharedAudioEncoder> shared_;
+  const int payload_type_;
+  int64_t block_index_;
+};
+
+SharedAudioEncoder::Block::Block() = default;
+SharedAudioEncoder::Block::~Block() = default;
+
+// static
+rtc::scoped_refptr<SharedAudioEncoder> SharedAudioEncoder::Create(
+    std::unique_ptr<AudioEncoder> encoder) {
+  return new rtc::RefCountedObject<SharedAudioEncoder>(std::move(encoder));
+}
+
+SharedAudioEncoder::SharedAudioEncoder(std::unique_ptr<AudioEncoder> encoder)
+    : sample_rate_hz_(encoder->SampleRateHz()),
+      num_channels_(encoder->NumChannels()),
+      rtp_timestamp_rate_hz_(encoder->RtpTimestampRateHz()),
+      max_10ms_frames_in_a_packet_(encoder->Max10MsFramesInAPacket()),
+      encoder_(std::move(encoder)),
+      blocks_(kNumBlocks) {}
+
+SharedAudioEncoder::~SharedAudioEncoder() = default;
+
+std::unique_ptr<AudioEncoder> SharedAudioEncoder::CreateSubscriber(
+    int payload_type) {
+  return std::make_unique<Subscriber>(this, payload_type);
+}
+
+void SharedAudioEncoder::ConfigureEncoder(
+    rtc::FunctionView<void(AudioEncoder*)> configure) {
+  rtc::CritScope lock(&lock_);
+  configure(encoder_.get());
+}
+
+int64_t SharedAudioEncoder::num_encoded_blocks() const {
+  return next_block_index();
+}
+
+AudioEncoder::EncodedInfo SharedAudioEncoder::Encode(
+    int64_t* block_index,
+    uint32_t rtp_timestamp,
+    rtc::ArrayView<const int16_t> audio,
+    rtc::Buffer* encoded) {
+  rtc::CritScope lock(&lock_);
+  const int64_t oldest_block_index =
+      std::max<int64_t>(next_block_index_ - kNumBlocks, 0);
+  if (*block_index < oldest_block_index) {
+    RTC_LOG(LS_WARNING) << "Subscriber is " << next_block_index_ - *block_index
+                        << " blocks behind, skipping ahead.";
+    *block_index = next_block_index_;
+  }
+  RTC_DCHECK_LE(*block_index, next_block_index_);
+
+  Block& block = blocks_[*block_index % kNumBlocks];
+  if (*block_index == next_block_index_) {
+    block.rtp_timestamp = next_rtp_timestamp_;
+    block.encoded.Clear();
+    block.info = encoder_->Encode(next_rtp_timestamp_, audio, &block.encoded);
+    next_rtp_timestamp_ += static_cast<uint32_t>(rtp_timestamp_rate_hz_ / 100);
+    ++next_block_index_;
+  }
+  ++*block_index;
+
+  AudioEncoder::EncodedInfo info = block.info;
+  if (info.encoded_bytes > 0) {
+    encoded->AppendData(block.encoded);
+    // The subscriber's timestamps are offset from the shared encoder's by the
+    // same amount for every block.
+    const uint32_t offset = rtp_timestamp - block.rtp_timestamp;
+    info.encoded_timestamp += offset;
+    for (AudioEncoder::EncodedInfoLeaf& leaf : info.redundant)
+      leaf.encoded_timestamp += offset;
+  }
+  return info;
+}
+
+int64_t SharedAudioEncoder::next_block_index() const {
+  rtc::CritScope lock(&lock_);
+  return next_block_index_;
+}
+
+size_t SharedAudioEncoder::Num10MsFramesInNextPacket() const {
+  rtc::CritScope lock(&lock_);
+  return encoder_->Num10MsFramesInNextPacket();
+}
+
+int SharedAudioEncoder::GetTargetBitrate() const {
+  rtc::CritScope lock(&lock_);
+  return encoder_->GetTargetBitrate();
+}
+
+}  // namespace webrtc
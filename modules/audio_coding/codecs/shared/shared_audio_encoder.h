@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODER_H_
+#define MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio_codecs/audio_encoder.h"
+#include "api/function_view.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Lets several send streams that send the same audio, e.g. an MCU sending
+// one mix to many listeners, share a single encoder. Each stream is given its
+// own AudioEncoder from CreateSubscriber(). The first subscriber to encode a
+// 10 ms block runs the shared encoder on it, and the others get a copy of the
+// result with their own RTP timestamps and payload type, so the encoding cost
+// does not grow with the number of streams. Only packetization and
+// encryption remain per stream.
+//
+// All subscribers must be given the same audio. The encoder settings are
+// shared too: the per-stream network adaptation calls on a subscriber (target
+// bitrate, packet loss, FEC, DTX, ...) are ignored, and the shared encoder is
+// configured with ConfigureEncoder() instead. Subscribers may encode on
+// different threads.
+class SharedAudioEncoder : public rtc::RefCountInterface {
+ public:
+  static rtc::scoped_refptr<SharedAudioEncoder> Create(
+      std::unique_ptr<AudioEncoder> encoder);
+
+  // Creates an encoder for one send stream, which starts at the next block
+  // encoded and sends with |payload_type|.
+  std::unique_ptr<AudioEncoder> CreateSubscriber(int payload_type);
+
+  // Runs |configure| on the shared encoder, e.g. to set the target bitrate for
+  // all the streams.
+  void ConfigureEncoder(rtc::FunctionView<void(AudioEncoder*)> configure);
+
+  // Number of 10 ms blocks the shared encoder has encoded.
+  int64_t num_encoded_blocks() const;
+
+ protected:
+  explicit SharedAudioEncoder(std::unique_ptr<AudioEncoder> encoder);
+  ~SharedAudioEncoder() override;
+
+ private:
+  class Subscriber;
+
+  struct Block {
+    Block();
+    ~Block();
+
+    uint32_t rtp_timestamp = 0;
+    AudioEncoder::EncodedInfo info;
+    rtc::Buffer encoded;
+  };
+
+  // Appends the encoding of block |*block_index| to |encoded|, encoding it
+  // with |audio| first if no subscriber has yet, and advances |*block_index|.
+  // A subscriber that has fallen further behind than the blocks kept skips
+  // ahead to the next block to encode.
+  AudioEncoder::EncodedInfo Encode(int64_t* block_index,
+                                   uint32_t rtp_timestamp,
+                                   rtc::ArrayView<const int16_t> audio,
+                                   rtc::Buffer* encoded);
+
+  int64_t next_block_index() const;
+  size_t Num10MsFramesInNextPacket() const;
+  int GetTargetBitrate() const;
+
+  const int sample_rate_hz_;
+  const size_t num_channels_;
+  const int rtp_timestamp_rate_hz_;
+  const size_t max_10ms_frames_in_a_packet_;
+
+  rtc::CriticalSection lock_;
+  const std::unique_ptr<AudioEncoder> encoder_ RTC_GUARDED_BY(lock_);
+  int64_t next_block_index_ RTC_GUARDED_BY(lock_) = 0;
+  uint32_t next_rtp_timestamp_ RTC_GUARDED_BY(lock_) = 0;
+  // Ring buffer of the most recent blocks, indexed by block index modulo its
+  // size, so that their buffers are reused.
+  std::vector<Block> blocks_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_CODECS_SHARED_SHARED_AUDIO_ENCODER_H_
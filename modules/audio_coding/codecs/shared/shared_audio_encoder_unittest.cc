@@ -0,0 +1,167 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/codecs/shared/shared_audio_encoder.h"
+
+#include <memory>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+constexpr int kPayloadType = 111;
+
+// Sends packets of two 10 ms blocks, each with the first sample of every
+// block, and counts the blocks encoded.
+class FakeEncoder : public AudioEncoder {
+ public:
+  explicit FakeEncoder(int* num_encoded_blocks)
+      : num_encoded_blocks_(num_encoded_blocks) {}
+
+  int SampleRateHz() const override { return kSampleRateHz; }
+  size_t NumChannels() const override { return 1; }
+  size_t Num10MsFramesInNextPacket() const override { return 2; }
+  size_t Max10MsFramesInAPacket() const override { return 2; }
+  int GetTargetBitrate() const override { return 32000; }
+  void Reset() override {}
+
+ protected:
+  EncodedInfo EncodeImpl(uint32_t rtp_timestamp,
+                         rtc::ArrayView<const int16_t> audio,
+                         rtc::Buffer* encoded) override {
+    ++*num_encoded_blocks_;
+    if (pending_.empty())
+      first_timestamp_ = rtp_timestamp;
+    pending_.push_back(static_cast<uint8_t>(audio[0]));
+    EncodedInfo info;
+    if (pending_.size() < 2)
+      return info;
+    encoded->AppendData(pending_.data(), pending_.size());
+    info.encoded_bytes = pending_.size();
+    info.encoded_timestamp = first_timestamp_;
+    info.payload_type = 0;
+    pending_.clear();
+    return info;
+  }
+
+ private:
+  int* const num_encoded_blocks_;
+  std::vector<uint8_t> pending_;
+  uint32_t first_timestamp_ = 0;
+};
+
+class Stream {
+ public:
+  Stream(SharedAudioEncoder* shared, uint32_t first_timestamp)
+      : encoder_(shared->CreateSubscriber(kPayloadType)),
+        timestamp_(first_timestamp) {}
+
+  AudioEncoder::EncodedInfo Encode(int16_t value) {
+    std::vector<int16_t> audio(kSamplesPer10Ms, value);
+    encoded_.Clear();
+    AudioEncoder::EncodedInfo info =
+        encoder_->Encode(timestamp_, audio, &encoded_);
+    timestamp_ += kSamplesPer10Ms;
+    return info;
+  }
+
+  const rtc::Buffer& encoded() const { return encoded_; }
+
+ private:
+  const std::unique_ptr<AudioEncoder> encoder_;
+  uint32_t timestamp_;
+  rtc::Buffer encoded_;
+};
+
+}  // namespace
+
+TEST(SharedAudioEncoderTest, EncodesEachBlockOnceForAllSubscribers) {
+  int num_encoded_blocks = 0;
+  rtc::scoped_refptr<SharedAudioEncoder> shared = SharedAudioEncoder::Create(
+      std::make_unique<FakeEncoder>(&num_encoded_blocks));
+  Stream first(shared, 1000);
+  Stream second(shared, 50000);
+
+  for (int16_t block = 0; block < 10; block += 2) {
+    EXPECT_EQ(0u, first.Encode(block).encoded_bytes);
+    EXPECT_EQ(0u, second.Encode(block).encoded_bytes);
+    AudioEncoder::EncodedInfo first_info = first.Encode(block + 1);
+    AudioEncoder::EncodedInfo second_info = second.Encode(block + 1);
+
+    ASSERT_EQ(2u, first_info.encoded_bytes);
+    ASSERT_EQ(2u, second_info.encoded_bytes);
+    EXPECT_EQ(kPayloadType, first_info.payload_type);
+    EXPECT_EQ(1000u + block * kSamplesPer10Ms, first_info.encoded_timestamp);
+    EXPECT_EQ(50000u + block * kSamplesPer10Ms, second_info.encoded_timestamp);
+    EXPECT_EQ(block, first.encoded()[0]);
+    EXPECT_EQ(block + 1, first.encoded()[1]);
+    EXPECT_EQ(first.encoded(), second.encoded());
+  }
+  EXPECT_EQ(10, num_encoded_blocks);
+  EXPECT_EQ(10, shared->num_encoded_blocks());
+}
+
+TEST(SharedAudioEncoderTest, LateSubscriberStartsAtNextBlock) {
+  int num_encoded_blocks = 0;
+  rtc::scoped_refptr<SharedAudioEncoder> shared = SharedAudioEncoder::Create(
+      std::make_unique<FakeEncoder>(&num_encoded_blocks));
+  Stream first(shared, 0);
+  first.Encode(0);
+  first.Encode(1);
+  first.Encode(2);
+
+  // Joins in the middle of a packet, which it gets when it completes.
+  Stream late(shared, 7000);
+  first.Encode(3);
+  AudioEncoder::EncodedInfo info = late.Encode(3);
+  ASSERT_EQ(2u, info.encoded_bytes);
+  EXPECT_EQ(7000u - kSamplesPer10Ms, info.encoded_timestamp);
+  EXPECT_EQ(2, late.encoded()[0]);
+  EXPECT_EQ(4, num_encoded_blocks);
+}
+
+TEST(SharedAudioEncoderTest, SubscriberFarBehindSkipsAhead) {
+  int num_encoded_blocks = 0;
+  rtc::scoped_refptr<SharedAudioEncoder> shared = SharedAudioEncoder::Create(
+      std::make_unique<FakeEncoder>(&num_encoded_blocks));
+  Stream first(shared, 0);
+  Stream stalled(shared, 0);
+  for (int16_t block = 0; block < 100; ++block)
+    first.Encode(block);
+
+  // The stalled subscriber encodes the next block instead of one that is no
+  // longer kept.
+  stalled.Encode(100);
+  EXPECT_EQ(101, num_encoded_blocks);
+  first.Encode(101);
+  EXPECT_EQ(101, num_encoded_blocks);
+}
+
+TEST(SharedAudioEncoderTest, ConfiguresSharedEncoder) {
+  int num_encoded_blocks = 0;
+  rtc::scoped_refptr<SharedAudioEncoder> shared = SharedAudioEncoder::Create(
+      std::make_unique<FakeEncoder>(&num_encoded_blocks));
+  std::unique_ptr<AudioEncoder> subscriber =
+      shared->CreateSubscriber(kPayloadType);
+  EXPECT_EQ(kSampleRateHz, subscriber->SampleRateHz());
+  EXPECT_EQ(32000, subscriber->GetTargetBitrate());
+  int target_bitrate = 0;
+  shared->ConfigureEncoder([&](AudioEncoder* encoder) {
+    target_bitrate = encoder->GetTargetBitrate();
+  });
+  EXPECT_EQ(32000, target_bitrate);
+}
+
+}  // namespace webrtc
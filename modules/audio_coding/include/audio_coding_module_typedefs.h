@@ -139,6 +139,8 @@ struct NetworkStatistics {
   int32_t interruptionCount;
   // total duration of audio interruptions
   int32_t totalInterruptionDurationMs;
+  // approximate memory held by the packet buffer (bytes)
+  uint64_t packetBufferBytes;
 };
 
 }  // namespace webrtc
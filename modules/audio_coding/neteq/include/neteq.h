@@ -112,6 +112,11 @@ struct NetEqOperationsAndState {
   uint64_t current_buffer_size_ms = 0;
   // The current frame size in ms.
   uint64_t current_frame_size_ms = 0;
+  // Approximate memory held by the packets in the packet buffer, in bytes.
+  uint64_t packet_buffer_bytes = 0;
+  // Approximate memory held by the decoded, sync and algorithm audio buffers,
+  // in bytes.
+  uint64_t audio_buffer_bytes = 0;
   // Flag to indicate that the next packet is available.
   bool next_packet_available = false;
 };
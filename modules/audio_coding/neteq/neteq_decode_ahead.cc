@@ -0,0 +1,141 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_decode_ahead.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+struct NetEqDecodeAhead::Instance {
+  explicit Instance(NetEq* neteq) : neteq(neteq) {}
+
+  NetEq* const neteq;
+  // Written by a worker while the instance is decoded.
+  std::unique_ptr<AudioFrame> decoded = std::make_unique<AudioFrame>();
+  bool decoded_muted = false;
+  int decoded_result = NetEq::kOK;
+  bool has_decoded = false;
+  // Handed out by GetAudio().
+  std::unique_ptr<AudioFrame> output = std::make_unique<AudioFrame>();
+};
+
+NetEqDecodeAhead::NetEqDecodeAhead(int num_threads)
+    : round_done_(/*manual_reset=*/true, /*initially_signaled=*/true) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.push_back(std::make_unique<rtc::PlatformThread>(
+        &NetEqDecodeAhead::RunWorker, this, "NetEqDecodeAhead",
+        rtc::kRealtimePriority));
+    threads_.back()->Start();
+  }
+}
+
+NetEqDecodeAhead::~NetEqDecodeAhead() {
+  round_done_.Wait(rtc::Event::kForever);
+  {
+    rtc::CritScope lock(&crit_);
+    quit_ = true;
+  }
+  wake_up_.Set();
+  for (auto& thread : threads_)
+    thread->Stop();
+}
+
+void NetEqDecodeAhead::AddNetEq(NetEq* neteq) {
+  RTC_DCHECK(neteq);
+  rtc::CritScope lock(&crit_);
+  instances_.push_back(std::make_unique<Instance>(neteq));
+}
+
+void NetEqDecodeAhead::RemoveNetEq(NetEq* neteq) {
+  round_done_.Wait(rtc::Event::kForever);
+  rtc::CritScope lock(&crit_);
+  auto it = std::find_if(instances_.begin(), instances_.end(),
+                         [neteq](const std::unique_ptr<Instance>& instance) {
+                           return instance->neteq == neteq;
+                         });
+  RTC_DCHECK(it != instances_.end());
+  if (it != instances_.end())
+    instances_.erase(it);
+}
+
+std::vector<NetEqDecodeAhead::Frame> NetEqDecodeAhead::GetAudio() {
+  round_done_.Wait(rtc::Event::kForever);
+  std::vector<Frame> frames;
+  rtc::CritScope lock(&crit_);
+  frames.reserve(instances_.size());
+  for (auto& instance : instances_) {
+    if (!instance->has_decoded)
+      continue;
+    std::swap(instance->decoded, instance->output);
+    instance->has_decoded = false;
+    Frame frame;
+    frame.neteq = instance->neteq;
+    frame.audio_frame = instance->output.get();
+    frame.muted = instance->decoded_muted;
+    frame.result = instance->decoded_result;
+    frames.push_back(frame);
+  }
+
+  round_size_ = instances_.size();
+  next_instance_ = 0;
+  num_pending_ = round_size_;
+  if (num_pending_ > 0) {
+    round_done_.Reset();
+    wake_up_.Set();
+  }
+  return frames;
+}
+
+void NetEqDecodeAhead::RunWorker(void* obj) {
+  static_cast<NetEqDecodeAhead*>(obj)->DecodeFrames();
+}
+
+void NetEqDecodeAhead::DecodeFrames() {
+  while (true) {
+    Instance* instance = nullptr;
+    {
+      rtc::CritScope lock(&crit_);
+      if (quit_) {
+        // Pass the wake up on to the next thread.
+        wake_up_.Set();
+        return;
+      }
+      if (next_instance_ < round_size_) {
+        instance = instances_[next_instance_++].get();
+        // Only one thread is woken up per event, so wake up another one if
+        // there is more to do.
+        if (next_instance_ < round_size_)
+          wake_up_.Set();
+      }
+    }
+
+    if (!instance) {
+      wake_up_.Wait(rtc::Event::kForever);
+      continue;
+    }
+
+    // The instance is only touched by this thread until the round is done.
+    instance->decoded_result =
+        instance->neteq->GetAudio(instance->decoded.get(),
+                                  &instance->decoded_muted);
+    instance->has_decoded = true;
+
+    rtc::CritScope lock(&crit_);
+    if (--num_pending_ == 0)
+      round_done_.Set();
+  }
+}
+
+}  // namespace webrtc
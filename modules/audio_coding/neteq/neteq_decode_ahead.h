@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_NETEQ_DECODE_AHEAD_H_
+#define MODULES_AUDIO_CODING_NETEQ_NETEQ_DECODE_AHEAD_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "modules/audio_coding/neteq/include/neteq.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Pulls audio from many NetEq instances one 10 ms frame ahead of time, on a
+// set of worker threads. Meant for servers that mix many streams: GetAudio()
+// hands out the frames that were decoded during the last 10 ms, and starts
+// decoding the next frame of every instance in the background. The mixing
+// thread then only copies PCM, and decoding, time stretching and expansion no
+// longer count against its real-time deadline. The cost is one frame of extra
+// delay, since every frame is decoded one GetAudio() call before it is used.
+//
+// NetEq is thread safe, so packets can be inserted while a frame is decoded.
+// All methods of this class must be called on the same thread.
+class NetEqDecodeAhead {
+ public:
+  struct Frame {
+    NetEq* neteq = nullptr;
+    // Valid until the next call to GetAudio().
+    const AudioFrame* audio_frame = nullptr;
+    bool muted = false;
+    // The return value of NetEq::GetAudio().
+    int result = NetEq::kOK;
+  };
+
+  explicit NetEqDecodeAhead(int num_threads);
+  NetEqDecodeAhead(const NetEqDecodeAhead&) = delete;
+  NetEqDecodeAhead& operator=(const NetEqDecodeAhead&) = delete;
+  ~NetEqDecodeAhead();
+
+  // |neteq| must stay alive until it is removed. Its first frame is decoded
+  // after the next call to GetAudio(), and returned by the call after that.
+  void AddNetEq(NetEq* neteq);
+  // Waits for the frame of |neteq| that is being decoded, if any.
+  void RemoveNetEq(NetEq* neteq);
+
+  // Waits until the frames started by the last call are decoded, and returns
+  // them. Then starts decoding the next frame of every instance.
+  std::vector<Frame> GetAudio();
+
+ private:
+  struct Instance;
+
+  static void RunWorker(void* obj);
+  void DecodeFrames();
+
+  // Signaled when a round of decoding starts.
+  rtc::Event wake_up_;
+  // Manual reset; signaled while no round of decoding is running.
+  rtc::Event round_done_;
+
+  rtc::CriticalSection crit_;
+  bool quit_ RTC_GUARDED_BY(crit_) = false;
+  std::vector<std::unique_ptr<Instance>> instances_ RTC_GUARDED_BY(crit_);
+  // The instances that are decoded in the running round are the first
+  // |round_size_| ones, of which the first |next_instance_| have been picked
+  // up by a worker.
+  size_t round_size_ RTC_GUARDED_BY(crit_) = 0;
+  size_t next_instance_ RTC_GUARDED_BY(crit_) = 0;
+  size_t num_pending_ RTC_GUARDED_BY(crit_) = 0;
+
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_NETEQ_DECODE_AHEAD_H_
@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_decode_ahead.h"
+
+#include <math.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kPayloadType = 95;
+constexpr int kSampleRateHz = 16000;
+constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+constexpr int kNumPackets = 20;
+
+class NetEqDecodeAheadTest : public ::testing::Test {
+ protected:
+  NetEqDecodeAheadTest() : clock_(0) {}
+
+  std::unique_ptr<NetEq> CreateNetEq() {
+    NetEq::Config config;
+    config.sample_rate_hz = kSampleRateHz;
+    std::unique_ptr<NetEq> neteq(
+        NetEq::Create(config, &clock_, CreateBuiltinAudioDecoderFactory()));
+    EXPECT_TRUE(neteq->RegisterPayloadType(
+        kPayloadType, SdpAudioFormat("l16", kSampleRateHz, 1)));
+    return neteq;
+  }
+
+  // Inserts 10 ms packets of a sine wave with the given frequency.
+  void InsertPackets(NetEq* neteq, float frequency_hz) {
+    RTPHeader header;
+    header.payloadType = kPayloadType;
+    header.ssrc = 0x1234;
+    int16_t samples[kSamplesPer10Ms];
+    uint8_t payload[2 * kSamplesPer10Ms];
+    for (int i = 0; i < kNumPackets; ++i) {
+      for (size_t j = 0; j < kSamplesPer10Ms; ++j) {
+        samples[j] = static_cast<int16_t>(
+            10000 * sinf(2 * M_PI * frequency_hz * (i * kSamplesPer10Ms + j) /
+                         kSampleRateHz));
+      }
+      WebRtcPcm16b_Encode(samples, kSamplesPer10Ms, payload);
+      header.sequenceNumber = i;
+      header.timestamp = i * kSamplesPer10Ms;
+      ASSERT_EQ(NetEq::kOK,
+                neteq->InsertPacket(header, payload, header.timestamp));
+    }
+  }
+
+  SimulatedClock clock_;
+};
+
+TEST_F(NetEqDecodeAheadTest, ReturnsTheSameFramesOneCallLater) {
+  constexpr int kNumInstances = 4;
+  std::vector<std::unique_ptr<NetEq>> neteqs;
+  std::vector<std::unique_ptr<NetEq>> references;
+  NetEqDecodeAhead decode_ahead(/*num_threads=*/2);
+  for (int i = 0; i < kNumInstances; ++i) {
+    neteqs.push_back(CreateNetEq());
+    references.push_back(CreateNetEq());
+    InsertPackets(neteqs.back().get(), 200.f * (i + 1));
+    InsertPackets(references.back().get(), 200.f * (i + 1));
+    decode_ahead.AddNetEq(neteqs.back().get());
+  }
+
+  // Nothing is decoded before the first call.
+  EXPECT_TRUE(decode_ahead.GetAudio().empty());
+
+  AudioFrame reference_frame;
+  for (int n = 0; n < 2 * kNumPackets; ++n) {
+    std::vector<NetEqDecodeAhead::Frame> frames = decode_ahead.GetAudio();
+    ASSERT_EQ(static_cast<size_t>(kNumInstances), frames.size());
+    for (int i = 0; i < kNumInstances; ++i) {
+      EXPECT_EQ(neteqs[i].get(), frames[i].neteq);
+      bool muted;
+      ASSERT_EQ(NetEq::kOK, references[i]->GetAudio(&reference_frame, &muted));
+      EXPECT_EQ(NetEq::kOK, frames[i].result);
+      EXPECT_EQ(muted, frames[i].muted);
+      const AudioFrame& frame = *frames[i].audio_frame;
+      ASSERT_EQ(reference_frame.samples_per_channel_,
+                frame.samples_per_channel_);
+      EXPECT_EQ(reference_frame.speech_type_, frame.speech_type_);
+      for (size_t j = 0; j < frame.samples_per_channel_; ++j) {
+        ASSERT_EQ(reference_frame.data()[j], frame.data()[j]);
+      }
+    }
+  }
+}
+
+TEST_F(NetEqDecodeAheadTest, AddAndRemoveInstances) {
+  std::unique_ptr<NetEq> first = CreateNetEq();
+  std::unique_ptr<NetEq> second = CreateNetEq();
+  NetEqDecodeAhead decode_ahead(/*num_threads=*/1);
+  decode_ahead.AddNetEq(first.get());
+  decode_ahead.GetAudio();
+
+  // The second instance only gets a frame a call after the first one.
+  decode_ahead.AddNetEq(second.get());
+  std::vector<NetEqDecodeAhead::Frame> frames = decode_ahead.GetAudio();
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(first.get(), frames[0].neteq);
+  EXPECT_EQ(kSamplesPer10Ms, frames[0].audio_frame->samples_per_channel_);
+  EXPECT_EQ(2u, decode_ahead.GetAudio().size());
+
+  // Removing waits for the frame being decoded.
+  decode_ahead.RemoveNetEq(first.get());
+  frames = decode_ahead.GetAudio();
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(second.get(), frames[0].neteq);
+
+  decode_ahead.RemoveNetEq(second.get());
+  EXPECT_TRUE(decode_ahead.GetAudio().empty());
+}
+
+}  // namespace
+}  // namespace webrtc
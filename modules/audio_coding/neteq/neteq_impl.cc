@@ -108,8 +108,7 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       preemptive_expand_factory_(std::move(deps.preemptive_expand_factory)),
       stats_(std::move(deps.stats)),
       last_mode_(kModeNormal),
-      decoded_buffer_length_(kMaxFrameSize),
-      decoded_buffer_(new int16_t[decoded_buffer_length_]),
+      decoded_buffer_length_(0),
       playout_timestamp_(0),
       new_codec_(false),
       timestamp_(0),
@@ -358,6 +357,12 @@ NetEqOperationsAndState NetEqImpl::GetOperationsAndState() const {
        sync_buffer_->FutureLength()) *
       1000 / fs_hz_;
   result.current_frame_size_ms = decoder_frame_length_ * 1000 / fs_hz_;
+  result.packet_buffer_bytes = packet_buffer_->NumBytesInBuffer();
+  result.audio_buffer_bytes =
+      sizeof(int16_t) *
+      (decoded_buffer_length_ +
+       sync_buffer_->Size() * sync_buffer_->Channels() +
+       algorithm_buffer_->Size() * algorithm_buffer_->Channels());
   result.next_packet_available = packet_buffer_->PeekNextPacket() &&
                                  packet_buffer_->PeekNextPacket()->timestamp ==
                                      sync_buffer_->end_timestamp();
@@ -613,6 +618,8 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
       const auto payload_type = packet.payload_type;
       const Packet::Priority original_priority = packet.priority;
       const auto& packet_info = packet.packet_info;
+      const size_t payload_size = packet.payload.size();
+      size_t num_results = 1;
       auto packet_from_result = [&](AudioDecoder::ParseResult& result) {
         Packet new_packet;
         new_packet.sequence_number = sequence_number;
@@ -622,6 +629,8 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
         new_packet.priority.red_level = original_priority.red_level;
         new_packet.packet_info = packet_info;
         new_packet.frame = std::move(result.frame);
+        // The frames of one payload are assumed to be of similar size.
+        new_packet.frame_size_bytes = payload_size / num_results;
         return new_packet;
       };
 
@@ -631,6 +640,7 @@ int NetEqImpl::InsertPacketInternal(const RTPHeader& rtp_header,
       if (results.empty()) {
         packet_list.pop_front();
       } else {
+        num_results = results.size();
         bool first = true;
         for (auto& result : results) {
           RTC_DCHECK(result.frame);
@@ -1420,7 +1430,8 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list,
     // The number of channels in the |sync_buffer_| should be the same as the
     // number decoder channels.
     assert(sync_buffer_->Channels() == decoder->Channels());
-    assert(decoded_buffer_length_ >= kMaxFrameSize * decoder->Channels());
+    assert(decoded_buffer_length_ >=
+           DecodedBufferLengthPerChannel(fs_hz_) * decoder->Channels());
     assert(operation == kNormal || operation == kAccelerate ||
            operation == kFastAccelerate || operation == kMerge ||
            operation == kPreemptiveExpand);
@@ -1993,6 +2004,12 @@ int NetEqImpl::ExtractPackets(size_t required_samples,
   return rtc::dchecked_cast<int>(extracted_samples);
 }
 
+// static
+size_t NetEqImpl::DecodedBufferLengthPerChannel(int fs_hz) {
+  const size_t length = static_cast<size_t>(240 * fs_hz / 1000);
+  return length < kMaxFrameSize ? length : kMaxFrameSize;
+}
+
 void NetEqImpl::UpdatePlcComponents(int fs_hz, size_t channels) {
   // Delete objects and create new ones.
   expand_.reset(expand_factory_->Create(background_noise_.get(),
@@ -2052,10 +2069,11 @@ void NetEqImpl::SetSampleRateAndChannels(int fs_hz, size_t channels) {
   comfort_noise_.reset(
       new ComfortNoise(fs_hz, decoder_database_.get(), sync_buffer_.get()));
 
-  // Verify that |decoded_buffer_| is long enough.
-  if (decoded_buffer_length_ < kMaxFrameSize * channels) {
-    // Reallocate to larger size.
-    decoded_buffer_length_ = kMaxFrameSize * channels;
+  // Size |decoded_buffer_| for the new sample rate and number of channels.
+  const size_t decoded_buffer_length =
+      DecodedBufferLengthPerChannel(fs_hz) * channels;
+  if (decoded_buffer_length_ != decoded_buffer_length) {
+    decoded_buffer_length_ = decoded_buffer_length;
     decoded_buffer_.reset(new int16_t[decoded_buffer_length_]);
   }
 
@@ -209,6 +209,10 @@ class NetEqImpl : public webrtc::NetEq {
  protected:
   static const int kOutputSizeMs = 10;
   static const size_t kMaxFrameSize = 5760;  // 120 ms @ 48 kHz.
+  // Returns the per-channel length of |decoded_buffer_| at |fs_hz|. This is
+  // 240 ms of audio, but at most kMaxFrameSize, so that a narrowband instance
+  // doesn't hold a buffer sized for 48 kHz.
+  static size_t DecodedBufferLengthPerChannel(int fs_hz);
   // TODO(hlundin): Provide a better value for kSyncBufferSize.
   // Current value is kMaxFrameSize + 60 ms * 48 kHz, which is enough for
   // calculating correlations of current frame against history.
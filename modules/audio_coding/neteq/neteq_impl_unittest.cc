@@ -428,6 +428,36 @@ TEST_F(NetEqImplTest, InsertPacketsUntilBufferIsFull) {
   EXPECT_EQ(rtp_header.sequenceNumber, test_packet->sequence_number);
 }
 
+// Verifies that the audio buffers of a narrowband instance are sized for its
+// sample rate, and grow when a wideband decoder is used.
+TEST_F(NetEqImplTest, AudioBuffersAreSizedBySampleRate) {
+  UseNoMocks();
+  CreateInstance();
+  const uint64_t narrowband_bytes =
+      neteq_->GetOperationsAndState().audio_buffer_bytes;
+  EXPECT_GT(narrowband_bytes, 0u);
+
+  const int kSampleRateHz = 48000;
+  const int kPayloadLengthSamples = kSampleRateHz / 100;
+  const uint8_t kPayloadType = 17;
+  uint8_t payload[2 * kPayloadLengthSamples] = {0};
+  RTPHeader rtp_header;
+  rtp_header.payloadType = kPayloadType;
+  rtp_header.sequenceNumber = 0x1234;
+  rtp_header.timestamp = 0x12345678;
+  rtp_header.ssrc = 0x87654321;
+  EXPECT_TRUE(neteq_->RegisterPayloadType(
+      kPayloadType, SdpAudioFormat("l16", kSampleRateHz, 1)));
+  EXPECT_EQ(NetEq::kOK, neteq_->InsertPacket(rtp_header, payload, 0));
+
+  AudioFrame output;
+  bool muted;
+  EXPECT_EQ(NetEq::kOK, neteq_->GetAudio(&output, &muted));
+  ASSERT_EQ(kSampleRateHz, output.sample_rate_hz_);
+  EXPECT_GT(neteq_->GetOperationsAndState().audio_buffer_bytes,
+            4 * narrowband_bytes);
+}
+
 TEST_F(NetEqImplTest, TestDtmfPacketAVT) {
   TestDtmfPacket(8000);
 }
@@ -77,6 +77,9 @@ struct Packet {
   RtpPacketInfo packet_info;
   std::unique_ptr<TickTimer::Stopwatch> waiting_time;
   std::unique_ptr<AudioDecoder::EncodedAudioFrame> frame;
+  // Approximate number of encoded bytes held by |frame|, for memory
+  // accounting only.
+  size_t frame_size_bytes = 0;
 
   Packet();
   Packet(Packet&& b);
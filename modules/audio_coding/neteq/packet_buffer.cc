@@ -8,14 +8,13 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// of packet slots. The ring is kept sorted at all times so that the next packet
+// to decode is at the beginning of the ring.
 
 #include "modules/audio_coding/neteq/packet_buffer.h"
 
 #include <algorithm>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -30,17 +29,9 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when |packet| goes before |new_packet|.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet& new_packet)
-      : new_packet_(new_packet) {}
-  bool operator()(const Packet& packet) { return (new_packet_ >= packet); }
-
- private:
-  const Packet& new_packet_;
-};
+
+// The initial number of packet slots.
+constexpr size_t kMinNumberOfSlots = 16;
 
 // Returns true if both payload types are known to the decoder database, and
 // have the same sample rate.
@@ -74,11 +65,15 @@ PacketBuffer::~PacketBuffer() {
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  buffer_.clear();
+  for (size_t i = 0; i < num_packets_; ++i) {
+    PacketAt(i) = Packet();
+  }
+  first_ = 0;
+  num_packets_ = 0;
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return num_packets_ == 0;
 }
 
 int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
@@ -94,7 +89,7 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
 
   packet.waiting_time = tick_timer_->GetNewStopwatch();
 
-  if (buffer_.size() >= max_number_of_packets_) {
+  if (num_packets_ >= max_number_of_packets_) {
     // Buffer is full. Flush it.
     Flush();
     stats->FlushedPacketBuffer();
@@ -102,29 +97,30 @@ int PacketBuffer::InsertPacket(Packet&& packet, StatisticsCalculator* stats) {
     return_val = kFlushed;
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(), NewTimestampIsLarger(packet));
+  // Find the position in the buffer where the new packet should be inserted.
+  // The buffer is searched from the back, since the most likely case is that
+  // the new packet should be near the end of the buffer.
+  size_t index = num_packets_;
+  while (index > 0 && !(packet >= PacketAt(index - 1))) {
+    --index;
+  }
 
-  // The new packet is to be inserted to the right of |rit|. If it has the same
-  // timestamp as |rit|, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // The new packet is to be inserted after the packet at |index| - 1. If it has
+  // the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet.
+  if (index > 0 && packet.timestamp == PacketAt(index - 1).timestamp) {
     LogPacketDiscarded(packet.priority.codec_level, stats);
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of |it|. If it has the same
-  // timestamp as |it|, which has a lower priority, replace |it| with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    LogPacketDiscarded(it->priority.codec_level, stats);
-    it = buffer_.erase(it);
+  // If the new packet has the same timestamp as the packet at |index|, which
+  // has a lower priority, replace that packet with the new one.
+  if (index < num_packets_ && packet.timestamp == PacketAt(index).timestamp) {
+    LogPacketDiscarded(PacketAt(index).priority.codec_level, stats);
+    PacketAt(index) = std::move(packet);
+    return return_val;
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+  InsertAt(index, std::move(packet));
 
   return return_val;
 }
@@ -182,7 +178,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front().timestamp;
+  *next_timestamp = PacketAt(0).timestamp;
   return kOK;
 }
 
@@ -194,11 +190,11 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t i = 0; i < num_packets_; ++i) {
+    const uint32_t packet_timestamp = PacketAt(i).timestamp;
+    if (packet_timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = packet_timestamp;
       return kOK;
     }
   }
@@ -206,7 +202,7 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
 }
 
 const Packet* PacketBuffer::PeekNextPacket() const {
-  return buffer_.empty() ? nullptr : &buffer_.front();
+  return Empty() ? nullptr : &PacketAt(0);
 }
 
 absl::optional<Packet> PacketBuffer::GetNextPacket() {
@@ -215,10 +211,10 @@ absl::optional<Packet> PacketBuffer::GetNextPacket() {
     return absl::nullopt;
   }
 
-  absl::optional<Packet> packet(std::move(buffer_.front()));
+  absl::optional<Packet> packet(std::move(PacketAt(0)));
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
-  buffer_.pop_front();
+  PopFront();
 
   return packet;
 }
@@ -228,17 +224,17 @@ int PacketBuffer::DiscardNextPacket(StatisticsCalculator* stats) {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  const Packet& packet = buffer_.front();
+  const Packet& packet = PacketAt(0);
   RTC_DCHECK(!packet.empty());
   LogPacketDiscarded(packet.priority.codec_level, stats);
-  buffer_.pop_front();
+  PopFront();
   return kOK;
 }
 
 void PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                      uint32_t horizon_samples,
                                      StatisticsCalculator* stats) {
-  buffer_.remove_if([timestamp_limit, horizon_samples, stats](const Packet& p) {
+  RemoveIf([timestamp_limit, horizon_samples, stats](const Packet& p) {
     if (timestamp_limit == p.timestamp ||
         !IsObsoleteTimestamp(p.timestamp, timestamp_limit, horizon_samples)) {
       return false;
@@ -255,7 +251,7 @@ void PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit,
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
                                                  StatisticsCalculator* stats) {
-  buffer_.remove_if([payload_type, stats](const Packet& p) {
+  RemoveIf([payload_type, stats](const Packet& p) {
     if (p.payload_type != payload_type) {
       return false;
     }
@@ -265,13 +261,14 @@ void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type,
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return num_packets_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < num_packets_; ++i) {
+    const Packet& packet = PacketAt(i);
     if (packet.frame) {
       // TODO(hlundin): Verify that it's fine to count all packets and remove
       // this check.
@@ -288,19 +285,30 @@ size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   return num_samples;
 }
 
+size_t PacketBuffer::NumBytesInBuffer() const {
+  size_t num_bytes = 0;
+  for (size_t i = 0; i < num_packets_; ++i) {
+    const Packet& packet = PacketAt(i);
+    num_bytes +=
+        sizeof(Packet) + packet.payload.capacity() + packet.frame_size_bytes;
+  }
+  return num_bytes;
+}
+
 size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
                                     size_t sample_rate,
                                     bool count_dtx_waiting_time) const {
-  if (buffer_.size() == 0) {
+  if (Empty()) {
     return 0;
   }
 
-  size_t span = buffer_.back().timestamp - buffer_.front().timestamp;
-  if (buffer_.back().frame && buffer_.back().frame->Duration() > 0) {
-    size_t duration = buffer_.back().frame->Duration();
-    if (count_dtx_waiting_time && buffer_.back().frame->IsDtxPacket()) {
+  const Packet& last_packet = PacketAt(num_packets_ - 1);
+  size_t span = last_packet.timestamp - PacketAt(0).timestamp;
+  if (last_packet.frame && last_packet.frame->Duration() > 0) {
+    size_t duration = last_packet.frame->Duration();
+    if (count_dtx_waiting_time && last_packet.frame->IsDtxPacket()) {
       size_t waiting_time_samples = rtc::dchecked_cast<size_t>(
-          buffer_.back().waiting_time->ElapsedMs() * (sample_rate / 1000));
+          last_packet.waiting_time->ElapsedMs() * (sample_rate / 1000));
       duration = std::max(duration, waiting_time_samples);
     }
     span += duration;
@@ -313,7 +321,8 @@ size_t PacketBuffer::GetSpanSamples(size_t last_decoded_length,
 bool PacketBuffer::ContainsDtxOrCngPacket(
     const DecoderDatabase* decoder_database) const {
   RTC_DCHECK(decoder_database);
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < num_packets_; ++i) {
+    const Packet& packet = PacketAt(i);
     if ((packet.frame && packet.frame->IsDtxPacket()) ||
         decoder_database->IsComfortNoise(packet.payload_type)) {
       return true;
@@ -322,4 +331,60 @@ bool PacketBuffer::ContainsDtxOrCngPacket(
   return false;
 }
 
+void PacketBuffer::InsertAt(size_t index, Packet&& packet) {
+  RTC_DCHECK_LE(index, num_packets_);
+  if (num_packets_ == slots_.size()) {
+    // Grow the ring, moving the packets to the start of the new slots.
+    const size_t num_slots = std::max(
+        num_packets_ + 1,
+        std::min(std::max(kMinNumberOfSlots, 2 * slots_.size()),
+                 max_number_of_packets_));
+    std::vector<Packet> slots(num_slots);
+    for (size_t i = 0; i < num_packets_; ++i) {
+      slots[i] = std::move(PacketAt(i));
+    }
+    slots_.swap(slots);
+    first_ = 0;
+  }
+  if (index >= num_packets_ / 2) {
+    // Move the packets from |index| onwards one slot towards the back.
+    for (size_t i = num_packets_; i > index; --i) {
+      PacketAt(i) = std::move(PacketAt(i - 1));
+    }
+  } else {
+    // Move the packets before |index| one slot towards the front.
+    first_ = (first_ == 0 ? slots_.size() : first_) - 1;
+    for (size_t i = 0; i < index; ++i) {
+      PacketAt(i) = std::move(PacketAt(i + 1));
+    }
+  }
+  PacketAt(index) = std::move(packet);
+  ++num_packets_;
+}
+
+void PacketBuffer::PopFront() {
+  RTC_DCHECK_GT(num_packets_, 0);
+  PacketAt(0) = Packet();
+  first_ = SlotIndex(1);
+  --num_packets_;
+}
+
+template <typename Predicate>
+void PacketBuffer::RemoveIf(Predicate predicate) {
+  size_t num_kept = 0;
+  for (size_t i = 0; i < num_packets_; ++i) {
+    if (predicate(PacketAt(i))) {
+      continue;
+    }
+    if (num_kept != i) {
+      PacketAt(num_kept) = std::move(PacketAt(i));
+    }
+    ++num_kept;
+  }
+  for (size_t i = num_kept; i < num_packets_; ++i) {
+    PacketAt(i) = Packet();
+  }
+  num_packets_ = num_kept;
+}
+
 }  // namespace webrtc
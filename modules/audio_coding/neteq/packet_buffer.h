@@ -11,6 +11,10 @@
 #ifndef MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <stddef.h>
+
+#include <vector>
+
 #include "absl/types/optional.h"
 #include "modules/audio_coding/neteq/decoder_database.h"
 #include "modules/audio_coding/neteq/packet.h"
@@ -121,6 +125,10 @@ class PacketBuffer {
   // duplicate and redundant packets.
   virtual size_t NumSamplesInBuffer(size_t last_decoded_length) const;
 
+  // Returns the approximate number of bytes held by the packets in the buffer,
+  // including the packet objects themselves.
+  virtual size_t NumBytesInBuffer() const;
+
   // Returns the total duration in samples that the packets in the buffer spans
   // across.
   virtual size_t GetSpanSamples(size_t last_decoded_length,
@@ -146,8 +154,31 @@ class PacketBuffer {
   }
 
  private:
+  // The packets are kept sorted in a ring of slots, |slots_|, starting at slot
+  // |first_|. The ring grows on demand up to |max_number_of_packets_| slots
+  // and never shrinks, so after warm-up inserting and extracting packets moves
+  // them between slots instead of allocating list nodes.
+  Packet& PacketAt(size_t index) { return slots_[SlotIndex(index)]; }
+  const Packet& PacketAt(size_t index) const {
+    return slots_[SlotIndex(index)];
+  }
+  size_t SlotIndex(size_t index) const {
+    const size_t slot = first_ + index;
+    return slot < slots_.size() ? slot : slot - slots_.size();
+  }
+  // Inserts |packet| before the packet at |index|, shifting the shorter side
+  // of the ring.
+  void InsertAt(size_t index, Packet&& packet);
+  void PopFront();
+  // Removes the packets for which |predicate| returns true, keeping the order
+  // of the others.
+  template <typename Predicate>
+  void RemoveIf(Predicate predicate);
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  std::vector<Packet> slots_;
+  size_t first_ = 0;
+  size_t num_packets_ = 0;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
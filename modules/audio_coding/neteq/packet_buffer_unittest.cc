@@ -18,7 +18,10 @@
 #include "modules/audio_coding/neteq/mock/mock_decoder_database.h"
 #include "modules/audio_coding/neteq/mock/mock_statistics_calculator.h"
 #include "modules/audio_coding/neteq/packet.h"
+#include "modules/audio_coding/neteq/statistics_calculator.h"
 #include "modules/audio_coding/neteq/tick_timer.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -155,6 +158,32 @@ TEST(PacketBuffer, FlushBuffer) {
   EXPECT_TRUE(buffer.Empty());
 }
 
+// Test that the buffered bytes follow the inserted and extracted packets.
+TEST(PacketBuffer, NumBytesInBuffer) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(10, &tick_timer);  // 10 packets.
+  PacketGenerator gen(0, 0, 0, 10);
+  const int payload_len = 100;
+  StrictMock<MockStatisticsCalculator> mock_stats;
+  EXPECT_EQ(0u, buffer.NumBytesInBuffer());
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(
+        PacketBuffer::kOK,
+        buffer.InsertPacket(gen.NextPacket(payload_len, nullptr), &mock_stats));
+  }
+  EXPECT_GE(buffer.NumBytesInBuffer(), 3 * (sizeof(Packet) + payload_len));
+
+  Packet parsed = gen.NextPacket(0, std::make_unique<MockEncodedAudioFrame>());
+  parsed.frame_size_bytes = payload_len;
+  EXPECT_EQ(PacketBuffer::kOK,
+            buffer.InsertPacket(std::move(parsed), &mock_stats));
+  EXPECT_GE(buffer.NumBytesInBuffer(), 4 * (sizeof(Packet) + payload_len));
+
+  buffer.Flush();
+  EXPECT_EQ(0u, buffer.NumBytesInBuffer());
+}
+
 // Test to fill the buffer over the limits, and verify that it flushes.
 TEST(PacketBuffer, OverfillBuffer) {
   TickTimer tick_timer;
@@ -800,4 +829,49 @@ TEST(PacketBuffer, IsObsoleteTimestamp) {
   TestIsObsoleteTimestamp(0x7FFFFFFF);  // 2^31 - 1.
 }
 
+// Returns the average time in nanoseconds to insert one packet into a buffer
+// holding |depth| packets and extract one. Every |reorder_interval|-th pair of
+// packets arrives swapped.
+int64_t MeasureInsertExtractNs(size_t depth,
+                               int reorder_interval,
+                               int num_packets) {
+  TickTimer tick_timer;
+  StatisticsCalculator stats;
+  PacketBuffer buffer(depth + 2, &tick_timer);
+  PacketGenerator gen(0, 0, 0, 960);
+  constexpr int kPayloadSizeBytes = 160;
+  for (size_t i = 0; i < depth; ++i) {
+    buffer.InsertPacket(gen.NextPacket(kPayloadSizeBytes, nullptr), &stats);
+  }
+
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_packets; i += 2) {
+    Packet first = gen.NextPacket(kPayloadSizeBytes, nullptr);
+    Packet second = gen.NextPacket(kPayloadSizeBytes, nullptr);
+    if (i % (2 * reorder_interval) == 0)
+      std::swap(first, second);
+    buffer.InsertPacket(std::move(first), &stats);
+    buffer.GetNextPacket();
+    buffer.InsertPacket(std::move(second), &stats);
+    buffer.GetNextPacket();
+  }
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  EXPECT_EQ(depth, buffer.NumPacketsInBuffer());
+  return elapsed_ns / num_packets;
+}
+
+TEST(PacketBuffer, DISABLED_InsertExtractPerf) {
+  constexpr int kNumPackets = 2000000;
+  // Three 20 ms packets are a typical depth; 250 packets, i.e. 5 s, are a
+  // congested MCU-side NetEq.
+  for (size_t depth : {3, 50, 250}) {
+    RTC_LOG(LS_INFO) << "Depth " << depth << ", in order: "
+                     << MeasureInsertExtractNs(depth, kNumPackets, kNumPackets)
+                     << " ns per packet.";
+    RTC_LOG(LS_INFO) << "Depth " << depth << ", every 10th pair reordered: "
+                     << MeasureInsertExtractNs(depth, 10, kNumPackets)
+                     << " ns per packet.";
+  }
+}
+
 }  // namespace webrtc
@@ -108,6 +108,10 @@ void AudioDeviceBuffer::StartPlayout() {
   // Clear members that are only touched on the main (creating) thread.
   play_start_time_ = now_time;
   playing_ = true;
+  // Allocate room for 10ms of audio up front, so that the native audio thread
+  // does not have to allocate in RequestPlayoutData(). Safe since the owning
+  // ADM has not yet started the native audio playout.
+  play_buffer_.EnsureCapacity(play_channels_ * play_sample_rate_ / 100);
 }
 
 void AudioDeviceBuffer::StartRecording() {
@@ -126,10 +130,13 @@ void AudioDeviceBuffer::StartRecording() {
   // Clear members that will be touched on the main (creating) thread.
   rec_start_time_ = rtc::TimeMillis();
   recording_ = true;
-  // And finally a member which can be modified on the native audio thread.
+  // And finally members which can be modified on the native audio thread.
   // It is safe to do so since we know by design that the owning ADM has not
   // yet started the native audio recording.
   only_silence_recorded_ = true;
+  // Allocate room for 10ms of audio up front, so that the native audio thread
+  // does not have to allocate in SetRecordedBuffer().
+  rec_buffer_.EnsureCapacity(rec_channels_ * rec_sample_rate_ / 100);
 }
 
 void AudioDeviceBuffer::StopPlayout() {
@@ -273,6 +280,7 @@ int32_t AudioDeviceBuffer::DeliverRecordedData() {
       rec_sample_rate_, total_delay_ms, 0, 0, typing_status_,
       new_mic_level_dummy);
   if (res == -1) {
+    stats_.rec_glitches.fetch_add(1, std::memory_order_relaxed);
     RTC_LOG(LS_ERROR) << "RecordedDataIsAvailable() failed";
   }
   return 0;
@@ -306,6 +314,9 @@ int32_t AudioDeviceBuffer::RequestPlayoutData(size_t samples_per_channel) {
   if (res != 0) {
     RTC_LOG(LS_ERROR) << "NeedMorePlayData() failed";
   }
+  if (res != 0 || num_samples_out < total_samples) {
+    stats_.play_glitches.fetch_add(1, std::memory_order_relaxed);
+  }
 
   // Derive a new level value twice per second.
   int16_t max_abs = 0;
@@ -385,12 +396,14 @@ void AudioDeviceBuffer::LogStats(LogState state) {
   last_timer_task_time_ = now_time;
 
   Stats stats;
-  {
-    rtc::CritScope cs(&lock_);
-    stats = stats_;
-    stats_.max_rec_level = 0;
-    stats_.max_play_level = 0;
-  }
+  stats.rec_callbacks = stats_.rec_callbacks.load(std::memory_order_relaxed);
+  stats.play_callbacks = stats_.play_callbacks.load(std::memory_order_relaxed);
+  stats.rec_samples = stats_.rec_samples.load(std::memory_order_relaxed);
+  stats.play_samples = stats_.play_samples.load(std::memory_order_relaxed);
+  stats.rec_glitches = stats_.rec_glitches.load(std::memory_order_relaxed);
+  stats.play_glitches = stats_.play_glitches.load(std::memory_order_relaxed);
+  stats.max_rec_level = stats_.max_rec_level.exchange(0);
+  stats.max_play_level = stats_.max_play_level.exchange(0);
 
   // Cache current sample rate from atomic members.
   const uint32_t rec_sample_rate = rec_sample_rate_;
@@ -417,6 +430,8 @@ void AudioDeviceBuffer::LogStats(LogState state) {
                     << "samples: " << diff_samples << ", "
                     << "rate: " << static_cast<int>(rate + 0.5) << ", "
                     << "rate diff: " << abs_diff_rate_in_percent << "%, "
+                    << "glitches: "
+                    << stats.rec_glitches - last_stats_.rec_glitches << ", "
                     << "level: " << stats.max_rec_level;
     }
 
@@ -435,6 +450,8 @@ void AudioDeviceBuffer::LogStats(LogState state) {
                     << "samples: " << diff_samples << ", "
                     << "rate: " << static_cast<int>(rate + 0.5) << ", "
                     << "rate diff: " << abs_diff_rate_in_percent << "%, "
+                    << "glitches: "
+                    << stats.play_glitches - last_stats_.play_glitches << ", "
                     << "level: " << stats.max_play_level;
     }
   }
@@ -452,34 +469,39 @@ void AudioDeviceBuffer::LogStats(LogState state) {
 void AudioDeviceBuffer::ResetRecStats() {
   RTC_DCHECK_RUN_ON(&task_queue_);
   last_stats_.ResetRecStats();
-  rtc::CritScope cs(&lock_);
-  stats_.ResetRecStats();
+  stats_.rec_callbacks = 0;
+  stats_.rec_samples = 0;
+  stats_.rec_glitches = 0;
+  stats_.max_rec_level = 0;
 }
 
 void AudioDeviceBuffer::ResetPlayStats() {
   RTC_DCHECK_RUN_ON(&task_queue_);
   last_stats_.ResetPlayStats();
-  rtc::CritScope cs(&lock_);
-  stats_.ResetPlayStats();
+  stats_.play_callbacks = 0;
+  stats_.play_samples = 0;
+  stats_.play_glitches = 0;
+  stats_.max_play_level = 0;
 }
 
 void AudioDeviceBuffer::UpdateRecStats(int16_t max_abs,
                                        size_t samples_per_channel) {
-  rtc::CritScope cs(&lock_);
-  ++stats_.rec_callbacks;
-  stats_.rec_samples += samples_per_channel;
-  if (max_abs > stats_.max_rec_level) {
-    stats_.max_rec_level = max_abs;
+  stats_.rec_callbacks.fetch_add(1, std::memory_order_relaxed);
+  stats_.rec_samples.fetch_add(samples_per_channel, std::memory_order_relaxed);
+  // A level reset by LogStats() in between the load and the store is lost,
+  // which is harmless for a level that is only logged.
+  if (max_abs > stats_.max_rec_level.load(std::memory_order_relaxed)) {
+    stats_.max_rec_level.store(max_abs, std::memory_order_relaxed);
   }
 }
 
 void AudioDeviceBuffer::UpdatePlayStats(int16_t max_abs,
                                         size_t samples_per_channel) {
-  rtc::CritScope cs(&lock_);
-  ++stats_.play_callbacks;
-  stats_.play_samples += samples_per_channel;
-  if (max_abs > stats_.max_play_level) {
-    stats_.max_play_level = max_abs;
+  stats_.play_callbacks.fetch_add(1, std::memory_order_relaxed);
+  stats_.play_samples.fetch_add(samples_per_channel,
+                                std::memory_order_relaxed);
+  if (max_abs > stats_.max_play_level.load(std::memory_order_relaxed)) {
+    stats_.max_play_level.store(max_abs, std::memory_order_relaxed);
   }
 }
 
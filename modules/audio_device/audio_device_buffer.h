@@ -19,7 +19,6 @@
 #include "api/task_queue/task_queue_factory.h"
 #include "modules/audio_device/include/audio_device_defines.h"
 #include "rtc_base/buffer.h"
-#include "rtc_base/critical_section.h"
 #include "rtc_base/task_queue.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_checker.h"
@@ -44,12 +43,14 @@ class AudioDeviceBuffer {
     void ResetRecStats() {
       rec_callbacks = 0;
       rec_samples = 0;
+      rec_glitches = 0;
       max_rec_level = 0;
     }
 
     void ResetPlayStats() {
       play_callbacks = 0;
       play_samples = 0;
+      play_glitches = 0;
       max_play_level = 0;
     }
 
@@ -67,6 +68,14 @@ class AudioDeviceBuffer {
     // Total number of played audio samples.
     uint64_t play_samples = 0;
 
+    // Total number of recording callbacks where the recorded audio could not
+    // be delivered to the audio transport.
+    uint64_t rec_glitches = 0;
+
+    // Total number of playback callbacks where the audio transport could not
+    // provide all the requested audio, i.e. where silence was played out.
+    uint64_t play_glitches = 0;
+
     // Contains max level (max(abs(x))) of recorded audio packets over the last
     // 10 seconds where a new measurement is done twice per second. The level
     // is reset to zero at each call to LogStats().
@@ -122,7 +131,8 @@ class AudioDeviceBuffer {
   void LogStats(LogState state);
 
   // Updates counters in each play/record callback. These counters are later
-  // (periodically) read by LogStats() using a lock.
+  // (periodically) read by LogStats(). No locks are taken since the counters
+  // are updated on the real-time audio threads.
   void UpdateRecStats(int16_t max_abs, size_t samples_per_channel);
   void UpdatePlayStats(int16_t max_abs, size_t samples_per_channel);
 
@@ -142,8 +152,6 @@ class AudioDeviceBuffer {
   // Main thread on which this object is created.
   rtc::ThreadChecker main_thread_checker_;
 
-  rtc::CriticalSection lock_;
-
   // Task queue used to invoke LogStats() periodically. Tasks are executed on a
   // worker thread but it does not necessarily have to be the same thread for
   // each task.
@@ -202,8 +210,21 @@ class AudioDeviceBuffer {
   int64_t play_start_time_ RTC_GUARDED_BY(main_thread_checker_);
   int64_t rec_start_time_ RTC_GUARDED_BY(main_thread_checker_);
 
-  // Contains counters for playout and recording statistics.
-  Stats stats_ RTC_GUARDED_BY(lock_);
+  // Contains counters for playout and recording statistics. Each recording
+  // counter is only written on the native recording thread and each playout
+  // counter on the native playout thread, while LogStats() reads and resets
+  // them on the task queue.
+  struct AtomicStats {
+    std::atomic<uint64_t> rec_callbacks{0};
+    std::atomic<uint64_t> play_callbacks{0};
+    std::atomic<uint64_t> rec_samples{0};
+    std::atomic<uint64_t> play_samples{0};
+    std::atomic<uint64_t> rec_glitches{0};
+    std::atomic<uint64_t> play_glitches{0};
+    std::atomic<int16_t> max_rec_level{0};
+    std::atomic<int16_t> max_play_level{0};
+  };
+  AtomicStats stats_;
 
   // Stores current stats at each timer task. Used to calculate differences
   // between two successive timer events.
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -95,12 +96,17 @@ AudioMixerImpl::SourceStatusList::const_iterator FindSourceInList(
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-    bool use_limiter)
-    : output_rate_calculator_(std::move(output_rate_calculator)),
+    bool use_limiter,
+    int max_sources_to_mix)
+    : max_sources_to_mix_(max_sources_to_mix),
+      use_limiter_(use_limiter),
+      output_rate_calculator_(std::move(output_rate_calculator)),
       output_frequency_(0),
       sample_size_(0),
       audio_source_list_(),
-      frame_combiner_(use_limiter) {}
+      frame_combiner_(use_limiter) {
+  RTC_DCHECK_GT(max_sources_to_mix, 0);
+}
 
 AudioMixerImpl::~AudioMixerImpl() {}
 
@@ -113,9 +119,17 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create() {
 rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter) {
+  return Create(std::move(output_rate_calculator), use_limiter,
+                kMaximumAmountOfMixedAudioSources);
+}
+
+rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
+    std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+    bool use_limiter,
+    int max_sources_to_mix) {
   return rtc::scoped_refptr<AudioMixerImpl>(
       new rtc::RefCountedObject<AudioMixerImpl>(
-          std::move(output_rate_calculator), use_limiter));
+          std::move(output_rate_calculator), use_limiter, max_sources_to_mix));
 }
 
 void AudioMixerImpl::Mix(size_t number_of_channels,
@@ -128,9 +142,12 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
   {
     rtc::CritScope lock(&crit_);
     const size_t number_of_streams = audio_source_list_.size();
-    frame_combiner_.Combine(GetAudioFromSources(), number_of_channels,
-                            OutputFrequency(), number_of_streams,
-                            audio_frame_for_mixing);
+    const AudioFrameList mix_list = GetAudioFromSources();
+    frame_combiner_.Combine(mix_list, number_of_channels, OutputFrequency(),
+                            number_of_streams, audio_frame_for_mixing);
+    if (num_mix_minus_outputs_ > 0) {
+      CombineMixMinusOutputs(mix_list, number_of_channels, number_of_streams);
+    }
   }
 
   return;
@@ -172,9 +189,32 @@ void AudioMixerImpl::RemoveSource(Source* audio_source) {
   rtc::CritScope lock(&crit_);
   const auto iter = FindSourceInList(audio_source, &audio_source_list_);
   RTC_DCHECK(iter != audio_source_list_.end()) << "Source not present in mixer";
+  if ((*iter)->mix_minus_frame) {
+    --num_mix_minus_outputs_;
+  }
   audio_source_list_.erase(iter);
 }
 
+void AudioMixerImpl::SetMixMinusOutput(Source* listener,
+                                       AudioFrame* audio_frame) {
+  RTC_DCHECK(listener);
+  rtc::CritScope lock(&crit_);
+  const auto iter = FindSourceInList(listener, &audio_source_list_);
+  RTC_DCHECK(iter != audio_source_list_.end()) << "Source not present in mixer";
+  if (iter == audio_source_list_.end()) {
+    return;
+  }
+  SourceStatus* const status = iter->get();
+  if (audio_frame && !status->mix_minus_frame) {
+    ++num_mix_minus_outputs_;
+    status->mix_minus_combiner = std::make_unique<FrameCombiner>(use_limiter_);
+  } else if (!audio_frame && status->mix_minus_frame) {
+    --num_mix_minus_outputs_;
+    status->mix_minus_combiner.reset();
+  }
+  status->mix_minus_frame = audio_frame;
+}
+
 AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
   AudioFrameList result;
@@ -196,11 +236,15 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
         audio_frame_info == Source::AudioFrameInfo::kMuted);
   }
 
-  // Sort frames by sorting function.
-  std::sort(audio_source_mixing_data_list.begin(),
-            audio_source_mixing_data_list.end(), ShouldMixBefore);
+  // Only the frames that can be mixed need to be in order, so sort just
+  // those. With many sources this is much cheaper than a full sort.
+  const size_t num_sorted = std::min(audio_source_mixing_data_list.size(),
+                                     static_cast<size_t>(max_sources_to_mix_));
+  std::partial_sort(audio_source_mixing_data_list.begin(),
+                    audio_source_mixing_data_list.begin() + num_sorted,
+                    audio_source_mixing_data_list.end(), ShouldMixBefore);
 
-  int max_audio_frame_counter = kMaximumAmountOfMixedAudioSources;
+  int max_audio_frame_counter = max_sources_to_mix_;
 
   // Go through list in order and put unmuted frames in result list.
   for (const auto& p : audio_source_mixing_data_list) {
@@ -224,6 +268,26 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   return result;
 }
 
+void AudioMixerImpl::CombineMixMinusOutputs(const AudioFrameList& mix_list,
+                                            size_t number_of_channels,
+                                            size_t number_of_streams) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  if (!mix_minus_sum_) {
+    mix_minus_sum_ = std::make_unique<FrameCombiner::MixingBuffer>();
+  }
+  FrameCombiner::SumFrames(mix_list, number_of_channels, OutputFrequency(),
+                           mix_minus_sum_.get());
+  for (auto& source_and_status : audio_source_list_) {
+    if (!source_and_status->mix_minus_frame) {
+      continue;
+    }
+    source_and_status->mix_minus_combiner->CombineMixMinus(
+        mix_list, &source_and_status->audio_frame, *mix_minus_sum_,
+        number_of_channels, OutputFrequency(), number_of_streams,
+        source_and_status->mix_minus_frame);
+  }
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
@@ -41,12 +41,18 @@ class AudioMixerImpl : public AudioMixer {
 
     // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
     AudioFrame audio_frame;
+
+    // Set by SetMixMinusOutput(). Gets the mix without this source, made by
+    // its own combiner.
+    AudioFrame* mix_minus_frame = nullptr;
+    std::unique_ptr<FrameCombiner> mix_minus_combiner;
   };
 
   using SourceStatusList = std::vector<std::unique_ptr<SourceStatus>>;
 
   // AudioProcessing only accepts 10 ms frames.
   static const int kFrameDurationInMs = 10;
+  // The default number of sources that are mixed each round.
   static const int kMaximumAmountOfMixedAudioSources = 3;
 
   static rtc::scoped_refptr<AudioMixerImpl> Create();
@@ -55,6 +61,13 @@ class AudioMixerImpl : public AudioMixer {
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
       bool use_limiter);
 
+  // Mixes up to |max_sources_to_mix| sources each round, instead of
+  // kMaximumAmountOfMixedAudioSources.
+  static rtc::scoped_refptr<AudioMixerImpl> Create(
+      std::unique_ptr<OutputRateCalculator> output_rate_calculator,
+      bool use_limiter,
+      int max_sources_to_mix);
+
   ~AudioMixerImpl() override;
 
   // AudioMixer functions
@@ -65,6 +78,16 @@ class AudioMixerImpl : public AudioMixer {
            AudioFrame* audio_frame_for_mixing) override
       RTC_LOCKS_EXCLUDED(crit_);
 
+  // Mix-minus: makes Mix() also write the mix without the audio of
+  // |listener| to |audio_frame|, so that a participant doesn't hear itself.
+  // The mixed frames are summed once for all listeners, and each listener
+  // only subtracts its own frame, instead of running a mixer per listener.
+  // Each listener output has its own limiter. |listener| must be a source of
+  // the mixer, and |audio_frame| must stay valid until the source is
+  // removed, or the output is reset by passing nullptr.
+  void SetMixMinusOutput(Source* listener, AudioFrame* audio_frame)
+      RTC_LOCKS_EXCLUDED(crit_);
+
   // Returns true if the source was mixed last round. Returns
   // false and logs an error if the source was never added to the
   // mixer.
@@ -72,7 +95,8 @@ class AudioMixerImpl : public AudioMixer {
 
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
-                 bool use_limiter);
+                 bool use_limiter,
+                 int max_sources_to_mix);
 
  private:
   // Set mixing frequency through OutputFrequencyCalculator.
@@ -81,16 +105,26 @@ class AudioMixerImpl : public AudioMixer {
   int OutputFrequency() const;
 
   // Compute what audio sources to mix from audio_source_list_. Ramp
-  // in and out. Update mixed status. Mixes up to
-  // kMaximumAmountOfMixedAudioSources audio sources.
+  // in and out. Update mixed status. Mixes up to |max_sources_to_mix_|
+  // audio sources.
   AudioFrameList GetAudioFromSources() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Writes the mix-minus output of every listener, from the frames that were
+  // mixed this round.
+  void CombineMixMinusOutputs(const AudioFrameList& mix_list,
+                              size_t number_of_channels,
+                              size_t number_of_streams)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // The critical section lock guards audio source insertion and
   // removal, which can be done from any thread. The race checker
   // checks that mixing is done sequentially.
   rtc::CriticalSection crit_;
   rtc::RaceChecker race_checker_;
 
+  const int max_sources_to_mix_;
+  const bool use_limiter_;
+
   std::unique_ptr<OutputRateCalculator> output_rate_calculator_;
   // The current sample frequency and sample size when mixing.
   int output_frequency_ RTC_GUARDED_BY(race_checker_);
@@ -102,6 +136,12 @@ class AudioMixerImpl : public AudioMixer {
   // Component that handles actual adding of audio frames.
   FrameCombiner frame_combiner_ RTC_GUARDED_BY(race_checker_);
 
+  // The number of sources with a mix-minus output, and the sum of the mixed
+  // frames that their outputs are derived from.
+  int num_mix_minus_outputs_ RTC_GUARDED_BY(crit_) = 0;
+  std::unique_ptr<FrameCombiner::MixingBuffer> mix_minus_sum_
+      RTC_GUARDED_BY(race_checker_);
+
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioMixerImpl);
 };
 }  // namespace webrtc
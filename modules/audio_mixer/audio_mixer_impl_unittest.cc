@@ -16,13 +16,17 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "api/audio/audio_mixer.h"
 #include "modules/audio_mixer/default_output_rate_calculator.h"
+#include "rtc_base/arraysize.h"
 #include "rtc_base/bind.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/task_queue_for_test.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -199,6 +203,81 @@ TEST(AudioMixer, LargestEnergyVadActiveMixed) {
   }
 }
 
+TEST(AudioMixer, ConfigurableNumberOfMixedSources) {
+  constexpr int kAudioSources = 10;
+  constexpr int kMaxSourcesToMix = 6;
+
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), true, kMaxSourcesToMix);
+
+  MockMixerAudioSource participants[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    participants[i].fake_frame()->mutable_data()[80] = i;
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+  }
+
+  AudioFrame audio_frame;
+  mixer->Mix(1, &audio_frame);
+
+  for (int i = 0; i < kAudioSources; ++i) {
+    EXPECT_EQ(i >= kAudioSources - kMaxSourcesToMix,
+              mixer->GetAudioSourceMixabilityStatusForTest(&participants[i]))
+        << "Mixing status of AudioSource #" << i << " wrong.";
+  }
+}
+
+TEST(AudioMixer, MixMinusLeavesOutOwnAudio) {
+  // The last source is too quiet to be mixed.
+  constexpr int16_t kValues[] = {100, 200, 400, 800, 1};
+  constexpr int kAudioSources = arraysize(kValues);
+  constexpr int kMixedSum = 100 + 200 + 400 + 800;
+  const auto mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), false, 4);
+
+  MockMixerAudioSource participants[kAudioSources];
+  AudioFrame mix_minus_frames[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(participants[i].fake_frame());
+    int16_t* data = participants[i].fake_frame()->mutable_data();
+    std::fill(data, data + kDefaultSampleRateHz / 100, kValues[i]);
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+    mixer->SetMixMinusOutput(&participants[i], &mix_minus_frames[i]);
+  }
+  // Not a listener.
+  mixer->SetMixMinusOutput(&participants[0], nullptr);
+
+  AudioFrame audio_frame;
+  // Mix twice, so that the sources are ramped in.
+  for (int round = 0; round < 2; ++round) {
+    for (AudioFrame& frame : mix_minus_frames)
+      frame.Mute();
+    mixer->Mix(1, &audio_frame);
+  }
+
+  EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&participants[4]));
+  EXPECT_EQ(kMixedSum, audio_frame.data()[100]);
+  EXPECT_TRUE(mix_minus_frames[0].muted());
+  for (int i = 1; i < kAudioSources; ++i) {
+    const int expected =
+        i == kAudioSources - 1 ? kMixedSum : kMixedSum - kValues[i];
+    EXPECT_FALSE(mix_minus_frames[i].muted());
+    EXPECT_EQ(expected, mix_minus_frames[i].data()[100])
+        << "Mix-minus output of AudioSource #" << i << " wrong.";
+  }
+
+  // Removing a listener stops its output. Now the quiet source is mixed too,
+  // and is ramped in after two rounds.
+  mixer->RemoveSource(&participants[1]);
+  for (int round = 0; round < 2; ++round) {
+    mix_minus_frames[1].Mute();
+    mixer->Mix(1, &audio_frame);
+    EXPECT_TRUE(mix_minus_frames[1].muted());
+  }
+  EXPECT_EQ(kValues[0] + kValues[3] + kValues[4],
+            mix_minus_frames[2].data()[100]);
+}
+
 TEST(AudioMixer, FrameNotModifiedForSingleParticipant) {
   const auto mixer = AudioMixerImpl::Create();
 
@@ -639,4 +718,60 @@ TEST(AudioMixer, MultipleChannelsAndHighRate) {
 #endif
 }
 
+namespace {
+
+// Cheaper than MockMixerAudioSource, so that the benchmark below measures the
+// mixer.
+class FakeAudioSource : public AudioMixer::Source {
+ public:
+  explicit FakeAudioSource(int16_t amplitude) {
+    ResetFrame(&frame_);
+    int16_t* data = frame_.mutable_data();
+    for (size_t i = 0; i < frame_.samples_per_channel_; ++i)
+      data[i] = (i % 2 == 0) ? amplitude : -amplitude;
+  }
+
+  AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz,
+                                       AudioFrame* audio_frame) override {
+    audio_frame->CopyFrom(frame_);
+    return AudioFrameInfo::kNormal;
+  }
+  int Ssrc() const override { return 0; }
+  int PreferredSampleRate() const override { return kDefaultSampleRateHz; }
+
+ private:
+  AudioFrame frame_;
+};
+
+}  // namespace
+
+TEST(AudioMixer, DISABLED_MixPerf) {
+  constexpr int kNumMixes = 1000;
+  for (int num_sources : {10, 100, 500}) {
+    for (int max_sources_to_mix :
+         {AudioMixerImpl::kMaximumAmountOfMixedAudioSources, 16}) {
+      const auto mixer = AudioMixerImpl::Create(
+          std::make_unique<DefaultOutputRateCalculator>(), true,
+          max_sources_to_mix);
+      std::vector<std::unique_ptr<FakeAudioSource>> sources;
+      for (int i = 0; i < num_sources; ++i) {
+        sources.push_back(std::make_unique<FakeAudioSource>(100 + i));
+        mixer->AddSource(sources.back().get());
+      }
+
+      AudioFrame audio_frame;
+      int64_t start_us = rtc::TimeMicros();
+      for (int i = 0; i < kNumMixes; ++i)
+        mixer->Mix(1, &audio_frame);
+      int64_t elapsed_us = rtc::TimeMicros() - start_us;
+      RTC_LOG(LS_INFO) << num_sources << " sources, mixing up to "
+                       << max_sources_to_mix << ": " << elapsed_us / kNumMixes
+                       << " us per mix";
+
+      for (auto& source : sources)
+        mixer->RemoveSource(source.get());
+    }
+  }
+}
+
 }  // namespace webrtc
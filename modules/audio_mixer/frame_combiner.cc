@@ -74,29 +74,57 @@ void MixFewFramesWithNoLimiter(const std::vector<AudioFrame*>& mix_list,
             audio_frame_for_mixing->mutable_data());
 }
 
+// Adds the samples of 'frame_data' to the mixing buffer, or subtracts them
+// if 'subtract' is set. The loop bounds are hoisted, and each channel is
+// accumulated in its own contiguous loop, so that the compiler can vectorize
+// the inner loops.
+void AccumulateFrame(const int16_t* frame_data,
+                     bool subtract,
+                     size_t samples_per_channel,
+                     size_t number_of_channels,
+                     MixingBuffer* mixing_buffer) {
+  const size_t num_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t num_samples =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+  const float sign = subtract ? -1.f : 1.f;
+  if (number_of_channels == 1) {
+    float* const channel = (*mixing_buffer)[0].data();
+    for (size_t k = 0; k < num_samples; ++k) {
+      channel[k] += sign * frame_data[k];
+    }
+    return;
+  }
+  for (size_t j = 0; j < num_channels; ++j) {
+    float* const channel = (*mixing_buffer)[j].data();
+    const int16_t* const interleaved = frame_data + j;
+    for (size_t k = 0; k < num_samples; ++k) {
+      channel[k] += sign * interleaved[number_of_channels * k];
+    }
+  }
+}
+
 void MixToFloatFrame(const std::vector<AudioFrame*>& mix_list,
                      size_t samples_per_channel,
                      size_t number_of_channels,
                      MixingBuffer* mixing_buffer) {
   RTC_DCHECK_LE(samples_per_channel, FrameCombiner::kMaximumChannelSize);
   RTC_DCHECK_LE(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
-  // Clear the mixing buffer.
-  for (auto& one_channel_buffer : *mixing_buffer) {
-    std::fill(one_channel_buffer.begin(), one_channel_buffer.end(), 0.f);
+  const size_t num_channels =
+      std::min(number_of_channels, FrameCombiner::kMaximumNumberOfChannels);
+  const size_t num_samples =
+      std::min(samples_per_channel, FrameCombiner::kMaximumChannelSize);
+
+  // Clear the part of the mixing buffer that is used.
+  for (size_t j = 0; j < num_channels; ++j) {
+    std::fill((*mixing_buffer)[j].begin(),
+              (*mixing_buffer)[j].begin() + num_samples, 0.f);
   }
 
   // Convert to FloatS16 and mix.
-  for (size_t i = 0; i < mix_list.size(); ++i) {
-    const AudioFrame* const frame = mix_list[i];
-    for (size_t j = 0; j < std::min(number_of_channels,
-                                    FrameCombiner::kMaximumNumberOfChannels);
-         ++j) {
-      for (size_t k = 0; k < std::min(samples_per_channel,
-                                      FrameCombiner::kMaximumChannelSize);
-           ++k) {
-        (*mixing_buffer)[j][k] += frame->data()[number_of_channels * k + j];
-      }
-    }
+  for (const AudioFrame* frame : mix_list) {
+    AccumulateFrame(frame->data(), false, samples_per_channel,
+                    number_of_channels, mixing_buffer);
   }
 }
 
@@ -173,7 +201,71 @@ void FrameCombiner::Combine(const std::vector<AudioFrame*>& mix_list,
 
   MixToFloatFrame(mix_list, samples_per_channel, number_of_channels,
                   mixing_buffer_.get());
+  LimitAndInterleave(number_of_channels, samples_per_channel,
+                     audio_frame_for_mixing);
+}
+
+void FrameCombiner::SumFrames(const std::vector<AudioFrame*>& mix_list,
+                              size_t number_of_channels,
+                              int sample_rate,
+                              MixingBuffer* mix_sum) {
+  RTC_DCHECK(mix_sum);
+  const size_t samples_per_channel = static_cast<size_t>(
+      (sample_rate * webrtc::AudioMixerImpl::kFrameDurationInMs) / 1000);
+  for (auto* frame : mix_list) {
+    RemixFrame(number_of_channels, frame);
+  }
+  MixToFloatFrame(mix_list, samples_per_channel, number_of_channels, mix_sum);
+}
+
+void FrameCombiner::CombineMixMinus(const std::vector<AudioFrame*>& mix_list,
+                                    const AudioFrame* excluded_frame,
+                                    const MixingBuffer& mix_sum,
+                                    size_t number_of_channels,
+                                    int sample_rate,
+                                    size_t number_of_streams,
+                                    AudioFrame* audio_frame_for_mixing) {
+  RTC_DCHECK(audio_frame_for_mixing);
+
+  std::vector<AudioFrame*> listener_mix_list;
+  listener_mix_list.reserve(mix_list.size());
+  bool is_excluded_frame_mixed = false;
+  for (AudioFrame* frame : mix_list) {
+    if (frame == excluded_frame) {
+      is_excluded_frame_mixed = true;
+    } else {
+      listener_mix_list.push_back(frame);
+    }
+  }
+
+  SetAudioFrameFields(listener_mix_list, number_of_channels, sample_rate,
+                      number_of_streams, audio_frame_for_mixing);
+
+  if (number_of_streams <= 1) {
+    MixFewFramesWithNoLimiter(listener_mix_list, audio_frame_for_mixing);
+    return;
+  }
+
+  const size_t samples_per_channel = static_cast<size_t>(
+      (sample_rate * webrtc::AudioMixerImpl::kFrameDurationInMs) / 1000);
+  const size_t num_samples = std::min(samples_per_channel, kMaximumChannelSize);
+  for (size_t j = 0; j < std::min(number_of_channels, kMaximumNumberOfChannels);
+       ++j) {
+    std::copy(mix_sum[j].begin(), mix_sum[j].begin() + num_samples,
+              (*mixing_buffer_)[j].begin());
+  }
+  // The samples are integers, so the sum and the difference are exact.
+  if (is_excluded_frame_mixed) {
+    AccumulateFrame(excluded_frame->data(), true, samples_per_channel,
+                    number_of_channels, mixing_buffer_.get());
+  }
+  LimitAndInterleave(number_of_channels, samples_per_channel,
+                     audio_frame_for_mixing);
+}
 
+void FrameCombiner::LimitAndInterleave(size_t number_of_channels,
+                                       size_t samples_per_channel,
+                                       AudioFrame* audio_frame_for_mixing) {
   const size_t output_number_of_channels =
       std::min(number_of_channels, kMaximumNumberOfChannels);
   const size_t output_samples_per_channel =
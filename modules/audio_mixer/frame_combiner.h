@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_MIXER_FRAME_COMBINER_H_
 #define MODULES_AUDIO_MIXER_FRAME_COMBINER_H_
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -45,7 +46,34 @@ class FrameCombiner {
   using MixingBuffer = std::array<std::array<float, kMaximumChannelSize>,
                                   kMaximumNumberOfChannels>;
 
+  // Sums the frames in 'mix_list' into 'mix_sum', for CombineMixMinus().
+  // Remixes the frames to 'number_of_channels' first, like Combine().
+  static void SumFrames(const std::vector<AudioFrame*>& mix_list,
+                        size_t number_of_channels,
+                        int sample_rate,
+                        MixingBuffer* mix_sum);
+
+  // Like Combine(), but leaves 'excluded_frame' out of the mix. This is the
+  // output of a mix-minus listener, whose own voice should not be played
+  // back to them. 'mix_sum' must hold the sum of all frames in 'mix_list', as
+  // computed by SumFrames(). So the sum is computed once for all listeners,
+  // and each of them only subtracts its own frame. 'excluded_frame' doesn't
+  // have to be in 'mix_list', e.g. when the listener isn't mixed.
+  void CombineMixMinus(const std::vector<AudioFrame*>& mix_list,
+                       const AudioFrame* excluded_frame,
+                       const MixingBuffer& mix_sum,
+                       size_t number_of_channels,
+                       int sample_rate,
+                       size_t number_of_streams,
+                       AudioFrame* audio_frame_for_mixing);
+
  private:
+  // Runs the limiter on the mixing buffer, if enabled, and writes the result
+  // to 'audio_frame_for_mixing'.
+  void LimitAndInterleave(size_t number_of_channels,
+                          size_t samples_per_channel,
+                          AudioFrame* audio_frame_for_mixing);
+
   void LogMixingStats(const std::vector<AudioFrame*>& mix_list,
                       int sample_rate,
                       size_t number_of_streams) const;
@@ -15,6 +15,7 @@
 #include <numeric>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "api/array_view.h"
 #include "audio/utility/audio_frame_operations.h"
@@ -216,6 +217,50 @@ TEST(FrameCombiner, CombiningOneFrameShouldNotChangeFrame) {
   }
 }
 
+TEST(FrameCombiner, MixMinusMatchesCombiningTheOtherFrames) {
+  constexpr int kRate = 48000;
+  for (const int number_of_channels : {1, 2}) {
+    SCOPED_TRACE(ProduceDebugText(kRate, number_of_channels, 3));
+    // Loud enough for the limiter to kick in.
+    SineWaveGenerator wave_generator1(440.f, 30000);
+    SineWaveGenerator wave_generator2(1000.f, 30000);
+    FrameCombiner reference_combiner(true);
+    FrameCombiner mix_minus_combiner(true);
+    FrameCombiner::MixingBuffer mix_sum;
+    AudioFrame frame3;
+    AudioFrame reference_frame;
+
+    for (int i = 0; i < 10; ++i) {
+      SetUpFrames(kRate, number_of_channels);
+      frame3.CopyFrom(frame1);
+      wave_generator1.GenerateNextFrame(&frame1);
+      wave_generator2.GenerateNextFrame(&frame2);
+      std::fill(frame3.mutable_data(),
+                frame3.mutable_data() + number_of_channels * kRate / 100,
+                10000);
+
+      const std::vector<AudioFrame*> all_frames = {&frame1, &frame2, &frame3};
+      const std::vector<AudioFrame*> other_frames = {&frame2, &frame3};
+      reference_combiner.Combine(other_frames, number_of_channels, kRate,
+                                 all_frames.size(), &reference_frame);
+      FrameCombiner::SumFrames(all_frames, number_of_channels, kRate,
+                               &mix_sum);
+      mix_minus_combiner.CombineMixMinus(all_frames, &frame1, mix_sum,
+                                         number_of_channels, kRate,
+                                         all_frames.size(),
+                                         &audio_frame_for_mixing);
+
+      const size_t number_of_samples = number_of_channels * kRate / 100;
+      EXPECT_EQ(std::vector<int16_t>(reference_frame.data(),
+                                     reference_frame.data() +
+                                         number_of_samples),
+                std::vector<int16_t>(audio_frame_for_mixing.data(),
+                                     audio_frame_for_mixing.data() +
+                                         number_of_samples));
+    }
+  }
+}
+
 // Send a sine wave through the FrameCombiner, and check that the
 // difference between input and output varies smoothly. Also check
 // that it is inside reasonable bounds. This is to catch issues like
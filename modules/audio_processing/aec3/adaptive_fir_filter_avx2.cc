@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/adaptive_fir_filter.h"
+
+#include <immintrin.h>
+
+#include <array>
+#include <vector>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+namespace aec3 {
+
+// Computes and stores the frequency response of the filter.
+void UpdateFrequencyResponse_AVX2(
+    rtc::ArrayView<const FftData> H,
+    std::vector<std::array<float, kFftLengthBy2Plus1>>* H2) {
+  RTC_DCHECK_EQ(H.size(), H2->size());
+  for (size_t k = 0; k < H.size(); ++k) {
+    for (size_t j = 0; j < kFftLengthBy2; j += 8) {
+      const __m256 re = _mm256_loadu_ps(&H[k].re[j]);
+      const __m256 im = _mm256_loadu_ps(&H[k].im[j]);
+      const __m256 re2 = _mm256_mul_ps(re, re);
+      const __m256 H2_k_j = _mm256_fmadd_ps(im, im, re2);
+      _mm256_storeu_ps(&(*H2)[k][j], H2_k_j);
+    }
+    (*H2)[k][kFftLengthBy2] = H[k].re[kFftLengthBy2] * H[k].re[kFftLengthBy2] +
+                              H[k].im[kFftLengthBy2] * H[k].im[kFftLengthBy2];
+  }
+}
+
+// Adapts the filter partitions. (AVX2 variant)
+void AdaptPartitions_AVX2(const RenderBuffer& render_buffer,
+                          const FftData& G,
+                          rtc::ArrayView<FftData> H) {
+  rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  const size_t num_blocks = render_buffer_data.size();
+  constexpr int kNumEightBinBands = kFftLengthBy2 / 8;
+
+  size_t index = render_buffer.Position();
+  for (FftData& H_j : H) {
+    const FftData& X = render_buffer_data[index][/*channel=*/0];
+    for (int k = 0, n = 0; n < kNumEightBinBands; ++n, k += 8) {
+      const __m256 G_re = _mm256_loadu_ps(&G.re[k]);
+      const __m256 G_im = _mm256_loadu_ps(&G.im[k]);
+      const __m256 X_re = _mm256_loadu_ps(&X.re[k]);
+      const __m256 X_im = _mm256_loadu_ps(&X.im[k]);
+      const __m256 H_re = _mm256_loadu_ps(&H_j.re[k]);
+      const __m256 H_im = _mm256_loadu_ps(&H_j.im[k]);
+      // H_re += X_re * G_re + X_im * G_im, and
+      // H_im += X_re * G_im - X_im * G_re.
+      const __m256 a = _mm256_fmadd_ps(X_re, G_re, H_re);
+      const __m256 b = _mm256_fmadd_ps(X_re, G_im, H_im);
+      const __m256 e = _mm256_fmadd_ps(X_im, G_im, a);
+      const __m256 f = _mm256_fnmadd_ps(X_im, G_re, b);
+      _mm256_storeu_ps(&H_j.re[k], e);
+      _mm256_storeu_ps(&H_j.im[k], f);
+    }
+    H_j.re[kFftLengthBy2] += X.re[kFftLengthBy2] * G.re[kFftLengthBy2] +
+                             X.im[kFftLengthBy2] * G.im[kFftLengthBy2];
+    H_j.im[kFftLengthBy2] += X.re[kFftLengthBy2] * G.im[kFftLengthBy2] -
+                             X.im[kFftLengthBy2] * G.re[kFftLengthBy2];
+
+    index = index < (num_blocks - 1) ? index + 1 : 0;
+  }
+}
+
+// Produces the filter output (AVX2 variant).
+void ApplyFilter_AVX2(const RenderBuffer& render_buffer,
+                      rtc::ArrayView<const FftData> H,
+                      FftData* S) {
+  rtc::ArrayView<const std::vector<FftData>> render_buffer_data =
+      render_buffer.GetFftBuffer();
+  const size_t num_blocks = render_buffer_data.size();
+  constexpr int kNumEightBinBands = kFftLengthBy2 / 8;
+
+  // Accumulate each band over all partitions in registers, and store it once.
+  for (int k = 0, n = 0; n < kNumEightBinBands; ++n, k += 8) {
+    __m256 S_re = _mm256_setzero_ps();
+    __m256 S_im = _mm256_setzero_ps();
+    size_t index = render_buffer.Position();
+    for (const FftData& H_j : H) {
+      const FftData& X = render_buffer_data[index][/*channel=*/0];
+      const __m256 X_re = _mm256_loadu_ps(&X.re[k]);
+      const __m256 X_im = _mm256_loadu_ps(&X.im[k]);
+      const __m256 H_re = _mm256_loadu_ps(&H_j.re[k]);
+      const __m256 H_im = _mm256_loadu_ps(&H_j.im[k]);
+      // S_re += X_re * H_re - X_im * H_im, and
+      // S_im += X_re * H_im + X_im * H_re.
+      S_re = _mm256_fmadd_ps(X_re, H_re, S_re);
+      S_im = _mm256_fmadd_ps(X_re, H_im, S_im);
+      S_re = _mm256_fnmadd_ps(X_im, H_im, S_re);
+      S_im = _mm256_fmadd_ps(X_im, H_re, S_im);
+      index = index < (num_blocks - 1) ? index + 1 : 0;
+    }
+    _mm256_storeu_ps(&S->re[k], S_re);
+    _mm256_storeu_ps(&S->im[k], S_im);
+  }
+
+  S->re[kFftLengthBy2] = 0.f;
+  S->im[kFftLengthBy2] = 0.f;
+  size_t index = render_buffer.Position();
+  for (const FftData& H_j : H) {
+    const FftData& X = render_buffer_data[index][/*channel=*/0];
+    S->re[kFftLengthBy2] += X.re[kFftLengthBy2] * H_j.re[kFftLengthBy2] -
+                            X.im[kFftLengthBy2] * H_j.im[kFftLengthBy2];
+    S->im[kFftLengthBy2] += X.re[kFftLengthBy2] * H_j.im[kFftLengthBy2] +
+                            X.im[kFftLengthBy2] * H_j.re[kFftLengthBy2];
+    index = index < (num_blocks - 1) ? index + 1 : 0;
+  }
+}
+
+}  // namespace aec3
+}  // namespace webrtc
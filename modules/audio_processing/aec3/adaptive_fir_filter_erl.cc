@@ -83,6 +83,7 @@ void ComputeErl(const Aec3Optimization& optimization,
   switch (optimization) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
     case Aec3Optimization::kSse2:
+    case Aec3Optimization::kAvx2:
       aec3::ErlComputer_SSE2(H2, erl);
       break;
 #endif
@@ -32,9 +32,11 @@
 #include "modules/audio_processing/test/echo_canceller_test_tools.h"
 #include "modules/audio_processing/utility/cascaded_biquad_filter.h"
 #include "rtc_base/arraysize.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
@@ -245,8 +247,200 @@ TEST(AdaptiveFirFilter, UpdateFrequencyResponseSse2Optimization) {
   }
 }
 
+// Verifies that the AVX2 methods for filter adaptation are similar to their
+// reference counterparts. They use fused multiply-adds, and the filter output
+// is accumulated in a different order, so they are not bitexact: the results
+// are compared with a tolerance relative to the largest value in the output.
+TEST(AdaptiveFirFilter, FilterAdaptationAvx2Optimizations) {
+  constexpr size_t kNumRenderChannels = 1;
+  constexpr int kSampleRateHz = 48000;
+  constexpr size_t kNumBands = NumBandsForRate(kSampleRateHz);
+
+  bool use_avx2 = (WebRtc_GetCPUInfo(kAVX2) != 0);
+  if (use_avx2) {
+    std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+        RenderDelayBuffer::Create(EchoCanceller3Config(), kSampleRateHz,
+                                  kNumRenderChannels));
+    Random random_generator(42U);
+    std::vector<std::vector<std::vector<float>>> x(
+        kNumBands,
+        std::vector<std::vector<float>>(kNumRenderChannels,
+                                        std::vector<float>(kBlockSize, 0.f)));
+    FftData S_C;
+    FftData S_AVX2;
+    FftData G;
+    Aec3Fft fft;
+    std::vector<FftData> H_C(10);
+    std::vector<FftData> H_AVX2(10);
+    for (auto& H_j : H_C) {
+      H_j.Clear();
+    }
+    for (auto& H_j : H_AVX2) {
+      H_j.Clear();
+    }
+
+    for (size_t k = 0; k < 500; ++k) {
+      for (size_t band = 0; band < x.size(); ++band) {
+        for (size_t channel = 0; channel < x[band].size(); ++channel) {
+          RandomizeSampleVector(&random_generator, x[band][channel]);
+        }
+      }
+      render_delay_buffer->Insert(x);
+      if (k == 0) {
+        render_delay_buffer->Reset();
+      }
+      render_delay_buffer->PrepareCaptureProcessing();
+      auto* const render_buffer = render_delay_buffer->GetRenderBuffer();
+
+      ApplyFilter_AVX2(*render_buffer, H_AVX2, &S_AVX2);
+      ApplyFilter(*render_buffer, H_C, &S_C);
+      float max_abs_S = 0.f;
+      for (size_t j = 0; j < S_C.re.size(); ++j) {
+        max_abs_S = std::max({max_abs_S, fabsf(S_C.re[j]), fabsf(S_C.im[j])});
+      }
+      for (size_t j = 0; j < S_C.re.size(); ++j) {
+        EXPECT_NEAR(S_C.re[j], S_AVX2.re[j], max_abs_S * 0.00001f);
+        EXPECT_NEAR(S_C.im[j], S_AVX2.im[j], max_abs_S * 0.00001f);
+      }
+
+      std::for_each(G.re.begin(), G.re.end(),
+                    [&](float& a) { a = random_generator.Rand<float>(); });
+      std::for_each(G.im.begin(), G.im.end(),
+                    [&](float& a) { a = random_generator.Rand<float>(); });
+
+      AdaptPartitions_AVX2(*render_buffer, G, H_AVX2);
+      AdaptPartitions(*render_buffer, G, H_C);
+
+      for (size_t k = 0; k < H_C.size(); ++k) {
+        float max_abs_H = 0.f;
+        for (size_t j = 0; j < H_C[k].re.size(); ++j) {
+          max_abs_H =
+              std::max({max_abs_H, fabsf(H_C[k].re[j]), fabsf(H_C[k].im[j])});
+        }
+        for (size_t j = 0; j < H_C[k].re.size(); ++j) {
+          EXPECT_NEAR(H_C[k].re[j], H_AVX2[k].re[j], max_abs_H * 0.00001f);
+          EXPECT_NEAR(H_C[k].im[j], H_AVX2[k].im[j], max_abs_H * 0.00001f);
+        }
+      }
+    }
+  }
+}
+
+// Verifies that the AVX2 method for frequency response computation is similar
+// to the reference counterpart. With a fused multiply-add, the result may
+// differ in the last bit.
+TEST(AdaptiveFirFilter, UpdateFrequencyResponseAvx2Optimization) {
+  bool use_avx2 = (WebRtc_GetCPUInfo(kAVX2) != 0);
+  if (use_avx2) {
+    const size_t kNumPartitions = 12;
+    std::vector<FftData> H(kNumPartitions);
+    std::vector<std::array<float, kFftLengthBy2Plus1>> H2(kNumPartitions);
+    std::vector<std::array<float, kFftLengthBy2Plus1>> H2_AVX2(kNumPartitions);
+
+    for (size_t j = 0; j < H.size(); ++j) {
+      for (size_t k = 0; k < H[j].re.size(); ++k) {
+        H[j].re[k] = k + j / 3.f;
+        H[j].im[k] = j + k / 7.f;
+      }
+    }
+
+    UpdateFrequencyResponse(H, &H2);
+    UpdateFrequencyResponse_AVX2(H, &H2_AVX2);
+
+    for (size_t j = 0; j < H2.size(); ++j) {
+      for (size_t k = 0; k < H[j].re.size(); ++k) {
+        EXPECT_FLOAT_EQ(H2[j][k], H2_AVX2[j][k]);
+      }
+    }
+  }
+}
+
 #endif
 
+// Logs the time spent per call of each available variant of the filter
+// kernels.
+TEST(AdaptiveFirFilter, DISABLED_KernelPerf) {
+  constexpr int kNumCalls = 20000;
+  constexpr size_t kNumPartitions = 12;
+  constexpr int kSampleRateHz = 48000;
+  std::unique_ptr<RenderDelayBuffer> render_delay_buffer(
+      RenderDelayBuffer::Create(EchoCanceller3Config(), kSampleRateHz, 1));
+  Random random_generator(42U);
+  std::vector<std::vector<std::vector<float>>> x(
+      NumBandsForRate(kSampleRateHz),
+      std::vector<std::vector<float>>(1, std::vector<float>(kBlockSize, 0.f)));
+  for (size_t k = 0; k < 30; ++k) {
+    for (auto& band : x) {
+      RandomizeSampleVector(&random_generator, band[0]);
+    }
+    render_delay_buffer->Insert(x);
+    render_delay_buffer->PrepareCaptureProcessing();
+  }
+  const RenderBuffer& render_buffer = *render_delay_buffer->GetRenderBuffer();
+
+  FftData G;
+  std::for_each(G.re.begin(), G.re.end(),
+                [&](float& a) { a = random_generator.Rand<float>(); });
+  std::for_each(G.im.begin(), G.im.end(),
+                [&](float& a) { a = random_generator.Rand<float>(); });
+
+  struct Kernels {
+    const char* name;
+    decltype(&ApplyFilter) apply_filter;
+    decltype(&AdaptPartitions) adapt_partitions;
+    decltype(&UpdateFrequencyResponse) update_frequency_response;
+  };
+  std::vector<Kernels> variants = {
+      {"C", &ApplyFilter, &AdaptPartitions, &UpdateFrequencyResponse}};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    variants.push_back({"SSE2", &ApplyFilter_SSE2, &AdaptPartitions_SSE2,
+                        &UpdateFrequencyResponse_SSE2});
+  }
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    variants.push_back({"AVX2", &ApplyFilter_AVX2, &AdaptPartitions_AVX2,
+                        &UpdateFrequencyResponse_AVX2});
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  variants.push_back({"NEON", &ApplyFilter_NEON, &AdaptPartitions_NEON,
+                      &UpdateFrequencyResponse_NEON});
+#endif
+
+  for (const Kernels& kernels : variants) {
+    std::vector<FftData> H(kNumPartitions);
+    for (auto& H_j : H) {
+      H_j.Clear();
+    }
+    std::vector<std::array<float, kFftLengthBy2Plus1>> H2(kNumPartitions);
+    FftData S;
+
+    int64_t start_us = rtc::TimeMicros();
+    for (int k = 0; k < kNumCalls; ++k) {
+      kernels.adapt_partitions(render_buffer, G, H);
+    }
+    const int64_t adapt_us = rtc::TimeMicros() - start_us;
+
+    start_us = rtc::TimeMicros();
+    for (int k = 0; k < kNumCalls; ++k) {
+      kernels.apply_filter(render_buffer, H, &S);
+    }
+    const int64_t apply_us = rtc::TimeMicros() - start_us;
+
+    start_us = rtc::TimeMicros();
+    for (int k = 0; k < kNumCalls; ++k) {
+      kernels.update_frequency_response(H, &H2);
+    }
+    const int64_t update_us = rtc::TimeMicros() - start_us;
+
+    RTC_LOG(LS_INFO) << kernels.name
+                     << ": AdaptPartitions: " << adapt_us * 1000 / kNumCalls
+                     << " ns, ApplyFilter: " << apply_us * 1000 / kNumCalls
+                     << " ns, UpdateFrequencyResponse: "
+                     << update_us * 1000 / kNumCalls << " ns per call.";
+  }
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 // Verifies that the check for non-null data dumper works.
 TEST(AdaptiveFirFilter, NullDataDumper) {
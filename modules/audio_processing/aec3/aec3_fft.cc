@@ -72,6 +72,15 @@ const float kSqrtHanning128[kFftLength] = {
 
 }  // namespace
 
+Aec3Fft::Aec3Fft(Backend backend)
+    : pffft_(backend == Backend::kPffft
+                 ? std::make_unique<Pffft>(kFftLength, Pffft::FftType::kReal)
+                 : nullptr),
+      pffft_in_(pffft_ ? pffft_->CreateBuffer() : nullptr),
+      pffft_out_(pffft_ ? pffft_->CreateBuffer() : nullptr) {}
+
+Aec3Fft::~Aec3Fft() = default;
+
 // TODO(peah): Change x to be std::array once the rest of the code allows this.
 void Aec3Fft::ZeroPaddedFft(rtc::ArrayView<const float> x,
                             Window window,
@@ -130,4 +139,37 @@ void Aec3Fft::PaddedFft(rtc::ArrayView<const float> x,
   Fft(&fft, X);
 }
 
+// The ordered PFFFT output is packed like the Ooura output, but the Ooura FFT
+// computes the transform with the opposite sign of the exponent, and scales the
+// inverse transform by kFftLengthBy2 instead of by kFftLength.
+void Aec3Fft::PffftFft(const std::array<float, kFftLength>& x,
+                       FftData* X) const {
+  rtc::ArrayView<float> in = pffft_in_->GetView();
+  std::copy(x.begin(), x.end(), in.begin());
+  pffft_->ForwardTransform(*pffft_in_, pffft_out_.get(), /*ordered=*/true);
+  rtc::ArrayView<const float> out = pffft_out_->GetConstView();
+  X->re[0] = out[0];
+  X->re[kFftLengthBy2] = out[1];
+  X->im[0] = X->im[kFftLengthBy2] = 0.f;
+  for (size_t k = 1; k < kFftLengthBy2; ++k) {
+    X->re[k] = out[2 * k];
+    X->im[k] = -out[2 * k + 1];
+  }
+}
+
+void Aec3Fft::PffftIfft(const FftData& X,
+                        std::array<float, kFftLength>* x) const {
+  rtc::ArrayView<float> in = pffft_in_->GetView();
+  in[0] = X.re[0];
+  in[1] = X.re[kFftLengthBy2];
+  for (size_t k = 1; k < kFftLengthBy2; ++k) {
+    in[2 * k] = X.re[k];
+    in[2 * k + 1] = -X.im[k];
+  }
+  pffft_->BackwardTransform(*pffft_in_, pffft_out_.get(), /*ordered=*/true);
+  rtc::ArrayView<const float> out = pffft_out_->GetConstView();
+  std::transform(out.begin(), out.end(), x->begin(),
+                 [](float a) { return 0.5f * a; });
+}
+
 }  // namespace webrtc
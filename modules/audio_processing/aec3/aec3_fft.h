@@ -12,33 +12,49 @@
 #define MODULES_AUDIO_PROCESSING_AEC3_AEC3_FFT_H_
 
 #include <array>
+#include <memory>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "modules/audio_processing/utility/ooura_fft.h"
+#include "modules/audio_processing/utility/pffft_wrapper.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/constructor_magic.h"
 
 namespace webrtc {
 
 // Wrapper class that provides 128 point real valued FFT functionality with the
-// FftData type.
+// FftData type. Not thread safe when the PFFFT backend is used.
 class Aec3Fft {
  public:
   enum class Window { kRectangular, kHanning, kSqrtHanning };
+  // The Ooura FFT is the default. The PFFFT backend gives the same transforms
+  // up to rounding errors, so the results are not bitexact to the default.
+  enum class Backend { kOoura, kPffft };
+
+  Aec3Fft() : Aec3Fft(Backend::kOoura) {}
+  explicit Aec3Fft(Backend backend);
+  ~Aec3Fft();
 
-  Aec3Fft() = default;
   // Computes the FFT. Note that both the input and output are modified.
   void Fft(std::array<float, kFftLength>* x, FftData* X) const {
     RTC_DCHECK(x);
     RTC_DCHECK(X);
+    if (pffft_) {
+      PffftFft(*x, X);
+      return;
+    }
     ooura_fft_.Fft(x->data());
     X->CopyFromPackedArray(*x);
   }
   // Computes the inverse Fft.
   void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
     RTC_DCHECK(x);
+    if (pffft_) {
+      PffftIfft(X, x);
+      return;
+    }
     X.CopyToPackedArray(x);
     ooura_fft_.InverseFft(x->data());
   }
@@ -64,7 +80,14 @@ class Aec3Fft {
                  FftData* X) const;
 
  private:
+  void PffftFft(const std::array<float, kFftLength>& x, FftData* X) const;
+  void PffftIfft(const FftData& X, std::array<float, kFftLength>* x) const;
+
   const OouraFft ooura_fft_;
+  // Only set for the PFFFT backend.
+  const std::unique_ptr<Pffft> pffft_;
+  const std::unique_ptr<Pffft::FloatBuffer> pffft_in_;
+  const std::unique_ptr<Pffft::FloatBuffer> pffft_out_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(Aec3Fft);
 };
@@ -12,6 +12,9 @@
 
 #include <algorithm>
 
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -210,4 +213,55 @@ TEST(Aec3Fft, PaddedFft) {
   }
 }
 
+// Verifies that the PFFFT backend computes the same transforms as the Ooura
+// backend.
+TEST(Aec3Fft, PffftBackendMatchesOoura) {
+  Aec3Fft ooura_fft;
+  Aec3Fft pffft_fft(Aec3Fft::Backend::kPffft);
+  Random random(42);
+  FftData X;
+  FftData X_ref;
+  std::array<float, kFftLength> x;
+  std::array<float, kFftLength> x_ref;
+  for (int k = 0; k < 20; ++k) {
+    for (size_t j = 0; j < x.size(); ++j) {
+      x[j] = x_ref[j] = random.Rand(-1000, 1000);
+    }
+    pffft_fft.Fft(&x, &X);
+    ooura_fft.Fft(&x_ref, &X_ref);
+    for (size_t j = 0; j < X.re.size(); ++j) {
+      EXPECT_NEAR(X_ref.re[j], X.re[j], 0.1f);
+      EXPECT_NEAR(X_ref.im[j], X.im[j], 0.1f);
+    }
+
+    pffft_fft.Ifft(X, &x);
+    ooura_fft.Ifft(X, &x_ref);
+    for (size_t j = 0; j < x.size(); ++j) {
+      EXPECT_NEAR(x_ref[j], x[j], 1.f);
+    }
+  }
+}
+
+// Logs the time per transform pair of the two backends.
+TEST(Aec3Fft, DISABLED_BackendPerf) {
+  constexpr int kNumIterations = 100000;
+  for (auto backend : {Aec3Fft::Backend::kOoura, Aec3Fft::Backend::kPffft}) {
+    Aec3Fft fft(backend);
+    FftData X;
+    std::array<float, kFftLength> x;
+    x.fill(1.f);
+    int64_t start_us = rtc::TimeMicros();
+    for (int k = 0; k < kNumIterations; ++k) {
+      fft.Fft(&x, &X);
+      fft.Ifft(X, &x);
+      // Keep the values bounded.
+      std::for_each(x.begin(), x.end(), [](float& a) { a *= 1.f / 64.f; });
+    }
+    RTC_LOG(LS_INFO) << (backend == Aec3Fft::Backend::kOoura ? "Ooura: "
+                                                              : "PFFFT: ")
+                     << (rtc::TimeMicros() - start_us) * 1000 / kNumIterations
+                     << " ns per Fft and Ifft.";
+  }
+}
+
 }  // namespace webrtc
@@ -24,8 +24,10 @@
 #include "modules/audio_processing/aec3/render_delay_buffer.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "modules/audio_processing/test/echo_canceller_test_tools.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
@@ -133,8 +135,96 @@ TEST(MatchedFilter, TestSse2Optimizations) {
   }
 }
 
+// Verifies that the optimized methods for AVX2 are similar to their reference
+// counterparts. The AVX2 core uses fused multiply-adds and accumulates in a
+// different order, so it is not bitexact.
+TEST(MatchedFilter, TestAvx2Optimizations) {
+  bool use_avx2 = (WebRtc_GetCPUInfo(kAVX2) != 0);
+  if (use_avx2) {
+    Random random_generator(42U);
+    constexpr float kSmoothing = 0.7f;
+    for (auto down_sampling_factor : kDownSamplingFactors) {
+      const size_t sub_block_size = kBlockSize / down_sampling_factor;
+      std::vector<float> x(2000);
+      RandomizeSampleVector(&random_generator, x);
+      std::vector<float> y(sub_block_size);
+      std::vector<float> h_AVX2(512);
+      std::vector<float> h(512);
+      int x_index = 0;
+      for (int k = 0; k < 1000; ++k) {
+        RandomizeSampleVector(&random_generator, y);
+
+        bool filters_updated = false;
+        float error_sum = 0.f;
+        bool filters_updated_AVX2 = false;
+        float error_sum_AVX2 = 0.f;
+
+        MatchedFilterCore_AVX2(x_index, h.size() * 150.f * 150.f, kSmoothing, x,
+                               y, h_AVX2, &filters_updated_AVX2,
+                               &error_sum_AVX2);
+
+        MatchedFilterCore(x_index, h.size() * 150.f * 150.f, kSmoothing, x, y,
+                          h, &filters_updated, &error_sum);
+
+        EXPECT_EQ(filters_updated, filters_updated_AVX2);
+        EXPECT_NEAR(error_sum, error_sum_AVX2, error_sum / 100000.f);
+
+        for (size_t j = 0; j < h.size(); ++j) {
+          EXPECT_NEAR(h[j], h_AVX2[j], 0.00001f);
+        }
+
+        x_index = (x_index + sub_block_size) % x.size();
+      }
+    }
+  }
+}
+
+#endif
+
+// Logs the time spent per call of each available matched filter core.
+TEST(MatchedFilter, DISABLED_MatchedFilterCorePerf) {
+  constexpr int kNumCalls = 100000;
+  constexpr float kSmoothing = 0.7f;
+  constexpr size_t kSubBlockSize = kBlockSize / 4;
+  Random random_generator(42U);
+  std::vector<float> x(2000);
+  RandomizeSampleVector(&random_generator, x);
+  std::vector<float> y(kSubBlockSize);
+  RandomizeSampleVector(&random_generator, y);
+  std::vector<float> h(kWindowSizeSubBlocks * kSubBlockSize);
+
+  struct Core {
+    const char* name;
+    decltype(&MatchedFilterCore) function;
+  };
+  std::vector<Core> cores = {{"C", &MatchedFilterCore}};
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0)
+    cores.push_back({"SSE2", &MatchedFilterCore_SSE2});
+  if (WebRtc_GetCPUInfo(kAVX2) != 0)
+    cores.push_back({"AVX2", &MatchedFilterCore_AVX2});
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  cores.push_back({"NEON", &MatchedFilterCore_NEON});
 #endif
 
+  for (const Core& core : cores) {
+    std::fill(h.begin(), h.end(), 0.f);
+    size_t x_index = 0;
+    float error_sum = 0.f;
+    bool filters_updated = false;
+    const int64_t start_us = rtc::TimeMicros();
+    for (int k = 0; k < kNumCalls; ++k) {
+      core.function(x_index, 0.f, kSmoothing, x, y, h, &filters_updated,
+                    &error_sum);
+      x_index = (x_index + kSubBlockSize) % x.size();
+    }
+    const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+    RTC_LOG(LS_INFO) << core.name << ": " << elapsed_us * 1000 / kNumCalls
+                     << " ns per call.";
+  }
+}
+
 // Verifies that the matched filter produces proper lag estimates for
 // artificially
 // delayed signals.
@@ -43,7 +43,8 @@ class VectorMath {
   void Sqrt(rtc::ArrayView<float> x) {
     switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-      case Aec3Optimization::kSse2: {
+      case Aec3Optimization::kSse2:
+      case Aec3Optimization::kAvx2: {
         const int x_size = static_cast<int>(x.size());
         const int vector_limit = x_size >> 2;
 
@@ -117,7 +118,8 @@ class VectorMath {
     RTC_DCHECK_EQ(z.size(), y.size());
     switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-      case Aec3Optimization::kSse2: {
+      case Aec3Optimization::kSse2:
+      case Aec3Optimization::kAvx2: {
         const int x_size = static_cast<int>(x.size());
         const int vector_limit = x_size >> 2;
 
@@ -163,7 +165,8 @@ class VectorMath {
     RTC_DCHECK_EQ(z.size(), x.size());
     switch (optimization_) {
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-      case Aec3Optimization::kSse2: {
+      case Aec3Optimization::kSse2:
+      case Aec3Optimization::kAvx2: {
         const int x_size = static_cast<int>(x.size());
         const int vector_limit = x_size >> 2;
 
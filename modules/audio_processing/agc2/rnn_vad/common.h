@@ -63,6 +63,11 @@ static_assert(kCepstralCoeffsHistorySize > 2,
 
 constexpr size_t kFeatureVectorSize = 42;
 
+enum class Optimization { kNone, kSse2, kAvx2, kNeon };
+
+// Detects what kind of optimizations to use for the code.
+Optimization DetectOptimization();
+
 }  // namespace rnn_vad
 }  // namespace webrtc
 
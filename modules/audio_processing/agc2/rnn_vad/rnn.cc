@@ -10,6 +10,16 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 
+// Defines WEBRTC_ARCH_X86_FAMILY, used below.
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 #include <algorithm>
 #include <array>
 #include <cmath>
@@ -48,17 +58,103 @@ using rnnoise::RectifiedLinearUnit;
 using rnnoise::SigmoidApproximated;
 using rnnoise::TansigApproximated;
 
+namespace {
+
+std::vector<float> ConvertWeights(rtc::ArrayView<const int8_t> weights) {
+  return std::vector<float>(weights.begin(), weights.end());
+}
+
+void AddWeightedInputsOptimized(Optimization optimization,
+                                rtc::ArrayView<const float> input,
+                                const float* weights,
+                                size_t stride,
+                                rtc::ArrayView<float> output) {
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Optimization::kSse2:
+      AddWeightedInputs_SSE2(input, weights, stride, output);
+      break;
+    case Optimization::kAvx2:
+      AddWeightedInputs_AVX2(input, weights, stride, output);
+      break;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+    case Optimization::kNeon:
+      AddWeightedInputs_NEON(input, weights, stride, output);
+      break;
+#endif
+    default:
+      AddWeightedInputs(input, weights, stride, output);
+  }
+}
+
+}  // namespace
+
+void AddWeightedInputs(rtc::ArrayView<const float> input,
+                       const float* weights,
+                       size_t stride,
+                       rtc::ArrayView<float> output) {
+  for (size_t o = 0; o < output.size(); ++o) {
+    for (size_t i = 0; i < input.size(); ++i) {
+      output[o] += input[i] * weights[i * stride + o];
+    }
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void AddWeightedInputs_SSE2(rtc::ArrayView<const float> input,
+                            const float* weights,
+                            size_t stride,
+                            rtc::ArrayView<float> output) {
+  // Compute four outputs at a time. Each lane adds the products in the same
+  // order as AddWeightedInputs(), which makes the result bitexact.
+  const size_t vector_limit = output.size() & ~static_cast<size_t>(3);
+  for (size_t o = 0; o < vector_limit; o += 4) {
+    __m128 sums = _mm_loadu_ps(&output[o]);
+    for (size_t i = 0; i < input.size(); ++i) {
+      const __m128 w = _mm_loadu_ps(&weights[i * stride + o]);
+      sums = _mm_add_ps(sums, _mm_mul_ps(_mm_set1_ps(input[i]), w));
+    }
+    _mm_storeu_ps(&output[o], sums);
+  }
+  AddWeightedInputs(input, weights + vector_limit, stride,
+                    output.subview(vector_limit));
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void AddWeightedInputs_NEON(rtc::ArrayView<const float> input,
+                            const float* weights,
+                            size_t stride,
+                            rtc::ArrayView<float> output) {
+  // Compute four outputs at a time, see AddWeightedInputs_SSE2().
+  const size_t vector_limit = output.size() & ~static_cast<size_t>(3);
+  for (size_t o = 0; o < vector_limit; o += 4) {
+    float32x4_t sums = vld1q_f32(&output[o]);
+    for (size_t i = 0; i < input.size(); ++i) {
+      const float32x4_t w = vld1q_f32(&weights[i * stride + o]);
+      sums = vaddq_f32(sums, vmulq_n_f32(w, input[i]));
+    }
+    vst1q_f32(&output[o], sums);
+  }
+  AddWeightedInputs(input, weights + vector_limit, stride,
+                    output.subview(vector_limit));
+}
+#endif
+
 FullyConnectedLayer::FullyConnectedLayer(
     const size_t input_size,
     const size_t output_size,
     const rtc::ArrayView<const int8_t> bias,
     const rtc::ArrayView<const int8_t> weights,
-    float (*const activation_function)(float))
+    float (*const activation_function)(float),
+    Optimization optimization)
     : input_size_(input_size),
       output_size_(output_size),
       bias_(bias),
-      weights_(weights),
-      activation_function_(activation_function) {
+      weights_(ConvertWeights(weights)),
+      activation_function_(activation_function),
+      optimization_(optimization) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayersMaxUnits)
       << "Static over-allocation of fully-connected layers output vectors is "
          "not sufficient.";
@@ -75,16 +171,13 @@ rtc::ArrayView<const float> FullyConnectedLayer::GetOutput() const {
 }
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
-  for (size_t o = 0; o < output_size_; ++o) {
-    output_[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| change the performance across different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {
-      output_[o] += input[i] * weights_[i * output_size_ + o];
-    }
-    output_[o] = (*activation_function_)(kWeightsScale * output_[o]);
+  RTC_DCHECK_EQ(input_size_, input.size());
+  rtc::ArrayView<float> output(output_.data(), output_size_);
+  std::copy(bias_.begin(), bias_.end(), output.begin());
+  AddWeightedInputsOptimized(optimization_, input, weights_.data(),
+                             output_size_, output);
+  for (float& y : output) {
+    y = (*activation_function_)(kWeightsScale * y);
   }
 }
 
@@ -94,13 +187,15 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> bias,
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
-    float (*const activation_function)(float))
+    float (*const activation_function)(float),
+    Optimization optimization)
     : input_size_(input_size),
       output_size_(output_size),
       bias_(bias),
-      weights_(weights),
-      recurrent_weights_(recurrent_weights),
-      activation_function_(activation_function) {
+      weights_(ConvertWeights(weights)),
+      recurrent_weights_(ConvertWeights(recurrent_weights)),
+      activation_function_(activation_function),
+      optimization_(optimization) {
   RTC_DCHECK_LE(output_size_, kRecurrentLayersMaxUnits)
       << "Static over-allocation of recurrent layers state vectors is not "
       << "sufficient.";
@@ -125,58 +220,59 @@ void GatedRecurrentLayer::Reset() {
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
-  // TODO(bugs.chromium.org/9076): Optimize using SSE/AVX fused multiply-add
-  // operations.
+  RTC_DCHECK_EQ(input_size_, input.size());
   // Stride and offset used to read parameter arrays.
   const size_t stride = 3 * output_size_;
   size_t offset = 0;
+  rtc::ArrayView<const float> state(state_.data(), output_size_);
 
   // Compute update gates.
-  std::array<float, kRecurrentLayersMaxUnits> update;
-  for (size_t o = 0; o < output_size_; ++o) {
-    update[o] = bias_[o];
-    // TODO(bugs.chromium.org/9076): Benchmark how different layouts for
-    // |weights_| and |recurrent_weights_| change the performance across
-    // different platforms.
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      update[o] += input[i] * weights_[i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {
-      update[o] += state_[s] * recurrent_weights_[s * stride + o];
-    }  // Add state.
-    update[o] = SigmoidApproximated(kWeightsScale * update[o]);
+  std::array<float, kRecurrentLayersMaxUnits> update_storage;
+  rtc::ArrayView<float> update(update_storage.data(), output_size_);
+  std::copy(bias_.begin(), bias_.begin() + output_size_, update.begin());
+  AddWeightedInputsOptimized(optimization_, input, weights_.data(), stride,
+                             update);
+  AddWeightedInputsOptimized(optimization_, state, recurrent_weights_.data(),
+                             stride, update);
+  for (float& z : update) {
+    z = SigmoidApproximated(kWeightsScale * z);
   }
 
   // Compute reset gates.
   offset += output_size_;
-  std::array<float, kRecurrentLayersMaxUnits> reset;
-  for (size_t o = 0; o < output_size_; ++o) {
-    reset[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      reset[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_; ++s) {  // Add state.
-      reset[o] += state_[s] * recurrent_weights_[offset + s * stride + o];
-    }
-    reset[o] = SigmoidApproximated(kWeightsScale * reset[o]);
+  std::array<float, kRecurrentLayersMaxUnits> reset_storage;
+  rtc::ArrayView<float> reset(reset_storage.data(), output_size_);
+  std::copy(bias_.begin() + offset, bias_.begin() + offset + output_size_,
+            reset.begin());
+  AddWeightedInputsOptimized(optimization_, input, weights_.data() + offset,
+                             stride, reset);
+  AddWeightedInputsOptimized(optimization_, state,
+                             recurrent_weights_.data() + offset, stride, reset);
+  for (float& r : reset) {
+    r = SigmoidApproximated(kWeightsScale * r);
   }
 
   // Compute output.
   offset += output_size_;
-  std::array<float, kRecurrentLayersMaxUnits> output;
+  std::array<float, kRecurrentLayersMaxUnits> output_storage;
+  rtc::ArrayView<float> output(output_storage.data(), output_size_);
+  std::copy(bias_.begin() + offset, bias_.begin() + offset + output_size_,
+            output.begin());
+  AddWeightedInputsOptimized(optimization_, input, weights_.data() + offset,
+                             stride, output);
+  // Add state through reset gates.
+  std::array<float, kRecurrentLayersMaxUnits> reset_state_storage;
+  rtc::ArrayView<float> reset_state(reset_state_storage.data(), output_size_);
+  for (size_t s = 0; s < output_size_; ++s) {
+    reset_state[s] = state[s] * reset[s];
+  }
+  AddWeightedInputsOptimized(optimization_, reset_state,
+                             recurrent_weights_.data() + offset, stride,
+                             output);
   for (size_t o = 0; o < output_size_; ++o) {
-    output[o] = bias_[offset + o];
-    for (size_t i = 0; i < input_size_; ++i) {  // Add input.
-      output[o] += input[i] * weights_[offset + i * stride + o];
-    }
-    for (size_t s = 0; s < output_size_;
-         ++s) {  // Add state through reset gates.
-      output[o] +=
-          state_[s] * recurrent_weights_[offset + s * stride + o] * reset[s];
-    }
     output[o] = (*activation_function_)(kWeightsScale * output[o]);
     // Update output through the update gates.
-    output[o] = update[o] * state_[o] + (1.f - update[o]) * output[o];
+    output[o] = update[o] * state[o] + (1.f - update[o]) * output[o];
   }
 
   // Update the state. Not done in the previous loop since that would pollute
@@ -184,23 +280,28 @@ void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
   std::copy(output.begin(), output.end(), state_.begin());
 }
 
-RnnBasedVad::RnnBasedVad()
+RnnBasedVad::RnnBasedVad() : RnnBasedVad(DetectOptimization()) {}
+
+RnnBasedVad::RnnBasedVad(Optimization optimization)
     : input_layer_(kInputLayerInputSize,
                    kInputLayerOutputSize,
                    kInputDenseBias,
                    kInputDenseWeights,
-                   TansigApproximated),
+                   TansigApproximated,
+                   optimization),
       hidden_layer_(kInputLayerOutputSize,
                     kHiddenLayerOutputSize,
                     kHiddenGruBias,
                     kHiddenGruWeights,
                     kHiddenGruRecurrentWeights,
-                    RectifiedLinearUnit),
+                    RectifiedLinearUnit,
+                    optimization),
       output_layer_(kHiddenLayerOutputSize,
                     kOutputLayerOutputSize,
                     kOutputDenseBias,
                     kOutputDenseWeights,
-                    SigmoidApproximated) {
+                    SigmoidApproximated,
+                    optimization) {
   // Input-output chaining size checks.
   RTC_DCHECK_EQ(input_layer_.output_size(), hidden_layer_.input_size())
       << "The input and the hidden layers sizes do not match.";
@@ -15,9 +15,11 @@
 #include <sys/types.h>
 
 #include <array>
+#include <vector>
 
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
+#include "rtc_base/system/arch.h"
 
 namespace webrtc {
 namespace rnn_vad {
@@ -34,6 +36,30 @@ constexpr size_t kFullyConnectedLayersMaxUnits = 24;
 // recurrent layer.
 constexpr size_t kRecurrentLayersMaxUnits = 24;
 
+// Adds the weighted |input| values to each |output| value, where the weights
+// for |output|[o] are |weights|[i * stride + o] for each input i. The weights
+// of an input are contiguous, so that several outputs are computed at once.
+void AddWeightedInputs(rtc::ArrayView<const float> input,
+                       const float* weights,
+                       size_t stride,
+                       rtc::ArrayView<float> output);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void AddWeightedInputs_SSE2(rtc::ArrayView<const float> input,
+                            const float* weights,
+                            size_t stride,
+                            rtc::ArrayView<float> output);
+void AddWeightedInputs_AVX2(rtc::ArrayView<const float> input,
+                            const float* weights,
+                            size_t stride,
+                            rtc::ArrayView<float> output);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void AddWeightedInputs_NEON(rtc::ArrayView<const float> input,
+                            const float* weights,
+                            size_t stride,
+                            rtc::ArrayView<float> output);
+#endif
+
 // Fully-connected layer.
 class FullyConnectedLayer {
  public:
@@ -41,7 +67,8 @@ class FullyConnectedLayer {
                       const size_t output_size,
                       const rtc::ArrayView<const int8_t> bias,
                       const rtc::ArrayView<const int8_t> weights,
-                      float (*const activation_function)(float));
+                      float (*const activation_function)(float),
+                      Optimization optimization);
   FullyConnectedLayer(const FullyConnectedLayer&) = delete;
   FullyConnectedLayer& operator=(const FullyConnectedLayer&) = delete;
   ~FullyConnectedLayer();
@@ -55,8 +82,10 @@ class FullyConnectedLayer {
   const size_t input_size_;
   const size_t output_size_;
   const rtc::ArrayView<const int8_t> bias_;
-  const rtc::ArrayView<const int8_t> weights_;
+  // The weights converted to float once, for the vectorized computation.
+  const std::vector<float> weights_;
   float (*const activation_function_)(float);
+  const Optimization optimization_;
   // The output vector of a recurrent layer has length equal to |output_size_|.
   // However, for efficiency, over-allocation is used.
   std::array<float, kFullyConnectedLayersMaxUnits> output_;
@@ -70,7 +99,8 @@ class GatedRecurrentLayer {
                       const rtc::ArrayView<const int8_t> bias,
                       const rtc::ArrayView<const int8_t> weights,
                       const rtc::ArrayView<const int8_t> recurrent_weights,
-                      float (*const activation_function)(float));
+                      float (*const activation_function)(float),
+                      Optimization optimization);
   GatedRecurrentLayer(const GatedRecurrentLayer&) = delete;
   GatedRecurrentLayer& operator=(const GatedRecurrentLayer&) = delete;
   ~GatedRecurrentLayer();
@@ -85,9 +115,11 @@ class GatedRecurrentLayer {
   const size_t input_size_;
   const size_t output_size_;
   const rtc::ArrayView<const int8_t> bias_;
-  const rtc::ArrayView<const int8_t> weights_;
-  const rtc::ArrayView<const int8_t> recurrent_weights_;
+  // The weights converted to float once, for the vectorized computation.
+  const std::vector<float> weights_;
+  const std::vector<float> recurrent_weights_;
   float (*const activation_function_)(float);
+  const Optimization optimization_;
   // The state vector of a recurrent layer has length equal to |output_size_|.
   // However, to avoid dynamic allocation, over-allocation is used.
   std::array<float, kRecurrentLayersMaxUnits> state_;
@@ -97,6 +129,7 @@ class GatedRecurrentLayer {
 class RnnBasedVad {
  public:
   RnnBasedVad();
+  explicit RnnBasedVad(Optimization optimization);
   RnnBasedVad(const RnnBasedVad&) = delete;
   RnnBasedVad& operator=(const RnnBasedVad&) = delete;
   ~RnnBasedVad();
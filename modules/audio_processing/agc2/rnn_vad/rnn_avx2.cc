@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/agc2/rnn_vad/rnn.h"
+
+namespace webrtc {
+namespace rnn_vad {
+
+void AddWeightedInputs_AVX2(rtc::ArrayView<const float> input,
+                            const float* weights,
+                            size_t stride,
+                            rtc::ArrayView<float> output) {
+  // Compute eight outputs at a time. Unlike AddWeightedInputs_SSE2(), fused
+  // multiply-adds are used, so the result is not bitexact.
+  const size_t vector_limit = output.size() & ~static_cast<size_t>(7);
+  for (size_t o = 0; o < vector_limit; o += 8) {
+    __m256 sums = _mm256_loadu_ps(&output[o]);
+    for (size_t i = 0; i < input.size(); ++i) {
+      const __m256 w = _mm256_loadu_ps(&weights[i * stride + o]);
+      sums = _mm256_fmadd_ps(_mm256_set1_ps(input[i]), w, sums);
+    }
+    _mm256_storeu_ps(&output[o], sums);
+  }
+  AddWeightedInputs_SSE2(input, weights + vector_limit, stride,
+                         output.subview(vector_limit));
+}
+
+}  // namespace rnn_vad
+}  // namespace webrtc
@@ -117,6 +117,7 @@ void AudioBuffer::CopyFrom(const float* const* data,
   RTC_DCHECK_EQ(stream_config.num_frames(), input_num_frames_);
   RTC_DCHECK_EQ(stream_config.num_channels(), input_num_channels_);
   RestoreNumChannels();
+  InvalidateS16Bands();
   const bool downmix_needed = input_num_channels_ > 1 && num_channels_ == 1;
 
   const bool resampling_needed = input_num_frames_ != buffer_num_frames_;
@@ -165,6 +166,7 @@ void AudioBuffer::CopyFrom(const float* const* data,
 void AudioBuffer::CopyTo(const StreamConfig& stream_config,
                          float* const* data) {
   RTC_DCHECK_EQ(stream_config.num_frames(), output_num_frames_);
+  PrepareFloatWrite();
 
   const bool resampling_needed = output_num_frames_ != buffer_num_frames_;
   if (resampling_needed) {
@@ -207,6 +209,7 @@ void AudioBuffer::CopyFrom(const AudioFrame* frame) {
   RTC_DCHECK_EQ(frame->num_channels_, input_num_channels_);
   RTC_DCHECK_EQ(frame->samples_per_channel_, input_num_frames_);
   RestoreNumChannels();
+  InvalidateS16Bands();
 
   const bool resampling_required = input_num_frames_ != buffer_num_frames_;
 
@@ -278,6 +281,7 @@ void AudioBuffer::CopyFrom(const AudioFrame* frame) {
 void AudioBuffer::CopyTo(AudioFrame* frame) const {
   RTC_DCHECK(frame->num_channels_ == num_channels_ || num_channels_ == 1);
   RTC_DCHECK_EQ(frame->samples_per_channel_, output_num_frames_);
+  PrepareFloatRead();
 
   const bool resampling_required = buffer_num_frames_ != output_num_frames_;
 
@@ -340,13 +344,73 @@ void AudioBuffer::CopyTo(AudioFrame* frame) const {
 }
 
 void AudioBuffer::SplitIntoFrequencyBands() {
+  PrepareFloatWrite();
   splitting_filter_->Analysis(data_.get(), split_data_.get());
 }
 
 void AudioBuffer::MergeFrequencyBands() {
+  PrepareFloatWrite();
   splitting_filter_->Synthesis(split_data_.get(), data_.get());
 }
 
+const int16_t* const* AudioBuffer::split_bands_const_s16(
+    size_t channel) const {
+  RTC_DCHECK_LT(channel, num_channels_);
+  if (!split_data_s16_ || s16_states_[channel] == S16State::kStale) {
+    ExportS16Bands(channel);
+  }
+  return split_data_s16_->bands(channel);
+}
+
+int16_t* const* AudioBuffer::split_bands_s16(size_t channel) {
+  split_bands_const_s16(channel);
+  s16_states_[channel] = S16State::kNewer;
+  s16_newer_ = true;
+  return split_data_s16_->bands(channel);
+}
+
+void AudioBuffer::ExportS16Bands(size_t channel) const {
+  if (!split_data_s16_) {
+    split_data_s16_.reset(new ChannelBuffer<int16_t>(
+        buffer_num_frames_, buffer_num_channels_, num_bands_));
+    s16_states_.assign(buffer_num_channels_, S16State::kStale);
+  }
+  const float* const* bands =
+      split_data_ ? split_data_->bands(channel) : data_->bands(channel);
+  int16_t* const* bands_s16 = split_data_s16_->bands(channel);
+  for (size_t k = 0; k < num_bands_; ++k) {
+    FloatS16ToS16(bands[k], num_split_frames_, bands_s16[k]);
+  }
+  s16_states_[channel] = S16State::kValid;
+  s16_valid_ = true;
+}
+
+void AudioBuffer::ImportS16Bands() const {
+  RTC_DCHECK(split_data_s16_);
+  for (size_t channel = 0; channel < s16_states_.size(); ++channel) {
+    if (s16_states_[channel] != S16State::kNewer) {
+      continue;
+    }
+    float* const* bands =
+        split_data_ ? split_data_->bands(channel) : data_->bands(channel);
+    const int16_t* const* bands_s16 = split_data_s16_->bands(channel);
+    for (size_t k = 0; k < num_bands_; ++k) {
+      S16ToFloatS16(bands_s16[k], num_split_frames_, bands[k]);
+    }
+    s16_states_[channel] = S16State::kValid;
+  }
+  s16_newer_ = false;
+}
+
+void AudioBuffer::InvalidateS16Bands() {
+  if (!s16_valid_) {
+    return;
+  }
+  s16_states_.assign(s16_states_.size(), S16State::kStale);
+  s16_valid_ = false;
+  s16_newer_ = false;
+}
+
 void AudioBuffer::ExportSplitChannelData(size_t channel,
                                          int16_t* const* split_band_data) {
   for (size_t k = 0; k < num_bands(); ++k) {
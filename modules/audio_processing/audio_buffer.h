@@ -74,8 +74,14 @@ class AudioBuffer {
   // Where:
   // 0 <= channel < |buffer_num_channels_|
   // 0 <= sample < |buffer_num_frames_|
-  float* const* channels() { return data_->channels(); }
-  const float* const* channels_const() const { return data_->channels(); }
+  float* const* channels() {
+    PrepareFloatWrite();
+    return data_->channels();
+  }
+  const float* const* channels_const() const {
+    PrepareFloatRead();
+    return data_->channels();
+  }
 
   // Returns pointer arrays to the bands for a specific channel.
   // Usage:
@@ -85,14 +91,25 @@ class AudioBuffer {
   // 0 <= band < |num_bands_|
   // 0 <= sample < |num_split_frames_|
   const float* const* split_bands_const(size_t channel) const {
+    PrepareFloatRead();
     return split_data_.get() ? split_data_->bands(channel)
                              : data_->bands(channel);
   }
   float* const* split_bands(size_t channel) {
+    PrepareFloatWrite();
     return split_data_.get() ? split_data_->bands(channel)
                              : data_->bands(channel);
   }
 
+  // Same as split_bands() and split_bands_const(), but in 16-bit integers for
+  // the fixed-point submodules. The integer bands are kept alongside the float
+  // ones and only converted when the other format is next accessed, so that
+  // consecutive fixed-point submodules share a single conversion each way.
+  // Pointers returned by either format are invalidated by an access to the
+  // other format.
+  const int16_t* const* split_bands_const_s16(size_t channel) const;
+  int16_t* const* split_bands_s16(size_t channel);
+
   // Returns a pointer array to the channels for a specific band.
   // Usage:
   // split_channels(band)[channel][sample].
@@ -101,6 +118,7 @@ class AudioBuffer {
   // 0 <= channel < |buffer_num_channels_|
   // 0 <= sample < |num_split_frames_|
   const float* const* split_channels_const(Band band) const {
+    PrepareFloatRead();
     if (split_data_.get()) {
       return split_data_->channels(band);
     } else {
@@ -151,6 +169,22 @@ class AudioBuffer {
                            SetNumChannelsSetsChannelBuffersNumChannels);
   void RestoreNumChannels();
 
+  // State of the 16-bit split bands of a channel relative to the float ones.
+  enum class S16State { kStale, kValid, kNewer };
+
+  void PrepareFloatRead() const {
+    if (s16_newer_)
+      ImportS16Bands();
+  }
+  void PrepareFloatWrite() {
+    PrepareFloatRead();
+    if (s16_valid_)
+      InvalidateS16Bands();
+  }
+  void ExportS16Bands(size_t channel) const;
+  void ImportS16Bands() const;
+  void InvalidateS16Bands();
+
   const size_t input_num_frames_;
   const size_t input_num_channels_;
   const size_t buffer_num_frames_;
@@ -164,6 +198,12 @@ class AudioBuffer {
 
   std::unique_ptr<ChannelBuffer<float>> data_;
   std::unique_ptr<ChannelBuffer<float>> split_data_;
+  // Allocated on the first use of the 16-bit split bands.
+  mutable std::unique_ptr<ChannelBuffer<int16_t>> split_data_s16_;
+  mutable std::vector<S16State> s16_states_;
+  // Whether any channel is in the kValid or kNewer, resp. kNewer, state.
+  mutable bool s16_valid_ = false;
+  mutable bool s16_newer_ = false;
   std::unique_ptr<SplittingFilter> splitting_filter_;
   std::unique_ptr<ChannelBuffer<float>> output_buffer_;
   std::vector<std::unique_ptr<PushSincResampler>> input_resamplers_;
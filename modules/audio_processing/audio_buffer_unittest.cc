@@ -36,6 +36,28 @@ TEST(AudioBufferTest, SetNumChannelsSetsChannelBuffersNumChannels) {
   ExpectNumChannels(ab, kStereo);
 }
 
+TEST(AudioBufferTest, S16SplitBandsAreSyncedWithFloatSplitBands) {
+  constexpr size_t kRate16kHz = 16000u;
+  AudioBuffer ab(kRate16kHz, kMono, kRate16kHz, kMono, kRate16kHz, kMono);
+  ab.channels()[0][0] = 1.4f;
+  ab.channels()[0][1] = -2.6f;
+
+  const int16_t* const* bands_s16 = ab.split_bands_const_s16(0);
+  EXPECT_EQ(1, bands_s16[0][0]);
+  EXPECT_EQ(-3, bands_s16[0][1]);
+  // Reading the integer bands leaves the float ones untouched.
+  EXPECT_EQ(1.4f, ab.split_bands_const(0)[0][0]);
+
+  ab.split_bands_s16(0)[0][0] = 100;
+  ab.split_bands_s16(0)[0][1] *= 2;
+  EXPECT_EQ(100.f, ab.split_bands_const(0)[0][0]);
+  EXPECT_EQ(-6.f, ab.split_bands_const(0)[0][1]);
+
+  // Writing the float bands makes the integer ones convert again.
+  ab.split_bands(0)[0][0] = 7.f;
+  EXPECT_EQ(7, ab.split_bands_const_s16(0)[0][0]);
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 TEST(AudioBufferTest, SetNumChannelsDeathTest) {
   AudioBuffer ab(kSampleRateHz, kMono, kSampleRateHz, kMono, kSampleRateHz,
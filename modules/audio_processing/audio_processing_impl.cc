@@ -1075,10 +1075,8 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
                                                 num_reverse_channels(),
                                                 &aec_render_queue_buffer_);
 
-    if (!aec_render_signal_queue_->Insert(&aec_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
+    if (!aec_render_signal_queue_->Insert(&aec_render_queue_buffer_) &&
+        HandleRenderQueueOverrun()) {
       // Retry the insert (should always work).
       bool result = aec_render_signal_queue_->Insert(&aec_render_queue_buffer_);
       RTC_DCHECK(result);
@@ -1091,10 +1089,8 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
                                                  &aecm_render_queue_buffer_);
     RTC_DCHECK(aecm_render_signal_queue_);
     // Insert the samples into the queue.
-    if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
+    if (!aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_) &&
+        HandleRenderQueueOverrun()) {
       // Retry the insert (should always work).
       bool result =
           aecm_render_signal_queue_->Insert(&aecm_render_queue_buffer_);
@@ -1105,10 +1101,8 @@ void AudioProcessingImpl::QueueBandedRenderAudio(AudioBuffer* audio) {
   if (!constants_.use_experimental_agc) {
     GainControlImpl::PackRenderAudioBuffer(audio, &agc_render_queue_buffer_);
     // Insert the samples into the queue.
-    if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_)) {
-      // The data queue is full and needs to be emptied.
-      EmptyQueuedRenderAudio();
-
+    if (!agc_render_signal_queue_->Insert(&agc_render_queue_buffer_) &&
+        HandleRenderQueueOverrun()) {
       // Retry the insert (should always work).
       bool result = agc_render_signal_queue_->Insert(&agc_render_queue_buffer_);
       RTC_DCHECK(result);
@@ -1120,16 +1114,26 @@ void AudioProcessingImpl::QueueNonbandedRenderAudio(AudioBuffer* audio) {
   ResidualEchoDetector::PackRenderAudioBuffer(audio, &red_render_queue_buffer_);
 
   // Insert the samples into the queue.
-  if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_)) {
-    // The data queue is full and needs to be emptied.
-    EmptyQueuedRenderAudio();
-
+  if (!red_render_signal_queue_->Insert(&red_render_queue_buffer_) &&
+      HandleRenderQueueOverrun()) {
     // Retry the insert (should always work).
     bool result = red_render_signal_queue_->Insert(&red_render_queue_buffer_);
     RTC_DCHECK(result);
   }
 }
 
+bool AudioProcessingImpl::HandleRenderQueueOverrun() {
+  render_queue_overruns_.fetch_add(1, std::memory_order_relaxed);
+  if (config_.pipeline.drop_render_audio_on_queue_overrun) {
+    // Emptying the queues needs the capture lock, which the render side must
+    // not wait for.
+    return false;
+  }
+  // The data queue is full and needs to be emptied.
+  EmptyQueuedRenderAudio();
+  return true;
+}
+
 void AudioProcessingImpl::AllocateRenderQueue() {
   const size_t new_agc_render_queue_element_max_size =
       std::max(static_cast<size_t>(1), kMaxAllowedValuesOfSamplesPerBand);
@@ -1783,10 +1787,12 @@ void AudioProcessingImpl::DetachPlayoutAudioGenerator() {
 AudioProcessingStats AudioProcessingImpl::GetStatistics(
     bool has_remote_tracks) const {
   rtc::CritScope cs_capture(&crit_capture_);
+  AudioProcessingStats stats = capture_.stats;
+  stats.render_queue_overruns =
+      render_queue_overruns_.load(std::memory_order_relaxed);
   if (!has_remote_tracks) {
-    return capture_.stats;
+    return stats;
   }
-  AudioProcessingStats stats = capture_.stats;
   EchoCancellationImpl::Metrics metrics;
   if (private_submodules_->echo_controller) {
     auto ec_metrics = private_submodules_->echo_controller->GetMetrics();
@@ -1880,8 +1886,8 @@ void AudioProcessingImpl::InitializeEchoController() {
   if (use_echo_controller) {
     // Create and activate the echo controller.
     if (echo_control_factory_) {
-      private_submodules_->echo_controller =
-          echo_control_factory_->Create(proc_sample_rate_hz());
+      private_submodules_->echo_controller = echo_control_factory_->Create(
+          proc_sample_rate_hz(), num_reverse_channels(), num_proc_channels());
     } else {
       private_submodules_->echo_controller = std::make_unique<EchoCanceller3>(
           EchoCanceller3Config(), proc_sample_rate_hz(), num_reverse_channels(),
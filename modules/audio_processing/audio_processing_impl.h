@@ -11,6 +11,7 @@
 #ifndef MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_IMPL_H_
 #define MODULES_AUDIO_PROCESSING_AUDIO_PROCESSING_IMPL_H_
 
+#include <atomic>
 #include <list>
 #include <memory>
 #include <vector>
@@ -266,6 +267,10 @@ class AudioProcessingImpl : public AudioProcessing {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
   void QueueNonbandedRenderAudio(AudioBuffer* audio)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
+  // Called when a render queue is full. Returns true if the queues were
+  // emptied and the insert can be retried, and false if the render audio is
+  // dropped.
+  bool HandleRenderQueueOverrun() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
 
   // Capture-side exclusive methods possibly running APM in a multi-threaded
   // manner that are called with the render lock already acquired.
@@ -463,6 +468,9 @@ class AudioProcessingImpl : public AudioProcessing {
       agc_render_signal_queue_;
   std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
       red_render_signal_queue_;
+  // Number of times the render side found a queue full. Written on the render
+  // side and read on the capture side.
+  std::atomic<int> render_queue_overruns_{0};
 };
 
 }  // namespace webrtc
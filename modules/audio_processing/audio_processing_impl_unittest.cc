@@ -17,6 +17,8 @@
 #include "modules/audio_processing/test/echo_control_mock.h"
 #include "modules/audio_processing/test/test_utils.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/ref_counted_object.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -58,9 +60,21 @@ class MockEchoControlFactory : public EchoControlFactory {
     next_mock_ = std::make_unique<MockEchoControl>();
     return mock;
   }
+  std::unique_ptr<EchoControl> Create(int sample_rate_hz,
+                                      int num_render_channels,
+                                      int num_capture_channels) override {
+    num_render_channels_ = num_render_channels;
+    num_capture_channels_ = num_capture_channels;
+    return Create(sample_rate_hz);
+  }
+  // The channel counts of the last created MockEchoControl.
+  int num_render_channels() const { return num_render_channels_; }
+  int num_capture_channels() const { return num_capture_channels_; }
 
  private:
   std::unique_ptr<MockEchoControl> next_mock_;
+  int num_render_channels_ = 0;
+  int num_capture_channels_ = 0;
 };
 
 void InitializeAudioFrame(size_t input_rate,
@@ -140,6 +154,28 @@ class TestRenderPreProcessor : public CustomProcessing {
   static constexpr float ProcessSample(float x) { return 2.f * x; }
 };
 
+// Capture post-processor that blocks in Process() until released, while the
+// capture side holds its lock.
+class BlockingCapturePostProcessor : public CustomProcessing {
+ public:
+  void Initialize(int sample_rate_hz, int num_channels) override {}
+  void Process(AudioBuffer* audio) override {
+    processing_.Set();
+    release_.Wait(rtc::Event::kForever);
+  }
+  std::string ToString() const override {
+    return "BlockingCapturePostProcessor";
+  }
+  void SetRuntimeSetting(AudioProcessing::RuntimeSetting setting) override {}
+
+  rtc::Event& processing() { return processing_; }
+  rtc::Event& release() { return release_; }
+
+ private:
+  rtc::Event processing_;
+  rtc::Event release_;
+};
+
 }  // namespace
 
 TEST(AudioProcessingImplTest, AudioParameterChangeTriggersInit) {
@@ -253,6 +289,34 @@ TEST(AudioProcessingImplTest,
   apm->ProcessStream(&frame);
 }
 
+TEST(AudioProcessingImplTest, EchoControllerSharesRenderWithCaptureChannels) {
+  // Tests that a multi-channel capture stream is handed to a single echo
+  // controller, which analyzes the render signal once for all channels.
+  auto echo_control_factory = std::make_unique<MockEchoControlFactory>();
+  const auto* echo_control_factory_ptr = echo_control_factory.get();
+
+  std::unique_ptr<AudioProcessing> apm(
+      AudioProcessingBuilder()
+          .SetEchoControlFactory(std::move(echo_control_factory))
+          .Create());
+  webrtc::AudioProcessing::Config apm_config;
+  apm_config.pipeline.experimental_multi_channel = true;
+  apm->ApplyConfig(apm_config);
+
+  AudioFrame frame;
+  constexpr size_t kSampleRateHz = 48000;
+  constexpr size_t kNumChannels = 2;
+  InitializeAudioFrame(kSampleRateHz, kNumChannels, &frame);
+  MockEchoControl* echo_control_mock = echo_control_factory_ptr->GetNext();
+  EXPECT_CALL(*echo_control_mock, AnalyzeCapture(testing::_)).Times(1);
+  EXPECT_CALL(*echo_control_mock, ProcessCapture(NotNull(), testing::_))
+      .Times(1);
+  apm->ProcessStream(&frame);
+
+  EXPECT_EQ(1, echo_control_factory_ptr->num_render_channels());
+  EXPECT_EQ(2, echo_control_factory_ptr->num_capture_channels());
+}
+
 TEST(AudioProcessingImplTest,
      EchoControllerObservesAnalogAgc1EchoPathGainChange) {
   // Tests that the echo controller observes an echo path gain change when the
@@ -395,4 +459,71 @@ TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
             test_echo_detector->last_render_audio_first_sample());
 }
 
+TEST(AudioProcessingImplTest, CountsRenderQueueOverruns) {
+  std::unique_ptr<AudioProcessing> apm(AudioProcessingBuilder().Create());
+  AudioFrame frame;
+  InitializeAudioFrame(/*sample_rate_hz=*/16000, /*num_channels=*/1, &frame);
+  FillFixedFrame(/*audio_level=*/1000, &frame);
+  ASSERT_EQ(AudioProcessing::kNoError, apm->ProcessStream(&frame));
+  EXPECT_EQ(0, apm->GetStatistics(/*has_remote_tracks=*/false)
+                   .render_queue_overruns.value_or(-1));
+
+  // Without any capture processing, the render queues fill up.
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_EQ(AudioProcessing::kNoError, apm->ProcessReverseStream(&frame));
+  }
+  EXPECT_GT(apm->GetStatistics(/*has_remote_tracks=*/false)
+                .render_queue_overruns.value_or(0),
+            0);
+  EXPECT_EQ(AudioProcessing::kNoError, apm->ProcessStream(&frame));
+}
+
+TEST(AudioProcessingImplTest, RenderDoesNotWaitForCaptureWhenDroppingAudio) {
+  auto post_processor = std::make_unique<BlockingCapturePostProcessor>();
+  BlockingCapturePostProcessor* post_processor_ptr = post_processor.get();
+  std::unique_ptr<AudioProcessing> apm(
+      AudioProcessingBuilder()
+          .SetCapturePostProcessing(std::move(post_processor))
+          .Create());
+  AudioProcessing::Config apm_config;
+  apm_config.pipeline.drop_render_audio_on_queue_overrun = true;
+  apm->ApplyConfig(apm_config);
+
+  AudioFrame render_frame;
+  InitializeAudioFrame(/*sample_rate_hz=*/16000, /*num_channels=*/1,
+                       &render_frame);
+  FillFixedFrame(/*audio_level=*/1000, &render_frame);
+  AudioFrame capture_frame;
+  capture_frame.CopyFrom(render_frame);
+  ASSERT_EQ(AudioProcessing::kNoError,
+            apm->ProcessReverseStream(&render_frame));
+
+  // Block the capture side inside ProcessStream(), holding the capture lock.
+  struct CaptureArgs {
+    AudioProcessing* apm;
+    AudioFrame* frame;
+  } capture_args = {apm.get(), &capture_frame};
+  rtc::PlatformThread capture_thread(
+      [](void* obj) {
+        CaptureArgs* args = static_cast<CaptureArgs*>(obj);
+        args->apm->ProcessStream(args->frame);
+      },
+      &capture_args, "Capture");
+  capture_thread.Start();
+  ASSERT_TRUE(post_processor_ptr->processing().Wait(5000));
+
+  // Overrun the render queues. Emptying the queues would wait for the capture
+  // lock and never return.
+  for (int i = 0; i < 300; ++i) {
+    ASSERT_EQ(AudioProcessing::kNoError,
+              apm->ProcessReverseStream(&render_frame));
+  }
+
+  post_processor_ptr->release().Set();
+  capture_thread.Stop();
+  EXPECT_GT(apm->GetStatistics(/*has_remote_tracks=*/false)
+                .render_queue_overruns.value_or(0),
+            0);
+}
+
 }  // namespace webrtc
@@ -182,16 +182,8 @@ int EchoControlMobileImpl::ProcessCaptureAudio(AudioBuffer* audio,
     RTC_DCHECK_GE(AudioBuffer::kMaxSplitFrameLength,
                   audio->num_frames_per_band());
 
-    std::array<int16_t, AudioBuffer::kMaxSplitFrameLength> split_bands_data;
-    int16_t* split_bands = split_bands_data.data();
-    const int16_t* clean = split_bands_data.data();
-    if (audio->split_bands(capture)[kBand0To8kHz]) {
-      FloatS16ToS16(audio->split_bands(capture)[kBand0To8kHz],
-                    audio->num_frames_per_band(), split_bands_data.data());
-    } else {
-      clean = nullptr;
-      split_bands = nullptr;
-    }
+    int16_t* split_bands = audio->split_bands_s16(capture)[kBand0To8kHz];
+    const int16_t* clean = split_bands;
 
     if (noisy == NULL) {
       noisy = clean;
@@ -203,11 +195,6 @@ int EchoControlMobileImpl::ProcessCaptureAudio(AudioBuffer* audio,
                                split_bands, audio->num_frames_per_band(),
                                stream_delay_ms);
 
-      if (split_bands) {
-        S16ToFloatS16(split_bands, audio->num_frames_per_band(),
-                      audio->split_bands(capture)[kBand0To8kHz]);
-      }
-
       if (err != AudioProcessing::kNoError) {
         return MapError(err);
       }
@@ -215,9 +202,8 @@ int EchoControlMobileImpl::ProcessCaptureAudio(AudioBuffer* audio,
       ++handle_index;
     }
     for (size_t band = 1u; band < audio->num_bands(); ++band) {
-      memset(audio->split_bands_f(capture)[band], 0,
-             audio->num_frames_per_band() *
-                 sizeof(audio->split_bands_f(capture)[band][0]));
+      memset(audio->split_bands_s16(capture)[band], 0,
+             audio->num_frames_per_band() * sizeof(int16_t));
     }
   }
   return AudioProcessing::kNoError;
@@ -227,9 +213,9 @@ void EchoControlMobileImpl::CopyLowPassReference(AudioBuffer* audio) {
   RTC_DCHECK_LE(audio->num_channels(), low_pass_reference_.size());
   reference_copied_ = true;
   for (size_t capture = 0; capture < audio->num_channels(); ++capture) {
-    FloatS16ToS16(audio->split_bands_const(capture)[kBand0To8kHz],
-                  audio->num_frames_per_band(),
-                  low_pass_reference_[capture].data());
+    memcpy(low_pass_reference_[capture].data(),
+           audio->split_bands_const_s16(capture)[kBand0To8kHz],
+           audio->num_frames_per_band() * sizeof(int16_t));
   }
 }
 
@@ -154,23 +154,15 @@ int GainControlImpl::AnalyzeCaptureAudio(AudioBuffer* audio) {
   RTC_DCHECK_EQ(audio->num_channels(), *num_proc_channels_);
   RTC_DCHECK_LE(*num_proc_channels_, gain_controllers_.size());
 
-  int16_t split_band_data[AudioBuffer::kMaxNumBands]
-                         [AudioBuffer::kMaxSplitFrameLength];
-  int16_t* split_bands[AudioBuffer::kMaxNumBands] = {
-      split_band_data[0], split_band_data[1], split_band_data[2]};
-
   if (mode_ == kAdaptiveAnalog) {
     int capture_channel = 0;
     for (auto& gain_controller : gain_controllers_) {
       gain_controller->set_capture_level(analog_capture_level_);
 
-      audio->ExportSplitChannelData(capture_channel, split_bands);
-
-      int err =
-          WebRtcAgc_AddMic(gain_controller->state(), split_bands,
-                           audio->num_bands(), audio->num_frames_per_band());
-
-      audio->ImportSplitChannelData(capture_channel, split_bands);
+      int err = WebRtcAgc_AddMic(gain_controller->state(),
+                                 audio->split_bands_s16(capture_channel),
+                                 audio->num_bands(),
+                                 audio->num_frames_per_band());
 
       if (err != AudioProcessing::kNoError) {
         return AudioProcessing::kUnspecifiedError;
@@ -182,14 +174,10 @@ int GainControlImpl::AnalyzeCaptureAudio(AudioBuffer* audio) {
     for (auto& gain_controller : gain_controllers_) {
       int32_t capture_level_out = 0;
 
-      audio->ExportSplitChannelData(capture_channel, split_bands);
-
-      int err =
-          WebRtcAgc_VirtualMic(gain_controller->state(), split_bands,
-                               audio->num_bands(), audio->num_frames_per_band(),
-                               analog_capture_level_, &capture_level_out);
-
-      audio->ImportSplitChannelData(capture_channel, split_bands);
+      int err = WebRtcAgc_VirtualMic(
+          gain_controller->state(), audio->split_bands_s16(capture_channel),
+          audio->num_bands(), audio->num_frames_per_band(),
+          analog_capture_level_, &capture_level_out);
 
       gain_controller->set_capture_level(capture_level_out);
 
@@ -224,11 +212,7 @@ int GainControlImpl::ProcessCaptureAudio(AudioBuffer* audio,
     int32_t capture_level_out = 0;
     uint8_t saturation_warning = 0;
 
-    int16_t split_band_data[AudioBuffer::kMaxNumBands]
-                           [AudioBuffer::kMaxSplitFrameLength];
-    int16_t* split_bands[AudioBuffer::kMaxNumBands] = {
-        split_band_data[0], split_band_data[1], split_band_data[2]};
-    audio->ExportSplitChannelData(capture_channel, split_bands);
+    int16_t* const* split_bands = audio->split_bands_s16(capture_channel);
 
     // The call to stream_has_echo() is ok from a deadlock perspective
     // as the capture lock is allready held.
@@ -238,8 +222,6 @@ int GainControlImpl::ProcessCaptureAudio(AudioBuffer* audio,
         gain_controller->get_capture_level(), &capture_level_out,
         stream_has_echo, &saturation_warning);
 
-    audio->ImportSplitChannelData(capture_channel, split_bands);
-
     if (err != AudioProcessing::kNoError) {
       return AudioProcessing::kUnspecifiedError;
     }
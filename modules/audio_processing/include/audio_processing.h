@@ -257,6 +257,11 @@ class AudioProcessing : public rtc::RefCountInterface {
       // Force multi-channel processing on playout and capture audio. This is an
       // experimental feature, and is likely to change without warning.
       bool experimental_multi_channel = false;
+      // Drop render audio when the render queues are full, instead of emptying
+      // the queues from the render side. Emptying the queues needs the capture
+      // lock, so dropping keeps the render side from ever waiting for a busy
+      // capture side.
+      bool drop_render_audio_on_queue_overrun = false;
     } pipeline;
 
     // Enabled the pre-amplifier. It amplifies the capture signal
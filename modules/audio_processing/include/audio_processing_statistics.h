@@ -66,6 +66,11 @@ struct RTC_EXPORT AudioProcessingStats {
   // milliseconds and the value is the instantaneous value at the time of the
   // call to |GetStatistics()|.
   absl::optional<int32_t> delay_ms;
+
+  // The number of times that the render side found a render queue full, since
+  // APM was created. This happens when the capture side doesn't keep up with
+  // the render side.
+  absl::optional<int> render_queue_overruns;
 };
 
 }  // namespace webrtc
@@ -101,16 +101,9 @@ void NoiseSuppressionImpl::ProcessCaptureAudio(AudioBuffer* audio) {
     WebRtcNs_Process(suppressors_[i]->state(), audio->split_bands_const(i),
                      audio->num_bands(), audio->split_bands(i));
 #elif defined(WEBRTC_NS_FIXED)
-    int16_t split_band_data[AudioBuffer::kMaxNumBands]
-                           [AudioBuffer::kMaxSplitFrameLength];
-    int16_t* split_bands[AudioBuffer::kMaxNumBands] = {
-        split_band_data[0], split_band_data[1], split_band_data[2]};
-    audio->ExportSplitChannelData(i, split_bands);
-
+    int16_t* const* split_bands = audio->split_bands_s16(i);
     WebRtcNsx_Process(suppressors_[i]->state(), split_bands, audio->num_bands(),
                       split_bands);
-
-    audio->ImportSplitChannelData(i, split_bands);
 #endif
   }
 }
@@ -0,0 +1,356 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Measures the cost of processing a 10 ms frame with APM, for each submodule
+// on its own and at each of the usual sample rates and channel counts, and
+// prints the results as CSV or JSON. The results of a configuration with all
+// submodules disabled are included, for the cost of APM itself, as well as
+// those of the band splitting and merging around the multi-band submodules.
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/strings/str_split.h"
+#include "common_audio/channel_buffer.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/include/audio_processing.h"
+#include "modules/audio_processing/splitting_filter.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+
+ABSL_FLAG(int, frames, 3000, "Number of 10 ms frames measured per run.");
+ABSL_FLAG(int,
+          warmup_frames,
+          300,
+          "Number of 10 ms frames processed before measuring.");
+ABSL_FLAG(std::string,
+          submodules,
+          "",
+          "Comma separated submodules to measure, among none, aec3, ns, "
+          "agc1, agc2, hpf, ts, le and band_split. All of them if empty.");
+ABSL_FLAG(std::string, format, "csv", "Output format, csv or json.");
+ABSL_FLAG(std::string,
+          output_file,
+          "",
+          "File to write the results to. Standard output if empty.");
+
+namespace webrtc {
+namespace {
+
+const char kUsage[] =
+    "\nMeasures the processing cost of the APM submodules.\n\n"
+    "Each submodule is enabled on its own and fed with 10 ms frames of noise\n"
+    "at 16, 32 and 48 kHz, mono and stereo. The mean, standard deviation,\n"
+    "median and 99th percentile of the time spent per frame, in render and\n"
+    "capture processing together, are reported in microseconds, along with\n"
+    "the SIMD path in use so that results from different machines can be\n"
+    "told apart. The band_split results are those of the band splitting and\n"
+    "merging alone, at 32 and 48 kHz.\n\n";
+
+constexpr int kSampleRatesHz[] = {16000, 32000, 48000};
+constexpr size_t kNumChannels[] = {1, 2};
+constexpr int kStreamDelayMs = 30;
+constexpr char kBandSplit[] = "band_split";
+
+struct Submodule {
+  const char* name;
+  void (*enable)(AudioProcessing::Config* apm_config,
+                 webrtc::Config* config);
+  // The transient suppressor only runs once key presses have been reported.
+  bool press_keys;
+};
+
+const Submodule kSubmodules[] = {
+    {"none", [](AudioProcessing::Config*, webrtc::Config*) {}},
+    {"aec3",
+     [](AudioProcessing::Config* apm_config, webrtc::Config*) {
+       apm_config->echo_canceller.enabled = true;
+     }},
+    {"ns",
+     [](AudioProcessing::Config* apm_config, webrtc::Config*) {
+       apm_config->noise_suppression.enabled = true;
+     }},
+    {"agc1",
+     [](AudioProcessing::Config* apm_config, webrtc::Config*) {
+       apm_config->gain_controller1.enabled = true;
+       apm_config->gain_controller1.mode =
+           AudioProcessing::Config::GainController1::kAdaptiveDigital;
+     }},
+    {"agc2",
+     [](AudioProcessing::Config* apm_config, webrtc::Config*) {
+       apm_config->gain_controller2.enabled = true;
+       apm_config->gain_controller2.adaptive_digital.enabled = true;
+     }},
+    {"hpf",
+     [](AudioProcessing::Config* apm_config, webrtc::Config*) {
+       apm_config->high_pass_filter.enabled = true;
+     }},
+    {"ts",
+     [](AudioProcessing::Config*, webrtc::Config* config) {
+       config->Set<ExperimentalNs>(new ExperimentalNs(true));
+     },
+     true},
+    {"le",
+     [](AudioProcessing::Config* apm_config, webrtc::Config*) {
+       apm_config->level_estimation.enabled = true;
+     }},
+};
+
+struct Result {
+  std::string submodule;
+  int sample_rate_hz;
+  size_t num_channels;
+  double mean_us;
+  double stddev_us;
+  double median_us;
+  double p99_us;
+};
+
+const char* SimdPath() {
+  switch (DetectOptimization()) {
+    case Aec3Optimization::kAvx2:
+      return "avx2";
+    case Aec3Optimization::kSse2:
+      return "sse2";
+    case Aec3Optimization::kNeon:
+      return "neon";
+    case Aec3Optimization::kNone:
+      return "none";
+  }
+  RTC_NOTREACHED();
+  return "";
+}
+
+// Fills |channels| with white noise at about -18 dBFS.
+void FillWithNoise(Random* random, std::vector<std::vector<float>>* channels) {
+  for (std::vector<float>& channel : *channels) {
+    for (float& sample : channel)
+      sample = random->Rand<float>() * 0.5f - 0.25f;
+  }
+}
+
+// Fills |result| with the statistics of |durations_us|.
+void ComputeStats(std::vector<double> durations_us, Result* result) {
+  double sum = 0.0;
+  for (double duration : durations_us)
+    sum += duration;
+  result->mean_us = sum / durations_us.size();
+  double sum_of_squares = 0.0;
+  for (double duration : durations_us) {
+    sum_of_squares +=
+        (duration - result->mean_us) * (duration - result->mean_us);
+  }
+  result->stddev_us = std::sqrt(sum_of_squares / durations_us.size());
+  std::sort(durations_us.begin(), durations_us.end());
+  result->median_us = durations_us[durations_us.size() / 2];
+  result->p99_us = durations_us[durations_us.size() * 99 / 100];
+}
+
+Result Measure(const Submodule& submodule,
+               int sample_rate_hz,
+               size_t num_channels,
+               int num_frames,
+               int num_warmup_frames) {
+  AudioProcessing::Config apm_config;
+  apm_config.residual_echo_detector.enabled = false;
+  webrtc::Config config;
+  submodule.enable(&apm_config, &config);
+  std::unique_ptr<AudioProcessing> apm(
+      AudioProcessingBuilder().Create(config));
+  RTC_CHECK(apm);
+  apm->ApplyConfig(apm_config);
+
+  const StreamConfig stream_config(sample_rate_hz, num_channels, false);
+  std::vector<std::vector<float>> render(
+      num_channels, std::vector<float>(stream_config.num_frames()));
+  std::vector<std::vector<float>> capture = render;
+  std::vector<float*> render_channels;
+  std::vector<float*> capture_channels;
+  for (size_t ch = 0; ch < num_channels; ++ch) {
+    render_channels.push_back(render[ch].data());
+    capture_channels.push_back(capture[ch].data());
+  }
+
+  Random random(42);
+  std::vector<double> durations_us;
+  durations_us.reserve(num_frames);
+  for (int frame = 0; frame < num_warmup_frames + num_frames; ++frame) {
+    FillWithNoise(&random, &render);
+    FillWithNoise(&random, &capture);
+    const int64_t start_ns = rtc::TimeNanos();
+    RTC_CHECK_EQ(AudioProcessing::kNoError,
+                 apm->ProcessReverseStream(
+                     render_channels.data(), stream_config, stream_config,
+                     render_channels.data()));
+    apm->set_stream_delay_ms(kStreamDelayMs);
+    apm->set_stream_key_pressed(submodule.press_keys);
+    RTC_CHECK_EQ(AudioProcessing::kNoError,
+                 apm->ProcessStream(capture_channels.data(), stream_config,
+                                    stream_config, capture_channels.data()));
+    const int64_t duration_ns = rtc::TimeNanos() - start_ns;
+    if (frame >= num_warmup_frames)
+      durations_us.push_back(duration_ns / 1000.0);
+  }
+
+  Result result;
+  result.submodule = submodule.name;
+  result.sample_rate_hz = sample_rate_hz;
+  result.num_channels = num_channels;
+  ComputeStats(std::move(durations_us), &result);
+  return result;
+}
+
+// Measures the splitting of a frame into bands and their merging, as done
+// around the multi-band submodules: two bands at 32 kHz and three at 48 kHz.
+Result MeasureBandSplitting(int sample_rate_hz,
+                            size_t num_channels,
+                            int num_frames,
+                            int num_warmup_frames) {
+  const size_t num_bands = sample_rate_hz == 48000 ? 3 : 2;
+  const size_t frame_length = sample_rate_hz / 100;
+  SplittingFilter splitting_filter(num_channels, num_bands, frame_length);
+  ChannelBuffer<float> data(frame_length, num_channels);
+  ChannelBuffer<float> bands(frame_length, num_channels, num_bands);
+
+  Random random(42);
+  std::vector<double> durations_us;
+  durations_us.reserve(num_frames);
+  for (int frame = 0; frame < num_warmup_frames + num_frames; ++frame) {
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      for (size_t i = 0; i < frame_length; ++i)
+        data.channels()[ch][i] = random.Rand<float>() * 16384.f - 8192.f;
+    }
+    const int64_t start_ns = rtc::TimeNanos();
+    splitting_filter.Analysis(&data, &bands);
+    splitting_filter.Synthesis(&bands, &data);
+    const int64_t duration_ns = rtc::TimeNanos() - start_ns;
+    if (frame >= num_warmup_frames)
+      durations_us.push_back(duration_ns / 1000.0);
+  }
+
+  Result result;
+  result.submodule = kBandSplit;
+  result.sample_rate_hz = sample_rate_hz;
+  result.num_channels = num_channels;
+  ComputeStats(std::move(durations_us), &result);
+  return result;
+}
+
+void PrintCsv(const std::vector<Result>& results, FILE* file) {
+  fprintf(file,
+          "simd,submodule,sample_rate_hz,num_channels,mean_us,stddev_us,"
+          "median_us,p99_us\n");
+  for (const Result& result : results) {
+    fprintf(file, "%s,%s,%d,%zu,%.2f,%.2f,%.2f,%.2f\n", SimdPath(),
+            result.submodule.c_str(), result.sample_rate_hz,
+            result.num_channels, result.mean_us, result.stddev_us,
+            result.median_us, result.p99_us);
+  }
+}
+
+void PrintJson(const std::vector<Result>& results, FILE* file) {
+  fprintf(file, "{\n  \"simd\": \"%s\",\n  \"results\": [", SimdPath());
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result& result = results[i];
+    fprintf(file,
+            "%s\n    {\"submodule\": \"%s\", \"sample_rate_hz\": %d, "
+            "\"num_channels\": %zu, \"mean_us\": %.2f, \"stddev_us\": %.2f, "
+            "\"median_us\": %.2f, \"p99_us\": %.2f}",
+            i == 0 ? "" : ",", result.submodule.c_str(), result.sample_rate_hz,
+            result.num_channels, result.mean_us, result.stddev_us,
+            result.median_us, result.p99_us);
+  }
+  fprintf(file, "\n  ]\n}\n");
+}
+
+int RunBenchmark() {
+  const int num_frames = absl::GetFlag(FLAGS_frames);
+  const int num_warmup_frames = absl::GetFlag(FLAGS_warmup_frames);
+  const std::string format = absl::GetFlag(FLAGS_format);
+  if (num_frames <= 0 || num_warmup_frames < 0 ||
+      (format != "csv" && format != "json")) {
+    printf("%s", kUsage);
+    return 1;
+  }
+
+  std::vector<const Submodule*> submodules;
+  const std::string names = absl::GetFlag(FLAGS_submodules);
+  const std::vector<std::string> selected =
+      absl::StrSplit(names, ',', absl::SkipEmpty());
+  for (const Submodule& submodule : kSubmodules) {
+    if (selected.empty() ||
+        std::find(selected.begin(), selected.end(), submodule.name) !=
+            selected.end()) {
+      submodules.push_back(&submodule);
+    }
+  }
+  const bool measure_band_splitting =
+      selected.empty() ||
+      std::find(selected.begin(), selected.end(), kBandSplit) !=
+          selected.end();
+  if (submodules.empty() && !measure_band_splitting) {
+    fprintf(stderr, "No known submodule in: %s\n", names.c_str());
+    return 1;
+  }
+
+  std::vector<Result> results;
+  for (const Submodule* submodule : submodules) {
+    for (int sample_rate_hz : kSampleRatesHz) {
+      for (size_t num_channels : kNumChannels) {
+        results.push_back(Measure(*submodule, sample_rate_hz, num_channels,
+                                  num_frames, num_warmup_frames));
+      }
+    }
+  }
+  if (measure_band_splitting) {
+    for (int sample_rate_hz : {32000, 48000}) {
+      for (size_t num_channels : kNumChannels) {
+        results.push_back(MeasureBandSplitting(
+            sample_rate_hz, num_channels, num_frames, num_warmup_frames));
+      }
+    }
+  }
+
+  const std::string output_file = absl::GetFlag(FLAGS_output_file);
+  FILE* file = output_file.empty() ? stdout : fopen(output_file.c_str(), "w");
+  if (!file) {
+    fprintf(stderr, "Could not open %s\n", output_file.c_str());
+    return 1;
+  }
+  if (format == "csv") {
+    PrintCsv(results, file);
+  } else {
+    PrintJson(results, file);
+  }
+  if (file != stdout)
+    fclose(file);
+  return 0;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() != 1) {
+    printf("%s", webrtc::kUsage);
+    return 1;
+  }
+  return webrtc::RunBenchmark();
+}
@@ -17,11 +17,12 @@
 namespace webrtc {
 
 MovingMoments::MovingMoments(size_t length)
-    : length_(length), queue_(), sum_(0.0), sum_of_squares_(0.0) {
+    : length_(length),
+      values_(length, 0.f),
+      oldest_index_(0),
+      sum_(0.0),
+      sum_of_squares_(0.0) {
   RTC_DCHECK_GT(length, 0);
-  for (size_t i = 0; i < length; ++i) {
-    queue_.push(0.0);
-  }
 }
 
 MovingMoments::~MovingMoments() {}
@@ -36,9 +37,11 @@ void MovingMoments::CalculateMoments(const float* in,
   RTC_DCHECK(second);
 
   for (size_t i = 0; i < in_length; ++i) {
-    const float old_value = queue_.front();
-    queue_.pop();
-    queue_.push(in[i]);
+    const float old_value = values_[oldest_index_];
+    values_[oldest_index_] = in[i];
+    if (++oldest_index_ == length_) {
+      oldest_index_ = 0;
+    }
 
     sum_ += in[i] - old_value;
     sum_of_squares_ += in[i] * in[i] - old_value * old_value;
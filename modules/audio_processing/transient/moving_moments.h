@@ -13,7 +13,7 @@
 
 #include <stddef.h>
 
-#include <queue>
+#include <vector>
 
 namespace webrtc {
 
@@ -40,8 +40,10 @@ class MovingMoments {
 
  private:
   size_t length_;
-  // A queue holding the |length_| latest input values.
-  std::queue<float> queue_;
+  // Ring buffer holding the |length_| latest input values, the oldest one at
+  // |oldest_index_|.
+  std::vector<float> values_;
+  size_t oldest_index_;
   // Sum of the values of the queue.
   float sum_;
   // Sum of the squares of the values of the queue.
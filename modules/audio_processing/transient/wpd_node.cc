@@ -10,29 +10,48 @@
 
 #include "modules/audio_processing/transient/wpd_node.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
 #include <math.h>
 #include <string.h>
 
-#include "common_audio/fir_filter.h"
-#include "common_audio/fir_filter_factory.h"
-#include "modules/audio_processing/transient/dyadic_decimator.h"
 #include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 
 namespace webrtc {
 
 WPDNode::WPDNode(size_t length,
                  const float* coefficients,
                  size_t coefficients_length)
-    :  // The data buffer has parent data length to be able to contain and
-       // filter it.
-      data_(new float[2 * length + 1]),
+    : data_(new float[length]),
       length_(length),
-      filter_(
-          CreateFirFilter(coefficients, coefficients_length, 2 * length + 1)) {
+      history_(coefficients_length - 1, 0.f),
+      // Sized for the longest parent data, 2 * |length| + 1 samples.
+      even_input_((coefficients_length + 2 * length + 1) / 2),
+      odd_input_((coefficients_length + 2 * length) / 2) {
   RTC_DCHECK_GT(length, 0);
   RTC_DCHECK(coefficients);
   RTC_DCHECK_GT(coefficients_length, 0);
-  memset(data_.get(), 0.f, (2 * length + 1) * sizeof(data_[0]));
+  memset(data_.get(), 0, length * sizeof(data_[0]));
+  // The filter output at parent position n is the sum of
+  // coefficients[k] * parent[n - k], so with the coefficients reversed the
+  // coefficient at position m applies to the input at position n + m, counted
+  // from the start of |history_|.
+  for (size_t m = 0; m < coefficients_length; ++m) {
+    const float coefficient = coefficients[coefficients_length - 1 - m];
+    if (m % 2 == 0) {
+      even_coefficients_.push_back(coefficient);
+    } else {
+      odd_coefficients_.push_back(coefficient);
+    }
+  }
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  use_sse2_ = WebRtc_GetCPUInfo(kSSE2) != 0;
+#endif
 }
 
 WPDNode::~WPDNode() {}
@@ -42,20 +61,40 @@ int WPDNode::Update(const float* parent_data, size_t parent_data_length) {
     return -1;
   }
 
-  // Filter data.
-  filter_->Filter(parent_data, parent_data_length, data_.get());
+  // Split the history and the parent data into even and odd positions.
+  float* const inputs[2] = {even_input_.data(), odd_input_.data()};
+  const size_t history_length = history_.size();
+  for (size_t i = 0; i < history_length; ++i) {
+    inputs[i % 2][i / 2] = history_[i];
+  }
+  for (size_t i = 0; i < parent_data_length; ++i) {
+    const size_t j = history_length + i;
+    inputs[j % 2][j / 2] = parent_data[i];
+  }
 
-  // Decimate data.
-  const bool kOddSequence = true;
-  size_t output_samples = DyadicDecimate(data_.get(), parent_data_length,
-                                         kOddSequence, data_.get(), length_);
-  if (output_samples != length_) {
-    return -1;
+  // Filter the data and decimate it, keeping the odd samples, and get the
+  // absolute values.
+#if defined(WEBRTC_HAS_NEON)
+  FilterAndDecimateNeon();
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (use_sse2_) {
+    FilterAndDecimateSse2();
+  } else {
+    FilterAndDecimate(0);
   }
+#else
+  FilterAndDecimate(0);
+#endif
 
-  // Get abs to all values.
-  for (size_t i = 0; i < length_; ++i) {
-    data_[i] = fabs(data_[i]);
+  // Update the history.
+  if (parent_data_length >= history_length) {
+    memcpy(history_.data(), &parent_data[parent_data_length - history_length],
+           history_length * sizeof(history_[0]));
+  } else {
+    memmove(history_.data(), &history_[parent_data_length],
+            (history_length - parent_data_length) * sizeof(history_[0]));
+    memcpy(&history_[history_length - parent_data_length], parent_data,
+           parent_data_length * sizeof(parent_data[0]));
   }
 
   return 0;
@@ -69,4 +108,62 @@ int WPDNode::set_data(const float* new_data, size_t length) {
   return 0;
 }
 
+// The kept output i is at parent position 2 * i + 1. The coefficients at even
+// positions 2 * p apply to the inputs at 2 * (i + p) + 1, which are the odd
+// inputs i + p, and those at odd positions 2 * p + 1 to the inputs at
+// 2 * (i + p + 1), which are the even inputs i + p + 1.
+void WPDNode::FilterAndDecimate(size_t begin) {
+  for (size_t i = begin; i < length_; ++i) {
+    float sum = 0.f;
+    for (size_t p = 0; p < even_coefficients_.size(); ++p) {
+      sum += even_coefficients_[p] * odd_input_[i + p];
+    }
+    for (size_t p = 0; p < odd_coefficients_.size(); ++p) {
+      sum += odd_coefficients_[p] * even_input_[i + p + 1];
+    }
+    data_[i] = fabs(sum);
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Same as FilterAndDecimate(), for four outputs at a time.
+void WPDNode::FilterAndDecimateSse2() {
+  const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+  size_t i = 0;
+  for (; i + 4 <= length_; i += 4) {
+    __m128 sum = _mm_setzero_ps();
+    for (size_t p = 0; p < even_coefficients_.size(); ++p) {
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(even_coefficients_[p]),
+                                       _mm_loadu_ps(&odd_input_[i + p])));
+    }
+    for (size_t p = 0; p < odd_coefficients_.size(); ++p) {
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(odd_coefficients_[p]),
+                                       _mm_loadu_ps(&even_input_[i + p + 1])));
+    }
+    _mm_storeu_ps(&data_[i], _mm_and_ps(sum, abs_mask));
+  }
+  FilterAndDecimate(i);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+// Same as FilterAndDecimate(), for four outputs at a time.
+void WPDNode::FilterAndDecimateNeon() {
+  size_t i = 0;
+  for (; i + 4 <= length_; i += 4) {
+    float32x4_t sum = vdupq_n_f32(0.f);
+    for (size_t p = 0; p < even_coefficients_.size(); ++p) {
+      sum = vmlaq_n_f32(sum, vld1q_f32(&odd_input_[i + p]),
+                        even_coefficients_[p]);
+    }
+    for (size_t p = 0; p < odd_coefficients_.size(); ++p) {
+      sum = vmlaq_n_f32(sum, vld1q_f32(&even_input_[i + p + 1]),
+                        odd_coefficients_[p]);
+    }
+    vst1q_f32(&data_[i], vabsq_f32(sum));
+  }
+  FilterAndDecimate(i);
+}
+#endif
+
 }  // namespace webrtc
@@ -11,11 +11,14 @@
 #ifndef MODULES_AUDIO_PROCESSING_TRANSIENT_WPD_NODE_H_
 #define MODULES_AUDIO_PROCESSING_TRANSIENT_WPD_NODE_H_
 
+#include <stddef.h>
+
 #include <memory>
+#include <vector>
 
-namespace webrtc {
+#include "rtc_base/system/arch.h"
 
-class FIRFilter;
+namespace webrtc {
 
 // A single node of a Wavelet Packet Decomposition (WPD) tree.
 class WPDNode {
@@ -35,9 +38,32 @@ class WPDNode {
   size_t length() const { return length_; }
 
  private:
+  // Filters the parent data in |even_input_| and |odd_input_| and writes the
+  // absolute values of the odd filtered samples, which are the only ones kept
+  // by the decimation, to |data_|, from |data_[begin]| on.
+  void FilterAndDecimate(size_t begin);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  void FilterAndDecimateSse2();
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  void FilterAndDecimateNeon();
+#endif
+
   std::unique_ptr<float[]> data_;
   size_t length_;
-  std::unique_ptr<FIRFilter> filter_;
+  // The reversed filter coefficients at even and odd positions.
+  std::vector<float> even_coefficients_;
+  std::vector<float> odd_coefficients_;
+  // The last |coefficients_length| - 1 samples of the previous parent data.
+  std::vector<float> history_;
+  // |history_| followed by the current parent data, split into the samples at
+  // even and odd positions. This way the filter outputs that survive the
+  // decimation are computed with contiguous loads.
+  std::vector<float> even_input_;
+  std::vector<float> odd_input_;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  bool use_sse2_;
+#endif
 };
 
 }  // namespace webrtc
@@ -10,8 +10,11 @@
 
 #include "modules/audio_processing/transient/wpd_node.h"
 
+#include <math.h>
 #include <string.h>
 
+#include <vector>
+
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -53,6 +56,37 @@ TEST(WPDNodeTest, UpdateWithArbitraryDataAndArbitraryFilter) {
   EXPECT_NEAR(0.94f, node.data()[4], kTolerance);
 }
 
+TEST(WPDNodeTest, UpdatesMatchFilteringFollowedByDecimation) {
+  // Long enough for the vectorized filtering to have a remainder.
+  const size_t kLength = 62;
+  const size_t kNumUpdates = 3;
+  // The samples are up to 100 in magnitude.
+  const float kFilterTolerance = 0.01f;
+  const float kLongCoefficients[] = {0.1f,  -0.2f, 0.3f,  0.4f,   -0.5f, 0.6f,
+                                     0.7f,  -0.8f, 0.9f,  -0.11f, 0.12f, 0.13f,
+                                     0.14f, 0.15f, -0.16f, 0.17f};
+  const size_t kLongCoefficientsLength =
+      sizeof(kLongCoefficients) / sizeof(kLongCoefficients[0]);
+  std::vector<float> parent_data(kNumUpdates * 2 * kLength);
+  for (size_t i = 0; i < parent_data.size(); ++i) {
+    parent_data[i] = static_cast<float>((i * 7919) % 201) - 100.f;
+  }
+
+  WPDNode node(kLength, kLongCoefficients, kLongCoefficientsLength);
+  for (size_t update = 0; update < kNumUpdates; ++update) {
+    const size_t offset = update * 2 * kLength;
+    EXPECT_EQ(0, node.Update(&parent_data[offset], 2 * kLength));
+    for (size_t i = 0; i < kLength; ++i) {
+      const size_t n = offset + 2 * i + 1;
+      float expected = 0.f;
+      for (size_t k = 0; k < kLongCoefficientsLength && k <= n; ++k) {
+        expected += kLongCoefficients[k] * parent_data[n - k];
+      }
+      EXPECT_NEAR(fabs(expected), node.data()[i], kFilterTolerance);
+    }
+  }
+}
+
 TEST(WPDNodeTest, ExpectedErrorReturnValue) {
   WPDNode node(kDataLength, kCoefficients, kCoefficientsLength);
   EXPECT_EQ(-1, node.Update(kParentData, kParentDataLength - 1));
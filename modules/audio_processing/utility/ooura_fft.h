@@ -11,6 +11,8 @@
 #ifndef MODULES_AUDIO_PROCESSING_UTILITY_OOURA_FFT_H_
 #define MODULES_AUDIO_PROCESSING_UTILITY_OOURA_FFT_H_
 
+#include <stddef.h>
+
 #include "rtc_base/system/arch.h"
 
 namespace webrtc {
@@ -43,6 +45,19 @@ class OouraFft {
   void Fft(float* a) const;
   void InverseFft(float* a) const;
 
+  // Number of transforms computed by FftBatch() and InverseFftBatch(), and
+  // the alignment in bytes they require of their input.
+  static constexpr size_t kBatchSize = 4;
+  static constexpr size_t kBatchAlignment = 16;
+
+  // Like Fft() and InverseFft(), but on |kBatchSize| independent transforms
+  // at once, which are interleaved in |a|: element i of transform k is
+  // a[kBatchSize * i + k]. The transforms are computed with the operations of
+  // the C version, vectorized across the batch, so they are bitexact to Fft()
+  // and InverseFft() on platforms without SSE2 or NEON, and close otherwise.
+  void FftBatch(float* a) const;
+  void InverseFftBatch(float* a) const;
+
  private:
   void cft1st_128(float* a) const;
   void cftmdl_128(float* a) const;
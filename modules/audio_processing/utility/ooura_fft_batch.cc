@@ -0,0 +1,553 @@
+/*
+ * http://www.kurims.kyoto-u.ac.jp/~ooura/fft.html
+ * Copyright Takuya OOURA, 1996-2001
+ *
+ * You may use, copy, modify and distribute this code for any purpose (include
+ * commercial use) and without fee. Please refer to this package when you modify
+ * this code.
+ *
+ * Changes by the WebRTC authors:
+ *    - The C version of the rdft of length 128 from ooura_fft.cc, written for
+ *      a vector type so that it computes several transforms at once.
+ *
+ *  All changes are covered by the WebRTC license and IP grant:
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/ooura_fft.h"
+
+#include <stdint.h>
+
+#include "modules/audio_processing/utility/ooura_fft_tables_common.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#elif defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace webrtc {
+
+namespace {
+
+// The elements of OouraFft::kBatchSize transforms, one per lane. The
+// operations are done lane by lane, in the same order as in the C version.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+struct Lanes {
+  Lanes() = default;
+  explicit Lanes(float x) : v(_mm_set1_ps(x)) {}
+  explicit Lanes(__m128 x) : v(x) {}
+
+  __m128 v;
+};
+
+inline Lanes operator+(const Lanes& a, const Lanes& b) {
+  return Lanes(_mm_add_ps(a.v, b.v));
+}
+
+inline Lanes operator-(const Lanes& a, const Lanes& b) {
+  return Lanes(_mm_sub_ps(a.v, b.v));
+}
+
+inline Lanes operator*(const Lanes& a, const Lanes& b) {
+  return Lanes(_mm_mul_ps(a.v, b.v));
+}
+#elif defined(WEBRTC_HAS_NEON)
+struct Lanes {
+  Lanes() = default;
+  explicit Lanes(float x) : v(vdupq_n_f32(x)) {}
+  explicit Lanes(float32x4_t x) : v(x) {}
+
+  float32x4_t v;
+};
+
+inline Lanes operator+(const Lanes& a, const Lanes& b) {
+  return Lanes(vaddq_f32(a.v, b.v));
+}
+
+inline Lanes operator-(const Lanes& a, const Lanes& b) {
+  return Lanes(vsubq_f32(a.v, b.v));
+}
+
+inline Lanes operator*(const Lanes& a, const Lanes& b) {
+  return Lanes(vmulq_f32(a.v, b.v));
+}
+#else
+struct Lanes {
+  Lanes() = default;
+  explicit Lanes(float x) {
+    for (size_t k = 0; k < OouraFft::kBatchSize; ++k)
+      v[k] = x;
+  }
+
+  float v[OouraFft::kBatchSize];
+};
+
+inline Lanes operator+(const Lanes& a, const Lanes& b) {
+  Lanes r;
+  for (size_t k = 0; k < OouraFft::kBatchSize; ++k)
+    r.v[k] = a.v[k] + b.v[k];
+  return r;
+}
+
+inline Lanes operator-(const Lanes& a, const Lanes& b) {
+  Lanes r;
+  for (size_t k = 0; k < OouraFft::kBatchSize; ++k)
+    r.v[k] = a.v[k] - b.v[k];
+  return r;
+}
+
+inline Lanes operator*(const Lanes& a, const Lanes& b) {
+  Lanes r;
+  for (size_t k = 0; k < OouraFft::kBatchSize; ++k)
+    r.v[k] = a.v[k] * b.v[k];
+  return r;
+}
+#endif
+
+static_assert(sizeof(Lanes) == OouraFft::kBatchSize * sizeof(float), "");
+
+inline Lanes operator-(const Lanes& a) {
+  return Lanes(0.f) - a;
+}
+
+inline Lanes& operator+=(Lanes& a, const Lanes& b) {
+  a = a + b;
+  return a;
+}
+
+inline Lanes& operator-=(Lanes& a, const Lanes& b) {
+  a = a - b;
+  return a;
+}
+
+void cft1st_128_batch(Lanes* a) {
+  const int n = 128;
+  int j, k1, k2;
+  Lanes wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
+  Lanes x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
+
+  // The processing of the first set of elements was simplified in C to avoid
+  // some operations (multiplication by zero or one, addition of two elements
+  // multiplied by the same weight, ...).
+  x0r = a[0] + a[2];
+  x0i = a[1] + a[3];
+  x1r = a[0] - a[2];
+  x1i = a[1] - a[3];
+  x2r = a[4] + a[6];
+  x2i = a[5] + a[7];
+  x3r = a[4] - a[6];
+  x3i = a[5] - a[7];
+  a[0] = x0r + x2r;
+  a[1] = x0i + x2i;
+  a[4] = x0r - x2r;
+  a[5] = x0i - x2i;
+  a[2] = x1r - x3i;
+  a[3] = x1i + x3r;
+  a[6] = x1r + x3i;
+  a[7] = x1i - x3r;
+  wk1r = Lanes(rdft_w[2]);
+  x0r = a[8] + a[10];
+  x0i = a[9] + a[11];
+  x1r = a[8] - a[10];
+  x1i = a[9] - a[11];
+  x2r = a[12] + a[14];
+  x2i = a[13] + a[15];
+  x3r = a[12] - a[14];
+  x3i = a[13] - a[15];
+  a[8] = x0r + x2r;
+  a[9] = x0i + x2i;
+  a[12] = x2i - x0i;
+  a[13] = x0r - x2r;
+  x0r = x1r - x3i;
+  x0i = x1i + x3r;
+  a[10] = wk1r * (x0r - x0i);
+  a[11] = wk1r * (x0r + x0i);
+  x0r = x3i + x1r;
+  x0i = x3r - x1i;
+  a[14] = wk1r * (x0i - x0r);
+  a[15] = wk1r * (x0i + x0r);
+  k1 = 0;
+  for (j = 16; j < n; j += 16) {
+    k1 += 2;
+    k2 = 2 * k1;
+    wk2r = Lanes(rdft_w[k1 + 0]);
+    wk2i = Lanes(rdft_w[k1 + 1]);
+    wk1r = Lanes(rdft_w[k2 + 0]);
+    wk1i = Lanes(rdft_w[k2 + 1]);
+    wk3r = Lanes(rdft_wk3ri_first[k1 + 0]);
+    wk3i = Lanes(rdft_wk3ri_first[k1 + 1]);
+    x0r = a[j + 0] + a[j + 2];
+    x0i = a[j + 1] + a[j + 3];
+    x1r = a[j + 0] - a[j + 2];
+    x1i = a[j + 1] - a[j + 3];
+    x2r = a[j + 4] + a[j + 6];
+    x2i = a[j + 5] + a[j + 7];
+    x3r = a[j + 4] - a[j + 6];
+    x3i = a[j + 5] - a[j + 7];
+    a[j + 0] = x0r + x2r;
+    a[j + 1] = x0i + x2i;
+    x0r -= x2r;
+    x0i -= x2i;
+    a[j + 4] = wk2r * x0r - wk2i * x0i;
+    a[j + 5] = wk2r * x0i + wk2i * x0r;
+    x0r = x1r - x3i;
+    x0i = x1i + x3r;
+    a[j + 2] = wk1r * x0r - wk1i * x0i;
+    a[j + 3] = wk1r * x0i + wk1i * x0r;
+    x0r = x1r + x3i;
+    x0i = x1i - x3r;
+    a[j + 6] = wk3r * x0r - wk3i * x0i;
+    a[j + 7] = wk3r * x0i + wk3i * x0r;
+    wk1r = Lanes(rdft_w[k2 + 2]);
+    wk1i = Lanes(rdft_w[k2 + 3]);
+    wk3r = Lanes(rdft_wk3ri_second[k1 + 0]);
+    wk3i = Lanes(rdft_wk3ri_second[k1 + 1]);
+    x0r = a[j + 8] + a[j + 10];
+    x0i = a[j + 9] + a[j + 11];
+    x1r = a[j + 8] - a[j + 10];
+    x1i = a[j + 9] - a[j + 11];
+    x2r = a[j + 12] + a[j + 14];
+    x2i = a[j + 13] + a[j + 15];
+    x3r = a[j + 12] - a[j + 14];
+    x3i = a[j + 13] - a[j + 15];
+    a[j + 8] = x0r + x2r;
+    a[j + 9] = x0i + x2i;
+    x0r -= x2r;
+    x0i -= x2i;
+    a[j + 12] = -wk2i * x0r - wk2r * x0i;
+    a[j + 13] = -wk2i * x0i + wk2r * x0r;
+    x0r = x1r - x3i;
+    x0i = x1i + x3r;
+    a[j + 10] = wk1r * x0r - wk1i * x0i;
+    a[j + 11] = wk1r * x0i + wk1i * x0r;
+    x0r = x1r + x3i;
+    x0i = x1i - x3r;
+    a[j + 14] = wk3r * x0r - wk3i * x0i;
+    a[j + 15] = wk3r * x0i + wk3i * x0r;
+  }
+}
+
+void cftmdl_128_batch(Lanes* a) {
+  const int l = 8;
+  const int n = 128;
+  const int m = 32;
+  int j0, j1, j2, j3, k, k1, k2, m2;
+  Lanes wk1r, wk1i, wk2r, wk2i, wk3r, wk3i;
+  Lanes x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
+
+  for (j0 = 0; j0 < l; j0 += 2) {
+    j1 = j0 + 8;
+    j2 = j0 + 16;
+    j3 = j0 + 24;
+    x0r = a[j0 + 0] + a[j1 + 0];
+    x0i = a[j0 + 1] + a[j1 + 1];
+    x1r = a[j0 + 0] - a[j1 + 0];
+    x1i = a[j0 + 1] - a[j1 + 1];
+    x2r = a[j2 + 0] + a[j3 + 0];
+    x2i = a[j2 + 1] + a[j3 + 1];
+    x3r = a[j2 + 0] - a[j3 + 0];
+    x3i = a[j2 + 1] - a[j3 + 1];
+    a[j0 + 0] = x0r + x2r;
+    a[j0 + 1] = x0i + x2i;
+    a[j2 + 0] = x0r - x2r;
+    a[j2 + 1] = x0i - x2i;
+    a[j1 + 0] = x1r - x3i;
+    a[j1 + 1] = x1i + x3r;
+    a[j3 + 0] = x1r + x3i;
+    a[j3 + 1] = x1i - x3r;
+  }
+  wk1r = Lanes(rdft_w[2]);
+  for (j0 = m; j0 < l + m; j0 += 2) {
+    j1 = j0 + 8;
+    j2 = j0 + 16;
+    j3 = j0 + 24;
+    x0r = a[j0 + 0] + a[j1 + 0];
+    x0i = a[j0 + 1] + a[j1 + 1];
+    x1r = a[j0 + 0] - a[j1 + 0];
+    x1i = a[j0 + 1] - a[j1 + 1];
+    x2r = a[j2 + 0] + a[j3 + 0];
+    x2i = a[j2 + 1] + a[j3 + 1];
+    x3r = a[j2 + 0] - a[j3 + 0];
+    x3i = a[j2 + 1] - a[j3 + 1];
+    a[j0 + 0] = x0r + x2r;
+    a[j0 + 1] = x0i + x2i;
+    a[j2 + 0] = x2i - x0i;
+    a[j2 + 1] = x0r - x2r;
+    x0r = x1r - x3i;
+    x0i = x1i + x3r;
+    a[j1 + 0] = wk1r * (x0r - x0i);
+    a[j1 + 1] = wk1r * (x0r + x0i);
+    x0r = x3i + x1r;
+    x0i = x3r - x1i;
+    a[j3 + 0] = wk1r * (x0i - x0r);
+    a[j3 + 1] = wk1r * (x0i + x0r);
+  }
+  k1 = 0;
+  m2 = 2 * m;
+  for (k = m2; k < n; k += m2) {
+    k1 += 2;
+    k2 = 2 * k1;
+    wk2r = Lanes(rdft_w[k1 + 0]);
+    wk2i = Lanes(rdft_w[k1 + 1]);
+    wk1r = Lanes(rdft_w[k2 + 0]);
+    wk1i = Lanes(rdft_w[k2 + 1]);
+    wk3r = Lanes(rdft_wk3ri_first[k1 + 0]);
+    wk3i = Lanes(rdft_wk3ri_first[k1 + 1]);
+    for (j0 = k; j0 < l + k; j0 += 2) {
+      j1 = j0 + 8;
+      j2 = j0 + 16;
+      j3 = j0 + 24;
+      x0r = a[j0 + 0] + a[j1 + 0];
+      x0i = a[j0 + 1] + a[j1 + 1];
+      x1r = a[j0 + 0] - a[j1 + 0];
+      x1i = a[j0 + 1] - a[j1 + 1];
+      x2r = a[j2 + 0] + a[j3 + 0];
+      x2i = a[j2 + 1] + a[j3 + 1];
+      x3r = a[j2 + 0] - a[j3 + 0];
+      x3i = a[j2 + 1] - a[j3 + 1];
+      a[j0 + 0] = x0r + x2r;
+      a[j0 + 1] = x0i + x2i;
+      x0r -= x2r;
+      x0i -= x2i;
+      a[j2 + 0] = wk2r * x0r - wk2i * x0i;
+      a[j2 + 1] = wk2r * x0i + wk2i * x0r;
+      x0r = x1r - x3i;
+      x0i = x1i + x3r;
+      a[j1 + 0] = wk1r * x0r - wk1i * x0i;
+      a[j1 + 1] = wk1r * x0i + wk1i * x0r;
+      x0r = x1r + x3i;
+      x0i = x1i - x3r;
+      a[j3 + 0] = wk3r * x0r - wk3i * x0i;
+      a[j3 + 1] = wk3r * x0i + wk3i * x0r;
+    }
+    wk1r = Lanes(rdft_w[k2 + 2]);
+    wk1i = Lanes(rdft_w[k2 + 3]);
+    wk3r = Lanes(rdft_wk3ri_second[k1 + 0]);
+    wk3i = Lanes(rdft_wk3ri_second[k1 + 1]);
+    for (j0 = k + m; j0 < l + (k + m); j0 += 2) {
+      j1 = j0 + 8;
+      j2 = j0 + 16;
+      j3 = j0 + 24;
+      x0r = a[j0 + 0] + a[j1 + 0];
+      x0i = a[j0 + 1] + a[j1 + 1];
+      x1r = a[j0 + 0] - a[j1 + 0];
+      x1i = a[j0 + 1] - a[j1 + 1];
+      x2r = a[j2 + 0] + a[j3 + 0];
+      x2i = a[j2 + 1] + a[j3 + 1];
+      x3r = a[j2 + 0] - a[j3 + 0];
+      x3i = a[j2 + 1] - a[j3 + 1];
+      a[j0 + 0] = x0r + x2r;
+      a[j0 + 1] = x0i + x2i;
+      x0r -= x2r;
+      x0i -= x2i;
+      a[j2 + 0] = -wk2i * x0r - wk2r * x0i;
+      a[j2 + 1] = -wk2i * x0i + wk2r * x0r;
+      x0r = x1r - x3i;
+      x0i = x1i + x3r;
+      a[j1 + 0] = wk1r * x0r - wk1i * x0i;
+      a[j1 + 1] = wk1r * x0i + wk1i * x0r;
+      x0r = x1r + x3i;
+      x0i = x1i - x3r;
+      a[j3 + 0] = wk3r * x0r - wk3i * x0i;
+      a[j3 + 1] = wk3r * x0i + wk3i * x0r;
+    }
+  }
+}
+
+void rftfsub_128_batch(Lanes* a) {
+  const float* c = rdft_w + 32;
+  int j1, j2, k1, k2;
+  Lanes wkr, wki, xr, xi, yr, yi;
+
+  for (j1 = 1, j2 = 2; j2 < 64; j1 += 1, j2 += 2) {
+    k2 = 128 - j2;
+    k1 = 32 - j1;
+    wkr = Lanes(0.5f - c[k1]);
+    wki = Lanes(c[j1]);
+    xr = a[j2 + 0] - a[k2 + 0];
+    xi = a[j2 + 1] + a[k2 + 1];
+    yr = wkr * xr - wki * xi;
+    yi = wkr * xi + wki * xr;
+    a[j2 + 0] -= yr;
+    a[j2 + 1] -= yi;
+    a[k2 + 0] += yr;
+    a[k2 + 1] -= yi;
+  }
+}
+
+void rftbsub_128_batch(Lanes* a) {
+  const float* c = rdft_w + 32;
+  int j1, j2, k1, k2;
+  Lanes wkr, wki, xr, xi, yr, yi;
+
+  a[1] = -a[1];
+  for (j1 = 1, j2 = 2; j2 < 64; j1 += 1, j2 += 2) {
+    k2 = 128 - j2;
+    k1 = 32 - j1;
+    wkr = Lanes(0.5f - c[k1]);
+    wki = Lanes(c[j1]);
+    xr = a[j2 + 0] - a[k2 + 0];
+    xi = a[j2 + 1] + a[k2 + 1];
+    yr = wkr * xr + wki * xi;
+    yi = wkr * xi - wki * xr;
+    a[j2 + 0] = a[j2 + 0] - yr;
+    a[j2 + 1] = yi - a[j2 + 1];
+    a[k2 + 0] = yr + a[k2 + 0];
+    a[k2 + 1] = yi - a[k2 + 1];
+  }
+  a[65] = -a[65];
+}
+
+void cftbsub_128_batch(Lanes* a) {
+  int j, j1, j2, j3, l;
+  Lanes x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
+
+  cft1st_128_batch(a);
+  cftmdl_128_batch(a);
+  l = 32;
+
+  for (j = 0; j < l; j += 2) {
+    j1 = j + l;
+    j2 = j1 + l;
+    j3 = j2 + l;
+    x0r = a[j] + a[j1];
+    x0i = -a[j + 1] - a[j1 + 1];
+    x1r = a[j] - a[j1];
+    x1i = -a[j + 1] + a[j1 + 1];
+    x2r = a[j2] + a[j3];
+    x2i = a[j2 + 1] + a[j3 + 1];
+    x3r = a[j2] - a[j3];
+    x3i = a[j2 + 1] - a[j3 + 1];
+    a[j] = x0r + x2r;
+    a[j + 1] = x0i - x2i;
+    a[j2] = x0r - x2r;
+    a[j2 + 1] = x0i + x2i;
+    a[j1] = x1r - x3i;
+    a[j1 + 1] = x1i - x3r;
+    a[j3] = x1r + x3i;
+    a[j3 + 1] = x1i + x3r;
+  }
+}
+
+void cftfsub_128_batch(Lanes* a) {
+  int j, j1, j2, j3, l;
+  Lanes x0r, x0i, x1r, x1i, x2r, x2i, x3r, x3i;
+
+  cft1st_128_batch(a);
+  cftmdl_128_batch(a);
+  l = 32;
+  for (j = 0; j < l; j += 2) {
+    j1 = j + l;
+    j2 = j1 + l;
+    j3 = j2 + l;
+    x0r = a[j] + a[j1];
+    x0i = a[j + 1] + a[j1 + 1];
+    x1r = a[j] - a[j1];
+    x1i = a[j + 1] - a[j1 + 1];
+    x2r = a[j2] + a[j3];
+    x2i = a[j2 + 1] + a[j3 + 1];
+    x3r = a[j2] - a[j3];
+    x3i = a[j2 + 1] - a[j3 + 1];
+    a[j] = x0r + x2r;
+    a[j + 1] = x0i + x2i;
+    a[j2] = x0r - x2r;
+    a[j2 + 1] = x0i - x2i;
+    a[j1] = x1r - x3i;
+    a[j1 + 1] = x1i + x3r;
+    a[j3] = x1r + x3i;
+    a[j3 + 1] = x1i - x3r;
+  }
+}
+
+void bitrv2_128_batch(Lanes* a) {
+  unsigned int j, j1, k, k1;
+  Lanes xr, xi, yr, yi;
+
+  const int ip[4] = {0, 64, 32, 96};
+  for (k = 0; k < 4; k++) {
+    for (j = 0; j < k; j++) {
+      j1 = 2 * j + ip[k];
+      k1 = 2 * k + ip[j];
+      xr = a[j1 + 0];
+      xi = a[j1 + 1];
+      yr = a[k1 + 0];
+      yi = a[k1 + 1];
+      a[j1 + 0] = yr;
+      a[j1 + 1] = yi;
+      a[k1 + 0] = xr;
+      a[k1 + 1] = xi;
+      j1 += 8;
+      k1 += 16;
+      xr = a[j1 + 0];
+      xi = a[j1 + 1];
+      yr = a[k1 + 0];
+      yi = a[k1 + 1];
+      a[j1 + 0] = yr;
+      a[j1 + 1] = yi;
+      a[k1 + 0] = xr;
+      a[k1 + 1] = xi;
+      j1 += 8;
+      k1 -= 8;
+      xr = a[j1 + 0];
+      xi = a[j1 + 1];
+      yr = a[k1 + 0];
+      yi = a[k1 + 1];
+      a[j1 + 0] = yr;
+      a[j1 + 1] = yi;
+      a[k1 + 0] = xr;
+      a[k1 + 1] = xi;
+      j1 += 8;
+      k1 += 16;
+      xr = a[j1 + 0];
+      xi = a[j1 + 1];
+      yr = a[k1 + 0];
+      yi = a[k1 + 1];
+      a[j1 + 0] = yr;
+      a[j1 + 1] = yi;
+      a[k1 + 0] = xr;
+      a[k1 + 1] = xi;
+    }
+    j1 = 2 * k + 8 + ip[k];
+    k1 = j1 + 8;
+    xr = a[j1 + 0];
+    xi = a[j1 + 1];
+    yr = a[k1 + 0];
+    yi = a[k1 + 1];
+    a[j1 + 0] = yr;
+    a[j1 + 1] = yi;
+    a[k1 + 0] = xr;
+    a[k1 + 1] = xi;
+  }
+}
+
+}  // namespace
+
+void OouraFft::FftBatch(float* a) const {
+  RTC_DCHECK_EQ(0, reinterpret_cast<uintptr_t>(a) % kBatchAlignment);
+  Lanes* lanes = reinterpret_cast<Lanes*>(a);
+  bitrv2_128_batch(lanes);
+  cftfsub_128_batch(lanes);
+  rftfsub_128_batch(lanes);
+  const Lanes xi = lanes[0] - lanes[1];
+  lanes[0] += lanes[1];
+  lanes[1] = xi;
+}
+
+void OouraFft::InverseFftBatch(float* a) const {
+  RTC_DCHECK_EQ(0, reinterpret_cast<uintptr_t>(a) % kBatchAlignment);
+  Lanes* lanes = reinterpret_cast<Lanes*>(a);
+  lanes[1] = Lanes(0.5f) * (lanes[0] - lanes[1]);
+  lanes[0] -= lanes[1];
+  rftbsub_128_batch(lanes);
+  bitrv2_128_batch(lanes);
+  cftbsub_128_batch(lanes);
+}
+
+}  // namespace webrtc
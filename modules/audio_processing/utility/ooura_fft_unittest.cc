@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/utility/ooura_fft.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <array>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kFftLength = 128;
+constexpr size_t kBatchSize = OouraFft::kBatchSize;
+
+using Batch = std::array<float, kFftLength * kBatchSize>;
+
+// Fills |x| with random transforms, and |batch| with the same transforms
+// interleaved.
+void RandomizeBatch(Random* random,
+                    std::array<std::array<float, kFftLength>, kBatchSize>* x,
+                    Batch* batch) {
+  for (size_t k = 0; k < kBatchSize; ++k) {
+    for (size_t i = 0; i < kFftLength; ++i) {
+      (*x)[k][i] = random->Rand(-32768, 32767);
+      (*batch)[kBatchSize * i + k] = (*x)[k][i];
+    }
+  }
+}
+
+// Expects |batch| to hold the transforms in |x|, up to rounding errors
+// relative to the largest magnitude in each transform.
+void ExpectBatchNear(
+    const std::array<std::array<float, kFftLength>, kBatchSize>& x,
+    const Batch& batch) {
+  for (size_t k = 0; k < kBatchSize; ++k) {
+    float max_abs = 0.f;
+    for (float x_i : x[k])
+      max_abs = std::max(max_abs, fabsf(x_i));
+    for (size_t i = 0; i < kFftLength; ++i)
+      EXPECT_NEAR(x[k][i], batch[kBatchSize * i + k], max_abs * 1e-6f);
+  }
+}
+
+TEST(OouraFftTest, FftBatchMatchesFft) {
+  OouraFft fft;
+  Random random(42);
+  std::array<std::array<float, kFftLength>, kBatchSize> x;
+  alignas(OouraFft::kBatchAlignment) Batch batch;
+  for (int n = 0; n < 100; ++n) {
+    RandomizeBatch(&random, &x, &batch);
+    for (auto& x_k : x)
+      fft.Fft(x_k.data());
+    fft.FftBatch(batch.data());
+    ExpectBatchNear(x, batch);
+  }
+}
+
+TEST(OouraFftTest, InverseFftBatchMatchesInverseFft) {
+  OouraFft fft;
+  Random random(42);
+  std::array<std::array<float, kFftLength>, kBatchSize> x;
+  alignas(OouraFft::kBatchAlignment) Batch batch;
+  for (int n = 0; n < 100; ++n) {
+    RandomizeBatch(&random, &x, &batch);
+    for (auto& x_k : x)
+      fft.InverseFft(x_k.data());
+    fft.InverseFftBatch(batch.data());
+    ExpectBatchNear(x, batch);
+  }
+}
+
+// Logs the time per transform of Fft() and FftBatch().
+TEST(OouraFftTest, DISABLED_FftBatchPerf) {
+  constexpr int kNumBatches = 100000;
+  OouraFft fft;
+  Random random(42);
+  std::array<std::array<float, kFftLength>, kBatchSize> x;
+  alignas(OouraFft::kBatchAlignment) Batch batch;
+  RandomizeBatch(&random, &x, &batch);
+
+  int64_t start_us = rtc::TimeMicros();
+  for (int n = 0; n < kNumBatches; ++n) {
+    for (auto& x_k : x) {
+      fft.Fft(x_k.data());
+      fft.InverseFft(x_k.data());
+    }
+  }
+  const int64_t single_us = rtc::TimeMicros() - start_us;
+
+  start_us = rtc::TimeMicros();
+  for (int n = 0; n < kNumBatches; ++n) {
+    fft.FftBatch(batch.data());
+    fft.InverseFftBatch(batch.data());
+  }
+  const int64_t batch_us = rtc::TimeMicros() - start_us;
+
+  const int64_t num_transforms = 2 * kNumBatches * kBatchSize;
+  RTC_LOG(LS_INFO) << "Single: " << single_us * 1000 / num_transforms
+                   << " ns, batched: " << batch_us * 1000 / num_transforms
+                   << " ns per transform.";
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -13,7 +13,12 @@
 #include <algorithm>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
+#include "common_audio/third_party/fft4g/fft4g.h"
+#include "modules/audio_processing/utility/ooura_fft.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "test/gtest.h"
 #include "third_party/pffft/src/pffft.h"
 
@@ -177,5 +182,60 @@ TEST(PffftTest, FftBitExactness) {
   }
 }
 
+// Logs the time per forward and backward real transform of the FFTs in APM,
+// for the sizes that APM uses. The Ooura FFT only supports 128 points, and
+// fft4g only supports powers of two.
+TEST(PffftTest, DISABLED_BackendsPerf) {
+  constexpr int kNumIterations = 20000;
+  for (size_t fft_size : {128, 256, 480, 512}) {
+    std::srand(0);
+    Pffft pffft(fft_size, Pffft::FftType::kReal);
+    auto in = pffft.CreateBuffer();
+    auto out = pffft.CreateBuffer();
+    auto in_view = in->GetView();
+    for (size_t i = 0; i < fft_size; ++i) {
+      in_view[i] = static_cast<float>(frand() * 2.0 - 1.0);
+    }
+    int64_t start_us = rtc::TimeMicros();
+    for (int k = 0; k < kNumIterations; ++k) {
+      pffft.ForwardTransform(*in, out.get(), /*ordered=*/true);
+      pffft.BackwardTransform(*out, in.get(), /*ordered=*/true);
+    }
+    RTC_LOG(LS_INFO) << "PFFFT " << fft_size << ": "
+                     << (rtc::TimeMicros() - start_us) * 1000 / kNumIterations
+                     << " ns";
+
+    if ((fft_size & (fft_size - 1)) == 0) {
+      std::vector<float> data(in_view.begin(), in_view.end());
+      std::vector<size_t> ip(fft_size);
+      std::vector<float> w(fft_size / 2);
+      ip[0] = 0;
+      start_us = rtc::TimeMicros();
+      for (int k = 0; k < kNumIterations; ++k) {
+        WebRtc_rdft(fft_size, 1, data.data(), ip.data(), w.data());
+        WebRtc_rdft(fft_size, -1, data.data(), ip.data(), w.data());
+      }
+      RTC_LOG(LS_INFO) << "fft4g " << fft_size << ": "
+                       << (rtc::TimeMicros() - start_us) * 1000 /
+                              kNumIterations
+                       << " ns";
+    }
+
+    if (fft_size == 128) {
+      OouraFft ooura_fft;
+      std::vector<float> data(in_view.begin(), in_view.end());
+      start_us = rtc::TimeMicros();
+      for (int k = 0; k < kNumIterations; ++k) {
+        ooura_fft.Fft(data.data());
+        ooura_fft.InverseFft(data.data());
+      }
+      RTC_LOG(LS_INFO) << "Ooura " << fft_size << ": "
+                       << (rtc::TimeMicros() - start_us) * 1000 /
+                              kNumIterations
+                       << " ns";
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace webrtc
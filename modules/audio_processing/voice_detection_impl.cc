@@ -64,8 +64,9 @@ bool VoiceDetectionImpl::ProcessCaptureAudio(AudioBuffer* audio) {
   rtc::ArrayView<const int16_t> mixed_low_pass(mixed_low_pass_data.data(),
                                                audio->num_frames_per_band());
   if (audio->num_channels() == 1) {
-    FloatS16ToS16(audio->split_bands_const(0)[kBand0To8kHz],
-                  audio->num_frames_per_band(), mixed_low_pass_data.data());
+    mixed_low_pass = rtc::ArrayView<const int16_t>(
+        audio->split_bands_const_s16(0)[kBand0To8kHz],
+        audio->num_frames_per_band());
   } else {
     const int num_channels = static_cast<int>(audio->num_channels());
     for (size_t i = 0; i < audio->num_frames_per_band(); ++i) {
@@ -43,6 +43,12 @@ constexpr DataSize kDefaultTCPMSS = DataSize::Bytes<1460>();
 // Constants based on TCP defaults.
 constexpr DataSize kMaxSegmentSize = kDefaultTCPMSS;
 
+// The pacer sends bursts of about a millisecond of data, but at least two max
+// size packets and at most 64 KB, like the send quantum of Linux TCP BBR.
+constexpr TimeDelta kSendQuantumTime = TimeDelta::Millis<1>();
+constexpr DataSize kMinSendQuantum = DataSize::Bytes<2 * 1452>();
+constexpr DataSize kMaxSendQuantum = DataSize::Bytes<64 * 1024>();
+
 // The gain used for the slow start, equal to 2/ln(2).
 const double kHighGain = 2.885f;
 // The gain used in STARTUP after loss has been detected.
@@ -285,6 +291,9 @@ NetworkControlUpdate BbrNetworkController::CreateRateUpdate(
   // A small time window ensures an even pacing rate.
   pacer_config.time_window = rtt * 0.25;
   pacer_config.data_window = pacer_config.time_window * pacing_rate;
+  pacer_config.send_quantum =
+      std::max(kMinSendQuantum,
+               std::min(kSendQuantumTime * pacing_rate, kMaxSendQuantum));
 
   if (IsProbingForMoreBandwidth())
     pacer_config.pad_window = pacer_config.data_window;
@@ -73,6 +73,8 @@ GoogCcNetworkController::GoogCcNetworkController(NetworkControllerConfig config,
           IsEnabled(key_value_config_, "WebRTC-Bwe-ProbeRateFallback")),
       use_min_allocatable_as_lower_bound_(
           IsNotDisabled(key_value_config_, "WebRTC-Bwe-MinAllocAsLowerBound")),
+      count_ecn_ce_as_loss_(
+          IsEnabled(key_value_config_, "WebRTC-Bwe-EcnCeAsLoss")),
       rate_control_settings_(
           RateControlSettings::ParseFromKeyValueConfig(key_value_config_)),
       probe_controller_(
@@ -367,8 +369,13 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportLossReport(
     return NetworkControlUpdate();
   int64_t total_packets_delta =
       msg.packets_received_delta + msg.packets_lost_delta;
+  // CE marked packets are counted as received by the loss report.
+  int64_t ce_marked_packets = std::min<int64_t>(
+      ce_marked_packets_since_last_loss_report_, msg.packets_received_delta);
+  ce_marked_packets_since_last_loss_report_ = 0;
   bandwidth_estimation_->UpdatePacketsLost(
-      msg.packets_lost_delta, total_packets_delta, msg.receive_time);
+      msg.packets_lost_delta + ce_marked_packets, total_packets_delta,
+      msg.receive_time);
   return NetworkControlUpdate();
 }
 
@@ -462,6 +469,12 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
       if (packet_feedback.receive_time.IsInfinite())
         lost_packets_since_last_loss_update_ += 1;
     }
+    if (count_ecn_ce_as_loss_) {
+      // A CE mark means that a queue on the path would have dropped the
+      // packet, so react to it like to a loss. The packet was received, so it
+      // is already counted as expected.
+      lost_packets_since_last_loss_update_ += report.ecn_ce_packets;
+    }
     if (report.feedback_time > next_loss_update_) {
       next_loss_update_ = report.feedback_time + kLossUpdateInterval;
       bandwidth_estimation_->UpdatePacketsLost(
@@ -470,6 +483,9 @@ NetworkControlUpdate GoogCcNetworkController::OnTransportPacketsFeedback(
       expected_packets_since_last_loss_update_ = 0;
       lost_packets_since_last_loss_update_ = 0;
     }
+  } else if (count_ecn_ce_as_loss_) {
+    // Added to the losses of the next RTCP loss report.
+    ce_marked_packets_since_last_loss_report_ += report.ecn_ce_packets;
   }
   absl::optional<int64_t> alr_start_time =
       alr_detector_->GetApplicationLimitedRegionStartTime();
@@ -88,6 +88,7 @@ class GoogCcNetworkController : public NetworkControllerInterface {
   const bool use_downlink_delay_for_congestion_window_;
   const bool fall_back_to_probe_rate_;
   const bool use_min_allocatable_as_lower_bound_;
+  const bool count_ecn_ce_as_loss_;
   const RateControlSettings rate_control_settings_;
 
   const std::unique_ptr<ProbeController> probe_controller_;
@@ -115,6 +116,8 @@ class GoogCcNetworkController : public NetworkControllerInterface {
   Timestamp next_loss_update_ = Timestamp::MinusInfinity();
   int lost_packets_since_last_loss_update_ = 0;
   int expected_packets_since_last_loss_update_ = 0;
+  // Packets reported as CE marked by the ECN feedback, when counted as losses.
+  int64_t ce_marked_packets_since_last_loss_report_ = 0;
 
   std::deque<int64_t> feedback_max_rtts_;
 
@@ -206,7 +206,9 @@ class GoogCcNetworkControllerTest : public ::testing::Test {
       target_bitrate_ = update.target_rate->target_rate;
   }
 
-  void PacketTransmissionAndFeedbackBlock(int64_t runtime_ms, int64_t delay) {
+  void PacketTransmissionAndFeedbackBlock(int64_t runtime_ms,
+                                          int64_t delay,
+                                          bool ecn_ce_marked = false) {
     int64_t delay_buildup = 0;
     int64_t start_time_ms = current_time_.ms();
     while (current_time_.ms() - start_time_ms < runtime_ms) {
@@ -219,6 +221,8 @@ class GoogCcNetworkControllerTest : public ::testing::Test {
       TransportPacketsFeedback feedback;
       feedback.feedback_time = packet.receive_time;
       feedback.packet_feedbacks.push_back(packet);
+      feedback.ecn_capable_packets = 1;
+      feedback.ecn_ce_packets = ecn_ce_marked ? 1 : 0;
       OnUpdate(controller_->OnTransportPacketsFeedback(feedback));
       AdvanceTimeMilliseconds(50);
       OnUpdate(controller_->OnProcessInterval(DefaultInterval()));
@@ -339,6 +343,29 @@ TEST_F(GoogCcNetworkControllerTest, UpdatesDelayBasedEstimate) {
   EXPECT_LT(*target_bitrate_, bitrate_before_delay);
 }
 
+TEST_F(GoogCcNetworkControllerTest, ReducesRateOnEcnCeMarksInTrial) {
+  ScopedFieldTrials trial("WebRTC-Bwe-EcnCeAsLoss/Enabled/");
+  TargetBitrateTrackingSetup();
+  const int64_t kRunTimeMs = 6000;
+
+  PacketTransmissionAndFeedbackBlock(kRunTimeMs, 0);
+  ASSERT_TRUE(target_bitrate_.has_value());
+
+  // All packets arrive without queuing delay, and the loss reports show no
+  // losses, but all packets are marked as congested.
+  DataRate bitrate_before_marks = *target_bitrate_;
+  const int64_t kLossReportIntervalMs = 1000;
+  for (int64_t i = 0; i < kRunTimeMs; i += kLossReportIntervalMs) {
+    PacketTransmissionAndFeedbackBlock(kLossReportIntervalMs, 0,
+                                       /*ecn_ce_marked=*/true);
+    TransportLossReport loss_report;
+    loss_report.receive_time = current_time_;
+    loss_report.packets_received_delta = 20;
+    OnUpdate(controller_->OnTransportLossReport(loss_report));
+  }
+  EXPECT_LT(*target_bitrate_, bitrate_before_marks);
+}
+
 TEST_F(GoogCcNetworkControllerTest,
        PaddingRateLimitedByCongestionWindowInTrial) {
   ScopedFieldTrials trial(
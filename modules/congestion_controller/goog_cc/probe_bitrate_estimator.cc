@@ -19,6 +19,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace {
@@ -83,6 +84,8 @@ absl::optional<DataRate> ProbeBitrateEstimator::HandleProbeAndEstimateBitrate(
     cluster->last_receive = packet_feedback.receive_time;
   }
   cluster->size_total += packet_feedback.sent_packet.size;
+  if (packet_feedback.sent_packet.is_padding)
+    cluster->size_padding += packet_feedback.sent_packet.size;
   cluster->num_probes += 1;
 
   RTC_DCHECK_GT(
@@ -157,7 +160,8 @@ absl::optional<DataRate> ProbeBitrateEstimator::HandleProbeAndEstimateBitrate(
                    << " ]"
                    << " [receive: " << ToString(receive_size) << " / "
                    << ToString(receive_interval) << " = "
-                   << ToString(receive_rate) << "]";
+                   << ToString(receive_rate) << "]"
+                   << " [padding: " << ToString(cluster->size_padding) << "]";
 
   DataRate res = std::min(send_rate, receive_rate);
   // If we're receiving at significantly lower bitrate than we were sending at,
@@ -171,6 +175,7 @@ absl::optional<DataRate> ProbeBitrateEstimator::HandleProbeAndEstimateBitrate(
     event_log_->Log(
         std::make_unique<RtcEventProbeResultSuccess>(cluster_id, res.bps()));
   }
+  ReportEfficiency(cluster, packet_feedback.sent_packet.pacing_info, res);
   last_estimate_ = res;
   estimated_data_rate_ = res;
   return res;
@@ -187,6 +192,23 @@ absl::optional<DataRate> ProbeBitrateEstimator::last_estimate() const {
   return last_estimate_;
 }
 
+void ProbeBitrateEstimator::ReportEfficiency(
+    AggregatedCluster* cluster,
+    const PacedPacketInfo& pacing_info,
+    DataRate estimate) {
+  if (cluster->efficiency_reported)
+    return;
+  cluster->efficiency_reported = true;
+  RTC_HISTOGRAM_PERCENTAGE(
+      "WebRTC.BWE.Probing.PaddingPercentage",
+      static_cast<int>(100 * (cluster->size_padding / cluster->size_total)));
+  if (pacing_info.send_bitrate_bps > 0) {
+    RTC_HISTOGRAM_COUNTS_1000(
+        "WebRTC.BWE.Probing.EstimateToProbeRatePercentage",
+        static_cast<int>(100 * estimate.bps() / pacing_info.send_bitrate_bps));
+  }
+}
+
 void ProbeBitrateEstimator::EraseOldClusters(Timestamp timestamp) {
   for (auto it = clusters_.begin(); it != clusters_.end();) {
     if (it->second.last_receive + kMaxClusterHistory < timestamp) {
@@ -45,8 +45,17 @@ class ProbeBitrateEstimator {
     DataSize size_last_send = DataSize::Zero();
     DataSize size_first_receive = DataSize::Zero();
     DataSize size_total = DataSize::Zero();
+    // The part of |size_total| that was padding rather than media.
+    DataSize size_padding = DataSize::Zero();
+    bool efficiency_reported = false;
   };
 
+  // Reports how much of |cluster| was padding, and how close the estimate
+  // got to the probed bitrate, once per cluster.
+  void ReportEfficiency(AggregatedCluster* cluster,
+                        const PacedPacketInfo& pacing_info,
+                        DataRate estimate);
+
   // Erases old cluster data that was seen before |timestamp|.
   void EraseOldClusters(Timestamp timestamp);
 
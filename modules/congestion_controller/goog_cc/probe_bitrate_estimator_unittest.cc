@@ -13,6 +13,7 @@
 #include <stddef.h>
 
 #include "api/transport/network_types.h"
+#include "system_wrappers/include/metrics.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -21,6 +22,7 @@ namespace {
 constexpr int kDefaultMinProbes = 5;
 constexpr int kDefaultMinBytes = 5000;
 constexpr float kTargetUtilizationFraction = 0.95f;
+constexpr int kProbeBitrateBps = 1000000;
 }  // anonymous namespace
 
 class TestProbeBitrateEstimator : public ::testing::Test {
@@ -34,7 +36,8 @@ class TestProbeBitrateEstimator : public ::testing::Test {
                          int64_t send_time_ms,
                          int64_t arrival_time_ms,
                          int min_probes = kDefaultMinProbes,
-                         int min_bytes = kDefaultMinBytes) {
+                         int min_bytes = kDefaultMinBytes,
+                         bool is_padding = false) {
     const Timestamp kReferenceTime = Timestamp::seconds(1000);
     PacketResult feedback;
     feedback.sent_packet.send_time =
@@ -42,6 +45,8 @@ class TestProbeBitrateEstimator : public ::testing::Test {
     feedback.sent_packet.size = DataSize::bytes(size_bytes);
     feedback.sent_packet.pacing_info =
         PacedPacketInfo(probe_cluster_id, min_probes, min_bytes);
+    feedback.sent_packet.pacing_info.send_bitrate_bps = kProbeBitrateBps;
+    feedback.sent_packet.is_padding = is_padding;
     feedback.receive_time = kReferenceTime + TimeDelta::ms(arrival_time_ms);
     measured_data_rate_ =
         probe_bitrate_estimator_.HandleProbeAndEstimateBitrate(feedback);
@@ -225,4 +230,23 @@ TEST_F(TestProbeBitrateEstimator, FetchLastEstimatedBitrateBps) {
   EXPECT_FALSE(probe_bitrate_estimator_.FetchAndResetLastEstimatedBitrate());
 }
 
+TEST_F(TestProbeBitrateEstimator, ReportsEfficiencyOncePerCluster) {
+  metrics::Reset();
+  AddPacketFeedback(0, 1000, 0, 10);
+  AddPacketFeedback(0, 1000, 10, 20);
+  AddPacketFeedback(0, 1000, 20, 30, kDefaultMinProbes, kDefaultMinBytes,
+                    /*is_padding=*/true);
+  AddPacketFeedback(0, 1000, 30, 40, kDefaultMinProbes, kDefaultMinBytes,
+                    /*is_padding=*/true);
+  ASSERT_TRUE(measured_data_rate_);
+  // Packets arriving after the estimate don't add samples.
+  AddPacketFeedback(0, 1000, 40, 50);
+
+  EXPECT_EQ(1, metrics::NumSamples("WebRTC.BWE.Probing.PaddingPercentage"));
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.BWE.Probing.PaddingPercentage", 50));
+  // 800 kbps of the probed 1000 kbps.
+  EXPECT_EQ(1, metrics::NumEvents(
+                   "WebRTC.BWE.Probing.EstimateToProbeRatePercentage", 80));
+}
+
 }  // namespace webrtc
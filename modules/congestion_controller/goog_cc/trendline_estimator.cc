@@ -50,6 +50,17 @@ constexpr double kDefaultTrendlineSmoothingCoeff = 0.9;
 constexpr double kDefaultTrendlineThresholdGain = 4.0;
 const char kBweWindowSizeInPacketsExperiment[] =
     "WebRTC-BweWindowSizeInPackets";
+const char kBweIncrementalTrendlineFitExperiment[] =
+    "WebRTC-Bwe-TrendlineIncrementalFit";
+
+// How many points are added between recomputing the co-moments of a
+// SlidingWindowLinearFit from its points. Recomputing costs a pass over the
+// window, so this keeps the amortized cost per point constant too.
+constexpr size_t kPointsPerRecompute = 1000;
+// Below this, the co-moment of x is treated as rounding errors of x values
+// that are all equal. The arrival times fitted by the trendline are whole
+// milliseconds, which gives a co-moment of at least 0.5 otherwise.
+constexpr double kMinCoMomentXx = 1e-9;
 
 size_t ReadTrendlineFilterWindowSize(
     const WebRtcKeyValueConfig* key_value_config) {
@@ -68,7 +79,63 @@ size_t ReadTrendlineFilterWindowSize(
   return kDefaultTrendlineWindowSize;
 }
 
-absl::optional<double> LinearFitSlope(
+constexpr double kMaxAdaptOffsetMs = 15.0;
+constexpr double kOverUsingTimeThreshold = 10;
+constexpr int kMinNumDeltas = 60;
+constexpr int kDeltaCounterMax = 1000;
+
+}  // namespace
+
+SlidingWindowLinearFit::SlidingWindowLinearFit(size_t window_size)
+    : window_size_(window_size), points_until_recompute_(kPointsPerRecompute) {
+  RTC_DCHECK_GE(window_size_, 1);
+}
+
+SlidingWindowLinearFit::~SlidingWindowLinearFit() = default;
+
+void SlidingWindowLinearFit::AddPoint(double x, double y) {
+  if (points_.size() == window_size_) {
+    const std::pair<double, double> oldest = points_.front();
+    points_.pop_front();
+    if (points_.empty()) {
+      mean_x_ = 0;
+      mean_y_ = 0;
+      co_moment_xx_ = 0;
+      co_moment_xy_ = 0;
+    } else {
+      const size_t n = points_.size();
+      const double dx = oldest.first - mean_x_;
+      mean_x_ -= dx / n;
+      mean_y_ -= (oldest.second - mean_y_) / n;
+      co_moment_xx_ -= dx * (oldest.first - mean_x_);
+      co_moment_xy_ -= dx * (oldest.second - mean_y_);
+    }
+  }
+  points_.emplace_back(x, y);
+  const size_t n = points_.size();
+  const double dx = x - mean_x_;
+  mean_x_ += dx / n;
+  mean_y_ += (y - mean_y_) / n;
+  co_moment_xx_ += dx * (x - mean_x_);
+  co_moment_xy_ += dx * (y - mean_y_);
+
+  if (--points_until_recompute_ == 0) {
+    Recompute();
+    points_until_recompute_ = kPointsPerRecompute;
+  }
+}
+
+absl::optional<double> SlidingWindowLinearFit::Slope() const {
+  RTC_DCHECK_GE(points_.size(), 2);
+  if (co_moment_xx_ < kMinCoMomentXx) {
+    // All x may be equal. Let the exact computation decide, which only costs
+    // a pass over the window in this rare case.
+    return ExactSlope(points_);
+  }
+  return co_moment_xy_ / co_moment_xx_;
+}
+
+absl::optional<double> SlidingWindowLinearFit::ExactSlope(
     const std::deque<std::pair<double, double>>& points) {
   RTC_DCHECK(points.size() >= 2);
   // Compute the "center of mass".
@@ -92,12 +159,22 @@ absl::optional<double> LinearFitSlope(
   return numerator / denominator;
 }
 
-constexpr double kMaxAdaptOffsetMs = 15.0;
-constexpr double kOverUsingTimeThreshold = 10;
-constexpr int kMinNumDeltas = 60;
-constexpr int kDeltaCounterMax = 1000;
-
-}  // namespace
+void SlidingWindowLinearFit::Recompute() {
+  double sum_x = 0;
+  double sum_y = 0;
+  for (const auto& point : points_) {
+    sum_x += point.first;
+    sum_y += point.second;
+  }
+  mean_x_ = sum_x / points_.size();
+  mean_y_ = sum_y / points_.size();
+  co_moment_xx_ = 0;
+  co_moment_xy_ = 0;
+  for (const auto& point : points_) {
+    co_moment_xx_ += (point.first - mean_x_) * (point.first - mean_x_);
+    co_moment_xy_ += (point.first - mean_x_) * (point.second - mean_y_);
+  }
+}
 
 TrendlineEstimator::TrendlineEstimator(
     const WebRtcKeyValueConfig* key_value_config,
@@ -114,7 +191,10 @@ TrendlineEstimator::TrendlineEstimator(
       first_arrival_time_ms_(-1),
       accumulated_delay_(0),
       smoothed_delay_(0),
-      delay_hist_(),
+      delay_hist_(window_size_),
+      incremental_fit_(
+          key_value_config->Lookup(kBweIncrementalTrendlineFitExperiment)
+              .find("Enabled") == 0),
       k_up_(0.0087),
       k_down_(0.039),
       overusing_time_threshold_(kOverUsingTimeThreshold),
@@ -175,19 +255,21 @@ void TrendlineEstimator::UpdateTrendline(double recv_delta_ms,
                         smoothed_delay_);
 
   // Simple linear regression.
-  delay_hist_.push_back(std::make_pair(
+  delay_hist_.AddPoint(
       static_cast<double>(arrival_time_ms - first_arrival_time_ms_),
-      smoothed_delay_));
-  if (delay_hist_.size() > window_size_)
-    delay_hist_.pop_front();
+      smoothed_delay_);
   double trend = prev_trend_;
-  if (delay_hist_.size() == window_size_) {
+  if (delay_hist_.points().size() == window_size_) {
     // Update trend_ if it is possible to fit a line to the data. The delay
     // trend can be seen as an estimate of (send_rate - capacity)/capacity.
     // 0 < trend < 1   ->  the delay increases, queues are filling up
     //   trend == 0    ->  the delay does not change
     //   trend < 0     ->  the delay decreases, queues are being emptied
-    trend = LinearFitSlope(delay_hist_).value_or(trend);
+    absl::optional<double> slope =
+        incremental_fit_
+            ? delay_hist_.Slope()
+            : SlidingWindowLinearFit::ExactSlope(delay_hist_.points());
+    trend = slope.value_or(trend);
   }
   BWE_TEST_LOGGING_PLOT(1, "trendline_slope", arrival_time_ms, trend);
 
@@ -17,6 +17,7 @@
 #include <memory>
 #include <utility>
 
+#include "absl/types/optional.h"
 #include "api/network_state_predictor.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/congestion_controller/goog_cc/delay_increase_detector_interface.h"
@@ -41,6 +42,45 @@ struct BweIgnoreSmallPacketsSettings {
   std::unique_ptr<StructParametersParser> Parser();
 };
 
+// Least squares fit of a line to the points in a sliding window. Adding a point
+// updates the means and co-moments of the points like Welford's algorithm
+// does, so the slope is available in constant time instead of by a pass over
+// the window. The co-moments are recomputed from the points now and then, so
+// that rounding errors don't accumulate.
+class SlidingWindowLinearFit {
+ public:
+  explicit SlidingWindowLinearFit(size_t window_size);
+  ~SlidingWindowLinearFit();
+
+  // Adds a point, and removes the oldest one if the window is full.
+  void AddPoint(double x, double y);
+
+  const std::deque<std::pair<double, double>>& points() const {
+    return points_;
+  }
+
+  // Returns the slope of the fitted line, or nullopt if the x of all points
+  // are equal. There must be at least two points.
+  absl::optional<double> Slope() const;
+
+  // Computes the slope of |points| with a pass over them, which is how Slope()
+  // is done without the running sums.
+  static absl::optional<double> ExactSlope(
+      const std::deque<std::pair<double, double>>& points);
+
+ private:
+  void Recompute();
+
+  const size_t window_size_;
+  std::deque<std::pair<double, double>> points_;
+  double mean_x_ = 0;
+  double mean_y_ = 0;
+  // Sums of (x - mean_x_)^2 and of (x - mean_x_) * (y - mean_y_).
+  double co_moment_xx_ = 0;
+  double co_moment_xy_ = 0;
+  size_t points_until_recompute_;
+};
+
 class TrendlineEstimator : public DelayIncreaseDetectorInterface {
  public:
   TrendlineEstimator(const WebRtcKeyValueConfig* key_value_config,
@@ -89,7 +129,10 @@ class TrendlineEstimator : public DelayIncreaseDetectorInterface {
   double accumulated_delay_;
   double smoothed_delay_;
   // Linear least squares regression.
-  std::deque<std::pair<double, double>> delay_hist_;
+  SlidingWindowLinearFit delay_hist_;
+  // Whether to use the running sums of |delay_hist_| for the slope, instead of
+  // a pass over the window.
+  const bool incremental_fit_;
 
   const double k_up_;
   const double k_down_;
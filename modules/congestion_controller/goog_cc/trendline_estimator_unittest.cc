@@ -11,11 +11,13 @@
 #include "modules/congestion_controller/goog_cc/trendline_estimator.h"
 
 #include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <vector>
 
 #include "api/transport/field_trial_based_config.h"
 #include "rtc_base/random.h"
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -148,4 +150,63 @@ TEST_F(TrendlineEstimatorTest, IncludesSmallPacketsByDefault) {
   EXPECT_EQ(count, kPacketCount);  // All packets processed
 }
 
+TEST_F(TrendlineEstimatorTest, IncrementalFitGivesSameState) {
+  test::ScopedFieldTrials field_trial(
+      "WebRTC-Bwe-TrendlineIncrementalFit/Enabled/");
+  const FieldTrialBasedConfig incremental_config;
+  TrendlineEstimator incremental_estimator(&incremental_config, nullptr);
+  Random random(0x1234);
+  int64_t send_time_ms = 123456789;
+  int64_t recv_time_ms = 987654321;
+  for (int i = 0; i < 2000; ++i) {
+    // Alternate between slower and faster delivery than the send pace.
+    int64_t send_delta_ms = 20;
+    int64_t recv_delta_ms = (i / 100) % 2 ? random.Rand(12, 24)
+                                          : random.Rand(16, 28);
+    send_time_ms += send_delta_ms;
+    recv_time_ms += recv_delta_ms;
+    estimator.Update(recv_delta_ms, send_delta_ms, send_time_ms, recv_time_ms,
+                     kPacketSizeBytes, true);
+    incremental_estimator.Update(recv_delta_ms, send_delta_ms, send_time_ms,
+                                 recv_time_ms, kPacketSizeBytes, true);
+    ASSERT_EQ(estimator.State(), incremental_estimator.State());
+  }
+}
+
+TEST(SlidingWindowLinearFitTest, MatchesExactSlope) {
+  const size_t kWindowSize = 20;
+  SlidingWindowLinearFit fit(kWindowSize);
+  Random random(0x5eed);
+  // Arrival times an hour into a call, with a random walk for the delay.
+  double x = 3600 * 1000;
+  double y = 0;
+  for (int i = 0; i < 10000; ++i) {
+    x += random.Rand(1, 30);
+    y += random.Gaussian(0, 5);
+    fit.AddPoint(x, y);
+    if (fit.points().size() < 2)
+      continue;
+    ASSERT_LE(fit.points().size(), kWindowSize);
+    absl::optional<double> exact =
+        SlidingWindowLinearFit::ExactSlope(fit.points());
+    absl::optional<double> slope = fit.Slope();
+    ASSERT_TRUE(exact);
+    ASSERT_TRUE(slope);
+    EXPECT_NEAR(*exact, *slope, 1e-9 + 1e-6 * std::abs(*exact));
+  }
+}
+
+TEST(SlidingWindowLinearFitTest, NoSlopeWhenAllXAreEqual) {
+  SlidingWindowLinearFit fit(4);
+  fit.AddPoint(1, 10);
+  fit.AddPoint(2, 20);
+  for (int i = 0; i < 4; ++i)
+    fit.AddPoint(5, i);
+  EXPECT_FALSE(fit.Slope());
+
+  fit.AddPoint(6, 4);
+  ASSERT_TRUE(fit.Slope());
+  EXPECT_DOUBLE_EQ(2.0, *fit.Slope());
+}
+
 }  // namespace webrtc
@@ -20,6 +20,7 @@
 #include "modules/remote_bitrate_estimator/remote_estimator_proxy.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/network/ecn_marking.h"
 
 namespace webrtc {
 class RemoteBitrateEstimator;
@@ -44,6 +45,12 @@ class ReceiveSideCongestionController : public CallStatsObserver,
   virtual void OnReceivedPacket(int64_t arrival_time_ms,
                                 size_t payload_size,
                                 const RTPHeader& header);
+  // |ecn| is the ECN field of the IP packet, which is reported back to the
+  // sender with send-side BWE.
+  void OnReceivedPacket(int64_t arrival_time_ms,
+                        size_t payload_size,
+                        const RTPHeader& header,
+                        rtc::EcnMarking ecn);
 
   void SetSendPeriodicFeedback(bool send_periodic_feedback);
   // TODO(nisse): Delete these methods, design a more specific interface.
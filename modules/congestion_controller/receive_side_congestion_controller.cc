@@ -137,7 +137,17 @@ void ReceiveSideCongestionController::OnReceivedPacket(
     int64_t arrival_time_ms,
     size_t payload_size,
     const RTPHeader& header) {
-  remote_estimator_proxy_.IncomingPacket(arrival_time_ms, payload_size, header);
+  OnReceivedPacket(arrival_time_ms, payload_size, header,
+                   rtc::EcnMarking::kNotEct);
+}
+
+void ReceiveSideCongestionController::OnReceivedPacket(
+    int64_t arrival_time_ms,
+    size_t payload_size,
+    const RTPHeader& header,
+    rtc::EcnMarking ecn) {
+  remote_estimator_proxy_.IncomingPacket(arrival_time_ms, payload_size, header,
+                                         ecn);
   if (!header.extension.hasTransportSequenceNumber) {
     // Receive-side BWE.
     remote_bitrate_estimator_.IncomingPacket(arrival_time_ms, payload_size,
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/rtp/route_state_cache.h"
+
+namespace webrtc {
+namespace {
+// Time on a route before the estimate is assumed to have converged.
+constexpr TimeDelta kConvergenceTime = TimeDelta::Seconds<5>();
+// The capacity of a route that was left longer ago than this may have
+// changed too much for the cached state to be useful.
+constexpr TimeDelta kMaxStateAge = TimeDelta::Seconds<60>();
+// Loss above this level is treated as a route going bad.
+constexpr float kMaxLossRateRatio = 0.1f;
+// Routes are only cached while they are recent, so this is only a safeguard.
+constexpr size_t kMaxRoutes = 16;
+}  // namespace
+
+RouteStateCache::RouteStateCache() = default;
+RouteStateCache::~RouteStateCache() = default;
+
+void RouteStateCache::OnRouteChange(uint16_t local_network_id,
+                                    uint16_t remote_network_id,
+                                    Timestamp at_time) {
+  current_route_ = RouteId(local_network_id, remote_network_id);
+  current_route_start_ = at_time;
+  for (auto it = states_.begin(); it != states_.end();) {
+    if (at_time - it->second.at_time > kMaxStateAge) {
+      it = states_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void RouteStateCache::OnTargetRate(const TargetTransferRate& target_rate) {
+  if (!current_route_ ||
+      target_rate.at_time - current_route_start_ < kConvergenceTime) {
+    return;
+  }
+  if (states_.size() >= kMaxRoutes && states_.count(*current_route_) == 0) {
+    auto oldest = states_.begin();
+    for (auto it = states_.begin(); it != states_.end(); ++it) {
+      if (it->second.at_time < oldest->second.at_time)
+        oldest = it;
+    }
+    states_.erase(oldest);
+  }
+  RouteState& state = states_[*current_route_];
+  state.at_time = target_rate.at_time;
+  state.target_rate = target_rate.target_rate;
+  state.round_trip_time = target_rate.network_estimate.round_trip_time;
+  state.loss_rate_ratio = target_rate.network_estimate.loss_rate_ratio;
+}
+
+absl::optional<RouteStateCache::RouteState> RouteStateCache::GetState(
+    uint16_t local_network_id,
+    uint16_t remote_network_id,
+    Timestamp at_time) const {
+  auto it = states_.find(RouteId(local_network_id, remote_network_id));
+  if (it == states_.end())
+    return absl::nullopt;
+  const RouteState& state = it->second;
+  if (at_time - state.at_time > kMaxStateAge ||
+      state.loss_rate_ratio > kMaxLossRateRatio ||
+      state.target_rate.IsZero()) {
+    return absl::nullopt;
+  }
+  return state;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_RTP_ROUTE_STATE_CACHE_H_
+#define MODULES_CONGESTION_CONTROLLER_RTP_ROUTE_STATE_CACHE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+
+#include "absl/types/optional.h"
+#include "api/transport/network_types.h"
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+
+namespace webrtc {
+
+// Remembers the congestion state that the network controller converged to on
+// each network route, keyed by the local and remote network ids. When the
+// selected route flaps, e.g. between WiFi and cellular, the controller can be
+// seeded with the state of the route it switches back to instead of starting
+// over from the start rate.
+class RouteStateCache {
+ public:
+  struct RouteState {
+    Timestamp at_time = Timestamp::MinusInfinity();
+    DataRate target_rate = DataRate::Zero();
+    TimeDelta round_trip_time = TimeDelta::PlusInfinity();
+    float loss_rate_ratio = 0;
+  };
+
+  RouteStateCache();
+  ~RouteStateCache();
+
+  // Makes the route with the given ids the one that target rate updates
+  // belong to.
+  void OnRouteChange(uint16_t local_network_id,
+                     uint16_t remote_network_id,
+                     Timestamp at_time);
+  // Remembers |target_rate| for the current route. Updates during the first
+  // seconds on a route are ignored, since they don't reflect the route yet.
+  void OnTargetRate(const TargetTransferRate& target_rate);
+
+  // Returns the state of the route with the given ids, unless there is none,
+  // it is too old to be trusted at |at_time|, or the route was lossy enough
+  // that it might be why it was left.
+  absl::optional<RouteState> GetState(uint16_t local_network_id,
+                                      uint16_t remote_network_id,
+                                      Timestamp at_time) const;
+
+ private:
+  using RouteId = std::pair<uint16_t, uint16_t>;
+
+  absl::optional<RouteId> current_route_;
+  Timestamp current_route_start_ = Timestamp::MinusInfinity();
+  std::map<RouteId, RouteState> states_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_RTP_ROUTE_STATE_CACHE_H_
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/rtp/route_state_cache.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint16_t kWifi = 1;
+constexpr uint16_t kCellular = 2;
+constexpr uint16_t kRemote = 3;
+
+TargetTransferRate CreateTargetRate(Timestamp at_time,
+                                    DataRate rate,
+                                    float loss_rate_ratio = 0) {
+  TargetTransferRate target_rate;
+  target_rate.at_time = at_time;
+  target_rate.target_rate = rate;
+  target_rate.network_estimate.at_time = at_time;
+  target_rate.network_estimate.round_trip_time = TimeDelta::ms(80);
+  target_rate.network_estimate.loss_rate_ratio = loss_rate_ratio;
+  return target_rate;
+}
+
+}  // namespace
+
+TEST(RouteStateCacheTest, ReturnsStateOfPreviousRoute) {
+  RouteStateCache cache;
+  Timestamp now = Timestamp::seconds(100);
+  cache.OnRouteChange(kWifi, kRemote, now);
+  now += TimeDelta::seconds(10);
+  cache.OnTargetRate(CreateTargetRate(now, DataRate::kbps(2000)));
+  cache.OnRouteChange(kCellular, kRemote, now);
+
+  now += TimeDelta::seconds(2);
+  absl::optional<RouteStateCache::RouteState> state =
+      cache.GetState(kWifi, kRemote, now);
+  ASSERT_TRUE(state);
+  EXPECT_EQ(state->target_rate, DataRate::kbps(2000));
+  EXPECT_EQ(state->round_trip_time, TimeDelta::ms(80));
+  EXPECT_FALSE(cache.GetState(kCellular, kRemote, now));
+}
+
+TEST(RouteStateCacheTest, IgnoresUpdatesBeforeConvergence) {
+  RouteStateCache cache;
+  Timestamp now = Timestamp::seconds(100);
+  cache.OnRouteChange(kWifi, kRemote, now);
+  now += TimeDelta::seconds(1);
+  cache.OnTargetRate(CreateTargetRate(now, DataRate::kbps(300)));
+  EXPECT_FALSE(cache.GetState(kWifi, kRemote, now));
+}
+
+TEST(RouteStateCacheTest, ExpiresOldState) {
+  RouteStateCache cache;
+  Timestamp now = Timestamp::seconds(100);
+  cache.OnRouteChange(kWifi, kRemote, now);
+  now += TimeDelta::seconds(10);
+  cache.OnTargetRate(CreateTargetRate(now, DataRate::kbps(2000)));
+  cache.OnRouteChange(kCellular, kRemote, now);
+  EXPECT_TRUE(cache.GetState(kWifi, kRemote, now + TimeDelta::seconds(30)));
+  EXPECT_FALSE(cache.GetState(kWifi, kRemote, now + TimeDelta::seconds(90)));
+}
+
+TEST(RouteStateCacheTest, DoesNotReturnLossyState) {
+  RouteStateCache cache;
+  Timestamp now = Timestamp::seconds(100);
+  cache.OnRouteChange(kWifi, kRemote, now);
+  now += TimeDelta::seconds(10);
+  cache.OnTargetRate(CreateTargetRate(now, DataRate::kbps(2000), 0.3f));
+  cache.OnRouteChange(kCellular, kRemote, now);
+  EXPECT_FALSE(cache.GetState(kWifi, kRemote, now));
+}
+
+}  // namespace webrtc
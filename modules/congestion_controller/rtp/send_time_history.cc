@@ -26,18 +26,33 @@ SendTimeHistory::~SendTimeHistory() {}
 
 void SendTimeHistory::RemoveOld(int64_t at_time_ms) {
   while (!history_.empty() &&
-         at_time_ms - history_.begin()->second.creation_time_ms >
+         at_time_ms - history_.front()->creation_time_ms >
              packet_age_limit_ms_) {
     // TODO(sprang): Warn if erasing (too many) old items?
-    RemovePacketBytes(history_.begin()->second);
-    history_.erase(history_.begin());
+    RemovePacketBytes(*history_.front());
+    ErasePacket(first_seq_num_);
   }
 }
 
 void SendTimeHistory::AddNewPacket(PacketFeedback packet) {
   packet.long_sequence_number =
       seq_num_unwrapper_.Unwrap(packet.sequence_number);
-  history_.insert(std::make_pair(packet.long_sequence_number, packet));
+  const int64_t seq_num = packet.long_sequence_number;
+  if (history_.empty()) {
+    first_seq_num_ = seq_num;
+    history_.emplace_back();
+  } else if (seq_num < first_seq_num_) {
+    history_.insert(history_.begin(), first_seq_num_ - seq_num,
+                    absl::nullopt);
+    first_seq_num_ = seq_num;
+  } else if (seq_num - first_seq_num_ >=
+             static_cast<int64_t>(history_.size())) {
+    history_.resize(seq_num - first_seq_num_ + 1);
+  } else if (history_[seq_num - first_seq_num_]) {
+    // Like std::map::insert, keep the packet that was added first.
+    return;
+  }
+  history_[seq_num - first_seq_num_].emplace(packet);
   if (packet.send_time_ms >= 0) {
     AddPacketBytes(packet);
     last_send_time_ms_ = std::max(last_send_time_ms_, packet.send_time_ms);
@@ -56,20 +71,20 @@ void SendTimeHistory::AddUntracked(size_t packet_size, int64_t send_time_ms) {
 SendTimeHistory::Status SendTimeHistory::OnSentPacket(uint16_t sequence_number,
                                                       int64_t send_time_ms) {
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  PacketFeedback* packet = FindPacket(unwrapped_seq_num);
+  if (!packet)
     return Status::kNotAdded;
-  bool packet_retransmit = it->second.send_time_ms >= 0;
-  it->second.send_time_ms = send_time_ms;
+  bool packet_retransmit = packet->send_time_ms >= 0;
+  packet->send_time_ms = send_time_ms;
   last_send_time_ms_ = std::max(last_send_time_ms_, send_time_ms);
   if (!packet_retransmit)
-    AddPacketBytes(it->second);
+    AddPacketBytes(*packet);
   if (pending_untracked_size_ > 0) {
     if (send_time_ms < last_untracked_send_time_ms_)
       RTC_LOG(LS_WARNING)
           << "appending acknowledged data for out of order packet. (Diff: "
           << last_untracked_send_time_ms_ - send_time_ms << " ms.)";
-    it->second.unacknowledged_data += pending_untracked_size_;
+    packet->unacknowledged_data += pending_untracked_size_;
     pending_untracked_size_ = 0;
   }
   return packet_retransmit ? Status::kDuplicate : Status::kOk;
@@ -80,9 +95,9 @@ absl::optional<PacketFeedback> SendTimeHistory::GetPacket(
   int64_t unwrapped_seq_num =
       seq_num_unwrapper_.UnwrapWithoutUpdate(sequence_number);
   absl::optional<PacketFeedback> optional_feedback;
-  auto it = history_.find(unwrapped_seq_num);
-  if (it != history_.end())
-    optional_feedback.emplace(it->second);
+  const PacketFeedback* packet = FindPacket(unwrapped_seq_num);
+  if (packet)
+    optional_feedback.emplace(*packet);
   return optional_feedback;
 }
 
@@ -93,17 +108,17 @@ bool SendTimeHistory::GetFeedback(PacketFeedback* packet_feedback,
       seq_num_unwrapper_.Unwrap(packet_feedback->sequence_number);
   UpdateAckedSeqNum(unwrapped_seq_num);
   RTC_DCHECK_GE(*last_ack_seq_num_, 0);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  const PacketFeedback* packet = FindPacket(unwrapped_seq_num);
+  if (!packet)
     return false;
 
   // Save arrival_time not to overwrite it.
   int64_t arrival_time_ms = packet_feedback->arrival_time_ms;
-  *packet_feedback = it->second;
+  *packet_feedback = *packet;
   packet_feedback->arrival_time_ms = arrival_time_ms;
 
   if (remove)
-    history_.erase(it);
+    ErasePacket(unwrapped_seq_num);
   return true;
 }
 
@@ -120,11 +135,39 @@ DataSize SendTimeHistory::GetOutstandingData(uint16_t local_net_id,
 absl::optional<int64_t> SendTimeHistory::GetFirstUnackedSendTime() const {
   if (!last_ack_seq_num_)
     return absl::nullopt;
-  auto it = history_.find(*last_ack_seq_num_);
-  if (it == history_.end() ||
-      it->second.send_time_ms == PacketFeedback::kNoSendTime)
+  const PacketFeedback* packet = FindPacket(*last_ack_seq_num_);
+  if (!packet || packet->send_time_ms == PacketFeedback::kNoSendTime)
     return absl::nullopt;
-  return it->second.send_time_ms;
+  return packet->send_time_ms;
+}
+
+PacketFeedback* SendTimeHistory::FindPacket(int64_t unwrapped_seq_num) {
+  return const_cast<PacketFeedback*>(
+      static_cast<const SendTimeHistory*>(this)->FindPacket(
+          unwrapped_seq_num));
+}
+
+const PacketFeedback* SendTimeHistory::FindPacket(
+    int64_t unwrapped_seq_num) const {
+  if (unwrapped_seq_num < first_seq_num_ ||
+      unwrapped_seq_num - first_seq_num_ >=
+          static_cast<int64_t>(history_.size())) {
+    return nullptr;
+  }
+  const absl::optional<PacketFeedback>& slot =
+      history_[unwrapped_seq_num - first_seq_num_];
+  return slot ? &*slot : nullptr;
+}
+
+void SendTimeHistory::ErasePacket(int64_t unwrapped_seq_num) {
+  RTC_DCHECK(FindPacket(unwrapped_seq_num));
+  history_[unwrapped_seq_num - first_seq_num_].reset();
+  while (!history_.empty() && !history_.front()) {
+    history_.pop_front();
+    ++first_seq_num_;
+  }
+  while (!history_.empty() && !history_.back())
+    history_.pop_back();
 }
 
 void SendTimeHistory::AddPacketBytes(const PacketFeedback& packet) {
@@ -156,13 +199,17 @@ void SendTimeHistory::UpdateAckedSeqNum(int64_t acked_seq_num) {
   if (last_ack_seq_num_ && *last_ack_seq_num_ >= acked_seq_num)
     return;
 
-  auto unacked_it = history_.begin();
+  int64_t unacked_seq_num = first_seq_num_;
   if (last_ack_seq_num_)
-    unacked_it = history_.lower_bound(*last_ack_seq_num_);
-
-  auto newly_acked_end = history_.upper_bound(acked_seq_num);
-  for (; unacked_it != newly_acked_end; ++unacked_it) {
-    RemovePacketBytes(unacked_it->second);
+    unacked_seq_num = std::max(unacked_seq_num, *last_ack_seq_num_);
+
+  int64_t newly_acked_end = std::min<int64_t>(
+      acked_seq_num + 1, first_seq_num_ + history_.size());
+  for (; unacked_seq_num < newly_acked_end; ++unacked_seq_num) {
+    const absl::optional<PacketFeedback>& packet =
+        history_[unacked_seq_num - first_seq_num_];
+    if (packet)
+      RemovePacketBytes(*packet);
   }
   last_ack_seq_num_.emplace(acked_seq_num);
 }
@@ -11,6 +11,7 @@
 #ifndef MODULES_CONGESTION_CONTROLLER_RTP_SEND_TIME_HISTORY_H_
 #define MODULES_CONGESTION_CONTROLLER_RTP_SEND_TIME_HISTORY_H_
 
+#include <deque>
 #include <map>
 #include <utility>
 
@@ -56,6 +57,12 @@ class SendTimeHistory {
  private:
   using RemoteAndLocalNetworkId = std::pair<uint16_t, uint16_t>;
 
+  // Returns the packet with |unwrapped_seq_num|, or null if it isn't in the
+  // history.
+  PacketFeedback* FindPacket(int64_t unwrapped_seq_num);
+  const PacketFeedback* FindPacket(int64_t unwrapped_seq_num) const;
+  void ErasePacket(int64_t unwrapped_seq_num);
+
   void AddPacketBytes(const PacketFeedback& packet);
   void RemovePacketBytes(const PacketFeedback& packet);
   void UpdateAckedSeqNum(int64_t acked_seq_num);
@@ -64,7 +71,14 @@ class SendTimeHistory {
   int64_t last_send_time_ms_ = -1;
   int64_t last_untracked_send_time_ms_ = -1;
   SequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketFeedback> history_;
+  // Packets indexed by unwrapped sequence number, starting at
+  // |first_seq_num_|. Packets that were never added, or that were already
+  // removed, leave empty slots; the first and last slots are never empty.
+  // Finding, adding and removing packets are index computations, which is much
+  // cheaper than a tree walk for the thousands of packets a transport feedback
+  // reports per second.
+  std::deque<absl::optional<PacketFeedback>> history_;
+  int64_t first_seq_num_ = 0;
   absl::optional<int64_t> last_ack_seq_num_;
   std::map<RemoteAndLocalNetworkId, size_t> in_flight_bytes_;
 
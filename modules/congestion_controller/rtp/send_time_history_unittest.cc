@@ -17,6 +17,9 @@
 
 #include "api/transport/network_types.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gtest.h"
 
@@ -256,5 +259,63 @@ TEST_F(SendTimeHistoryTest, InterlievedGetAndRemove) {
   EXPECT_TRUE(history_.GetFeedback(&packet3, true));
   EXPECT_EQ(packets[2], packet3);
 }
+
+TEST_F(SendTimeHistoryTest, AddBeforeFirstAndAfterGap) {
+  AddPacketWithSendTime(10, 100, 1, PacedPacketInfo());
+  AddPacketWithSendTime(20, 100, 2, PacedPacketInfo());
+  AddPacketWithSendTime(5, 100, 3, PacedPacketInfo());
+  EXPECT_EQ(300, history_.GetOutstandingData(0, 0).bytes());
+
+  for (uint16_t seq_num : {6, 11, 19, 21})
+    EXPECT_FALSE(history_.GetPacket(seq_num).has_value());
+  EXPECT_EQ(3, history_.GetPacket(5)->send_time_ms);
+  EXPECT_EQ(1, history_.GetPacket(10)->send_time_ms);
+  EXPECT_EQ(2, history_.GetPacket(20)->send_time_ms);
+
+  // Acking 10 acks 5 too, but not 20.
+  PacketFeedback packet(0, 10);
+  EXPECT_TRUE(history_.GetFeedback(&packet, true));
+  EXPECT_EQ(100, history_.GetOutstandingData(0, 0).bytes());
+  EXPECT_TRUE(history_.GetPacket(5).has_value());
+  EXPECT_FALSE(history_.GetPacket(10).has_value());
+}
+
+// Feeds the history with a synthetic trace of a high bitrate stream, with a
+// transport feedback every 50 ms that reports all packets sent since the last
+// one, minus a few lost ones. Run with --gtest_also_run_disabled_tests to get
+// the timings logged.
+TEST_F(SendTimeHistoryTest, DISABLED_FeedbackPerf) {
+  const int kPacketsPerMs = 5;
+  const int kFeedbackIntervalMs = 50;
+  const int kNumFeedbacks = 20000;
+  Random random(0x5eed);
+  uint16_t seq_num = 0;
+  uint16_t first_unreported_seq_num = 0;
+  int64_t elapsed_us = 0;
+  int num_reported = 0;
+  for (int i = 0; i < kNumFeedbacks; ++i) {
+    int64_t start_us = rtc::TimeMicros();
+    for (int ms = 0; ms < kFeedbackIntervalMs; ++ms) {
+      clock_.AdvanceTimeMilliseconds(1);
+      for (int j = 0; j < kPacketsPerMs; ++j) {
+        AddPacketWithSendTime(seq_num++, 1200, clock_.TimeInMilliseconds(),
+                              PacedPacketInfo());
+      }
+    }
+    for (; first_unreported_seq_num != seq_num; ++first_unreported_seq_num) {
+      if (random.Rand(0, 99) == 0)
+        continue;
+      PacketFeedback packet(clock_.TimeInMilliseconds(),
+                            first_unreported_seq_num);
+      num_reported += history_.GetFeedback(&packet, true);
+    }
+    elapsed_us += rtc::TimeMicros() - start_us;
+  }
+  EXPECT_GT(num_reported, 0);
+  RTC_LOG(LS_INFO) << "SendTimeHistory: "
+                   << (elapsed_us * 1000.0) /
+                          (kNumFeedbacks * kFeedbackIntervalMs * kPacketsPerMs)
+                   << " ns per packet";
+}
 }  // namespace test
 }  // namespace webrtc
@@ -18,6 +18,7 @@
 
 #include "api/units/timestamp.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -38,6 +39,7 @@ PacketResult NetworkPacketFeedbackFromRtpPacketFeedback(
   feedback.sent_packet.send_time = Timestamp::ms(pf.send_time_ms);
   feedback.sent_packet.size = DataSize::bytes(pf.payload_size);
   feedback.sent_packet.pacing_info = pf.pacing_info;
+  feedback.sent_packet.is_padding = pf.is_padding;
   feedback.sent_packet.prior_unacked_data =
       DataSize::bytes(pf.unacknowledged_data);
   return feedback;
@@ -90,6 +92,7 @@ void TransportFeedbackAdapter::AddPacket(const RtpPacketSendInfo& packet_info,
       packet_feedback.ssrc = packet_info.ssrc;
       packet_feedback.rtp_sequence_number = packet_info.rtp_sequence_number;
     }
+    packet_feedback.is_padding = packet_info.is_padding;
     send_time_history_.RemoveOld(creation_time.ms());
     send_time_history_.AddNewPacket(std::move(packet_feedback));
   }
@@ -173,9 +176,32 @@ TransportFeedbackAdapter::ProcessTransportFeedback(
   msg.feedback_time = feedback_receive_time;
   msg.prior_in_flight = prior_in_flight;
   msg.data_in_flight = GetOutstandingData();
+  msg.ecn_capable_packets = pending_ecn_capable_packets_;
+  msg.ecn_ce_packets = pending_ecn_ce_packets_;
+  pending_ecn_capable_packets_ = 0;
+  pending_ecn_ce_packets_ = 0;
   return msg;
 }
 
+void TransportFeedbackAdapter::ProcessEcnFeedback(
+    const rtcp::EcnFeedback& feedback) {
+  const uint32_t ect_count = feedback.ect0_count() + feedback.ect1_count();
+  const int32_t ect_delta =
+      static_cast<int32_t>(ect_count - last_ecn_ect_count_);
+  // The CE counter is only 16 bits, and wraps around.
+  const int16_t ce_delta =
+      static_cast<int16_t>(feedback.ce_count() - last_ecn_ce_count_);
+  if (ect_delta < 0 || ce_delta < 0) {
+    // Reordered feedback, the counts are already accounted for.
+    return;
+  }
+  last_ecn_ect_count_ = ect_count;
+  last_ecn_ce_count_ = feedback.ce_count();
+  // Packets marked CE by the network were ECN capable when sent.
+  pending_ecn_capable_packets_ += ect_delta + ce_delta;
+  pending_ecn_ce_packets_ += ce_delta;
+}
+
 void TransportFeedbackAdapter::SetNetworkIds(uint16_t local_id,
                                              uint16_t remote_id) {
   rtc::CritScope cs(&lock_);
@@ -210,37 +236,23 @@ std::vector<PacketFeedback> TransportFeedbackAdapter::GetPacketFeedbackVector(
   {
     rtc::CritScope cs(&lock_);
     size_t failed_lookups = 0;
-    int64_t offset_us = 0;
-    int64_t timestamp_ms = 0;
-    uint16_t seq_num = feedback.GetBaseSequence();
-    for (const auto& packet : feedback.GetReceivedPackets()) {
-      // Insert into the vector those unreceived packets which precede this
-      // iteration's received packet.
-      for (; seq_num != packet.sequence_number(); ++seq_num) {
-        PacketFeedback packet_feedback(PacketFeedback::kNotReceived, seq_num);
-        // Note: Element not removed from history because it might be reported
-        // as received by another feedback.
-        if (!send_time_history_.GetFeedback(&packet_feedback, false))
-          ++failed_lookups;
-        if (packet_feedback.local_net_id == local_net_id_ &&
-            packet_feedback.remote_net_id == remote_net_id_) {
-          packet_feedback_vector.push_back(packet_feedback);
-        }
-      }
-
-      // Handle this iteration's received packet.
-      offset_us += packet.delta_us();
-      timestamp_ms = current_offset_ms_ + (offset_us / 1000);
-      PacketFeedback packet_feedback(timestamp_ms, packet.sequence_number());
-      if (!send_time_history_.GetFeedback(&packet_feedback, true))
+    feedback.ForAllPackets([&](uint16_t sequence_number,
+                               int64_t delta_since_base_us) {
+      const bool received =
+          delta_since_base_us != rtcp::TransportFeedback::kNotReceived;
+      PacketFeedback packet_feedback(
+          received ? current_offset_ms_ + delta_since_base_us / 1000
+                   : PacketFeedback::kNotReceived,
+          sequence_number);
+      // Note: Lost packets are not removed from history because they might be
+      // reported as received by another feedback.
+      if (!send_time_history_.GetFeedback(&packet_feedback, received))
         ++failed_lookups;
       if (packet_feedback.local_net_id == local_net_id_ &&
           packet_feedback.remote_net_id == remote_net_id_) {
         packet_feedback_vector.push_back(packet_feedback);
       }
-
-      ++seq_num;
-    }
+    });
 
     if (failed_lookups > 0) {
       RTC_LOG(LS_WARNING) << "Failed to lookup send time for " << failed_lookups
@@ -27,6 +27,7 @@ class PacketFeedbackObserver;
 struct RtpPacketSendInfo;
 
 namespace rtcp {
+class EcnFeedback;
 class TransportFeedback;
 }  // namespace rtcp
 
@@ -47,6 +48,9 @@ class TransportFeedbackAdapter {
   absl::optional<TransportPacketsFeedback> ProcessTransportFeedback(
       const rtcp::TransportFeedback& feedback,
       Timestamp feedback_time);
+  // The ECN counts reported since the previous ECN feedback are added to the
+  // next transport feedback message.
+  void ProcessEcnFeedback(const rtcp::EcnFeedback& feedback);
 
   std::vector<PacketFeedback> GetTransportFeedbackVector() const;
 
@@ -68,6 +72,11 @@ class TransportFeedbackAdapter {
   int64_t current_offset_ms_;
   int64_t last_timestamp_us_;
   std::vector<PacketFeedback> last_packet_feedback_vector_;
+  // Cumulative counts of the last ECN feedback.
+  uint32_t last_ecn_ect_count_ = 0;
+  uint16_t last_ecn_ce_count_ = 0;
+  int64_t pending_ecn_capable_packets_ = 0;
+  int64_t pending_ecn_ce_packets_ = 0;
   uint16_t local_net_id_ RTC_GUARDED_BY(&lock_);
   uint16_t remote_net_id_ RTC_GUARDED_BY(&lock_);
 
@@ -16,6 +16,7 @@
 
 #include "modules/congestion_controller/rtp/congestion_controller_unittests_helper.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -169,6 +170,42 @@ TEST_F(TransportFeedbackAdapterTest, AdaptsFeedbackAndPopulatesSendTimes) {
   ComparePacketFeedbackVectors(packets, adapter_->GetTransportFeedbackVector());
 }
 
+TEST_F(TransportFeedbackAdapterTest, AddsEcnCountsToNextFeedback) {
+  const PacketFeedback packet(100, 200, 0, 1500, kPacingInfo0);
+  OnSentPacket(packet);
+  rtcp::TransportFeedback feedback;
+  feedback.SetBase(packet.sequence_number, packet.arrival_time_ms * 1000);
+  EXPECT_TRUE(feedback.AddReceivedPacket(packet.sequence_number,
+                                         packet.arrival_time_ms * 1000));
+
+  rtcp::EcnFeedback ecn_feedback;
+  ecn_feedback.SetEct0Count(8);
+  ecn_feedback.SetEct1Count(1);
+  ecn_feedback.SetCeCount(1);
+  adapter_->ProcessEcnFeedback(ecn_feedback);
+  rtcp::EcnFeedback later_ecn_feedback(ecn_feedback);
+  later_ecn_feedback.SetEct0Count(15);
+  later_ecn_feedback.SetCeCount(3);
+  adapter_->ProcessEcnFeedback(later_ecn_feedback);
+  // Reordered feedback is ignored.
+  adapter_->ProcessEcnFeedback(ecn_feedback);
+
+  absl::optional<TransportPacketsFeedback> msg =
+      adapter_->ProcessTransportFeedback(
+          feedback, Timestamp::ms(clock_.TimeInMilliseconds()));
+  ASSERT_TRUE(msg);
+  // CE marked packets are ECN capable packets too.
+  EXPECT_EQ(16 + 3, msg->ecn_capable_packets);
+  EXPECT_EQ(3, msg->ecn_ce_packets);
+
+  // The counts are only reported once.
+  msg = adapter_->ProcessTransportFeedback(
+      feedback, Timestamp::ms(clock_.TimeInMilliseconds()));
+  ASSERT_TRUE(msg);
+  EXPECT_EQ(0, msg->ecn_capable_packets);
+  EXPECT_EQ(0, msg->ecn_ce_packets);
+}
+
 TEST_F(TransportFeedbackAdapterTest, FeedbackVectorReportsUnreceived) {
   std::vector<PacketFeedback> sent_packets = {
       PacketFeedback(100, 220, 0, 1500, kPacingInfo0),
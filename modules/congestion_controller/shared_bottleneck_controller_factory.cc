@@ -0,0 +1,286 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/shared_bottleneck_controller_factory.h"
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/units/data_rate.h"
+#include "api/units/timestamp.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace {
+
+// How long a probe of one member keeps the other members from probing. Covers
+// the probe clusters and the feedback that the probe results are based on.
+constexpr TimeDelta kProbingTime = TimeDelta::Millis<1000>();
+
+constexpr int64_t kNoMaxBps = std::numeric_limits<int64_t>::max();
+
+}  // namespace
+
+class SharedBottleneckControllerFactory::Group {
+ public:
+  class Member;
+
+  std::unique_ptr<NetworkControllerInterface> CreateMember(
+      std::unique_ptr<NetworkControllerInterface> controller,
+      const StreamsConfig& streams_config);
+
+ private:
+  struct MemberState {
+    // Latest target rate of the member's own controller.
+    absl::optional<TargetTransferRate> estimate;
+    absl::optional<PacerConfig> pacer_config;
+    int64_t min_bps = 0;
+    int64_t max_bps = kNoMaxBps;
+    // The target rate that the member was last given.
+    absl::optional<DataRate> allocated_rate;
+  };
+
+  void RemoveMember(const Member* member);
+  void OnStreamsConfig(const Member* member, const StreamsConfig& msg);
+  // Applies the coordination of the group to |update| of |member|.
+  NetworkControlUpdate Coordinate(const Member* member,
+                                  NetworkControlUpdate update);
+  DataRate Allocate(const Member* member) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  rtc::CriticalSection crit_;
+  std::map<const Member*, MemberState> members_ RTC_GUARDED_BY(crit_);
+  const Member* probing_member_ RTC_GUARDED_BY(crit_) = nullptr;
+  Timestamp probing_until_ RTC_GUARDED_BY(crit_) = Timestamp::MinusInfinity();
+};
+
+class SharedBottleneckControllerFactory::Group::Member
+    : public NetworkControllerInterface {
+ public:
+  Member(Group* group, std::unique_ptr<NetworkControllerInterface> controller)
+      : group_(group), controller_(std::move(controller)) {}
+  ~Member() override { group_->RemoveMember(this); }
+
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability msg) override {
+    return Coordinate(controller_->OnNetworkAvailability(msg));
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange msg) override {
+    return Coordinate(controller_->OnNetworkRouteChange(msg));
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval msg) override {
+    return Coordinate(controller_->OnProcessInterval(msg));
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport msg) override {
+    return Coordinate(controller_->OnRemoteBitrateReport(msg));
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate msg) override {
+    return Coordinate(controller_->OnRoundTripTimeUpdate(msg));
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket msg) override {
+    return Coordinate(controller_->OnSentPacket(msg));
+  }
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket msg) override {
+    return Coordinate(controller_->OnReceivedPacket(msg));
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig msg) override {
+    group_->OnStreamsConfig(this, msg);
+    return Coordinate(controller_->OnStreamsConfig(msg));
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints msg) override {
+    return Coordinate(controller_->OnTargetRateConstraints(msg));
+  }
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport msg) override {
+    return Coordinate(controller_->OnTransportLossReport(msg));
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback msg) override {
+    return Coordinate(controller_->OnTransportPacketsFeedback(msg));
+  }
+  NetworkControlUpdate OnNetworkStateEstimate(
+      NetworkStateEstimate msg) override {
+    return Coordinate(controller_->OnNetworkStateEstimate(msg));
+  }
+
+ private:
+  NetworkControlUpdate Coordinate(NetworkControlUpdate update) {
+    return group_->Coordinate(this, std::move(update));
+  }
+
+  Group* const group_;
+  const std::unique_ptr<NetworkControllerInterface> controller_;
+};
+
+std::unique_ptr<NetworkControllerInterface>
+SharedBottleneckControllerFactory::Group::CreateMember(
+    std::unique_ptr<NetworkControllerInterface> controller,
+    const StreamsConfig& streams_config) {
+  auto member = std::make_unique<Member>(this, std::move(controller));
+  {
+    rtc::CritScope lock(&crit_);
+    members_[member.get()];
+  }
+  OnStreamsConfig(member.get(), streams_config);
+  return member;
+}
+
+void SharedBottleneckControllerFactory::Group::RemoveMember(
+    const Member* member) {
+  rtc::CritScope lock(&crit_);
+  members_.erase(member);
+  if (probing_member_ == member)
+    probing_member_ = nullptr;
+}
+
+void SharedBottleneckControllerFactory::Group::OnStreamsConfig(
+    const Member* member,
+    const StreamsConfig& msg) {
+  rtc::CritScope lock(&crit_);
+  MemberState& state = members_[member];
+  if (msg.min_total_allocated_bitrate)
+    state.min_bps = msg.min_total_allocated_bitrate->bps();
+  if (msg.max_total_allocated_bitrate) {
+    state.max_bps = msg.max_total_allocated_bitrate->IsFinite()
+                        ? msg.max_total_allocated_bitrate->bps()
+                        : kNoMaxBps;
+  }
+}
+
+NetworkControlUpdate SharedBottleneckControllerFactory::Group::Coordinate(
+    const Member* member,
+    NetworkControlUpdate update) {
+  rtc::CritScope lock(&crit_);
+  MemberState& state = members_[member];
+  if (update.target_rate)
+    state.estimate = update.target_rate;
+  if (update.pacer_config)
+    state.pacer_config = update.pacer_config;
+
+  if (!update.probe_cluster_configs.empty()) {
+    Timestamp at_time = update.probe_cluster_configs.front().at_time;
+    if (probing_member_ && probing_member_ != member &&
+        at_time < probing_until_) {
+      update.probe_cluster_configs.clear();
+    } else {
+      probing_member_ = member;
+      probing_until_ = at_time + kProbingTime;
+    }
+  }
+
+  if (!state.estimate)
+    return update;
+  DataRate allocated_rate = Allocate(member);
+  double ratio = 1.0;
+  if (state.estimate->target_rate > DataRate::Zero())
+    ratio = allocated_rate / state.estimate->target_rate;
+  if (update.target_rate || state.allocated_rate != allocated_rate) {
+    TargetTransferRate target_rate = *state.estimate;
+    target_rate.target_rate = allocated_rate;
+    target_rate.stable_target_rate = target_rate.stable_target_rate * ratio;
+    update.target_rate = target_rate;
+    state.allocated_rate = allocated_rate;
+    // The pacer has to follow the new target rate.
+    if (state.pacer_config)
+      update.pacer_config = state.pacer_config;
+  }
+  if (update.pacer_config && update.pacer_config->data_window.IsFinite())
+    update.pacer_config->data_window = update.pacer_config->data_window * ratio;
+  return update;
+}
+
+// Like the BitrateAllocator does for streams: members first get their minimum
+// rate, then equal shares of the rest, capped by their maximum rate. What is
+// left when all members are capped is split evenly.
+DataRate SharedBottleneckControllerFactory::Group::Allocate(
+    const Member* member) const {
+  struct Allocation {
+    const Member* member;
+    int64_t min_bps;
+    int64_t max_bps;
+    int64_t allocated_bps;
+  };
+  std::vector<Allocation> allocations;
+  int64_t total_bps = 0;
+  int64_t total_min_bps = 0;
+  for (const auto& it : members_) {
+    if (!it.second.estimate)
+      continue;
+    total_bps += it.second.estimate->target_rate.bps();
+    total_min_bps += it.second.min_bps;
+    allocations.push_back({it.first, it.second.min_bps,
+                           std::max(it.second.min_bps, it.second.max_bps), 0});
+  }
+  RTC_DCHECK(!allocations.empty());
+
+  if (total_min_bps >= total_bps) {
+    for (const Allocation& allocation : allocations) {
+      if (allocation.member != member)
+        continue;
+      if (total_min_bps == 0)
+        return DataRate::bps(total_bps / allocations.size());
+      return DataRate::bps(static_cast<int64_t>(
+          static_cast<double>(total_bps) * allocation.min_bps / total_min_bps));
+    }
+  }
+
+  // Fill up the members with the least headroom first, so that what they
+  // can't use goes to the others.
+  std::sort(allocations.begin(), allocations.end(),
+            [](const Allocation& a, const Allocation& b) {
+              return a.max_bps - a.min_bps < b.max_bps - b.min_bps;
+            });
+  int64_t remaining_bps = total_bps - total_min_bps;
+  for (size_t i = 0; i < allocations.size(); ++i) {
+    Allocation& allocation = allocations[i];
+    int64_t share_bps = remaining_bps / (allocations.size() - i);
+    int64_t added_bps =
+        std::min(share_bps, allocation.max_bps - allocation.min_bps);
+    allocation.allocated_bps = allocation.min_bps + added_bps;
+    remaining_bps -= added_bps;
+  }
+  for (const Allocation& allocation : allocations) {
+    if (allocation.member == member) {
+      return DataRate::bps(allocation.allocated_bps +
+                           remaining_bps / allocations.size());
+    }
+  }
+  RTC_NOTREACHED();
+  return DataRate::Zero();
+}
+
+SharedBottleneckControllerFactory::SharedBottleneckControllerFactory(
+    std::unique_ptr<NetworkControllerFactoryInterface> factory)
+    : factory_(std::move(factory)), group_(std::make_unique<Group>()) {
+  RTC_DCHECK(factory_);
+}
+
+SharedBottleneckControllerFactory::~SharedBottleneckControllerFactory() =
+    default;
+
+std::unique_ptr<NetworkControllerInterface>
+SharedBottleneckControllerFactory::Create(NetworkControllerConfig config) {
+  StreamsConfig streams_config = config.stream_based_config;
+  return group_->CreateMember(factory_->Create(std::move(config)),
+                              streams_config);
+}
+
+TimeDelta SharedBottleneckControllerFactory::GetProcessInterval() const {
+  return factory_->GetProcessInterval();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_CONGESTION_CONTROLLER_SHARED_BOTTLENECK_CONTROLLER_FACTORY_H_
+#define MODULES_CONGESTION_CONTROLLER_SHARED_BOTTLENECK_CONTROLLER_FACTORY_H_
+
+#include <memory>
+
+#include "api/transport/network_control.h"
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+
+// Creates network controllers for transports that share a bottleneck, e.g.
+// the transports of many PeerConnections to the same SFU, when they all use
+// the same PeerConnectionFactory. Each controller wraps a controller created
+// by |factory| that estimates the bandwidth of its own transport, as transport
+// feedback is per transport. The controllers of one factory form a group that
+// is coordinated in two ways:
+//
+// - Only one member of the group probes at a time. Probes that other members
+//   ask for while a probe is in flight are dropped: they would measure the
+//   same link, and running them at the same time causes self-induced queueing.
+// - The sum of the target rates of the members is reallocated between them
+//   according to the allocation limits of their streams, so that members with
+//   little to send leave their share to the others. The total sent by the
+//   group isn't changed by this.
+//
+// The group lives in the factory, which must outlive the controllers. The
+// controllers may be used on different threads.
+class SharedBottleneckControllerFactory
+    : public NetworkControllerFactoryInterface {
+ public:
+  explicit SharedBottleneckControllerFactory(
+      std::unique_ptr<NetworkControllerFactoryInterface> factory);
+  ~SharedBottleneckControllerFactory() override;
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override;
+  TimeDelta GetProcessInterval() const override;
+
+ private:
+  class Group;
+
+  const std::unique_ptr<NetworkControllerFactoryInterface> factory_;
+  const std::unique_ptr<Group> group_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_CONGESTION_CONTROLLER_SHARED_BOTTLENECK_CONTROLLER_FACTORY_H_
@@ -0,0 +1,230 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/congestion_controller/shared_bottleneck_controller_factory.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Returns the update that the test sets up, whatever the message.
+class FakeNetworkController : public NetworkControllerInterface {
+ public:
+  NetworkControlUpdate next_update;
+
+  NetworkControlUpdate OnNetworkAvailability(NetworkAvailability) override {
+    return Next();
+  }
+  NetworkControlUpdate OnNetworkRouteChange(NetworkRouteChange) override {
+    return Next();
+  }
+  NetworkControlUpdate OnProcessInterval(ProcessInterval) override {
+    return Next();
+  }
+  NetworkControlUpdate OnRemoteBitrateReport(RemoteBitrateReport) override {
+    return Next();
+  }
+  NetworkControlUpdate OnRoundTripTimeUpdate(RoundTripTimeUpdate) override {
+    return Next();
+  }
+  NetworkControlUpdate OnSentPacket(SentPacket) override { return Next(); }
+  NetworkControlUpdate OnReceivedPacket(ReceivedPacket) override {
+    return Next();
+  }
+  NetworkControlUpdate OnStreamsConfig(StreamsConfig) override {
+    return Next();
+  }
+  NetworkControlUpdate OnTargetRateConstraints(
+      TargetRateConstraints) override {
+    return Next();
+  }
+  NetworkControlUpdate OnTransportLossReport(TransportLossReport) override {
+    return Next();
+  }
+  NetworkControlUpdate OnTransportPacketsFeedback(
+      TransportPacketsFeedback) override {
+    return Next();
+  }
+  NetworkControlUpdate OnNetworkStateEstimate(NetworkStateEstimate) override {
+    return Next();
+  }
+
+ private:
+  NetworkControlUpdate Next() {
+    NetworkControlUpdate update = next_update;
+    next_update = NetworkControlUpdate();
+    return update;
+  }
+};
+
+class FakeNetworkControllerFactory : public NetworkControllerFactoryInterface {
+ public:
+  explicit FakeNetworkControllerFactory(
+      std::vector<FakeNetworkController*>* controllers)
+      : controllers_(controllers) {}
+
+  std::unique_ptr<NetworkControllerInterface> Create(
+      NetworkControllerConfig config) override {
+    auto controller = std::make_unique<FakeNetworkController>();
+    controllers_->push_back(controller.get());
+    return controller;
+  }
+  TimeDelta GetProcessInterval() const override { return TimeDelta::ms(25); }
+
+ private:
+  std::vector<FakeNetworkController*>* const controllers_;
+};
+
+NetworkControlUpdate TargetRateUpdate(DataRate rate) {
+  NetworkControlUpdate update;
+  update.target_rate.emplace();
+  update.target_rate->target_rate = rate;
+  update.target_rate->stable_target_rate = rate;
+  PacerConfig pacer_config;
+  pacer_config.time_window = TimeDelta::seconds(1);
+  pacer_config.data_window = rate * pacer_config.time_window;
+  update.pacer_config = pacer_config;
+  return update;
+}
+
+NetworkControlUpdate ProbeUpdate(Timestamp at_time) {
+  NetworkControlUpdate update;
+  ProbeClusterConfig probe;
+  probe.at_time = at_time;
+  probe.target_data_rate = DataRate::kbps(1000);
+  update.probe_cluster_configs.push_back(probe);
+  return update;
+}
+
+NetworkControllerConfig ConfigWithMaxRate(DataRate max_rate) {
+  NetworkControllerConfig config;
+  config.stream_based_config.max_total_allocated_bitrate = max_rate;
+  return config;
+}
+
+class SharedBottleneckControllerFactoryTest : public ::testing::Test {
+ protected:
+  SharedBottleneckControllerFactoryTest()
+      : factory_(
+            std::make_unique<FakeNetworkControllerFactory>(&fakes_)) {}
+
+  NetworkControlUpdate Process(size_t i, NetworkControlUpdate update) {
+    fakes_[i]->next_update = std::move(update);
+    return controllers_[i]->OnProcessInterval(ProcessInterval());
+  }
+
+  std::vector<FakeNetworkController*> fakes_;
+  SharedBottleneckControllerFactory factory_;
+  std::vector<std::unique_ptr<NetworkControllerInterface>> controllers_;
+};
+
+TEST_F(SharedBottleneckControllerFactoryTest, SingleMemberIsUnchanged) {
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  NetworkControlUpdate update =
+      Process(0, TargetRateUpdate(DataRate::kbps(500)));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(500), update.target_rate->target_rate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(DataRate::kbps(500), update.pacer_config->data_rate());
+
+  update = Process(0, ProbeUpdate(Timestamp::ms(1000)));
+  EXPECT_EQ(1u, update.probe_cluster_configs.size());
+  EXPECT_FALSE(update.target_rate);
+}
+
+TEST_F(SharedBottleneckControllerFactoryTest, OnlyOneMemberProbesAtATime) {
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+
+  EXPECT_EQ(1u,
+            Process(0, ProbeUpdate(Timestamp::ms(1000)))
+                .probe_cluster_configs.size());
+  EXPECT_TRUE(Process(1, ProbeUpdate(Timestamp::ms(1500)))
+                  .probe_cluster_configs.empty());
+  // The first member may keep probing.
+  EXPECT_EQ(1u,
+            Process(0, ProbeUpdate(Timestamp::ms(1600)))
+                .probe_cluster_configs.size());
+  EXPECT_TRUE(Process(1, ProbeUpdate(Timestamp::ms(2500)))
+                  .probe_cluster_configs.empty());
+  EXPECT_EQ(1u,
+            Process(1, ProbeUpdate(Timestamp::ms(2601)))
+                .probe_cluster_configs.size());
+}
+
+TEST_F(SharedBottleneckControllerFactoryTest, MemberThatLeavesStopsProbing) {
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+  Process(0, ProbeUpdate(Timestamp::ms(1000)));
+  controllers_[0].reset();
+  EXPECT_EQ(1u,
+            Process(1, ProbeUpdate(Timestamp::ms(1100)))
+                .probe_cluster_configs.size());
+}
+
+TEST_F(SharedBottleneckControllerFactoryTest, ReallocatesUnusedRate) {
+  controllers_.push_back(
+      factory_.Create(ConfigWithMaxRate(DataRate::kbps(100))));
+  controllers_.push_back(factory_.Create(NetworkControllerConfig()));
+
+  NetworkControlUpdate update =
+      Process(0, TargetRateUpdate(DataRate::kbps(500)));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(500), update.target_rate->target_rate);
+
+  // The second member gets what the first one can't use.
+  update = Process(1, TargetRateUpdate(DataRate::kbps(500)));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(900), update.target_rate->target_rate);
+  EXPECT_EQ(DataRate::kbps(900), update.target_rate->stable_target_rate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(DataRate::kbps(900), update.pacer_config->data_rate());
+
+  // The first member is updated on its next call, even without a new
+  // estimate of its own.
+  update = Process(0, NetworkControlUpdate());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(100), update.target_rate->target_rate);
+  ASSERT_TRUE(update.pacer_config);
+  EXPECT_EQ(DataRate::kbps(100), update.pacer_config->data_rate());
+  EXPECT_FALSE(Process(0, NetworkControlUpdate()).target_rate);
+
+  // Raising the limit of the first member splits the rate evenly again.
+  StreamsConfig streams_config;
+  streams_config.max_total_allocated_bitrate = DataRate::PlusInfinity();
+  update = controllers_[0]->OnStreamsConfig(streams_config);
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(500), update.target_rate->target_rate);
+}
+
+TEST_F(SharedBottleneckControllerFactoryTest, SplitsRateByMinimumWhenShort) {
+  NetworkControllerConfig config;
+  config.stream_based_config.min_total_allocated_bitrate = DataRate::kbps(300);
+  controllers_.push_back(factory_.Create(config));
+  config.stream_based_config.min_total_allocated_bitrate = DataRate::kbps(100);
+  controllers_.push_back(factory_.Create(config));
+
+  Process(0, TargetRateUpdate(DataRate::kbps(100)));
+  NetworkControlUpdate update =
+      Process(1, TargetRateUpdate(DataRate::kbps(100)));
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(50), update.target_rate->target_rate);
+  update = Process(0, NetworkControlUpdate());
+  ASSERT_TRUE(update.target_rate);
+  EXPECT_EQ(DataRate::kbps(150), update.target_rate->target_rate);
+}
+
+}  // namespace
+}  // namespace webrtc
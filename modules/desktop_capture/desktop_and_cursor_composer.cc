@@ -70,6 +70,15 @@ class DesktopFrameWithCursor : public DesktopFrame {
                          const DesktopVector& position);
   ~DesktopFrameWithCursor() override;
 
+  // Where the cursor is drawn, in frame coordinates. Empty if it's not.
+  DesktopRect cursor_rect() const {
+    if (!restore_frame_)
+      return DesktopRect();
+    DesktopRect rect = DesktopRect::MakeSize(restore_frame_->size());
+    rect.Translate(restore_position_);
+    return rect;
+  }
+
  private:
   const std::unique_ptr<DesktopFrame> original_frame_;
 
@@ -144,6 +153,11 @@ DesktopAndCursorComposer::DesktopAndCursorComposer(
 
 DesktopAndCursorComposer::~DesktopAndCursorComposer() = default;
 
+void DesktopAndCursorComposer::SetCursorMetadataCallback(
+    MouseCursorMonitor::Callback* callback) {
+  cursor_metadata_callback_ = callback;
+}
+
 void DesktopAndCursorComposer::Start(DesktopCapturer::Callback* callback) {
   callback_ = callback;
   if (mouse_monitor_)
@@ -169,7 +183,8 @@ void DesktopAndCursorComposer::SetExcludedWindow(WindowId window) {
 void DesktopAndCursorComposer::OnCaptureResult(
     DesktopCapturer::Result result,
     std::unique_ptr<DesktopFrame> frame) {
-  if (frame && cursor_) {
+  if (frame && cursor_ && !cursor_metadata_callback_) {
+    DesktopRect cursor_rect;
     if (frame->rect().Contains(cursor_position_) &&
         !desktop_capturer_->IsOccluded(cursor_position_)) {
       DesktopVector relative_position =
@@ -185,8 +200,20 @@ void DesktopAndCursorComposer::OnCaptureResult(
       relative_position.set(relative_position.x() * scale,
                             relative_position.y() * scale);
 #endif
-      frame = std::make_unique<DesktopFrameWithCursor>(
+      auto frame_with_cursor = std::make_unique<DesktopFrameWithCursor>(
           std::move(frame), *cursor_, relative_position);
+      cursor_rect = frame_with_cursor->cursor_rect();
+      frame = std::move(frame_with_cursor);
+    }
+    // Only the cursor's old and new areas change when it moves, so that
+    // cursor motion over a static screen stays cheap to encode.
+    if (cursor_changed_ || !cursor_rect.equals(previous_cursor_rect_)) {
+      DesktopRect previous_rect = previous_cursor_rect_;
+      previous_rect.IntersectWith(DesktopRect::MakeSize(frame->size()));
+      frame->mutable_updated_region()->AddRect(previous_rect);
+      frame->mutable_updated_region()->AddRect(cursor_rect);
+      previous_cursor_rect_ = cursor_rect;
+      cursor_changed_ = false;
     }
   }
 
@@ -195,6 +222,9 @@ void DesktopAndCursorComposer::OnCaptureResult(
 
 void DesktopAndCursorComposer::OnMouseCursor(MouseCursor* cursor) {
   cursor_.reset(cursor);
+  cursor_changed_ = true;
+  if (cursor_metadata_callback_)
+    cursor_metadata_callback_->OnMouseCursor(MouseCursor::CopyOf(*cursor));
 }
 
 void DesktopAndCursorComposer::OnMouseCursorPosition(
@@ -206,6 +236,8 @@ void DesktopAndCursorComposer::OnMouseCursorPosition(
 void DesktopAndCursorComposer::OnMouseCursorPosition(
     const DesktopVector& position) {
   cursor_position_ = position;
+  if (cursor_metadata_callback_)
+    cursor_metadata_callback_->OnMouseCursorPosition(position);
 }
 
 }  // namespace webrtc
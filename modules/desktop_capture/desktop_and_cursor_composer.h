@@ -41,6 +41,13 @@ class RTC_EXPORT DesktopAndCursorComposer
 
   ~DesktopAndCursorComposer() override;
 
+  // Passes the cursor to |callback| instead of composing it into the frames,
+  // for receivers that draw it themselves. The shape is passed with
+  // OnMouseCursor() whenever it changes, and the position, in screen
+  // coordinates, with OnMouseCursorPosition() before each frame. Must be
+  // called before Start(). |callback| must outlive the composer.
+  void SetCursorMetadataCallback(MouseCursorMonitor::Callback* callback);
+
   // DesktopCapturer interface.
   void Start(DesktopCapturer::Callback* callback) override;
   void SetSharedMemoryFactory(
@@ -71,9 +78,14 @@ class RTC_EXPORT DesktopAndCursorComposer
   const std::unique_ptr<MouseCursorMonitor> mouse_monitor_;
 
   DesktopCapturer::Callback* callback_;
+  MouseCursorMonitor::Callback* cursor_metadata_callback_ = nullptr;
 
   std::unique_ptr<MouseCursor> cursor_;
   DesktopVector cursor_position_;
+  // Whether |cursor_| has changed since it was last composed.
+  bool cursor_changed_ = false;
+  // Where the cursor was composed into the last frame.
+  DesktopRect previous_cursor_rect_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(DesktopAndCursorComposer);
 };
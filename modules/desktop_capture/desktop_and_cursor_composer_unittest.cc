@@ -144,6 +144,7 @@ class FakeMouseMonitor : public MouseCursorMonitor {
       }
 
       callback_->OnMouseCursor(new MouseCursor(image.release(), hotspot_));
+      changed_ = false;
     }
 
     callback_->OnMouseCursorPosition(position_);
@@ -324,4 +325,57 @@ TEST_F(DesktopAndCursorComposerTest, CursorIncluded) {
   }
 }
 
+TEST_F(DesktopAndCursorComposerTest, UpdatedRegionCoversCursorMoves) {
+  std::unique_ptr<SharedDesktopFrame> frame(
+      SharedDesktopFrame::Wrap(CreateTestFrame()));
+  const DesktopRect first_rect = DesktopRect::MakeXYWH(10, 20, 10, 10);
+  const DesktopRect second_rect = DesktopRect::MakeXYWH(50, 60, 10, 10);
+
+  fake_screen_->SetNextFrame(frame->Share());
+  fake_cursor_->SetState(MouseCursorMonitor::INSIDE, first_rect.top_left());
+  blender_.CaptureFrame();
+  EXPECT_TRUE(frame_->updated_region().Equals(DesktopRegion(first_rect)));
+
+  // Nothing changes while the cursor stays put.
+  fake_screen_->SetNextFrame(frame->Share());
+  blender_.CaptureFrame();
+  EXPECT_TRUE(frame_->updated_region().is_empty());
+
+  fake_screen_->SetNextFrame(frame->Share());
+  fake_cursor_->SetState(MouseCursorMonitor::INSIDE, second_rect.top_left());
+  blender_.CaptureFrame();
+  DesktopRegion expected(first_rect);
+  expected.AddRect(second_rect);
+  EXPECT_TRUE(frame_->updated_region().Equals(expected));
+}
+
+TEST_F(DesktopAndCursorComposerTest, CursorPassedAsMetadata) {
+  class CursorCallback : public MouseCursorMonitor::Callback {
+   public:
+    void OnMouseCursor(MouseCursor* cursor) override { cursor_.reset(cursor); }
+    void OnMouseCursorPosition(MouseCursorMonitor::CursorState state,
+                               const DesktopVector& position) override {}
+    void OnMouseCursorPosition(const DesktopVector& position) override {
+      position_ = position;
+    }
+
+    std::unique_ptr<MouseCursor> cursor_;
+    DesktopVector position_;
+  } cursor_callback;
+  blender_.SetCursorMetadataCallback(&cursor_callback);
+
+  std::unique_ptr<SharedDesktopFrame> frame(
+      SharedDesktopFrame::Wrap(CreateTestFrame()));
+  const DesktopVector pos(50, 50);
+  fake_screen_->SetNextFrame(frame->Share());
+  fake_cursor_->SetState(MouseCursorMonitor::INSIDE, pos);
+  blender_.CaptureFrame();
+
+  VerifyFrame(*frame_, MouseCursorMonitor::OUTSIDE, DesktopVector());
+  EXPECT_TRUE(frame_->updated_region().is_empty());
+  ASSERT_TRUE(cursor_callback.cursor_);
+  EXPECT_EQ(kCursorWidth, cursor_callback.cursor_->image()->size().width());
+  EXPECT_TRUE(cursor_callback.position_.equals(pos));
+}
+
 }  // namespace webrtc
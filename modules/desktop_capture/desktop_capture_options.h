@@ -17,6 +17,11 @@
 #include "modules/desktop_capture/linux/shared_x_display.h"
 #endif
 
+#if defined(WEBRTC_USE_PIPEWIRE)
+#include "api/video/video_frame.h"
+#include "api/video/video_sink_interface.h"
+#endif
+
 #if defined(WEBRTC_MAC) && !defined(WEBRTC_IOS)
 #include "modules/desktop_capture/mac/desktop_configuration_monitor.h"
 #include "modules/desktop_capture/mac/full_screen_chrome_window_detector.h"
@@ -133,6 +138,18 @@ class RTC_EXPORT DesktopCaptureOptions {
 #if defined(WEBRTC_USE_PIPEWIRE)
   bool allow_pipewire() const { return allow_pipewire_; }
   void set_allow_pipewire(bool allow) { allow_pipewire_ = allow; }
+
+  // If set, frames that the compositor shares as DMA-BUFs are passed to
+  // |sink|, as DmaBufVideoFrameBuffers, on the PipeWire thread instead of
+  // being copied to the frames returned by CaptureFrame(). This lets a
+  // hardware encoder import them without reading them back from the GPU.
+  // The sink must outlive the capturer.
+  rtc::VideoSinkInterface<VideoFrame>* pipewire_dmabuf_sink() const {
+    return pipewire_dmabuf_sink_;
+  }
+  void set_pipewire_dmabuf_sink(rtc::VideoSinkInterface<VideoFrame>* sink) {
+    pipewire_dmabuf_sink_ = sink;
+  }
 #endif
 
  private:
@@ -161,6 +178,7 @@ class RTC_EXPORT DesktopCaptureOptions {
   bool detect_updated_region_ = false;
 #if defined(WEBRTC_USE_PIPEWIRE)
   bool allow_pipewire_ = false;
+  rtc::VideoSinkInterface<VideoFrame>* pipewire_dmabuf_sink_ = nullptr;
 #endif
 };
 
@@ -0,0 +1,50 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_to_video_frame.h"
+
+#include "api/video/i420_buffer.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace webrtc {
+
+VideoFrame::UpdateRect UpdateRectFromDesktopRegion(const DesktopRegion& region,
+                                                   const DesktopSize& size) {
+  VideoFrame::UpdateRect update_rect = {0, 0, 0, 0};
+  for (DesktopRegion::Iterator it(region); !it.IsAtEnd(); it.Advance()) {
+    DesktopRect rect = it.rect();
+    rect.IntersectWith(DesktopRect::MakeSize(size));
+    if (!rect.is_empty()) {
+      update_rect.Union(
+          {rect.left(), rect.top(), rect.width(), rect.height()});
+    }
+  }
+  return update_rect;
+}
+
+VideoFrame ConvertToVideoFrame(const DesktopFrame& frame,
+                               int64_t timestamp_us) {
+  const int width = frame.size().width();
+  const int height = frame.size().height();
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  // DesktopFrame is BGRA in memory, which libyuv calls ARGB.
+  libyuv::ARGBToI420(frame.data(), frame.stride(), buffer->MutableDataY(),
+                     buffer->StrideY(), buffer->MutableDataU(),
+                     buffer->StrideU(), buffer->MutableDataV(),
+                     buffer->StrideV(), width, height);
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(buffer)
+      .set_timestamp_us(timestamp_us)
+      .set_update_rect(
+          UpdateRectFromDesktopRegion(frame.updated_region(), frame.size()))
+      .build();
+}
+
+}  // namespace webrtc
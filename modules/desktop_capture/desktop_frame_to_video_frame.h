@@ -0,0 +1,39 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_TO_VIDEO_FRAME_H_
+#define MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_TO_VIDEO_FRAME_H_
+
+#include <stdint.h>
+
+#include "api/video/video_frame.h"
+#include "modules/desktop_capture/desktop_frame.h"
+#include "modules/desktop_capture/desktop_region.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Returns the bounding box of |region|, clipped to |size|, as the update rect
+// of a VideoFrame. An empty region gives an empty update rect, i.e. a frame
+// that's identical to the previous one.
+RTC_EXPORT VideoFrame::UpdateRect UpdateRectFromDesktopRegion(
+    const DesktopRegion& region,
+    const DesktopSize& size);
+
+// Converts |frame| to an I420 VideoFrame for encoding. Its updated_region()
+// becomes the update rect of the VideoFrame, which VideoStreamEncoder
+// accumulates over dropped frames and encoders use to find static content,
+// e.g. to encode unchanged screens at a low frame rate.
+RTC_EXPORT VideoFrame ConvertToVideoFrame(const DesktopFrame& frame,
+                                          int64_t timestamp_us);
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_DESKTOP_FRAME_TO_VIDEO_FRAME_H_
@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/desktop_frame_to_video_frame.h"
+
+#include <string.h>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+void ExpectUpdateRect(const VideoFrame::UpdateRect& update_rect,
+                      int offset_x,
+                      int offset_y,
+                      int width,
+                      int height) {
+  EXPECT_EQ(offset_x, update_rect.offset_x);
+  EXPECT_EQ(offset_y, update_rect.offset_y);
+  EXPECT_EQ(width, update_rect.width);
+  EXPECT_EQ(height, update_rect.height);
+}
+
+}  // namespace
+
+TEST(DesktopFrameToVideoFrameTest, EmptyRegionIsEmptyUpdate) {
+  EXPECT_TRUE(UpdateRectFromDesktopRegion(DesktopRegion(), DesktopSize(64, 32))
+                  .IsEmpty());
+}
+
+TEST(DesktopFrameToVideoFrameTest, UpdateRectIsBoundingBoxOfRegion) {
+  DesktopRegion region(DesktopRect::MakeXYWH(4, 8, 2, 2));
+  region.AddRect(DesktopRect::MakeXYWH(20, 2, 4, 4));
+  ExpectUpdateRect(UpdateRectFromDesktopRegion(region, DesktopSize(64, 32)), 4,
+                   2, 20, 8);
+}
+
+TEST(DesktopFrameToVideoFrameTest, UpdateRectIsClippedToFrame) {
+  DesktopRegion region(DesktopRect::MakeXYWH(60, 30, 10, 10));
+  region.AddRect(DesktopRect::MakeXYWH(100, 100, 4, 4));
+  ExpectUpdateRect(UpdateRectFromDesktopRegion(region, DesktopSize(64, 32)),
+                   60, 30, 4, 2);
+}
+
+TEST(DesktopFrameToVideoFrameTest, ConvertsPixelsAndUpdatedRegion) {
+  BasicDesktopFrame frame(DesktopSize(16, 8));
+  // Gray, so that the converted frame is flat.
+  memset(frame.data(), 128, frame.stride() * frame.size().height());
+  frame.mutable_updated_region()->SetRect(DesktopRect::MakeXYWH(2, 4, 6, 2));
+
+  const VideoFrame video_frame = ConvertToVideoFrame(frame, 1234);
+
+  EXPECT_EQ(16, video_frame.width());
+  EXPECT_EQ(8, video_frame.height());
+  EXPECT_EQ(1234, video_frame.timestamp_us());
+  ExpectUpdateRect(video_frame.update_rect(), 2, 4, 6, 2);
+  rtc::scoped_refptr<I420BufferInterface> i420 =
+      video_frame.video_frame_buffer()->ToI420();
+  EXPECT_NEAR(126, i420->DataY()[0], 2);
+  EXPECT_NEAR(128, i420->DataU()[0], 2);
+  EXPECT_NEAR(128, i420->DataV()[0], 2);
+}
+
+}  // namespace webrtc
@@ -12,8 +12,21 @@
 
 #include <string.h>
 
+#include <vector>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/system/arch.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include "modules/desktop_capture/differ_vector_neon.h"
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/desktop_capture/differ_vector_avx2.h"
+#include "modules/desktop_capture/differ_vector_sse2.h"
+#endif
+
 namespace webrtc {
 
 // Run 900 times to mimic 1280x720.
@@ -86,4 +99,119 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+namespace {
+
+using VectorDifferenceFunction = bool (*)(const uint8_t*, const uint8_t*);
+
+struct Implementation {
+  const char* name;
+  VectorDifferenceFunction function;
+};
+
+bool VectorDifference_Memcmp(const uint8_t* image1, const uint8_t* image2) {
+  return memcmp(image1, image2, kBlockSize * kBytesPerPixel) != 0;
+}
+
+// The implementations of VectorDifference() that the CPU supports, for
+// kBlockSize.
+std::vector<Implementation> SupportedImplementations() {
+  std::vector<Implementation> implementations;
+  implementations.push_back({"memcmp", &VectorDifference_Memcmp});
+#if defined(WEBRTC_HAS_NEON)
+  implementations.push_back({"NEON", kBlockSize == 32
+                                         ? &VectorDifference_NEON_W32
+                                         : &VectorDifference_NEON_W16});
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    implementations.push_back({"SSE2", kBlockSize == 32
+                                           ? &VectorDifference_SSE2_W32
+                                           : &VectorDifference_SSE2_W16});
+  }
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    implementations.push_back({"AVX2", kBlockSize == 32
+                                           ? &VectorDifference_AVX2_W32
+                                           : &VectorDifference_AVX2_W16});
+  }
+#endif
+  return implementations;
+}
+
+// Compares all full blocks of two frames of |width| x |height| pixels the way
+// DesktopCapturerDifferWrapper does, and returns the number of blocks that
+// differ.
+int CountDifferentBlocks(VectorDifferenceFunction function,
+                         const uint8_t* frame1,
+                         const uint8_t* frame2,
+                         int width,
+                         int height) {
+  const int stride = width * kBytesPerPixel;
+  int different_blocks = 0;
+  for (int y = 0; y + kBlockSize <= height; y += kBlockSize) {
+    for (int x = 0; x + kBlockSize <= width; x += kBlockSize) {
+      const int offset = y * stride + x * kBytesPerPixel;
+      for (int row = 0; row < kBlockSize; ++row) {
+        if (function(frame1 + offset + row * stride,
+                     frame2 + offset + row * stride)) {
+          ++different_blocks;
+          break;
+        }
+      }
+    }
+  }
+  return different_blocks;
+}
+
+}  // namespace
+
+TEST(VectorDifferenceTest, AllImplementationsFindEveryDifferentByte) {
+  constexpr int kVectorBytes = kBlockSize * kBytesPerPixel;
+  uint8_t image1[kVectorBytes];
+  uint8_t image2[kVectorBytes];
+  GenerateData(image1, kVectorBytes);
+  for (const Implementation& implementation : SupportedImplementations()) {
+    SCOPED_TRACE(implementation.name);
+    memcpy(image2, image1, kVectorBytes);
+    EXPECT_FALSE(implementation.function(image1, image2));
+    for (int i = 0; i < kVectorBytes; ++i) {
+      // Also differences that don't change the sum of the bytes.
+      image2[i] ^= 0x80;
+      EXPECT_TRUE(implementation.function(image1, image2)) << i;
+      image2[i] ^= 0x80;
+    }
+  }
+}
+
+TEST(BlockDifferenceTest, DISABLED_BlockDifferencePerf) {
+  struct Resolution {
+    const char* name;
+    int width;
+    int height;
+  };
+  const Resolution kResolutions[] = {{"1080p", 1920, 1080},
+                                     {"2160p", 3840, 2160}};
+  constexpr int kNumFrames = 100;
+  for (const Resolution& resolution : kResolutions) {
+    const int size = resolution.width * resolution.height * kBytesPerPixel;
+    // Identical frames, the common case for screenshare, where every row of
+    // every block has to be compared.
+    std::vector<uint8_t> frame1(size);
+    GenerateData(frame1.data(), size);
+    const std::vector<uint8_t> frame2 = frame1;
+    for (const Implementation& implementation : SupportedImplementations()) {
+      const int64_t start_us = rtc::TimeMicros();
+      int different_blocks = 0;
+      for (int i = 0; i < kNumFrames; ++i) {
+        different_blocks +=
+            CountDifferentBlocks(implementation.function, frame1.data(),
+                                 frame2.data(), resolution.width,
+                                 resolution.height);
+      }
+      const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+      EXPECT_EQ(0, different_blocks);
+      RTC_LOG(LS_INFO) << resolution.name << " " << implementation.name
+                       << ": " << elapsed_us / kNumFrames << " us per frame";
+    }
+  }
+}
+
 }  // namespace webrtc
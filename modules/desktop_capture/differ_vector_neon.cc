@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/differ_vector_neon.h"
+
+#include <arm_neon.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns whether the XOR of |bytes| vectors of |image1| and |image2| has any
+// bit set. |bytes| is a multiple of 32.
+bool VectorDifference_NEON(const uint8_t* image1,
+                           const uint8_t* image2,
+                           int bytes) {
+  uint8x16_t acc0 = veorq_u8(vld1q_u8(image1), vld1q_u8(image2));
+  uint8x16_t acc1 = veorq_u8(vld1q_u8(image1 + 16), vld1q_u8(image2 + 16));
+  for (int i = 32; i < bytes; i += 32) {
+    acc0 = vorrq_u8(acc0, veorq_u8(vld1q_u8(image1 + i), vld1q_u8(image2 + i)));
+    acc1 = vorrq_u8(
+        acc1, veorq_u8(vld1q_u8(image1 + i + 16), vld1q_u8(image2 + i + 16)));
+  }
+  const uint64x2_t acc = vreinterpretq_u64_u8(vorrq_u8(acc0, acc1));
+  return (vgetq_lane_u64(acc, 0) | vgetq_lane_u64(acc, 1)) != 0;
+}
+
+}  // namespace
+
+extern bool VectorDifference_NEON_W16(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  return VectorDifference_NEON(image1, image2, 16 * 4);
+}
+
+extern bool VectorDifference_NEON_W32(const uint8_t* image1,
+                                      const uint8_t* image2) {
+  return VectorDifference_NEON(image1, image2, 32 * 4);
+}
+
+}  // namespace webrtc
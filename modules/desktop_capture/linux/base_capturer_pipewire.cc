@@ -16,15 +16,22 @@
 #include <spa/param/props.h>
 #include <spa/param/video/raw-utils.h>
 #include <spa/support/type-map.h>
+#include <unistd.h>
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "modules/desktop_capture/desktop_capture_options.h"
 #include "modules/desktop_capture/desktop_capturer.h"
+#include "modules/desktop_capture/linux/dmabuf_video_frame_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
 
 #if defined(WEBRTC_DLOPEN_PIPEWIRE)
 #include "modules/desktop_capture/linux/pipewire_stubs.h"
@@ -50,6 +57,45 @@ const int kBytesPerPixel = 4;
 const char kPipeWireLib[] = "libpipewire-0.2.so.1";
 #endif
 
+// Collects the buffers of released DMA-BUF frames, which can happen on any
+// thread, for the PipeWire thread to queue back to the stream. Queueing them
+// right away would need the loop lock, which the PipeWire thread may hold
+// while releasing a frame itself, so only the loop's event is signalled.
+// Outlives the capturer if frames do.
+class BaseCapturerPipeWire::BufferReleaser : public rtc::RefCountInterface {
+ public:
+  BufferReleaser(pw_loop* loop, spa_source* event)
+      : loop_(loop), event_(event) {}
+
+  void Release(pw_buffer* buffer) {
+    rtc::CritScope lock(&lock_);
+    if (!loop_)
+      return;
+    released_.push_back(buffer);
+    pw_loop_signal_event(loop_, event_);
+  }
+
+  std::vector<pw_buffer*> TakeReleased() {
+    rtc::CritScope lock(&lock_);
+    return std::move(released_);
+  }
+
+  // Called when the capturer is destroyed, after which buffers of frames
+  // still alive are no longer queued back.
+  void Detach() {
+    rtc::CritScope lock(&lock_);
+    loop_ = nullptr;
+    event_ = nullptr;
+    released_.clear();
+  }
+
+ private:
+  rtc::CriticalSection lock_;
+  pw_loop* loop_ RTC_GUARDED_BY(lock_);
+  spa_source* event_ RTC_GUARDED_BY(lock_);
+  std::vector<pw_buffer*> released_ RTC_GUARDED_BY(lock_);
+};
+
 // static
 void BaseCapturerPipeWire::OnStateChanged(void* data,
                                           pw_remote_state old_state,
@@ -170,19 +216,40 @@ void BaseCapturerPipeWire::OnStreamProcess(void* data) {
     return;
   }
 
-  that->HandleBuffer(buf);
+  if (!that->HandleBuffer(buf)) {
+    pw_stream_queue_buffer(that->pw_stream_, buf);
+  }
+}
+
+// static
+void BaseCapturerPipeWire::OnBuffersReleased(void* data, uint64_t count) {
+  BaseCapturerPipeWire* that = static_cast<BaseCapturerPipeWire*>(data);
+  RTC_DCHECK(that);
 
-  pw_stream_queue_buffer(that->pw_stream_, buf);
+  for (pw_buffer* buffer : that->buffer_releaser_->TakeReleased()) {
+    pw_stream_queue_buffer(that->pw_stream_, buffer);
+  }
 }
 
-BaseCapturerPipeWire::BaseCapturerPipeWire(CaptureSourceType source_type)
-    : capture_source_type_(source_type) {}
+BaseCapturerPipeWire::BaseCapturerPipeWire(CaptureSourceType source_type,
+                                           const DesktopCaptureOptions& options)
+    : capture_source_type_(source_type),
+      options_(options),
+      dmabuf_sink_(options.pipewire_dmabuf_sink()) {}
 
 BaseCapturerPipeWire::~BaseCapturerPipeWire() {
+  if (buffer_releaser_) {
+    buffer_releaser_->Detach();
+  }
+
   if (pw_main_loop_) {
     pw_thread_loop_stop(pw_main_loop_);
   }
 
+  if (buffers_released_event_) {
+    pw_loop_destroy_source(pw_loop_, buffers_released_event_);
+  }
+
   if (pw_type_) {
     delete pw_type_;
   }
@@ -283,6 +350,12 @@ void BaseCapturerPipeWire::InitPipeWire() {
   pw_init(/*argc=*/nullptr, /*argc=*/nullptr);
 
   pw_loop_ = pw_loop_new(/*properties=*/nullptr);
+  if (dmabuf_sink_) {
+    buffers_released_event_ =
+        pw_loop_add_event(pw_loop_, &OnBuffersReleased, this);
+    buffer_releaser_ = new rtc::RefCountedObject<BufferReleaser>(
+        pw_loop_, buffers_released_event_);
+  }
   pw_main_loop_ = pw_thread_loop_new(pw_loop_, "pipewire-main-loop");
 
   pw_core_ = pw_core_new(pw_loop_, /*properties=*/nullptr);
@@ -377,12 +450,16 @@ void BaseCapturerPipeWire::CreateReceivingStream() {
   }
 }
 
-void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
+bool BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
   spa_buffer* spaBuffer = buffer->buffer;
   void* src = nullptr;
 
+  if (dmabuf_sink_ && spaBuffer->datas[0].type == pw_core_type_->data.DmaBuf) {
+    return HandleDmaBuf(buffer);
+  }
+
   if (!(src = spaBuffer->datas[0].data)) {
-    return;
+    return false;
   }
 
   uint32_t maxSize = spaBuffer->datas[0].maxsize;
@@ -392,7 +469,7 @@ void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
                       << srcStride
                       << " != " << (desktop_size_.width() * kBytesPerPixel);
     portal_init_failed_ = true;
-    return;
+    return false;
   }
 
   if (!current_frame_) {
@@ -411,6 +488,36 @@ void BaseCapturerPipeWire::HandleBuffer(pw_buffer* buffer) {
   } else {
     std::memcpy(current_frame_, src, maxSize);
   }
+  return false;
+}
+
+bool BaseCapturerPipeWire::HandleDmaBuf(pw_buffer* buffer) {
+  const spa_data& data = buffer->buffer->datas[0];
+  // The frame gets its own descriptor, which keeps the DMA-BUF alive also if
+  // the stream is destroyed before the frame.
+  const int fd = dup(data.fd);
+  if (fd < 0) {
+    RTC_LOG_ERRNO(LS_ERROR) << "Failed to duplicate DMA-BUF descriptor.";
+    return false;
+  }
+
+  const DmaBufVideoFrameBuffer::PixelFormat pixel_format =
+      spa_video_format_->format == pw_type_->video_format.RGBx
+          ? DmaBufVideoFrameBuffer::PixelFormat::kRGBx
+          : DmaBufVideoFrameBuffer::PixelFormat::kBGRx;
+  // The compositor mustn't write to the buffer while the frame is alive, so
+  // it's only queued back once the frame is released.
+  rtc::scoped_refptr<BufferReleaser> releaser = buffer_releaser_;
+  rtc::scoped_refptr<DmaBufVideoFrameBuffer> frame_buffer =
+      DmaBufVideoFrameBuffer::Create(
+          fd, spa_video_format_->size.width, spa_video_format_->size.height,
+          data.chunk->stride, data.chunk->offset, pixel_format,
+          [releaser, buffer] { releaser->Release(buffer); });
+  dmabuf_sink_->OnFrame(VideoFrame::Builder()
+                            .set_video_frame_buffer(frame_buffer)
+                            .set_timestamp_us(rtc::TimeMicros())
+                            .build());
+  return true;
 }
 
 void BaseCapturerPipeWire::ConvertRGBxToBGRx(uint8_t* frame, uint32_t size) {
@@ -865,6 +972,9 @@ void BaseCapturerPipeWire::CaptureFrame() {
     callback_->OnCaptureResult(Result::ERROR_TEMPORARY, nullptr);
     return;
   }
+  // The whole frame may have changed, as PipeWire doesn't report damage.
+  result->mutable_updated_region()->SetRect(
+      DesktopRect::MakeSize(desktop_size_));
 
   // TODO(julien.isorce): http://crbug.com/945468. Set the icc profile on the
   // frame, see ScreenCapturerX11::CaptureFrame.
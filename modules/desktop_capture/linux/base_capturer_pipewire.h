@@ -16,6 +16,9 @@
 #include <pipewire/pipewire.h>
 #include <spa/param/video/format-utils.h>
 
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame.h"
+#include "api/video/video_sink_interface.h"
 #include "modules/desktop_capture/desktop_capture_options.h"
 #include "modules/desktop_capture/desktop_capturer.h"
 #include "rtc_base/constructor_magic.h"
@@ -34,7 +37,8 @@ class BaseCapturerPipeWire : public DesktopCapturer {
  public:
   enum CaptureSourceType { Screen = 1, Window };
 
-  explicit BaseCapturerPipeWire(CaptureSourceType source_type);
+  BaseCapturerPipeWire(CaptureSourceType source_type,
+                       const DesktopCaptureOptions& options);
   ~BaseCapturerPipeWire() override;
 
   // DesktopCapturer interface.
@@ -44,6 +48,8 @@ class BaseCapturerPipeWire : public DesktopCapturer {
   bool SelectSource(SourceId id) override;
 
  private:
+  class BufferReleaser;
+
   // PipeWire types -->
   pw_core* pw_core_ = nullptr;
   pw_type* pw_core_type_ = nullptr;
@@ -61,6 +67,10 @@ class BaseCapturerPipeWire : public DesktopCapturer {
 
   spa_video_info_raw* spa_video_format_ = nullptr;
 
+  // Signalled when DMA-BUF frames passed to |dmabuf_sink_| are released, so
+  // that their buffers are queued back on the PipeWire thread.
+  spa_source* buffers_released_event_ = nullptr;
+
   gint32 pw_fd_ = -1;
 
   CaptureSourceType capture_source_type_ =
@@ -85,6 +95,9 @@ class BaseCapturerPipeWire : public DesktopCapturer {
   uint8_t* current_frame_ = nullptr;
   Callback* callback_ = nullptr;
 
+  rtc::VideoSinkInterface<VideoFrame>* const dmabuf_sink_;
+  rtc::scoped_refptr<BufferReleaser> buffer_releaser_;
+
   bool portal_init_failed_ = false;
 
   void InitPortal();
@@ -92,7 +105,10 @@ class BaseCapturerPipeWire : public DesktopCapturer {
   void InitPipeWireTypes();
 
   void CreateReceivingStream();
-  void HandleBuffer(pw_buffer* buffer);
+  // Returns true if |buffer| is held by a frame passed to |dmabuf_sink_|, in
+  // which case it's queued back once the frame is released.
+  bool HandleBuffer(pw_buffer* buffer);
+  bool HandleDmaBuf(pw_buffer* buffer);
 
   void ConvertRGBxToBGRx(uint8_t* frame, uint32_t size);
 
@@ -107,6 +123,7 @@ class BaseCapturerPipeWire : public DesktopCapturer {
 
   static void OnStreamFormatChanged(void* data, const struct spa_pod* format);
   static void OnStreamProcess(void* data);
+  static void OnBuffersReleased(void* data, uint64_t count);
   static void OnNewBuffer(void* data, uint32_t id);
 
   guint SetupRequestResponseSignal(const gchar* object_path,
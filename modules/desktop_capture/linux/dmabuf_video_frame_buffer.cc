@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/linux/dmabuf_video_frame_buffer.h"
+
+#include <errno.h>
+#include <linux/dma-buf.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/ref_counted_object.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace webrtc {
+
+namespace {
+
+// Brackets CPU access to a DMA-BUF, so that caches are flushed or
+// invalidated as needed. Exporters that don't need this fail the ioctl, which
+// is harmless.
+void SyncDmaBuf(int fd, uint64_t flags) {
+  dma_buf_sync sync = {};
+  sync.flags = flags | DMA_BUF_SYNC_READ;
+  while (ioctl(fd, DMA_BUF_IOCTL_SYNC, &sync) == -1 &&
+         (errno == EINTR || errno == EAGAIN)) {
+  }
+}
+
+}  // namespace
+
+// static
+rtc::scoped_refptr<DmaBufVideoFrameBuffer> DmaBufVideoFrameBuffer::Create(
+    int fd,
+    int width,
+    int height,
+    int stride,
+    uint32_t offset,
+    PixelFormat pixel_format,
+    std::function<void()> release_callback) {
+  return new rtc::RefCountedObject<DmaBufVideoFrameBuffer>(
+      fd, width, height, stride, offset, pixel_format,
+      std::move(release_callback));
+}
+
+DmaBufVideoFrameBuffer::DmaBufVideoFrameBuffer(
+    int fd,
+    int width,
+    int height,
+    int stride,
+    uint32_t offset,
+    PixelFormat pixel_format,
+    std::function<void()> release_callback)
+    : fd_(fd),
+      width_(width),
+      height_(height),
+      stride_(stride),
+      offset_(offset),
+      pixel_format_(pixel_format),
+      release_callback_(std::move(release_callback)) {
+  RTC_DCHECK_GE(fd_, 0);
+  RTC_DCHECK_GT(width_, 0);
+  RTC_DCHECK_GT(height_, 0);
+  RTC_DCHECK_GE(stride_, width_ * 4);
+}
+
+DmaBufVideoFrameBuffer::~DmaBufVideoFrameBuffer() {
+  close(fd_);
+  if (release_callback_)
+    release_callback_();
+}
+
+VideoFrameBuffer::Type DmaBufVideoFrameBuffer::type() const {
+  return Type::kNative;
+}
+
+int DmaBufVideoFrameBuffer::width() const {
+  return width_;
+}
+
+int DmaBufVideoFrameBuffer::height() const {
+  return height_;
+}
+
+rtc::scoped_refptr<I420BufferInterface> DmaBufVideoFrameBuffer::ToI420() {
+  // The mapping has to start at a page boundary.
+  const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const size_t map_offset = offset_ - offset_ % page_size;
+  const size_t map_size =
+      offset_ - map_offset + static_cast<size_t>(stride_) * height_;
+  void* map = mmap(nullptr, map_size, PROT_READ, MAP_SHARED, fd_,
+                   static_cast<off_t>(map_offset));
+  if (map == MAP_FAILED) {
+    RTC_LOG_ERRNO(LS_ERROR) << "Failed to map DMA-BUF.";
+    return nullptr;
+  }
+  const uint8_t* src = static_cast<const uint8_t*>(map) + offset_ - map_offset;
+
+  rtc::scoped_refptr<I420Buffer> i420 = I420Buffer::Create(width_, height_);
+  SyncDmaBuf(fd_, DMA_BUF_SYNC_START);
+  // libyuv names formats by the order of the bytes in a little endian word,
+  // so BGRx in memory is ARGB, and RGBx is ABGR.
+  const auto convert = pixel_format_ == PixelFormat::kBGRx
+                           ? &libyuv::ARGBToI420
+                           : &libyuv::ABGRToI420;
+  convert(src, stride_, i420->MutableDataY(), i420->StrideY(),
+          i420->MutableDataU(), i420->StrideU(), i420->MutableDataV(),
+          i420->StrideV(), width_, height_);
+  SyncDmaBuf(fd_, DMA_BUF_SYNC_END);
+  munmap(map, map_size);
+  return i420;
+}
+
+}  // namespace webrtc
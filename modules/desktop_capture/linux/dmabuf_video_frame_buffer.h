@@ -0,0 +1,82 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_DESKTOP_CAPTURE_LINUX_DMABUF_VIDEO_FRAME_BUFFER_H_
+#define MODULES_DESKTOP_CAPTURE_LINUX_DMABUF_VIDEO_FRAME_BUFFER_H_
+
+#include <stdint.h>
+
+#include <functional>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// A native frame buffer referencing a single plane, 32 bits per pixel DMA-BUF,
+// as shared by the compositor through PipeWire. Hardware encoders that can
+// import DMA-BUFs (e.g. through VA-API) use fd(), offset() and stride() to
+// encode the frame without it ever being read back to system memory. For
+// everything else ToI420() maps the DMA-BUF, on demand, and converts it.
+class DmaBufVideoFrameBuffer : public VideoFrameBuffer {
+ public:
+  // Byte order of the pixels in memory.
+  enum class PixelFormat {
+    kBGRx,
+    kRGBx,
+  };
+
+  // Takes ownership of |fd|. |release_callback| is called when the buffer is
+  // destroyed, at which point the producer may write to the DMA-BUF again.
+  static rtc::scoped_refptr<DmaBufVideoFrameBuffer> Create(
+      int fd,
+      int width,
+      int height,
+      int stride,
+      uint32_t offset,
+      PixelFormat pixel_format,
+      std::function<void()> release_callback);
+
+  Type type() const override;
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  int fd() const { return fd_; }
+  int stride() const { return stride_; }
+  uint32_t offset() const { return offset_; }
+  PixelFormat pixel_format() const { return pixel_format_; }
+
+ protected:
+  DmaBufVideoFrameBuffer(int fd,
+                         int width,
+                         int height,
+                         int stride,
+                         uint32_t offset,
+                         PixelFormat pixel_format,
+                         std::function<void()> release_callback);
+  ~DmaBufVideoFrameBuffer() override;
+
+ private:
+  const int fd_;
+  const int width_;
+  const int height_;
+  const int stride_;
+  const uint32_t offset_;
+  const PixelFormat pixel_format_;
+  const std::function<void()> release_callback_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DmaBufVideoFrameBuffer);
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_DESKTOP_CAPTURE_LINUX_DMABUF_VIDEO_FRAME_BUFFER_H_
@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/desktop_capture/linux/dmabuf_video_frame_buffer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 16;
+constexpr int kHeight = 8;
+// Padded, as GPU buffers often are.
+constexpr int kStride = kWidth * 4 + 64;
+// Not a multiple of the page size.
+constexpr uint32_t kOffset = 100;
+
+// Regular files can be mapped like a DMA-BUF, so they stand in for one. Each
+// pixel is set to |pixel|, in memory order.
+int CreateFakeDmaBuf(const uint8_t pixel[4]) {
+  const std::string file_name =
+      test::TempFilename(test::OutputPath(), "dmabuf");
+  const int fd = open(file_name.c_str(), O_RDWR);
+  RTC_CHECK_GE(fd, 0);
+  unlink(file_name.c_str());
+  std::vector<uint8_t> contents(kOffset + kStride * kHeight, 0);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x) {
+      for (int i = 0; i < 4; ++i)
+        contents[kOffset + y * kStride + x * 4 + i] = pixel[i];
+    }
+  }
+  RTC_CHECK_EQ(write(fd, contents.data(), contents.size()),
+               static_cast<ssize_t>(contents.size()));
+  return fd;
+}
+
+rtc::scoped_refptr<I420BufferInterface> ToI420(
+    const uint8_t pixel[4],
+    DmaBufVideoFrameBuffer::PixelFormat pixel_format) {
+  rtc::scoped_refptr<DmaBufVideoFrameBuffer> buffer =
+      DmaBufVideoFrameBuffer::Create(CreateFakeDmaBuf(pixel), kWidth, kHeight,
+                                     kStride, kOffset, pixel_format,
+                                     /*release_callback=*/nullptr);
+  EXPECT_EQ(VideoFrameBuffer::Type::kNative, buffer->type());
+  return buffer->ToI420();
+}
+
+TEST(DmaBufVideoFrameBufferTest, ConvertsGrayToI420) {
+  const uint8_t kGray[] = {128, 128, 128, 0};
+  rtc::scoped_refptr<I420BufferInterface> i420 =
+      ToI420(kGray, DmaBufVideoFrameBuffer::PixelFormat::kBGRx);
+  ASSERT_TRUE(i420);
+  EXPECT_EQ(kWidth, i420->width());
+  EXPECT_EQ(kHeight, i420->height());
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kWidth; ++x)
+      EXPECT_NEAR(126, i420->DataY()[y * i420->StrideY() + x], 2);
+  }
+  for (int y = 0; y < i420->ChromaHeight(); ++y) {
+    for (int x = 0; x < i420->ChromaWidth(); ++x) {
+      EXPECT_NEAR(128, i420->DataU()[y * i420->StrideU() + x], 2);
+      EXPECT_NEAR(128, i420->DataV()[y * i420->StrideV() + x], 2);
+    }
+  }
+}
+
+TEST(DmaBufVideoFrameBufferTest, HonorsPixelFormat) {
+  // Blue when read as BGRx, red when read as RGBx.
+  const uint8_t kPixel[] = {255, 0, 0, 0};
+  rtc::scoped_refptr<I420BufferInterface> blue =
+      ToI420(kPixel, DmaBufVideoFrameBuffer::PixelFormat::kBGRx);
+  rtc::scoped_refptr<I420BufferInterface> red =
+      ToI420(kPixel, DmaBufVideoFrameBuffer::PixelFormat::kRGBx);
+  ASSERT_TRUE(blue);
+  ASSERT_TRUE(red);
+  EXPECT_GT(blue->DataU()[0], 128);
+  EXPECT_LT(red->DataU()[0], 128);
+  EXPECT_LT(blue->DataV()[0], 128);
+  EXPECT_GT(red->DataV()[0], 128);
+}
+
+TEST(DmaBufVideoFrameBufferTest, ReleasesWhenDestroyed) {
+  const uint8_t kBlack[] = {0, 0, 0, 0};
+  int releases = 0;
+  rtc::scoped_refptr<DmaBufVideoFrameBuffer> buffer =
+      DmaBufVideoFrameBuffer::Create(
+          CreateFakeDmaBuf(kBlack), kWidth, kHeight, kStride, kOffset,
+          DmaBufVideoFrameBuffer::PixelFormat::kBGRx, [&] { ++releases; });
+  // Converting doesn't release the DMA-BUF.
+  EXPECT_TRUE(buffer->ToI420());
+  EXPECT_EQ(0, releases);
+  buffer = nullptr;
+  EXPECT_EQ(1, releases);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -15,15 +15,17 @@
 
 namespace webrtc {
 
-ScreenCapturerPipeWire::ScreenCapturerPipeWire()
-    : BaseCapturerPipeWire(BaseCapturerPipeWire::CaptureSourceType::Screen) {}
+ScreenCapturerPipeWire::ScreenCapturerPipeWire(
+    const DesktopCaptureOptions& options)
+    : BaseCapturerPipeWire(BaseCapturerPipeWire::CaptureSourceType::Screen,
+                           options) {}
 ScreenCapturerPipeWire::~ScreenCapturerPipeWire() {}
 
 // static
 std::unique_ptr<DesktopCapturer>
 ScreenCapturerPipeWire::CreateRawScreenCapturer(
     const DesktopCaptureOptions& options) {
-  return std::make_unique<ScreenCapturerPipeWire>();
+  return std::make_unique<ScreenCapturerPipeWire>(options);
 }
 
 }  // namespace webrtc
@@ -19,7 +19,7 @@ namespace webrtc {
 
 class ScreenCapturerPipeWire : public BaseCapturerPipeWire {
  public:
-  ScreenCapturerPipeWire();
+  explicit ScreenCapturerPipeWire(const DesktopCaptureOptions& options);
   ~ScreenCapturerPipeWire() override;
 
   static std::unique_ptr<DesktopCapturer> CreateRawScreenCapturer(
@@ -166,10 +166,11 @@ void ScreenCapturerX11::CaptureFrame() {
   // If the current frame is from an older generation then allocate a new one.
   // Note that we can't reallocate other buffers at this point, since the caller
   // may still be reading from them.
+  // Where possible the frames are shared memory segments that the X server
+  // writes to directly.
   if (!queue_.current_frame()) {
     queue_.ReplaceCurrentFrame(
-        SharedDesktopFrame::Wrap(std::unique_ptr<DesktopFrame>(
-            new BasicDesktopFrame(x_server_pixel_buffer_.window_size()))));
+        SharedDesktopFrame::Wrap(x_server_pixel_buffer_.CreateFrame()));
   }
 
   std::unique_ptr<DesktopFrame> result = CaptureScreen();
@@ -15,15 +15,17 @@
 
 namespace webrtc {
 
-WindowCapturerPipeWire::WindowCapturerPipeWire()
-    : BaseCapturerPipeWire(BaseCapturerPipeWire::CaptureSourceType::Window) {}
+WindowCapturerPipeWire::WindowCapturerPipeWire(
+    const DesktopCaptureOptions& options)
+    : BaseCapturerPipeWire(BaseCapturerPipeWire::CaptureSourceType::Window,
+                           options) {}
 WindowCapturerPipeWire::~WindowCapturerPipeWire() {}
 
 // static
 std::unique_ptr<DesktopCapturer>
 WindowCapturerPipeWire::CreateRawWindowCapturer(
     const DesktopCaptureOptions& options) {
-  return std::make_unique<WindowCapturerPipeWire>();
+  return std::make_unique<WindowCapturerPipeWire>(options);
 }
 
 }  // namespace webrtc
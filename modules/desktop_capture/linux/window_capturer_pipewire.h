@@ -19,7 +19,7 @@ namespace webrtc {
 
 class WindowCapturerPipeWire : public BaseCapturerPipeWire {
  public:
-  WindowCapturerPipeWire();
+  explicit WindowCapturerPipeWire(const DesktopCaptureOptions& options);
   ~WindowCapturerPipeWire() override;
 
   static std::unique_ptr<DesktopCapturer> CreateRawWindowCapturer(
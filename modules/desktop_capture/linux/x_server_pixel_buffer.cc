@@ -131,8 +131,31 @@ void SlowBlit(XImage* x_image,
   }
 }
 
+// A frame whose pixels are a shared memory segment that the X server writes
+// to. Detaching the segment doesn't involve the X server, so the frame can be
+// released on any thread.
+class XShmDesktopFrame : public DesktopFrame {
+ public:
+  XShmDesktopFrame(DesktopSize size, int stride, uint8_t* data)
+      : DesktopFrame(size, stride, data, nullptr) {}
+  ~XShmDesktopFrame() override { shmdt(data()); }
+
+ private:
+  RTC_DISALLOW_COPY_AND_ASSIGN(XShmDesktopFrame);
+};
+
 }  // namespace
 
+struct XServerPixelBuffer::FrameBuffer {
+  XShmSegmentInfo segment_info;
+  XImage* image = nullptr;
+  Pixmap pixmap = 0;
+  // The Synchronize() the segment was last fetched for, when not using
+  // |pixmap|.
+  int64_t synchronize_count = -1;
+  bool get_image_succeeded = false;
+};
+
 XServerPixelBuffer::XServerPixelBuffer() {}
 
 XServerPixelBuffer::~XServerPixelBuffer() {
@@ -156,6 +179,14 @@ void XServerPixelBuffer::Release() {
     XFreeGC(display_, shm_gc_);
     shm_gc_ = nullptr;
   }
+  // The frames detach their segments themselves.
+  for (const auto& frame_buffer : frame_buffers_) {
+    if (frame_buffer->pixmap)
+      XFreePixmap(display_, frame_buffer->pixmap);
+    XShmDetach(display_, &frame_buffer->segment_info);
+    XDestroyImage(frame_buffer->image);
+  }
+  frame_buffers_.clear();
 
   ReleaseSharedMemorySegment();
 
@@ -204,6 +235,8 @@ bool XServerPixelBuffer::Init(XAtomCache* cache, Window window) {
 void XServerPixelBuffer::InitShm(const XWindowAttributes& attributes) {
   Visual* default_visual = attributes.visual;
   int default_depth = attributes.depth;
+  visual_ = default_visual;
+  depth_ = default_depth;
 
   int major, minor;
   Bool have_pixmaps;
@@ -314,7 +347,10 @@ bool XServerPixelBuffer::IsWindowValid() const {
 }
 
 void XServerPixelBuffer::Synchronize() {
-  if (shm_segment_info_ && !shm_pixmap_) {
+  ++synchronize_count_;
+  xshm_get_image_succeeded_ = false;
+  // Frames from CreateFrame() are fetched by CaptureRect() instead.
+  if (shm_segment_info_ && !shm_pixmap_ && frame_buffers_.empty()) {
     // XShmGetImage can fail if the display is being reconfigured.
     XErrorTrap error_trap(display_);
     // XShmGetImage fails if the window is partially out of screen.
@@ -328,6 +364,31 @@ bool XServerPixelBuffer::CaptureRect(const DesktopRect& rect,
   RTC_DCHECK_LE(rect.right(), window_rect_.width());
   RTC_DCHECK_LE(rect.bottom(), window_rect_.height());
 
+  if (FrameBuffer* frame_buffer = FindFrameBuffer(*frame)) {
+    bool captured;
+    if (frame_buffer->pixmap) {
+      XCopyArea(display_, window_, frame_buffer->pixmap, shm_gc_, rect.left(),
+                rect.top(), rect.width(), rect.height(), rect.left(),
+                rect.top());
+      XSync(display_, False);
+      captured = true;
+    } else {
+      if (frame_buffer->synchronize_count != synchronize_count_) {
+        frame_buffer->synchronize_count = synchronize_count_;
+        XErrorTrap error_trap(display_);
+        frame_buffer->get_image_succeeded = XShmGetImage(
+            display_, window_, frame_buffer->image, 0, 0, AllPlanes);
+      }
+      captured = frame_buffer->get_image_succeeded;
+    }
+    // Otherwise fall back to copying, as for any other frame.
+    if (captured) {
+      if (!icc_profile_.empty())
+        frame->set_icc_profile(icc_profile_);
+      return true;
+    }
+  }
+
   XImage* image;
   uint8_t* data;
 
@@ -368,4 +429,88 @@ bool XServerPixelBuffer::CaptureRect(const DesktopRect& rect,
   return true;
 }
 
+std::unique_ptr<DesktopFrame> XServerPixelBuffer::CreateFrame() {
+  std::unique_ptr<FrameBuffer> frame_buffer = CreateFrameBuffer();
+  if (!frame_buffer)
+    return std::make_unique<BasicDesktopFrame>(window_rect_.size());
+
+  std::unique_ptr<DesktopFrame> frame = std::make_unique<XShmDesktopFrame>(
+      window_rect_.size(), frame_buffer->image->bytes_per_line,
+      reinterpret_cast<uint8_t*>(frame_buffer->segment_info.shmaddr));
+  frame_buffers_.push_back(std::move(frame_buffer));
+  return frame;
+}
+
+std::unique_ptr<XServerPixelBuffer::FrameBuffer>
+XServerPixelBuffer::CreateFrameBuffer() {
+  // Frames hold 32-bit RGB pixels, so only then can the X server write to
+  // them directly.
+  if (!shm_segment_info_ || !IsXImageRGBFormat(x_shm_image_))
+    return nullptr;
+
+  auto frame_buffer = std::make_unique<FrameBuffer>();
+  XShmSegmentInfo* segment_info = &frame_buffer->segment_info;
+  segment_info->shmid = -1;
+  segment_info->shmaddr = nullptr;
+  segment_info->readOnly = False;
+  XImage* image =
+      XShmCreateImage(display_, visual_, depth_, ZPixmap, 0, segment_info,
+                      window_rect_.width(), window_rect_.height());
+  if (!image)
+    return nullptr;
+  segment_info->shmid = shmget(
+      IPC_PRIVATE, image->bytes_per_line * image->height, IPC_CREAT | 0600);
+  if (segment_info->shmid == -1) {
+    XDestroyImage(image);
+    return nullptr;
+  }
+  void* shmat_result = shmat(segment_info->shmid, 0, 0);
+  if (shmat_result == reinterpret_cast<void*>(-1)) {
+    shmctl(segment_info->shmid, IPC_RMID, 0);
+    XDestroyImage(image);
+    return nullptr;
+  }
+  segment_info->shmaddr = reinterpret_cast<char*>(shmat_result);
+  image->data = segment_info->shmaddr;
+
+  bool attached;
+  {
+    XErrorTrap error_trap(display_);
+    attached = XShmAttach(display_, segment_info);
+    XSync(display_, False);
+    if (error_trap.GetLastErrorAndDisable() != 0)
+      attached = false;
+  }
+  // The segment is freed once both this process and the X server have
+  // detached from it.
+  shmctl(segment_info->shmid, IPC_RMID, 0);
+  if (!attached) {
+    shmdt(segment_info->shmaddr);
+    XDestroyImage(image);
+    return nullptr;
+  }
+  frame_buffer->image = image;
+
+  if (shm_pixmap_) {
+    XErrorTrap error_trap(display_);
+    frame_buffer->pixmap = XShmCreatePixmap(
+        display_, window_, segment_info->shmaddr, segment_info,
+        window_rect_.width(), window_rect_.height(), depth_);
+    XSync(display_, False);
+    if (error_trap.GetLastErrorAndDisable() != 0)
+      frame_buffer->pixmap = 0;
+  }
+  return frame_buffer;
+}
+
+XServerPixelBuffer::FrameBuffer* XServerPixelBuffer::FindFrameBuffer(
+    const DesktopFrame& frame) {
+  // Newest first, in case the address of a released frame has been reused.
+  for (auto it = frame_buffers_.rbegin(); it != frame_buffers_.rend(); ++it) {
+    if (reinterpret_cast<uint8_t*>((*it)->image->data) == frame.data())
+      return it->get();
+  }
+  return nullptr;
+}
+
 }  // namespace webrtc
@@ -64,11 +64,25 @@ class XServerPixelBuffer {
   // that |rect| is not larger than window_size().
   bool CaptureRect(const DesktopRect& rect, DesktopFrame* frame);
 
+  // Returns a frame of window_size() to pass to CaptureRect(). Where the
+  // shared memory extension allows, the frame's pixels live in a shared
+  // memory segment of its own that the X server writes to, and CaptureRect()
+  // doesn't copy them. The frame may outlive this object, but is only
+  // captured into until the next Init() or Release().
+  std::unique_ptr<DesktopFrame> CreateFrame();
+
  private:
+  // A shared memory segment attached to the X server, for a frame returned
+  // by CreateFrame().
+  struct FrameBuffer;
+
   void ReleaseSharedMemorySegment();
 
+  FrameBuffer* FindFrameBuffer(const DesktopFrame& frame);
+
   void InitShm(const XWindowAttributes& attributes);
   bool InitPixmaps(int depth);
+  std::unique_ptr<FrameBuffer> CreateFrameBuffer();
 
   Display* display_ = nullptr;
   Window window_ = 0;
@@ -80,6 +94,12 @@ class XServerPixelBuffer {
   GC shm_gc_ = nullptr;
   bool xshm_get_image_succeeded_ = false;
   std::vector<uint8_t> icc_profile_;
+  Visual* visual_ = nullptr;
+  int depth_ = 0;
+  // Counts the calls to Synchronize(), so that each frame buffer is fetched
+  // from the server once per capture.
+  int64_t synchronize_count_ = 0;
+  std::vector<std::unique_ptr<FrameBuffer>> frame_buffers_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(XServerPixelBuffer);
 };
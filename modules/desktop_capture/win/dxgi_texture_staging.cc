@@ -57,6 +57,7 @@ bool DxgiTextureStaging::InitializeStage(ID3D11Texture2D* texture) {
     // ID3D11Texture2D instance.
     stage_.Reset();
     surface_.Reset();
+    stage_up_to_date_ = false;
   } else {
     RTC_DCHECK(!surface_);
   }
@@ -93,7 +94,8 @@ void DxgiTextureStaging::AssertStageAndSurfaceAreSameObject() {
 
 bool DxgiTextureStaging::CopyFromTexture(
     const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-    ID3D11Texture2D* texture) {
+    ID3D11Texture2D* texture,
+    const DesktopRegion& updated_region) {
   RTC_DCHECK_GT(frame_info.AccumulatedFrames, 0);
   RTC_DCHECK(texture);
 
@@ -103,8 +105,28 @@ bool DxgiTextureStaging::CopyFromTexture(
     return false;
   }
 
-  device_.context()->CopyResource(static_cast<ID3D11Resource*>(stage_.Get()),
-                                  static_cast<ID3D11Resource*>(texture));
+  ID3D11Resource* const stage = static_cast<ID3D11Resource*>(stage_.Get());
+  if (stage_up_to_date_) {
+    // The rest of stage_ still holds the same content as the texture, so only
+    // the updated region is copied on the GPU.
+    for (DesktopRegion::Iterator it(updated_region); !it.IsAtEnd();
+         it.Advance()) {
+      const DesktopRect& rect = it.rect();
+      D3D11_BOX box = {static_cast<UINT>(rect.left()),
+                       static_cast<UINT>(rect.top()),
+                       0,
+                       static_cast<UINT>(rect.right()),
+                       static_cast<UINT>(rect.bottom()),
+                       1};
+      device_.context()->CopySubresourceRegion(
+          stage, 0, box.left, box.top, 0,
+          static_cast<ID3D11Resource*>(texture), 0, &box);
+    }
+  } else {
+    device_.context()->CopyResource(stage,
+                                    static_cast<ID3D11Resource*>(texture));
+    stage_up_to_date_ = true;
+  }
 
   *rect() = {0};
   _com_error error = surface_->Map(rect(), DXGI_MAP_READ);
@@ -123,6 +145,7 @@ bool DxgiTextureStaging::DoRelease() {
   if (error.Error() != S_OK) {
     stage_.Reset();
     surface_.Reset();
+    stage_up_to_date_ = false;
   }
   // If using staging mode, we only need to recreate ID3D11Texture2D instance.
   // This will happen during next CopyFrom call. So this function always returns
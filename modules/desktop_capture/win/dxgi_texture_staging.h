@@ -39,9 +39,11 @@ class DxgiTextureStaging : public DxgiTexture {
 
  protected:
   // Copies selected regions of a frame represented by frame_info and texture.
-  // Returns false if anything wrong.
+  // Only |updated_region| is copied into stage_ unless stage_ has just been
+  // created. Returns false if anything wrong.
   bool CopyFromTexture(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                       ID3D11Texture2D* texture) override;
+                       ID3D11Texture2D* texture,
+                       const DesktopRegion& updated_region) override;
 
   bool DoRelease() override;
 
@@ -61,6 +63,9 @@ class DxgiTextureStaging : public DxgiTexture {
   const D3dDevice device_;
   Microsoft::WRL::ComPtr<ID3D11Texture2D> stage_;
   Microsoft::WRL::ComPtr<IDXGISurface> surface_;
+  // Whether stage_ holds the whole content of the last copied texture, so
+  // that only the updated region needs to be copied into it.
+  bool stage_up_to_date_ = false;
 };
 
 }  // namespace webrtc
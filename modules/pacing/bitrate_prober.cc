@@ -37,12 +37,13 @@ BitrateProberConfig::BitrateProberConfig(
     : min_probe_packets_sent("min_probe_packets_sent", 5),
       min_probe_delta("min_probe_delta", TimeDelta::ms(1)),
       min_probe_duration("min_probe_duration", TimeDelta::ms(15)),
-      max_probe_delay("max_probe_delay", TimeDelta::ms(3)) {
+      max_probe_delay("max_probe_delay", TimeDelta::ms(3)),
+      media_wait("media_wait", TimeDelta::Zero()) {
   ParseFieldTrial({&min_probe_packets_sent, &min_probe_delta,
                    &min_probe_duration, &max_probe_delay},
                   key_value_config->Lookup("WebRTC-Bwe-ProbingConfiguration"));
   ParseFieldTrial({&min_probe_packets_sent, &min_probe_delta,
-                   &min_probe_duration, &max_probe_delay},
+                   &min_probe_duration, &max_probe_delay, &media_wait},
                   key_value_config->Lookup("WebRTC-Bwe-ProbingBehavior"));
 }
 
@@ -56,6 +57,7 @@ BitrateProber::~BitrateProber() {
 BitrateProber::BitrateProber(const WebRtcKeyValueConfig& field_trials)
     : probing_state_(ProbingState::kDisabled),
       next_probe_time_ms_(-1),
+      media_wait_start_ms_(-1),
       total_probe_count_(0),
       total_failed_probe_count_(0),
       config_(&field_trials) {
@@ -79,6 +81,8 @@ bool BitrateProber::IsProbing() const {
 }
 
 void BitrateProber::OnIncomingPacket(size_t packet_size) {
+  if (!config_.media_wait->IsZero())
+    return;
   // Don't initialize probing unless we have something large enough to start
   // probing.
   if (probing_state_ == ProbingState::kInactive && !clusters_.empty() &&
@@ -90,6 +94,35 @@ void BitrateProber::OnIncomingPacket(size_t packet_size) {
   }
 }
 
+void BitrateProber::OnQueuedMedia(size_t queue_size,
+                                  size_t queued_packets,
+                                  int64_t now_ms) {
+  if (config_.media_wait->IsZero() ||
+      probing_state_ != ProbingState::kInactive || clusters_.empty()) {
+    return;
+  }
+  // Same as in OnIncomingPacket(), wait for something large enough to start
+  // probing with before starting the wait.
+  if (queue_size <
+      std::min<size_t>(RecommendedMinProbeSize(), kMinProbePacketSize)) {
+    return;
+  }
+  if (media_wait_start_ms_ < 0)
+    media_wait_start_ms_ = now_ms;
+  // Each probe sends at least one packet.
+  const PacedPacketInfo& cluster = clusters_.front().pace_info;
+  bool enough_media =
+      queue_size >= static_cast<size_t>(cluster.probe_cluster_min_bytes) &&
+      queued_packets >= static_cast<size_t>(cluster.probe_cluster_min_probes);
+  if (enough_media ||
+      now_ms - media_wait_start_ms_ >= config_.media_wait->ms()) {
+    media_wait_start_ms_ = -1;
+    // Send next probe right away.
+    next_probe_time_ms_ = -1;
+    probing_state_ = ProbingState::kActive;
+  }
+}
+
 void BitrateProber::CreateProbeCluster(int bitrate_bps,
                                        int64_t now_ms,
                                        int cluster_id) {
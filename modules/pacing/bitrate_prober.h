@@ -38,6 +38,10 @@ struct BitrateProberConfig {
   // Maximum amount of time each probe can be delayed. Probe cluster is reset
   // and retried from the start when this limit is reached.
   FieldTrialParameter<TimeDelta> max_probe_delay;
+  // If non-zero, probing waits up to this long for enough media to be queued
+  // to send the whole probe cluster with media, before starting to probe with
+  // what is queued and topping up with padding.
+  FieldTrialParameter<TimeDelta> media_wait;
 };
 
 // Note that this class isn't thread-safe by itself and therefore relies
@@ -59,6 +63,12 @@ class BitrateProber {
   // with.
   void OnIncomingPacket(size_t packet_size);
 
+  // Used instead of OnIncomingPacket() when |media_wait| is configured.
+  // Initializes a new probing session once the |queued_packets| packets of
+  // |queue_size| bytes are enough for the whole probe cluster, or once probing
+  // has waited |media_wait| for media to be queued.
+  void OnQueuedMedia(size_t queue_size, size_t queued_packets, int64_t now_ms);
+
   // Create a cluster used to probe for |bitrate_bps| with |num_probes| number
   // of probes.
   void CreateProbeCluster(int bitrate_bps, int64_t now_ms, int cluster_id);
@@ -118,6 +128,9 @@ class BitrateProber {
   // Time the next probe should be sent when in kActive state.
   int64_t next_probe_time_ms_;
 
+  // Time probing started waiting for media to be queued, or -1.
+  int64_t media_wait_start_ms_;
+
   int total_probe_count_;
   int total_failed_probe_count_;
 
@@ -10,6 +10,7 @@
 
 #include "modules/pacing/bitrate_prober.h"
 
+#include "test/field_trial.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -204,4 +205,49 @@ TEST(BitrateProberTest, ProbeClusterTimeout) {
 
   EXPECT_FALSE(prober.IsProbing());
 }
+
+TEST(BitrateProberTest, WaitsForMediaToFillProbeCluster) {
+  test::ScopedFieldTrials trial("WebRTC-Bwe-ProbingBehavior/media_wait:20ms/");
+  const FieldTrialBasedConfig config;
+  BitrateProber prober(config);
+  // 15 ms at 2 Mbps.
+  constexpr int kBitrateBps = 2000000;
+  constexpr size_t kClusterBytes = 3750;
+
+  constexpr size_t kClusterPackets = 5;
+
+  int64_t now_ms = 0;
+  prober.CreateProbeCluster(kBitrateBps, now_ms, /*cluster_id=*/0);
+  prober.OnIncomingPacket(1000);
+  prober.OnQueuedMedia(1000, 1, now_ms);
+  EXPECT_FALSE(prober.IsProbing());
+  now_ms += 5;
+  prober.OnQueuedMedia(kClusterBytes - 1, kClusterPackets, now_ms);
+  EXPECT_FALSE(prober.IsProbing());
+  prober.OnQueuedMedia(kClusterBytes, kClusterPackets - 1, now_ms);
+  EXPECT_FALSE(prober.IsProbing());
+  prober.OnQueuedMedia(kClusterBytes, kClusterPackets, now_ms);
+  EXPECT_TRUE(prober.IsProbing());
+  EXPECT_EQ(0, prober.TimeUntilNextProbe(now_ms));
+}
+
+TEST(BitrateProberTest, StopsWaitingForMediaAfterMediaWait) {
+  test::ScopedFieldTrials trial("WebRTC-Bwe-ProbingBehavior/media_wait:20ms/");
+  const FieldTrialBasedConfig config;
+  BitrateProber prober(config);
+  constexpr int kBitrateBps = 2000000;
+
+  int64_t now_ms = 0;
+  prober.CreateProbeCluster(kBitrateBps, now_ms, /*cluster_id=*/0);
+  // Too small to start the wait.
+  prober.OnQueuedMedia(100, 1, now_ms);
+  now_ms += 10;
+  prober.OnQueuedMedia(1000, 1, now_ms);
+  now_ms += 19;
+  prober.OnQueuedMedia(1000, 1, now_ms);
+  EXPECT_FALSE(prober.IsProbing());
+  now_ms += 1;
+  prober.OnQueuedMedia(1000, 1, now_ms);
+  EXPECT_TRUE(prober.IsProbing());
+}
 }  // namespace webrtc
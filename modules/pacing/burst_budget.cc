@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/burst_budget.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+BurstBudget::BurstBudget()
+    : target_rate_(DataRate::Zero()),
+      max_burst_(DataSize::Zero()),
+      budget_bytes_(0) {}
+
+void BurstBudget::set_target_rate(DataRate target_rate) {
+  RTC_DCHECK(target_rate.IsFinite());
+  target_rate_ = target_rate;
+}
+
+void BurstBudget::set_max_burst(DataSize max_burst) {
+  RTC_DCHECK(max_burst.IsFinite());
+  max_burst_ = max_burst;
+  budget_bytes_ = std::min(budget_bytes_, max_burst_.bytes<double>());
+}
+
+void BurstBudget::IncreaseBudget(TimeDelta delta) {
+  RTC_DCHECK(delta.IsFinite());
+  double bytes = target_rate_.bps<double>() * delta.seconds<double>() / 8;
+  budget_bytes_ = std::min(budget_bytes_ + bytes, max_burst_.bytes<double>());
+}
+
+void BurstBudget::UseBudget(DataSize size) {
+  // Don't let a burst of unpaced packets, e.g. audio or probes, build up more
+  // debt than can be paid back in one burst.
+  budget_bytes_ = std::max(budget_bytes_ - size.bytes<double>(),
+                           -max_burst_.bytes<double>());
+}
+
+DataSize BurstBudget::bytes_remaining() const {
+  return DataSize::bytes(std::max<int64_t>(0, budget_bytes_));
+}
+
+TimeDelta BurstBudget::TimeUntilAvailable(DataSize size) const {
+  double missing_bytes = size.bytes<double>() - budget_bytes_;
+  if (missing_bytes <= 0)
+    return TimeDelta::Zero();
+  if (target_rate_.IsZero())
+    return TimeDelta::PlusInfinity();
+  return TimeDelta::us(
+      std::ceil(missing_bytes * 8 * 1000000 / target_rate_.bps<double>()));
+}
+
+}  // namespace webrtc
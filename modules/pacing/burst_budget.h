@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_BURST_BUDGET_H_
+#define MODULES_PACING_BURST_BUDGET_H_
+
+#include "api/units/data_rate.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+
+namespace webrtc {
+
+// Token bucket for pacing with a send quantum, as used by BBR. Budget accrues
+// at the target rate, and unlike the IntervalBudget, budget that isn't used
+// carries over, up to |max_burst|. Sending is allowed as long as there is
+// budget left, so sending may overshoot by a packet, which is paid back from
+// the following budget.
+class BurstBudget {
+ public:
+  BurstBudget();
+
+  void set_target_rate(DataRate target_rate);
+  void set_max_burst(DataSize max_burst);
+
+  void IncreaseBudget(TimeDelta delta);
+  void UseBudget(DataSize size);
+
+  DataSize bytes_remaining() const;
+  // Returns the time until at least |size| of budget is available, if nothing
+  // is sent meanwhile.
+  TimeDelta TimeUntilAvailable(DataSize size) const;
+
+  DataRate target_rate() const { return target_rate_; }
+  DataSize max_burst() const { return max_burst_; }
+
+ private:
+  DataRate target_rate_;
+  DataSize max_burst_;
+  // In bytes, negative after an overshoot. Kept as a double so that small
+  // increments at low rates aren't rounded away.
+  double budget_bytes_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_BURST_BUDGET_H_
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/burst_budget.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+constexpr DataRate kTargetRate = DataRate::KilobitsPerSec<8000>();
+constexpr DataSize kMaxBurst = DataSize::Bytes<10000>();
+}  // namespace
+
+TEST(BurstBudgetTest, UnderuseBuildsUpToMaxBurst) {
+  BurstBudget budget;
+  budget.set_target_rate(kTargetRate);
+  budget.set_max_burst(kMaxBurst);
+  EXPECT_EQ(DataSize::Zero(), budget.bytes_remaining());
+
+  budget.IncreaseBudget(TimeDelta::ms(5));
+  EXPECT_EQ(DataSize::bytes(5000), budget.bytes_remaining());
+  budget.IncreaseBudget(TimeDelta::ms(3));
+  EXPECT_EQ(DataSize::bytes(8000), budget.bytes_remaining());
+  budget.IncreaseBudget(TimeDelta::ms(100));
+  EXPECT_EQ(kMaxBurst, budget.bytes_remaining());
+
+  budget.set_max_burst(DataSize::bytes(4000));
+  EXPECT_EQ(DataSize::bytes(4000), budget.bytes_remaining());
+}
+
+TEST(BurstBudgetTest, OvershootIsPaidBack) {
+  BurstBudget budget;
+  budget.set_target_rate(kTargetRate);
+  budget.set_max_burst(kMaxBurst);
+  budget.IncreaseBudget(TimeDelta::ms(1));
+  budget.UseBudget(DataSize::bytes(1200));
+  budget.UseBudget(DataSize::bytes(1200));
+  EXPECT_EQ(DataSize::Zero(), budget.bytes_remaining());
+  EXPECT_EQ(TimeDelta::us(1400),
+            budget.TimeUntilAvailable(DataSize::Zero()));
+
+  budget.IncreaseBudget(TimeDelta::ms(2));
+  EXPECT_EQ(DataSize::bytes(600), budget.bytes_remaining());
+  EXPECT_EQ(TimeDelta::Zero(), budget.TimeUntilAvailable(DataSize::bytes(600)));
+  EXPECT_EQ(TimeDelta::ms(1), budget.TimeUntilAvailable(DataSize::bytes(1600)));
+}
+
+TEST(BurstBudgetTest, DebtIsLimitedToMaxBurst) {
+  BurstBudget budget;
+  budget.set_target_rate(kTargetRate);
+  budget.set_max_burst(kMaxBurst);
+  budget.UseBudget(DataSize::bytes(50000));
+  EXPECT_EQ(TimeDelta::ms(10), budget.TimeUntilAvailable(DataSize::Zero()));
+}
+
+TEST(BurstBudgetTest, NeverAvailableWithoutRate) {
+  BurstBudget budget;
+  budget.set_max_burst(kMaxBurst);
+  budget.IncreaseBudget(TimeDelta::ms(10));
+  EXPECT_EQ(DataSize::Zero(), budget.bytes_remaining());
+  EXPECT_TRUE(budget.TimeUntilAvailable(DataSize::bytes(1)).IsPlusInfinity());
+}
+
+}  // namespace webrtc
@@ -24,6 +24,24 @@
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
+namespace {
+// Number of packets that can be waiting in the lock-free ingest queue before
+// EnqueuePacket() falls back to taking the pacer lock. Covers several frames
+// of simulcast video at high bitrates.
+constexpr size_t kIngestQueueSize = 1024;
+
+std::unique_ptr<BoundedMpscQueue<std::unique_ptr<RtpPacketToSend>>>
+MaybeCreateIngestQueue(const WebRtcKeyValueConfig* field_trials) {
+  FieldTrialBasedConfig default_config;
+  const WebRtcKeyValueConfig& config =
+      field_trials ? *field_trials : default_config;
+  if (config.Lookup("WebRTC-Pacer-LockFreeEnqueue").find("Enabled") != 0)
+    return nullptr;
+  return std::make_unique<
+      BoundedMpscQueue<std::unique_ptr<RtpPacketToSend>>>(kIngestQueueSize);
+}
+}  // namespace
+
 const int64_t PacedSender::kMaxQueueLengthMs = 2000;
 const float PacedSender::kDefaultPaceMultiplier = 2.5f;
 
@@ -36,6 +54,7 @@ PacedSender::PacedSender(Clock* clock,
                          static_cast<PacingController::PacketSender*>(this),
                          event_log,
                          field_trials),
+      ingest_queue_(MaybeCreateIngestQueue(field_trials)),
       packet_router_(packet_router),
       process_thread_(process_thread) {
   if (process_thread_)
@@ -91,7 +110,29 @@ void PacedSender::SetPacingRates(DataRate pacing_rate, DataRate padding_rate) {
   pacing_controller_.SetPacingRates(pacing_rate, padding_rate);
 }
 
+void PacedSender::SetSendQuantum(DataSize send_quantum) {
+  rtc::CritScope cs(&critsect_);
+  pacing_controller_.SetSendQuantum(send_quantum);
+}
+
 void PacedSender::EnqueuePacket(std::unique_ptr<RtpPacketToSend> packet) {
+  if (ingest_queue_) {
+    if (ingest_queue_->TryPush(&packet)) {
+      // Hand the packet over right away if nobody else holds the lock, so
+      // that the queue stats stay accurate when there is no contention.
+      if (critsect_.TryEnter()) {
+        DrainIngestQueue(/*wait_for_pending_pushes=*/false);
+        critsect_.Leave();
+      }
+      return;
+    }
+    // The ingest queue is full. Empty it before enqueuing directly so that
+    // packets from this thread stay in order.
+    rtc::CritScope cs(&critsect_);
+    DrainIngestQueue(/*wait_for_pending_pushes=*/true);
+    pacing_controller_.EnqueuePacket(std::move(packet));
+    return;
+  }
   rtc::CritScope cs(&critsect_);
   pacing_controller_.EnqueuePacket(std::move(packet));
 }
@@ -143,12 +184,12 @@ int64_t PacedSender::TimeUntilNextProcess() {
     return next_probe->ms();
   }
 
-  const TimeDelta min_packet_limit = TimeDelta::ms(5);
-  return std::max(min_packet_limit - elapsed_time, TimeDelta::Zero()).ms();
+  return pacing_controller_.TimeUntilAvailableBudget().ms();
 }
 
 void PacedSender::Process() {
   rtc::CritScope cs(&critsect_);
+  DrainIngestQueue(/*wait_for_pending_pushes=*/false);
   pacing_controller_.ProcessPackets();
 }
 
@@ -177,4 +218,19 @@ std::vector<std::unique_ptr<RtpPacketToSend>> PacedSender::GeneratePadding(
   critsect_.Enter();
   return padding_packets;
 }
+
+void PacedSender::DrainIngestQueue(bool wait_for_pending_pushes) {
+  if (!ingest_queue_)
+    return;
+  std::unique_ptr<RtpPacketToSend> packet;
+  while (!ingest_queue_->Empty()) {
+    if (ingest_queue_->TryPop(&packet)) {
+      pacing_controller_.EnqueuePacket(std::move(packet));
+    } else if (!wait_for_pending_pushes) {
+      // The next packet is still being written by its producer; it will be
+      // picked up on the next drain.
+      break;
+    }
+  }
+}
 }  // namespace webrtc
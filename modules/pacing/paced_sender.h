@@ -32,6 +32,7 @@
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "modules/utility/include/process_thread.h"
+#include "rtc_base/bounded_mpsc_queue.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/thread_annotations.h"
 
@@ -71,7 +72,9 @@ class PacedSender : public Module,
   // Methods implementing RtpPacketSender.
 
   // Adds the packet to the queue and calls PacketRouter::SendPacket() when
-  // it's time to send.
+  // it's time to send. With the "WebRTC-Pacer-LockFreeEnqueue" field trial,
+  // packets are handed off through a lock-free queue and moved into the pacing
+  // controller by whichever thread next holds the pacer lock.
   void EnqueuePacket(std::unique_ptr<RtpPacketToSend> packet) override;
 
   // Methods implementing RtpPacketPacer:
@@ -90,6 +93,8 @@ class PacedSender : public Module,
   // Sets the pacing rates. Must be called once before packets can be sent.
   void SetPacingRates(DataRate pacing_rate, DataRate padding_rate) override;
 
+  void SetSendQuantum(DataSize send_quantum) override;
+
   // Currently audio traffic is not accounted by pacer and passed through.
   // With the introduction of audio BWE audio traffic will be accounted for
   // the pacer budget calculation. The audio traffic still will be injected
@@ -144,6 +149,13 @@ class PacedSender : public Module,
   std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       DataSize size) override RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
 
+  // Moves packets from |ingest_queue_| into |pacing_controller_|. If
+  // |wait_for_pending_pushes| is true, also waits for pushes that other
+  // threads have started but not completed, so that the queue is empty on
+  // return.
+  void DrainIngestQueue(bool wait_for_pending_pushes)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+
   // Private implementation of Module to not expose those implementation details
   // publicly and control when the class is registered/deregistered.
   class ModuleProxy : public Module {
@@ -165,6 +177,12 @@ class PacedSender : public Module,
   rtc::CriticalSection critsect_;
   PacingController pacing_controller_ RTC_GUARDED_BY(critsect_);
 
+  // Packets enqueued without taking |critsect_|, null unless the
+  // "WebRTC-Pacer-LockFreeEnqueue" field trial is enabled. Any thread may
+  // push; popping requires |critsect_|.
+  const std::unique_ptr<BoundedMpscQueue<std::unique_ptr<RtpPacketToSend>>>
+      ingest_queue_;
+
   PacketRouter* const packet_router_;
   ProcessThread* const process_thread_;
 };
@@ -74,7 +74,19 @@ std::unique_ptr<RtpPacketToSend> BuildRtpPacket(RtpPacketToSend::Type type) {
   return packet;
 }
 
-TEST(PacedSenderTest, PacesPackets) {
+class PacedSenderTest : public ::testing::TestWithParam<std::string> {
+ protected:
+  PacedSenderTest() : field_trials_(GetParam()) {}
+
+  ScopedFieldTrials field_trials_;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    LockedAndLockFreeEnqueue,
+    PacedSenderTest,
+    ::testing::Values("", "WebRTC-Pacer-LockFreeEnqueue/Enabled/"));
+
+TEST_P(PacedSenderTest, PacesPackets) {
   SimulatedClock clock(0);
   MockCallback callback;
   MockProcessThread process_thread;
@@ -91,6 +103,7 @@ TEST(PacedSenderTest, PacesPackets) {
   for (size_t i = 0; i < kPacketsToSend; ++i) {
     pacer.EnqueuePacket(BuildRtpPacket(RtpPacketToSend::Type::kVideo));
   }
+  EXPECT_EQ(kPacketsToSend, pacer.QueueSizePackets());
 
   // Expect all of them to be sent.
   size_t packets_sent = 0;
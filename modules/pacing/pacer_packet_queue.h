@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_PACER_PACKET_QUEUE_H_
+#define MODULES_PACING_PACER_PACKET_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+// Queue of packets waiting to be sent by the PacingController. Packets are
+// popped in priority order, round robin between streams of equal priority
+// based on how much data each stream has sent.
+class PacerPacketQueue {
+ public:
+  // A packet on its way out of the queue, see BeginPop().
+  class QueuedPacket {
+   public:
+    virtual RtpPacketToSend::Type type() const = 0;
+    virtual DataSize size() const = 0;
+    virtual std::unique_ptr<RtpPacketToSend> ReleasePacket() = 0;
+
+   protected:
+    ~QueuedPacket() = default;
+  };
+
+  virtual ~PacerPacketQueue() = default;
+
+  virtual void Push(int priority,
+                    Timestamp enqueue_time,
+                    uint64_t enqueue_order,
+                    std::unique_ptr<RtpPacketToSend> packet) = 0;
+  // Removes the next packet to send from the queue. The returned packet stays
+  // valid until either CancelPop(), which puts it back, or FinalizePop() is
+  // called. Must not be called when the queue is empty.
+  virtual QueuedPacket* BeginPop() = 0;
+  virtual void CancelPop() = 0;
+  virtual void FinalizePop() = 0;
+
+  virtual bool Empty() const = 0;
+  virtual size_t SizeInPackets() const = 0;
+  virtual DataSize Size() const = 0;
+
+  virtual Timestamp OldestEnqueueTime() const = 0;
+  virtual TimeDelta AverageQueueTime() const = 0;
+  virtual void UpdateQueueTime(Timestamp now) = 0;
+  virtual void SetPauseState(bool paused, Timestamp now) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_PACER_PACKET_QUEUE_H_
@@ -17,6 +17,8 @@
 
 #include "modules/pacing/bitrate_prober.h"
 #include "modules/pacing/interval_budget.h"
+#include "modules/pacing/pooled_round_robin_packet_queue.h"
+#include "modules/pacing/round_robin_packet_queue.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -33,6 +35,11 @@ constexpr TimeDelta kMaxElapsedTime = TimeDelta::Seconds<2>();
 // Upper cap on process interval, in case process has not been called in a long
 // time.
 constexpr TimeDelta kMaxProcessingInterval = TimeDelta::Millis<30>();
+// With a send quantum, the burst budget holds this many quanta, so that waking
+// up a bit late doesn't lose budget.
+constexpr int kBurstBudgetQuanta = 2;
+// The process thread runs with millisecond resolution.
+constexpr TimeDelta kMinBurstInterval = TimeDelta::Millis<1>();
 
 bool IsDisabled(const WebRtcKeyValueConfig& field_trials,
                 absl::string_view key) {
@@ -44,6 +51,19 @@ bool IsEnabled(const WebRtcKeyValueConfig& field_trials,
   return field_trials.Lookup(key).find("Enabled") == 0;
 }
 
+// The queue implementation is selected with |selection_field_trials|, which
+// is never null, and |field_trials| is passed on as is to the queue.
+std::unique_ptr<PacerPacketQueue> CreatePacketQueue(
+    Timestamp start_time,
+    const WebRtcKeyValueConfig& selection_field_trials,
+    const WebRtcKeyValueConfig* field_trials) {
+  if (IsEnabled(selection_field_trials, "WebRTC-Pacer-PooledPacketQueue")) {
+    return std::make_unique<PooledRoundRobinPacketQueue>(start_time,
+                                                         field_trials);
+  }
+  return std::make_unique<RoundRobinPacketQueue>(start_time, field_trials);
+}
+
 int GetPriorityForType(RtpPacketToSend::Type type) {
   switch (type) {
     case RtpPacketToSend::Type::kAudio:
@@ -88,18 +108,21 @@ PacingController::PacingController(Clock* clock,
       send_padding_if_silent_(
           IsEnabled(*field_trials_, "WebRTC-Pacer-PadInSilence")),
       pace_audio_(!IsDisabled(*field_trials_, "WebRTC-Pacer-BlockAudio")),
+      send_batched_(IsEnabled(*field_trials_, "WebRTC-Pacer-BatchedSend")),
       min_packet_limit_(kDefaultMinPacketLimit),
       last_timestamp_(clock_->CurrentTime()),
       paused_(false),
       media_budget_(0),
       padding_budget_(0),
+      send_quantum_(DataSize::Zero()),
       prober_(*field_trials_),
       probing_send_failure_(false),
       padding_failure_state_(false),
       pacing_bitrate_(DataRate::Zero()),
       time_last_process_(clock->CurrentTime()),
       last_send_time_(time_last_process_),
-      packet_queue_(time_last_process_, field_trials),
+      packet_queue_(
+          CreatePacketQueue(time_last_process_, *field_trials_, field_trials)),
       packet_counter_(0),
       congestion_window_size_(DataSize::PlusInfinity()),
       outstanding_data_(DataSize::Zero()),
@@ -126,14 +149,14 @@ void PacingController::Pause() {
   if (!paused_)
     RTC_LOG(LS_INFO) << "PacedSender paused.";
   paused_ = true;
-  packet_queue_.SetPauseState(true, CurrentTime());
+  packet_queue_->SetPauseState(true, CurrentTime());
 }
 
 void PacingController::Resume() {
   if (paused_)
     RTC_LOG(LS_INFO) << "PacedSender resumed.";
   paused_ = false;
-  packet_queue_.SetPauseState(false, CurrentTime());
+  packet_queue_->SetPauseState(false, CurrentTime());
 }
 
 bool PacingController::IsPaused() const {
@@ -184,6 +207,16 @@ void PacingController::SetPacingRates(DataRate pacing_rate,
                       << " padding_budget_kbps=" << padding_rate.kbps();
 }
 
+void PacingController::SetSendQuantum(DataSize send_quantum) {
+  RTC_DCHECK(send_quantum.IsFinite());
+  if (send_quantum_.IsZero() && !send_quantum.IsZero()) {
+    RTC_LOG(LS_INFO) << "Pacing media with a send quantum of "
+                     << ToString(send_quantum);
+  }
+  send_quantum_ = send_quantum;
+  burst_budget_.set_max_burst(send_quantum_ * kBurstBudgetQuanta);
+}
+
 void PacingController::EnqueuePacket(std::unique_ptr<RtpPacketToSend> packet) {
   RTC_DCHECK(pacing_bitrate_ > DataRate::Zero())
       << "SetPacingRate must be called before InsertPacket.";
@@ -197,7 +230,9 @@ void PacingController::EnqueuePacket(std::unique_ptr<RtpPacketToSend> packet) {
 
   RTC_CHECK(packet->packet_type());
   int priority = GetPriorityForType(*packet->packet_type());
-  packet_queue_.Push(priority, now, packet_counter_++, std::move(packet));
+  packet_queue_->Push(priority, now, packet_counter_++, std::move(packet));
+  prober_.OnQueuedMedia(packet_queue_->Size().bytes(),
+                        packet_queue_->SizeInPackets(), now.ms());
 }
 
 void PacingController::SetAccountForAudioPackets(bool account_for_audio) {
@@ -212,11 +247,11 @@ TimeDelta PacingController::ExpectedQueueTime() const {
 }
 
 size_t PacingController::QueueSizePackets() const {
-  return packet_queue_.SizeInPackets();
+  return packet_queue_->SizeInPackets();
 }
 
 DataSize PacingController::QueueSizeData() const {
-  return packet_queue_.Size();
+  return packet_queue_->Size();
 }
 
 absl::optional<Timestamp> PacingController::FirstSentPacketTime() const {
@@ -224,7 +259,7 @@ absl::optional<Timestamp> PacingController::FirstSentPacketTime() const {
 }
 
 TimeDelta PacingController::OldestPacketWaitTime() const {
-  Timestamp oldest_packet = packet_queue_.OldestEnqueueTime();
+  Timestamp oldest_packet = packet_queue_->OldestEnqueueTime();
   if (oldest_packet.IsInfinite()) {
     return TimeDelta::Zero();
   }
@@ -279,6 +314,18 @@ TimeDelta PacingController::TimeElapsedSinceLastProcess() const {
   return CurrentTime() - time_last_process_;
 }
 
+TimeDelta PacingController::TimeUntilAvailableBudget() const {
+  TimeDelta interval = min_packet_limit_;
+  if (!send_quantum_.IsZero() && !packet_queue_->Empty() && !Congested()) {
+    // Come back once the next burst has accrued. At high pacing rates that is
+    // sooner than the regular process interval.
+    interval = std::max(
+        kMinBurstInterval,
+        std::min(interval, burst_budget_.TimeUntilAvailable(send_quantum_)));
+  }
+  return std::max(interval - TimeElapsedSinceLastProcess(), TimeDelta::Zero());
+}
+
 void PacingController::ProcessPackets() {
   Timestamp now = CurrentTime();
   TimeDelta elapsed_time = UpdateTimeAndGetElapsed(now);
@@ -299,16 +346,16 @@ void PacingController::ProcessPackets() {
 
   if (elapsed_time > TimeDelta::Zero()) {
     DataRate target_rate = pacing_bitrate_;
-    DataSize queue_size_data = packet_queue_.Size();
+    DataSize queue_size_data = packet_queue_->Size();
     if (queue_size_data > DataSize::Zero()) {
       // Assuming equal size packets and input/output rate, the average packet
       // has avg_time_left_ms left to get queue_size_bytes out of the queue, if
       // time constraint shall be met. Determine bitrate needed for that.
-      packet_queue_.UpdateQueueTime(CurrentTime());
+      packet_queue_->UpdateQueueTime(CurrentTime());
       if (drain_large_queues_) {
         TimeDelta avg_time_left =
             std::max(TimeDelta::ms(1),
-                     queue_time_limit - packet_queue_.AverageQueueTime());
+                     queue_time_limit - packet_queue_->AverageQueueTime());
         DataRate min_rate_needed = queue_size_data / avg_time_left;
         if (min_rate_needed > target_rate) {
           target_rate = min_rate_needed;
@@ -319,9 +366,13 @@ void PacingController::ProcessPackets() {
     }
 
     media_budget_.set_target_rate_kbps(target_rate.kbps());
+    burst_budget_.set_target_rate(target_rate);
     UpdateBudgetWithElapsedTime(elapsed_time);
   }
 
+  // Starts probing once probing has waited long enough for media.
+  prober_.OnQueuedMedia(packet_queue_->Size().bytes(),
+                        packet_queue_->SizeInPackets(), now.ms());
   bool is_probing = prober_.IsProbing();
   PacedPacketInfo pacing_info;
   absl::optional<DataSize> recommended_probe_size;
@@ -331,6 +382,10 @@ void PacingController::ProcessPackets() {
   }
 
   DataSize data_sent = DataSize::Zero();
+  // With batched sending, each packet is handed to the packet sender only
+  // once the next packet of the burst is known, so that the final packet can
+  // be flagged as the end of the batch.
+  std::unique_ptr<RtpPacketToSend> held_back_packet;
   // The paused state is checked in the loop since it leaves the critical
   // section allowing the paused state to be changed from other code.
   while (!paused_) {
@@ -358,7 +413,15 @@ void PacingController::ProcessPackets() {
 
     std::unique_ptr<RtpPacketToSend> rtp_packet = packet->ReleasePacket();
     RTC_DCHECK(rtp_packet);
-    packet_sender_->SendRtpPacket(std::move(rtp_packet), pacing_info);
+    if (send_batched_) {
+      rtp_packet->set_is_batchable(true);
+      if (held_back_packet) {
+        packet_sender_->SendRtpPacket(std::move(held_back_packet), pacing_info);
+      }
+      held_back_packet = std::move(rtp_packet);
+    } else {
+      packet_sender_->SendRtpPacket(std::move(rtp_packet), pacing_info);
+    }
 
     data_sent += packet->size();
     // Send succeeded, remove it from the queue.
@@ -367,6 +430,11 @@ void PacingController::ProcessPackets() {
       break;
   }
 
+  if (held_back_packet) {
+    held_back_packet->set_is_last_in_batch(true);
+    packet_sender_->SendRtpPacket(std::move(held_back_packet), pacing_info);
+  }
+
   if (is_probing) {
     probing_send_failure_ = data_sent == DataSize::Zero();
     if (!probing_send_failure_) {
@@ -378,7 +446,7 @@ void PacingController::ProcessPackets() {
 DataSize PacingController::PaddingToAdd(
     absl::optional<DataSize> recommended_probe_size,
     DataSize data_sent) {
-  if (!packet_queue_.Empty()) {
+  if (!packet_queue_->Empty()) {
     // Actual payload available, no need to add padding.
     return DataSize::Zero();
   }
@@ -404,29 +472,29 @@ DataSize PacingController::PaddingToAdd(
   return DataSize::bytes(padding_budget_.bytes_remaining());
 }
 
-RoundRobinPacketQueue::QueuedPacket* PacingController::GetPendingPacket(
+PacerPacketQueue::QueuedPacket* PacingController::GetPendingPacket(
     const PacedPacketInfo& pacing_info) {
-  if (packet_queue_.Empty()) {
+  if (packet_queue_->Empty()) {
     return nullptr;
   }
 
   // Since we need to release the lock in order to send, we first pop the
   // element from the priority queue but keep it in storage, so that we can
   // reinsert it if send fails.
-  RoundRobinPacketQueue::QueuedPacket* packet = packet_queue_.BeginPop();
+  PacerPacketQueue::QueuedPacket* packet = packet_queue_->BeginPop();
   bool audio_packet = packet->type() == RtpPacketToSend::Type::kAudio;
   bool apply_pacing = !audio_packet || pace_audio_;
-  if (apply_pacing && (Congested() || (media_budget_.bytes_remaining() == 0 &&
+  if (apply_pacing && (Congested() || (!HasMediaBudget() &&
                                        pacing_info.probe_cluster_id ==
                                            PacedPacketInfo::kNotAProbe))) {
-    packet_queue_.CancelPop();
+    packet_queue_->CancelPop();
     return nullptr;
   }
   return packet;
 }
 
 void PacingController::OnPacketSent(
-    RoundRobinPacketQueue::QueuedPacket* packet) {
+    PacerPacketQueue::QueuedPacket* packet) {
   Timestamp now = CurrentTime();
   if (!first_sent_packet_time_) {
     first_sent_packet_time_ = now;
@@ -438,7 +506,7 @@ void PacingController::OnPacketSent(
     last_send_time_ = now;
   }
   // Send succeeded, remove it from the queue.
-  packet_queue_.FinalizePop();
+  packet_queue_->FinalizePop();
   padding_failure_state_ = false;
 }
 
@@ -452,6 +520,8 @@ void PacingController::OnPaddingSent(DataSize data_sent) {
 }
 
 void PacingController::UpdateBudgetWithElapsedTime(TimeDelta delta) {
+  // The burst budget caps itself.
+  burst_budget_.IncreaseBudget(delta);
   delta = std::min(kMaxProcessingInterval, delta);
   media_budget_.IncreaseBudget(delta.ms());
   padding_budget_.IncreaseBudget(delta.ms());
@@ -460,9 +530,16 @@ void PacingController::UpdateBudgetWithElapsedTime(TimeDelta delta) {
 void PacingController::UpdateBudgetWithSentData(DataSize size) {
   outstanding_data_ += size;
   media_budget_.UseBudget(size.bytes());
+  burst_budget_.UseBudget(size);
   padding_budget_.UseBudget(size.bytes());
 }
 
+bool PacingController::HasMediaBudget() const {
+  if (!send_quantum_.IsZero())
+    return !burst_budget_.bytes_remaining().IsZero();
+  return media_budget_.bytes_remaining() > 0;
+}
+
 void PacingController::SetQueueTimeLimit(TimeDelta limit) {
   queue_time_limit = limit;
 }
@@ -25,8 +25,9 @@
 #include "api/transport/network_types.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/pacing/bitrate_prober.h"
+#include "modules/pacing/burst_budget.h"
 #include "modules/pacing/interval_budget.h"
-#include "modules/pacing/round_robin_packet_queue.h"
+#include "modules/pacing/pacer_packet_queue.h"
 #include "modules/pacing/rtp_packet_pacer.h"
 #include "modules/rtp_rtcp/include/rtp_packet_sender.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
@@ -92,6 +93,13 @@ class PacingController {
   // Sets the pacing rates. Must be called once before packets can be sent.
   void SetPacingRates(DataRate pacing_rate, DataRate padding_rate);
 
+  // With a non-zero |send_quantum|, media is paced with a token bucket rather
+  // than an interval budget: media budget that isn't used carries over, so
+  // that media can be sent in bursts of up to |send_quantum|, and the process
+  // interval shrinks at high pacing rates so that each burst goes out on
+  // time. This is how BBR expects its pacing rate to be applied.
+  void SetSendQuantum(DataSize send_quantum);
+
   // Currently audio traffic is not accounted by pacer and passed through.
   // With the introduction of audio BWE audio traffic will be accounted for
   // the pacer budget calculation. The audio traffic still will be injected
@@ -126,6 +134,7 @@ class PacingController {
   // Time since ProcessPackets() was last executed.
   TimeDelta TimeElapsedSinceLastProcess() const;
 
+  // Time until ProcessPackets() should be called to send more media.
   TimeDelta TimeUntilAvailableBudget() const;
 
   // Check queue of pending packets and send them or padding packets, if budget
@@ -141,13 +150,14 @@ class PacingController {
   // Updates the number of bytes that can be sent for the next time interval.
   void UpdateBudgetWithElapsedTime(TimeDelta delta);
   void UpdateBudgetWithSentData(DataSize size);
+  bool HasMediaBudget() const;
 
   DataSize PaddingToAdd(absl::optional<DataSize> recommended_probe_size,
                         DataSize data_sent);
 
-  RoundRobinPacketQueue::QueuedPacket* GetPendingPacket(
+  PacerPacketQueue::QueuedPacket* GetPendingPacket(
       const PacedPacketInfo& pacing_info);
-  void OnPacketSent(RoundRobinPacketQueue::QueuedPacket* packet);
+  void OnPacketSent(PacerPacketQueue::QueuedPacket* packet);
   void OnPaddingSent(DataSize padding_sent);
 
   Timestamp CurrentTime() const;
@@ -160,6 +170,9 @@ class PacingController {
   const bool drain_large_queues_;
   const bool send_padding_if_silent_;
   const bool pace_audio_;
+  // Mark the packets of each burst as batchable, so that the transport can
+  // send them with a single system call. See rtc::PacketOptions::batchable.
+  const bool send_batched_;
   TimeDelta min_packet_limit_;
 
   // TODO(webrtc:9716): Remove this when we are certain clocks are monotonic.
@@ -173,6 +186,9 @@ class PacingController {
   // allowed to send out during the current interval. This budget will be
   // utilized when there's no media to send.
   IntervalBudget padding_budget_;
+  // Replaces |media_budget_| when a send quantum is set.
+  DataSize send_quantum_;
+  BurstBudget burst_budget_;
 
   BitrateProber prober_;
   bool probing_send_failure_;
@@ -184,7 +200,7 @@ class PacingController {
   Timestamp last_send_time_;
   absl::optional<Timestamp> first_sent_packet_time_;
 
-  RoundRobinPacketQueue packet_queue_;
+  const std::unique_ptr<PacerPacketQueue> packet_queue_;
   uint64_t packet_counter_;
 
   DataSize congestion_window_size_;
@@ -25,6 +25,7 @@
 #include "test/gtest.h"
 
 using ::testing::_;
+using ::testing::AnyNumber;
 using ::testing::Field;
 using ::testing::Pointee;
 using ::testing::Property;
@@ -237,9 +238,7 @@ class PacingControllerTest : public ::testing::Test {
   }
 
   TimeDelta TimeUntilNextProcess() {
-    // TODO(bugs.webrtc.org/10809): Replace this with TimeUntilAvailableBudget()
-    // once ported from WIP code. For now, emulate PacedSender method.
-
+    // Emulate PacedSender::TimeUntilNextProcess().
     TimeDelta elapsed_time = pacer_->TimeElapsedSinceLastProcess();
     if (pacer_->IsPaused()) {
       return std::max(PacingController::kPausedProcessInterval - elapsed_time,
@@ -251,8 +250,7 @@ class PacingControllerTest : public ::testing::Test {
       return *next_probe;
     }
 
-    const TimeDelta min_packet_limit = TimeDelta::ms(5);
-    return std::max(min_packet_limit - elapsed_time, TimeDelta::Zero());
+    return pacer_->TimeUntilAvailableBudget();
   }
 
   SimulatedClock clock_;
@@ -396,6 +394,41 @@ TEST_F(PacingControllerFieldTrialTest, BudgetDoesNotAffectAudioInTrial) {
   ProcessNext(&pacer);
 }
 
+TEST_F(PacingControllerFieldTrialTest, BatchedSendMarksEndOfBurst) {
+  ScopedFieldTrials trial("WebRTC-Pacer-BatchedSend/Enabled/");
+  MockPacketSender callback;
+  PacingController pacer(&clock_, &callback, nullptr, nullptr);
+  pacer.SetPacingRates(DataRate::bps(10000000), DataRate::Zero());
+  for (int i = 0; i < 3; ++i) {
+    InsertPacket(&pacer, &video);
+  }
+
+  std::vector<bool> last_in_batch;
+  EXPECT_CALL(callback, SendRtpPacket)
+      .Times(3)
+      .WillRepeatedly([&](const std::unique_ptr<RtpPacketToSend>& packet,
+                          const PacedPacketInfo& cluster_info) {
+        EXPECT_TRUE(packet->is_batchable());
+        last_in_batch.push_back(packet->is_last_in_batch());
+      });
+  ProcessNext(&pacer);
+  EXPECT_THAT(last_in_batch, ::testing::ElementsAre(false, false, true));
+}
+
+TEST_F(PacingControllerFieldTrialTest, DefaultPacketsNotBatchable) {
+  MockPacketSender callback;
+  PacingController pacer(&clock_, &callback, nullptr, nullptr);
+  pacer.SetPacingRates(DataRate::bps(10000000), DataRate::Zero());
+  InsertPacket(&pacer, &video);
+  InsertPacket(&pacer, &video);
+  EXPECT_CALL(callback, SendRtpPacket(
+                            Pointee(Property(&RtpPacketToSend::is_batchable,
+                                             false)),
+                            _))
+      .Times(2);
+  ProcessNext(&pacer);
+}
+
 TEST_F(PacingControllerTest, FirstSentPacketTimeIsSet) {
   uint16_t sequence_number = 1234;
   const uint32_t kSsrc = 12345;
@@ -415,6 +448,39 @@ TEST_F(PacingControllerTest, FirstSentPacketTimeIsSet) {
   EXPECT_EQ(kStartTime, pacer_->FirstSentPacketTime());
 }
 
+TEST_F(PacingControllerTest, SendQuantumReachesHighPacingRate) {
+  const DataRate kPacingRate = DataRate::kbps(50000);
+  const DataSize kSendQuantum = kPacingRate * TimeDelta::ms(1);
+  const size_t kPacketSize = 1200;
+  pacer_->SetPacingRates(kPacingRate, DataRate::Zero());
+  pacer_->SetSendQuantum(kSendQuantum);
+  EXPECT_CALL(callback_, SendPacket).Times(AnyNumber());
+
+  uint16_t sequence_number = 0;
+  DataSize data_sent = DataSize::Zero();
+  const Timestamp start_time = clock_.CurrentTime();
+  while (clock_.CurrentTime() - start_time < TimeDelta::seconds(1)) {
+    // Keep the queue short, so that it isn't drained faster than the pacing
+    // rate.
+    while (pacer_->QueueSizePackets() < 50) {
+      Send(RtpPacketToSend::Type::kVideo, kVideoSsrc, sequence_number++,
+           clock_.TimeInMilliseconds(), kPacketSize);
+    }
+    TimeDelta time_until_process = TimeUntilNextProcess();
+    // The next burst is due once a quantum has accrued, which takes a
+    // millisecond plus paying back the overshoot of the last burst.
+    EXPECT_LE(time_until_process, TimeDelta::ms(2));
+    clock_.AdvanceTime(time_until_process);
+    DataSize queue_size = pacer_->QueueSizeData();
+    pacer_->ProcessPackets();
+    DataSize burst_size = queue_size - pacer_->QueueSizeData();
+    EXPECT_LE(burst_size, kSendQuantum * 2 + DataSize::bytes(kPacketSize));
+    data_sent += burst_size;
+  }
+  DataRate send_rate = data_sent / (clock_.CurrentTime() - start_time);
+  EXPECT_NEAR(kPacingRate.kbps(), send_rate.kbps(), kPacingRate.kbps() / 50);
+}
+
 TEST_F(PacingControllerTest, QueuePacket) {
   uint32_t ssrc = 12345;
   uint16_t sequence_number = 1234;
@@ -1142,6 +1208,43 @@ TEST_F(PacingControllerTest, ProbingWithPaddingSupport) {
               kFirstClusterRate.bps(), kProbingErrorMargin.bps());
 }
 
+TEST_F(PacingControllerTest, ProbingWaitsForQueuedMediaInTrial) {
+  ScopedFieldTrials trial("WebRTC-Bwe-ProbingBehavior/media_wait:100ms/");
+  const size_t kPacketSize = 1200;
+  const int kInitialBitrateBps = 300000;
+  uint32_t ssrc = 12346;
+  uint16_t sequence_number = 1234;
+
+  PacingControllerProbing packet_sender;
+  pacer_ = std::make_unique<PacingController>(&clock_, &packet_sender, nullptr,
+                                              nullptr);
+  pacer_->CreateProbeCluster(kFirstClusterRate,
+                             /*cluster_id=*/0);
+  pacer_->SetPacingRates(DataRate::bps(kInitialBitrateBps * kPaceMultiplier),
+                         DataRate::Zero());
+
+  // A single packet isn't enough to probe with, and is sent as usual.
+  Send(RtpPacketToSend::Type::kVideo, ssrc, sequence_number++,
+       clock_.TimeInMilliseconds(), kPacketSize);
+  clock_.AdvanceTime(TimeUntilNextProcess());
+  pacer_->ProcessPackets();
+  EXPECT_EQ(1, packet_sender.packets_sent());
+
+  // The next frame is enough for the whole cluster.
+  for (int i = 0; i < 5; ++i) {
+    Send(RtpPacketToSend::Type::kVideo, ssrc, sequence_number++,
+         clock_.TimeInMilliseconds(), kPacketSize);
+  }
+  int64_t start = clock_.TimeInMilliseconds();
+  while (packet_sender.packets_sent() < 6) {
+    clock_.AdvanceTime(TimeUntilNextProcess());
+    pacer_->ProcessPackets();
+  }
+  EXPECT_NEAR(4 * kPacketSize * 8000 / (clock_.TimeInMilliseconds() - start),
+              kFirstClusterRate.bps(), kProbingErrorMargin.bps());
+  EXPECT_EQ(0, packet_sender.padding_sent());
+}
+
 TEST_F(PacingControllerTest, PaddingOveruse) {
   uint32_t ssrc = 12346;
   uint16_t sequence_number = 1234;
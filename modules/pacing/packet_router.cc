@@ -303,6 +303,21 @@ void PacketRouter::SendNetworkStateEstimatePacket(
   }
 }
 
+void PacketRouter::SendEcnFeedback(rtcp::EcnFeedback* packet) {
+  rtc::CritScope cs(&modules_crit_);
+  // Prefer send modules, like for transport feedback.
+  for (auto* rtp_module : rtp_send_modules_) {
+    packet->SetSenderSsrc(rtp_module->SSRC());
+    if (rtp_module->SendEcnFeedbackPacket(*packet))
+      return;
+  }
+  for (auto* rtcp_sender : rtcp_feedback_senders_) {
+    packet->SetSenderSsrc(rtcp_sender->SSRC());
+    if (rtcp_sender->SendEcnFeedbackPacket(*packet))
+      return;
+  }
+}
+
 void PacketRouter::AddRembModuleCandidate(
     RtcpFeedbackSenderInterface* candidate_module,
     bool media_sender) {
@@ -80,6 +80,8 @@ class PacketRouter : public RemoteBitrateObserver,
   bool SendTransportFeedback(rtcp::TransportFeedback* packet) override;
   // Send RemoteEstimate packet to send-side.
   void SendNetworkStateEstimatePacket(rtcp::RemoteEstimate* packet) override;
+  // Send ECN feedback packet to send-side.
+  void SendEcnFeedback(rtcp::EcnFeedback* packet) override;
 
  private:
   RtpRtcp* FindRtpModule(uint32_t ssrc)
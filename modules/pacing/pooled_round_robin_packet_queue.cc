@@ -0,0 +1,390 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/pooled_round_robin_packet_queue.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+// Must match the leading size limit of RoundRobinPacketQueue.
+constexpr DataSize kMaxLeadingSize = DataSize::Bytes<1400>();
+
+bool IsFieldTrialEnabled(const WebRtcKeyValueConfig* field_trials,
+                         const char* name) {
+  if (!field_trials) {
+    return false;
+  }
+  return field_trials->Lookup(name).find("Enabled") == 0;
+}
+}  // namespace
+
+constexpr size_t PooledRoundRobinPacketQueue::kNotInHeap;
+
+PooledRoundRobinPacketQueue::Node::Node() = default;
+PooledRoundRobinPacketQueue::Node::~Node() = default;
+
+RtpPacketToSend::Type PooledRoundRobinPacketQueue::Node::type() const {
+  return packet_type;
+}
+
+DataSize PooledRoundRobinPacketQueue::Node::size() const {
+  return packet_size;
+}
+
+std::unique_ptr<RtpPacketToSend>
+PooledRoundRobinPacketQueue::Node::ReleasePacket() {
+  return std::move(packet);
+}
+
+PooledRoundRobinPacketQueue::Stream::Stream() = default;
+PooledRoundRobinPacketQueue::Stream::Stream(Stream&&) = default;
+PooledRoundRobinPacketQueue::Stream& PooledRoundRobinPacketQueue::Stream::
+operator=(Stream&&) = default;
+PooledRoundRobinPacketQueue::Stream::~Stream() = default;
+
+PooledRoundRobinPacketQueue::PooledRoundRobinPacketQueue(
+    Timestamp start_time,
+    const WebRtcKeyValueConfig* field_trials)
+    : time_last_updated_(start_time),
+      paused_(false),
+      size_packets_(0),
+      size_(DataSize::Zero()),
+      max_size_(kMaxLeadingSize),
+      queue_time_sum_(TimeDelta::Zero()),
+      pause_time_sum_(TimeDelta::Zero()),
+      schedule_counter_(0),
+      send_side_bwe_with_overhead_(IsFieldTrialEnabled(
+          field_trials,
+          "WebRTC-SendSideBwe-WithOverhead")) {}
+
+PooledRoundRobinPacketQueue::~PooledRoundRobinPacketQueue() = default;
+
+void PooledRoundRobinPacketQueue::Push(
+    int priority,
+    Timestamp enqueue_time,
+    uint64_t enqueue_order,
+    std::unique_ptr<RtpPacketToSend> packet) {
+  RTC_DCHECK(packet->packet_type().has_value());
+  size_t node_index;
+  if (free_nodes_.empty()) {
+    node_index = nodes_.size();
+    nodes_.emplace_back();
+  } else {
+    node_index = free_nodes_.back();
+    free_nodes_.pop_back();
+  }
+  Node& node = nodes_[node_index];
+  node.priority = priority;
+  node.packet_type = *packet->packet_type();
+  node.retransmission =
+      node.packet_type == RtpPacketToSend::Type::kRetransmission;
+  node.enqueue_order = enqueue_order;
+  node.original_enqueue_time = enqueue_time;
+  node.packet_size =
+      DataSize::bytes(send_side_bwe_with_overhead_
+                          ? packet->size()
+                          : packet->payload_size() + packet->padding_size());
+  node.stream_index = GetOrCreateStream(packet->Ssrc());
+  node.packet = std::move(packet);
+
+  Stream* stream = &streams_[node.stream_index];
+  if (stream->stream_heap_index == kNotInHeap) {
+    ScheduleStream(node.stream_index, priority);
+  } else if (priority < stream->scheduled_priority) {
+    // The priority of this SSRC increased, note that lower ordinal means
+    // higher priority.
+    UnscheduleStream(node.stream_index);
+    ScheduleStream(node.stream_index, priority);
+  }
+
+  // See RoundRobinPacketQueue::Push() for how the pause time is accounted.
+  UpdateQueueTime(enqueue_time);
+  node.enqueue_time = enqueue_time - pause_time_sum_;
+
+  size_packets_ += 1;
+  size_ += node.packet_size;
+
+  node.enqueue_time_heap_index = enqueue_time_heap_.size();
+  enqueue_time_heap_.push_back(node_index);
+  EnqueueTimeHeapSiftUp(node.enqueue_time_heap_index);
+
+  PushPacketToStream(stream, node_index);
+}
+
+PacerPacketQueue::QueuedPacket* PooledRoundRobinPacketQueue::BeginPop() {
+  RTC_CHECK_EQ(pop_node_, kNotInHeap);
+  RTC_CHECK(!stream_heap_.empty());
+  Stream* stream = &streams_[stream_heap_.front()];
+  pop_node_ = PopPacketFromStream(stream);
+  return &nodes_[pop_node_];
+}
+
+void PooledRoundRobinPacketQueue::CancelPop() {
+  RTC_CHECK_NE(pop_node_, kNotInHeap);
+  PushPacketToStream(&streams_[nodes_[pop_node_].stream_index], pop_node_);
+  pop_node_ = kNotInHeap;
+}
+
+void PooledRoundRobinPacketQueue::FinalizePop() {
+  if (Empty())
+    return;
+  RTC_CHECK_NE(pop_node_, kNotInHeap);
+  Node& node = nodes_[pop_node_];
+  const size_t stream_index = node.stream_index;
+  Stream* stream = &streams_[stream_index];
+  UnscheduleStream(stream_index);
+
+  TimeDelta time_in_non_paused_state =
+      time_last_updated_ - node.enqueue_time - pause_time_sum_;
+  queue_time_sum_ -= time_in_non_paused_state;
+
+  RTC_CHECK_NE(node.enqueue_time_heap_index, kNotInHeap);
+  EnqueueTimeHeapRemove(node.enqueue_time_heap_index);
+
+  // Same budget limiting as in RoundRobinPacketQueue::FinalizePop().
+  stream->size =
+      std::max(stream->size + node.packet_size, max_size_ - kMaxLeadingSize);
+  max_size_ = std::max(max_size_, stream->size);
+
+  size_ -= node.packet_size;
+  size_packets_ -= 1;
+  RTC_CHECK(size_packets_ > 0 || queue_time_sum_ == TimeDelta::Zero());
+
+  // If there are packets left to be sent, schedule the stream again.
+  if (!stream->packet_heap.empty()) {
+    ScheduleStream(stream_index, nodes_[stream->packet_heap.front()].priority);
+  }
+
+  node.packet.reset();
+  free_nodes_.push_back(pop_node_);
+  pop_node_ = kNotInHeap;
+}
+
+bool PooledRoundRobinPacketQueue::Empty() const {
+  RTC_CHECK((!stream_heap_.empty() && size_packets_ > 0) ||
+            (stream_heap_.empty() && size_packets_ == 0));
+  return stream_heap_.empty();
+}
+
+size_t PooledRoundRobinPacketQueue::SizeInPackets() const {
+  return size_packets_;
+}
+
+DataSize PooledRoundRobinPacketQueue::Size() const {
+  return size_;
+}
+
+Timestamp PooledRoundRobinPacketQueue::OldestEnqueueTime() const {
+  if (Empty())
+    return Timestamp::MinusInfinity();
+  RTC_CHECK(!enqueue_time_heap_.empty());
+  return nodes_[enqueue_time_heap_.front()].original_enqueue_time;
+}
+
+void PooledRoundRobinPacketQueue::UpdateQueueTime(Timestamp now) {
+  RTC_CHECK_GE(now, time_last_updated_);
+  if (now == time_last_updated_)
+    return;
+
+  TimeDelta delta = now - time_last_updated_;
+
+  if (paused_) {
+    pause_time_sum_ += delta;
+  } else {
+    queue_time_sum_ += TimeDelta::us(delta.us() * size_packets_);
+  }
+
+  time_last_updated_ = now;
+}
+
+void PooledRoundRobinPacketQueue::SetPauseState(bool paused, Timestamp now) {
+  if (paused_ == paused)
+    return;
+  UpdateQueueTime(now);
+  paused_ = paused;
+}
+
+TimeDelta PooledRoundRobinPacketQueue::AverageQueueTime() const {
+  if (Empty())
+    return TimeDelta::Zero();
+  return queue_time_sum_ / size_packets_;
+}
+
+bool PooledRoundRobinPacketQueue::PacketBefore(size_t a, size_t b) const {
+  const Node& first = nodes_[a];
+  const Node& second = nodes_[b];
+  if (first.priority != second.priority)
+    return first.priority < second.priority;
+  if (first.retransmission != second.retransmission)
+    return first.retransmission;
+  return first.enqueue_order < second.enqueue_order;
+}
+
+bool PooledRoundRobinPacketQueue::StreamBefore(size_t a, size_t b) const {
+  const Stream& first = streams_[a];
+  const Stream& second = streams_[b];
+  if (first.scheduled_priority != second.scheduled_priority)
+    return first.scheduled_priority < second.scheduled_priority;
+  if (first.scheduled_size != second.scheduled_size)
+    return first.scheduled_size < second.scheduled_size;
+  // Streams with equal keys are served in the order they were scheduled.
+  return first.schedule_order < second.schedule_order;
+}
+
+size_t PooledRoundRobinPacketQueue::GetOrCreateStream(uint32_t ssrc) {
+  auto it = std::lower_bound(
+      stream_index_.begin(), stream_index_.end(), ssrc,
+      [](const std::pair<uint32_t, size_t>& entry, uint32_t ssrc) {
+        return entry.first < ssrc;
+      });
+  if (it != stream_index_.end() && it->first == ssrc)
+    return it->second;
+
+  size_t stream_index = streams_.size();
+  streams_.emplace_back();
+  streams_.back().ssrc = ssrc;
+  stream_index_.insert(it, std::make_pair(ssrc, stream_index));
+  return stream_index;
+}
+
+void PooledRoundRobinPacketQueue::ScheduleStream(size_t stream_index,
+                                                 int priority) {
+  Stream& stream = streams_[stream_index];
+  RTC_CHECK_EQ(stream.stream_heap_index, kNotInHeap);
+  stream.scheduled_priority = priority;
+  stream.scheduled_size = stream.size;
+  stream.schedule_order = schedule_counter_++;
+  stream.stream_heap_index = stream_heap_.size();
+  stream_heap_.push_back(stream_index);
+  StreamHeapSiftUp(stream.stream_heap_index);
+}
+
+void PooledRoundRobinPacketQueue::UnscheduleStream(size_t stream_index) {
+  size_t pos = streams_[stream_index].stream_heap_index;
+  RTC_CHECK_NE(pos, kNotInHeap);
+  size_t last = stream_heap_.size() - 1;
+  if (pos != last)
+    StreamHeapSwap(pos, last);
+  stream_heap_.pop_back();
+  streams_[stream_index].stream_heap_index = kNotInHeap;
+  if (pos < stream_heap_.size()) {
+    StreamHeapSiftDown(pos);
+    StreamHeapSiftUp(pos);
+  }
+}
+
+void PooledRoundRobinPacketQueue::PushPacketToStream(Stream* stream,
+                                                     size_t node_index) {
+  stream->packet_heap.push_back(node_index);
+  std::push_heap(stream->packet_heap.begin(), stream->packet_heap.end(),
+                 [this](size_t a, size_t b) { return PacketBefore(b, a); });
+}
+
+size_t PooledRoundRobinPacketQueue::PopPacketFromStream(Stream* stream) {
+  RTC_CHECK(!stream->packet_heap.empty());
+  std::pop_heap(stream->packet_heap.begin(), stream->packet_heap.end(),
+                [this](size_t a, size_t b) { return PacketBefore(b, a); });
+  size_t node_index = stream->packet_heap.back();
+  stream->packet_heap.pop_back();
+  return node_index;
+}
+
+void PooledRoundRobinPacketQueue::StreamHeapSiftUp(size_t pos) {
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (!StreamBefore(stream_heap_[pos], stream_heap_[parent]))
+      break;
+    StreamHeapSwap(pos, parent);
+    pos = parent;
+  }
+}
+
+void PooledRoundRobinPacketQueue::StreamHeapSiftDown(size_t pos) {
+  const size_t size = stream_heap_.size();
+  while (true) {
+    size_t best = pos;
+    size_t left = 2 * pos + 1;
+    size_t right = left + 1;
+    if (left < size && StreamBefore(stream_heap_[left], stream_heap_[best]))
+      best = left;
+    if (right < size && StreamBefore(stream_heap_[right], stream_heap_[best]))
+      best = right;
+    if (best == pos)
+      break;
+    StreamHeapSwap(pos, best);
+    pos = best;
+  }
+}
+
+void PooledRoundRobinPacketQueue::StreamHeapSwap(size_t a, size_t b) {
+  std::swap(stream_heap_[a], stream_heap_[b]);
+  streams_[stream_heap_[a]].stream_heap_index = a;
+  streams_[stream_heap_[b]].stream_heap_index = b;
+}
+
+void PooledRoundRobinPacketQueue::EnqueueTimeHeapSiftUp(size_t pos) {
+  while (pos > 0) {
+    size_t parent = (pos - 1) / 2;
+    if (nodes_[enqueue_time_heap_[pos]].original_enqueue_time >=
+        nodes_[enqueue_time_heap_[parent]].original_enqueue_time) {
+      break;
+    }
+    EnqueueTimeHeapSwap(pos, parent);
+    pos = parent;
+  }
+}
+
+void PooledRoundRobinPacketQueue::EnqueueTimeHeapSiftDown(size_t pos) {
+  const size_t size = enqueue_time_heap_.size();
+  while (true) {
+    size_t best = pos;
+    size_t left = 2 * pos + 1;
+    size_t right = left + 1;
+    if (left < size &&
+        nodes_[enqueue_time_heap_[left]].original_enqueue_time <
+            nodes_[enqueue_time_heap_[best]].original_enqueue_time) {
+      best = left;
+    }
+    if (right < size &&
+        nodes_[enqueue_time_heap_[right]].original_enqueue_time <
+            nodes_[enqueue_time_heap_[best]].original_enqueue_time) {
+      best = right;
+    }
+    if (best == pos)
+      break;
+    EnqueueTimeHeapSwap(pos, best);
+    pos = best;
+  }
+}
+
+void PooledRoundRobinPacketQueue::EnqueueTimeHeapSwap(size_t a, size_t b) {
+  std::swap(enqueue_time_heap_[a], enqueue_time_heap_[b]);
+  nodes_[enqueue_time_heap_[a]].enqueue_time_heap_index = a;
+  nodes_[enqueue_time_heap_[b]].enqueue_time_heap_index = b;
+}
+
+void PooledRoundRobinPacketQueue::EnqueueTimeHeapRemove(size_t pos) {
+  size_t node_index = enqueue_time_heap_[pos];
+  size_t last = enqueue_time_heap_.size() - 1;
+  if (pos != last)
+    EnqueueTimeHeapSwap(pos, last);
+  enqueue_time_heap_.pop_back();
+  nodes_[node_index].enqueue_time_heap_index = kNotInHeap;
+  if (pos < enqueue_time_heap_.size()) {
+    EnqueueTimeHeapSiftDown(pos);
+    EnqueueTimeHeapSiftUp(pos);
+  }
+}
+
+}  // namespace webrtc
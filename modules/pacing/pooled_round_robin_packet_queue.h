@@ -0,0 +1,160 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_PACING_POOLED_ROUND_ROBIN_PACKET_QUEUE_H_
+#define MODULES_PACING_POOLED_ROUND_ROBIN_PACKET_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/transport/webrtc_key_value_config.h"
+#include "api/units/data_size.h"
+#include "api/units/time_delta.h"
+#include "api/units/timestamp.h"
+#include "modules/pacing/pacer_packet_queue.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+
+namespace webrtc {
+
+// Same scheduling as RoundRobinPacketQueue, but without per-packet heap
+// allocations once the queue has warmed up: packets live in a pool of reusable
+// nodes, streams are kept in a flat vector indexed by a sorted SSRC table, and
+// the stream priority order and the enqueue times are tracked with intrusive
+// binary heaps instead of std::multimap/std::multiset.
+class PooledRoundRobinPacketQueue : public PacerPacketQueue {
+ public:
+  PooledRoundRobinPacketQueue(Timestamp start_time,
+                              const WebRtcKeyValueConfig* field_trials);
+  ~PooledRoundRobinPacketQueue() override;
+
+  void Push(int priority,
+            Timestamp enqueue_time,
+            uint64_t enqueue_order,
+            std::unique_ptr<RtpPacketToSend> packet) override;
+  QueuedPacket* BeginPop() override;
+  void CancelPop() override;
+  void FinalizePop() override;
+
+  bool Empty() const override;
+  size_t SizeInPackets() const override;
+  DataSize Size() const override;
+
+  Timestamp OldestEnqueueTime() const override;
+  TimeDelta AverageQueueTime() const override;
+  void UpdateQueueTime(Timestamp now) override;
+  void SetPauseState(bool paused, Timestamp now) override;
+
+ private:
+  static constexpr size_t kNotInHeap = static_cast<size_t>(-1);
+
+  struct Node : public PacerPacketQueue::QueuedPacket {
+    Node();
+    ~Node();
+
+    RtpPacketToSend::Type type() const override;
+    DataSize size() const override;
+    std::unique_ptr<RtpPacketToSend> ReleasePacket() override;
+
+    int priority = 0;
+    RtpPacketToSend::Type packet_type = RtpPacketToSend::Type::kVideo;
+    bool retransmission = false;
+    uint64_t enqueue_order = 0;
+    // Absolute time of pacer queue entry, minus the time the queue had been
+    // paused when the packet was pushed.
+    Timestamp enqueue_time = Timestamp::MinusInfinity();
+    // Absolute time of pacer queue entry, as reported by OldestEnqueueTime().
+    Timestamp original_enqueue_time = Timestamp::MinusInfinity();
+    DataSize packet_size = DataSize::Zero();
+    size_t stream_index = 0;
+    // Position in |enqueue_time_heap_|.
+    size_t enqueue_time_heap_index = kNotInHeap;
+    std::unique_ptr<RtpPacketToSend> packet;
+  };
+
+  struct Stream {
+    Stream();
+    Stream(Stream&&);
+    Stream& operator=(Stream&&);
+    ~Stream();
+
+    uint32_t ssrc = 0;
+    DataSize size = DataSize::Zero();
+    // Heap of indices into |nodes_|, ordered by PacketBefore().
+    std::vector<size_t> packet_heap;
+
+    // Scheduling key while the stream is in |stream_heap_|.
+    int scheduled_priority = 0;
+    DataSize scheduled_size = DataSize::Zero();
+    uint64_t schedule_order = 0;
+    size_t stream_heap_index = kNotInHeap;
+  };
+
+  bool PacketBefore(size_t a, size_t b) const;
+  bool StreamBefore(size_t a, size_t b) const;
+
+  size_t GetOrCreateStream(uint32_t ssrc);
+  void ScheduleStream(size_t stream_index, int priority);
+  void UnscheduleStream(size_t stream_index);
+
+  void PushPacketToStream(Stream* stream, size_t node_index);
+  size_t PopPacketFromStream(Stream* stream);
+
+  // Intrusive heap helpers for |stream_heap_|.
+  void StreamHeapSiftUp(size_t pos);
+  void StreamHeapSiftDown(size_t pos);
+  void StreamHeapSwap(size_t a, size_t b);
+
+  // Intrusive heap helpers for |enqueue_time_heap_|.
+  void EnqueueTimeHeapSiftUp(size_t pos);
+  void EnqueueTimeHeapSiftDown(size_t pos);
+  void EnqueueTimeHeapSwap(size_t a, size_t b);
+  void EnqueueTimeHeapRemove(size_t pos);
+
+  Timestamp time_last_updated_;
+  // Index into |nodes_| of the packet between BeginPop() and FinalizePop().
+  size_t pop_node_ = kNotInHeap;
+
+  bool paused_;
+  size_t size_packets_;
+  DataSize size_;
+  DataSize max_size_;
+  TimeDelta queue_time_sum_;
+  TimeDelta pause_time_sum_;
+  uint64_t schedule_counter_;
+
+  // Packet nodes. A deque is used so that pointers handed out by BeginPop()
+  // stay valid if the pool grows. Unused nodes are listed in |free_nodes_|.
+  std::deque<Node> nodes_;
+  std::vector<size_t> free_nodes_;
+
+  // All streams seen so far, and a table of (ssrc, index into |streams_|)
+  // sorted by SSRC for lookups.
+  std::vector<Stream> streams_;
+  std::vector<std::pair<uint32_t, size_t>> stream_index_;
+
+  // Min-heap of indices into |streams_| of the streams that have packets
+  // queued, ordered by StreamBefore().
+  std::vector<size_t> stream_heap_;
+
+  // Min-heap of indices into |nodes_| of all queued packets, ordered by the
+  // original enqueue time.
+  std::vector<size_t> enqueue_time_heap_;
+
+  const bool send_side_bwe_with_overhead_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_PACING_POOLED_ROUND_ROBIN_PACKET_QUEUE_H_
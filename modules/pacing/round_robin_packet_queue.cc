@@ -50,6 +50,14 @@ RoundRobinPacketQueue::QueuedPacket::QueuedPacket(
       enqueue_time_it_(enqueue_time_it),
       packet_it_(packet_it) {}
 
+RtpPacketToSend::Type RoundRobinPacketQueue::QueuedPacket::type() const {
+  return type_;
+}
+
+DataSize RoundRobinPacketQueue::QueuedPacket::size() const {
+  return size_;
+}
+
 std::unique_ptr<RtpPacketToSend>
 RoundRobinPacketQueue::QueuedPacket::ReleasePacket() {
   return packet_it_ ? std::move(**packet_it_) : nullptr;
@@ -25,19 +25,20 @@
 #include "api/units/data_size.h"
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
+#include "modules/pacing/pacer_packet_queue.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
 
-class RoundRobinPacketQueue {
+class RoundRobinPacketQueue : public PacerPacketQueue {
  public:
   RoundRobinPacketQueue(Timestamp start_time,
                         const WebRtcKeyValueConfig* field_trials);
-  ~RoundRobinPacketQueue();
+  ~RoundRobinPacketQueue() override;
 
-  struct QueuedPacket {
+  struct QueuedPacket : public PacerPacketQueue::QueuedPacket {
    public:
     QueuedPacket(
         int priority,
@@ -58,15 +59,15 @@ class RoundRobinPacketQueue {
     bool operator<(const QueuedPacket& other) const;
 
     int priority() const { return priority_; }
-    RtpPacketToSend::Type type() const { return type_; }
+    RtpPacketToSend::Type type() const override;
     uint32_t ssrc() const { return ssrc_; }
     uint16_t sequence_number() const { return sequence_number_; }
     int64_t capture_time_ms() const { return capture_time_ms_; }
     Timestamp enqueue_time() const { return enqueue_time_; }
-    DataSize size() const { return size_; }
+    DataSize size() const override;
     bool is_retransmission() const { return retransmission_; }
     uint64_t enqueue_order() const { return enqueue_order_; }
-    std::unique_ptr<RtpPacketToSend> ReleasePacket();
+    std::unique_ptr<RtpPacketToSend> ReleasePacket() override;
 
     // For internal use.
     absl::optional<std::list<std::unique_ptr<RtpPacketToSend>>::iterator>
@@ -107,19 +108,19 @@ class RoundRobinPacketQueue {
   void Push(int priority,
             Timestamp enqueue_time,
             uint64_t enqueue_order,
-            std::unique_ptr<RtpPacketToSend> packet);
-  QueuedPacket* BeginPop();
-  void CancelPop();
-  void FinalizePop();
-
-  bool Empty() const;
-  size_t SizeInPackets() const;
-  DataSize Size() const;
-
-  Timestamp OldestEnqueueTime() const;
-  TimeDelta AverageQueueTime() const;
-  void UpdateQueueTime(Timestamp now);
-  void SetPauseState(bool paused, Timestamp now);
+            std::unique_ptr<RtpPacketToSend> packet) override;
+  QueuedPacket* BeginPop() override;
+  void CancelPop() override;
+  void FinalizePop() override;
+
+  bool Empty() const override;
+  size_t SizeInPackets() const override;
+  DataSize Size() const override;
+
+  Timestamp OldestEnqueueTime() const override;
+  TimeDelta AverageQueueTime() const override;
+  void UpdateQueueTime(Timestamp now) override;
+  void SetPauseState(bool paused, Timestamp now) override;
 
  private:
   struct StreamPrioKey {
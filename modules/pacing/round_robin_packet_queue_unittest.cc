@@ -0,0 +1,260 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/pacing/round_robin_packet_queue.h"
+
+#include <memory>
+#include <tuple>
+#include <utility>
+
+#include "modules/pacing/pooled_round_robin_packet_queue.h"
+#include "rtc_base/arraysize.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kAudioSsrc = 1111;
+constexpr uint32_t kVideoSsrcs[] = {2222, 3333, 4444};
+
+std::unique_ptr<RtpPacketToSend> BuildPacket(RtpPacketToSend::Type type,
+                                             uint32_t ssrc,
+                                             uint16_t sequence_number,
+                                             size_t size) {
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+  packet->set_packet_type(type);
+  packet->SetSsrc(ssrc);
+  packet->SetSequenceNumber(sequence_number);
+  packet->SetPayloadSize(size);
+  return packet;
+}
+
+std::unique_ptr<PacerPacketQueue> CreateQueue(bool pooled, Timestamp now) {
+  if (pooled)
+    return std::make_unique<PooledRoundRobinPacketQueue>(now, nullptr);
+  return std::make_unique<RoundRobinPacketQueue>(now, nullptr);
+}
+
+struct PoppedPacket {
+  uint32_t ssrc;
+  uint16_t sequence_number;
+
+  bool operator==(const PoppedPacket& other) const {
+    return ssrc == other.ssrc && sequence_number == other.sequence_number;
+  }
+};
+
+PoppedPacket PopPacket(PacerPacketQueue* queue) {
+  PacerPacketQueue::QueuedPacket* queued = queue->BeginPop();
+  std::unique_ptr<RtpPacketToSend> packet = queued->ReleasePacket();
+  queue->FinalizePop();
+  return {packet->Ssrc(), packet->SequenceNumber()};
+}
+
+void PushPacket(PacerPacketQueue* queue,
+                Timestamp now,
+                uint64_t* enqueue_order,
+                std::unique_ptr<RtpPacketToSend> packet) {
+  int priority = packet->packet_type() == RtpPacketToSend::Type::kAudio ? 0 : 2;
+  queue->Push(priority, now, (*enqueue_order)++, std::move(packet));
+}
+
+// Pushes |num_packets| video packets spread over the video SSRCs.
+void FillQueue(PacerPacketQueue* queue,
+               size_t num_packets,
+               Timestamp now,
+               uint64_t* enqueue_order) {
+  for (size_t i = 0; i < num_packets; ++i) {
+    PushPacket(queue, now, enqueue_order,
+               BuildPacket(RtpPacketToSend::Type::kVideo,
+                           kVideoSsrcs[i % arraysize(kVideoSsrcs)],
+                           static_cast<uint16_t>(i), 1000));
+  }
+}
+
+}  // namespace
+
+class RoundRobinPacketQueueTest : public ::testing::TestWithParam<bool> {
+ protected:
+  RoundRobinPacketQueueTest()
+      : now_(Timestamp::ms(1000)), queue_(CreateQueue(GetParam(), now_)) {}
+
+  Timestamp now_;
+  uint64_t enqueue_order_ = 0;
+  std::unique_ptr<PacerPacketQueue> queue_;
+};
+
+INSTANTIATE_TEST_SUITE_P(PooledAndLegacy,
+                         RoundRobinPacketQueueTest,
+                         ::testing::Bool());
+
+TEST_P(RoundRobinPacketQueueTest, EmptyQueue) {
+  EXPECT_TRUE(queue_->Empty());
+  EXPECT_EQ(0u, queue_->SizeInPackets());
+  EXPECT_EQ(DataSize::Zero(), queue_->Size());
+  EXPECT_EQ(Timestamp::MinusInfinity(), queue_->OldestEnqueueTime());
+}
+
+TEST_P(RoundRobinPacketQueueTest, HigherPriorityPacketPoppedFirst) {
+  PushPacket(queue_.get(), now_, &enqueue_order_,
+             BuildPacket(RtpPacketToSend::Type::kVideo, kVideoSsrcs[0], 1,
+                         1000));
+  PushPacket(queue_.get(), now_, &enqueue_order_,
+             BuildPacket(RtpPacketToSend::Type::kAudio, kAudioSsrc, 2, 100));
+  EXPECT_EQ(2u, queue_->SizeInPackets());
+  EXPECT_EQ(DataSize::bytes(1100), queue_->Size());
+
+  EXPECT_EQ(kAudioSsrc, PopPacket(queue_.get()).ssrc);
+  EXPECT_EQ(kVideoSsrcs[0], PopPacket(queue_.get()).ssrc);
+  EXPECT_TRUE(queue_->Empty());
+}
+
+TEST_P(RoundRobinPacketQueueTest, StreamsOfEqualPriorityAreInterleaved) {
+  for (uint16_t i = 0; i < 2; ++i) {
+    PushPacket(queue_.get(), now_, &enqueue_order_,
+               BuildPacket(RtpPacketToSend::Type::kVideo, kVideoSsrcs[0], i,
+                           1000));
+  }
+  for (uint16_t i = 0; i < 2; ++i) {
+    PushPacket(queue_.get(), now_, &enqueue_order_,
+               BuildPacket(RtpPacketToSend::Type::kVideo, kVideoSsrcs[1], i,
+                           1000));
+  }
+  EXPECT_EQ(kVideoSsrcs[0], PopPacket(queue_.get()).ssrc);
+  EXPECT_EQ(kVideoSsrcs[1], PopPacket(queue_.get()).ssrc);
+  EXPECT_EQ(kVideoSsrcs[0], PopPacket(queue_.get()).ssrc);
+  EXPECT_EQ(kVideoSsrcs[1], PopPacket(queue_.get()).ssrc);
+}
+
+TEST_P(RoundRobinPacketQueueTest, CancelPopKeepsPacketQueued) {
+  PushPacket(queue_.get(), now_, &enqueue_order_,
+             BuildPacket(RtpPacketToSend::Type::kVideo, kVideoSsrcs[0], 7,
+                         1000));
+  PacerPacketQueue::QueuedPacket* packet = queue_->BeginPop();
+  EXPECT_EQ(RtpPacketToSend::Type::kVideo, packet->type());
+  EXPECT_EQ(DataSize::bytes(1000), packet->size());
+  queue_->CancelPop();
+  EXPECT_EQ(1u, queue_->SizeInPackets());
+  EXPECT_EQ(7, PopPacket(queue_.get()).sequence_number);
+}
+
+TEST_P(RoundRobinPacketQueueTest, TracksOldestEnqueueTimeAndQueueTime) {
+  PushPacket(queue_.get(), now_, &enqueue_order_,
+             BuildPacket(RtpPacketToSend::Type::kVideo, kVideoSsrcs[0], 1,
+                         1000));
+  Timestamp first_enqueue_time = now_;
+  now_ += TimeDelta::ms(10);
+  PushPacket(queue_.get(), now_, &enqueue_order_,
+             BuildPacket(RtpPacketToSend::Type::kAudio, kAudioSsrc, 1, 100));
+  now_ += TimeDelta::ms(10);
+  queue_->UpdateQueueTime(now_);
+  EXPECT_EQ(first_enqueue_time, queue_->OldestEnqueueTime());
+  // Packets have been queued for 20 and 10 ms.
+  EXPECT_EQ(TimeDelta::ms(15), queue_->AverageQueueTime());
+
+  // The audio packet is sent first, the video packet remains the oldest.
+  EXPECT_EQ(kAudioSsrc, PopPacket(queue_.get()).ssrc);
+  EXPECT_EQ(first_enqueue_time, queue_->OldestEnqueueTime());
+  EXPECT_EQ(TimeDelta::ms(20), queue_->AverageQueueTime());
+}
+
+TEST_P(RoundRobinPacketQueueTest, PausedTimeNotCountedAsQueueTime) {
+  PushPacket(queue_.get(), now_, &enqueue_order_,
+             BuildPacket(RtpPacketToSend::Type::kVideo, kVideoSsrcs[0], 1,
+                         1000));
+  now_ += TimeDelta::ms(10);
+  queue_->SetPauseState(true, now_);
+  now_ += TimeDelta::ms(100);
+  queue_->SetPauseState(false, now_);
+  now_ += TimeDelta::ms(10);
+  queue_->UpdateQueueTime(now_);
+  EXPECT_EQ(TimeDelta::ms(20), queue_->AverageQueueTime());
+}
+
+// The pooled queue must send packets in exactly the same order as the legacy
+// implementation.
+TEST(PooledRoundRobinPacketQueueTest, SameOrderAsLegacyQueue) {
+  Timestamp now = Timestamp::ms(1000);
+  RoundRobinPacketQueue legacy(now, nullptr);
+  PooledRoundRobinPacketQueue pooled(now, nullptr);
+  uint64_t legacy_order = 0;
+  uint64_t pooled_order = 0;
+  Random random(0x12345678);
+  const RtpPacketToSend::Type kTypes[] = {
+      RtpPacketToSend::Type::kAudio, RtpPacketToSend::Type::kVideo,
+      RtpPacketToSend::Type::kRetransmission,
+      RtpPacketToSend::Type::kPadding};
+
+  uint16_t sequence_number = 0;
+  for (int i = 0; i < 5000; ++i) {
+    now += TimeDelta::ms(random.Rand(0, 2));
+    if (random.Rand(0, 2) > 0 || legacy.Empty()) {
+      RtpPacketToSend::Type type = kTypes[random.Rand(0, 3)];
+      uint32_t ssrc = type == RtpPacketToSend::Type::kAudio
+                          ? kAudioSsrc
+                          : kVideoSsrcs[random.Rand(0, 2)];
+      size_t size = random.Rand(50, 1200);
+      int priority = static_cast<int>(type);
+      legacy.Push(priority, now, legacy_order++,
+                  BuildPacket(type, ssrc, sequence_number, size));
+      pooled.Push(priority, now, pooled_order++,
+                  BuildPacket(type, ssrc, sequence_number, size));
+      ++sequence_number;
+    } else {
+      legacy.UpdateQueueTime(now);
+      pooled.UpdateQueueTime(now);
+      ASSERT_EQ(legacy.OldestEnqueueTime(), pooled.OldestEnqueueTime());
+      ASSERT_EQ(legacy.AverageQueueTime(), pooled.AverageQueueTime());
+      ASSERT_EQ(PopPacket(&legacy), PopPacket(&pooled));
+    }
+    ASSERT_EQ(legacy.SizeInPackets(), pooled.SizeInPackets());
+    ASSERT_EQ(legacy.Size(), pooled.Size());
+  }
+  while (!legacy.Empty()) {
+    ASSERT_EQ(PopPacket(&legacy), PopPacket(&pooled));
+  }
+  EXPECT_TRUE(pooled.Empty());
+}
+
+// Measures the cost of filling the queue to a given depth and draining it.
+// Run with --gtest_also_run_disabled_tests to get the timings logged.
+class RoundRobinPacketQueuePerfTest
+    : public ::testing::TestWithParam<std::tuple<bool, size_t>> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    PooledAndLegacy,
+    RoundRobinPacketQueuePerfTest,
+    ::testing::Combine(::testing::Bool(), ::testing::Values(1000, 10000)));
+
+TEST_P(RoundRobinPacketQueuePerfTest, DISABLED_EnqueueDequeuePerf) {
+  const bool pooled = std::get<0>(GetParam());
+  const size_t queue_depth = std::get<1>(GetParam());
+  const int kIterations = 100;
+  Timestamp now = Timestamp::ms(1000);
+  std::unique_ptr<PacerPacketQueue> queue = CreateQueue(pooled, now);
+  uint64_t enqueue_order = 0;
+
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kIterations; ++i) {
+    FillQueue(queue.get(), queue_depth, now, &enqueue_order);
+    while (!queue->Empty())
+      PopPacket(queue.get());
+  }
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  RTC_LOG(LS_INFO) << (pooled ? "Pooled" : "Legacy") << " queue, depth "
+                   << queue_depth << ": "
+                   << (elapsed_us * 1000.0) / (kIterations * queue_depth)
+                   << " ns per enqueue + dequeue";
+}
+
+}  // namespace webrtc
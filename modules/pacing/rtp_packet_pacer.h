@@ -40,6 +40,10 @@ class RtpPacketPacer {
   // Sets the pacing rates. Must be called once before packets can be sent.
   virtual void SetPacingRates(DataRate pacing_rate, DataRate padding_rate) = 0;
 
+  // Sets the largest burst of media to send at once, see
+  // PacerConfig::send_quantum. Zero disables bursts.
+  virtual void SetSendQuantum(DataSize send_quantum) = 0;
+
   // Time since the oldest packet currently in the queue was added.
   virtual TimeDelta OldestPacketWaitTime() const = 0;
 
@@ -0,0 +1,87 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include <algorithm>
+
+namespace webrtc {
+
+constexpr int64_t PacketArrivalTimeMap::kNotReceived;
+
+int64_t PacketArrivalTimeMap::NextReceived(int64_t sequence_number) const {
+  int64_t end = end_sequence_number();
+  sequence_number = std::max(sequence_number, begin_sequence_number_);
+  while (sequence_number < end &&
+         arrival_times_[sequence_number - begin_sequence_number_] ==
+             kNotReceived) {
+    ++sequence_number;
+  }
+  return std::min(sequence_number, end);
+}
+
+void PacketArrivalTimeMap::AddPacket(int64_t sequence_number,
+                                     int64_t arrival_time_ms) {
+  RTC_DCHECK_GE(arrival_time_ms, 0);
+  if (arrival_times_.empty()) {
+    begin_sequence_number_ = sequence_number;
+    arrival_times_.push_back(arrival_time_ms);
+    return;
+  }
+  if (sequence_number < begin_sequence_number_) {
+    arrival_times_.insert(arrival_times_.begin(),
+                          begin_sequence_number_ - sequence_number,
+                          kNotReceived);
+    begin_sequence_number_ = sequence_number;
+  } else if (sequence_number >= end_sequence_number()) {
+    arrival_times_.resize(sequence_number - begin_sequence_number_ + 1,
+                          kNotReceived);
+  }
+  int64_t& arrival_time =
+      arrival_times_[sequence_number - begin_sequence_number_];
+  // Only the first arrival of a packet counts.
+  if (arrival_time == kNotReceived)
+    arrival_time = arrival_time_ms;
+}
+
+void PacketArrivalTimeMap::EraseTo(int64_t sequence_number) {
+  if (sequence_number <= begin_sequence_number_)
+    return;
+  if (sequence_number >= end_sequence_number()) {
+    arrival_times_.clear();
+    begin_sequence_number_ = sequence_number;
+    return;
+  }
+  arrival_times_.erase(
+      arrival_times_.begin(),
+      arrival_times_.begin() + (sequence_number - begin_sequence_number_));
+  begin_sequence_number_ = sequence_number;
+  TrimFront();
+}
+
+void PacketArrivalTimeMap::RemoveOldPackets(int64_t sequence_number,
+                                            int64_t arrival_time_limit_ms) {
+  while (!arrival_times_.empty() &&
+         begin_sequence_number_ < sequence_number &&
+         arrival_times_.front() <= arrival_time_limit_ms) {
+    arrival_times_.pop_front();
+    ++begin_sequence_number_;
+    TrimFront();
+  }
+}
+
+void PacketArrivalTimeMap::TrimFront() {
+  while (!arrival_times_.empty() && arrival_times_.front() == kNotReceived) {
+    arrival_times_.pop_front();
+    ++begin_sequence_number_;
+  }
+}
+
+}  // namespace webrtc
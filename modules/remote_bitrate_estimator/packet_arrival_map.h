@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+#define MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+// Arrival times of received packets, by unwrapped transport sequence number.
+// The times are stored in a ring indexed by sequence number, with a sentinel
+// for packets that haven't been received, so adding and finding packets
+// doesn't allocate a node per packet like a std::map would. Packets can only
+// be removed from the front, which is all that the RemoteEstimatorProxy needs.
+//
+// The map grows to cover all sequence numbers between the first and the last
+// received packet, so the user must bound that range, e.g. by erasing packets
+// that are too old to be reported.
+class PacketArrivalTimeMap {
+ public:
+  static constexpr int64_t kNotReceived = -1;
+
+  // Sequence numbers in [begin_sequence_number(), end_sequence_number()) are
+  // covered by the map. Unless the map is empty, the first and the last of
+  // them have been received.
+  int64_t begin_sequence_number() const { return begin_sequence_number_; }
+  int64_t end_sequence_number() const {
+    return begin_sequence_number_ + arrival_times_.size();
+  }
+  bool empty() const { return arrival_times_.empty(); }
+
+  bool has_received(int64_t sequence_number) const {
+    return get(sequence_number) != kNotReceived;
+  }
+
+  // Returns the arrival time of |sequence_number|, or kNotReceived.
+  int64_t get(int64_t sequence_number) const {
+    if (sequence_number < begin_sequence_number() ||
+        sequence_number >= end_sequence_number()) {
+      return kNotReceived;
+    }
+    return arrival_times_[sequence_number - begin_sequence_number_];
+  }
+
+  // Returns the first received sequence number in [|sequence_number|,
+  // end_sequence_number()), or end_sequence_number().
+  int64_t NextReceived(int64_t sequence_number) const;
+
+  // Records the arrival of |sequence_number|, unless it has already been
+  // received. |arrival_time_ms| must not be negative.
+  void AddPacket(int64_t sequence_number, int64_t arrival_time_ms);
+
+  // Removes all packets before |sequence_number|.
+  void EraseTo(int64_t sequence_number);
+
+  // Removes packets from the front, as long as they are before
+  // |sequence_number| and arrived at or before |arrival_time_limit_ms|.
+  void RemoveOldPackets(int64_t sequence_number, int64_t arrival_time_limit_ms);
+
+ private:
+  // Pops leading packets that haven't been received.
+  void TrimFront();
+
+  int64_t begin_sequence_number_ = 0;
+  std::deque<int64_t> arrival_times_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_REMOTE_BITRATE_ESTIMATOR_PACKET_ARRIVAL_MAP_H_
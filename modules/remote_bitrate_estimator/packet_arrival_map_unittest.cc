@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(PacketArrivalMapTest, IsConsistentWhenEmpty) {
+  PacketArrivalTimeMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin_sequence_number(), map.end_sequence_number());
+  EXPECT_FALSE(map.has_received(0));
+  EXPECT_EQ(PacketArrivalTimeMap::kNotReceived, map.get(0));
+}
+
+TEST(PacketArrivalMapTest, InsertsFirstItemIntoMap) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  EXPECT_EQ(42, map.begin_sequence_number());
+  EXPECT_EQ(43, map.end_sequence_number());
+  EXPECT_TRUE(map.has_received(42));
+  EXPECT_EQ(10, map.get(42));
+  EXPECT_FALSE(map.has_received(41));
+  EXPECT_FALSE(map.has_received(43));
+}
+
+TEST(PacketArrivalMapTest, KeepsFirstArrivalTime) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  map.AddPacket(42, 11);
+  EXPECT_EQ(10, map.get(42));
+}
+
+TEST(PacketArrivalMapTest, GrowsBothWaysWithGaps) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  map.AddPacket(45, 11);
+  map.AddPacket(40, 12);
+  EXPECT_EQ(40, map.begin_sequence_number());
+  EXPECT_EQ(46, map.end_sequence_number());
+  EXPECT_FALSE(map.has_received(41));
+  EXPECT_FALSE(map.has_received(43));
+  EXPECT_FALSE(map.has_received(44));
+  EXPECT_EQ(12, map.get(40));
+  EXPECT_EQ(10, map.get(42));
+  EXPECT_EQ(11, map.get(45));
+
+  EXPECT_EQ(40, map.NextReceived(0));
+  EXPECT_EQ(42, map.NextReceived(41));
+  EXPECT_EQ(45, map.NextReceived(43));
+  EXPECT_EQ(46, map.NextReceived(46));
+  EXPECT_EQ(46, map.NextReceived(100));
+}
+
+TEST(PacketArrivalMapTest, EraseToSkipsMissingPackets) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  map.AddPacket(45, 11);
+  map.AddPacket(46, 12);
+
+  map.EraseTo(41);
+  EXPECT_EQ(42, map.begin_sequence_number());
+  map.EraseTo(43);
+  EXPECT_EQ(45, map.begin_sequence_number());
+  EXPECT_FALSE(map.has_received(42));
+  map.EraseTo(47);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PacketArrivalMapTest, RemovesOldPacketsUpToSequenceNumber) {
+  PacketArrivalTimeMap map;
+  map.AddPacket(42, 10);
+  map.AddPacket(43, 20);
+  map.AddPacket(45, 15);
+  map.AddPacket(46, 30);
+
+  // Stops at the first packet that arrived too late.
+  map.RemoveOldPackets(46, 15);
+  EXPECT_EQ(43, map.begin_sequence_number());
+  map.RemoveOldPackets(46, 20);
+  EXPECT_EQ(46, map.begin_sequence_number());
+  // Never removes |sequence_number| itself.
+  map.RemoveOldPackets(46, 30);
+  EXPECT_EQ(46, map.begin_sequence_number());
+  EXPECT_TRUE(map.has_received(46));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <limits>
 
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -55,6 +56,14 @@ RemoteEstimatorProxy::~RemoteEstimatorProxy() {}
 void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
                                           size_t payload_size,
                                           const RTPHeader& header) {
+  IncomingPacket(arrival_time_ms, payload_size, header,
+                 rtc::EcnMarking::kNotEct);
+}
+
+void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
+                                          size_t payload_size,
+                                          const RTPHeader& header,
+                                          rtc::EcnMarking ecn) {
   if (arrival_time_ms < 0 || arrival_time_ms > kMaxTimeMs) {
     RTC_LOG(LS_WARNING) << "Arrival time out of bounds: " << arrival_time_ms;
     return;
@@ -68,14 +77,11 @@ void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
 
     if (send_periodic_feedback_) {
       if (periodic_window_start_seq_ &&
-          packet_arrival_times_.lower_bound(*periodic_window_start_seq_) ==
-              packet_arrival_times_.end()) {
+          *periodic_window_start_seq_ >=
+              packet_arrival_times_.end_sequence_number()) {
         // Start new feedback packet, cull old packets.
-        for (auto it = packet_arrival_times_.begin();
-             it != packet_arrival_times_.end() && it->first < seq &&
-             arrival_time_ms - it->second >= send_config_.back_window->ms();) {
-          it = packet_arrival_times_.erase(it);
-        }
+        packet_arrival_times_.RemoveOldPackets(
+            seq, arrival_time_ms - send_config_.back_window->ms());
       }
       if (!periodic_window_start_seq_ || seq < *periodic_window_start_seq_) {
         periodic_window_start_seq_ = seq;
@@ -83,22 +89,26 @@ void RemoteEstimatorProxy::IncomingPacket(int64_t arrival_time_ms,
     }
 
     // We are only interested in the first time a packet is received.
-    if (packet_arrival_times_.find(seq) != packet_arrival_times_.end())
+    if (packet_arrival_times_.has_received(seq)) {
+      ++ecn_counts_.duplicates;
       return;
+    }
 
-    packet_arrival_times_[seq] = arrival_time_ms;
+    packet_arrival_times_.AddPacket(seq, arrival_time_ms);
+    CountEcnMarking(seq, ecn);
 
     // Limit the range of sequence numbers to send feedback for.
-    auto first_arrival_time_to_keep = packet_arrival_times_.lower_bound(
-        packet_arrival_times_.rbegin()->first - kMaxNumberOfPackets);
-    if (first_arrival_time_to_keep != packet_arrival_times_.begin()) {
-      packet_arrival_times_.erase(packet_arrival_times_.begin(),
-                                  first_arrival_time_to_keep);
+    int64_t first_sequence_number_to_keep =
+        packet_arrival_times_.end_sequence_number() - 1 - kMaxNumberOfPackets;
+    if (packet_arrival_times_.begin_sequence_number() <
+        first_sequence_number_to_keep) {
+      packet_arrival_times_.EraseTo(first_sequence_number_to_keep);
       if (send_periodic_feedback_) {
         // |packet_arrival_times_| cannot be empty since we just added one
         // element and the last element is not deleted.
         RTC_DCHECK(!packet_arrival_times_.empty());
-        periodic_window_start_seq_ = packet_arrival_times_.begin()->first;
+        periodic_window_start_seq_ =
+            packet_arrival_times_.begin_sequence_number();
       }
     }
 
@@ -197,15 +207,27 @@ void RemoteEstimatorProxy::SendPeriodicFeedbacks() {
     }
   }
 
-  for (auto begin_iterator =
-           packet_arrival_times_.lower_bound(*periodic_window_start_seq_);
-       begin_iterator != packet_arrival_times_.cend();
-       begin_iterator =
-           packet_arrival_times_.lower_bound(*periodic_window_start_seq_)) {
+  // The ECN feedback goes first, so that the sender can attribute the marks to
+  // the transport feedback that follows. Without ECN capable packets there is
+  // nothing to report, e.g. when the sender doesn't mark its packets or the
+  // socket doesn't report the marks.
+  if (ecn_counts_.ect0 + ecn_counts_.ect1 + ecn_counts_.ce > 0) {
+    rtcp::EcnFeedback ecn_feedback;
+    BuildEcnFeedbackPacket(&ecn_feedback);
+    feedback_sender_->SendEcnFeedback(&ecn_feedback);
+  }
+
+  // Each feedback packet continues where the previous one got full.
+  for (int64_t begin_sequence_number =
+           packet_arrival_times_.NextReceived(*periodic_window_start_seq_);
+       begin_sequence_number < packet_arrival_times_.end_sequence_number();
+       begin_sequence_number =
+           packet_arrival_times_.NextReceived(*periodic_window_start_seq_)) {
     rtcp::TransportFeedback feedback_packet;
     periodic_window_start_seq_ = BuildFeedbackPacket(
         feedback_packet_count_++, media_ssrc_, *periodic_window_start_seq_,
-        begin_iterator, packet_arrival_times_.cend(), &feedback_packet);
+        packet_arrival_times_, begin_sequence_number,
+        packet_arrival_times_.end_sequence_number(), &feedback_packet);
 
     RTC_DCHECK(feedback_sender_ != nullptr);
     feedback_sender_->SendTransportFeedback(&feedback_packet);
@@ -225,29 +247,73 @@ void RemoteEstimatorProxy::SendFeedbackOnRequest(
 
   int64_t first_sequence_number =
       sequence_number - feedback_request.sequence_count + 1;
-  auto begin_iterator =
-      packet_arrival_times_.lower_bound(first_sequence_number);
-  auto end_iterator = packet_arrival_times_.upper_bound(sequence_number);
-
   BuildFeedbackPacket(feedback_packet_count_++, media_ssrc_,
-                      first_sequence_number, begin_iterator, end_iterator,
-                      &feedback_packet);
+                      first_sequence_number, packet_arrival_times_,
+                      packet_arrival_times_.NextReceived(first_sequence_number),
+                      sequence_number + 1, &feedback_packet);
 
   // Clear up to the first packet that is included in this feedback packet.
-  packet_arrival_times_.erase(packet_arrival_times_.begin(), begin_iterator);
+  packet_arrival_times_.EraseTo(first_sequence_number);
 
   RTC_DCHECK(feedback_sender_ != nullptr);
   feedback_sender_->SendTransportFeedback(&feedback_packet);
 }
 
+void RemoteEstimatorProxy::CountEcnMarking(int64_t sequence_number,
+                                           rtc::EcnMarking ecn) {
+  switch (ecn) {
+    case rtc::EcnMarking::kNotEct:
+      ++ecn_counts_.not_ect;
+      break;
+    case rtc::EcnMarking::kEct1:
+      ++ecn_counts_.ect1;
+      break;
+    case rtc::EcnMarking::kEct0:
+      ++ecn_counts_.ect0;
+      break;
+    case rtc::EcnMarking::kCe:
+      ++ecn_counts_.ce;
+      break;
+  }
+  if (ecn_counts_.received == 0 ||
+      sequence_number < ecn_counts_.first_sequence_number) {
+    ecn_counts_.first_sequence_number = sequence_number;
+  }
+  ecn_counts_.highest_sequence_number =
+      std::max(ecn_counts_.highest_sequence_number, sequence_number);
+  ++ecn_counts_.received;
+}
+
+void RemoteEstimatorProxy::BuildEcnFeedbackPacket(
+    rtcp::EcnFeedback* feedback_packet) const {
+  // The counts cover the transport-wide sequence numbers of all streams, so
+  // the extended highest sequence number is a transport sequence number too.
+  int64_t expected = ecn_counts_.highest_sequence_number -
+                     ecn_counts_.first_sequence_number + 1;
+  int64_t lost = std::max<int64_t>(expected - ecn_counts_.received, 0);
+  feedback_packet->SetMediaSsrc(media_ssrc_);
+  feedback_packet->SetExtendedHighestSequenceNumber(
+      static_cast<uint32_t>(ecn_counts_.highest_sequence_number));
+  feedback_packet->SetEct0Count(ecn_counts_.ect0);
+  feedback_packet->SetEct1Count(ecn_counts_.ect1);
+  // The 16 bit counters wrap around.
+  feedback_packet->SetCeCount(static_cast<uint16_t>(ecn_counts_.ce));
+  feedback_packet->SetNotEctCount(static_cast<uint16_t>(ecn_counts_.not_ect));
+  feedback_packet->SetLostPacketsCount(static_cast<uint16_t>(lost));
+  feedback_packet->SetDuplicatesCount(
+      static_cast<uint16_t>(ecn_counts_.duplicates));
+}
+
 int64_t RemoteEstimatorProxy::BuildFeedbackPacket(
     uint8_t feedback_packet_count,
     uint32_t media_ssrc,
     int64_t base_sequence_number,
-    std::map<int64_t, int64_t>::const_iterator begin_iterator,
-    std::map<int64_t, int64_t>::const_iterator end_iterator,
+    const PacketArrivalTimeMap& packet_arrival_times,
+    int64_t begin_sequence_number,
+    int64_t end_sequence_number,
     rtcp::TransportFeedback* feedback_packet) {
-  RTC_DCHECK(begin_iterator != end_iterator);
+  RTC_DCHECK_LT(begin_sequence_number, end_sequence_number);
+  RTC_DCHECK(packet_arrival_times.has_received(begin_sequence_number));
 
   // TODO(sprang): Measure receive times in microseconds and remove the
   // conversions below.
@@ -255,22 +321,26 @@ int64_t RemoteEstimatorProxy::BuildFeedbackPacket(
   // Base sequence number is the expected first sequence number. This is known,
   // but we might not have actually received it, so the base time shall be the
   // time of the first received packet in the feedback.
-  feedback_packet->SetBase(static_cast<uint16_t>(base_sequence_number & 0xFFFF),
-                           begin_iterator->second * 1000);
+  feedback_packet->SetBase(
+      static_cast<uint16_t>(base_sequence_number & 0xFFFF),
+      packet_arrival_times.get(begin_sequence_number) * 1000);
   feedback_packet->SetFeedbackSequenceNumber(feedback_packet_count);
+  feedback_packet->ReservePackets(end_sequence_number - base_sequence_number);
   int64_t next_sequence_number = base_sequence_number;
-  for (auto it = begin_iterator; it != end_iterator; ++it) {
+  for (int64_t seq = begin_sequence_number; seq < end_sequence_number;
+       seq = packet_arrival_times.NextReceived(seq + 1)) {
     if (!feedback_packet->AddReceivedPacket(
-            static_cast<uint16_t>(it->first & 0xFFFF), it->second * 1000)) {
+            static_cast<uint16_t>(seq & 0xFFFF),
+            packet_arrival_times.get(seq) * 1000)) {
       // If we can't even add the first seq to the feedback packet, we won't be
       // able to build it at all.
-      RTC_CHECK(begin_iterator != it);
+      RTC_CHECK_NE(begin_sequence_number, seq);
 
       // Could not add timestamp, feedback packet might be full. Return and
       // try again with a fresh packet.
       break;
     }
-    next_sequence_number = it->first + 1;
+    next_sequence_number = seq + 1;
   }
   return next_sequence_number;
 }
@@ -11,14 +11,15 @@
 #ifndef MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 #define MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 
-#include <map>
 #include <vector>
 
 #include "api/transport/network_control.h"
 #include "api/transport/webrtc_key_value_config.h"
 #include "modules/remote_bitrate_estimator/include/remote_bitrate_estimator.h"
+#include "modules/remote_bitrate_estimator/packet_arrival_map.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/experiments/field_trial_parser.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 
 namespace webrtc {
@@ -26,6 +27,7 @@ namespace webrtc {
 class Clock;
 class PacketRouter;
 namespace rtcp {
+class EcnFeedback;
 class TransportFeedback;
 }
 
@@ -44,6 +46,13 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
   void IncomingPacket(int64_t arrival_time_ms,
                       size_t payload_size,
                       const RTPHeader& header) override;
+  // Also counts the ECN marking of the packet. Once ECN capable packets have
+  // been received, the counts are sent in an ECN feedback ahead of each round
+  // of periodic transport feedback.
+  void IncomingPacket(int64_t arrival_time_ms,
+                      size_t payload_size,
+                      const RTPHeader& header,
+                      rtc::EcnMarking ecn);
   void RemoveStream(uint32_t ssrc) override {}
   bool LatestEstimate(std::vector<unsigned int>* ssrcs,
                       unsigned int* bitrate_bps) const override;
@@ -70,20 +79,40 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
     }
   };
 
+  // Cumulative counts of the packets with transport sequence numbers.
+  struct EcnCounts {
+    uint32_t ect0 = 0;
+    uint32_t ect1 = 0;
+    uint32_t ce = 0;
+    uint32_t not_ect = 0;
+    uint32_t duplicates = 0;
+    int64_t received = 0;
+    int64_t first_sequence_number = 0;
+    int64_t highest_sequence_number = -1;
+  };
+
   static const int kMaxNumberOfPackets;
 
   void SendPeriodicFeedbacks() RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   void SendFeedbackOnRequest(int64_t sequence_number,
                              const FeedbackRequest& feedback_request)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  void CountEcnMarking(int64_t sequence_number, rtc::EcnMarking ecn)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // Builds an ECN feedback from |ecn_counts_|.
+  void BuildEcnFeedbackPacket(rtcp::EcnFeedback* feedback_packet) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // Adds the received packets in [|begin_sequence_number|,
+  // |end_sequence_number|) to |feedback_packet|, until it is full, and returns
+  // the sequence number to continue from in the next feedback packet.
+  // |begin_sequence_number| must have been received.
   static int64_t BuildFeedbackPacket(
       uint8_t feedback_packet_count,
       uint32_t media_ssrc,
       int64_t base_sequence_number,
-      std::map<int64_t, int64_t>::const_iterator
-          begin_iterator,  // |begin_iterator| is inclusive.
-      std::map<int64_t, int64_t>::const_iterator
-          end_iterator,  // |end_iterator| is exclusive.
+      const PacketArrivalTimeMap& packet_arrival_times,
+      int64_t begin_sequence_number,
+      int64_t end_sequence_number,
       rtcp::TransportFeedback* feedback_packet);
 
   Clock* const clock_;
@@ -99,10 +128,10 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
   uint8_t feedback_packet_count_ RTC_GUARDED_BY(&lock_);
   SeqNumUnwrapper<uint16_t> unwrapper_ RTC_GUARDED_BY(&lock_);
   absl::optional<int64_t> periodic_window_start_seq_ RTC_GUARDED_BY(&lock_);
-  // Map unwrapped seq -> time.
-  std::map<int64_t, int64_t> packet_arrival_times_ RTC_GUARDED_BY(&lock_);
+  PacketArrivalTimeMap packet_arrival_times_ RTC_GUARDED_BY(&lock_);
   int64_t send_interval_ms_ RTC_GUARDED_BY(&lock_);
   bool send_periodic_feedback_ RTC_GUARDED_BY(&lock_);
+  EcnCounts ecn_counts_ RTC_GUARDED_BY(&lock_);
 
   // Unwraps absolute send times.
   uint32_t previous_abs_send_time_ RTC_GUARDED_BY(&lock_);
@@ -13,6 +13,7 @@
 #include "api/transport/field_trial_based_config.h"
 #include "api/transport/test/mock_network_control.h"
 #include "modules/pacing/packet_router.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gmock.h"
@@ -64,6 +65,7 @@ class MockTransportFeedbackSender : public TransportFeedbackSenderInterface {
                bool(rtcp::TransportFeedback* feedback_packet));
   MOCK_METHOD1(SendNetworkStateEstimatePacket,
                void(rtcp::RemoteEstimate* packet));
+  MOCK_METHOD1(SendEcnFeedback, void(rtcp::EcnFeedback* packet));
 };
 
 class RemoteEstimatorProxyTest : public ::testing::Test {
@@ -146,6 +148,42 @@ TEST_F(RemoteEstimatorProxyTest, DuplicatedPackets) {
   Process();
 }
 
+TEST_F(RemoteEstimatorProxyTest, SendsEcnFeedbackBeforeTransportFeedback) {
+  const rtc::EcnMarking kMarkings[] = {
+      rtc::EcnMarking::kEct0, rtc::EcnMarking::kCe, rtc::EcnMarking::kEct1,
+      rtc::EcnMarking::kNotEct, rtc::EcnMarking::kEct0};
+  for (uint16_t i = 0; i < 5; ++i) {
+    // Drop the fourth packet.
+    if (i == 3)
+      continue;
+    proxy_.IncomingPacket(
+        kBaseTimeMs + i, kDefaultPacketSize,
+        CreateHeader(kBaseSeq + i, absl::nullopt, absl::nullopt),
+        kMarkings[i]);
+  }
+  // Duplicates are counted, but their markings are not.
+  proxy_.IncomingPacket(kBaseTimeMs + 5, kDefaultPacketSize,
+                        CreateHeader(kBaseSeq, absl::nullopt, absl::nullopt),
+                        rtc::EcnMarking::kCe);
+
+  ::testing::InSequence in_sequence;
+  EXPECT_CALL(router_, SendEcnFeedback(_))
+      .WillOnce(Invoke([](rtcp::EcnFeedback* feedback_packet) {
+        EXPECT_EQ(kMediaSsrc, feedback_packet->media_ssrc());
+        EXPECT_EQ(kBaseSeq + 4u,
+                  feedback_packet->extended_highest_sequence_number());
+        EXPECT_EQ(2u, feedback_packet->ect0_count());
+        EXPECT_EQ(1u, feedback_packet->ect1_count());
+        EXPECT_EQ(1u, feedback_packet->ce_count());
+        EXPECT_EQ(0u, feedback_packet->not_ect_count());
+        EXPECT_EQ(1u, feedback_packet->lost_packets_count());
+        EXPECT_EQ(1u, feedback_packet->duplicates_count());
+      }));
+  EXPECT_CALL(router_, SendTransportFeedback(_)).WillOnce(Return(true));
+
+  Process();
+}
+
 TEST_F(RemoteEstimatorProxyTest, FeedbackWithMissingStart) {
   // First feedback.
   IncomingPacket(kBaseSeq, kBaseTimeMs);
@@ -105,6 +105,12 @@ class RtpRtcp : public Module, public RtcpFeedbackSenderInterface {
 
     int rtcp_report_interval_ms = 0;
 
+    // If positive, the time of the next report is rounded up to a multiple
+    // of this interval, so that modules sharing a transport through an
+    // RtcpPacketAggregator produce their reports together. Should be small
+    // compared to the report interval.
+    int rtcp_report_alignment_ms = 0;
+
     // Update network2 instead of pacer_exit field of video timing extension.
     bool populate_network2_timestamp = false;
 
@@ -348,6 +354,9 @@ class RtpRtcp : public Module, public RtcpFeedbackSenderInterface {
       StreamDataCounters* rtp_counters,
       StreamDataCounters* rtx_counters) const = 0;
 
+  // Returns the memory used by the packets stored for retransmission.
+  virtual RtpPacketHistoryStats GetPacketHistoryStats() const = 0;
+
   // Returns received RTCP report block.
   // Returns -1 on failure else 0.
   // TODO(https://crbug.com/webrtc/10678): Remove this in favor of
@@ -103,7 +103,8 @@ PacketFeedback::PacketFeedback(int64_t creation_time_ms,
       remote_net_id(remote_net_id),
       pacing_info(pacing_info),
       ssrc(0),
-      rtp_sequence_number(0) {}
+      rtp_sequence_number(0),
+      is_padding(false) {}
 
 PacketFeedback::PacketFeedback(const PacketFeedback&) = default;
 PacketFeedback& PacketFeedback::operator=(const PacketFeedback&) = default;
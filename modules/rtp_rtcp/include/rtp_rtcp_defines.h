@@ -23,6 +23,7 @@
 #include "api/audio_codecs/audio_format.h"
 #include "api/rtp_headers.h"
 #include "api/transport/network_types.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/remote_estimate.h"
 #include "system_wrappers/include/clock.h"
 
@@ -277,6 +278,8 @@ struct PacketFeedback {
   // The SSRC and RTP sequence number of the packet this feedback refers to.
   absl::optional<uint32_t> ssrc;
   uint16_t rtp_sequence_number;
+  // True if the packet was sent as padding, i.e. it carried no new media.
+  bool is_padding;
 };
 
 struct RtpPacketSendInfo {
@@ -290,6 +293,8 @@ struct RtpPacketSendInfo {
   bool has_rtp_sequence_number = false;
   size_t length = 0;
   PacedPacketInfo pacing_info;
+  // True for padding packets, also when the padding is a retransmission.
+  bool is_padding = false;
 };
 class NetworkStateEstimateObserver {
  public:
@@ -304,6 +309,7 @@ class TransportFeedbackObserver {
 
   virtual void OnAddPacket(const RtpPacketSendInfo& packet_info) = 0;
   virtual void OnTransportFeedback(const rtcp::TransportFeedback& feedback) = 0;
+  virtual void OnEcnFeedback(const rtcp::EcnFeedback& feedback) {}
 };
 
 // Interface for PacketRouter to send rtcp feedback on behalf of
@@ -317,6 +323,7 @@ class RtcpFeedbackSenderInterface {
   virtual bool SendFeedbackPacket(const rtcp::TransportFeedback& feedback) = 0;
   virtual bool SendNetworkStateEstimatePacket(
       const rtcp::RemoteEstimate& packet) = 0;
+  virtual bool SendEcnFeedbackPacket(const rtcp::EcnFeedback& packet) = 0;
   virtual void SetRemb(int64_t bitrate_bps, std::vector<uint32_t> ssrcs) = 0;
   virtual void UnsetRemb() = 0;
 };
@@ -424,6 +431,14 @@ struct StreamDataCounters {
   RtpPacketCounter fec;            // Number of redundancy packets/bytes.
 };
 
+// Memory used by the packets a sender stores for retransmission.
+struct RtpPacketHistoryStats {
+  // Approximate number of bytes held by the stored packets.
+  size_t stored_bytes = 0;
+  // The maximum number of packets that are stored, 0 if storage is disabled.
+  size_t max_packets = 0;
+};
+
 // Callback, called whenever byte/packet counts have been updated.
 class StreamDataCountersCallback {
  public:
@@ -123,6 +123,7 @@ class MockRtpRtcp : public RtpRtcp {
                      int32_t(size_t* bytes_sent, uint32_t* packets_sent));
   MOCK_CONST_METHOD2(GetSendStreamDataCounters,
                      void(StreamDataCounters*, StreamDataCounters*));
+  MOCK_CONST_METHOD0(GetPacketHistoryStats, RtpPacketHistoryStats());
   MOCK_CONST_METHOD1(RemoteRTCPStat,
                      int32_t(std::vector<RTCPReportBlock>* receive_blocks));
   MOCK_CONST_METHOD0(GetLatestReportBlockData, std::vector<ReportBlockData>());
@@ -150,6 +151,7 @@ class MockRtpRtcp : public RtpRtcp {
   MOCK_METHOD1(SendFeedbackPacket, bool(const rtcp::TransportFeedback& packet));
   MOCK_METHOD1(SendNetworkStateEstimatePacket,
                bool(const rtcp::RemoteEstimate& packet));
+  MOCK_METHOD1(SendEcnFeedbackPacket, bool(const rtcp::EcnFeedback& packet));
   MOCK_METHOD1(SetTargetSendBitrate, void(uint32_t bitrate_bps));
   MOCK_METHOD4(SendLossNotification,
                int32_t(uint16_t last_decoded_seq_num,
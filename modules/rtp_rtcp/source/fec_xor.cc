@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include <emmintrin.h>
+#endif
+
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using XorFunction = void (*)(const uint8_t* src, size_t length, uint8_t* dst);
+
+XorFunction SelectXorFunction() {
+#if defined(WEBRTC_HAS_NEON)
+  return &XorBytes_NEON;
+#else
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    return &XorBytes_AVX2;
+  }
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    return &XorBytes_SSE2;
+  }
+#endif
+  return &XorBytes_C;
+#endif
+}
+
+}  // namespace
+
+void XorBytes(const uint8_t* src, size_t length, uint8_t* dst) {
+  static const XorFunction xor_function = SelectXorFunction();
+  xor_function(src, length, dst);
+}
+
+void XorBytes_C(const uint8_t* src, size_t length, uint8_t* dst) {
+  for (size_t i = 0; i < length; ++i) {
+    dst[i] ^= src[i];
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorBytes_SSE2(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  // Process 64 bytes per iteration, to keep several loads in flight.
+  for (; i + 64 <= length; i += 64) {
+    for (size_t j = i; j < i + 64; j += 16) {
+      __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + j));
+      __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + j));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + j),
+                       _mm_xor_si128(s, d));
+    }
+  }
+  for (; i + 16 <= length; i += 16) {
+    __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(s, d));
+  }
+  XorBytes_C(src + i, length - i, dst + i);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void XorBytes_NEON(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  for (; i + 64 <= length; i += 64) {
+    uint8x16_t d0 = veorq_u8(vld1q_u8(src + i), vld1q_u8(dst + i));
+    uint8x16_t d1 = veorq_u8(vld1q_u8(src + i + 16), vld1q_u8(dst + i + 16));
+    uint8x16_t d2 = veorq_u8(vld1q_u8(src + i + 32), vld1q_u8(dst + i + 32));
+    uint8x16_t d3 = veorq_u8(vld1q_u8(src + i + 48), vld1q_u8(dst + i + 48));
+    vst1q_u8(dst + i, d0);
+    vst1q_u8(dst + i + 16, d1);
+    vst1q_u8(dst + i + 32, d2);
+    vst1q_u8(dst + i + 48, d3);
+  }
+  for (; i + 16 <= length; i += 16) {
+    vst1q_u8(dst + i, veorq_u8(vld1q_u8(src + i), vld1q_u8(dst + i)));
+  }
+  XorBytes_C(src + i, length - i, dst + i);
+}
+#endif
+
+}  // namespace internal
+}  // namespace webrtc
@@ -0,0 +1,42 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+#define MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace internal {
+
+// XORs |length| bytes from |src| into |dst|, i.e. dst[i] ^= src[i]. The two
+// ranges must not overlap. Uses the widest vector instructions supported by
+// the CPU.
+void XorBytes(const uint8_t* src, size_t length, uint8_t* dst);
+
+// The implementations XorBytes() dispatches to, exposed for testing. The
+// vectorized ones must only be called if the CPU supports them.
+void XorBytes_C(const uint8_t* src, size_t length, uint8_t* dst);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void XorBytes_SSE2(const uint8_t* src, size_t length, uint8_t* dst);
+// Compiled separately, with AVX2 code generation enabled.
+void XorBytes_AVX2(const uint8_t* src, size_t length, uint8_t* dst);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void XorBytes_NEON(const uint8_t* src, size_t length, uint8_t* dst);
+#endif
+
+}  // namespace internal
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_FEC_XOR_H_
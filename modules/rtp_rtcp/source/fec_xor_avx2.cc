@@ -0,0 +1,41 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+namespace internal {
+
+void XorBytes_AVX2(const uint8_t* src, size_t length, uint8_t* dst) {
+  size_t i = 0;
+  // Process 128 bytes per iteration, to keep several loads in flight.
+  for (; i + 128 <= length; i += 128) {
+    for (size_t j = i; j < i + 128; j += 32) {
+      __m256i s =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + j));
+      __m256i d =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + j));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + j),
+                          _mm256_xor_si256(s, d));
+    }
+  }
+  for (; i + 32 <= length; i += 32) {
+    __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                        _mm256_xor_si256(s, d));
+  }
+  XorBytes_SSE2(src + i, length - i, dst + i);
+}
+
+}  // namespace internal
+}  // namespace webrtc
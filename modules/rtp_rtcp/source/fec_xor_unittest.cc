@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/fec_xor.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace internal {
+namespace {
+
+using XorFunction = void (*)(const uint8_t*, size_t, uint8_t*);
+
+// Larger than any RTP packet, and not a multiple of any vector width.
+constexpr size_t kMaxLength = 1500 + 63;
+
+std::vector<std::pair<std::string, XorFunction>> VectorizedXorFunctions() {
+  std::vector<std::pair<std::string, XorFunction>> functions;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0) {
+    functions.emplace_back("SSE2", &XorBytes_SSE2);
+  }
+  if (WebRtc_GetCPUInfo(kAVX2) != 0) {
+    functions.emplace_back("AVX2", &XorBytes_AVX2);
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  functions.emplace_back("NEON", &XorBytes_NEON);
+#endif
+  functions.emplace_back("Dispatched", &XorBytes);
+  return functions;
+}
+
+std::vector<uint8_t> RandomBytes(Random* random, size_t length) {
+  std::vector<uint8_t> bytes(length);
+  for (uint8_t& byte : bytes) {
+    byte = random->Rand<uint8_t>();
+  }
+  return bytes;
+}
+
+}  // namespace
+
+TEST(FecXorTest, ScalarXorsBytes) {
+  const uint8_t src[] = {0x00, 0xff, 0x0f, 0xa5};
+  uint8_t dst[] = {0x12, 0x34, 0xf0, 0xa5, 0x77};
+  XorBytes_C(src, sizeof(src), dst);
+  EXPECT_EQ(0x12, dst[0]);
+  EXPECT_EQ(0xcb, dst[1]);
+  EXPECT_EQ(0xff, dst[2]);
+  EXPECT_EQ(0x00, dst[3]);
+  // Bytes beyond the length are untouched.
+  EXPECT_EQ(0x77, dst[4]);
+}
+
+// Runs every vectorized implementation available on this CPU on random data,
+// lengths and alignments, and checks that the result is identical to the
+// scalar implementation, including that no bytes outside the range change.
+TEST(FecXorTest, VectorizedMatchesScalar) {
+  Random random(0x6a4f1e);
+  for (const auto& function : VectorizedXorFunctions()) {
+    SCOPED_TRACE(function.first);
+    for (int i = 0; i < 2000; ++i) {
+      const size_t length = random.Rand(0, static_cast<int>(kMaxLength));
+      const size_t src_offset = random.Rand(0, 63);
+      const size_t dst_offset = random.Rand(0, 63);
+      const std::vector<uint8_t> src =
+          RandomBytes(&random, src_offset + length);
+      std::vector<uint8_t> expected = RandomBytes(&random, dst_offset + length);
+      // Guard bytes behind the destination range.
+      expected.resize(expected.size() + 64, 0xcc);
+      std::vector<uint8_t> actual = expected;
+
+      XorBytes_C(src.data() + src_offset, length, expected.data() + dst_offset);
+      function.second(src.data() + src_offset, length,
+                      actual.data() + dst_offset);
+      ASSERT_EQ(expected, actual)
+          << "length " << length << ", src offset " << src_offset
+          << ", dst offset " << dst_offset;
+    }
+  }
+}
+
+TEST(FecXorTest, XorTwiceRestoresDestination) {
+  Random random(0x1234);
+  const std::vector<uint8_t> src = RandomBytes(&random, kMaxLength);
+  const std::vector<uint8_t> original = RandomBytes(&random, kMaxLength);
+  std::vector<uint8_t> dst = original;
+  XorBytes(src.data(), src.size(), dst.data());
+  EXPECT_NE(original, dst);
+  XorBytes(src.data(), src.size(), dst.data());
+  EXPECT_EQ(original, dst);
+}
+
+// Compares the throughput of the implementations on packet sized payloads.
+// Run with --gtest_also_run_disabled_tests to get the timings logged.
+TEST(FecXorTest, DISABLED_XorPerf) {
+  const size_t kPayloadLength = 1200;
+  const int kIterations = 1000000;
+  Random random(0x5678);
+  const std::vector<uint8_t> src = RandomBytes(&random, kPayloadLength);
+  std::vector<uint8_t> dst = RandomBytes(&random, kPayloadLength);
+
+  std::vector<std::pair<std::string, XorFunction>> functions =
+      VectorizedXorFunctions();
+  functions.emplace_back("C", &XorBytes_C);
+  for (const auto& function : functions) {
+    int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kIterations; ++i) {
+      function.second(src.data(), kPayloadLength, dst.data());
+    }
+    int64_t elapsed_us = rtc::TimeMicros() - start_us;
+    RTC_LOG(LS_INFO) << function.first << ": "
+                     << (elapsed_us * 1000.0) / kIterations
+                     << " ns per payload";
+  }
+}
+
+}  // namespace internal
+}  // namespace webrtc
@@ -13,12 +13,14 @@
 #include <string.h>
 
 #include <algorithm>
+#include <iterator>
 #include <utility>
 
 #include "absl/algorithm/container.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/fec_xor.h"
 #include "modules/rtp_rtcp/source/flexfec_header_reader_writer.h"
 #include "modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
@@ -31,6 +33,23 @@ namespace webrtc {
 namespace {
 // Transport header size in bytes. Assume UDP/IPv4 as a reasonable minimum.
 constexpr size_t kTransportOverhead = 28;
+
+// Finds where |packet| goes in the sorted |packets|. Packets mostly arrive in
+// order, so the search starts from the back. Returns false if a packet with
+// the same sequence number is already in |packets|.
+template <typename List>
+bool FindInsertPosition(const List& packets,
+                        const ForwardErrorCorrection::SortablePacket& packet,
+                        typename List::const_iterator* position) {
+  ForwardErrorCorrection::SortablePacket::LessThan less_than;
+  auto it = packets.end();
+  while (it != packets.begin() && less_than(&packet, *std::prev(it)))
+    --it;
+  if (it != packets.begin() && (*std::prev(it))->seq_num == packet.seq_num)
+    return false;
+  *position = it;
+  return true;
+}
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : data(0), ref_count_(0) {}
@@ -361,13 +380,10 @@ void ForwardErrorCorrection::InsertMediaPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, protected_media_ssrc_);
 
-  // Search for duplicate packets.
-  for (const auto& recovered_packet : *recovered_packets) {
-    RTC_DCHECK_EQ(recovered_packet->ssrc, received_packet.ssrc);
-    if (recovered_packet->seq_num == received_packet.seq_num) {
-      // Duplicate packet, no need to add to list.
-      return;
-    }
+  RecoveredPacketList::const_iterator position;
+  if (!FindInsertPosition(*recovered_packets, received_packet, &position)) {
+    // Duplicate packet, no need to add to list.
+    return;
   }
 
   std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
@@ -378,11 +394,8 @@ void ForwardErrorCorrection::InsertMediaPacket(
   recovered_packet->ssrc = received_packet.ssrc;
   recovered_packet->seq_num = received_packet.seq_num;
   recovered_packet->pkt = received_packet.pkt;
-  // TODO(holmer): Consider replacing this with a binary search for the right
-  // position, and then just insert the new packet. Would get rid of the sort.
   RecoveredPacket* recovered_packet_ptr = recovered_packet.get();
-  recovered_packets->push_back(std::move(recovered_packet));
-  recovered_packets->sort(SortablePacket::LessThan());
+  recovered_packets->insert(position, std::move(recovered_packet));
   UpdateCoveringFecPackets(*recovered_packet_ptr);
 }
 
@@ -395,6 +408,10 @@ void ForwardErrorCorrection::UpdateCoveringFecPackets(
     if (protected_it != fec_packet->protected_packets.end() &&
         (*protected_it)->seq_num == packet.seq_num) {
       // Found an FEC packet which is protecting |packet|.
+      if ((*protected_it)->pkt == nullptr) {
+        RTC_DCHECK_GT(fec_packet->num_protected_packets_missing, 0);
+        --fec_packet->num_protected_packets_missing;
+      }
       (*protected_it)->pkt = packet.pkt;
     }
   }
@@ -405,13 +422,10 @@ void ForwardErrorCorrection::InsertFecPacket(
     const ReceivedPacket& received_packet) {
   RTC_DCHECK_EQ(received_packet.ssrc, ssrc_);
 
-  // Check for duplicate.
-  for (const auto& existing_fec_packet : received_fec_packets_) {
-    RTC_DCHECK_EQ(existing_fec_packet->ssrc, received_packet.ssrc);
-    if (existing_fec_packet->seq_num == received_packet.seq_num) {
-      // Drop duplicate FEC packet data.
-      return;
-    }
+  ReceivedFecPacketList::const_iterator position;
+  if (!FindInsertPosition(received_fec_packets_, received_packet, &position)) {
+    // Drop duplicate FEC packet data.
+    return;
   }
 
   std::unique_ptr<ReceivedFecPacket> fec_packet(new ReceivedFecPacket());
@@ -438,6 +452,7 @@ void ForwardErrorCorrection::InsertFecPacket(
   }
 
   // Parse packet mask from header and represent as protected packets.
+  fec_packet->protected_packets.reserve(fec_packet->packet_mask_size * 8);
   for (uint16_t byte_idx = 0; byte_idx < fec_packet->packet_mask_size;
        ++byte_idx) {
     uint8_t packet_mask =
@@ -455,16 +470,15 @@ void ForwardErrorCorrection::InsertFecPacket(
       }
     }
   }
+  fec_packet->num_protected_packets_missing =
+      fec_packet->protected_packets.size();
 
   if (fec_packet->protected_packets.empty()) {
     // All-zero packet mask; we can discard this FEC packet.
     RTC_LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
   } else {
     AssignRecoveredPackets(recovered_packets, fec_packet.get());
-    // TODO(holmer): Consider replacing this with a binary search for the right
-    // position, and then just insert the new packet. Would get rid of the sort.
-    received_fec_packets_.push_back(std::move(fec_packet));
-    received_fec_packets_.sort(SortablePacket::LessThan());
+    received_fec_packets_.insert(position, std::move(fec_packet));
     const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
     if (received_fec_packets_.size() > max_fec_packets) {
       received_fec_packets_.pop_front();
@@ -477,7 +491,6 @@ void ForwardErrorCorrection::AssignRecoveredPackets(
     const RecoveredPacketList& recovered_packets,
     ReceivedFecPacket* fec_packet) {
   ProtectedPacketList* protected_packets = &fec_packet->protected_packets;
-  std::vector<RecoveredPacket*> recovered_protected_packets;
 
   // Find intersection between the (sorted) containers |protected_packets|
   // and |recovered_packets|, i.e. all protected packets that have already
@@ -494,6 +507,7 @@ void ForwardErrorCorrection::AssignRecoveredPackets(
     } else {  // *it_p == *it_r.
       // This protected packet has already been recovered.
       (*it_p)->pkt = (*it_r)->pkt;
+      --fec_packet->num_protected_packets_missing;
       ++it_p;
       ++it_r;
     }
@@ -635,11 +649,8 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   if (dst_offset + payload_length > dst->data.size()) {
     dst->data.SetSize(dst_offset + payload_length);
   }
-  uint8_t* dst_data = dst->data.data();
-  const uint8_t* src_data = src.data.cdata();
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst_data[dst_offset + i] ^= src_data[kRtpHeaderSize + i];
-  }
+  internal::XorBytes(src.data.cdata() + kRtpHeaderSize, payload_length,
+                     dst->data.data() + dst_offset);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -685,12 +696,12 @@ void ForwardErrorCorrection::AttemptRecovery(
       auto* recovered_packet_ptr = recovered_packet.get();
       // Add recovered packet to the list of recovered packets and update any
       // FEC packets covering this packet with a pointer to the data.
-      // TODO(holmer): Consider replacing this with a binary search for the
-      // right position, and then just insert the new packet. Would get rid of
-      // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
-      recovered_packets->sort(SortablePacket::LessThan());
-      UpdateCoveringFecPackets(*recovered_packet_ptr);
+      RecoveredPacketList::const_iterator position;
+      if (FindInsertPosition(*recovered_packets, *recovered_packet_ptr,
+                             &position)) {
+        recovered_packets->insert(position, std::move(recovered_packet));
+        UpdateCoveringFecPackets(*recovered_packet_ptr);
+      }
       DiscardOldRecoveredPackets(recovered_packets);
       fec_packet_it = received_fec_packets_.erase(fec_packet_it);
 
@@ -710,16 +721,7 @@ void ForwardErrorCorrection::AttemptRecovery(
 
 int ForwardErrorCorrection::NumCoveredPacketsMissing(
     const ReceivedFecPacket& fec_packet) {
-  int packets_missing = 0;
-  for (const auto& protected_packet : fec_packet.protected_packets) {
-    if (protected_packet->pkt == nullptr) {
-      ++packets_missing;
-      if (packets_missing > 1) {
-        break;  // We can't recover more than one packet.
-      }
-    }
-  }
-  return packets_missing;
+  return std::min<size_t>(fec_packet.num_protected_packets_missing, 2);
 }
 
 void ForwardErrorCorrection::DiscardOldRecoveredPackets(
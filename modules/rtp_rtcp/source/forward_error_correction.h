@@ -115,7 +115,7 @@ class ForwardErrorCorrection {
     rtc::scoped_refptr<ForwardErrorCorrection::Packet> pkt;
   };
 
-  using ProtectedPacketList = std::list<std::unique_ptr<ProtectedPacket>>;
+  using ProtectedPacketList = std::vector<std::unique_ptr<ProtectedPacket>>;
 
   // Used for internal storage of received FEC packets in a list.
   //
@@ -125,8 +125,12 @@ class ForwardErrorCorrection {
     ReceivedFecPacket();
     ~ReceivedFecPacket();
 
-    // List of media packets that this FEC packet protects.
+    // List of media packets that this FEC packet protects, sorted by sequence
+    // number.
     ProtectedPacketList protected_packets;
+    // Number of |protected_packets| that have not been received or recovered,
+    // i.e. whose |pkt| is null.
+    size_t num_protected_packets_missing;
     // RTP header fields.
     uint32_t ssrc;
     // FEC header fields.
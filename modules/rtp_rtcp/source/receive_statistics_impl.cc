@@ -10,9 +10,11 @@
 
 #include "modules/rtp_rtcp/source/receive_statistics_impl.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "modules/remote_bitrate_estimator/test/bwe_test_logging.h"
@@ -298,10 +300,13 @@ std::unique_ptr<ReceiveStatistics> ReceiveStatistics::Create(Clock* clock) {
   return std::make_unique<ReceiveStatisticsImpl>(clock);
 }
 
+constexpr size_t ReceiveStatisticsImpl::kMaxLockFreeStreams;
+
 ReceiveStatisticsImpl::ReceiveStatisticsImpl(Clock* clock)
     : clock_(clock),
       last_returned_ssrc_(0),
-      max_reordering_threshold_(kDefaultMaxReorderingThreshold) {}
+      max_reordering_threshold_(kDefaultMaxReorderingThreshold),
+      num_lock_free_streams_(0) {}
 
 ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
   while (!statisticians_.empty()) {
@@ -320,6 +325,9 @@ void ReceiveStatisticsImpl::OnRtpPacket(const RtpPacketReceived& packet) {
 
 StreamStatisticianImpl* ReceiveStatisticsImpl::GetStatistician(
     uint32_t ssrc) const {
+  StreamStatisticianImpl* statistician = FindLockFreeStatistician(ssrc);
+  if (statistician)
+    return statistician;
   rtc::CritScope cs(&receive_statistics_lock_);
   const auto& it = statisticians_.find(ssrc);
   if (it == statisticians_.end())
@@ -329,14 +337,36 @@ StreamStatisticianImpl* ReceiveStatisticsImpl::GetStatistician(
 
 StreamStatisticianImpl* ReceiveStatisticsImpl::GetOrCreateStatistician(
     uint32_t ssrc) {
+  StreamStatisticianImpl* statistician = FindLockFreeStatistician(ssrc);
+  if (statistician)
+    return statistician;
   rtc::CritScope cs(&receive_statistics_lock_);
   StreamStatisticianImpl*& impl = statisticians_[ssrc];
   if (impl == nullptr) {  // new element
     impl = new StreamStatisticianImpl(ssrc, clock_, max_reordering_threshold_);
+    const size_t num_lock_free_streams =
+        num_lock_free_streams_.load(std::memory_order_relaxed);
+    if (num_lock_free_streams < kMaxLockFreeStreams) {
+      lock_free_ssrcs_[num_lock_free_streams] = ssrc;
+      lock_free_statisticians_[num_lock_free_streams] = impl;
+      num_lock_free_streams_.store(num_lock_free_streams + 1,
+                                   std::memory_order_release);
+    }
   }
   return impl;
 }
 
+StreamStatisticianImpl* ReceiveStatisticsImpl::FindLockFreeStatistician(
+    uint32_t ssrc) const {
+  const size_t num_lock_free_streams =
+      num_lock_free_streams_.load(std::memory_order_acquire);
+  for (size_t i = 0; i < num_lock_free_streams; ++i) {
+    if (lock_free_ssrcs_[i] == ssrc)
+      return lock_free_statisticians_[i];
+  }
+  return nullptr;
+}
+
 void ReceiveStatisticsImpl::SetMaxReorderingThreshold(
     int max_reordering_threshold) {
   std::map<uint32_t, StreamStatisticianImpl*> statisticians;
@@ -364,10 +394,11 @@ void ReceiveStatisticsImpl::EnableRetransmitDetection(uint32_t ssrc,
 
 std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
     size_t max_blocks) {
-  std::map<uint32_t, StreamStatisticianImpl*> statisticians;
+  // A flat copy, sorted by ssrc, keeps the lock short with many streams.
+  std::vector<std::pair<uint32_t, StreamStatisticianImpl*>> statisticians;
   {
     rtc::CritScope cs(&receive_statistics_lock_);
-    statisticians = statisticians_;
+    statisticians.assign(statisticians_.begin(), statisticians_.end());
   }
   std::vector<rtcp::ReportBlock> result;
   result.reserve(std::min(max_blocks, statisticians.size()));
@@ -390,7 +421,12 @@ std::vector<rtcp::ReportBlock> ReceiveStatisticsImpl::RtcpReportBlocks(
     block.SetJitter(stats.jitter);
   };
 
-  const auto start_it = statisticians.upper_bound(last_returned_ssrc_);
+  const auto start_it = std::upper_bound(
+      statisticians.begin(), statisticians.end(), last_returned_ssrc_,
+      [](uint32_t ssrc,
+         const std::pair<uint32_t, StreamStatisticianImpl*>& statistician) {
+        return ssrc < statistician.first;
+      });
   for (auto it = start_it;
        result.size() < max_blocks && it != statisticians.end(); ++it)
     add_report_block(it->first, it->second);
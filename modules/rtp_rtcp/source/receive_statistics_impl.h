@@ -12,6 +12,7 @@
 #define MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <vector>
 
@@ -120,7 +121,14 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
   void EnableRetransmitDetection(uint32_t ssrc, bool enable) override;
 
  private:
+  // Statisticians are never removed, so the first |kMaxLockFreeStreams| of
+  // them are also published in arrays that are searched without taking
+  // |receive_statistics_lock_|. That covers the media, RTX and FEC streams of
+  // a receive stream, so packets don't contend with RTCP report generation.
+  static constexpr size_t kMaxLockFreeStreams = 8;
+
   StreamStatisticianImpl* GetOrCreateStatistician(uint32_t ssrc);
+  StreamStatisticianImpl* FindLockFreeStatistician(uint32_t ssrc) const;
 
   Clock* const clock_;
   rtc::CriticalSection receive_statistics_lock_;
@@ -128,6 +136,11 @@ class ReceiveStatisticsImpl : public ReceiveStatistics {
   int max_reordering_threshold_ RTC_GUARDED_BY(receive_statistics_lock_);
   std::map<uint32_t, StreamStatisticianImpl*> statisticians_
       RTC_GUARDED_BY(receive_statistics_lock_);
+  // An entry is written once, before |num_lock_free_streams_| is increased to
+  // include it.
+  uint32_t lock_free_ssrcs_[kMaxLockFreeStreams];
+  StreamStatisticianImpl* lock_free_statisticians_[kMaxLockFreeStreams];
+  std::atomic<size_t> num_lock_free_streams_;
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
@@ -206,6 +206,36 @@ TEST_F(ReceiveStatisticsTest, ActiveStatisticians) {
   EXPECT_EQ(2u, counters.transmitted.packets);
 }
 
+TEST_F(ReceiveStatisticsTest, ManySsrcs) {
+  constexpr uint32_t kNumSsrcs = 50;
+  for (int i = 0; i < 3; ++i) {
+    for (uint32_t ssrc = kNumSsrcs; ssrc > 0; --ssrc) {
+      RtpPacketReceived packet = CreateRtpPacket(ssrc, kPacketSize1);
+      packet.SetSequenceNumber(i);
+      receive_statistics_->OnRtpPacket(packet);
+    }
+  }
+  for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+    StreamStatistician* statistician =
+        receive_statistics_->GetStatistician(ssrc);
+    ASSERT_TRUE(statistician);
+    EXPECT_EQ(3u, statistician->GetReceiveStreamDataCounters()
+                      .transmitted.packets);
+  }
+  EXPECT_FALSE(receive_statistics_->GetStatistician(kNumSsrcs + 1));
+
+  // Report blocks go round robin in ssrc order.
+  std::vector<rtcp::ReportBlock> report_blocks =
+      receive_statistics_->RtcpReportBlocks(30);
+  ASSERT_THAT(report_blocks, SizeIs(30));
+  EXPECT_EQ(1u, report_blocks.front().source_ssrc());
+  EXPECT_EQ(30u, report_blocks.back().source_ssrc());
+  report_blocks = receive_statistics_->RtcpReportBlocks(30);
+  ASSERT_THAT(report_blocks, SizeIs(30));
+  EXPECT_EQ(31u, report_blocks.front().source_ssrc());
+  EXPECT_EQ(10u, report_blocks.back().source_ssrc());
+}
+
 TEST_F(ReceiveStatisticsTest,
        DoesntCreateRtcpReportBlockUntilFirstReceivedPacketForSsrc) {
   // Creates a statistician object for the ssrc.
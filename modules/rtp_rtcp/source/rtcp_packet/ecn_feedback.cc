@@ -0,0 +1,104 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
+
+#include "modules/rtp_rtcp/source/byte_io.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace webrtc {
+namespace rtcp {
+constexpr uint8_t EcnFeedback::kFeedbackMessageType;
+constexpr size_t EcnFeedback::kFciLength;
+
+// RFC 6679, Section 5.1: RTP/AVPF Transport-Layer ECN Feedback Packet.
+//
+//   0                   1                   2                   3
+//   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |V=2|P|  FMT=8  |     PT=205    |         length=7              |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                  SSRC of packet sender                        |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  |                  SSRC of media source                         |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  | Extended Highest Sequence Number                              |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  | ECT (0) Counter                                               |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  | ECT (1) Counter                                               |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  | ECN-CE Counter                | not-ECT Counter               |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+//  | Lost Packets Counter          | Duplication Counter           |
+//  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+EcnFeedback::EcnFeedback() = default;
+
+EcnFeedback::EcnFeedback(const EcnFeedback& rhs) = default;
+
+EcnFeedback::~EcnFeedback() = default;
+
+bool EcnFeedback::Parse(const CommonHeader& packet) {
+  RTC_DCHECK_EQ(packet.type(), kPacketType);
+  RTC_DCHECK_EQ(packet.fmt(), kFeedbackMessageType);
+
+  if (packet.payload_size_bytes() != kCommonFeedbackLength + kFciLength) {
+    RTC_LOG(LS_WARNING) << "Packet payload size should be "
+                        << kCommonFeedbackLength + kFciLength
+                        << " instead of " << packet.payload_size_bytes()
+                        << " to be a valid ECN feedback";
+    return false;
+  }
+
+  ParseCommonFeedback(packet.payload());
+  const uint8_t* fci = packet.payload() + kCommonFeedbackLength;
+  extended_highest_sequence_number_ = ByteReader<uint32_t>::ReadBigEndian(fci);
+  ect0_count_ = ByteReader<uint32_t>::ReadBigEndian(fci + 4);
+  ect1_count_ = ByteReader<uint32_t>::ReadBigEndian(fci + 8);
+  ce_count_ = ByteReader<uint16_t>::ReadBigEndian(fci + 12);
+  not_ect_count_ = ByteReader<uint16_t>::ReadBigEndian(fci + 14);
+  lost_packets_count_ = ByteReader<uint16_t>::ReadBigEndian(fci + 16);
+  duplicates_count_ = ByteReader<uint16_t>::ReadBigEndian(fci + 18);
+  return true;
+}
+
+size_t EcnFeedback::BlockLength() const {
+  return kHeaderLength + kCommonFeedbackLength + kFciLength;
+}
+
+bool EcnFeedback::Create(uint8_t* packet,
+                         size_t* index,
+                         size_t max_length,
+                         PacketReadyCallback callback) const {
+  while (*index + BlockLength() > max_length) {
+    if (!OnBufferFull(packet, index, callback))
+      return false;
+  }
+
+  CreateHeader(kFeedbackMessageType, kPacketType, HeaderLength(), packet,
+               index);
+  CreateCommonFeedback(packet + *index);
+  *index += kCommonFeedbackLength;
+  uint8_t* fci = packet + *index;
+  ByteWriter<uint32_t>::WriteBigEndian(fci, extended_highest_sequence_number_);
+  ByteWriter<uint32_t>::WriteBigEndian(fci + 4, ect0_count_);
+  ByteWriter<uint32_t>::WriteBigEndian(fci + 8, ect1_count_);
+  ByteWriter<uint16_t>::WriteBigEndian(fci + 12, ce_count_);
+  ByteWriter<uint16_t>::WriteBigEndian(fci + 14, not_ect_count_);
+  ByteWriter<uint16_t>::WriteBigEndian(fci + 16, lost_packets_count_);
+  ByteWriter<uint16_t>::WriteBigEndian(fci + 18, duplicates_count_);
+  *index += kFciLength;
+  return true;
+}
+
+}  // namespace rtcp
+}  // namespace webrtc
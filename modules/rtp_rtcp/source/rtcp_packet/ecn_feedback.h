@@ -0,0 +1,77 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_ECN_FEEDBACK_H_
+#define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_ECN_FEEDBACK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
+
+namespace webrtc {
+namespace rtcp {
+class CommonHeader;
+
+// RTCP ECN Feedback, RFC 6679 Section 5.1. All counters are cumulative since
+// the start of the session; the 16 bit counters wrap around.
+class EcnFeedback : public Rtpfb {
+ public:
+  static constexpr uint8_t kFeedbackMessageType = 8;
+
+  EcnFeedback();
+  EcnFeedback(const EcnFeedback&);
+  ~EcnFeedback() override;
+
+  // Parse assumes header is already parsed and validated.
+  bool Parse(const CommonHeader& packet);
+
+  void SetExtendedHighestSequenceNumber(uint32_t sequence_number) {
+    extended_highest_sequence_number_ = sequence_number;
+  }
+  void SetEct0Count(uint32_t count) { ect0_count_ = count; }
+  void SetEct1Count(uint32_t count) { ect1_count_ = count; }
+  void SetCeCount(uint16_t count) { ce_count_ = count; }
+  void SetNotEctCount(uint16_t count) { not_ect_count_ = count; }
+  void SetLostPacketsCount(uint16_t count) { lost_packets_count_ = count; }
+  void SetDuplicatesCount(uint16_t count) { duplicates_count_ = count; }
+
+  uint32_t extended_highest_sequence_number() const {
+    return extended_highest_sequence_number_;
+  }
+  uint32_t ect0_count() const { return ect0_count_; }
+  uint32_t ect1_count() const { return ect1_count_; }
+  uint16_t ce_count() const { return ce_count_; }
+  uint16_t not_ect_count() const { return not_ect_count_; }
+  uint16_t lost_packets_count() const { return lost_packets_count_; }
+  uint16_t duplicates_count() const { return duplicates_count_; }
+
+  size_t BlockLength() const override;
+
+  bool Create(uint8_t* packet,
+              size_t* index,
+              size_t max_length,
+              PacketReadyCallback callback) const override;
+
+ private:
+  static constexpr size_t kFciLength = 20;
+
+  uint32_t extended_highest_sequence_number_ = 0;
+  uint32_t ect0_count_ = 0;
+  uint32_t ect1_count_ = 0;
+  uint16_t ce_count_ = 0;
+  uint16_t not_ect_count_ = 0;
+  uint16_t lost_packets_count_ = 0;
+  uint16_t duplicates_count_ = 0;
+};
+
+}  // namespace rtcp
+}  // namespace webrtc
+#endif  // MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_ECN_FEEDBACK_H_
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+#include "test/rtcp_packet_parser.h"
+
+using ::testing::ElementsAreArray;
+using ::testing::make_tuple;
+using webrtc::rtcp::EcnFeedback;
+
+namespace webrtc {
+namespace {
+const uint32_t kSenderSsrc = 0x12345678;
+const uint32_t kRemoteSsrc = 0x23456789;
+const uint32_t kExtendedHighestSequenceNumber = 0x00012345;
+const uint32_t kEct0Count = 0x00010203;
+const uint32_t kEct1Count = 0x00000004;
+const uint16_t kCeCount = 0x0506;
+const uint16_t kNotEctCount = 0x0007;
+const uint16_t kLostPacketsCount = 0x0809;
+const uint16_t kDuplicatesCount = 0x000a;
+// Manually created packet matching constants above.
+const uint8_t kPacket[] = {0x88, 205,  0x00, 0x07, 0x12, 0x34, 0x56, 0x78,
+                           0x23, 0x45, 0x67, 0x89, 0x00, 0x01, 0x23, 0x45,
+                           0x00, 0x01, 0x02, 0x03, 0x00, 0x00, 0x00, 0x04,
+                           0x05, 0x06, 0x00, 0x07, 0x08, 0x09, 0x00, 0x0a};
+}  // namespace
+
+TEST(RtcpPacketEcnFeedbackTest, Parse) {
+  EcnFeedback mutable_parsed;
+  EXPECT_TRUE(test::ParseSinglePacket(kPacket, &mutable_parsed));
+  const EcnFeedback& parsed = mutable_parsed;
+
+  EXPECT_EQ(kSenderSsrc, parsed.sender_ssrc());
+  EXPECT_EQ(kRemoteSsrc, parsed.media_ssrc());
+  EXPECT_EQ(kExtendedHighestSequenceNumber,
+            parsed.extended_highest_sequence_number());
+  EXPECT_EQ(kEct0Count, parsed.ect0_count());
+  EXPECT_EQ(kEct1Count, parsed.ect1_count());
+  EXPECT_EQ(kCeCount, parsed.ce_count());
+  EXPECT_EQ(kNotEctCount, parsed.not_ect_count());
+  EXPECT_EQ(kLostPacketsCount, parsed.lost_packets_count());
+  EXPECT_EQ(kDuplicatesCount, parsed.duplicates_count());
+}
+
+TEST(RtcpPacketEcnFeedbackTest, Create) {
+  EcnFeedback ecn;
+  ecn.SetSenderSsrc(kSenderSsrc);
+  ecn.SetMediaSsrc(kRemoteSsrc);
+  ecn.SetExtendedHighestSequenceNumber(kExtendedHighestSequenceNumber);
+  ecn.SetEct0Count(kEct0Count);
+  ecn.SetEct1Count(kEct1Count);
+  ecn.SetCeCount(kCeCount);
+  ecn.SetNotEctCount(kNotEctCount);
+  ecn.SetLostPacketsCount(kLostPacketsCount);
+  ecn.SetDuplicatesCount(kDuplicatesCount);
+
+  rtc::Buffer packet = ecn.Build();
+
+  EXPECT_THAT(make_tuple(packet.data(), packet.size()),
+              ElementsAreArray(kPacket));
+}
+
+TEST(RtcpPacketEcnFeedbackTest, ParseFailsOnTooSmallPacket) {
+  const uint8_t kTooSmallPacket[] = {0x88, 205,  0x00, 0x02, 0x12, 0x34,
+                                     0x56, 0x78, 0x23, 0x45, 0x67, 0x89};
+  EcnFeedback parsed;
+  EXPECT_FALSE(test::ParseSinglePacket(kTooSmallPacket, &parsed));
+}
+
+}  // namespace webrtc
@@ -74,6 +74,7 @@ constexpr int64_t kTimeWrapPeriodUs = (1ll << 24) * kBaseScaleFactor;
 }  // namespace
 constexpr uint8_t TransportFeedback::kFeedbackMessageType;
 constexpr size_t TransportFeedback::kMaxReportedPackets;
+constexpr int64_t TransportFeedback::kNotReceived;
 
 constexpr size_t TransportFeedback::LastChunk::kMaxRunLengthCapacity;
 constexpr size_t TransportFeedback::LastChunk::kMaxOneBitCapacity;
@@ -313,11 +314,15 @@ bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
   // encoding process.
   int16_t delta = 0;
   if (include_timestamps_) {
-    // Convert to ticks and round.
-    int64_t delta_full =
-        (timestamp_us - last_timestamp_us_) % kTimeWrapPeriodUs;
-    if (delta_full > kTimeWrapPeriodUs / 2)
-      delta_full -= kTimeWrapPeriodUs;
+    // Convert to ticks and round. Only deltas beyond half the wrap period
+    // need the comparatively slow modulo.
+    int64_t delta_full = timestamp_us - last_timestamp_us_;
+    if (delta_full <= -kTimeWrapPeriodUs ||
+        delta_full > kTimeWrapPeriodUs / 2) {
+      delta_full %= kTimeWrapPeriodUs;
+      if (delta_full > kTimeWrapPeriodUs / 2)
+        delta_full -= kTimeWrapPeriodUs;
+    }
     delta_full +=
         delta_full < 0 ? -(kDeltaScaleFactor / 2) : kDeltaScaleFactor / 2;
     delta_full /= kDeltaScaleFactor;
@@ -352,6 +357,15 @@ bool TransportFeedback::AddReceivedPacket(uint16_t sequence_number,
   return true;
 }
 
+void TransportFeedback::ReservePackets(size_t num_packets) {
+  num_packets = std::min(num_packets, kMaxReportedPackets);
+  received_packets_.reserve(num_packets);
+  if (include_lost_)
+    all_packets_.reserve(num_packets);
+  // A chunk holds at least 7 packets.
+  encoded_chunks_.reserve(num_packets / 7 + 1);
+}
+
 const std::vector<TransportFeedback::ReceivedPacket>&
 TransportFeedback::GetReceivedPackets() const {
   return received_packets_;
@@ -367,6 +381,23 @@ uint16_t TransportFeedback::GetBaseSequence() const {
   return base_seq_no_;
 }
 
+void TransportFeedback::ForAllPackets(
+    rtc::FunctionView<void(uint16_t, int64_t)> handler) const {
+  int64_t delta_since_base_us = 0;
+  uint16_t seq_no = base_seq_no_;
+  for (const ReceivedPacket& packet : received_packets_) {
+    for (; seq_no != packet.sequence_number(); ++seq_no)
+      handler(seq_no, kNotReceived);
+    delta_since_base_us += packet.delta_us();
+    handler(seq_no, delta_since_base_us);
+    ++seq_no;
+  }
+  for (uint16_t end_seq_no = base_seq_no_ + num_seq_no_; seq_no != end_seq_no;
+       ++seq_no) {
+    handler(seq_no, kNotReceived);
+  }
+}
+
 int64_t TransportFeedback::GetBaseTimeUs() const {
   return static_cast<int64_t>(base_time_ticks_) * kBaseScaleFactor;
 }
@@ -435,9 +466,14 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
 
   uint16_t seq_no = base_seq_no_;
   size_t recv_delta_size = 0;
+  size_t num_received = 0;
   for (size_t delta_size : delta_sizes) {
     recv_delta_size += delta_size;
+    num_received += delta_size > 0 ? 1 : 0;
   }
+  received_packets_.reserve(num_received);
+  if (include_lost_)
+    all_packets_.reserve(status_count);
 
   // Determine if timestamps, that is, recv_delta are included in the packet.
   if (end_index >= index + recv_delta_size) {
@@ -11,9 +11,11 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_TRANSPORT_FEEDBACK_H_
 #define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_TRANSPORT_FEEDBACK_H_
 
+#include <limits>
 #include <memory>
 #include <vector>
 
+#include "api/function_view.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/rtpfb.h"
 
 namespace webrtc {
@@ -49,6 +51,8 @@ class TransportFeedback : public Rtpfb {
   static constexpr int kDeltaScaleFactor = 250;
   // Maximum number of packets (including missing) TransportFeedback can report.
   static constexpr size_t kMaxReportedPackets = 0xffff;
+  // Passed to ForAllPackets() handlers for packets that were not received.
+  static constexpr int64_t kNotReceived = std::numeric_limits<int64_t>::max();
 
   TransportFeedback();
 
@@ -64,10 +68,19 @@ class TransportFeedback : public Rtpfb {
   void SetBase(uint16_t base_sequence,     // Seq# of first packet in this msg.
                int64_t ref_timestamp_us);  // Reference timestamp for this msg.
   void SetFeedbackSequenceNumber(uint8_t feedback_sequence);
+  // Pre-sizes the buffers so that adding up to |num_packets| packets, received
+  // or not, doesn't reallocate.
+  void ReservePackets(size_t num_packets);
   // NOTE: This method requires increasing sequence numbers (excepting wraps).
   bool AddReceivedPacket(uint16_t sequence_number, int64_t timestamp_us);
   const std::vector<ReceivedPacket>& GetReceivedPackets() const;
   const std::vector<ReceivedPacket>& GetAllPackets() const;
+  // Calls |handler| for all packets this feedback describes, in sequence
+  // number order, with the receive time relative to GetBaseTimeUs(), or
+  // kNotReceived for missing packets.
+  void ForAllPackets(
+      rtc::FunctionView<void(uint16_t sequence_number,
+                             int64_t delta_since_base_us)> handler) const;
 
   uint16_t GetBaseSequence() const;
 
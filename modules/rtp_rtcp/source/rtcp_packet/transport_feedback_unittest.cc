@@ -13,9 +13,12 @@
 #include <limits>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "modules/rtp_rtcp/source/byte_io.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -23,6 +26,7 @@ namespace webrtc {
 namespace {
 
 using rtcp::TransportFeedback;
+using ::testing::ElementsAre;
 using ::testing::ElementsAreArray;
 
 static const int kHeaderSize = 20;
@@ -602,5 +606,67 @@ TEST(TransportFeedbackTest, ReportsMissingPacketsWithoutTimestamps) {
   EXPECT_FALSE(packets[2].received());
   EXPECT_TRUE(packets[3].received());
 }
+
+TEST(TransportFeedbackTest, ForAllPacketsVisitsLostAndReceivedPackets) {
+  const uint16_t kBaseSeqNo = 0xfffe;
+  // A multiple of the 64 ms base time resolution.
+  const int64_t kBaseTimestampUs = 256000;
+  TransportFeedback feedback_builder;
+  feedback_builder.SetBase(kBaseSeqNo, kBaseTimestampUs);
+  feedback_builder.ReservePackets(4);
+  feedback_builder.AddReceivedPacket(kBaseSeqNo + 0, kBaseTimestampUs);
+  // The sequence numbers wrap after two lost packets.
+  feedback_builder.AddReceivedPacket(1, kBaseTimestampUs + 2000);
+  feedback_builder.AddReceivedPacket(2, kBaseTimestampUs + 2500);
+  rtc::Buffer coded = feedback_builder.Build();
+  std::unique_ptr<TransportFeedback> feedback =
+      TransportFeedback::ParseFrom(coded.data(), coded.size());
+  ASSERT_TRUE(feedback);
+
+  std::vector<uint16_t> sequence_numbers;
+  std::vector<int64_t> deltas_us;
+  feedback->ForAllPackets(
+      [&](uint16_t sequence_number, int64_t delta_since_base_us) {
+        sequence_numbers.push_back(sequence_number);
+        deltas_us.push_back(delta_since_base_us);
+      });
+  const int64_t kLost = TransportFeedback::kNotReceived;
+  EXPECT_THAT(sequence_numbers, ElementsAre(0xfffe, 0xffff, 0, 1, 2));
+  EXPECT_THAT(deltas_us, ElementsAre(0, kLost, kLost, 2000, 2500));
+}
+
+TEST(TransportFeedbackTest, DISABLED_BuildAndParsePerf) {
+  // About 100 ms of packets at 10000 packets per second, with some losses.
+  constexpr uint16_t kNumPackets = 1000;
+  constexpr int kNumIterations = 10000;
+  const uint16_t kBaseSeqNo = 0xfff0;
+  size_t num_received = 0;
+  int64_t build_us = 0;
+  int64_t parse_us = 0;
+  for (int i = 0; i < kNumIterations; ++i) {
+    int64_t start_us = rtc::TimeMicros();
+    TransportFeedback builder;
+    builder.SetBase(kBaseSeqNo, 10000);
+    builder.ReservePackets(kNumPackets);
+    for (uint16_t seq = 0; seq < kNumPackets; ++seq) {
+      if (seq % 50 != 7)
+        builder.AddReceivedPacket(kBaseSeqNo + seq, 10000 + seq * 100);
+    }
+    rtc::Buffer packet = builder.Build();
+    build_us += rtc::TimeMicros() - start_us;
+
+    start_us = rtc::TimeMicros();
+    std::unique_ptr<TransportFeedback> parsed =
+        TransportFeedback::ParseFrom(packet.data(), packet.size());
+    parse_us += rtc::TimeMicros() - start_us;
+    num_received += parsed->GetReceivedPackets().size();
+  }
+  EXPECT_EQ(kNumIterations * (kNumPackets - kNumPackets / 50), num_received);
+  RTC_LOG(LS_INFO) << "Per feedback of " << kNumPackets << " packets, build: "
+                   << build_us * 1000 / kNumIterations
+                   << " ns, parse: " << parse_us * 1000 / kNumIterations
+                   << " ns.";
+}
+
 }  // namespace
 }  // namespace webrtc
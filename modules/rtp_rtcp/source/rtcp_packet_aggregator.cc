@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet_aggregator.h"
+
+#include <algorithm>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Returns true if |packet| is a valid compound packet that only carries
+// reports, which can wait for the reports of other streams.
+bool IsReportOnly(const uint8_t* packet, size_t length) {
+  const uint8_t* const end = packet + length;
+  rtcp::CommonHeader header;
+  for (const uint8_t* next = packet; next != end;
+       next = header.NextPacket()) {
+    if (!header.Parse(next, end - next))
+      return false;
+    switch (header.type()) {
+      case rtcp::SenderReport::kPacketType:
+      case rtcp::ReceiverReport::kPacketType:
+      case rtcp::Sdes::kPacketType:
+      case rtcp::ExtendedReports::kPacketType:
+        break;
+      default:
+        return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+constexpr int64_t RtcpPacketAggregator::kDefaultMaxHoldMs;
+
+RtcpPacketAggregator::RtcpPacketAggregator(Clock* clock,
+                                           Transport* transport,
+                                           size_t max_packet_size,
+                                           int64_t max_hold_ms)
+    : clock_(clock),
+      transport_(transport),
+      max_packet_size_(max_packet_size),
+      max_hold_ms_(max_hold_ms) {
+  RTC_DCHECK(transport_);
+  RTC_DCHECK_GE(max_hold_ms_, 0);
+}
+
+RtcpPacketAggregator::~RtcpPacketAggregator() {
+  Flush();
+}
+
+bool RtcpPacketAggregator::SendRtp(const uint8_t* packet,
+                                   size_t length,
+                                   const PacketOptions& options) {
+  return transport_->SendRtp(packet, length, options);
+}
+
+bool RtcpPacketAggregator::SendRtcp(const uint8_t* packet, size_t length) {
+  const bool report_only = IsReportOnly(packet, length);
+  rtc::CritScope lock(&crit_);
+  if (pending_.size() + length > max_packet_size_)
+    FlushLocked();
+  if (length > max_packet_size_ || (!report_only && pending_.empty()))
+    return transport_->SendRtcp(packet, length);
+
+  // Held reports go first, so the merged packet still starts with a report.
+  pending_.AppendData(packet, length);
+  if (!report_only)
+    return FlushLocked();
+  if (pending_since_ms_ < 0)
+    pending_since_ms_ = clock_->TimeInMilliseconds();
+  return true;
+}
+
+void RtcpPacketAggregator::Flush() {
+  rtc::CritScope lock(&crit_);
+  FlushLocked();
+}
+
+int64_t RtcpPacketAggregator::TimeUntilNextProcess() {
+  rtc::CritScope lock(&crit_);
+  if (pending_since_ms_ < 0)
+    return max_hold_ms_;
+  return std::max<int64_t>(
+      0, pending_since_ms_ + max_hold_ms_ - clock_->TimeInMilliseconds());
+}
+
+void RtcpPacketAggregator::Process() {
+  rtc::CritScope lock(&crit_);
+  if (pending_since_ms_ >= 0 &&
+      clock_->TimeInMilliseconds() - pending_since_ms_ >= max_hold_ms_) {
+    FlushLocked();
+  }
+}
+
+bool RtcpPacketAggregator::FlushLocked() {
+  if (pending_.empty())
+    return true;
+  bool sent = transport_->SendRtcp(pending_.data(), pending_.size());
+  pending_.Clear();
+  pending_since_ms_ = -1;
+  return sent;
+}
+
+}  // namespace webrtc
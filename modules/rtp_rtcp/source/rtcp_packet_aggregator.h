@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_AGGREGATOR_H_
+#define MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_AGGREGATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/call/transport.h"
+#include "modules/include/module.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Merges the RTCP compound packets of several RTP/RTCP modules that share one
+// transport, e.g. all streams of a bundled transport, into fewer and larger
+// packets. Pass the aggregator as RtpRtcp::Configuration::outgoing_transport
+// of each module and register it with the process thread.
+//
+// Compound packets carrying only reports (SR, RR, SDES and XR) are held for
+// at most |max_hold_ms|, so that the reports of other modules can be sent in
+// the same packet. Anything else, e.g. NACK, PLI or transport feedback, is
+// sent at once, together with the held reports. Since the delay since last
+// SR is computed when a report is built, holding it biases the round trip
+// time seen by the remote end, so |max_hold_ms| should stay in the order of
+// the process thread tick. Use RtpRtcp::Configuration::
+// rtcp_report_alignment_ms to make the modules produce their reports at the
+// same time. RTP packets are passed through. Thread safe.
+class RtcpPacketAggregator : public Transport, public Module {
+ public:
+  static constexpr int64_t kDefaultMaxHoldMs = 10;
+
+  // |max_packet_size| is the largest RTCP packet to send, before any SRTCP
+  // overhead.
+  RtcpPacketAggregator(Clock* clock,
+                       Transport* transport,
+                       size_t max_packet_size,
+                       int64_t max_hold_ms = kDefaultMaxHoldMs);
+  ~RtcpPacketAggregator() override;
+
+  // Transport.
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override;
+  bool SendRtcp(const uint8_t* packet, size_t length) override;
+
+  // Sends any held reports.
+  void Flush();
+
+  // Module.
+  int64_t TimeUntilNextProcess() override;
+  void Process() override;
+
+ private:
+  bool FlushLocked() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Clock* const clock_;
+  Transport* const transport_;
+  const size_t max_packet_size_;
+  const int64_t max_hold_ms_;
+
+  // Held while sending as well, so that packets leave in order.
+  rtc::CriticalSection crit_;
+  rtc::Buffer pending_ RTC_GUARDED_BY(crit_);
+  int64_t pending_since_ms_ RTC_GUARDED_BY(crit_) = -1;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_RTP_RTCP_SOURCE_RTCP_PACKET_AGGREGATOR_H_
@@ -0,0 +1,151 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/rtp_rtcp/source/rtcp_packet_aggregator.h"
+
+#include <vector>
+
+#include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/pli.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "test/gtest.h"
+#include "test/rtcp_packet_parser.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMaxPacketSize = 1200;
+constexpr int64_t kMaxHoldMs = 10;
+
+class RecordingTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    ++rtp_packets;
+    return true;
+  }
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    rtcp_packets.emplace_back(packet, packet + length);
+    return true;
+  }
+
+  int rtp_packets = 0;
+  std::vector<std::vector<uint8_t>> rtcp_packets;
+};
+
+rtc::Buffer BuildReport(uint32_t ssrc) {
+  rtcp::ReceiverReport rr;
+  rr.SetSenderSsrc(ssrc);
+  rtcp::Sdes sdes;
+  sdes.AddCName(ssrc, "cname");
+  rtcp::CompoundPacket compound;
+  compound.Append(&rr);
+  compound.Append(&sdes);
+  return compound.Build();
+}
+
+rtc::Buffer BuildReportWithPli(uint32_t ssrc) {
+  rtcp::ReceiverReport rr;
+  rr.SetSenderSsrc(ssrc);
+  rtcp::Pli pli;
+  pli.SetSenderSsrc(ssrc);
+  pli.SetMediaSsrc(ssrc + 1);
+  rtcp::CompoundPacket compound;
+  compound.Append(&rr);
+  compound.Append(&pli);
+  return compound.Build();
+}
+
+class RtcpPacketAggregatorTest : public ::testing::Test {
+ protected:
+  RtcpPacketAggregatorTest()
+      : clock_(123456),
+        aggregator_(&clock_, &transport_, kMaxPacketSize, kMaxHoldMs) {}
+
+  void Send(const rtc::Buffer& packet) {
+    EXPECT_TRUE(aggregator_.SendRtcp(packet.data(), packet.size()));
+  }
+
+  SimulatedClock clock_;
+  RecordingTransport transport_;
+  RtcpPacketAggregator aggregator_;
+};
+
+TEST_F(RtcpPacketAggregatorTest, MergesReportsUntilHoldTimeExpires) {
+  Send(BuildReport(1));
+  EXPECT_EQ(kMaxHoldMs, aggregator_.TimeUntilNextProcess());
+  clock_.AdvanceTimeMilliseconds(4);
+  Send(BuildReport(2));
+  Send(BuildReport(3));
+  EXPECT_EQ(kMaxHoldMs - 4, aggregator_.TimeUntilNextProcess());
+  aggregator_.Process();
+  EXPECT_TRUE(transport_.rtcp_packets.empty());
+
+  clock_.AdvanceTimeMilliseconds(kMaxHoldMs - 4);
+  EXPECT_EQ(0, aggregator_.TimeUntilNextProcess());
+  aggregator_.Process();
+  ASSERT_EQ(1u, transport_.rtcp_packets.size());
+  test::RtcpPacketParser parser;
+  EXPECT_TRUE(parser.Parse(transport_.rtcp_packets[0].data(),
+                           transport_.rtcp_packets[0].size()));
+  EXPECT_EQ(3, parser.receiver_report()->num_packets());
+  EXPECT_EQ(3, parser.sdes()->num_packets());
+  EXPECT_EQ(kMaxHoldMs, aggregator_.TimeUntilNextProcess());
+}
+
+TEST_F(RtcpPacketAggregatorTest, FeedbackIsSentWithHeldReports) {
+  Send(BuildReport(1));
+  Send(BuildReportWithPli(2));
+  ASSERT_EQ(1u, transport_.rtcp_packets.size());
+  test::RtcpPacketParser parser;
+  EXPECT_TRUE(parser.Parse(transport_.rtcp_packets[0].data(),
+                           transport_.rtcp_packets[0].size()));
+  EXPECT_EQ(2, parser.receiver_report()->num_packets());
+  EXPECT_EQ(1, parser.pli()->num_packets());
+  // The merged packet starts with the held report.
+  EXPECT_EQ(1u, parser.sdes()->num_packets());
+  EXPECT_EQ(rtcp::ReceiverReport::kPacketType, transport_.rtcp_packets[0][1]);
+
+  // Feedback without held reports is passed through as is.
+  rtc::Buffer feedback = BuildReportWithPli(3);
+  Send(feedback);
+  ASSERT_EQ(2u, transport_.rtcp_packets.size());
+  EXPECT_EQ(std::vector<uint8_t>(feedback.begin(), feedback.end()),
+            transport_.rtcp_packets[1]);
+}
+
+TEST_F(RtcpPacketAggregatorTest, MergedPacketsStayWithinMaxSize) {
+  const size_t report_size = BuildReport(0).size();
+  const size_t reports_per_packet = kMaxPacketSize / report_size;
+  for (uint32_t ssrc = 0; ssrc < 100; ++ssrc)
+    Send(BuildReport(ssrc));
+  aggregator_.Flush();
+  size_t total_size = 0;
+  for (const std::vector<uint8_t>& packet : transport_.rtcp_packets) {
+    EXPECT_LE(packet.size(), kMaxPacketSize);
+    total_size += packet.size();
+  }
+  EXPECT_EQ(100 * report_size, total_size);
+  EXPECT_EQ((100 + reports_per_packet - 1) / reports_per_packet,
+            transport_.rtcp_packets.size());
+}
+
+TEST_F(RtcpPacketAggregatorTest, PassesRtpThrough) {
+  Send(BuildReport(1));
+  uint8_t rtp[12] = {0x80};
+  EXPECT_TRUE(aggregator_.SendRtp(rtp, sizeof(rtp), PacketOptions()));
+  EXPECT_EQ(1, transport_.rtp_packets);
+  EXPECT_TRUE(transport_.rtcp_packets.empty());
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -12,6 +12,7 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <limits>
 #include <map>
 #include <memory>
@@ -23,6 +24,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/loss_notification.h"
@@ -78,6 +80,7 @@ struct RTCPReceiver::PacketInformation {
   int64_t rtt_ms = 0;
   uint32_t receiver_estimated_max_bitrate_bps = 0;
   std::unique_ptr<rtcp::TransportFeedback> transport_feedback;
+  std::unique_ptr<rtcp::EcnFeedback> ecn_feedback;
   absl::optional<VideoBitrateAllocation> target_bitrate_allocation;
   absl::optional<NetworkStateEstimate> network_state_estimate;
   std::unique_ptr<rtcp::LossNotification> loss_notification;
@@ -121,6 +124,12 @@ struct RTCPReceiver::LastFirStatus {
   uint8_t sequence_number;
 };
 
+struct RTCPReceiver::ReportBlockEntry {
+  uint32_t source_ssrc;
+  uint32_t remote_ssrc;
+  ReportBlockData data;
+};
+
 RTCPReceiver::RTCPReceiver(const RtpRtcp::Configuration& config,
                            ModuleRtpRtcp* owner)
     : clock_(config.clock),
@@ -153,13 +162,13 @@ RTCPReceiver::RTCPReceiver(const RtpRtcp::Configuration& config,
       last_skipped_packets_warning_ms_(clock_->TimeInMilliseconds()) {
   RTC_DCHECK(owner);
   if (config.local_media_ssrc) {
-    registered_ssrcs_.insert(*config.local_media_ssrc);
+    registered_ssrcs_.push_back(*config.local_media_ssrc);
   }
   if (config.rtx_send_ssrc) {
-    registered_ssrcs_.insert(*config.rtx_send_ssrc);
+    registered_ssrcs_.push_back(*config.rtx_send_ssrc);
   }
   if (config.flexfec_sender) {
-    registered_ssrcs_.insert(config.flexfec_sender->ssrc());
+    registered_ssrcs_.push_back(config.flexfec_sender->ssrc());
   }
 }
 
@@ -198,7 +207,7 @@ void RTCPReceiver::SetSsrcs(uint32_t main_ssrc,
                             const std::set<uint32_t>& registered_ssrcs) {
   rtc::CritScope lock(&rtcp_receiver_lock_);
   main_ssrc_ = main_ssrc;
-  registered_ssrcs_ = registered_ssrcs;
+  registered_ssrcs_.assign(registered_ssrcs.begin(), registered_ssrcs.end());
 }
 
 int32_t RTCPReceiver::RTT(uint32_t remote_ssrc,
@@ -208,15 +217,16 @@ int32_t RTCPReceiver::RTT(uint32_t remote_ssrc,
                           int64_t* max_rtt_ms) const {
   rtc::CritScope lock(&rtcp_receiver_lock_);
 
-  auto it = received_report_blocks_.find(main_ssrc_);
+  auto it = std::find_if(received_report_blocks_.begin(),
+                         received_report_blocks_.end(),
+                         [&](const ReportBlockEntry& entry) {
+                           return entry.source_ssrc == main_ssrc_ &&
+                                  entry.remote_ssrc == remote_ssrc;
+                         });
   if (it == received_report_blocks_.end())
     return -1;
 
-  auto it_info = it->second.find(remote_ssrc);
-  if (it_info == it->second.end())
-    return -1;
-
-  const ReportBlockData* report_block_data = &it_info->second;
+  const ReportBlockData* report_block_data = &it->data;
 
   if (report_block_data->num_rtts() == 0)
     return -1;
@@ -295,12 +305,12 @@ RTCPReceiver::ConsumeReceivedXrReferenceTimeInfo() {
       CompactNtp(TimeMicrosToNtp(clock_->TimeInMicroseconds()));
 
   for (size_t i = 0; i < last_xr_rtis_size; ++i) {
-    RrtrInformation& rrtr = received_rrtrs_.front();
+    const RrtrInformation& rrtr = received_rrtrs_[i];
     last_xr_rtis.emplace_back(rrtr.ssrc, rrtr.received_remote_mid_ntp_time,
                               now_ntp - rrtr.local_receive_mid_ntp_time);
-    received_rrtrs_ssrc_it_.erase(rrtr.ssrc);
-    received_rrtrs_.pop_front();
   }
+  received_rrtrs_.erase(received_rrtrs_.begin(),
+                        received_rrtrs_.begin() + last_xr_rtis_size);
 
   return last_xr_rtis;
 }
@@ -310,18 +320,17 @@ int32_t RTCPReceiver::StatisticsReceived(
     std::vector<RTCPReportBlock>* receive_blocks) const {
   RTC_DCHECK(receive_blocks);
   rtc::CritScope lock(&rtcp_receiver_lock_);
-  for (const auto& reports_per_receiver : received_report_blocks_)
-    for (const auto& report : reports_per_receiver.second)
-      receive_blocks->push_back(report.second.report_block());
+  for (const ReportBlockEntry& entry : received_report_blocks_)
+    receive_blocks->push_back(entry.data.report_block());
   return 0;
 }
 
 std::vector<ReportBlockData> RTCPReceiver::GetLatestReportBlockData() const {
   std::vector<ReportBlockData> result;
   rtc::CritScope lock(&rtcp_receiver_lock_);
-  for (const auto& reports_per_receiver : received_report_blocks_)
-    for (const auto& report : reports_per_receiver.second)
-      result.push_back(report.second);
+  result.reserve(received_report_blocks_.size());
+  for (const ReportBlockEntry& entry : received_report_blocks_)
+    result.push_back(entry.data);
   return result;
 }
 
@@ -384,6 +393,9 @@ bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
           case rtcp::TransportFeedback::kFeedbackMessageType:
             HandleTransportFeedback(rtcp_block, packet_information);
             break;
+          case rtcp::EcnFeedback::kFeedbackMessageType:
+            HandleEcnFeedback(rtcp_block, packet_information);
+            break;
           default:
             ++num_skipped_packets_;
             break;
@@ -432,7 +444,7 @@ bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
 
 void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
                                       PacketInformation* packet_information) {
-  rtcp::SenderReport sender_report;
+  rtcp::SenderReport& sender_report = sender_report_;
   if (!sender_report.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -464,7 +476,7 @@ void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
 
 void RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
                                         PacketInformation* packet_information) {
-  rtcp::ReceiverReport receiver_report;
+  rtcp::ReceiverReport& receiver_report = receiver_report_;
   if (!receiver_report.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -495,13 +507,13 @@ void RTCPReceiver::HandleReportBlock(const ReportBlock& report_block,
   // which the information in this reception report block pertains.
 
   // Filter out all report blocks that are not for us.
-  if (registered_ssrcs_.count(report_block.source_ssrc()) == 0)
+  if (!IsRegisteredSsrc(report_block.source_ssrc()))
     return;
 
   last_received_rb_ms_ = clock_->TimeInMilliseconds();
 
   ReportBlockData* report_block_data =
-      &received_report_blocks_[report_block.source_ssrc()][remote_ssrc];
+      FindOrCreateReportBlockData(report_block.source_ssrc(), remote_ssrc);
   RTCPReportBlock rtcp_report_block;
   rtcp_report_block.sender_ssrc = remote_ssrc;
   rtcp_report_block.source_ssrc = report_block.source_ssrc();
@@ -554,6 +566,28 @@ void RTCPReceiver::HandleReportBlock(const ReportBlock& report_block,
   packet_information->report_block_datas.push_back(*report_block_data);
 }
 
+bool RTCPReceiver::IsRegisteredSsrc(uint32_t ssrc) const {
+  return std::find(registered_ssrcs_.begin(), registered_ssrcs_.end(),
+                   ssrc) != registered_ssrcs_.end();
+}
+
+ReportBlockData* RTCPReceiver::FindOrCreateReportBlockData(
+    uint32_t source_ssrc,
+    uint32_t remote_ssrc) {
+  auto it = std::lower_bound(
+      received_report_blocks_.begin(), received_report_blocks_.end(),
+      std::make_pair(source_ssrc, remote_ssrc),
+      [](const ReportBlockEntry& entry, std::pair<uint32_t, uint32_t> key) {
+        return std::make_pair(entry.source_ssrc, entry.remote_ssrc) < key;
+      });
+  if (it == received_report_blocks_.end() || it->source_ssrc != source_ssrc ||
+      it->remote_ssrc != remote_ssrc) {
+    it = received_report_blocks_.insert(
+        it, ReportBlockEntry{source_ssrc, remote_ssrc, ReportBlockData()});
+  }
+  return &it->data;
+}
+
 RTCPReceiver::TmmbrInformation* RTCPReceiver::FindOrCreateTmmbrInfo(
     uint32_t remote_ssrc) {
   // Create or find receive information.
@@ -674,7 +708,7 @@ void RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
 
 void RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
-  rtcp::Nack nack;
+  rtcp::Nack& nack = nack_;
   if (!nack.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -721,8 +755,13 @@ void RTCPReceiver::HandleBye(const CommonHeader& rtcp_block) {
   }
 
   // Clear our lists.
-  for (auto& reports_per_receiver : received_report_blocks_)
-    reports_per_receiver.second.erase(bye.sender_ssrc());
+  received_report_blocks_.erase(
+      std::remove_if(received_report_blocks_.begin(),
+                     received_report_blocks_.end(),
+                     [&](const ReportBlockEntry& entry) {
+                       return entry.remote_ssrc == bye.sender_ssrc();
+                     }),
+      received_report_blocks_.end());
 
   TmmbrInformation* tmmbr_info = GetTmmbrInformation(bye.sender_ssrc());
   if (tmmbr_info)
@@ -730,11 +769,12 @@ void RTCPReceiver::HandleBye(const CommonHeader& rtcp_block) {
 
   last_fir_.erase(bye.sender_ssrc());
   received_cnames_.erase(bye.sender_ssrc());
-  auto it = received_rrtrs_ssrc_it_.find(bye.sender_ssrc());
-  if (it != received_rrtrs_ssrc_it_.end()) {
-    received_rrtrs_.erase(it->second);
-    received_rrtrs_ssrc_it_.erase(it);
-  }
+  auto it = std::find_if(received_rrtrs_.begin(), received_rrtrs_.end(),
+                         [&](const RrtrInformation& rrtr) {
+                           return rrtr.ssrc == bye.sender_ssrc();
+                         });
+  if (it != received_rrtrs_.end())
+    received_rrtrs_.erase(it);
   xr_rr_rtt_ms_ = 0;
 }
 
@@ -764,15 +804,17 @@ void RTCPReceiver::HandleXrReceiveReferenceTime(uint32_t sender_ssrc,
   uint32_t local_receive_mid_ntp_time =
       CompactNtp(TimeMicrosToNtp(clock_->TimeInMicroseconds()));
 
-  auto it = received_rrtrs_ssrc_it_.find(sender_ssrc);
-  if (it != received_rrtrs_ssrc_it_.end()) {
-    it->second->received_remote_mid_ntp_time = received_remote_mid_ntp_time;
-    it->second->local_receive_mid_ntp_time = local_receive_mid_ntp_time;
+  auto it = std::find_if(received_rrtrs_.begin(), received_rrtrs_.end(),
+                         [&](const RrtrInformation& rrtr) {
+                           return rrtr.ssrc == sender_ssrc;
+                         });
+  if (it != received_rrtrs_.end()) {
+    it->received_remote_mid_ntp_time = received_remote_mid_ntp_time;
+    it->local_receive_mid_ntp_time = local_receive_mid_ntp_time;
   } else {
     if (received_rrtrs_.size() < kMaxNumberOfStoredRrtrs) {
       received_rrtrs_.emplace_back(sender_ssrc, received_remote_mid_ntp_time,
                                    local_receive_mid_ntp_time);
-      received_rrtrs_ssrc_it_[sender_ssrc] = std::prev(received_rrtrs_.end());
     } else {
       RTC_LOG(LS_WARNING) << "Discarding received RRTR for ssrc " << sender_ssrc
                           << ", reached maximum number of stored RRTRs.";
@@ -781,7 +823,7 @@ void RTCPReceiver::HandleXrReceiveReferenceTime(uint32_t sender_ssrc,
 }
 
 void RTCPReceiver::HandleXrDlrrReportBlock(const rtcp::ReceiveTimeInfo& rti) {
-  if (registered_ssrcs_.count(rti.ssrc) == 0)  // Not to us.
+  if (!IsRegisteredSsrc(rti.ssrc))  // Not to us.
     return;
 
   // Caller should explicitly enable rtt calculation using extended reports.
@@ -969,11 +1011,28 @@ void RTCPReceiver::HandleTransportFeedback(
     ++num_skipped_packets_;
     return;
   }
+  uint32_t media_source_ssrc = transport_feedback->media_ssrc();
+  if (media_source_ssrc != main_ssrc_ && !IsRegisteredSsrc(media_source_ssrc))
+    return;
 
   packet_information->packet_type_flags |= kRtcpTransportFeedback;
   packet_information->transport_feedback = std::move(transport_feedback);
 }
 
+void RTCPReceiver::HandleEcnFeedback(const CommonHeader& rtcp_block,
+                                     PacketInformation* packet_information) {
+  auto ecn_feedback = std::make_unique<rtcp::EcnFeedback>();
+  if (!ecn_feedback->Parse(rtcp_block)) {
+    ++num_skipped_packets_;
+    return;
+  }
+  uint32_t media_source_ssrc = ecn_feedback->media_ssrc();
+  if (media_source_ssrc != main_ssrc_ && !IsRegisteredSsrc(media_source_ssrc))
+    return;
+
+  packet_information->ecn_feedback = std::move(ecn_feedback);
+}
+
 void RTCPReceiver::NotifyTmmbrUpdated() {
   // Find bounding set.
   std::vector<rtcp::TmmbItem> bounding =
@@ -1022,12 +1081,10 @@ void RTCPReceiver::TriggerCallbacksFromRtcpPacket(
     NotifyTmmbrUpdated();
   }
   uint32_t local_ssrc;
-  std::set<uint32_t> registered_ssrcs;
   {
     // We don't want to hold this critsect when triggering the callbacks below.
     rtc::CritScope lock(&rtcp_receiver_lock_);
     local_ssrc = main_ssrc_;
-    registered_ssrcs = registered_ssrcs_;
   }
   if (!receiver_only_ && (packet_information.packet_type_flags & kRtcpSrReq)) {
     rtp_rtcp_->OnRequestSendReport();
@@ -1091,15 +1148,16 @@ void RTCPReceiver::TriggerCallbacksFromRtcpPacket(
     rtp_rtcp_->OnReceivedRtcpReportBlocks(packet_information.report_blocks);
   }
 
+  // Feedback not for our ssrcs was dropped when parsed.
   if (transport_feedback_observer_ &&
       (packet_information.packet_type_flags & kRtcpTransportFeedback)) {
-    uint32_t media_source_ssrc =
-        packet_information.transport_feedback->media_ssrc();
-    if (media_source_ssrc == local_ssrc ||
-        registered_ssrcs.find(media_source_ssrc) != registered_ssrcs.end()) {
-      transport_feedback_observer_->OnTransportFeedback(
-          *packet_information.transport_feedback);
-    }
+    transport_feedback_observer_->OnTransportFeedback(
+        *packet_information.transport_feedback);
+  }
+
+  if (transport_feedback_observer_ && packet_information.ecn_feedback) {
+    transport_feedback_observer_->OnEcnFeedback(
+        *packet_information.ecn_feedback);
   }
 
   if (network_state_estimate_observer_ &&
@@ -11,7 +11,6 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
 #define MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
 
-#include <list>
 #include <map>
 #include <set>
 #include <string>
@@ -23,6 +22,9 @@
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtcp_nack_stats.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/dlrr.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/nack.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/thread_annotations.h"
 #include "system_wrappers/include/ntp_time.h"
@@ -120,10 +122,7 @@ class RTCPReceiver {
   struct TmmbrInformation;
   struct RrtrInformation;
   struct LastFirStatus;
-  // RTCP report blocks mapped by remote SSRC.
-  using ReportBlockDataMap = std::map<uint32_t, ReportBlockData>;
-  // RTCP report blocks map mapped by source SSRC.
-  using ReportBlockMap = std::map<uint32_t, ReportBlockDataMap>;
+  struct ReportBlockEntry;
 
   bool ParseCompoundPacket(const uint8_t* packet_begin,
                            const uint8_t* packet_end,
@@ -132,6 +131,13 @@ class RTCPReceiver {
   void TriggerCallbacksFromRtcpPacket(
       const PacketInformation& packet_information);
 
+  bool IsRegisteredSsrc(uint32_t ssrc) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
+
+  ReportBlockData* FindOrCreateReportBlockData(uint32_t source_ssrc,
+                                               uint32_t remote_ssrc)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
+
   TmmbrInformation* FindOrCreateTmmbrInfo(uint32_t remote_ssrc)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
   // Update TmmbrInformation (if present) is alive.
@@ -212,6 +218,10 @@ class RTCPReceiver {
                                PacketInformation* packet_information)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
 
+  void HandleEcnFeedback(const rtcp::CommonHeader& rtcp_block,
+                         PacketInformation* packet_information)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(rtcp_receiver_lock_);
+
   Clock* const clock_;
   const bool receiver_only_;
   ModuleRtpRtcp* const rtp_rtcp_;
@@ -228,7 +238,8 @@ class RTCPReceiver {
   rtc::CriticalSection rtcp_receiver_lock_;
   uint32_t main_ssrc_ RTC_GUARDED_BY(rtcp_receiver_lock_);
   uint32_t remote_ssrc_ RTC_GUARDED_BY(rtcp_receiver_lock_);
-  std::set<uint32_t> registered_ssrcs_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  // Few ssrcs, e.g. media, rtx and flexfec, so a flat set.
+  std::vector<uint32_t> registered_ssrcs_ RTC_GUARDED_BY(rtcp_receiver_lock_);
 
   // Received sender report.
   NtpTime remote_sender_ntp_time_ RTC_GUARDED_BY(rtcp_receiver_lock_);
@@ -236,12 +247,10 @@ class RTCPReceiver {
   // When did we receive the last send report.
   NtpTime last_received_sr_ntp_ RTC_GUARDED_BY(rtcp_receiver_lock_);
 
-  // Received RRTR information in ascending receive time order.
-  std::list<RrtrInformation> received_rrtrs_
+  // Received RRTR information in ascending receive time order, at most one
+  // per remote ssrc.
+  std::vector<RrtrInformation> received_rrtrs_
       RTC_GUARDED_BY(rtcp_receiver_lock_);
-  // Received RRTR information mapped by remote ssrc.
-  std::map<uint32_t, std::list<RrtrInformation>::iterator>
-      received_rrtrs_ssrc_it_ RTC_GUARDED_BY(rtcp_receiver_lock_);
 
   // Estimated rtt, zero when there is no valid estimate.
   bool xr_rrtr_status_ RTC_GUARDED_BY(rtcp_receiver_lock_);
@@ -252,12 +261,21 @@ class RTCPReceiver {
   std::map<uint32_t, TmmbrInformation> tmmbr_infos_
       RTC_GUARDED_BY(rtcp_receiver_lock_);
 
-  ReportBlockMap received_report_blocks_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  // Sorted by source ssrc, then by remote ssrc. There is an entry for each
+  // pair of our ssrcs and remote senders, which are few.
+  std::vector<ReportBlockEntry> received_report_blocks_
+      RTC_GUARDED_BY(rtcp_receiver_lock_);
   std::map<uint32_t, LastFirStatus> last_fir_
       RTC_GUARDED_BY(rtcp_receiver_lock_);
   std::map<uint32_t, std::string> received_cnames_
       RTC_GUARDED_BY(rtcp_receiver_lock_);
 
+  // Reused between packets, so that parsing doesn't allocate once their
+  // buffers have grown.
+  rtcp::SenderReport sender_report_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  rtcp::ReceiverReport receiver_report_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+  rtcp::Nack nack_ RTC_GUARDED_BY(rtcp_receiver_lock_);
+
   // The last time we received an RTCP Report block for this module.
   int64_t last_received_rb_ms_ RTC_GUARDED_BY(rtcp_receiver_lock_);
 
@@ -23,6 +23,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/app.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/compound_packet.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_jitter_report.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
@@ -38,7 +39,9 @@
 #include "modules/rtp_rtcp/source/time_util.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/fake_clock.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/ntp_time.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -100,6 +103,7 @@ class MockTransportFeedbackObserver : public TransportFeedbackObserver {
  public:
   MOCK_METHOD1(OnAddPacket, void(const RtpPacketSendInfo&));
   MOCK_METHOD1(OnTransportFeedback, void(const rtcp::TransportFeedback&));
+  MOCK_METHOD1(OnEcnFeedback, void(const rtcp::EcnFeedback&));
   MOCK_CONST_METHOD0(GetTransportFeedbackVector, std::vector<PacketFeedback>());
 };
 
@@ -1408,6 +1412,21 @@ TEST_F(RtcpReceiverTest, ReceivesTransportFeedback) {
   InjectRtcpPacket(packet);
 }
 
+TEST_F(RtcpReceiverTest, ReceivesEcnFeedback) {
+  rtcp::EcnFeedback packet;
+  packet.SetMediaSsrc(kReceiverMainSsrc);
+  packet.SetSenderSsrc(kSenderSsrc);
+  packet.SetEct0Count(100);
+  packet.SetCeCount(3);
+
+  EXPECT_CALL(transport_feedback_observer_,
+              OnEcnFeedback(AllOf(
+                  Property(&rtcp::EcnFeedback::media_ssrc, kReceiverMainSsrc),
+                  Property(&rtcp::EcnFeedback::ect0_count, 100u),
+                  Property(&rtcp::EcnFeedback::ce_count, 3))));
+  InjectRtcpPacket(packet);
+}
+
 TEST_F(RtcpReceiverTest, ReceivesRemb) {
   const uint32_t kBitrateBps = 500000;
   rtcp::Remb remb;
@@ -1568,4 +1587,72 @@ TEST_F(RtcpReceiverTest, HandlesIncorrectTargetBitrate) {
   InjectRtcpPacket(xr);
 }
 
+class NoopModuleRtpRtcp : public RTCPReceiver::ModuleRtpRtcp {
+ public:
+  void SetTmmbn(std::vector<rtcp::TmmbItem> bounding_set) override {}
+  void OnRequestSendReport() override {}
+  void OnReceivedNack(
+      const std::vector<uint16_t>& nack_sequence_numbers) override {}
+  void OnReceivedRtcpReportBlocks(
+      const ReportBlockList& report_blocks) override {}
+};
+
+TEST(RtcpReceiverPerfTest, DISABLED_ParseMixedCompoundPacketsPerf) {
+  constexpr int kNumIterations = 100000;
+  SimulatedClock clock(1335900000);
+  NoopModuleRtpRtcp owner;
+  RtpRtcp::Configuration config;
+  config.clock = &clock;
+  config.receiver_only = false;
+  config.local_media_ssrc = kReceiverMainSsrc;
+  config.rtx_send_ssrc = kReceiverExtraSsrc;
+  RTCPReceiver receiver(config, &owner);
+  receiver.SetRemoteSSRC(kSenderSsrc);
+
+  // What a receiving endpoint of a conference sends: reports for all the
+  // streams it receives, transport feedback and the occasional NACK.
+  rtcp::ReceiverReport rr;
+  rr.SetSenderSsrc(kSenderSsrc);
+  for (uint32_t ssrc : {kReceiverMainSsrc, kReceiverExtraSsrc}) {
+    rtcp::ReportBlock block;
+    block.SetMediaSsrc(ssrc);
+    block.SetExtHighestSeqNum(1000);
+    rr.AddReportBlock(block);
+  }
+  for (uint32_t i = 0; i < 20; ++i) {
+    rtcp::ReportBlock block;
+    block.SetMediaSsrc(kNotToUsSsrc + i);
+    rr.AddReportBlock(block);
+  }
+  rtcp::TransportFeedback feedback;
+  feedback.SetSenderSsrc(kSenderSsrc);
+  feedback.SetMediaSsrc(kReceiverMainSsrc);
+  feedback.SetBase(1, 1000);
+  for (uint16_t seq = 1; seq <= 50; ++seq)
+    feedback.AddReceivedPacket(seq, 1000 + seq * 1000);
+  rtcp::Nack nack;
+  nack.SetSenderSsrc(kSenderSsrc);
+  nack.SetMediaSsrc(kReceiverMainSsrc);
+  const uint16_t kNackList[] = {1, 3, 20, 21, 22, 40};
+  nack.SetPacketIds(kNackList, arraysize(kNackList));
+
+  rtcp::CompoundPacket report_and_feedback;
+  report_and_feedback.Append(&rr);
+  report_and_feedback.Append(&feedback);
+  rtcp::CompoundPacket report_and_nack;
+  report_and_nack.Append(&rr);
+  report_and_nack.Append(&nack);
+  const rtc::Buffer packets[] = {report_and_feedback.Build(), feedback.Build(),
+                                 report_and_nack.Build(), feedback.Build()};
+
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    const rtc::Buffer& packet = packets[i % arraysize(packets)];
+    receiver.IncomingPacket(packet.data(), packet.size());
+  }
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  RTC_LOG(LS_INFO) << "IncomingPacket: " << elapsed_us * 1000 / kNumIterations
+                   << " ns per compound packet.";
+}
+
 }  // namespace webrtc
@@ -124,6 +124,7 @@ RTCPSender::RTCPSender(const RtpRtcp::Configuration& config)
                               ? config.rtcp_report_interval_ms
                               : (config.audio ? kDefaultAudioReportInterval
                                               : kDefaultVideoReportInterval)),
+      report_alignment_ms_(config.rtcp_report_alignment_ms),
       sending_(false),
       next_time_to_send_rtcp_(0),
       timestamp_offset_(0),
@@ -814,6 +815,11 @@ void RTCPSender::PrepareReport(const FeedbackState& feedback_state) {
 
     RTC_DCHECK_GT(time_to_next, 0);
     next_time_to_send_rtcp_ = clock_->TimeInMilliseconds() + time_to_next;
+    if (report_alignment_ms_ > 0) {
+      next_time_to_send_rtcp_ +=
+          report_alignment_ms_ - 1 -
+          (next_time_to_send_rtcp_ - 1) % report_alignment_ms_;
+    }
 
     // RtcpSender expected to be used for sending either just sender reports
     // or just receiver reports.
@@ -1014,4 +1020,21 @@ bool RTCPSender::SendNetworkStateEstimatePacket(
   return packet.Build(max_packet_size, callback) && send_success;
 }
 
+bool RTCPSender::SendEcnFeedbackPacket(const rtcp::EcnFeedback& packet) {
+  size_t max_packet_size;
+  {
+    rtc::CritScope lock(&critical_section_rtcp_sender_);
+    if (method_ == RtcpMode::kOff)
+      return false;
+    max_packet_size = max_packet_size_;
+  }
+
+  RTC_DCHECK_LE(max_packet_size, IP_PACKET_SIZE);
+  bool send_success = false;
+  auto callback = [&](rtc::ArrayView<const uint8_t> packet) {
+    send_success = transport_->SendRtcp(packet.data(), packet.size());
+  };
+  return packet.Build(max_packet_size, callback) && send_success;
+}
+
 }  // namespace webrtc
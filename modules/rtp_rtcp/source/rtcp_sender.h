@@ -142,6 +142,7 @@ class RTCPSender {
   void SetVideoBitrateAllocation(const VideoBitrateAllocation& bitrate);
   bool SendFeedbackPacket(const rtcp::TransportFeedback& packet);
   bool SendNetworkStateEstimatePacket(const rtcp::RemoteEstimate& packet);
+  bool SendEcnFeedbackPacket(const rtcp::EcnFeedback& packet);
 
  private:
   class RtcpContext;
@@ -193,6 +194,7 @@ class RTCPSender {
   Transport* const transport_;
 
   const int report_interval_ms_;
+  const int report_alignment_ms_;
 
   rtc::CriticalSection critical_section_rtcp_sender_;
   bool sending_ RTC_GUARDED_BY(critical_section_rtcp_sender_);
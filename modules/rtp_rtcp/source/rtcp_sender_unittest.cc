@@ -816,6 +816,23 @@ TEST_F(RtcpSenderTest, SendTargetBitrateExplicitZeroOnStreamRemoval) {
   EXPECT_EQ(bitrates[1].target_bitrate_kbps, 0u);
 }
 
+TEST_F(RtcpSenderTest, AlignsReportTimes) {
+  const int kAlignmentMs = 100;
+  RtpRtcp::Configuration configuration = GetDefaultConfig();
+  configuration.rtcp_report_alignment_ms = kAlignmentMs;
+  rtcp_sender_.reset(new RTCPSender(configuration));
+  rtcp_sender_->SetRemoteSSRC(kRemoteSsrc);
+  rtcp_sender_->SetRTCPStatus(RtcpMode::kCompound);
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(0, rtcp_sender_->SendRTCP(feedback_state(), kRtcpReport));
+    clock_.AdvanceTimeMilliseconds(1 + i * 7);
+    while (!rtcp_sender_->TimeToSendRTCPReport(false))
+      clock_.AdvanceTimeMilliseconds(1);
+    EXPECT_EQ(0, clock_.TimeInMilliseconds() % kAlignmentMs);
+  }
+}
+
 TEST_F(RtcpSenderTest, DoesntSchedulesInitialReportWhenSsrcSetOnConstruction) {
   rtcp_sender_->SetRTCPStatus(RtcpMode::kReducedSize);
   rtcp_sender_->SetRemoteSSRC(kRemoteSsrc);
@@ -131,6 +131,16 @@ bool RtcpTransceiver::SendNetworkStateEstimatePacket(
   return true;
 }
 
+bool RtcpTransceiver::SendEcnFeedbackPacket(const rtcp::EcnFeedback& packet) {
+  RTC_CHECK(rtcp_transceiver_);
+  RtcpTransceiverImpl* ptr = rtcp_transceiver_.get();
+  rtc::Buffer raw_packet = packet.Build();
+  task_queue_->PostTask([ptr, raw_packet = std::move(raw_packet)] {
+    ptr->SendRawPacket(raw_packet);
+  });
+  return true;
+}
+
 void RtcpTransceiver::SendNack(uint32_t ssrc,
                                std::vector<uint16_t> sequence_numbers) {
   RTC_CHECK(rtcp_transceiver_);
@@ -81,6 +81,7 @@ class RtcpTransceiver : public RtcpFeedbackSenderInterface {
   bool SendFeedbackPacket(const rtcp::TransportFeedback& packet) override;
   bool SendNetworkStateEstimatePacket(
       const rtcp::RemoteEstimate& packet) override;
+  bool SendEcnFeedbackPacket(const rtcp::EcnFeedback& packet) override;
 
   // Reports missing packets, https://tools.ietf.org/html/rfc4585#section-6.2.1
   void SendNack(uint32_t ssrc, std::vector<uint16_t> sequence_numbers);
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <list>
 #include <memory>
 
@@ -333,6 +334,42 @@ TYPED_TEST(RtpFecTest, FecRecoveryWithLoss) {
   EXPECT_FALSE(this->IsRecoveryComplete());
 }
 
+TYPED_TEST(RtpFecTest, FecRecoveryWithReorderedAndDuplicatedMediaPackets) {
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  constexpr int kNumMediaPackets = 12;
+  constexpr uint8_t kProtectionFactor = 255;
+
+  this->media_packets_ =
+      this->media_packet_generator_.ConstructMediaPackets(kNumMediaPackets);
+
+  EXPECT_EQ(
+      0, this->fec_.EncodeFec(this->media_packets_, kProtectionFactor,
+                              kNumImportantPackets, kUseUnequalProtection,
+                              kFecMaskBursty, &this->generated_fec_packets_));
+
+  // A burst of 2 media packets lost.
+  memset(this->media_loss_mask_, 0, sizeof(this->media_loss_mask_));
+  memset(this->fec_loss_mask_, 0, sizeof(this->fec_loss_mask_));
+  for (int i = 4; i < 6; ++i)
+    this->media_loss_mask_[i] = 1;
+  this->NetworkReceivedPackets(this->media_loss_mask_, this->fec_loss_mask_);
+
+  // Deliver the media packets in reverse order and twice, followed by the FEC
+  // packets. The FEC packets are not duplicated, since reading the ULPFEC
+  // header modifies the packet.
+  std::reverse(this->received_packets_.begin(),
+               this->received_packets_.begin() + kNumMediaPackets - 2);
+  for (const auto& received_packet : this->received_packets_) {
+    this->fec_.DecodeFec(*received_packet, &this->recovered_packets_);
+    if (!received_packet->is_fec)
+      this->fec_.DecodeFec(*received_packet, &this->recovered_packets_);
+  }
+
+  // The recovered packets are sorted and free of duplicates.
+  EXPECT_TRUE(this->IsRecoveryComplete());
+}
+
 // Verify that we don't use an old FEC packet for FEC decoding.
 TYPED_TEST(RtpFecTest, NoFecRecoveryWithOldFecPacket) {
   constexpr int kNumImportantPackets = 0;
@@ -29,6 +29,9 @@ constexpr uint16_t kTwoByteExtensionProfileId = 0x1000;
 constexpr size_t kOneByteExtensionHeaderLength = 1;
 constexpr size_t kTwoByteExtensionHeaderLength = 2;
 constexpr size_t kDefaultPacketSize = 1500;
+// Room for the extensions a video packet typically has, reserved with the
+// first one rather than growing one at a time.
+constexpr size_t kInitialExtensionEntries = 8;
 }  // namespace
 
 //  0                   1                   2                   3
@@ -120,6 +123,8 @@ void RtpPacket::CopyHeaderFrom(const RtpPacket& packet) {
   payload_offset_ = packet.payload_offset_;
   extensions_ = packet.extensions_;
   extension_entries_ = packet.extension_entries_;
+  memcpy(extension_entry_by_id_, packet.extension_entry_by_id_,
+         sizeof(extension_entry_by_id_));
   extensions_size_ = packet.extensions_size_;
   buffer_.SetData(packet.data(), packet.headers_size());
   // Reset payload and padding.
@@ -318,8 +323,7 @@ rtc::ArrayView<uint8_t> RtpPacket::AllocateRawExtension(int id, size_t length) {
   const uint16_t extension_info_offset = rtc::dchecked_cast<uint16_t>(
       extensions_offset + extensions_size_ + extension_header_size);
   const uint8_t extension_info_length = rtc::dchecked_cast<uint8_t>(length);
-  extension_entries_.emplace_back(id, extension_info_length,
-                                  extension_info_offset);
+  AddExtensionInfo(id, extension_info_length, extension_info_offset);
 
   extensions_size_ = new_extensions_size;
 
@@ -431,7 +435,7 @@ void RtpPacket::Clear() {
   payload_size_ = 0;
   padding_size_ = 0;
   extensions_size_ = 0;
-  extension_entries_.clear();
+  ClearExtensionInfos();
 
   memset(WriteAt(0), 0, kFixedHeaderSize);
   buffer_.SetSize(kFixedHeaderSize);
@@ -471,7 +475,7 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
   }
 
   extensions_size_ = 0;
-  extension_entries_.clear();
+  ClearExtensionInfos();
   if (has_extension) {
     /* RTP header extension, RFC 3550.
      0                   1                   2                   3
@@ -557,6 +561,10 @@ bool RtpPacket::ParseBuffer(const uint8_t* buffer, size_t size) {
 }
 
 const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
+  if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    const uint8_t entry = extension_entry_by_id_[id];
+    return entry != 0 ? &extension_entries_[entry - 1] : nullptr;
+  }
   for (const ExtensionInfo& extension : extension_entries_) {
     if (extension.id == id) {
       return &extension;
@@ -566,15 +574,31 @@ const RtpPacket::ExtensionInfo* RtpPacket::FindExtensionInfo(int id) const {
 }
 
 RtpPacket::ExtensionInfo& RtpPacket::FindOrCreateExtensionInfo(int id) {
-  for (ExtensionInfo& extension : extension_entries_) {
-    if (extension.id == id) {
-      return extension;
-    }
+  const ExtensionInfo* extension = FindExtensionInfo(id);
+  if (extension != nullptr) {
+    return const_cast<ExtensionInfo&>(*extension);
+  }
+  return AddExtensionInfo(rtc::dchecked_cast<uint8_t>(id), 0, 0);
+}
+
+RtpPacket::ExtensionInfo& RtpPacket::AddExtensionInfo(uint8_t id,
+                                                      uint8_t length,
+                                                      uint16_t offset) {
+  if (extension_entries_.capacity() == 0)
+    extension_entries_.reserve(kInitialExtensionEntries);
+  extension_entries_.emplace_back(id, length, offset);
+  if (id <= RtpExtension::kOneByteHeaderExtensionMaxId) {
+    extension_entry_by_id_[id] =
+        rtc::dchecked_cast<uint8_t>(extension_entries_.size());
   }
-  extension_entries_.emplace_back(id);
   return extension_entries_.back();
 }
 
+void RtpPacket::ClearExtensionInfos() {
+  extension_entries_.clear();
+  memset(extension_entry_by_id_, 0, sizeof(extension_entry_by_id_));
+}
+
 rtc::ArrayView<const uint8_t> RtpPacket::FindExtension(
     ExtensionType type) const {
   uint8_t id = extensions_.GetId(type);
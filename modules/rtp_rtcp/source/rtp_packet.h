@@ -169,6 +169,10 @@ class RtpPacket {
   // with the specified id if not found.
   ExtensionInfo& FindOrCreateExtensionInfo(int id);
 
+  // Appends an entry to |extension_entries_| and returns it.
+  ExtensionInfo& AddExtensionInfo(uint8_t id, uint8_t length, uint16_t offset);
+  void ClearExtensionInfos();
+
   // Allocates and returns place to store rtp header extension.
   // Returns empty arrayview on failure.
   rtc::ArrayView<uint8_t> AllocateRawExtension(int id, size_t length);
@@ -195,6 +199,12 @@ class RtpPacket {
 
   ExtensionManager extensions_;
   std::vector<ExtensionInfo> extension_entries_;
+  // One more than the index into |extension_entries_| of the extension with
+  // each one-byte header id, or 0 if the packet doesn't have it, so that
+  // finding those extensions doesn't search |extension_entries_|. Extensions
+  // with larger ids are rare and are searched for.
+  uint8_t extension_entry_by_id_[RtpExtension::kOneByteHeaderExtensionMaxId +
+                                 1] = {};
   size_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
@@ -22,6 +22,13 @@
 #include "system_wrappers/include/clock.h"
 
 namespace webrtc {
+namespace {
+// Marks the absence of a neighbour in the padding priority list.
+constexpr int kNoPacket = -1;
+// Initial number of slots in the ring buffer.
+constexpr size_t kMinRingSize = 128;
+constexpr int kSeqNumSpan = std::numeric_limits<uint16_t>::max() + 1;
+}  // namespace
 
 constexpr size_t RtpPacketHistory::kMaxCapacity;
 constexpr size_t RtpPacketHistory::kMaxPaddingtHistory;
@@ -43,6 +50,9 @@ RtpPacketHistory::StoredPacket::StoredPacket(
       // be put in the pacer queue and later retrieved via
       // GetPacketAndSetSendTime().
       pending_transmission_(!send_time_ms.has_value()),
+      in_padding_list_(false),
+      padding_prev_(kNoPacket),
+      padding_next_(kNoPacket),
       insert_order_(insert_order),
       times_retransmitted_(0) {}
 
@@ -51,27 +61,8 @@ RtpPacketHistory::StoredPacket& RtpPacketHistory::StoredPacket::operator=(
     RtpPacketHistory::StoredPacket&&) = default;
 RtpPacketHistory::StoredPacket::~StoredPacket() = default;
 
-void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted(
-    PacketPrioritySet* priority_set) {
-  // Check if this StoredPacket is in the priority set. If so, we need to remove
-  // it before updating |times_retransmitted_| since that is used in sorting,
-  // and then add it back.
-  const bool in_priority_set = priority_set->erase(this) > 0;
-  ++times_retransmitted_;
-  if (in_priority_set) {
-    auto it = priority_set->insert(this);
-    RTC_DCHECK(it.second)
-        << "ERROR: Priority set already contains matching packet! In set: "
-           "insert order = "
-        << (*it.first)->insert_order_
-        << ", times retransmitted = " << (*it.first)->times_retransmitted_
-        << ". Trying to add: insert order = " << insert_order_
-        << ", times retransmitted = " << times_retransmitted_;
-  }
-}
-
-bool RtpPacketHistory::MoreUseful::operator()(StoredPacket* lhs,
-                                              StoredPacket* rhs) const {
+bool RtpPacketHistory::MoreUseful::operator()(const StoredPacket* lhs,
+                                              const StoredPacket* rhs) const {
   // Prefer to send packets we haven't already sent as padding.
   if (lhs->times_retransmitted() != rhs->times_retransmitted()) {
     return lhs->times_retransmitted() < rhs->times_retransmitted();
@@ -85,7 +76,12 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock)
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_ms_(-1),
-      packets_inserted_(0) {}
+      first_sequence_number_(0),
+      history_span_(0),
+      packets_inserted_(0),
+      padding_head_(kNoPacket),
+      padding_tail_(kNoPacket),
+      padding_list_size_(0) {}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -106,6 +102,22 @@ RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
   return mode_;
 }
 
+RtpPacketHistoryStats RtpPacketHistory::GetStats() const {
+  rtc::CritScope cs(&lock_);
+  RtpPacketHistoryStats stats;
+  stats.stored_bytes = packet_history_.capacity() * sizeof(StoredPacket);
+  for (const StoredPacket& stored_packet : packet_history_) {
+    if (stored_packet.packet_) {
+      stats.stored_bytes +=
+          sizeof(RtpPacketToSend) + stored_packet.packet_->capacity();
+    }
+  }
+  if (mode_ != StorageMode::kDisabled) {
+    stats.max_packets = number_to_store_;
+  }
+  return stats;
+}
+
 void RtpPacketHistory::SetRtt(int64_t rtt_ms) {
   rtc::CritScope cs(&lock_);
   RTC_DCHECK_GE(rtt_ms, 0);
@@ -132,37 +144,40 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
 
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
-  int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0u &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (GetStoredPacket(rtp_seq_no) != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
-    RemovePacket(packet_index);
-    packet_index = GetPacketIndex(rtp_seq_no);
+    RemovePacket(rtp_seq_no);
   }
 
-  // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front(nullptr, absl::nullopt, 0);
+  // Extend the span to cover the new packet, either ahead of the first packet
+  // or behind the last one.
+  const int packet_index = GetPacketIndex(rtp_seq_no);
+  size_t new_span = history_span_;
+  if (history_span_ == 0) {
+    new_span = 1;
+  } else if (packet_index < 0) {
+    new_span += -packet_index;
+  } else if (static_cast<size_t>(packet_index) >= history_span_) {
+    new_span = packet_index + 1;
   }
-  // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back(nullptr, absl::nullopt, 0);
+  EnsureRingSize(new_span);
+  if (history_span_ == 0 || packet_index < 0) {
+    first_sequence_number_ = rtp_seq_no;
   }
+  history_span_ = new_span;
 
-  RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
-
-  packet_history_[packet_index] =
+  StoredPacket& stored_packet = Slot(rtp_seq_no);
+  RTC_DCHECK(stored_packet.packet_ == nullptr);
+  stored_packet =
       StoredPacket(std::move(packet), send_time_ms, packets_inserted_++);
 
-  if (padding_priority_.size() >= kMaxPaddingtHistory - 1) {
-    padding_priority_.erase(std::prev(padding_priority_.end()));
+  if (padding_list_size_ >= kMaxPaddingtHistory - 1) {
+    RemoveFromPaddingList(&Slot(padding_tail_));
   }
-  auto prio_it = padding_priority_.insert(&packet_history_[packet_index]);
-  RTC_DCHECK(prio_it.second) << "Failed to insert packet into prio set.";
+  // A new packet has not been retransmitted and is newer than all others, so
+  // it is always the most useful one.
+  InsertIntoPaddingList(&stored_packet, padding_head_);
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
@@ -183,7 +198,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   }
 
   if (packet->send_time_ms_) {
-    packet->IncrementTimesRetransmitted(&padding_priority_);
+    IncrementTimesRetransmitted(packet);
   }
 
   // Update send-time and mark as no long in pacer queue.
@@ -253,7 +268,7 @@ void RtpPacketHistory::MarkPacketAsSent(uint16_t sequence_number) {
   // transmission count.
   packet->send_time_ms_ = clock_->TimeInMilliseconds();
   packet->pending_transmission_ = false;
-  packet->IncrementTimesRetransmitted(&padding_priority_);
+  IncrementTimesRetransmitted(packet);
 }
 
 absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
@@ -263,21 +278,16 @@ absl::optional<RtpPacketHistory::PacketState> RtpPacketHistory::GetPacketState(
     return absl::nullopt;
   }
 
-  int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
-    return absl::nullopt;
-  }
-  const StoredPacket& packet = packet_history_[packet_index];
-  if (packet.packet_ == nullptr) {
+  const StoredPacket* packet = GetStoredPacket(sequence_number);
+  if (packet == nullptr) {
     return absl::nullopt;
   }
 
-  if (!VerifyRtt(packet, clock_->TimeInMilliseconds())) {
+  if (!VerifyRtt(*packet, clock_->TimeInMilliseconds())) {
     return absl::nullopt;
   }
 
-  return StoredPacketToPacketState(packet);
+  return StoredPacketToPacketState(*packet);
 }
 
 bool RtpPacketHistory::VerifyRtt(const RtpPacketHistory::StoredPacket& packet,
@@ -307,12 +317,11 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
     rtc::FunctionView<std::unique_ptr<RtpPacketToSend>(const RtpPacketToSend&)>
         encapsulate) {
   rtc::CritScope cs(&lock_);
-  if (mode_ == StorageMode::kDisabled || padding_priority_.empty()) {
+  if (mode_ == StorageMode::kDisabled || padding_head_ == kNoPacket) {
     return nullptr;
   }
 
-  auto best_packet_it = padding_priority_.begin();
-  StoredPacket* best_packet = *best_packet_it;
+  StoredPacket* best_packet = &Slot(padding_head_);
   if (best_packet->pending_transmission_) {
     // Because PacedSender releases it's lock when it calls
     // GeneratePadding() there is the potential for a race where a new
@@ -328,7 +337,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   }
 
   best_packet->send_time_ms_ = clock_->TimeInMilliseconds();
-  best_packet->IncrementTimesRetransmitted(&padding_priority_);
+  IncrementTimesRetransmitted(best_packet);
 
   return padding_packet;
 }
@@ -337,12 +346,9 @@ void RtpPacketHistory::CullAcknowledgedPackets(
     rtc::ArrayView<const uint16_t> sequence_numbers) {
   rtc::CritScope cs(&lock_);
   for (uint16_t sequence_number : sequence_numbers) {
-    int packet_index = GetPacketIndex(sequence_number);
-    if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
-      continue;
+    if (GetStoredPacket(sequence_number) != nullptr) {
+      RemovePacket(sequence_number);
     }
-    RemovePacket(packet_index);
   }
 }
 
@@ -368,21 +374,25 @@ void RtpPacketHistory::Clear() {
 
 void RtpPacketHistory::Reset() {
   packet_history_.clear();
-  padding_priority_.clear();
+  first_sequence_number_ = 0;
+  history_span_ = 0;
+  padding_head_ = kNoPacket;
+  padding_tail_ = kNoPacket;
+  padding_list_size_ = 0;
 }
 
 void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
   int64_t packet_duration_ms =
       std::max(kMinPacketDurationRtt * rtt_ms_, kMinPacketDurationMs);
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (history_span_ > 0) {
+    if (history_span_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
-      RemovePacket(0);
+      RemovePacket(first_sequence_number_);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = Slot(first_sequence_number_);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
@@ -393,13 +403,13 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (history_span_ >= number_to_store_ ||
         *stored_packet.send_time_ms_ +
                 (packet_duration_ms * kPacketCullingDelayFactor) <=
             now_ms) {
       // Too many packets in history, or this packet has timed out. Remove it
       // and continue.
-      RemovePacket(0);
+      RemovePacket(first_sequence_number_);
     } else {
       // No more packets can be removed right now.
       return;
@@ -408,18 +418,33 @@ void RtpPacketHistory::CullOldPackets(int64_t now_ms) {
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
-    int packet_index) {
-  // Move the packet out from the StoredPacket container.
-  std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+    uint16_t sequence_number) {
+  StoredPacket& stored_packet = Slot(sequence_number);
+  RTC_DCHECK(stored_packet.packet_ != nullptr);
 
-  // Erase from padding priority set, if eligible.
-  padding_priority_.erase(&packet_history_[packet_index]);
+  // Erase from padding priority list, if eligible.
+  RemoveFromPaddingList(&stored_packet);
 
-  if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+  // Move the packet out from the StoredPacket container.
+  std::unique_ptr<RtpPacketToSend> rtp_packet =
+      std::move(stored_packet.packet_);
+
+  // Shrink the span past any empty slots at either end, so that the first and
+  // last slot stay populated.
+  if (sequence_number == first_sequence_number_) {
+    while (history_span_ > 0 &&
+           Slot(first_sequence_number_).packet_ == nullptr) {
+      ++first_sequence_number_;
+      --history_span_;
+    }
+  } else {
+    while (history_span_ > 0) {
+      uint16_t last_sequence_number =
+          static_cast<uint16_t>(first_sequence_number_ + history_span_ - 1);
+      if (Slot(last_sequence_number).packet_ != nullptr) {
+        break;
+      }
+      --history_span_;
     }
   }
 
@@ -427,19 +452,16 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (history_span_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  int first_seq = first_sequence_number_;
   if (first_seq == sequence_number) {
     return 0;
   }
 
   int packet_index = sequence_number - first_seq;
-  constexpr int kSeqNumSpan = std::numeric_limits<uint16_t>::max() + 1;
-
   if (IsNewerSequenceNumber(sequence_number, first_seq)) {
     if (sequence_number < first_seq) {
       // Forward wrap.
@@ -455,11 +477,112 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
+  return const_cast<StoredPacket*>(
+      static_cast<const RtpPacketHistory*>(this)->GetStoredPacket(
+          sequence_number));
+}
+
+const RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
+    uint16_t sequence_number) const {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size()) {
+  if (index < 0 || static_cast<size_t>(index) >= history_span_) {
     return nullptr;
   }
-  return &packet_history_[index];
+  const StoredPacket& stored_packet =
+      packet_history_[sequence_number & (packet_history_.size() - 1)];
+  return stored_packet.packet_ != nullptr ? &stored_packet : nullptr;
+}
+
+RtpPacketHistory::StoredPacket& RtpPacketHistory::Slot(
+    uint16_t sequence_number) {
+  RTC_DCHECK(!packet_history_.empty());
+  return packet_history_[sequence_number & (packet_history_.size() - 1)];
+}
+
+void RtpPacketHistory::EnsureRingSize(size_t span) {
+  if (span <= packet_history_.size()) {
+    return;
+  }
+  size_t ring_size = std::max(kMinRingSize, packet_history_.size());
+  while (ring_size < span) {
+    ring_size *= 2;
+  }
+  RTC_DCHECK_LE(ring_size, kSeqNumSpan);
+
+  std::vector<StoredPacket> ring;
+  ring.reserve(ring_size);
+  for (size_t i = 0; i < ring_size; ++i) {
+    ring.emplace_back(nullptr, absl::nullopt, 0);
+  }
+  // Padding list links are sequence numbers, so they remain valid in the new
+  // ring.
+  for (StoredPacket& stored_packet : packet_history_) {
+    if (stored_packet.packet_ != nullptr) {
+      uint16_t sequence_number = stored_packet.packet_->SequenceNumber();
+      ring[sequence_number & (ring_size - 1)] = std::move(stored_packet);
+    }
+  }
+  packet_history_.swap(ring);
+}
+
+void RtpPacketHistory::IncrementTimesRetransmitted(StoredPacket* packet) {
+  if (!packet->in_padding_list_) {
+    packet->IncrementTimesRetransmitted();
+    return;
+  }
+  // |times_retransmitted_| is used in sorting, so unlink the packet before
+  // updating it. Since it only makes the packet less useful, its new position
+  // is at or after the old one.
+  int next = packet->padding_next_;
+  RemoveFromPaddingList(packet);
+  packet->IncrementTimesRetransmitted();
+  MoreUseful more_useful;
+  while (next != kNoPacket && more_useful(&Slot(next), packet)) {
+    next = Slot(next).padding_next_;
+  }
+  InsertIntoPaddingList(packet, next);
+}
+
+void RtpPacketHistory::InsertIntoPaddingList(StoredPacket* packet, int next) {
+  RTC_DCHECK(!packet->in_padding_list_);
+  const int sequence_number = packet->packet_->SequenceNumber();
+  const int prev = next == kNoPacket ? padding_tail_ : Slot(next).padding_prev_;
+  packet->padding_prev_ = prev;
+  packet->padding_next_ = next;
+  if (prev == kNoPacket) {
+    padding_head_ = sequence_number;
+  } else {
+    Slot(prev).padding_next_ = sequence_number;
+  }
+  if (next == kNoPacket) {
+    padding_tail_ = sequence_number;
+  } else {
+    Slot(next).padding_prev_ = sequence_number;
+  }
+  packet->in_padding_list_ = true;
+  ++padding_list_size_;
+}
+
+void RtpPacketHistory::RemoveFromPaddingList(StoredPacket* packet) {
+  if (!packet->in_padding_list_) {
+    return;
+  }
+  const int prev = packet->padding_prev_;
+  const int next = packet->padding_next_;
+  if (prev == kNoPacket) {
+    padding_head_ = next;
+  } else {
+    Slot(prev).padding_next_ = next;
+  }
+  if (next == kNoPacket) {
+    padding_tail_ = prev;
+  } else {
+    Slot(next).padding_prev_ = prev;
+  }
+  packet->in_padding_list_ = false;
+  packet->padding_prev_ = kNoPacket;
+  packet->padding_next_ = kNoPacket;
+  --padding_list_size_;
 }
 
 RtpPacketHistory::PacketState RtpPacketHistory::StoredPacketToPacketState(
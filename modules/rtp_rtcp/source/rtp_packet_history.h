@@ -11,10 +11,8 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
 #include <map>
 #include <memory>
-#include <set>
 #include <vector>
 
 #include "api/function_view.h"
@@ -70,6 +68,9 @@ class RtpPacketHistory {
   void SetStorePacketsStatus(StorageMode mode, size_t number_to_store);
   StorageMode GetStorageMode() const;
 
+  // Returns the approximate memory held by the history and its capacity.
+  RtpPacketHistoryStats GetStats() const;
+
   // Set RTT, used to avoid premature retransmission and to prevent over-writing
   // a packet in the history before we are reasonably sure it has been received.
   void SetRtt(int64_t rtt_ms);
@@ -136,10 +137,6 @@ class RtpPacketHistory {
   void Clear();
 
  private:
-  struct MoreUseful;
-  class StoredPacket;
-  using PacketPrioritySet = std::set<StoredPacket*, MoreUseful>;
-
   class StoredPacket {
    public:
     StoredPacket(std::unique_ptr<RtpPacketToSend> packet,
@@ -151,7 +148,7 @@ class RtpPacketHistory {
 
     uint64_t insert_order() const { return insert_order_; }
     size_t times_retransmitted() const { return times_retransmitted_; }
-    void IncrementTimesRetransmitted(PacketPrioritySet* priority_set);
+    void IncrementTimesRetransmitted() { ++times_retransmitted_; }
 
     // The time of last transmission, including retransmissions.
     absl::optional<int64_t> send_time_ms_;
@@ -162,6 +159,13 @@ class RtpPacketHistory {
     // True if the packet is currently in the pacer queue pending transmission.
     bool pending_transmission_;
 
+    // Links in the padding priority list. The neighbours are referred to by
+    // sequence number rather than by pointer, so that the links stay valid
+    // when the ring buffer is resized. -1 means there is no neighbour.
+    bool in_padding_list_;
+    int padding_prev_;
+    int padding_next_;
+
    private:
     // Unique number per StoredPacket, incremented by one for each added
     // packet. Used to sort on insert order.
@@ -171,7 +175,7 @@ class RtpPacketHistory {
     size_t times_retransmitted_;
   };
   struct MoreUseful {
-    bool operator()(StoredPacket* lhs, StoredPacket* rhs) const;
+    bool operator()(const StoredPacket* lhs, const StoredPacket* rhs) const;
   };
 
   // Helper method used by GetPacketAndSetSendTime() and GetPacketState() to
@@ -182,12 +186,35 @@ class RtpPacketHistory {
   void CullOldPackets(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   // Removes the packet from the history, and context/mapping that has been
   // stored. Returns the RTP packet instance contained within the StoredPacket.
-  std::unique_ptr<RtpPacketToSend> RemovePacket(int packet_index)
+  std::unique_ptr<RtpPacketToSend> RemovePacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the offset of |sequence_number| from the oldest packet in the
+  // history. Negative, or not less than |history_span_|, if it is outside the
+  // range of stored sequence numbers.
   int GetPacketIndex(uint16_t sequence_number) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Returns the stored packet with |sequence_number|, or null if there is
+  // none.
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  const StoredPacket* GetStoredPacket(uint16_t sequence_number) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Ring buffer slot for |sequence_number|, which may be empty.
+  StoredPacket& Slot(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Grows the ring buffer, if needed, so that |span| consecutive sequence
+  // numbers map to distinct slots.
+  void EnsureRingSize(size_t span) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Increments the retransmission count of |packet| and moves it to its new
+  // position in the padding priority list.
+  void IncrementTimesRetransmitted(StoredPacket* packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Links |packet| into the padding priority list just before the packet with
+  // sequence number |next|, or last if |next| is -1.
+  void InsertIntoPaddingList(StoredPacket* packet, int next)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void RemoveFromPaddingList(StoredPacket* packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   static PacketState StoredPacketToPacketState(
       const StoredPacket& stored_packet);
 
@@ -197,19 +224,27 @@ class RtpPacketHistory {
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   int64_t rtt_ms_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
-  // the front and new packets being added to the back. Note that there may be
-  // wrap-arounds so the back may have a lower sequence number.
-  // Packets may also be removed out-of-order, in which case there will be
-  // instances of StoredPacket with |packet_| set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // Ring buffer of stored packets, indexed by sequence number modulo its size,
+  // which is a power of two. It is grown on demand, so that the
+  // |history_span_| sequence numbers starting at |first_sequence_number_| map
+  // to distinct slots. Packets may be removed out-of-order, leaving empty slots
+  // with |packet_| set to nullptr within the span. The first and last slot of
+  // the span will however always be populated.
+  std::vector<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // Sequence number of the oldest packet, valid if |history_span_| > 0.
+  uint16_t first_sequence_number_ RTC_GUARDED_BY(lock_);
+  // Number of sequence numbers from the oldest to the newest stored packet,
+  // inclusive.
+  size_t history_span_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
-  // Objects from |packet_history_| ordered by "most likely to be useful", used
-  // in GetPayloadPaddingPacket().
-  PacketPrioritySet padding_priority_ RTC_GUARDED_BY(lock_);
+  // Intrusive list through |packet_history_| ordered by "most likely to be
+  // useful", used in GetPayloadPaddingPacket(). Holds the sequence numbers of
+  // the first and last entry, or -1 when empty.
+  int padding_head_ RTC_GUARDED_BY(lock_);
+  int padding_tail_ RTC_GUARDED_BY(lock_);
+  size_t padding_list_size_ RTC_GUARDED_BY(lock_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
 };
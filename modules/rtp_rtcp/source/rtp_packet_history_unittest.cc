@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
@@ -96,6 +97,22 @@ TEST_F(RtpPacketHistoryTest, StartSeqResetAfterReset) {
   EXPECT_TRUE(hist_.GetPacketState(To16u(kStartSeqNum + 2)));
 }
 
+TEST_F(RtpPacketHistoryTest, ReportsStoredBytesAndCapacity) {
+  EXPECT_EQ(0u, hist_.GetStats().max_packets);
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  RtpPacketHistoryStats empty_stats = hist_.GetStats();
+  EXPECT_EQ(10u, empty_stats.max_packets);
+
+  std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kStartSeqNum);
+  const size_t packet_capacity = packet->capacity();
+  hist_.PutRtpPacket(std::move(packet), absl::nullopt);
+  RtpPacketHistoryStats stats = hist_.GetStats();
+  EXPECT_GE(stats.stored_bytes, empty_stats.stored_bytes + packet_capacity);
+
+  hist_.SetStorePacketsStatus(StorageMode::kDisabled, 0);
+  EXPECT_EQ(0u, hist_.GetStats().max_packets);
+}
+
 TEST_F(RtpPacketHistoryTest, NoStoreStatus) {
   EXPECT_EQ(StorageMode::kDisabled, hist_.GetStorageMode());
   std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kStartSeqNum);
@@ -766,4 +783,60 @@ TEST_F(RtpPacketHistoryTest, OutOfOrderInsertRemoval) {
     expected_time_offset_ms += 33;
   }
 }
+
+TEST_F(RtpPacketHistoryTest, LooksUpPacketsAfterGrowingAcrossWrap) {
+  const size_t kNumPackets = 1000;
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, kNumPackets);
+
+  // Start in front of the wrap, so that the history has to grow while it
+  // spans it.
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum - 500 + i)),
+                       fake_clock_.TimeInMilliseconds());
+  }
+
+  // Ack every third packet, as well as the oldest and newest ones.
+  std::vector<uint16_t> acked_sequence_numbers;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    if (i % 3 == 0 || i == kNumPackets - 1) {
+      acked_sequence_numbers.push_back(To16u(kStartSeqNum - 500 + i));
+    }
+  }
+  hist_.CullAcknowledgedPackets(acked_sequence_numbers);
+
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    const uint16_t seq_no = To16u(kStartSeqNum - 500 + i);
+    const bool acked = i % 3 == 0 || i == kNumPackets - 1;
+    absl::optional<RtpPacketHistory::PacketState> packet_state =
+        hist_.GetPacketState(seq_no);
+    ASSERT_EQ(!acked, packet_state.has_value()) << "Packet " << seq_no;
+    if (packet_state) {
+      EXPECT_EQ(seq_no, packet_state->rtp_sequence_number);
+    }
+  }
+
+  // Sequence numbers just outside the stored range are still unknown.
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - 501)));
+  EXPECT_FALSE(hist_.GetPacketState(To16u(kStartSeqNum - 500 + kNumPackets)));
+}
+
+TEST_F(RtpPacketHistoryTest, RetransmissionReordersPaddingPriority) {
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, 10);
+  const uint16_t kSeqA = kStartSeqNum;
+  const uint16_t kSeqB = To16u(kStartSeqNum + 1);
+  const uint16_t kSeqC = To16u(kStartSeqNum + 2);
+  for (uint16_t seq_no : {kSeqA, kSeqB, kSeqC}) {
+    hist_.PutRtpPacket(CreateRtpPacket(seq_no),
+                       fake_clock_.TimeInMilliseconds());
+  }
+
+  // Retransmitting B moves it behind A and C.
+  EXPECT_TRUE(hist_.GetPacketAndSetSendTime(kSeqB));
+
+  // Each padding packet is a retransmission too, so the order keeps changing.
+  EXPECT_EQ(kSeqC, hist_.GetPayloadPaddingPacket()->SequenceNumber());
+  EXPECT_EQ(kSeqA, hist_.GetPayloadPaddingPacket()->SequenceNumber());
+  EXPECT_EQ(kSeqC, hist_.GetPayloadPaddingPacket()->SequenceNumber());
+  EXPECT_EQ(kSeqB, hist_.GetPayloadPaddingPacket()->SequenceNumber());
+}
 }  // namespace webrtc
@@ -20,10 +20,15 @@
 #include "api/video/video_timing.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet.h"
+#include "rtc_base/memory/small_object_pool.h"
 
 namespace webrtc {
 // Class to hold rtp packet with metadata for sender side.
-class RtpPacketToSend : public RtpPacket {
+// One or more are allocated per packet sent, e.g. by the RTP sender, for
+// RED, FEC and RTX copies, and for the send history, and they are freed on
+// the pacer thread or on history eviction. They come from
+// rtc::SmallObjectPool, which keeps freed packets for reuse.
+class RtpPacketToSend : public RtpPacket, public rtc::SmallObject {
  public:
   enum class Type {
     kAudio,                   // Audio media packets.
@@ -66,6 +71,15 @@ class RtpPacketToSend : public RtpPacket {
   }
   bool allow_retransmission() { return allow_retransmission_; }
 
+  // Set by the pacer when the packet is part of a burst that may be sent to
+  // the network in one batch, see PacketOptions::batchable.
+  void set_is_batchable(bool is_batchable) { is_batchable_ = is_batchable; }
+  bool is_batchable() const { return is_batchable_; }
+  void set_is_last_in_batch(bool is_last_in_batch) {
+    is_last_in_batch_ = is_last_in_batch;
+  }
+  bool is_last_in_batch() const { return is_last_in_batch_; }
+
   // Additional data bound to the RTP packet for use in application code,
   // outside of WebRTC.
   rtc::ArrayView<const uint8_t> application_data() const {
@@ -104,6 +118,8 @@ class RtpPacketToSend : public RtpPacket {
   int64_t capture_time_ms_ = 0;
   absl::optional<Type> packet_type_;
   bool allow_retransmission_ = false;
+  bool is_batchable_ = false;
+  bool is_last_in_batch_ = false;
   absl::optional<uint16_t> retransmitted_sequence_number_;
   std::vector<uint8_t> application_data_;
 };
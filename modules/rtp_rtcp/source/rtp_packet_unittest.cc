@@ -7,12 +7,16 @@
  *  in the file PATENTS.  All contributing project authors may
  *  be found in the AUTHORS file in the root of the source tree.
  */
+#include <memory>
+
 #include "common_video/test/utilities.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
 #include "modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -701,6 +705,17 @@ TEST(RtpPacketTest, ParseWithExtensionDelayed) {
   EXPECT_EQ(0u, packet.padding_size());
 }
 
+TEST(RtpPacketTest, ParseForgetsExtensionsOfPreviousPacket) {
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  RtpPacketReceived packet(&extensions);
+  EXPECT_TRUE(packet.Parse(kPacketWithTO, sizeof(kPacketWithTO)));
+  EXPECT_TRUE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_TRUE(packet.Parse(kMinimumPacket, sizeof(kMinimumPacket)));
+  EXPECT_FALSE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_FALSE(packet.IsExtensionReserved<TransmissionOffset>());
+}
+
 TEST(RtpPacketTest, ParseDynamicSizeExtension) {
   // clang-format off
   const uint8_t kPacket1[] = {
@@ -1100,4 +1115,80 @@ TEST(RtpPacketTest, RemoveExtensionFailure) {
   EXPECT_THAT(kPacketWithTO, ElementsAreArray(packet.data(), packet.size()));
 }
 
+TEST(RtpPacketTest, DISABLED_ParseAndReadVideoExtensionsPerf) {
+  constexpr int kNumIterations = 1000000;
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AbsoluteSendTime>(2);
+  extensions.Register<TransportSequenceNumber>(3);
+  extensions.Register<VideoOrientation>(4);
+  extensions.Register<PlayoutDelayLimits>(5);
+  extensions.Register<VideoContentTypeExtension>(6);
+  extensions.Register<VideoTimingExtension>(kVideoTimingExtensionId);
+  extensions.Register<RtpMid>(kRtpMidExtensionId);
+  RtpPacketToSend send_packet(&extensions);
+  send_packet.SetPayloadType(kPayloadType);
+  send_packet.SetSequenceNumber(kSeqNum);
+  send_packet.SetTimestamp(kTimestamp);
+  send_packet.SetSsrc(kSsrc);
+  send_packet.SetExtension<TransmissionOffset>(kTimeOffset);
+  send_packet.SetExtension<AbsoluteSendTime>(0x123456);
+  send_packet.SetExtension<TransportSequenceNumber>(kSeqNum);
+  send_packet.SetExtension<VideoOrientation>(kVideoRotation_90);
+  send_packet.SetExtension<PlayoutDelayLimits>(PlayoutDelay{100, 200});
+  send_packet.SetExtension<VideoTimingExtension>(VideoSendTiming());
+  send_packet.AllocatePayload(1100);
+
+  RtpPacketReceived packet(&extensions);
+  int64_t found = 0;
+  const int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    packet.Parse(send_packet.data(), send_packet.size());
+    found += packet.GetExtension<TransportSequenceNumber>().has_value();
+    found += packet.GetExtension<AbsoluteSendTime>().has_value();
+    found += packet.GetExtension<TransmissionOffset>().has_value();
+    found += packet.GetExtension<VideoOrientation>().has_value();
+    found += packet.GetExtension<PlayoutDelayLimits>().has_value();
+    found += packet.GetExtension<VideoTimingExtension>().has_value();
+    found += packet.HasExtension<VideoContentTypeExtension>();
+    found += packet.HasExtension<RtpMid>();
+  }
+  const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  EXPECT_EQ(6 * kNumIterations, found);
+  RTC_LOG(LS_INFO) << "Parse and read of 8 extensions: "
+                   << elapsed_us * 1000 / kNumIterations << " ns per packet.";
+}
+
+// Allocates a packet the way RTPSender does, copies it into the history and
+// frees both, as for each media packet on the send path.
+TEST(RtpPacketTest, DISABLED_AllocateCopyAndFreeSendPacketPerf) {
+  constexpr int kNumIterations = 1000000;
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register<TransmissionOffset>(kTransmissionOffsetExtensionId);
+  extensions.Register<AbsoluteSendTime>(2);
+  extensions.Register<TransportSequenceNumber>(3);
+  extensions.Register<VideoOrientation>(4);
+  extensions.Register<VideoTimingExtension>(kVideoTimingExtensionId);
+  extensions.Register<RtpMid>(kRtpMidExtensionId);
+
+  size_t total_size = 0;
+  const int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumIterations; ++i) {
+    auto packet = std::make_unique<RtpPacketToSend>(&extensions, 1216);
+    packet->SetSsrc(kSsrc);
+    packet->ReserveExtension<AbsoluteSendTime>();
+    packet->ReserveExtension<TransmissionOffset>();
+    packet->ReserveExtension<TransportSequenceNumber>();
+    packet->SetExtension<RtpMid>(kMid);
+    packet->SetExtension<VideoOrientation>(kVideoRotation_90);
+    packet->AllocatePayload(1100);
+    auto stored_packet = std::make_unique<RtpPacketToSend>(*packet);
+    total_size += stored_packet->size();
+  }
+  const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  EXPECT_GT(total_size, 0u);
+  RTC_LOG(LS_INFO) << "Allocate, copy and free of a send packet: "
+                   << elapsed_us * 1000 / kNumIterations << " ns per packet.";
+}
+
 }  // namespace webrtc
@@ -507,6 +507,13 @@ void ModuleRtpRtcpImpl::GetSendStreamDataCounters(
   rtp_sender_->GetDataCounters(rtp_counters, rtx_counters);
 }
 
+RtpPacketHistoryStats ModuleRtpRtcpImpl::GetPacketHistoryStats() const {
+  if (!rtp_sender_) {
+    return RtpPacketHistoryStats();
+  }
+  return rtp_sender_->GetPacketHistoryStats();
+}
+
 // Received RTCP report.
 int32_t ModuleRtpRtcpImpl::RemoteRTCPStat(
     std::vector<RTCPReportBlock>* receive_blocks) const {
@@ -657,6 +664,11 @@ bool ModuleRtpRtcpImpl::SendNetworkStateEstimatePacket(
   return rtcp_sender_.SendNetworkStateEstimatePacket(packet);
 }
 
+bool ModuleRtpRtcpImpl::SendEcnFeedbackPacket(
+    const rtcp::EcnFeedback& packet) {
+  return rtcp_sender_.SendEcnFeedbackPacket(packet);
+}
+
 int32_t ModuleRtpRtcpImpl::SendLossNotification(uint16_t last_decoded_seq_num,
                                                 uint16_t last_received_seq_num,
                                                 bool decodability_flag,
@@ -479,6 +479,8 @@ bool RTPSender::TrySendPacket(RtpPacketToSend* packet,
 
   options.application_data.assign(packet->application_data().begin(),
                                   packet->application_data().end());
+  options.batchable = packet->is_batchable();
+  options.last_packet_in_batch = packet->is_last_in_batch();
 
   if (packet->packet_type() != RtpPacketToSend::Type::kPadding &&
       packet->packet_type() != RtpPacketToSend::Type::kRetransmission) {
@@ -816,6 +818,10 @@ void RTPSender::GetDataCounters(StreamDataCounters* rtp_stats,
   *rtx_stats = rtx_rtp_stats_;
 }
 
+RtpPacketHistoryStats RTPSender::GetPacketHistoryStats() const {
+  return packet_history_.GetStats();
+}
+
 std::unique_ptr<RtpPacketToSend> RTPSender::AllocatePacket() const {
   rtc::CritScope lock(&send_critsect_);
   // TODO(danilchap): Find better motivator and value for extra capacity.
@@ -1168,6 +1174,8 @@ void RTPSender::AddPacketToTransportFeedback(
     packet_info.rtp_sequence_number = packet.SequenceNumber();
     packet_info.length = packet_size;
     packet_info.pacing_info = pacing_info;
+    packet_info.is_padding =
+        packet.packet_type() == RtpPacketToSend::Type::kPadding;
     transport_feedback_observer_->OnAddPacket(packet_info);
   }
 }
@@ -64,6 +64,8 @@ class RTPSender {
   void GetDataCounters(StreamDataCounters* rtp_stats,
                        StreamDataCounters* rtx_stats) const;
 
+  RtpPacketHistoryStats GetPacketHistoryStats() const;
+
   uint32_t TimestampOffset() const;
   void SetTimestampOffset(uint32_t timestamp);
 
@@ -471,6 +471,7 @@ bool RTPSenderVideo::SendVideo(
   if (payload_size == 0)
     return false;
   RTC_CHECK(video_header);
+  RTC_DCHECK_RUNS_SERIALIZED(&send_race_checker_);
 
   size_t fec_packet_overhead;
   bool red_enabled;
@@ -602,8 +603,6 @@ bool RTPSenderVideo::SendVideo(
     }
   }
 
-  // TODO(benwright@webrtc.org) - Allocate enough to always encrypt inline.
-  rtc::Buffer encrypted_video_payload;
   if (frame_encryptor_ != nullptr) {
     if (generic_descriptor_raw.empty()) {
       return false;
@@ -612,7 +611,8 @@ bool RTPSenderVideo::SendVideo(
     const size_t max_ciphertext_size =
         frame_encryptor_->GetMaxCiphertextByteSize(cricket::MEDIA_TYPE_VIDEO,
                                                    payload_size);
-    encrypted_video_payload.SetSize(max_ciphertext_size);
+    // Only grows the buffer, which is reused for the following frames.
+    encrypted_video_payload_.SetSize(max_ciphertext_size);
 
     size_t bytes_written = 0;
 
@@ -625,13 +625,13 @@ bool RTPSenderVideo::SendVideo(
     if (frame_encryptor_->Encrypt(
             cricket::MEDIA_TYPE_VIDEO, first_packet->Ssrc(), additional_data,
             rtc::MakeArrayView(payload_data, payload_size),
-            encrypted_video_payload, &bytes_written) != 0) {
+            encrypted_video_payload_, &bytes_written) != 0) {
       return false;
     }
 
-    encrypted_video_payload.SetSize(bytes_written);
-    payload_data = encrypted_video_payload.data();
-    payload_size = encrypted_video_payload.size();
+    encrypted_video_payload_.SetSize(bytes_written);
+    payload_data = encrypted_video_payload_.data();
+    payload_size = encrypted_video_payload_.size();
   } else if (require_frame_encryption_) {
     RTC_LOG(LS_WARNING)
         << "No FrameEncryptor is attached to this video sending stream but "
@@ -27,8 +27,10 @@
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 #include "modules/rtp_rtcp/source/rtp_sequence_number_map.h"
 #include "modules/rtp_rtcp/source/ulpfec_generator.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/one_time_event.h"
+#include "rtc_base/race_checker.h"
 #include "rtc_base/rate_statistics.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/thread_annotations.h"
@@ -215,6 +217,10 @@ class RTPSenderVideo {
 
   // E2EE Custom Video Frame Encryptor (optional)
   FrameEncryptorInterface* const frame_encryptor_ = nullptr;
+  rtc::RaceChecker send_race_checker_;
+  // Output of |frame_encryptor_|, kept between frames so that encrypting a
+  // frame doesn't allocate and fault in a new frame sized buffer.
+  rtc::Buffer encrypted_video_payload_ RTC_GUARDED_BY(send_race_checker_);
   // If set to true will require all outgoing frames to pass through an
   // initialized frame_encryptor_ before being sent out of the network.
   // Otherwise these payloads will be dropped.
@@ -13,6 +13,7 @@
 #include <string>
 #include <vector>
 
+#include "api/crypto/frame_encryptor_interface.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video/video_timing.h"
 #include "modules/rtp_rtcp/include/rtp_cvo.h"
@@ -26,6 +27,7 @@
 #include "modules/rtp_rtcp/source/rtp_sender.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/rate_limiter.h"
+#include "rtc_base/ref_counted_object.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -90,6 +92,35 @@ class LoopbackTransportTest : public webrtc::Transport {
   std::vector<RtpPacketReceived> sent_packets_;
 };
 
+// Flips all bits of the frame and reports where the ciphertext was written.
+class XorFrameEncryptor : public FrameEncryptorInterface {
+ public:
+  int Encrypt(cricket::MediaType media_type,
+              uint32_t ssrc,
+              rtc::ArrayView<const uint8_t> additional_data,
+              rtc::ArrayView<const uint8_t> frame,
+              rtc::ArrayView<uint8_t> encrypted_frame,
+              size_t* bytes_written) override {
+    output_buffers_.push_back(encrypted_frame.data());
+    for (size_t i = 0; i < frame.size(); ++i)
+      encrypted_frame[i] = ~frame[i];
+    *bytes_written = frame.size();
+    return 0;
+  }
+
+  size_t GetMaxCiphertextByteSize(cricket::MediaType media_type,
+                                  size_t frame_size) override {
+    return frame_size + 16;
+  }
+
+  const std::vector<uint8_t*>& output_buffers() const {
+    return output_buffers_;
+  }
+
+ private:
+  std::vector<uint8_t*> output_buffers_;
+};
+
 }  // namespace
 
 class TestRtpSenderVideo : public RTPSenderVideo {
@@ -559,6 +590,42 @@ TEST_P(RtpSenderVideoTest, PopulateGenericFrameDescriptor01) {
   PopulateGenericFrameDescriptor(1);
 }
 
+TEST_P(RtpSenderVideoTest, ReusesEncryptionBufferBetweenFrames) {
+  rtc::scoped_refptr<XorFrameEncryptor> encryptor(
+      new rtc::RefCountedObject<XorFrameEncryptor>());
+  RTPSenderVideo rtp_sender_video(
+      &fake_clock_, &rtp_sender_, nullptr,
+      &rtp_sender_video_.playout_delay_oracle_, encryptor,
+      /*require_frame_encryption=*/true, /*need_rtp_packet_infos=*/false,
+      /*enable_retransmit_all_layers=*/false, field_trials_);
+  rtp_sender_video.RegisterPayloadType(kPayload, "generic",
+                                       /*raw_payload=*/false);
+  EXPECT_EQ(0, rtp_sender_.RegisterRtpHeaderExtension(
+                   kRtpExtensionGenericFrameDescriptor00,
+                   kGenericDescriptorId00));
+
+  uint8_t frame[100];
+  for (size_t i = 0; i < sizeof(frame); ++i)
+    frame[i] = i;
+  RTPVideoHeader hdr;
+  RTPVideoHeader::GenericDescriptorInfo& generic = hdr.generic.emplace();
+  for (size_t frame_size : {100, 50, 100}) {
+    ++generic.frame_id;
+    EXPECT_TRUE(rtp_sender_video.SendVideo(
+        VideoFrameType::kVideoFrameKey, kPayload, kTimestamp, 0, frame,
+        frame_size, nullptr, &hdr, kDefaultExpectedRetransmissionTimeMs));
+    rtc::ArrayView<const uint8_t> payload =
+        transport_.last_sent_packet().payload();
+    ASSERT_FALSE(payload.empty());
+    EXPECT_EQ(static_cast<uint8_t>(~frame[frame_size - 1]),
+              payload[payload.size() - 1]);
+  }
+
+  ASSERT_EQ(3u, encryptor->output_buffers().size());
+  EXPECT_EQ(encryptor->output_buffers()[0], encryptor->output_buffers()[1]);
+  EXPECT_EQ(encryptor->output_buffers()[0], encryptor->output_buffers()[2]);
+}
+
 void RtpSenderVideoTest::
     UsesMinimalVp8DescriptorWhenGenericFrameDescriptorExtensionIsUsed(
         int version) {
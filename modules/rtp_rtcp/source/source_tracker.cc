@@ -11,11 +11,11 @@
 #include "modules/rtp_rtcp/source/source_tracker.h"
 
 #include <algorithm>
-#include <utility>
 
 namespace webrtc {
 
 constexpr int64_t SourceTracker::kTimeoutMs;
+constexpr int64_t SourceTracker::kPruneIntervalMs;
 
 SourceTracker::SourceTracker(Clock* clock) : clock_(clock) {}
 
@@ -29,68 +29,82 @@ void SourceTracker::OnFrameDelivered(const RtpPacketInfos& packet_infos) {
 
   for (const auto& packet_info : packet_infos) {
     for (uint32_t csrc : packet_info.csrcs()) {
-      SourceKey key(RtpSourceType::CSRC, csrc);
-      SourceEntry& entry = UpdateEntry(key);
+      SourceEntry& entry = UpdateEntry(RtpSourceType::CSRC, csrc);
 
       entry.timestamp_ms = now_ms;
       entry.audio_level = packet_info.audio_level();
       entry.rtp_timestamp = packet_info.rtp_timestamp();
     }
 
-    SourceKey key(RtpSourceType::SSRC, packet_info.ssrc());
-    SourceEntry& entry = UpdateEntry(key);
+    SourceEntry& entry = UpdateEntry(RtpSourceType::SSRC, packet_info.ssrc());
 
     entry.timestamp_ms = now_ms;
     entry.audio_level = packet_info.audio_level();
     entry.rtp_timestamp = packet_info.rtp_timestamp();
   }
 
-  PruneEntries(now_ms);
+  if (now_ms >= next_prune_ms_) {
+    PruneEntries(now_ms);
+    next_prune_ms_ = now_ms + kPruneIntervalMs;
+  }
 }
 
 std::vector<RtpSource> SourceTracker::GetSources() const {
-  std::vector<RtpSource> sources;
+  std::vector<const SourceEntry*> live_entries;
 
   int64_t now_ms = clock_->TimeInMilliseconds();
   rtc::CritScope lock_scope(&lock_);
 
-  PruneEntries(now_ms);
-
-  for (const auto& pair : list_) {
-    const SourceKey& key = pair.first;
-    const SourceEntry& entry = pair.second;
+  int64_t prune_ms = now_ms - kTimeoutMs;
+  live_entries.reserve(entries_.size());
+  for (const SourceEntry& entry : entries_) {
+    if (entry.timestamp_ms >= prune_ms)
+      live_entries.push_back(&entry);
+  }
+  std::sort(live_entries.begin(), live_entries.end(),
+            [](const SourceEntry* lhs, const SourceEntry* rhs) {
+              return lhs->update_sequence > rhs->update_sequence;
+            });
 
-    sources.emplace_back(entry.timestamp_ms, key.source, key.source_type,
-                         entry.audio_level, entry.rtp_timestamp);
+  std::vector<RtpSource> sources;
+  sources.reserve(live_entries.size());
+  for (const SourceEntry* entry : live_entries) {
+    sources.emplace_back(entry->timestamp_ms, entry->source,
+                         entry->source_type, entry->audio_level,
+                         entry->rtp_timestamp);
   }
 
   return sources;
 }
 
-SourceTracker::SourceEntry& SourceTracker::UpdateEntry(const SourceKey& key) {
-  // We intentionally do |find() + emplace()|, instead of checking the return
-  // value of |emplace()|, for performance reasons. It's much more likely for
-  // the key to already exist than for it not to.
-  auto map_it = map_.find(key);
-  if (map_it == map_.end()) {
-    // Insert a new entry at the front of the list.
-    list_.emplace_front(key, SourceEntry());
-    map_.emplace(key, list_.begin());
-  } else if (map_it->second != list_.begin()) {
-    // Move the old entry to the front of the list.
-    list_.splice(list_.begin(), list_, map_it->second);
+SourceTracker::SourceEntry& SourceTracker::UpdateEntry(
+    RtpSourceType source_type,
+    uint32_t source) {
+  SourceEntry* entry = nullptr;
+  for (SourceEntry& candidate : entries_) {
+    if (candidate.source == source && candidate.source_type == source_type) {
+      entry = &candidate;
+      break;
+    }
   }
-
-  return list_.front().second;
+  if (!entry) {
+    entries_.emplace_back();
+    entry = &entries_.back();
+    entry->source_type = source_type;
+    entry->source = source;
+  }
+  entry->update_sequence = next_update_sequence_++;
+  return *entry;
 }
 
-void SourceTracker::PruneEntries(int64_t now_ms) const {
+void SourceTracker::PruneEntries(int64_t now_ms) {
   int64_t prune_ms = now_ms - kTimeoutMs;
 
-  while (!list_.empty() && list_.back().second.timestamp_ms < prune_ms) {
-    map_.erase(list_.back().first);
-    list_.pop_back();
-  }
+  entries_.erase(std::remove_if(entries_.begin(), entries_.end(),
+                                [prune_ms](const SourceEntry& entry) {
+                                  return entry.timestamp_ms < prune_ms;
+                                }),
+                 entries_.end());
 }
 
 }  // namespace webrtc
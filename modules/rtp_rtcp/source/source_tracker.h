@@ -12,9 +12,6 @@
 #define MODULES_RTP_RTCP_SOURCE_SOURCE_TRACKER_H_
 
 #include <cstdint>
-#include <list>
-#include <unordered_map>
-#include <utility>
 #include <vector>
 
 #include "absl/types/optional.h"
@@ -54,31 +51,17 @@ class SourceTracker {
   std::vector<RtpSource> GetSources() const;
 
  private:
-  struct SourceKey {
-    SourceKey(RtpSourceType source_type, uint32_t source)
-        : source_type(source_type), source(source) {}
+  // Timed out entries are removed at most this often; until then they are
+  // only skipped by GetSources().
+  static constexpr int64_t kPruneIntervalMs = 1000;
 
+  struct SourceEntry {
     // Type of |source|.
     RtpSourceType source_type;
 
     // CSRC or SSRC identifier of the contributing or synchronization source.
     uint32_t source;
-  };
 
-  struct SourceKeyComparator {
-    bool operator()(const SourceKey& lhs, const SourceKey& rhs) const {
-      return (lhs.source_type == rhs.source_type) && (lhs.source == rhs.source);
-    }
-  };
-
-  struct SourceKeyHasher {
-    size_t operator()(const SourceKey& value) const {
-      return static_cast<size_t>(value.source_type) +
-             static_cast<size_t>(value.source) * 11076425802534262905ULL;
-    }
-  };
-
-  struct SourceEntry {
     // Timestamp indicating the most recent time a frame from an RTP packet,
     // originating from this source, was delivered to the RTCRtpReceiver's
     // MediaStreamTrack. Its reference clock is the outer class's |clock_|.
@@ -93,31 +76,27 @@ class SourceTracker {
     // RTP timestamp of the most recent packet used to assemble the frame
     // associated with |timestamp_ms|.
     uint32_t rtp_timestamp;
-  };
 
-  using SourceList = std::list<std::pair<const SourceKey, SourceEntry>>;
-  using SourceMap = std::unordered_map<SourceKey,
-                                       SourceList::iterator,
-                                       SourceKeyHasher,
-                                       SourceKeyComparator>;
+    // Increases with every update, orders the output of GetSources().
+    uint64_t update_sequence;
+  };
 
-  // Updates an entry by creating it (if it didn't previously exist) and moving
-  // it to the front of the list. Returns a reference to the entry.
-  SourceEntry& UpdateEntry(const SourceKey& key)
+  // Updates an entry by creating it if it didn't previously exist. Returns a
+  // reference to the entry.
+  SourceEntry& UpdateEntry(RtpSourceType source_type, uint32_t source)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
-  // Removes entries that have timed out. Marked as "const" so that we can do
-  // pruning in getters.
-  void PruneEntries(int64_t now_ms) const RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Removes entries that have timed out.
+  void PruneEntries(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   Clock* const clock_;
   rtc::CriticalSection lock_;
 
-  // Entries are stored in reverse chronological order (i.e. with the most
-  // recently updated entries appearing first). Mutability is needed for timeout
-  // pruning in const functions.
-  mutable SourceList list_ RTC_GUARDED_BY(lock_);
-  mutable SourceMap map_ RTC_GUARDED_BY(lock_);
+  // Unordered. There are few sources, so a linear search is cheaper than
+  // hashing, and updating an entry doesn't move or allocate anything.
+  std::vector<SourceEntry> entries_ RTC_GUARDED_BY(lock_);
+  uint64_t next_update_sequence_ RTC_GUARDED_BY(lock_) = 0;
+  int64_t next_prune_ms_ RTC_GUARDED_BY(lock_) = 0;
 };
 
 }  // namespace webrtc
@@ -26,6 +26,10 @@
  * -Removed usage of inttypes.h and tgmath.h
  * -Changed to use WebRtc types
  * -Added option to run encoder bitexact with ITU-T reference implementation
+ *
+ * Modifications for WebRtc, 2019:
+ * -The transmit QMF is run a block of samples at a time, using SSE2 when
+ *  available
  */
 
 /*! \file */
@@ -36,6 +40,10 @@
 
 #include "modules/third_party/g722/g722_enc_dec.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #if !defined(FALSE)
 #define FALSE 0
 #endif
@@ -180,6 +188,86 @@ int WebRtc_g722_encode_release(G722EncoderState *s)
 }
 /*- End of function --------------------------------------------------------*/
 
+/* Number of transmit QMF outputs computed ahead of the ADPCM at a time */
+#define QMF_BLOCK_PAIRS 80
+
+/* Runs the transmit QMF on 2*pairs samples of amp, discarding every other
+   output, to give pairs low and high band samples. With the QMF coefficients
+   3, -11, 12, 32, -210, 951, 3876, -805, 362, -156, 53, -11 as c[], the sum
+   and the difference of the two polyphase filters are single 24 tap filters
+   with taps c[i] at 2*i and c[11 - i] at 2*i + 1, the even taps being negated
+   for the difference. The last 22 samples are kept in s->x. */
+static void qmf_block(G722EncoderState *s, const int16_t amp[], size_t pairs,
+                      int xlow[], int xhigh[])
+{
+    static const int16_t qmf_low_taps[24] =
+    {
+           3,  -11,  -11,   53,   12, -156,   32,  362, -210, -805,  951, 3876,
+        3876,  951, -805, -210,  362,   32, -156,   12,   53,  -11,  -11,    3
+    };
+    static const int16_t qmf_high_taps[24] =
+    {
+          -3,  -11,   11,   53,  -12, -156,  -32,  362,  210, -805, -951, 3876,
+       -3876,  951,  805, -210, -362,   32,  156,   12,  -53,  -11,   11,    3
+    };
+    int16_t x[22 + 2*QMF_BLOCK_PAIRS];
+    size_t i;
+    size_t j;
+
+    for (i = 0;  i < 22;  i++)
+        x[i] = (int16_t) s->x[i + 2];
+    memcpy(&x[22], amp, 2*pairs*sizeof(amp[0]));
+    for (j = 0;  j < pairs;  j++)
+    {
+#if defined(__SSE2__)
+        /* The pairwise sums of _mm_madd_epi16() are exact, so this is bit
+           exact with the C version. */
+        __m128i low;
+        __m128i high;
+        __m128i sums;
+
+        low = _mm_setzero_si128();
+        high = _mm_setzero_si128();
+        for (i = 0;  i < 24;  i += 8)
+        {
+            __m128i in = _mm_loadu_si128((const __m128i *) &x[2*j + i]);
+
+            low = _mm_add_epi32(low, _mm_madd_epi16(in,
+                _mm_loadu_si128((const __m128i *) &qmf_low_taps[i])));
+            high = _mm_add_epi32(high, _mm_madd_epi16(in,
+                _mm_loadu_si128((const __m128i *) &qmf_high_taps[i])));
+        }
+        /* Low band total in lane 0 and high band total in lane 1, shifted
+           like in the C version below */
+        sums = _mm_add_epi32(_mm_unpacklo_epi32(low, high),
+                             _mm_unpackhi_epi32(low, high));
+        sums = _mm_srai_epi32(_mm_add_epi32(sums, _mm_srli_si128(sums, 8)),
+                              14);
+        xlow[j] = _mm_cvtsi128_si32(sums);
+        xhigh[j] = _mm_cvtsi128_si32(_mm_srli_si128(sums, 4));
+#else
+        int sumlow;
+        int sumhigh;
+
+        sumlow = 0;
+        sumhigh = 0;
+        for (i = 0;  i < 24;  i++)
+        {
+            sumlow += x[2*j + i]*qmf_low_taps[i];
+            sumhigh += x[2*j + i]*qmf_high_taps[i];
+        }
+        /* We shift by 12 to allow for the QMF filters (DC gain = 4096), plus 1
+           to allow for us summing two filters, plus 1 to allow for the 15 bit
+           input to the G.722 algorithm. */
+        xlow[j] = sumlow >> 14;
+        xhigh[j] = sumhigh >> 14;
+#endif
+    }
+    for (i = 0;  i < 24;  i++)
+        s->x[i] = x[2*pairs - 2 + i];
+}
+/*- End of function --------------------------------------------------------*/
+
 /* WebRtc, tlegrand:
  * Only define the following if bit-exactness with reference implementation
  * is needed. Will only have any effect if input signal is saturated.
@@ -248,10 +336,6 @@ size_t WebRtc_g722_encode(G722EncoderState *s, uint8_t g722_data[],
     {
         -7408,  -1616,   7408,   1616
     };
-    static const int qmf_coeffs[12] =
-    {
-           3,  -11,   12,   32, -210,  951, 3876, -805,  362, -156,   53,  -11,
-    };
     static const int ihn[3] = {0, 1, 0};
     static const int ihp[3] = {0, 3, 2};
     static const int wh[3] = {0, -214, 798};
@@ -275,15 +359,19 @@ size_t WebRtc_g722_encode(G722EncoderState *s, uint8_t g722_data[],
     int xlow;
     int xhigh;
     size_t g722_bytes;
-    /* Even and odd tap accumulators */
-    int sumeven;
-    int sumodd;
+    /* Transmit QMF outputs of the current block */
+    int qmf_low[QMF_BLOCK_PAIRS];
+    int qmf_high[QMF_BLOCK_PAIRS];
+    size_t qmf_len;
+    size_t qmf_pos;
     int ihigh;
     int ilow;
     int code;
 
     g722_bytes = 0;
     xhigh = 0;
+    qmf_len = 0;
+    qmf_pos = 0;
     for (j = 0;  j < len;  )
     {
         if (s->itu_test_mode)
@@ -300,26 +388,22 @@ size_t WebRtc_g722_encode(G722EncoderState *s, uint8_t g722_data[],
             }
             else
             {
-                /* Apply the transmit QMF */
-                /* Shuffle the buffer down */
-                for (i = 0;  i < 22;  i++)
-                    s->x[i] = s->x[i + 2];
-                s->x[22] = amp[j++];
-                s->x[23] = amp[j++];
-
-                /* Discard every other QMF output */
-                sumeven = 0;
-                sumodd = 0;
-                for (i = 0;  i < 12;  i++)
+                /* Apply the transmit QMF, a block of samples at a time. A
+                   trailing odd sample is not encoded. */
+                if (qmf_pos == qmf_len)
                 {
-                    sumodd += s->x[2*i]*qmf_coeffs[i];
-                    sumeven += s->x[2*i + 1]*qmf_coeffs[11 - i];
+                    if (len - j < 2)
+                        break;
+                    qmf_len = (len - j)/2;
+                    if (qmf_len > QMF_BLOCK_PAIRS)
+                        qmf_len = QMF_BLOCK_PAIRS;
+                    qmf_block(s, &amp[j], qmf_len, qmf_low, qmf_high);
+                    qmf_pos = 0;
                 }
-                /* We shift by 12 to allow for the QMF filters (DC gain = 4096), plus 1
-                   to allow for us summing two filters, plus 1 to allow for the 15 bit
-                   input to the G.722 algorithm. */
-                xlow = (sumeven + sumodd) >> 14;
-                xhigh = (sumeven - sumodd) >> 14;
+                xlow = qmf_low[qmf_pos];
+                xhigh = qmf_high[qmf_pos];
+                qmf_pos++;
+                j += 2;
 
 #ifdef RUN_LIKE_REFERENCE_G722
                 /* The following lines are only used to verify bit-exactness
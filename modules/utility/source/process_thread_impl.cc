@@ -10,6 +10,7 @@
 
 #include "modules/utility/source/process_thread_impl.h"
 
+#include <algorithm>
 #include <string>
 
 #include "modules/include/module.h"
@@ -97,8 +98,10 @@ void ProcessThreadImpl::WakeUp(Module* module) {
   {
     rtc::CritScope lock(&lock_);
     for (ModuleCallback& m : modules_) {
-      if (m.module == module)
+      if (m.module == module && m.next_callback != kCallProcessImmediately) {
         m.next_callback = kCallProcessImmediately;
+        Schedule(&m);
+      }
     }
   }
   wake_up_.Set();
@@ -139,6 +142,9 @@ void ProcessThreadImpl::RegisterModule(Module* module,
   {
     rtc::CritScope lock(&lock_);
     modules_.push_back(ModuleCallback(module, from));
+    // Scheduled right away, so that the process thread asks the module when
+    // it wants to be called.
+    Schedule(&modules_.back());
   }
 
   // Wake the thread calling ProcessThreadImpl::Process() to update the
@@ -153,6 +159,12 @@ void ProcessThreadImpl::DeRegisterModule(Module* module) {
 
   {
     rtc::CritScope lock(&lock_);
+    schedule_.erase(std::remove_if(schedule_.begin(), schedule_.end(),
+                                   [&module](const ScheduledCallback& s) {
+                                     return s.callback->module == module;
+                                   }),
+                    schedule_.end());
+    std::make_heap(schedule_.begin(), schedule_.end());
     modules_.remove_if(
         [&module](const ModuleCallback& m) { return m.module == module; });
   }
@@ -161,6 +173,11 @@ void ProcessThreadImpl::DeRegisterModule(Module* module) {
   module->ProcessThreadAttached(nullptr);
 }
 
+void ProcessThreadImpl::Schedule(ModuleCallback* callback) {
+  schedule_.push_back({callback->next_callback, callback});
+  std::push_heap(schedule_.begin(), schedule_.end());
+}
+
 // static
 void ProcessThreadImpl::Run(void* obj) {
   ProcessThreadImpl* impl = static_cast<ProcessThreadImpl*>(obj);
@@ -177,33 +194,56 @@ bool ProcessThreadImpl::Process() {
     rtc::CritScope lock(&lock_);
     if (stop_)
       return false;
-    for (ModuleCallback& m : modules_) {
-      // TODO(tommi): Would be good to measure the time TimeUntilNextProcess
-      // takes and dcheck if it takes too long (e.g. >=10ms).  Ideally this
-      // operation should not require taking a lock, so querying all modules
-      // should run in a matter of nanoseconds.
-      if (m.next_callback == 0)
-        m.next_callback = GetNextCallbackTime(m.module, now);
-
-      if (m.next_callback <= now ||
-          m.next_callback == kCallProcessImmediately) {
-        {
-          TRACE_EVENT2("webrtc", "ModuleProcess", "function",
-                       m.location.function_name(), "file",
-                       m.location.file_and_line());
-          m.module->Process();
-        }
-        // Use a new 'now' reference to calculate when the next callback
-        // should occur.  We'll continue to use 'now' above for the baseline
-        // of calculating how long we should wait, to reduce variance.
-        int64_t new_now = rtc::TimeMillis();
-        m.next_callback = GetNextCallbackTime(m.module, new_now);
+    // Take the modules that are due off the schedule first, so that each of
+    // them is processed at most once per wakeup.
+    std::vector<ModuleCallback*> due;
+    while (!schedule_.empty()) {
+      const ScheduledCallback next = schedule_.front();
+      ModuleCallback* m = next.callback;
+      if (next.time != m->next_callback) {
+        // Stale entry.
+        std::pop_heap(schedule_.begin(), schedule_.end());
+        schedule_.pop_back();
+        continue;
       }
+      if (m->next_callback == 0) {
+        // Newly registered module.
+        std::pop_heap(schedule_.begin(), schedule_.end());
+        schedule_.pop_back();
+        // TODO(tommi): Would be good to measure the time TimeUntilNextProcess
+        // takes and dcheck if it takes too long (e.g. >=10ms).  Ideally this
+        // operation should not require taking a lock, so querying all modules
+        // should run in a matter of nanoseconds.
+        m->next_callback = GetNextCallbackTime(m->module, now);
+        Schedule(m);
+        continue;
+      }
+      if (m->next_callback > now)
+        break;
+      std::pop_heap(schedule_.begin(), schedule_.end());
+      schedule_.pop_back();
+      due.push_back(m);
+    }
 
-      if (m.next_callback < next_checkpoint)
-        next_checkpoint = m.next_callback;
+    for (ModuleCallback* m : due) {
+      {
+        TRACE_EVENT2("webrtc", "ModuleProcess", "function",
+                     m->location.function_name(), "file",
+                     m->location.file_and_line());
+        m->module->Process();
+      }
+      // Use a new 'now' reference to calculate when the next callback
+      // should occur.  We'll continue to use 'now' above for the baseline
+      // of calculating how long we should wait, to reduce variance.
+      int64_t new_now = rtc::TimeMillis();
+      m->next_callback = GetNextCallbackTime(m->module, new_now);
+      Schedule(m);
     }
 
+    // A stale entry at the top only makes the thread wake up early.
+    if (!schedule_.empty() && schedule_.front().time < next_checkpoint)
+      next_checkpoint = schedule_.front().time;
+
     while (!queue_.empty()) {
       QueuedTask* task = queue_.front();
       queue_.pop();
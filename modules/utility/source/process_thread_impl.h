@@ -16,6 +16,7 @@
 #include <list>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "api/task_queue/queued_task.h"
 #include "modules/include/module.h"
@@ -67,13 +68,30 @@ class ProcessThreadImpl : public ProcessThread {
 
   typedef std::list<ModuleCallback> ModuleList;
 
+  // An entry in |schedule_|. The entry is stale, and skipped, if the module
+  // has been rescheduled since, i.e. if |time| no longer matches
+  // |callback->next_callback|.
+  struct ScheduledCallback {
+    int64_t time;
+    ModuleCallback* callback;
+    // Orders the heap by earliest time first.
+    bool operator<(const ScheduledCallback& other) const {
+      return time > other.time;
+    }
+  };
+
+  // Adds an entry for |callback| at its current |next_callback| time.
+  // Must be called with |lock_| held.
+  void Schedule(ModuleCallback* callback);
+
   // Warning: For some reason, if |lock_| comes immediately before |modules_|
   // with the current class layout, we will  start to have mysterious crashes
   // on Mac 10.9 debug.  I (Tommi) suspect we're hitting some obscure alignemnt
   // issues, but I haven't figured out what they are, if there are alignment
   // requirements for mutexes on Mac or if there's something else to it.
   // So be careful with changing the layout.
-  rtc::CriticalSection lock_;  // Used to guard modules_, tasks_ and stop_.
+  // Used to guard modules_, schedule_, tasks_ and stop_.
+  rtc::CriticalSection lock_;
 
   rtc::ThreadChecker thread_checker_;
   rtc::Event wake_up_;
@@ -81,6 +99,9 @@ class ProcessThreadImpl : public ProcessThread {
   std::unique_ptr<rtc::PlatformThread> thread_;
 
   ModuleList modules_;
+  // Min-heap of when each module is due, so that a wakeup only visits the
+  // modules to process instead of all registered modules.
+  std::vector<ScheduledCallback> schedule_;
   std::queue<QueuedTask*> queue_;
   bool stop_;
   const char* thread_name_;
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
+
+#include <errno.h>
+#include <linux/videodev2.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "third_party/libyuv/include/libyuv/convert.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+V4L2BufferPool::V4L2BufferPool(int device_fd, std::vector<Buffer> buffers)
+    : device_fd_(device_fd), buffers_(std::move(buffers)) {}
+
+V4L2BufferPool::~V4L2BufferPool() {
+  for (const Buffer& buffer : buffers_) {
+    munmap(buffer.start, buffer.length);
+    if (buffer.dmabuf_fd != -1)
+      close(buffer.dmabuf_fd);
+  }
+}
+
+int V4L2BufferPool::num_held() const {
+  rtc::CritScope lock(&lock_);
+  return num_held_;
+}
+
+void V4L2BufferPool::Hold() {
+  rtc::CritScope lock(&lock_);
+  ++num_held_;
+}
+
+void V4L2BufferPool::Return(size_t index) {
+  RTC_DCHECK_LT(index, buffers_.size());
+  rtc::CritScope lock(&lock_);
+  RTC_DCHECK_GT(num_held_, 0);
+  --num_held_;
+  if (stopped_)
+    return;
+  struct v4l2_buffer buf;
+  memset(&buf, 0, sizeof(struct v4l2_buffer));
+  buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+  buf.memory = V4L2_MEMORY_MMAP;
+  buf.index = static_cast<uint32_t>(index);
+  if (ioctl(device_fd_, VIDIOC_QBUF, &buf) == -1) {
+    RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer. errno = " << errno;
+  }
+}
+
+void V4L2BufferPool::Stop() {
+  rtc::CritScope lock(&lock_);
+  stopped_ = true;
+}
+
+V4L2NV12FrameBuffer::V4L2NV12FrameBuffer(
+    rtc::scoped_refptr<V4L2BufferPool> pool,
+    size_t index,
+    int width,
+    int height,
+    int stride)
+    : pool_(std::move(pool)),
+      index_(index),
+      width_(width),
+      height_(height),
+      stride_(stride) {
+  RTC_DCHECK_LT(index_, pool_->size());
+  RTC_DCHECK_GE(pool_->buffer(index_).length,
+                static_cast<size_t>(stride_) * (height_ + (height_ + 1) / 2));
+  pool_->Hold();
+}
+
+V4L2NV12FrameBuffer::~V4L2NV12FrameBuffer() {
+  pool_->Return(index_);
+}
+
+int V4L2NV12FrameBuffer::width() const {
+  return width_;
+}
+
+int V4L2NV12FrameBuffer::height() const {
+  return height_;
+}
+
+rtc::scoped_refptr<I420BufferInterface> V4L2NV12FrameBuffer::ToI420() {
+  rtc::scoped_refptr<I420Buffer> i420 = I420Buffer::Create(width_, height_);
+  libyuv::NV12ToI420(DataY(), StrideY(), DataUV(), StrideUV(),
+                     i420->MutableDataY(), i420->StrideY(),
+                     i420->MutableDataU(), i420->StrideU(),
+                     i420->MutableDataV(), i420->StrideV(), width_, height_);
+  return i420;
+}
+
+const uint8_t* V4L2NV12FrameBuffer::DataY() const {
+  return static_cast<const uint8_t*>(pool_->buffer(index_).start);
+}
+
+const uint8_t* V4L2NV12FrameBuffer::DataUV() const {
+  // V4L2_PIX_FMT_NV12 is a single plane, with the interleaved chroma
+  // following the luma.
+  return DataY() + stride_ * height_;
+}
+
+int V4L2NV12FrameBuffer::StrideY() const {
+  return stride_;
+}
+
+int V4L2NV12FrameBuffer::StrideUV() const {
+  return stride_;
+}
+
+int V4L2NV12FrameBuffer::dmabuf_fd() const {
+  return pool_->buffer(index_).dmabuf_fd;
+}
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
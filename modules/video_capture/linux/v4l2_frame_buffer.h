@@ -0,0 +1,105 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+#define MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+
+// The mmap()ed buffers of a V4L2 capture session. Shared with the frames
+// made from them, so that a buffer is queued back to the device when its
+// frame is released, and the buffers are unmapped only once capture has
+// stopped and no frame uses them any more.
+class V4L2BufferPool : public rtc::RefCountInterface {
+ public:
+  struct Buffer {
+    void* start;
+    size_t length;
+    // The buffer exported as a DMA-BUF, or -1. Owned by the pool.
+    int dmabuf_fd;
+  };
+
+  // |device_fd| isn't owned; Stop() must be called before it's closed.
+  V4L2BufferPool(int device_fd, std::vector<Buffer> buffers);
+
+  size_t size() const { return buffers_.size(); }
+  const Buffer& buffer(size_t index) const { return buffers_[index]; }
+
+  // Number of buffers held by frames.
+  int num_held() const;
+  // Called when a frame is made from a dequeued buffer.
+  void Hold();
+  // Called when the frame made from buffer |index| is released. Queues the
+  // buffer back to the device, unless the pool is stopped.
+  void Return(size_t index);
+  // Stops queuing buffers, e.g. before the device is closed.
+  void Stop();
+
+ protected:
+  ~V4L2BufferPool() override;
+
+ private:
+  rtc::CriticalSection lock_;
+  const int device_fd_;
+  const std::vector<Buffer> buffers_;
+  bool stopped_ RTC_GUARDED_BY(lock_) = false;
+  int num_held_ RTC_GUARDED_BY(lock_) = 0;
+};
+
+// An NV12 frame delivered in the V4L2 buffer it was captured in, without
+// copying. The buffer is queued back to the device when the frame is
+// released, so sinks must not hold on to it for long. ToI420() copies.
+class V4L2NV12FrameBuffer : public NV12BufferInterface {
+ public:
+  V4L2NV12FrameBuffer(rtc::scoped_refptr<V4L2BufferPool> pool,
+                      size_t index,
+                      int width,
+                      int height,
+                      int stride);
+
+  int width() const override;
+  int height() const override;
+  rtc::scoped_refptr<I420BufferInterface> ToI420() override;
+
+  const uint8_t* DataY() const override;
+  const uint8_t* DataUV() const override;
+  int StrideY() const override;
+  int StrideUV() const override;
+  // The buffer as a DMA-BUF, for hardware encoders to import, or -1. Valid
+  // for as long as the frame buffer.
+  int dmabuf_fd() const;
+
+ protected:
+  ~V4L2NV12FrameBuffer() override;
+
+ private:
+  const rtc::scoped_refptr<V4L2BufferPool> pool_;
+  const size_t index_;
+  const int width_;
+  const int height_;
+  const int stride_;
+};
+
+}  // namespace videocapturemodule
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CAPTURE_LINUX_V4L2_FRAME_BUFFER_H_
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
+
+#include <string.h>
+#include <sys/mman.h>
+
+#include <vector>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/ref_counted_object.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace videocapturemodule {
+namespace {
+
+constexpr int kWidth = 6;
+constexpr int kHeight = 4;
+constexpr int kStride = 8;
+constexpr size_t kBufferSize = kStride * (kHeight + kHeight / 2);
+
+// A pool of anonymous mappings standing in for the buffers of a device. It's
+// stopped, since there's no device to queue the buffers to.
+rtc::scoped_refptr<V4L2BufferPool> CreatePool(size_t num_buffers) {
+  std::vector<V4L2BufferPool::Buffer> buffers;
+  for (size_t i = 0; i < num_buffers; ++i) {
+    V4L2BufferPool::Buffer buffer;
+    buffer.start = mmap(nullptr, kBufferSize, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    RTC_CHECK(buffer.start != MAP_FAILED);
+    buffer.length = kBufferSize;
+    buffer.dmabuf_fd = -1;
+    buffers.push_back(buffer);
+  }
+  rtc::scoped_refptr<V4L2BufferPool> pool(
+      new rtc::RefCountedObject<V4L2BufferPool>(-1, std::move(buffers)));
+  pool->Stop();
+  return pool;
+}
+
+TEST(V4L2NV12FrameBufferTest, ConvertsInPlaceFrameToI420) {
+  rtc::scoped_refptr<V4L2BufferPool> pool = CreatePool(1);
+  uint8_t* data = static_cast<uint8_t*>(pool->buffer(0).start);
+  // Row padding is filled with values that mustn't show up in the output.
+  memset(data, 0xff, kBufferSize);
+  for (int row = 0; row < kHeight; ++row)
+    memset(data + row * kStride, 16 + row, kWidth);
+  uint8_t* uv = data + kStride * kHeight;
+  for (int row = 0; row < kHeight / 2; ++row) {
+    for (int col = 0; col < kWidth / 2; ++col) {
+      uv[row * kStride + 2 * col] = 100 + row;
+      uv[row * kStride + 2 * col + 1] = 200 + row;
+    }
+  }
+
+  rtc::scoped_refptr<V4L2NV12FrameBuffer> buffer(
+      new rtc::RefCountedObject<V4L2NV12FrameBuffer>(pool, 0, kWidth, kHeight,
+                                                     kStride));
+  EXPECT_EQ(VideoFrameBuffer::Type::kNV12, buffer->type());
+  EXPECT_EQ(data, buffer->DataY());
+  EXPECT_EQ(uv, buffer->DataUV());
+  EXPECT_EQ(-1, buffer->dmabuf_fd());
+
+  rtc::scoped_refptr<I420BufferInterface> i420 = buffer->ToI420();
+  ASSERT_EQ(kWidth, i420->width());
+  ASSERT_EQ(kHeight, i420->height());
+  for (int row = 0; row < kHeight; ++row) {
+    for (int col = 0; col < kWidth; ++col)
+      EXPECT_EQ(16 + row, i420->DataY()[row * i420->StrideY() + col]);
+  }
+  for (int row = 0; row < kHeight / 2; ++row) {
+    for (int col = 0; col < kWidth / 2; ++col) {
+      EXPECT_EQ(100 + row, i420->DataU()[row * i420->StrideU() + col]);
+      EXPECT_EQ(200 + row, i420->DataV()[row * i420->StrideV() + col]);
+    }
+  }
+}
+
+TEST(V4L2NV12FrameBufferTest, HoldsBufferUntilReleased) {
+  rtc::scoped_refptr<V4L2BufferPool> pool = CreatePool(2);
+  EXPECT_EQ(0, pool->num_held());
+  rtc::scoped_refptr<V4L2NV12FrameBuffer> first(
+      new rtc::RefCountedObject<V4L2NV12FrameBuffer>(pool, 0, kWidth, kHeight,
+                                                     kStride));
+  rtc::scoped_refptr<V4L2NV12FrameBuffer> second(
+      new rtc::RefCountedObject<V4L2NV12FrameBuffer>(pool, 1, kWidth, kHeight,
+                                                     kStride));
+  EXPECT_EQ(2, pool->num_held());
+  first = nullptr;
+  EXPECT_EQ(1, pool->num_held());
+  // The frame keeps the buffers mapped after the pool is dropped.
+  pool = nullptr;
+  EXPECT_EQ(kWidth, second->ToI420()->width());
+}
+
+}  // namespace
+}  // namespace videocapturemodule
+}  // namespace webrtc
@@ -23,15 +23,38 @@
 
 #include <new>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "api/scoped_refptr.h"
 #include "media/base/video_common.h"
 #include "modules/video_capture/video_capture.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 namespace videocapturemodule {
+namespace {
+
+// Buffers to keep queued to the device when frames are delivered without
+// copying. Sinks holding on to more frames get copies instead.
+constexpr int kMinQueuedBuffers = 2;
+
+// Returns when the frame in |buf| was captured, in the rtc::TimeMicros()
+// clock, or -1 if the driver doesn't say.
+int64_t CaptureTimeMicros(const struct v4l2_buffer& buf) {
+  if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) !=
+      V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC) {
+    return -1;
+  }
+  return buf.timestamp.tv_sec * rtc::kNumMicrosecsPerSec +
+         buf.timestamp.tv_usec;
+}
+
+}  // namespace
+
 rtc::scoped_refptr<VideoCaptureModule> VideoCaptureImpl::Create(
     const char* deviceUniqueId) {
   rtc::scoped_refptr<VideoCaptureModuleV4L2> implementation(
@@ -50,10 +73,10 @@ VideoCaptureModuleV4L2::VideoCaptureModuleV4L2()
       _buffersAllocatedByDevice(-1),
       _currentWidth(-1),
       _currentHeight(-1),
+      _currentStride(-1),
       _currentFrameRate(-1),
       _captureStarted(false),
-      _captureVideoType(VideoType::kI420),
-      _pool(NULL) {}
+      _captureVideoType(VideoType::kI420) {}
 
 int32_t VideoCaptureModuleV4L2::Init(const char* deviceUniqueIdUTF8) {
   int len = strlen((const char*)deviceUniqueIdUTF8);
@@ -127,21 +150,23 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
 
   // Supported video formats in preferred order.
   // If the requested resolution is larger than VGA, we prefer MJPEG. Go for
-  // I420 otherwise.
-  const int nFormats = 5;
+  // NV12, which is delivered without copying, or I420 otherwise.
+  const int nFormats = 6;
   unsigned int fmts[nFormats];
   if (capability.width > 640 || capability.height > 480) {
     fmts[0] = V4L2_PIX_FMT_MJPEG;
+    fmts[1] = V4L2_PIX_FMT_NV12;
+    fmts[2] = V4L2_PIX_FMT_YUV420;
+    fmts[3] = V4L2_PIX_FMT_YUYV;
+    fmts[4] = V4L2_PIX_FMT_UYVY;
+    fmts[5] = V4L2_PIX_FMT_JPEG;
+  } else {
+    fmts[0] = V4L2_PIX_FMT_NV12;
     fmts[1] = V4L2_PIX_FMT_YUV420;
     fmts[2] = V4L2_PIX_FMT_YUYV;
     fmts[3] = V4L2_PIX_FMT_UYVY;
-    fmts[4] = V4L2_PIX_FMT_JPEG;
-  } else {
-    fmts[0] = V4L2_PIX_FMT_YUV420;
-    fmts[1] = V4L2_PIX_FMT_YUYV;
-    fmts[2] = V4L2_PIX_FMT_UYVY;
-    fmts[3] = V4L2_PIX_FMT_MJPEG;
-    fmts[4] = V4L2_PIX_FMT_JPEG;
+    fmts[4] = V4L2_PIX_FMT_MJPEG;
+    fmts[5] = V4L2_PIX_FMT_JPEG;
   }
 
   // Enumerate image formats.
@@ -186,6 +211,8 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
     _captureVideoType = VideoType::kI420;
   else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_UYVY)
     _captureVideoType = VideoType::kUYVY;
+  else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_NV12)
+    _captureVideoType = VideoType::kNV12;
   else if (video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_MJPEG ||
            video_fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_JPEG)
     _captureVideoType = VideoType::kMJPEG;
@@ -199,6 +226,9 @@ int32_t VideoCaptureModuleV4L2::StartCapture(
   // initialize current width and height
   _currentWidth = video_fmt.fmt.pix.width;
   _currentHeight = video_fmt.fmt.pix.height;
+  _currentStride = video_fmt.fmt.pix.bytesperline > 0
+                       ? video_fmt.fmt.pix.bytesperline
+                       : _currentWidth;
 
   // Trying to set frame rate, before check driver capability.
   bool driver_framerate_support = true;
@@ -304,9 +334,10 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
 
   _buffersAllocatedByDevice = rbuffer.count;
 
-  // Map the buffers
-  _pool = new Buffer[rbuffer.count];
-
+  // Map the buffers. Frames delivered without copying are also exported as
+  // DMA-BUFs, where the driver supports it, for encoders to import.
+  std::vector<V4L2BufferPool::Buffer> buffers;
+  bool ok = true;
   for (unsigned int i = 0; i < rbuffer.count; i++) {
     struct v4l2_buffer buffer;
     memset(&buffer, 0, sizeof(v4l2_buffer));
@@ -315,33 +346,46 @@ bool VideoCaptureModuleV4L2::AllocateVideoBuffers() {
     buffer.index = i;
 
     if (ioctl(_deviceFd, VIDIOC_QUERYBUF, &buffer) < 0) {
-      return false;
+      ok = false;
+      break;
     }
 
-    _pool[i].start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
-                          MAP_SHARED, _deviceFd, buffer.m.offset);
-
-    if (MAP_FAILED == _pool[i].start) {
-      for (unsigned int j = 0; j < i; j++)
-        munmap(_pool[j].start, _pool[j].length);
-      return false;
+    V4L2BufferPool::Buffer mapped;
+    mapped.start = mmap(NULL, buffer.length, PROT_READ | PROT_WRITE,
+                        MAP_SHARED, _deviceFd, buffer.m.offset);
+    if (MAP_FAILED == mapped.start) {
+      ok = false;
+      break;
     }
-
-    _pool[i].length = buffer.length;
+    mapped.length = buffer.length;
+    mapped.dmabuf_fd = -1;
+
+    if (_captureVideoType == VideoType::kNV12) {
+      struct v4l2_exportbuffer expbuf;
+      memset(&expbuf, 0, sizeof(v4l2_exportbuffer));
+      expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+      expbuf.index = i;
+      expbuf.flags = O_RDONLY | O_CLOEXEC;
+      if (ioctl(_deviceFd, VIDIOC_EXPBUF, &expbuf) == 0)
+        mapped.dmabuf_fd = expbuf.fd;
+    }
+    buffers.push_back(mapped);
 
     if (ioctl(_deviceFd, VIDIOC_QBUF, &buffer) < 0) {
-      return false;
+      ok = false;
+      break;
     }
   }
-  return true;
+  // The pool unmaps the buffers when it goes away, also on failure.
+  _pool = new rtc::RefCountedObject<V4L2BufferPool>(_deviceFd,
+                                                    std::move(buffers));
+  return ok;
 }
 
 bool VideoCaptureModuleV4L2::DeAllocateVideoBuffers() {
-  // unmap buffers
-  for (int i = 0; i < _buffersAllocatedByDevice; i++)
-    munmap(_pool[i].start, _pool[i].length);
-
-  delete[] _pool;
+  // The buffers are unmapped once the frames made from them are released.
+  _pool->Stop();
+  _pool = nullptr;
 
   // turn off stream
   enum v4l2_buf_type type;
@@ -406,17 +450,32 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
           return true;
         }
       }
-      VideoCaptureCapability frameInfo;
-      frameInfo.width = _currentWidth;
-      frameInfo.height = _currentHeight;
-      frameInfo.videoType = _captureVideoType;
-
-      // convert to to I420 if needed
-      IncomingFrame((unsigned char*)_pool[buf.index].start, buf.bytesused,
-                    frameInfo);
-      // enqueue the buffer again
-      if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
-        RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+      const int64_t capture_time_us = CaptureTimeMicros(buf);
+      if (_captureVideoType == VideoType::kNV12) {
+        // The frame buffer queues the buffer again when it's released.
+        DeliverNV12Frame(buf.index, capture_time_us != -1
+                                        ? capture_time_us
+                                        : rtc::TimeMicros());
+      } else {
+        VideoCaptureCapability frameInfo;
+        frameInfo.width = _currentWidth;
+        frameInfo.height = _currentHeight;
+        frameInfo.videoType = _captureVideoType;
+
+        // convert to to I420 if needed
+        IncomingFrame(
+            static_cast<unsigned char*>(_pool->buffer(buf.index).start),
+            buf.bytesused, frameInfo);
+        // enqueue the buffer again
+        if (ioctl(_deviceFd, VIDIOC_QBUF, &buf) == -1) {
+          RTC_LOG(LS_INFO) << "Failed to enqueue capture buffer";
+        }
+      }
+      if (capture_time_us != -1) {
+        RTC_HISTOGRAM_COUNTS_1000(
+            "WebRTC.Video.V4L2.CaptureToFrameLatencyMs",
+            (rtc::TimeMicros() - capture_time_us) /
+                rtc::kNumMicrosecsPerMillisec);
       }
     }
   }
@@ -424,6 +483,21 @@ bool VideoCaptureModuleV4L2::CaptureProcess() {
   return true;
 }
 
+void VideoCaptureModuleV4L2::DeliverNV12Frame(uint32_t index,
+                                              int64_t timestamp_us) {
+  // Released when delivered, unless a sink holds on to it.
+  rtc::scoped_refptr<VideoFrameBuffer> buffer(
+      new rtc::RefCountedObject<V4L2NV12FrameBuffer>(
+          _pool, index, _currentWidth, _currentHeight, _currentStride));
+  // Capture stalls if sinks hold on to all buffers; give them copies before
+  // that happens.
+  if (_pool->num_held() >
+      static_cast<int>(_pool->size()) - kMinQueuedBuffers) {
+    buffer = buffer->ToI420();
+  }
+  IncomingFrameBuffer(std::move(buffer), timestamp_us);
+}
+
 int32_t VideoCaptureModuleV4L2::CaptureSettings(
     VideoCaptureCapability& settings) {
   settings.width = _currentWidth;
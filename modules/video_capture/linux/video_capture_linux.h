@@ -16,6 +16,8 @@
 
 #include <memory>
 
+#include "api/scoped_refptr.h"
+#include "modules/video_capture/linux/v4l2_frame_buffer.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "modules/video_capture/video_capture_impl.h"
 #include "rtc_base/critical_section.h"
@@ -40,6 +42,9 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   bool CaptureProcess();
   bool AllocateVideoBuffers();
   bool DeAllocateVideoBuffers();
+  // Delivers the NV12 frame in buffer |index|, without copying if enough
+  // buffers are left for capture to go on.
+  void DeliverNV12Frame(uint32_t index, int64_t timestamp_us);
 
   // TODO(pbos): Stop using unique_ptr and resetting the thread.
   std::unique_ptr<rtc::PlatformThread> _captureThread;
@@ -51,14 +56,11 @@ class VideoCaptureModuleV4L2 : public VideoCaptureImpl {
   int32_t _buffersAllocatedByDevice;
   int32_t _currentWidth;
   int32_t _currentHeight;
+  int32_t _currentStride;
   int32_t _currentFrameRate;
   bool _captureStarted;
   VideoType _captureVideoType;
-  struct Buffer {
-    void* start;
-    size_t length;
-  };
-  Buffer* _pool;
+  rtc::scoped_refptr<V4L2BufferPool> _pool;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
@@ -11,10 +11,13 @@
 #ifndef MODULES_VIDEO_CAPTURE_VIDEO_CAPTURE_H_
 #define MODULES_VIDEO_CAPTURE_VIDEO_CAPTURE_H_
 
+#include <memory>
+
 #include "api/video/video_rotation.h"
 #include "api/video/video_sink_interface.h"
 #include "modules/include/module.h"
 #include "modules/video_capture/video_capture_defines.h"
+#include "modules/video_capture/video_capture_mjpeg_decoder.h"
 
 namespace webrtc {
 
@@ -108,6 +111,11 @@ class VideoCaptureModule : public rtc::RefCountInterface {
   // Return whether the rotation is applied or left pending.
   virtual bool GetApplyRotation() = 0;
 
+  // Sets the decoder used for MJPEG frames, instead of libyuv. Modules that
+  // don't capture MJPEG ignore it.
+  virtual void SetMjpegDecoder(
+      std::unique_ptr<VideoCaptureMjpegDecoder> decoder) {}
+
  protected:
   ~VideoCaptureModule() override {}
 };
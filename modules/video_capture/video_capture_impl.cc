@@ -13,6 +13,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <utility>
+
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/libyuv/include/webrtc_libyuv.h"
@@ -125,6 +127,14 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
 
   TRACE_EVENT1("webrtc", "VC::IncomingFrame", "capture_time", captureTime);
 
+  if (frameInfo.videoType == VideoType::kMJPEG && mjpeg_decoder_) {
+    rtc::scoped_refptr<VideoFrameBuffer> decoded = mjpeg_decoder_->Decode(
+        videoFrame, videoFrameLength, width, abs(height));
+    if (decoded)
+      return DeliverFrameBuffer(decoded, rtc::TimeMicros(), captureTime);
+    RTC_LOG(LS_WARNING) << "Failed to decode MJPEG frame, trying libyuv.";
+  }
+
   // Not encoded, convert to I420.
   if (frameInfo.videoType != VideoType::kMJPEG &&
       CalcBufferSize(frameInfo.videoType, width, abs(height)) !=
@@ -203,6 +213,37 @@ int32_t VideoCaptureImpl::IncomingFrame(uint8_t* videoFrame,
   return 0;
 }
 
+int32_t VideoCaptureImpl::IncomingFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int64_t timestamp_us,
+    int64_t captureTime /*=0*/) {
+  rtc::CritScope cs(&_apiCs);
+  TRACE_EVENT1("webrtc", "VC::IncomingFrameBuffer", "capture_time",
+               captureTime);
+  return DeliverFrameBuffer(std::move(buffer), timestamp_us, captureTime);
+}
+
+int32_t VideoCaptureImpl::DeliverFrameBuffer(
+    rtc::scoped_refptr<VideoFrameBuffer> buffer,
+    int64_t timestamp_us,
+    int64_t captureTime) {
+  // SetApplyRotation doesn't take any lock. Make a local copy here.
+  const bool apply_rotation = apply_rotation_;
+  if (apply_rotation && _rotateFrame != kVideoRotation_0)
+    buffer = I420Buffer::Rotate(*buffer->ToI420(), _rotateFrame);
+
+  VideoFrame captureFrame =
+      VideoFrame::Builder()
+          .set_video_frame_buffer(buffer)
+          .set_timestamp_rtp(0)
+          .set_timestamp_us(timestamp_us)
+          .set_rotation(!apply_rotation ? _rotateFrame : kVideoRotation_0)
+          .build();
+  captureFrame.set_ntp_time_ms(captureTime);
+
+  return DeliverCapturedFrame(captureFrame);
+}
+
 int32_t VideoCaptureImpl::StartCapture(
     const VideoCaptureCapability& capability) {
   _requestedCapability = capability;
@@ -236,6 +277,12 @@ bool VideoCaptureImpl::SetApplyRotation(bool enable) {
   return true;
 }
 
+void VideoCaptureImpl::SetMjpegDecoder(
+    std::unique_ptr<VideoCaptureMjpegDecoder> decoder) {
+  rtc::CritScope cs(&_apiCs);
+  mjpeg_decoder_ = std::move(decoder);
+}
+
 bool VideoCaptureImpl::GetApplyRotation() {
   return apply_rotation_;
 }
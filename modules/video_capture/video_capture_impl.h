@@ -18,6 +18,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include <memory>
+
 #include "api/scoped_refptr.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_rotation.h"
@@ -26,6 +28,7 @@
 #include "modules/video_capture/video_capture_config.h"
 #include "modules/video_capture/video_capture_defines.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -58,6 +61,8 @@ class VideoCaptureImpl : public VideoCaptureModule {
   int32_t SetCaptureRotation(VideoRotation rotation) override;
   bool SetApplyRotation(bool enable) override;
   bool GetApplyRotation() override;
+  void SetMjpegDecoder(
+      std::unique_ptr<VideoCaptureMjpegDecoder> decoder) override;
 
   const char* CurrentDeviceName() const override;
 
@@ -77,6 +82,13 @@ class VideoCaptureImpl : public VideoCaptureModule {
   VideoCaptureImpl();
   ~VideoCaptureImpl() override;
 
+  // Delivers a frame that is already decoded, e.g. one in a native buffer of
+  // the platform. It's only converted to I420 if rotation is to be applied.
+  // |timestamp_us| is in the rtc::TimeMicros() clock.
+  int32_t IncomingFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                              int64_t timestamp_us,
+                              int64_t captureTime = 0);
+
   char* _deviceUniqueId;  // current Device unique name;
   rtc::CriticalSection _apiCs;
   VideoCaptureCapability _requestedCapability;  // Should be set by platform
@@ -86,6 +98,10 @@ class VideoCaptureImpl : public VideoCaptureModule {
   void UpdateFrameCount();
   uint32_t CalculateFrameRate(int64_t now_ns);
   int32_t DeliverCapturedFrame(VideoFrame& captureFrame);
+  int32_t DeliverFrameBuffer(rtc::scoped_refptr<VideoFrameBuffer> buffer,
+                             int64_t timestamp_us,
+                             int64_t captureTime)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(_apiCs);
 
   // last time the module process function was called.
   int64_t _lastProcessTimeNanos;
@@ -102,6 +118,9 @@ class VideoCaptureImpl : public VideoCaptureModule {
 
   // Indicate whether rotation should be applied before delivered externally.
   bool apply_rotation_;
+
+  std::unique_ptr<VideoCaptureMjpegDecoder> mjpeg_decoder_
+      RTC_GUARDED_BY(_apiCs);
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
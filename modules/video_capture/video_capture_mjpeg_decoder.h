@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CAPTURE_VIDEO_CAPTURE_MJPEG_DECODER_H_
+#define MODULES_VIDEO_CAPTURE_VIDEO_CAPTURE_MJPEG_DECODER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+
+namespace webrtc {
+
+// Decodes the MJPEG frames of a capture device, e.g. with a hardware
+// decoder, instead of libyuv. Called on the capture thread.
+class VideoCaptureMjpegDecoder {
+ public:
+  virtual ~VideoCaptureMjpegDecoder() = default;
+
+  // Returns the decoded frame, or null if it can't be decoded, in which case
+  // libyuv is tried. |data| is only valid for the duration of the call.
+  virtual rtc::scoped_refptr<VideoFrameBuffer> Decode(const uint8_t* data,
+                                                      size_t size,
+                                                      int width,
+                                                      int height) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CAPTURE_VIDEO_CAPTURE_MJPEG_DECODER_H_
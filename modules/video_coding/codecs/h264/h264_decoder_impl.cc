@@ -55,6 +55,20 @@ enum H264DecoderImplEvent {
   kH264DecoderEventMax = 16,
 };
 
+// The number of threads FFmpeg decodes with, for a |width|x|height| stream on
+// a machine with |number_of_cores|.
+int NumberOfThreads(int width, int height, int number_of_cores) {
+  int max_threads = 1;
+  if (width * height >= 1920 * 1080) {
+    max_threads = 8;
+  } else if (width * height >= 1280 * 720) {
+    max_threads = 4;
+  } else if (width * height > 640 * 480) {
+    max_threads = 2;
+  }
+  return std::max(1, std::min(max_threads, number_of_cores));
+}
+
 }  // namespace
 
 int H264DecoderImpl::AVGetBuffer2(AVCodecContext* context,
@@ -103,8 +117,12 @@ int H264DecoderImpl::AVGetBuffer2(AVCodecContext* context,
   // http://crbug.com/390941. Our pool is set up to zero-initialize new buffers.
   // TODO(nisse): Delete that feature from the video pool, instead add
   // an explicit call to InitializeData here.
-  rtc::scoped_refptr<I420Buffer> frame_buffer =
-      decoder->pool_.CreateBuffer(width, height);
+  rtc::scoped_refptr<I420Buffer> frame_buffer;
+  {
+    // With frame threading, FFmpeg calls this from its decoding threads.
+    rtc::CritScope lock(&decoder->pool_lock_);
+    frame_buffer = decoder->pool_.CreateBuffer(width, height);
+  }
 
   int y_size = width * height;
   int uv_size = frame_buffer->ChromaWidth() * frame_buffer->ChromaHeight();
@@ -153,6 +171,8 @@ void H264DecoderImpl::AVFreeBuffer2(void* opaque, uint8_t* data) {
 H264DecoderImpl::H264DecoderImpl()
     : kEnable8bitHdrFix_(
           !field_trial::IsEnabled("WebRTC-8bitH264HdrKillSwitch")),
+      kEnableFrameThreading_(
+          field_trial::IsEnabled("WebRTC-H264DecoderFrameThreading")),
       pool_(true),
       decoded_image_callback_(nullptr),
       has_reported_init_(false),
@@ -191,10 +211,20 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
   av_context_->extradata = nullptr;
   av_context_->extradata_size = 0;
 
-  // If this is ever increased, look at |av_context_->thread_safe_callbacks| and
-  // make it possible to disable the thread checker in the frame buffer pool.
-  av_context_->thread_count = 1;
+  // Slice threading only helps streams with several slices per frame, but
+  // adds no delay. Frame threading decodes consecutive frames in parallel and
+  // delays the output by a frame per extra thread, so it is opt-in.
+  av_context_->thread_count =
+      codec_settings ? NumberOfThreads(codec_settings->width,
+                                       codec_settings->height, number_of_cores)
+                     : 1;
   av_context_->thread_type = FF_THREAD_SLICE;
+  if (kEnableFrameThreading_ && av_context_->thread_count > 1) {
+    av_context_->thread_type |= FF_THREAD_FRAME;
+    // Lets the decoding threads call |AVGetBuffer2| directly instead of
+    // serializing them on the thread calling |Decode|.
+    av_context_->thread_safe_callbacks = 1;
+  }
 
   // Function used by FFmpeg to get buffers to store decoded frames in.
   av_context_->get_buffer2 = AVGetBuffer2;
@@ -263,9 +293,12 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   packet.size = static_cast<int>(input_image.size());
-  int64_t frame_timestamp_us = input_image.ntp_time_ms_ * 1000;  // ms -> μs
-  av_context_->reordered_opaque = frame_timestamp_us;
+  // Carries the RTP timestamp to the decoded frame, which is a later call's
+  // input with frame threading.
+  av_context_->reordered_opaque = input_image.Timestamp();
 
+  const bool frame_threading =
+      (av_context_->active_thread_type & FF_THREAD_FRAME) != 0;
   int result = avcodec_send_packet(av_context_.get(), &packet);
   if (result < 0) {
     RTC_LOG(LS_ERROR) << "avcodec_send_packet error: " << result;
@@ -274,15 +307,21 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
   }
 
   result = avcodec_receive_frame(av_context_.get(), av_frame_.get());
+  if (result == AVERROR(EAGAIN) && frame_threading) {
+    // The frame is still being decoded and is returned by a later call.
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
   if (result < 0) {
     RTC_LOG(LS_ERROR) << "avcodec_receive_frame error: " << result;
     ReportError();
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
 
-  // We don't expect reordering. Decoded frame tamestamp should match
-  // the input one.
-  RTC_DCHECK_EQ(av_frame_->reordered_opaque, frame_timestamp_us);
+  // We don't expect reordering. Without frame threading, the decoded frame
+  // timestamp should match the input one.
+  const uint32_t rtp_timestamp =
+      static_cast<uint32_t>(av_frame_->reordered_opaque);
+  RTC_DCHECK(frame_threading || rtp_timestamp == input_image.Timestamp());
 
   // Obtain the |video_frame| containing the decoded image.
   VideoFrame* input_frame =
@@ -298,16 +337,19 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
   // TODO(sakal): Maybe it is possible to get QP directly from FFmpeg.
   h264_bitstream_parser_.ParseBitstream(input_image.data(), input_image.size());
   int qp_int;
-  if (h264_bitstream_parser_.GetLastSliceQp(&qp_int)) {
+  // With frame threading, the input is not the decoded frame.
+  if (!frame_threading && h264_bitstream_parser_.GetLastSliceQp(&qp_int)) {
     qp.emplace(qp_int);
   }
 
   rtc::scoped_refptr<VideoFrameBuffer> decoded_buffer;
 
-  // Pass on color space from input frame if explicitly specified.
+  // Pass on color space from input frame if explicitly specified, unless the
+  // input is another frame.
   const ColorSpace& color_space =
-      input_image.ColorSpace() ? *input_image.ColorSpace()
-                               : ExtractH264ColorSpace(av_context_.get());
+      input_image.ColorSpace() && !frame_threading
+          ? *input_image.ColorSpace()
+          : ExtractH264ColorSpace(av_context_.get());
   // 8-bit HDR is currently not being rendered correctly in Chrome on Windows.
   // If the ColorSpace transfer function is set to ST2084, convert the 8-bit
   // buffer to a 10-bit buffer. This way 8-bit HDR content is rendered correctly
@@ -340,7 +382,7 @@ int32_t H264DecoderImpl::Decode(const EncodedImage& input_image,
 
   VideoFrame decoded_frame = VideoFrame::Builder()
                                  .set_video_frame_buffer(decoded_buffer)
-                                 .set_timestamp_rtp(input_image.Timestamp())
+                                 .set_timestamp_rtp(rtp_timestamp)
                                  .set_color_space(color_space)
                                  .build();
 
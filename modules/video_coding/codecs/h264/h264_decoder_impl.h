@@ -45,6 +45,8 @@ extern "C" {
 
 #include "common_video/h264/h264_bitstream_parser.h"
 #include "common_video/include/i420_buffer_pool.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
 
 namespace webrtc {
 
@@ -78,6 +80,9 @@ class H264DecoderImpl : public H264Decoder {
 
  private:
   const bool kEnable8bitHdrFix_;
+  // Lets FFmpeg decode several frames in parallel when decoding with more
+  // than one thread, at the cost of delaying the output.
+  const bool kEnableFrameThreading_;
   // Called by FFmpeg when it needs a frame buffer to store decoded frames in.
   // The |VideoFrame| returned by FFmpeg at |Decode| originate from here. Their
   // buffers are reference counted and freed by FFmpeg using |AVFreeBuffer2|.
@@ -93,7 +98,8 @@ class H264DecoderImpl : public H264Decoder {
   void ReportInit();
   void ReportError();
 
-  I420BufferPool pool_;
+  rtc::CriticalSection pool_lock_;
+  I420BufferPool pool_ RTC_GUARDED_BY(pool_lock_);
   std::unique_ptr<AVCodecContext, AVCodecContextDeleter> av_context_;
   std::unique_ptr<AVFrame, AVFrameDeleter> av_frame_;
 
@@ -222,6 +222,8 @@ void VideoCodecTestFixtureImpl::Config::SetCodecSettings(
 }
 
 size_t VideoCodecTestFixtureImpl::Config::NumberOfCores() const {
+  if (num_cores > 0)
+    return num_cores;
   return use_single_core ? 1 : CpuInfo::DetectNumberOfCores();
 }
 
@@ -257,6 +259,7 @@ std::string VideoCodecTestFixtureImpl::Config::ToString() const {
   ss << "\ndecode: " << decode;
   ss << "\nuse_single_core: " << use_single_core;
   ss << "\nmeasure_cpu: " << measure_cpu;
+  ss << "\nmeasure_throughput: " << measure_throughput;
   ss << "\nnum_cores: " << NumberOfCores();
   ss << "\ncodec_type: " << codec_type;
   ss << "\n\n--> codec_settings";
@@ -424,6 +427,7 @@ void VideoCodecTestFixtureImpl::ProcessAllFrames(
   });
 
   cpu_process_time_->Start();
+  const int64_t start_us = rtc::TimeMicros();
 
   for (size_t frame_num = 0; frame_num < config_.num_frames; ++frame_num) {
     auto next_rate_profile = std::next(rate_profile);
@@ -448,6 +452,7 @@ void VideoCodecTestFixtureImpl::ProcessAllFrames(
 
   // Wait until we know that the last frame has been sent for encode.
   task_queue->SendTask([] {});
+  processing_time_us_ = rtc::TimeMicros() - start_us;
 
   // Give the VideoProcessor pipeline some time to process the last frame,
   // and then release the codecs.
@@ -540,6 +545,17 @@ void VideoCodecTestFixtureImpl::AnalyzeAllFrames(
   }
 
   cpu_process_time_->Print();
+
+  if (config_.measure_throughput && processing_time_us_ > 0) {
+    // Codecs that deliver their output synchronously, as the software ones
+    // do, encode and decode each frame on the task queue, so this is their
+    // combined throughput. For the others, see enc_speed and dec_speed.
+    const double throughput_fps = static_cast<double>(config_.num_frames) *
+                                  rtc::kNumMicrosecsPerSec /
+                                  processing_time_us_;
+    PrintResult("throughput", "", config_.test_name, throughput_fps, "fps",
+                /*important=*/true);
+  }
 }
 
 void VideoCodecTestFixtureImpl::VerifyVideoStatistic(
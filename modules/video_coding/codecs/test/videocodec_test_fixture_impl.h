@@ -98,6 +98,8 @@ class VideoCodecTestFixtureImpl : public VideoCodecTestFixture {
   VideoProcessor::FrameWriterList decoded_frame_writers_;
   std::unique_ptr<VideoProcessor> processor_;
   std::unique_ptr<CpuProcessTime> cpu_process_time_;
+  // Wall-clock time taken to process all frames.
+  int64_t processing_time_us_ = 0;
 };
 
 }  // namespace test
@@ -9,6 +9,7 @@
  */
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "api/test/create_videocodec_test_fixture.h"
@@ -482,5 +483,60 @@ TEST(VideoCodecTestLibvpx, DISABLED_SvcVP9RdPerf) {
   PrintRdPerf(rd_stats);
 }
 
+// Measures how many frames per second can be encoded and decoded, across
+// resolutions, numbers of cores and layer configurations.
+TEST(VideoCodecTestLibvpx, DISABLED_Throughput) {
+  struct Clip {
+    const char* filename;
+    size_t width;
+    size_t height;
+    size_t bitrate_kbps;
+  };
+  const Clip kClips[] = {{"foreman_cif", kCifWidth, kCifHeight, 500},
+                         {"ConferenceMotion_1280_720_50", 1280, 720, 1500}};
+  struct Layers {
+    const char* codec_name;
+    size_t num_simulcast_streams;
+    size_t num_spatial_layers;
+    size_t num_temporal_layers;
+  };
+  const Layers kLayers[] = {{cricket::kVp8CodecName, 1, 1, 1},
+                            {cricket::kVp8CodecName, 3, 1, 3},
+                            {cricket::kVp9CodecName, 1, 1, 1},
+                            {cricket::kVp9CodecName, 1, 3, 3}};
+  const size_t kNumCores[] = {1, 2, 4};
+
+  for (const Clip& clip : kClips) {
+    for (const Layers& layers : kLayers) {
+      // Simulcast and spatial layers need an HD input.
+      if (layers.num_simulcast_streams * layers.num_spatial_layers > 1 &&
+          clip.height < 720) {
+        continue;
+      }
+      for (size_t num_cores : kNumCores) {
+        auto config = CreateConfig();
+        config.filename = clip.filename;
+        config.filepath = ResourcePath(config.filename, "yuv");
+        config.num_frames = kNumFramesShort;
+        config.num_cores = num_cores;
+        config.measure_throughput = true;
+        config.SetCodecSettings(
+            layers.codec_name, layers.num_simulcast_streams,
+            layers.num_spatial_layers, layers.num_temporal_layers, false,
+            false, false, clip.width, clip.height);
+        config.test_name = config.filename + "_" + config.CodecName() +
+                           "_s" + std::to_string(layers.num_simulcast_streams) +
+                           "_sl" + std::to_string(layers.num_spatial_layers) +
+                           "_tl" + std::to_string(layers.num_temporal_layers) +
+                           "_cores" + std::to_string(num_cores);
+        auto fixture = CreateVideoCodecTestFixture(config);
+
+        std::vector<RateProfile> rate_profiles = {{clip.bitrate_kbps, 30, 0}};
+        fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+      }
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -9,6 +9,7 @@
  */
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "api/test/create_videocodec_test_fixture.h"
@@ -83,5 +84,38 @@ TEST(VideoCodecTestOpenH264, SingleNalUnit) {
                    &bs_thresholds);
 }
 
+// Measures how many frames per second can be encoded and decoded, across
+// resolutions and numbers of cores. The decoder's share is reported as
+// dec_speed. Run with --force_fieldtrials=WebRTC-H264DecoderFrameThreading/
+// Enabled/ to measure frame threaded decoding.
+TEST(VideoCodecTestOpenH264, DISABLED_Throughput) {
+  struct Clip {
+    const char* filename;
+    size_t width;
+    size_t height;
+    size_t bitrate_kbps;
+  };
+  const Clip kClips[] = {{"foreman_cif", kCifWidth, kCifHeight, 500},
+                         {"ConferenceMotion_1280_720_50", 1280, 720, 1500}};
+  const size_t kNumCores[] = {1, 2, 4, 8};
+  for (const Clip& clip : kClips) {
+    for (size_t num_cores : kNumCores) {
+      auto config = CreateConfig();
+      config.filename = clip.filename;
+      config.filepath = ResourcePath(config.filename, "yuv");
+      config.num_cores = num_cores;
+      config.measure_throughput = true;
+      config.SetCodecSettings(cricket::kH264CodecName, 1, 1, 1, false, false,
+                              false, clip.width, clip.height);
+      config.test_name = config.filename + "_H264_cores" +
+                         std::to_string(num_cores);
+      auto fixture = CreateVideoCodecTestFixture(config);
+
+      std::vector<RateProfile> rate_profiles = {{clip.bitrate_kbps, 30, 0}};
+      fixture->RunTest(rate_profiles, nullptr, nullptr, nullptr);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace webrtc
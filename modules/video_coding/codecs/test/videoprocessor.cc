@@ -266,7 +266,7 @@ void VideoProcessor::ProcessFrame() {
           .set_rotation(webrtc::kVideoRotation_0)
           .build();
   // Store input frame as a reference for quality calculations.
-  if (config_.decode && !config_.measure_cpu) {
+  if (config_.decode && !config_.measure_cpu && !config_.measure_throughput) {
     if (input_frames_.size() == kMaxBufferedInputFrames) {
       input_frames_.erase(input_frames_.begin());
     }
@@ -496,8 +496,8 @@ void VideoProcessor::FrameDecoded(const VideoFrame& decoded_frame,
   frame_stat->decoded_width = decoded_frame.width();
   frame_stat->decoded_height = decoded_frame.height();
 
-  // Skip quality metrics calculation to not affect CPU usage.
-  if (!config_.measure_cpu) {
+  // Skip quality metrics calculation to not affect CPU usage or throughput.
+  if (!config_.measure_cpu && !config_.measure_throughput) {
     const auto reference_frame = input_frames_.find(frame_number);
     RTC_CHECK(reference_frame != input_frames_.cend())
         << "The codecs are either buffering too much, dropping too much, or "
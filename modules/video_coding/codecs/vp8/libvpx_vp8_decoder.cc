@@ -42,6 +42,9 @@ constexpr int kVp8ErrorPropagationTh = 30;
 // "Set to zero for unlimited.", but actual implementation requires this to be
 // a mode with 0 meaning allow delay and 1 not allowing it.
 constexpr long kDecodeDeadlineRealtime = 1;  // NOLINT
+// Keep up to one 720p frame of another resolution in the buffer pool, so that
+// resolution switches back and forth don't reallocate every time.
+constexpr size_t kMaxRetainedBufferBytes = 1280 * 720 * 3 / 2;
 
 const char kVp8PostProcArmFieldTrial[] = "WebRTC-VP8-Postproc-Config-Arm";
 
@@ -99,7 +102,9 @@ class LibvpxVp8Decoder::QpSmoother {
 LibvpxVp8Decoder::LibvpxVp8Decoder()
     : use_postproc_arm_(
           webrtc::field_trial::IsEnabled(kVp8PostProcArmFieldTrial)),
-      buffer_pool_(false, 300 /* max_number_of_buffers*/),
+      buffer_pool_(false,
+                   300 /* max_number_of_buffers*/,
+                   kMaxRetainedBufferBytes),
       decode_complete_callback_(NULL),
       inited_(false),
       decoder_(NULL),
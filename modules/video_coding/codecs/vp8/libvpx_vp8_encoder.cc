@@ -60,6 +60,9 @@ constexpr int kLowVp8QpThreshold = 29;
 constexpr int kHighVp8QpThreshold = 95;
 
 constexpr int kTokenPartitions = VP8_ONE_TOKENPARTITION;
+// libvpx hands each encoder thread a macroblock row at a time, and rows wait
+// on the one above; threads beyond this fraction of the rows mostly wait.
+constexpr int kMinMacroblockRowsPerThread = 4;
 constexpr uint32_t kVp832ByteAlign = 32u;
 
 constexpr int kRtpTicksPerSecond = 90000;
@@ -68,6 +71,18 @@ constexpr int kRtpTicksPerMs = kRtpTicksPerSecond / 1000;
 constexpr double kLowRateFactor = 1.0;
 constexpr double kHighRateFactor = 2.0;
 
+// With multiple threads, also split the tokens into as many partitions,
+// which the decoder can then parse in parallel.
+vp8e_token_partitions TokenPartitions(int threads) {
+  if (threads >= 8)
+    return VP8_EIGHT_TOKENPARTITION;
+  if (threads >= 4)
+    return VP8_FOUR_TOKENPARTITION;
+  if (threads >= 2)
+    return VP8_TWO_TOKENPARTITION;
+  return VP8_ONE_TOKENPARTITION;
+}
+
 // VP8 denoiser states.
 enum denoiserState : uint32_t {
   kDenoiserOff,
@@ -296,6 +311,8 @@ LibvpxVp8Encoder::LibvpxVp8Encoder(
           "WebRTC-VP8VariableFramerateScreenshare")),
       framerate_controller_(variable_framerate_experiment_.framerate_limit),
       num_steady_state_frames_(0),
+      adaptive_threading_experiment_(
+          ParseAdaptiveThreadingConfig("WebRTC-VP8-AdaptiveThreading")),
       fec_controller_override_(nullptr) {
   // TODO(eladalon/ilnik): These reservations might be wasting memory.
   // InitEncode() is resizing to the actual size, which might be smaller.
@@ -676,8 +693,13 @@ int LibvpxVp8Encoder::InitEncode(const VideoCodec* inst,
     vpx_configs_[i].g_w = inst->simulcastStream[stream_idx].width;
     vpx_configs_[i].g_h = inst->simulcastStream[stream_idx].height;
 
-    // Use 1 thread for lower resolutions.
-    vpx_configs_[i].g_threads = 1;
+    // Use 1 thread for lower resolutions, unless they are large enough to
+    // gain from more under the adaptive threading experiment.
+    vpx_configs_[i].g_threads =
+        adaptive_threading_experiment_.enabled
+            ? AdaptiveNumberOfThreads(vpx_configs_[i].g_w, vpx_configs_[i].g_h,
+                                      settings.number_of_cores)
+            : 1;
 
     vpx_configs_[i].rc_dropframe_thresh = FrameDropThreshold(stream_idx);
 
@@ -736,6 +758,9 @@ int LibvpxVp8Encoder::GetCpuSpeed(int width, int height) {
 }
 
 int LibvpxVp8Encoder::NumberOfThreads(int width, int height, int cpus) {
+  if (adaptive_threading_experiment_.enabled) {
+    return AdaptiveNumberOfThreads(width, height, cpus);
+  }
 #if defined(WEBRTC_ANDROID)
   if (width * height >= 320 * 180) {
     if (cpus >= 4) {
@@ -784,6 +809,18 @@ int LibvpxVp8Encoder::NumberOfThreads(int width, int height, int cpus) {
 #endif
 }
 
+int LibvpxVp8Encoder::AdaptiveNumberOfThreads(int width,
+                                              int height,
+                                              int cpus) const {
+  int threads =
+      width * height / adaptive_threading_experiment_.pixels_per_thread;
+  // Leave a core for capture, packetization and everything else.
+  threads = std::min(threads, cpus > 2 ? cpus - 1 : cpus);
+  threads = std::min(threads, (height + 15) / 16 / kMinMacroblockRowsPerThread);
+  threads = std::min(threads, adaptive_threading_experiment_.max_threads);
+  return std::max(threads, 1);
+}
+
 int LibvpxVp8Encoder::InitAndSetControlSettings() {
   vpx_codec_flags_t flags = 0;
   flags |= VPX_CODEC_USE_OUTPUT_PARTITION;
@@ -831,7 +868,9 @@ int LibvpxVp8Encoder::InitAndSetControlSettings() {
     libvpx_->codec_control(&(encoders_[i]), VP8E_SET_CPUUSED, cpu_speed_[i]);
     libvpx_->codec_control(
         &(encoders_[i]), VP8E_SET_TOKEN_PARTITIONS,
-        static_cast<vp8e_token_partitions>(kTokenPartitions));
+        adaptive_threading_experiment_.enabled
+            ? TokenPartitions(vpx_configs_[i].g_threads)
+            : static_cast<vp8e_token_partitions>(kTokenPartitions));
     libvpx_->codec_control(&(encoders_[i]), VP8E_SET_MAX_INTRA_BITRATE_PCT,
                            rc_max_intra_target_);
     // VP8E_SET_SCREEN_CONTENT_MODE 2 = screen content with more aggressive
@@ -1277,4 +1316,19 @@ LibvpxVp8Encoder::ParseVariableFramerateConfig(std::string group_name) {
   return config;
 }
 
+// static
+LibvpxVp8Encoder::AdaptiveThreadingExperiment
+LibvpxVp8Encoder::ParseAdaptiveThreadingConfig(std::string group_name) {
+  FieldTrialFlag enabled = FieldTrialFlag("Enabled");
+  FieldTrialParameter<int> pixels_per_thread("pixels_per_thread", 640 * 360);
+  FieldTrialParameter<int> max_threads("max_threads", 16);
+  ParseFieldTrial({&enabled, &pixels_per_thread, &max_threads},
+                  field_trial::FindFullName(group_name));
+  AdaptiveThreadingExperiment config;
+  config.enabled = enabled.Get();
+  config.pixels_per_thread = std::max(1, pixels_per_thread.Get());
+  config.max_threads = std::max(1, max_threads.Get());
+  return config;
+}
+
 }  // namespace webrtc
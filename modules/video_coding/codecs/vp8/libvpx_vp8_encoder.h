@@ -75,6 +75,10 @@ class LibvpxVp8Encoder : public VideoEncoder {
   // Determine number of encoder threads to use.
   int NumberOfThreads(int width, int height, int number_of_cores);
 
+  // Number of threads under the adaptive threading experiment, which scales
+  // with the frame area instead of stepping between fixed resolutions.
+  int AdaptiveNumberOfThreads(int width, int height, int number_of_cores) const;
+
   // Call encoder initialize function and set control settings.
   int InitAndSetControlSettings();
 
@@ -142,6 +146,16 @@ class LibvpxVp8Encoder : public VideoEncoder {
   FramerateController framerate_controller_;
   int num_steady_state_frames_;
 
+  // Thread count tuning for high resolutions, e.g. 1080p and 4K screenshare.
+  const struct AdaptiveThreadingExperiment {
+    bool enabled = false;
+    // One thread is used per this many pixels of the frame.
+    int pixels_per_thread = 640 * 360;
+    int max_threads = 16;
+  } adaptive_threading_experiment_;
+  static AdaptiveThreadingExperiment ParseAdaptiveThreadingConfig(
+      std::string group_name);
+
   FecControllerOverride* fec_controller_override_;
 };
 
@@ -23,6 +23,8 @@
 #include "modules/video_coding/codecs/vp8/libvpx_vp8_encoder.h"
 #include "modules/video_coding/codecs/vp8/test/mock_libvpx_interface.h"
 #include "modules/video_coding/utility/vp8_header_parser.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/time_utils.h"
 #include "test/field_trial.h"
 #include "test/video_codec_settings.h"
@@ -36,6 +38,7 @@ using ::testing::Field;
 using ::testing::Invoke;
 using ::testing::NiceMock;
 using ::testing::Return;
+using ::testing::TypedEq;
 using EncoderInfo = webrtc::VideoEncoder::EncoderInfo;
 using FramerateFractions =
     absl::InlinedVector<uint8_t, webrtc::kMaxTemporalStreams>;
@@ -164,6 +167,24 @@ TEST_F(TestVp8Impl,
             encoder.InitEncode(&codec_settings_, kSettings));
 }
 
+TEST_F(TestVp8Impl, AdaptiveThreadingScalesWithResolutionAndCores) {
+  test::ScopedFieldTrials field_trials("WebRTC-VP8-AdaptiveThreading/Enabled/");
+  codec_settings_.width = 1920;
+  codec_settings_.height = 1080;
+
+  auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
+  LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)));
+  // Nine threads' worth of pixels, capped to leave one of the cores free.
+  EXPECT_CALL(*vpx,
+              codec_enc_init(_, _, Field(&vpx_codec_enc_cfg_t::g_threads, 7u),
+                             _));
+  EXPECT_CALL(*vpx, codec_control(_, VP8E_SET_TOKEN_PARTITIONS,
+                                  TypedEq<int>(VP8_FOUR_TOKENPARTITION)));
+  const VideoEncoder::Settings settings(kCapabilities, 8, kMaxPayloadSize);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder.InitEncode(&codec_settings_, settings));
+}
+
 TEST_F(TestVp8Impl, SetRates) {
   auto* const vpx = new NiceMock<MockLibvpxVp8Interface>();
   LibvpxVp8Encoder encoder((std::unique_ptr<LibvpxInterface>(vpx)));
@@ -647,4 +668,84 @@ TEST_F(TestVp8Impl, GetEncoderInfoFpsAllocationSimulcastVideo) {
               ::testing::ElementsAreArray(expected_fps_allocation));
 }
 
+namespace {
+class CountingEncodedImageCallback : public EncodedImageCallback {
+ public:
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info,
+                        const RTPFragmentationHeader* fragmentation) override {
+    ++frames_;
+    return Result(Result::OK);
+  }
+
+  int frames() const { return frames_; }
+
+ private:
+  int frames_ = 0;
+};
+}  // namespace
+
+// Logs the wall clock and process CPU time per encoded frame for a range of
+// resolutions and core counts, with the default and the adaptive thread
+// count.
+TEST_F(TestVp8Impl, DISABLED_EncodeCpuTimePerf) {
+  constexpr int kNumFrames = 100;
+  const struct {
+    int width;
+    int height;
+  } kResolutions[] = {{1280, 720}, {1920, 1080}, {3840, 2160}};
+  for (bool adaptive : {false, true}) {
+    test::ScopedFieldTrials field_trials(
+        adaptive ? "WebRTC-VP8-AdaptiveThreading/Enabled/" : "");
+    for (const auto& resolution : kResolutions) {
+      // Mostly static content, as with screen capture.
+      std::unique_ptr<test::FrameGenerator> frame_generator =
+          test::FrameGenerator::CreateSquareGenerator(
+              resolution.width, resolution.height, absl::nullopt,
+              absl::nullopt);
+      for (int cores : {1, 2, 4, 8}) {
+        VideoCodec codec_settings = codec_settings_;
+        codec_settings.width = resolution.width;
+        codec_settings.height = resolution.height;
+        codec_settings.startBitrate =
+            resolution.width * resolution.height * 3 / 1000;
+        codec_settings.maxBitrate = codec_settings.startBitrate;
+        codec_settings.VP8()->denoisingOn = false;
+
+        std::unique_ptr<VideoEncoder> encoder = VP8Encoder::Create();
+        CountingEncodedImageCallback callback;
+        encoder->RegisterEncodeCompleteCallback(&callback);
+        ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+                  encoder->InitEncode(
+                      &codec_settings,
+                      VideoEncoder::Settings(kCapabilities, cores,
+                                             kMaxPayloadSize)));
+
+        const int64_t start_us = rtc::TimeMicros();
+        const int64_t start_cpu_ns = rtc::GetProcessCpuTimeNanos();
+        std::vector<VideoFrameType> frame_types(
+            1, VideoFrameType::kVideoFrameDelta);
+        for (int i = 0; i < kNumFrames; ++i) {
+          VideoFrame frame = *frame_generator->NextFrame();
+          frame.set_timestamp(kInitialTimestampRtp + i * 3000);
+          EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+                    encoder->Encode(frame, &frame_types));
+        }
+        const int64_t cpu_us =
+            (rtc::GetProcessCpuTimeNanos() - start_cpu_ns) /
+            rtc::kNumNanosecsPerMicrosec;
+        const int64_t elapsed_us = rtc::TimeMicros() - start_us;
+        encoder->Release();
+
+        RTC_LOG(LS_INFO) << (adaptive ? "adaptive " : "default ")
+                         << resolution.width << "x" << resolution.height
+                         << ", " << cores << " cores: "
+                         << elapsed_us / kNumFrames << " us/frame, "
+                         << cpu_us / kNumFrames << " us CPU/frame, "
+                         << callback.frames() << " frames encoded.";
+      }
+    }
+  }
+}
+
 }  // namespace webrtc
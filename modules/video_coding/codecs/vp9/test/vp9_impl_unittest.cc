@@ -17,6 +17,8 @@
 #include "modules/video_coding/codecs/test/video_codec_unittest.h"
 #include "modules/video_coding/codecs/vp9/include/vp9.h"
 #include "modules/video_coding/codecs/vp9/svc_config.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -151,6 +153,30 @@ TEST_F(TestVp9Impl, EncodeDecode) {
             color_space.chroma_siting_vertical());
 }
 
+TEST_F(TestVp9Impl, EncodeDecodeWithTileColumnsAndRowMultithreading) {
+  codec_settings_.VP9()->numberOfTileColumns = 4;
+  codec_settings_.VP9()->rowMultithreadedDecoding = true;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->InitEncode(
+                &codec_settings_,
+                VideoEncoder::Settings(kCapabilities, /*number_of_cores=*/4,
+                                       /*max_payload_size=*/0)));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder_->InitDecode(&codec_settings_, /*number_of_cores=*/4));
+
+  VideoFrame* input_frame = NextInputFrame();
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->Encode(*input_frame, nullptr));
+  EncodedImage encoded_frame;
+  CodecSpecificInfo codec_specific_info;
+  ASSERT_TRUE(WaitForEncodedFrame(&encoded_frame, &codec_specific_info));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder_->Decode(encoded_frame, false, 0));
+  std::unique_ptr<VideoFrame> decoded_frame;
+  absl::optional<uint8_t> decoded_qp;
+  ASSERT_TRUE(WaitForDecodedFrame(&decoded_frame, &decoded_qp));
+  ASSERT_TRUE(decoded_frame);
+  EXPECT_GT(I420PSNR(input_frame, decoded_frame.get()), 36);
+}
+
 TEST_F(TestVp9Impl, DecodedColorSpaceFromBitstream) {
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
             encoder_->Encode(*NextInputFrame(), nullptr));
@@ -1513,4 +1539,94 @@ TEST_F(TestVp9Impl, ReenablingUpperLayerAfterKFWithInterlayerPredIsEnabled) {
   EXPECT_EQ(encoded_frames[0]._frameType, VideoFrameType::kVideoFrameDelta);
 }
 
+namespace {
+class StoringEncodedImageCallback : public EncodedImageCallback {
+ public:
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info,
+                        const RTPFragmentationHeader* fragmentation) override {
+    EncodedImage image = encoded_image;
+    image.SetEncodedData(
+        EncodedImageBuffer::Create(encoded_image.data(), encoded_image.size()));
+    images_.push_back(image);
+    return Result(Result::OK);
+  }
+
+  const std::vector<EncodedImage>& images() const { return images_; }
+
+ private:
+  std::vector<EncodedImage> images_;
+};
+
+class CountingDecodedImageCallback : public DecodedImageCallback {
+ public:
+  int32_t Decoded(VideoFrame& decoded_image) override {
+    ++frames_;
+    return 0;
+  }
+
+  int frames() const { return frames_; }
+
+ private:
+  int frames_ = 0;
+};
+}  // namespace
+
+// Logs the encode and decode wall clock time per 4K frame for a range of tile
+// column counts, with and without row-based multithreaded decoding.
+TEST_F(TestVp9Impl, DISABLED_TileColumnsAndRowMultithreading4kPerf) {
+  constexpr int kNumFrames = 60;
+  constexpr int kNumCores = 8;
+  VideoCodec codec_settings = codec_settings_;
+  codec_settings.width = 3840;
+  codec_settings.height = 2160;
+  codec_settings.startBitrate = 12000;
+  codec_settings.maxBitrate = 12000;
+  std::unique_ptr<test::FrameGenerator> frame_generator =
+      test::FrameGenerator::CreateSquareGenerator(
+          codec_settings.width, codec_settings.height,
+          test::FrameGenerator::OutputType::kI420, absl::nullopt);
+
+  for (unsigned char tile_columns : {1, 2, 4, 8}) {
+    codec_settings.VP9()->numberOfTileColumns = tile_columns;
+    std::unique_ptr<VideoEncoder> encoder = VP9Encoder::Create();
+    StoringEncodedImageCallback encoded;
+    encoder->RegisterEncodeCompleteCallback(&encoded);
+    ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+              encoder->InitEncode(
+                  &codec_settings,
+                  VideoEncoder::Settings(kCapabilities, kNumCores,
+                                         /*max_payload_size=*/0)));
+    int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumFrames; ++i) {
+      VideoFrame frame = *frame_generator->NextFrame();
+      frame.set_timestamp(3000 * (i + 1));
+      ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder->Encode(frame, nullptr));
+    }
+    const int64_t encode_us = rtc::TimeMicros() - start_us;
+    encoder->Release();
+
+    for (bool row_mt : {false, true}) {
+      codec_settings.VP9()->rowMultithreadedDecoding = row_mt;
+      std::unique_ptr<VideoDecoder> decoder = VP9Decoder::Create();
+      CountingDecodedImageCallback decoded;
+      decoder->RegisterDecodeCompleteCallback(&decoded);
+      ASSERT_EQ(WEBRTC_VIDEO_CODEC_OK,
+                decoder->InitDecode(&codec_settings, kNumCores));
+      start_us = rtc::TimeMicros();
+      for (const EncodedImage& image : encoded.images())
+        decoder->Decode(image, false, 0);
+      const int64_t decode_us = rtc::TimeMicros() - start_us;
+      decoder->Release();
+
+      RTC_LOG(LS_INFO) << static_cast<int>(tile_columns) << " tile columns"
+                       << (row_mt ? ", row-MT decode: " : ": ")
+                       << encode_us / kNumFrames << " us/frame encode, "
+                       << decode_us / kNumFrames << " us/frame decode, "
+                       << decoded.frames() << " of "
+                       << encoded.images().size() << " frames decoded.";
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -13,15 +13,180 @@
 
 #include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
 
+#include <map>
+#include <utility>
+#include <vector>
+
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/thread_annotations.h"
 #include "vpx/vpx_codec.h"
 #include "vpx/vpx_decoder.h"
 #include "vpx/vpx_frame_buffer.h"
 
 namespace webrtc {
 
+namespace {
+
+constexpr size_t kMinBufferSize = 4096;
+// A size class whose buffers were not asked for in this many requests is
+// trimmed on the next allocation. libvpx asks for a buffer per decoded frame
+// and spatial layer.
+constexpr int64_t kMaxIdleRequests = 300;
+// If more buffers than this are in use we print warnings. VP9 is defined to
+// have 8 reference buffers, of which 3 can be referenced by any frame, see
+// https://tools.ietf.org/html/draft-grange-vp9-bitstream-00#section-2.2.2.
+// Assuming VP9 holds on to at most 8 buffers, any more buffers than that
+// would have to be by application code. Decoded frames should not be
+// referenced for longer than necessary. If we allow ~60 additional buffers
+// then the application has ~1 second to e.g. render each frame of a 60 fps
+// video.
+constexpr int kMaxNumBuffersInUse = 68;
+
+// Rounds |size| up to one of four size classes per power of two, so that a
+// buffer is at most 25% larger than asked for.
+size_t SizeClass(size_t size) {
+  if (size <= kMinBufferSize)
+    return kMinBufferSize;
+  size_t power_of_two = kMinBufferSize;
+  while (power_of_two < size)
+    power_of_two *= 2;
+  const size_t step = power_of_two / 8;
+  return (size + step - 1) / step * step;
+}
+
+}  // namespace
+
+class Vp9FrameBufferPool::FreeLists : public rtc::RefCountInterface {
+ public:
+  explicit FreeLists(size_t max_free_bytes) : max_free_bytes_(max_free_bytes) {}
+
+  ~FreeLists() override {
+    for (auto& entry : size_classes_) {
+      for (Vp9FrameBuffer* buffer : entry.second.free)
+        delete buffer;
+    }
+  }
+
+  // Returns a buffer of at least |min_size|, with no references.
+  Vp9FrameBuffer* Get(size_t min_size) {
+    const size_t size = SizeClass(min_size);
+    Vp9FrameBuffer* buffer = nullptr;
+    std::vector<Vp9FrameBuffer*> trimmed;
+    {
+      rtc::CritScope lock(&lock_);
+      SizeClassState& size_class = size_classes_[size];
+      size_class.last_request = ++requests_;
+      if (!size_class.free.empty()) {
+        buffer = size_class.free.back();
+        size_class.free.pop_back();
+        --stats_.free_buffers;
+        stats_.free_bytes -= size;
+        ++stats_.reuses;
+      } else {
+        ++stats_.allocations;
+        TrimIdleSizeClasses(&trimmed);
+      }
+      ++stats_.buffers_in_use;
+      stats_.bytes_in_use += size;
+      if (stats_.buffers_in_use > kMaxNumBuffersInUse) {
+        RTC_LOG(LS_WARNING)
+            << stats_.buffers_in_use << " Vp9FrameBuffers are in use in a "
+            << "Vp9FrameBufferPool (exceeding what is considered reasonable, "
+            << kMaxNumBuffersInUse << ").";
+      }
+    }
+    for (Vp9FrameBuffer* buffer : trimmed)
+      delete buffer;
+    if (!buffer)
+      buffer = new Vp9FrameBuffer(size);
+    buffer->free_lists_ = this;
+    return buffer;
+  }
+
+  // Called when the last reference to |buffer| is dropped. The buffer no
+  // longer holds a reference to this object.
+  void Recycle(Vp9FrameBuffer* buffer) {
+    RTC_DCHECK(!buffer->free_lists_);
+    const size_t size = buffer->data_.capacity();
+    {
+      rtc::CritScope lock(&lock_);
+      --stats_.buffers_in_use;
+      stats_.bytes_in_use -= size;
+      if (!closed_ && stats_.free_bytes + size <= max_free_bytes_) {
+        size_classes_[size].free.push_back(buffer);
+        ++stats_.free_buffers;
+        stats_.free_bytes += size;
+        return;
+      }
+      if (!closed_)
+        ++stats_.trimmed;
+    }
+    delete buffer;
+  }
+
+  // Deletes the free buffers, and buffers in use once they are released.
+  void Close() {
+    std::vector<Vp9FrameBuffer*> deleted;
+    {
+      rtc::CritScope lock(&lock_);
+      closed_ = true;
+      for (auto& entry : size_classes_) {
+        deleted.insert(deleted.end(), entry.second.free.begin(),
+                       entry.second.free.end());
+      }
+      size_classes_.clear();
+      stats_.free_buffers = 0;
+      stats_.free_bytes = 0;
+    }
+    for (Vp9FrameBuffer* buffer : deleted)
+      delete buffer;
+  }
+
+  Stats GetStats() const {
+    rtc::CritScope lock(&lock_);
+    return stats_;
+  }
+
+ private:
+  struct SizeClassState {
+    std::vector<Vp9FrameBuffer*> free;
+    int64_t last_request = 0;
+  };
+
+  void TrimIdleSizeClasses(std::vector<Vp9FrameBuffer*>* trimmed)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    for (auto it = size_classes_.begin(); it != size_classes_.end();) {
+      SizeClassState& size_class = it->second;
+      if (requests_ - size_class.last_request <= kMaxIdleRequests) {
+        ++it;
+        continue;
+      }
+      trimmed->insert(trimmed->end(), size_class.free.begin(),
+                      size_class.free.end());
+      stats_.trimmed += size_class.free.size();
+      stats_.free_buffers -= size_class.free.size();
+      stats_.free_bytes -= size_class.free.size() * it->first;
+      it = size_classes_.erase(it);
+    }
+  }
+
+  const size_t max_free_bytes_;
+  rtc::CriticalSection lock_;
+  bool closed_ RTC_GUARDED_BY(lock_) = false;
+  int64_t requests_ RTC_GUARDED_BY(lock_) = 0;
+  // Keyed by buffer capacity.
+  std::map<size_t, SizeClassState> size_classes_ RTC_GUARDED_BY(lock_);
+  Stats stats_ RTC_GUARDED_BY(lock_);
+};
+
+Vp9FrameBufferPool::Vp9FrameBuffer::Vp9FrameBuffer(size_t capacity)
+    : data_(0, capacity) {}
+
+Vp9FrameBufferPool::Vp9FrameBuffer::~Vp9FrameBuffer() = default;
+
 uint8_t* Vp9FrameBufferPool::Vp9FrameBuffer::GetData() {
   return data_.data<uint8_t>();
 }
@@ -31,9 +196,33 @@ size_t Vp9FrameBufferPool::Vp9FrameBuffer::GetDataSize() const {
 }
 
 void Vp9FrameBufferPool::Vp9FrameBuffer::SetSize(size_t size) {
+  RTC_DCHECK_LE(size, data_.capacity());
   data_.SetSize(size);
 }
 
+void Vp9FrameBufferPool::Vp9FrameBuffer::AddRef() const {
+  ref_count_.IncRef();
+}
+
+rtc::RefCountReleaseStatus Vp9FrameBufferPool::Vp9FrameBuffer::Release()
+    const {
+  const rtc::RefCountReleaseStatus status = ref_count_.DecRef();
+  if (status == rtc::RefCountReleaseStatus::kDroppedLastRef) {
+    // Hold on to the free lists until the buffer is back in them.
+    rtc::scoped_refptr<FreeLists> free_lists = std::move(free_lists_);
+    free_lists->Recycle(const_cast<Vp9FrameBuffer*>(this));
+  }
+  return status;
+}
+
+Vp9FrameBufferPool::Vp9FrameBufferPool(size_t max_free_bytes)
+    : max_free_bytes_(max_free_bytes),
+      free_lists_(new rtc::RefCountedObject<FreeLists>(max_free_bytes)) {}
+
+Vp9FrameBufferPool::~Vp9FrameBufferPool() {
+  free_lists_->Close();
+}
+
 bool Vp9FrameBufferPool::InitializeVpxUsePool(
     vpx_codec_ctx* vpx_codec_context) {
   RTC_DCHECK(vpx_codec_context);
@@ -56,50 +245,22 @@ bool Vp9FrameBufferPool::InitializeVpxUsePool(
 rtc::scoped_refptr<Vp9FrameBufferPool::Vp9FrameBuffer>
 Vp9FrameBufferPool::GetFrameBuffer(size_t min_size) {
   RTC_DCHECK_GT(min_size, 0);
-  rtc::scoped_refptr<Vp9FrameBuffer> available_buffer = nullptr;
-  {
-    rtc::CritScope cs(&buffers_lock_);
-    // Do we have a buffer we can recycle?
-    for (const auto& buffer : allocated_buffers_) {
-      if (buffer->HasOneRef()) {
-        available_buffer = buffer;
-        break;
-      }
-    }
-    // Otherwise create one.
-    if (available_buffer == nullptr) {
-      available_buffer = new rtc::RefCountedObject<Vp9FrameBuffer>();
-      allocated_buffers_.push_back(available_buffer);
-      if (allocated_buffers_.size() > max_num_buffers_) {
-        RTC_LOG(LS_WARNING)
-            << allocated_buffers_.size() << " Vp9FrameBuffers have been "
-            << "allocated by a Vp9FrameBufferPool (exceeding what is "
-            << "considered reasonable, " << max_num_buffers_ << ").";
-
-        // TODO(phoglund): this limit is being hit in tests since Oct 5 2016.
-        // See https://bugs.chromium.org/p/webrtc/issues/detail?id=6484.
-        // RTC_NOTREACHED();
-      }
-    }
-  }
-
-  available_buffer->SetSize(min_size);
-  return available_buffer;
+  rtc::scoped_refptr<Vp9FrameBuffer> buffer = free_lists_->Get(min_size);
+  buffer->SetSize(min_size);
+  return buffer;
 }
 
 int Vp9FrameBufferPool::GetNumBuffersInUse() const {
-  int num_buffers_in_use = 0;
-  rtc::CritScope cs(&buffers_lock_);
-  for (const auto& buffer : allocated_buffers_) {
-    if (!buffer->HasOneRef())
-      ++num_buffers_in_use;
-  }
-  return num_buffers_in_use;
+  return free_lists_->GetStats().buffers_in_use;
+}
+
+Vp9FrameBufferPool::Stats Vp9FrameBufferPool::GetStats() const {
+  return free_lists_->GetStats();
 }
 
 void Vp9FrameBufferPool::ClearPool() {
-  rtc::CritScope cs(&buffers_lock_);
-  allocated_buffers_.clear();
+  free_lists_->Close();
+  free_lists_ = new rtc::RefCountedObject<FreeLists>(max_free_bytes_);
 }
 
 // static
@@ -14,12 +14,13 @@
 
 #ifdef RTC_ENABLE_VP9
 
-#include <vector>
+#include <stddef.h>
+#include <stdint.h>
 
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
-#include "rtc_base/critical_section.h"
 #include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counter.h"
 
 struct vpx_codec_ctx;
 struct vpx_codec_frame_buffer;
@@ -36,6 +37,12 @@ namespace webrtc {
 // using scoped_refptr, the image buffer can be reused by VideoFrames and no
 // frame copy has to occur during decoding and frame delivery.
 //
+// Buffers are allocated in size classes, four per power of two, and a buffer
+// returns itself to the free list of its class when its last reference is
+// dropped. Free buffers are deleted when keeping them would exceed the
+// pool's budget of free memory, or when their size class has not been asked
+// for in a while, e.g. after the stream's resolution went back down.
+//
 // Pseudo example usage case:
 //    Vp9FrameBufferPool pool;
 //    pool.InitializeVpxUsePool(decoder_ctx);
@@ -53,20 +60,52 @@ namespace webrtc {
 //    // Destroying the codec will make libvpx release any buffers it was using.
 //    vpx_codec_destroy(decoder_ctx);
 class Vp9FrameBufferPool {
+  // The free buffers, shared with the buffers in use so that these can
+  // return to it from any thread, and also after the pool is gone.
+  class FreeLists;
+
  public:
+  static constexpr size_t kDefaultMaxFreeBytes = 128 * 1024 * 1024;
+
   class Vp9FrameBuffer : public rtc::RefCountInterface {
    public:
     uint8_t* GetData();
     size_t GetDataSize() const;
     void SetSize(size_t size);
 
-    virtual bool HasOneRef() const = 0;
+    void AddRef() const override;
+    rtc::RefCountReleaseStatus Release() const override;
 
    private:
+    friend class FreeLists;
+
+    explicit Vp9FrameBuffer(size_t capacity);
+    ~Vp9FrameBuffer() override;
+
+    mutable webrtc_impl::RefCounter ref_count_{0};
+    // Set while the buffer is in use.
+    mutable rtc::scoped_refptr<FreeLists> free_lists_;
     // Data as an easily resizable buffer.
     rtc::Buffer data_;
   };
 
+  struct Stats {
+    // Buffers allocated from the heap, and requests served by free buffers.
+    int64_t allocations = 0;
+    int64_t reuses = 0;
+    // Free buffers deleted to stay within budget or because their size class
+    // went unused.
+    int64_t trimmed = 0;
+    int buffers_in_use = 0;
+    size_t bytes_in_use = 0;
+    int free_buffers = 0;
+    size_t free_bytes = 0;
+  };
+
+  // |max_free_bytes| bounds the memory held by buffers not in use.
+  explicit Vp9FrameBufferPool(size_t max_free_bytes = kDefaultMaxFreeBytes);
+  ~Vp9FrameBufferPool();
+
   // Configures libvpx to, in the specified context, use this memory pool for
   // buffers used to decompress frames. This is only supported for VP9.
   bool InitializeVpxUsePool(vpx_codec_ctx* vpx_codec_context);
@@ -77,6 +116,7 @@ class Vp9FrameBufferPool {
   rtc::scoped_refptr<Vp9FrameBuffer> GetFrameBuffer(size_t min_size);
   // Gets the number of buffers currently in use (not ready to be recycled).
   int GetNumBuffersInUse() const;
+  Stats GetStats() const;
   // Releases allocated buffers, deleting available buffers. Buffers in use are
   // not deleted until they are no longer referenced.
   void ClearPool();
@@ -103,21 +143,9 @@ class Vp9FrameBufferPool {
                                        vpx_codec_frame_buffer* fb);
 
  private:
-  // Protects |allocated_buffers_|.
-  rtc::CriticalSection buffers_lock_;
-  // All buffers, in use or ready to be recycled.
-  std::vector<rtc::scoped_refptr<Vp9FrameBuffer>> allocated_buffers_
-      RTC_GUARDED_BY(buffers_lock_);
-  // If more buffers than this are allocated we print warnings and crash if in
-  // debug mode. VP9 is defined to have 8 reference buffers, of which 3 can be
-  // referenced by any frame, see
-  // https://tools.ietf.org/html/draft-grange-vp9-bitstream-00#section-2.2.2.
-  // Assuming VP9 holds on to at most 8 buffers, any more buffers than that
-  // would have to be by application code. Decoded frames should not be
-  // referenced for longer than necessary. If we allow ~60 additional buffers
-  // then the application has ~1 second to e.g. render each frame of a 60 fps
-  // video.
-  static const size_t max_num_buffers_ = 68;
+  const size_t max_free_bytes_;
+  // Replaced on ClearPool().
+  rtc::scoped_refptr<FreeLists> free_lists_;
 };
 
 }  // namespace webrtc
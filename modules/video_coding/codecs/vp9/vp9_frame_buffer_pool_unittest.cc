@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifdef RTC_ENABLE_VP9
+
+#include "modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kFrameSize = 1280 * 720 * 3 / 2;
+
+TEST(Vp9FrameBufferPoolTest, ReusesReleasedBuffers) {
+  Vp9FrameBufferPool pool;
+  rtc::scoped_refptr<Vp9FrameBufferPool::Vp9FrameBuffer> buffer =
+      pool.GetFrameBuffer(kFrameSize);
+  EXPECT_EQ(kFrameSize, buffer->GetDataSize());
+  memset(buffer->GetData(), 0, buffer->GetDataSize());
+  uint8_t* data = buffer->GetData();
+  EXPECT_EQ(1, pool.GetNumBuffersInUse());
+  buffer = nullptr;
+  EXPECT_EQ(0, pool.GetNumBuffersInUse());
+
+  // A slightly smaller frame fits in the same size class.
+  buffer = pool.GetFrameBuffer(kFrameSize - 100);
+  EXPECT_EQ(data, buffer->GetData());
+  EXPECT_EQ(kFrameSize - 100, buffer->GetDataSize());
+
+  Vp9FrameBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(1, stats.allocations);
+  EXPECT_EQ(1, stats.reuses);
+  EXPECT_EQ(1, stats.buffers_in_use);
+  EXPECT_GE(stats.bytes_in_use, kFrameSize);
+  EXPECT_EQ(0, stats.free_buffers);
+}
+
+TEST(Vp9FrameBufferPoolTest, BuffersInUseAreDistinct) {
+  Vp9FrameBufferPool pool;
+  std::vector<rtc::scoped_refptr<Vp9FrameBufferPool::Vp9FrameBuffer>> buffers;
+  for (int i = 0; i < 10; ++i) {
+    buffers.push_back(pool.GetFrameBuffer(kFrameSize));
+    memset(buffers.back()->GetData(), i, kFrameSize);
+  }
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(i, buffers[i]->GetData()[kFrameSize - 1]);
+  EXPECT_EQ(10, pool.GetNumBuffersInUse());
+  buffers.clear();
+
+  Vp9FrameBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(0, stats.buffers_in_use);
+  EXPECT_EQ(0u, stats.bytes_in_use);
+  EXPECT_EQ(10, stats.free_buffers);
+}
+
+TEST(Vp9FrameBufferPoolTest, FreeBuffersStayWithinBudget) {
+  Vp9FrameBufferPool pool(/*max_free_bytes=*/2 * kFrameSize);
+  std::vector<rtc::scoped_refptr<Vp9FrameBufferPool::Vp9FrameBuffer>> buffers;
+  for (int i = 0; i < 5; ++i)
+    buffers.push_back(pool.GetFrameBuffer(kFrameSize));
+  buffers.clear();
+
+  Vp9FrameBufferPool::Stats stats = pool.GetStats();
+  EXPECT_LE(stats.free_bytes, 2 * kFrameSize);
+  EXPECT_GE(stats.free_buffers, 1);
+  EXPECT_EQ(5, stats.free_buffers + stats.trimmed);
+}
+
+TEST(Vp9FrameBufferPoolTest, TrimsIdleSizeClasses) {
+  Vp9FrameBufferPool pool;
+  pool.GetFrameBuffer(4 * kFrameSize);
+  EXPECT_EQ(1, pool.GetStats().free_buffers);
+  // Only the smaller size is used for a while, then a new size is needed.
+  for (int i = 0; i < 1000; ++i)
+    pool.GetFrameBuffer(kFrameSize);
+  pool.GetFrameBuffer(kFrameSize / 4);
+
+  Vp9FrameBufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(1, stats.trimmed);
+  EXPECT_EQ(2, stats.free_buffers);
+  EXPECT_LT(stats.free_bytes, 2 * kFrameSize);
+}
+
+TEST(Vp9FrameBufferPoolTest, BuffersOutliveClearedAndDestroyedPool) {
+  rtc::scoped_refptr<Vp9FrameBufferPool::Vp9FrameBuffer> cleared;
+  rtc::scoped_refptr<Vp9FrameBufferPool::Vp9FrameBuffer> destroyed;
+  {
+    Vp9FrameBufferPool pool;
+    cleared = pool.GetFrameBuffer(kFrameSize);
+    pool.ClearPool();
+    EXPECT_EQ(0, pool.GetNumBuffersInUse());
+    destroyed = pool.GetFrameBuffer(kFrameSize);
+    cleared = nullptr;
+    EXPECT_EQ(0, pool.GetStats().free_buffers);
+  }
+  memset(destroyed->GetData(), 0, destroyed->GetDataSize());
+}
+
+}  // namespace
+}  // namespace webrtc
+
+#endif  // RTC_ENABLE_VP9
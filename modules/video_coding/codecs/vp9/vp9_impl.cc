@@ -590,7 +590,9 @@ int VP9EncoderImpl::NumberOfThreads(int width,
                                     int number_of_cores) {
   // Keep the number of encoder threads equal to the possible number of column
   // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
-  if (width * height >= 1280 * 720 && number_of_cores > 4) {
+  if (width * height >= 1920 * 1080 && number_of_cores > 8) {
+    return 8;
+  } else if (width * height >= 1280 * 720 && number_of_cores > 4) {
     return 4;
   } else if (width * height >= 640 * 360 && number_of_cores > 2) {
     return 2;
@@ -749,7 +751,14 @@ int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // log2 unit: e.g., 0 = 1 tile column, 1 = 2 tile columns, 2 = 4 tile columns.
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
-  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, (config_->g_threads >> 1));
+  int tile_columns_log2 = config_->g_threads >> 1;
+  if (inst->VP9().numberOfTileColumns > 0) {
+    tile_columns_log2 = 0;
+    while ((2 << tile_columns_log2) <= inst->VP9().numberOfTileColumns) {
+      ++tile_columns_log2;
+    }
+  }
+  vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, tile_columns_log2);
 
   // Turn on row-based multithreading.
   vpx_codec_control(encoder_, VP9E_SET_ROW_MT, 1);
@@ -1618,6 +1627,15 @@ int VP9DecoderImpl::InitDecode(const VideoCodec* inst, int number_of_cores) {
     return WEBRTC_VIDEO_CODEC_MEMORY;
   }
 
+  // Tile columns are at least 256 pixels wide, which leaves few of them to
+  // decode in parallel. Also decode the rows within each tile in parallel.
+  if (cfg.threads > 1 && inst && inst->codecType == kVideoCodecVP9 &&
+      inst->VP9().rowMultithreadedDecoding) {
+    if (vpx_codec_control(decoder_, VP9D_SET_ROW_MT, 1)) {
+      RTC_LOG(LS_WARNING) << "Failed to enable row-based multithreading.";
+    }
+  }
+
   inited_ = true;
   // Always start with a complete key frame.
   key_frame_required_ = true;
@@ -51,7 +51,8 @@ constexpr int64_t kLogNonDecodedIntervalMs = 5000;
 FrameBuffer::FrameBuffer(Clock* clock,
                          VCMTiming* timing,
                          VCMReceiveStatisticsCallback* stats_callback)
-    : decoded_frames_history_(kMaxFramesHistory),
+    : frames_(field_trial::IsEnabled("WebRTC-FrameBuffer2-FlatFrameMap")),
+      decoded_frames_history_(kMaxFramesHistory),
       clock_(clock),
       callback_queue_(nullptr),
       jitter_estimator_(clock),
@@ -237,6 +238,15 @@ int64_t FrameBuffer::FindNextFrame(int64_t now_ms) {
     if (frame->RenderTime() == -1) {
       frame->SetRenderTime(timing_->RenderTimeMs(frame->Timestamp(), now_ms));
     }
+    if (frame->RenderTime() == 0) {
+      // A zero playout delay renders the frames as soon as they are decoded,
+      // so decode right away. The target delay only decides whether a frame
+      // has waited for too long and is skipped if a later one is decodable.
+      wait_ms = 0;
+      if (now_ms - frame->ReceivedTime() > timing_->TargetVideoDelay())
+        continue;
+      break;
+    }
     wait_ms = timing_->MaxWaitingTime(frame->RenderTime(), now_ms);
 
     // This will cause the frame buffer to prefer high framerate rather
@@ -525,13 +535,26 @@ int64_t FrameBuffer::InsertFrame(std::unique_ptr<EncodedFrame> frame) {
   // ambiguous (covering more than half the interval of 2^16). This can happen
   // when the picture id make large jumps mid stream.
   if (!frames_.empty() && id < frames_.begin()->first &&
-      frames_.rbegin()->first < id) {
+      std::prev(frames_.end())->first < id) {
     RTC_LOG(LS_WARNING)
         << "A jump in picture id was detected, clearing buffer.";
     ClearFramesAndHistory();
     last_continuous_picture_id = -1;
   }
 
+  // The flat frame map only spans a limited range of picture ids.
+  if (!frames_.Fits(id)) {
+    RTC_LOG(LS_WARNING) << "Frame with (picture_id:spatial_id) ("
+                        << id.picture_id << ":"
+                        << static_cast<int>(id.spatial_layer)
+                        << ") is too far from the buffered frames, clearing"
+                        << " buffer.";
+    ClearFramesAndHistory();
+    last_continuous_picture_id = -1;
+    if (!frames_.Fits(id))
+      return last_continuous_picture_id;
+  }
+
   auto info = frames_.emplace(id, FrameInfo()).first;
 
   if (info->second.frame) {
@@ -668,6 +691,14 @@ bool FrameBuffer::UpdateFrameInfoWithIncomingFrame(const EncodedFrame& frame,
         return false;
       }
     } else {
+      if (!frames_.Fits(ref_key)) {
+        RTC_LOG(LS_WARNING) << "Frame with (picture_id:spatial_id) ("
+                            << id.picture_id << ":"
+                            << static_cast<int>(id.spatial_layer)
+                            << ") references a frame too far back, dropping"
+                            << " frame.";
+        return false;
+      }
       auto ref_info = frames_.find(ref_key);
       bool ref_continuous =
           ref_info != frames_.end() && ref_info->second.continuous;
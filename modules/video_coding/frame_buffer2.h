@@ -23,6 +23,7 @@
 #include "modules/video_coding/inter_frame_delay.h"
 #include "modules/video_coding/jitter_estimator.h"
 #include "modules/video_coding/utility/decoded_frames_history.h"
+#include "modules/video_coding/utility/flat_frame_map.h"
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/event.h"
@@ -120,7 +121,9 @@ class FrameBuffer {
     std::unique_ptr<EncodedFrame> frame;
   };
 
-  using FrameMap = std::map<VideoLayerFrameId, FrameInfo>;
+  // Backed by a std::map, or by a FlatFrameMap if the
+  // WebRTC-FrameBuffer2-FlatFrameMap field trial is enabled.
+  using FrameMap = LayerFrameMap<FrameInfo>;
 
   // Check that the references of |frame| are valid.
   bool ValidReferences(const EncodedFrame& frame) const;
@@ -19,9 +19,11 @@
 #include "modules/video_coding/frame_object.h"
 #include "modules/video_coding/jitter_estimator.h"
 #include "modules/video_coding/timing.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/platform_thread.h"
 #include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
@@ -124,7 +126,8 @@ class VCMReceiveStatisticsCallbackMock : public VCMReceiveStatisticsCallback {
   MOCK_METHOD1(OnTimingFrameInfoUpdated, void(const TimingFrameInfo& info));
 };
 
-class TestFrameBuffer2 : public ::testing::Test {
+// The parameter tells whether the frames are stored in a FlatFrameMap.
+class TestFrameBuffer2 : public ::testing::TestWithParam<bool> {
  protected:
   static constexpr int kMaxReferences = 5;
   static constexpr int kFps1 = 1000;
@@ -133,7 +136,9 @@ class TestFrameBuffer2 : public ::testing::Test {
   static constexpr size_t kFrameSize = 10;
 
   TestFrameBuffer2()
-      : trial_("WebRTC-AddRttToPlayoutDelay/Enabled/"),
+      : trial_(GetParam() ? "WebRTC-AddRttToPlayoutDelay/Enabled/"
+                            "WebRTC-FrameBuffer2-FlatFrameMap/Enabled/"
+                          : "WebRTC-AddRttToPlayoutDelay/Enabled/"),
         clock_(0),
         timing_(&clock_),
         buffer_(new FrameBuffer(&clock_, &timing_, &stats_callback_)),
@@ -284,11 +289,15 @@ class TestFrameBuffer2 : public ::testing::Test {
 constexpr size_t TestFrameBuffer2::kFrameSize;
 #endif
 
+INSTANTIATE_TEST_SUITE_P(FlatFrameMap,
+                         TestFrameBuffer2,
+                         ::testing::Values(false, true));
+
 // Following tests are timing dependent. Either the timeouts have to
 // be increased by a large margin, which would slow down all trybots,
 // or we disable them for the very slow ones, like we do here.
 #if !defined(ADDRESS_SANITIZER) && !defined(MEMORY_SANITIZER)
-TEST_F(TestFrameBuffer2, WaitForFrame) {
+TEST_P(TestFrameBuffer2, WaitForFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -297,7 +306,7 @@ TEST_F(TestFrameBuffer2, WaitForFrame) {
   CheckFrame(0, pid, 0);
 }
 
-TEST_F(TestFrameBuffer2, OneSuperFrame) {
+TEST_P(TestFrameBuffer2, OneSuperFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -308,7 +317,7 @@ TEST_F(TestFrameBuffer2, OneSuperFrame) {
   CheckFrame(0, pid, 1);
 }
 
-TEST_F(TestFrameBuffer2, ZeroPlayoutDelay) {
+TEST_P(TestFrameBuffer2, ZeroPlayoutDelay) {
   VCMTiming timing(&clock_);
   buffer_.reset(new FrameBuffer(&clock_, &timing, &stats_callback_));
   const PlayoutDelay kPlayoutDelayMs = {0, 0};
@@ -321,8 +330,30 @@ TEST_F(TestFrameBuffer2, ZeroPlayoutDelay) {
   EXPECT_EQ(0, frames_[0]->RenderTimeMs());
 }
 
+TEST_P(TestFrameBuffer2, ZeroPlayoutDelaySkipsOnlyStaleFrames) {
+  VCMTiming timing(&clock_);
+  timing.set_min_playout_delay(0);
+  timing.set_max_playout_delay(0);
+  buffer_.reset(new FrameBuffer(&clock_, &timing, &stats_callback_));
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  // Frames that arrived within the target delay are all decoded.
+  InsertFrame(pid, 0, ts, false, true, kFrameSize);
+  InsertFrame(pid + 1, 0, ts + kFps10, false, true, kFrameSize);
+  ExtractFrame();
+  CheckFrame(0, pid, 0);
+  EXPECT_EQ(0, frames_[0]->RenderTimeMs());
+
+  // Once it has waited for too long, a frame is skipped for a later one.
+  clock_.AdvanceTimeMilliseconds(timing.TargetVideoDelay() + 1);
+  InsertFrame(pid + 2, 0, ts + 2 * kFps10, false, true, kFrameSize);
+  ExtractFrame();
+  CheckFrame(1, pid + 2, 0);
+}
+
 // Flaky test, see bugs.webrtc.org/7068.
-TEST_F(TestFrameBuffer2, DISABLED_OneUnorderedSuperFrame) {
+TEST_P(TestFrameBuffer2, DISABLED_OneUnorderedSuperFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -335,7 +366,7 @@ TEST_F(TestFrameBuffer2, DISABLED_OneUnorderedSuperFrame) {
   CheckFrame(1, pid, 1);
 }
 
-TEST_F(TestFrameBuffer2, DISABLED_OneLayerStreamReordered) {
+TEST_P(TestFrameBuffer2, DISABLED_OneLayerStreamReordered) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -357,12 +388,12 @@ TEST_F(TestFrameBuffer2, DISABLED_OneLayerStreamReordered) {
 }
 #endif  // Timing dependent tests.
 
-TEST_F(TestFrameBuffer2, ExtractFromEmptyBuffer) {
+TEST_P(TestFrameBuffer2, ExtractFromEmptyBuffer) {
   ExtractFrame();
   CheckNoFrame(0);
 }
 
-TEST_F(TestFrameBuffer2, MissingFrame) {
+TEST_P(TestFrameBuffer2, MissingFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -378,7 +409,7 @@ TEST_F(TestFrameBuffer2, MissingFrame) {
   CheckNoFrame(2);
 }
 
-TEST_F(TestFrameBuffer2, OneLayerStream) {
+TEST_P(TestFrameBuffer2, OneLayerStream) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -394,7 +425,7 @@ TEST_F(TestFrameBuffer2, OneLayerStream) {
   }
 }
 
-TEST_F(TestFrameBuffer2, DropTemporalLayerSlowDecoder) {
+TEST_P(TestFrameBuffer2, DropTemporalLayerSlowDecoder) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -426,7 +457,7 @@ TEST_F(TestFrameBuffer2, DropTemporalLayerSlowDecoder) {
   CheckNoFrame(9);
 }
 
-TEST_F(TestFrameBuffer2, DropFramesIfSystemIsStalled) {
+TEST_P(TestFrameBuffer2, DropFramesIfSystemIsStalled) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -446,7 +477,7 @@ TEST_F(TestFrameBuffer2, DropFramesIfSystemIsStalled) {
   CheckFrame(1, pid + 3, 0);
 }
 
-TEST_F(TestFrameBuffer2, DroppedFramesCountedOnClear) {
+TEST_P(TestFrameBuffer2, DroppedFramesCountedOnClear) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -461,7 +492,7 @@ TEST_F(TestFrameBuffer2, DroppedFramesCountedOnClear) {
   buffer_->Clear();
 }
 
-TEST_F(TestFrameBuffer2, InsertLateFrame) {
+TEST_P(TestFrameBuffer2, InsertLateFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -477,7 +508,7 @@ TEST_F(TestFrameBuffer2, InsertLateFrame) {
   CheckNoFrame(2);
 }
 
-TEST_F(TestFrameBuffer2, ProtectionModeNackFEC) {
+TEST_P(TestFrameBuffer2, ProtectionModeNackFEC) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
   constexpr int64_t kRttMs = 200;
@@ -497,7 +528,7 @@ TEST_F(TestFrameBuffer2, ProtectionModeNackFEC) {
   EXPECT_LT(timing_.GetCurrentJitter(), kRttMs);
 }
 
-TEST_F(TestFrameBuffer2, ProtectionModeNack) {
+TEST_P(TestFrameBuffer2, ProtectionModeNack) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
   constexpr int64_t kRttMs = 200;
@@ -519,14 +550,14 @@ TEST_F(TestFrameBuffer2, ProtectionModeNack) {
   EXPECT_GT(timing_.GetCurrentJitter(), kRttMs);
 }
 
-TEST_F(TestFrameBuffer2, NoContinuousFrame) {
+TEST_P(TestFrameBuffer2, NoContinuousFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
   EXPECT_EQ(-1, InsertFrame(pid + 1, 0, ts, false, true, kFrameSize, pid));
 }
 
-TEST_F(TestFrameBuffer2, LastContinuousFrameSingleLayer) {
+TEST_P(TestFrameBuffer2, LastContinuousFrameSingleLayer) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -538,7 +569,7 @@ TEST_F(TestFrameBuffer2, LastContinuousFrameSingleLayer) {
   EXPECT_EQ(pid + 5, InsertFrame(pid + 5, 0, ts, false, true, kFrameSize));
 }
 
-TEST_F(TestFrameBuffer2, LastContinuousFrameTwoLayers) {
+TEST_P(TestFrameBuffer2, LastContinuousFrameTwoLayers) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -556,7 +587,7 @@ TEST_F(TestFrameBuffer2, LastContinuousFrameTwoLayers) {
             InsertFrame(pid + 3, 1, ts, true, true, kFrameSize, pid + 2));
 }
 
-TEST_F(TestFrameBuffer2, PictureIdJumpBack) {
+TEST_P(TestFrameBuffer2, PictureIdJumpBack) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -574,7 +605,7 @@ TEST_F(TestFrameBuffer2, PictureIdJumpBack) {
   CheckNoFrame(2);
 }
 
-TEST_F(TestFrameBuffer2, StatsCallback) {
+TEST_P(TestFrameBuffer2, StatsCallback) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
   const int kFrameSize = 5000;
@@ -600,7 +631,7 @@ TEST_F(TestFrameBuffer2, StatsCallback) {
   CheckFrame(0, pid, 0);
 }
 
-TEST_F(TestFrameBuffer2, ForwardJumps) {
+TEST_P(TestFrameBuffer2, ForwardJumps) {
   EXPECT_EQ(5453, InsertFrame(5453, 0, 1, false, true, kFrameSize));
   ExtractFrame();
   EXPECT_EQ(5454, InsertFrame(5454, 0, 1, false, true, kFrameSize, 5453));
@@ -619,21 +650,21 @@ TEST_F(TestFrameBuffer2, ForwardJumps) {
   ExtractFrame();
 }
 
-TEST_F(TestFrameBuffer2, DuplicateFrames) {
+TEST_P(TestFrameBuffer2, DuplicateFrames) {
   EXPECT_EQ(22256, InsertFrame(22256, 0, 1, false, true, kFrameSize));
   ExtractFrame();
   EXPECT_EQ(22256, InsertFrame(22256, 0, 1, false, true, kFrameSize));
 }
 
 // TODO(philipel): implement more unittests related to invalid references.
-TEST_F(TestFrameBuffer2, InvalidReferences) {
+TEST_P(TestFrameBuffer2, InvalidReferences) {
   EXPECT_EQ(-1, InsertFrame(0, 0, 1000, false, true, kFrameSize, 2));
   EXPECT_EQ(1, InsertFrame(1, 0, 2000, false, true, kFrameSize));
   ExtractFrame();
   EXPECT_EQ(2, InsertFrame(2, 0, 3000, false, true, kFrameSize, 1));
 }
 
-TEST_F(TestFrameBuffer2, KeyframeRequired) {
+TEST_P(TestFrameBuffer2, KeyframeRequired) {
   EXPECT_EQ(1, InsertFrame(1, 0, 1000, false, true, kFrameSize));
   EXPECT_EQ(2, InsertFrame(2, 0, 2000, false, true, kFrameSize, 1));
   EXPECT_EQ(3, InsertFrame(3, 0, 3000, false, true, kFrameSize));
@@ -646,7 +677,7 @@ TEST_F(TestFrameBuffer2, KeyframeRequired) {
   CheckNoFrame(2);
 }
 
-TEST_F(TestFrameBuffer2, KeyframeClearsFullBuffer) {
+TEST_P(TestFrameBuffer2, KeyframeClearsFullBuffer) {
   const int kMaxBufferSize = 600;
 
   for (int i = 1; i <= kMaxBufferSize; ++i)
@@ -661,7 +692,7 @@ TEST_F(TestFrameBuffer2, KeyframeClearsFullBuffer) {
   CheckFrame(1, kMaxBufferSize + 1, 0);
 }
 
-TEST_F(TestFrameBuffer2, DontUpdateOnUndecodableFrame) {
+TEST_P(TestFrameBuffer2, DontUpdateOnUndecodableFrame) {
   InsertFrame(1, 0, 0, false, true, kFrameSize);
   ExtractFrame(0, true);
   InsertFrame(3, 0, 0, false, true, kFrameSize, 2, 0);
@@ -671,7 +702,7 @@ TEST_F(TestFrameBuffer2, DontUpdateOnUndecodableFrame) {
   ExtractFrame(0, true);
 }
 
-TEST_F(TestFrameBuffer2, DontDecodeOlderTimestamp) {
+TEST_P(TestFrameBuffer2, DontDecodeOlderTimestamp) {
   InsertFrame(2, 0, 1, false, true, kFrameSize);
   InsertFrame(1, 0, 2, false, true,
               kFrameSize);  // Older picture id but newer timestamp.
@@ -689,7 +720,7 @@ TEST_F(TestFrameBuffer2, DontDecodeOlderTimestamp) {
   CheckNoFrame(3);
 }
 
-TEST_F(TestFrameBuffer2, CombineFramesToSuperframe) {
+TEST_P(TestFrameBuffer2, CombineFramesToSuperframe) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -707,7 +738,7 @@ TEST_F(TestFrameBuffer2, CombineFramesToSuperframe) {
   EXPECT_EQ(frames_[0]->SpatialLayerFrameSize(1), 2 * kFrameSize);
 }
 
-TEST_F(TestFrameBuffer2, HigherSpatialLayerNonDecodable) {
+TEST_P(TestFrameBuffer2, HigherSpatialLayerNonDecodable) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
 
@@ -732,5 +763,48 @@ TEST_F(TestFrameBuffer2, HigherSpatialLayerNonDecodable) {
   CheckFrame(2, pid + 2, 1);
 }
 
+// Measures the cost of inserting three spatial layer superframes, with 30
+// superframes buffered at any time. Run with
+// --gtest_also_run_disabled_tests to get the timings logged.
+TEST_P(TestFrameBuffer2, DISABLED_InsertAndExtractSvcPerf) {
+  const int kNumSpatialLayers = 3;
+  const int kNumPictures = 30000;
+  const int kPicturesBuffered = 30;
+  const int kFrameIntervalMs = 33;
+
+  // Extracting hops to the task queue, which would hide the cost of the
+  // frame bookkeeping, so only inserting is timed.
+  int64_t insert_us = 0;
+  for (int pid = 0; pid < kNumPictures + kPicturesBuffered; ++pid) {
+    if (pid < kNumPictures) {
+      int64_t start_us = rtc::TimeMicros();
+      int64_t ts_ms = pid * kFrameIntervalMs;
+      for (int sid = 0; sid < kNumSpatialLayers; ++sid) {
+        bool inter_layer_predicted = sid > 0;
+        bool last_spatial_layer = sid == kNumSpatialLayers - 1;
+        if (pid == 0) {
+          InsertFrame(pid, sid, ts_ms, inter_layer_predicted,
+                      last_spatial_layer, kFrameSize);
+        } else {
+          InsertFrame(pid, sid, ts_ms, inter_layer_predicted,
+                      last_spatial_layer, kFrameSize, pid - 1);
+        }
+      }
+      insert_us += rtc::TimeMicros() - start_us;
+    }
+    if (pid >= kPicturesBuffered) {
+      clock_.AdvanceTimeMilliseconds(kFrameIntervalMs);
+      ExtractFrame();
+      ASSERT_TRUE(frames_.back());
+      EXPECT_EQ(pid - kPicturesBuffered, frames_.back()->id.picture_id);
+      frames_.clear();
+    }
+  }
+
+  RTC_LOG(LS_INFO) << (GetParam() ? "FlatFrameMap: " : "std::map: ")
+                   << (insert_us * 1000) / kNumPictures
+                   << " ns to insert a superframe.";
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
@@ -153,9 +153,12 @@ void VCMJitterEstimator::UpdateEstimate(int64_t frameDelayMS,
   }
   _prevFrameSize = frameSizeBytes;
 
+  // |_varNoise| isn't updated until EstimateRandomJitter() below.
+  const double stdDevNoise = sqrt(_varNoise);
+
   // Cap frameDelayMS based on the current time deviation noise.
   int64_t max_time_deviation_ms =
-      static_cast<int64_t>(time_deviation_upper_bound_ * sqrt(_varNoise) + 0.5);
+      static_cast<int64_t>(time_deviation_upper_bound_ * stdDevNoise + 0.5);
   frameDelayMS = std::max(std::min(frameDelayMS, max_time_deviation_ms),
                           -max_time_deviation_ms);
 
@@ -165,7 +168,7 @@ void VCMJitterEstimator::UpdateEstimate(int64_t frameDelayMS,
   // line slope.
   double deviation = DeviationFromExpectedDelay(frameDelayMS, deltaFS);
 
-  if (fabs(deviation) < _numStdDevDelayOutlier * sqrt(_varNoise) ||
+  if (fabs(deviation) < _numStdDevDelayOutlier * stdDevNoise ||
       frameSizeBytes >
           _avgFrameSize + _numStdDevFrameSizeOutlier * sqrt(_varFrameSize)) {
     // Update the variance of the deviation from the line given by the Kalman
@@ -185,7 +188,7 @@ void VCMJitterEstimator::UpdateEstimate(int64_t frameDelayMS,
   } else {
     int nStdDev =
         (deviation >= 0) ? _numStdDevDelayOutlier : -_numStdDevDelayOutlier;
-    EstimateRandomJitter(nStdDev * sqrt(_varNoise), incompleteFrame);
+    EstimateRandomJitter(nStdDev * stdDevNoise, incompleteFrame);
   }
   // Post process the total estimated jitter
   if (_startupCount >= kStartupDelaySamples) {
@@ -294,7 +297,7 @@ void VCMJitterEstimator::EstimateRandomJitter(double d_dT,
                                               bool incompleteFrame) {
   uint64_t now = clock_->TimeInMicroseconds();
   if (_lastUpdateT != -1) {
-    fps_counter_.AddSample(now - _lastUpdateT);
+    fps_counter_.AddSample(rtc::saturated_cast<int>(now - _lastUpdateT));
   }
   _lastUpdateT = now;
 
@@ -417,10 +420,12 @@ int VCMJitterEstimator::GetJitterEstimate(
 }
 
 double VCMJitterEstimator::GetFrameRate() const {
-  if (fps_counter_.ComputeMean() <= 0.0)
+  absl::optional<double> mean_frame_interval_us =
+      fps_counter_.GetUnroundedAverage();
+  if (!mean_frame_interval_us || *mean_frame_interval_us <= 0.0)
     return 0;
 
-  double fps = 1000000.0 / fps_counter_.ComputeMean();
+  double fps = 1000000.0 / *mean_frame_interval_us;
   // Sanity check.
   assert(fps >= 0.0);
   if (fps > kMaxFramerateEstimate) {
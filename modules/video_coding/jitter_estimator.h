@@ -12,7 +12,7 @@
 #define MODULES_VIDEO_CODING_JITTER_ESTIMATOR_H_
 
 #include "modules/video_coding/rtt_filter.h"
-#include "rtc_base/rolling_accumulator.h"
+#include "rtc_base/numerics/moving_average.h"
 
 namespace webrtc {
 
@@ -148,7 +148,8 @@ class VCMJitterEstimator {
                              // but never goes above _nackLimit
   VCMRttFilter _rttFilter;
 
-  rtc::RollingAccumulator<uint64_t> fps_counter_;
+  // Average time between frames, in microseconds.
+  rtc::MovingAverage fps_counter_;
   const double time_deviation_upper_bound_;
   Clock* clock_;
 };
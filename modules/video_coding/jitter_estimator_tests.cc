@@ -16,7 +16,9 @@
 #include "api/array_view.h"
 #include "modules/video_coding/jitter_estimator.h"
 #include "rtc_base/experiments/jitter_upper_bound_experiment.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/numerics/histogram_percentile_counter.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
@@ -144,4 +146,53 @@ TEST_F(TestVCMJitterEstimator, TestUpperBound) {
   EXPECT_GT(max_unbound, static_cast<uint32_t>(max_bounded * 1.25));
 }
 
+// Runs the estimator on a trace with random delays, frame sizes, key frames
+// and NACKs, and returns the jitter estimate after every frame.
+std::vector<int> RunRandomTrace(VCMJitterEstimator* estimator,
+                                SimulatedClock* clock,
+                                int num_frames) {
+  Random random(0x1234);
+  std::vector<int> estimates;
+  for (int i = 0; i < num_frames; ++i) {
+    bool key_frame = i % 90 == 0;
+    uint32_t frame_size = key_frame ? random.Rand(20000, 40000)
+                                    : random.Rand(1000, 3000);
+    int64_t delay_ms = random.Rand(-15, 15) + (key_frame ? 20 : 0);
+    estimator->UpdateEstimate(delay_ms, frame_size, random.Rand(0, 20) == 0);
+    if (random.Rand(0, 10) == 0)
+      estimator->FrameNacked();
+    estimator->UpdateRtt(random.Rand(50, 150));
+    estimates.push_back(estimator->GetJitterEstimate(1.0, absl::nullopt));
+    clock->AdvanceTimeMicroseconds(rtc::kNumMicrosecsPerSec / 30 +
+                                   random.Rand(-5000, 5000));
+  }
+  return estimates;
+}
+
+// The estimates are recorded from the floating point implementation this
+// estimator started out as, to catch changes in behavior when optimizing it.
+TEST_F(TestVCMJitterEstimator, MatchesRecordedEstimates) {
+  const int kRecordedEstimates[] = {
+      11,  33,  189, 202, 198, 174, 174, 174, 174, 175,
+      176, 175, 175, 175, 185, 187, 187, 186, 188, 188,
+      188, 188, 188, 184, 183, 183, 183, 180, 180, 180};
+  std::vector<int> estimates =
+      RunRandomTrace(estimator_.get(), &fake_clock_, 600);
+  int sum = 0;
+  for (size_t i = 0; i < estimates.size(); ++i) {
+    if (i % 20 == 0)
+      EXPECT_EQ(kRecordedEstimates[i / 20], estimates[i]) << "Frame " << i;
+    sum += estimates[i];
+  }
+  EXPECT_EQ(103951, sum);
+}
+
+TEST_F(TestVCMJitterEstimator, DISABLED_UpdateEstimatePerf) {
+  const int kNumFrames = 1000000;
+  int64_t start_us = rtc::TimeMicros();
+  RunRandomTrace(estimator_.get(), &fake_clock_, kNumFrames);
+  RTC_LOG(LS_INFO) << (rtc::TimeMicros() - start_us) * 1000 / kNumFrames
+                   << " ns per frame.";
+}
+
 }  // namespace webrtc
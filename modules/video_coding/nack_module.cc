@@ -46,8 +46,8 @@ int64_t GetSendNackDelay() {
 NackModule::NackInfo::NackInfo()
     : seq_num(0), send_at_seq_num(0), sent_at_time(-1), retries(0) {}
 
-NackModule::NackInfo::NackInfo(uint16_t seq_num,
-                               uint16_t send_at_seq_num,
+NackModule::NackInfo::NackInfo(int64_t seq_num,
+                               int64_t send_at_seq_num,
                                int64_t created_at_time)
     : seq_num(seq_num),
       send_at_seq_num(send_at_seq_num),
@@ -55,6 +55,83 @@ NackModule::NackInfo::NackInfo(uint16_t seq_num,
       sent_at_time(-1),
       retries(0) {}
 
+NackModule::SeqNumSet::SeqNumSet() {
+  bits_.fill(0);
+}
+
+void NackModule::SeqNumSet::Insert(int64_t seq_num) {
+  if (begin_ == end_) {
+    begin_ = seq_num;
+    end_ = seq_num + 1;
+  } else if (seq_num < begin_) {
+    if (end_ - seq_num > kSize)
+      return;
+    begin_ = seq_num;
+  } else if (seq_num >= end_) {
+    if (seq_num - begin_ >= kSize)
+      EraseBefore(seq_num - kSize + 1);
+    end_ = seq_num + 1;
+  }
+  uint64_t index = static_cast<uint64_t>(seq_num) % kSize;
+  bits_[index / kBitsPerWord] |= uint64_t{1} << (index % kBitsPerWord);
+}
+
+bool NackModule::SeqNumSet::Contains(int64_t seq_num) const {
+  if (seq_num < begin_ || seq_num >= end_)
+    return false;
+  uint64_t index = static_cast<uint64_t>(seq_num) % kSize;
+  return (bits_[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1;
+}
+
+absl::optional<int64_t> NackModule::SeqNumSet::First() const {
+  int64_t seq_num = begin_;
+  while (seq_num < end_) {
+    uint64_t index = static_cast<uint64_t>(seq_num) % kSize;
+    uint64_t word = bits_[index / kBitsPerWord] >> (index % kBitsPerWord);
+    if (word == 0) {
+      // Skip to the start of the next word.
+      seq_num += kBitsPerWord - index % kBitsPerWord;
+      continue;
+    }
+    while ((word & 1) == 0) {
+      word >>= 1;
+      ++seq_num;
+    }
+    return seq_num < end_ ? absl::optional<int64_t>(seq_num) : absl::nullopt;
+  }
+  return absl::nullopt;
+}
+
+void NackModule::SeqNumSet::EraseBefore(int64_t seq_num) {
+  if (seq_num <= begin_)
+    return;
+  if (seq_num >= end_) {
+    Clear();
+    begin_ = end_ = seq_num;
+    return;
+  }
+  ClearBits(begin_, seq_num);
+  begin_ = seq_num;
+}
+
+void NackModule::SeqNumSet::Clear() {
+  ClearBits(begin_, end_);
+  begin_ = end_;
+}
+
+void NackModule::SeqNumSet::ClearBits(int64_t begin, int64_t end) {
+  while (begin < end) {
+    uint64_t index = static_cast<uint64_t>(begin) % kSize;
+    int offset = index % kBitsPerWord;
+    int count = std::min<int64_t>(kBitsPerWord - offset, end - begin);
+    uint64_t mask = count == kBitsPerWord ? ~uint64_t{0}
+                                          : ((uint64_t{1} << count) - 1)
+                                                << offset;
+    bits_[index / kBitsPerWord] &= ~mask;
+    begin += count;
+  }
+}
+
 NackModule::NackModule(Clock* clock,
                        NackSender* nack_sender,
                        KeyFrameRequestSender* keyframe_request_sender)
@@ -65,6 +142,7 @@ NackModule::NackModule(Clock* clock,
       initialized_(false),
       rtt_ms_(kDefaultRttMs),
       newest_seq_num_(0),
+      newest_unwrapped_seq_num_(0),
       next_process_time_ms_(-1),
       send_nack_delay_ms_(GetSendNackDelay()) {
   RTC_DCHECK(clock_);
@@ -88,8 +166,9 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 
   if (!initialized_) {
     newest_seq_num_ = seq_num;
+    newest_unwrapped_seq_num_ = seq_num;
     if (is_keyframe)
-      keyframe_list_.insert(seq_num);
+      keyframe_list_.Insert(newest_unwrapped_seq_num_);
     initialized_ = true;
     return 0;
   }
@@ -99,12 +178,18 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
   if (seq_num == newest_seq_num_)
     return 0;
 
-  if (AheadOf(newest_seq_num_, seq_num)) {
+  int64_t unwrapped_seq_num = Unwrap(seq_num);
+  if (unwrapped_seq_num < newest_unwrapped_seq_num_) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
+    auto nack_list_it = std::lower_bound(
+        nack_list_.begin(), nack_list_.end(), unwrapped_seq_num,
+        [](const NackInfo& nack_info, int64_t seq_num) {
+          return nack_info.seq_num < seq_num;
+        });
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
+    if (nack_list_it != nack_list_.end() &&
+        nack_list_it->seq_num == unwrapped_seq_num) {
+      nacks_sent_for_packet = nack_list_it->retries;
       nack_list_.erase(nack_list_it);
     }
     if (!is_retransmitted)
@@ -114,27 +199,24 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 
   // Keep track of new keyframes.
   if (is_keyframe)
-    keyframe_list_.insert(seq_num);
+    keyframe_list_.Insert(unwrapped_seq_num);
 
   // And remove old ones so we don't accumulate keyframes.
-  auto it = keyframe_list_.lower_bound(seq_num - kMaxPacketAge);
-  if (it != keyframe_list_.begin())
-    keyframe_list_.erase(keyframe_list_.begin(), it);
+  keyframe_list_.EraseBefore(unwrapped_seq_num - kMaxPacketAge);
 
   if (is_recovered) {
-    recovered_list_.insert(seq_num);
+    recovered_list_.Insert(unwrapped_seq_num);
 
     // Remove old ones so we don't accumulate recovered packets.
-    auto it = recovered_list_.lower_bound(seq_num - kMaxPacketAge);
-    if (it != recovered_list_.begin())
-      recovered_list_.erase(recovered_list_.begin(), it);
+    recovered_list_.EraseBefore(unwrapped_seq_num - kMaxPacketAge);
 
     // Do not send nack for packets recovered by FEC or RTX.
     return 0;
   }
 
-  AddPacketsToNack(newest_seq_num_ + 1, seq_num);
+  AddPacketsToNack(newest_unwrapped_seq_num_ + 1, unwrapped_seq_num);
   newest_seq_num_ = seq_num;
+  newest_unwrapped_seq_num_ = unwrapped_seq_num;
 
   // Are there any nacks that are waiting for this seq_num.
   std::vector<uint16_t> nack_batch = GetNackBatch(kSeqNumOnly);
@@ -149,11 +231,13 @@ int NackModule::OnReceivedPacket(uint16_t seq_num,
 
 void NackModule::ClearUpTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
-  keyframe_list_.erase(keyframe_list_.begin(),
-                       keyframe_list_.lower_bound(seq_num));
-  recovered_list_.erase(recovered_list_.begin(),
-                        recovered_list_.lower_bound(seq_num));
+  int64_t unwrapped_seq_num = Unwrap(seq_num);
+  while (!nack_list_.empty() &&
+         nack_list_.front().seq_num < unwrapped_seq_num) {
+    nack_list_.pop_front();
+  }
+  keyframe_list_.EraseBefore(unwrapped_seq_num);
+  recovered_list_.EraseBefore(unwrapped_seq_num);
 }
 
 void NackModule::UpdateRtt(int64_t rtt_ms) {
@@ -164,8 +248,8 @@ void NackModule::UpdateRtt(int64_t rtt_ms) {
 void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
   nack_list_.clear();
-  keyframe_list_.clear();
-  recovered_list_.clear();
+  keyframe_list_.Clear();
+  recovered_list_.Clear();
 }
 
 int64_t NackModule::TimeUntilNextProcess() {
@@ -203,33 +287,37 @@ void NackModule::Process() {
 }
 
 bool NackModule::RemovePacketsUntilKeyFrame() {
-  while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
-
-    if (it != nack_list_.begin()) {
-      // We have found a keyframe that actually is newer than at least one
-      // packet in the nack list.
-      nack_list_.erase(nack_list_.begin(), it);
-      return true;
-    }
-
-    // If this keyframe is so old it does not remove any packets from the list,
-    // remove it from the list of keyframes and try the next keyframe.
-    keyframe_list_.erase(keyframe_list_.begin());
+  if (nack_list_.empty()) {
+    keyframe_list_.Clear();
+    return false;
   }
-  return false;
+
+  // Keyframes that are so old that they do not remove any packets from the
+  // list are dropped.
+  keyframe_list_.EraseBefore(nack_list_.front().seq_num + 1);
+  absl::optional<int64_t> keyframe_seq_num = keyframe_list_.First();
+  if (!keyframe_seq_num)
+    return false;
+
+  // We have found a keyframe that actually is newer than at least one packet
+  // in the nack list.
+  while (!nack_list_.empty() && nack_list_.front().seq_num < *keyframe_seq_num)
+    nack_list_.pop_front();
+  return true;
 }
 
-void NackModule::AddPacketsToNack(uint16_t seq_num_start,
-                                  uint16_t seq_num_end) {
+void NackModule::AddPacketsToNack(int64_t seq_num_start,
+                                  int64_t seq_num_end) {
   // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  while (!nack_list_.empty() &&
+         nack_list_.front().seq_num < seq_num_end - kMaxPacketAge) {
+    nack_list_.pop_front();
+  }
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
   // clear it and request a keyframe.
-  uint16_t num_new_nacks = ForwardDiff(seq_num_start, seq_num_end);
+  int64_t num_new_nacks = seq_num_end - seq_num_start;
   if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
     while (RemovePacketsUntilKeyFrame() &&
            nack_list_.size() + num_new_nacks > kMaxNackPackets) {
@@ -244,14 +332,14 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
     }
   }
 
-  for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
+  int wait_packets = WaitNumberOfPackets(0.5);
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  for (int64_t seq_num = seq_num_start; seq_num < seq_num_end; ++seq_num) {
     // Do not send nack for packets that are already recovered by FEC or RTX
-    if (recovered_list_.find(seq_num) != recovered_list_.end())
+    if (recovered_list_.Contains(seq_num))
       continue;
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5),
-                       clock_->TimeInMilliseconds());
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    RTC_DCHECK(nack_list_.empty() || nack_list_.back().seq_num < seq_num);
+    nack_list_.emplace_back(seq_num, seq_num + wait_packets, now_ms);
   }
 }
 
@@ -260,30 +348,32 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    bool delay_timed_out =
-        now_ms - it->second.created_at_time >= send_nack_delay_ms_;
-    bool nack_on_rtt_passed = now_ms - it->second.sent_at_time >= rtt_ms_;
+  // Packets that reach the max number of retries are removed by moving the
+  // remaining ones forward, in the same pass.
+  auto kept = nack_list_.begin();
+  for (auto it = nack_list_.begin(); it != nack_list_.end(); ++it) {
+    bool delay_timed_out = now_ms - it->created_at_time >= send_nack_delay_ms_;
+    bool nack_on_rtt_passed = now_ms - it->sent_at_time >= rtt_ms_;
     bool nack_on_seq_num_passed =
-        it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num);
+        it->sent_at_time == -1 &&
+        newest_unwrapped_seq_num_ >= it->send_at_seq_num;
     if (delay_timed_out && ((consider_seq_num && nack_on_seq_num_passed) ||
                             (consider_timestamp && nack_on_rtt_passed))) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        RTC_LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
+      uint16_t seq_num = static_cast<uint16_t>(it->seq_num);
+      nack_batch.emplace_back(seq_num);
+      ++it->retries;
+      it->sent_at_time = now_ms;
+      if (it->retries >= kMaxNackRetries) {
+        RTC_LOG(LS_WARNING) << "Sequence number " << seq_num
                             << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
+        continue;
       }
-      continue;
     }
-    ++it;
+    if (kept != it)
+      *kept = *it;
+    ++kept;
   }
+  nack_list_.erase(kept, nack_list_.end());
   return nack_batch;
 }
 
@@ -293,6 +383,11 @@ void NackModule::UpdateReorderingStatistics(uint16_t seq_num) {
   reordering_histogram_.Add(diff);
 }
 
+int64_t NackModule::Unwrap(uint16_t seq_num) const {
+  return newest_unwrapped_seq_num_ +
+         static_cast<int16_t>(seq_num - newest_seq_num_);
+}
+
 int NackModule::WaitNumberOfPackets(float probability) const {
   if (reordering_histogram_.NumValues() == 0)
     return 0;
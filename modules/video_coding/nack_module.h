@@ -13,10 +13,11 @@
 
 #include <stdint.h>
 
-#include <map>
-#include <set>
+#include <array>
+#include <deque>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "modules/include/module.h"
 #include "modules/include/module_common_types.h"
 #include "modules/video_coding/histogram.h"
@@ -51,20 +52,47 @@ class NackModule : public Module {
 
   // This class holds the sequence number of the packet that is in the nack list
   // as well as the meta data about when it should be nacked and how many times
-  // we have tried to nack this packet.
+  // we have tried to nack this packet. Sequence numbers are unwrapped.
   struct NackInfo {
     NackInfo();
-    NackInfo(uint16_t seq_num,
-             uint16_t send_at_seq_num,
-             int64_t created_at_time);
+    NackInfo(int64_t seq_num, int64_t send_at_seq_num, int64_t created_at_time);
 
-    uint16_t seq_num;
-    uint16_t send_at_seq_num;
+    int64_t seq_num;
+    int64_t send_at_seq_num;
     int64_t created_at_time;
     int64_t sent_at_time;
     int retries;
   };
-  void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
+
+  // Set of unwrapped sequence numbers, stored as a bitmap over a sliding
+  // window. Inserting a sequence number more than |kSize| ahead of the oldest
+  // one in the set drops the oldest ones.
+  class SeqNumSet {
+   public:
+    static constexpr int kSize = 1 << 14;
+
+    SeqNumSet();
+
+    void Insert(int64_t seq_num);
+    bool Contains(int64_t seq_num) const;
+    // Returns the oldest sequence number in the set.
+    absl::optional<int64_t> First() const;
+    // Removes all sequence numbers older than |seq_num|.
+    void EraseBefore(int64_t seq_num);
+    void Clear();
+
+   private:
+    static constexpr int kBitsPerWord = 64;
+
+    void ClearBits(int64_t begin, int64_t end);
+
+    std::array<uint64_t, kSize / kBitsPerWord> bits_;
+    // All sequence numbers in the set are in [begin_, end_).
+    int64_t begin_ = 0;
+    int64_t end_ = 0;
+  };
+
+  void AddPacketsToNack(int64_t seq_num_start, int64_t seq_num_end)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Removes packets from the nack list until the next keyframe. Returns true
@@ -82,6 +110,9 @@ class NackModule : public Module {
   int WaitNumberOfPackets(float probability) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Unwraps |seq_num| relative to the newest received sequence number.
+  int64_t Unwrap(uint16_t seq_num) const RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   rtc::CriticalSection crit_;
   Clock* const clock_;
   NackSender* const nack_sender_;
@@ -90,16 +121,15 @@ class NackModule : public Module {
   // TODO(philipel): Some of the variables below are consistently used on a
   // known thread (e.g. see |initialized_|). Those probably do not need
   // synchronized access.
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
-      RTC_GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> recovered_list_
-      RTC_GUARDED_BY(crit_);
+  // Ordered by sequence number, oldest first.
+  std::deque<NackInfo> nack_list_ RTC_GUARDED_BY(crit_);
+  SeqNumSet keyframe_list_ RTC_GUARDED_BY(crit_);
+  SeqNumSet recovered_list_ RTC_GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ RTC_GUARDED_BY(crit_);
   bool initialized_ RTC_GUARDED_BY(crit_);
   int64_t rtt_ms_ RTC_GUARDED_BY(crit_);
   uint16_t newest_seq_num_ RTC_GUARDED_BY(crit_);
+  int64_t newest_unwrapped_seq_num_ RTC_GUARDED_BY(crit_);
 
   // Only touched on the process thread.
   int64_t next_process_time_ms_;
@@ -12,8 +12,13 @@
 
 #include <cstdint>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <set>
 
+#include "rtc_base/logging.h"
+#include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
@@ -294,6 +299,86 @@ TEST_F(TestNackModule, SendNackWithoutDelay) {
   EXPECT_EQ(99u, sent_nacks_.size());
 }
 
+// Receives |num_packets| at 10000 packets per second, with 30% of the packets
+// and their retransmissions lost, and a 50 ms RTT. Keeps receiving
+// retransmissions for a second after the last packet, and returns the number
+// of packets that were never received.
+int ReceiveLossyStream(SimulatedClock* clock, int num_packets) {
+  const int kPacketIntervalUs = 100;
+  const int64_t kRttMs = 50;
+  const int kProcessIntervalMs = 20;
+  const double kLossRate = 0.3;
+  const int kDrainPackets = 10000;
+
+  class RetransmittingSender : public NackSender, public KeyFrameRequestSender {
+   public:
+    explicit RetransmittingSender(Clock* clock) : clock_(clock) {}
+    void SendNack(const std::vector<uint16_t>& sequence_numbers,
+                  bool buffering_allowed) override {
+      int64_t arrival_ms = clock_->TimeInMilliseconds() + kRttMs;
+      for (uint16_t seq_num : sequence_numbers)
+        retransmissions.emplace(arrival_ms, seq_num);
+    }
+    void RequestKeyFrame() override { ++keyframes_requested; }
+
+    std::multimap<int64_t, uint16_t> retransmissions;
+    int keyframes_requested = 0;
+
+   private:
+    Clock* const clock_;
+  };
+
+  RetransmittingSender sender(clock);
+  NackModule nack_module(clock, &sender, &sender);
+  nack_module.UpdateRtt(kRttMs);
+  Random random(0x1234);
+  std::set<uint16_t> missing;
+  int64_t next_process_ms = clock->TimeInMilliseconds();
+  for (int i = 0; i < num_packets + kDrainPackets; ++i) {
+    if (i < num_packets) {
+      uint16_t seq_num = i;
+      // The last packet is never lost, so that all losses are detected.
+      if (i > 0 && i < num_packets - 1 && random.Rand<double>() < kLossRate) {
+        missing.insert(seq_num);
+      } else {
+        nack_module.OnReceivedPacket(seq_num, false, false);
+      }
+    }
+
+    int64_t now_ms = clock->TimeInMilliseconds();
+    while (!sender.retransmissions.empty() &&
+           sender.retransmissions.begin()->first <= now_ms) {
+      uint16_t retransmitted = sender.retransmissions.begin()->second;
+      sender.retransmissions.erase(sender.retransmissions.begin());
+      if (random.Rand<double>() >= kLossRate) {
+        nack_module.OnReceivedPacket(retransmitted, false, false);
+        missing.erase(retransmitted);
+      }
+    }
+    if (now_ms >= next_process_ms) {
+      nack_module.Process();
+      next_process_ms += kProcessIntervalMs;
+    }
+    clock->AdvanceTimeMicroseconds(kPacketIntervalUs);
+  }
+  EXPECT_EQ(0, sender.keyframes_requested);
+  return missing.size();
+}
+
+TEST_F(TestNackModule, RecoversLossyStream) {
+  EXPECT_EQ(0, ReceiveLossyStream(clock_.get(), 10000));
+}
+
+// Run with --gtest_also_run_disabled_tests to get the timing logged.
+TEST_F(TestNackModule, DISABLED_ReceiveLossyStreamPerf) {
+  const int kNumPackets = 1000000;
+  int64_t start_us = rtc::TimeMicros();
+  ReceiveLossyStream(clock_.get(), kNumPackets);
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  RTC_LOG(LS_INFO) << (elapsed_us * 1000) / kNumPackets
+                   << " ns per packet at 30% loss.";
+}
+
 class TestNackModuleWithFieldTrial : public ::testing::Test,
                                      public NackSender,
                                      public KeyFrameRequestSender {
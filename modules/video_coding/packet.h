@@ -20,6 +20,7 @@
 #include "api/video/video_frame_type.h"
 #include "modules/rtp_rtcp/source/rtp_generic_frame_descriptor.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "rtc_base/copy_on_write_buffer.h"
 
 namespace webrtc {
 
@@ -63,6 +64,10 @@ class VCMPacket {
   uint16_t seqNum;
   const uint8_t* dataPtr;
   size_t sizeBytes;
+  // If not empty, |dataPtr| points into this buffer, which keeps the payload
+  // alive. Otherwise |dataPtr| is owned by whoever the packet is handed to
+  // and freed with delete[].
+  rtc::CopyOnWriteBuffer payload_buffer;
   bool markerBit;
   int timesNacked;
 
@@ -30,6 +30,18 @@
 
 namespace webrtc {
 namespace video_coding {
+namespace {
+
+// Frees the payload of a packet removed from the buffer, unless the payload
+// is a view into a shared receive buffer.
+void ReleasePayload(VCMPacket* packet) {
+  if (packet->payload_buffer.size() == 0)
+    delete[] packet->dataPtr;
+  packet->dataPtr = nullptr;
+  packet->payload_buffer = rtc::CopyOnWriteBuffer();
+}
+
+}  // namespace
 
 PacketBuffer::PacketBuffer(Clock* clock,
                            size_t start_buffer_size,
@@ -41,8 +53,7 @@ PacketBuffer::PacketBuffer(Clock* clock,
       first_seq_num_(0),
       first_packet_received_(false),
       is_cleared_to_first_seq_num_(false),
-      data_buffer_(start_buffer_size),
-      sequence_buffer_(start_buffer_size),
+      buffer_(start_buffer_size),
       assembled_frame_callback_(assembled_frame_callback),
       unique_frames_seen_(0),
       sps_pps_idr_is_h264_keyframe_(
@@ -74,47 +85,51 @@ bool PacketBuffer::InsertPacket(VCMPacket* packet) {
       // If we have explicitly cleared past this packet then it's old,
       // don't insert it, just silently ignore it.
       if (is_cleared_to_first_seq_num_) {
-        delete[] packet->dataPtr;
-        packet->dataPtr = nullptr;
+        ReleasePayload(packet);
         return true;
       }
 
       first_seq_num_ = seq_num;
     }
 
-    if (sequence_buffer_[index].used) {
+    if (buffer_[index]) {
       // Duplicate packet, just delete the payload.
-      if (data_buffer_[index].seqNum == packet->seqNum) {
-        delete[] packet->dataPtr;
-        packet->dataPtr = nullptr;
+      if (buffer_[index]->packet.seqNum == packet->seqNum) {
+        ReleasePayload(packet);
         return true;
       }
 
       // The packet buffer is full, try to expand the buffer.
-      while (ExpandBufferSize() && sequence_buffer_[seq_num % size_].used) {
+      while (ExpandBufferSize() && buffer_[seq_num % size_]) {
       }
       index = seq_num % size_;
 
       // Packet buffer is still full since we were unable to expand the buffer.
-      if (sequence_buffer_[index].used) {
+      if (buffer_[index]) {
         // Clear the buffer, delete payload, and return false to signal that a
         // new keyframe is needed.
         RTC_LOG(LS_WARNING) << "Clear PacketBuffer and request key frame.";
         Clear();
-        delete[] packet->dataPtr;
-        packet->dataPtr = nullptr;
+        ReleasePayload(packet);
         return false;
       }
     }
 
-    sequence_buffer_[index].frame_begin = packet->is_first_packet_in_frame();
-    sequence_buffer_[index].frame_end = packet->is_last_packet_in_frame();
-    sequence_buffer_[index].seq_num = packet->seqNum;
-    sequence_buffer_[index].continuous = false;
-    sequence_buffer_[index].frame_created = false;
-    sequence_buffer_[index].used = true;
-    data_buffer_[index] = *packet;
+    std::unique_ptr<StoredPacket> entry;
+    if (free_entries_.empty()) {
+      entry = std::make_unique<StoredPacket>();
+    } else {
+      entry = std::move(free_entries_.back());
+      free_entries_.pop_back();
+    }
+    entry->frame_begin = packet->is_first_packet_in_frame();
+    entry->frame_end = packet->is_last_packet_in_frame();
+    entry->continuous = false;
+    entry->frame_created = false;
+    entry->packet = *packet;
+    buffer_[index] = std::move(entry);
     packet->dataPtr = nullptr;
+    packet->payload_buffer = rtc::CopyOnWriteBuffer();
 
     UpdateMissingPackets(packet->seqNum);
 
@@ -151,11 +166,9 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   size_t iterations = std::min(diff, size_);
   for (size_t i = 0; i < iterations; ++i) {
     size_t index = first_seq_num_ % size_;
-    RTC_DCHECK_EQ(data_buffer_[index].seqNum, sequence_buffer_[index].seq_num);
-    if (AheadOf<uint16_t>(seq_num, sequence_buffer_[index].seq_num)) {
-      delete[] data_buffer_[index].dataPtr;
-      data_buffer_[index].dataPtr = nullptr;
-      sequence_buffer_[index].used = false;
+    if (buffer_[index] &&
+        AheadOf<uint16_t>(seq_num, buffer_[index]->packet.seqNum)) {
+      ReleaseEntry(index);
     }
     ++first_seq_num_;
   }
@@ -179,11 +192,9 @@ void PacketBuffer::ClearInterval(uint16_t start_seq_num,
   uint16_t seq_num = start_seq_num;
   for (size_t i = 0; i < iterations; ++i) {
     size_t index = seq_num % size_;
-    RTC_DCHECK_EQ(sequence_buffer_[index].seq_num, seq_num);
-    RTC_DCHECK_EQ(sequence_buffer_[index].seq_num, data_buffer_[index].seqNum);
-    delete[] data_buffer_[index].dataPtr;
-    data_buffer_[index].dataPtr = nullptr;
-    sequence_buffer_[index].used = false;
+    RTC_DCHECK(buffer_[index]);
+    RTC_DCHECK_EQ(buffer_[index]->packet.seqNum, seq_num);
+    ReleaseEntry(index);
 
     ++seq_num;
   }
@@ -192,9 +203,8 @@ void PacketBuffer::ClearInterval(uint16_t start_seq_num,
 void PacketBuffer::Clear() {
   rtc::CritScope lock(&crit_);
   for (size_t i = 0; i < size_; ++i) {
-    delete[] data_buffer_[i].dataPtr;
-    data_buffer_[i].dataPtr = nullptr;
-    sequence_buffer_[i].used = false;
+    if (buffer_[i])
+      ReleaseEntry(i);
   }
 
   first_packet_received_ = false;
@@ -239,46 +249,36 @@ bool PacketBuffer::ExpandBufferSize() {
     return false;
   }
 
+  // Only the pointers to the stored packets move, the packets themselves stay
+  // where they are.
   size_t new_size = std::min(max_size_, 2 * size_);
-  std::vector<VCMPacket> new_data_buffer(new_size);
-  std::vector<ContinuityInfo> new_sequence_buffer(new_size);
-  for (size_t i = 0; i < size_; ++i) {
-    if (sequence_buffer_[i].used) {
-      size_t index = sequence_buffer_[i].seq_num % new_size;
-      new_sequence_buffer[index] = sequence_buffer_[i];
-      new_data_buffer[index] = data_buffer_[i];
-    }
+  std::vector<std::unique_ptr<StoredPacket>> new_buffer(new_size);
+  for (std::unique_ptr<StoredPacket>& entry : buffer_) {
+    if (entry)
+      new_buffer[entry->packet.seqNum % new_size] = std::move(entry);
   }
   size_ = new_size;
-  sequence_buffer_ = std::move(new_sequence_buffer);
-  data_buffer_ = std::move(new_data_buffer);
+  buffer_ = std::move(new_buffer);
   RTC_LOG(LS_INFO) << "PacketBuffer size expanded to " << new_size;
   return true;
 }
 
 bool PacketBuffer::PotentialNewFrame(uint16_t seq_num) const {
-  size_t index = seq_num % size_;
-  int prev_index = index > 0 ? index - 1 : size_ - 1;
-
-  if (!sequence_buffer_[index].used)
+  const StoredPacket* entry = GetEntry(seq_num);
+  if (!entry)
     return false;
-  if (sequence_buffer_[index].seq_num != seq_num)
+  if (entry->frame_created)
     return false;
-  if (sequence_buffer_[index].frame_created)
-    return false;
-  if (sequence_buffer_[index].frame_begin)
+  if (entry->frame_begin)
     return true;
-  if (!sequence_buffer_[prev_index].used)
+  const StoredPacket* prev = GetEntry(seq_num - 1);
+  if (!prev)
     return false;
-  if (sequence_buffer_[prev_index].frame_created)
+  if (prev->frame_created)
     return false;
-  if (sequence_buffer_[prev_index].seq_num !=
-      static_cast<uint16_t>(sequence_buffer_[index].seq_num - 1)) {
+  if (prev->packet.timestamp != entry->packet.timestamp)
     return false;
-  }
-  if (data_buffer_[prev_index].timestamp != data_buffer_[index].timestamp)
-    return false;
-  if (sequence_buffer_[prev_index].continuous)
+  if (prev->continuous)
     return true;
 
   return false;
@@ -288,57 +288,79 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
     uint16_t seq_num) {
   std::vector<std::unique_ptr<RtpFrameObject>> found_frames;
   for (size_t i = 0; i < size_ && PotentialNewFrame(seq_num); ++i) {
-    size_t index = seq_num % size_;
-    sequence_buffer_[index].continuous = true;
+    StoredPacket* entry = GetEntry(seq_num);
+    entry->continuous = true;
+    bool is_h264 = entry->packet.codec() == kVideoCodecH264;
+
+    // A continuous packet either starts a frame or continues the frame of the
+    // previous packet. H264 doesn't have a reliable frame_begin bit (see
+    // below), so there the timestamp alone decides.
+    const StoredPacket* prev = GetEntry(seq_num - 1);
+    if ((!entry->frame_begin || is_h264) && prev && prev->continuous &&
+        !prev->frame_created &&
+        prev->packet.timestamp == entry->packet.timestamp) {
+      entry->frame_first_seq_num = prev->frame_first_seq_num;
+    } else {
+      entry->frame_first_seq_num = seq_num;
+    }
+
+    // If all packets of the frame is continuous, create an RtpFrameObject
+    // from the packets starting at |frame_first_seq_num|.
+    if (entry->frame_end) {
+      uint16_t start_seq_num = entry->frame_first_seq_num;
+      int64_t frame_timestamp = entry->packet.timestamp;
+
+      // In the case of H264 we don't have a frame_begin bit (yes,
+      // |frame_begin| might be set to true but that is a lie). So instead
+      // we extend the frame backwards as long as we have a previous packet and
+      // the timestamp of that packet is the same as this one. This may cause
+      // the PacketBuffer to hand out incomplete frames.
+      // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=7106
+      if (is_h264) {
+        while (ForwardDiff<uint16_t>(start_seq_num, seq_num) + 1 < size_) {
+          const StoredPacket* earlier = GetEntry(start_seq_num - 1);
+          if (!earlier || earlier->packet.timestamp != frame_timestamp)
+            break;
+          --start_seq_num;
+        }
+      }
 
-    // If all packets of the frame is continuous, find the first packet of the
-    // frame and create an RtpFrameObject.
-    if (sequence_buffer_[index].frame_end) {
       size_t frame_size = 0;
       int max_nack_count = -1;
-      uint16_t start_seq_num = seq_num;
-      int64_t min_recv_time = data_buffer_[index].packet_info.receive_time_ms();
-      int64_t max_recv_time = data_buffer_[index].packet_info.receive_time_ms();
+      int64_t min_recv_time = entry->packet.packet_info.receive_time_ms();
+      int64_t max_recv_time = entry->packet.packet_info.receive_time_ms();
       RtpPacketInfos::vector_type packet_infos;
-
-      // Find the start index by searching backward until the packet with
-      // the |frame_begin| flag is set.
-      int start_index = index;
-      size_t tested_packets = 0;
-      int64_t frame_timestamp = data_buffer_[start_index].timestamp;
+      packet_infos.reserve(ForwardDiff<uint16_t>(start_seq_num, seq_num) + 1);
 
       // Identify H.264 keyframes by means of SPS, PPS, and IDR.
-      bool is_h264 = data_buffer_[start_index].codec() == kVideoCodecH264;
       bool has_h264_sps = false;
       bool has_h264_pps = false;
       bool has_h264_idr = false;
       bool is_h264_keyframe = false;
 
-      while (true) {
-        ++tested_packets;
-        frame_size += data_buffer_[start_index].sizeBytes;
-        max_nack_count =
-            std::max(max_nack_count, data_buffer_[start_index].timesNacked);
-        sequence_buffer_[start_index].frame_created = true;
+      // Traverse the frame backwards, as the H.264 keyframe detection stops
+      // looking at NALUs once the packets after them make up a keyframe.
+      for (uint16_t packet_seq_num = seq_num;; --packet_seq_num) {
+        StoredPacket* frame_entry = GetEntry(packet_seq_num);
+        RTC_DCHECK(frame_entry);
+        const VCMPacket& packet = frame_entry->packet;
+        frame_size += packet.sizeBytes;
+        max_nack_count = std::max(max_nack_count, packet.timesNacked);
+        frame_entry->frame_created = true;
 
         min_recv_time =
-            std::min(min_recv_time,
-                     data_buffer_[start_index].packet_info.receive_time_ms());
+            std::min(min_recv_time, packet.packet_info.receive_time_ms());
         max_recv_time =
-            std::max(max_recv_time,
-                     data_buffer_[start_index].packet_info.receive_time_ms());
+            std::max(max_recv_time, packet.packet_info.receive_time_ms());
 
         // Should use |push_front()| since the loop traverses backwards. But
         // it's too inefficient to do so on a vector so we'll instead fix the
         // order afterwards.
-        packet_infos.push_back(data_buffer_[start_index].packet_info);
-
-        if (!is_h264 && sequence_buffer_[start_index].frame_begin)
-          break;
+        packet_infos.push_back(packet.packet_info);
 
         if (is_h264 && !is_h264_keyframe) {
           const auto* h264_header = absl::get_if<RTPVideoHeaderH264>(
-              &data_buffer_[start_index].video_header.video_type_header);
+              &packet.video_header.video_type_header);
           if (!h264_header || h264_header->nalus_length >= kMaxNalusPerPacket)
             return found_frames;
 
@@ -358,24 +380,8 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
           }
         }
 
-        if (tested_packets == size_)
+        if (packet_seq_num == start_seq_num)
           break;
-
-        start_index = start_index > 0 ? start_index - 1 : size_ - 1;
-
-        // In the case of H264 we don't have a frame_begin bit (yes,
-        // |frame_begin| might be set to true but that is a lie). So instead
-        // we traverese backwards as long as we have a previous packet and
-        // the timestamp of that packet is the same as this one. This may cause
-        // the PacketBuffer to hand out incomplete frames.
-        // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=7106
-        if (is_h264 &&
-            (!sequence_buffer_[start_index].used ||
-             data_buffer_[start_index].timestamp != frame_timestamp)) {
-          break;
-        }
-
-        --start_seq_num;
       }
 
       // Fix the order since the packet-finding loop traverses backwards.
@@ -396,27 +402,24 @@ std::vector<std::unique_ptr<RtpFrameObject>> PacketBuffer::FindFrames(
         // Now that we have decided whether to treat this frame as a key frame
         // or delta frame in the frame buffer, we update the field that
         // determines if the RtpFrameObject is a key frame or delta frame.
-        const size_t first_packet_index = start_seq_num % size_;
-        RTC_CHECK_LT(first_packet_index, size_);
+        RTPVideoHeader& first_video_header =
+            GetEntry(start_seq_num)->packet.video_header;
         if (is_h264_keyframe) {
-          data_buffer_[first_packet_index].video_header.frame_type =
-              VideoFrameType::kVideoFrameKey;
+          first_video_header.frame_type = VideoFrameType::kVideoFrameKey;
         } else {
-          data_buffer_[first_packet_index].video_header.frame_type =
-              VideoFrameType::kVideoFrameDelta;
+          first_video_header.frame_type = VideoFrameType::kVideoFrameDelta;
         }
 
         // With IPPP, if this is not a keyframe, make sure there are no gaps
         // in the packet sequence numbers up until this point.
-        const uint8_t h264tid =
-            data_buffer_[start_index].video_header.frame_marking.temporal_id;
+        const uint8_t h264tid = first_video_header.frame_marking.temporal_id;
         if (h264tid == kNoTemporalIdx && !is_h264_keyframe &&
             missing_packets_.upper_bound(start_seq_num) !=
                 missing_packets_.begin()) {
-          uint16_t stop_index = (index + 1) % size_;
-          while (start_index != stop_index) {
-            sequence_buffer_[start_index].frame_created = false;
-            start_index = (start_index + 1) % size_;
+          for (uint16_t packet_seq_num = start_seq_num;
+               packet_seq_num != static_cast<uint16_t>(seq_num + 1);
+               ++packet_seq_num) {
+            GetEntry(packet_seq_num)->frame_created = false;
           }
 
           return found_frames;
@@ -453,33 +456,39 @@ rtc::scoped_refptr<EncodedImageBuffer> PacketBuffer::GetEncodedImageBuffer(
     size_t frame_size,
     uint16_t first_seq_num,
     uint16_t last_seq_num) {
-  size_t index = first_seq_num % size_;
-  size_t end = (last_seq_num + 1) % size_;
-
   auto buffer = EncodedImageBuffer::Create(frame_size);
   size_t offset = 0;
 
+  uint16_t seq_num = first_seq_num;
   do {
-    RTC_DCHECK(sequence_buffer_[index].used);
+    const StoredPacket* entry = GetEntry(seq_num);
+    RTC_DCHECK(entry);
 
-    size_t length = data_buffer_[index].sizeBytes;
+    size_t length = entry->packet.sizeBytes;
     RTC_CHECK_LE(offset + length, buffer->size());
-    memcpy(buffer->data() + offset, data_buffer_[index].dataPtr, length);
+    memcpy(buffer->data() + offset, entry->packet.dataPtr, length);
     offset += length;
-
-    index = (index + 1) % size_;
-  } while (index != end);
+  } while (seq_num++ != last_seq_num);
 
   return buffer;
 }
 
 VCMPacket* PacketBuffer::GetPacket(uint16_t seq_num) {
-  size_t index = seq_num % size_;
-  if (!sequence_buffer_[index].used ||
-      seq_num != sequence_buffer_[index].seq_num) {
+  StoredPacket* entry = GetEntry(seq_num);
+  return entry ? &entry->packet : nullptr;
+}
+
+PacketBuffer::StoredPacket* PacketBuffer::GetEntry(uint16_t seq_num) const {
+  StoredPacket* entry = buffer_[seq_num % size_].get();
+  if (!entry || entry->packet.seqNum != seq_num)
     return nullptr;
-  }
-  return &data_buffer_[index];
+  return entry;
+}
+
+void PacketBuffer::ReleaseEntry(size_t index) {
+  RTC_DCHECK(buffer_[index]);
+  ReleasePayload(&buffer_[index]->packet);
+  free_entries_.push_back(std::move(buffer_[index]));
 }
 
 void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
@@ -48,8 +48,8 @@ class PacketBuffer {
 
   // Returns true unless the packet buffer is cleared, which means that a key
   // frame request should be sent. The PacketBuffer will always take ownership
-  // of the |packet.dataPtr| when this function is called. Made virtual for
-  // testing.
+  // of the |packet.dataPtr| when this function is called, or of a reference to
+  // |packet.payload_buffer| if that is set. Made virtual for testing.
   virtual bool InsertPacket(VCMPacket* packet);
   void ClearTo(uint16_t seq_num);
   void Clear();
@@ -64,12 +64,12 @@ class PacketBuffer {
 
  private:
   friend RtpFrameObject;
-  // Since we want the packet buffer to be as packet type agnostic
-  // as possible we extract only the information needed in order
-  // to determine whether a sequence of packets is continuous or not.
-  struct ContinuityInfo {
-    // The sequence number of the packet.
-    uint16_t seq_num = 0;
+  // A packet in the buffer, along with the information needed to determine
+  // the continuity between packets. Entries are heap allocated so that
+  // expanding the buffer only moves pointers, and are recycled through
+  // |free_entries_| to avoid an allocation per packet.
+  struct StoredPacket {
+    VCMPacket packet;
 
     // If this is the first packet of the frame.
     bool frame_begin = false;
@@ -77,14 +77,17 @@ class PacketBuffer {
     // If this is the last packet of the frame.
     bool frame_end = false;
 
-    // If this slot is currently used.
-    bool used = false;
-
     // If all its previous packets have been inserted into the packet buffer.
     bool continuous = false;
 
     // If this packet has been used to create a frame already.
     bool frame_created = false;
+
+    // Sequence number of the first packet of the frame this packet belongs
+    // to, recorded when the packet becomes continuous. This makes the packets
+    // of a frame known as soon as its last packet is continuous, without
+    // searching for the start of the frame.
+    uint16_t frame_first_seq_num = 0;
   };
 
   Clock* const clock_;
@@ -92,6 +95,14 @@ class PacketBuffer {
   // Tries to expand the buffer.
   bool ExpandBufferSize() RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns the entry holding the packet with sequence number |seq_num|, or
+  // null if there is none.
+  StoredPacket* GetEntry(uint16_t seq_num) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Releases the payload of the entry at |index| and makes the slot free.
+  void ReleaseEntry(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Test if all previous packets has arrived for the given sequence number.
   bool PotentialNewFrame(uint16_t seq_num) const
       RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -138,12 +149,13 @@ class PacketBuffer {
   // If the buffer is cleared to |first_seq_num_|.
   bool is_cleared_to_first_seq_num_ RTC_GUARDED_BY(crit_);
 
-  // Buffer that holds the inserted packets.
-  std::vector<VCMPacket> data_buffer_ RTC_GUARDED_BY(crit_);
+  // Buffer that holds the inserted packets, indexed by sequence number modulo
+  // |size_|. Free slots are null.
+  std::vector<std::unique_ptr<StoredPacket>> buffer_ RTC_GUARDED_BY(crit_);
 
-  // Buffer that holds the information about which slot that is currently in use
-  // and information needed to determine the continuity between packets.
-  std::vector<ContinuityInfo> sequence_buffer_ RTC_GUARDED_BY(crit_);
+  // Entries no longer in |buffer_|, kept for reuse by later packets.
+  std::vector<std::unique_ptr<StoredPacket>> free_entries_
+      RTC_GUARDED_BY(crit_);
 
   // Called when all packets in a frame are received, allowing the frame
   // to be assembled.
@@ -297,6 +297,14 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp8(
   // Find if there has been a gap in fully received frames and save the picture
   // id of those frames in |not_yet_received_frames_|.
   if (AheadOf<uint16_t, kPicIdLength>(frame->id.picture_id, last_picture_id_)) {
+    // Frames older than |kMaxNotYetReceivedFrames| are cleaned out below, so
+    // don't add them in the first place.
+    if (ForwardDiff<uint16_t, kPicIdLength>(last_picture_id_,
+                                            frame->id.picture_id) >
+        kMaxNotYetReceivedFrames) {
+      last_picture_id_ = Subtract<kPicIdLength>(frame->id.picture_id,
+                                                kMaxNotYetReceivedFrames + 1);
+    }
     do {
       last_picture_id_ = Add<kPicIdLength>(last_picture_id_, 1);
       not_yet_received_frames_.insert(last_picture_id_);
@@ -550,6 +558,14 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameVp9(
   auto up_switch_erase_to = up_switch_.lower_bound(old_picture_id);
   up_switch_.erase(up_switch_.begin(), up_switch_erase_to);
 
+  // Clean out info about missing frames that are too old to be referenced.
+  uint16_t old_missing_picture_id =
+      Subtract<kPicIdLength>(frame->id.picture_id, kMaxMissingFrameAge);
+  for (auto& missing_frames : missing_frames_for_layer_) {
+    missing_frames.erase(missing_frames.begin(),
+                         missing_frames.lower_bound(old_missing_picture_id));
+  }
+
   size_t diff = ForwardDiff<uint16_t, kPicIdLength>(info->gof->pid_start,
                                                     frame->id.picture_id);
   size_t gof_idx = diff % info->gof->num_frames_in_gof;
@@ -621,6 +637,16 @@ void RtpFrameReferenceFinder::FrameReceivedVp9(uint16_t picture_id,
                                                       last_picture_id);
     size_t gof_idx = diff % gof_size;
 
+    // Missing frames older than |kMaxMissingFrameAge| are cleaned out anyway,
+    // so skip ahead over a large gap instead of adding all of them.
+    size_t gap =
+        ForwardDiff<uint16_t, kPicIdLength>(last_picture_id, picture_id);
+    if (gap > kMaxMissingFrameAge) {
+      size_t skip = gap - kMaxMissingFrameAge;
+      gof_idx = (gof_idx + skip) % gof_size;
+      last_picture_id = Add<kPicIdLength>(last_picture_id, skip);
+    }
+
     last_picture_id = Add<kPicIdLength>(last_picture_id, 1);
     while (last_picture_id != picture_id) {
       gof_idx = (gof_idx + 1) % gof_size;
@@ -704,6 +730,13 @@ RtpFrameReferenceFinder::FrameDecision RtpFrameReferenceFinder::ManageFrameH264(
   if (frame->frame_type() == VideoFrameType::kVideoFrameDelta) {
     uint16_t last_pic_id_padded = last_seq_num_gop_.begin()->second.second;
     if (AheadOf<uint16_t>(frame->id.picture_id, last_pic_id_padded)) {
+      // Sequence numbers older than |kMaxNotYetReceivedFrames| * 2 are cleaned
+      // out below, so don't add them in the first place.
+      if (ForwardDiff<uint16_t>(last_pic_id_padded, frame->id.picture_id) >
+          kMaxNotYetReceivedFrames * 2) {
+        last_pic_id_padded =
+            frame->id.picture_id - kMaxNotYetReceivedFrames * 2 - 1;
+      }
       do {
         last_pic_id_padded = last_pic_id_padded + 1;
         not_yet_received_seq_num_.insert(last_pic_id_padded);
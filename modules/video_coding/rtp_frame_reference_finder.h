@@ -69,6 +69,9 @@ class RtpFrameReferenceFinder {
   static const int kMaxNotYetReceivedFrames = 100;
   static const int kMaxGofSaved = 50;
   static const int kMaxPaddingAge = 100;
+  // VP9 references reach at most kMaxVp9FramesInGof pictures back. The margin
+  // is for stashed frames that are retried later.
+  static const size_t kMaxMissingFrameAge = 4 * kMaxVp9FramesInGof;
 
   enum FrameDecision { kStash, kHandOff, kDrop };
 
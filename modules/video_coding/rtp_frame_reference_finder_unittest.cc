@@ -18,8 +18,10 @@
 #include "modules/video_coding/frame_object.h"
 #include "modules/video_coding/packet_buffer.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
 #include "rtc_base/ref_count.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/gtest.h"
 
@@ -1794,5 +1796,58 @@ TEST_F(TestRtpFrameReferenceFinder, H264Tl0PicIdxWrap) {
   }
 }
 
+
+TEST_F(TestRtpFrameReferenceFinder, Vp9GofWrapWithOldMissingFrame) {
+  const uint8_t kTemporalIdx[] = {0, 2, 1, 2};  // 0212 pattern
+  // Run until the picture id has wrapped around, so that the picture id of the
+  // missing frame is used again.
+  const int kNumFrames = (1 << 15) + 8;
+  uint16_t pid = Rand();
+  uint16_t sn = Rand();
+  GofInfoVP9 ss;
+  ss.SetGofInfoVP9(kTemporalStructureMode3);
+
+  InsertVp9Gof(sn, sn, true, pid, 0, 0, 0, false, false, &ss);
+  size_t num_frames = 1;
+  for (int i = 1; i < kNumFrames; ++i) {
+    // The first TL1 frame is lost.
+    if (i == 2)
+      continue;
+    InsertVp9Gof(sn + i, sn + i, false, pid + i, 0, kTemporalIdx[i % 4],
+                 (i / 4) % 256, false);
+    ++num_frames;
+    reference_finder_->ClearTo(sn + i);
+  }
+
+  // Only the TL2 frame that references the lost frame is missing.
+  EXPECT_EQ(num_frames - 1, frames_from_callback_.size());
+}
+
+TEST_F(TestRtpFrameReferenceFinder, DISABLED_Vp9GofHeavyLossPerf) {
+  const uint8_t kTemporalIdx[] = {0, 2, 1, 2};  // 0212 pattern
+  const int kNumFrames = 200000;
+  const int kKeyFrameInterval = 300;
+  const int kBurstInterval = 30 * kKeyFrameInterval;
+  uint16_t pid = Rand();
+  uint16_t sn = Rand();
+  GofInfoVP9 ss;
+  ss.SetGofInfoVP9(kTemporalStructureMode3);
+
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumFrames; ++i) {
+    bool keyframe = i % kKeyFrameInterval == 0;
+    // Lose a third of the frames, and bursts of many seconds of frames, but
+    // never a keyframe.
+    if (!keyframe &&
+        (rand_.Rand(0, 2) == 0 || i % kBurstInterval > kKeyFrameInterval))
+      continue;
+    InsertVp9Gof(sn + i, sn + i, keyframe, pid + i, 0, kTemporalIdx[i % 4],
+                 (i / 4) % 256, false, true, keyframe ? &ss : nullptr);
+    frames_from_callback_.clear();
+  }
+  RTC_LOG(LS_INFO) << (rtc::TimeMicros() - start_us) * 1000 / kNumFrames
+                   << " ns per frame.";
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
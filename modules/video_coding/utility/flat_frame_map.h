@@ -0,0 +1,381 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_UTILITY_FLAT_FRAME_MAP_H_
+#define MODULES_VIDEO_CODING_UTILITY_FLAT_FRAME_MAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/video/encoded_frame.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace video_coding {
+
+// Ordered map from VideoLayerFrameId to T, stored in a ring of slots indexed
+// by picture id and spatial layer. Finding, inserting and erasing frames is
+// an index computation instead of a tree walk, and iterating visits frames in
+// decode order, which is the order of the keys.
+//
+// The map can only hold frames whose picture ids are less than
+// |kMaxPictureSpan| apart, and whose spatial layers are less than
+// |kMaxSpatialLayers|; use Fits() before inserting. Iterating skips over the
+// slots of missing frames, so it is only efficient when the picture ids in
+// the map are mostly consecutive.
+//
+// Unlike std::map, inserting may move the stored values, so pointers and
+// references to values are invalidated by inserts. Iterators stay valid until
+// the frame they point at is erased.
+template <typename T>
+class FlatFrameMap {
+ public:
+  using key_type = VideoLayerFrameId;
+  using mapped_type = T;
+  using value_type = std::pair<const VideoLayerFrameId, T>;
+
+  static constexpr int64_t kMaxPictureSpan = 1 << 12;
+  static constexpr int kMaxSpatialLayers = 8;
+
+  class iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = FlatFrameMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    iterator() = default;
+
+    reference operator*() const { return *map_->slots_[map_->Index(key_)]; }
+    pointer operator->() const { return &**this; }
+
+    iterator& operator++() {
+      key_ = map_->NextKey(key_);
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator it = *this;
+      ++*this;
+      return it;
+    }
+    iterator& operator--() {
+      key_ = key_ == EndKey() ? map_->last_key_ : map_->PrevKey(key_);
+      return *this;
+    }
+    iterator operator--(int) {
+      iterator it = *this;
+      --*this;
+      return it;
+    }
+
+    bool operator==(const iterator& other) const { return key_ == other.key_; }
+    bool operator!=(const iterator& other) const { return key_ != other.key_; }
+
+   private:
+    friend class FlatFrameMap;
+    iterator(FlatFrameMap* map, const VideoLayerFrameId& key)
+        : map_(map), key_(key) {}
+
+    FlatFrameMap* map_ = nullptr;
+    VideoLayerFrameId key_;
+  };
+
+  FlatFrameMap() = default;
+  FlatFrameMap(const FlatFrameMap&) = delete;
+  FlatFrameMap& operator=(const FlatFrameMap&) = delete;
+
+  iterator begin() { return iterator(this, empty() ? EndKey() : first_key_); }
+  iterator end() { return iterator(this, EndKey()); }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  // Returns true if a frame with |key| can be inserted without making the map
+  // span more than |kMaxPictureSpan| picture ids.
+  bool Fits(const key_type& key) const {
+    if (key.spatial_layer >= kMaxSpatialLayers)
+      return false;
+    if (empty())
+      return true;
+    int64_t low = std::min(first_key_.picture_id, key.picture_id);
+    int64_t high = std::max(last_key_.picture_id, key.picture_id);
+    return high - low < kMaxPictureSpan;
+  }
+
+  iterator find(const key_type& key) {
+    if (!Contains(key))
+      return end();
+    return iterator(this, key);
+  }
+
+  // Inserts |value| for |key| unless there already is a value stored for it,
+  // like std::map::emplace(). |key| must fit into the map.
+  std::pair<iterator, bool> emplace(const key_type& key, T value) {
+    if (Contains(key))
+      return {iterator(this, key), false};
+    RTC_CHECK(Fits(key));
+    Reserve(key);
+    slots_[Index(key)].emplace(key, std::move(value));
+    if (empty() || key < first_key_)
+      first_key_ = key;
+    if (empty() || last_key_ < key)
+      last_key_ = key;
+    ++size_;
+    return {iterator(this, key), true};
+  }
+
+  T& operator[](const key_type& key) { return emplace(key, T()).first->second; }
+
+  // Erases the frames in [first, last).
+  void erase(iterator first, iterator last) {
+    const VideoLayerFrameId first_erased = first.key_;
+    while (first != last) {
+      VideoLayerFrameId key = first.key_;
+      ++first;
+      slots_[Index(key)].reset();
+      --size_;
+    }
+    if (empty())
+      return;
+    if (first_erased == first_key_)
+      first_key_ = last.key_;
+    if (last.key_ == EndKey())
+      last_key_ = PrevKey(first_erased);
+  }
+
+  void clear() {
+    for (absl::optional<value_type>& slot : slots_)
+      slot.reset();
+    size_ = 0;
+  }
+
+ private:
+  static VideoLayerFrameId EndKey() {
+    return VideoLayerFrameId(std::numeric_limits<int64_t>::max(), 0);
+  }
+
+  size_t Index(const VideoLayerFrameId& key) const {
+    return (key.picture_id & (num_pictures_ - 1)) * num_layers_ +
+           key.spatial_layer;
+  }
+
+  bool Contains(const VideoLayerFrameId& key) const {
+    if (empty() || key < first_key_ || last_key_ < key ||
+        key.spatial_layer >= num_layers_) {
+      return false;
+    }
+    return slots_[Index(key)].has_value();
+  }
+
+  // Returns the key of the first frame after |key|, or EndKey().
+  VideoLayerFrameId NextKey(VideoLayerFrameId key) const {
+    while (key < last_key_) {
+      if (++key.spatial_layer == num_layers_) {
+        key.spatial_layer = 0;
+        ++key.picture_id;
+      }
+      if (slots_[Index(key)])
+        return key;
+    }
+    return EndKey();
+  }
+
+  // Returns the key of the last frame before |key|, which must exist.
+  VideoLayerFrameId PrevKey(VideoLayerFrameId key) const {
+    do {
+      if (key.spatial_layer == 0) {
+        key.spatial_layer = num_layers_;
+        --key.picture_id;
+      }
+      --key.spatial_layer;
+      RTC_DCHECK(!(key < first_key_));
+    } while (!slots_[Index(key)]);
+    return key;
+  }
+
+  // Grows the ring, if needed, so that |key| gets a slot of its own.
+  void Reserve(const VideoLayerFrameId& key) {
+    int64_t low = empty() ? key.picture_id
+                          : std::min(first_key_.picture_id, key.picture_id);
+    int64_t high = empty() ? key.picture_id
+                           : std::max(last_key_.picture_id, key.picture_id);
+    int64_t num_pictures = num_pictures_;
+    while (high - low >= num_pictures)
+      num_pictures *= 2;
+    int num_layers = num_layers_;
+    while (key.spatial_layer >= num_layers)
+      num_layers *= 2;
+    if (num_pictures == num_pictures_ && num_layers == num_layers_ &&
+        !slots_.empty()) {
+      return;
+    }
+
+    std::vector<absl::optional<value_type>> old_slots(num_pictures *
+                                                      num_layers);
+    old_slots.swap(slots_);
+    num_pictures_ = num_pictures;
+    num_layers_ = num_layers;
+    for (absl::optional<value_type>& slot : old_slots) {
+      if (slot)
+        slots_[Index(slot->first)].emplace(std::move(*slot));
+    }
+  }
+
+  // Both powers of two.
+  int64_t num_pictures_ = 64;
+  int num_layers_ = 1;
+  std::vector<absl::optional<value_type>> slots_;
+  size_t size_ = 0;
+  VideoLayerFrameId first_key_;
+  VideoLayerFrameId last_key_;
+};
+
+// Ordered map from VideoLayerFrameId to T, stored either in a std::map or in
+// a FlatFrameMap, as chosen at construction. Offers the subset of the
+// std::map interface that the FrameBuffer uses.
+template <typename T>
+class LayerFrameMap {
+ public:
+  using key_type = VideoLayerFrameId;
+  using mapped_type = T;
+  using value_type = std::pair<const VideoLayerFrameId, T>;
+  using TreeMap = std::map<VideoLayerFrameId, T>;
+  using FlatMap = FlatFrameMap<T>;
+
+  class iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = LayerFrameMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = value_type*;
+    using reference = value_type&;
+
+    iterator() = default;
+
+    reference operator*() const { return flat_ ? *flat_it_ : *tree_it_; }
+    pointer operator->() const { return &**this; }
+
+    iterator& operator++() {
+      if (flat_) {
+        ++flat_it_;
+      } else {
+        ++tree_it_;
+      }
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator it = *this;
+      ++*this;
+      return it;
+    }
+    iterator& operator--() {
+      if (flat_) {
+        --flat_it_;
+      } else {
+        --tree_it_;
+      }
+      return *this;
+    }
+    iterator operator--(int) {
+      iterator it = *this;
+      --*this;
+      return it;
+    }
+
+    bool operator==(const iterator& other) const {
+      return flat_ ? flat_it_ == other.flat_it_ : tree_it_ == other.tree_it_;
+    }
+    bool operator!=(const iterator& other) const { return !(*this == other); }
+
+   private:
+    friend class LayerFrameMap;
+    explicit iterator(typename TreeMap::iterator it)
+        : flat_(false), tree_it_(it) {}
+    explicit iterator(typename FlatMap::iterator it)
+        : flat_(true), flat_it_(it) {}
+
+    bool flat_ = false;
+    typename TreeMap::iterator tree_it_;
+    typename FlatMap::iterator flat_it_;
+  };
+
+  explicit LayerFrameMap(bool use_flat_map) : use_flat_map_(use_flat_map) {}
+  LayerFrameMap(const LayerFrameMap&) = delete;
+  LayerFrameMap& operator=(const LayerFrameMap&) = delete;
+
+  iterator begin() {
+    return use_flat_map_ ? iterator(flat_.begin()) : iterator(tree_.begin());
+  }
+  iterator end() {
+    return use_flat_map_ ? iterator(flat_.end()) : iterator(tree_.end());
+  }
+
+  size_t size() const { return use_flat_map_ ? flat_.size() : tree_.size(); }
+  bool empty() const { return use_flat_map_ ? flat_.empty() : tree_.empty(); }
+
+  // Returns true if a frame with |key| can be inserted. Always true unless the
+  // flat map is used.
+  bool Fits(const key_type& key) const {
+    return !use_flat_map_ || flat_.Fits(key);
+  }
+
+  iterator find(const key_type& key) {
+    return use_flat_map_ ? iterator(flat_.find(key))
+                         : iterator(tree_.find(key));
+  }
+
+  std::pair<iterator, bool> emplace(const key_type& key, T value) {
+    if (use_flat_map_) {
+      auto result = flat_.emplace(key, std::move(value));
+      return {iterator(result.first), result.second};
+    }
+    auto result = tree_.emplace(key, std::move(value));
+    return {iterator(result.first), result.second};
+  }
+
+  T& operator[](const key_type& key) {
+    return use_flat_map_ ? flat_[key] : tree_[key];
+  }
+
+  void erase(iterator first, iterator last) {
+    if (use_flat_map_) {
+      flat_.erase(first.flat_it_, last.flat_it_);
+    } else {
+      tree_.erase(first.tree_it_, last.tree_it_);
+    }
+  }
+
+  void clear() {
+    if (use_flat_map_) {
+      flat_.clear();
+    } else {
+      tree_.clear();
+    }
+  }
+
+ private:
+  const bool use_flat_map_;
+  TreeMap tree_;
+  FlatMap flat_;
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_UTILITY_FLAT_FRAME_MAP_H_
@@ -0,0 +1,156 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/utility/flat_frame_map.h"
+
+#include <iterator>
+#include <map>
+
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+using Map = FlatFrameMap<int>;
+
+TEST(FlatFrameMapTest, EmptyMap) {
+  Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(0u, map.size());
+  EXPECT_TRUE(map.begin() == map.end());
+  EXPECT_TRUE(map.find(VideoLayerFrameId(1, 0)) == map.end());
+}
+
+TEST(FlatFrameMapTest, IteratesInKeyOrder) {
+  Map map;
+  map.emplace(VideoLayerFrameId(10, 1), 3);
+  map.emplace(VideoLayerFrameId(12, 0), 4);
+  map.emplace(VideoLayerFrameId(10, 0), 2);
+  map.emplace(VideoLayerFrameId(7, 0), 1);
+  EXPECT_FALSE(map.emplace(VideoLayerFrameId(10, 0), 5).second);
+  ASSERT_EQ(4u, map.size());
+
+  int expected = 1;
+  for (auto it = map.begin(); it != map.end(); ++it)
+    EXPECT_EQ(expected++, it->second);
+  EXPECT_EQ(VideoLayerFrameId(12, 0), std::prev(map.end())->first);
+  EXPECT_EQ(VideoLayerFrameId(10, 1),
+            std::prev(map.find(VideoLayerFrameId(12, 0)))->first);
+}
+
+TEST(FlatFrameMapTest, IteratorsSurviveGrowth) {
+  Map map;
+  auto it = map.emplace(VideoLayerFrameId(100, 0), 1).first;
+  // Grow the ring both in picture ids and in spatial layers.
+  map.emplace(VideoLayerFrameId(100 + Map::kMaxPictureSpan - 1, 0), 2);
+  map.emplace(VideoLayerFrameId(101, Map::kMaxSpatialLayers - 1), 3);
+  EXPECT_EQ(VideoLayerFrameId(100, 0), it->first);
+  EXPECT_EQ(1, it->second);
+  EXPECT_EQ(3, (++it)->second);
+
+  EXPECT_FALSE(map.Fits(VideoLayerFrameId(99, 0)));
+  EXPECT_FALSE(map.Fits(VideoLayerFrameId(100 + Map::kMaxPictureSpan, 0)));
+  EXPECT_FALSE(map.Fits(VideoLayerFrameId(101, Map::kMaxSpatialLayers)));
+}
+
+TEST(FlatFrameMapTest, ErasePrefixAndSuffix) {
+  Map map;
+  for (int i = 0; i < 10; ++i)
+    map[VideoLayerFrameId(i, 0)] = i;
+
+  map.erase(map.begin(), map.find(VideoLayerFrameId(4, 0)));
+  EXPECT_EQ(6u, map.size());
+  EXPECT_EQ(4, map.begin()->second);
+  EXPECT_TRUE(map.find(VideoLayerFrameId(3, 0)) == map.end());
+
+  map.erase(map.find(VideoLayerFrameId(8, 0)), map.end());
+  EXPECT_EQ(4u, map.size());
+  EXPECT_EQ(7, std::prev(map.end())->second);
+
+  map.erase(map.begin(), map.end());
+  EXPECT_TRUE(map.empty());
+}
+
+// Runs a random sequence of the operations that the FrameBuffer uses, and
+// checks the result against std::map.
+TEST(FlatFrameMapTest, MatchesStdMap) {
+  Map map;
+  std::map<VideoLayerFrameId, int> reference;
+  Random random(0x5eed);
+  int64_t first_picture_id = 1000;
+  for (int i = 0; i < 20000; ++i) {
+    VideoLayerFrameId key(first_picture_id + random.Rand(0, 200),
+                          random.Rand(0, 2));
+    int operation = random.Rand(0, 3);
+    if (operation == 0) {
+      ASSERT_TRUE(map.Fits(key));
+      int value = random.Rand(0, 1000);
+      EXPECT_EQ(reference.emplace(key, value).second,
+                map.emplace(key, value).second);
+    } else if (operation == 1) {
+      auto it = reference.find(key);
+      auto flat_it = map.find(key);
+      ASSERT_EQ(it == reference.end(), flat_it == map.end());
+      if (it != reference.end())
+        EXPECT_EQ(it->second, flat_it->second);
+    } else if (operation == 2) {
+      // Erase everything before |key|, like when a frame is decoded.
+      reference.erase(reference.begin(), reference.lower_bound(key));
+      auto flat_it = map.begin();
+      while (flat_it != map.end() && flat_it->first < key)
+        ++flat_it;
+      map.erase(map.begin(), flat_it);
+      first_picture_id = key.picture_id;
+    } else {
+      // Step backwards from the end.
+      auto it = reference.end();
+      auto flat_it = map.end();
+      for (int j = 0; j < 3 && it != reference.begin(); ++j) {
+        --it;
+        --flat_it;
+        EXPECT_EQ(it->first, flat_it->first);
+      }
+    }
+    ASSERT_EQ(reference.size(), map.size());
+  }
+
+  auto flat_it = map.begin();
+  for (const auto& entry : reference) {
+    ASSERT_TRUE(flat_it != map.end());
+    EXPECT_EQ(entry.first, flat_it->first);
+    EXPECT_EQ(entry.second, flat_it->second);
+    ++flat_it;
+  }
+  EXPECT_TRUE(flat_it == map.end());
+}
+
+TEST(LayerFrameMapTest, BothBackendsBehaveTheSame) {
+  for (bool use_flat_map : {false, true}) {
+    LayerFrameMap<int> map(use_flat_map);
+    map[VideoLayerFrameId(5, 1)] = 2;
+    map.emplace(VideoLayerFrameId(5, 0), 1);
+    map.emplace(VideoLayerFrameId(6, 0), 3);
+    EXPECT_EQ(3u, map.size());
+    EXPECT_EQ(1, map.begin()->second);
+    EXPECT_EQ(3, std::prev(map.end())->second);
+
+    map.erase(map.begin(), map.find(VideoLayerFrameId(6, 0)));
+    EXPECT_EQ(1u, map.size());
+    EXPECT_EQ(3, map.begin()->second);
+    map.clear();
+    EXPECT_TRUE(map.empty());
+  }
+}
+
+}  // namespace
+}  // namespace video_coding
+}  // namespace webrtc
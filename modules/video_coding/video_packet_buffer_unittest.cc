@@ -8,15 +8,20 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <cstring>
 #include <map>
 #include <set>
 #include <utility>
+#include <vector>
 
 #include "common_video/h264/h264_common.h"
 #include "modules/video_coding/frame_object.h"
 #include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/random.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 #include "test/field_trial.h"
 #include "test/gtest.h"
@@ -299,6 +304,30 @@ TEST_F(TestPacketBuffer, ExpandBufferOverflow) {
   EXPECT_FALSE(Insert(seq_num + kMaxSize, kKeyFrame, kNotFirst, kLast));
 }
 
+TEST_F(TestPacketBuffer, ReversedFrameExpandsBuffer) {
+  const uint16_t seq_num = Rand();
+  const int kNumPackets = 3 * kStartSize;
+  static_assert(kNumPackets <= kMaxSize, "");
+
+  // Insert the packets last to first, so that the frame becomes continuous
+  // only with the last inserted packet, after the buffer has expanded twice.
+  for (int i = kNumPackets - 1; i >= 0; --i) {
+    uint8_t* data = new uint8_t[1];
+    data[0] = i;
+    EXPECT_TRUE(Insert(seq_num + i, kKeyFrame, i == 0 ? kFirst : kNotFirst,
+                       i == kNumPackets - 1 ? kLast : kNotLast, 1, data));
+    EXPECT_EQ(i == 0 ? 1UL : 0UL, frames_from_callback_.size());
+  }
+
+  CheckFrame(seq_num);
+  RtpFrameObject* frame = frames_from_callback_[seq_num].get();
+  EXPECT_EQ(static_cast<uint16_t>(seq_num + kNumPackets - 1),
+            frame->last_seq_num());
+  ASSERT_EQ(static_cast<size_t>(kNumPackets), frame->size());
+  for (int i = 0; i < kNumPackets; ++i)
+    EXPECT_EQ(i, frame->data()[i]);
+}
+
 TEST_F(TestPacketBuffer, OnePacketOneFrame) {
   const uint16_t seq_num = Rand();
   EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kLast));
@@ -464,6 +493,44 @@ TEST_F(TestPacketBuffer, GetBitstream) {
             0);
 }
 
+TEST_F(TestPacketBuffer, GetBitstreamFromSharedPayloadBuffers) {
+  // Two "received packets", each with a header that is not part of the
+  // payload. The payloads are referenced in place rather than owned.
+  const uint8_t kFirstPacket[] = {0xff, 0xff, 's', 'h', 'a'};
+  const uint8_t kSecondPacket[] = {0xff, 'r', 'e', 'd', 0x0};
+  rtc::CopyOnWriteBuffer first_buffer(kFirstPacket, sizeof(kFirstPacket));
+  rtc::CopyOnWriteBuffer second_buffer(kSecondPacket, sizeof(kSecondPacket));
+  const uint16_t seq_num = Rand();
+
+  VCMPacket packet;
+  packet.video_header.codec = kVideoCodecGeneric;
+  packet.video_header.frame_type = VideoFrameType::kVideoFrameKey;
+  packet.timestamp = 123u;
+  packet.seqNum = seq_num;
+  packet.video_header.is_first_packet_in_frame = true;
+  packet.video_header.is_last_packet_in_frame = false;
+  packet.payload_buffer = first_buffer;
+  packet.dataPtr = first_buffer.cdata() + 2;
+  packet.sizeBytes = 3;
+  EXPECT_TRUE(packet_buffer_.InsertPacket(&packet));
+  EXPECT_EQ(nullptr, packet.dataPtr);
+  EXPECT_EQ(0u, packet.payload_buffer.size());
+
+  packet.seqNum = seq_num + 1;
+  packet.video_header.is_first_packet_in_frame = false;
+  packet.video_header.is_last_packet_in_frame = true;
+  packet.payload_buffer = second_buffer;
+  packet.dataPtr = second_buffer.cdata() + 1;
+  packet.sizeBytes = 4;
+  EXPECT_TRUE(packet_buffer_.InsertPacket(&packet));
+
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  CheckFrame(seq_num);
+  EXPECT_EQ(frames_from_callback_[seq_num]->size(), 7u);
+  EXPECT_EQ(memcmp(frames_from_callback_[seq_num]->data(), "shared", 7), 0);
+  packet_buffer_.ClearTo(seq_num + 1);
+}
+
 TEST_F(TestPacketBuffer, GetBitstreamOneFrameOnePacket) {
   uint8_t bitstream_data[] = "All the bitstream data for this frame!";
   uint8_t* data = new uint8_t[sizeof(bitstream_data)];
@@ -998,5 +1065,58 @@ TEST_F(TestPacketBufferH264SpsPpsIdrIsKeyframe, SpsPpsIdrIsKeyframe) {
             frames_from_callback_[kSeqNum]->frame_type());
 }
 
+// Measures the time it takes to assemble large keyframes, like those of high
+// resolution screenshare, with the packet buffer sizes used by
+// RtpVideoStreamReceiver. Run with --gtest_also_run_disabled_tests to get the
+// timings logged.
+TEST_F(TestPacketBuffer, DISABLED_LargeKeyframeAssemblyPerf) {
+  const int kNumFrames = 200;
+  const uint16_t kPacketsPerFrame = 1000;
+  const int kPayloadSize = 1000;
+  const int kReorderWindow = 8;
+  PacketBuffer packet_buffer(clock_.get(), 512, 2048, this);
+
+  std::vector<uint16_t> order(kPacketsPerFrame);
+  int64_t total_us = 0;
+  uint16_t seq_num = Rand();
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    // Shuffle the packets within small windows, like reordering in the
+    // network would.
+    for (uint16_t i = 0; i < kPacketsPerFrame; ++i)
+      order[i] = i;
+    for (int i = 0; i < kPacketsPerFrame; ++i) {
+      int window_end = std::min<int>(i + kReorderWindow, kPacketsPerFrame);
+      std::swap(order[i], order[rand_.Rand(i, window_end - 1)]);
+    }
+
+    std::vector<VCMPacket> packets(kPacketsPerFrame);
+    for (uint16_t i = 0; i < kPacketsPerFrame; ++i) {
+      VCMPacket& packet = packets[i];
+      packet.video_header.codec = kVideoCodecGeneric;
+      packet.timestamp = frame * 9000;
+      packet.seqNum = seq_num + order[i];
+      packet.video_header.frame_type = VideoFrameType::kVideoFrameKey;
+      packet.video_header.is_first_packet_in_frame = order[i] == 0;
+      packet.video_header.is_last_packet_in_frame =
+          order[i] == kPacketsPerFrame - 1;
+      packet.sizeBytes = kPayloadSize;
+      packet.dataPtr = new uint8_t[kPayloadSize]();
+    }
+
+    int64_t start_us = rtc::TimeMicros();
+    for (VCMPacket& packet : packets)
+      EXPECT_TRUE(packet_buffer.InsertPacket(&packet));
+    total_us += rtc::TimeMicros() - start_us;
+
+    CheckFrame(seq_num);
+    DeleteFrame(seq_num);
+    seq_num += kPacketsPerFrame;
+    packet_buffer.ClearTo(seq_num - 1);
+  }
+  RTC_LOG(LS_INFO) << "Assembled " << kNumFrames << " keyframes of "
+                   << kPacketsPerFrame << " packets in "
+                   << total_us / kNumFrames << " us per frame.";
+}
+
 }  // namespace video_coding
 }  // namespace webrtc
@@ -12,6 +12,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
@@ -21,12 +22,40 @@
 #include "modules/video_processing/util/denoiser_filter.h"
 #include "modules/video_processing/util/skin_detection.h"
 #include "modules/video_processing/video_denoiser.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/frame_utils.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "modules/video_processing/util/denoiser_filter_avx2.h"
+#endif
+
 namespace webrtc {
 
+namespace {
+
+// Fills the luma plane with a random walk around a gradient, so that
+// consecutive frames differ by noise of varying strength and some motion.
+void FillNoisyFrame(int frame_index, Random* random, I420Buffer* buffer) {
+  for (int y = 0; y < buffer->height(); ++y) {
+    for (int x = 0; x < buffer->width(); ++x) {
+      const int noise = random->Rand(-(y % 24), y % 24);
+      const int value = ((x + frame_index * 3) & 0xff) / 2 + 64 + noise;
+      buffer->MutableDataY()[y * buffer->StrideY() + x] =
+          static_cast<uint8_t>(std::min(255, std::max(0, value)));
+    }
+  }
+  memset(buffer->MutableDataU(), 128,
+         buffer->StrideU() * buffer->ChromaHeight());
+  memset(buffer->MutableDataV(), 128,
+         buffer->StrideV() * buffer->ChromaHeight());
+}
+
+}  // namespace
+
 TEST(VideoDenoiserTest, CopyMem) {
   std::unique_ptr<DenoiserFilter> df_c(DenoiserFilter::Create(false, nullptr));
   std::unique_ptr<DenoiserFilter> df_sse_neon(
@@ -165,4 +194,66 @@ TEST(VideoDenoiserTest, Denoiser) {
   ASSERT_NE(0, feof(source_file)) << "Error reading source file";
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+TEST(VideoDenoiserTest, Avx2MatchesC) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+  std::unique_ptr<DenoiserFilter> df_c(DenoiserFilter::Create(false, nullptr));
+  DenoiserFilterAVX2 df_avx2;
+  Random random(0x1234);
+  const int kStride = 24;
+  uint8_t running_src[16 * kStride], src[16 * kStride];
+  uint8_t dst[16 * kStride], dst_avx2[16 * kStride];
+  for (int test = 0; test < 1000; ++test) {
+    // Differences of all the adjustment levels, and all of one sign in some
+    // blocks to reach the saturation of the accumulated difference.
+    const int max_diff = 1 + test % 24;
+    const int min_diff = test % 3 == 0 ? 0 : -max_diff;
+    for (int i = 0; i < 16 * kStride; ++i) {
+      running_src[i] = random.Rand<uint8_t>();
+      src[i] = static_cast<uint8_t>(std::min(
+          255, std::max(0, running_src[i] + random.Rand(min_diff, max_diff))));
+    }
+    for (int increase_denoising = 0; increase_denoising < 2;
+         ++increase_denoising) {
+      memset(dst, 0, sizeof(dst));
+      memset(dst_avx2, 0, sizeof(dst_avx2));
+      EXPECT_EQ(df_c->MbDenoise(running_src, kStride, dst, kStride, src,
+                                kStride, 0, increase_denoising),
+                df_avx2.MbDenoise(running_src, kStride, dst_avx2, kStride, src,
+                                  kStride, 0, increase_denoising));
+      ASSERT_EQ(0, memcmp(dst, dst_avx2, sizeof(dst)));
+    }
+    uint32_t sse_c = 0, sse_avx2 = 0;
+    EXPECT_EQ(df_c->Variance16x8(running_src, kStride, src, kStride, &sse_c),
+              df_avx2.Variance16x8(running_src, kStride, src, kStride,
+                                   &sse_avx2));
+    EXPECT_EQ(sse_c, sse_avx2);
+  }
+}
+#endif
+
+TEST(VideoDenoiserTest, MultiThreadedDenoiserMatchesSingleThreaded) {
+  // Not a multiple of 16, to also cover the margins.
+  const int kWidth = 360;
+  const int kHeight = 200;
+  VideoDenoiser denoiser(true);
+  VideoDenoiser denoiser_multi_threaded(true, 4);
+  Random random(0x5678);
+
+  for (int i = 0; i < 30; ++i) {
+    rtc::scoped_refptr<I420Buffer> video_frame_buffer =
+        I420Buffer::Create(kWidth, kHeight);
+    FillNoisyFrame(i, &random, video_frame_buffer.get());
+
+    rtc::scoped_refptr<I420BufferInterface> denoised_frame(
+        denoiser.DenoiseFrame(video_frame_buffer, true));
+    rtc::scoped_refptr<I420BufferInterface> denoised_frame_multi_threaded(
+        denoiser_multi_threaded.DenoiseFrame(video_frame_buffer, true));
+
+    ASSERT_TRUE(
+        test::FrameBufsEqual(denoised_frame, denoised_frame_multi_threaded));
+  }
+}
+
 }  // namespace webrtc
@@ -13,7 +13,10 @@
 #include <stdint.h>
 #include <string.h>
 
+#include "api/task_queue/default_task_queue_factory.h"
 #include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "third_party/libyuv/include/libyuv/planar_functions.h"
 
 namespace webrtc {
@@ -75,10 +78,25 @@ static void ShowRect(const std::unique_ptr<DenoiserFilter>& filter,
 #endif
 
 VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection)
+    : VideoDenoiser(runtime_cpu_detection, 1) {}
+
+VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection, int num_threads)
     : width_(0),
       height_(0),
       filter_(DenoiserFilter::Create(runtime_cpu_detection, &cpu_type_)),
-      ne_(new NoiseEstimation()) {}
+      ne_(new NoiseEstimation()) {
+  RTC_DCHECK_GE(num_threads, 1);
+  if (num_threads > 1) {
+    task_queue_factory_ = CreateDefaultTaskQueueFactory();
+    for (int i = 1; i < num_threads; ++i) {
+      stripe_queues_.push_back(std::make_unique<rtc::TaskQueue>(
+          task_queue_factory_->CreateTaskQueue(
+              "VideoDenoiser", TaskQueueFactory::Priority::NORMAL)));
+    }
+  }
+}
+
+VideoDenoiser::~VideoDenoiser() = default;
 
 void VideoDenoiser::DenoiserReset(
     rtc::scoped_refptr<I420BufferInterface> frame) {
@@ -94,6 +112,8 @@ void VideoDenoiser::DenoiserReset(
   x_density_.reset(new uint8_t[mb_cols_]);
   y_density_.reset(new uint8_t[mb_rows_]);
   moving_object_.reset(new uint8_t[mb_cols_ * mb_rows_]);
+  mb_noise_var_.reset(new uint32_t[mb_cols_ * mb_rows_]);
+  mb_luma_.reset(new uint32_t[mb_cols_ * mb_rows_]);
 }
 
 int VideoDenoiser::PositionCheck(int mb_row, int mb_col, int noise_level) {
@@ -175,10 +195,12 @@ bool VideoDenoiser::IsTrailingBlock(const std::unique_ptr<uint8_t[]>& d_status,
 void VideoDenoiser::CopySrcOnMOB(const uint8_t* y_src,
                                  int stride_src,
                                  uint8_t* y_dst,
-                                 int stride_dst) {
+                                 int stride_dst,
+                                 int mb_row_begin,
+                                 int mb_row_end) {
   // Loop over to copy src block if the block is marked as moving object block
   // or if the block may cause trailing artifacts.
-  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+  for (int mb_row = mb_row_begin; mb_row < mb_row_end; ++mb_row) {
     const int mb_index_base = mb_row * mb_cols_;
     const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_src;
     uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_dst;
@@ -220,38 +242,17 @@ void VideoDenoiser::CopyLumaOnMargin(const uint8_t* y_src,
   }
 }
 
-rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
-    rtc::scoped_refptr<I420BufferInterface> frame,
-    bool noise_estimation_enabled) {
-  // If previous width and height are different from current frame's, need to
-  // reallocate the buffers and no denoising for the current frame.
-  if (!prev_buffer_ || width_ != frame->width() || height_ != frame->height()) {
-    DenoiserReset(frame);
-    prev_buffer_ = frame;
-    return frame;
-  }
-
-  // Set buffer pointers.
-  const uint8_t* y_src = frame->DataY();
-  int stride_y_src = frame->StrideY();
-  rtc::scoped_refptr<I420Buffer> dst =
-      buffer_pool_.CreateBuffer(width_, height_);
-
-  uint8_t* y_dst = dst->MutableDataY();
-  int stride_y_dst = dst->StrideY();
-
-  const uint8_t* y_dst_prev = prev_buffer_->DataY();
-  int stride_prev = prev_buffer_->StrideY();
-
-  memset(x_density_.get(), 0, mb_cols_);
-  memset(y_density_.get(), 0, mb_rows_);
-  memset(moving_object_.get(), 1, mb_cols_ * mb_rows_);
-
-  uint8_t noise_level = noise_estimation_enabled ? ne_->GetNoiseLevel() : 0;
-  int thr_var_base = 16 * 16 * 2;
-  // Loop over blocks to accumulate/extract noise level and update x/y_density
-  // factors for moving object detection.
-  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+void VideoDenoiser::DenoiseStripe(const uint8_t* y_src,
+                                  int stride_y_src,
+                                  uint8_t* y_dst,
+                                  int stride_y_dst,
+                                  const uint8_t* y_dst_prev,
+                                  int stride_prev,
+                                  uint8_t noise_level,
+                                  int mb_row_begin,
+                                  int mb_row_end) {
+  const int thr_var_base = 16 * 16 * 2;
+  for (int mb_row = mb_row_begin; mb_row < mb_row_end; ++mb_row) {
     const int mb_index_base = mb_row * mb_cols_;
     const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_y_src;
     uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_y_dst;
@@ -274,6 +275,7 @@ rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
             luma += mb_src[i * stride_y_src + j];
           }
         }
+        mb_luma_[mb_index] = luma;
       }
 
       // Get the filtered block and filter_decision.
@@ -289,9 +291,8 @@ rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
         if (ne_enable) {
           // The variance used in noise estimation is based on the src block in
           // time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
-          uint32_t noise_var = filter_->Variance16x8(
+          mb_noise_var_[mb_index] = filter_->Variance16x8(
               mb_dst_prev, stride_y_dst, mb_src, stride_y_src, &sse_t);
-          ne_->GetNoise(mb_index, noise_var, luma);
         }
         moving_edge_[mb_index] = 0;  // Not a moving edge block.
       } else {
@@ -301,29 +302,109 @@ rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
         uint32_t noise_var = filter_->Variance16x8(
             mb_dst_prev, stride_prev, mb_dst, stride_y_dst, &sse_t);
         if (noise_var > thr_var_adp) {  // Moving edge checking.
-          if (ne_enable) {
-            ne_->ResetConsecLowVar(mb_index);
-          }
           moving_edge_[mb_index] = 1;  // Mark as moving edge block.
-          x_density_[mb_col] += (pos_factor < 3);
-          y_density_[mb_row] += (pos_factor < 3);
         } else {
           moving_edge_[mb_index] = 0;
           if (ne_enable) {
             // The variance used in noise estimation is based on the src block
             // in time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
-            uint32_t noise_var = filter_->Variance16x8(
+            mb_noise_var_[mb_index] = filter_->Variance16x8(
                 mb_dst_prev, stride_prev, mb_src, stride_y_src, &sse_t);
-            ne_->GetNoise(mb_index, noise_var, luma);
           }
         }
       }
     }  // End of for loop
   }    // End of for loop
+}
+
+void VideoDenoiser::UpdateNoiseAndDensity(uint8_t noise_level) {
+  memset(x_density_.get(), 0, mb_cols_);
+  memset(y_density_.get(), 0, mb_rows_);
+  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+    for (int mb_col = 0; mb_col < mb_cols_; ++mb_col) {
+      const int mb_index = mb_row * mb_cols_ + mb_col;
+      const bool ne_enable = (mb_index % NOISE_SUBSAMPLE_INTERVAL == 0);
+      if (moving_edge_[mb_index]) {
+        if (ne_enable) {
+          ne_->ResetConsecLowVar(mb_index);
+        }
+        const int pos_factor = PositionCheck(mb_row, mb_col, noise_level);
+        x_density_[mb_col] += (pos_factor < 3);
+        y_density_[mb_row] += (pos_factor < 3);
+      } else if (ne_enable) {
+        ne_->GetNoise(mb_index, mb_noise_var_[mb_index], mb_luma_[mb_index]);
+      }
+    }
+  }
+}
+
+void VideoDenoiser::ProcessStripes(
+    const std::function<void(int mb_row_begin, int mb_row_end)>&
+        process_stripe) {
+  const int num_stripes = static_cast<int>(stripe_queues_.size()) + 1;
+  if (num_stripes == 1 || mb_rows_ < num_stripes) {
+    process_stripe(0, mb_rows_);
+    return;
+  }
+  std::vector<rtc::Event> done(num_stripes - 1);
+  for (int i = 0; i < num_stripes - 1; ++i) {
+    const int mb_row_begin = mb_rows_ * i / num_stripes;
+    const int mb_row_end = mb_rows_ * (i + 1) / num_stripes;
+    rtc::Event* stripe_done = &done[i];
+    stripe_queues_[i]->PostTask(
+        [&process_stripe, mb_row_begin, mb_row_end, stripe_done] {
+          process_stripe(mb_row_begin, mb_row_end);
+          stripe_done->Set();
+        });
+  }
+  // Meanwhile, process the last stripe on this thread.
+  process_stripe(mb_rows_ * (num_stripes - 1) / num_stripes, mb_rows_);
+  for (rtc::Event& stripe_done : done)
+    stripe_done.Wait(rtc::Event::kForever);
+}
+
+rtc::scoped_refptr<I420BufferInterface> VideoDenoiser::DenoiseFrame(
+    rtc::scoped_refptr<I420BufferInterface> frame,
+    bool noise_estimation_enabled) {
+  // If previous width and height are different from current frame's, need to
+  // reallocate the buffers and no denoising for the current frame.
+  if (!prev_buffer_ || width_ != frame->width() || height_ != frame->height()) {
+    DenoiserReset(frame);
+    prev_buffer_ = frame;
+    return frame;
+  }
+
+  // Set buffer pointers.
+  const uint8_t* y_src = frame->DataY();
+  int stride_y_src = frame->StrideY();
+  rtc::scoped_refptr<I420Buffer> dst =
+      buffer_pool_.CreateBuffer(width_, height_);
+
+  uint8_t* y_dst = dst->MutableDataY();
+  int stride_y_dst = dst->StrideY();
+
+  const uint8_t* y_dst_prev = prev_buffer_->DataY();
+  int stride_prev = prev_buffer_->StrideY();
+
+  memset(moving_object_.get(), 1, mb_cols_ * mb_rows_);
+
+  uint8_t noise_level = noise_estimation_enabled ? ne_->GetNoiseLevel() : 0;
+  // Denoise the blocks and extract what the noise estimation and the moving
+  // object detection need. Only the stripe's own blocks are written.
+  ProcessStripes([&](int mb_row_begin, int mb_row_end) {
+    DenoiseStripe(y_src, stride_y_src, y_dst, stride_y_dst, y_dst_prev,
+                  stride_prev, noise_level, mb_row_begin, mb_row_end);
+  });
+  // Accumulate noise level and update x/y_density factors for moving object
+  // detection.
+  UpdateNoiseAndDensity(noise_level);
 
   ReduceFalseDetection(moving_edge_, &moving_object_, noise_level);
 
-  CopySrcOnMOB(y_src, stride_y_src, y_dst, stride_y_dst);
+  ProcessStripes([&](int mb_row_begin, int mb_row_end) {
+    CopySrcOnMOB(y_src, stride_y_src, y_dst, stride_y_dst, mb_row_begin,
+                 mb_row_end);
+  });
 
   // When frame width/height not divisible by 16, copy the margin to
   // denoised_frame.
@@ -11,20 +11,29 @@
 #ifndef MODULES_VIDEO_PROCESSING_VIDEO_DENOISER_H_
 #define MODULES_VIDEO_PROCESSING_VIDEO_DENOISER_H_
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 #include "api/scoped_refptr.h"
+#include "api/task_queue/task_queue_factory.h"
 #include "api/video/video_frame_buffer.h"
 #include "common_video/include/i420_buffer_pool.h"
 #include "modules/video_processing/util/denoiser_filter.h"
 #include "modules/video_processing/util/noise_estimation.h"
 #include "modules/video_processing/util/skin_detection.h"
+#include "rtc_base/task_queue.h"
 
 namespace webrtc {
 
 class VideoDenoiser {
  public:
   explicit VideoDenoiser(bool runtime_cpu_detection);
+  // Splits the frames into |num_threads| stripes of macroblock rows, which
+  // are denoised concurrently on task queues of their own and on the thread
+  // calling DenoiseFrame(). The result is the same as with a single thread.
+  VideoDenoiser(bool runtime_cpu_detection, int num_threads);
+  ~VideoDenoiser();
 
   rtc::scoped_refptr<I420BufferInterface> DenoiseFrame(
       rtc::scoped_refptr<I420BufferInterface> frame,
@@ -49,11 +58,38 @@ class VideoDenoiser {
                        int mb_row,
                        int mb_col);
 
-  // Copy input blocks to dst buffer on moving object blocks (MOB).
+  // Denoises the luma blocks of macroblock rows [mb_row_begin, mb_row_end),
+  // and saves the filter decisions, moving edges and the variances used for
+  // noise estimation.
+  void DenoiseStripe(const uint8_t* y_src,
+                     int stride_y_src,
+                     uint8_t* y_dst,
+                     int stride_y_dst,
+                     const uint8_t* y_dst_prev,
+                     int stride_prev,
+                     uint8_t noise_level,
+                     int mb_row_begin,
+                     int mb_row_end);
+
+  // Feeds the saved variances to the noise estimator and accumulates the
+  // x/y_density factors for moving object detection, in block order.
+  void UpdateNoiseAndDensity(uint8_t noise_level);
+
+  // Copy input blocks to dst buffer on moving object blocks (MOB), for
+  // macroblock rows [mb_row_begin, mb_row_end).
   void CopySrcOnMOB(const uint8_t* y_src,
                     int stride_src,
                     uint8_t* y_dst,
-                    int stride_dst);
+                    int stride_dst,
+                    int mb_row_begin,
+                    int mb_row_end);
+
+  // Calls |process_stripe| with the bounds of each stripe of macroblock rows,
+  // concurrently when there are |stripe_queues_|, and returns when all
+  // stripes are done.
+  void ProcessStripes(
+      const std::function<void(int mb_row_begin, int mb_row_end)>&
+          process_stripe);
 
   // Copy luma margin blocks when frame width/height not divisible by 16.
   void CopyLumaOnMargin(const uint8_t* y_src,
@@ -77,8 +113,17 @@ class VideoDenoiser {
   std::unique_ptr<uint8_t[]> y_density_;
   // Save the return values by MbDenoise for each block.
   std::unique_ptr<DenoiserDecision[]> mb_filter_decision_;
+  // Variance and luma sum for noise estimation, for the blocks that take part
+  // in it.
+  std::unique_ptr<uint32_t[]> mb_noise_var_;
+  std::unique_ptr<uint32_t[]> mb_luma_;
   I420BufferPool buffer_pool_;
   rtc::scoped_refptr<I420BufferInterface> prev_buffer_;
+
+  std::unique_ptr<TaskQueueFactory> task_queue_factory_;
+  // Queues for all stripes but the last one, which is processed on the thread
+  // calling DenoiseFrame().
+  std::vector<std::unique_ptr<rtc::TaskQueue>> stripe_queues_;
 };
 
 }  // namespace webrtc
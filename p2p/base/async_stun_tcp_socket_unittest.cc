@@ -13,14 +13,19 @@
 #include <stdint.h>
 #include <string.h>
 
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/async_socket.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/virtual_socket_server.h"
 #include "test/gtest.h"
 
@@ -153,6 +158,29 @@ TEST_F(AsyncStunTCPSocketTest, TestMultipleStunPackets) {
   EXPECT_EQ(4u, recv_packets_.size());
 }
 
+// Verify that packets arriving in a single read are all received, in order,
+// including ChannelData messages followed by padding.
+TEST_F(AsyncStunTCPSocketTest, TestMultiplePacketsInOneRead) {
+  rtc::PacketOptions options;
+  for (int i = 0; i < 50; ++i) {
+    ASSERT_EQ(static_cast<int>(sizeof(kTurnChannelDataMessageWithOddLength)),
+              send_socket_->Send(kTurnChannelDataMessageWithOddLength,
+                                 sizeof(kTurnChannelDataMessageWithOddLength),
+                                 options));
+    ASSERT_EQ(static_cast<int>(sizeof(kStunMessageWithZeroLength)),
+              send_socket_->Send(kStunMessageWithZeroLength,
+                                 sizeof(kStunMessageWithZeroLength), options));
+  }
+  vss_->ProcessMessagesUntilIdle();
+  ASSERT_EQ(100u, recv_packets_.size());
+  for (int i = 0; i < 50; ++i) {
+    EXPECT_TRUE(CheckData(kTurnChannelDataMessageWithOddLength,
+                          sizeof(kTurnChannelDataMessageWithOddLength)));
+    EXPECT_TRUE(CheckData(kStunMessageWithZeroLength,
+                          sizeof(kStunMessageWithZeroLength)));
+  }
+}
+
 // Verifying TURN channel data message with zero length.
 TEST_F(AsyncStunTCPSocketTest, TestTurnChannelDataWithZeroLength) {
   EXPECT_TRUE(Send(kTurnChannelDataMessageWithZeroLength,
@@ -281,4 +309,32 @@ TEST_F(AsyncStunTCPSocketTest, SignalSentPacketNotFiredWhenPacketNotSent) {
   EXPECT_EQ(0, sent_packets_);
 }
 
+// Measures how many TURN ChannelData packets per second go through a
+// connected pair of sockets. Run with --gtest_also_run_disabled_tests to get
+// the rate logged.
+TEST_F(AsyncStunTCPSocketTest, DISABLED_ChannelDataThroughputPerf) {
+  const int kNumBatches = 1000;
+  const int kPacketsPerBatch = 20;
+  // A ChannelData message with 1200 bytes of data, which needs no padding.
+  std::vector<char> packet(4 + 1200);
+  packet[0] = 0x40;
+  rtc::SetBE16(&packet[2], 1200);
+  rtc::PacketOptions options;
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kNumBatches; ++i) {
+    for (int j = 0; j < kPacketsPerBatch; ++j) {
+      send_socket_->Send(packet.data(), packet.size(), options);
+    }
+    vss_->ProcessMessagesUntilIdle();
+  }
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  EXPECT_FALSE(recv_packets_.empty());
+  RTC_LOG(LS_INFO) << recv_packets_.size() << " packets in "
+                   << elapsed_us / 1000 << " ms: "
+                   << static_cast<int64_t>(recv_packets_.size()) *
+                          rtc::kNumMicrosecsPerSec /
+                          std::max<int64_t>(1, elapsed_us)
+                   << " packets/s";
+}
+
 }  // namespace cricket
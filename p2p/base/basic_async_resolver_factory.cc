@@ -10,12 +10,12 @@
 
 #include "p2p/base/basic_async_resolver_factory.h"
 
-#include "rtc_base/net_helpers.h"
+#include "rtc_base/async_resolver_pool.h"
 
 namespace webrtc {
 
 rtc::AsyncResolverInterface* BasicAsyncResolverFactory::Create() {
-  return new rtc::AsyncResolver();
+  return rtc::AsyncResolverPool::Default()->CreateResolver();
 }
 
 }  // namespace webrtc
@@ -15,11 +15,11 @@
 #include <string>
 
 #include "p2p/base/async_stun_tcp_socket.h"
+#include "rtc_base/async_resolver_pool.h"
 #include "rtc_base/async_tcp_socket.h"
 #include "rtc_base/async_udp_socket.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
-#include "rtc_base/net_helpers.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_adapters.h"
 #include "rtc_base/socket_server.h"
@@ -189,7 +189,7 @@ AsyncPacketSocket* BasicPacketSocketFactory::CreateClientTcpSocket(
 }
 
 AsyncResolverInterface* BasicPacketSocketFactory::CreateAsyncResolver() {
-  return new AsyncResolver();
+  return AsyncResolverPool::Default()->CreateResolver();
 }
 
 int BasicPacketSocketFactory::BindSocket(AsyncSocket* socket,
@@ -216,7 +216,8 @@ void ConnectionRequest::Prepare(StunMessage* request) {
       STUN_ATTR_PRIORITY, prflx_priority));
 
   // Adding Message Integrity attribute.
-  request->AddMessageIntegrity(connection_->remote_candidate().password());
+  request->AddMessageIntegrity(connection_->remote_password_hmac_.Get(
+      connection_->remote_candidate().password()));
   // Adding Fingerprint.
   request->AddFingerprint();
 }
@@ -454,8 +455,9 @@ void Connection::OnReadPacket(const char* data,
       // id's match.
       case STUN_BINDING_RESPONSE:
       case STUN_BINDING_ERROR_RESPONSE:
-        if (msg->ValidateMessageIntegrity(data, size,
-                                          remote_candidate().password())) {
+        if (msg->ValidateMessageIntegrity(
+                data, size,
+                remote_password_hmac_.Get(remote_candidate().password()))) {
           requests_.CheckResponse(msg.get());
         }
         // Otherwise silently discard the response message.
@@ -371,6 +371,8 @@ class Connection : public CandidatePairInterface,
 
   IceMode remote_ice_mode_;
   StunRequestManager requests_;
+  // Authenticates the pings to and responses from the remote candidate.
+  StunPasswordHmac remote_password_hmac_;
   int rtt_;
   int rtt_samples_ = 0;
   // https://w3c.github.io/webrtc-stats/#dom-rtcicecandidatepairstats-totalroundtriptime
@@ -10,6 +10,7 @@
 
 #include "p2p/base/p2p_transport_channel.h"
 
+#include <algorithm>
 #include <iterator>
 #include <memory>
 #include <set>
@@ -95,6 +96,34 @@ uint32_t GetWeakPingIntervalInFieldTrial() {
   return cricket::WEAK_PING_INTERVAL;
 }
 
+// Sorts |connections| like a stable sort does, but with fewer comparisons when
+// only a few of them are out of order, which is the common case between two
+// sorts. The connections that are smaller than the one before them are taken
+// out, leaving the others sorted, and are then inserted where they belong.
+template <typename Less>
+void StableSortMostlySorted(std::vector<cricket::Connection*>* connections,
+                            Less less) {
+  std::vector<cricket::Connection*> out_of_order;
+  auto sorted_end = connections->begin();
+  for (cricket::Connection* connection : *connections) {
+    if (sorted_end != connections->begin() &&
+        less(connection, *(sorted_end - 1))) {
+      out_of_order.push_back(connection);
+    } else {
+      *sorted_end++ = connection;
+    }
+  }
+  connections->erase(sorted_end, connections->end());
+  // A connection that was taken out is smaller than all sorted connections
+  // that came after it, so inserting after the equal ones keeps it stable.
+  for (cricket::Connection* connection : out_of_order) {
+    connections->insert(
+        std::upper_bound(connections->begin(), connections->end(), connection,
+                         less),
+        connection);
+  }
+}
+
 }  // unnamed namespace
 
 namespace cricket {
@@ -1807,20 +1836,22 @@ void P2PTransportChannel::SortConnectionsAndUpdateState(
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
   // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  absl::c_stable_sort(
-      connections_, [this](const Connection* a, const Connection* b) {
-        int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
-        if (cmp != 0) {
-          return cmp > 0;
-        }
-        // Otherwise, sort based on latency estimate.
-        return a->rtt() < b->rtt();
-      });
-
-  RTC_LOG(LS_VERBOSE) << "Sorting " << connections_.size()
-                      << " available connections";
-  for (size_t i = 0; i < connections_.size(); ++i) {
-    RTC_LOG(LS_VERBOSE) << connections_[i]->ToString();
+  auto connection_less = [this](const Connection* a, const Connection* b) {
+    int cmp = CompareConnections(a, b, absl::nullopt, nullptr);
+    if (cmp != 0) {
+      return cmp > 0;
+    }
+    // Otherwise, sort based on latency estimate.
+    return a->rtt() < b->rtt();
+  };
+  StableSortMostlySorted(&connections_, connection_less);
+
+  if (RTC_LOG_CHECK_LEVEL(LS_VERBOSE)) {
+    RTC_LOG(LS_VERBOSE) << "Sorting " << connections_.size()
+                        << " available connections";
+    for (size_t i = 0; i < connections_.size(); ++i) {
+      RTC_LOG(LS_VERBOSE) << connections_[i]->ToString();
+    }
   }
 
   Connection* top_connection =
@@ -2290,19 +2321,21 @@ Connection* P2PTransportChannel::FindNextPingableConnection() {
   // Otherwise, treat everything as unpinged.
   // TODO(honghaiz): Instead of adding two separate vectors, we can add a state
   // "pinged" to filter out unpinged connections.
-  if (absl::c_none_of(unpinged_connections_, [this, now](Connection* conn) {
-        return this->IsPingable(conn, now);
-      })) {
+  std::vector<Connection*> pingable_connections;
+  absl::c_copy_if(
+      unpinged_connections_, std::back_inserter(pingable_connections),
+      [this, now](Connection* conn) { return IsPingable(conn, now); });
+  if (pingable_connections.empty()) {
+    // Only the previously pinged connections need to be checked again.
+    absl::c_copy_if(
+        pinged_connections_, std::back_inserter(pingable_connections),
+        [this, now](Connection* conn) { return IsPingable(conn, now); });
     unpinged_connections_.insert(pinged_connections_.begin(),
                                  pinged_connections_.end());
     pinged_connections_.clear();
   }
 
   // Among un-pinged pingable connections, "more pingable" takes precedence.
-  std::vector<Connection*> pingable_connections;
-  absl::c_copy_if(
-      unpinged_connections_, std::back_inserter(pingable_connections),
-      [this, now](Connection* conn) { return IsPingable(conn, now); });
   auto iter = absl::c_max_element(pingable_connections,
                                   [this](Connection* conn1, Connection* conn2) {
                                     // Some implementations of max_element
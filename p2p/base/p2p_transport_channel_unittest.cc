@@ -39,6 +39,7 @@
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/virtual_socket_server.h"
 #include "system_wrappers/include/metrics.h"
 #include "test/field_trial.h"
@@ -4529,6 +4530,49 @@ TEST_F(P2PTransportChannelPingTest, TestPortDestroyedAfterTimeoutAndPruned) {
   EXPECT_EQ_SIMULATED_WAIT(nullptr, GetPrunedPort(&ch), 1, fake_clock);
 }
 
+// Measures the cost of scheduling pings and keeping the connections sorted
+// with many connections on a channel. Run with
+// --gtest_also_run_disabled_tests to get the timings logged.
+class P2PTransportChannelPingPerfTest
+    : public P2PTransportChannelPingTest,
+      public ::testing::WithParamInterface<int> {};
+
+INSTANTIATE_TEST_SUITE_P(NumConnections,
+                         P2PTransportChannelPingPerfTest,
+                         ::testing::Values(10, 100, 400));
+
+TEST_P(P2PTransportChannelPingPerfTest, DISABLED_PingSchedulingPerf) {
+  const int num_connections = GetParam();
+  const int kSteps = 1000;
+  rtc::ScopedFakeClock clock;
+  FakePortAllocator pa(rtc::Thread::Current(), nullptr);
+  P2PTransportChannel ch("ping perf", 1, &pa);
+  PrepareChannel(&ch);
+  ch.SetIceRole(ICEROLE_CONTROLLED);
+  ch.MaybeStartGathering();
+  std::vector<std::string> remote_ips;
+  for (int i = 0; i < num_connections; ++i) {
+    remote_ips.push_back(rtc::IPAddress(0x0A000001 + i).ToString());
+    ASSERT_TRUE(CreateConnectionWithCandidate(&ch, &clock, remote_ips.back(),
+                                              1, i, true));
+  }
+
+  int64_t start_us = rtc::SystemTimeNanos() / 1000;
+  for (int step = 0; step < kSteps; ++step) {
+    // Ping responses keep the connections alive and change their RTTs, which
+    // may change their order.
+    Connection* conn =
+        GetConnectionTo(&ch, remote_ips[step % num_connections], 1);
+    if (conn)
+      conn->ReceivedPingResponse(LOW_RTT + step % 50, "id");
+    clock.AdvanceTime(webrtc::TimeDelta::ms(10));
+  }
+  int64_t elapsed_us = rtc::SystemTimeNanos() / 1000 - start_us;
+  RTC_LOG(LS_INFO) << num_connections << " connections: "
+                   << static_cast<double>(elapsed_us) / kSteps
+                   << " us per 10 ms of pinging";
+}
+
 class P2PTransportChannelMostLikelyToWorkFirstTest
     : public P2PTransportChannelPingTest {
  public:
@@ -470,6 +470,8 @@ class Port : public PortInterface,
   // username_fragment().
   std::string ice_username_fragment_;
   std::string password_;
+  // Authenticates the connectivity checks to and from this port.
+  StunPasswordHmac password_hmac_;
   std::vector<Candidate> candidates_;
   AddressMap connections_;
   int timeout_delay_;
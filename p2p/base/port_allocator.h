@@ -87,6 +87,18 @@ enum {
   // Exclude link-local network interfaces
   // from considertaion after adapter enumeration.
   PORTALLOCATOR_DISABLE_LINK_LOCAL_NETWORKS = 0x10000,
+
+  // Along with PORTALLOCATOR_ENABLE_SHARED_SOCKET, the UDP ports of all
+  // sessions of the allocator share one UDP socket per local IP, instead of
+  // opening a socket for each session. Meant for servers with many ICE-lite
+  // sessions; relay ports don't use the shared socket in this mode.
+  PORTALLOCATOR_ENABLE_UDP_SOCKET_MUX = 0x20000,
+
+  // Run all the allocation phases of a network at once, instead of one phase
+  // per step delay, and start the networks right after each other, paced by
+  // the number of STUN and TURN servers they contact. Shortens the time to the
+  // first relay candidate at the cost of a burst of traffic at the start.
+  PORTALLOCATOR_ENABLE_PARALLEL_GATHERING = 0x40000,
 };
 
 // Defines various reasons that have caused ICE regathering.
@@ -114,14 +114,26 @@ const uint32_t DEF_ACK_DELAY = 100;  // 100 milliseconds
 
 const uint8_t FLAG_CTL = 0x02;
 const uint8_t FLAG_RST = 0x04;
+// Set on ACKs that carry SACK blocks as their data: a count byte followed by
+// the [left, right) sequence numbers of each block. Only sent when both
+// sides offered TCP_OPT_SACK_PERMITTED.
+const uint8_t FLAG_SACK = 0x08;
 
 const uint8_t CTL_CONNECT = 0;
 
 // TCP options.
-const uint8_t TCP_OPT_EOL = 0;        // End of list.
-const uint8_t TCP_OPT_NOOP = 1;       // No-op.
-const uint8_t TCP_OPT_MSS = 2;        // Maximum segment size.
-const uint8_t TCP_OPT_WND_SCALE = 3;  // Window scale factor.
+const uint8_t TCP_OPT_EOL = 0;             // End of list.
+const uint8_t TCP_OPT_NOOP = 1;            // No-op.
+const uint8_t TCP_OPT_MSS = 2;             // Maximum segment size.
+const uint8_t TCP_OPT_WND_SCALE = 3;       // Window scale factor.
+const uint8_t TCP_OPT_SACK_PERMITTED = 4;  // Selective ACKs (RFC 2018).
+
+// Pacing rates, in percent of the congestion window per round trip.
+const uint32_t PACING_GAIN_SLOW_START = 200;
+const uint32_t PACING_GAIN = 125;
+// At most the bytes of this long at the pacing rate, or of two segments, are
+// sent in a burst.
+const uint32_t MAX_PACING_BURST = 5;  // 5 milliseconds
 
 const long DEFAULT_TIMEOUT =
     4000;  // If there are no pending clocks, wake up every 4 seconds
@@ -251,6 +263,13 @@ PseudoTcp::PseudoTcp(IPseudoTcpNotify* notify, uint32_t conv)
   m_rx_rto = DEF_RTO;
   m_rx_srtt = m_rx_rttvar = 0;
 
+  m_sack_permitted = m_use_sack = false;
+  m_sack_high = m_sack_rexmit_nxt = 0;
+
+  m_use_pacing = m_pacing_deferred = false;
+  m_pacing_budget = 0;
+  m_pacing_last = 0;
+
   m_use_nagling = true;
   m_ack_delay = DEF_ACK_DELAY;
   m_support_wnd_scale = true;
@@ -335,6 +354,11 @@ void PseudoTcp::NotifyClock(uint32_t now) {
     packet(m_snd_nxt, 0, 0, 0);
   }
 
+  // Check if it's time to send data held back by pacing
+  if (m_pacing_deferred) {
+    attemptSend();
+  }
+
 #if PSEUDO_KEEPALIVE
   // Check for idle timeout
   if ((m_state == TCP_ESTABLISHED) &&
@@ -373,6 +397,10 @@ void PseudoTcp::GetOption(Option opt, int* value) {
     *value = m_sbuf_len;
   } else if (opt == OPT_RCVBUF) {
     *value = m_rbuf_len;
+  } else if (opt == OPT_SACK) {
+    *value = m_sack_permitted ? 1 : 0;
+  } else if (opt == OPT_PACING) {
+    *value = m_use_pacing ? 1 : 0;
   } else {
     RTC_NOTREACHED();
   }
@@ -388,6 +416,12 @@ void PseudoTcp::SetOption(Option opt, int value) {
   } else if (opt == OPT_RCVBUF) {
     RTC_DCHECK(m_state == TCP_LISTEN);
     resizeReceiveBuffer(value);
+  } else if (opt == OPT_SACK) {
+    RTC_DCHECK(m_state == TCP_LISTEN);
+    m_sack_permitted = value != 0;
+  } else if (opt == OPT_PACING) {
+    m_use_pacing = value != 0;
+    m_pacing_deferred = false;
   } else {
     RTC_NOTREACHED();
   }
@@ -530,12 +564,16 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
   long_to_bytes(m_ts_recent, buffer.get() + 20);
   m_ts_lastack = m_rcv_nxt;
 
+  uint32_t sack_len = 0;
   if (len) {
     size_t bytes_read = 0;
     rtc::StreamResult result =
         m_sbuf.ReadOffset(buffer.get() + HEADER_SIZE, len, offset, &bytes_read);
     RTC_DCHECK(result == rtc::SR_SUCCESS);
     RTC_DCHECK(static_cast<uint32_t>(bytes_read) == len);
+  } else if (m_use_sack && !m_rlist.empty() && !(flags & FLAG_CTL)) {
+    sack_len = writeSackBlocks(buffer.get() + HEADER_SIZE);
+    buffer[13] |= FLAG_SACK;
   }
 
 #if _DEBUGMSG >= _DBG_VERBOSE
@@ -548,8 +586,9 @@ IPseudoTcpNotify::WriteResult PseudoTcp::packet(uint32_t seq,
                    << ">";
 #endif  // _DEBUGMSG
 
-  IPseudoTcpNotify::WriteResult wres = m_notify->TcpWritePacket(
-      this, reinterpret_cast<char*>(buffer.get()), len + HEADER_SIZE);
+  IPseudoTcpNotify::WriteResult wres =
+      m_notify->TcpWritePacket(this, reinterpret_cast<char*>(buffer.get()),
+                               HEADER_SIZE + len + sack_len);
   // Note: When len is 0, this is an ACK packet.  We don't read the return value
   // for those, and thus we won't retry.  So go ahead and treat the packet as a
   // success (basically simulate as if it were dropped), which will prevent our
@@ -584,6 +623,23 @@ bool PseudoTcp::parse(const uint8_t* buffer, uint32_t size) {
   seg.data = reinterpret_cast<const char*>(buffer) + HEADER_SIZE;
   seg.len = size - HEADER_SIZE;
 
+  seg.num_sack_blocks = 0;
+  if (seg.flags & FLAG_SACK) {
+    // The SACK blocks are all of the data.
+    if (seg.len == 0 || buffer[HEADER_SIZE] > kMaxSackBlocks ||
+        seg.len != 1 + 8u * buffer[HEADER_SIZE]) {
+      RTC_LOG_F(LS_WARNING) << "Invalid SACK blocks received";
+      return false;
+    }
+    seg.num_sack_blocks = buffer[HEADER_SIZE];
+    for (uint8_t i = 0; i < seg.num_sack_blocks; ++i) {
+      const uint8_t* block = buffer + HEADER_SIZE + 1 + 8 * i;
+      seg.sack_blocks[i].left = rtc::GetBE32(block);
+      seg.sack_blocks[i].right = rtc::GetBE32(block + 4);
+    }
+    seg.len = 0;
+  }
+
 #if _DEBUGMSG >= _DBG_VERBOSE
   RTC_LOG(LS_INFO) << "--> <CONV=" << seg.conv
                    << "><FLG=" << static_cast<unsigned>(seg.flags)
@@ -628,6 +684,14 @@ bool PseudoTcp::clock_check(uint32_t now, long& nTimeout) {
     nTimeout = std::min<int32_t>(nTimeout,
                                  rtc::TimeDiff32(m_lastsend + m_rx_rto, now));
   }
+  if (m_pacing_deferred) {
+    // Wake up when the pacing budget allows the next segment.
+    uint64_t rate = pacingRate();
+    uint32_t wait =
+        static_cast<uint32_t>(((1 - m_pacing_budget) * 1000 + rate - 1) / rate);
+    nTimeout = std::min<int32_t>(nTimeout,
+                                 rtc::TimeDiff32(m_pacing_last + wait, now));
+  }
 #if PSEUDO_KEEPALIVE
   if (m_state == TCP_ESTABLISHED) {
     nTimeout = std::min<int32_t>(
@@ -704,6 +768,10 @@ bool PseudoTcp::process(Segment& seg) {
     m_ts_recent = seg.tsval;
   }
 
+  if (m_use_sack && seg.num_sack_blocks > 0) {
+    applySack(seg);
+  }
+
   // Check if this is a valuable ack
   if ((seg.ack > m_snd_una) && (seg.ack <= m_snd_nxt)) {
     // Calculate round-trip time
@@ -771,6 +839,8 @@ bool PseudoTcp::process(Segment& seg) {
           closedown(ECONNABORTED);
           return false;
         }
+        m_sack_rexmit_nxt = std::max(
+            m_sack_rexmit_nxt, m_slist.front().seq + m_slist.front().len);
         m_cwnd += m_mss - std::min(nAcked, m_cwnd);
       }
     } else {
@@ -802,13 +872,25 @@ bool PseudoTcp::process(Segment& seg) {
           return false;
         }
         m_recover = m_snd_nxt;
+        m_sack_rexmit_nxt = m_slist.front().seq + m_slist.front().len;
         uint32_t nInFlight = m_snd_nxt - m_snd_una;
         m_ssthresh = std::max(nInFlight / 2, 2 * m_mss);
         // RTC_LOG(LS_INFO) << "m_ssthresh: " << m_ssthresh << "  nInFlight: "
         // << nInFlight << "  m_mss: " << m_mss;
         m_cwnd = m_ssthresh + 3 * m_mss;
       } else if (m_dup_acks > 3) {
-        m_cwnd += m_mss;
+        // With SACK, the segment that left the network makes room for the
+        // next hole rather than for new data.
+        SList::iterator hole = m_use_sack ? nextSackHole() : m_slist.end();
+        if (hole != m_slist.end()) {
+          if (!transmit(hole, now)) {
+            closedown(ECONNABORTED);
+            return false;
+          }
+          m_sack_rexmit_nxt = hole->seq + hole->len;
+        } else {
+          m_cwnd += m_mss;
+        }
       }
     } else {
       m_dup_acks = 0;
@@ -1040,6 +1122,7 @@ bool PseudoTcp::transmit(const SList::iterator& seg, uint32_t now) {
     SSegment subseg(seg->seq + nTransmit, seg->len - nTransmit, seg->bCtrl);
     // subseg.tstamp = seg->tstamp;
     subseg.xmit = seg->xmit;
+    subseg.sacked = seg->sacked;
     seg->len = nTransmit;
 
     SList::iterator next = seg;
@@ -1064,6 +1147,7 @@ void PseudoTcp::attemptSend(SendFlags sflags) {
   if (rtc::TimeDiff32(now, m_lastsend) > static_cast<long>(m_rx_rto)) {
     m_cwnd = m_mss;
   }
+  m_pacing_deferred = false;
 
 #if _DEBUGMSG
   bool bFirst = true;
@@ -1107,6 +1191,17 @@ void PseudoTcp::attemptSend(SendFlags sflags) {
     }
 #endif  // _DEBUGMSG
 
+    // Pacing spreads the window over the round trip instead of sending it
+    // as soon as ACKs open it. The RTT must be known first.
+    if (nAvailable > 0 && m_use_pacing && m_rx_srtt > 0) {
+      refillPacingBudget(now);
+      if (m_pacing_budget <= 0) {
+        // Sent from NotifyClock(), see clock_check().
+        m_pacing_deferred = true;
+        nAvailable = 0;
+      }
+    }
+
     if (nAvailable == 0) {
       if (sflags == sfNone)
         return;
@@ -1148,11 +1243,98 @@ void PseudoTcp::attemptSend(SendFlags sflags) {
       // TODO(?): consider closing socket
       return;
     }
+    if (m_use_pacing) {
+      m_pacing_budget -= seg->len;
+    }
 
     sflags = sfNone;
   }
 }
 
+void PseudoTcp::applySack(const Segment& seg) {
+  for (uint8_t i = 0; i < seg.num_sack_blocks; ++i) {
+    const SackBlock& block = seg.sack_blocks[i];
+    if ((block.left >= block.right) || (block.right > m_snd_nxt)) {
+      continue;
+    }
+    for (SSegment& sseg : m_slist) {
+      if ((sseg.xmit == 0) || (sseg.seq >= block.right)) {
+        break;
+      }
+      if ((sseg.seq >= block.left) && (sseg.seq + sseg.len <= block.right)) {
+        sseg.sacked = true;
+      }
+    }
+    m_sack_high = std::max(m_sack_high, block.right);
+  }
+}
+
+PseudoTcp::SList::iterator PseudoTcp::nextSackHole() {
+  // The receiver never drops out-of-order data, so SACKed segments don't
+  // need to be retransmitted even after a timeout.
+  for (SList::iterator it = m_slist.begin(); it != m_slist.end(); ++it) {
+    if ((it->xmit == 0) || (it->seq >= m_sack_high)) {
+      break;
+    }
+    if (!it->sacked && (it->seq >= m_sack_rexmit_nxt)) {
+      return it;
+    }
+  }
+  return m_slist.end();
+}
+
+uint32_t PseudoTcp::writeSackBlocks(uint8_t* buffer) {
+  // |m_rlist| is sorted by sequence number, but its segments may overlap or
+  // be adjacent. The blocks closest to |m_rcv_nxt| come first.
+  SackBlock blocks[kMaxSackBlocks];
+  uint8_t count = 0;
+  for (const RSegment& rseg : m_rlist) {
+    uint32_t left = std::max(rseg.seq, m_rcv_nxt);
+    uint32_t right = rseg.seq + rseg.len;
+    if (left >= right) {
+      continue;
+    }
+    if ((count > 0) && (left <= blocks[count - 1].right)) {
+      blocks[count - 1].right = std::max(blocks[count - 1].right, right);
+    } else if (count < kMaxSackBlocks) {
+      blocks[count].left = left;
+      blocks[count].right = right;
+      ++count;
+    } else {
+      break;
+    }
+  }
+
+  buffer[0] = count;
+  for (uint8_t i = 0; i < count; ++i) {
+    rtc::SetBE32(buffer + 1 + 8 * i, blocks[i].left);
+    rtc::SetBE32(buffer + 5 + 8 * i, blocks[i].right);
+  }
+  return 1 + 8 * count;
+}
+
+uint64_t PseudoTcp::pacingRate() const {
+  RTC_DCHECK_GT(m_rx_srtt, 0);
+  uint32_t gain = (m_cwnd < m_ssthresh) ? PACING_GAIN_SLOW_START : PACING_GAIN;
+  // Percent of the window per millisecond to bytes per second.
+  return std::max<uint64_t>(1, uint64_t{m_cwnd} * gain * 10 / m_rx_srtt);
+}
+
+void PseudoTcp::refillPacingBudget(uint32_t now) {
+  uint64_t rate = pacingRate();
+  int64_t max_budget = static_cast<int64_t>(
+      std::max<uint64_t>(2 * m_mss, rate * MAX_PACING_BURST / 1000));
+  if (m_pacing_last == 0) {
+    m_pacing_budget = max_budget;
+  } else {
+    int32_t elapsed = std::max(0, rtc::TimeDiff32(now, m_pacing_last));
+    m_pacing_budget =
+        std::min(max_budget,
+                 m_pacing_budget + static_cast<int64_t>(rate * elapsed / 1000));
+  }
+  m_pacing_last = now;
+}
+
 void PseudoTcp::closedown(uint32_t err) {
   RTC_LOG(LS_INFO) << "State: TCP_CLOSED";
   m_state = TCP_CLOSED;
@@ -1198,6 +1380,10 @@ void PseudoTcp::queueConnectMessage() {
     buf.WriteUInt8(1);
     buf.WriteUInt8(m_rwnd_scale);
   }
+  if (m_sack_permitted) {
+    buf.WriteUInt8(TCP_OPT_SACK_PERMITTED);
+    buf.WriteUInt8(0);
+  }
   m_snd_wnd = static_cast<uint32_t>(buf.Length());
   queue(buf.Data(), static_cast<uint32_t>(buf.Length()), true);
 }
@@ -1246,6 +1432,10 @@ void PseudoTcp::parseOptions(const char* data, uint32_t len) {
       m_swnd_scale = 0;
     }
   }
+
+  // Selective acknowledgments are only used if both sides offer them.
+  m_use_sack = m_sack_permitted &&
+               (options_specified.count(TCP_OPT_SACK_PERMITTED) > 0);
 }
 
 void PseudoTcp::applyOption(char kind, const char* data, uint32_t len) {
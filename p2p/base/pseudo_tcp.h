@@ -90,13 +90,19 @@ class RTC_EXPORT PseudoTcp {
   // instance's behaviour for the kind of data it will carry.
   // If an unrecognized option is set or got, an assertion will fire.
   //
-  // Setting options for OPT_RCVBUF or OPT_SNDBUF after Connect() is called
-  // will result in an assertion.
+  // Setting options for OPT_RCVBUF, OPT_SNDBUF or OPT_SACK after Connect() is
+  // called will result in an assertion.
+  //
+  // OPT_SACK and OPT_PACING are off by default, which keeps the wire format
+  // of older implementations. Selective acknowledgments are only used if
+  // both sides enable them.
   enum Option {
     OPT_NODELAY,   // Whether to enable Nagle's algorithm (0 == off)
     OPT_ACKDELAY,  // The Delayed ACK timeout (0 == off).
     OPT_RCVBUF,    // Set the receive buffer size, in bytes.
     OPT_SNDBUF,    // Set the send buffer size, in bytes.
+    OPT_SACK,      // Whether to offer selective acknowledgments (0 == off).
+    OPT_PACING,    // Whether to pace sends over the round trip (0 == off).
   };
   void GetOption(Option opt, int* value);
   void SetOption(Option opt, int value);
@@ -118,6 +124,14 @@ class RTC_EXPORT PseudoTcp {
  protected:
   enum SendFlags { sfNone, sfDelayedAck, sfImmediateAck };
 
+  // The most SACK blocks carried by an ACK.
+  static const uint8_t kMaxSackBlocks = 4;
+
+  // A range [left, right) of sequence numbers that the receiver holds.
+  struct SackBlock {
+    uint32_t left, right;
+  };
+
   struct Segment {
     uint32_t conv, seq, ack;
     uint8_t flags;
@@ -125,15 +139,19 @@ class RTC_EXPORT PseudoTcp {
     const char* data;
     uint32_t len;
     uint32_t tsval, tsecr;
+    uint8_t num_sack_blocks;
+    SackBlock sack_blocks[kMaxSackBlocks];
   };
 
   struct SSegment {
     SSegment(uint32_t s, uint32_t l, bool c)
-        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c) {}
+        : seq(s), len(l), /*tstamp(0),*/ xmit(0), bCtrl(c), sacked(false) {}
     uint32_t seq, len;
     // uint32_t tstamp;
     uint8_t xmit;
     bool bCtrl;
+    // Whether the receiver has selectively acknowledged the segment.
+    bool sacked;
   };
   typedef std::list<SSegment> SList;
 
@@ -166,6 +184,22 @@ class RTC_EXPORT PseudoTcp {
   bool process(Segment& seg);
   bool transmit(const SList::iterator& seg, uint32_t now);
 
+  // Marks the segments covered by the SACK blocks of |seg| as sacked.
+  void applySack(const Segment& seg);
+  // Returns the first segment below the highest SACKed sequence number that
+  // was neither SACKed nor retransmitted during this recovery, or the end of
+  // |m_slist| if there is none.
+  SList::iterator nextSackHole();
+  // Writes the SACK blocks describing |m_rlist| after the header in |buffer|,
+  // and returns the number of bytes written.
+  uint32_t writeSackBlocks(uint8_t* buffer);
+
+  // Returns the pacing rate in bytes per second.
+  uint64_t pacingRate() const;
+  // Adds the bytes that may be sent since the last refill to the pacing
+  // budget.
+  void refillPacingBudget(uint32_t now);
+
   void adjustMTU();
 
  protected:
@@ -236,6 +270,15 @@ class RTC_EXPORT PseudoTcp {
   uint32_t m_recover;
   uint32_t m_t_ack;
 
+  // Selective acknowledgments
+  bool m_sack_permitted, m_use_sack;
+  uint32_t m_sack_high, m_sack_rexmit_nxt;
+
+  // Pacing
+  bool m_use_pacing, m_pacing_deferred;
+  int64_t m_pacing_budget;
+  uint32_t m_pacing_last;
+
   // Configuration options
   bool m_use_nagling;
   uint32_t m_ack_delay;
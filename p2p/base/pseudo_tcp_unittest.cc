@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "rtc_base/gunit.h"
@@ -33,6 +34,8 @@ using cricket::PseudoTcp;
 static const int kConnectTimeoutMs = 10000;  // ~3 * default RTO of 3000ms
 static const int kTransferTimeoutMs = 15000;
 static const int kBlockSize = 4096;
+// The header flag of ACKs with SACK blocks.
+static const uint8_t kFlagSack = 0x08;
 
 class PseudoTcpForTest : public cricket::PseudoTcp {
  public:
@@ -102,6 +105,21 @@ class PseudoTcpTestBase : public ::testing::Test,
   }
   void DisableRemoteWindowScale() { remote_.disableWindowScale(); }
   void DisableLocalWindowScale() { local_.disableWindowScale(); }
+  void SetLocalOptSack(bool enable) {
+    local_.SetOption(PseudoTcp::OPT_SACK, enable);
+  }
+  void SetRemoteOptSack(bool enable) {
+    remote_.SetOption(PseudoTcp::OPT_SACK, enable);
+  }
+  void SetOptSack(bool enable) {
+    SetLocalOptSack(enable);
+    SetRemoteOptSack(enable);
+  }
+  void SetOptPacing(bool enable) {
+    local_.SetOption(PseudoTcp::OPT_PACING, enable);
+    remote_.SetOption(PseudoTcp::OPT_PACING, enable);
+  }
+  int num_sack_packets() const { return num_sack_packets_; }
 
  protected:
   int Connect() {
@@ -156,6 +174,9 @@ class PseudoTcpTestBase : public ::testing::Test,
   virtual WriteResult TcpWritePacket(PseudoTcp* tcp,
                                      const char* buffer,
                                      size_t len) {
+    if (len > 13 && (buffer[13] & kFlagSack)) {
+      ++num_sack_packets_;
+    }
     // Drop a packet if the test called DropNextPacket.
     if (drop_next_packet_) {
       drop_next_packet_ = false;
@@ -231,6 +252,7 @@ class PseudoTcpTestBase : public ::testing::Test,
   int loss_;
   bool drop_next_packet_ = false;
   bool simultaneous_open_ = false;
+  int num_sack_packets_ = 0;
 };
 
 class PseudoTcpTest : public PseudoTcpTestBase {
@@ -766,6 +788,107 @@ TEST_F(PseudoTcpTest, TestSendVerySmallReceiveBuffer) {
   TestTransfer(100000);
 }
 
+// Test sending data with packet loss when both sides use SACK.
+TEST_F(PseudoTcpTest, TestSendWithLossAndSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  SetOptSack(true);
+  TestTransfer(100000);
+  EXPECT_GT(num_sack_packets(), 0);
+}
+
+// Test sending data with a 50 ms RTT and 10% packet loss when both sides use
+// SACK.
+TEST_F(PseudoTcpTest, TestSendWithDelayAndLossAndSack) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(10);
+  SetOptSack(true);
+  TestTransfer(100000);
+  EXPECT_GT(num_sack_packets(), 0);
+}
+
+// Test that SACK isn't used, and the wire format is unchanged, when only one
+// side offers it.
+TEST_F(PseudoTcpTest, TestSendWithLossAndSackOnlyLocal) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  SetLocalOptSack(true);
+  TestTransfer(100000);
+  EXPECT_EQ(0, num_sack_packets());
+}
+
+TEST_F(PseudoTcpTest, TestSendWithLossAndSackOnlyRemote) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(10);
+  SetRemoteOptSack(true);
+  TestTransfer(100000);
+  EXPECT_EQ(0, num_sack_packets());
+}
+
+// Test sending data with a 50 ms RTT and pacing.
+TEST_F(PseudoTcpTest, TestSendWithDelayAndPacing) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetOptPacing(true);
+  TestTransfer(1000000);
+}
+
+// Test sending data with large windows, SACK and pacing, over a 50 ms RTT
+// with packet loss.
+TEST_F(PseudoTcpTest, TestSendWithDelayAndLossInThroughputMode) {
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetDelay(50);
+  SetLoss(5);
+  SetRemoteOptRcvBuf(1000000);
+  SetLocalOptRcvBuf(1000000);
+  SetOptSndBuf(1000000);
+  SetOptSack(true);
+  SetOptPacing(true);
+  TestTransfer(1000000);
+}
+
+// Measures the throughput of a transfer at the given loss (in percent) and
+// one way delay (in ms), with the default options or with large windows, SACK
+// and pacing. Run with --gtest_also_run_disabled_tests to get the throughput
+// logged.
+class PseudoTcpThroughputPerfTest
+    : public PseudoTcpTest,
+      public ::testing::WithParamInterface<std::tuple<int, int, bool>> {};
+
+INSTANTIATE_TEST_SUITE_P(
+    LossDelayThroughputMode,
+    PseudoTcpThroughputPerfTest,
+    ::testing::Combine(::testing::Values(0, 1, 5),
+                       ::testing::Values(10, 50),
+                       ::testing::Bool()));
+
+TEST_P(PseudoTcpThroughputPerfTest, DISABLED_TransferPerf) {
+  int loss = std::get<0>(GetParam());
+  int delay = std::get<1>(GetParam());
+  bool throughput_mode = std::get<2>(GetParam());
+  SetLocalMtu(1500);
+  SetRemoteMtu(1500);
+  SetLoss(loss);
+  SetDelay(delay);
+  if (throughput_mode) {
+    SetRemoteOptRcvBuf(1000000);
+    SetLocalOptRcvBuf(1000000);
+    SetOptSndBuf(1000000);
+    SetOptSack(true);
+    SetOptPacing(true);
+  }
+  RTC_LOG(LS_INFO) << (throughput_mode ? "Throughput mode" : "Default")
+                   << ", loss " << loss << "%, delay " << delay << " ms:";
+  TestTransfer(1000000);
+}
+
 // Ping-pong (request/response) tests
 
 // Test sending <= 1x MTU of data in each ping/pong.  Should take <10ms.
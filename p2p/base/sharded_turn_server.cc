@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/location.h"
+#include "rtc_base/logging.h"
+
+namespace cricket {
+
+namespace {
+const size_t kNonceKeySize = 16;
+const int kListenBacklog = 128;
+}  // namespace
+
+ShardedTurnServer::ShardedTurnServer() = default;
+
+ShardedTurnServer::~ShardedTurnServer() {
+  Stop();
+}
+
+bool ShardedTurnServer::Start(const Config& config) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  RTC_DCHECK(shards_.empty());
+  RTC_DCHECK_GT(config.num_shards, 0);
+  RTC_DCHECK(config.protocol == PROTO_UDP || config.protocol == PROTO_TCP);
+  const std::string nonce_key = rtc::CreateRandomString(kNonceKeySize);
+  rtc::SocketAddress address = config.internal_address;
+  for (int i = 0; i < config.num_shards; ++i) {
+    auto shard = std::make_unique<Shard>();
+    shard->thread = rtc::Thread::CreateWithSocketServer();
+    shard->thread->SetName("TurnShard", shard.get());
+    shard->thread->Start();
+    Shard* shard_ptr = shard.get();
+    shards_.push_back(std::move(shard));
+    bool started = shard_ptr->thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      return StartShard(shard_ptr, config, nonce_key, &address);
+    });
+    if (!started) {
+      RTC_LOG(LS_ERROR) << "Failed to start TURN shard " << i << " on "
+                        << address.ToString();
+      Stop();
+      return false;
+    }
+  }
+  internal_address_ = address;
+  RTC_LOG(LS_INFO) << "Started " << shards_.size() << " TURN shards on "
+                   << internal_address_.ToString();
+  return true;
+}
+
+void ShardedTurnServer::Stop() {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  for (auto& shard : shards_) {
+    // The server and its sockets must be destroyed on the shard thread.
+    shard->thread->Invoke<void>(RTC_FROM_HERE,
+                                [&shard] { shard->server.reset(); });
+    shard->thread->Stop();
+  }
+  shards_.clear();
+  internal_address_.Clear();
+}
+
+int ShardedTurnServer::num_shards() const {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  return static_cast<int>(shards_.size());
+}
+
+const rtc::SocketAddress& ShardedTurnServer::internal_address() const {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  return internal_address_;
+}
+
+size_t ShardedTurnServer::NumAllocations() {
+  size_t num_allocations = 0;
+  ForEachShard([&num_allocations](TurnServer* server) {
+    num_allocations += server->allocations().size();
+  });
+  return num_allocations;
+}
+
+void ShardedTurnServer::ForEachShard(
+    const std::function<void(TurnServer*)>& callback) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  for (auto& shard : shards_) {
+    shard->thread->Invoke<void>(RTC_FROM_HERE,
+                                [&] { callback(shard->server.get()); });
+  }
+}
+
+bool ShardedTurnServer::StartShard(Shard* shard,
+                                   const Config& config,
+                                   const std::string& nonce_key,
+                                   rtc::SocketAddress* address) {
+  RTC_DCHECK(shard->thread->IsCurrent());
+  int type = config.protocol == PROTO_UDP ? SOCK_DGRAM : SOCK_STREAM;
+  std::unique_ptr<rtc::AsyncSocket> socket(
+      shard->thread->socketserver()->CreateAsyncSocket(address->family(),
+                                                       type));
+  if (!socket || socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0 ||
+      socket->Bind(*address) != 0) {
+    return false;
+  }
+  if (config.protocol == PROTO_TCP && socket->Listen(kListenBacklog) != 0)
+    return false;
+  *address = socket->GetLocalAddress();
+
+  shard->server = std::make_unique<TurnServer>(shard->thread.get());
+  TurnServer* server = shard->server.get();
+  server->set_realm(config.realm);
+  server->set_software(config.software);
+  server->set_auth_hook(config.auth_hook);
+  server->set_nonce_key(nonce_key);
+  if (config.protocol == PROTO_UDP) {
+    server->AddInternalSocket(new rtc::AsyncUDPSocket(socket.release()),
+                              PROTO_UDP);
+  } else {
+    server->AddInternalServerSocket(socket.release(), PROTO_TCP);
+  }
+  server->SetExternalSocketFactory(
+      new rtc::BasicPacketSocketFactory(shard->thread.get()),
+      rtc::SocketAddress(config.external_ip, 0));
+  return true;
+}
+
+}  // namespace cricket
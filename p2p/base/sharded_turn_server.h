@@ -0,0 +1,97 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARDED_TURN_SERVER_H_
+#define P2P_BASE_SHARDED_TURN_SERVER_H_
+
+#include <stddef.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "p2p/base/port.h"
+#include "p2p/base/turn_server.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_checker.h"
+
+namespace cricket {
+
+// Runs a TurnServer on each of a number of threads, the shards, to relay more
+// traffic than one thread can. Every shard listens on the same internal
+// address with its own SO_REUSEPORT socket, so the kernel spreads the clients
+// across the shards by hashing their addresses, and all packets of a client
+// reach the same shard. A shard owns the allocations of its clients, and
+// relays their packets on its own thread without locking.
+//
+// The auth hook is called on all shard threads and must be thread safe. The
+// shards share the nonce key, so a nonce is valid on all of them.
+//
+// Needs SO_REUSEPORT to run more than one shard, i.e. Linux or BSD.
+class ShardedTurnServer {
+ public:
+  struct Config {
+    int num_shards = 1;
+    // With port 0, the first shard picks a port for all of them.
+    rtc::SocketAddress internal_address;
+    ProtocolType protocol = PROTO_UDP;
+    // Relayed addresses are allocated on this IP.
+    rtc::IPAddress external_ip;
+    std::string realm;
+    std::string software;
+    // Not owned, must outlive the server.
+    TurnAuthInterface* auth_hook = nullptr;
+  };
+
+  ShardedTurnServer();
+  ShardedTurnServer(const ShardedTurnServer&) = delete;
+  ShardedTurnServer& operator=(const ShardedTurnServer&) = delete;
+  ~ShardedTurnServer();
+
+  // Starts the shards. Returns false, with no shard running, if any of the
+  // shards couldn't listen on the internal address.
+  bool Start(const Config& config);
+  // Stops the shards and destroys their allocations.
+  void Stop();
+
+  int num_shards() const;
+  // The address all shards listen on.
+  const rtc::SocketAddress& internal_address() const;
+  // Sums the allocations of all shards.
+  size_t NumAllocations();
+
+  // Runs |callback| for each shard, on the shard's thread, e.g. to change
+  // settings that Config doesn't cover. Blocks until all calls are done.
+  void ForEachShard(const std::function<void(TurnServer*)>& callback);
+
+ private:
+  struct Shard {
+    std::unique_ptr<rtc::Thread> thread;
+    std::unique_ptr<TurnServer> server;
+  };
+
+  // Runs on the thread of |shard|. On success, updates |address| to the
+  // address the shard listens on.
+  static bool StartShard(Shard* shard,
+                         const Config& config,
+                         const std::string& nonce_key,
+                         rtc::SocketAddress* address);
+
+  rtc::ThreadChecker thread_checker_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  rtc::SocketAddress internal_address_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARDED_TURN_SERVER_H_
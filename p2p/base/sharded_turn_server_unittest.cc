@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "p2p/base/stun.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "test/gtest.h"
+
+namespace cricket {
+
+// Sharing a port needs SO_REUSEPORT.
+#if defined(WEBRTC_LINUX)
+
+namespace {
+const int kTimeoutMs = 5000;
+const int kNumShards = 4;
+}  // namespace
+
+class ShardedTurnServerTest : public ::testing::Test,
+                              public sigslot::has_slots<> {
+ public:
+  ShardedTurnServerTest() : thread_(&ss_) {
+    config_.num_shards = kNumShards;
+    config_.internal_address = rtc::SocketAddress("127.0.0.1", 0);
+    config_.external_ip = rtc::IPAddress(INADDR_LOOPBACK);
+    config_.realm = "realm";
+  }
+
+  std::unique_ptr<rtc::AsyncUDPSocket> CreateClient() {
+    std::unique_ptr<rtc::AsyncUDPSocket> client(rtc::AsyncUDPSocket::Create(
+        &ss_, rtc::SocketAddress("127.0.0.1", 0)));
+    client->SignalReadPacket.connect(this,
+                                     &ShardedTurnServerTest::OnReadPacket);
+    return client;
+  }
+
+  void SendBindingRequest(rtc::AsyncUDPSocket* client) {
+    StunMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    client->SendTo(buf.Data(), buf.Length(), server_.internal_address(),
+                   rtc::PacketOptions());
+  }
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    StunMessage response;
+    rtc::ByteBufferReader buf(data, size);
+    if (!response.Read(&buf) || response.type() != STUN_BINDING_RESPONSE)
+      return;
+    const StunAddressAttribute* mapped_address =
+        response.GetAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+    if (mapped_address)
+      mapped_addresses_[socket] = mapped_address->GetAddress();
+  }
+
+ protected:
+  rtc::PhysicalSocketServer ss_;
+  rtc::AutoSocketServerThread thread_;
+  ShardedTurnServer::Config config_;
+  ShardedTurnServer server_;
+  std::map<rtc::AsyncPacketSocket*, rtc::SocketAddress> mapped_addresses_;
+};
+
+TEST_F(ShardedTurnServerTest, ShardsAnswerOnSharedAddress) {
+  ASSERT_TRUE(server_.Start(config_));
+  EXPECT_EQ(kNumShards, server_.num_shards());
+  EXPECT_NE(0, server_.internal_address().port());
+
+  const size_t kNumClients = 16;
+  std::vector<std::unique_ptr<rtc::AsyncUDPSocket>> clients;
+  for (size_t i = 0; i < kNumClients; ++i) {
+    clients.push_back(CreateClient());
+    SendBindingRequest(clients.back().get());
+  }
+  EXPECT_EQ_WAIT(kNumClients, mapped_addresses_.size(), kTimeoutMs);
+  for (const auto& client : clients)
+    EXPECT_EQ(client->GetLocalAddress(), mapped_addresses_[client.get()]);
+  EXPECT_EQ(0u, server_.NumAllocations());
+}
+
+TEST_F(ShardedTurnServerTest, RunsEachShardOnItsOwnThread) {
+  ASSERT_TRUE(server_.Start(config_));
+  std::set<rtc::Thread*> threads;
+  server_.ForEachShard([&threads](TurnServer* server) {
+    threads.insert(rtc::Thread::Current());
+    EXPECT_EQ("realm", server->realm());
+  });
+  EXPECT_EQ(static_cast<size_t>(kNumShards), threads.size());
+  EXPECT_EQ(0u, threads.count(&thread_));
+}
+
+TEST_F(ShardedTurnServerTest, FailsToStartOnPortInUse) {
+  // A socket without SO_REUSEPORT keeps the shards from sharing its port.
+  std::unique_ptr<rtc::AsyncUDPSocket> blocker = CreateClient();
+  config_.internal_address = blocker->GetLocalAddress();
+  EXPECT_FALSE(server_.Start(config_));
+  EXPECT_EQ(0, server_.num_shards());
+}
+
+#endif  // defined(WEBRTC_LINUX)
+
+}  // namespace cricket
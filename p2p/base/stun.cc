@@ -182,6 +182,15 @@ const StunUInt16ListAttribute* StunMessage::GetUnknownAttributes() const {
 bool StunMessage::ValidateMessageIntegrity(const char* data,
                                            size_t size,
                                            const std::string& password) {
+  std::unique_ptr<rtc::MessageDigest> hmac(
+      rtc::MessageDigestFactory::CreateHmac(rtc::DIGEST_SHA_1, password.c_str(),
+                                            password.size()));
+  return ValidateMessageIntegrity(data, size, hmac.get());
+}
+
+bool StunMessage::ValidateMessageIntegrity(const char* data,
+                                           size_t size,
+                                           rtc::MessageDigest* hmac) {
   // Verifying the size of the message.
   if ((size % 4) != 0 || size < kStunHeaderSize) {
     return false;
@@ -226,8 +235,6 @@ bool StunMessage::ValidateMessageIntegrity(const char* data,
 
   // Getting length of the message to calculate Message Integrity.
   size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
   if (size > mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize) {
     // Stun message has other attributes after message integrity.
     // Adjust the length parameter in stun message to calculate HMAC.
@@ -235,26 +242,31 @@ bool StunMessage::ValidateMessageIntegrity(const char* data,
         size - (mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize);
     size_t new_adjusted_len = size - extra_offset - kStunHeaderSize;
 
-    // Writing new length of the STUN message @ Message Length in temp buffer.
+    // Hashing the header with the new length @ Message Length.
     //      0                   1                   2                   3
     //      0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
     //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
     //     |0 0|     STUN Message Type     |         Message Length        |
     //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
+    char type_and_length[4];
+    memcpy(type_and_length, data, 2);
+    rtc::SetBE16(type_and_length + 2, static_cast<uint16_t>(new_adjusted_len));
+    hmac->Update(type_and_length, sizeof(type_and_length));
+    hmac->Update(data + sizeof(type_and_length),
+                 mi_pos - sizeof(type_and_length));
+  } else {
+    hmac->Update(data, mi_pos);
   }
 
-  char hmac[kStunMessageIntegritySize];
-  size_t ret =
-      rtc::ComputeHmac(rtc::DIGEST_SHA_1, password.c_str(), password.size(),
-                       temp_data.get(), mi_pos, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac))
+  char computed_hmac[kStunMessageIntegritySize];
+  size_t ret = hmac->Finish(computed_hmac, sizeof(computed_hmac));
+  RTC_DCHECK(ret == sizeof(computed_hmac));
+  if (ret != sizeof(computed_hmac))
     return false;
 
   // Comparing the calculated HMAC with the one present in the message.
-  return memcmp(data + current_pos + kStunAttributeHeaderSize, hmac,
-                sizeof(hmac)) == 0;
+  return memcmp(data + current_pos + kStunAttributeHeaderSize, computed_hmac,
+                sizeof(computed_hmac)) == 0;
 }
 
 bool StunMessage::AddMessageIntegrity(const std::string& password) {
@@ -262,6 +274,12 @@ bool StunMessage::AddMessageIntegrity(const std::string& password) {
 }
 
 bool StunMessage::AddMessageIntegrity(const char* key, size_t keylen) {
+  std::unique_ptr<rtc::MessageDigest> hmac(
+      rtc::MessageDigestFactory::CreateHmac(rtc::DIGEST_SHA_1, key, keylen));
+  return AddMessageIntegrity(hmac.get());
+}
+
+bool StunMessage::AddMessageIntegrity(rtc::MessageDigest* hmac) {
   // Add the attribute with a dummy value. Since this is a known attribute, it
   // can't fail.
   auto msg_integrity_attr_ptr = std::make_unique<StunByteStringAttribute>(
@@ -276,18 +294,18 @@ bool StunMessage::AddMessageIntegrity(const char* key, size_t keylen) {
 
   int msg_len_for_hmac = static_cast<int>(
       buf.Length() - kStunAttributeHeaderSize - msg_integrity_attr->length());
-  char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1, key, keylen, buf.Data(),
-                                msg_len_for_hmac, hmac, sizeof(hmac));
-  RTC_DCHECK(ret == sizeof(hmac));
-  if (ret != sizeof(hmac)) {
+  char computed_hmac[kStunMessageIntegritySize];
+  size_t ret = rtc::ComputeDigest(hmac, buf.Data(), msg_len_for_hmac,
+                                  computed_hmac, sizeof(computed_hmac));
+  RTC_DCHECK(ret == sizeof(computed_hmac));
+  if (ret != sizeof(computed_hmac)) {
     RTC_LOG(LS_ERROR) << "HMAC computation failed. Message-Integrity "
                          "has dummy value.";
     return false;
   }
 
   // Insert correct HMAC into the attribute.
-  msg_integrity_attr->CopyBytes(hmac, sizeof(hmac));
+  msg_integrity_attr->CopyBytes(computed_hmac, sizeof(computed_hmac));
   return true;
 }
 
@@ -343,6 +361,19 @@ bool StunMessage::AddFingerprint() {
   return true;
 }
 
+StunPasswordHmac::StunPasswordHmac() = default;
+
+StunPasswordHmac::~StunPasswordHmac() = default;
+
+rtc::MessageDigest* StunPasswordHmac::Get(const std::string& password) {
+  if (!hmac_ || password != password_) {
+    password_ = password;
+    hmac_.reset(rtc::MessageDigestFactory::CreateHmac(
+        rtc::DIGEST_SHA_1, password.c_str(), password.size()));
+  }
+  return hmac_.get();
+}
+
 bool StunMessage::Read(ByteBufferReader* buf) {
   if (!buf->ReadUInt16(&type_))
     return false;
@@ -23,6 +23,7 @@
 
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/ip_address.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/socket_address.h"
 
 namespace cricket {
@@ -179,9 +180,15 @@ class StunMessage {
   static bool ValidateMessageIntegrity(const char* data,
                                        size_t size,
                                        const std::string& password);
+  // Like the previous function, but with an HMAC-SHA1 that is keyed with the
+  // password already (see StunPasswordHmac).
+  static bool ValidateMessageIntegrity(const char* data,
+                                       size_t size,
+                                       rtc::MessageDigest* hmac);
   // Adds a MESSAGE-INTEGRITY attribute that is valid for the current message.
   bool AddMessageIntegrity(const std::string& password);
   bool AddMessageIntegrity(const char* key, size_t keylen);
+  bool AddMessageIntegrity(rtc::MessageDigest* hmac);
 
   // Verifies that a given buffer is STUN by checking for a correct FINGERPRINT.
   static bool ValidateFingerprint(const char* data, size_t size);
@@ -221,6 +228,22 @@ class StunMessage {
   uint32_t stun_magic_cookie_;
 };
 
+// Keeps an HMAC-SHA1 keyed with a STUN password, so that connectivity checks
+// with the same password don't set up the key for each message.
+class StunPasswordHmac {
+ public:
+  StunPasswordHmac();
+  ~StunPasswordHmac();
+
+  // Returns the HMAC for |password|, keying it again if the password changed
+  // since the previous call.
+  rtc::MessageDigest* Get(const std::string& password);
+
+ private:
+  std::string password_;
+  std::unique_ptr<rtc::MessageDigest> hmac_;
+};
+
 // Base class for all STUN/TURN attributes.
 class StunAttribute {
  public:
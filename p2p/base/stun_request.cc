@@ -46,7 +46,8 @@ namespace {
 const char kRfc5389StunRetransmissions[] = "WebRTC-Rfc5389StunRetransmissions";
 }  // namespace
 
-StunRequestManager::StunRequestManager(rtc::Thread* thread) : thread_(thread) {}
+StunRequestManager::StunRequestManager(rtc::Thread* thread)
+    : thread_(thread), timers_(StunTimerWheel::ForThread(thread)) {}
 
 StunRequestManager::~StunRequestManager() {
   while (requests_.begin() != requests_.end()) {
@@ -67,7 +68,7 @@ void StunRequestManager::SendDelayed(StunRequest* request, int delay) {
   request->Construct();
   requests_[request->id()] = request;
   if (delay > 0) {
-    thread_->PostDelayed(RTC_FROM_HERE, delay, request, MSG_STUN_SEND, NULL);
+    timers_->Schedule(&request->timer_, delay);
   } else {
     thread_->Send(RTC_FROM_HERE, request, MSG_STUN_SEND, NULL);
   }
@@ -77,7 +78,7 @@ void StunRequestManager::Flush(int msg_type) {
   for (const auto& kv : requests_) {
     StunRequest* request = kv.second;
     if (msg_type == kAllRequests || msg_type == request->type()) {
-      thread_->Clear(request, MSG_STUN_SEND);
+      timers_->Cancel(&request->timer_);
       thread_->Send(RTC_FROM_HERE, request, MSG_STUN_SEND, NULL);
     }
   }
@@ -99,7 +100,7 @@ void StunRequestManager::Remove(StunRequest* request) {
   if (iter != requests_.end()) {
     RTC_DCHECK(iter->second == request);
     requests_.erase(iter);
-    thread_->Clear(request);
+    timers_->Cancel(&request->timer_);
   }
 }
 
@@ -176,7 +177,8 @@ StunRequest::StunRequest()
       msg_(new StunMessage()),
       tstamp_(0),
       in_rfc5389_retransmission_experiment_(
-          webrtc::field_trial::IsEnabled(kRfc5389StunRetransmissions)) {
+          webrtc::field_trial::IsEnabled(kRfc5389StunRetransmissions)),
+      timer_([this] { SendAndScheduleResend(); }) {
   msg_->SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
 }
 
@@ -187,7 +189,8 @@ StunRequest::StunRequest(StunMessage* request)
       msg_(request),
       tstamp_(0),
       in_rfc5389_retransmission_experiment_(
-          webrtc::field_trial::IsEnabled(kRfc5389StunRetransmissions)) {
+          webrtc::field_trial::IsEnabled(kRfc5389StunRetransmissions)),
+      timer_([this] { SendAndScheduleResend(); }) {
   msg_->SetTransactionID(rtc::CreateRandomString(kStunTransactionIdLength));
 }
 
@@ -196,6 +199,7 @@ StunRequest::~StunRequest() {
   if (manager_) {
     manager_->Remove(this);
     manager_->thread_->Clear(this);
+    manager_->timers_->Cancel(&timer_);
   }
   delete msg_;
 }
@@ -234,8 +238,12 @@ void StunRequest::set_manager(StunRequestManager* manager) {
 }
 
 void StunRequest::OnMessage(rtc::Message* pmsg) {
-  RTC_DCHECK(manager_ != NULL);
   RTC_DCHECK(pmsg->message_id == MSG_STUN_SEND);
+  SendAndScheduleResend();
+}
+
+void StunRequest::SendAndScheduleResend() {
+  RTC_DCHECK(manager_ != NULL);
 
   if (timeout_) {
     OnTimeout();
@@ -250,8 +258,7 @@ void StunRequest::OnMessage(rtc::Message* pmsg) {
   manager_->SignalSendPacket(buf.Data(), buf.Length(), this);
 
   OnSent();
-  manager_->thread_->PostDelayed(RTC_FROM_HERE, resend_delay(), this,
-                                 MSG_STUN_SEND, NULL);
+  manager_->timers_->Schedule(&timer_, resend_delay());
 }
 
 void StunRequest::OnSent() {
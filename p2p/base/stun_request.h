@@ -17,7 +17,9 @@
 #include <map>
 #include <string>
 
+#include "api/scoped_refptr.h"
 #include "p2p/base/stun.h"
+#include "p2p/base/stun_timer_wheel.h"
 #include "rtc_base/message_handler.h"
 #include "rtc_base/message_queue.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -78,6 +80,8 @@ class StunRequestManager {
   typedef std::map<std::string, StunRequest*> RequestMap;
 
   rtc::Thread* thread_;
+  // Shared with the other managers on |thread_|.
+  rtc::scoped_refptr<StunTimerWheel> timers_;
   RequestMap requests_;
   std::string origin_;
 
@@ -145,11 +149,15 @@ class StunRequest : public rtc::MessageHandler {
 
   // Handles messages for sending and timeout.
   void OnMessage(rtc::Message* pmsg) override;
+  // Sends the request, or times it out, and schedules the next resend.
+  void SendAndScheduleResend();
 
   StunRequestManager* manager_;
   StunMessage* msg_;
   int64_t tstamp_;
   bool in_rfc5389_retransmission_experiment_;
+  // Resends are scheduled on the timer wheel of the manager.
+  StunTimerWheel::Timer timer_;
 
   friend class StunRequestManager;
 };
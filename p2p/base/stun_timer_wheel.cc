@@ -0,0 +1,211 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/stun_timer_wheel.h"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/location.h"
+#include "rtc_base/time_utils.h"
+
+namespace cricket {
+
+namespace {
+const uint32_t MSG_TIMER_WHEEL_WAKEUP = 1;
+
+rtc::GlobalLockPod g_wheels_lock;
+std::map<rtc::Thread*, StunTimerWheel*>* g_wheels = nullptr;
+}  // namespace
+
+StunTimerWheel::Timer::Timer(std::function<void()> callback)
+    : callback_(std::move(callback)) {}
+
+StunTimerWheel::Timer::~Timer() {
+  if (wheel_)
+    wheel_->Cancel(this);
+}
+
+rtc::scoped_refptr<StunTimerWheel> StunTimerWheel::ForThread(
+    rtc::Thread* thread) {
+  RTC_DCHECK(thread);
+  rtc::GlobalLockScope gls(&g_wheels_lock);
+  if (!g_wheels)
+    g_wheels = new std::map<rtc::Thread*, StunTimerWheel*>();
+  StunTimerWheel*& wheel = (*g_wheels)[thread];
+  if (!wheel)
+    wheel = new StunTimerWheel(thread);
+  // Taking the reference while holding the lock keeps Release() on another
+  // thread from destroying the wheel in between.
+  return wheel;
+}
+
+StunTimerWheel::StunTimerWheel(rtc::Thread* thread) : thread_(thread) {}
+
+StunTimerWheel::~StunTimerWheel() {
+  RTC_DCHECK_EQ(0u, size_);
+}
+
+void StunTimerWheel::AddRef() const {
+  ref_count_.IncRef();
+}
+
+rtc::RefCountReleaseStatus StunTimerWheel::Release() const {
+  {
+    rtc::GlobalLockScope gls(&g_wheels_lock);
+    if (ref_count_.DecRef() == rtc::RefCountReleaseStatus::kOtherRefsRemained)
+      return rtc::RefCountReleaseStatus::kOtherRefsRemained;
+    g_wheels->erase(thread_);
+  }
+  delete this;
+  return rtc::RefCountReleaseStatus::kDroppedLastRef;
+}
+
+void StunTimerWheel::Schedule(Timer* timer, int delay_ms) {
+  RTC_DCHECK(thread_->IsCurrent());
+  RTC_DCHECK_GE(delay_ms, 0);
+  RTC_DCHECK(!timer->wheel_ || timer->wheel_ == this);
+  if (timer->wheel_)
+    Unlink(timer);
+
+  int64_t now_ms = rtc::TimeMillis();
+  if (size_ == 0 && !firing_)
+    next_tick_ = TickOf(now_ms);
+  timer->wheel_ = this;
+  timer->due_ms_ = now_ms + delay_ms;
+  timer->next_ = nullptr;
+  // The head of a slot links back to its tail, to append in constant time.
+  Timer** head = SlotForTick(TickOf(timer->due_ms_));
+  if (*head) {
+    Timer* tail = (*head)->prev_;
+    tail->next_ = timer;
+    timer->prev_ = tail;
+    (*head)->prev_ = timer;
+  } else {
+    *head = timer;
+    timer->prev_ = timer;
+  }
+  ++size_;
+
+  // The posted message is never later than the earliest timer, so only a
+  // new earliest timer needs a new message.
+  if (!firing_ && (!wakeup_ms_ || timer->due_ms_ < *wakeup_ms_)) {
+    if (wakeup_ms_)
+      thread_->Clear(this, MSG_TIMER_WHEEL_WAKEUP);
+    wakeup_ms_ = timer->due_ms_;
+    thread_->PostDelayed(RTC_FROM_HERE, delay_ms, this,
+                         MSG_TIMER_WHEEL_WAKEUP);
+  }
+}
+
+void StunTimerWheel::Cancel(Timer* timer) {
+  RTC_DCHECK(thread_->IsCurrent());
+  if (timer->wheel_ != this)
+    return;
+  // The posted message is left as is; waking up with nothing to do is cheaper
+  // than finding the next timer.
+  Unlink(timer);
+}
+
+void StunTimerWheel::Unlink(Timer* timer) {
+  Timer** head = SlotForTick(TickOf(timer->due_ms_));
+  if (timer == *head) {
+    *head = timer->next_;
+    if (*head)
+      (*head)->prev_ = timer->prev_;
+  } else {
+    timer->prev_->next_ = timer->next_;
+    if (timer->next_) {
+      timer->next_->prev_ = timer->prev_;
+    } else {
+      (*head)->prev_ = timer->prev_;
+    }
+  }
+  timer->wheel_ = nullptr;
+  timer->prev_ = nullptr;
+  timer->next_ = nullptr;
+  --size_;
+}
+
+void StunTimerWheel::OnMessage(rtc::Message* msg) {
+  RTC_DCHECK(msg->message_id == MSG_TIMER_WHEEL_WAKEUP);
+  // A callback may drop the last reference to the wheel, e.g. by destroying
+  // the last port on the thread.
+  rtc::scoped_refptr<StunTimerWheel> self(this);
+  wakeup_ms_.reset();
+  int64_t now_ms = rtc::TimeMillis();
+  FireExpired(now_ms);
+  UpdateWakeup(now_ms);
+}
+
+void StunTimerWheel::FireExpired(int64_t now_ms) {
+  firing_ = true;
+  int64_t now_tick = TickOf(now_ms);
+  // The wheel wakes up at least once per turn, so this visits each slot at
+  // most once, unless the clock jumps.
+  for (int64_t tick = next_tick_; tick <= now_tick && size_ > 0; ++tick) {
+    Timer** head = SlotForTick(tick);
+    while (true) {
+      // The list is searched again after each callback, which may cancel or
+      // schedule any timer. Timers of later turns of the wheel are skipped.
+      Timer* earliest = nullptr;
+      for (Timer* timer = *head; timer; timer = timer->next_) {
+        if (timer->due_ms_ <= now_ms && TickOf(timer->due_ms_) <= tick &&
+            (!earliest || timer->due_ms_ < earliest->due_ms_)) {
+          earliest = timer;
+        }
+      }
+      if (!earliest)
+        break;
+      Unlink(earliest);
+      earliest->callback_();
+    }
+  }
+  next_tick_ = now_tick;
+  firing_ = false;
+}
+
+absl::optional<int64_t> StunTimerWheel::FindNextDueTime() const {
+  if (size_ == 0)
+    return absl::nullopt;
+  for (size_t i = 0; i < kNumSlots; ++i) {
+    int64_t tick = next_tick_ + static_cast<int64_t>(i);
+    absl::optional<int64_t> due_ms;
+    for (const Timer* timer = *SlotForTick(tick); timer;
+         timer = timer->next_) {
+      if (TickOf(timer->due_ms_) <= tick &&
+          (!due_ms || timer->due_ms_ < *due_ms)) {
+        due_ms = timer->due_ms_;
+      }
+    }
+    if (due_ms)
+      return due_ms;
+  }
+  // All timers are more than a turn away. Waking up after a turn is cheaper
+  // than keeping them sorted.
+  return (next_tick_ + static_cast<int64_t>(kNumSlots)) * kTickMs;
+}
+
+void StunTimerWheel::UpdateWakeup(int64_t now_ms) {
+  absl::optional<int64_t> due_ms = FindNextDueTime();
+  if (!due_ms || (wakeup_ms_ && *wakeup_ms_ <= *due_ms))
+    return;
+  if (wakeup_ms_)
+    thread_->Clear(this, MSG_TIMER_WHEEL_WAKEUP);
+  wakeup_ms_ = std::max(*due_ms, now_ms);
+  thread_->PostDelayed(RTC_FROM_HERE,
+                       static_cast<int>(*wakeup_ms_ - now_ms), this,
+                       MSG_TIMER_WHEEL_WAKEUP);
+}
+
+}  // namespace cricket
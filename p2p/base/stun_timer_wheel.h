@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_STUN_TIMER_WHEEL_H_
+#define P2P_BASE_STUN_TIMER_WHEEL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <functional>
+
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
+#include "rtc_base/message_handler.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counter.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+
+// A hashed timer wheel shared by all STUN request managers on a thread, so
+// that the retransmits, keepalives and TURN refreshes of thousands of ports
+// don't each post a delayed message to the thread. Timers are kept in
+// intrusive lists, one per slot of |kTickMs|, and the wheel posts a single
+// message for the earliest of them. Timers still fire at the exact time they
+// were scheduled for; timers due at the same time fire in the order they were
+// scheduled.
+//
+// The wheel of a thread is created by the first ForThread() call for it, and
+// destroyed when the last reference to it goes away. Apart from that, it must
+// only be used on its thread.
+class StunTimerWheel : public rtc::MessageHandler {
+ public:
+  // A timer that can be scheduled on a wheel. The owner must outlive the
+  // callback, or Cancel() the timer before it is destroyed; destroying a
+  // scheduled timer cancels it.
+  class Timer {
+   public:
+    explicit Timer(std::function<void()> callback);
+    Timer(const Timer&) = delete;
+    Timer& operator=(const Timer&) = delete;
+    ~Timer();
+
+    bool scheduled() const { return wheel_ != nullptr; }
+    // Time the timer fires at, if scheduled.
+    int64_t due_ms() const { return due_ms_; }
+
+   private:
+    friend class StunTimerWheel;
+
+    std::function<void()> callback_;
+    StunTimerWheel* wheel_ = nullptr;
+    int64_t due_ms_ = 0;
+    Timer* prev_ = nullptr;
+    Timer* next_ = nullptr;
+  };
+
+  static rtc::scoped_refptr<StunTimerWheel> ForThread(rtc::Thread* thread);
+
+  rtc::Thread* thread() const { return thread_; }
+
+  // Makes |timer| fire after |delay_ms|, rescheduling it if it is scheduled
+  // already.
+  void Schedule(Timer* timer, int delay_ms);
+  // Does nothing if |timer| isn't scheduled.
+  void Cancel(Timer* timer);
+
+  size_t size() const { return size_; }
+
+  void AddRef() const;
+  rtc::RefCountReleaseStatus Release() const;
+
+ protected:
+  explicit StunTimerWheel(rtc::Thread* thread);
+  ~StunTimerWheel() override;
+
+ private:
+  static constexpr int64_t kTickMs = 8;
+  static constexpr size_t kNumSlots = 512;
+
+  void OnMessage(rtc::Message* msg) override;
+
+  static int64_t TickOf(int64_t time_ms) { return time_ms / kTickMs; }
+  Timer** SlotForTick(int64_t tick) {
+    return &slots_[static_cast<size_t>(tick) & (kNumSlots - 1)];
+  }
+  const Timer* const* SlotForTick(int64_t tick) const {
+    return &slots_[static_cast<size_t>(tick) & (kNumSlots - 1)];
+  }
+  void Unlink(Timer* timer);
+  void FireExpired(int64_t now_ms);
+  absl::optional<int64_t> FindNextDueTime() const;
+  void UpdateWakeup(int64_t now_ms);
+
+  rtc::Thread* const thread_;
+  mutable webrtc::webrtc_impl::RefCounter ref_count_{0};
+  // Each slot is a list of the timers due in its ticks, in the order they
+  // were scheduled.
+  Timer* slots_[kNumSlots] = {};
+  size_t size_ = 0;
+  bool firing_ = false;
+  // The earliest tick that may have timers that are due.
+  int64_t next_tick_ = 0;
+  // The time of the posted message, if any.
+  absl::optional<int64_t> wakeup_ms_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_STUN_TIMER_WHEEL_H_
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/stun_timer_wheel.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/fake_clock.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace cricket {
+
+class StunTimerWheelTest : public ::testing::Test {
+ public:
+  StunTimerWheelTest()
+      : thread_(rtc::Thread::Current()),
+        wheel_(StunTimerWheel::ForThread(thread_)) {
+    // Keep the timers away from a tick boundary.
+    fake_clock_.SetTime(webrtc::Timestamp::ms(100003));
+  }
+
+  std::unique_ptr<StunTimerWheel::Timer> CreateTimer(int id) {
+    return std::make_unique<StunTimerWheel::Timer>(
+        [this, id] { fired_.push_back(id); });
+  }
+
+  void AdvanceTime(int ms) {
+    fake_clock_.AdvanceTime(webrtc::TimeDelta::ms(ms));
+    thread_->ProcessMessages(0);
+  }
+
+ protected:
+  rtc::ScopedFakeClock fake_clock_;
+  rtc::Thread* const thread_;
+  rtc::scoped_refptr<StunTimerWheel> wheel_;
+  std::vector<int> fired_;
+};
+
+TEST_F(StunTimerWheelTest, SharesWheelPerThread) {
+  EXPECT_EQ(wheel_.get(), StunTimerWheel::ForThread(thread_).get());
+  std::unique_ptr<rtc::Thread> other_thread = rtc::Thread::Create();
+  EXPECT_NE(wheel_.get(), StunTimerWheel::ForThread(other_thread.get()).get());
+}
+
+TEST_F(StunTimerWheelTest, FiresAtScheduledTime) {
+  std::unique_ptr<StunTimerWheel::Timer> timer = CreateTimer(1);
+  wheel_->Schedule(timer.get(), 250);
+  EXPECT_TRUE(timer->scheduled());
+  AdvanceTime(249);
+  EXPECT_TRUE(fired_.empty());
+  AdvanceTime(1);
+  EXPECT_EQ(std::vector<int>({1}), fired_);
+  EXPECT_FALSE(timer->scheduled());
+  EXPECT_EQ(0u, wheel_->size());
+}
+
+TEST_F(StunTimerWheelTest, FiresInOrderOfDueTime) {
+  std::vector<std::unique_ptr<StunTimerWheel::Timer>> timers;
+  const int kDelays[] = {9000, 300, 5, 300, 2};
+  for (int i = 0; i < 5; ++i) {
+    timers.push_back(CreateTimer(i));
+    wheel_->Schedule(timers.back().get(), kDelays[i]);
+  }
+  AdvanceTime(10000);
+  EXPECT_EQ(std::vector<int>({4, 2, 1, 3, 0}), fired_);
+}
+
+TEST_F(StunTimerWheelTest, PostsOneMessageForAllTimers) {
+  size_t queued_messages = thread_->size();
+  std::vector<std::unique_ptr<StunTimerWheel::Timer>> timers;
+  for (int i = 0; i < 1000; ++i) {
+    timers.push_back(CreateTimer(i));
+    wheel_->Schedule(timers.back().get(), 100 + i);
+  }
+  EXPECT_EQ(1000u, wheel_->size());
+  EXPECT_EQ(queued_messages + 1, thread_->size());
+  AdvanceTime(2000);
+  EXPECT_EQ(1000u, fired_.size());
+}
+
+TEST_F(StunTimerWheelTest, CancelledOrDestroyedTimerDoesNotFire) {
+  std::unique_ptr<StunTimerWheel::Timer> cancelled = CreateTimer(1);
+  std::unique_ptr<StunTimerWheel::Timer> destroyed = CreateTimer(2);
+  std::unique_ptr<StunTimerWheel::Timer> kept = CreateTimer(3);
+  wheel_->Schedule(cancelled.get(), 100);
+  wheel_->Schedule(destroyed.get(), 100);
+  wheel_->Schedule(kept.get(), 200);
+  wheel_->Cancel(cancelled.get());
+  destroyed.reset();
+  EXPECT_EQ(1u, wheel_->size());
+  AdvanceTime(1000);
+  EXPECT_EQ(std::vector<int>({3}), fired_);
+}
+
+TEST_F(StunTimerWheelTest, ReschedulesTimer) {
+  std::unique_ptr<StunTimerWheel::Timer> timer = CreateTimer(1);
+  wheel_->Schedule(timer.get(), 100);
+  wheel_->Schedule(timer.get(), 500);
+  EXPECT_EQ(1u, wheel_->size());
+  AdvanceTime(499);
+  EXPECT_TRUE(fired_.empty());
+  AdvanceTime(1);
+  EXPECT_EQ(std::vector<int>({1}), fired_);
+}
+
+TEST_F(StunTimerWheelTest, FiresTimersMoreThanATurnAway) {
+  std::unique_ptr<StunTimerWheel::Timer> timer = CreateTimer(1);
+  wheel_->Schedule(timer.get(), 600000);
+  for (int i = 0; i < 599; ++i)
+    AdvanceTime(1000);
+  AdvanceTime(999);
+  EXPECT_TRUE(fired_.empty());
+  AdvanceTime(1);
+  EXPECT_EQ(std::vector<int>({1}), fired_);
+}
+
+TEST_F(StunTimerWheelTest, TimerCanRescheduleItselfAndCancelOthers) {
+  std::unique_ptr<StunTimerWheel::Timer> other = CreateTimer(2);
+  int count = 0;
+  StunTimerWheel::Timer repeating([&] {
+    fired_.push_back(1);
+    wheel_->Cancel(other.get());
+    if (++count < 3)
+      wheel_->Schedule(&repeating, 250);
+  });
+  wheel_->Schedule(&repeating, 250);
+  wheel_->Schedule(other.get(), 250);
+  AdvanceTime(250);
+  EXPECT_EQ(std::vector<int>({1}), fired_);
+  AdvanceTime(250);
+  AdvanceTime(250);
+  EXPECT_EQ(std::vector<int>({1, 1, 1}), fired_);
+  EXPECT_EQ(0u, wheel_->size());
+}
+
+}  // namespace cricket
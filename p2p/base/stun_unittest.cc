@@ -19,7 +19,9 @@
 #include "rtc_base/arraysize.h"
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/byte_order.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/socket_address.h"
+#include "rtc_base/time_utils.h"
 #include "test/gtest.h"
 
 namespace cricket {
@@ -1271,6 +1273,41 @@ TEST_F(StunTest, AddMessageIntegrity) {
       kRfc5769SampleMsgPassword));
 }
 
+// Check that an HMAC keyed once authenticates many messages.
+TEST_F(StunTest, MessageIntegrityWithPasswordHmac) {
+  StunPasswordHmac password_hmac;
+  rtc::MessageDigest* hmac = password_hmac.Get(kRfc5769SampleMsgPassword);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+        reinterpret_cast<const char*>(kRfc5769SampleRequest),
+        sizeof(kRfc5769SampleRequest), hmac));
+    EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+        reinterpret_cast<const char*>(kRfc5769SampleResponse),
+        sizeof(kRfc5769SampleResponse), hmac));
+  }
+  EXPECT_EQ(hmac, password_hmac.Get(kRfc5769SampleMsgPassword));
+
+  IceMessage msg;
+  rtc::ByteBufferReader buf(
+      reinterpret_cast<const char*>(kRfc5769SampleRequestWithoutMI),
+      sizeof(kRfc5769SampleRequestWithoutMI));
+  EXPECT_TRUE(msg.Read(&buf));
+  EXPECT_TRUE(msg.AddMessageIntegrity(hmac));
+  const StunByteStringAttribute* mi_attr =
+      msg.GetByteString(STUN_ATTR_MESSAGE_INTEGRITY);
+  EXPECT_EQ(
+      0, memcmp(mi_attr->bytes(), kCalculatedHmac1, sizeof(kCalculatedHmac1)));
+
+  // A new password keys the HMAC again.
+  EXPECT_FALSE(StunMessage::ValidateMessageIntegrity(
+      reinterpret_cast<const char*>(kRfc5769SampleRequest),
+      sizeof(kRfc5769SampleRequest), password_hmac.Get("InvalidPassword")));
+  EXPECT_TRUE(StunMessage::ValidateMessageIntegrity(
+      reinterpret_cast<const char*>(kRfc5769SampleRequest),
+      sizeof(kRfc5769SampleRequest),
+      password_hmac.Get(kRfc5769SampleMsgPassword)));
+}
+
 // Check our STUN message validation code against the RFC5769 test messages.
 TEST_F(StunTest, ValidateFingerprint) {
   EXPECT_TRUE(StunMessage::ValidateFingerprint(
@@ -1571,4 +1608,59 @@ TEST_F(StunTest, ReduceTransactionIdIsHostOrderIndependent) {
   EXPECT_EQ(reduced_transaction_id, 1835954016u);
 }
 
+// Measures the cost of building and checking the STUN binding requests of
+// connectivity checks, with the HMAC keyed for each message or keyed once.
+// Run with --gtest_also_run_disabled_tests to get the timings logged.
+class StunConnectivityCheckPerfTest
+    : public StunTest,
+      public ::testing::WithParamInterface<bool> {};
+
+INSTANTIATE_TEST_SUITE_P(PasswordHmac,
+                         StunConnectivityCheckPerfTest,
+                         ::testing::Bool());
+
+TEST_P(StunConnectivityCheckPerfTest, DISABLED_ConnectivityCheckPerf) {
+  const bool use_password_hmac = GetParam();
+  const int kChecks = 100000;
+  StunPasswordHmac sender_hmac;
+  StunPasswordHmac receiver_hmac;
+  int valid_checks = 0;
+  int64_t start_us = rtc::SystemTimeNanos() / 1000;
+  for (int i = 0; i < kChecks; ++i) {
+    IceMessage request;
+    request.SetType(STUN_BINDING_REQUEST);
+    request.SetTransactionID("0123456789ab");
+    request.AddAttribute(std::make_unique<StunByteStringAttribute>(
+        STUN_ATTR_USERNAME, "remoteufrag:localufrag"));
+    request.AddAttribute(std::make_unique<StunUInt64Attribute>(
+        STUN_ATTR_ICE_CONTROLLING, 0x0123456789abcdefULL));
+    request.AddAttribute(
+        std::make_unique<StunUInt32Attribute>(STUN_ATTR_PRIORITY, i));
+    if (use_password_hmac) {
+      request.AddMessageIntegrity(sender_hmac.Get(kRfc5769SampleMsgPassword));
+    } else {
+      request.AddMessageIntegrity(kRfc5769SampleMsgPassword);
+    }
+    request.AddFingerprint();
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+
+    bool valid = StunMessage::ValidateFingerprint(buf.Data(), buf.Length());
+    if (use_password_hmac) {
+      valid = valid && StunMessage::ValidateMessageIntegrity(
+                           buf.Data(), buf.Length(),
+                           receiver_hmac.Get(kRfc5769SampleMsgPassword));
+    } else {
+      valid = valid && StunMessage::ValidateMessageIntegrity(
+                           buf.Data(), buf.Length(), kRfc5769SampleMsgPassword);
+    }
+    if (valid)
+      ++valid_checks;
+  }
+  int64_t elapsed_us = rtc::SystemTimeNanos() / 1000 - start_us;
+  EXPECT_EQ(kChecks, valid_checks);
+  RTC_LOG(LS_INFO) << (use_password_hmac ? "Password HMAC: " : "No cache: ")
+                   << kChecks * 1000000.0 / elapsed_us << " checks/s";
+}
+
 }  // namespace cricket
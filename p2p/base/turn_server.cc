@@ -98,6 +98,60 @@ class TurnServerAllocation::Channel : public rtc::MessageHandler {
   rtc::SocketAddress peer_;
 };
 
+// Finds the XOR-PEER-ADDRESS and DATA attributes of a Send indication in
+// place, without copying the data. Returns false if |data| isn't a well formed
+// RFC 5389 Send indication with both attributes.
+static bool ParseSendIndication(const char* data,
+                                size_t size,
+                                rtc::SocketAddress* peer,
+                                const char** payload,
+                                size_t* payload_size) {
+  if (size < kStunHeaderSize || rtc::GetBE16(data) != TURN_SEND_INDICATION ||
+      kStunHeaderSize + rtc::GetBE16(data + 2) != size ||
+      rtc::GetBE32(data + 4) != kStunMagicCookie) {
+    return false;
+  }
+  bool has_peer = false;
+  bool has_payload = false;
+  size_t pos = kStunHeaderSize;
+  while (pos + kStunAttributeHeaderSize <= size) {
+    uint16_t attr_type = rtc::GetBE16(data + pos);
+    size_t attr_length = rtc::GetBE16(data + pos + 2);
+    const char* value = data + pos + kStunAttributeHeaderSize;
+    if (pos + kStunAttributeHeaderSize + attr_length > size)
+      return false;
+    if (attr_type == STUN_ATTR_XOR_PEER_ADDRESS && !has_peer) {
+      // The port is XORed with the high bits of the magic cookie, an IPv4
+      // address with the magic cookie and an IPv6 address with the magic
+      // cookie and the transaction id.
+      uint8_t family = static_cast<uint8_t>(value[1]);
+      uint16_t port = rtc::GetBE16(value + 2) ^ (kStunMagicCookie >> 16);
+      if (family == STUN_ADDRESS_IPV4 && attr_length == 8) {
+        uint32_t ip = rtc::GetBE32(value + 4) ^ kStunMagicCookie;
+        *peer = rtc::SocketAddress(rtc::IPAddress(ip), port);
+      } else if (family == STUN_ADDRESS_IPV6 && attr_length == 20) {
+        in6_addr ip;
+        uint8_t* ip_bytes = reinterpret_cast<uint8_t*>(&ip);
+        // The magic cookie and the transaction id follow each other.
+        const char* mask = data + 4;
+        for (size_t i = 0; i < sizeof(ip); ++i)
+          ip_bytes[i] = static_cast<uint8_t>(value[4 + i] ^ mask[i]);
+        *peer = rtc::SocketAddress(rtc::IPAddress(ip), port);
+      } else {
+        return false;
+      }
+      has_peer = true;
+    } else if (attr_type == STUN_ATTR_DATA && !has_payload) {
+      *payload = value;
+      *payload_size = attr_length;
+      has_payload = true;
+    }
+    // Attributes are padded to a multiple of four bytes.
+    pos += kStunAttributeHeaderSize + ((attr_length + 3) & ~3);
+  }
+  return pos == size && has_peer && has_payload;
+}
+
 static bool InitResponse(const StunMessage* req, StunMessage* resp) {
   int resp_type = (req) ? GetStunSuccessResponseType(req->type()) : -1;
   if (resp_type == -1)
@@ -212,6 +266,19 @@ void TurnServer::OnInternalPacket(rtc::AsyncPacketSocket* socket,
   TurnServerConnection conn(addr, iter->second, socket);
   uint16_t msg_type = rtc::GetBE16(data);
   if (!IsTurnChannelData(msg_type)) {
+    // Like channel data, Send indications are relayed without parsing the
+    // whole message. Anything unusual takes the regular path.
+    if (msg_type == TURN_SEND_INDICATION && !stun_message_observer_) {
+      TurnServerAllocation* allocation = FindAllocation(&conn);
+      rtc::SocketAddress peer;
+      const char* payload;
+      size_t payload_size;
+      if (allocation &&
+          ParseSendIndication(data, size, &peer, &payload, &payload_size)) {
+        allocation->HandleSendIndicationData(peer, payload, payload_size);
+        return;
+      }
+    }
     // This is a STUN message.
     HandleStunMessage(&conn, data, size);
   } else {
@@ -737,15 +804,22 @@ void TurnServerAllocation::HandleSendIndication(const TurnMessage* msg) {
     return;
   }
 
+  HandleSendIndicationData(peer_attr->GetAddress(), data_attr->bytes(),
+                           data_attr->length());
+}
+
+void TurnServerAllocation::HandleSendIndicationData(
+    const rtc::SocketAddress& peer,
+    const char* data,
+    size_t size) {
   // If a permission exists, send the data on to the peer.
-  if (HasPermission(peer_attr->GetAddress().ipaddr())) {
-    SendExternal(data_attr->bytes(), data_attr->length(),
-                 peer_attr->GetAddress());
+  if (HasPermission(peer.ipaddr())) {
+    SendExternal(data, size, peer);
   } else {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received send indication without permission"
                            " peer="
-                        << peer_attr->GetAddress().ToSensitiveString();
+                        << peer.ToSensitiveString();
   }
 }
 
@@ -851,11 +925,11 @@ void TurnServerAllocation::OnExternalPacket(
   Channel* channel = FindChannel(addr);
   if (channel) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id());
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(data, size);
-    server_->Send(&conn_, buf);
+    channel_data_buffer_.Clear();
+    channel_data_buffer_.WriteUInt16(channel->id());
+    channel_data_buffer_.WriteUInt16(static_cast<uint16_t>(size));
+    channel_data_buffer_.WriteBytes(data, size);
+    server_->Send(&conn_, channel_data_buffer_);
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(addr.ipaddr())) {
     // No channel, but a permission exists. Send as a data indication.
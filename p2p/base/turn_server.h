@@ -11,7 +11,6 @@
 #ifndef P2P_BASE_TURN_SERVER_H_
 #define P2P_BASE_TURN_SERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
@@ -22,13 +21,13 @@
 #include "p2p/base/port_interface.h"
 #include "rtc_base/async_invoker.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/byte_buffer.h"
 #include "rtc_base/message_queue.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread_checker.h"
 
 namespace rtc {
-class ByteBufferWriter;
 class PacketSocketFactory;
 class Thread;
 }  // namespace rtc
@@ -89,14 +88,20 @@ class TurnServerAllocation : public rtc::MessageHandler,
 
   void HandleTurnMessage(const TurnMessage* msg);
   void HandleChannelData(const char* data, size_t size);
+  // Relays the data of a Send indication to |peer|, if there is a permission
+  // for it.
+  void HandleSendIndicationData(const rtc::SocketAddress& peer,
+                                const char* data,
+                                size_t size);
 
   sigslot::signal1<TurnServerAllocation*> SignalDestroyed;
 
  private:
   class Channel;
   class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  // These are searched for every relayed packet, so keep them contiguous.
+  typedef std::vector<Permission*> PermissionList;
+  typedef std::vector<Channel*> ChannelList;
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
@@ -141,6 +146,8 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string last_nonce_;
   PermissionList perms_;
   ChannelList channels_;
+  // Reused for the channel data messages sent to the client.
+  rtc::ByteBufferWriter channel_data_buffer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -234,6 +241,13 @@ class TurnServer : public sigslot::has_slots<> {
     enable_permission_checks_ = enable;
   }
 
+  // Sets the key that nonces are signed with, so that servers with the same
+  // key accept each other's nonces. Defaults to a random key.
+  void set_nonce_key(const std::string& nonce_key) {
+    RTC_DCHECK(thread_checker_.IsCurrent());
+    nonce_key_ = nonce_key;
+  }
+
   // Starts listening for packets from internal clients.
   void AddInternalSocket(rtc::AsyncPacketSocket* socket, ProtocolType proto);
   // Starts listening for the connections on this socket. When someone tries
@@ -0,0 +1,246 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/udp_socket_mux.h"
+
+#include <algorithm>
+
+#include "api/scoped_refptr.h"
+#include "p2p/base/stun.h"
+#include "p2p/base/stun_request.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace cricket {
+
+namespace {
+
+// Returns the STUN message type of |data|, or 0 if it isn't a STUN message.
+int GetStunType(const char* data, size_t size) {
+  if (size < kStunHeaderSize || (data[0] & 0xC0) != 0 ||
+      rtc::GetBE32(data + kStunTransactionIdOffset - kStunMagicCookieLength) !=
+          kStunMagicCookie) {
+    return 0;
+  }
+  return rtc::GetBE16(data);
+}
+
+// Returns the ufrag of the receiver of a STUN request, which comes first in
+// the USERNAME, or an empty string if there is none.
+std::string GetLocalUfrag(const char* data, size_t size) {
+  size_t end = std::min<size_t>(size, kStunHeaderSize + rtc::GetBE16(data + 2));
+  size_t pos = kStunHeaderSize;
+  while (pos + kStunAttributeHeaderSize <= end) {
+    uint16_t attr_type = rtc::GetBE16(data + pos);
+    uint16_t attr_length = rtc::GetBE16(data + pos + 2);
+    pos += kStunAttributeHeaderSize;
+    if (pos + attr_length > end)
+      break;
+    if (attr_type == STUN_ATTR_USERNAME) {
+      std::string username(data + pos, attr_length);
+      return username.substr(0, username.find(':'));
+    }
+    pos += (attr_length + 3) & ~3;
+  }
+  return std::string();
+}
+
+}  // namespace
+
+// A socket for one session that sends and receives through the mux.
+class UdpSocketMux::MuxedSocket : public rtc::AsyncPacketSocket {
+ public:
+  MuxedSocket(UdpSocketMux* mux, const std::string& ice_ufrag)
+      : mux_(mux), ice_ufrag_(ice_ufrag) {}
+  ~MuxedSocket() override { mux_->RemoveSocket(this); }
+
+  const std::string& ice_ufrag() const { return ice_ufrag_; }
+
+  rtc::SocketAddress GetLocalAddress() const override {
+    return mux_->GetLocalAddress();
+  }
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+  int Send(const void* pv,
+           size_t cb,
+           const rtc::PacketOptions& options) override {
+    // Only connected sockets can send without an address.
+    return -1;
+  }
+  int SendTo(const void* pv,
+             size_t cb,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) override {
+    return mux_->SendTo(this, pv, cb, addr, options);
+  }
+  int Close() override { return 0; }
+  State GetState() const override { return mux_->socket_->GetState(); }
+  int GetOption(rtc::Socket::Option opt, int* value) override {
+    return mux_->socket_->GetOption(opt, value);
+  }
+  int SetOption(rtc::Socket::Option opt, int value) override {
+    return mux_->socket_->SetOption(opt, value);
+  }
+  int GetError() const override { return mux_->socket_->GetError(); }
+  void SetError(int error) override { mux_->socket_->SetError(error); }
+
+ private:
+  // The mux lives as long as its sockets.
+  const rtc::scoped_refptr<UdpSocketMux> mux_;
+  const std::string ice_ufrag_;
+};
+
+UdpSocketMux::UdpSocketMux(std::unique_ptr<rtc::AsyncPacketSocket> socket)
+    : socket_(std::move(socket)) {
+  socket_->SignalReadPacket.connect(this, &UdpSocketMux::OnReadPacket);
+  socket_->SignalSentPacket.connect(this, &UdpSocketMux::OnSentPacket);
+  socket_->SignalReadyToSend.connect(this, &UdpSocketMux::OnReadyToSend);
+}
+
+UdpSocketMux::~UdpSocketMux() {
+  RTC_DCHECK(sockets_.empty());
+}
+
+std::unique_ptr<rtc::AsyncPacketSocket> UdpSocketMux::CreateSocket(
+    const std::string& ice_ufrag) {
+  auto muxed_socket = std::make_unique<MuxedSocket>(this, ice_ufrag);
+  sockets_.insert(muxed_socket.get());
+  // After an ICE restart, or when gathering again, the latest socket of a
+  // ufrag receives its new requests.
+  sockets_by_ufrag_[ice_ufrag] = muxed_socket.get();
+  return muxed_socket;
+}
+
+rtc::SocketAddress UdpSocketMux::GetLocalAddress() const {
+  return socket_->GetLocalAddress();
+}
+
+int UdpSocketMux::SendTo(MuxedSocket* muxed_socket,
+                         const void* data,
+                         size_t size,
+                         const rtc::SocketAddress& addr,
+                         const rtc::PacketOptions& options) {
+  sockets_by_remote_address_[addr] = muxed_socket;
+  const char* bytes = static_cast<const char*>(data);
+  if (IsStunRequestType(GetStunType(bytes, size))) {
+    AddPendingTransaction(
+        std::string(bytes + kStunTransactionIdOffset, kStunTransactionIdLength),
+        muxed_socket);
+  }
+  RTC_DCHECK(!sending_socket_);
+  sending_socket_ = muxed_socket;
+  int result = socket_->SendTo(data, size, addr, options);
+  sending_socket_ = nullptr;
+  return result;
+}
+
+void UdpSocketMux::RemoveSocket(MuxedSocket* muxed_socket) {
+  sockets_.erase(muxed_socket);
+  auto ufrag_it = sockets_by_ufrag_.find(muxed_socket->ice_ufrag());
+  if (ufrag_it != sockets_by_ufrag_.end() && ufrag_it->second == muxed_socket)
+    sockets_by_ufrag_.erase(ufrag_it);
+  for (auto it = sockets_by_remote_address_.begin();
+       it != sockets_by_remote_address_.end();) {
+    if (it->second == muxed_socket) {
+      it = sockets_by_remote_address_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (auto it = pending_transactions_.begin();
+       it != pending_transactions_.end();) {
+    if (it->second.first == muxed_socket) {
+      it = pending_transactions_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+UdpSocketMux::MuxedSocket* UdpSocketMux::FindSocket(
+    const char* data,
+    size_t size,
+    const rtc::SocketAddress& remote_addr) {
+  int stun_type = GetStunType(data, size);
+  if (IsStunSuccessResponseType(stun_type) ||
+      IsStunErrorResponseType(stun_type)) {
+    auto it = pending_transactions_.find(
+        std::string(data + kStunTransactionIdOffset, kStunTransactionIdLength));
+    if (it != pending_transactions_.end()) {
+      MuxedSocket* muxed_socket = it->second.first;
+      pending_transactions_.erase(it);
+      return muxed_socket;
+    }
+  } else if (IsStunRequestType(stun_type)) {
+    auto it = sockets_by_ufrag_.find(GetLocalUfrag(data, size));
+    if (it != sockets_by_ufrag_.end()) {
+      // Also lets the session receive the packets that follow, e.g. DTLS.
+      sockets_by_remote_address_[remote_addr] = it->second;
+      return it->second;
+    }
+  }
+  auto it = sockets_by_remote_address_.find(remote_addr);
+  return it != sockets_by_remote_address_.end() ? it->second : nullptr;
+}
+
+void UdpSocketMux::AddPendingTransaction(std::string transaction_id,
+                                         MuxedSocket* muxed_socket) {
+  int64_t now_ms = rtc::TimeMillis();
+  while (!pending_transaction_times_.empty() &&
+         now_ms - pending_transaction_times_.front().first >
+             STUN_TOTAL_TIMEOUT) {
+    // Retransmits leave older entries for the same transaction behind.
+    auto it =
+        pending_transactions_.find(pending_transaction_times_.front().second);
+    if (it != pending_transactions_.end() &&
+        it->second.second == pending_transaction_times_.front().first) {
+      pending_transactions_.erase(it);
+    }
+    pending_transaction_times_.pop_front();
+  }
+  pending_transactions_[transaction_id] = {muxed_socket, now_ms};
+  pending_transaction_times_.emplace_back(now_ms, std::move(transaction_id));
+}
+
+void UdpSocketMux::OnReadPacket(rtc::AsyncPacketSocket* socket,
+                                const char* data,
+                                size_t size,
+                                const rtc::SocketAddress& remote_addr,
+                                const int64_t& packet_time_us) {
+  RTC_DCHECK(socket == socket_.get());
+  MuxedSocket* muxed_socket = FindSocket(data, size, remote_addr);
+  if (!muxed_socket) {
+    RTC_LOG(LS_VERBOSE) << "Dropping packet from unknown address "
+                        << remote_addr.ToSensitiveString();
+    return;
+  }
+  muxed_socket->SignalReadPacket(muxed_socket, data, size, remote_addr,
+                                 packet_time_us);
+}
+
+void UdpSocketMux::OnSentPacket(rtc::AsyncPacketSocket* socket,
+                                const rtc::SentPacket& sent_packet) {
+  if (sending_socket_)
+    sending_socket_->SignalSentPacket(sending_socket_, sent_packet);
+}
+
+void UdpSocketMux::OnReadyToSend(rtc::AsyncPacketSocket* socket) {
+  // A socket may go away while signaling.
+  std::set<MuxedSocket*> sockets = sockets_;
+  for (MuxedSocket* muxed_socket : sockets) {
+    if (sockets_.count(muxed_socket))
+      muxed_socket->SignalReadyToSend(muxed_socket);
+  }
+}
+
+}  // namespace cricket
@@ -0,0 +1,101 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_UDP_SOCKET_MUX_H_
+#define P2P_BASE_UDP_SOCKET_MUX_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+
+namespace cricket {
+
+// Lets the UDP ports of many ICE sessions share one UDP socket, so that a
+// server with thousands of sessions doesn't need a socket for each of them.
+// Each session gets a socket from CreateSocket() that sends on the shared
+// socket and receives the packets of the session, demultiplexed by
+//  - the ICE ufrag in the USERNAME of STUN requests,
+//  - the transaction ID of STUN responses, for requests sent by the session,
+//  - the remote address of anything else, for addresses the session sent to
+//    or got a STUN request from.
+// Other packets are dropped. Socket options are shared by all sessions.
+//
+// Two sessions sending to the same address, e.g. the same TURN server over
+// the shared socket, can't be told apart; the packets from the address go to
+// the one that sent last. STUN responses still reach the right session.
+//
+// Must be used on the thread of the shared socket. The mux lives as long as
+// any of its sockets.
+class UdpSocketMux : public rtc::RefCountInterface,
+                     public sigslot::has_slots<> {
+ public:
+  std::unique_ptr<rtc::AsyncPacketSocket> CreateSocket(
+      const std::string& ice_ufrag);
+
+  rtc::SocketAddress GetLocalAddress() const;
+  size_t num_sockets() const { return sockets_.size(); }
+
+ protected:
+  explicit UdpSocketMux(std::unique_ptr<rtc::AsyncPacketSocket> socket);
+  ~UdpSocketMux() override;
+
+ private:
+  class MuxedSocket;
+
+  int SendTo(MuxedSocket* muxed_socket,
+             const void* data,
+             size_t size,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options);
+  void RemoveSocket(MuxedSocket* muxed_socket);
+  MuxedSocket* FindSocket(const char* data,
+                          size_t size,
+                          const rtc::SocketAddress& remote_addr);
+  void AddPendingTransaction(std::string transaction_id,
+                             MuxedSocket* muxed_socket);
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us);
+  void OnSentPacket(rtc::AsyncPacketSocket* socket,
+                    const rtc::SentPacket& sent_packet);
+  void OnReadyToSend(rtc::AsyncPacketSocket* socket);
+
+  const std::unique_ptr<rtc::AsyncPacketSocket> socket_;
+  std::set<MuxedSocket*> sockets_;
+  std::map<std::string, MuxedSocket*> sockets_by_ufrag_;
+  std::map<rtc::SocketAddress, MuxedSocket*> sockets_by_remote_address_;
+  // STUN requests sent without a response yet, by transaction ID, with the
+  // time they were sent at.
+  std::map<std::string, std::pair<MuxedSocket*, int64_t>>
+      pending_transactions_;
+  // The same transactions in the order they were sent, to drop them after the
+  // request times out.
+  std::deque<std::pair<int64_t, std::string>> pending_transaction_times_;
+  // Set while a muxed socket sends, to pass it SignalSentPacket.
+  MuxedSocket* sending_socket_ = nullptr;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_UDP_SOCKET_MUX_H_
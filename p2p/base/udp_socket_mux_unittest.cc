@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/udp_socket_mux.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "absl/memory/memory.h"
+#include "p2p/base/stun.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/helpers.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/virtual_socket_server.h"
+#include "test/gtest.h"
+
+namespace cricket {
+
+namespace {
+const int kTimeoutMs = 1000;
+const rtc::SocketAddress kLocalAddr("11.11.11.11", 0);
+const rtc::SocketAddress kRemoteAddr1("22.22.22.22", 0);
+const rtc::SocketAddress kRemoteAddr2("33.33.33.33", 0);
+}  // namespace
+
+class UdpSocketMuxTest : public ::testing::Test, public sigslot::has_slots<> {
+ public:
+  UdpSocketMuxTest()
+      : thread_(&ss_),
+        mux_(new rtc::RefCountedObject<UdpSocketMux>(
+            absl::WrapUnique(rtc::AsyncUDPSocket::Create(&ss_, kLocalAddr)))),
+        remote1_(CreateRemote(kRemoteAddr1)),
+        remote2_(CreateRemote(kRemoteAddr2)) {}
+
+  std::unique_ptr<rtc::AsyncPacketSocket> CreateSocket(
+      const std::string& ice_ufrag) {
+    std::unique_ptr<rtc::AsyncPacketSocket> socket =
+        mux_->CreateSocket(ice_ufrag);
+    socket->SignalReadPacket.connect(this, &UdpSocketMuxTest::OnReadPacket);
+    return socket;
+  }
+
+  std::unique_ptr<rtc::AsyncUDPSocket> CreateRemote(
+      const rtc::SocketAddress& addr) {
+    std::unique_ptr<rtc::AsyncUDPSocket> remote(
+        rtc::AsyncUDPSocket::Create(&ss_, addr));
+    remote->SignalReadPacket.connect(this, &UdpSocketMuxTest::OnReadPacket);
+    return remote;
+  }
+
+  static std::string CreateStunMessage(int type,
+                                       const std::string& transaction_id,
+                                       const std::string& username) {
+    StunMessage msg;
+    msg.SetType(type);
+    msg.SetTransactionID(transaction_id);
+    if (!username.empty()) {
+      msg.AddAttribute(
+          std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME,
+                                                    username));
+    }
+    rtc::ByteBufferWriter buf;
+    msg.Write(&buf);
+    return std::string(buf.Data(), buf.Length());
+  }
+
+  void Send(rtc::AsyncPacketSocket* from,
+            const std::string& data,
+            const rtc::SocketAddress& to) {
+    from->SendTo(data.data(), data.size(), to, rtc::PacketOptions());
+  }
+
+  void OnReadPacket(rtc::AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const rtc::SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    received_[socket] = std::string(data, size);
+    ++num_received_;
+  }
+
+ protected:
+  rtc::VirtualSocketServer ss_;
+  rtc::AutoSocketServerThread thread_;
+  rtc::scoped_refptr<UdpSocketMux> mux_;
+  std::unique_ptr<rtc::AsyncUDPSocket> remote1_;
+  std::unique_ptr<rtc::AsyncUDPSocket> remote2_;
+  std::map<rtc::AsyncPacketSocket*, std::string> received_;
+  int num_received_ = 0;
+};
+
+TEST_F(UdpSocketMuxTest, RoutesStunRequestsByUfrag) {
+  std::unique_ptr<rtc::AsyncPacketSocket> socket1 = CreateSocket("ufrag1");
+  std::unique_ptr<rtc::AsyncPacketSocket> socket2 = CreateSocket("ufrag2");
+  EXPECT_EQ(2u, mux_->num_sockets());
+  EXPECT_EQ(socket1->GetLocalAddress(), socket2->GetLocalAddress());
+
+  std::string request = CreateStunMessage(
+      STUN_BINDING_REQUEST, rtc::CreateRandomString(kStunTransactionIdLength),
+      "ufrag2:remote");
+  Send(remote1_.get(), request, mux_->GetLocalAddress());
+  EXPECT_EQ_WAIT(1, num_received_, kTimeoutMs);
+  EXPECT_EQ(request, received_[socket2.get()]);
+
+  // Packets that follow from the same address go to the same session.
+  Send(remote1_.get(), "dtls", mux_->GetLocalAddress());
+  EXPECT_EQ_WAIT(2, num_received_, kTimeoutMs);
+  EXPECT_EQ("dtls", received_[socket2.get()]);
+  EXPECT_EQ(0u, received_.count(socket1.get()));
+}
+
+TEST_F(UdpSocketMuxTest, RoutesStunResponsesByTransactionId) {
+  std::unique_ptr<rtc::AsyncPacketSocket> socket1 = CreateSocket("ufrag1");
+  std::unique_ptr<rtc::AsyncPacketSocket> socket2 = CreateSocket("ufrag2");
+  // Both sessions send to the same server, e.g. for a server reflexive
+  // candidate.
+  std::string id1 = rtc::CreateRandomString(kStunTransactionIdLength);
+  std::string id2 = rtc::CreateRandomString(kStunTransactionIdLength);
+  Send(socket1.get(), CreateStunMessage(STUN_BINDING_REQUEST, id1, ""),
+       remote1_->GetLocalAddress());
+  Send(socket2.get(), CreateStunMessage(STUN_BINDING_REQUEST, id2, ""),
+       remote1_->GetLocalAddress());
+  EXPECT_EQ_WAIT(2, num_received_, kTimeoutMs);
+
+  std::string response1 = CreateStunMessage(STUN_BINDING_RESPONSE, id1, "");
+  Send(remote1_.get(), response1, mux_->GetLocalAddress());
+  EXPECT_EQ_WAIT(3, num_received_, kTimeoutMs);
+  EXPECT_EQ(response1, received_[socket1.get()]);
+  EXPECT_EQ(0u, received_.count(socket2.get()));
+}
+
+TEST_F(UdpSocketMuxTest, RoutesByRemoteAddressAfterSend) {
+  std::unique_ptr<rtc::AsyncPacketSocket> socket1 = CreateSocket("ufrag1");
+  std::unique_ptr<rtc::AsyncPacketSocket> socket2 = CreateSocket("ufrag2");
+  Send(socket1.get(), "to remote1", remote1_->GetLocalAddress());
+  Send(socket2.get(), "to remote2", remote2_->GetLocalAddress());
+  EXPECT_EQ_WAIT(2, num_received_, kTimeoutMs);
+  EXPECT_EQ("to remote1", received_[remote1_.get()]);
+  EXPECT_EQ("to remote2", received_[remote2_.get()]);
+
+  Send(remote1_.get(), "from remote1", mux_->GetLocalAddress());
+  Send(remote2_.get(), "from remote2", mux_->GetLocalAddress());
+  EXPECT_EQ_WAIT(4, num_received_, kTimeoutMs);
+  EXPECT_EQ("from remote1", received_[socket1.get()]);
+  EXPECT_EQ("from remote2", received_[socket2.get()]);
+}
+
+TEST_F(UdpSocketMuxTest, DropsPacketsFromUnknownAddresses) {
+  std::unique_ptr<rtc::AsyncPacketSocket> socket = CreateSocket("ufrag1");
+  Send(remote1_.get(), "unknown", mux_->GetLocalAddress());
+  // A request for another ufrag is dropped too.
+  Send(remote1_.get(),
+       CreateStunMessage(STUN_BINDING_REQUEST,
+                         rtc::CreateRandomString(kStunTransactionIdLength),
+                         "ufrag2:remote"),
+       mux_->GetLocalAddress());
+  thread_.ProcessMessages(100);
+  EXPECT_EQ(0, num_received_);
+}
+
+TEST_F(UdpSocketMuxTest, StopsRoutingToDestroyedSocket) {
+  std::unique_ptr<rtc::AsyncPacketSocket> socket = CreateSocket("ufrag1");
+  Send(socket.get(), "to remote1", remote1_->GetLocalAddress());
+  EXPECT_EQ_WAIT(1, num_received_, kTimeoutMs);
+  socket.reset();
+  EXPECT_EQ(0u, mux_->num_sockets());
+
+  Send(remote1_.get(), "from remote1", mux_->GetLocalAddress());
+  thread_.ProcessMessages(100);
+  EXPECT_EQ(1, num_received_);
+}
+
+}  // namespace cricket
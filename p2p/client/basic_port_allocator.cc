@@ -28,6 +28,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/metrics.h"
 
 using rtc::CreateRandomId;
@@ -50,6 +51,11 @@ const int PHASE_TCP = 2;
 
 const int kNumPhases = 3;
 
+// With PORTALLOCATOR_ENABLE_PARALLEL_GATHERING, the sequences of the networks
+// start this long apart for each server the previous one contacts, which keeps
+// new STUN transactions within the 5 ms pacing RFC 8445, section 14 allows.
+const int kParallelGatheringPacingMs = 5;
+
 // Gets protocol priority: UDP > TCP > SSLTCP == TLS.
 int GetProtocolPriority(cricket::ProtocolType protocol) {
   switch (protocol) {
@@ -245,6 +251,26 @@ void BasicPortAllocator::AddTurnServer(const RelayServerConfig& turn_server) {
                    prune_turn_ports(), turn_customizer());
 }
 
+std::unique_ptr<rtc::AsyncPacketSocket>
+BasicPortAllocator::CreateMuxedUdpSocket(
+    rtc::PacketSocketFactory* socket_factory,
+    const rtc::IPAddress& ip,
+    const std::string& ice_ufrag) {
+  CheckRunOnValidThreadIfInitialized();
+  rtc::scoped_refptr<UdpSocketMux>& mux = udp_socket_muxes_[ip];
+  if (!mux) {
+    std::unique_ptr<rtc::AsyncPacketSocket> socket(
+        socket_factory->CreateUdpSocket(rtc::SocketAddress(ip, 0), min_port(),
+                                        max_port()));
+    if (!socket) {
+      udp_socket_muxes_.erase(ip);
+      return nullptr;
+    }
+    mux = new rtc::RefCountedObject<UdpSocketMux>(std::move(socket));
+  }
+  return mux->CreateSocket(ice_ufrag);
+}
+
 void BasicPortAllocator::InitRelayPortFactory(
     RelayPortFactoryInterface* relay_port_factory) {
   if (relay_port_factory != nullptr) {
@@ -370,6 +396,8 @@ void BasicPortAllocatorSession::SetCandidateFilter(uint32_t filter) {
 void BasicPortAllocatorSession::StartGettingPorts() {
   RTC_DCHECK_RUN_ON(network_thread_);
   state_ = SessionState::GATHERING;
+  if (!start_time_ms_)
+    start_time_ms_ = rtc::TimeMillis();
   if (!socket_factory_) {
     owned_socket_factory_.reset(
         new rtc::BasicPacketSocketFactory(network_thread_));
@@ -798,6 +826,7 @@ void BasicPortAllocatorSession::DoAllocate(bool disable_equivalent) {
   } else {
     RTC_LOG(LS_INFO) << "Allocate ports on " << networks.size() << " networks";
     PortConfiguration* config = configs_.empty() ? nullptr : configs_.back();
+    int start_delay_ms = 0;
     for (uint32_t i = 0; i < networks.size(); ++i) {
       uint32_t sequence_flags = flags();
       if ((sequence_flags & DISABLE_ALL_PHASES) == DISABLE_ALL_PHASES) {
@@ -841,7 +870,13 @@ void BasicPortAllocatorSession::DoAllocate(bool disable_equivalent) {
       sequence->SignalPortAllocationComplete.connect(
           this, &BasicPortAllocatorSession::OnPortAllocationComplete);
       sequence->Init();
-      sequence->Start();
+      if (sequence_flags & PORTALLOCATOR_ENABLE_PARALLEL_GATHERING) {
+        sequence->Start(start_delay_ms);
+        start_delay_ms += kParallelGatheringPacingMs *
+                          std::max(1, sequence->NumServerTransactions());
+      } else {
+        sequence->Start();
+      }
       sequences_.push_back(sequence);
       done_signal_needed = true;
     }
@@ -982,6 +1017,7 @@ void BasicPortAllocatorSession::OnCandidateReady(Port* port,
     std::vector<Candidate> candidates;
     candidates.push_back(allocator_->SanitizeCandidate(c));
     SignalCandidatesReady(this, candidates);
+    RecordCandidateLatency(c);
   } else {
     RTC_LOG(LS_INFO) << "Discarding candidate because it doesn't match filter.";
   }
@@ -1136,10 +1172,57 @@ void BasicPortAllocatorSession::MaybeSignalCandidatesAllocationDone() {
       RTC_LOG(LS_INFO) << "All candidates gathered for " << content_name()
                        << ":" << component() << ":" << generation();
     }
+    RecordGatheringCompleteLatency();
     SignalCandidatesAllocationDone(this);
   }
 }
 
+void BasicPortAllocatorSession::RecordCandidateLatency(const Candidate& c) {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!start_time_ms_)
+    return;
+  uint32_t type = CF_NONE;
+  if (c.type() == LOCAL_PORT_TYPE) {
+    type = CF_HOST;
+  } else if (c.type() == STUN_PORT_TYPE) {
+    type = CF_REFLEXIVE;
+  } else if (c.type() == RELAY_PORT_TYPE) {
+    type = CF_RELAY;
+  }
+  if (type == CF_NONE || (recorded_candidate_types_ & type))
+    return;
+  recorded_candidate_types_ |= type;
+
+  int latency_ms = static_cast<int>(rtc::TimeMillis() - *start_time_ms_);
+  switch (type) {
+    case CF_HOST:
+      RTC_HISTOGRAM_COUNTS_10000(
+          "WebRTC.PeerConnection.IceGathering.FirstHostCandidateTime",
+          latency_ms);
+      break;
+    case CF_REFLEXIVE:
+      RTC_HISTOGRAM_COUNTS_10000(
+          "WebRTC.PeerConnection.IceGathering.FirstSrflxCandidateTime",
+          latency_ms);
+      break;
+    case CF_RELAY:
+      RTC_HISTOGRAM_COUNTS_10000(
+          "WebRTC.PeerConnection.IceGathering.FirstRelayCandidateTime",
+          latency_ms);
+      break;
+  }
+}
+
+void BasicPortAllocatorSession::RecordGatheringCompleteLatency() {
+  RTC_DCHECK_RUN_ON(network_thread_);
+  if (!start_time_ms_ || recorded_complete_latency_)
+    return;
+  recorded_complete_latency_ = true;
+  RTC_HISTOGRAM_COUNTS_10000(
+      "WebRTC.PeerConnection.IceGathering.CompleteTime",
+      static_cast<int>(rtc::TimeMillis() - *start_time_ms_));
+}
+
 void BasicPortAllocatorSession::OnPortDestroyed(PortInterface* port) {
   RTC_DCHECK_RUN_ON(network_thread_);
   for (std::vector<PortData>::iterator iter = ports_.begin();
@@ -1223,9 +1306,16 @@ AllocationSequence::AllocationSequence(BasicPortAllocatorSession* session,
 
 void AllocationSequence::Init() {
   if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
-    udp_socket_.reset(session_->socket_factory()->CreateUdpSocket(
-        rtc::SocketAddress(network_->GetBestIP(), 0),
-        session_->allocator()->min_port(), session_->allocator()->max_port()));
+    if (IsFlagSet(PORTALLOCATOR_ENABLE_UDP_SOCKET_MUX)) {
+      udp_socket_ = session_->allocator()->CreateMuxedUdpSocket(
+          session_->socket_factory(), network_->GetBestIP(),
+          session_->username());
+    } else {
+      udp_socket_.reset(session_->socket_factory()->CreateUdpSocket(
+          rtc::SocketAddress(network_->GetBestIP(), 0),
+          session_->allocator()->min_port(),
+          session_->allocator()->max_port()));
+    }
     if (udp_socket_) {
       udp_socket_->SignalReadPacket.connect(this,
                                             &AllocationSequence::OnReadPacket);
@@ -1323,14 +1413,35 @@ void AllocationSequence::DisableEquivalentPhases(rtc::Network* network,
   }
 }
 
-void AllocationSequence::Start() {
+void AllocationSequence::Start(int delay_ms) {
   state_ = kRunning;
-  session_->network_thread()->Post(RTC_FROM_HERE, this, MSG_ALLOCATION_PHASE);
+  if (delay_ms > 0) {
+    session_->network_thread()->PostDelayed(RTC_FROM_HERE, delay_ms, this,
+                                            MSG_ALLOCATION_PHASE);
+  } else {
+    session_->network_thread()->Post(RTC_FROM_HERE, this,
+                                     MSG_ALLOCATION_PHASE);
+  }
   // Take a snapshot of the best IP, so that when DisableEquivalentPhases is
   // called next time, we enable all phases if the best IP has since changed.
   previous_best_ip_ = network_->GetBestIP();
 }
 
+int AllocationSequence::NumServerTransactions() const {
+  if (!config_)
+    return 0;
+  int num = 0;
+  if (!IsFlagSet(PORTALLOCATOR_DISABLE_UDP) &&
+      !IsFlagSet(PORTALLOCATOR_DISABLE_STUN)) {
+    num += static_cast<int>(config_->StunServers().size());
+  }
+  if (!IsFlagSet(PORTALLOCATOR_DISABLE_RELAY)) {
+    for (const RelayServerConfig& relay : config_->relays)
+      num += static_cast<int>(relay.ports.size());
+  }
+  return num;
+}
+
 void AllocationSequence::Stop() {
   // If the port is completed, don't set it to stopped.
   if (state_ == kRunning) {
@@ -1345,31 +1456,37 @@ void AllocationSequence::OnMessage(rtc::Message* msg) {
 
   const char* const PHASE_NAMES[kNumPhases] = {"Udp", "Relay", "Tcp"};
 
-  // Perform all of the phases in the current step.
-  RTC_LOG(LS_INFO) << network_->ToString()
-                   << ": Allocation Phase=" << PHASE_NAMES[phase_];
+  // With parallel gathering, all the phases run in this step.
+  do {
+    // Perform all of the phases in the current step.
+    RTC_LOG(LS_INFO) << network_->ToString()
+                     << ": Allocation Phase=" << PHASE_NAMES[phase_];
 
-  switch (phase_) {
-    case PHASE_UDP:
-      CreateUDPPorts();
-      CreateStunPorts();
-      break;
+    switch (phase_) {
+      case PHASE_UDP:
+        CreateUDPPorts();
+        CreateStunPorts();
+        break;
 
-    case PHASE_RELAY:
-      CreateRelayPorts();
-      break;
+      case PHASE_RELAY:
+        CreateRelayPorts();
+        break;
 
-    case PHASE_TCP:
-      CreateTCPPorts();
-      state_ = kCompleted;
-      break;
+      case PHASE_TCP:
+        CreateTCPPorts();
+        state_ = kCompleted;
+        break;
 
-    default:
-      RTC_NOTREACHED();
-  }
+      default:
+        RTC_NOTREACHED();
+    }
+
+    if (state() == kRunning)
+      ++phase_;
+  } while (state() == kRunning &&
+           IsFlagSet(PORTALLOCATOR_ENABLE_PARALLEL_GATHERING));
 
   if (state() == kRunning) {
-    ++phase_;
     session_->network_thread()->PostDelayed(RTC_FROM_HERE,
                                             session_->allocator()->step_delay(),
                                             this, MSG_ALLOCATION_PHASE);
@@ -1572,7 +1689,10 @@ void AllocationSequence::CreateTurnPort(const RelayServerConfig& config) {
     // don't pass shared socket for ports which will create TCP sockets.
     // TODO(mallinath) - Enable shared socket mode for TURN ports. Disabled
     // due to webrtc bug https://code.google.com/p/webrtc/issues/detail?id=3537
+    // Relay ports of different sessions on a muxed socket would share the
+    // address of their TURN server, so they get their own sockets.
     if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET) &&
+        !IsFlagSet(PORTALLOCATOR_ENABLE_UDP_SOCKET_MUX) &&
         relay_port->proto == PROTO_UDP && udp_socket_) {
       port = session_->allocator()->relay_port_factory()->Create(
           args, udp_socket_.get());
@@ -11,12 +11,16 @@
 #ifndef P2P_CLIENT_BASIC_PORT_ALLOCATOR_H_
 #define P2P_CLIENT_BASIC_PORT_ALLOCATOR_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
+#include "api/scoped_refptr.h"
 #include "api/turn_customizer.h"
 #include "p2p/base/port_allocator.h"
+#include "p2p/base/udp_socket_mux.h"
 #include "p2p/client/relay_port_factory_interface.h"
 #include "p2p/client/turn_port_factory.h"
 #include "rtc_base/checks.h"
@@ -76,6 +80,14 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
     return relay_port_factory_;
   }
 
+  // With PORTALLOCATOR_ENABLE_UDP_SOCKET_MUX, creates a socket for the session
+  // with |ice_ufrag| on the UDP socket shared by the sessions on |ip|. Creates
+  // the shared socket with |socket_factory| if there is none yet.
+  std::unique_ptr<rtc::AsyncPacketSocket> CreateMuxedUdpSocket(
+      rtc::PacketSocketFactory* socket_factory,
+      const rtc::IPAddress& ip,
+      const std::string& ice_ufrag);
+
  private:
   void Construct();
 
@@ -97,6 +109,8 @@ class RTC_EXPORT BasicPortAllocator : public PortAllocator {
 
   // This instance is created if caller does pass a factory.
   std::unique_ptr<RelayPortFactoryInterface> default_relay_port_factory_;
+
+  std::map<rtc::IPAddress, rtc::scoped_refptr<UdpSocketMux>> udp_socket_muxes_;
 };
 
 struct PortConfiguration;
@@ -239,6 +253,10 @@ class RTC_EXPORT BasicPortAllocatorSession : public PortAllocatorSession,
   void OnPortDestroyed(PortInterface* port);
   void MaybeSignalCandidatesAllocationDone();
   void OnPortAllocationComplete(AllocationSequence* seq);
+  // Reports how long it took to get the first candidate of each type, and to
+  // finish gathering, once per session.
+  void RecordCandidateLatency(const Candidate& c);
+  void RecordGatheringCompleteLatency();
   PortData* FindPort(Port* port);
   std::vector<rtc::Network*> GetNetworks();
   std::vector<rtc::Network*> GetFailedNetworks();
@@ -277,6 +295,11 @@ class RTC_EXPORT BasicPortAllocatorSession : public PortAllocatorSession,
   // Whether to prune low-priority ports, taken from the port allocator.
   bool prune_turn_ports_;
   SessionState state_ = SessionState::CLEARED;
+  // When StartGettingPorts() was first called, for the latency metrics.
+  absl::optional<int64_t> start_time_ms_;
+  // The CF_* types of candidates whose latency has been recorded.
+  uint32_t recorded_candidate_types_ = CF_NONE;
+  bool recorded_complete_latency_ = false;
 
   friend class AllocationSequence;
 };
@@ -359,10 +382,14 @@ class AllocationSequence : public rtc::MessageHandler,
                                uint32_t* flags);
 
   // Starts and stops the sequence.  When started, it will continue allocating
-  // new ports on its own timed schedule.
-  void Start();
+  // new ports on its own timed schedule, the first ones after |delay_ms|.
+  void Start(int delay_ms = 0);
   void Stop();
 
+  // The number of STUN and TURN servers the sequence will contact, used to
+  // pace parallel gathering.
+  int NumServerTransactions() const;
+
   // MessageHandler
   void OnMessage(rtc::Message* msg) override;
 
@@ -381,7 +408,7 @@ class AllocationSequence : public rtc::MessageHandler,
  private:
   typedef std::vector<ProtocolType> ProtocolList;
 
-  bool IsFlagSet(uint32_t flag) { return ((flags_ & flag) != 0); }
+  bool IsFlagSet(uint32_t flag) const { return ((flags_ & flag) != 0); }
   void CreateUDPPorts();
   void CreateTCPPorts();
   void CreateStunPorts();
@@ -91,8 +91,10 @@ static const int kMaxPort = 10099;
 
 // Based on ICE_UFRAG_LENGTH
 static const char kIceUfrag0[] = "UF00";
+static const char kIceUfrag1[] = "UF01";
 // Based on ICE_PWD_LENGTH
 static const char kIcePwd0[] = "TESTICEPWD00000000000000";
+static const char kIcePwd1[] = "TESTICEPWD00000000000001";
 
 static const char kContentName[] = "test content";
 
@@ -1138,6 +1140,38 @@ TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithOneSecondStepDelay) {
   session_->StopGettingPorts();
 }
 
+// Test that with PORTALLOCATOR_ENABLE_PARALLEL_GATHERING, all phases run on
+// all networks right away instead of one step delay apart, and the latency of
+// each phase is reported.
+TEST_F(BasicPortAllocatorTest, TestParallelGatheringRunsAllPhasesAtOnce) {
+  AddInterface(kClientAddr);
+  AddInterface(kClientAddr2, "net2");
+  AddTurnServers(kTurnUdpIntAddr, rtc::SocketAddress());
+  allocator_->set_step_delay(kDefaultStepDelay);
+  allocator_->set_flags(allocator().flags() |
+                        PORTALLOCATOR_ENABLE_PARALLEL_GATHERING);
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  // Without parallel gathering, the TCP ports would come after two steps.
+  ASSERT_TRUE_SIMULATED_WAIT(candidate_allocation_done_, kDefaultStepDelay / 2,
+                             fake_clock);
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "udp", kClientAddr));
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "udp", kClientAddr2));
+  EXPECT_TRUE(HasCandidate(candidates_, "relay", "udp", kTurnUdpExtAddr));
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "tcp", kClientAddr));
+  EXPECT_TRUE(HasCandidate(candidates_, "local", "tcp", kClientAddr2));
+  EXPECT_EQ(1, CountPorts(ports_, "relay", PROTO_UDP, kClientAddr));
+  EXPECT_EQ(1, CountPorts(ports_, "relay", PROTO_UDP, kClientAddr2));
+  EXPECT_EQ(
+      1, webrtc::metrics::NumSamples(
+             "WebRTC.PeerConnection.IceGathering.FirstHostCandidateTime"));
+  EXPECT_EQ(
+      1, webrtc::metrics::NumSamples(
+             "WebRTC.PeerConnection.IceGathering.FirstRelayCandidateTime"));
+  EXPECT_EQ(1, webrtc::metrics::NumSamples(
+                   "WebRTC.PeerConnection.IceGathering.CompleteTime"));
+}
+
 TEST_F(BasicPortAllocatorTest, TestSetupVideoRtpPortsWithNormalSendBuffers) {
   AddInterface(kClientAddr);
   ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP, CN_VIDEO));
@@ -1621,6 +1655,42 @@ TEST_F(BasicPortAllocatorTest, TestSharedSocketWithNat) {
   EXPECT_EQ(3U, candidates_.size());
 }
 
+// Test that with PORTALLOCATOR_ENABLE_UDP_SOCKET_MUX, the UDP ports of two
+// sessions share one socket, and both still get their STUN candidates.
+TEST_F(BasicPortAllocatorTest, TestUdpSocketMuxSharesSocketAcrossSessions) {
+  AddInterface(kClientAddr);
+  ResetWithStunServerAndNat(kStunAddr);
+
+  allocator_->set_flags(allocator().flags() |
+                        PORTALLOCATOR_ENABLE_SHARED_SOCKET |
+                        PORTALLOCATOR_ENABLE_UDP_SOCKET_MUX |
+                        PORTALLOCATOR_DISABLE_TCP);
+  ASSERT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  std::unique_ptr<PortAllocatorSession> session2 =
+      CreateSession("session2", kContentName, ICE_CANDIDATE_COMPONENT_RTP,
+                    kIceUfrag1, kIcePwd1);
+  session_->StartGettingPorts();
+  session2->StartGettingPorts();
+  ASSERT_EQ_SIMULATED_WAIT(4U, candidates_.size(), kDefaultAllocationTimeout,
+                           fake_clock);
+  ASSERT_EQ(2U, ports_.size());
+  EXPECT_EQ(ports_[0]->Network(), ports_[1]->Network());
+  std::vector<Candidate> local_candidates;
+  std::vector<Candidate> stun_candidates;
+  for (const Candidate& candidate : candidates_) {
+    if (candidate.type() == LOCAL_PORT_TYPE) {
+      local_candidates.push_back(candidate);
+    } else if (candidate.type() == STUN_PORT_TYPE) {
+      stun_candidates.push_back(candidate);
+    }
+  }
+  ASSERT_EQ(2U, local_candidates.size());
+  ASSERT_EQ(2U, stun_candidates.size());
+  EXPECT_EQ(local_candidates[0].address(), local_candidates[1].address());
+  EXPECT_EQ(stun_candidates[0].address(), stun_candidates[1].address());
+  EXPECT_NE(stun_candidates[0].username(), stun_candidates[1].username());
+}
+
 // Test TURN port in shared socket mode with UDP and TCP TURN server addresses.
 TEST_F(BasicPortAllocatorTest, TestSharedSocketWithoutNatUsingTurn) {
   turn_server_.AddInternalSocket(kTurnTcpIntAddr, PROTO_TCP);
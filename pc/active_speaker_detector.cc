@@ -0,0 +1,126 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/active_speaker_detector.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// Audio levels are in -dBov, 127 being silence.
+constexpr int kSilenceLevel = 127;
+
+}  // namespace
+
+ActiveSpeakerDetector::ActiveSpeakerDetector()
+    : ActiveSpeakerDetector(Config()) {}
+
+ActiveSpeakerDetector::ActiveSpeakerDetector(const Config& config)
+    : config_(config) {
+  RTC_DCHECK_GT(config_.smoothing_factor, 0.0f);
+  RTC_DCHECK_LE(config_.smoothing_factor, 1.0f);
+}
+
+ActiveSpeakerDetector::~ActiveSpeakerDetector() = default;
+
+void ActiveSpeakerDetector::SetObserver(Observer* observer) {
+  rtc::CritScope cs(&crit_);
+  observer_ = observer;
+}
+
+bool ActiveSpeakerDetector::OnRtpAudioLevel(uint32_t ssrc,
+                                            uint8_t level,
+                                            bool voice_activity,
+                                            int64_t arrival_time_ms) {
+  const float loudness_db =
+      config_.use_voice_activity && !voice_activity
+          ? 0.0f
+          : static_cast<float>(kSilenceLevel - std::min<int>(level, 127));
+  Observer* observer = nullptr;
+  uint32_t dominant_ssrc = 0;
+  {
+    rtc::CritScope cs(&crit_);
+    Stream* stream = FindStream(ssrc);
+    if (stream) {
+      stream->loudness_db +=
+          (loudness_db - stream->loudness_db) * config_.smoothing_factor;
+    } else {
+      streams_.push_back({ssrc, loudness_db * config_.smoothing_factor, 0});
+      stream = &streams_.back();
+    }
+    stream->last_packet_ms = arrival_time_ms;
+    if (arrival_time_ms < next_evaluation_ms_)
+      return true;
+    next_evaluation_ms_ = arrival_time_ms + config_.evaluation_interval_ms;
+    if (!Evaluate(arrival_time_ms))
+      return true;
+    observer = observer_;
+    dominant_ssrc = *dominant_ssrc_;
+  }
+  if (observer)
+    observer->OnDominantSpeakerChanged(dominant_ssrc);
+  return true;
+}
+
+void ActiveSpeakerDetector::RemoveStream(uint32_t ssrc) {
+  rtc::CritScope cs(&crit_);
+  streams_.erase(std::remove_if(streams_.begin(), streams_.end(),
+                                [ssrc](const Stream& stream) {
+                                  return stream.ssrc == ssrc;
+                                }),
+                 streams_.end());
+  if (dominant_ssrc_ == ssrc)
+    dominant_ssrc_ = absl::nullopt;
+}
+
+absl::optional<uint32_t> ActiveSpeakerDetector::DominantSpeaker() const {
+  rtc::CritScope cs(&crit_);
+  return dominant_ssrc_;
+}
+
+ActiveSpeakerDetector::Stream* ActiveSpeakerDetector::FindStream(
+    uint32_t ssrc) {
+  for (Stream& stream : streams_) {
+    if (stream.ssrc == ssrc)
+      return &stream;
+  }
+  return nullptr;
+}
+
+bool ActiveSpeakerDetector::Evaluate(int64_t now_ms) {
+  const Stream* loudest = nullptr;
+  const Stream* dominant = nullptr;
+  for (const Stream& stream : streams_) {
+    if (now_ms - stream.last_packet_ms > config_.stream_timeout_ms)
+      continue;
+    if (!loudest || stream.loudness_db > loudest->loudness_db)
+      loudest = &stream;
+    if (stream.ssrc == dominant_ssrc_)
+      dominant = &stream;
+  }
+  if (!loudest || loudest == dominant)
+    return false;
+  // A stream that timed out counts as silent.
+  const float dominant_loudness_db = dominant ? dominant->loudness_db : 0.0f;
+  if (loudest->loudness_db < dominant_loudness_db + config_.switch_margin_db)
+    return false;
+  if (dominant_ssrc_ &&
+      now_ms - last_switch_ms_ < config_.min_switch_interval_ms) {
+    return false;
+  }
+  dominant_ssrc_ = loudest->ssrc;
+  last_switch_ms_ = now_ms;
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef PC_ACTIVE_SPEAKER_DETECTOR_H_
+#define PC_ACTIVE_SPEAKER_DETECTOR_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Gets the audio level extension of incoming RTP packets before they are
+// parsed and demuxed. See RtpTransport::SetAudioLevelSink().
+class RtpAudioLevelSinkInterface {
+ public:
+  virtual ~RtpAudioLevelSinkInterface() = default;
+
+  // |level| is in -dBov, 0 being the loudest and 127 silence. Returning false
+  // drops the packet, so it never reaches the demuxer or the receive streams.
+  virtual bool OnRtpAudioLevel(uint32_t ssrc,
+                               uint8_t level,
+                               bool voice_activity,
+                               int64_t arrival_time_ms) = 0;
+};
+
+// Picks the dominant speaker among incoming audio streams from their audio
+// level extensions. Levels are smoothed per stream and the dominant speaker
+// only changes when another stream has been clearly louder, and not more than
+// once per |min_switch_interval_ms|. The selection is reevaluated at most
+// every |evaluation_interval_ms|, so the per packet cost is a lookup and a
+// multiply-add. Thread safe.
+class ActiveSpeakerDetector : public RtpAudioLevelSinkInterface {
+ public:
+  struct Config {
+    // Weight of a new packet in the smoothed loudness.
+    float smoothing_factor = 0.1f;
+    // Margin, in dB, by which a stream must be louder than the dominant one.
+    float switch_margin_db = 6.0f;
+    int64_t min_switch_interval_ms = 1000;
+    int64_t evaluation_interval_ms = 100;
+    // Streams without packets for this long can't be the dominant speaker.
+    int64_t stream_timeout_ms = 2000;
+    // Count packets without the voice activity flag as silence.
+    bool use_voice_activity = true;
+  };
+
+  class Observer {
+   public:
+    virtual ~Observer() = default;
+    // Called on the packet delivery thread.
+    virtual void OnDominantSpeakerChanged(uint32_t ssrc) = 0;
+  };
+
+  ActiveSpeakerDetector();
+  explicit ActiveSpeakerDetector(const Config& config);
+  ~ActiveSpeakerDetector() override;
+
+  // |observer| must outlive the detector or be reset to null.
+  void SetObserver(Observer* observer);
+
+  // Always returns true, all packets are forwarded.
+  bool OnRtpAudioLevel(uint32_t ssrc,
+                       uint8_t level,
+                       bool voice_activity,
+                       int64_t arrival_time_ms) override;
+
+  void RemoveStream(uint32_t ssrc);
+
+  absl::optional<uint32_t> DominantSpeaker() const;
+
+ private:
+  struct Stream {
+    uint32_t ssrc;
+    float loudness_db;
+    int64_t last_packet_ms;
+  };
+
+  Stream* FindStream(uint32_t ssrc) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns true if the dominant speaker changed.
+  bool Evaluate(int64_t now_ms) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  const Config config_;
+  rtc::CriticalSection crit_;
+  Observer* observer_ RTC_GUARDED_BY(crit_) = nullptr;
+  // Few streams are expected, a vector is faster to search than a map.
+  std::vector<Stream> streams_ RTC_GUARDED_BY(crit_);
+  absl::optional<uint32_t> dominant_ssrc_ RTC_GUARDED_BY(crit_);
+  int64_t last_switch_ms_ RTC_GUARDED_BY(crit_) = 0;
+  int64_t next_evaluation_ms_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // PC_ACTIVE_SPEAKER_DETECTOR_H_
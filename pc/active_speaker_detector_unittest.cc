@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/active_speaker_detector.h"
+
+#include <vector>
+
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr uint32_t kSsrc1 = 1111;
+constexpr uint32_t kSsrc2 = 2222;
+constexpr int64_t kPacketIntervalMs = 20;
+constexpr uint8_t kLoud = 20;
+constexpr uint8_t kQuiet = 100;
+
+class RecordingObserver : public ActiveSpeakerDetector::Observer {
+ public:
+  void OnDominantSpeakerChanged(uint32_t ssrc) override {
+    changes.push_back(ssrc);
+  }
+  std::vector<uint32_t> changes;
+};
+
+class ActiveSpeakerDetectorTest : public ::testing::Test {
+ protected:
+  ActiveSpeakerDetectorTest() { detector_.SetObserver(&observer_); }
+
+  // Feeds both streams with the given levels for |duration_ms|.
+  void Talk(uint8_t level1, uint8_t level2, int64_t duration_ms) {
+    for (int64_t end_ms = now_ms_ + duration_ms; now_ms_ < end_ms;
+         now_ms_ += kPacketIntervalMs) {
+      EXPECT_TRUE(detector_.OnRtpAudioLevel(kSsrc1, level1, true, now_ms_));
+      EXPECT_TRUE(detector_.OnRtpAudioLevel(kSsrc2, level2, true, now_ms_));
+    }
+  }
+
+  int64_t now_ms_ = 1000;
+  RecordingObserver observer_;
+  ActiveSpeakerDetector detector_;
+};
+
+TEST_F(ActiveSpeakerDetectorTest, NoDominantSpeakerInSilence) {
+  Talk(127, 127, 1000);
+  EXPECT_FALSE(detector_.DominantSpeaker());
+  EXPECT_TRUE(observer_.changes.empty());
+}
+
+TEST_F(ActiveSpeakerDetectorTest, PicksLoudestStream) {
+  Talk(kQuiet, kLoud, 1000);
+  EXPECT_EQ(kSsrc2, detector_.DominantSpeaker());
+  Talk(kLoud, kQuiet, 2000);
+  EXPECT_EQ(kSsrc1, detector_.DominantSpeaker());
+  EXPECT_THAT(observer_.changes, ElementsAre(kSsrc2, kSsrc1));
+}
+
+TEST_F(ActiveSpeakerDetectorTest, DoesNotSwitchOnShortBursts) {
+  Talk(kQuiet, kLoud, 2000);
+  // Interjections shorter than the smoothing and switch interval.
+  for (int i = 0; i < 5; ++i) {
+    Talk(kLoud, kQuiet, 100);
+    Talk(kQuiet, kLoud, 500);
+  }
+  EXPECT_THAT(observer_.changes, ElementsAre(kSsrc2));
+}
+
+TEST_F(ActiveSpeakerDetectorTest, IgnoresPacketsWithoutVoiceActivity) {
+  for (int i = 0; i < 50; ++i, now_ms_ += kPacketIntervalMs)
+    detector_.OnRtpAudioLevel(kSsrc1, kLoud, false, now_ms_);
+  EXPECT_FALSE(detector_.DominantSpeaker());
+}
+
+TEST_F(ActiveSpeakerDetectorTest, RemovedStreamIsNoLongerDominant) {
+  Talk(kLoud, kQuiet, 1000);
+  EXPECT_EQ(kSsrc1, detector_.DominantSpeaker());
+  detector_.RemoveStream(kSsrc1);
+  EXPECT_FALSE(detector_.DominantSpeaker());
+}
+
+}  // namespace
+}  // namespace webrtc
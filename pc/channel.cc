@@ -485,12 +485,14 @@ void BaseChannel::OnRtpPacket(const webrtc::RtpPacketReceived& parsed_packet) {
     return;
   }
 
-  auto packet_buffer = parsed_packet.Buffer();
-
+  // The parsed packet is handed on, so that it isn't parsed again on its way
+  // to the receive stream.
   invoker_.AsyncInvoke<void>(
-      RTC_FROM_HERE, worker_thread_, [this, packet_buffer, packet_time_us] {
+      RTC_FROM_HERE, worker_thread_,
+      [this, packet = parsed_packet, packet_time_us]() mutable {
         RTC_DCHECK(worker_thread_->IsCurrent());
-        media_channel_->OnPacketReceived(packet_buffer, packet_time_us);
+        media_channel_->OnRtpPacketReceived(std::move(packet),
+                                            packet_time_us);
       });
 }
 
@@ -98,6 +98,18 @@ bool SctpSidAllocator::IsSidAvailable(int sid) const {
   return used_sids_.find(sid) == used_sids_.end();
 }
 
+size_t DataChannelProviderInterface::SendDataBatch(
+    const std::vector<cricket::SendDataParams>& params,
+    const std::vector<rtc::CopyOnWriteBuffer>& payloads,
+    cricket::SendDataResult* result) {
+  RTC_DCHECK_EQ(params.size(), payloads.size());
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    if (!SendData(params[i], payloads[i], result))
+      return i;
+  }
+  return payloads.size();
+}
+
 bool DataChannel::PacketQueue::Empty() const {
   return packets_.empty();
 }
@@ -297,6 +309,41 @@ bool DataChannel::Send(const DataBuffer& buffer) {
   return true;
 }
 
+bool DataChannel::SendMultiple(const std::vector<DataBuffer>& buffers) {
+  if (!IsSctpLike(data_channel_type_)) {
+    // RTP data channels don't queue outgoing data.
+    return DataChannelInterface::SendMultiple(buffers);
+  }
+  for (const DataBuffer& buffer : buffers) {
+    buffered_amount_ += buffer.size();
+  }
+  if (state_ != kOpen) {
+    return false;
+  }
+
+  // Queue all the messages and send the queue, which hands them to the
+  // provider in one batch. If the queue was non-empty, we're waiting for
+  // SignalReadyToSend and the messages are sent along with it.
+  bool was_blocked = !queued_send_data_.Empty();
+  for (const DataBuffer& buffer : buffers) {
+    if (buffer.size() == 0) {
+      continue;
+    }
+    if (!QueueSendDataMessage(buffer)) {
+      RTC_LOG(LS_ERROR) << "Closing the DataChannel due to a failure to queue "
+                           "additional data.";
+      CloseAbruptly();
+      return true;
+    }
+  }
+  if (!was_blocked) {
+    SendQueuedDataMessages();
+  }
+
+  // Always return true for SCTP DataChannel per the spec.
+  return true;
+}
+
 void DataChannel::SetReceiveSsrc(uint32_t receive_ssrc) {
   RTC_DCHECK(data_channel_type_ == cricket::DCT_RTP);
 
@@ -588,52 +635,46 @@ void DataChannel::SendQueuedDataMessages() {
 
   RTC_DCHECK(state_ == kOpen || state_ == kClosing);
 
+  // Hand all the queued messages to the provider in one batch. The payloads
+  // are shared, not copied.
+  std::vector<std::unique_ptr<DataBuffer>> buffers;
+  std::vector<cricket::SendDataParams> params;
+  std::vector<rtc::CopyOnWriteBuffer> payloads;
   while (!queued_send_data_.Empty()) {
-    std::unique_ptr<DataBuffer> buffer = queued_send_data_.PopFront();
-    if (!SendDataMessage(*buffer, false)) {
-      // Return the message to the front of the queue if sending is aborted.
-      queued_send_data_.PushFront(std::move(buffer));
-      break;
-    }
+    buffers.push_back(queued_send_data_.PopFront());
+    params.push_back(GetSendDataParams(*buffers.back()));
+    payloads.push_back(buffers.back()->data);
+  }
+
+  cricket::SendDataResult send_result = cricket::SDR_SUCCESS;
+  size_t sent = provider_->SendDataBatch(params, payloads, &send_result);
+  RTC_DCHECK_LE(sent, buffers.size());
+  // Return the messages that weren't sent to the front of the queue before
+  // notifying the observer, which may call Send() again.
+  for (size_t i = buffers.size(); i > sent; --i) {
+    queued_send_data_.PushFront(std::move(buffers[i - 1]));
+  }
+  for (size_t i = 0; i < sent; ++i) {
+    OnDataMessageSent(*buffers[i]);
+  }
+
+  if (sent < buffers.size() && send_result != cricket::SDR_BLOCK) {
+    RTC_LOG(LS_ERROR) << "Closing the DataChannel due to a failure to send "
+                         "data, send_result = "
+                      << send_result;
+    CloseAbruptly();
   }
 }
 
 bool DataChannel::SendDataMessage(const DataBuffer& buffer,
                                   bool queue_if_blocked) {
-  cricket::SendDataParams send_params;
-
-  if (IsSctpLike(data_channel_type_)) {
-    send_params.ordered = config_.ordered;
-    // Send as ordered if it is still going through OPEN/ACK signaling.
-    if (handshake_state_ != kHandshakeReady && !config_.ordered) {
-      send_params.ordered = true;
-      RTC_LOG(LS_VERBOSE)
-          << "Sending data as ordered for unordered DataChannel "
-             "because the OPEN_ACK message has not been received.";
-    }
-
-    send_params.max_rtx_count =
-        config_.maxRetransmits ? *config_.maxRetransmits : -1;
-    send_params.max_rtx_ms =
-        config_.maxRetransmitTime ? *config_.maxRetransmitTime : -1;
-    send_params.sid = config_.id;
-  } else {
-    send_params.ssrc = send_ssrc_;
-  }
-  send_params.type = buffer.binary ? cricket::DMT_BINARY : cricket::DMT_TEXT;
+  cricket::SendDataParams send_params = GetSendDataParams(buffer);
 
   cricket::SendDataResult send_result = cricket::SDR_SUCCESS;
   bool success = provider_->SendData(send_params, buffer.data, &send_result);
 
   if (success) {
-    ++messages_sent_;
-    bytes_sent_ += buffer.size();
-
-    RTC_DCHECK(buffered_amount_ >= buffer.size());
-    buffered_amount_ -= buffer.size();
-    if (observer_ && buffer.size() > 0) {
-      observer_->OnBufferedAmountChange(buffer.size());
-    }
+    OnDataMessageSent(buffer);
     return true;
   }
 
@@ -656,6 +697,43 @@ bool DataChannel::SendDataMessage(const DataBuffer& buffer,
   return false;
 }
 
+cricket::SendDataParams DataChannel::GetSendDataParams(
+    const DataBuffer& buffer) const {
+  cricket::SendDataParams send_params;
+
+  if (IsSctpLike(data_channel_type_)) {
+    send_params.ordered = config_.ordered;
+    // Send as ordered if it is still going through OPEN/ACK signaling.
+    if (handshake_state_ != kHandshakeReady && !config_.ordered) {
+      send_params.ordered = true;
+      RTC_LOG(LS_VERBOSE)
+          << "Sending data as ordered for unordered DataChannel "
+             "because the OPEN_ACK message has not been received.";
+    }
+
+    send_params.max_rtx_count =
+        config_.maxRetransmits ? *config_.maxRetransmits : -1;
+    send_params.max_rtx_ms =
+        config_.maxRetransmitTime ? *config_.maxRetransmitTime : -1;
+    send_params.sid = config_.id;
+  } else {
+    send_params.ssrc = send_ssrc_;
+  }
+  send_params.type = buffer.binary ? cricket::DMT_BINARY : cricket::DMT_TEXT;
+  return send_params;
+}
+
+void DataChannel::OnDataMessageSent(const DataBuffer& buffer) {
+  ++messages_sent_;
+  bytes_sent_ += buffer.size();
+
+  RTC_DCHECK(buffered_amount_ >= buffer.size());
+  buffered_amount_ -= buffer.size();
+  if (observer_ && buffer.size() > 0) {
+    observer_->OnBufferedAmountChange(buffer.size());
+  }
+}
+
 bool DataChannel::QueueSendDataMessage(const DataBuffer& buffer) {
   size_t start_buffered_amount = queued_send_data_.byte_count();
   if (start_buffered_amount + buffer.size() > kMaxQueuedSendDataBytes) {
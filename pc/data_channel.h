@@ -15,6 +15,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
 #include "api/data_channel_interface.h"
 #include "api/proxy.h"
@@ -48,6 +49,14 @@ class DataChannelProviderInterface {
   virtual void RemoveSctpDataStream(int sid) = 0;
   // Returns true if the transport channel is ready to send data.
   virtual bool ReadyToSendData() const = 0;
+  // Sends |payloads| in order with the matching |params|, stopping at the
+  // first message that isn't sent; |result| is set by the last attempt.
+  // Returns the number of messages sent. Providers that send on another
+  // thread override this to hop there once per batch.
+  virtual size_t SendDataBatch(
+      const std::vector<cricket::SendDataParams>& params,
+      const std::vector<rtc::CopyOnWriteBuffer>& payloads,
+      cricket::SendDataResult* result);
 
  protected:
   virtual ~DataChannelProviderInterface() {}
@@ -151,6 +160,7 @@ class DataChannel : public DataChannelInterface, public sigslot::has_slots<> {
   virtual uint32_t messages_received() const { return messages_received_; }
   virtual uint64_t bytes_received() const { return bytes_received_; }
   virtual bool Send(const DataBuffer& buffer);
+  virtual bool SendMultiple(const std::vector<DataBuffer>& buffers);
 
   // Close immediately, ignoring any queued data or closing procedure.
   // This is called for RTP data channels when SDP indicates a channel should
@@ -266,6 +276,9 @@ class DataChannel : public DataChannelInterface, public sigslot::has_slots<> {
 
   void SendQueuedDataMessages();
   bool SendDataMessage(const DataBuffer& buffer, bool queue_if_blocked);
+  cricket::SendDataParams GetSendDataParams(const DataBuffer& buffer) const;
+  // Updates the counters and the buffered amount after |buffer| is sent.
+  void OnDataMessageSent(const DataBuffer& buffer);
   bool QueueSendDataMessage(const DataBuffer& buffer);
 
   void SendQueuedControlMessages();
@@ -326,6 +339,7 @@ PROXY_CONSTMETHOD0(uint64_t, bytes_received)
 PROXY_CONSTMETHOD0(uint64_t, buffered_amount)
 PROXY_METHOD0(void, Close)
 PROXY_METHOD1(bool, Send, const DataBuffer&)
+PROXY_METHOD1(bool, SendMultiple, const std::vector<DataBuffer>&)
 END_PROXY_MAP()
 
 }  // namespace webrtc
@@ -275,6 +275,58 @@ TEST_F(SctpDataChannelTest, VerifyMessagesAndBytesSent) {
   EXPECT_EQ(bytes_sent, webrtc_data_channel_->bytes_sent());
 }
 
+// Tests that the queued data is handed to the provider in one batch when the
+// channel is unblocked.
+TEST_F(SctpDataChannelTest, QueuedDataSentInOneBatch) {
+  AddObserver();
+  SetChannelReady();
+  webrtc::DataBuffer buffer("abcd");
+  provider_->set_send_blocked(true);
+  const int number_of_packets = 3;
+  for (int i = 0; i < number_of_packets; ++i) {
+    EXPECT_TRUE(webrtc_data_channel_->Send(buffer));
+  }
+  int batch_count = provider_->send_data_batch_count();
+
+  provider_->set_send_blocked(false);
+  EXPECT_EQ(batch_count + 1, provider_->send_data_batch_count());
+  EXPECT_EQ(0U, webrtc_data_channel_->buffered_amount());
+  EXPECT_EQ(static_cast<uint32_t>(number_of_packets),
+            webrtc_data_channel_->messages_sent());
+  EXPECT_EQ(static_cast<size_t>(number_of_packets),
+            observer_->on_buffered_amount_change_count());
+}
+
+// Tests that SendMultiple() hands all the messages to the provider in one
+// batch, and queues them if the channel is blocked.
+TEST_F(SctpDataChannelTest, SendMultiple) {
+  AddObserver();
+  SetChannelReady();
+  std::vector<webrtc::DataBuffer> buffers({
+      webrtc::DataBuffer("message 1"),
+      webrtc::DataBuffer("msg 2"),
+      webrtc::DataBuffer("message three"),
+  });
+  size_t bytes = buffers[0].size() + buffers[1].size() + buffers[2].size();
+  int batch_count = provider_->send_data_batch_count();
+
+  EXPECT_TRUE(webrtc_data_channel_->SendMultiple(buffers));
+  EXPECT_EQ(batch_count + 1, provider_->send_data_batch_count());
+  EXPECT_EQ(0U, webrtc_data_channel_->buffered_amount());
+  EXPECT_EQ(3U, webrtc_data_channel_->messages_sent());
+  EXPECT_EQ(bytes, webrtc_data_channel_->bytes_sent());
+
+  provider_->set_send_blocked(true);
+  EXPECT_TRUE(webrtc_data_channel_->SendMultiple(buffers));
+  EXPECT_EQ(bytes, webrtc_data_channel_->buffered_amount());
+  EXPECT_EQ(3U, webrtc_data_channel_->messages_sent());
+
+  provider_->set_send_blocked(false);
+  EXPECT_EQ(0U, webrtc_data_channel_->buffered_amount());
+  EXPECT_EQ(6U, webrtc_data_channel_->messages_sent());
+  EXPECT_EQ(2 * bytes, webrtc_data_channel_->bytes_sent());
+}
+
 // Tests that the queued control message is sent when channel is ready.
 TEST_F(SctpDataChannelTest, OpenMessageSent) {
   // Initially the id is unassigned.
@@ -51,11 +51,6 @@ const char kDisableDatagramToRtcpFeebackTranslationFieldTrial[] =
 
 }  // namespace
 
-// Maximum packet size of RTCP feedback packet for allocation. We re-create RTCP
-// feedback packets when we get ACK notifications from datagram transport. Our
-// rtcp feedback packets contain only 1 ACK, so they are much smaller than 1250.
-constexpr size_t kMaxRtcpFeedbackPacketSize = 1250;
-
 DatagramRtpTransport::DatagramRtpTransport(
     const std::vector<RtpExtension>& rtp_header_extensions,
     cricket::IceTransportInternal* ice_transport,
@@ -293,18 +288,71 @@ void DatagramRtpTransport::OnDatagramAcked(const DatagramAck& ack) {
   // which is guaranteed by SentPacketInfo constructor.
   RTC_CHECK(sent_packet_info.ssrc);
 
-  // Recreate RTCP feedback packet.
-  rtcp::TransportFeedback feedback_packet;
-  feedback_packet.SetMediaSsrc(*sent_packet_info.ssrc);
+  const bool first_pending_ack = acked_packets_.empty();
+  acked_packets_.push_back({*sent_packet_info.ssrc,
+                            transport_sequence_number_unwrapper_.Unwrap(
+                                *sent_packet_info.transport_sequence_number),
+                            receive_timestamp_us});
+  if (!first_pending_ack)
+    return;
+
+  // Report the acks once the datagram transport is done with the current
+  // batch of them.
+  rtc::Thread* current_thread = rtc::Thread::Current();
+  if (current_thread == nullptr) {
+    SendPendingFeedback();
+    return;
+  }
+  invoker_.AsyncInvoke<void>(RTC_FROM_HERE, current_thread,
+                             [this] { SendPendingFeedback(); });
+}
 
-  const uint16_t transport_sequence_number =
-      sent_packet_info.transport_sequence_number.value();
+void DatagramRtpTransport::SendPendingFeedback() {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  if (acked_packets_.empty())
+    return;
 
-  feedback_packet.SetBase(transport_sequence_number, receive_timestamp_us);
-  feedback_packet.AddReceivedPacket(transport_sequence_number,
-                                    receive_timestamp_us);
+  std::sort(acked_packets_.begin(), acked_packets_.end(),
+            [](const AckedPacketInfo& a, const AckedPacketInfo& b) {
+              return a.unwrapped_transport_sequence_number <
+                     b.unwrapped_transport_sequence_number;
+            });
+
+  // Only runs of consecutive sequence numbers share a feedback packet. The
+  // datagrams in a gap may still be in flight, so the gaps split the feedback
+  // packets instead of being reported as lost.
+  std::unique_ptr<rtcp::TransportFeedback> feedback_packet;
+  int64_t previous_sequence_number = 0;
+  for (const AckedPacketInfo& acked_packet : acked_packets_) {
+    const int64_t sequence_number =
+        acked_packet.unwrapped_transport_sequence_number;
+    if (feedback_packet && sequence_number == previous_sequence_number) {
+      // Duplicate ack.
+      continue;
+    }
+    if (!feedback_packet || sequence_number != previous_sequence_number + 1 ||
+        !feedback_packet->AddReceivedPacket(
+            static_cast<uint16_t>(sequence_number),
+            acked_packet.receive_timestamp_us)) {
+      if (feedback_packet)
+        SendFeedbackPacket(*feedback_packet);
+      feedback_packet = std::make_unique<rtcp::TransportFeedback>();
+      feedback_packet->SetMediaSsrc(acked_packet.ssrc);
+      feedback_packet->SetBase(static_cast<uint16_t>(sequence_number),
+                               acked_packet.receive_timestamp_us);
+      feedback_packet->AddReceivedPacket(
+          static_cast<uint16_t>(sequence_number),
+          acked_packet.receive_timestamp_us);
+    }
+    previous_sequence_number = sequence_number;
+  }
+  SendFeedbackPacket(*feedback_packet);
+  acked_packets_.clear();
+}
 
-  rtc::CopyOnWriteBuffer buffer(kMaxRtcpFeedbackPacketSize);
+void DatagramRtpTransport::SendFeedbackPacket(
+    const rtcp::TransportFeedback& feedback_packet) {
+  rtc::CopyOnWriteBuffer buffer(feedback_packet.BlockLength());
   size_t index = 0;
   if (!feedback_packet.Create(buffer.data(), &index, buffer.capacity(),
                               nullptr)) {
@@ -313,7 +361,7 @@ void DatagramRtpTransport::OnDatagramAcked(const DatagramAck& ack) {
   }
 
   RTC_CHECK_GT(index, 0);
-  RTC_CHECK_LE(index, kMaxRtcpFeedbackPacketSize);
+  RTC_CHECK_LE(index, buffer.capacity());
 
   // Propagage created RTCP packet as normal incoming packet.
   buffer.SetSize(index);
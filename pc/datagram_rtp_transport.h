@@ -23,9 +23,11 @@
 #include "p2p/base/ice_transport_internal.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "pc/rtp_transport_internal.h"
+#include "rtc_base/async_invoker.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/buffer_queue.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
 #include "rtc_base/strings/string_builder.h"
@@ -33,6 +35,10 @@
 
 namespace webrtc {
 
+namespace rtcp {
+class TransportFeedback;
+}  // namespace rtcp
+
 constexpr int kDatagramDtlsAdaptorComponent = -1;
 
 // RTP transport which uses the DatagramTransportInterface to send and receive
@@ -125,6 +131,13 @@ class DatagramRtpTransport : public RtpTransportInternal,
     int64_t packet_id = 0;
   };
 
+  // Acked RTP packet waiting to be reported in RTCP feedback.
+  struct AckedPacketInfo {
+    uint32_t ssrc;
+    int64_t unwrapped_transport_sequence_number;
+    int64_t receive_timestamp_us;
+  };
+
   // Finds SentPacketInfo for given |datagram_id| and removes map entry.
   // Returns false if entry was not found.
   bool GetAndRemoveSentPacketInfo(webrtc::DatagramId datagram_id,
@@ -134,6 +147,13 @@ class DatagramRtpTransport : public RtpTransportInternal,
   bool SendDatagram(rtc::ArrayView<const uint8_t> data,
                     webrtc::DatagramId datagram_id);
 
+  // Reports the packets in |acked_packets_| in as few RTCP feedback packets as
+  // possible, and clears it.
+  void SendPendingFeedback();
+
+  // Propagates |feedback_packet| as an incoming RTCP packet.
+  void SendFeedbackPacket(const rtcp::TransportFeedback& feedback_packet);
+
   // Propagates network route changes from ICE.
   void OnNetworkRouteChanged(absl::optional<rtc::NetworkRoute> network_route);
 
@@ -161,6 +181,13 @@ class DatagramRtpTransport : public RtpTransportInternal,
   // transport. Investigate if we can eliminate zero timestamps.
   int64_t previous_nonzero_timestamp_us_ = 0;
 
+  // Datagram transports typically report the acks of a whole ack frame in a
+  // row. They are collected here and reported together once the current task
+  // is done, instead of creating and parsing a feedback packet per ack.
+  std::vector<AckedPacketInfo> acked_packets_;
+  SeqNumUnwrapper<uint16_t> transport_sequence_number_unwrapper_;
+  rtc::AsyncInvoker invoker_;
+
   // Disable datagram to RTCP feedback translation and enable RTCP feedback
   // loop (note that having both RTCP and datagram feedback loops is
   // inefficient, but can be useful in tests and experiments).
@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "pc/datagram_rtp_transport.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "api/test/fake_datagram_transport.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "p2p/base/fake_ice_transport.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kTransportSequenceNumberId = 5;
+constexpr uint32_t kSsrc = 1234;
+
+class FeedbackObserver : public sigslot::has_slots<> {
+ public:
+  explicit FeedbackObserver(DatagramRtpTransport* transport) {
+    transport->SignalRtcpPacketReceived.connect(
+        this, &FeedbackObserver::OnRtcpPacketReceived);
+  }
+
+  void OnRtcpPacketReceived(rtc::CopyOnWriteBuffer* packet,
+                            int64_t /*packet_time_us*/) {
+    rtcp::CommonHeader header;
+    ASSERT_TRUE(header.Parse(packet->cdata(), packet->size()));
+    rtcp::TransportFeedback feedback;
+    ASSERT_TRUE(feedback.Parse(header));
+    std::vector<uint16_t> sequence_numbers;
+    for (const auto& received_packet : feedback.GetReceivedPackets())
+      sequence_numbers.push_back(received_packet.sequence_number());
+    feedback_packets_.push_back(sequence_numbers);
+  }
+
+  // Received sequence numbers of each feedback packet.
+  const std::vector<std::vector<uint16_t>>& feedback_packets() const {
+    return feedback_packets_;
+  }
+
+ private:
+  std::vector<std::vector<uint16_t>> feedback_packets_;
+};
+
+class DatagramRtpTransportTest : public ::testing::Test {
+ protected:
+  DatagramRtpTransportTest()
+      : ice_transport_("test", 1),
+        datagram_transport_(MediaTransportSettings(), ""),
+        transport_({RtpExtension(TransportSequenceNumber::kUri,
+                                 kTransportSequenceNumberId)},
+                   &ice_transport_,
+                   &datagram_transport_),
+        observer_(&transport_) {}
+
+  // Sends an RTP packet, which gets the next datagram id.
+  void SendRtpPacket(uint16_t transport_sequence_number) {
+    RtpHeaderExtensionMap extensions;
+    extensions.Register<TransportSequenceNumber>(kTransportSequenceNumberId);
+    RtpPacketToSend packet(&extensions);
+    packet.SetSsrc(kSsrc);
+    packet.SetExtension<TransportSequenceNumber>(transport_sequence_number);
+    packet.AllocatePayload(100);
+    rtc::CopyOnWriteBuffer buffer = packet.Buffer();
+    ASSERT_TRUE(transport_.SendRtpPacket(&buffer, rtc::PacketOptions(), 0));
+  }
+
+  void AckDatagram(DatagramId datagram_id) {
+    DatagramAck ack;
+    ack.datagram_id = datagram_id;
+    ack.receive_timestamp = Timestamp::ms(1000 + datagram_id);
+    transport_.OnDatagramAcked(ack);
+  }
+
+  cricket::FakeIceTransport ice_transport_;
+  FakeDatagramTransport datagram_transport_;
+  DatagramRtpTransport transport_;
+  FeedbackObserver observer_;
+};
+
+}  // namespace
+
+TEST_F(DatagramRtpTransportTest, ReportsAcksTogether) {
+  for (uint16_t sequence_number = 0; sequence_number < 5; ++sequence_number)
+    SendRtpPacket(sequence_number);
+  AckDatagram(1);
+  AckDatagram(0);
+  AckDatagram(2);
+  AckDatagram(4);
+  EXPECT_TRUE(observer_.feedback_packets().empty());
+
+  rtc::Thread::Current()->ProcessMessages(0);
+  // The gap at the datagram that is not acked yet splits the feedback.
+  const std::vector<std::vector<uint16_t>> kExpectedFeedbackPackets = {
+      {0, 1, 2}, {4}};
+  EXPECT_EQ(kExpectedFeedbackPackets, observer_.feedback_packets());
+
+  AckDatagram(3);
+  rtc::Thread::Current()->ProcessMessages(0);
+  ASSERT_EQ(3u, observer_.feedback_packets().size());
+  EXPECT_EQ(std::vector<uint16_t>({3}), observer_.feedback_packets()[2]);
+}
+
+}  // namespace webrtc
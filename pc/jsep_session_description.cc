@@ -210,6 +210,7 @@ bool JsepSessionDescription::Initialize(
   session_version_ = session_version;
   description_ = std::move(description);
   candidate_collection_.resize(number_of_mediasections());
+  serialized_sections_.clear();
   return true;
 }
 
@@ -250,6 +251,7 @@ bool JsepSessionDescription::AddCandidate(
     UpdateConnectionAddress(
         candidate_collection_[mediasection_index],
         description_->contents()[mediasection_index].media_description());
+    InvalidateSerializedSection(mediasection_index);
   }
 
   return true;
@@ -268,6 +270,7 @@ size_t JsepSessionDescription::RemoveCandidates(
     UpdateConnectionAddress(
         candidate_collection_[mediasection_index],
         description_->contents()[mediasection_index].media_description());
+    InvalidateSerializedSection(mediasection_index);
   }
   return num_removed;
 }
@@ -289,10 +292,16 @@ bool JsepSessionDescription::ToString(std::string* out) const {
   if (!description_ || !out) {
     return false;
   }
-  *out = SdpSerialize(*this);
+  *out = SdpSerialize(*this, &serialized_sections_);
   return !out->empty();
 }
 
+void JsepSessionDescription::InvalidateSerializedSection(size_t index) {
+  if (index < serialized_sections_.size()) {
+    serialized_sections_[index].clear();
+  }
+}
+
 bool JsepSessionDescription::GetMediasectionIndex(
     const IceCandidateInterface* candidate,
     size_t* index) {
@@ -26,6 +26,7 @@
 #include "p2p/base/port.h"
 #include "p2p/base/transport_description.h"
 #include "p2p/base/transport_info.h"
+#include "pc/media_session.h"
 #include "pc/session_description.h"
 #include "pc/webrtc_sdp.h"
 #include "rtc_base/helpers.h"
@@ -294,6 +295,42 @@ TEST_F(JsepSessionDescriptionTest, SerializeDeserializeWithCandidates) {
   EXPECT_EQ(sdp_with_candidate, parsed_sdp_with_candidate);
 }
 
+// Test that the m= sections cached by ToString() are serialized again when
+// their candidates change, and match a serialization without the cache.
+TEST_F(JsepSessionDescriptionTest, SerializeAfterCandidatesChange) {
+  Serialize(jsep_desc_.get());
+
+  JsepIceCandidate jsep_candidate("video", 1, candidate_);
+  EXPECT_TRUE(jsep_desc_->AddCandidate(&jsep_candidate));
+  std::string sdp = Serialize(jsep_desc_.get());
+  EXPECT_NE(std::string::npos, sdp.find("a=candidate"));
+  EXPECT_EQ(webrtc::SdpSerialize(*jsep_desc_), sdp);
+  // Serializing again reuses every section.
+  EXPECT_EQ(sdp, Serialize(jsep_desc_.get()));
+
+  std::vector<cricket::Candidate> candidates(1, candidate_);
+  candidates[0].set_transport_name("video");
+  EXPECT_EQ(1u, jsep_desc_->RemoveCandidates(candidates));
+  sdp = Serialize(jsep_desc_.get());
+  EXPECT_EQ(std::string::npos, sdp.find("a=candidate"));
+  EXPECT_EQ(webrtc::SdpSerialize(*jsep_desc_), sdp);
+}
+
+// Test that changes made through description() after ToString() are
+// serialized.
+TEST_F(JsepSessionDescriptionTest, SerializeAfterDescriptionChanges) {
+  std::string sdp = Serialize(jsep_desc_.get());
+  EXPECT_EQ(std::string::npos, sdp.find("a=rtcp-mux"));
+
+  cricket::ContentInfo* audio =
+      cricket::GetFirstAudioContent(jsep_desc_->description());
+  ASSERT_TRUE(audio);
+  audio->media_description()->set_rtcp_mux(true);
+  sdp = Serialize(jsep_desc_.get());
+  EXPECT_NE(std::string::npos, sdp.find("a=rtcp-mux"));
+  EXPECT_EQ(webrtc::SdpSerialize(*jsep_desc_), sdp);
+}
+
 // TODO(zhihuang): Modify these tests. These are used to verify that after
 // adding the candidates, the connection_address field is set correctly. Modify
 // those so that the "connection address" is tested directly.
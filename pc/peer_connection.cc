@@ -647,6 +647,29 @@ const ContentInfo* FindTransceiverMSection(
              : nullptr;
 }
 
+SendDataParams ToWebrtcSendDataParams(const cricket::SendDataParams& params) {
+  SendDataParams send_params;
+  send_params.type = ToWebrtcDataMessageType(params.type);
+  send_params.ordered = params.ordered;
+  if (params.max_rtx_count >= 0) {
+    send_params.max_rtx_count = params.max_rtx_count;
+  } else if (params.max_rtx_ms >= 0) {
+    send_params.max_rtx_ms = params.max_rtx_ms;
+  }
+  return send_params;
+}
+
+cricket::SendDataResult ToCricketSendDataResult(const RTCError& error) {
+  if (error.ok()) {
+    return cricket::SendDataResult::SDR_SUCCESS;
+  } else if (error.type() == RTCErrorType::RESOURCE_EXHAUSTED) {
+    // SCTP transport uses RESOURCE_EXHAUSTED when it's blocked.
+    // TODO(mellem):  Stop using RTCError here and get rid of the mapping.
+    return cricket::SendDataResult::SDR_BLOCK;
+  }
+  return cricket::SendDataResult::SDR_ERROR;
+}
+
 }  // namespace
 
 class PeerConnection::LocalIceCredentialsToReplace {
@@ -1980,6 +2003,16 @@ void PeerConnection::GetStats(
   stats_collector_->GetStatsReport(internal_receiver, callback);
 }
 
+void PeerConnection::GetStats(
+    const std::set<std::string>& stats_types,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  TRACE_EVENT0("webrtc", "PeerConnection::GetStats");
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  RTC_DCHECK(callback);
+  RTC_DCHECK(stats_collector_);
+  stats_collector_->GetStatsReport(stats_types, callback);
+}
+
 PeerConnectionInterface::SignalingState PeerConnection::signaling_state() {
   RTC_DCHECK_RUN_ON(signaling_thread());
   return signaling_state_;
@@ -5835,7 +5868,10 @@ RTCError PeerConnection::PushdownMediaDescription(
                                    : remote_description());
   RTC_DCHECK(sdesc);
 
-  // Push down the new SDP media section for each audio/video transceiver.
+  // Collect the new SDP media section for each audio/video transceiver.
+  std::vector<std::pair<cricket::ChannelInterface*,
+                        const MediaContentDescription*>>
+      channel_contents;
   for (const auto& transceiver : transceivers_) {
     const ContentInfo* content_info =
         FindMediaSectionForTransceiver(transceiver, sdesc);
@@ -5848,13 +5884,7 @@ RTCError PeerConnection::PushdownMediaDescription(
     if (!content_desc) {
       continue;
     }
-    std::string error;
-    bool success = (source == cricket::CS_LOCAL)
-                       ? channel->SetLocalContent(content_desc, type, &error)
-                       : channel->SetRemoteContent(content_desc, type, &error);
-    if (!success) {
-      LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER, error);
-    }
+    channel_contents.emplace_back(channel, content_desc);
   }
 
   // If using the RtpDataChannel, push down the new SDP section for it too.
@@ -5865,15 +5895,29 @@ RTCError PeerConnection::PushdownMediaDescription(
       const MediaContentDescription* data_desc =
           data_content->media_description();
       if (data_desc) {
+        channel_contents.emplace_back(rtp_data_channel_, data_desc);
+      }
+    }
+  }
+
+  // Push them all down in a single hop to the worker thread, where the
+  // channels apply them, instead of one blocking hop per channel.
+  if (!channel_contents.empty()) {
+    RTCError error = worker_thread()->Invoke<RTCError>(RTC_FROM_HERE, [&] {
+      for (const auto& entry : channel_contents) {
         std::string error;
         bool success =
             (source == cricket::CS_LOCAL)
-                ? rtp_data_channel_->SetLocalContent(data_desc, type, &error)
-                : rtp_data_channel_->SetRemoteContent(data_desc, type, &error);
+                ? entry.first->SetLocalContent(entry.second, type, &error)
+                : entry.first->SetRemoteContent(entry.second, type, &error);
         if (!success) {
           LOG_AND_RETURN_ERROR(RTCErrorType::INVALID_PARAMETER, error);
         }
       }
+      return RTCError::OK();
+    });
+    if (!error.ok()) {
+      return error;
     }
   }
 
@@ -5987,32 +6031,14 @@ bool PeerConnection::SendData(const cricket::SendDataParams& params,
                               cricket::SendDataResult* result) {
   RTC_DCHECK_RUN_ON(signaling_thread());
   if (data_channel_transport_) {
-    SendDataParams send_params;
-    send_params.type = ToWebrtcDataMessageType(params.type);
-    send_params.ordered = params.ordered;
-    if (params.max_rtx_count >= 0) {
-      send_params.max_rtx_count = params.max_rtx_count;
-    } else if (params.max_rtx_ms >= 0) {
-      send_params.max_rtx_ms = params.max_rtx_ms;
-    }
-
+    SendDataParams send_params = ToWebrtcSendDataParams(params);
     RTCError error = network_thread()->Invoke<RTCError>(
         RTC_FROM_HERE, [this, params, send_params, payload] {
           return data_channel_transport_->SendData(params.sid, send_params,
                                                    payload);
         });
-
-    if (error.ok()) {
-      *result = cricket::SendDataResult::SDR_SUCCESS;
-      return true;
-    } else if (error.type() == RTCErrorType::RESOURCE_EXHAUSTED) {
-      // SCTP transport uses RESOURCE_EXHAUSTED when it's blocked.
-      // TODO(mellem):  Stop using RTCError here and get rid of the mapping.
-      *result = cricket::SendDataResult::SDR_BLOCK;
-      return false;
-    }
-    *result = cricket::SendDataResult::SDR_ERROR;
-    return false;
+    *result = ToCricketSendDataResult(error);
+    return error.ok();
   } else if (rtp_data_channel_) {
     return rtp_data_channel_->SendData(params, payload, result);
   }
@@ -6020,6 +6046,32 @@ bool PeerConnection::SendData(const cricket::SendDataParams& params,
   return false;
 }
 
+size_t PeerConnection::SendDataBatch(
+    const std::vector<cricket::SendDataParams>& params,
+    const std::vector<rtc::CopyOnWriteBuffer>& payloads,
+    cricket::SendDataResult* result) {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  RTC_DCHECK_EQ(params.size(), payloads.size());
+  if (!data_channel_transport_) {
+    return DataChannelProviderInterface::SendDataBatch(params, payloads,
+                                                       result);
+  }
+
+  // Hop to the network thread once for the whole batch.
+  RTCError error;
+  size_t sent = network_thread()->Invoke<size_t>(RTC_FROM_HERE, [&] {
+    for (size_t i = 0; i < payloads.size(); ++i) {
+      error = data_channel_transport_->SendData(
+          params[i].sid, ToWebrtcSendDataParams(params[i]), payloads[i]);
+      if (!error.ok())
+        return i;
+    }
+    return payloads.size();
+  });
+  *result = ToCricketSendDataResult(error);
+  return sent;
+}
+
 bool PeerConnection::ConnectDataChannel(DataChannel* webrtc_data_channel) {
   RTC_DCHECK_RUN_ON(signaling_thread());
   if (!rtp_data_channel_ && !data_channel_transport_) {
@@ -7348,6 +7400,56 @@ void PeerConnection::ClearStatsCache() {
   }
 }
 
+MemoryUsageReport PeerConnection::GetMemoryUsageReport() {
+  RTC_DCHECK_RUN_ON(signaling_thread());
+  std::vector<cricket::VoiceMediaChannel*> voice_channels;
+  std::vector<cricket::VideoMediaChannel*> video_channels;
+  for (const auto& transceiver : transceivers_) {
+    cricket::ChannelInterface* channel = transceiver->internal()->channel();
+    if (!channel)
+      continue;
+    if (channel->media_type() == cricket::MEDIA_TYPE_AUDIO) {
+      voice_channels.push_back(
+          static_cast<cricket::VoiceChannel*>(channel)->media_channel());
+    } else if (channel->media_type() == cricket::MEDIA_TYPE_VIDEO) {
+      video_channels.push_back(
+          static_cast<cricket::VideoChannel*>(channel)->media_channel());
+    }
+  }
+
+  MemoryUsageReport report;
+  worker_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+    for (cricket::VoiceMediaChannel* media_channel : voice_channels) {
+      cricket::VoiceMediaInfo info;
+      if (!media_channel->GetStats(&info))
+        continue;
+      for (const cricket::VoiceSenderInfo& sender : info.senders) {
+        report.audio_rtp_packet_history_bytes +=
+            sender.rtp_packet_history_bytes;
+        report.rtp_packet_history_max_packets +=
+            sender.rtp_packet_history_max_packets;
+      }
+      for (const cricket::VoiceReceiverInfo& receiver : info.receivers) {
+        report.audio_jitter_buffer_bytes += receiver.jitter_buffer_bytes;
+        report.audio_jitter_buffer_max_packets +=
+            receiver.jitter_buffer_max_packets;
+      }
+    }
+    for (cricket::VideoMediaChannel* media_channel : video_channels) {
+      cricket::VideoMediaInfo info;
+      if (!media_channel->GetStats(&info))
+        continue;
+      for (const cricket::VideoSenderInfo& sender : info.senders) {
+        report.video_rtp_packet_history_bytes +=
+            sender.rtp_packet_history_bytes;
+        report.rtp_packet_history_max_packets +=
+            sender.rtp_packet_history_max_packets;
+      }
+    }
+  });
+  return report;
+}
+
 void PeerConnection::RequestUsagePatternReportForTesting() {
   signaling_thread()->Post(RTC_FROM_HERE, this, MSG_REPORT_USAGE_PATTERN,
                            nullptr);
@@ -181,7 +181,11 @@ class PeerConnection : public PeerConnectionInternal,
   void GetStats(
       rtc::scoped_refptr<RtpReceiverInterface> selector,
       rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
+  void GetStats(
+      const std::set<std::string>& stats_types,
+      rtc::scoped_refptr<RTCStatsCollectorCallback> callback) override;
   void ClearStatsCache() override;
+  MemoryUsageReport GetMemoryUsageReport() override;
 
   SignalingState signaling_state() override;
 
@@ -925,6 +929,9 @@ class PeerConnection : public PeerConnectionInternal,
   bool SendData(const cricket::SendDataParams& params,
                 const rtc::CopyOnWriteBuffer& payload,
                 cricket::SendDataResult* result) override;
+  size_t SendDataBatch(const std::vector<cricket::SendDataParams>& params,
+                       const std::vector<rtc::CopyOnWriteBuffer>& payloads,
+                       cricket::SendDataResult* result) override;
   bool ConnectDataChannel(DataChannel* webrtc_data_channel) override;
   void DisconnectDataChannel(DataChannel* webrtc_data_channel) override;
   void AddSctpDataStream(int sid) override;
@@ -39,18 +39,23 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/field_trial_parser.h"
 #include "rtc_base/experiments/field_trial_units.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace webrtc {
 
 rtc::scoped_refptr<PeerConnectionFactoryInterface>
 CreateModularPeerConnectionFactory(
     PeerConnectionFactoryDependencies dependencies) {
+  const int64_t start_time_ms = rtc::TimeMillis();
   rtc::scoped_refptr<PeerConnectionFactory> pc_factory(
       new rtc::RefCountedObject<PeerConnectionFactory>(
           std::move(dependencies)));
+  const int64_t threads_started_time_ms = rtc::TimeMillis();
   // Call Initialize synchronously but make sure it is executed on
   // |signaling_thread|.
   MethodCall0<PeerConnectionFactory, bool> call(
@@ -60,6 +65,16 @@ CreateModularPeerConnectionFactory(
   if (!result) {
     return nullptr;
   }
+  // Startup time breakdown. The media engine part is reported by Initialize().
+  const int64_t threads_time_ms = threads_started_time_ms - start_time_ms;
+  const int64_t total_time_ms = rtc::TimeMillis() - start_time_ms;
+  RTC_LOG(LS_INFO) << "PeerConnectionFactory created in " << total_time_ms
+                   << " ms, " << threads_time_ms << " ms of which starting "
+                   << "threads.";
+  RTC_HISTOGRAM_COUNTS_10000("WebRTC.PeerConnectionFactory.CreateTimeMs",
+                             total_time_ms);
+  RTC_HISTOGRAM_COUNTS_10000(
+      "WebRTC.PeerConnectionFactory.StartThreadsTimeMs", threads_time_ms);
   return PeerConnectionFactoryProxy::Create(pc_factory->signaling_thread(),
                                             pc_factory);
 }
@@ -139,14 +154,33 @@ bool PeerConnectionFactory::Initialize() {
       worker_thread_, network_thread_);
 
   channel_manager_->SetVideoRtxEnabled(true);
+  const int64_t media_engine_start_time_ms = rtc::TimeMillis();
   if (!channel_manager_->Init()) {
     return false;
   }
+  const int64_t media_engine_time_ms =
+      rtc::TimeMillis() - media_engine_start_time_ms;
+  RTC_LOG(LS_INFO) << "Media engine initialized in " << media_engine_time_ms
+                   << " ms";
+  RTC_HISTOGRAM_COUNTS_10000(
+      "WebRTC.PeerConnectionFactory.MediaEngineInitTimeMs",
+      media_engine_time_ms);
 
   return true;
 }
 
 void PeerConnectionFactory::SetOptions(const Options& options) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  if (options.certificate_pool_size <= 0) {
+    certificate_pool_ = nullptr;
+  } else if (!certificate_pool_ ||
+             certificate_pool_->depth() !=
+                 static_cast<size_t>(options.certificate_pool_size)) {
+    // Certificates use the same network thread as the default generator.
+    certificate_pool_ = rtc::RTCCertificatePool::Create(
+        signaling_thread_, network_thread_, rtc::KeyParams(),
+        options.certificate_pool_size);
+  }
   options_ = options;
 }
 
@@ -248,8 +282,8 @@ PeerConnectionFactory::CreatePeerConnection(
   // Set internal defaults if optional dependencies are not set.
   if (!dependencies.cert_generator) {
     dependencies.cert_generator =
-        std::make_unique<rtc::RTCCertificateGenerator>(signaling_thread_,
-                                                       network_thread_);
+        std::make_unique<rtc::RTCCertificateGenerator>(
+            signaling_thread_, network_thread_, certificate_pool_);
   }
   if (!dependencies.allocator) {
     rtc::PacketSocketFactory* packet_socket_factory;
@@ -127,6 +127,8 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   std::unique_ptr<NetworkControllerFactoryInterface>
       injected_network_controller_factory_;
   std::unique_ptr<MediaTransportFactory> media_transport_factory_;
+  // Set when |Options::certificate_pool_size| is non-zero.
+  rtc::scoped_refptr<rtc::RTCCertificatePool> certificate_pool_;
 };
 
 }  // namespace webrtc
@@ -2463,6 +2463,39 @@ TEST_F(PeerConnectionIntegrationTestUnifiedPlan,
   ASSERT_TRUE(ExpectNewFrames(media_expectations));
 }
 
+// Measures how long SetRemoteDescription of an initial offer takes as the
+// number of transceivers grows, which is dominated by blocking hops to the
+// worker and network threads. Run with --gtest_also_run_disabled_tests to get
+// the times logged.
+TEST_F(PeerConnectionIntegrationTestUnifiedPlan,
+       DISABLED_SetRemoteDescriptionPerf) {
+  for (int num_transceivers : {1, 10, 50}) {
+    ASSERT_TRUE(CreatePeerConnectionWrappers());
+    for (int i = 0; i < num_transceivers; ++i) {
+      caller()->pc()->AddTransceiver(i % 2 == 0 ? cricket::MEDIA_TYPE_AUDIO
+                                                : cricket::MEDIA_TYPE_VIDEO);
+    }
+    rtc::scoped_refptr<MockCreateSessionDescriptionObserver> offer_observer(
+        new rtc::RefCountedObject<MockCreateSessionDescriptionObserver>());
+    caller()->pc()->CreateOffer(
+        offer_observer, PeerConnectionInterface::RTCOfferAnswerOptions());
+    ASSERT_TRUE_WAIT(offer_observer->called(), kDefaultTimeout);
+    std::unique_ptr<SessionDescriptionInterface> offer =
+        offer_observer->MoveDescription();
+    ASSERT_TRUE(offer);
+
+    rtc::scoped_refptr<MockSetSessionDescriptionObserver> observer(
+        new rtc::RefCountedObject<MockSetSessionDescriptionObserver>());
+    int64_t start_us = rtc::TimeMicros();
+    callee()->pc()->SetRemoteDescription(observer, offer.release());
+    int64_t elapsed_us = rtc::TimeMicros() - start_us;
+    ASSERT_TRUE_WAIT(observer->called(), kDefaultTimeout);
+    EXPECT_TRUE(observer->result());
+    RTC_LOG(LS_INFO) << "SetRemoteDescription with " << num_transceivers
+                     << " transceivers: " << elapsed_us << " us.";
+  }
+}
+
 // Tests that video flows between multiple video tracks when SSRCs are not
 // signaled. This exercises the MID RTP header extension which is needed to
 // demux the incoming video tracks.
@@ -821,6 +821,18 @@ void ProduceReceiverMediaTrackStats(
   }
 }
 
+rtc::scoped_refptr<RTCStatsReport> CreateReportFilteredByTypes(
+    const std::set<std::string>& stats_types,
+    rtc::scoped_refptr<const RTCStatsReport> report) {
+  rtc::scoped_refptr<RTCStatsReport> filtered_report =
+      RTCStatsReport::Create(report->timestamp_us());
+  for (const RTCStats& stats : *report) {
+    if (stats_types.find(stats.type()) != stats_types.end())
+      filtered_report->AddStats(stats.copy());
+  }
+  return filtered_report;
+}
+
 rtc::scoped_refptr<RTCStatsReport> CreateReportFilteredBySelector(
     bool filter_by_sender_selector,
     rtc::scoped_refptr<const RTCStatsReport> report,
@@ -895,6 +907,16 @@ RTCStatsCollector::RequestInfo::RequestInfo(
                   nullptr,
                   std::move(selector)) {}
 
+RTCStatsCollector::RequestInfo::RequestInfo(
+    std::set<std::string> stats_types,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback)
+    : RequestInfo(FilterMode::kTypeSelector,
+                  std::move(callback),
+                  nullptr,
+                  nullptr) {
+  stats_types_ = std::move(stats_types);
+}
+
 RTCStatsCollector::RequestInfo::RequestInfo(
     RTCStatsCollector::RequestInfo::FilterMode filter_mode,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback,
@@ -908,6 +930,39 @@ RTCStatsCollector::RequestInfo::RequestInfo(
   RTC_DCHECK(!sender_selector_ || !receiver_selector_);
 }
 
+uint32_t RTCStatsCollector::RequestInfo::stats_families() const {
+  if (filter_mode_ != FilterMode::kTypeSelector) {
+    // The stats selection algorithm follows the references of the RTP streams,
+    // which lead to most other stats, so everything is gathered.
+    return kAllStatsFamilies;
+  }
+  static const struct {
+    const char* type;
+    uint32_t family;
+  } kStatsTypeFamilies[] = {
+      {RTCCertificateStats::kType, kCertificateStats},
+      {RTCCodecStats::kType, kCodecStats},
+      {RTCDataChannelStats::kType, kDataChannelStats},
+      {RTCIceCandidatePairStats::kType, kIceCandidateAndPairStats},
+      {RTCLocalIceCandidateStats::kType, kIceCandidateAndPairStats},
+      {RTCRemoteIceCandidateStats::kType, kIceCandidateAndPairStats},
+      {RTCMediaStreamStats::kType, kMediaStreamStats},
+      {RTCMediaStreamTrackStats::kType, kMediaStreamTrackStats},
+      {RTCAudioSourceStats::kType, kMediaSourceStats},
+      {RTCPeerConnectionStats::kType, kPeerConnectionStats},
+      {RTCInboundRTPStreamStats::kType, kRTPStreamStats},
+      {RTCOutboundRTPStreamStats::kType, kRTPStreamStats},
+      {RTCRemoteInboundRtpStreamStats::kType, kRTPStreamStats},
+      {RTCTransportStats::kType, kTransportStats},
+  };
+  uint32_t stats_families = 0;
+  for (const auto& type_family : kStatsTypeFamilies) {
+    if (stats_types_.find(type_family.type) != stats_types_.end())
+      stats_families |= type_family.family;
+  }
+  return stats_families;
+}
+
 rtc::scoped_refptr<RTCStatsCollector> RTCStatsCollector::Create(
     PeerConnectionInternal* pc,
     int64_t cache_lifetime_us) {
@@ -923,6 +978,7 @@ RTCStatsCollector::RTCStatsCollector(PeerConnectionInternal* pc,
       network_thread_(pc->network_thread()),
       num_pending_partial_reports_(0),
       partial_report_timestamp_us_(0),
+      partial_report_stats_families_(kAllStatsFamilies),
       network_report_event_(true /* manual_reset */,
                             true /* initially_signaled */),
       cache_timestamp_us_(0),
@@ -957,6 +1013,12 @@ void RTCStatsCollector::GetStatsReport(
   GetStatsReportInternal(RequestInfo(std::move(selector), std::move(callback)));
 }
 
+void RTCStatsCollector::GetStatsReport(
+    const std::set<std::string>& stats_types,
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  GetStatsReportInternal(RequestInfo(stats_types, std::move(callback)));
+}
+
 void RTCStatsCollector::GetStatsReportInternal(
     RTCStatsCollector::RequestInfo request) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
@@ -978,39 +1040,77 @@ void RTCStatsCollector::GetStatsReportInternal(
     // Only start gathering stats if we're not already gathering stats. In the
     // case of already gathering stats, |callback_| will be invoked when there
     // are no more pending partial reports.
+    GatherStats_s(cache_now_us);
+  }
+}
 
-    // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
-    // UTC), in microseconds. The system clock could be modified and is not
-    // necessarily monotonically increasing.
-    int64_t timestamp_us = rtc::TimeUTCMicros();
-
-    num_pending_partial_reports_ = 2;
-    partial_report_timestamp_us_ = cache_now_us;
-
-    // Prepare |transceiver_stats_infos_| for use in
-    // |ProducePartialResultsOnNetworkThread| and
-    // |ProducePartialResultsOnSignalingThread|.
-    transceiver_stats_infos_ = PrepareTransceiverStatsInfos_s();
-    // Prepare |transport_names_| for use in
-    // |ProducePartialResultsOnNetworkThread|.
+void RTCStatsCollector::GatherStats_s(int64_t cache_now_us) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  RTC_DCHECK(!requests_.empty());
+  RTC_DCHECK_EQ(num_pending_partial_reports_, 0);
+  // Stats that need the media channels' stats from the worker thread.
+  const uint32_t kMediaInfoStatsFamilies =
+      kCodecStats | kMediaStreamTrackStats | kMediaSourceStats | kRTPStreamStats;
+  // Stats that need the transport stats from the network thread.
+  const uint32_t kTransportStatsFamilies =
+      kCertificateStats | kIceCandidateAndPairStats | kTransportStats;
+  // Stats that are produced on the network thread.
+  const uint32_t kNetworkThreadStatsFamilies =
+      kTransportStatsFamilies | kCodecStats | kRTPStreamStats;
+
+  // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
+  // UTC), in microseconds. The system clock could be modified and is not
+  // necessarily monotonically increasing.
+  int64_t timestamp_us = rtc::TimeUTCMicros();
+
+  num_pending_partial_reports_ = 2;
+  partial_report_timestamp_us_ = cache_now_us;
+  partial_report_stats_families_ = 0;
+  for (const RequestInfo& request : requests_)
+    partial_report_stats_families_ |= request.stats_families();
+
+  // Prepare |transceiver_stats_infos_| for use in
+  // |ProducePartialResultsOnNetworkThread| and
+  // |ProducePartialResultsOnSignalingThread|.
+  if (partial_report_stats_families_ &
+      (kMediaInfoStatsFamilies | kMediaStreamStats)) {
+    transceiver_stats_infos_ = PrepareTransceiverStatsInfos_s(
+        partial_report_stats_families_ & kMediaInfoStatsFamilies);
+  }
+  // Prepare |transport_names_| for use in
+  // |ProducePartialResultsOnNetworkThread|.
+  if (partial_report_stats_families_ & kTransportStatsFamilies) {
     transport_names_ = PrepareTransportNames_s();
+  } else {
+    transport_names_.clear();
+  }
 
-    // Prepare |call_stats_| here since GetCallStats() will hop to the worker
-    // thread.
-    // TODO(holmer): To avoid the hop we could move BWE and BWE stats to the
-    // network thread, where it more naturally belongs.
+  // Prepare |call_stats_| here since GetCallStats() will hop to the worker
+  // thread.
+  // TODO(holmer): To avoid the hop we could move BWE and BWE stats to the
+  // network thread, where it more naturally belongs.
+  if (partial_report_stats_families_ & kIceCandidateAndPairStats)
     call_stats_ = pc_->GetCallStats();
 
-    // Don't touch |network_report_| on the signaling thread until
-    // ProducePartialResultsOnNetworkThread() has signaled the
-    // |network_report_event_|.
-    network_report_event_.Reset();
+  // Don't touch |network_report_| on the signaling thread until
+  // ProducePartialResultsOnNetworkThread() has signaled the
+  // |network_report_event_|.
+  network_report_event_.Reset();
+  if (partial_report_stats_families_ & kNetworkThreadStatsFamilies) {
     network_thread_->PostTask(
         RTC_FROM_HERE,
         rtc::Bind(&RTCStatsCollector::ProducePartialResultsOnNetworkThread,
                   this, timestamp_us));
-    ProducePartialResultsOnSignalingThread(timestamp_us);
+  } else {
+    // Nothing to gather on the network thread, but the result is still
+    // delivered asynchronously.
+    network_report_ = RTCStatsReport::Create(timestamp_us);
+    network_report_event_.Set();
+    signaling_thread_->PostTask(
+        RTC_FROM_HERE,
+        rtc::Bind(&RTCStatsCollector::MergeNetworkReport_s, this));
   }
+  ProducePartialResultsOnSignalingThread(timestamp_us);
 }
 
 void RTCStatsCollector::ClearCachedStatsReport() {
@@ -1045,11 +1145,16 @@ void RTCStatsCollector::ProducePartialResultsOnSignalingThreadImpl(
     int64_t timestamp_us,
     RTCStatsReport* partial_report) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  ProduceDataChannelStats_s(timestamp_us, partial_report);
-  ProduceMediaStreamStats_s(timestamp_us, partial_report);
-  ProduceMediaStreamTrackStats_s(timestamp_us, partial_report);
-  ProduceMediaSourceStats_s(timestamp_us, partial_report);
-  ProducePeerConnectionStats_s(timestamp_us, partial_report);
+  if (partial_report_stats_families_ & kDataChannelStats)
+    ProduceDataChannelStats_s(timestamp_us, partial_report);
+  if (partial_report_stats_families_ & kMediaStreamStats)
+    ProduceMediaStreamStats_s(timestamp_us, partial_report);
+  if (partial_report_stats_families_ & kMediaStreamTrackStats)
+    ProduceMediaStreamTrackStats_s(timestamp_us, partial_report);
+  if (partial_report_stats_families_ & kMediaSourceStats)
+    ProduceMediaSourceStats_s(timestamp_us, partial_report);
+  if (partial_report_stats_families_ & kPeerConnectionStats)
+    ProducePeerConnectionStats_s(timestamp_us, partial_report);
 }
 
 void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
@@ -1059,10 +1164,14 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
   // |network_report_event_| is reset before this method is invoked.
   network_report_ = RTCStatsReport::Create(timestamp_us);
 
-  std::map<std::string, cricket::TransportStats> transport_stats_by_name =
-      pc_->GetTransportStatsByNames(transport_names_);
-  std::map<std::string, CertificateStatsPair> transport_cert_stats =
-      PrepareTransportCertificateStats_n(transport_stats_by_name);
+  std::map<std::string, cricket::TransportStats> transport_stats_by_name;
+  if (!transport_names_.empty())
+    transport_stats_by_name = pc_->GetTransportStatsByNames(transport_names_);
+  std::map<std::string, CertificateStatsPair> transport_cert_stats;
+  if (partial_report_stats_families_ & (kCertificateStats | kTransportStats)) {
+    transport_cert_stats =
+        PrepareTransportCertificateStats_n(transport_stats_by_name);
+  }
 
   ProducePartialResultsOnNetworkThreadImpl(
       timestamp_us, transport_stats_by_name, transport_cert_stats,
@@ -1082,14 +1191,24 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThreadImpl(
     const std::map<std::string, CertificateStatsPair>& transport_cert_stats,
     RTCStatsReport* partial_report) {
   RTC_DCHECK(network_thread_->IsCurrent());
-  ProduceCertificateStats_n(timestamp_us, transport_cert_stats, partial_report);
-  ProduceCodecStats_n(timestamp_us, transceiver_stats_infos_, partial_report);
-  ProduceIceCandidateAndPairStats_n(timestamp_us, transport_stats_by_name,
-                                    call_stats_, partial_report);
-  ProduceTransportStats_n(timestamp_us, transport_stats_by_name,
-                          transport_cert_stats, partial_report);
-  ProduceRTPStreamStats_n(timestamp_us, transceiver_stats_infos_,
-                          partial_report);
+  if (partial_report_stats_families_ & kCertificateStats) {
+    ProduceCertificateStats_n(timestamp_us, transport_cert_stats,
+                              partial_report);
+  }
+  if (partial_report_stats_families_ & kCodecStats)
+    ProduceCodecStats_n(timestamp_us, transceiver_stats_infos_, partial_report);
+  if (partial_report_stats_families_ & kIceCandidateAndPairStats) {
+    ProduceIceCandidateAndPairStats_n(timestamp_us, transport_stats_by_name,
+                                      call_stats_, partial_report);
+  }
+  if (partial_report_stats_families_ & kTransportStats) {
+    ProduceTransportStats_n(timestamp_us, transport_stats_by_name,
+                            transport_cert_stats, partial_report);
+  }
+  if (partial_report_stats_families_ & kRTPStreamStats) {
+    ProduceRTPStreamStats_n(timestamp_us, transceiver_stats_infos_,
+                            partial_report);
+  }
 }
 
 void RTCStatsCollector::MergeNetworkReport_s() {
@@ -1117,10 +1236,33 @@ void RTCStatsCollector::MergeNetworkReport_s() {
   // asynchronously, so |num_pending_partial_reports_| must now be 0 and we are
   // ready to deliver the result.
   RTC_DCHECK_EQ(num_pending_partial_reports_, 0);
-  cache_timestamp_us_ = partial_report_timestamp_us_;
-  cached_report_ = partial_report_;
+  rtc::scoped_refptr<const RTCStatsReport> report = partial_report_;
   partial_report_ = nullptr;
   transceiver_stats_infos_.clear();
+
+  std::vector<RequestInfo> requests;
+  requests.swap(requests_);
+  if (partial_report_stats_families_ != kAllStatsFamilies) {
+    // Only some of the stats were gathered; such a report is not cached.
+    // Requests that were made while gathering and that need more than that are
+    // gathered for again.
+    std::vector<RequestInfo> served_requests;
+    for (RequestInfo& request : requests) {
+      if ((request.stats_families() & ~partial_report_stats_families_) == 0) {
+        served_requests.push_back(std::move(request));
+      } else {
+        requests_.push_back(std::move(request));
+      }
+    }
+    if (!requests_.empty())
+      GatherStats_s(rtc::TimeMicros());
+    if (!served_requests.empty())
+      DeliverCachedReport(report, std::move(served_requests));
+    return;
+  }
+
+  cache_timestamp_us_ = partial_report_timestamp_us_;
+  cached_report_ = report;
   // Trace WebRTC Stats when getStats is called on Javascript.
   // This allows access to WebRTC stats from trace logs. To enable them,
   // select the "webrtc_stats" category when recording traces.
@@ -1128,8 +1270,6 @@ void RTCStatsCollector::MergeNetworkReport_s() {
                        cached_report_->ToJson());
 
   // Deliver report and clear |requests_|.
-  std::vector<RequestInfo> requests;
-  requests.swap(requests_);
   DeliverCachedReport(cached_report_, std::move(requests));
 }
 
@@ -1143,6 +1283,10 @@ void RTCStatsCollector::DeliverCachedReport(
   for (const RequestInfo& request : requests) {
     if (request.filter_mode() == RequestInfo::FilterMode::kAll) {
       request.callback()->OnStatsDelivered(cached_report);
+    } else if (request.filter_mode() ==
+               RequestInfo::FilterMode::kTypeSelector) {
+      request.callback()->OnStatsDelivered(
+          CreateReportFilteredByTypes(request.stats_types(), cached_report));
     } else {
       bool filter_by_sender_selector;
       rtc::scoped_refptr<RtpSenderInternal> sender_selector;
@@ -1717,17 +1861,29 @@ void RTCStatsCollector::ProduceTransportStats_n(
 std::map<std::string, RTCStatsCollector::CertificateStatsPair>
 RTCStatsCollector::PrepareTransportCertificateStats_n(
     const std::map<std::string, cricket::TransportStats>&
-        transport_stats_by_name) const {
+        transport_stats_by_name) {
   RTC_DCHECK(network_thread_->IsCurrent());
   std::map<std::string, CertificateStatsPair> transport_cert_stats;
+  // Only the transports that still exist are kept in the cache.
+  std::map<std::string, LocalCertificateStats> local_certificate_stats;
   for (const auto& entry : transport_stats_by_name) {
     const std::string& transport_name = entry.first;
 
     CertificateStatsPair certificate_stats_pair;
     rtc::scoped_refptr<rtc::RTCCertificate> local_certificate;
     if (pc_->GetLocalCertificate(transport_name, &local_certificate)) {
-      certificate_stats_pair.local =
-          local_certificate->GetSSLCertificateChain().GetStats();
+      LocalCertificateStats& cached = local_certificate_stats[transport_name];
+      auto it = local_certificate_stats_.find(transport_name);
+      if (it != local_certificate_stats_.end() &&
+          it->second.certificate == local_certificate) {
+        cached = std::move(it->second);
+      } else {
+        cached.certificate = local_certificate;
+        cached.stats = local_certificate->GetSSLCertificateChain().GetStats();
+      }
+      if (cached.stats) {
+        certificate_stats_pair.local = cached.stats->Copy();
+      }
     }
 
     std::unique_ptr<rtc::SSLCertChain> remote_cert_chain =
@@ -1739,11 +1895,12 @@ RTCStatsCollector::PrepareTransportCertificateStats_n(
     transport_cert_stats.insert(
         std::make_pair(transport_name, std::move(certificate_stats_pair)));
   }
+  local_certificate_stats_ = std::move(local_certificate_stats);
   return transport_cert_stats;
 }
 
 std::vector<RTCStatsCollector::RtpTransceiverStatsInfo>
-RTCStatsCollector::PrepareTransceiverStatsInfos_s() const {
+RTCStatsCollector::PrepareTransceiverStatsInfos_s(bool get_media_info) const {
   std::vector<RtpTransceiverStatsInfo> transceiver_stats_infos;
 
   // These are used to invoke GetStats for all the media channels together in
@@ -1774,6 +1931,8 @@ RTCStatsCollector::PrepareTransceiverStatsInfos_s() const {
     stats.mid = channel->content_name();
     stats.transport_name = channel->transport_name();
 
+    if (!get_media_info)
+      continue;
     if (media_type == cricket::MEDIA_TYPE_AUDIO) {
       auto* voice_channel = static_cast<cricket::VoiceChannel*>(channel);
       RTC_DCHECK(voice_stats.find(voice_channel->media_channel()) ==
@@ -1791,6 +1950,9 @@ RTCStatsCollector::PrepareTransceiverStatsInfos_s() const {
     }
   }
 
+  if (!get_media_info)
+    return transceiver_stats_infos;
+
   // Call GetStats for all media channels together on the worker thread in one
   // hop.
   worker_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
@@ -29,6 +29,7 @@
 #include "pc/track_media_info_map.h"
 #include "rtc_base/event.h"
 #include "rtc_base/ref_count.h"
+#include "rtc_base/rtc_certificate.h"
 #include "rtc_base/ssl_identity.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/time_utils.h"
@@ -65,6 +66,12 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   // as: no RTP streams are received by selector). The result is empty.
   void GetStatsReport(rtc::scoped_refptr<RtpReceiverInternal> selector,
                       rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Only the stats objects whose |RTCStats::type| is in |stats_types| are
+  // delivered. Unless there is a fresh report cached, only the stats needed for
+  // these types are gathered, skipping the worker and network thread hops that
+  // aren't needed for them. Such partial reports are not cached.
+  void GetStatsReport(const std::set<std::string>& stats_types,
+                      rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
   // Clears the cache's reference to the most recent stats report. Subsequently
   // calling |GetStatsReport| guarantees fresh stats.
   void ClearCachedStatsReport();
@@ -94,9 +101,30 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
       RTCStatsReport* partial_report);
 
  private:
+  // Groups of stats objects that are produced together, as a bitmask. Only the
+  // families needed by the pending requests are gathered.
+  enum StatsFamily : uint32_t {
+    kCertificateStats = 1 << 0,
+    kCodecStats = 1 << 1,
+    kDataChannelStats = 1 << 2,
+    kIceCandidateAndPairStats = 1 << 3,
+    kMediaStreamStats = 1 << 4,
+    kMediaStreamTrackStats = 1 << 5,
+    kMediaSourceStats = 1 << 6,
+    kPeerConnectionStats = 1 << 7,
+    kRTPStreamStats = 1 << 8,
+    kTransportStats = 1 << 9,
+    kAllStatsFamilies = (1 << 10) - 1,
+  };
+
   class RequestInfo {
    public:
-    enum class FilterMode { kAll, kSenderSelector, kReceiverSelector };
+    enum class FilterMode {
+      kAll,
+      kSenderSelector,
+      kReceiverSelector,
+      kTypeSelector
+    };
 
     // Constructs with FilterMode::kAll.
     explicit RequestInfo(
@@ -109,8 +137,13 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     // applied even if |selector| is null, resulting in an empty report.
     RequestInfo(rtc::scoped_refptr<RtpReceiverInternal> selector,
                 rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+    // Constructs with FilterMode::kTypeSelector.
+    RequestInfo(std::set<std::string> stats_types,
+                rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
 
     FilterMode filter_mode() const { return filter_mode_; }
+    // The |StatsFamily| bitmask needed to serve this request.
+    uint32_t stats_families() const;
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback() const {
       return callback_;
     }
@@ -122,6 +155,10 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
       RTC_DCHECK(filter_mode_ == FilterMode::kReceiverSelector);
       return receiver_selector_;
     }
+    const std::set<std::string>& stats_types() const {
+      RTC_DCHECK(filter_mode_ == FilterMode::kTypeSelector);
+      return stats_types_;
+    }
 
    private:
     RequestInfo(FilterMode filter_mode,
@@ -133,9 +170,12 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback_;
     rtc::scoped_refptr<RtpSenderInternal> sender_selector_;
     rtc::scoped_refptr<RtpReceiverInternal> receiver_selector_;
+    std::set<std::string> stats_types_;
   };
 
   void GetStatsReportInternal(RequestInfo request);
+  // Starts gathering the stats needed by |requests_|.
+  void GatherStats_s(int64_t cache_now_us);
 
   // Structure for tracking stats about each RtpTransceiver managed by the
   // PeerConnection. This can either by a Plan B style or Unified Plan style
@@ -214,8 +254,11 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   std::map<std::string, CertificateStatsPair>
   PrepareTransportCertificateStats_n(
       const std::map<std::string, cricket::TransportStats>&
-          transport_stats_by_name) const;
-  std::vector<RtpTransceiverStatsInfo> PrepareTransceiverStatsInfos_s() const;
+          transport_stats_by_name);
+  // If |get_media_info| is false the worker thread is not invoked and the
+  // |track_media_info_map| of the returned infos are null.
+  std::vector<RtpTransceiverStatsInfo> PrepareTransceiverStatsInfos_s(
+      bool get_media_info) const;
   std::set<std::string> PrepareTransportNames_s() const;
 
   // Stats gathering on a particular thread.
@@ -238,6 +281,9 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
 
   int num_pending_partial_reports_;
   int64_t partial_report_timestamp_us_;
+  // The |StatsFamily| bitmask of the stats being gathered for
+  // |partial_report_|.
+  uint32_t partial_report_stats_families_;
   // Reports that are produced on the signaling thread or the network thread are
   // merged into this report. It is only touched on the signaling thread. Once
   // all partial reports are merged this is the result of a request.
@@ -288,6 +334,17 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     std::set<uintptr_t> opened_data_channels;
   };
   InternalRecord internal_record_;
+
+  // The stats of the local certificate of each transport, as of the last
+  // report. A local certificate doesn't change for the lifetime of its
+  // transport, so its fingerprint and DER encoding are only computed again if
+  // the transport gets a different certificate. Only touched on the network
+  // thread.
+  struct LocalCertificateStats {
+    rtc::scoped_refptr<rtc::RTCCertificate> certificate;
+    std::unique_ptr<rtc::SSLCertificateStats> stats;
+  };
+  std::map<std::string, LocalCertificateStats> local_certificate_stats_;
 };
 
 const char* CandidateTypeToRTCIceCandidateTypeForTesting(
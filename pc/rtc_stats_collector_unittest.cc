@@ -384,6 +384,13 @@ class RTCStatsCollectorWrapper {
     return WaitForReport(callback);
   }
 
+  rtc::scoped_refptr<const RTCStatsReport> GetStatsReportWithTypes(
+      const std::set<std::string>& stats_types) {
+    rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
+    stats_collector_->GetStatsReport(stats_types, callback);
+    return WaitForReport(callback);
+  }
+
   rtc::scoped_refptr<const RTCStatsReport> GetFreshStatsReport() {
     stats_collector_->ClearCachedStatsReport();
     return GetStatsReport();
@@ -2735,6 +2742,40 @@ TEST_F(RTCStatsCollectorTest, GetStatsWithNullReceiverSelector) {
   EXPECT_EQ(empty_report->size(), 0u);
 }
 
+TEST_F(RTCStatsCollectorTest, GetStatsWithTypesFromCachedReport) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetStatsReportWithTypes(
+          {RTCOutboundRTPStreamStats::kType, RTCTransportStats::kType});
+  EXPECT_EQ(report->timestamp_us(), graph.full_report->timestamp_us());
+  EXPECT_EQ(report->size(), 2u);
+  EXPECT_TRUE(report->Get(graph.outbound_rtp_id));
+  EXPECT_TRUE(report->Get(graph.transport_id));
+}
+
+TEST_F(RTCStatsCollectorTest, GetStatsWithTypesOnlyGathersRequestedStats) {
+  ExampleStatsGraph graph = SetupExampleStatsGraphForSelectorTests();
+  stats_->stats_collector()->ClearCachedStatsReport();
+
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      stats_->GetStatsReportWithTypes(
+          {RTCOutboundRTPStreamStats::kType, RTCTransportStats::kType});
+  EXPECT_EQ(report->size(), 2u);
+  EXPECT_TRUE(report->Get(graph.outbound_rtp_id));
+  EXPECT_TRUE(report->Get(graph.transport_id));
+
+  report = stats_->GetStatsReportWithTypes({RTCPeerConnectionStats::kType});
+  EXPECT_EQ(report->size(), 1u);
+  EXPECT_TRUE(report->Get(graph.peer_connection_id));
+
+  report = stats_->GetStatsReportWithTypes({"unknown-type"});
+  EXPECT_EQ(report->size(), 0u);
+
+  // Reports with only some of the stats are not cached.
+  report = stats_->GetStatsReport();
+  EXPECT_EQ(report->size(), graph.full_report->size());
+}
+
 // When the PC has not had SetLocalDescription done, tracks all have
 // SSRC 0, meaning "unconnected".
 // In this state, we report on track stats, but not RTP stats.
@@ -22,6 +22,8 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/allocation_tracker.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/trace_event.h"
 
@@ -154,6 +156,9 @@ bool RtpTransport::SendPacket(bool rtcp,
     }
     return false;
   }
+  if (!rtcp) {
+    RTC_ALLOCATION_TRACKER_ADD_PACKETS(1);
+  }
   return true;
 }
 
@@ -182,6 +187,10 @@ bool RtpTransport::UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) {
 
 void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
                                int64_t packet_time_us) {
+  RTC_ALLOCATION_TRACKER_ADD_PACKETS(1);
+  if (audio_level_sink_ && !DeliverAudioLevel(packet, packet_time_us))
+    return;
+
   webrtc::RtpPacketReceived parsed_packet(&header_extension_map_);
   if (!parsed_packet.Parse(std::move(packet))) {
     RTC_LOG(LS_ERROR)
@@ -198,6 +207,24 @@ void RtpTransport::DemuxPacket(rtc::CopyOnWriteBuffer packet,
   }
 }
 
+bool RtpTransport::DeliverAudioLevel(const rtc::CopyOnWriteBuffer& packet,
+                                     int64_t packet_time_us) {
+  const int extension_id = header_extension_map_.GetId(kRtpExtensionAudioLevel);
+  uint32_t ssrc;
+  uint8_t level;
+  bool voice_activity;
+  if (extension_id == RtpHeaderExtensionMap::kInvalidId ||
+      !cricket::GetRtpSsrc(packet.data(), packet.size(), &ssrc) ||
+      !cricket::GetRtpAudioLevel(packet.data(), packet.size(), extension_id,
+                                 &level, &voice_activity)) {
+    return true;
+  }
+  int64_t arrival_time_ms = packet_time_us != -1 ? (packet_time_us + 500) / 1000
+                                                 : rtc::TimeMillis();
+  return audio_level_sink_->OnRtpAudioLevel(ssrc, level, voice_activity,
+                                            arrival_time_ms);
+}
+
 bool RtpTransport::IsTransportWritable() {
   auto rtcp_packet_transport =
       rtcp_mux_enabled_ ? nullptr : rtcp_packet_transport_;
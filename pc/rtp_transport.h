@@ -15,6 +15,7 @@
 
 #include "call/rtp_demuxer.h"
 #include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "pc/active_speaker_detector.h"
 #include "pc/rtp_transport_internal.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
@@ -76,6 +77,14 @@ class RtpTransport : public RtpTransportInternal {
 
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
 
+  // Gives |sink| the audio level of incoming packets carrying the negotiated
+  // audio level extension, read by offset before the packet is parsed. The
+  // sink may drop packets, e.g. those of streams that are not forwarded.
+  // Pass null to remove it.
+  void SetAudioLevelSink(RtpAudioLevelSinkInterface* sink) {
+    audio_level_sink_ = sink;
+  }
+
  protected:
   // These methods will be used in the subclasses.
   void DemuxPacket(rtc::CopyOnWriteBuffer packet, int64_t packet_time_us);
@@ -111,6 +120,10 @@ class RtpTransport : public RtpTransportInternal {
 
   void MaybeSignalReadyToSend();
 
+  // Returns false if the audio level sink drops the packet.
+  bool DeliverAudioLevel(const rtc::CopyOnWriteBuffer& packet,
+                         int64_t packet_time_us);
+
   bool IsTransportWritable();
 
   bool rtcp_mux_enabled_;
@@ -126,6 +139,8 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+
+  RtpAudioLevelSinkInterface* audio_level_sink_ = nullptr;
 };
 
 }  // namespace webrtc
@@ -80,6 +80,33 @@ class SignalObserver : public sigslot::has_slots<> {
   absl::optional<rtc::NetworkRoute> network_route_;
 };
 
+class AudioLevelSink : public RtpAudioLevelSinkInterface {
+ public:
+  bool OnRtpAudioLevel(uint32_t ssrc,
+                       uint8_t level,
+                       bool voice_activity,
+                       int64_t arrival_time_ms) override {
+    ++count_;
+    last_ssrc_ = ssrc;
+    last_level_ = level;
+    last_voice_activity_ = voice_activity;
+    return forward_;
+  }
+
+  void set_forward(bool forward) { forward_ = forward; }
+  int count() const { return count_; }
+  uint32_t last_ssrc() const { return last_ssrc_; }
+  uint8_t last_level() const { return last_level_; }
+  bool last_voice_activity() const { return last_voice_activity_; }
+
+ private:
+  bool forward_ = true;
+  int count_ = 0;
+  uint32_t last_ssrc_ = 0;
+  uint8_t last_level_ = 0;
+  bool last_voice_activity_ = false;
+};
+
 TEST(RtpTransportTest, SettingRtcpAndRtpSignalsReady) {
   RtpTransport transport(kMuxDisabled);
   SignalObserver observer(&transport);
@@ -322,4 +349,47 @@ TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+TEST(RtpTransportTest, AudioLevelSinkGetsLevelAndCanDropPacket) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  transport.SetRtpPacketTransport(&fake_rtp);
+  transport.UpdateRtpHeaderExtensionMap(
+      {RtpExtension(RtpExtension::kAudioLevelUri, 1)});
+  AudioLevelSink audio_level_sink;
+  transport.SetAudioLevelSink(&audio_level_sink);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types = {0x11};
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  // Audio level 42 with voice activity, in a one-byte header extension.
+  const uint8_t kRtpWithAudioLevel[] = {
+      0x90, 0x11, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x12, 0x34,
+      0x56, 0x78, 0xBE, 0xDE, 0x00, 0x01, 0x10, 0xAA, 0x00, 0x00};
+  const rtc::PacketOptions options;
+  const int flags = 0;
+  fake_rtp.SendPacket(reinterpret_cast<const char*>(kRtpWithAudioLevel),
+                      sizeof(kRtpWithAudioLevel), options, flags);
+  EXPECT_EQ(1, audio_level_sink.count());
+  EXPECT_EQ(0x12345678u, audio_level_sink.last_ssrc());
+  EXPECT_EQ(42, audio_level_sink.last_level());
+  EXPECT_TRUE(audio_level_sink.last_voice_activity());
+  EXPECT_EQ(1, observer.rtp_count());
+
+  audio_level_sink.set_forward(false);
+  fake_rtp.SendPacket(reinterpret_cast<const char*>(kRtpWithAudioLevel),
+                      sizeof(kRtpWithAudioLevel), options, flags);
+  EXPECT_EQ(2, audio_level_sink.count());
+  EXPECT_EQ(1, observer.rtp_count());
+
+  // Packets without the extension aren't reported.
+  rtc::Buffer rtp_data(kRtpData, kRtpLen);
+  fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, options, flags);
+  EXPECT_EQ(2, audio_level_sink.count());
+  EXPECT_EQ(2, observer.rtp_count());
+  // Remove the sink before destroying the transport.
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
 }  // namespace webrtc
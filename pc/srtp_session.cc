@@ -14,6 +14,7 @@
 #include "pc/external_hmac.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "system_wrappers/include/metrics.h"
 #include "third_party/libsrtp/include/srtp.h"
@@ -72,7 +73,36 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
     RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet: no SRTP Session";
     return false;
   }
+  return DoProtectRtp(p, in_len, max_len, out_len);
+}
+
+size_t SrtpSession::ProtectRtp(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      packet.Clear();
+    }
+    return 0;
+  }
+
+  size_t num_protected = 0;
+  for (rtc::CopyOnWriteBuffer& packet : packets) {
+    packet.EnsureCapacity(packet.size() + rtp_auth_tag_len_);
+    int len = rtc::checked_cast<int>(packet.size());
+    if (DoProtectRtp(packet.data(), len,
+                     rtc::checked_cast<int>(packet.capacity()), &len)) {
+      packet.SetSize(len);
+      ++num_protected;
+    } else {
+      packet.Clear();
+    }
+  }
+  return num_protected;
+}
 
+bool SrtpSession::DoProtectRtp(void* p, int in_len, int max_len, int* out_len) {
   int need_len = in_len + rtp_auth_tag_len_;  // NOLINT
   if (max_len < need_len) {
     RTC_LOG(LS_WARNING) << "Failed to protect SRTP packet: The buffer length "
@@ -134,7 +164,35 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
     RTC_LOG(LS_WARNING) << "Failed to unprotect SRTP packet: no SRTP Session";
     return false;
   }
+  return DoUnprotectRtp(p, in_len, out_len);
+}
+
+size_t SrtpSession::UnprotectRtp(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to unprotect " << packets.size()
+                        << " SRTP packets: no SRTP Session";
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      packet.Clear();
+    }
+    return 0;
+  }
+
+  size_t num_unprotected = 0;
+  for (rtc::CopyOnWriteBuffer& packet : packets) {
+    int len = rtc::checked_cast<int>(packet.size());
+    if (DoUnprotectRtp(packet.data(), len, &len)) {
+      packet.SetSize(len);
+      ++num_unprotected;
+    } else {
+      packet.Clear();
+    }
+  }
+  return num_unprotected;
+}
 
+bool SrtpSession::DoUnprotectRtp(void* p, int in_len, int* out_len) {
   *out_len = in_len;
   int err = srtp_unprotect(session_, p, out_len);
   if (err != srtp_err_status_ok) {
@@ -13,7 +13,9 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/scoped_refptr.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/thread_checker.h"
 
 // Forward declaration to avoid pulling in libsrtp headers here
@@ -65,6 +67,15 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Batched versions of ProtectRtp() and UnprotectRtp(), which process the
+  // packets in order, in-place, and set each buffer's size to the output
+  // length. Protecting grows the buffers' capacity as needed to fit the auth
+  // tag. Packets that fail are cleared, i.e. their size is set to zero, and
+  // the others are still processed. Returns the number of packets that were
+  // successfully processed.
+  size_t ProtectRtp(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets);
+  size_t UnprotectRtp(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets);
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -99,6 +110,10 @@ class SrtpSession {
                  const uint8_t* key,
                  size_t len,
                  const std::vector<int>& extension_ids);
+  // Implementation of ProtectRtp() and UnprotectRtp(), without the checks of
+  // the thread and session that only need to be done once per batch.
+  bool DoProtectRtp(void* data, int in_len, int max_len, int* out_len);
+  bool DoUnprotectRtp(void* data, int in_len, int* out_len);
   // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
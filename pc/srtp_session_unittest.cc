@@ -13,10 +13,12 @@
 #include <string.h>
 
 #include <string>
+#include <vector>
 
 #include "media/base/fake_rtp.h"
 #include "pc/test/srtp_test_util.h"
 #include "rtc_base/byte_order.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/ssl_stream_adapter.h"  // For rtc::SRTP_*
 #include "system_wrappers/include/metrics.h"
 #include "test/gmock.h"
@@ -190,6 +192,42 @@ TEST_F(SrtpSessionTest, TestBuffersTooSmall) {
                                sizeof(rtcp_packet_) - 14, &out_len));
 }
 
+// Test that a batch of packets can be protected and unprotected, and that a
+// packet failing to unprotect doesn't affect the rest of the batch.
+TEST_F(SrtpSessionTest, TestProtectAndUnprotectBatch) {
+  static const size_t kNumPackets = 5;
+  EXPECT_TRUE(s1_.SetSend(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(SRTP_AES128_CM_SHA1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  std::vector<CopyOnWriteBuffer> packets;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    packets.emplace_back(kPcmuFrame, sizeof(kPcmuFrame));
+    SetBE16(packets.back().data() + 2, static_cast<uint16_t>(i + 1));
+  }
+
+  EXPECT_EQ(kNumPackets, s1_.ProtectRtp(packets));
+  for (const CopyOnWriteBuffer& packet : packets) {
+    EXPECT_EQ(sizeof(kPcmuFrame) +
+                  rtp_auth_tag_len(CS_AES_CM_128_HMAC_SHA1_80),
+              packet.size());
+  }
+
+  // Replay the second packet in place of the fourth.
+  packets[3] = CopyOnWriteBuffer(packets[1].cdata(), packets[1].size());
+  EXPECT_EQ(kNumPackets - 1, s2_.UnprotectRtp(packets));
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    if (i == 3) {
+      EXPECT_EQ(0u, packets[i].size());
+      continue;
+    }
+    ASSERT_EQ(sizeof(kPcmuFrame), packets[i].size());
+    EXPECT_EQ(i + 1, GetBE16(packets[i].cdata() + 2));
+    EXPECT_EQ(0, memcmp(packets[i].cdata() + 4, kPcmuFrame + 4,
+                        sizeof(kPcmuFrame) - 4));
+  }
+}
+
 TEST_F(SrtpSessionTest, TestReplay) {
   static const uint16_t kMaxSeqnum = static_cast<uint16_t>(-1);
   static const uint16_t seqnum_big = 62275;
@@ -174,6 +174,48 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   return SendPacket(/*rtcp=*/false, packet, updated_options, flags);
 }
 
+size_t SrtpTransport::SendRtpPackets(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer> packets,
+    rtc::ArrayView<const rtc::PacketOptions> options,
+    int flags) {
+  RTC_DCHECK_EQ(packets.size(), options.size());
+  if (!IsSrtpActive()) {
+    RTC_LOG(LS_ERROR)
+        << "Failed to send the packets because SRTP transport is inactive.";
+    return 0;
+  }
+
+  size_t num_sent = 0;
+#if defined(ENABLE_EXTERNAL_AUTH)
+  if (IsExternalAuthActive()) {
+    // The packet index and auth params have to be fetched for each packet,
+    // so there is nothing to gain from batching.
+    for (size_t i = 0; i < packets.size(); ++i) {
+      if (SendRtpPacket(&packets[i], options[i], flags)) {
+        ++num_sent;
+      }
+    }
+    return num_sent;
+  }
+#endif
+
+  TRACE_EVENT1("webrtc", "SRTP Encode", "packets", packets.size());
+  RTC_CHECK(send_session_);
+  size_t num_protected = send_session_->ProtectRtp(packets);
+  if (num_protected != packets.size()) {
+    RTC_LOG(LS_ERROR) << "Failed to protect "
+                      << packets.size() - num_protected << " of "
+                      << packets.size() << " RTP packets.";
+  }
+  for (size_t i = 0; i < packets.size(); ++i) {
+    if (packets[i].size() > 0 &&
+        SendPacket(/*rtcp=*/false, &packets[i], options[i], flags)) {
+      ++num_sent;
+    }
+  }
+  return num_sent;
+}
+
 bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                                    const rtc::PacketOptions& options,
                                    int flags) {
@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/crypto_params.h"
 #include "api/rtc_error.h"
 #include "p2p/base/packet_transport_internal.h"
@@ -52,6 +53,14 @@ class SrtpTransport : public RtpTransport {
                       const rtc::PacketOptions& options,
                       int flags) override;
 
+  // Protects and sends a batch of RTP packets, where |options| holds the
+  // options of each packet. The packets are encrypted by a single call to the
+  // send session before any of them is sent. Packets that can't be protected
+  // are dropped, and left empty. Returns the number of packets sent.
+  size_t SendRtpPackets(rtc::ArrayView<rtc::CopyOnWriteBuffer> packets,
+                        rtc::ArrayView<const rtc::PacketOptions> options,
+                        int flags);
+
   // The transport becomes active if the send_session_ and recv_session_ are
   // created.
   bool IsSrtpActive() const override;
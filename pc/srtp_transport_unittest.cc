@@ -405,6 +405,35 @@ INSTANTIATE_TEST_SUITE_P(ExternalAuth,
                          SrtpTransportTestWithExternalAuth,
                          ::testing::Values(true, false));
 
+// Test that a batch of packets is protected and delivered in order.
+TEST_F(SrtpTransportTest, SendRtpPacketsDeliversBatch) {
+  static const int kNumPackets = 8;
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::SRTP_AEAD_AES_128_GCM, kTestKeyGcm128_1, kTestKeyGcm128Len,
+      extension_ids, rtc::SRTP_AEAD_AES_128_GCM, kTestKeyGcm128_2,
+      kTestKeyGcm128Len, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::SRTP_AEAD_AES_128_GCM, kTestKeyGcm128_2, kTestKeyGcm128Len,
+      extension_ids, rtc::SRTP_AEAD_AES_128_GCM, kTestKeyGcm128_1,
+      kTestKeyGcm128Len, extension_ids));
+
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  for (int i = 0; i < kNumPackets; ++i) {
+    packets.emplace_back(kPcmuFrame, sizeof(kPcmuFrame));
+    rtc::SetBE16(packets.back().data() + 2, ++sequence_number_);
+  }
+  std::vector<rtc::PacketOptions> options(kNumPackets);
+  EXPECT_EQ(static_cast<size_t>(kNumPackets),
+            srtp_transport1_->SendRtpPackets(packets, options,
+                                             cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(kNumPackets, rtp_sink2_.rtp_count());
+  ASSERT_TRUE(rtp_sink2_.last_recv_rtp_packet().data());
+  ASSERT_EQ(sizeof(kPcmuFrame), rtp_sink2_.last_recv_rtp_packet().size());
+  EXPECT_EQ(sequence_number_,
+            rtc::GetBE16(rtp_sink2_.last_recv_rtp_packet().data() + 2));
+}
+
 // Test directly setting the params with bogus keys.
 TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
   std::vector<int> extension_ids;
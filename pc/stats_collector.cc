@@ -890,14 +890,7 @@ void StatsCollector::ExtractBweInfo() {
   if (pc_->signaling_state() == PeerConnectionInterface::kClosed)
     return;
 
-  webrtc::Call::Stats call_stats = pc_->GetCallStats();
-  cricket::BandwidthEstimationInfo bwe_info;
-  bwe_info.available_send_bandwidth = call_stats.send_bandwidth_bps;
-  bwe_info.available_recv_bandwidth = call_stats.recv_bandwidth_bps;
-  bwe_info.bucket_delay = call_stats.pacer_delay_ms;
-
-  // Fill in target encoder bitrate, actual encoder bitrate, rtx bitrate, etc.
-  // TODO(holmer): Also fill this in for audio.
+  std::vector<cricket::VideoMediaChannel*> video_media_channels;
   for (const auto& transceiver : pc_->GetTransceiversInternal()) {
     if (transceiver->media_type() != cricket::MEDIA_TYPE_VIDEO) {
       continue;
@@ -907,9 +900,28 @@ void StatsCollector::ExtractBweInfo() {
     if (!video_channel) {
       continue;
     }
-    video_channel->FillBitrateInfo(&bwe_info);
+    video_media_channels.push_back(video_channel->media_channel());
   }
 
+  // Gather the call stats and the bitrates of all video channels with a
+  // single hop to the worker thread.
+  cricket::BandwidthEstimationInfo bwe_info;
+  pc_->worker_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+    rtc::Thread::ScopedDisallowBlockingCalls no_blocking_calls;
+    webrtc::Call::Stats call_stats = pc_->GetCallStats();
+    bwe_info.available_send_bandwidth = call_stats.send_bandwidth_bps;
+    bwe_info.available_recv_bandwidth = call_stats.recv_bandwidth_bps;
+    bwe_info.bucket_delay = call_stats.pacer_delay_ms;
+
+    // Fill in target encoder bitrate, actual encoder bitrate, rtx bitrate,
+    // etc.
+    // TODO(holmer): Also fill this in for audio.
+    for (cricket::VideoMediaChannel* video_media_channel :
+         video_media_channels) {
+      video_media_channel->FillBitrateInfo(&bwe_info);
+    }
+  });
+
   StatsReport::Id report_id(StatsReport::NewBandwidthEstimationId());
   StatsReport* report = reports_.FindOrAddNew(report_id);
   ExtractStats(bwe_info, stats_gathering_started_, report);
@@ -12,6 +12,7 @@
 #define PC_TEST_FAKE_DATA_CHANNEL_PROVIDER_H_
 
 #include <set>
+#include <vector>
 
 #include "pc/data_channel.h"
 #include "rtc_base/checks.h"
@@ -44,6 +45,14 @@ class FakeDataChannelProvider : public webrtc::DataChannelProviderInterface {
     return true;
   }
 
+  size_t SendDataBatch(const std::vector<cricket::SendDataParams>& params,
+                       const std::vector<rtc::CopyOnWriteBuffer>& payloads,
+                       cricket::SendDataResult* result) override {
+    ++send_data_batch_count_;
+    return DataChannelProviderInterface::SendDataBatch(params, payloads,
+                                                       result);
+  }
+
   bool ConnectDataChannel(webrtc::DataChannel* data_channel) override {
     RTC_CHECK(connected_channels_.find(data_channel) ==
               connected_channels_.end());
@@ -126,6 +135,8 @@ class FakeDataChannelProvider : public webrtc::DataChannelProviderInterface {
 
   void set_transport_error() { transport_error_ = true; }
 
+  int send_data_batch_count() const { return send_data_batch_count_; }
+
   cricket::SendDataParams last_send_data_params() const {
     return last_send_data_params_;
   }
@@ -148,6 +159,7 @@ class FakeDataChannelProvider : public webrtc::DataChannelProviderInterface {
   bool transport_available_;
   bool ready_to_send_;
   bool transport_error_;
+  int send_data_batch_count_ = 0;
   std::set<webrtc::DataChannel*> connected_channels_;
   std::set<uint32_t> send_ssrcs_;
   std::set<uint32_t> recv_ssrcs_;
@@ -25,6 +25,7 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/strings/match.h"
+#include "absl/strings/string_view.h"
 #include "api/candidate.h"
 #include "api/crypto_params.h"
 #include "api/jsep_ice_candidate.h"
@@ -489,7 +490,8 @@ static bool GetLine(const std::string& message,
   if (line_end > 0 && (message.at(line_end - 1) == kReturnChar)) {
     --line_end;
   }
-  *line = message.substr(line_begin, (line_end - line_begin));
+  // Reuse the capacity of |line|, which callers pass for every line.
+  line->assign(message, line_begin, line_end - line_begin);
   const char* cline = line->c_str();
   // RFC 4566
   // An SDP session description consists of a number of lines of text of
@@ -619,23 +621,46 @@ static bool AddSsrcLine(uint32_t ssrc_id,
 }
 
 // Get value only from <attribute>:<value>.
-static bool GetValue(const std::string& message,
+static bool GetValue(absl::string_view message,
                      const std::string& attribute,
                      std::string* value,
                      SdpParseError* error) {
-  std::string leftpart;
-  if (!rtc::tokenize_first(message, kSdpDelimiterColonChar, &leftpart, value)) {
-    return ParseFailedGetValue(message, attribute, error);
+  size_t colon = message.find(kSdpDelimiterColonChar);
+  if (colon == absl::string_view::npos) {
+    return ParseFailedGetValue(std::string(message), attribute, error);
   }
   // The left part should end with the expected attribute.
-  if (leftpart.length() < attribute.length() ||
-      leftpart.compare(leftpart.length() - attribute.length(),
-                       attribute.length(), attribute) != 0) {
-    return ParseFailedGetValue(message, attribute, error);
+  if (!absl::EndsWith(message.substr(0, colon), attribute)) {
+    return ParseFailedGetValue(std::string(message), attribute, error);
+  }
+  // As with rtc::tokenize_first(), repeated delimiters are skipped.
+  size_t value_begin = message.find_first_not_of(kSdpDelimiterColonChar, colon);
+  if (value_begin == absl::string_view::npos) {
+    value->clear();
+  } else {
+    value->assign(message.data() + value_begin, message.size() - value_begin);
   }
   return true;
 }
 
+// Like rtc::split(), but the fields are views into |source|, so no string is
+// allocated per field. Used for the attributes that repeat for every codec.
+static size_t SplitToViews(absl::string_view source,
+                           char delimiter,
+                           std::vector<absl::string_view>* fields) {
+  RTC_DCHECK(fields);
+  fields->clear();
+  size_t last = 0;
+  for (size_t i = 0; i < source.length(); ++i) {
+    if (source[i] == delimiter) {
+      fields->push_back(source.substr(last, i - last));
+      last = i + 1;
+    }
+  }
+  fields->push_back(source.substr(last));
+  return fields->size();
+}
+
 static bool CaseInsensitiveFind(std::string str1, std::string str2) {
   absl::c_transform(str1, str1.begin(), ::tolower);
   absl::c_transform(str2, str2.begin(), ::tolower);
@@ -644,19 +669,21 @@ static bool CaseInsensitiveFind(std::string str1, std::string str2) {
 
 template <class T>
 static bool GetValueFromString(const std::string& line,
-                               const std::string& s,
+                               absl::string_view s,
                                T* t,
                                SdpParseError* error) {
-  if (!rtc::FromString(s, t)) {
+  // Fields are short enough to fit the small string buffer.
+  std::string value(s);
+  if (!rtc::FromString(value, t)) {
     rtc::StringBuilder description;
-    description << "Invalid value: " << s << ".";
+    description << "Invalid value: " << value << ".";
     return ParseFailed(line, description.str(), error);
   }
   return true;
 }
 
 static bool GetPayloadTypeFromString(const std::string& line,
-                                     const std::string& s,
+                                     absl::string_view s,
                                      int* payload_type,
                                      SdpParseError* error) {
   return GetValueFromString(line, s, payload_type, error) &&
@@ -862,6 +889,11 @@ static bool IsValidPort(int port) {
 }
 
 std::string SdpSerialize(const JsepSessionDescription& jdesc) {
+  return SdpSerialize(jdesc, nullptr);
+}
+
+std::string SdpSerialize(const JsepSessionDescription& jdesc,
+                         std::vector<std::string>* serialized_sections) {
   const cricket::SessionDescription* desc = jdesc.description();
   if (!desc) {
     return "";
@@ -946,14 +978,29 @@ std::string SdpSerialize(const JsepSessionDescription& jdesc) {
     }
   }
 
+  if (serialized_sections) {
+    serialized_sections->resize(desc->contents().size());
+  }
+
   // Preserve the order of the media contents.
   int mline_index = -1;
   for (const ContentInfo& content : desc->contents()) {
+    ++mline_index;
+    if (serialized_sections && !(*serialized_sections)[mline_index].empty()) {
+      message.append((*serialized_sections)[mline_index]);
+      continue;
+    }
     std::vector<Candidate> candidates;
-    GetCandidatesByMindex(jdesc, ++mline_index, &candidates);
+    GetCandidatesByMindex(jdesc, mline_index, &candidates);
+    std::string* section = serialized_sections
+                               ? &(*serialized_sections)[mline_index]
+                               : &message;
     BuildMediaDescription(&content, desc->GetTransportInfoByName(content.name),
                           content.media_description()->type(), candidates,
-                          desc->msid_signaling(), &message);
+                          desc->msid_signaling(), section);
+    if (serialized_sections) {
+      message.append(*section);
+    }
   }
   return message;
 }
@@ -2924,25 +2971,12 @@ T GetCodecWithPayloadType(const std::vector<T>& codecs, int payload_type) {
   return ret_val;
 }
 
-// Updates or creates a new codec entry in the audio description.
+// Updates or creates a new codec entry in the audio description. The codec is
+// replaced in place, rather than by copying all codecs of the description for
+// every rtpmap, fmtp and rtcp-fb line.
 template <class T, class U>
 void AddOrReplaceCodec(MediaContentDescription* content_desc, const U& codec) {
-  T* desc = static_cast<T*>(content_desc);
-  std::vector<U> codecs = desc->codecs();
-  bool found = false;
-  for (U& existing_codec : codecs) {
-    if (codec.id == existing_codec.id) {
-      // Overwrite existing codec with the new codec.
-      existing_codec = codec;
-      found = true;
-      break;
-    }
-  }
-  if (!found) {
-    desc->AddCodec(codec);
-    return;
-  }
-  desc->set_codecs(codecs);
+  static_cast<T*>(content_desc)->AddOrReplaceCodec(codec);
 }
 
 // Adds or updates existing codec corresponding to |payload_type| according
@@ -3548,8 +3582,9 @@ bool ParseSsrcGroupAttribute(const std::string& line,
   RTC_DCHECK(ssrc_groups != NULL);
   // RFC 5576
   // a=ssrc-group:<semantics> <ssrc-id> ...
-  std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  std::vector<absl::string_view> fields;
+  SplitToViews(absl::string_view(line).substr(kLinePrefixLength),
+               kSdpDelimiterSpaceChar, &fields);
   const size_t expected_min_fields = 2;
   if (fields.size() < expected_min_fields) {
     return ParseFailedExpectMinFieldNum(line, expected_min_fields, error);
@@ -3639,8 +3674,9 @@ bool ParseRtpmapAttribute(const std::string& line,
                           const std::vector<int>& payload_types,
                           MediaContentDescription* media_desc,
                           SdpParseError* error) {
-  std::vector<std::string> fields;
-  rtc::split(line.substr(kLinePrefixLength), kSdpDelimiterSpaceChar, &fields);
+  std::vector<absl::string_view> fields;
+  SplitToViews(absl::string_view(line).substr(kLinePrefixLength),
+               kSdpDelimiterSpaceChar, &fields);
   // RFC 4566
   // a=rtpmap:<payload type> <encoding name>/<clock rate>[/<encodingparameters>]
   const size_t expected_min_fields = 2;
@@ -3663,9 +3699,8 @@ bool ParseRtpmapAttribute(const std::string& line,
                         << line;
     return true;
   }
-  const std::string& encoder = fields[1];
-  std::vector<std::string> codec_params;
-  rtc::split(encoder, '/', &codec_params);
+  std::vector<absl::string_view> codec_params;
+  SplitToViews(fields[1], '/', &codec_params);
   // <encoding name>/<clock rate>[/<encodingparameters>]
   // 2 mandatory fields
   if (codec_params.size() < 2 || codec_params.size() > 3) {
@@ -3674,7 +3709,7 @@ bool ParseRtpmapAttribute(const std::string& line,
                        "[/<encodingparameters>]\".",
                        error);
   }
-  const std::string& encoding_name = codec_params[0];
+  const std::string encoding_name(codec_params[0]);
   int clock_rate = 0;
   if (!GetValueFromString(line, codec_params[1], &clock_rate, error)) {
     return false;
@@ -3819,8 +3854,8 @@ bool ParseRtcpFbAttribute(const std::string& line,
       media_type != cricket::MEDIA_TYPE_VIDEO) {
     return true;
   }
-  std::vector<std::string> rtcp_fb_fields;
-  rtc::split(line.c_str(), kSdpDelimiterSpaceChar, &rtcp_fb_fields);
+  std::vector<absl::string_view> rtcp_fb_fields;
+  SplitToViews(line, kSdpDelimiterSpaceChar, &rtcp_fb_fields);
   if (rtcp_fb_fields.size() < 2) {
     return ParseFailedGetValue(line, kAttributeRtcpFb, error);
   }
@@ -3836,11 +3871,11 @@ bool ParseRtcpFbAttribute(const std::string& line,
       return false;
     }
   }
-  std::string id = rtcp_fb_fields[1];
-  std::string param = "";
-  for (std::vector<std::string>::iterator iter = rtcp_fb_fields.begin() + 2;
-       iter != rtcp_fb_fields.end(); ++iter) {
-    param.append(*iter);
+  std::string id(rtcp_fb_fields[1]);
+  std::string param;
+  for (auto iter = rtcp_fb_fields.begin() + 2; iter != rtcp_fb_fields.end();
+       ++iter) {
+    param.append(iter->data(), iter->size());
   }
   const cricket::FeedbackParam feedback_param(id, param);
 
@@ -21,6 +21,7 @@
 #define PC_WEBRTC_SDP_H_
 
 #include <string>
+#include <vector>
 
 #include "rtc_base/system/rtc_export.h"
 
@@ -42,6 +43,13 @@ struct SdpParseError;
 // return - SDP string serialized from the arguments.
 std::string SdpSerialize(const JsepSessionDescription& jdesc);
 
+// Like above, but reuses the text of the m= sections that is not empty in
+// |serialized_sections|, indexed by m= section, and stores the text of the
+// other sections there. Callers clear the entries of the sections that
+// changed since the last call.
+std::string SdpSerialize(const JsepSessionDescription& jdesc,
+                         std::vector<std::string>* serialized_sections);
+
 // Serializes the passed in IceCandidateInterface to a SDP string.
 // candidate - The candidate to be serialized.
 std::string SdpSerializeCandidate(const IceCandidateInterface& candidate);
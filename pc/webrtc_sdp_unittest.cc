@@ -41,7 +41,10 @@
 #include "rtc_base/message_digest.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_fingerprint.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/string_encode.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -1003,6 +1006,60 @@ static void ReplaceRejected(bool audio_rejected,
 
 // WebRtcSdpTest
 
+// Builds a Unified Plan offer with |num_sections| m= sections, alternating
+// audio and video, like an SFU sends for a large room.
+static std::string MakeLargeUnifiedPlanSdp(int num_sections) {
+  rtc::StringBuilder sdp;
+  sdp << "v=0\r\n"
+         "o=- 18446744069414584320 18446462598732840960 IN IP4 127.0.0.1\r\n"
+         "s=-\r\n"
+         "t=0 0\r\n"
+         "a=msid-semantic: WMS\r\n";
+  for (int i = 0; i < num_sections; ++i) {
+    if (i % 2 == 0) {
+      sdp << "m=audio 9 UDP/TLS/RTP/SAVPF 111 103 104\r\n"
+             "c=IN IP4 0.0.0.0\r\n"
+             "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+             "a=ice-ufrag:ufrag\r\na=ice-pwd:pwd\r\n"
+          << "a=mid:" << i << "\r\n"
+          << "a=msid:stream_" << i << " track_" << i << "\r\n"
+          << "a=sendrecv\r\n"
+             "a=rtcp-mux\r\n"
+             "a=rtpmap:111 opus/48000/2\r\n"
+             "a=rtcp-fb:111 transport-cc\r\n"
+             "a=fmtp:111 minptime=10;useinbandfec=1\r\n"
+             "a=rtpmap:103 ISAC/16000\r\n"
+             "a=rtpmap:104 ISAC/32000\r\n"
+          << "a=ssrc:" << 1000 + i << " cname:cname_" << i << "\r\n";
+    } else {
+      sdp << "m=video 9 UDP/TLS/RTP/SAVPF 96 97 98 99\r\n"
+             "c=IN IP4 0.0.0.0\r\n"
+             "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+             "a=ice-ufrag:ufrag\r\na=ice-pwd:pwd\r\n"
+          << "a=mid:" << i << "\r\n"
+          << "a=msid:stream_" << i << " track_" << i << "\r\n"
+          << "a=sendrecv\r\n"
+             "a=rtcp-mux\r\n"
+             "a=rtcp-rsize\r\n";
+      for (int pt : {96, 98}) {
+        sdp << "a=rtpmap:" << pt << (pt == 96 ? " VP8" : " H264")
+            << "/90000\r\n"
+            << "a=rtcp-fb:" << pt << " goog-remb\r\n"
+            << "a=rtcp-fb:" << pt << " transport-cc\r\n"
+            << "a=rtcp-fb:" << pt << " ccm fir\r\n"
+            << "a=rtcp-fb:" << pt << " nack\r\n"
+            << "a=rtcp-fb:" << pt << " nack pli\r\n"
+            << "a=rtpmap:" << pt + 1 << " rtx/90000\r\n"
+            << "a=fmtp:" << pt + 1 << " apt=" << pt << "\r\n";
+      }
+      sdp << "a=ssrc-group:FID " << 2000 + i << " " << 3000 + i << "\r\n"
+          << "a=ssrc:" << 2000 + i << " cname:cname_" << i << "\r\n"
+          << "a=ssrc:" << 3000 + i << " cname:cname_" << i << "\r\n";
+    }
+  }
+  return sdp.Release();
+}
+
 class WebRtcSdpTest : public ::testing::Test {
  public:
   WebRtcSdpTest() : jdesc_(kDummyType) {
@@ -4736,3 +4793,49 @@ TEST_F(WebRtcSdpTest, DeserializeWithAllSctpProtocols) {
     EXPECT_TRUE(webrtc::SdpDeserialize(message, &jsep_output, &error));
   }
 }
+
+// Test that a large Unified Plan offer survives a round trip, and that the
+// attributes repeated for every codec are all applied.
+TEST_F(WebRtcSdpTest, RoundTripLargeUnifiedPlanOffer) {
+  const int kNumSections = 200;
+  JsepSessionDescription jdesc(kDummyType);
+  ASSERT_TRUE(SdpDeserialize(MakeLargeUnifiedPlanSdp(kNumSections), &jdesc));
+  ASSERT_EQ(static_cast<size_t>(kNumSections),
+            jdesc.description()->contents().size());
+
+  const VideoContentDescription* video =
+      jdesc.description()->contents()[1].media_description()->as_video();
+  ASSERT_EQ(4u, video->codecs().size());
+  EXPECT_EQ("VP8", video->codecs()[0].name);
+  EXPECT_EQ(5u, video->codecs()[0].feedback_params.params().size());
+  EXPECT_EQ("98", video->codecs()[3].params.at("apt"));
+  ASSERT_EQ(1u, video->streams().size());
+  EXPECT_EQ(2u, video->streams()[0].ssrcs.size());
+
+  std::string serialized = webrtc::SdpSerialize(jdesc);
+  JsepSessionDescription reparsed(kDummyType);
+  ASSERT_TRUE(SdpDeserialize(serialized, &reparsed));
+  EXPECT_TRUE(CompareSessionDescription(jdesc, reparsed));
+  EXPECT_EQ(serialized, webrtc::SdpSerialize(reparsed));
+}
+
+// Measures parsing and serializing a 200 m= section Unified Plan offer. Run
+// with --gtest_also_run_disabled_tests to get the times logged.
+TEST_F(WebRtcSdpTest, DISABLED_LargeUnifiedPlanOfferPerf) {
+  const int kIterations = 50;
+  const std::string sdp = MakeLargeUnifiedPlanSdp(200);
+  int64_t parse_us = 0;
+  int64_t serialize_us = 0;
+  for (int i = 0; i < kIterations; ++i) {
+    JsepSessionDescription jdesc(kDummyType);
+    int64_t start_us = rtc::TimeMicros();
+    ASSERT_TRUE(SdpDeserialize(sdp, &jdesc));
+    int64_t parsed_us = rtc::TimeMicros();
+    webrtc::SdpSerialize(jdesc);
+    parse_us += parsed_us - start_us;
+    serialize_us += rtc::TimeMicros() - parsed_us;
+  }
+  RTC_LOG(LS_INFO) << "Parse: " << parse_us / kIterations
+                   << " us, serialize: " << serialize_us / kIterations
+                   << " us, for " << sdp.size() << " bytes.";
+}
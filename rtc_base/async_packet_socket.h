@@ -49,6 +49,12 @@ struct PacketOptions {
   PacketTimeUpdateParams packet_time_params;
   // PacketInfo is passed to SentPacket when signaling this packet is sent.
   PacketInfo info_signaled_after_sent;
+  // If set, the socket may delay the packet and send it together with the
+  // following batchable packets in a single system call. Batched packets are
+  // flushed no later than when a packet with |last_packet_in_batch| set, or a
+  // packet that is not batchable, is sent.
+  bool batchable = false;
+  bool last_packet_in_batch = false;
 };
 
 // Provides the ability to receive packets asynchronously. Sends are not
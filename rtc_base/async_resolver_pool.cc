@@ -0,0 +1,246 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/async_resolver_pool.h"
+
+#include "rtc_base/checks.h"
+#include "rtc_base/location.h"
+#include "rtc_base/net_helpers.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+
+// A resolver handed out by the pool. It only lives on the thread it was
+// started on.
+class AsyncResolverPool::PooledResolver : public AsyncResolverInterface {
+ public:
+  explicit PooledResolver(scoped_refptr<AsyncResolverPool> pool)
+      : pool_(std::move(pool)) {}
+
+  void Start(const SocketAddress& addr) override;
+  bool GetResolvedAddress(int family, SocketAddress* addr) const override;
+  int GetError() const override { return error_; }
+  void Destroy(bool wait) override;
+
+  void OnResolved(const Result& result);
+
+ private:
+  ~PooledResolver() override = default;
+
+  const scoped_refptr<AsyncResolverPool> pool_;
+  SocketAddress addr_;
+  scoped_refptr<Request> request_;
+  int error_ = -1;
+  std::vector<IPAddress> addresses_;
+};
+
+// The pending lookup of a resolver, which outlives it if the resolver is
+// destroyed before the result comes.
+class AsyncResolverPool::Request : public RefCountInterface {
+ public:
+  explicit Request(PooledResolver* resolver)
+      : resolver_(resolver), thread_(Thread::Current()) {
+    RTC_DCHECK(thread_);
+  }
+
+  Thread* thread() const { return thread_; }
+
+  void Cancel() {
+    RTC_DCHECK(thread_->IsCurrent());
+    resolver_ = nullptr;
+  }
+
+  void Deliver(const Result& result) {
+    RTC_DCHECK(thread_->IsCurrent());
+    if (resolver_)
+      resolver_->OnResolved(result);
+  }
+
+ private:
+  PooledResolver* resolver_;
+  Thread* const thread_;
+};
+
+void AsyncResolverPool::PooledResolver::Start(const SocketAddress& addr) {
+  RTC_DCHECK(!request_);
+  addr_ = addr;
+  request_ = new RefCountedObject<Request>(this);
+  pool_->StartRequest(Key(addr.hostname(), addr.family()), request_);
+}
+
+bool AsyncResolverPool::PooledResolver::GetResolvedAddress(
+    int family,
+    SocketAddress* addr) const {
+  if (error_ != 0 || addresses_.empty())
+    return false;
+
+  *addr = addr_;
+  for (const IPAddress& address : addresses_) {
+    if (family == address.family()) {
+      addr->SetResolvedIP(address);
+      return true;
+    }
+  }
+  return false;
+}
+
+void AsyncResolverPool::PooledResolver::Destroy(bool wait) {
+  // There is no thread to wait for.
+  if (request_)
+    request_->Cancel();
+  delete this;
+}
+
+void AsyncResolverPool::PooledResolver::OnResolved(const Result& result) {
+  request_ = nullptr;
+  error_ = result.error;
+  addresses_ = result.addresses;
+  SignalDone(this);
+}
+
+AsyncResolverPool* AsyncResolverPool::Default() {
+  static AsyncResolverPool* const pool = Create(Config()).release();
+  return pool;
+}
+
+scoped_refptr<AsyncResolverPool> AsyncResolverPool::Create(
+    const Config& config) {
+  return new RefCountedObject<AsyncResolverPool>(config);
+}
+
+AsyncResolverPool::AsyncResolverPool(const Config& config) : config_(config) {
+  RTC_DCHECK_GT(config_.max_threads, 0);
+}
+
+AsyncResolverPool::~AsyncResolverPool() {
+  std::vector<std::unique_ptr<Thread>> workers;
+  {
+    CritScope cs(&crit_);
+    workers.swap(workers_);
+  }
+  // The requests waiting for a lookup don't keep the pool alive, so a worker
+  // may still be resolving; stopping the worker waits for it.
+  workers.clear();
+}
+
+AsyncResolverInterface* AsyncResolverPool::CreateResolver() {
+  return new PooledResolver(this);
+}
+
+size_t AsyncResolverPool::num_threads() const {
+  CritScope cs(&crit_);
+  return workers_.size();
+}
+
+int AsyncResolverPool::Resolve(const std::string& hostname,
+                               int family,
+                               std::vector<IPAddress>* addresses) {
+  return ResolveHostname(hostname, family, addresses);
+}
+
+void AsyncResolverPool::StartRequest(const Key& key,
+                                     scoped_refptr<Request> request) {
+  CritScope cs(&crit_);
+  auto cached = cache_.find(key);
+  if (cached != cache_.end()) {
+    if (cached->second.expires_ms > TimeMillis()) {
+      // Signaled asynchronously, like a lookup.
+      Result result = cached->second.result;
+      request->thread()->PostTask(
+          RTC_FROM_HERE, [request, result] { request->Deliver(result); });
+      return;
+    }
+    cache_.erase(cached);
+  }
+
+  std::vector<scoped_refptr<Request>>& waiting = waiting_requests_[key];
+  waiting.push_back(std::move(request));
+  if (waiting.size() > 1)
+    return;
+
+  queued_lookups_.push_back(key);
+  Thread* worker = nullptr;
+  if (!idle_workers_.empty()) {
+    worker = idle_workers_.back();
+    idle_workers_.pop_back();
+  } else if (workers_.size() < static_cast<size_t>(config_.max_threads)) {
+    workers_.push_back(Thread::Create());
+    worker = workers_.back().get();
+    worker->SetName("AsyncResolverPool", this);
+    worker->Start();
+  }
+  // Otherwise the lookup is done by a worker when its current ones are done.
+  if (worker)
+    worker->PostTask(RTC_FROM_HERE, [this, worker] { RunLookups(worker); });
+}
+
+void AsyncResolverPool::RunLookups(Thread* worker) {
+  while (true) {
+    Key key;
+    {
+      CritScope cs(&crit_);
+      if (queued_lookups_.empty()) {
+        idle_workers_.push_back(worker);
+        return;
+      }
+      key = std::move(queued_lookups_.front());
+      queued_lookups_.pop_front();
+    }
+
+    Result result;
+    result.error = Resolve(key.first, key.second, &result.addresses);
+
+    std::vector<scoped_refptr<Request>> waiting;
+    {
+      CritScope cs(&crit_);
+      AddToCache(key, result);
+      auto it = waiting_requests_.find(key);
+      RTC_DCHECK(it != waiting_requests_.end());
+      waiting.swap(it->second);
+      waiting_requests_.erase(it);
+    }
+    for (scoped_refptr<Request>& request : waiting) {
+      request->thread()->PostTask(
+          RTC_FROM_HERE, [request, result] { request->Deliver(result); });
+    }
+  }
+}
+
+void AsyncResolverPool::AddToCache(const Key& key, const Result& result) {
+  int64_t now_ms = TimeMillis();
+  int ttl_ms =
+      result.error == 0 ? config_.cache_ttl_ms : config_.negative_cache_ttl_ms;
+  if (ttl_ms <= 0 || config_.max_cache_entries == 0)
+    return;
+  if (cache_.size() >= config_.max_cache_entries) {
+    for (auto it = cache_.begin(); it != cache_.end();) {
+      if (it->second.expires_ms <= now_ms) {
+        it = cache_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (cache_.size() >= config_.max_cache_entries) {
+      auto oldest = cache_.begin();
+      for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+        if (it->second.expires_ms < oldest->second.expires_ms)
+          oldest = it;
+      }
+      cache_.erase(oldest);
+    }
+  }
+  CacheEntry& entry = cache_[key];
+  entry.result = result;
+  entry.expires_ms = now_ms + ttl_ms;
+}
+
+}  // namespace rtc
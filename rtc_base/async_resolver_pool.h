@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_ASYNC_RESOLVER_POOL_H_
+#define RTC_BASE_ASYNC_RESOLVER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "rtc_base/async_resolver_interface.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Resolves hostnames on a bounded set of worker threads and caches the
+// results, so that many ports resolving the same STUN or TURN server don't
+// each start a thread and a DNS lookup, as AsyncResolver does. Lookups of a
+// hostname that is already being resolved wait for the same result.
+//
+// getaddrinfo() doesn't tell the TTL of the records, so results are kept for
+// |cache_ttl_ms|, and failures for the shorter |negative_cache_ttl_ms|.
+//
+// The pool can be used from any thread; resolvers signal on the thread they
+// were started on, which must be an rtc::Thread.
+class AsyncResolverPool : public RefCountInterface {
+ public:
+  struct Config {
+    // Worker threads are started as needed, up to this many.
+    int max_threads = 4;
+    int cache_ttl_ms = 60 * 1000;
+    int negative_cache_ttl_ms = 5 * 1000;
+    size_t max_cache_entries = 1000;
+  };
+
+  // Returns the pool shared by the process, which is never destroyed.
+  static AsyncResolverPool* Default();
+  static scoped_refptr<AsyncResolverPool> Create(const Config& config);
+
+  // Returns a resolver that resolves through the pool, to be deleted with
+  // Destroy(). The resolver keeps the pool alive.
+  AsyncResolverInterface* CreateResolver();
+
+  size_t num_threads() const;
+
+ protected:
+  explicit AsyncResolverPool(const Config& config);
+  ~AsyncResolverPool() override;
+
+  // Resolves |hostname| like getaddrinfo(). Called on the worker threads;
+  // virtual for testing.
+  virtual int Resolve(const std::string& hostname,
+                      int family,
+                      std::vector<IPAddress>* addresses);
+
+ private:
+  class PooledResolver;
+  class Request;
+  struct Result {
+    int error = -1;
+    std::vector<IPAddress> addresses;
+  };
+  struct CacheEntry {
+    Result result;
+    int64_t expires_ms = 0;
+  };
+  // The hostname and family of a lookup.
+  using Key = std::pair<std::string, int>;
+
+  void StartRequest(const Key& key, scoped_refptr<Request> request);
+  // Runs the queued lookups on |worker| until there are none left.
+  void RunLookups(Thread* worker);
+  void AddToCache(const Key& key, const Result& result)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  const Config config_;
+  mutable CriticalSection crit_;
+  std::map<Key, CacheEntry> cache_ RTC_GUARDED_BY(crit_);
+  // The requests waiting for each lookup that is queued or running.
+  std::map<Key, std::vector<scoped_refptr<Request>>> waiting_requests_
+      RTC_GUARDED_BY(crit_);
+  std::deque<Key> queued_lookups_ RTC_GUARDED_BY(crit_);
+  std::vector<std::unique_ptr<Thread>> workers_ RTC_GUARDED_BY(crit_);
+  std::vector<Thread*> idle_workers_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_ASYNC_RESOLVER_POOL_H_
@@ -0,0 +1,204 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/async_resolver_pool.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/gunit.h"
+#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace rtc {
+
+namespace {
+const int kTimeoutMs = 5000;
+const char kHostname[] = "server.example.com";
+const IPAddress kAddress(0x01020304);
+
+// Resolves any hostname but "unknown" to |kAddress|, optionally waiting until
+// it is told to go on.
+class FakeResolverPool : public AsyncResolverPool {
+ public:
+  explicit FakeResolverPool(const Config& config)
+      : AsyncResolverPool(config), proceed_(true, true) {}
+
+  void Block() { proceed_.Reset(); }
+  void Unblock() { proceed_.Set(); }
+
+  int num_lookups() const {
+    CritScope cs(&crit_);
+    return num_lookups_;
+  }
+  std::set<Thread*> lookup_threads() const {
+    CritScope cs(&crit_);
+    return lookup_threads_;
+  }
+
+ protected:
+  int Resolve(const std::string& hostname,
+              int family,
+              std::vector<IPAddress>* addresses) override {
+    {
+      CritScope cs(&crit_);
+      ++num_lookups_;
+      lookup_threads_.insert(Thread::Current());
+    }
+    proceed_.Wait(Event::kForever);
+    if (hostname == "unknown")
+      return -1;
+    addresses->push_back(kAddress);
+    return 0;
+  }
+
+ private:
+  Event proceed_;
+  mutable CriticalSection crit_;
+  int num_lookups_ RTC_GUARDED_BY(crit_) = 0;
+  std::set<Thread*> lookup_threads_ RTC_GUARDED_BY(crit_);
+};
+}  // namespace
+
+class AsyncResolverPoolTest : public ::testing::Test,
+                              public sigslot::has_slots<> {
+ public:
+  AsyncResolverPoolTest() { CreatePool(AsyncResolverPool::Config()); }
+
+  ~AsyncResolverPoolTest() override {
+    pool_->Unblock();
+    for (AsyncResolverInterface* resolver : resolvers_)
+      resolver->Destroy(false);
+  }
+
+  void CreatePool(const AsyncResolverPool::Config& config) {
+    pool_ = new RefCountedObject<FakeResolverPool>(config);
+  }
+
+  AsyncResolverInterface* Resolve(const std::string& hostname) {
+    AsyncResolverInterface* resolver = pool_->CreateResolver();
+    resolver->SignalDone.connect(this, &AsyncResolverPoolTest::OnDone);
+    resolvers_.push_back(resolver);
+    resolver->Start(SocketAddress(hostname, 3478));
+    return resolver;
+  }
+
+  void OnDone(AsyncResolverInterface* resolver) {
+    EXPECT_TRUE(main_thread_.IsCurrent());
+    done_.insert(resolver);
+  }
+
+ protected:
+  AutoThread main_thread_;
+  scoped_refptr<FakeResolverPool> pool_;
+  std::vector<AsyncResolverInterface*> resolvers_;
+  std::set<AsyncResolverInterface*> done_;
+};
+
+TEST_F(AsyncResolverPoolTest, ResolvesOnWorkerThread) {
+  AsyncResolverInterface* resolver = Resolve(kHostname);
+  ASSERT_TRUE_WAIT(done_.count(resolver), kTimeoutMs);
+  EXPECT_EQ(0, resolver->GetError());
+  SocketAddress address;
+  ASSERT_TRUE(resolver->GetResolvedAddress(AF_INET, &address));
+  EXPECT_EQ(kHostname, address.hostname());
+  EXPECT_EQ(kAddress, address.ipaddr());
+  EXPECT_EQ(3478, address.port());
+  EXPECT_FALSE(resolver->GetResolvedAddress(AF_INET6, &address));
+  EXPECT_EQ(0u, pool_->lookup_threads().count(&main_thread_));
+}
+
+TEST_F(AsyncResolverPoolTest, CachesResults) {
+  AsyncResolverInterface* first = Resolve(kHostname);
+  ASSERT_TRUE_WAIT(done_.count(first), kTimeoutMs);
+  // Signaled asynchronously from the cache.
+  AsyncResolverInterface* second = Resolve(kHostname);
+  EXPECT_EQ(0u, done_.count(second));
+  ASSERT_TRUE_WAIT(done_.count(second), kTimeoutMs);
+  EXPECT_EQ(kAddress, second->address().ipaddr());
+  EXPECT_EQ(1, pool_->num_lookups());
+
+  AsyncResolverInterface* other = Resolve("other.example.com");
+  ASSERT_TRUE_WAIT(done_.count(other), kTimeoutMs);
+  EXPECT_EQ(2, pool_->num_lookups());
+}
+
+TEST_F(AsyncResolverPoolTest, ResolvesAgainWhenCachedResultExpires) {
+  AsyncResolverPool::Config config;
+  config.cache_ttl_ms = 1;
+  CreatePool(config);
+  AsyncResolverInterface* first = Resolve(kHostname);
+  ASSERT_TRUE_WAIT(done_.count(first), kTimeoutMs);
+  Thread::SleepMs(5);
+  AsyncResolverInterface* second = Resolve(kHostname);
+  ASSERT_TRUE_WAIT(done_.count(second), kTimeoutMs);
+  EXPECT_EQ(2, pool_->num_lookups());
+}
+
+TEST_F(AsyncResolverPoolTest, CachesFailures) {
+  AsyncResolverInterface* first = Resolve("unknown");
+  ASSERT_TRUE_WAIT(done_.count(first), kTimeoutMs);
+  EXPECT_NE(0, first->GetError());
+  SocketAddress address;
+  EXPECT_FALSE(first->GetResolvedAddress(AF_INET, &address));
+
+  AsyncResolverInterface* second = Resolve("unknown");
+  ASSERT_TRUE_WAIT(done_.count(second), kTimeoutMs);
+  EXPECT_NE(0, second->GetError());
+  EXPECT_EQ(1, pool_->num_lookups());
+}
+
+TEST_F(AsyncResolverPoolTest, SharesLookupOfSameHostname) {
+  pool_->Block();
+  AsyncResolverInterface* first = Resolve(kHostname);
+  AsyncResolverInterface* second = Resolve(kHostname);
+  pool_->Unblock();
+  ASSERT_TRUE_WAIT(done_.count(first) && done_.count(second), kTimeoutMs);
+  EXPECT_EQ(kAddress, first->address().ipaddr());
+  EXPECT_EQ(kAddress, second->address().ipaddr());
+  EXPECT_EQ(1, pool_->num_lookups());
+}
+
+TEST_F(AsyncResolverPoolTest, LimitsNumberOfThreads) {
+  AsyncResolverPool::Config config;
+  config.max_threads = 2;
+  CreatePool(config);
+  pool_->Block();
+  for (int i = 0; i < 5; ++i)
+    Resolve("server" + std::to_string(i) + ".example.com");
+  EXPECT_EQ(2u, pool_->num_threads());
+  // Each thread waits in a lookup, and the others wait for a thread.
+  EXPECT_EQ_WAIT(2, pool_->num_lookups(), kTimeoutMs);
+  Thread::SleepMs(10);
+  EXPECT_EQ(2, pool_->num_lookups());
+  pool_->Unblock();
+  EXPECT_EQ_WAIT(5u, done_.size(), kTimeoutMs);
+  EXPECT_EQ(5, pool_->num_lookups());
+  EXPECT_EQ(2u, pool_->lookup_threads().size());
+}
+
+TEST_F(AsyncResolverPoolTest, DestroyedResolverIsNotSignaled) {
+  pool_->Block();
+  AsyncResolverInterface* destroyed = Resolve(kHostname);
+  resolvers_.pop_back();
+  destroyed->Destroy(false);
+  AsyncResolverInterface* kept = Resolve(kHostname);
+  pool_->Unblock();
+  ASSERT_TRUE_WAIT(done_.count(kept), kTimeoutMs);
+  EXPECT_EQ(1u, done_.size());
+}
+
+}  // namespace rtc
@@ -148,38 +148,44 @@ int AsyncTCPSocketBase::SendTo(const void* pv,
 }
 
 int AsyncTCPSocketBase::SendRaw(const void* pv, size_t cb) {
-  if (outbuf_.size() + cb > max_outsize_) {
+  if (outbuf_.size() - outpos_ + cb > max_outsize_) {
     socket_->SetError(EMSGSIZE);
     return -1;
   }
 
-  RTC_DCHECK(!listen_);
-  outbuf_.AppendData(static_cast<const uint8_t*>(pv), cb);
+  AppendToOutBuffer(pv, cb);
 
   return FlushOutBuffer();
 }
 
 int AsyncTCPSocketBase::FlushOutBuffer() {
   RTC_DCHECK(!listen_);
-  int res = socket_->Send(outbuf_.data(), outbuf_.size());
+  int res = socket_->Send(outbuf_.data() + outpos_, outbuf_.size() - outpos_);
   if (res <= 0) {
     return res;
   }
-  if (static_cast<size_t>(res) > outbuf_.size()) {
+  if (static_cast<size_t>(res) > outbuf_.size() - outpos_) {
     RTC_NOTREACHED();
     return -1;
   }
-  size_t new_size = outbuf_.size() - res;
-  if (new_size > 0) {
-    memmove(outbuf_.data(), outbuf_.data() + res, new_size);
+  outpos_ += res;
+  if (outpos_ == outbuf_.size()) {
+    ClearOutBuffer();
   }
-  outbuf_.SetSize(new_size);
   return res;
 }
 
 void AsyncTCPSocketBase::AppendToOutBuffer(const void* pv, size_t cb) {
-  RTC_DCHECK(outbuf_.size() + cb <= max_outsize_);
+  RTC_DCHECK(outbuf_.size() - outpos_ + cb <= max_outsize_);
   RTC_DCHECK(!listen_);
+  if (outpos_ > 0) {
+    // Drop the bytes that have already been sent, so that |outbuf_| doesn't
+    // grow beyond |max_outsize_|.
+    size_t new_size = outbuf_.size() - outpos_;
+    memmove(outbuf_.data(), outbuf_.data() + outpos_, new_size);
+    outbuf_.SetSize(new_size);
+    outpos_ = 0;
+  }
   outbuf_.AppendData(static_cast<const uint8_t*>(pv), cb);
 }
 
@@ -252,11 +258,11 @@ void AsyncTCPSocketBase::OnReadEvent(AsyncSocket* socket) {
 void AsyncTCPSocketBase::OnWriteEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
-  if (outbuf_.size() > 0) {
+  if (!IsOutBufferEmpty()) {
     FlushOutBuffer();
   }
 
-  if (outbuf_.size() == 0) {
+  if (IsOutBufferEmpty()) {
     SignalReadyToSend(this);
   }
 }
@@ -315,21 +321,27 @@ int AsyncTCPSocket::Send(const void* pv,
 void AsyncTCPSocket::ProcessInput(char* data, size_t* len) {
   SocketAddress remote_addr(GetRemoteAddress());
 
+  // Frames are signaled in place; only the trailing partial frame, if any, is
+  // moved to the front of |data| once all complete frames are consumed.
+  size_t processed = 0;
   while (true) {
-    if (*len < kPacketLenSize)
-      return;
+    size_t remaining = *len - processed;
+    if (remaining < kPacketLenSize)
+      break;
 
-    PacketLength pkt_len = rtc::GetBE16(data);
-    if (*len < kPacketLenSize + pkt_len)
-      return;
+    PacketLength pkt_len = rtc::GetBE16(data + processed);
+    if (remaining < kPacketLenSize + pkt_len)
+      break;
 
-    SignalReadPacket(this, data + kPacketLenSize, pkt_len, remote_addr,
-                     TimeMicros());
+    SignalReadPacket(this, data + processed + kPacketLenSize, pkt_len,
+                     remote_addr, TimeMicros());
 
-    *len -= kPacketLenSize + pkt_len;
-    if (*len > 0) {
-      memmove(data, data + kPacketLenSize + pkt_len, *len);
-    }
+    processed += kPacketLenSize + pkt_len;
+  }
+
+  *len -= processed;
+  if (processed > 0 && *len > 0) {
+    memmove(data, data + processed, *len);
   }
 }
 
@@ -67,8 +67,11 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
   void AppendToOutBuffer(const void* pv, size_t cb);
 
   // Helper methods for |outpos_|.
-  bool IsOutBufferEmpty() const { return outbuf_.size() == 0; }
-  void ClearOutBuffer() { outbuf_.Clear(); }
+  bool IsOutBufferEmpty() const { return outpos_ == outbuf_.size(); }
+  void ClearOutBuffer() {
+    outbuf_.Clear();
+    outpos_ = 0;
+  }
 
  private:
   // Called by the underlying socket
@@ -81,6 +84,10 @@ class AsyncTCPSocketBase : public AsyncPacketSocket {
   bool listen_;
   Buffer inbuf_;
   Buffer outbuf_;
+  // Offset of the first byte in |outbuf_| that hasn't been sent yet. Sent
+  // bytes are only dropped from |outbuf_| when more data is appended, or all
+  // of it has been sent.
+  size_t outpos_ = 0;
   size_t max_insize_;
   size_t max_outsize_;
 
@@ -23,6 +23,9 @@
 namespace rtc {
 
 static const int BUF_SIZE = 64 * 1024;
+// Batches are flushed when they reach this many packets, even if the end of
+// the batch has not been signaled yet.
+static const size_t kMaxPendingSends = 64;
 
 AsyncUDPSocket* AsyncUDPSocket::Create(AsyncSocket* socket,
                                        const SocketAddress& bind_address) {
@@ -46,6 +49,7 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
 AsyncUDPSocket::AsyncUDPSocket(AsyncSocket* socket) : socket_(socket) {
   size_ = BUF_SIZE;
   buf_ = new char[size_];
+  SetReadBatchSize(1, 0);
 
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
@@ -70,6 +74,7 @@ int AsyncUDPSocket::Send(const void* pv,
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
+  FlushPendingSends();
   int ret = socket_->Send(pv, cb);
   SignalSentPacket(this, sent_packet);
   return ret;
@@ -82,12 +87,54 @@ int AsyncUDPSocket::SendTo(const void* pv,
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
+  if (options.batchable) {
+    if (num_pending_sends_ == pending_sends_.size())
+      pending_sends_.emplace_back();
+    PendingSend& pending = pending_sends_[num_pending_sends_++];
+    pending.data.SetData(static_cast<const uint8_t*>(pv), cb);
+    pending.address = addr;
+    pending.sent_packet = sent_packet;
+    if (options.last_packet_in_batch || num_pending_sends_ >= kMaxPendingSends)
+      FlushPendingSends();
+    return static_cast<int>(cb);
+  }
+  // Keep the packet order, in case a batch was not terminated properly.
+  FlushPendingSends();
   int ret = socket_->SendTo(pv, cb, addr);
   SignalSentPacket(this, sent_packet);
   return ret;
 }
 
+void AsyncUDPSocket::FlushPendingSends() {
+  if (num_pending_sends_ == 0)
+    return;
+  datagrams_to_send_.resize(num_pending_sends_);
+  for (size_t i = 0; i < num_pending_sends_; ++i) {
+    datagrams_to_send_[i].data = pending_sends_[i].data.data();
+    datagrams_to_send_[i].length = pending_sends_[i].data.size();
+    datagrams_to_send_[i].address = pending_sends_[i].address;
+  }
+  size_t sent = 0;
+  while (sent < num_pending_sends_) {
+    int ret = socket_->SendToBatch(&datagrams_to_send_[sent],
+                                   num_pending_sends_ - sent);
+    if (ret <= 0) {
+      // Like unbatched sends, the remaining packets are dropped on error.
+      RTC_LOG(LS_VERBOSE) << "Batched send failed with error "
+                          << socket_->GetError() << ", dropping "
+                          << (num_pending_sends_ - sent) << " packets.";
+      break;
+    }
+    sent += ret;
+  }
+  size_t num_signaled = num_pending_sends_;
+  num_pending_sends_ = 0;
+  for (size_t i = 0; i < num_signaled; ++i)
+    SignalSentPacket(this, pending_sends_[i].sent_packet);
+}
+
 int AsyncUDPSocket::Close() {
+  num_pending_sends_ = 0;
   return socket_->Close();
 }
 
@@ -111,13 +158,36 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+void AsyncUDPSocket::SetReadBatchSize(size_t max_batch_size,
+                                      size_t max_datagram_size) {
+  RTC_DCHECK_GE(max_batch_size, 1);
+  batch_.assign(max_batch_size, ReceivedDatagram());
+  batch_[0].buffer = buf_;
+  batch_[0].capacity = size_;
+  batch_buf_.reset(max_batch_size > 1
+                       ? new char[(max_batch_size - 1) * max_datagram_size]
+                       : nullptr);
+  for (size_t i = 1; i < max_batch_size; ++i) {
+    batch_[i].buffer = batch_buf_.get() + (i - 1) * max_datagram_size;
+    batch_[i].capacity = max_datagram_size;
+  }
+}
+
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
+  if (batch_.size() > 1) {
+    OnBatchedReadEvent();
+    return;
+  }
+
   SocketAddress remote_addr;
   int64_t timestamp;
   int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
   if (len < 0) {
+    // Sockets may signal readability when there is nothing left to read.
+    if (socket_->IsBlocking())
+      return;
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
     // When doing ICE, this kind of thing will often happen.
@@ -134,6 +204,34 @@ void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
                    (timestamp > -1 ? timestamp : TimeMicros()));
 }
 
+void AsyncUDPSocket::OnBatchedReadEvent() {
+  int count = socket_->RecvFromBatch(batch_.data(), batch_.size());
+  if (count < 0) {
+    // See OnReadEvent() for why errors are only logged.
+    if (socket_->IsBlocking())
+      return;
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] batched receive failed with error "
+                     << socket_->GetError();
+    return;
+  }
+
+  int64_t now_us = TimeMicros();
+  for (int i = 0; i < count; ++i) {
+    const ReceivedDatagram& datagram = batch_[i];
+    if (datagram.truncated) {
+      RTC_LOG(LS_WARNING) << "Dropping truncated datagram from "
+                          << datagram.address.ToSensitiveString()
+                          << ", buffer size " << datagram.capacity;
+      continue;
+    }
+    SignalReadPacket(this, static_cast<const char*>(datagram.buffer),
+                     datagram.length, datagram.address,
+                     (datagram.timestamp > -1 ? datagram.timestamp : now_us));
+  }
+}
+
 void AsyncUDPSocket::OnWriteEvent(AsyncSocket* socket) {
   SignalReadyToSend(this);
 }
@@ -14,9 +14,11 @@
 #include <stddef.h>
 
 #include <memory>
+#include <vector>
 
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/async_socket.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/socket_factory.h"
@@ -24,7 +26,9 @@
 namespace rtc {
 
 // Provides the ability to receive packets asynchronously.  Sends are not
-// buffered since it is acceptable to drop packets under high load.
+// buffered since it is acceptable to drop packets under high load, except for
+// packets sent with PacketOptions::batchable, which are held back until the
+// end of their batch and then written with a single Socket::SendToBatch().
 class AsyncUDPSocket : public AsyncPacketSocket {
  public:
   // Binds |socket| and creates AsyncUDPSocket for it. Takes ownership
@@ -56,15 +60,42 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Opt-in batched reading: on each read event up to |max_batch_size|
+  // datagrams are drained from the socket with a single
+  // Socket::RecvFromBatch() call and signaled one after the other through
+  // SignalReadPacket. The first datagram of a batch may be as large as with
+  // unbatched reads, the following ones are limited to |max_datagram_size|
+  // bytes and are dropped if they don't fit. A |max_batch_size| of 1 (the
+  // default) reads one datagram per event.
+  void SetReadBatchSize(size_t max_batch_size, size_t max_datagram_size);
+
  private:
+  struct PendingSend {
+    Buffer data;
+    SocketAddress address;
+    SentPacket sent_packet;
+  };
+
+  // Writes all held back batchable packets to the socket.
+  void FlushPendingSends();
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(AsyncSocket* socket);
+  // Reads and signals a batch of datagrams, see SetReadBatchSize().
+  void OnBatchedReadEvent();
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(AsyncSocket* socket);
 
   std::unique_ptr<AsyncSocket> socket_;
   char* buf_;
   size_t size_;
+  // Buffers used for all but the first datagram of a batched read.
+  std::unique_ptr<char[]> batch_buf_;
+  std::vector<ReceivedDatagram> batch_;
+  // Held back batchable packets. Only the first |num_pending_sends_| entries
+  // are in use, the others are kept to reuse their buffers.
+  std::vector<PendingSend> pending_sends_;
+  size_t num_pending_sends_ = 0;
+  std::vector<DatagramToSend> datagrams_to_send_;
 };
 
 }  // namespace rtc
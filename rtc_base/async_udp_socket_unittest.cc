@@ -12,6 +12,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/gunit.h"
 #include "rtc_base/physical_socket_server.h"
@@ -29,9 +30,15 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
         ready_to_send_(false) {
     udp_socket_->SignalReadyToSend.connect(this,
                                            &AsyncUdpSocketTest::OnReadyToSend);
+    udp_socket_->SignalSentPacket.connect(this,
+                                          &AsyncUdpSocketTest::OnSentPacket);
   }
 
   void OnReadyToSend(rtc::AsyncPacketSocket* socket) { ready_to_send_ = true; }
+  void OnSentPacket(rtc::AsyncPacketSocket* socket,
+                    const rtc::SentPacket& sent_packet) {
+    sent_packet_ids_.push_back(sent_packet.packet_id);
+  }
 
  protected:
   std::unique_ptr<PhysicalSocketServer> pss_;
@@ -39,6 +46,7 @@ class AsyncUdpSocketTest : public ::testing::Test, public sigslot::has_slots<> {
   AsyncSocket* socket_;
   std::unique_ptr<AsyncUDPSocket> udp_socket_;
   bool ready_to_send_;
+  std::vector<int64_t> sent_packet_ids_;
 };
 
 TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
@@ -47,4 +55,38 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+TEST_F(AsyncUdpSocketTest, BatchablePacketsHeldBackUntilEndOfBatch) {
+  const SocketAddress kDestination("1.1.1.1", 5000);
+  const char kPayload[] = "payload";
+  PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 2; ++i) {
+    options.packet_id = i;
+    EXPECT_EQ(static_cast<int>(sizeof(kPayload)),
+              udp_socket_->SendTo(kPayload, sizeof(kPayload), kDestination,
+                                  options));
+  }
+  EXPECT_TRUE(sent_packet_ids_.empty());
+
+  options.packet_id = 2;
+  options.last_packet_in_batch = true;
+  udp_socket_->SendTo(kPayload, sizeof(kPayload), kDestination, options);
+  EXPECT_EQ(std::vector<int64_t>({0, 1, 2}), sent_packet_ids_);
+}
+
+TEST_F(AsyncUdpSocketTest, UnbatchedPacketFlushesPendingBatch) {
+  const SocketAddress kDestination("1.1.1.1", 5000);
+  const char kPayload[] = "payload";
+  PacketOptions options;
+  options.batchable = true;
+  options.packet_id = 0;
+  udp_socket_->SendTo(kPayload, sizeof(kPayload), kDestination, options);
+  EXPECT_TRUE(sent_packet_ids_.empty());
+
+  options.batchable = false;
+  options.packet_id = 1;
+  udp_socket_->SendTo(kPayload, sizeof(kPayload), kDestination, options);
+  EXPECT_EQ(std::vector<int64_t>({0, 1}), sent_packet_ids_);
+}
+
 }  // namespace rtc
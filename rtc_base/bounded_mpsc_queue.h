@@ -0,0 +1,125 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_BOUNDED_MPSC_QUEUE_H_
+#define RTC_BASE_BOUNDED_MPSC_QUEUE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/constructor_magic.h"
+
+namespace webrtc {
+
+// Fixed-size lock-free FIFO queue with any number of producers and a single
+// consumer. Any thread may call TryPush() concurrently with other producers
+// and with the consumer; TryPop() and Empty() must only be called by one
+// thread at a time.
+//
+// Each slot carries a sequence number telling whether it is free for the
+// producer that claims that position, or holds a published element for the
+// consumer. Producers claim positions with a compare-and-swap on the write
+// index and publish the element by advancing the slot sequence number, so
+// neither side ever blocks on the other. Elements pushed by one thread are
+// popped in the order they were pushed.
+//
+// The queue never allocates after construction; T must be default
+// constructible and move assignable.
+template <typename T>
+class BoundedMpscQueue {
+ public:
+  // |capacity| must be a power of two.
+  explicit BoundedMpscQueue(size_t capacity)
+      : mask_(capacity - 1), slots_(new Slot[capacity]) {
+    RTC_CHECK_GT(capacity, 1);
+    RTC_CHECK_EQ(capacity & mask_, 0) << "Capacity must be a power of two.";
+    for (size_t i = 0; i < capacity; ++i)
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    enqueue_pos_.store(0, std::memory_order_relaxed);
+    dequeue_pos_ = 0;
+  }
+
+  // Moves *input into the queue and returns true. If the queue is full,
+  // returns false and leaves *input untouched.
+  bool TryPush(T* input) {
+    RTC_DCHECK(input);
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots_[pos & mask_];
+      size_t sequence = slot->sequence.load(std::memory_order_acquire);
+      intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          break;
+        }
+        // |pos| was reloaded by the failed compare-and-swap.
+      } else if (diff < 0) {
+        // The consumer has not yet released this slot: the queue is full.
+        return false;
+      } else {
+        // Another producer claimed this position first.
+        pos = enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+    slot->value = std::move(*input);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Moves the oldest element into *output and returns true. Returns false if
+  // the queue is empty, or if the oldest position has been claimed by a
+  // producer that has not finished publishing it yet.
+  bool TryPop(T* output) {
+    RTC_DCHECK(output);
+    Slot* slot = &slots_[dequeue_pos_ & mask_];
+    size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence != dequeue_pos_ + 1)
+      return false;
+    *output = std::move(slot->value);
+    slot->value = T();
+    slot->sequence.store(dequeue_pos_ + mask_ + 1, std::memory_order_release);
+    ++dequeue_pos_;
+    return true;
+  }
+
+  // Returns true if no positions have been claimed by producers beyond what
+  // the consumer has popped. Unlike TryPop(), a push that is still in
+  // progress counts as non-empty.
+  bool Empty() const {
+    return enqueue_pos_.load(std::memory_order_acquire) == dequeue_pos_;
+  }
+
+  size_t capacity() const { return mask_ + 1; }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  const size_t mask_;
+  const std::unique_ptr<Slot[]> slots_;
+  std::atomic<size_t> enqueue_pos_;
+  size_t dequeue_pos_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BoundedMpscQueue);
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_BOUNDED_MPSC_QUEUE_H_
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/bounded_mpsc_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/platform_thread.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kNumProducers = 4;
+constexpr int kItemsPerProducer = 1000;
+
+struct ProducerParams {
+  BoundedMpscQueue<int>* queue;
+  int id;
+};
+
+// Pushes kItemsPerProducer items encoding the producer id and a sequence
+// number.
+void RunProducer(void* obj) {
+  ProducerParams* params = static_cast<ProducerParams*>(obj);
+  for (int i = 0; i < kItemsPerProducer; ++i) {
+    int item = params->id * kItemsPerProducer + i;
+    EXPECT_TRUE(params->queue->TryPush(&item));
+  }
+}
+
+}  // namespace
+
+TEST(BoundedMpscQueueTest, PopsInPushOrder) {
+  BoundedMpscQueue<int> queue(4);
+  EXPECT_TRUE(queue.Empty());
+  for (int i = 0; i < 3; ++i) {
+    int item = i;
+    EXPECT_TRUE(queue.TryPush(&item));
+  }
+  EXPECT_FALSE(queue.Empty());
+  for (int i = 0; i < 3; ++i) {
+    int item = -1;
+    EXPECT_TRUE(queue.TryPop(&item));
+    EXPECT_EQ(i, item);
+  }
+  int item = -1;
+  EXPECT_FALSE(queue.TryPop(&item));
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(BoundedMpscQueueTest, FullQueueRejectsPushAndKeepsInput) {
+  BoundedMpscQueue<std::unique_ptr<int>> queue(2);
+  std::unique_ptr<int> item = std::make_unique<int>(1);
+  EXPECT_TRUE(queue.TryPush(&item));
+  item = std::make_unique<int>(2);
+  EXPECT_TRUE(queue.TryPush(&item));
+  item = std::make_unique<int>(3);
+  EXPECT_FALSE(queue.TryPush(&item));
+  ASSERT_TRUE(item);
+  EXPECT_EQ(3, *item);
+
+  std::unique_ptr<int> output;
+  EXPECT_TRUE(queue.TryPop(&output));
+  EXPECT_EQ(1, *output);
+  EXPECT_TRUE(queue.TryPush(&item));
+  EXPECT_TRUE(queue.TryPop(&output));
+  EXPECT_EQ(2, *output);
+  EXPECT_TRUE(queue.TryPop(&output));
+  EXPECT_EQ(3, *output);
+}
+
+TEST(BoundedMpscQueueTest, WrapsAround) {
+  BoundedMpscQueue<int> queue(8);
+  for (int i = 0; i < 100; ++i) {
+    int item = i;
+    ASSERT_TRUE(queue.TryPush(&item));
+    int output = -1;
+    ASSERT_TRUE(queue.TryPop(&output));
+    EXPECT_EQ(i, output);
+  }
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(BoundedMpscQueueTest, ConcurrentProducersKeepPerProducerOrder) {
+  // Large enough for all items, so that producers never have to wait for the
+  // consumer, which would just burn CPU on machines with few cores.
+  BoundedMpscQueue<int> queue(4096);
+  static_assert(kNumProducers * kItemsPerProducer <= 4096, "");
+  std::vector<ProducerParams> params;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < kNumProducers; ++i)
+    params.push_back({&queue, i});
+  for (int i = 0; i < kNumProducers; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &RunProducer, &params[i], "MpscProducer"));
+    threads.back()->Start();
+  }
+
+  for (auto& thread : threads)
+    thread->Stop();
+
+  std::vector<int> next_expected(kNumProducers, 0);
+  for (int i = 0; i < kNumProducers * kItemsPerProducer; ++i) {
+    int item;
+    ASSERT_TRUE(queue.TryPop(&item));
+    int producer = item / kItemsPerProducer;
+    ASSERT_GE(producer, 0);
+    ASSERT_LT(producer, kNumProducers);
+    EXPECT_EQ(next_expected[producer], item % kItemsPerProducer);
+    next_expected[producer] = item % kItemsPerProducer + 1;
+  }
+  EXPECT_TRUE(queue.Empty());
+}
+
+}  // namespace webrtc
@@ -12,8 +12,40 @@
 
 #include <stddef.h>
 
+#include <new>
+
+#include "rtc_base/memory/buffer_pool.h"
+
 namespace rtc {
 
+namespace internal {
+
+CopyOnWriteBufferStorage* CopyOnWriteBufferStorage::Create(const uint8_t* data,
+                                                           size_t size,
+                                                           size_t capacity) {
+  capacity = std::max(size, capacity);
+  void* memory =
+      BufferPool::Allocate(sizeof(CopyOnWriteBufferStorage) + capacity);
+  CopyOnWriteBufferStorage* storage =
+      new (memory) CopyOnWriteBufferStorage(size, capacity);
+  if (data && size > 0)
+    std::memcpy(storage->data(), data, size);
+  return storage;
+}
+
+RefCountReleaseStatus CopyOnWriteBufferStorage::Release() const {
+  const RefCountReleaseStatus status = ref_count_.DecRef();
+  if (status == RefCountReleaseStatus::kDroppedLastRef) {
+    const size_t allocated_size = sizeof(CopyOnWriteBufferStorage) + capacity_;
+    this->~CopyOnWriteBufferStorage();
+    BufferPool::Free(const_cast<CopyOnWriteBufferStorage*>(this),
+                     allocated_size);
+  }
+  return status;
+}
+
+}  // namespace internal
+
 CopyOnWriteBuffer::CopyOnWriteBuffer() : offset_(0), size_(0) {
   RTC_DCHECK(IsConsistent());
 }
@@ -32,7 +64,7 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(const std::string& s)
     : CopyOnWriteBuffer(s.data(), s.length()) {}
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
-    : buffer_(size > 0 ? new RefCountedObject<Buffer>(size) : nullptr),
+    : buffer_(size > 0 ? Storage::Create(nullptr, size, size) : nullptr),
       offset_(0),
       size_(size) {
   RTC_DCHECK(IsConsistent());
@@ -40,7 +72,7 @@ CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size, size_t capacity)
     : buffer_(size > 0 || capacity > 0
-                  ? new RefCountedObject<Buffer>(size, capacity)
+                  ? Storage::Create(nullptr, size, capacity)
                   : nullptr),
       offset_(0),
       size_(size) {
@@ -61,7 +93,7 @@ void CopyOnWriteBuffer::SetSize(size_t size) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (size > 0) {
-      buffer_ = new RefCountedObject<Buffer>(size);
+      buffer_ = Storage::Create(nullptr, size, size);
       offset_ = 0;
       size_ = size;
     }
@@ -84,7 +116,7 @@ void CopyOnWriteBuffer::EnsureCapacity(size_t new_capacity) {
   RTC_DCHECK(IsConsistent());
   if (!buffer_) {
     if (new_capacity > 0) {
-      buffer_ = new RefCountedObject<Buffer>(0, new_capacity);
+      buffer_ = Storage::Create(nullptr, 0, new_capacity);
       offset_ = 0;
       size_ = 0;
     }
@@ -103,9 +135,9 @@ void CopyOnWriteBuffer::Clear() {
     return;
 
   if (buffer_->HasOneRef()) {
-    buffer_->Clear();
+    buffer_->SetSize(0);
   } else {
-    buffer_ = new RefCountedObject<Buffer>(0, capacity());
+    buffer_ = Storage::Create(nullptr, 0, capacity());
   }
   offset_ = 0;
   size_ = 0;
@@ -117,9 +149,48 @@ void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
     return;
   }
 
-  buffer_ = new RefCountedObject<Buffer>(buffer_->data() + offset_, size_,
-                                         new_capacity);
+  buffer_ = Storage::Create(buffer_->data() + offset_, size_, new_capacity);
+  offset_ = 0;
+  RTC_DCHECK(IsConsistent());
+}
+
+void CopyOnWriteBuffer::SetBytes(const uint8_t* data, size_t size) {
+  RTC_DCHECK(IsConsistent());
+  if (!buffer_) {
+    buffer_ = size > 0 ? Storage::Create(data, size, size) : nullptr;
+  } else if (!buffer_->HasOneRef()) {
+    buffer_ = Storage::Create(data, size, capacity());
+  } else if (size > buffer_->capacity()) {
+    // Grows like rtc::Buffer does.
+    const size_t old_capacity = buffer_->capacity();
+    buffer_ = Storage::Create(data, size, old_capacity + old_capacity / 2);
+  } else {
+    std::memcpy(buffer_->data(), data, size);
+    buffer_->SetSize(size);
+  }
   offset_ = 0;
+  size_ = size;
+
+  RTC_DCHECK(IsConsistent());
+}
+
+void CopyOnWriteBuffer::AppendBytes(const uint8_t* data, size_t size) {
+  RTC_DCHECK(IsConsistent());
+  if (!buffer_) {
+    buffer_ = Storage::Create(data, size, size);
+    offset_ = 0;
+    size_ = size;
+    RTC_DCHECK(IsConsistent());
+    return;
+  }
+
+  UnshareAndEnsureCapacity(std::max(capacity(), size_ + size));
+
+  // Data to the right of the slice is overwritten.
+  std::memcpy(buffer_->data() + offset_ + size_, data, size);
+  size_ += size;
+  buffer_->SetSize(offset_ + size_);
+
   RTC_DCHECK(IsConsistent());
 }
 
@@ -22,10 +22,50 @@
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
-#include "rtc_base/ref_counted_object.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counter.h"
 
 namespace rtc {
 
+namespace internal {
+
+// The shared storage of CopyOnWriteBuffers: the reference count, size and
+// capacity followed by the data, in a single allocation from BufferPool.
+class CopyOnWriteBufferStorage {
+ public:
+  // Returns storage with room for max(|size|, |capacity|) bytes, of which
+  // the first |size| are copied from |data| if it isn't null.
+  static CopyOnWriteBufferStorage* Create(const uint8_t* data,
+                                          size_t size,
+                                          size_t capacity);
+
+  void AddRef() const { ref_count_.IncRef(); }
+  RefCountReleaseStatus Release() const;
+  bool HasOneRef() const { return ref_count_.HasOneRef(); }
+
+  template <typename T = uint8_t>
+  T* data() {
+    return reinterpret_cast<T*>(this + 1);
+  }
+  size_t size() const { return size_; }
+  size_t capacity() const { return capacity_; }
+  // |size| must not exceed the capacity.
+  void SetSize(size_t size) {
+    RTC_DCHECK_LE(size, capacity_);
+    size_ = size;
+  }
+
+ private:
+  CopyOnWriteBufferStorage(size_t size, size_t capacity)
+      : ref_count_(0), size_(size), capacity_(capacity) {}
+
+  mutable webrtc::webrtc_impl::RefCounter ref_count_;
+  size_t size_;
+  const size_t capacity_;
+};
+
+}  // namespace internal
+
 class CopyOnWriteBuffer {
  public:
   // An empty buffer.
@@ -161,18 +201,7 @@ class CopyOnWriteBuffer {
             typename std::enable_if<
                 internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
   void SetData(const T* data, size_t size) {
-    RTC_DCHECK(IsConsistent());
-    if (!buffer_) {
-      buffer_ = size > 0 ? new RefCountedObject<Buffer>(data, size) : nullptr;
-    } else if (!buffer_->HasOneRef()) {
-      buffer_ = new RefCountedObject<Buffer>(data, size, capacity());
-    } else {
-      buffer_->SetData(data, size);
-    }
-    offset_ = 0;
-    size_ = size;
-
-    RTC_DCHECK(IsConsistent());
+    SetBytes(reinterpret_cast<const uint8_t*>(data), size);
   }
 
   template <typename T,
@@ -198,23 +227,7 @@ class CopyOnWriteBuffer {
             typename std::enable_if<
                 internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
   void AppendData(const T* data, size_t size) {
-    RTC_DCHECK(IsConsistent());
-    if (!buffer_) {
-      buffer_ = new RefCountedObject<Buffer>(data, size);
-      offset_ = 0;
-      size_ = size;
-      RTC_DCHECK(IsConsistent());
-      return;
-    }
-
-    UnshareAndEnsureCapacity(std::max(capacity(), size_ + size));
-
-    buffer_->SetSize(offset_ +
-                     size_);  // Remove data to the right of the slice.
-    buffer_->AppendData(data, size);
-    size_ += size;
-
-    RTC_DCHECK(IsConsistent());
+    AppendBytes(reinterpret_cast<const uint8_t*>(data), size);
   }
 
   template <typename T,
@@ -261,6 +274,11 @@ class CopyOnWriteBuffer {
   }
 
  private:
+  using Storage = internal::CopyOnWriteBufferStorage;
+
+  void SetBytes(const uint8_t* data, size_t size);
+  void AppendBytes(const uint8_t* data, size_t size);
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects or there is not enough capacity.
   void UnshareAndEnsureCapacity(size_t new_capacity);
@@ -275,8 +293,8 @@ class CopyOnWriteBuffer {
     }
   }
 
-  // buffer_ is either null, or points to an rtc::Buffer with capacity > 0.
-  scoped_refptr<RefCountedObject<Buffer>> buffer_;
+  // buffer_ is either null, or points to storage with capacity > 0.
+  scoped_refptr<Storage> buffer_;
   // This buffer may represent a slice of a original data.
   size_t offset_;  // Offset of a current slice in the original data in buffer_.
                    // Should be 0 if the buffer_ is empty.
@@ -11,18 +11,25 @@
 #include "rtc_base/crc32.h"
 
 #include "rtc_base/arraysize.h"
+#include "rtc_base/byte_order.h"
 
 namespace rtc {
 
-// This implementation is based on the sample implementation in RFC 1952.
+// This implementation is based on the sample implementation in RFC 1952,
+// extended to process eight bytes at a time ("slicing-by-8").
 
 // CRC32 polynomial, in reversed form.
 // See RFC 1952, or http://en.wikipedia.org/wiki/Cyclic_redundancy_check
 static const uint32_t kCrc32Polynomial = 0xEDB88320;
 
-static uint32_t* LoadCrc32Table() {
-  static uint32_t kCrc32Table[256];
-  for (uint32_t i = 0; i < arraysize(kCrc32Table); ++i) {
+// kCrc32Tables[0] is the table of RFC 1952. kCrc32Tables[k][i] is the CRC of
+// byte i followed by k zero bytes, so eight table lookups update the CRC with
+// eight bytes.
+static const size_t kCrc32NumTables = 8;
+
+static uint32_t (*LoadCrc32Tables())[256] {
+  static uint32_t kCrc32Tables[kCrc32NumTables][256];
+  for (uint32_t i = 0; i < arraysize(kCrc32Tables[0]); ++i) {
     uint32_t c = i;
     for (size_t j = 0; j < 8; ++j) {
       if (c & 1) {
@@ -31,18 +38,33 @@ static uint32_t* LoadCrc32Table() {
         c >>= 1;
       }
     }
-    kCrc32Table[i] = c;
+    kCrc32Tables[0][i] = c;
+  }
+  for (size_t k = 1; k < kCrc32NumTables; ++k) {
+    for (uint32_t i = 0; i < arraysize(kCrc32Tables[k]); ++i) {
+      uint32_t c = kCrc32Tables[k - 1][i];
+      kCrc32Tables[k][i] = kCrc32Tables[0][c & 0xFF] ^ (c >> 8);
+    }
   }
-  return kCrc32Table;
+  return kCrc32Tables;
 }
 
 uint32_t UpdateCrc32(uint32_t start, const void* buf, size_t len) {
-  static uint32_t* kCrc32Table = LoadCrc32Table();
+  static const uint32_t(*kCrc32Tables)[256] = LoadCrc32Tables();
 
   uint32_t c = start ^ 0xFFFFFFFF;
   const uint8_t* u = static_cast<const uint8_t*>(buf);
+  for (; len >= kCrc32NumTables; len -= kCrc32NumTables) {
+    uint32_t low = c ^ GetLE32(u);
+    uint32_t high = GetLE32(u + 4);
+    c = kCrc32Tables[7][low & 0xFF] ^ kCrc32Tables[6][(low >> 8) & 0xFF] ^
+        kCrc32Tables[5][(low >> 16) & 0xFF] ^ kCrc32Tables[4][low >> 24] ^
+        kCrc32Tables[3][high & 0xFF] ^ kCrc32Tables[2][(high >> 8) & 0xFF] ^
+        kCrc32Tables[1][(high >> 16) & 0xFF] ^ kCrc32Tables[0][high >> 24];
+    u += kCrc32NumTables;
+  }
   for (size_t i = 0; i < len; ++i) {
-    c = kCrc32Table[(c ^ u[i]) & 0xFF] ^ (c >> 8);
+    c = kCrc32Tables[0][(c ^ u[i]) & 0xFF] ^ (c >> 8);
   }
   return c ^ 0xFFFFFFFF;
 }
@@ -34,4 +34,20 @@ TEST(Crc32Test, TestMultipleUpdates) {
   EXPECT_EQ(0x171A3F5FU, c);
 }
 
+TEST(Crc32Test, TestUnalignedLongInput) {
+  std::string input;
+  for (int i = 0; i < 1000; ++i)
+    input += "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"[i % 56];
+  EXPECT_EQ(0xD60A96D6U, ComputeCrc32(input));
+  // Updating a byte at a time doesn't use the eight byte path, so it serves as
+  // the reference.
+  for (size_t offset = 0; offset < 8; ++offset) {
+    uint32_t expected = 0;
+    for (size_t i = offset; i < input.size(); ++i)
+      expected = UpdateCrc32(expected, &input[i], 1);
+    EXPECT_EQ(expected,
+              ComputeCrc32(input.data() + offset, input.size() - offset));
+  }
+}
+
 }  // namespace rtc
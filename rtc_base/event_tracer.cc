@@ -14,10 +14,19 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "absl/base/config.h"
 #include "rtc_base/atomic_ops.h"
+#include "rtc_base/byte_buffer.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/event.h"
@@ -84,6 +93,133 @@ static void EventTracingThreadFunc(void* params);
 // Atomic-int fast path for avoiding logging when disabled.
 static volatile int g_event_logging_active = 0;
 
+struct TraceArg {
+  const char* name;
+  unsigned char type;
+  // Copied from webrtc/rtc_base/trace_event.h TraceValueUnion.
+  union TraceArgValue {
+    bool as_bool;
+    unsigned long long as_uint;
+    long long as_int;
+    double as_double;
+    const void* as_pointer;
+    const char* as_string;
+  } value;
+
+  // Assert that the size of the union is equal to the size of the as_uint
+  // field since we are assigning to arbitrary types using it.
+  static_assert(sizeof(TraceArgValue) == sizeof(unsigned long long),
+                "Size of TraceArg value union is not equal to the size of "
+                "the uint field of that union.");
+};
+
+std::string TraceArgValueAsString(TraceArg arg) {
+  std::string output;
+
+  if (arg.type == TRACE_VALUE_TYPE_STRING ||
+      arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
+    // Space for every character to be an espaced character + two for
+    // quatation marks.
+    output.reserve(strlen(arg.value.as_string) * 2 + 2);
+    output += '\"';
+    for (const char* c = arg.value.as_string; *c; ++c) {
+      if (*c == '"' || *c == '\\') {
+        output += '\\';
+        output += *c;
+      } else {
+        output += *c;
+      }
+    }
+    output += '\"';
+  } else {
+    output.resize(kTraceArgBufferLength);
+    size_t print_length = 0;
+    switch (arg.type) {
+      case TRACE_VALUE_TYPE_BOOL:
+        if (arg.value.as_bool) {
+          strcpy(&output[0], "true");
+          print_length = 4;
+        } else {
+          strcpy(&output[0], "false");
+          print_length = 5;
+        }
+        break;
+      case TRACE_VALUE_TYPE_UINT:
+        print_length = snprintf(&output[0], kTraceArgBufferLength, "%llu",
+                                arg.value.as_uint);
+        break;
+      case TRACE_VALUE_TYPE_INT:
+        print_length = snprintf(&output[0], kTraceArgBufferLength, "%lld",
+                                arg.value.as_int);
+        break;
+      case TRACE_VALUE_TYPE_DOUBLE:
+        print_length = snprintf(&output[0], kTraceArgBufferLength, "%f",
+                                arg.value.as_double);
+        break;
+      case TRACE_VALUE_TYPE_POINTER:
+        print_length = snprintf(&output[0], kTraceArgBufferLength, "\"%p\"",
+                                arg.value.as_pointer);
+        break;
+    }
+    size_t output_length = print_length < kTraceArgBufferLength
+                               ? print_length
+                               : kTraceArgBufferLength - 1;
+    // This will hopefully be very close to nop. On most implementations, it
+    // just writes null byte and sets the length field of the string.
+    output.resize(output_length);
+  }
+
+  return output;
+}
+
+// Replaces |args_str| with the "args" member of a JSON trace event.
+void AppendTraceArgs(const std::vector<TraceArg>& args,
+                     std::string* args_str) {
+  args_str->clear();
+  if (args.empty())
+    return;
+  *args_str += ", \"args\": {";
+  bool is_first_argument = true;
+  for (const TraceArg& arg : args) {
+    if (!is_first_argument)
+      *args_str += ",";
+    is_first_argument = false;
+    *args_str += " \"";
+    *args_str += arg.name;
+    *args_str += "\": ";
+    *args_str += TraceArgValueAsString(arg);
+  }
+  *args_str += " }";
+}
+
+// Writes one element of the "traceEvents" array, with |args_str| as made by
+// AppendTraceArgs().
+void WriteTraceEvent(FILE* file,
+                     bool is_first_event,
+                     const char* name,
+                     const char* category,
+                     char phase,
+                     uint64_t timestamp,
+                     int pid,
+                     rtc::PlatformThreadId tid,
+                     const std::string* args_str) {
+  fprintf(file,
+          "%s{ \"name\": \"%s\""
+          ", \"cat\": \"%s\""
+          ", \"ph\": \"%c\""
+          ", \"ts\": %" PRIu64
+          ", \"pid\": %d"
+#if defined(WEBRTC_WIN)
+          ", \"tid\": %lu"
+#else
+          ", \"tid\": %d"
+#endif  // defined(WEBRTC_WIN)
+          "%s"
+          "}\n",
+          is_first_event ? " " : ",", name, category, phase, timestamp, pid,
+          tid, args_str->c_str());
+}
+
 // TODO(pbos): Log metadata for all threads, etc.
 class EventLogger final {
  public:
@@ -142,43 +278,18 @@ class EventLogger final {
       std::string args_str;
       args_str.reserve(kEventLoggerArgsStrBufferInitialSize);
       for (TraceEvent& e : events) {
-        args_str.clear();
-        if (!e.args.empty()) {
-          args_str += ", \"args\": {";
-          bool is_first_argument = true;
-          for (TraceArg& arg : e.args) {
-            if (!is_first_argument)
-              args_str += ",";
-            is_first_argument = false;
-            args_str += " \"";
-            args_str += arg.name;
-            args_str += "\": ";
-            args_str += TraceArgValueAsString(arg);
-
-            // Delete our copy of the string.
-            if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-              delete[] arg.value.as_string;
-              arg.value.as_string = nullptr;
-            }
+        AppendTraceArgs(e.args, &args_str);
+        WriteTraceEvent(output_file_, !has_logged_event, e.name,
+                        reinterpret_cast<const char*>(e.category_enabled),
+                        e.phase, e.timestamp, e.pid, e.tid, &args_str);
+        has_logged_event = true;
+        // Delete our copies of the strings.
+        for (TraceArg& arg : e.args) {
+          if (arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
+            delete[] arg.value.as_string;
+            arg.value.as_string = nullptr;
           }
-          args_str += " }";
         }
-        fprintf(output_file_,
-                "%s{ \"name\": \"%s\""
-                ", \"cat\": \"%s\""
-                ", \"ph\": \"%c\""
-                ", \"ts\": %" PRIu64
-                ", \"pid\": %d"
-#if defined(WEBRTC_WIN)
-                ", \"tid\": %lu"
-#else
-                ", \"tid\": %d"
-#endif  // defined(WEBRTC_WIN)
-                "%s"
-                "}\n",
-                has_logged_event ? "," : " ", e.name, e.category_enabled,
-                e.phase, e.timestamp, e.pid, e.tid, args_str.c_str());
-        has_logged_event = true;
       }
       if (shutting_down)
         break;
@@ -227,26 +338,6 @@ class EventLogger final {
   }
 
  private:
-  struct TraceArg {
-    const char* name;
-    unsigned char type;
-    // Copied from webrtc/rtc_base/trace_event.h TraceValueUnion.
-    union TraceArgValue {
-      bool as_bool;
-      unsigned long long as_uint;
-      long long as_int;
-      double as_double;
-      const void* as_pointer;
-      const char* as_string;
-    } value;
-
-    // Assert that the size of the union is equal to the size of the as_uint
-    // field since we are assigning to arbitrary types using it.
-    static_assert(sizeof(TraceArgValue) == sizeof(unsigned long long),
-                  "Size of TraceArg value union is not equal to the size of "
-                  "the uint field of that union.");
-  };
-
   struct TraceEvent {
     const char* name;
     const unsigned char* category_enabled;
@@ -257,66 +348,6 @@ class EventLogger final {
     rtc::PlatformThreadId tid;
   };
 
-  static std::string TraceArgValueAsString(TraceArg arg) {
-    std::string output;
-
-    if (arg.type == TRACE_VALUE_TYPE_STRING ||
-        arg.type == TRACE_VALUE_TYPE_COPY_STRING) {
-      // Space for every character to be an espaced character + two for
-      // quatation marks.
-      output.reserve(strlen(arg.value.as_string) * 2 + 2);
-      output += '\"';
-      const char* c = arg.value.as_string;
-      do {
-        if (*c == '"' || *c == '\\') {
-          output += '\\';
-          output += *c;
-        } else {
-          output += *c;
-        }
-      } while (*++c);
-      output += '\"';
-    } else {
-      output.resize(kTraceArgBufferLength);
-      size_t print_length = 0;
-      switch (arg.type) {
-        case TRACE_VALUE_TYPE_BOOL:
-          if (arg.value.as_bool) {
-            strcpy(&output[0], "true");
-            print_length = 4;
-          } else {
-            strcpy(&output[0], "false");
-            print_length = 5;
-          }
-          break;
-        case TRACE_VALUE_TYPE_UINT:
-          print_length = snprintf(&output[0], kTraceArgBufferLength, "%llu",
-                                  arg.value.as_uint);
-          break;
-        case TRACE_VALUE_TYPE_INT:
-          print_length = snprintf(&output[0], kTraceArgBufferLength, "%lld",
-                                  arg.value.as_int);
-          break;
-        case TRACE_VALUE_TYPE_DOUBLE:
-          print_length = snprintf(&output[0], kTraceArgBufferLength, "%f",
-                                  arg.value.as_double);
-          break;
-        case TRACE_VALUE_TYPE_POINTER:
-          print_length = snprintf(&output[0], kTraceArgBufferLength, "\"%p\"",
-                                  arg.value.as_pointer);
-          break;
-      }
-      size_t output_length = print_length < kTraceArgBufferLength
-                                 ? print_length
-                                 : kTraceArgBufferLength - 1;
-      // This will hopefully be very close to nop. On most implementations, it
-      // just writes null byte and sets the length field of the string.
-      output.resize(output_length);
-    }
-
-    return output;
-  }
-
   rtc::CriticalSection crit_;
   std::vector<TraceEvent> trace_events_ RTC_GUARDED_BY(crit_);
   rtc::PlatformThread logging_thread_;
@@ -330,6 +361,287 @@ static void EventTracingThreadFunc(void* params) {
   static_cast<EventLogger*>(params)->Log();
 }
 
+// Flight recorder.
+//
+// While active, every thread adding trace events keeps its most recent
+// |kFlightRecorderEventsPerThread| events in a ring buffer of its own. Only
+// the owning thread writes to a buffer, without locking. Dumps read the
+// buffers concurrently and drop the events that were overwritten while they
+// were being copied.
+//
+// Dump format, with integers in network byte order:
+//   magic: "WRTCFR01"
+//   string: 'S', id (u32, consecutive from 0), length (u16), bytes
+//   thread: 'T', thread id (u32), event count (u32), events:
+//     timestamp us (u64), name id (u32), category id (u32), phase (u8),
+//     arg count (u8), args: name id (u32), type (u8), value (u64)
+// Strings are written before the threads, and string arguments refer to them
+// by id.
+
+static volatile int g_flight_recorder_active = 0;
+
+constexpr size_t kFlightRecorderEventsPerThread = 4096;
+constexpr int kFlightRecorderMaxArgs = 2;
+constexpr size_t kWordsPerFlightRecord = 8;
+constexpr char kFlightRecordingMagic[] = "WRTCFR01";
+constexpr uint8_t kFlightRecordingStringTag = 'S';
+constexpr uint8_t kFlightRecordingThreadTag = 'T';
+
+using FlightRecord = std::array<uint64_t, kWordsPerFlightRecord>;
+
+// Words of a FlightRecord.
+enum FlightRecordWord {
+  kTimestampWord = 0,
+  kNameWord = 1,
+  kCategoryWord = 2,
+  // Phase, arg count and arg types, one byte each.
+  kHeaderWord = 3,
+  kFirstArgWord = 4,  // Name and value of each arg.
+};
+
+class FlightRecorderBuffer {
+ public:
+  FlightRecorderBuffer()
+      : words_(new std::atomic<uint64_t>[kFlightRecorderEventsPerThread *
+                                         kWordsPerFlightRecord]()) {}
+
+  // Called by the owning thread only.
+  void Add(const FlightRecord& record) {
+    uint64_t index = begun_.load(std::memory_order_relaxed);
+    begun_.store(index + 1, std::memory_order_relaxed);
+    // Orders the |begun_| update before the writes to the slot, so that a
+    // concurrent Snapshot() that sees any of them also sees the update.
+    std::atomic_thread_fence(std::memory_order_release);
+    std::atomic<uint64_t>* slot =
+        &words_[(index % kFlightRecorderEventsPerThread) *
+                kWordsPerFlightRecord];
+    for (size_t i = 0; i < kWordsPerFlightRecord; ++i)
+      slot[i].store(record[i], std::memory_order_relaxed);
+    written_.store(index + 1, std::memory_order_release);
+  }
+
+  // Returns the intact events written since |first_index|, oldest first.
+  std::vector<FlightRecord> Snapshot(uint64_t first_index) const {
+    uint64_t end = written_.load(std::memory_order_acquire);
+    uint64_t begin = std::max(first_index, OldestIndex(end));
+    std::vector<FlightRecord> records(end - begin);
+    for (uint64_t index = begin; index < end; ++index) {
+      const std::atomic<uint64_t>* slot =
+          &words_[(index % kFlightRecorderEventsPerThread) *
+                  kWordsPerFlightRecord];
+      for (size_t i = 0; i < kWordsPerFlightRecord; ++i)
+        records[index - begin][i] = slot[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // Events the owner started overwriting while they were copied are torn.
+    uint64_t intact_begin =
+        OldestIndex(begun_.load(std::memory_order_relaxed));
+    if (intact_begin > begin) {
+      uint64_t torn = std::min<uint64_t>(intact_begin - begin, records.size());
+      records.erase(records.begin(), records.begin() + torn);
+    }
+    return records;
+  }
+
+  // Index of the next event the owner will write.
+  uint64_t next_index() const {
+    return begun_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  static uint64_t OldestIndex(uint64_t end) {
+    return end > kFlightRecorderEventsPerThread
+               ? end - kFlightRecorderEventsPerThread
+               : 0;
+  }
+
+  const std::unique_ptr<std::atomic<uint64_t>[]> words_;
+  // Number of events the owner started writing and finished writing.
+  std::atomic<uint64_t> begun_{0};
+  std::atomic<uint64_t> written_{0};
+};
+
+// Owns the buffers of all threads. Buffers of exited threads are reused by
+// new threads.
+class FlightRecorder {
+ public:
+  FlightRecorderBuffer* AcquireBuffer(rtc::PlatformThreadId thread_id) {
+    rtc::CritScope lock(&crit_);
+    for (ThreadBuffer& thread_buffer : buffers_) {
+      if (!thread_buffer.in_use) {
+        thread_buffer.in_use = true;
+        thread_buffer.thread_id = thread_id;
+        // Events of the previous owner are not dumped.
+        thread_buffer.first_index = thread_buffer.buffer->next_index();
+        return thread_buffer.buffer.get();
+      }
+    }
+    buffers_.push_back(
+        {std::make_unique<FlightRecorderBuffer>(), thread_id, 0, true});
+    return buffers_.back().buffer.get();
+  }
+
+  void ReleaseBuffer(FlightRecorderBuffer* buffer) {
+    rtc::CritScope lock(&crit_);
+    for (ThreadBuffer& thread_buffer : buffers_) {
+      if (thread_buffer.buffer.get() == buffer)
+        thread_buffer.in_use = false;
+    }
+  }
+
+  bool Dump(FILE* file);
+
+ private:
+  struct ThreadBuffer {
+    std::unique_ptr<FlightRecorderBuffer> buffer;
+    rtc::PlatformThreadId thread_id;
+    uint64_t first_index;
+    bool in_use;
+  };
+
+  rtc::CriticalSection crit_;
+  std::vector<ThreadBuffer> buffers_ RTC_GUARDED_BY(crit_);
+};
+
+FlightRecorder* GetFlightRecorder() {
+  static FlightRecorder* const flight_recorder = new FlightRecorder();
+  return flight_recorder;
+}
+
+bool FlightRecorder::Dump(FILE* file) {
+  struct ThreadRecords {
+    rtc::PlatformThreadId thread_id;
+    std::vector<FlightRecord> records;
+  };
+  std::vector<ThreadRecords> threads;
+  {
+    rtc::CritScope lock(&crit_);
+    for (const ThreadBuffer& thread_buffer : buffers_) {
+      threads.push_back({thread_buffer.thread_id,
+                         thread_buffer.buffer->Snapshot(
+                             thread_buffer.first_index)});
+    }
+  }
+
+  rtc::ByteBufferWriter strings;
+  rtc::ByteBufferWriter events;
+  std::map<std::string, uint32_t> string_ids;
+  auto string_id = [&](std::string str) {
+    if (str.size() > std::numeric_limits<uint16_t>::max())
+      str.resize(std::numeric_limits<uint16_t>::max());
+    auto it = string_ids.find(str);
+    if (it != string_ids.end())
+      return it->second;
+    uint32_t id = static_cast<uint32_t>(string_ids.size());
+    strings.WriteUInt8(kFlightRecordingStringTag);
+    strings.WriteUInt32(id);
+    strings.WriteUInt16(static_cast<uint16_t>(str.size()));
+    strings.WriteString(str);
+    string_ids.emplace(std::move(str), id);
+    return id;
+  };
+  auto pointer_string_id = [&](uint64_t pointer) {
+    const char* str =
+        reinterpret_cast<const char*>(static_cast<uintptr_t>(pointer));
+    return string_id(str ? str : "");
+  };
+
+  for (const ThreadRecords& thread : threads) {
+    events.WriteUInt8(kFlightRecordingThreadTag);
+    events.WriteUInt32(static_cast<uint32_t>(thread.thread_id));
+    events.WriteUInt32(static_cast<uint32_t>(thread.records.size()));
+    for (const FlightRecord& record : thread.records) {
+      uint64_t header = record[kHeaderWord];
+      int num_args = static_cast<uint8_t>(header >> 8);
+      events.WriteUInt64(record[kTimestampWord]);
+      events.WriteUInt32(pointer_string_id(record[kNameWord]));
+      events.WriteUInt32(pointer_string_id(record[kCategoryWord]));
+      events.WriteUInt8(static_cast<uint8_t>(header));
+      events.WriteUInt8(static_cast<uint8_t>(num_args));
+      for (int i = 0; i < num_args; ++i) {
+        uint8_t type = static_cast<uint8_t>(header >> (16 + 8 * i));
+        uint64_t value = record[kFirstArgWord + 2 * i + 1];
+        events.WriteUInt32(pointer_string_id(record[kFirstArgWord + 2 * i]));
+        if (type == TRACE_VALUE_TYPE_STRING) {
+          value = pointer_string_id(value);
+        } else if (type == TRACE_VALUE_TYPE_COPY_STRING) {
+          // The first characters of the string were stored in the value.
+          char inline_string[sizeof(value) + 1] = {};
+          memcpy(inline_string, &value, sizeof(value));
+          value = string_id(inline_string);
+          type = TRACE_VALUE_TYPE_STRING;
+        }
+        events.WriteUInt8(type);
+        events.WriteUInt64(value);
+      }
+    }
+  }
+
+  return fwrite(kFlightRecordingMagic, 1, strlen(kFlightRecordingMagic),
+                file) == strlen(kFlightRecordingMagic) &&
+         fwrite(strings.Data(), 1, strings.Length(), file) ==
+             strings.Length() &&
+         fwrite(events.Data(), 1, events.Length(), file) == events.Length() &&
+         fflush(file) == 0;
+}
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+
+// Returns the buffer of the calling thread to the flight recorder when the
+// thread exits.
+class ThreadFlightRecorderBuffer {
+ public:
+  ~ThreadFlightRecorderBuffer() {
+    if (buffer_)
+      GetFlightRecorder()->ReleaseBuffer(buffer_);
+  }
+
+  FlightRecorderBuffer* Get() {
+    if (!buffer_)
+      buffer_ = GetFlightRecorder()->AcquireBuffer(rtc::CurrentThreadId());
+    return buffer_;
+  }
+
+ private:
+  FlightRecorderBuffer* buffer_ = nullptr;
+};
+
+thread_local ThreadFlightRecorderBuffer g_thread_flight_recorder_buffer;
+
+void RecordFlightEvent(char phase,
+                       const unsigned char* category_enabled,
+                       const char* name,
+                       int num_args,
+                       const char** arg_names,
+                       const unsigned char* arg_types,
+                       const unsigned long long* arg_values) {
+  FlightRecord record = {};
+  record[kTimestampWord] = rtc::TimeMicros();
+  record[kNameWord] = reinterpret_cast<uintptr_t>(name);
+  record[kCategoryWord] = reinterpret_cast<uintptr_t>(category_enabled);
+  num_args = std::min(num_args, kFlightRecorderMaxArgs);
+  uint64_t header = static_cast<uint8_t>(phase) | (num_args << 8);
+  for (int i = 0; i < num_args; ++i) {
+    header |= static_cast<uint64_t>(arg_types[i]) << (16 + 8 * i);
+    uint64_t value = arg_values[i];
+    if (arg_types[i] == TRACE_VALUE_TYPE_COPY_STRING) {
+      // The string doesn't outlive this call, so keep its first characters
+      // in the value instead.
+      TraceArg arg;
+      arg.value.as_uint = arg_values[i];
+      char inline_string[sizeof(value)] = {};
+      strncpy(inline_string, arg.value.as_string, sizeof(inline_string));
+      memcpy(&value, inline_string, sizeof(value));
+    }
+    record[kFirstArgWord + 2 * i] = reinterpret_cast<uintptr_t>(arg_names[i]);
+    record[kFirstArgWord + 2 * i + 1] = value;
+  }
+  record[kHeaderWord] = header;
+  g_thread_flight_recorder_buffer.Get()->Add(record);
+}
+
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
 static EventLogger* volatile g_event_logger = nullptr;
 static const char* const kDisabledTracePrefix = TRACE_DISABLED_BY_DEFAULT("");
 const unsigned char* InternalGetCategoryEnabled(const char* name) {
@@ -353,6 +665,13 @@ void InternalAddTraceEvent(char phase,
                            const unsigned char* arg_types,
                            const unsigned long long* arg_values,
                            unsigned char flags) {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  if (rtc::AtomicOps::AcquireLoad(&g_flight_recorder_active) != 0) {
+    RecordFlightEvent(phase, category_enabled, name, num_args, arg_names,
+                      arg_types, arg_values);
+  }
+#endif
+
   // Fast path for when event tracing is inactive.
   if (rtc::AtomicOps::AcquireLoad(&g_event_logging_active) == 0)
     return;
@@ -397,7 +716,114 @@ void StopInternalCapture() {
   }
 }
 
+void StartInternalFlightRecorder() {
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+  rtc::AtomicOps::ReleaseStore(&g_flight_recorder_active, 1);
+#else
+  RTC_LOG(LS_WARNING) << "The flight recorder needs thread_local support.";
+#endif
+}
+
+void StopInternalFlightRecorder() {
+  rtc::AtomicOps::ReleaseStore(&g_flight_recorder_active, 0);
+}
+
+bool DumpInternalFlightRecording(FILE* file) {
+  return GetFlightRecorder()->Dump(file);
+}
+
+bool ConvertFlightRecordingToJson(FILE* recording, FILE* json) {
+  std::vector<char> data;
+  char chunk[4096];
+  size_t read;
+  while ((read = fread(chunk, 1, sizeof(chunk), recording)) > 0)
+    data.insert(data.end(), chunk, chunk + read);
+  if (ferror(recording))
+    return false;
+
+  rtc::ByteBufferReader reader(data.data(), data.size());
+  std::string magic;
+  if (!reader.ReadString(&magic, strlen(kFlightRecordingMagic)) ||
+      magic != kFlightRecordingMagic) {
+    RTC_LOG(LS_ERROR) << "Not a flight recording.";
+    return false;
+  }
+
+  std::vector<std::string> strings;
+  auto get_string = [&strings](uint64_t id) -> const char* {
+    return id < strings.size() ? strings[id].c_str() : nullptr;
+  };
+  fprintf(json, "{ \"traceEvents\": [\n");
+  bool has_logged_event = false;
+  std::vector<TraceArg> args;
+  std::string args_str;
+  uint8_t tag;
+  while (reader.ReadUInt8(&tag)) {
+    if (tag == kFlightRecordingStringTag) {
+      uint32_t id;
+      uint16_t length;
+      std::string str;
+      if (!reader.ReadUInt32(&id) || id != strings.size() ||
+          !reader.ReadUInt16(&length) || !reader.ReadString(&str, length)) {
+        break;
+      }
+      strings.push_back(std::move(str));
+      continue;
+    }
+    uint32_t thread_id;
+    uint32_t num_events;
+    if (tag != kFlightRecordingThreadTag || !reader.ReadUInt32(&thread_id) ||
+        !reader.ReadUInt32(&num_events)) {
+      break;
+    }
+    for (uint32_t i = 0; i < num_events; ++i) {
+      uint64_t timestamp;
+      uint32_t name_id;
+      uint32_t category_id;
+      uint8_t phase;
+      uint8_t num_args;
+      if (!reader.ReadUInt64(&timestamp) || !reader.ReadUInt32(&name_id) ||
+          !reader.ReadUInt32(&category_id) || !reader.ReadUInt8(&phase) ||
+          !reader.ReadUInt8(&num_args) || !get_string(name_id) ||
+          !get_string(category_id)) {
+        RTC_LOG(LS_ERROR) << "Malformed flight recording.";
+        return false;
+      }
+      args.resize(num_args);
+      for (TraceArg& arg : args) {
+        uint32_t arg_name_id;
+        uint64_t value;
+        if (!reader.ReadUInt32(&arg_name_id) || !reader.ReadUInt8(&arg.type) ||
+            !reader.ReadUInt64(&value) || !get_string(arg_name_id) ||
+            (arg.type == TRACE_VALUE_TYPE_STRING && !get_string(value))) {
+          RTC_LOG(LS_ERROR) << "Malformed flight recording.";
+          return false;
+        }
+        arg.name = get_string(arg_name_id);
+        if (arg.type == TRACE_VALUE_TYPE_STRING)
+          arg.value.as_string = get_string(value);
+        else
+          arg.value.as_uint = value;
+      }
+      AppendTraceArgs(args, &args_str);
+      WriteTraceEvent(json, !has_logged_event, get_string(name_id),
+                      get_string(category_id), static_cast<char>(phase),
+                      timestamp, 1,
+                      static_cast<rtc::PlatformThreadId>(thread_id),
+                      &args_str);
+      has_logged_event = true;
+    }
+  }
+  fprintf(json, "]}\n");
+  if (reader.Length() != 0) {
+    RTC_LOG(LS_ERROR) << "Malformed flight recording.";
+    return false;
+  }
+  return fflush(json) == 0;
+}
+
 void ShutdownInternalTracer() {
+  StopInternalFlightRecorder();
   StopInternalCapture();
   EventLogger* old_logger = rtc::AtomicOps::AcquireLoadPtr(&g_event_logger);
   RTC_DCHECK(old_logger);
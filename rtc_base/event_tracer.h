@@ -74,6 +74,19 @@ void SetupInternalTracer();
 bool StartInternalCapture(const char* filename);
 void StartInternalCaptureToFile(FILE* file);
 void StopInternalCapture();
+// The flight recorder keeps the most recent trace events of each thread in
+// memory, so that they can be dumped on demand, e.g. when something goes
+// wrong. Recording is much cheaper than capturing to a file. The recorder
+// needs SetupInternalTracer() and runs independently of capturing.
+void StartInternalFlightRecorder();
+void StopInternalFlightRecorder();
+// Writes the recorded events in a compact binary format. May be called
+// while recording, from any thread.
+bool DumpInternalFlightRecording(FILE* file);
+// Converts a dump to the JSON trace event format that capturing writes,
+// which chrome://tracing and Perfetto load. Arguments of type
+// TRACE_VALUE_TYPE_COPY_STRING are truncated to their first 8 characters.
+bool ConvertFlightRecordingToJson(FILE* recording, FILE* json);
 // Make sure we run this, this will tear down the internal tracing.
 void ShutdownInternalTracer();
 }  // namespace tracing
@@ -10,8 +10,15 @@
 
 #include "rtc_base/event_tracer.h"
 
+#include <stdio.h>
+
+#include <string>
+
 #include "rtc_base/critical_section.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "test/gtest.h"
 
@@ -61,6 +68,20 @@ void TraceEventHandler(char /*phase*/,
   TestStatistics::Get()->Increment();
 }
 
+std::string ReadFile(FILE* file) {
+  std::string contents;
+  char chunk[4096];
+  size_t read;
+  rewind(file);
+  while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    contents.append(chunk, read);
+  return contents;
+}
+
+void TraceFromOtherThread(void* /*obj*/) {
+  TRACE_EVENT_INSTANT0("test", "OtherThreadEvent");
+}
+
 }  // namespace
 
 namespace webrtc {
@@ -78,4 +99,57 @@ TEST(EventTracerTest, ScopedTraceEvent) {
   TestStatistics::Get()->Reset();
 }
 
+TEST(EventTracerTest, FlightRecorderDumpConvertsToJson) {
+  rtc::tracing::SetupInternalTracer();
+  rtc::tracing::StartInternalFlightRecorder();
+  { TRACE_EVENT1("test", "ScopedEvent", "count", 42); }
+  TRACE_EVENT_INSTANT1("test", "StringArgEvent", "str", "a \"quoted\" value");
+  TRACE_EVENT_INSTANT1("test", "CopyStringArgEvent", "copy",
+                       TRACE_STR_COPY(std::string("copied string").c_str()));
+  rtc::PlatformThread thread(&TraceFromOtherThread, nullptr, "OtherThread");
+  thread.Start();
+  thread.Stop();
+  rtc::tracing::StopInternalFlightRecorder();
+  TRACE_EVENT_INSTANT0("test", "NotRecordedEvent");
+
+  FILE* recording = tmpfile();
+  FILE* json = tmpfile();
+  ASSERT_TRUE(recording);
+  ASSERT_TRUE(json);
+  ASSERT_TRUE(rtc::tracing::DumpInternalFlightRecording(recording));
+  rewind(recording);
+  ASSERT_TRUE(rtc::tracing::ConvertFlightRecordingToJson(recording, json));
+  std::string contents = ReadFile(json);
+  fclose(recording);
+  fclose(json);
+  rtc::tracing::ShutdownInternalTracer();
+
+  EXPECT_EQ(0u, contents.find("{ \"traceEvents\": ["));
+  EXPECT_NE(std::string::npos,
+            contents.find("\"name\": \"ScopedEvent\", \"cat\": \"test\", "
+                          "\"ph\": \"B\""));
+  EXPECT_NE(std::string::npos, contents.find("\"ph\": \"E\""));
+  EXPECT_NE(std::string::npos, contents.find("\"args\": { \"count\": 42 }"));
+  EXPECT_NE(std::string::npos,
+            contents.find("\"str\": \"a \\\"quoted\\\" value\""));
+  EXPECT_NE(std::string::npos, contents.find("\"copy\": \"copied s\""));
+  EXPECT_NE(std::string::npos, contents.find("OtherThreadEvent"));
+  EXPECT_EQ(std::string::npos, contents.find("NotRecordedEvent"));
+}
+
+TEST(EventTracerTest, DISABLED_FlightRecorderPerf) {
+  static constexpr int kIterations = 1000000;
+  rtc::tracing::SetupInternalTracer();
+  rtc::tracing::StartInternalFlightRecorder();
+  int64_t start_us = rtc::TimeMicros();
+  for (int i = 0; i < kIterations; ++i) {
+    TRACE_EVENT1("test", "FlightRecorderPerf", "i", i);
+  }
+  int64_t elapsed_us = rtc::TimeMicros() - start_us;
+  rtc::tracing::StopInternalFlightRecorder();
+  rtc::tracing::ShutdownInternalTracer();
+  RTC_LOG(LS_INFO) << kIterations << " recorded scoped events: " << elapsed_us
+                   << " us.";
+}
+
 }  // namespace webrtc
@@ -82,18 +82,20 @@ class FileRotatingStream : public StreamInterface {
 
   virtual void OnRotation() {}
 
- private:
-  bool OpenCurrentFile();
-  void CloseCurrentFile();
-
   // Rotates the files by creating a new current file, renaming the
   // existing files, and deleting the oldest one. e.g.
   // file_0 -> file_1
   // file_1 -> file_2
   // file_2 -> delete
   // create new file_0
+  // Done by Write() once the current file is full; subclasses may rotate
+  // sooner.
   void RotateFiles();
 
+ private:
+  bool OpenCurrentFile();
+  void CloseCurrentFile();
+
   // Private version of GetFilePath.
   std::string GetFilePath(size_t index, size_t num_files) const;
 
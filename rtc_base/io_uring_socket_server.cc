@@ -0,0 +1,638 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_socket_server.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <netinet/in.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+
+namespace {
+
+constexpr uint32_t kSubmissionQueueSize = 256;
+// Multishot receives post many completions per submission.
+constexpr uint32_t kCompletionQueueSize = 4096;
+// Buffers provided to the kernel for receives to pick from.
+constexpr uint32_t kNumReceiveBuffers = 1024;
+constexpr uint32_t kReceiveBufferSize = 2048;
+constexpr uint16_t kReceiveBufferGroup = 0;
+// Receive buffers start with an io_uring_recvmsg_out header and room for the
+// source address, followed by the payload.
+constexpr uint32_t kReceiveNameSize = sizeof(sockaddr_in6);
+constexpr uint32_t kReceiveHeaderSize =
+    sizeof(io_uring_recvmsg_out) + kReceiveNameSize;
+constexpr size_t kMaxSendsInFlight = 256;
+
+// The low bits of the user data of a submission tell what it was for; the
+// rest is a socket id or a send slot index.
+enum Operation : uint64_t {
+  kReceive = 1,
+  kSend = 2,
+  kCancel = 3,
+  kProvideBuffers = 4,
+};
+constexpr int kOperationBits = 8;
+
+uint64_t UserData(Operation operation, uint64_t id) {
+  return (id << kOperationBits) | operation;
+}
+
+int IoUringSetup(uint32_t entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd, uint32_t to_submit, uint32_t flags) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_enter, fd, to_submit, 0, flags, nullptr, 0));
+}
+
+int IoUringRegister(int fd, uint32_t opcode, void* arg, uint32_t nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+// The header of multishot receives; the kernel reads it when the receive is
+// submitted.
+const msghdr* ReceiveMessageHeader() {
+  static const msghdr header = [] {
+    msghdr header;
+    memset(&header, 0, sizeof(header));
+    header.msg_namelen = kReceiveNameSize;
+    return header;
+  }();
+  return &header;
+}
+
+}  // namespace
+
+struct IoUringSocketServer::SendSlot {
+  std::vector<uint8_t> data;
+  sockaddr_storage address;
+  iovec iov;
+  msghdr message;
+};
+
+// Reaps completions when the io_uring has some, as part of the epoll wait of
+// PhysicalSocketServer.
+class IoUringSocketServer::RingDispatcher : public Dispatcher {
+ public:
+  explicit RingDispatcher(IoUringSocketServer* ss) : ss_(ss) { ss_->Add(this); }
+  ~RingDispatcher() override { ss_->Remove(this); }
+
+  uint32_t GetRequestedEvents() override { return DE_READ; }
+  void OnPreEvent(uint32_t ff) override {}
+  void OnEvent(uint32_t ff, int err) override {
+    ss_->ProcessCompletions();
+    ss_->SubmitPending();
+  }
+  int GetDescriptor() override { return ss_->ring_fd_; }
+  bool IsDescriptorClosed() override { return false; }
+
+ private:
+  IoUringSocketServer* const ss_;
+};
+
+IoUringSocketServer::IoUringSocketServer() {
+  if (!SetUpRing()) {
+    TearDownRing();
+    return;
+  }
+  for (size_t i = 0; i < kMaxSendsInFlight; ++i) {
+    send_slots_.push_back(std::make_unique<SendSlot>());
+    free_send_slots_.push_back(i);
+  }
+  ring_dispatcher_ = std::make_unique<RingDispatcher>(this);
+}
+
+IoUringSocketServer::~IoUringSocketServer() {
+  RTC_DCHECK(sockets_.empty());
+  ring_dispatcher_.reset();
+  TearDownRing();
+}
+
+bool IoUringSocketServer::SetUpRing() {
+  // Multishot receives need Linux 6.0, the first release that also accepts
+  // IORING_SETUP_SINGLE_ISSUER, which makes for a cheap version check.
+  io_uring_params probe_params;
+  memset(&probe_params, 0, sizeof(probe_params));
+  probe_params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_R_DISABLED;
+  int probe_fd = IoUringSetup(1, &probe_params);
+  if (probe_fd < 0) {
+    RTC_LOG_E(LS_WARNING, EN, errno)
+        << "io_uring with multishot receives is not available";
+    return false;
+  }
+  close(probe_fd);
+
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = kCompletionQueueSize;
+  ring_fd_ = IoUringSetup(kSubmissionQueueSize, &params);
+  if (ring_fd_ < 0) {
+    RTC_LOG_E(LS_WARNING, EN, errno) << "io_uring_setup";
+    return false;
+  }
+  RTC_DCHECK(params.features & IORING_FEAT_SINGLE_MMAP);
+
+  rings_size_ =
+      std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  rings_ = mmap(nullptr, rings_size_, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (rings_ == MAP_FAILED) {
+    rings_ = nullptr;
+    RTC_LOG_E(LS_WARNING, EN, errno) << "mmap of io_uring rings";
+    return false;
+  }
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    RTC_LOG_E(LS_WARNING, EN, errno) << "mmap of io_uring submissions";
+    return false;
+  }
+  sqes_ = static_cast<io_uring_sqe*>(sqes);
+
+  uint8_t* rings = static_cast<uint8_t*>(rings_);
+  sq_head_ = reinterpret_cast<uint32_t*>(rings + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(rings + params.sq_off.tail);
+  sq_flags_ = reinterpret_cast<uint32_t*>(rings + params.sq_off.flags);
+  sq_mask_ = *reinterpret_cast<uint32_t*>(rings + params.sq_off.ring_mask);
+  sq_entries_ = params.sq_entries;
+  cq_head_ = reinterpret_cast<uint32_t*>(rings + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(rings + params.cq_off.tail);
+  cq_mask_ = *reinterpret_cast<uint32_t*>(rings + params.cq_off.ring_mask);
+  cqes_ = reinterpret_cast<io_uring_cqe*>(rings + params.cq_off.cqes);
+  // Submission queue entry i always uses sqes_[i].
+  uint32_t* sq_array = reinterpret_cast<uint32_t*>(rings + params.sq_off.array);
+  for (uint32_t i = 0; i < sq_entries_; ++i)
+    sq_array[i] = i;
+
+  void* buffers =
+      mmap(nullptr, kNumReceiveBuffers * kReceiveBufferSize,
+           PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buffers == MAP_FAILED) {
+    RTC_LOG_E(LS_WARNING, EN, errno) << "mmap of receive buffers";
+    return false;
+  }
+  buffers_ = static_cast<uint8_t*>(buffers);
+  for (uint32_t i = 0; i < kNumReceiveBuffers; ++i)
+    RecycleBuffer(static_cast<uint16_t>(i));
+  ProvideBuffers();
+  return true;
+}
+
+void IoUringSocketServer::TearDownRing() {
+  if (ring_fd_ >= 0) {
+    // Closing the ring cancels the requests in flight.
+    close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  if (rings_) {
+    munmap(rings_, rings_size_);
+    rings_ = nullptr;
+  }
+  if (sqes_) {
+    munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (buffers_) {
+    munmap(buffers_, kNumReceiveBuffers * kReceiveBufferSize);
+    buffers_ = nullptr;
+  }
+}
+
+AsyncSocket* IoUringSocketServer::CreateAsyncSocket(int family, int type) {
+  if (!io_uring_enabled() || type != SOCK_DGRAM)
+    return PhysicalSocketServer::CreateAsyncSocket(family, type);
+  IoUringUdpSocket* socket = new IoUringUdpSocket(this);
+  if (!socket->Create(family, type)) {
+    delete socket;
+    return nullptr;
+  }
+  return socket;
+}
+
+bool IoUringSocketServer::Wait(int cms, bool process_io) {
+  if (!io_uring_enabled() || !process_io)
+    return PhysicalSocketServer::Wait(cms, process_io);
+
+  // Sockets that didn't read all of their packets when signaled are signaled
+  // again, without sleeping.
+  if (ProcessCompletions())
+    cms = 0;
+  SubmitPending();
+  in_wait_ = true;
+  bool result = PhysicalSocketServer::Wait(cms, process_io);
+  in_wait_ = false;
+  return result;
+}
+
+void IoUringSocketServer::AddSocket(IoUringUdpSocket* socket) {
+  RTC_DCHECK_EQ(0, socket->id_);
+  socket->id_ = next_socket_id_++;
+  sockets_[socket->id_] = socket;
+  ArmReceive(socket);
+}
+
+void IoUringSocketServer::RemoveSocket(IoUringUdpSocket* socket) {
+  RTC_DCHECK_NE(0, socket->id_);
+  // Cancel the multishot receive right away, since it holds on to the
+  // socket, which would keep its port bound.
+  io_uring_sqe* sqe = GetSqe();
+  if (sqe) {
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = UserData(kReceive, socket->id_);
+    sqe->user_data = UserData(kCancel, 0);
+    SubmitPending();
+  }
+  for (const ReceivedPacket& packet : socket->received_)
+    RecycleBuffer(packet.buffer_id);
+  socket->received_.clear();
+  sockets_.erase(socket->id_);
+  readable_sockets_.erase(socket);
+  write_blocked_sockets_.erase(socket);
+  receive_stopped_sockets_.erase(socket);
+  socket->id_ = 0;
+}
+
+int IoUringSocketServer::QueueSend(IoUringUdpSocket* socket,
+                                   const void* data,
+                                   size_t length,
+                                   const SocketAddress* address,
+                                   int* error) {
+  if (free_send_slots_.empty()) {
+    *error = EWOULDBLOCK;
+    write_blocked_sockets_.insert(socket);
+    return -1;
+  }
+  io_uring_sqe* sqe = GetSqe();
+  if (!sqe) {
+    *error = EWOULDBLOCK;
+    write_blocked_sockets_.insert(socket);
+    return -1;
+  }
+  size_t slot_index = free_send_slots_.back();
+  free_send_slots_.pop_back();
+  SendSlot& slot = *send_slots_[slot_index];
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  slot.data.assign(bytes, bytes + length);
+  slot.iov.iov_base = slot.data.data();
+  slot.iov.iov_len = length;
+  memset(&slot.message, 0, sizeof(slot.message));
+  slot.message.msg_iov = &slot.iov;
+  slot.message.msg_iovlen = 1;
+  if (address) {
+    slot.message.msg_name = &slot.address;
+    slot.message.msg_namelen =
+        static_cast<socklen_t>(address->ToSockAddrStorage(&slot.address));
+  }
+
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = socket->s_;
+  sqe->addr = reinterpret_cast<uintptr_t>(&slot.message);
+  sqe->len = 1;
+  sqe->msg_flags = MSG_NOSIGNAL;
+  sqe->user_data = UserData(kSend, slot_index);
+  // Sends queued while reacting to received packets go out together once
+  // they've all been handled. Others, e.g. from the handlers of TCP sockets,
+  // can't wait since the epoll wait may go back to sleep.
+  if (in_wait_ && !processing_completions_)
+    SubmitPending();
+  return static_cast<int>(length);
+}
+
+int IoUringSocketServer::ReadPacket(IoUringUdpSocket* socket,
+                                    ReceivedDatagram* datagram,
+                                    int* error) {
+  if (socket->received_.empty()) {
+    *error = EWOULDBLOCK;
+    return -1;
+  }
+  ReceivedPacket packet = socket->received_.front();
+  socket->received_.pop_front();
+  if (socket->received_.empty())
+    readable_sockets_.erase(socket);
+
+  const uint8_t* buffer = BufferData(packet.buffer_id);
+  size_t length = std::min<size_t>(packet.payload_length, datagram->capacity);
+  memcpy(datagram->buffer, buffer + kReceiveHeaderSize, length);
+  datagram->length = length;
+  datagram->truncated = packet.truncated || length < packet.payload_length;
+  datagram->timestamp = packet.timestamp;
+  datagram->ecn = EcnMarking::kNotEct;
+  sockaddr_storage address;
+  memset(&address, 0, sizeof(address));
+  memcpy(&address, buffer + sizeof(io_uring_recvmsg_out),
+         std::min<size_t>(packet.name_length, kReceiveNameSize));
+  SocketAddressFromSockAddrStorage(address, &datagram->address);
+  RecycleBuffer(packet.buffer_id);
+  return static_cast<int>(length);
+}
+
+io_uring_sqe* IoUringSocketServer::GetSqe() {
+  uint32_t tail = *sq_tail_;
+  if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_) {
+    Enter();
+    if (tail - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) >= sq_entries_)
+      return nullptr;
+  }
+  io_uring_sqe* sqe = &sqes_[tail & sq_mask_];
+  memset(sqe, 0, sizeof(*sqe));
+  // The kernel only looks at the entry once it's submitted.
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++pending_submissions_;
+  return sqe;
+}
+
+void IoUringSocketServer::ArmReceive(IoUringUdpSocket* socket) {
+  io_uring_sqe* sqe = GetSqe();
+  if (!sqe) {
+    receive_stopped_sockets_.insert(socket);
+    return;
+  }
+  sqe->opcode = IORING_OP_RECVMSG;
+  sqe->fd = socket->s_;
+  sqe->addr = reinterpret_cast<uintptr_t>(ReceiveMessageHeader());
+  sqe->len = 1;
+  sqe->ioprio = IORING_RECV_MULTISHOT;
+  sqe->flags = IOSQE_BUFFER_SELECT;
+  sqe->buf_group = kReceiveBufferGroup;
+  sqe->user_data = UserData(kReceive, socket->id_);
+}
+
+void IoUringSocketServer::SubmitPending() {
+  ProvideBuffers();
+  // Receives are armed after buffers are provided for them.
+  if (free_buffers_ > 0 && !receive_stopped_sockets_.empty()) {
+    std::set<IoUringUdpSocket*> stopped;
+    stopped.swap(receive_stopped_sockets_);
+    for (IoUringUdpSocket* socket : stopped)
+      ArmReceive(socket);
+  }
+  Enter();
+}
+
+void IoUringSocketServer::Enter() {
+  // Completions that didn't fit into the completion queue are only moved
+  // there when entering the kernel.
+  bool overflowed =
+      __atomic_load_n(sq_flags_, __ATOMIC_RELAXED) & IORING_SQ_CQ_OVERFLOW;
+  if (pending_submissions_ == 0 && !overflowed)
+    return;
+  int submitted = IoUringEnter(ring_fd_, pending_submissions_,
+                               overflowed ? IORING_ENTER_GETEVENTS : 0);
+  if (submitted < 0) {
+    // EBUSY and EAGAIN mean that completions have to be reaped first.
+    if (errno != EINTR && errno != EBUSY && errno != EAGAIN)
+      RTC_LOG_E(LS_ERROR, EN, errno) << "io_uring_enter";
+    return;
+  }
+  pending_submissions_ -= std::min<uint32_t>(submitted, pending_submissions_);
+}
+
+void IoUringSocketServer::ProvideBuffers() {
+  if (buffers_to_provide_.empty())
+    return;
+  // Buffers with consecutive ids are provided together.
+  std::sort(buffers_to_provide_.begin(), buffers_to_provide_.end());
+  size_t begin = 0;
+  while (begin < buffers_to_provide_.size()) {
+    size_t end = begin + 1;
+    while (end < buffers_to_provide_.size() &&
+           buffers_to_provide_[end] == buffers_to_provide_[end - 1] + 1) {
+      ++end;
+    }
+    io_uring_sqe* sqe = GetSqe();
+    if (!sqe)
+      break;
+    sqe->opcode = IORING_OP_PROVIDE_BUFFERS;
+    sqe->fd = static_cast<int32_t>(end - begin);
+    sqe->addr = reinterpret_cast<uintptr_t>(
+        BufferData(buffers_to_provide_[begin]));
+    sqe->len = kReceiveBufferSize;
+    sqe->off = buffers_to_provide_[begin];
+    sqe->buf_group = kReceiveBufferGroup;
+    sqe->user_data = UserData(kProvideBuffers, 0);
+    begin = end;
+  }
+  buffers_to_provide_.erase(buffers_to_provide_.begin(),
+                            buffers_to_provide_.begin() + begin);
+}
+
+bool IoUringSocketServer::ProcessCompletions() {
+  processing_completions_ = true;
+  uint32_t head = *cq_head_;
+  uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  receive_timestamp_ = head != tail ? TimeMicros() : -1;
+  for (; head != tail; ++head)
+    OnCompletion(cqes_[head & cq_mask_]);
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+
+  // Handlers may close any socket, so signal from copies of the sets and
+  // check that a socket is still there before signaling it.
+  if (!write_blocked_sockets_.empty() && !free_send_slots_.empty()) {
+    std::set<IoUringUdpSocket*> blocked;
+    blocked.swap(write_blocked_sockets_);
+    for (IoUringUdpSocket* socket : blocked) {
+      if (socket->id_ != 0 && sockets_.count(socket->id_) &&
+          (socket->enabled_events() & DE_WRITE)) {
+        socket->SignalWriteEvent(socket);
+      }
+    }
+  }
+  std::vector<IoUringUdpSocket*> readable(readable_sockets_.begin(),
+                                          readable_sockets_.end());
+  for (IoUringUdpSocket* socket : readable) {
+    if (readable_sockets_.count(socket) &&
+        (socket->enabled_events() & DE_READ)) {
+      socket->SignalReadEvent(socket);
+    }
+  }
+  processing_completions_ = false;
+  return !readable_sockets_.empty();
+}
+
+void IoUringSocketServer::OnCompletion(const io_uring_cqe& cqe) {
+  const uint64_t id = cqe.user_data >> kOperationBits;
+  switch (cqe.user_data & ((1 << kOperationBits) - 1)) {
+    case kReceive: {
+      auto it = sockets_.find(id);
+      IoUringUdpSocket* socket = it != sockets_.end() ? it->second : nullptr;
+      if (cqe.flags & IORING_CQE_F_BUFFER) {
+        --free_buffers_;
+        uint16_t buffer_id =
+            static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+        const io_uring_recvmsg_out* out =
+            reinterpret_cast<const io_uring_recvmsg_out*>(
+                BufferData(buffer_id));
+        if (socket && cqe.res >= static_cast<int>(kReceiveHeaderSize)) {
+          ReceivedPacket packet;
+          packet.buffer_id = buffer_id;
+          packet.name_length = static_cast<uint16_t>(out->namelen);
+          packet.payload_length =
+              std::min<uint32_t>(out->payloadlen, cqe.res - kReceiveHeaderSize);
+          packet.truncated = (out->flags & MSG_TRUNC) != 0;
+          packet.timestamp = receive_timestamp_;
+          socket->received_.push_back(packet);
+          readable_sockets_.insert(socket);
+        } else {
+          RecycleBuffer(buffer_id);
+        }
+      }
+      if (socket && !(cqe.flags & IORING_CQE_F_MORE)) {
+        // The multishot receive stopped, typically because there were no
+        // free buffers. It's armed again once there are.
+        if (cqe.res < 0 && cqe.res != -ENOBUFS) {
+          RTC_LOG(LS_VERBOSE) << "io_uring receive stopped with error "
+                              << -cqe.res;
+          socket->SetError(-cqe.res);
+        }
+        receive_stopped_sockets_.insert(socket);
+      }
+      break;
+    }
+    case kSend:
+      if (cqe.res < 0) {
+        // Like errors of UDP sends in general, these are dropped.
+        RTC_LOG(LS_VERBOSE) << "io_uring send failed with error " << -cqe.res;
+      }
+      send_slots_[id]->data.clear();
+      free_send_slots_.push_back(static_cast<size_t>(id));
+      break;
+    case kProvideBuffers:
+      if (cqe.res < 0)
+        RTC_LOG(LS_ERROR) << "Providing io_uring buffers failed: " << -cqe.res;
+      break;
+    case kCancel:
+      break;
+    default:
+      RTC_NOTREACHED();
+  }
+}
+
+void IoUringSocketServer::RecycleBuffer(uint16_t buffer_id) {
+  // Given back to the kernel with the next submissions.
+  buffers_to_provide_.push_back(buffer_id);
+  ++free_buffers_;
+}
+
+const uint8_t* IoUringSocketServer::BufferData(uint16_t buffer_id) const {
+  return buffers_ + static_cast<size_t>(buffer_id) * kReceiveBufferSize;
+}
+
+IoUringUdpSocket::IoUringUdpSocket(IoUringSocketServer* ss)
+    : PhysicalSocket(ss), uring_ss_(ss) {}
+
+IoUringUdpSocket::~IoUringUdpSocket() {
+  Close();
+}
+
+bool IoUringUdpSocket::Create(int family, int type) {
+  if (type != SOCK_DGRAM)
+    return false;
+  if (!PhysicalSocket::Create(family, type))
+    return false;
+  fcntl(s_, F_SETFL, fcntl(s_, F_GETFL, 0) | O_NONBLOCK);
+  uring_ss_->AddSocket(this);
+  return true;
+}
+
+int IoUringUdpSocket::Send(const void* pv, size_t cb) {
+  int error = 0;
+  int sent = uring_ss_->QueueSend(this, pv, cb, nullptr, &error);
+  if (sent < 0) {
+    SetError(error);
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+}
+
+int IoUringUdpSocket::SendTo(const void* buffer,
+                             size_t length,
+                             const SocketAddress& addr) {
+  int error = 0;
+  int sent = uring_ss_->QueueSend(this, buffer, length, &addr, &error);
+  if (sent < 0) {
+    SetError(error);
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+}
+
+int IoUringUdpSocket::SendToBatch(const DatagramToSend* datagrams,
+                                  size_t count) {
+  // Every SendTo() only queues a submission.
+  return Socket::SendToBatch(datagrams, count);
+}
+
+int IoUringUdpSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
+  return RecvFrom(buffer, length, nullptr, timestamp);
+}
+
+int IoUringUdpSocket::RecvFrom(void* buffer,
+                               size_t length,
+                               SocketAddress* out_addr,
+                               int64_t* timestamp) {
+  ReceivedDatagram datagram;
+  datagram.buffer = buffer;
+  datagram.capacity = length;
+  int received = RecvFromBatch(&datagram, 1);
+  if (received <= 0)
+    return received;
+  if (out_addr)
+    *out_addr = datagram.address;
+  if (timestamp)
+    *timestamp = datagram.timestamp;
+  return static_cast<int>(datagram.length);
+}
+
+int IoUringUdpSocket::RecvFromBatch(ReceivedDatagram* datagrams,
+                                    size_t count) {
+  if (id_ == 0) {
+    SetError(EBADF);
+    return -1;
+  }
+  size_t received = 0;
+  int error = 0;
+  while (received < count &&
+         uring_ss_->ReadPacket(this, &datagrams[received], &error) >= 0) {
+    ++received;
+  }
+  if (received == 0) {
+    SetError(error);
+    return -1;
+  }
+  return static_cast<int>(received);
+}
+
+int IoUringUdpSocket::Close() {
+  if (id_ != 0)
+    uring_ss_->RemoveSocket(this);
+  return PhysicalSocket::Close();
+}
+
+}  // namespace rtc
@@ -0,0 +1,187 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_IO_URING_SOCKET_SERVER_H_
+#define RTC_BASE_IO_URING_SOCKET_SERVER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deque>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+#include "rtc_base/physical_socket_server.h"
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace rtc {
+
+class IoUringUdpSocket;
+
+// A PhysicalSocketServer whose asynchronous UDP sockets do their I/O through
+// an io_uring (Linux 6.0 or later). Each socket keeps a multishot receive
+// armed that fills buffers provided to the kernel up front, and sends are
+// queued as submissions that go to the kernel in one system call per Wait(),
+// so a busy socket server makes a few system calls per batch of packets
+// instead of one per packet. All other sockets work exactly as with
+// PhysicalSocketServer, and when the kernel has no io_uring support the
+// server falls back to PhysicalSocketServer behavior altogether.
+//
+// Like PhysicalSocketServer, it must only be used from the thread that
+// waits on it, e.g. as the socket server of an rtc::Thread.
+class IoUringSocketServer : public PhysicalSocketServer {
+ public:
+  IoUringSocketServer();
+  ~IoUringSocketServer() override;
+
+  // False if the io_uring couldn't be set up, in which case all sockets are
+  // PhysicalSocketServer sockets.
+  bool io_uring_enabled() const { return ring_fd_ >= 0; }
+
+  // SocketFactory:
+  AsyncSocket* CreateAsyncSocket(int family, int type) override;
+
+  // SocketServer:
+  bool Wait(int cms, bool process_io) override;
+
+ private:
+  friend class IoUringUdpSocket;
+  class RingDispatcher;
+
+  // A datagram received into a provided buffer, waiting to be read.
+  struct ReceivedPacket {
+    uint16_t buffer_id;
+    uint16_t name_length;
+    uint32_t payload_length;
+    bool truncated;
+    int64_t timestamp;
+  };
+
+  // A send submitted to the kernel. Owns a copy of the data until it
+  // completes.
+  struct SendSlot;
+
+  bool SetUpRing();
+  void TearDownRing();
+
+  // Called by IoUringUdpSocket.
+  void AddSocket(IoUringUdpSocket* socket);
+  void RemoveSocket(IoUringUdpSocket* socket);
+  // Returns the number of bytes queued, or -1 with |*error| set.
+  int QueueSend(IoUringUdpSocket* socket,
+                const void* data,
+                size_t length,
+                const SocketAddress* address,
+                int* error);
+  // Copies out the oldest packet received by |socket|, or returns -1 with
+  // |*error| set to EWOULDBLOCK.
+  int ReadPacket(IoUringUdpSocket* socket,
+                 ReceivedDatagram* datagram,
+                 int* error);
+
+  // Returns null if the submission queue is full even after submitting.
+  io_uring_sqe* GetSqe();
+  void ArmReceive(IoUringUdpSocket* socket);
+  // Queues the buffers to provide and the receives to arm again, then
+  // submits everything queued.
+  void SubmitPending();
+  void Enter();
+  void ProvideBuffers();
+  // Reaps completions and signals read and write events. Returns true if
+  // any socket still has packets waiting to be read.
+  bool ProcessCompletions();
+  void OnCompletion(const io_uring_cqe& cqe);
+  void RecycleBuffer(uint16_t buffer_id);
+  const uint8_t* BufferData(uint16_t buffer_id) const;
+
+  int ring_fd_ = -1;
+  // Memory shared with the kernel.
+  void* rings_ = nullptr;
+  size_t rings_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  uint32_t* sq_head_ = nullptr;
+  uint32_t* sq_tail_ = nullptr;
+  uint32_t* sq_flags_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t sq_entries_ = 0;
+  uint32_t* cq_head_ = nullptr;
+  uint32_t* cq_tail_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  // Submissions written since the last io_uring_enter().
+  uint32_t pending_submissions_ = 0;
+  // Whether PhysicalSocketServer::Wait() or ProcessCompletions() is running.
+  bool in_wait_ = false;
+  bool processing_completions_ = false;
+  // When the completions being processed were reaped.
+  int64_t receive_timestamp_ = -1;
+
+  uint8_t* buffers_ = nullptr;
+  // Ids of the buffers that are free but not provided to the kernel yet.
+  std::vector<uint16_t> buffers_to_provide_;
+  // Buffers that are provided or about to be.
+  uint32_t free_buffers_ = 0;
+
+  std::vector<std::unique_ptr<SendSlot>> send_slots_;
+  std::vector<size_t> free_send_slots_;
+
+  uint64_t next_socket_id_ = 1;
+  std::unordered_map<uint64_t, IoUringUdpSocket*> sockets_;
+  // Sockets with received packets, and sockets waiting for a send slot.
+  std::set<IoUringUdpSocket*> readable_sockets_;
+  std::set<IoUringUdpSocket*> write_blocked_sockets_;
+  // Sockets whose multishot receive stopped, to be armed again while there
+  // are free buffers.
+  std::set<IoUringUdpSocket*> receive_stopped_sockets_;
+
+  std::unique_ptr<RingDispatcher> ring_dispatcher_;
+};
+
+// Asynchronous UDP socket of an IoUringSocketServer.
+class IoUringUdpSocket : public PhysicalSocket {
+ public:
+  explicit IoUringUdpSocket(IoUringSocketServer* ss);
+  ~IoUringUdpSocket() override;
+
+  bool Create(int family, int type) override;
+
+  int Send(const void* pv, size_t cb) override;
+  int SendTo(const void* buffer,
+             size_t length,
+             const SocketAddress& addr) override;
+  int SendToBatch(const DatagramToSend* datagrams, size_t count) override;
+
+  int Recv(void* buffer, size_t length, int64_t* timestamp) override;
+  int RecvFrom(void* buffer,
+               size_t length,
+               SocketAddress* out_addr,
+               int64_t* timestamp) override;
+  int RecvFromBatch(ReceivedDatagram* datagrams, size_t count) override;
+
+  int Close() override;
+
+ private:
+  friend class IoUringSocketServer;
+
+  IoUringSocketServer* const uring_ss_;
+  // Identifies the socket in completions, since completions may arrive
+  // after the socket is gone. 0 while not registered.
+  uint64_t id_ = 0;
+  std::deque<IoUringSocketServer::ReceivedPacket> received_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_IO_URING_SOCKET_SERVER_H_
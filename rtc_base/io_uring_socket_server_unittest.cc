@@ -0,0 +1,188 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/io_uring_socket_server.h"
+
+#include <memory>
+
+#include "rtc_base/gunit.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/socket_unittest.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+class IoUringSocketTest : public SocketTest {
+ protected:
+  IoUringSocketTest()
+      : server_(new IoUringSocketServer()), thread_(server_.get()) {}
+
+  std::unique_ptr<IoUringSocketServer> server_;
+  AutoSocketServerThread thread_;
+};
+
+TEST_F(IoUringSocketTest, TestUdpIPv4) {
+  TestUdpIPv4();
+}
+
+TEST_F(IoUringSocketTest, TestUdpIPv6) {
+  TestUdpIPv6();
+}
+
+TEST_F(IoUringSocketTest, TestUdpReadyToSendIPv4) {
+  TestUdpReadyToSendIPv4();
+}
+
+TEST_F(IoUringSocketTest, TestGetSetOptionsIPv4) {
+  TestGetSetOptionsIPv4();
+}
+
+TEST_F(IoUringSocketTest, TestSocketServerWaitIPv4) {
+  TestSocketServerWaitIPv4();
+}
+
+// TCP sockets are those of PhysicalSocketServer.
+TEST_F(IoUringSocketTest, TestTcpIPv4) {
+  TestTcpIPv4();
+}
+
+TEST_F(IoUringSocketTest, RecvFromBatchReadsQueuedDatagramsIPv4) {
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  const int kNumDatagrams = 3;
+  for (char i = 0; i < kNumDatagrams; ++i) {
+    char payload[] = {i, i, i};
+    ASSERT_EQ(static_cast<int>(sizeof(payload)),
+              sender->SendTo(payload, sizeof(payload),
+                             receiver->GetLocalAddress()));
+  }
+
+  char buffers[4][16];
+  ReceivedDatagram datagrams[4];
+  for (int i = 0; i < 4; ++i) {
+    datagrams[i].buffer = buffers[i];
+    datagrams[i].capacity = sizeof(buffers[i]);
+  }
+  int received = 0;
+  // Sends are submitted, and receives reaped, while waiting.
+  for (int attempt = 0; attempt < 100 && received < kNumDatagrams; ++attempt) {
+    server_->Wait(1, true);
+    int count = receiver->RecvFromBatch(&datagrams[received], 4 - received);
+    if (count > 0)
+      received += count;
+  }
+  ASSERT_EQ(kNumDatagrams, received);
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    EXPECT_EQ(3u, datagrams[i].length);
+    EXPECT_FALSE(datagrams[i].truncated);
+    EXPECT_EQ(i, buffers[i][0]);
+    EXPECT_EQ(sender->GetLocalAddress(), datagrams[i].address);
+    EXPECT_GT(datagrams[i].timestamp, -1);
+  }
+}
+
+constexpr size_t kPacketSize = 1200;
+
+// Counts the datagrams a socket receives, reading all that are available on
+// each read event.
+class PacketCounter : public sigslot::has_slots<> {
+ public:
+  explicit PacketCounter(AsyncSocket* socket) : socket_(socket) {
+    socket_->SignalReadEvent.connect(this, &PacketCounter::OnReadEvent);
+  }
+
+  int count() const { return count_; }
+
+ private:
+  void OnReadEvent(AsyncSocket* socket) {
+    char buffers[kBatchSize][kPacketSize];
+    ReceivedDatagram datagrams[kBatchSize];
+    for (size_t i = 0; i < kBatchSize; ++i) {
+      datagrams[i].buffer = buffers[i];
+      datagrams[i].capacity = kPacketSize;
+    }
+    int received;
+    while ((received = socket->RecvFromBatch(datagrams, kBatchSize)) > 0)
+      count_ += received;
+  }
+
+  static constexpr size_t kBatchSize = 32;
+  AsyncSocket* const socket_;
+  int count_ = 0;
+};
+
+// Sends |num_packets| from one socket to another, in bursts, and returns how
+// many were received.
+int RunUdpThroughput(SocketServer* ss, int num_packets) {
+  std::unique_ptr<AsyncSocket> receiver(
+      ss->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      ss->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  IPAddress loopback(INADDR_LOOPBACK);
+  receiver->Bind(SocketAddress(loopback, 0));
+  sender->Bind(SocketAddress(loopback, 0));
+  receiver->SetOption(Socket::OPT_RCVBUF, 8 * 1024 * 1024);
+  PacketCounter counter(receiver.get());
+
+  static constexpr int kBurstSize = 64;
+  char packet[kPacketSize] = {};
+  int sent = 0;
+  while (sent < num_packets) {
+    for (int i = 0; i < kBurstSize && sent < num_packets; ++i) {
+      if (sender->SendTo(packet, sizeof(packet),
+                         receiver->GetLocalAddress()) < 0) {
+        break;
+      }
+      ++sent;
+    }
+    ss->Wait(0, true);
+  }
+  // Let the last packets arrive.
+  int64_t deadline = TimeMillis() + 100;
+  while (counter.count() < sent && TimeMillis() < deadline)
+    ss->Wait(1, true);
+  return counter.count();
+}
+
+TEST(IoUringSocketServerTest, DISABLED_UdpPacketRatePerf) {
+  static constexpr int kNumPackets = 1000000;
+
+  PhysicalSocketServer epoll_ss;
+  int64_t start_us = TimeMicros();
+  int epoll_received = RunUdpThroughput(&epoll_ss, kNumPackets);
+  int64_t epoll_us = TimeMicros() - start_us;
+
+  IoUringSocketServer io_uring_ss;
+  start_us = TimeMicros();
+  int io_uring_received = RunUdpThroughput(&io_uring_ss, kNumPackets);
+  int64_t io_uring_us = TimeMicros() - start_us;
+
+  RTC_LOG(LS_INFO) << "epoll: " << epoll_received << " of " << kNumPackets
+                   << " packets received, "
+                   << epoll_received * kNumMicrosecsPerSec / epoll_us
+                   << " packets/s.";
+  RTC_LOG(LS_INFO) << "io_uring (enabled: " << io_uring_ss.io_uring_enabled()
+                   << "): " << io_uring_received << " of " << kNumPackets
+                   << " packets received, "
+                   << io_uring_received * kNumMicrosecsPerSec / io_uring_us
+                   << " packets/s.";
+}
+
+}  // namespace
+}  // namespace rtc
@@ -0,0 +1,383 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/allocation_tracker.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <utility>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+namespace {
+
+// Distinct stages per thread, a power of two. Further stages are counted
+// together.
+constexpr size_t kMaxStages = 256;
+const char kOtherStages[] = "(other)";
+
+// Written only by the thread it belongs to; read by GetStats().
+struct StageCounter {
+  std::atomic<const char*> stage{nullptr};
+  std::atomic<int64_t> allocations{0};
+  std::atomic<int64_t> bytes{0};
+
+  void Add(size_t size) {
+    allocations.store(allocations.load(std::memory_order_relaxed) + 1,
+                      std::memory_order_relaxed);
+    bytes.store(bytes.load(std::memory_order_relaxed) + size,
+                std::memory_order_relaxed);
+  }
+};
+
+struct ThreadState {
+  explicit ThreadState(const char* name) : name(name) {}
+
+  StageCounter* Find(const char* stage) {
+    if (!stage)
+      return &no_stage;
+    const size_t index =
+        (reinterpret_cast<uintptr_t>(stage) >> 3) & (kMaxStages - 1);
+    for (size_t i = 0; i < kMaxStages; ++i) {
+      StageCounter& counter = stages[(index + i) & (kMaxStages - 1)];
+      const char* counter_stage =
+          counter.stage.load(std::memory_order_relaxed);
+      if (counter_stage == stage)
+        return &counter;
+      if (!counter_stage) {
+        counter.stage.store(stage, std::memory_order_release);
+        return &counter;
+      }
+    }
+    return &other_stages;
+  }
+
+  // Called by the owning thread when it sees a new Start().
+  void Reset(int new_generation) {
+    no_stage.allocations.store(0, std::memory_order_relaxed);
+    no_stage.bytes.store(0, std::memory_order_relaxed);
+    other_stages.allocations.store(0, std::memory_order_relaxed);
+    other_stages.bytes.store(0, std::memory_order_relaxed);
+    for (StageCounter& counter : stages) {
+      counter.stage.store(nullptr, std::memory_order_relaxed);
+      counter.allocations.store(0, std::memory_order_relaxed);
+      counter.bytes.store(0, std::memory_order_relaxed);
+    }
+    generation.store(new_generation, std::memory_order_release);
+  }
+
+  const std::string name;
+  // Whether the name matches the prefixes passed to Start().
+  std::atomic<bool> counting{false};
+  // The Start() the counters belong to.
+  std::atomic<int> generation{0};
+  StageCounter no_stage;
+  StageCounter other_stages;
+  StageCounter stages[kMaxStages];
+};
+
+class Registry {
+ public:
+  void Start(std::vector<std::string> thread_name_prefixes) {
+    CritScope lock(&lock_);
+    prefixes_ = std::move(thread_name_prefixes);
+    for (ThreadState* state : threads_)
+      state->counting.store(Matches(state->name), std::memory_order_relaxed);
+    generation_.fetch_add(1, std::memory_order_relaxed);
+    packets_.store(0, std::memory_order_relaxed);
+    frames_.store(0, std::memory_order_relaxed);
+    running_.store(true, std::memory_order_release);
+  }
+
+  void Stop() { running_.store(false, std::memory_order_release); }
+
+  // Threads are never unregistered; a thread's state outlives the thread so
+  // that its counts can still be reported.
+  ThreadState* Register(const char* name) {
+    ThreadState* state = new ThreadState(name);
+    CritScope lock(&lock_);
+    state->counting.store(Matches(state->name), std::memory_order_relaxed);
+    threads_.push_back(state);
+    return state;
+  }
+
+  AllocationTracker::Stats GetStats() {
+    AllocationTracker::Stats stats;
+    stats.packets = packets_.load(std::memory_order_relaxed);
+    stats.frames = frames_.load(std::memory_order_relaxed);
+    CritScope lock(&lock_);
+    const int generation = generation_.load(std::memory_order_relaxed);
+    for (ThreadState* state : threads_) {
+      // Threads that haven't allocated since the last Start() still hold
+      // counts from before it.
+      if (!state->counting.load(std::memory_order_relaxed) ||
+          state->generation.load(std::memory_order_acquire) != generation) {
+        continue;
+      }
+      const size_t first = stats.stages.size();
+      AddStage(*state, state->no_stage, "", &stats.stages, first);
+      AddStage(*state, state->other_stages, kOtherStages, &stats.stages,
+               first);
+      for (const StageCounter& counter : state->stages) {
+        const char* stage = counter.stage.load(std::memory_order_acquire);
+        if (stage)
+          AddStage(*state, counter, stage, &stats.stages, first);
+      }
+    }
+    std::sort(stats.stages.begin(), stats.stages.end(),
+              [](const AllocationTracker::StageStats& a,
+                 const AllocationTracker::StageStats& b) {
+                if (a.thread != b.thread)
+                  return a.thread < b.thread;
+                return a.allocations > b.allocations;
+              });
+    return stats;
+  }
+
+  bool running() const { return running_.load(std::memory_order_relaxed); }
+  int generation() const {
+    return generation_.load(std::memory_order_relaxed);
+  }
+  void AddPackets(int64_t packets) {
+    packets_.fetch_add(packets, std::memory_order_relaxed);
+  }
+  void AddFrames(int64_t frames) {
+    frames_.fetch_add(frames, std::memory_order_relaxed);
+  }
+
+ private:
+  bool Matches(const std::string& name) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    if (prefixes_.empty())
+      return true;
+    for (const std::string& prefix : prefixes_) {
+      if (name.compare(0, prefix.size(), prefix) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  // Stages are keyed by pointer, so the same name may show up more than once
+  // when it comes from string literals in different translation units.
+  // Merges those, looking at the entries of the thread, from |first| on.
+  static void AddStage(const ThreadState& state,
+                       const StageCounter& counter,
+                       const char* stage,
+                       std::vector<AllocationTracker::StageStats>* stages,
+                       size_t first) {
+    const int64_t allocations =
+        counter.allocations.load(std::memory_order_relaxed);
+    if (allocations == 0)
+      return;
+    const int64_t bytes = counter.bytes.load(std::memory_order_relaxed);
+    for (size_t i = first; i < stages->size(); ++i) {
+      AllocationTracker::StageStats& stats = (*stages)[i];
+      if (stats.stage == stage) {
+        stats.allocations += allocations;
+        stats.bytes += bytes;
+        return;
+      }
+    }
+    AllocationTracker::StageStats stats;
+    stats.thread = state.name;
+    stats.stage = stage;
+    stats.allocations = allocations;
+    stats.bytes = bytes;
+    stages->push_back(std::move(stats));
+  }
+
+  CriticalSection lock_;
+  std::vector<std::string> prefixes_ RTC_GUARDED_BY(lock_);
+  std::vector<ThreadState*> threads_ RTC_GUARDED_BY(lock_);
+  std::atomic<bool> running_{false};
+  std::atomic<int> generation_{0};
+  std::atomic<int64_t> packets_{0};
+  std::atomic<int64_t> frames_{0};
+};
+
+Registry* GetRegistry() {
+  // Never destroyed, so that allocations during static destruction can still
+  // be reported.
+  static Registry* const registry = new Registry();
+  return registry;
+}
+
+#if defined(ABSL_HAVE_THREAD_LOCAL)
+
+ABSL_CONST_INIT thread_local const char* current_stage = nullptr;
+ABSL_CONST_INIT thread_local ThreadState* current_thread = nullptr;
+
+const char* CurrentStage() {
+  return current_stage;
+}
+void SetCurrentStage(const char* stage) {
+  current_stage = stage;
+}
+ThreadState* CurrentThread() {
+  return current_thread;
+}
+void SetCurrentThread(ThreadState* state) {
+  current_thread = state;
+}
+
+#else  // defined(ABSL_HAVE_THREAD_LOCAL)
+
+// Without thread_local support no thread is ever registered, and nothing is
+// counted.
+const char* CurrentStage() {
+  return nullptr;
+}
+void SetCurrentStage(const char* stage) {}
+ThreadState* CurrentThread() {
+  return nullptr;
+}
+void SetCurrentThread(ThreadState* state) {}
+
+#endif  // defined(ABSL_HAVE_THREAD_LOCAL)
+
+}  // namespace
+
+std::string AllocationTracker::Stats::ToString() const {
+  std::string result;
+  char line[256];
+  snprintf(line, sizeof(line), "%lld packets, %lld frames\n",
+           static_cast<long long>(packets), static_cast<long long>(frames));
+  result += line;
+  for (const StageStats& stats : stages) {
+    snprintf(line, sizeof(line),
+             "%-24s %-40s %10lld allocs %12lld bytes %8.3f /packet %8.3f "
+             "/frame\n",
+             stats.thread.c_str(),
+             stats.stage.empty() ? "(no stage)" : stats.stage.c_str(),
+             static_cast<long long>(stats.allocations),
+             static_cast<long long>(stats.bytes),
+             packets > 0 ? static_cast<double>(stats.allocations) / packets
+                         : 0.0,
+             frames > 0 ? static_cast<double>(stats.allocations) / frames
+                        : 0.0);
+    result += line;
+  }
+  return result;
+}
+
+void AllocationTracker::Start(std::vector<std::string> thread_name_prefixes) {
+  GetRegistry()->Start(std::move(thread_name_prefixes));
+}
+
+void AllocationTracker::Stop() {
+  GetRegistry()->Stop();
+}
+
+AllocationTracker::Stats AllocationTracker::GetStats() {
+  return GetRegistry()->GetStats();
+}
+
+void AllocationTracker::RegisterCurrentThread(const char* name) {
+  if (!CurrentThread())
+    SetCurrentThread(GetRegistry()->Register(name));
+}
+
+void AllocationTracker::OnAllocation(size_t size) {
+  ThreadState* state = CurrentThread();
+  if (!state || !state->counting.load(std::memory_order_relaxed))
+    return;
+  Registry* registry = GetRegistry();
+  if (!registry->running())
+    return;
+  const int generation = registry->generation();
+  if (state->generation.load(std::memory_order_relaxed) != generation)
+    state->Reset(generation);
+  state->Find(CurrentStage())->Add(size);
+}
+
+void AllocationTracker::AddPackets(int64_t packets) {
+  Registry* registry = GetRegistry();
+  if (registry->running())
+    registry->AddPackets(packets);
+}
+
+void AllocationTracker::AddFrames(int64_t frames) {
+  Registry* registry = GetRegistry();
+  if (registry->running())
+    registry->AddFrames(frames);
+}
+
+ScopedAllocationStage::ScopedAllocationStage(const char* name)
+    : previous_(CurrentStage()) {
+  SetCurrentStage(name);
+}
+
+ScopedAllocationStage::~ScopedAllocationStage() {
+  SetCurrentStage(previous_);
+}
+
+}  // namespace rtc
+
+#if defined(WEBRTC_ALLOCATION_TRACKING)
+
+// Reports every allocation made through the global operator new. The aligned
+// variants are left alone; the media pipeline doesn't use them on hot paths.
+
+void* operator new(size_t size) {
+  rtc::AllocationTracker::OnAllocation(size);
+  void* ptr = malloc(size == 0 ? 1 : size);
+  if (!ptr)
+    abort();
+  return ptr;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+  rtc::AllocationTracker::OnAllocation(size);
+  return malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t& nothrow) noexcept {
+  return operator new(size, nothrow);
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+  free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  free(ptr);
+}
+
+#endif  // defined(WEBRTC_ALLOCATION_TRACKING)
@@ -0,0 +1,105 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_ALLOCATION_TRACKER_H_
+#define RTC_BASE_MEMORY_ALLOCATION_TRACKER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+namespace rtc {
+
+// Counts heap allocations made on named threads and attributes them to the
+// stage that was innermost on the allocating thread when it allocated.
+//
+// When built with the rtc_enable_allocation_tracking GN arg, which defines
+// WEBRTC_ALLOCATION_TRACKING, the wiring is automatic: rtc::Thread and
+// rtc::PlatformThread register their threads by name, every TRACE_EVENT scope
+// is a stage, global operator new reports each allocation, and the media
+// pipeline counts the packets and frames it handles. Otherwise only explicit
+// calls below are counted, and the macros at the end compile to nothing.
+class AllocationTracker {
+ public:
+  struct StageStats {
+    std::string thread;
+    // Empty for allocations made outside any stage.
+    std::string stage;
+    int64_t allocations = 0;
+    int64_t bytes = 0;
+  };
+
+  struct Stats {
+    int64_t packets = 0;
+    int64_t frames = 0;
+    // Sorted by thread, then by allocations, most first.
+    std::vector<StageStats> stages;
+
+    // One line per stage with its allocations per packet and per frame.
+    std::string ToString() const;
+  };
+
+  // Resets all counts and starts counting on the threads whose name starts
+  // with one of |thread_name_prefixes|, e.g. "pc_network_thread" or
+  // "EncoderQueue", or on all registered threads if it's empty.
+  static void Start(std::vector<std::string> thread_name_prefixes);
+  static void Stop();
+
+  // Counts from the last Start().
+  static Stats GetStats();
+
+  // Registers the current thread under |name|, which should stay the same
+  // for the lifetime of the thread. Threads that aren't registered are never
+  // counted.
+  static void RegisterCurrentThread(const char* name);
+
+  // Called for each allocation. Must not allocate.
+  static void OnAllocation(size_t size);
+
+  // Units of work to normalize the counts by.
+  static void AddPackets(int64_t packets);
+  static void AddFrames(int64_t frames);
+};
+
+// Makes |name| the stage of the current thread for the lifetime of the
+// object. |name| must outlive the tracker; a string literal is the intended
+// use, as with TRACE_EVENT names.
+class ScopedAllocationStage {
+ public:
+  explicit ScopedAllocationStage(const char* name);
+  ~ScopedAllocationStage();
+
+  ScopedAllocationStage(const ScopedAllocationStage&) = delete;
+  ScopedAllocationStage& operator=(const ScopedAllocationStage&) = delete;
+
+ private:
+  const char* const previous_;
+};
+
+}  // namespace rtc
+
+#if defined(WEBRTC_ALLOCATION_TRACKING)
+#define RTC_ALLOCATION_STAGE_UID2(line) rtc_allocation_stage_##line
+#define RTC_ALLOCATION_STAGE_UID(line) RTC_ALLOCATION_STAGE_UID2(line)
+#define RTC_ALLOCATION_STAGE(name) \
+  rtc::ScopedAllocationStage RTC_ALLOCATION_STAGE_UID(__LINE__)(name)
+#define RTC_ALLOCATION_TRACKER_ADD_PACKETS(packets) \
+  rtc::AllocationTracker::AddPackets(packets)
+#define RTC_ALLOCATION_TRACKER_ADD_FRAMES(frames) \
+  rtc::AllocationTracker::AddFrames(frames)
+#else
+#define RTC_ALLOCATION_STAGE(name)
+#define RTC_ALLOCATION_TRACKER_ADD_PACKETS(packets)
+#define RTC_ALLOCATION_TRACKER_ADD_FRAMES(frames)
+#endif  // defined(WEBRTC_ALLOCATION_TRACKING)
+
+#endif  // RTC_BASE_MEMORY_ALLOCATION_TRACKER_H_
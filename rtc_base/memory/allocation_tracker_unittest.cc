@@ -0,0 +1,112 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/allocation_tracker.h"
+
+#include <thread>
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+// Threads stay registered for the lifetime of the process, so each test uses
+// its own thread names. The tracked threads make no allocations of their own
+// between registering and exiting, which keeps the counts exact also when
+// operator new reports to the tracker.
+const AllocationTracker::StageStats* FindStage(
+    const AllocationTracker::Stats& stats,
+    const std::string& thread,
+    const std::string& stage) {
+  for (const AllocationTracker::StageStats& stage_stats : stats.stages) {
+    if (stage_stats.thread == thread && stage_stats.stage == stage)
+      return &stage_stats;
+  }
+  return nullptr;
+}
+
+TEST(AllocationTrackerTest, AttributesAllocationsToInnermostStage) {
+  AllocationTracker::Start({"AttributeTest"});
+  std::thread thread([] {
+    AllocationTracker::RegisterCurrentThread("AttributeTest");
+    AllocationTracker::OnAllocation(10);
+    {
+      ScopedAllocationStage outer("Outer");
+      AllocationTracker::OnAllocation(20);
+      {
+        ScopedAllocationStage inner("Inner");
+        AllocationTracker::OnAllocation(30);
+        AllocationTracker::OnAllocation(30);
+      }
+      AllocationTracker::OnAllocation(40);
+    }
+  });
+  thread.join();
+  AllocationTracker::AddPackets(4);
+  AllocationTracker::AddFrames(1);
+  const AllocationTracker::Stats stats = AllocationTracker::GetStats();
+  AllocationTracker::Stop();
+
+  EXPECT_EQ(4, stats.packets);
+  EXPECT_EQ(1, stats.frames);
+  const AllocationTracker::StageStats* none =
+      FindStage(stats, "AttributeTest", "");
+  ASSERT_TRUE(none);
+  EXPECT_EQ(1, none->allocations);
+  EXPECT_EQ(10, none->bytes);
+  const AllocationTracker::StageStats* outer =
+      FindStage(stats, "AttributeTest", "Outer");
+  ASSERT_TRUE(outer);
+  EXPECT_EQ(2, outer->allocations);
+  EXPECT_EQ(60, outer->bytes);
+  const AllocationTracker::StageStats* inner =
+      FindStage(stats, "AttributeTest", "Inner");
+  ASSERT_TRUE(inner);
+  EXPECT_EQ(2, inner->allocations);
+  EXPECT_EQ(60, inner->bytes);
+  EXPECT_NE(std::string::npos, stats.ToString().find("Inner"));
+}
+
+TEST(AllocationTrackerTest, CountsOnlyThreadsMatchingPrefixes) {
+  AllocationTracker::Start({"PrefixTestNetwork"});
+  std::thread network([] {
+    AllocationTracker::RegisterCurrentThread("PrefixTestNetwork1");
+    AllocationTracker::OnAllocation(1);
+  });
+  std::thread other([] {
+    AllocationTracker::RegisterCurrentThread("PrefixTestOther");
+    AllocationTracker::OnAllocation(1);
+  });
+  network.join();
+  other.join();
+  const AllocationTracker::Stats stats = AllocationTracker::GetStats();
+  AllocationTracker::Stop();
+
+  EXPECT_TRUE(FindStage(stats, "PrefixTestNetwork1", ""));
+  EXPECT_FALSE(FindStage(stats, "PrefixTestOther", ""));
+}
+
+TEST(AllocationTrackerTest, NothingIsCountedWhenStopped) {
+  AllocationTracker::Start({"StoppedTest"});
+  AllocationTracker::Stop();
+  std::thread thread([] {
+    AllocationTracker::RegisterCurrentThread("StoppedTest");
+    AllocationTracker::OnAllocation(1);
+  });
+  thread.join();
+  AllocationTracker::AddPackets(1);
+  const AllocationTracker::Stats stats = AllocationTracker::GetStats();
+
+  EXPECT_EQ(0, stats.packets);
+  EXPECT_FALSE(FindStage(stats, "StoppedTest", ""));
+}
+
+}  // namespace
+}  // namespace rtc
@@ -0,0 +1,220 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/buffer_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <vector>
+
+#include "absl/base/config.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+// Pooled blocks would hide use-after-free bugs from the sanitizers.
+#if defined(ABSL_HAVE_THREAD_LOCAL) && !defined(ADDRESS_SANITIZER) && \
+    !defined(MEMORY_SANITIZER) && !defined(WEBRTC_DISABLE_BUFFER_POOL)
+#define RTC_BUFFER_POOL_ENABLED 1
+#else
+#define RTC_BUFFER_POOL_ENABLED 0
+#endif
+
+namespace rtc {
+
+namespace {
+
+std::atomic<int64_t> g_allocations{0};
+std::atomic<int64_t> g_heap_allocations{0};
+
+void* HeapAllocate(size_t size) {
+  g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  return ::operator new(size);
+}
+
+}  // namespace
+
+#if RTC_BUFFER_POOL_ENABLED
+
+namespace {
+
+// Block sizes are 256 bytes, 512 bytes, ..., 64 KiB.
+constexpr size_t kMinBlockSize = 256;
+constexpr int kNumSizeClasses = 9;
+// Blocks are moved between a thread cache and the depot in batches of about
+// this many bytes. A thread cache holds up to two batches per size class.
+constexpr size_t kBatchBytes = 32 * 1024;
+// Number of batches per size class the depot holds on to before freeing
+// blocks instead.
+constexpr size_t kMaxDepotBatches = 16;
+// Number of allocations a thread counts before adding them to the totals.
+constexpr int64_t kStatsBatchSize = 256;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+int SizeClass(size_t size) {
+  int size_class = 0;
+  size_t block_size = kMinBlockSize;
+  while (block_size < size) {
+    block_size *= 2;
+    ++size_class;
+  }
+  return size_class;
+}
+
+size_t BlockSize(int size_class) {
+  return kMinBlockSize << size_class;
+}
+
+int BatchSize(int size_class) {
+  return static_cast<int>(
+      std::max<size_t>(2, kBatchBytes / BlockSize(size_class)));
+}
+
+void FreeChain(FreeBlock* head) {
+  while (head) {
+    FreeBlock* next = head->next;
+    ::operator delete(head);
+    head = next;
+  }
+}
+
+// Batches of free blocks shared by all threads.
+class Depot {
+ public:
+  // Returns null if the depot has no batch of this size class.
+  FreeBlock* Take(int size_class) {
+    CritScope lock(&lock_);
+    std::vector<FreeBlock*>& batches = batches_[size_class];
+    if (batches.empty())
+      return nullptr;
+    FreeBlock* batch = batches.back();
+    batches.pop_back();
+    return batch;
+  }
+
+  void Give(int size_class, FreeBlock* batch) {
+    {
+      CritScope lock(&lock_);
+      std::vector<FreeBlock*>& batches = batches_[size_class];
+      if (batches.size() < kMaxDepotBatches) {
+        batches.push_back(batch);
+        return;
+      }
+    }
+    FreeChain(batch);
+  }
+
+ private:
+  CriticalSection lock_;
+  std::vector<FreeBlock*> batches_[kNumSizeClasses] RTC_GUARDED_BY(lock_);
+};
+
+Depot* GetDepot() {
+  // Never destroyed, so that threads exiting during static destruction can
+  // still return their blocks.
+  static Depot* const depot = new Depot();
+  return depot;
+}
+
+class ThreadCache {
+ public:
+  ~ThreadCache() {
+    for (int size_class = 0; size_class < kNumSizeClasses; ++size_class)
+      FreeChain(free_[size_class]);
+    g_allocations.fetch_add(allocations_, std::memory_order_relaxed);
+  }
+
+  void* Allocate(int size_class) {
+    if (++allocations_ == kStatsBatchSize) {
+      g_allocations.fetch_add(allocations_, std::memory_order_relaxed);
+      allocations_ = 0;
+    }
+    if (!free_[size_class]) {
+      free_[size_class] = GetDepot()->Take(size_class);
+      if (!free_[size_class])
+        return HeapAllocate(BlockSize(size_class));
+      count_[size_class] = BatchSize(size_class);
+    }
+    FreeBlock* block = free_[size_class];
+    free_[size_class] = block->next;
+    --count_[size_class];
+    return block;
+  }
+
+  void Free(void* ptr, int size_class) {
+    const int batch_size = BatchSize(size_class);
+    if (count_[size_class] == 2 * batch_size) {
+      // Hand the oldest blocks over to the depot, keeping a batch for this
+      // thread.
+      FreeBlock* last_kept = free_[size_class];
+      for (int i = 1; i < batch_size; ++i)
+        last_kept = last_kept->next;
+      GetDepot()->Give(size_class, last_kept->next);
+      last_kept->next = nullptr;
+      count_[size_class] = batch_size;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = free_[size_class];
+    free_[size_class] = block;
+    ++count_[size_class];
+  }
+
+ private:
+  FreeBlock* free_[kNumSizeClasses] = {};
+  int count_[kNumSizeClasses] = {};
+  int64_t allocations_ = 0;
+};
+
+thread_local ThreadCache thread_cache;
+
+}  // namespace
+
+void* BufferPool::Allocate(size_t size) {
+  if (size > kMaxSize) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return HeapAllocate(size);
+  }
+  return thread_cache.Allocate(SizeClass(size));
+}
+
+void BufferPool::Free(void* ptr, size_t size) {
+  if (!ptr)
+    return;
+  if (size > kMaxSize) {
+    ::operator delete(ptr);
+    return;
+  }
+  thread_cache.Free(ptr, SizeClass(size));
+}
+
+#else  // RTC_BUFFER_POOL_ENABLED
+
+void* BufferPool::Allocate(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  return HeapAllocate(size);
+}
+
+void BufferPool::Free(void* ptr, size_t size) {
+  ::operator delete(ptr);
+}
+
+#endif  // RTC_BUFFER_POOL_ENABLED
+
+BufferPool::Stats BufferPool::GetStats() {
+  Stats stats;
+  stats.allocations = g_allocations.load(std::memory_order_relaxed);
+  stats.heap_allocations = g_heap_allocations.load(std::memory_order_relaxed);
+  return stats;
+}
+
+}  // namespace rtc
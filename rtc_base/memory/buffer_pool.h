@@ -0,0 +1,48 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_BUFFER_POOL_H_
+#define RTC_BASE_MEMORY_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace rtc {
+
+// Allocator for packet sized buffers, e.g. the storage of CopyOnWriteBuffer.
+// Like SmallObjectPool, it caches freed blocks per thread and hands batches
+// of them over between threads through a shared depot, since packets are
+// typically allocated on one thread and freed on another. Block sizes are
+// powers of two from 256 bytes to |kMaxSize|, and larger blocks are
+// allocated with operator new. Pooling can be turned off at build time with
+// the rtc_use_buffer_pool GN arg.
+class BufferPool {
+ public:
+  static constexpr size_t kMaxSize = 64 * 1024;
+
+  static void* Allocate(size_t size);
+  // |size| must be the size that was passed to Allocate().
+  static void Free(void* ptr, size_t size);
+
+  struct Stats {
+    // Blocks handed out by Allocate().
+    int64_t allocations = 0;
+    // Of those, the ones that were allocated with operator new rather than
+    // reused from the pool.
+    int64_t heap_allocations = 0;
+  };
+  // Threads report their allocations in batches, so the counts may lag
+  // behind by a few hundred allocations per thread.
+  static Stats GetStats();
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_MEMORY_BUFFER_POOL_H_
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/buffer_pool.h"
+
+#include <string.h>
+
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+TEST(BufferPoolTest, BlocksAreUsableAndDistinct) {
+  for (size_t size : {1, 255, 256, 257, 1200, 65536, 65537, 200000}) {
+    std::vector<void*> blocks;
+    std::set<void*> distinct;
+    for (int i = 0; i < 200; ++i) {
+      void* block = BufferPool::Allocate(size);
+      memset(block, i & 0xff, size);
+      blocks.push_back(block);
+      distinct.insert(block);
+    }
+    EXPECT_EQ(blocks.size(), distinct.size());
+    for (void* block : blocks)
+      BufferPool::Free(block, size);
+  }
+}
+
+TEST(BufferPoolTest, CountsAllocations) {
+  const BufferPool::Stats before = BufferPool::GetStats();
+  // Enough allocations for this thread to report a batch of them.
+  for (int i = 0; i < 1000; ++i)
+    BufferPool::Free(BufferPool::Allocate(1200), 1200);
+  const BufferPool::Stats after = BufferPool::GetStats();
+  EXPECT_GE(after.allocations - before.allocations, 512);
+  EXPECT_LE(after.heap_allocations - before.heap_allocations,
+            after.allocations - before.allocations);
+}
+
+TEST(BufferPoolTest, BlocksFreedOnAnotherThreadAreUsable) {
+  constexpr size_t kSize = 1200;
+  std::vector<void*> blocks;
+  for (int round = 0; round < 10; ++round) {
+    std::thread allocator([&blocks] {
+      for (int i = 0; i < 1000; ++i) {
+        void* block = BufferPool::Allocate(kSize);
+        memset(block, i & 0xff, kSize);
+        blocks.push_back(block);
+      }
+    });
+    allocator.join();
+    for (void* block : blocks)
+      BufferPool::Free(block, kSize);
+    blocks.clear();
+  }
+}
+
+TEST(BufferPoolTest, DISABLED_CopyOnWriteBufferAllocationPerf) {
+  static constexpr int kNumBuffers = 10000000;
+  const uint8_t payload[1200] = {};
+  const BufferPool::Stats before = BufferPool::GetStats();
+  int64_t start_us = TimeMicros();
+  for (int i = 0; i < kNumBuffers; ++i) {
+    CopyOnWriteBuffer buffer(payload, sizeof(payload), 1500);
+    CopyOnWriteBuffer copy = buffer;
+    copy.AppendData(payload, 100);
+  }
+  int64_t elapsed_us = TimeMicros() - start_us;
+  const BufferPool::Stats after = BufferPool::GetStats();
+  RTC_LOG(LS_INFO) << kNumBuffers << " buffers in " << elapsed_us
+                   << " us, "
+                   << after.allocations - before.allocations
+                   << " allocations, "
+                   << after.heap_allocations - before.heap_allocations
+                   << " from the heap.";
+}
+
+}  // namespace
+}  // namespace rtc
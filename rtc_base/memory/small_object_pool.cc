@@ -0,0 +1,183 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/small_object_pool.h"
+
+#include <vector>
+
+#include "absl/base/attributes.h"
+#include "absl/base/config.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+// Pooled blocks would hide use-after-free bugs from the sanitizers.
+#if defined(ABSL_HAVE_THREAD_LOCAL) && !defined(ADDRESS_SANITIZER) && \
+    !defined(MEMORY_SANITIZER)
+#define RTC_SMALL_OBJECT_POOL_ENABLED 1
+#else
+#define RTC_SMALL_OBJECT_POOL_ENABLED 0
+#endif
+
+namespace rtc {
+
+#if RTC_SMALL_OBJECT_POOL_ENABLED
+
+namespace {
+
+// Block sizes are 32, 64, 128 and 256 bytes.
+constexpr size_t kMinBlockSize = 32;
+constexpr int kNumSizeClasses = 4;
+// Number of blocks moved between a thread cache and the depot at a time. A
+// thread cache holds up to twice as many blocks per size class.
+constexpr int kBatchSize = 64;
+// Number of batches per size class the depot holds on to before freeing
+// blocks instead.
+constexpr size_t kMaxDepotBatches = 32;
+
+struct FreeBlock {
+  FreeBlock* next;
+};
+
+int SizeClass(size_t size) {
+  int size_class = 0;
+  size_t block_size = kMinBlockSize;
+  while (block_size < size) {
+    block_size *= 2;
+    ++size_class;
+  }
+  return size_class;
+}
+
+size_t BlockSize(int size_class) {
+  return kMinBlockSize << size_class;
+}
+
+void FreeChain(FreeBlock* head) {
+  while (head) {
+    FreeBlock* next = head->next;
+    ::operator delete(head);
+    head = next;
+  }
+}
+
+// Batches of |kBatchSize| free blocks shared by all threads.
+class Depot {
+ public:
+  // Returns null if the depot has no batch of this size class.
+  FreeBlock* Take(int size_class) {
+    CritScope lock(&lock_);
+    std::vector<FreeBlock*>& batches = batches_[size_class];
+    if (batches.empty())
+      return nullptr;
+    FreeBlock* batch = batches.back();
+    batches.pop_back();
+    return batch;
+  }
+
+  void Give(int size_class, FreeBlock* batch) {
+    {
+      CritScope lock(&lock_);
+      std::vector<FreeBlock*>& batches = batches_[size_class];
+      if (batches.size() < kMaxDepotBatches) {
+        batches.push_back(batch);
+        return;
+      }
+    }
+    FreeChain(batch);
+  }
+
+ private:
+  CriticalSection lock_;
+  std::vector<FreeBlock*> batches_[kNumSizeClasses] RTC_GUARDED_BY(lock_);
+};
+
+Depot* GetDepot() {
+  // Never destroyed, so that threads exiting during static destruction can
+  // still return their blocks.
+  static Depot* const depot = new Depot();
+  return depot;
+}
+
+class ThreadCache {
+ public:
+  ~ThreadCache() {
+    for (int size_class = 0; size_class < kNumSizeClasses; ++size_class)
+      FreeChain(free_[size_class]);
+  }
+
+  void* Allocate(int size_class) {
+    if (!free_[size_class]) {
+      free_[size_class] = GetDepot()->Take(size_class);
+      if (!free_[size_class])
+        return ::operator new(BlockSize(size_class));
+      count_[size_class] = kBatchSize;
+    }
+    FreeBlock* block = free_[size_class];
+    free_[size_class] = block->next;
+    --count_[size_class];
+    return block;
+  }
+
+  void Free(void* ptr, int size_class) {
+    if (count_[size_class] == 2 * kBatchSize) {
+      // Hand the oldest blocks over to the depot, keeping a batch's worth
+      // for this thread so that alternating allocations and frees don't go
+      // to the depot every time.
+      FreeBlock* last_kept = free_[size_class];
+      for (int i = 1; i < kBatchSize; ++i)
+        last_kept = last_kept->next;
+      GetDepot()->Give(size_class, last_kept->next);
+      last_kept->next = nullptr;
+      count_[size_class] = kBatchSize;
+    }
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = free_[size_class];
+    free_[size_class] = block;
+    ++count_[size_class];
+  }
+
+ private:
+  FreeBlock* free_[kNumSizeClasses] = {};
+  int count_[kNumSizeClasses] = {};
+};
+
+thread_local ThreadCache thread_cache;
+
+}  // namespace
+
+void* SmallObjectPool::Allocate(size_t size) {
+  if (size > kMaxSize)
+    return ::operator new(size);
+  return thread_cache.Allocate(SizeClass(size));
+}
+
+void SmallObjectPool::Free(void* ptr, size_t size) {
+  if (!ptr)
+    return;
+  if (size > kMaxSize) {
+    ::operator delete(ptr);
+    return;
+  }
+  thread_cache.Free(ptr, SizeClass(size));
+}
+
+#else  // RTC_SMALL_OBJECT_POOL_ENABLED
+
+void* SmallObjectPool::Allocate(size_t size) {
+  return ::operator new(size);
+}
+
+void SmallObjectPool::Free(void* ptr, size_t size) {
+  ::operator delete(ptr);
+}
+
+#endif  // RTC_SMALL_OBJECT_POOL_ENABLED
+
+}  // namespace rtc
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_MEMORY_SMALL_OBJECT_POOL_H_
+#define RTC_BASE_MEMORY_SMALL_OBJECT_POOL_H_
+
+#include <stddef.h>
+
+#include <new>
+
+namespace rtc {
+
+// Allocator for the small, short lived objects that are created for every
+// task or message posted to another thread, e.g. closures and message list
+// nodes. Freed blocks are cached per thread, and batches of them are handed
+// over between threads through a shared depot, so that the common pattern of
+// allocating on one thread and freeing on another rarely reaches malloc.
+// Blocks larger than |kMaxSize| bytes are allocated with operator new.
+class SmallObjectPool {
+ public:
+  static constexpr size_t kMaxSize = 256;
+
+  static void* Allocate(size_t size);
+  // |size| must be the size that was passed to Allocate().
+  static void Free(void* ptr, size_t size);
+};
+
+// Standard allocator backed by SmallObjectPool, for node based containers.
+template <typename T>
+class SmallObjectAllocator {
+ public:
+  using value_type = T;
+
+  SmallObjectAllocator() = default;
+  template <typename U>
+  SmallObjectAllocator(const SmallObjectAllocator<U>&) {}  // NOLINT
+
+  T* allocate(size_t n) {
+    return static_cast<T*>(SmallObjectPool::Allocate(n * sizeof(T)));
+  }
+  void deallocate(T* ptr, size_t n) {
+    SmallObjectPool::Free(ptr, n * sizeof(T));
+  }
+
+  template <typename U>
+  bool operator==(const SmallObjectAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const SmallObjectAllocator<U>&) const {
+    return false;
+  }
+};
+
+// Base class that makes a class, and classes derived from it, allocate from
+// SmallObjectPool. Deleting through a pointer to a base class requires a
+// virtual destructor, which makes the sized operator delete get the size of
+// the most derived class.
+class SmallObject {
+ public:
+  static void* operator new(size_t size) {
+    return SmallObjectPool::Allocate(size);
+  }
+  static void operator delete(void* ptr, size_t size) {
+    SmallObjectPool::Free(ptr, size);
+  }
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_MEMORY_SMALL_OBJECT_POOL_H_
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/memory/small_object_pool.h"
+
+#include <string.h>
+
+#include <list>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+class Base {
+ public:
+  virtual ~Base() = default;
+};
+
+class Derived : public Base, public SmallObject {
+ public:
+  explicit Derived(int* destroyed) : destroyed_(destroyed) {
+    memset(payload_, 0, sizeof(payload_));
+  }
+  ~Derived() override { ++*destroyed_; }
+
+ private:
+  int* const destroyed_;
+  char payload_[100];
+};
+
+TEST(SmallObjectPoolTest, BlocksAreUsableAndDistinct) {
+  for (size_t size : {1, 32, 33, 100, 256, 257, 4096}) {
+    std::vector<void*> blocks;
+    std::set<void*> distinct;
+    for (int i = 0; i < 1000; ++i) {
+      void* block = SmallObjectPool::Allocate(size);
+      memset(block, i & 0xff, size);
+      blocks.push_back(block);
+      distinct.insert(block);
+    }
+    EXPECT_EQ(blocks.size(), distinct.size());
+    for (void* block : blocks)
+      SmallObjectPool::Free(block, size);
+  }
+}
+
+TEST(SmallObjectPoolTest, DeletesDerivedThroughBase) {
+  int destroyed = 0;
+  std::vector<std::unique_ptr<Base>> objects;
+  for (int i = 0; i < 500; ++i)
+    objects.push_back(std::make_unique<Derived>(&destroyed));
+  objects.clear();
+  EXPECT_EQ(500, destroyed);
+}
+
+TEST(SmallObjectPoolTest, WorksAsListAllocator) {
+  std::list<int, SmallObjectAllocator<int>> list;
+  for (int i = 0; i < 1000; ++i)
+    list.push_back(i);
+  int expected = 0;
+  for (int value : list)
+    EXPECT_EQ(expected++, value);
+  list.clear();
+}
+
+}  // namespace
+}  // namespace rtc
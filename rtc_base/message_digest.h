@@ -43,6 +43,12 @@ class MessageDigest {
 class MessageDigestFactory {
  public:
   static MessageDigest* Create(const std::string& alg);
+  // Creates an RFC 2104 HMAC keyed with |key_len| bytes of |key|. Finish()
+  // outputs the HMAC of the input since the previous Finish(), so many inputs
+  // can be authenticated without setting up the key again for each.
+  static MessageDigest* CreateHmac(const std::string& alg,
+                                   const void* key,
+                                   size_t key_len);
 };
 
 // A whitelist of approved digest algorithms from RFC 4572 (FIPS 180).
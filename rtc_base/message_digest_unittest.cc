@@ -10,6 +10,8 @@
 
 #include "rtc_base/message_digest.h"
 
+#include <memory>
+
 #include "rtc_base/string_encode.h"
 #include "test/gtest.h"
 
@@ -146,6 +148,29 @@ TEST(MessageDigestTest, TestSha1Hmac) {
                         input.size(), output, sizeof(output) - 1));
 }
 
+// Test vectors from RFC 2202.
+TEST(MessageDigestTest, TestSha1KeyedHmac) {
+  std::string key(80, '\xaa');
+  std::unique_ptr<MessageDigest> hmac(
+      MessageDigestFactory::CreateHmac(DIGEST_SHA_1, key.data(), key.size()));
+  ASSERT_TRUE(hmac);
+  EXPECT_EQ(20U, hmac->Size());
+  // The key is reused for each input, also when it is split into updates.
+  EXPECT_EQ("aa4ae5e15272d00e95705637ce8a3b55ed402112",
+            ComputeDigest(
+                hmac.get(),
+                "Test Using Larger Than Block-Size Key - Hash Key First"));
+  hmac->Update("Test Using Larger Than Block-Size Key and Larger ", 49);
+  hmac->Update("Than One Block-Size Data", 24);
+  char output[20];
+  EXPECT_EQ(sizeof(output), hmac->Finish(output, sizeof(output)));
+  EXPECT_EQ("e8e99d0f45237d786d6bbaa7965c7808bbff1a91",
+            hex_encode(output, sizeof(output)));
+  EXPECT_EQ(0U, hmac->Finish(output, sizeof(output) - 1));
+
+  EXPECT_FALSE(MessageDigestFactory::CreateHmac("sha-9000", "key", 3));
+}
+
 TEST(MessageDigestTest, TestBadHmac) {
   std::string output;
   EXPECT_FALSE(ComputeHmac("sha-9000", "key", "abc", &output));
@@ -13,6 +13,7 @@
 #include <utility>
 
 #include "absl/algorithm/container.h"
+#include "absl/types/optional.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
@@ -154,6 +155,7 @@ MessageQueue::MessageQueue(SocketServer* ss, bool init_queue)
       dmsgq_next_num_(0),
       fInitialized_(false),
       fDestroyed_(false),
+      stats_("MessageQueue"),
       stop_(0),
       ss_(ss) {
   RTC_DCHECK(ss);
@@ -369,6 +371,8 @@ void MessageQueue::Post(const Location& posted_from,
     if (time_sensitive) {
       msg.ts_sensitive = TimeMillis() + kMaxMsgLatency;
     }
+    if (QueueStatsCollector::IsEnabled())
+      msg.ready_us = TimeMicros();
     msgq_.push_back(msg);
   }
   WakeUpSocketServer();
@@ -424,6 +428,8 @@ void MessageQueue::DoDelayPost(const Location& posted_from,
     msg.phandler = phandler;
     msg.message_id = id;
     msg.pdata = pdata;
+    if (QueueStatsCollector::IsEnabled())
+      msg.ready_us = TimeMicros() + cmsDelay * kNumMicrosecsPerMillisec;
     DelayedMessage dmsg(cmsDelay, tstamp, dmsgq_next_num_, msg);
     dmsgq_.push(dmsg);
     // If this message queue processes 1 message every millisecond for 50 days,
@@ -510,6 +516,9 @@ void MessageQueue::Dispatch(Message* pmsg) {
   TRACE_EVENT2("webrtc", "MessageQueue::Dispatch", "src_file_and_line",
                pmsg->posted_from.file_and_line(), "src_func",
                pmsg->posted_from.function_name());
+  absl::optional<QueueStatsCollector::ScopedTask> stats_scope;
+  if (QueueStatsCollector::IsEnabled())
+    stats_scope.emplace(&stats_, pmsg->posted_from, pmsg->ready_us);
   int64_t start_time = TimeMillis();
   pmsg->phandler->OnMessage(pmsg);
   int64_t end_time = TimeMillis();
@@ -23,7 +23,9 @@
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/location.h"
+#include "rtc_base/memory/small_object_pool.h"
 #include "rtc_base/message_handler.h"
+#include "rtc_base/queue_stats.h"
 #include "rtc_base/socket_server.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread_annotations.h"
@@ -152,7 +154,11 @@ const uint32_t MQID_DISPOSE = static_cast<uint32_t>(-2);
 
 struct Message {
   Message()
-      : phandler(nullptr), message_id(0), pdata(nullptr), ts_sensitive(0) {}
+      : phandler(nullptr),
+        message_id(0),
+        pdata(nullptr),
+        ts_sensitive(0),
+        ready_us(-1) {}
   inline bool Match(MessageHandler* handler, uint32_t id) const {
     return (handler == nullptr || handler == phandler) &&
            (id == MQID_ANY || id == message_id);
@@ -162,9 +168,13 @@ struct Message {
   uint32_t message_id;
   MessageData* pdata;
   int64_t ts_sensitive;
+  // TimeMicros() at which the message could first be dispatched, if queue
+  // stats were enabled when it was posted, or -1.
+  int64_t ready_us;
 };
 
-typedef std::list<Message> MessageList;
+// List nodes come from SmallObjectPool, as one is allocated per post.
+typedef std::list<Message, SmallObjectAllocator<Message>> MessageList;
 
 // DelayedMessage goes into a priority queue, sorted by trigger time.  Messages
 // with the same trigger time are processed in num_ (FIFO) order.
@@ -266,6 +276,9 @@ class MessageQueue {
     return msgq_.size() + dmsgq_.size() + (fPeekKeep_ ? 1u : 0u);
   }
 
+  // Load of this queue, see QueueStatsCollector.
+  QueueStats GetQueueStats() const { return stats_.GetStats(); }
+
   // Internally posts a message which causes the doomed object to be deleted
   template <class T>
   void Dispose(T* doomed) {
@@ -316,6 +329,7 @@ class MessageQueue {
   CriticalSection crit_;
   bool fInitialized_;
   bool fDestroyed_;
+  QueueStatsCollector stats_;
 
  private:
   volatile int stop_;
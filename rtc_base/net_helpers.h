@@ -17,6 +17,7 @@
 #include <winsock2.h>  // NOLINT
 #endif
 
+#include <string>
 #include <vector>
 
 #include "rtc_base/async_resolver_interface.h"
@@ -51,6 +52,13 @@ class AsyncResolver : public SignalThread, public AsyncResolverInterface {
   int error_;
 };
 
+// Resolves |hostname| with getaddrinfo(), blocking until it is done. Returns
+// 0 and the addresses of |family|, or of any family for AF_UNSPEC, on success,
+// or the getaddrinfo() error.
+int ResolveHostname(const std::string& hostname,
+                    int family,
+                    std::vector<IPAddress>* addresses);
+
 // rtc namespaced wrappers for inet_ntop and inet_pton so we can avoid
 // the windows-native versions of these.
 const char* inet_ntop(int af, const void* src, char* dst, socklen_t size);
@@ -0,0 +1,214 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/netlink_network_monitor.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+
+namespace {
+
+// Notifications that arrive within this time of the first one are reported
+// together.
+constexpr int kCoalescingDelayMs = 100;
+// Large enough for the notifications of a few dozen address changes.
+constexpr size_t kReceiveBufferSize = 16 * 1024;
+// The link flags whose changes are reported.
+constexpr unsigned int kRelevantLinkFlags = IFF_UP | IFF_RUNNING;
+
+}  // namespace
+
+NetlinkNetworkMonitor::NetlinkNetworkMonitor() = default;
+
+NetlinkNetworkMonitor::~NetlinkNetworkMonitor() {
+  Stop();
+}
+
+void NetlinkNetworkMonitor::Start() {
+  if (thread_)
+    return;
+
+  netlink_fd_ = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (netlink_fd_ < 0) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to create netlink socket";
+    return;
+  }
+  sockaddr_nl address = {};
+  address.nl_family = AF_NETLINK;
+  address.nl_groups = RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR;
+  if (bind(netlink_fd_, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) < 0 ||
+      pipe2(wakeup_fds_, O_CLOEXEC) < 0) {
+    RTC_LOG_ERR(LS_WARNING) << "Failed to set up netlink monitoring";
+    Stop();
+    return;
+  }
+
+  thread_.reset(new PlatformThread(&NetlinkNetworkMonitor::ListenThread, this,
+                                   "NetlinkMonitor"));
+  thread_->Start();
+  RTC_LOG(LS_INFO) << "Started netlink network monitor";
+}
+
+void NetlinkNetworkMonitor::Stop() {
+  if (thread_) {
+    char wakeup = 0;
+    if (write(wakeup_fds_[1], &wakeup, 1) != 1) {
+      RTC_LOG_ERR(LS_ERROR) << "Failed to wake up netlink monitor thread";
+    }
+    thread_->Stop();
+    thread_.reset();
+  }
+  for (int* fd : {&netlink_fd_, &wakeup_fds_[0], &wakeup_fds_[1]}) {
+    if (*fd >= 0) {
+      close(*fd);
+      *fd = -1;
+    }
+  }
+  link_flags_.clear();
+}
+
+AdapterType NetlinkNetworkMonitor::GetAdapterType(
+    const std::string& interface_name) {
+  // Netlink doesn't tell the type of the adapter; the network manager falls
+  // back to its interface name rules.
+  return ADAPTER_TYPE_UNKNOWN;
+}
+
+bool NetlinkNetworkMonitor::ReportsAllNetworkChanges() const {
+  return thread_ != nullptr;
+}
+
+// static
+bool NetlinkNetworkMonitor::ParseNetworkChanges(
+    const uint8_t* data,
+    size_t size,
+    std::map<int, unsigned int>* link_flags) {
+  bool changed = false;
+  // The NLMSG macros don't take const pointers.
+  nlmsghdr* header = reinterpret_cast<nlmsghdr*>(const_cast<uint8_t*>(data));
+  int remaining = static_cast<int>(size);
+  for (; NLMSG_OK(header, remaining); header = NLMSG_NEXT(header, remaining)) {
+    switch (header->nlmsg_type) {
+      case RTM_NEWLINK: {
+        if (header->nlmsg_len < NLMSG_LENGTH(sizeof(ifinfomsg)))
+          break;
+        const ifinfomsg* info =
+            reinterpret_cast<const ifinfomsg*>(NLMSG_DATA(header));
+        const unsigned int flags = info->ifi_flags & kRelevantLinkFlags;
+        auto it = link_flags->find(info->ifi_index);
+        if (it == link_flags->end() || it->second != flags) {
+          (*link_flags)[info->ifi_index] = flags;
+          changed = true;
+        }
+        break;
+      }
+      case RTM_DELLINK: {
+        if (header->nlmsg_len < NLMSG_LENGTH(sizeof(ifinfomsg)))
+          break;
+        const ifinfomsg* info =
+            reinterpret_cast<const ifinfomsg*>(NLMSG_DATA(header));
+        link_flags->erase(info->ifi_index);
+        changed = true;
+        break;
+      }
+      case RTM_NEWADDR:
+      case RTM_DELADDR:
+        changed = true;
+        break;
+      default:
+        break;
+    }
+  }
+  return changed;
+}
+
+// static
+void NetlinkNetworkMonitor::ListenThread(void* obj) {
+  static_cast<NetlinkNetworkMonitor*>(obj)->Listen();
+}
+
+void NetlinkNetworkMonitor::Listen() {
+  pollfd fds[2] = {{netlink_fd_, POLLIN, 0}, {wakeup_fds_[0], POLLIN, 0}};
+  // The time at which the pending changes are reported, or -1 if there are
+  // none.
+  int64_t report_time_ms = -1;
+  while (true) {
+    int timeout_ms = -1;
+    if (report_time_ms >= 0) {
+      timeout_ms = static_cast<int>(
+          std::max<int64_t>(0, report_time_ms - TimeMillis()));
+    }
+    int result = poll(fds, 2, timeout_ms);
+    if (result < 0) {
+      if (errno == EINTR)
+        continue;
+      RTC_LOG_ERR(LS_ERROR) << "Failed to poll netlink socket";
+      return;
+    }
+    if (fds[1].revents)
+      return;
+    if ((fds[0].revents & POLLIN) && ReadNotifications() &&
+        report_time_ms < 0) {
+      report_time_ms = TimeMillis() + kCoalescingDelayMs;
+    }
+    if (report_time_ms >= 0 && TimeMillis() >= report_time_ms) {
+      report_time_ms = -1;
+      OnNetworksChanged();
+    }
+  }
+}
+
+bool NetlinkNetworkMonitor::ReadNotifications() {
+  uint8_t buffer[kReceiveBufferSize];
+  bool changed = false;
+  while (true) {
+    ssize_t received = recv(netlink_fd_, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (received < 0) {
+      if (errno == EINTR)
+        continue;
+      if (errno == ENOBUFS) {
+        // The kernel dropped notifications, so the interfaces must be
+        // rescanned.
+        RTC_LOG(LS_WARNING) << "Netlink notifications were lost";
+        changed = true;
+        continue;
+      }
+      if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        RTC_LOG_ERR(LS_ERROR) << "Failed to read netlink socket";
+      }
+      return changed;
+    }
+    changed |= ParseNetworkChanges(buffer, received, &link_flags_);
+  }
+}
+
+NetlinkNetworkMonitorFactory::NetlinkNetworkMonitorFactory() = default;
+NetlinkNetworkMonitorFactory::~NetlinkNetworkMonitorFactory() = default;
+
+NetworkMonitorInterface* NetlinkNetworkMonitorFactory::CreateNetworkMonitor() {
+  return new NetlinkNetworkMonitor();
+}
+
+}  // namespace rtc
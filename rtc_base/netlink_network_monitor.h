@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETLINK_NETWORK_MONITOR_H_
+#define RTC_BASE_NETLINK_NETWORK_MONITOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "rtc_base/network_monitor.h"
+#include "rtc_base/platform_thread.h"
+
+namespace rtc {
+
+// A network monitor for Linux that listens to the rtnetlink link and address
+// notifications of the kernel instead of polling. Bursts of notifications,
+// e.g. when an interface comes up with several addresses, are coalesced into
+// a single OnNetworksChanged(). Link notifications that don't change whether
+// an interface is up, such as the periodic statistics updates, are ignored.
+//
+// While it is started, the monitor reports every change of the interfaces, so
+// BasicNetworkManager stops scanning the interfaces periodically and only
+// rescans them when the monitor fires. Install it with
+//   NetworkMonitorFactory::SetFactory(new NetlinkNetworkMonitorFactory());
+class NetlinkNetworkMonitor : public NetworkMonitorBase {
+ public:
+  NetlinkNetworkMonitor();
+  ~NetlinkNetworkMonitor() override;
+
+  // NetworkMonitorInterface:
+  void Start() override;
+  void Stop() override;
+  AdapterType GetAdapterType(const std::string& interface_name) override;
+  bool ReportsAllNetworkChanges() const override;
+
+  // Parses the rtnetlink messages in |data| and returns true if any of them
+  // adds or removes an address, adds or removes an interface, or brings an
+  // interface up or down. |link_flags| holds the last seen flags per
+  // interface index and is updated. Exposed for testing.
+  static bool ParseNetworkChanges(const uint8_t* data,
+                                  size_t size,
+                                  std::map<int, unsigned int>* link_flags);
+
+ private:
+  static void ListenThread(void* obj);
+  void Listen();
+  // Reads all pending notifications. Returns true if any of them is a network
+  // change.
+  bool ReadNotifications();
+
+  int netlink_fd_ = -1;
+  // Written to by Stop() to wake up the listening thread.
+  int wakeup_fds_[2] = {-1, -1};
+  // Only accessed on the listening thread.
+  std::map<int, unsigned int> link_flags_;
+  std::unique_ptr<PlatformThread> thread_;
+};
+
+class NetlinkNetworkMonitorFactory : public NetworkMonitorFactory {
+ public:
+  NetlinkNetworkMonitorFactory();
+  ~NetlinkNetworkMonitorFactory() override;
+
+  NetworkMonitorInterface* CreateNetworkMonitor() override;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETLINK_NETWORK_MONITOR_H_
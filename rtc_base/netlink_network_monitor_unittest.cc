@@ -0,0 +1,111 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/netlink_network_monitor.h"
+
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <string.h>
+
+#include <map>
+#include <vector>
+
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+// Appends a link message for |index| with |flags| to |buffer|.
+void AppendLinkMessage(uint16_t type,
+                       int index,
+                       unsigned int flags,
+                       std::vector<uint8_t>* buffer) {
+  const size_t offset = buffer->size();
+  buffer->resize(offset + NLMSG_SPACE(sizeof(ifinfomsg)));
+  nlmsghdr* header = reinterpret_cast<nlmsghdr*>(buffer->data() + offset);
+  header->nlmsg_len = NLMSG_LENGTH(sizeof(ifinfomsg));
+  header->nlmsg_type = type;
+  ifinfomsg* info = reinterpret_cast<ifinfomsg*>(NLMSG_DATA(header));
+  info->ifi_index = index;
+  info->ifi_flags = flags;
+}
+
+void AppendAddressMessage(uint16_t type, std::vector<uint8_t>* buffer) {
+  const size_t offset = buffer->size();
+  buffer->resize(offset + NLMSG_SPACE(sizeof(ifaddrmsg)));
+  nlmsghdr* header = reinterpret_cast<nlmsghdr*>(buffer->data() + offset);
+  header->nlmsg_len = NLMSG_LENGTH(sizeof(ifaddrmsg));
+  header->nlmsg_type = type;
+}
+
+bool ParseNetworkChanges(const std::vector<uint8_t>& buffer,
+                         std::map<int, unsigned int>* link_flags) {
+  return NetlinkNetworkMonitor::ParseNetworkChanges(
+      buffer.data(), buffer.size(), link_flags);
+}
+
+}  // namespace
+
+TEST(NetlinkNetworkMonitorTest, ReportsLinkUpAndDown) {
+  std::map<int, unsigned int> link_flags;
+  std::vector<uint8_t> buffer;
+  AppendLinkMessage(RTM_NEWLINK, 2, IFF_UP | IFF_RUNNING, &buffer);
+  EXPECT_TRUE(ParseNetworkChanges(buffer, &link_flags));
+  // The same state again, e.g. an MTU or statistics update, is no change.
+  EXPECT_FALSE(ParseNetworkChanges(buffer, &link_flags));
+
+  buffer.clear();
+  AppendLinkMessage(RTM_NEWLINK, 2, IFF_UP | IFF_MULTICAST, &buffer);
+  EXPECT_TRUE(ParseNetworkChanges(buffer, &link_flags));
+
+  buffer.clear();
+  AppendLinkMessage(RTM_DELLINK, 2, 0, &buffer);
+  EXPECT_TRUE(ParseNetworkChanges(buffer, &link_flags));
+  EXPECT_TRUE(link_flags.empty());
+}
+
+TEST(NetlinkNetworkMonitorTest, ReportsAddressChanges) {
+  std::map<int, unsigned int> link_flags;
+  std::vector<uint8_t> buffer;
+  AppendLinkMessage(RTM_NEWLINK, 3, IFF_UP, &buffer);
+  ASSERT_TRUE(ParseNetworkChanges(buffer, &link_flags));
+
+  // An address change in a batch with unchanged links is reported.
+  AppendAddressMessage(RTM_NEWADDR, &buffer);
+  EXPECT_TRUE(ParseNetworkChanges(buffer, &link_flags));
+
+  buffer.clear();
+  AppendAddressMessage(RTM_DELADDR, &buffer);
+  EXPECT_TRUE(ParseNetworkChanges(buffer, &link_flags));
+
+  buffer.clear();
+  AppendAddressMessage(RTM_GETADDR, &buffer);
+  EXPECT_FALSE(ParseNetworkChanges(buffer, &link_flags));
+}
+
+TEST(NetlinkNetworkMonitorTest, ReportsAllChangesWhileStarted) {
+  AutoThread thread;
+  NetlinkNetworkMonitor monitor;
+  EXPECT_FALSE(monitor.ReportsAllNetworkChanges());
+  monitor.Start();
+  // Netlink sockets may be unavailable in sandboxes, in which case the
+  // monitor doesn't start and the network manager keeps polling.
+  if (monitor.ReportsAllNetworkChanges()) {
+    monitor.Stop();
+    EXPECT_FALSE(monitor.ReportsAllNetworkChanges());
+    // Restarting works.
+    monitor.Start();
+    EXPECT_TRUE(monitor.ReportsAllNetworkChanges());
+  }
+}
+
+}  // namespace rtc
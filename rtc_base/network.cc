@@ -888,7 +888,13 @@ void BasicNetworkManager::StopNetworkMonitor() {
 void BasicNetworkManager::OnMessage(Message* msg) {
   switch (msg->message_id) {
     case kUpdateNetworksMessage: {
-      UpdateNetworksContinually();
+      // When the network monitor reports all changes, the networks are only
+      // updated when it fires.
+      if (network_monitor_ && network_monitor_->ReportsAllNetworkChanges()) {
+        UpdateNetworksOnce();
+      } else {
+        UpdateNetworksContinually();
+      }
       break;
     }
     case kSignalNetworksMessage: {
@@ -0,0 +1,35 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_NETWORK_ECN_MARKING_H_
+#define RTC_BASE_NETWORK_ECN_MARKING_H_
+
+#include <stdint.h>
+
+namespace rtc {
+
+// The Explicit Congestion Notification field of a received IP packet, i.e.
+// the two lowest bits of the IPv4 TOS or IPv6 traffic class byte, see
+// RFC 3168. Routers mark packets that they would otherwise have dropped as
+// kCe, but only if the sender marked them as ECN capable (kEct0 or kEct1).
+enum class EcnMarking : uint8_t {
+  kNotEct = 0,
+  kEct1 = 1,
+  kEct0 = 2,
+  kCe = 3,
+};
+
+inline EcnMarking EcnMarkingFromTos(int tos) {
+  return static_cast<EcnMarking>(tos & 0x3);
+}
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_NETWORK_ECN_MARKING_H_
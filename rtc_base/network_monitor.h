@@ -75,6 +75,11 @@ class NetworkMonitorInterface {
   virtual AdapterType GetAdapterType(const std::string& interface_name) = 0;
   virtual AdapterType GetVpnUnderlyingAdapterType(
       const std::string& interface_name) = 0;
+
+  // Returns true if every change of the interfaces and their addresses fires
+  // SignalNetworksChanged, so that the network manager doesn't need to poll
+  // for changes.
+  virtual bool ReportsAllNetworkChanges() const { return false; }
 };
 
 class NetworkMonitorBase : public NetworkMonitorInterface,
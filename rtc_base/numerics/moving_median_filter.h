@@ -13,7 +13,7 @@
 
 #include <stddef.h>
 
-#include <list>
+#include <vector>
 
 #include "rtc_base/checks.h"
 #include "rtc_base/constructor_magic.h"
@@ -40,7 +40,10 @@ class MovingMedianFilter {
 
  private:
   PercentileFilter<T> percentile_filter_;
-  std::list<T> samples_;
+  // Ring buffer of the latest |samples_stored_| samples, the oldest one being
+  // at |oldest_index_|.
+  std::vector<T> samples_;
+  size_t oldest_index_;
   size_t samples_stored_;
   const size_t window_size_;
 
@@ -49,20 +52,27 @@ class MovingMedianFilter {
 
 template <typename T>
 MovingMedianFilter<T>::MovingMedianFilter(size_t window_size)
-    : percentile_filter_(0.5f), samples_stored_(0), window_size_(window_size) {
+    : percentile_filter_(0.5f),
+      oldest_index_(0),
+      samples_stored_(0),
+      window_size_(window_size) {
   RTC_CHECK_GT(window_size, 0);
+  samples_.reserve(window_size_);
 }
 
 template <typename T>
 void MovingMedianFilter<T>::Insert(const T& value) {
   percentile_filter_.Insert(value);
-  samples_.emplace_back(value);
-  ++samples_stored_;
-  if (samples_stored_ > window_size_) {
-    percentile_filter_.Erase(samples_.front());
-    samples_.pop_front();
-    --samples_stored_;
+  if (samples_stored_ < window_size_) {
+    samples_.push_back(value);
+    ++samples_stored_;
+    return;
   }
+  // The window is full, the new sample replaces the oldest one.
+  percentile_filter_.Erase(samples_[oldest_index_]);
+  samples_[oldest_index_] = value;
+  if (++oldest_index_ == window_size_)
+    oldest_index_ = 0;
 }
 
 template <typename T>
@@ -74,6 +84,7 @@ template <typename T>
 void MovingMedianFilter<T>::Reset() {
   percentile_filter_.Reset();
   samples_.clear();
+  oldest_index_ = 0;
   samples_stored_ = 0;
 }
 
@@ -11,10 +11,10 @@
 #ifndef RTC_BASE_NUMERICS_PERCENTILE_FILTER_H_
 #define RTC_BASE_NUMERICS_PERCENTILE_FILTER_H_
 
-#include <stdint.h>
+#include <stddef.h>
 
-#include <iterator>
-#include <set>
+#include <algorithm>
+#include <vector>
 
 #include "rtc_base/checks.h"
 
@@ -23,6 +23,11 @@ namespace webrtc {
 // Class to efficiently get the percentile value from a group of observations.
 // The percentile is the value below which a given percentage of the
 // observations fall.
+//
+// The observations are kept sorted in a vector. For the window sizes used in
+// practice, up to a few hundred observations, moving the elements after the
+// insertion point is cheaper than allocating and rebalancing a tree node, and
+// once the vector has grown to the window size no more memory is allocated.
 template <typename T>
 class PercentileFilter {
  public:
@@ -30,12 +35,14 @@ class PercentileFilter {
   explicit PercentileFilter(float percentile);
 
   // Insert one observation. The complexity of this operation is logarithmic in
-  // the size of the container.
+  // the size of the container for the search, plus a linear move of the
+  // larger observations.
   void Insert(const T& value);
 
   // Remove one observation or return false if |value| doesn't exist in the
   // container. The complexity of this operation is logarithmic in the size of
-  // the container.
+  // the container for the search, plus a linear move of the larger
+  // observations.
   bool Erase(const T& value);
 
   // Get the percentile value. The complexity of this operation is constant.
@@ -45,21 +52,14 @@ class PercentileFilter {
   void Reset();
 
  private:
-  // Update iterator and index to point at target percentile value.
-  void UpdatePercentileIterator();
-
   const float percentile_;
-  std::multiset<T> set_;
-  // Maintain iterator and index of current target percentile value.
-  typename std::multiset<T>::iterator percentile_it_;
-  int64_t percentile_index_;
+  // All observations, in ascending order.
+  std::vector<T> sorted_values_;
 };
 
 template <typename T>
 PercentileFilter<T>::PercentileFilter(float percentile)
-    : percentile_(percentile),
-      percentile_it_(set_.begin()),
-      percentile_index_(0) {
+    : percentile_(percentile) {
   RTC_CHECK_GE(percentile, 0.0f);
   RTC_CHECK_LE(percentile, 1.0f);
 }
@@ -67,57 +67,35 @@ PercentileFilter<T>::PercentileFilter(float percentile)
 template <typename T>
 void PercentileFilter<T>::Insert(const T& value) {
   // Insert element at the upper bound.
-  set_.insert(value);
-  if (set_.size() == 1u) {
-    // First element inserted - initialize percentile iterator and index.
-    percentile_it_ = set_.begin();
-    percentile_index_ = 0;
-  } else if (value < *percentile_it_) {
-    // If new element is before us, increment |percentile_index_|.
-    ++percentile_index_;
-  }
-  UpdatePercentileIterator();
+  sorted_values_.insert(
+      std::upper_bound(sorted_values_.begin(), sorted_values_.end(), value),
+      value);
 }
 
 template <typename T>
 bool PercentileFilter<T>::Erase(const T& value) {
-  typename std::multiset<T>::const_iterator it = set_.lower_bound(value);
+  auto it =
+      std::lower_bound(sorted_values_.begin(), sorted_values_.end(), value);
   // Ignore erase operation if the element is not present in the current set.
-  if (it == set_.end() || *it != value)
+  if (it == sorted_values_.end() || *it != value)
     return false;
-  if (it == percentile_it_) {
-    // If same iterator, update to the following element. Index is not
-    // affected.
-    percentile_it_ = set_.erase(it);
-  } else {
-    set_.erase(it);
-    // If erased element was before us, decrement |percentile_index_|.
-    if (value <= *percentile_it_)
-      --percentile_index_;
-  }
-  UpdatePercentileIterator();
+  sorted_values_.erase(it);
   return true;
 }
 
-template <typename T>
-void PercentileFilter<T>::UpdatePercentileIterator() {
-  if (set_.empty())
-    return;
-  const int64_t index = static_cast<int64_t>(percentile_ * (set_.size() - 1));
-  std::advance(percentile_it_, index - percentile_index_);
-  percentile_index_ = index;
-}
-
 template <typename T>
 T PercentileFilter<T>::GetPercentileValue() const {
-  return set_.empty() ? 0 : *percentile_it_;
+  if (sorted_values_.empty())
+    return 0;
+  const size_t index =
+      static_cast<size_t>(percentile_ * (sorted_values_.size() - 1));
+  return sorted_values_[index];
 }
 
 template <typename T>
 void PercentileFilter<T>::Reset() {
-  set_.clear();
-  percentile_it_ = set_.begin();
-  percentile_index_ = 0;
+  // Keeps the capacity, so that refilling the filter doesn't allocate.
+  sorted_values_.clear();
 }
 }  // namespace webrtc
 
@@ -16,6 +16,7 @@
 #include <climits>
 #include <cstdint>
 #include <random>
+#include <vector>
 
 #include "absl/algorithm/container.h"
 #include "rtc_base/constructor_magic.h"
@@ -140,4 +141,29 @@ TEST_P(PercentileFilterTest, InsertAndEraseTenValuesInRandomOrder) {
   }
 }
 
+TEST_P(PercentileFilterTest, MatchesSortedWindowOfRandomValues) {
+  // Window sizes as used by MovingMedianFilter and VCMCodecTimer.
+  for (size_t window_size : {1, 20, 300}) {
+    filter_.Reset();
+    std::mt19937 generator(42);
+    // Few distinct values, so that there are plenty of duplicates.
+    std::uniform_int_distribution<int64_t> distribution(0, 50);
+    std::vector<int64_t> window;
+    for (int i = 0; i < 2000; ++i) {
+      const int64_t value = distribution(generator);
+      filter_.Insert(value);
+      window.push_back(value);
+      if (window.size() > window_size) {
+        EXPECT_TRUE(filter_.Erase(window.front()));
+        window.erase(window.begin());
+      }
+      std::vector<int64_t> sorted_window = window;
+      absl::c_sort(sorted_window);
+      const size_t index =
+          static_cast<size_t>(GetParam() * (sorted_window.size() - 1));
+      ASSERT_EQ(sorted_window[index], filter_.GetPercentileValue());
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -18,6 +18,7 @@
 #include <string.h>
 #include <time.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "rtc_base/checks.h"
@@ -29,6 +30,7 @@
 #include "rtc_base/openssl_utility.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 
 //////////////////////////////////////////////////////////////////////
 // SocketBIO
@@ -55,15 +57,36 @@ static BIO_METHOD* BIO_socket_method() {
   return methods;
 }
 
-static BIO* BIO_new_socket(rtc::AsyncSocket* socket) {
+// Large enough for a full TLS record, including the record header.
+static const size_t kSocketReadBufferSize = 17 * 1024;
+
+// The data of a socket BIO. With |buffer_reads| set, the socket is read in
+// chunks of kSocketReadBufferSize, so that a single Recv() on the socket
+// returns several TLS records instead of two Recv() calls being needed for
+// each record (one for the header and one for the body). Must not be set for
+// DTLS, where each read has to return a single datagram.
+struct SocketBioData {
+  rtc::AsyncSocket* socket;
+  bool buffer_reads;
+  rtc::Buffer read_buffer;
+  size_t read_pos = 0;
+};
+
+static BIO* BIO_new_socket(rtc::AsyncSocket* socket, bool buffer_reads) {
   BIO* ret = BIO_new(BIO_socket_method());
   if (ret == nullptr) {
     return nullptr;
   }
-  BIO_set_data(ret, socket);
+  BIO_set_data(ret, new SocketBioData{socket, buffer_reads});
   return ret;
 }
 
+// Returns the number of bytes read from the socket but not yet consumed.
+static size_t BIO_socket_buffered_bytes(BIO* b) {
+  SocketBioData* data = static_cast<SocketBioData*>(BIO_get_data(b));
+  return data->read_buffer.size() - data->read_pos;
+}
+
 static int socket_new(BIO* b) {
   BIO_set_shutdown(b, 0);
   BIO_set_init(b, 1);
@@ -74,18 +97,44 @@ static int socket_new(BIO* b) {
 static int socket_free(BIO* b) {
   if (b == nullptr)
     return 0;
+  delete static_cast<SocketBioData*>(BIO_get_data(b));
+  BIO_set_data(b, nullptr);
   return 1;
 }
 
+// Copies up to |size| buffered bytes to |out| and returns their number.
+static size_t ReadBuffered(SocketBioData* data, char* out, size_t size) {
+  size = std::min(size, data->read_buffer.size() - data->read_pos);
+  memcpy(out, data->read_buffer.data() + data->read_pos, size);
+  data->read_pos += size;
+  return size;
+}
+
 static int socket_read(BIO* b, char* out, int outl) {
   if (!out)
     return -1;
-  rtc::AsyncSocket* socket = static_cast<rtc::AsyncSocket*>(BIO_get_data(b));
+  SocketBioData* data = static_cast<SocketBioData*>(BIO_get_data(b));
   BIO_clear_retry_flags(b);
-  int result = socket->Recv(out, outl, nullptr);
-  if (result > 0) {
-    return result;
-  } else if (socket->IsBlocking()) {
+  const size_t size = static_cast<size_t>(outl);
+  int result;
+  if (BIO_socket_buffered_bytes(b) > 0) {
+    return rtc::checked_cast<int>(ReadBuffered(data, out, size));
+  } else if (data->buffer_reads && size < kSocketReadBufferSize) {
+    data->read_buffer.SetSize(kSocketReadBufferSize);
+    result = data->socket->Recv(data->read_buffer.data(),
+                                kSocketReadBufferSize, nullptr);
+    data->read_buffer.SetSize(std::max(result, 0));
+    data->read_pos = 0;
+    if (result > 0) {
+      return rtc::checked_cast<int>(ReadBuffered(data, out, size));
+    }
+  } else {
+    result = data->socket->Recv(out, outl, nullptr);
+    if (result > 0) {
+      return result;
+    }
+  }
+  if (data->socket->IsBlocking()) {
     BIO_set_retry_read(b);
   }
   return -1;
@@ -94,7 +143,8 @@ static int socket_read(BIO* b, char* out, int outl) {
 static int socket_write(BIO* b, const char* in, int inl) {
   if (!in)
     return -1;
-  rtc::AsyncSocket* socket = static_cast<rtc::AsyncSocket*>(BIO_get_data(b));
+  rtc::AsyncSocket* socket =
+      static_cast<SocketBioData*>(BIO_get_data(b))->socket;
   BIO_clear_retry_flags(b);
   int result = socket->Send(in, inl);
   if (result > 0) {
@@ -114,13 +164,15 @@ static long socket_ctrl(BIO* b, int cmd, long num, void* ptr) {  // NOLINT
     case BIO_CTRL_RESET:
       return 0;
     case BIO_CTRL_EOF: {
-      rtc::AsyncSocket* socket = static_cast<rtc::AsyncSocket*>(ptr);
+      rtc::AsyncSocket* socket =
+          static_cast<SocketBioData*>(BIO_get_data(b))->socket;
       // 1 means socket closed.
       return (socket->GetState() == rtc::AsyncSocket::CS_CLOSED) ? 1 : 0;
     }
     case BIO_CTRL_WPENDING:
-    case BIO_CTRL_PENDING:
       return 0;
+    case BIO_CTRL_PENDING:
+      return rtc::checked_cast<long>(BIO_socket_buffered_bytes(b));  // NOLINT
     case BIO_CTRL_FLUSH:
       return 1;
     default:
@@ -292,7 +344,7 @@ int OpenSSLAdapter::BeginSSL() {
     goto ssl_error;
   }
 
-  bio = BIO_new_socket(socket_);
+  bio = BIO_new_socket(socket_, ssl_mode_ == SSL_MODE_TLS);
   if (!bio) {
     err = -1;
     goto ssl_error;
@@ -396,6 +448,9 @@ int OpenSSLAdapter::ContinueSSL() {
       }
 
       state_ = SSL_CONNECTED;
+      connected_time_ms_ = TimeMillis();
+      bytes_encrypted_ = 0;
+      bytes_decrypted_ = 0;
       AsyncSocketAdapter::OnConnectEvent(this);
       // TODO(benwright): Refactor this code path.
       // Don't let ourselves go away during the callbacks
@@ -442,6 +497,18 @@ void OpenSSLAdapter::Error(const char* context, int err, bool signal) {
 void OpenSSLAdapter::Cleanup() {
   RTC_LOG(LS_INFO) << "OpenSSLAdapter::Cleanup";
 
+  if (connected_time_ms_ >= 0) {
+    int64_t duration_ms =
+        std::max<int64_t>(TimeMillis() - connected_time_ms_, 1);
+    RTC_LOG(LS_INFO) << "Connection to " << ssl_host_name_ << " encrypted "
+                     << bytes_encrypted_ << " bytes ("
+                     << bytes_encrypted_ * 8 / duration_ms << " kbps) and "
+                     << "decrypted " << bytes_decrypted_ << " bytes ("
+                     << bytes_decrypted_ * 8 / duration_ms << " kbps) in "
+                     << duration_ms << " ms";
+    connected_time_ms_ = -1;
+  }
+
   state_ = SSL_NONE;
   ssl_read_needs_write_ = false;
   ssl_write_needs_read_ = false;
@@ -459,8 +526,9 @@ void OpenSSLAdapter::Cleanup() {
   }
   identity_.reset();
 
-  // Clear the DTLS timer
+  // Clear the DTLS timer and any pending read event.
   Thread::Current()->Clear(this, MSG_TIMEOUT);
+  Thread::Current()->Clear(this, MSG_READ);
 }
 
 int OpenSSLAdapter::DoSslWrite(const void* pv, size_t cb, int* error) {
@@ -501,6 +569,75 @@ int OpenSSLAdapter::DoSslWrite(const void* pv, size_t cb, int* error) {
   return SOCKET_ERROR;
 }
 
+size_t OpenSSLAdapter::DoSslWriteRecords(const uint8_t* data,
+                                         size_t size,
+                                         int* error) {
+  // With SSL_MODE_ENABLE_PARTIAL_WRITE, SSL_write returns after each record,
+  // so keep going until all of |data| is written, instead of leaving the rest
+  // to a later Send() that may not come soon. DTLS writes one datagram.
+  size_t written = 0;
+  do {
+    int ret = DoSslWrite(data + written, size - written, error);
+    if (ret <= 0) {
+      break;
+    }
+    written += ret;
+    bytes_encrypted_ += ret;
+  } while (ssl_mode_ == SSL_MODE_TLS && written < size);
+  return written;
+}
+
+bool OpenSSLAdapter::FlushPendingData() {
+  if (pending_data_.empty()) {
+    return true;
+  }
+  int error;
+  size_t written =
+      DoSslWriteRecords(pending_data_.data(), pending_data_.size(), &error);
+  if (written == pending_data_.size()) {
+    // We completed sending the data previously passed into SSL_write! Now
+    // we're allowed to send more data.
+    pending_data_.Clear();
+    return true;
+  }
+  // Keep the rest, which starts with the arguments of the failed SSL_write.
+  size_t remaining = pending_data_.size() - written;
+  memmove(pending_data_.data(), pending_data_.data() + written, remaining);
+  pending_data_.SetSize(remaining);
+  return false;
+}
+
+int OpenSSLAdapter::DoSslRead(void* pv, size_t cb, int* error) {
+  RTC_DCHECK(error != nullptr);
+
+  ssl_read_needs_write_ = false;
+  int code = SSL_read(ssl_, pv, checked_cast<int>(cb));
+  *error = SSL_get_error(ssl_, code);
+  switch (*error) {
+    case SSL_ERROR_NONE:
+      return code;
+    case SSL_ERROR_WANT_READ:
+      SetError(EWOULDBLOCK);
+      break;
+    case SSL_ERROR_WANT_WRITE:
+      ssl_read_needs_write_ = true;
+      SetError(EWOULDBLOCK);
+      break;
+    case SSL_ERROR_ZERO_RETURN:
+      SetError(EWOULDBLOCK);
+      // do we need to signal closure?
+      break;
+    case SSL_ERROR_SSL:
+      LogSslError();
+      Error("SSL_read", (code ? code : -1), false);
+      break;
+    default:
+      Error("SSL_read", (code ? code : -1), false);
+      break;
+  }
+  return SOCKET_ERROR;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // AsyncSocket Implementation
 ///////////////////////////////////////////////////////////////////////////////
@@ -520,20 +657,13 @@ int OpenSSLAdapter::Send(const void* pv, size_t cb) {
       return SOCKET_ERROR;
   }
 
-  int ret;
   int error;
 
-  if (!pending_data_.empty()) {
-    ret = DoSslWrite(pending_data_.data(), pending_data_.size(), &error);
-    if (ret != static_cast<int>(pending_data_.size())) {
-      // We couldn't finish sending the pending data, so we definitely can't
-      // send any more data. Return with an EWOULDBLOCK error.
-      SetError(EWOULDBLOCK);
-      return SOCKET_ERROR;
-    }
-    // We completed sending the data previously passed into SSL_write! Now
-    // we're allowed to send more data.
-    pending_data_.Clear();
+  if (!FlushPendingData()) {
+    // We couldn't finish sending the pending data, so we definitely can't
+    // send any more data. Return with an EWOULDBLOCK error.
+    SetError(EWOULDBLOCK);
+    return SOCKET_ERROR;
   }
 
   // OpenSSL will return an error if we try to write zero bytes
@@ -541,7 +671,11 @@ int OpenSSLAdapter::Send(const void* pv, size_t cb) {
     return 0;
   }
 
-  ret = DoSslWrite(pv, cb, &error);
+  const uint8_t* data = static_cast<const uint8_t*>(pv);
+  size_t written = DoSslWriteRecords(data, cb, &error);
+  if (written == cb) {
+    return rtc::dchecked_cast<int>(cb);
+  }
 
   // If SSL_write fails with SSL_ERROR_WANT_READ or SSL_ERROR_WANT_WRITE, this
   // means the underlying socket is blocked on reading or (more typically)
@@ -553,20 +687,21 @@ int OpenSSLAdapter::Send(const void* pv, size_t cb) {
   // However, after Send exits, we will have lost access to data the user of
   // this class is trying to send, and there's no guarantee that the user of
   // this class will call Send with the same arguements when it fails. So, we
-  // buffer the data ourselves. When we know the underlying socket is writable
-  // again from OnWriteEvent (or if Send is called again before that happens),
-  // we'll retry sending this buffered data.
+  // buffer the data ourselves, starting with the arguments of the failed
+  // SSL_write. When we know the underlying socket is writable again from
+  // OnWriteEvent (or if Send is called again before that happens), we'll retry
+  // sending this buffered data.
   if (error == SSL_ERROR_WANT_READ || error == SSL_ERROR_WANT_WRITE) {
     // Shouldn't be able to get to this point if we already have pending data.
     RTC_DCHECK(pending_data_.empty());
     RTC_LOG(LS_WARNING)
         << "SSL_write couldn't write to the underlying socket; buffering data.";
-    pending_data_.SetData(static_cast<const uint8_t*>(pv), cb);
+    pending_data_.SetData(data + written, cb - written);
     // Since we're taking responsibility for sending this data, return its full
     // size. The user of this class can consider it sent.
     return rtc::dchecked_cast<int>(cb);
   }
-  return ret;
+  return written > 0 ? rtc::dchecked_cast<int>(written) : SOCKET_ERROR;
 }
 
 int OpenSSLAdapter::SendTo(const void* pv,
@@ -601,33 +736,31 @@ int OpenSSLAdapter::Recv(void* pv, size_t cb, int64_t* timestamp) {
     return 0;
   }
 
-  ssl_read_needs_write_ = false;
-  int code = SSL_read(ssl_, pv, checked_cast<int>(cb));
-  int error = SSL_get_error(ssl_, code);
-
-  switch (error) {
-    case SSL_ERROR_NONE:
-      return code;
-    case SSL_ERROR_WANT_READ:
-      SetError(EWOULDBLOCK);
-      break;
-    case SSL_ERROR_WANT_WRITE:
-      ssl_read_needs_write_ = true;
-      SetError(EWOULDBLOCK);
-      break;
-    case SSL_ERROR_ZERO_RETURN:
-      SetError(EWOULDBLOCK);
-      // do we need to signal closure?
-      break;
-    case SSL_ERROR_SSL:
-      LogSslError();
-      Error("SSL_read", (code ? code : -1), false);
-      break;
-    default:
-      Error("SSL_read", (code ? code : -1), false);
+  // SSL_read returns at most one record, so in TLS mode keep reading until
+  // |pv| is full or no more data is available. An error after some data was
+  // read is returned by the next call.
+  char* data = static_cast<char*>(pv);
+  size_t bytes_read = 0;
+  int error;
+  do {
+    int code = DoSslRead(data + bytes_read, cb - bytes_read, &error);
+    if (code <= 0) {
       break;
+    }
+    bytes_read += code;
+  } while (ssl_mode_ == SSL_MODE_TLS && bytes_read < cb);
+  if (bytes_read == 0) {
+    return SOCKET_ERROR;
   }
-  return SOCKET_ERROR;
+  bytes_decrypted_ += bytes_read;
+
+  // Data may be left in the socket BIO or in |ssl_| without the underlying
+  // socket signaling it again, so make sure that the reader comes back.
+  if (bytes_read == cb && (SSL_pending(ssl_) > 0 ||
+                           BIO_socket_buffered_bytes(SSL_get_rbio(ssl_)) > 0)) {
+    Thread::Current()->Post(RTC_FROM_HERE, this, MSG_READ);
+  }
+  return rtc::dchecked_cast<int>(bytes_read);
 }
 
 int OpenSSLAdapter::RecvFrom(void* pv,
@@ -668,6 +801,8 @@ void OpenSSLAdapter::OnMessage(Message* msg) {
     RTC_LOG(LS_INFO) << "DTLS timeout expired";
     DTLSv1_handle_timeout(ssl_);
     ContinueSSL();
+  } else if (MSG_READ == msg->message_id && state_ == SSL_CONNECTED) {
+    AsyncSocketAdapter::OnReadEvent(this);
   }
 }
 
@@ -737,13 +872,7 @@ void OpenSSLAdapter::OnWriteEvent(AsyncSocket* socket) {
 
   // If a previous SSL_write failed due to the underlying socket being blocked,
   // this will attempt finishing the write operation.
-  if (!pending_data_.empty()) {
-    int error;
-    if (DoSslWrite(pending_data_.data(), pending_data_.size(), &error) ==
-        static_cast<int>(pending_data_.size())) {
-      pending_data_.Clear();
-    }
-  }
+  FlushPendingData();
 
   AsyncSocketAdapter::OnWriteEvent(socket);
 }
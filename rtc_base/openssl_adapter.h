@@ -69,6 +69,10 @@ class OpenSSLAdapter final : public SSLAdapter, public MessageHandler {
   // Note that the socket returns ST_CONNECTING while SSL is being negotiated.
   ConnState GetState() const override;
   bool IsResumedSession() override;
+  // Number of application data bytes encrypted and sent, and received and
+  // decrypted, since the connection was established.
+  int64_t bytes_encrypted() const { return bytes_encrypted_; }
+  int64_t bytes_decrypted() const { return bytes_decrypted_; }
   // Creates a new SSL_CTX object, configured for client-to-server usage
   // with SSLMode |mode|, and if |enable_cache| is true, with support for
   // storing successful sessions so that they can be later resumed.
@@ -92,7 +96,7 @@ class OpenSSLAdapter final : public SSLAdapter, public MessageHandler {
     SSL_ERROR
   };
 
-  enum { MSG_TIMEOUT };
+  enum { MSG_TIMEOUT, MSG_READ };
 
   int BeginSSL();
   int ContinueSSL();
@@ -102,6 +106,16 @@ class OpenSSLAdapter final : public SSLAdapter, public MessageHandler {
   // Return value and arguments have the same meanings as for Send; |error| is
   // an output parameter filled with the result of SSL_get_error.
   int DoSslWrite(const void* pv, size_t cb, int* error);
+  // Calls DoSslWrite until all of |data| is written, which in TLS mode may
+  // take several records, or until it fails. Returns the number of bytes
+  // written.
+  size_t DoSslWriteRecords(const uint8_t* data, size_t size, int* error);
+  // Retries sending |pending_data_| and removes what was sent. Returns true if
+  // nothing is left.
+  bool FlushPendingData();
+  // Return value and arguments have the same meanings as for DoSslWrite, but
+  // for SSL_read.
+  int DoSslRead(void* pv, size_t cb, int* error);
   void OnMessage(Message* msg) override;
   bool SSLPostConnectionCheck(SSL* ssl, const std::string& host);
 
@@ -150,6 +164,10 @@ class OpenSSLAdapter final : public SSLAdapter, public MessageHandler {
   std::vector<std::string> elliptic_curves_;
   // Holds the result of the call to run of the ssl_cert_verify_->Verify()
   bool custom_cert_verifier_status_;
+  // Transfer statistics, logged when the connection is cleaned up.
+  int64_t bytes_encrypted_ = 0;
+  int64_t bytes_decrypted_ = 0;
+  int64_t connected_time_ms_ = -1;
 };
 
 // The OpenSSLAdapterFactory is responsbile for creating multiple new
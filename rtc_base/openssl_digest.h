@@ -45,6 +45,27 @@ class OpenSSLDigest final : public MessageDigest {
   const EVP_MD* md_;
 };
 
+// An HMAC with a fixed key that uses OpenSSL. The key is set up once, so each
+// Finish() only costs hashing the input.
+class OpenSSLHmac final : public MessageDigest {
+ public:
+  // Creates an OpenSSLHmac with |algorithm| as the hash algorithm, keyed with
+  // |key_len| bytes of |key|.
+  OpenSSLHmac(const std::string& algorithm, const void* key, size_t key_len);
+  ~OpenSSLHmac() override;
+  // Returns the HMAC output size (e.g. 20 bytes for SHA-1).
+  size_t Size() const override;
+  // Updates the HMAC with |len| bytes from |buf|.
+  void Update(const void* buf, size_t len) override;
+  // Outputs the HMAC value to |buf| with length |len|, and resets the HMAC
+  // for the next input with the same key.
+  size_t Finish(void* buf, size_t len) override;
+
+ private:
+  HMAC_CTX* ctx_ = nullptr;
+  const EVP_MD* md_;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_OPENSSL_DIGEST_H_
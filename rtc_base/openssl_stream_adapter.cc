@@ -21,12 +21,16 @@
 #include <openssl/ssl.h>
 #endif
 
+#include <deque>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/message_digest.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/openssl.h"
 #include "rtc_base/openssl_adapter.h"
@@ -34,6 +38,7 @@
 #include "rtc_base/openssl_identity.h"
 #include "rtc_base/ssl_certificate.h"
 #include "rtc_base/stream.h"
+#include "rtc_base/string_encode.h"
 #include "rtc_base/thread.h"
 #include "rtc_base/time_utils.h"
 
@@ -145,6 +150,65 @@ void TimeCallbackForTesting(const SSL* ssl, struct timeval* out_clock) {
 }
 #endif
 
+// The number of sessions kept for resumption, across all streams. The oldest
+// session is dropped to make room for a new one.
+constexpr size_t kMaxCachedSessions = 100;
+
+// Sessions of the client streams that enabled session resumption, keyed by
+// |OpenSSLStreamAdapter::SessionCacheKey|, and the session ticket keys shared
+// by all server streams that enabled it, so that any of them can resume a
+// session established by another. Used from any thread.
+class SessionResumptionCache {
+ public:
+  static SessionResumptionCache* Instance() {
+    static SessionResumptionCache* const instance =
+        new SessionResumptionCache();
+    return instance;
+  }
+
+  // Sets the session cached for |key|, if any, to be resumed by |ssl|.
+  bool SetSession(const std::string& key, SSL* ssl) {
+    CritScope lock(&crit_);
+    auto it = sessions_.find(key);
+    return it != sessions_.end() && SSL_set_session(ssl, it->second) == 1;
+  }
+
+  // Takes ownership of |session|, replacing any session cached for |key|.
+  void AddSession(const std::string& key, SSL_SESSION* session) {
+    CritScope lock(&crit_);
+    auto it = sessions_.find(key);
+    if (it != sessions_.end()) {
+      SSL_SESSION_free(it->second);
+      it->second = session;
+      return;
+    }
+    if (sessions_.size() == kMaxCachedSessions) {
+      auto oldest = sessions_.find(insertion_order_.front());
+      SSL_SESSION_free(oldest->second);
+      sessions_.erase(oldest);
+      insertion_order_.pop_front();
+    }
+    sessions_[key] = session;
+    insertion_order_.push_back(key);
+  }
+
+  bool ConfigureTicketKeys(SSL_CTX* ctx) {
+    return SSL_CTX_set_tlsext_ticket_keys(ctx, ticket_keys_,
+                                          sizeof(ticket_keys_)) == 1;
+  }
+
+ private:
+  SessionResumptionCache() {
+    RTC_CHECK(RAND_bytes(ticket_keys_, sizeof(ticket_keys_)));
+  }
+
+  CriticalSection crit_;
+  std::map<std::string, SSL_SESSION*> sessions_ RTC_GUARDED_BY(crit_);
+  std::deque<std::string> insertion_order_ RTC_GUARDED_BY(crit_);
+  // Name, HMAC secret and AES key of the session tickets.
+  uint8_t ticket_keys_[48];
+};
+
 }  // namespace
 
 //////////////////////////////////////////////////////////////////////
@@ -504,6 +568,11 @@ void OpenSSLStreamAdapter::SetInitialRetransmissionTimeout(int timeout_ms) {
   dtls_handshake_timeout_ms_ = timeout_ms;
 }
 
+void OpenSSLStreamAdapter::SetSessionResumptionEnabled(bool enabled) {
+  RTC_DCHECK(ssl_ctx_ == nullptr);
+  session_resumption_enabled_ = enabled;
+}
+
 //
 // StreamInterface Implementation
 //
@@ -811,6 +880,14 @@ int OpenSSLStreamAdapter::BeginSSL() {
   SSL_set_mode(ssl_, SSL_MODE_ENABLE_PARTIAL_WRITE |
                          SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
 
+  if (session_resumption_enabled_ && role_ == SSL_CLIENT) {
+    std::string key = SessionCacheKey();
+    if (!key.empty() &&
+        SessionResumptionCache::Instance()->SetSession(key, ssl_)) {
+      RTC_LOG(LS_INFO) << "Offering to resume a cached session.";
+    }
+  }
+
   // Do the connect
   return ContinueSSL();
 }
@@ -828,6 +905,12 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   switch (ssl_error) {
     case SSL_ERROR_NONE:
       RTC_LOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_)) {
+        RTC_LOG(LS_INFO) << "Resumed session.";
+        if (!VerifyResumedSession()) {
+          return -1;
+        }
+      }
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_cert_chain_ || !GetClientAuthEnabled());
@@ -1015,6 +1098,19 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
     }
   }
 
+  if (session_resumption_enabled_) {
+    if (role_ == SSL_CLIENT) {
+      // Sessions are only kept in |SessionResumptionCache|, since |ctx| is not
+      // shared with other streams.
+      SSL_CTX_set_session_cache_mode(
+          ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+      SSL_CTX_sess_set_new_cb(ctx, &OpenSSLStreamAdapter::NewSessionCallback);
+    } else if (!SessionResumptionCache::Instance()->ConfigureTicketKeys(ctx)) {
+      SSL_CTX_free(ctx);
+      return nullptr;
+    }
+  }
+
   return ctx;
 }
 
@@ -1092,6 +1188,49 @@ int OpenSSLStreamAdapter::SSLVerifyCallback(X509_STORE_CTX* store, void* arg) {
   return 1;
 }
 
+std::string OpenSSLStreamAdapter::SessionCacheKey() const {
+  if (!identity_ || !HasPeerCertificateDigest()) {
+    return std::string();
+  }
+  unsigned char digest[EVP_MAX_MD_SIZE];
+  size_t digest_length;
+  if (!identity_->certificate().ComputeDigest(DIGEST_SHA_256, digest,
+                                              sizeof(digest), &digest_length)) {
+    return std::string();
+  }
+  return hex_encode(reinterpret_cast<const char*>(digest), digest_length) +
+         " " + peer_certificate_digest_algorithm_ + " " +
+         hex_encode(peer_certificate_digest_value_.data<char>(),
+                    peer_certificate_digest_value_.size());
+}
+
+bool OpenSSLStreamAdapter::VerifyResumedSession() {
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (!cert) {
+    RTC_LOG(LS_WARNING) << "Resumed session has no peer certificate.";
+    return false;
+  }
+  peer_cert_chain_.reset(
+      new SSLCertChain(std::make_unique<OpenSSLCertificate>(cert)));
+  X509_free(cert);
+
+  // As in |SSLVerifyCallback|, if the peer certificate digest isn't known yet,
+  // the certificate is verified once it is.
+  return !HasPeerCertificateDigest() || VerifyPeerCertificate();
+}
+
+int OpenSSLStreamAdapter::NewSessionCallback(SSL* ssl, SSL_SESSION* session) {
+  OpenSSLStreamAdapter* stream =
+      reinterpret_cast<OpenSSLStreamAdapter*>(SSL_get_app_data(ssl));
+  // Only sessions with a verified peer certificate are worth resuming.
+  std::string key = stream->SessionCacheKey();
+  if (key.empty() || !stream->peer_certificate_verified_) {
+    return 0;
+  }
+  SessionResumptionCache::Instance()->AddSession(key, session);
+  return 1;  // We've taken ownership of the session; OpenSSL shouldn't free it.
+}
+
 bool OpenSSLStreamAdapter::IsBoringSsl() {
 #ifdef OPENSSL_IS_BORINGSSL
   return true;
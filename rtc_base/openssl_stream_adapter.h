@@ -26,6 +26,10 @@
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/stream.h"
 
+#ifndef OPENSSL_IS_BORINGSSL
+typedef struct ssl_session_st SSL_SESSION;
+#endif
+
 namespace rtc {
 
 // This class was written with OpenSSLAdapter (a socket adapter) as a
@@ -79,6 +83,7 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   void SetMode(SSLMode mode) override;
   void SetMaxProtocolVersion(SSLProtocolVersion version) override;
   void SetInitialRetransmissionTimeout(int timeout_ms) override;
+  void SetSessionResumptionEnabled(bool enabled) override;
 
   StreamResult Read(void* data,
                     size_t data_len,
@@ -174,6 +179,15 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // SSL certificate verification callback. See
   // SSL_CTX_set_cert_verify_callback.
   static int SSLVerifyCallback(X509_STORE_CTX* store, void* arg);
+  // Key of this stream's session in the session resumption cache, or empty if
+  // the local certificate or peer certificate digest is not known.
+  std::string SessionCacheKey() const;
+  // Verifies the peer certificate of a resumed session, for which
+  // |SSLVerifyCallback| is not called.
+  bool VerifyResumedSession();
+  // Adds sessions of client streams to the session resumption cache. See
+  // SSL_CTX_sess_set_new_cb.
+  static int NewSessionCallback(SSL* ssl, SSL_SESSION* session);
 
   bool WaitingToVerifyPeerCertificate() const {
     return GetClientAuthEnabled() && !peer_certificate_verified_;
@@ -217,6 +231,8 @@ class OpenSSLStreamAdapter final : public SSLStreamAdapter {
   // A 50-ms initial timeout ensures rapid setup on fast connections, but may
   // be too aggressive for low bandwidth links.
   int dtls_handshake_timeout_ms_ = 50;
+
+  bool session_resumption_enabled_ = false;
 };
 
 /////////////////////////////////////////////////////////////////////////////
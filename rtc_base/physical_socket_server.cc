@@ -53,6 +53,14 @@
 
 #if defined(WEBRTC_LINUX)
 #include <linux/sockios.h>
+#include <netinet/udp.h>
+// UDP generic segmentation offload is only defined starting with Linux 4.18.
+#if !defined(SOL_UDP)
+#define SOL_UDP 17
+#endif
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
 #endif
 
 #if defined(WEBRTC_WIN)
@@ -106,6 +114,55 @@ typedef char* SockOptArg;
 
 namespace rtc {
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+// Upper bound on the number of datagrams read by a single recvmmsg() call.
+static const size_t kMaxRecvBatchSize = 64;
+// Upper bound on the number of datagrams written by a single sendmmsg() call.
+// This is also the kernel's limit on the segments of one GSO send.
+static const size_t kMaxSendBatchSize = 64;
+// Maximum payload of a single UDP send, which bounds a whole GSO batch.
+static const size_t kMaxGsoPayloadSize = 65507;
+
+// A batch can be sent with UDP generic segmentation offload if all datagrams
+// go to the same address and all but the last have the same size; the last
+// one may be shorter.
+static bool CanSendWithGso(const DatagramToSend* datagrams, size_t count) {
+  const size_t segment_size = datagrams[0].length;
+  if (segment_size == 0 || segment_size > 0xffff)
+    return false;
+  size_t total_size = 0;
+  for (size_t i = 0; i < count; ++i) {
+    if (datagrams[i].address != datagrams[0].address)
+      return false;
+    if (i + 1 < count ? datagrams[i].length != segment_size
+                      : datagrams[i].length > segment_size) {
+      return false;
+    }
+    total_size += datagrams[i].length;
+  }
+  return total_size <= kMaxGsoPayloadSize;
+}
+
+// Returns the ECN field of a datagram read with OPT_RECV_ECN enabled.
+static EcnMarking ReadEcnMarking(struct msghdr* message) {
+  for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(message); cmsg != nullptr;
+       cmsg = CMSG_NXTHDR(message, cmsg)) {
+    // IP_TOS carries a single byte, IPV6_TCLASS an int.
+    if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_TOS &&
+        cmsg->cmsg_len >= CMSG_LEN(sizeof(uint8_t))) {
+      return EcnMarkingFromTos(*CMSG_DATA(cmsg));
+    }
+    if (cmsg->cmsg_level == IPPROTO_IPV6 && cmsg->cmsg_type == IPV6_TCLASS &&
+        cmsg->cmsg_len >= CMSG_LEN(sizeof(int))) {
+      int traffic_class;
+      memcpy(&traffic_class, CMSG_DATA(cmsg), sizeof(traffic_class));
+      return EcnMarkingFromTos(traffic_class);
+    }
+  }
+  return EcnMarking::kNotEct;
+}
+#endif
+
 std::unique_ptr<SocketServer> SocketServer::CreateDefault() {
 #if defined(__native_client__)
   return std::unique_ptr<SocketServer>(new rtc::NullSocketServer);
@@ -283,6 +340,14 @@ AsyncSocket::ConnState PhysicalSocket::GetState() const {
 }
 
 int PhysicalSocket::GetOption(Option opt, int* value) {
+  if (opt == OPT_RECV_ECN) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+    *value = recv_ecn_ ? 1 : 0;
+    return 0;
+#else
+    return -1;
+#endif
+  }
   int slevel;
   int sopt;
   if (TranslateOption(opt, &slevel, &sopt) == -1)
@@ -298,6 +363,8 @@ int PhysicalSocket::GetOption(Option opt, int* value) {
 }
 
 int PhysicalSocket::SetOption(Option opt, int value) {
+  if (opt == OPT_RECV_ECN)
+    return SetRecvEcn(value != 0);
   int slevel;
   int sopt;
   if (TranslateOption(opt, &slevel, &sopt) == -1)
@@ -310,6 +377,37 @@ int PhysicalSocket::SetOption(Option opt, int value) {
   return ::setsockopt(s_, slevel, sopt, (SockOptArg)&value, sizeof(value));
 }
 
+int PhysicalSocket::SetRecvEcn(bool enable) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (!udp_)
+    return -1;
+  int family = AF_UNSPEC;
+  socklen_t len = sizeof(family);
+  if (::getsockopt(s_, SOL_SOCKET, SO_DOMAIN, &family, &len) == -1) {
+    UpdateLastError();
+    return -1;
+  }
+  int value = enable ? 1 : 0;
+  int ret = -1;
+  if (family == AF_INET6) {
+    ret = ::setsockopt(s_, IPPROTO_IPV6, IPV6_RECVTCLASS, &value,
+                       sizeof(value));
+    // Dual stack sockets report the TOS byte of IPv4 packets separately.
+    if (ret == 0)
+      ::setsockopt(s_, IPPROTO_IP, IP_RECVTOS, &value, sizeof(value));
+  } else {
+    ret = ::setsockopt(s_, IPPROTO_IP, IP_RECVTOS, &value, sizeof(value));
+  }
+  UpdateLastError();
+  if (ret == 0)
+    recv_ecn_ = enable;
+  return ret;
+#else
+  RTC_LOG(LS_WARNING) << "Socket::OPT_RECV_ECN not supported.";
+  return -1;
+#endif
+}
+
 int PhysicalSocket::Send(const void* pv, size_t cb) {
   int sent = DoSend(
       s_, reinterpret_cast<const char*>(pv), static_cast<int>(cb),
@@ -328,6 +426,8 @@ int PhysicalSocket::Send(const void* pv, size_t cb) {
   MaybeRemapSendError();
   // We have seen minidumps where this may be false.
   RTC_DCHECK(sent <= static_cast<int>(cb));
+  if (sent < 0 && IsBlockingError(GetError()))
+    OnWouldBlock(DE_WRITE);
   if ((sent > 0 && sent < static_cast<int>(cb)) ||
       (sent < 0 && IsBlockingError(GetError()))) {
     EnableEvents(DE_WRITE);
@@ -353,6 +453,8 @@ int PhysicalSocket::SendTo(const void* buffer,
   MaybeRemapSendError();
   // We have seen minidumps where this may be false.
   RTC_DCHECK(sent <= static_cast<int>(length));
+  if (sent < 0 && IsBlockingError(GetError()))
+    OnWouldBlock(DE_WRITE);
   if ((sent > 0 && sent < static_cast<int>(length)) ||
       (sent < 0 && IsBlockingError(GetError()))) {
     EnableEvents(DE_WRITE);
@@ -360,6 +462,81 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToBatch(const DatagramToSend* datagrams,
+                                size_t count) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (!udp_ || count <= 1)
+    return Socket::SendToBatch(datagrams, count);
+
+  count = std::min(count, kMaxSendBatchSize);
+  struct iovec iovecs[kMaxSendBatchSize];
+  for (size_t i = 0; i < count; ++i) {
+    iovecs[i].iov_base = const_cast<void*>(datagrams[i].data);
+    iovecs[i].iov_len = datagrams[i].length;
+  }
+
+  if (gso_enabled_ && CanSendWithGso(datagrams, count)) {
+    sockaddr_storage saddr;
+    socklen_t saddr_len = static_cast<socklen_t>(
+        datagrams[0].address.ToSockAddrStorage(&saddr));
+    char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+    struct msghdr message = {};
+    message.msg_name = &saddr;
+    message.msg_namelen = saddr_len;
+    message.msg_iov = iovecs;
+    message.msg_iovlen = count;
+    message.msg_control = control;
+    message.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&message);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    uint16_t segment_size = static_cast<uint16_t>(datagrams[0].length);
+    memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+
+    int sent = ::sendmsg(s_, &message, MSG_NOSIGNAL);
+    UpdateLastError();
+    if (sent >= 0)
+      return static_cast<int>(count);
+    int error = GetError();
+    if (error != EIO && error != EINVAL && error != ENOPROTOOPT) {
+      if (IsBlockingError(error)) {
+        OnWouldBlock(DE_WRITE);
+        EnableEvents(DE_WRITE);
+      }
+      return sent;
+    }
+    // The kernel or the network device doesn't support GSO for this socket,
+    // don't try again.
+    RTC_LOG(LS_INFO) << "UDP GSO not available, error " << error;
+    gso_enabled_ = false;
+  }
+
+  struct mmsghdr messages[kMaxSendBatchSize];
+  sockaddr_storage addresses[kMaxSendBatchSize];
+  for (size_t i = 0; i < count; ++i) {
+    memset(&messages[i], 0, sizeof(messages[i]));
+    messages[i].msg_hdr.msg_name = &addresses[i];
+    messages[i].msg_hdr.msg_namelen = static_cast<socklen_t>(
+        datagrams[i].address.ToSockAddrStorage(&addresses[i]));
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+  int sent = ::sendmmsg(s_, messages, static_cast<unsigned int>(count),
+                        MSG_NOSIGNAL);
+  UpdateLastError();
+  if (sent < 0 && IsBlockingError(GetError()))
+    OnWouldBlock(DE_WRITE);
+  if (sent < static_cast<int>(count) &&
+      (sent >= 0 || IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+#else
+  return Socket::SendToBatch(datagrams, count);
+#endif
+}
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
@@ -380,6 +557,8 @@ int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   UpdateLastError();
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
+  if (received < 0 && IsBlockingError(error))
+    OnWouldBlock(DE_READ);
   if (udp_ || success) {
     EnableEvents(DE_READ);
   }
@@ -406,6 +585,8 @@ int PhysicalSocket::RecvFrom(void* buffer,
     SocketAddressFromSockAddrStorage(addr_storage, out_addr);
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
+  if (received < 0 && IsBlockingError(error))
+    OnWouldBlock(DE_READ);
   if (udp_ || success) {
     EnableEvents(DE_READ);
   }
@@ -415,6 +596,67 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(ReceivedDatagram* datagrams, size_t count) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // A single datagram goes through recvmmsg() too if its ECN field is needed,
+  // since RecvFrom() doesn't read control messages.
+  if (!udp_ || (count <= 1 && !recv_ecn_))
+    return Socket::RecvFromBatch(datagrams, count);
+
+  count = std::min(count, kMaxRecvBatchSize);
+  struct mmsghdr messages[kMaxRecvBatchSize];
+  struct iovec iovecs[kMaxRecvBatchSize];
+  sockaddr_storage addresses[kMaxRecvBatchSize];
+  // Room for an IP_TOS and an IPV6_TCLASS control message per datagram.
+  constexpr size_t kEcnControlSize = 2 * CMSG_SPACE(sizeof(int));
+  char controls[kMaxRecvBatchSize][kEcnControlSize];
+  for (size_t i = 0; i < count; ++i) {
+    iovecs[i].iov_base = datagrams[i].buffer;
+    iovecs[i].iov_len = datagrams[i].capacity;
+    memset(&messages[i], 0, sizeof(messages[i]));
+    messages[i].msg_hdr.msg_name = &addresses[i];
+    messages[i].msg_hdr.msg_namelen = sizeof(addresses[i]);
+    messages[i].msg_hdr.msg_iov = &iovecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+    if (recv_ecn_) {
+      messages[i].msg_hdr.msg_control = controls[i];
+      messages[i].msg_hdr.msg_controllen = kEcnControlSize;
+    }
+  }
+  int received = ::recvmmsg(s_, messages, static_cast<unsigned int>(count),
+                            MSG_DONTWAIT, nullptr);
+  UpdateLastError();
+  // recvmmsg() returns fewer datagrams than asked for once the receive queue
+  // is empty.
+  if ((received < 0 && IsBlockingError(GetError())) ||
+      (received >= 0 && received < static_cast<int>(count))) {
+    OnWouldBlock(DE_READ);
+  }
+  // UDP sockets always keep reading enabled, see RecvFrom().
+  EnableEvents(DE_READ);
+  if (received < 0) {
+    if (!IsBlockingError(GetError())) {
+      RTC_LOG_F(LS_VERBOSE) << "Error = " << GetError();
+    }
+    return received;
+  }
+  for (int i = 0; i < received; ++i) {
+    ReceivedDatagram& datagram = datagrams[i];
+    datagram.length = messages[i].msg_len;
+    datagram.truncated = (messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    SocketAddressFromSockAddrStorage(addresses[i], &datagram.address);
+    // SIOCGSTAMP only reports the timestamp of the last datagram read, so it
+    // can't be used to timestamp the individual datagrams of a batch.
+    datagram.timestamp = -1;
+    datagram.ecn = recv_ecn_ ? ReadEcnMarking(&messages[i].msg_hdr)
+                             : EcnMarking::kNotEct;
+  }
+  return received;
+#else
+  return Socket::RecvFromBatch(datagrams, count);
+#endif
+}
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -556,6 +798,16 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
     case OPT_DSCP:
       RTC_LOG(LS_WARNING) << "Socket::OPT_DSCP not supported.";
       return -1;
+    case OPT_REUSEPORT:
+#if defined(WEBRTC_POSIX) && defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
+    case OPT_RECV_ECN:
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
     default:
@@ -609,7 +861,13 @@ bool SocketDispatcher::Initialize() {
   int value = 1;
   ::setsockopt(s_, SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value));
 #endif
+#if defined(WEBRTC_USE_EPOLL)
+  edge_triggered_ = udp_;
+  pending_epoll_events_ = 0;
+  ss_->AddDispatcher(this, edge_triggered_);
+#else
   ss_->Add(this);
+#endif
   return true;
 }
 
@@ -807,8 +1065,11 @@ void SocketDispatcher::OnEvent(uint32_t ff, int err) {
 
 #if defined(WEBRTC_USE_EPOLL)
 
-static int GetEpollEvents(uint32_t ff) {
-  int events = 0;
+// Epoll events that are always reported.
+static const uint32_t kEpollErrorEvents = EPOLLERR | EPOLLHUP | EPOLLRDHUP;
+
+static uint32_t GetEpollEvents(uint32_t ff) {
+  uint32_t events = 0;
   if (ff & (DE_READ | DE_ACCEPT)) {
     events |= EPOLLIN;
   }
@@ -830,13 +1091,31 @@ void SocketDispatcher::FinishBatchedEventUpdates() {
   MaybeUpdateDispatcher(old_events);
 }
 
+// UDP sockets enable writing whenever a send would block, and disable it
+// again once signaled, which would take two epoll_ctl() calls each time. So
+// they are registered with edge-triggered epoll for both reading and writing
+// once instead, and keep the events they are signaled with until an
+// operation would block, to be dispatched whenever they are enabled.
 void SocketDispatcher::MaybeUpdateDispatcher(uint8_t old_events) {
-  if (GetEpollEvents(enabled_events()) != GetEpollEvents(old_events) &&
-      saved_enabled_events_ == -1) {
+  if (saved_enabled_events_ != -1)
+    return;
+  if (edge_triggered_) {
+    if (HasPendingEpollEvents())
+      ss_->ScheduleDispatcher(this);
+  } else if (GetEpollEvents(enabled_events()) != GetEpollEvents(old_events)) {
     ss_->Update(this);
   }
 }
 
+bool SocketDispatcher::HasPendingEpollEvents() const {
+  return (pending_epoll_events_ &
+          (GetEpollEvents(enabled_events()) | kEpollErrorEvents)) != 0;
+}
+
+void SocketDispatcher::OnWouldBlock(uint8_t events) {
+  pending_epoll_events_ &= ~GetEpollEvents(events);
+}
+
 void SocketDispatcher::SetEnabledEvents(uint8_t events) {
   uint8_t old_events = enabled_events();
   PhysicalSocket::SetEnabledEvents(events);
@@ -1237,6 +1516,11 @@ AsyncSocket* PhysicalSocketServer::WrapSocket(SOCKET s) {
 }
 
 void PhysicalSocketServer::Add(Dispatcher* pdispatcher) {
+  AddDispatcher(pdispatcher, /*edge_triggered=*/false);
+}
+
+void PhysicalSocketServer::AddDispatcher(Dispatcher* pdispatcher,
+                                         bool edge_triggered) {
   CritScope cs(&crit_);
   if (processing_dispatchers_) {
     // A dispatcher is being added while a "Wait" call is processing the
@@ -1250,7 +1534,7 @@ void PhysicalSocketServer::Add(Dispatcher* pdispatcher) {
   }
 #if defined(WEBRTC_USE_EPOLL)
   if (epoll_fd_ != INVALID_SOCKET) {
-    AddEpoll(pdispatcher);
+    AddEpoll(pdispatcher, edge_triggered);
   }
 #endif  // WEBRTC_USE_EPOLL
 }
@@ -1509,7 +1793,8 @@ static const size_t kInitialEpollEvents = 128;
 // Maximum number of events to process with one call to "epoll_wait".
 static const size_t kMaxEpollEvents = 8192;
 
-void PhysicalSocketServer::AddEpoll(Dispatcher* pdispatcher) {
+void PhysicalSocketServer::AddEpoll(Dispatcher* pdispatcher,
+                                    bool edge_triggered) {
   RTC_DCHECK(epoll_fd_ != INVALID_SOCKET);
   int fd = pdispatcher->GetDescriptor();
   RTC_DCHECK(fd != INVALID_SOCKET);
@@ -1518,17 +1803,38 @@ void PhysicalSocketServer::AddEpoll(Dispatcher* pdispatcher) {
   }
 
   struct epoll_event event = {0};
-  event.events = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  event.events = edge_triggered
+                     ? EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET
+                     : GetEpollEvents(pdispatcher->GetRequestedEvents());
   event.data.ptr = pdispatcher;
   int err = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event);
+  epoll_ctl_calls_.fetch_add(1, std::memory_order_relaxed);
   RTC_DCHECK_EQ(err, 0);
   if (err == -1) {
     RTC_LOG_E(LS_ERROR, EN, errno) << "epoll_ctl EPOLL_CTL_ADD";
+    return;
   }
+  epoll_interest_[pdispatcher] = event.events;
 }
 
 void PhysicalSocketServer::RemoveEpoll(Dispatcher* pdispatcher) {
   RTC_DCHECK(epoll_fd_ != INVALID_SOCKET);
+  auto it = epoll_interest_.find(pdispatcher);
+  if (it != epoll_interest_.end()) {
+    if (it->second & EPOLLET) {
+      SocketDispatcher* dispatcher =
+          static_cast<SocketDispatcher*>(pdispatcher);
+      if (dispatcher->scheduled_) {
+        std::replace(scheduled_dispatchers_.begin(),
+                     scheduled_dispatchers_.end(), dispatcher,
+                     static_cast<SocketDispatcher*>(nullptr));
+        dispatcher->scheduled_ = false;
+      }
+      std::replace(dispatching_.begin(), dispatching_.end(), dispatcher,
+                   static_cast<SocketDispatcher*>(nullptr));
+    }
+    epoll_interest_.erase(it);
+  }
   int fd = pdispatcher->GetDescriptor();
   RTC_DCHECK(fd != INVALID_SOCKET);
   if (fd == INVALID_SOCKET) {
@@ -1537,6 +1843,7 @@ void PhysicalSocketServer::RemoveEpoll(Dispatcher* pdispatcher) {
 
   struct epoll_event event = {0};
   int err = epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, &event);
+  epoll_ctl_calls_.fetch_add(1, std::memory_order_relaxed);
   RTC_DCHECK(err == 0 || errno == ENOENT);
   if (err == -1) {
     if (errno == ENOENT) {
@@ -1555,15 +1862,61 @@ void PhysicalSocketServer::UpdateEpoll(Dispatcher* pdispatcher) {
   if (fd == INVALID_SOCKET) {
     return;
   }
+  auto it = epoll_interest_.find(pdispatcher);
+  if (it == epoll_interest_.end() || (it->second & EPOLLET)) {
+    return;
+  }
+  uint32_t events = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  if (events == it->second) {
+    return;
+  }
 
   struct epoll_event event = {0};
-  event.events = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  event.events = events;
   event.data.ptr = pdispatcher;
   int err = epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event);
+  epoll_ctl_calls_.fetch_add(1, std::memory_order_relaxed);
   RTC_DCHECK_EQ(err, 0);
   if (err == -1) {
     RTC_LOG_E(LS_ERROR, EN, errno) << "epoll_ctl EPOLL_CTL_MOD";
+    return;
+  }
+  it->second = events;
+}
+
+void PhysicalSocketServer::ScheduleDispatcher(SocketDispatcher* dispatcher) {
+  CritScope cs(&crit_);
+  if (dispatcher->scheduled_ ||
+      epoll_interest_.find(dispatcher) == epoll_interest_.end()) {
+    return;
   }
+  dispatcher->scheduled_ = true;
+  scheduled_dispatchers_.push_back(dispatcher);
+}
+
+void PhysicalSocketServer::DispatchScheduled() {
+  // Dispatchers scheduled while dispatching are dispatched the next time, so
+  // that epoll is checked in between.
+  RTC_DCHECK(dispatching_.empty());
+  dispatching_.swap(scheduled_dispatchers_);
+  for (size_t i = 0; i < dispatching_.size(); ++i) {
+    SocketDispatcher* dispatcher = dispatching_[i];
+    if (!dispatcher) {
+      continue;
+    }
+    dispatcher->scheduled_ = false;
+    uint32_t events = dispatcher->pending_epoll_events_;
+    // Errors are only reported once, like getsockopt(SO_ERROR) does.
+    dispatcher->pending_epoll_events_ &= ~kEpollErrorEvents;
+    uint32_t requested = GetEpollEvents(dispatcher->GetRequestedEvents());
+    bool readable = (events & requested & EPOLLIN);
+    bool writable = (events & requested & EPOLLOUT);
+    bool check_error = (events & kEpollErrorEvents);
+    // Dispatchers that have pending events afterwards schedule themselves
+    // again.
+    ProcessEvents(dispatcher, readable, writable, check_error);
+  }
+  dispatching_.clear();
 }
 
 bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
@@ -1583,13 +1936,19 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
   fWait_ = true;
 
   while (fWait_) {
+    bool has_scheduled;
+    {
+      CritScope cr(&crit_);
+      has_scheduled = !scheduled_dispatchers_.empty();
+    }
     // Wait then call handlers as appropriate
     // < 0 means error
     // 0 means timeout
     // > 0 means count of descriptors ready
     int n = epoll_wait(epoll_fd_, &epoll_events_[0],
                        static_cast<int>(epoll_events_.size()),
-                       static_cast<int>(tvWait));
+                       has_scheduled ? 0 : static_cast<int>(tvWait));
+    epoll_wait_calls_.fetch_add(1, std::memory_order_relaxed);
     if (n < 0) {
       if (errno != EINTR) {
         RTC_LOG_E(LS_ERROR, EN, errno) << "epoll";
@@ -1599,7 +1958,7 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
       // signals managed by this PhysicalSocketServer, the
       // PosixSignalDeliveryDispatcher will be in the signaled state in the next
       // iteration.
-    } else if (n == 0) {
+    } else if (n == 0 && !has_scheduled) {
       // If timeout, return success
       return true;
     } else {
@@ -1608,17 +1967,29 @@ bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
       for (int i = 0; i < n; ++i) {
         const epoll_event& event = epoll_events_[i];
         Dispatcher* pdispatcher = static_cast<Dispatcher*>(event.data.ptr);
-        if (dispatchers_.find(pdispatcher) == dispatchers_.end()) {
+        auto it = epoll_interest_.find(pdispatcher);
+        if (it == epoll_interest_.end()) {
           // The dispatcher for this socket no longer exists.
           continue;
         }
 
+        if (it->second & EPOLLET) {
+          SocketDispatcher* dispatcher =
+              static_cast<SocketDispatcher*>(pdispatcher);
+          dispatcher->pending_epoll_events_ |= event.events;
+          if (dispatcher->HasPendingEpollEvents()) {
+            ScheduleDispatcher(dispatcher);
+          }
+          continue;
+        }
+
         bool readable = (event.events & (EPOLLIN | EPOLLPRI));
         bool writable = (event.events & EPOLLOUT);
         bool check_error = (event.events & (EPOLLRDHUP | EPOLLERR | EPOLLHUP));
 
         ProcessEvents(pdispatcher, readable, writable, check_error);
       }
+      DispatchScheduled();
     }
 
     if (static_cast<size_t>(n) == epoll_events_.size() &&
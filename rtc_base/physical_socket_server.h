@@ -16,8 +16,10 @@
 #define WEBRTC_USE_EPOLL 1
 #endif
 
+#include <atomic>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <vector>
 
 #include "rtc_base/critical_section.h"
@@ -40,6 +42,7 @@ enum DispatcherEvent {
 };
 
 class Signaler;
+class SocketDispatcher;
 #if defined(WEBRTC_POSIX)
 class PosixSignalDispatcher;
 #endif
@@ -81,6 +84,16 @@ class PhysicalSocketServer : public SocketServer {
   void Remove(Dispatcher* dispatcher);
   void Update(Dispatcher* dispatcher);
 
+#if defined(WEBRTC_USE_EPOLL)
+  // Number of epoll_ctl() and epoll_wait() calls made so far, for profiling.
+  int64_t epoll_ctl_calls() const {
+    return epoll_ctl_calls_.load(std::memory_order_relaxed);
+  }
+  int64_t epoll_wait_calls() const {
+    return epoll_wait_calls_.load(std::memory_order_relaxed);
+  }
+#endif  // WEBRTC_USE_EPOLL
+
 #if defined(WEBRTC_POSIX)
   // Sets the function to be executed in response to the specified POSIX signal.
   // The function is executed from inside Wait() using the "self-pipe trick"--
@@ -99,8 +112,12 @@ class PhysicalSocketServer : public SocketServer {
 #endif
 
  private:
+  friend class SocketDispatcher;
   typedef std::set<Dispatcher*> DispatcherSet;
 
+  // Edge-triggered dispatchers are SocketDispatchers, see
+  // SocketDispatcher::MaybeUpdateDispatcher().
+  void AddDispatcher(Dispatcher* dispatcher, bool edge_triggered);
   void AddRemovePendingDispatchers();
 
 #if defined(WEBRTC_POSIX)
@@ -110,14 +127,27 @@ class PhysicalSocketServer : public SocketServer {
   std::unique_ptr<PosixSignalDispatcher> signal_dispatcher_;
 #endif  // WEBRTC_POSIX
 #if defined(WEBRTC_USE_EPOLL)
-  void AddEpoll(Dispatcher* dispatcher);
+  void AddEpoll(Dispatcher* dispatcher, bool edge_triggered);
   void RemoveEpoll(Dispatcher* dispatcher);
   void UpdateEpoll(Dispatcher* dispatcher);
   bool WaitEpoll(int cms);
   bool WaitPoll(int cms, Dispatcher* dispatcher);
+  // Queues an edge-triggered dispatcher that has enabled events it was
+  // already signaled with, to be dispatched without waiting for epoll.
+  void ScheduleDispatcher(SocketDispatcher* dispatcher);
+  void DispatchScheduled();
 
   int epoll_fd_ = INVALID_SOCKET;
   std::vector<struct epoll_event> epoll_events_;
+  // The epoll events each registered dispatcher is registered for, so that
+  // unchanged registrations aren't updated.
+  std::unordered_map<Dispatcher*, uint32_t> epoll_interest_;
+  std::vector<SocketDispatcher*> scheduled_dispatchers_;
+  // The scheduled dispatchers being dispatched. Entries of dispatchers that
+  // are removed meanwhile are set to null.
+  std::vector<SocketDispatcher*> dispatching_;
+  std::atomic<int64_t> epoll_ctl_calls_{0};
+  std::atomic<int64_t> epoll_wait_calls_{0};
 #endif  // WEBRTC_USE_EPOLL
   DispatcherSet dispatchers_;
   DispatcherSet pending_add_dispatchers_;
@@ -157,12 +187,18 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+  // Uses sendmmsg() for UDP sockets on Linux, or a single UDP GSO send when
+  // the kernel supports it and all datagrams are bound for the same address.
+  int SendToBatch(const DatagramToSend* datagrams, size_t count) override;
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   int RecvFrom(void* buffer,
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+  // Uses recvmmsg() for UDP sockets on Linux, so that a whole batch of
+  // datagrams is read with a single system call.
+  int RecvFromBatch(ReceivedDatagram* datagrams, size_t count) override;
 
   int Listen(int backlog) override;
   AsyncSocket* Accept(SocketAddress* out_addr) override;
@@ -198,7 +234,14 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   virtual void EnableEvents(uint8_t events);
   virtual void DisableEvents(uint8_t events);
 
+  // Called when reading (DE_READ) or writing (DE_WRITE) failed because it
+  // would block.
+  virtual void OnWouldBlock(uint8_t events) {}
+
   static int TranslateOption(Option opt, int* slevel, int* sopt);
+  // Enables the IP_RECVTOS or IPV6_RECVTCLASS control messages that
+  // RecvFromBatch() reads the ECN field from.
+  int SetRecvEcn(bool enable);
 
   PhysicalSocketServer* ss_;
   SOCKET s_;
@@ -214,6 +257,11 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
  private:
   uint8_t enabled_events_ = 0;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Cleared once a GSO send fails because it isn't supported.
+  bool gso_enabled_ = true;
+  bool recv_ecn_ = false;
+#endif
 };
 
 class SocketDispatcher : public Dispatcher, public PhysicalSocket {
@@ -250,6 +298,7 @@ class SocketDispatcher : public Dispatcher, public PhysicalSocket {
   void SetEnabledEvents(uint8_t events) override;
   void EnableEvents(uint8_t events) override;
   void DisableEvents(uint8_t events) override;
+  void OnWouldBlock(uint8_t events) override;
 #endif
 
  private:
@@ -260,9 +309,20 @@ class SocketDispatcher : public Dispatcher, public PhysicalSocket {
   int signal_err_;
 #endif  // WEBRTC_WIN
 #if defined(WEBRTC_USE_EPOLL)
+  friend class PhysicalSocketServer;
+
   void MaybeUpdateDispatcher(uint8_t old_events);
+  // Whether an edge-triggered dispatcher has been signaled with epoll events
+  // that it has enabled, or with an error.
+  bool HasPendingEpollEvents() const;
 
   int saved_enabled_events_ = -1;
+  bool edge_triggered_ = false;
+  // Whether the dispatcher is in the scheduled dispatchers of |ss_|.
+  bool scheduled_ = false;
+  // The epoll events an edge-triggered dispatcher was signaled with, kept
+  // until reading or writing would block.
+  uint32_t pending_epoll_events_ = 0;
 #endif
 };
 
@@ -11,6 +11,9 @@
 #include "rtc_base/physical_socket_server.h"
 
 #include <signal.h>
+#if defined(WEBRTC_POSIX)
+#include <unistd.h>
+#endif
 
 #include <algorithm>
 #include <memory>
@@ -461,6 +464,149 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+// Datagrams queued on a UDP socket are all returned by a single batched read,
+// in order and with the sender's address.
+TEST_F(PhysicalSocketTest, RecvFromBatchReadsQueuedDatagramsIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  const int kNumDatagrams = 3;
+  for (char i = 0; i < kNumDatagrams; ++i) {
+    char payload[] = {i, i, i};
+    ASSERT_EQ(static_cast<int>(sizeof(payload)),
+              sender->SendTo(payload, sizeof(payload),
+                             receiver->GetLocalAddress()));
+  }
+
+  char buffers[4][16];
+  ReceivedDatagram datagrams[4];
+  for (int i = 0; i < 4; ++i) {
+    datagrams[i].buffer = buffers[i];
+    datagrams[i].capacity = sizeof(buffers[i]);
+  }
+  int received = 0;
+  // Loopback delivery is asynchronous, so allow for more than one read.
+  for (int attempt = 0; attempt < 100 && received < kNumDatagrams; ++attempt) {
+    int count = receiver->RecvFromBatch(&datagrams[received], 4 - received);
+    if (count > 0) {
+      received += count;
+    } else {
+      Thread::SleepMs(1);
+    }
+  }
+  ASSERT_EQ(kNumDatagrams, received);
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    EXPECT_EQ(3u, datagrams[i].length);
+    EXPECT_FALSE(datagrams[i].truncated);
+    EXPECT_EQ(i, buffers[i][0]);
+    EXPECT_EQ(sender->GetLocalAddress(), datagrams[i].address);
+  }
+}
+
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+// With OPT_RECV_ECN, batched reads report the ECN field of each datagram, also
+// when reading a single datagram.
+TEST_F(PhysicalSocketTest, RecvFromBatchReportsEcnMarkingIPv4) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, receiver->SetOption(Socket::OPT_RECV_ECN, 1));
+  int enabled = 0;
+  ASSERT_EQ(0, receiver->GetOption(Socket::OPT_RECV_ECN, &enabled));
+  EXPECT_EQ(1, enabled);
+
+  // There is no socket option for marking outgoing packets, so send with a
+  // plain socket.
+  int sender = ::socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_NE(-1, sender);
+  sockaddr_storage receiver_address;
+  socklen_t receiver_address_length = static_cast<socklen_t>(
+      receiver->GetLocalAddress().ToSockAddrStorage(&receiver_address));
+  const EcnMarking kMarkings[] = {EcnMarking::kNotEct, EcnMarking::kEct0,
+                                  EcnMarking::kCe};
+  for (EcnMarking marking : kMarkings) {
+    int tos = static_cast<int>(marking);
+    ASSERT_EQ(0, ::setsockopt(sender, IPPROTO_IP, IP_TOS, &tos, sizeof(tos)));
+    char payload = static_cast<char>(marking);
+    ASSERT_EQ(1, ::sendto(sender, &payload, 1, 0,
+                          reinterpret_cast<sockaddr*>(&receiver_address),
+                          receiver_address_length));
+  }
+  ::close(sender);
+
+  char buffer[16];
+  ReceivedDatagram datagram;
+  datagram.buffer = buffer;
+  datagram.capacity = sizeof(buffer);
+  int received = 0;
+  for (int attempt = 0; attempt < 100 && received < 3; ++attempt) {
+    if (receiver->RecvFromBatch(&datagram, 1) == 1) {
+      EXPECT_EQ(kMarkings[received], datagram.ecn);
+      EXPECT_EQ(static_cast<char>(kMarkings[received]), buffer[0]);
+      ++received;
+    } else {
+      Thread::SleepMs(1);
+    }
+  }
+  EXPECT_EQ(3, received);
+}
+#endif
+
+#if defined(WEBRTC_USE_EPOLL)
+// UDP sockets are registered with epoll once, and their registration isn't
+// updated as reading is disabled and enabled again for each datagram.
+TEST_F(PhysicalSocketTest, UdpSocketsDontUpdateEpollRegistration) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> receiver(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> sender(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, receiver->Bind(SocketAddress(kIPv4Loopback, 0)));
+  ASSERT_EQ(0, sender->Bind(SocketAddress(kIPv4Loopback, 0)));
+  webrtc::testing::StreamSink sink;
+  sink.Monitor(receiver.get());
+
+  const int64_t epoll_ctl_calls = server_->epoll_ctl_calls();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(3, sender->SendTo("foo", 3, receiver->GetLocalAddress()));
+    EXPECT_TRUE_WAIT(sink.Check(receiver.get(), webrtc::testing::SSE_READ),
+                     kTimeout);
+    char buffer[3];
+    EXPECT_EQ(3, receiver->RecvFrom(buffer, sizeof(buffer), nullptr, nullptr));
+    // There is nothing more to read.
+    EXPECT_EQ(-1, receiver->RecvFrom(buffer, sizeof(buffer), nullptr, nullptr));
+    EXPECT_TRUE(receiver->IsBlocking());
+  }
+  EXPECT_EQ(epoll_ctl_calls, server_->epoll_ctl_calls());
+  EXPECT_GT(server_->epoll_wait_calls(), 0);
+}
+#endif
+
+#if defined(WEBRTC_LINUX)
+TEST_F(PhysicalSocketTest, ReusePortLetsSocketsShareAPort) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<AsyncSocket> first(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, first->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, first->Bind(SocketAddress(kIPv4Loopback, 0)));
+
+  std::unique_ptr<AsyncSocket> second(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, second->SetOption(Socket::OPT_REUSEPORT, 1));
+  EXPECT_EQ(0, second->Bind(first->GetLocalAddress()));
+
+  std::unique_ptr<AsyncSocket> third(
+      server_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  EXPECT_EQ(-1, third->Bind(first->GetLocalAddress()));
+}
+#endif
+
 // Verify that if the socket was unable to be bound to a real network interface
 // (not loopback), Bind will return an error.
 TEST_F(PhysicalSocketTest,
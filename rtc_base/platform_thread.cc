@@ -19,6 +19,7 @@
 #include <algorithm>
 
 #include "rtc_base/checks.h"
+#include "rtc_base/memory/allocation_tracker.h"
 
 namespace rtc {
 namespace {
@@ -126,6 +127,9 @@ void PlatformThread::Run() {
   // Attach the worker thread checker to this thread.
   RTC_DCHECK(spawned_thread_checker_.IsCurrent());
   rtc::SetCurrentThreadName(name_.c_str());
+#if defined(WEBRTC_ALLOCATION_TRACKING)
+  AllocationTracker::RegisterCurrentThread(name_.c_str());
+#endif
   SetPriority(priority_);
   run_function_(obj_);
 }
@@ -0,0 +1,214 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/queue_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/time_utils.h"
+
+namespace rtc {
+namespace {
+
+std::atomic<bool> g_enabled{false};
+
+// All live collectors.
+class Registry {
+ public:
+  void Add(QueueStatsCollector* collector) {
+    CritScope lock(&crit_);
+    collectors_.push_back(collector);
+  }
+
+  void Remove(QueueStatsCollector* collector) {
+    CritScope lock(&crit_);
+    auto it = std::find(collectors_.begin(), collectors_.end(), collector);
+    RTC_DCHECK(it != collectors_.end());
+    collectors_.erase(it);
+  }
+
+  std::vector<QueueStats> GetAllStats() const {
+    CritScope lock(&crit_);
+    std::vector<QueueStats> stats;
+    stats.reserve(collectors_.size());
+    for (const QueueStatsCollector* collector : collectors_)
+      stats.push_back(collector->GetStats());
+    return stats;
+  }
+
+ private:
+  CriticalSection crit_;
+  std::vector<QueueStatsCollector*> collectors_ RTC_GUARDED_BY(crit_);
+};
+
+Registry* GetRegistry() {
+  // Never destroyed, since queues may outlive static destruction.
+  static Registry* const registry = new Registry();
+  return registry;
+}
+
+class MeasuredTask : public webrtc::QueuedTask {
+ public:
+  MeasuredTask(QueueStatsCollector* collector,
+               std::unique_ptr<webrtc::QueuedTask> task,
+               int64_t ready_us)
+      : collector_(collector), task_(std::move(task)), ready_us_(ready_us) {}
+
+ private:
+  bool Run() override {
+    bool delete_task;
+    {
+      QueueStatsCollector::ScopedTask scoped_task(collector_, Location(),
+                                                  ready_us_);
+      delete_task = task_->Run();
+    }
+    // A task that returns false has taken over its own ownership.
+    if (!delete_task)
+      task_.release();
+    return true;
+  }
+
+  QueueStatsCollector* const collector_;
+  std::unique_ptr<webrtc::QueuedTask> task_;
+  const int64_t ready_us_;
+};
+
+}  // namespace
+
+void DurationHistogram::Add(int64_t duration_us) {
+  int bucket = 0;
+  while (bucket < kNumBuckets - 1 && duration_us >= (int64_t{1} << bucket))
+    ++bucket;
+  ++buckets[bucket];
+}
+
+int64_t DurationHistogram::Count() const {
+  int64_t count = 0;
+  for (int64_t bucket_count : buckets)
+    count += bucket_count;
+  return count;
+}
+
+int64_t DurationHistogram::PercentileUs(double percentile) const {
+  const int64_t count = Count();
+  if (count == 0)
+    return 0;
+  const int64_t rank = std::max<int64_t>(
+      1, static_cast<int64_t>(count * std::min(percentile, 100.0) / 100));
+  int64_t seen = 0;
+  for (int bucket = 0; bucket < kNumBuckets - 1; ++bucket) {
+    seen += buckets[bucket];
+    if (seen >= rank)
+      return int64_t{1} << bucket;
+  }
+  return int64_t{1} << (kNumBuckets - 2);
+}
+
+void QueueStatsCollector::SetEnabled(bool enabled) {
+  g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool QueueStatsCollector::IsEnabled() {
+  return g_enabled.load(std::memory_order_relaxed);
+}
+
+std::vector<QueueStats> QueueStatsCollector::GetAllStats() {
+  return GetRegistry()->GetAllStats();
+}
+
+QueueStatsCollector::QueueStatsCollector(absl::string_view name)
+    : name_(name) {
+  GetRegistry()->Add(this);
+}
+
+QueueStatsCollector::~QueueStatsCollector() {
+  GetRegistry()->Remove(this);
+}
+
+void QueueStatsCollector::SetName(absl::string_view name) {
+  CritScope lock(&crit_);
+  name_ = std::string(name);
+}
+
+QueueStats QueueStatsCollector::GetStats() const {
+  QueueStats stats;
+  CritScope lock(&crit_);
+  stats.name = name_;
+  stats.tasks = tasks_;
+  stats.cpu_time_us = cpu_time_ns_ / kNumNanosecsPerMicrosec;
+  stats.queueing_delay_us = queueing_delay_us_;
+  stats.run_time_us = run_time_us_;
+  stats.sites.reserve(sites_.size());
+  for (const auto& entry : sites_) {
+    const Site& site = entry.second;
+    TaskSiteStats site_stats;
+    site_stats.location = site.location.ToString();
+    site_stats.tasks = site.tasks;
+    site_stats.total_run_time_us = site.total_run_time_us;
+    site_stats.max_run_time_us = site.max_run_time_us;
+    stats.sites.push_back(std::move(site_stats));
+  }
+  std::sort(stats.sites.begin(), stats.sites.end(),
+            [](const TaskSiteStats& a, const TaskSiteStats& b) {
+              return a.total_run_time_us > b.total_run_time_us;
+            });
+  return stats;
+}
+
+std::unique_ptr<webrtc::QueuedTask> QueueStatsCollector::Wrap(
+    std::unique_ptr<webrtc::QueuedTask> task,
+    uint32_t delay_ms) {
+  if (!IsEnabled())
+    return task;
+  return std::make_unique<MeasuredTask>(
+      this, std::move(task),
+      TimeMicros() + int64_t{delay_ms} * kNumMicrosecsPerMillisec);
+}
+
+void QueueStatsCollector::OnTaskRun(const Location& posted_from,
+                                    int64_t queueing_delay_us,
+                                    int64_t run_time_us,
+                                    int64_t cpu_time_ns) {
+  CritScope lock(&crit_);
+  ++tasks_;
+  cpu_time_ns_ += cpu_time_ns;
+  if (queueing_delay_us >= 0)
+    queueing_delay_us_.Add(queueing_delay_us);
+  run_time_us_.Add(run_time_us);
+  Site& site = sites_[posted_from.file_and_line()];
+  site.location = posted_from;
+  ++site.tasks;
+  site.total_run_time_us += run_time_us;
+  site.max_run_time_us = std::max(site.max_run_time_us, run_time_us);
+}
+
+QueueStatsCollector::ScopedTask::ScopedTask(QueueStatsCollector* collector,
+                                            const Location& posted_from,
+                                            int64_t ready_us)
+    : collector_(collector),
+      posted_from_(posted_from),
+      ready_us_(ready_us),
+      start_us_(TimeMicros()),
+      start_cpu_ns_(GetThreadCpuTimeNanos()) {}
+
+QueueStatsCollector::ScopedTask::~ScopedTask() {
+  const int64_t cpu_time_ns = GetThreadCpuTimeNanos() - start_cpu_ns_;
+  const int64_t run_time_us = TimeMicros() - start_us_;
+  const int64_t queueing_delay_us =
+      ready_us_ < 0 ? -1 : std::max<int64_t>(0, start_us_ - ready_us_);
+  collector_->OnTaskRun(posted_from_, queueing_delay_us, run_time_us,
+                        cpu_time_ns);
+}
+
+}  // namespace rtc
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_QUEUE_STATS_H_
+#define RTC_BASE_QUEUE_STATS_H_
+
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/queued_task.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/location.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Histogram of durations in microseconds. Bucket 0 counts durations below
+// 1 us and bucket i > 0 those in [2^(i-1), 2^i) us, except that the last
+// bucket also counts everything longer.
+struct DurationHistogram {
+  static constexpr int kNumBuckets = 25;
+
+  void Add(int64_t duration_us);
+  int64_t Count() const;
+  // Returns the upper bound of the bucket holding the sample at |percentile|
+  // (0-100), or the lower bound if that is the last bucket. Returns 0 if the
+  // histogram is empty.
+  int64_t PercentileUs(double percentile) const;
+
+  int64_t buckets[kNumBuckets] = {};
+};
+
+// Tasks posted from one source location.
+struct TaskSiteStats {
+  // Location::ToString() of where the tasks were posted. Tasks posted without
+  // a location, e.g. to a TaskQueue, all count towards "Unknown".
+  std::string location;
+  int64_t tasks = 0;
+  int64_t total_run_time_us = 0;
+  int64_t max_run_time_us = 0;
+};
+
+// Load of one thread or task queue since it was created.
+struct QueueStats {
+  std::string name;
+  int64_t tasks = 0;
+  // Thread CPU time spent running tasks.
+  int64_t cpu_time_us = 0;
+  // Time from when a task could have run, i.e. when it was posted or when
+  // its delay expired, until it started running.
+  DurationHistogram queueing_delay_us;
+  DurationHistogram run_time_us;
+  // Sorted by decreasing total run time.
+  std::vector<TaskSiteStats> sites;
+};
+
+// Collects the QueueStats of an rtc::Thread or a task queue. The queue
+// reports each task it runs, on its own thread, and GetStats() may be called
+// from any thread.
+//
+// Collection is off by default, since it reads the wall clock and the thread
+// CPU clock around each task. While it is off, queues skip all of the above.
+class QueueStatsCollector {
+ public:
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled();
+  // Stats of all queues that currently exist.
+  static std::vector<QueueStats> GetAllStats();
+
+  explicit QueueStatsCollector(absl::string_view name);
+  ~QueueStatsCollector();
+
+  void SetName(absl::string_view name);
+  QueueStats GetStats() const;
+
+  // Measures the task run during its lifetime. |ready_us| is the TimeMicros()
+  // at which the task could have run, or -1 if unknown.
+  class ScopedTask {
+   public:
+    ScopedTask(QueueStatsCollector* collector,
+               const Location& posted_from,
+               int64_t ready_us);
+    ~ScopedTask();
+
+   private:
+    QueueStatsCollector* const collector_;
+    const Location posted_from_;
+    const int64_t ready_us_;
+    const int64_t start_us_;
+    const int64_t start_cpu_ns_;
+  };
+
+  // For task queues, which have no place to keep a post time: wraps |task| so
+  // that running it is reported to this collector, if collection is enabled.
+  // The collector must outlive the task.
+  std::unique_ptr<webrtc::QueuedTask> Wrap(
+      std::unique_ptr<webrtc::QueuedTask> task,
+      uint32_t delay_ms = 0);
+
+ private:
+  struct Site {
+    Location location;
+    int64_t tasks = 0;
+    int64_t total_run_time_us = 0;
+    int64_t max_run_time_us = 0;
+  };
+
+  void OnTaskRun(const Location& posted_from,
+                 int64_t queueing_delay_us,
+                 int64_t run_time_us,
+                 int64_t cpu_time_ns);
+
+  CriticalSection crit_;
+  std::string name_ RTC_GUARDED_BY(crit_);
+  int64_t tasks_ RTC_GUARDED_BY(crit_) = 0;
+  int64_t cpu_time_ns_ RTC_GUARDED_BY(crit_) = 0;
+  DurationHistogram queueing_delay_us_ RTC_GUARDED_BY(crit_);
+  DurationHistogram run_time_us_ RTC_GUARDED_BY(crit_);
+  // Keyed by Location::file_and_line(), which points to a string literal.
+  std::unordered_map<const char*, Site> sites_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_QUEUE_STATS_H_
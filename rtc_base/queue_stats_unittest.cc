@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/queue_stats.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+class QueueStatsTest : public ::testing::Test {
+ protected:
+  QueueStatsTest() { QueueStatsCollector::SetEnabled(true); }
+  ~QueueStatsTest() override { QueueStatsCollector::SetEnabled(false); }
+};
+
+class CountingTask : public webrtc::QueuedTask {
+ public:
+  CountingTask(int* runs, bool delete_after_run)
+      : runs_(runs), delete_after_run_(delete_after_run) {}
+
+ private:
+  bool Run() override {
+    ++*runs_;
+    return delete_after_run_;
+  }
+
+  int* const runs_;
+  const bool delete_after_run_;
+};
+
+TEST(DurationHistogramTest, BucketsArePowersOfTwo) {
+  DurationHistogram histogram;
+  histogram.Add(0);
+  histogram.Add(1);
+  histogram.Add(3);
+  histogram.Add(1000);
+  histogram.Add(int64_t{1} << 40);
+  EXPECT_EQ(5, histogram.Count());
+  EXPECT_EQ(1, histogram.buckets[0]);
+  EXPECT_EQ(1, histogram.buckets[1]);
+  EXPECT_EQ(1, histogram.buckets[2]);
+  EXPECT_EQ(1, histogram.buckets[10]);
+  EXPECT_EQ(1, histogram.buckets[DurationHistogram::kNumBuckets - 1]);
+}
+
+TEST(DurationHistogramTest, Percentiles) {
+  DurationHistogram histogram;
+  EXPECT_EQ(0, histogram.PercentileUs(50));
+  for (int i = 0; i < 90; ++i)
+    histogram.Add(10);
+  for (int i = 0; i < 10; ++i)
+    histogram.Add(5000);
+  EXPECT_EQ(16, histogram.PercentileUs(50));
+  EXPECT_EQ(16, histogram.PercentileUs(90));
+  EXPECT_EQ(8192, histogram.PercentileUs(99));
+}
+
+TEST_F(QueueStatsTest, AttributesThreadMessagesToPostLocation) {
+  std::unique_ptr<Thread> thread = Thread::Create();
+  thread->SetName("QueueStatsTest", nullptr);
+  thread->Start();
+  for (int i = 0; i < 10; ++i)
+    thread->Invoke<void>(RTC_FROM_HERE, [] { Thread::SleepMs(1); });
+  thread->Invoke<void>(RTC_FROM_HERE, [] {});
+  thread->Stop();
+
+  QueueStats stats = thread->GetQueueStats();
+  EXPECT_EQ("QueueStatsTest", stats.name);
+  EXPECT_EQ(11, stats.tasks);
+  EXPECT_EQ(11, stats.run_time_us.Count());
+  EXPECT_EQ(11, stats.queueing_delay_us.Count());
+  ASSERT_EQ(2u, stats.sites.size());
+  // The sleeping tasks come first.
+  EXPECT_EQ(10, stats.sites[0].tasks);
+  EXPECT_GE(stats.sites[0].total_run_time_us, 10 * kNumMicrosecsPerMillisec);
+  EXPECT_GE(stats.sites[0].max_run_time_us, kNumMicrosecsPerMillisec);
+  EXPECT_NE(std::string::npos,
+            stats.sites[0].location.find("queue_stats_unittest.cc"));
+  EXPECT_EQ(1, stats.sites[1].tasks);
+
+  bool found = false;
+  for (const QueueStats& queue : QueueStatsCollector::GetAllStats())
+    found |= queue.name == "QueueStatsTest";
+  EXPECT_TRUE(found);
+}
+
+TEST_F(QueueStatsTest, NothingIsCollectedWhileDisabled) {
+  QueueStatsCollector::SetEnabled(false);
+  std::unique_ptr<Thread> thread = Thread::Create();
+  thread->Start();
+  thread->Invoke<void>(RTC_FROM_HERE, [] {});
+  thread->Stop();
+  EXPECT_EQ(0, thread->GetQueueStats().tasks);
+}
+
+TEST_F(QueueStatsTest, WrappedTasksAreMeasured) {
+  QueueStatsCollector collector("queue");
+  int runs = 0;
+  std::unique_ptr<webrtc::QueuedTask> task =
+      collector.Wrap(std::make_unique<CountingTask>(&runs, true));
+  EXPECT_TRUE(task->Run());
+  EXPECT_EQ(1, runs);
+
+  // A task that doesn't want to be deleted keeps doing so when wrapped.
+  auto* reposted = new CountingTask(&runs, false);
+  task = collector.Wrap(std::unique_ptr<webrtc::QueuedTask>(reposted),
+                        /*delay_ms=*/1000);
+  EXPECT_TRUE(task->Run());
+  EXPECT_EQ(2, runs);
+  task.reset();
+  delete reposted;
+
+  QueueStats stats = collector.GetStats();
+  EXPECT_EQ("queue", stats.name);
+  EXPECT_EQ(2, stats.tasks);
+  ASSERT_EQ(1u, stats.sites.size());
+  EXPECT_EQ(Location().ToString(), stats.sites[0].location);
+}
+
+TEST_F(QueueStatsTest, TasksAreNotWrappedWhileDisabled) {
+  QueueStatsCollector::SetEnabled(false);
+  QueueStatsCollector collector("queue");
+  int runs = 0;
+  auto* task = new CountingTask(&runs, true);
+  std::unique_ptr<webrtc::QueuedTask> wrapped =
+      collector.Wrap(std::unique_ptr<webrtc::QueuedTask>(task));
+  EXPECT_EQ(task, wrapped.get());
+}
+
+}  // namespace
+}  // namespace rtc
@@ -10,36 +10,31 @@
 
 #include "rtc_base/rate_statistics.h"
 
-#include <algorithm>
-#include <memory>
+#include <iterator>
 
 #include "rtc_base/checks.h"
 
 namespace webrtc {
 
 RateStatistics::RateStatistics(int64_t window_size_ms, float scale)
-    : buckets_(new Bucket[window_size_ms]()),
-      accumulated_count_(0),
+    : RateStatistics(window_size_ms, scale, 1) {}
+
+RateStatistics::RateStatistics(int64_t window_size_ms,
+                               float scale,
+                               int64_t resolution_ms)
+    : accumulated_count_(0),
       num_samples_(0),
       oldest_time_(-window_size_ms),
-      oldest_index_(0),
       scale_(scale),
       max_window_size_ms_(window_size_ms),
-      current_window_size_ms_(max_window_size_ms_) {}
-
-RateStatistics::RateStatistics(const RateStatistics& other)
-    : accumulated_count_(other.accumulated_count_),
-      num_samples_(other.num_samples_),
-      oldest_time_(other.oldest_time_),
-      oldest_index_(other.oldest_index_),
-      scale_(other.scale_),
-      max_window_size_ms_(other.max_window_size_ms_),
-      current_window_size_ms_(other.current_window_size_ms_) {
-  buckets_ = std::make_unique<Bucket[]>(other.max_window_size_ms_);
-  std::copy(other.buckets_.get(),
-            other.buckets_.get() + other.max_window_size_ms_, buckets_.get());
+      current_window_size_ms_(max_window_size_ms_),
+      resolution_ms_(resolution_ms) {
+  RTC_DCHECK_GE(resolution_ms_, 1);
+  RTC_DCHECK_LE(resolution_ms_, max_window_size_ms_);
 }
 
+RateStatistics::RateStatistics(const RateStatistics& other) = default;
+
 RateStatistics::RateStatistics(RateStatistics&& other) = default;
 
 RateStatistics::~RateStatistics() {}
@@ -48,10 +43,8 @@ void RateStatistics::Reset() {
   accumulated_count_ = 0;
   num_samples_ = 0;
   oldest_time_ = -max_window_size_ms_;
-  oldest_index_ = 0;
   current_window_size_ms_ = max_window_size_ms_;
-  for (int64_t i = 0; i < max_window_size_ms_; i++)
-    buckets_[i] = Bucket();
+  buckets_.clear();
 }
 
 void RateStatistics::Update(size_t count, int64_t now_ms) {
@@ -66,13 +59,21 @@ void RateStatistics::Update(size_t count, int64_t now_ms) {
   if (!IsInitialized())
     oldest_time_ = now_ms;
 
-  uint32_t now_offset = static_cast<uint32_t>(now_ms - oldest_time_);
-  RTC_DCHECK_LT(now_offset, max_window_size_ms_);
-  uint32_t index = oldest_index_ + now_offset;
-  if (index >= max_window_size_ms_)
-    index -= max_window_size_ms_;
-  buckets_[index].sum += count;
-  ++buckets_[index].samples;
+  // Start of the bucket of |now_ms|, rounding towards minus infinity.
+  int64_t timestamp = now_ms - now_ms % resolution_ms_;
+  if (timestamp > now_ms)
+    timestamp -= resolution_ms_;
+
+  // Data points normally come in order and go to the last bucket, or to a new
+  // one after it. Out of order ones are still sorted into their bucket.
+  auto it = buckets_.end();
+  while (it != buckets_.begin() && std::prev(it)->timestamp > timestamp)
+    --it;
+  if (it == buckets_.begin() || std::prev(it)->timestamp != timestamp)
+    it = std::next(buckets_.emplace(it, timestamp));
+  Bucket& bucket = *std::prev(it);
+  bucket.sum += count;
+  ++bucket.samples;
   accumulated_count_ += count;
   ++num_samples_;
 }
@@ -105,17 +106,15 @@ void RateStatistics::EraseOld(int64_t now_ms) {
   if (new_oldest_time <= oldest_time_)
     return;
 
-  // Loop over buckets and remove too old data points.
-  while (num_samples_ > 0 && oldest_time_ < new_oldest_time) {
-    const Bucket& oldest_bucket = buckets_[oldest_index_];
+  // Remove the buckets whose data points are all too old.
+  while (!buckets_.empty() &&
+         buckets_.front().timestamp + resolution_ms_ <= new_oldest_time) {
+    const Bucket& oldest_bucket = buckets_.front();
     RTC_DCHECK_GE(accumulated_count_, oldest_bucket.sum);
     RTC_DCHECK_GE(num_samples_, oldest_bucket.samples);
     accumulated_count_ -= oldest_bucket.sum;
     num_samples_ -= oldest_bucket.samples;
-    buckets_[oldest_index_] = Bucket();
-    if (++oldest_index_ >= max_window_size_ms_)
-      oldest_index_ = 0;
-    ++oldest_time_;
+    buckets_.pop_front();
   }
   oldest_time_ = new_oldest_time;
 }
@@ -14,7 +14,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <memory>
+#include <deque>
 
 #include "absl/types/optional.h"
 
@@ -30,6 +30,14 @@ class RateStatistics {
   // scale = coefficient to convert counts/ms to desired unit
   //         ex: kBpsScale (8000) for bits/s if count represents bytes.
   RateStatistics(int64_t max_window_size_ms, float scale);
+  // Same as above, with the data points counted in buckets of
+  // |resolution_ms|, between 1 and |max_window_size_ms|. A data point leaves
+  // the window together with the most recent data point of its bucket, so up
+  // to |resolution_ms| - 1 ms late, but fewer buckets are stored and erased
+  // when there are many data points per ms.
+  RateStatistics(int64_t max_window_size_ms,
+                 float scale,
+                 int64_t resolution_ms);
 
   RateStatistics(const RateStatistics& other);
 
@@ -59,13 +67,17 @@ class RateStatistics {
   void EraseOld(int64_t now_ms);
   bool IsInitialized() const;
 
-  // Counters are kept in buckets (circular buffer), with one bucket
-  // per millisecond.
+  // Counters are kept in buckets, one per |resolution_ms_| that has seen data
+  // points, ordered by time. Buckets are added at the back and erased at the
+  // front, so updates take amortized constant time and the memory used is
+  // proportional to the number of buckets in the window.
   struct Bucket {
-    size_t sum;      // Sum of all samples in this bucket.
-    size_t samples;  // Number of samples in this bucket.
+    explicit Bucket(int64_t timestamp) : timestamp(timestamp) {}
+    size_t sum = 0;      // Sum of all samples in this bucket.
+    size_t samples = 0;  // Number of samples in this bucket.
+    int64_t timestamp;   // Start time of this bucket, in ms.
   };
-  std::unique_ptr<Bucket[]> buckets_;
+  std::deque<Bucket> buckets_;
 
   // Total count recorded in buckets.
   size_t accumulated_count_;
@@ -73,18 +85,17 @@ class RateStatistics {
   // The total number of samples in the buckets.
   size_t num_samples_;
 
-  // Oldest time recorded in buckets.
+  // Oldest time included in the window.
   int64_t oldest_time_;
 
-  // Bucket index of oldest counter recorded in buckets.
-  uint32_t oldest_index_;
-
   // To convert counts/ms to desired units
   const float scale_;
 
   // The window sizes, in ms, over which the rate is calculated.
   const int64_t max_window_size_ms_;
   int64_t current_window_size_ms_;
+
+  const int64_t resolution_ms_;
 };
 }  // namespace webrtc
 
@@ -11,7 +11,9 @@
 #include "rtc_base/rate_statistics.h"
 
 #include <cstdlib>
+#include <deque>
 
+#include "rtc_base/random.h"
 #include "test/gtest.h"
 
 namespace {
@@ -20,6 +22,76 @@ using webrtc::RateStatistics;
 
 const int64_t kWindowMs = 500;
 
+// Keeps every data point individually, with the window semantics of the
+// original one-bucket-per-millisecond RateStatistics.
+class ReferenceRateStatistics {
+ public:
+  ReferenceRateStatistics(int64_t window_size_ms, float scale)
+      : scale_(scale),
+        max_window_size_ms_(window_size_ms),
+        current_window_size_ms_(window_size_ms),
+        oldest_time_(-window_size_ms) {}
+
+  void Update(size_t count, int64_t now_ms) {
+    if (now_ms < oldest_time_)
+      return;
+    EraseOld(now_ms);
+    if (oldest_time_ == -max_window_size_ms_)
+      oldest_time_ = now_ms;
+    samples_.push_back({now_ms, count});
+  }
+
+  absl::optional<uint32_t> Rate(int64_t now_ms) {
+    EraseOld(now_ms);
+    size_t sum = 0;
+    for (const Sample& sample : samples_)
+      sum += sample.count;
+    int64_t active_window_size = now_ms - oldest_time_ + 1;
+    if (samples_.empty() || active_window_size <= 1 ||
+        (samples_.size() <= 1 &&
+         active_window_size < current_window_size_ms_)) {
+      return absl::nullopt;
+    }
+    float scale = scale_ / active_window_size;
+    return static_cast<uint32_t>(sum * scale + 0.5f);
+  }
+
+  bool SetWindowSize(int64_t window_size_ms, int64_t now_ms) {
+    if (window_size_ms <= 0 || window_size_ms > max_window_size_ms_)
+      return false;
+    current_window_size_ms_ = window_size_ms;
+    EraseOld(now_ms);
+    return true;
+  }
+
+ private:
+  struct Sample {
+    int64_t timestamp;
+    size_t count;
+  };
+
+  void EraseOld(int64_t now_ms) {
+    if (oldest_time_ == -max_window_size_ms_)
+      return;
+    int64_t new_oldest_time = now_ms - current_window_size_ms_ + 1;
+    if (new_oldest_time <= oldest_time_)
+      return;
+    for (auto it = samples_.begin(); it != samples_.end();) {
+      if (it->timestamp < new_oldest_time)
+        it = samples_.erase(it);
+      else
+        ++it;
+    }
+    oldest_time_ = new_oldest_time;
+  }
+
+  const float scale_;
+  const int64_t max_window_size_ms_;
+  int64_t current_window_size_ms_;
+  int64_t oldest_time_;
+  std::deque<Sample> samples_;
+};
+
 class RateStatisticsTest : public ::testing::Test {
  protected:
   RateStatisticsTest() : stats_(kWindowMs, 8000) {}
@@ -278,4 +350,57 @@ TEST_F(RateStatisticsTest, HandlesQuietPeriods) {
   EXPECT_TRUE(static_cast<bool>(bitrate));
   EXPECT_EQ(0u, *bitrate);
 }
+
+TEST(RateStatisticsEquivalenceTest, MatchesReferenceAtMillisecondResolution) {
+  webrtc::Random random(0x1234);
+  RateStatistics stats(kWindowMs, 8000);
+  ReferenceRateStatistics reference(kWindowMs, 8000);
+  int64_t now_ms = 1000;
+  for (int i = 0; i < 20000; ++i) {
+    // Mostly small steps, with the occasional pause, and a few data points
+    // that arrive late.
+    int64_t step_ms = random.Rand(0, 9);
+    if (random.Rand(0, 99) == 0)
+      step_ms = random.Rand(0, 3 * kWindowMs);
+    now_ms += step_ms;
+    int64_t timestamp_ms = now_ms;
+    if (random.Rand(0, 19) == 0)
+      timestamp_ms -= random.Rand(0, kWindowMs);
+    const size_t count = random.Rand(0, 1500);
+    stats.Update(count, timestamp_ms);
+    reference.Update(count, timestamp_ms);
+    if (random.Rand(0, 199) == 0) {
+      const int64_t window_ms = random.Rand(1, kWindowMs);
+      EXPECT_EQ(reference.SetWindowSize(window_ms, now_ms),
+                stats.SetWindowSize(window_ms, now_ms));
+    }
+    EXPECT_EQ(reference.Rate(now_ms), stats.Rate(now_ms)) << "i = " << i;
+  }
+}
+
+TEST(RateStatisticsResolutionTest, CoarseResolutionDelaysExpiry) {
+  const int64_t kResolutionMs = 20;
+  RateStatistics stats(kWindowMs, 8000, kResolutionMs);
+  // One byte per millisecond, 8 kbps.
+  int64_t now_ms = 0;
+  for (; now_ms < kWindowMs; ++now_ms)
+    stats.Update(1, now_ms);
+  absl::optional<uint32_t> bitrate = stats.Rate(now_ms - 1);
+  ASSERT_TRUE(bitrate);
+  EXPECT_EQ(8000u, *bitrate);
+
+  // Data points are dropped a bucket at a time, so the rate is overestimated
+  // by at most one bucket worth of data.
+  for (; now_ms < 3 * kWindowMs; ++now_ms) {
+    stats.Update(1, now_ms);
+    bitrate = stats.Rate(now_ms);
+    ASSERT_TRUE(bitrate);
+    EXPECT_GE(*bitrate, 8000u);
+    EXPECT_LE(*bitrate, 8000u * (kWindowMs + kResolutionMs) / kWindowMs);
+  }
+
+  // Everything is gone once the window has passed the last bucket.
+  EXPECT_FALSE(stats.Rate(now_ms + kWindowMs + kResolutionMs));
+}
+
 }  // namespace
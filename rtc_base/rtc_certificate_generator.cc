@@ -22,6 +22,7 @@
 #include "rtc_base/message_queue.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/ssl_identity.h"
+#include "rtc_base/time_utils.h"
 
 namespace rtc {
 
@@ -48,12 +49,14 @@ class RTCCertificateGenerationTask : public RefCountInterface,
       Thread* worker_thread,
       const KeyParams& key_params,
       const absl::optional<uint64_t>& expires_ms,
-      const scoped_refptr<RTCCertificateGeneratorCallback>& callback)
+      const scoped_refptr<RTCCertificateGeneratorCallback>& callback,
+      const scoped_refptr<RTCCertificate>& certificate = nullptr)
       : signaling_thread_(signaling_thread),
         worker_thread_(worker_thread),
         key_params_(key_params),
         expires_ms_(expires_ms),
-        callback_(callback) {
+        callback_(callback),
+        certificate_(certificate) {
     RTC_DCHECK(signaling_thread_);
     RTC_DCHECK(worker_thread_);
     RTC_DCHECK(callback_);
@@ -100,8 +103,139 @@ class RTCCertificateGenerationTask : public RefCountInterface,
   scoped_refptr<RTCCertificate> certificate_;
 };
 
+// Starts an |RTCCertificateGenerationTask| for |callback|. If |certificate| is
+// set, it is handed to |callback| without generating a new one. The callback
+// is invoked asynchronously on the signaling thread either way.
+void PostGenerationTask(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    const KeyParams& key_params,
+    const absl::optional<uint64_t>& expires_ms,
+    const scoped_refptr<RTCCertificateGeneratorCallback>& callback,
+    const scoped_refptr<RTCCertificate>& certificate = nullptr) {
+  // The task is reference counted and referenced by the message data, ensuring
+  // it lives until it has completed (independent of its creator).
+  ScopedRefMessageData<RTCCertificateGenerationTask>* msg_data =
+      new ScopedRefMessageData<RTCCertificateGenerationTask>(
+          new RefCountedObject<RTCCertificateGenerationTask>(
+              signaling_thread, worker_thread, key_params, expires_ms,
+              callback, certificate));
+  if (certificate) {
+    signaling_thread->Post(RTC_FROM_HERE, msg_data->data().get(),
+                           MSG_GENERATE_DONE, msg_data);
+  } else {
+    worker_thread->Post(RTC_FROM_HERE, msg_data->data().get(), MSG_GENERATE,
+                        msg_data);
+  }
+}
+
+bool KeyParamsEqual(const KeyParams& a, const KeyParams& b) {
+  if (a.type() != b.type())
+    return false;
+  switch (a.type()) {
+    case KT_RSA:
+      return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+             a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+    case KT_ECDSA:
+      return a.ec_curve() == b.ec_curve();
+    default:
+      return false;
+  }
+}
+
 }  // namespace
 
+class RTCCertificatePool::GenerationCallback
+    : public RTCCertificateGeneratorCallback {
+ public:
+  explicit GenerationCallback(const scoped_refptr<RTCCertificatePool>& pool)
+      : pool_(pool) {}
+
+  void OnSuccess(const scoped_refptr<RTCCertificate>& certificate) override {
+    pool_->OnCertificateGenerated(certificate);
+  }
+  void OnFailure() override { pool_->OnGenerationFailed(); }
+
+ private:
+  // Keeps the pool alive until the generation has completed.
+  const scoped_refptr<RTCCertificatePool> pool_;
+};
+
+// static
+scoped_refptr<RTCCertificatePool> RTCCertificatePool::Create(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    const KeyParams& key_params,
+    size_t depth) {
+  scoped_refptr<RTCCertificatePool> pool(
+      new RefCountedObject<RTCCertificatePool>(signaling_thread, worker_thread,
+                                               key_params, depth));
+  pool->Refill();
+  return pool;
+}
+
+RTCCertificatePool::RTCCertificatePool(Thread* signaling_thread,
+                                       Thread* worker_thread,
+                                       const KeyParams& key_params,
+                                       size_t depth)
+    : signaling_thread_(signaling_thread),
+      worker_thread_(worker_thread),
+      key_params_(key_params),
+      depth_(depth) {
+  RTC_DCHECK(signaling_thread_);
+  RTC_DCHECK(worker_thread_);
+}
+
+RTCCertificatePool::~RTCCertificatePool() {}
+
+bool RTCCertificatePool::Matches(const KeyParams& key_params) const {
+  return KeyParamsEqual(key_params_, key_params);
+}
+
+size_t RTCCertificatePool::size() const {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  return certificates_.size();
+}
+
+scoped_refptr<RTCCertificate> RTCCertificatePool::Take() {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  scoped_refptr<RTCCertificate> certificate;
+  uint64_t now = static_cast<uint64_t>(TimeUTCMillis());
+  while (!certificate && !certificates_.empty()) {
+    // Certificates that expired while waiting in the pool are dropped.
+    if (!certificates_.front()->HasExpired(now))
+      certificate = certificates_.front();
+    certificates_.pop_front();
+  }
+  Refill();
+  return certificate;
+}
+
+void RTCCertificatePool::Refill() {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  while (certificates_.size() + pending_generations_ < depth_) {
+    ++pending_generations_;
+    PostGenerationTask(signaling_thread_, worker_thread_, key_params_,
+                       absl::nullopt,
+                       new RefCountedObject<GenerationCallback>(this));
+  }
+}
+
+void RTCCertificatePool::OnCertificateGenerated(
+    const scoped_refptr<RTCCertificate>& certificate) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  RTC_DCHECK_GT(pending_generations_, 0);
+  --pending_generations_;
+  certificates_.push_back(certificate);
+}
+
+void RTCCertificatePool::OnGenerationFailed() {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  RTC_DCHECK_GT(pending_generations_, 0);
+  // Not retried; the next |Take| tries again.
+  --pending_generations_;
+}
+
 // static
 scoped_refptr<RTCCertificate> RTCCertificateGenerator::GenerateCertificate(
     const KeyParams& key_params,
@@ -141,6 +275,17 @@ RTCCertificateGenerator::RTCCertificateGenerator(Thread* signaling_thread,
   RTC_DCHECK(worker_thread_);
 }
 
+RTCCertificateGenerator::RTCCertificateGenerator(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    scoped_refptr<RTCCertificatePool> pool)
+    : signaling_thread_(signaling_thread),
+      worker_thread_(worker_thread),
+      pool_(std::move(pool)) {
+  RTC_DCHECK(signaling_thread_);
+  RTC_DCHECK(worker_thread_);
+}
+
 void RTCCertificateGenerator::GenerateCertificateAsync(
     const KeyParams& key_params,
     const absl::optional<uint64_t>& expires_ms,
@@ -148,16 +293,11 @@ void RTCCertificateGenerator::GenerateCertificateAsync(
   RTC_DCHECK(signaling_thread_->IsCurrent());
   RTC_DCHECK(callback);
 
-  // Create a new |RTCCertificateGenerationTask| for this generation request. It
-  // is reference counted and referenced by the message data, ensuring it lives
-  // until the task has completed (independent of |RTCCertificateGenerator|).
-  ScopedRefMessageData<RTCCertificateGenerationTask>* msg_data =
-      new ScopedRefMessageData<RTCCertificateGenerationTask>(
-          new RefCountedObject<RTCCertificateGenerationTask>(
-              signaling_thread_, worker_thread_, key_params, expires_ms,
-              callback));
-  worker_thread_->Post(RTC_FROM_HERE, msg_data->data().get(), MSG_GENERATE,
-                       msg_data);
+  scoped_refptr<RTCCertificate> certificate;
+  if (pool_ && !expires_ms && pool_->Matches(key_params))
+    certificate = pool_->Take();
+  PostGenerationTask(signaling_thread_, worker_thread_, key_params, expires_ms,
+                     callback, certificate);
 }
 
 }  // namespace rtc
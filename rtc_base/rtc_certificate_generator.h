@@ -11,8 +11,11 @@
 #ifndef RTC_BASE_RTC_CERTIFICATE_GENERATOR_H_
 #define RTC_BASE_RTC_CERTIFICATE_GENERATOR_H_
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <deque>
+
 #include "absl/types/optional.h"
 #include "api/scoped_refptr.h"
 #include "rtc_base/ref_count.h"
@@ -49,6 +52,53 @@ class RTCCertificateGeneratorInterface {
       const scoped_refptr<RTCCertificateGeneratorCallback>& callback) = 0;
 };
 
+// A pool of certificates that are generated ahead of time on the worker
+// thread, so that |RTCCertificateGenerator| can hand one out without waiting
+// for key generation. Every time a certificate is taken, a replacement is
+// generated in the background to keep |depth| certificates ready. Must be used
+// on the signaling thread.
+class RTCCertificatePool : public RefCountInterface {
+ public:
+  static scoped_refptr<RTCCertificatePool> Create(Thread* signaling_thread,
+                                                  Thread* worker_thread,
+                                                  const KeyParams& key_params,
+                                                  size_t depth);
+
+  // True if certificates of this pool can be used for a request with
+  // |key_params| and the default expiration time.
+  bool Matches(const KeyParams& key_params) const;
+  size_t depth() const { return depth_; }
+  // The number of certificates that are ready to be taken.
+  size_t size() const;
+
+  // Returns a pre-generated certificate and starts generating its replacement,
+  // or returns null if none is ready.
+  scoped_refptr<RTCCertificate> Take();
+
+ protected:
+  RTCCertificatePool(Thread* signaling_thread,
+                     Thread* worker_thread,
+                     const KeyParams& key_params,
+                     size_t depth);
+  ~RTCCertificatePool() override;
+
+ private:
+  class GenerationCallback;
+
+  // Starts generating certificates until |depth_| are ready or pending.
+  void Refill();
+  void OnCertificateGenerated(
+      const scoped_refptr<RTCCertificate>& certificate);
+  void OnGenerationFailed();
+
+  Thread* const signaling_thread_;
+  Thread* const worker_thread_;
+  const KeyParams key_params_;
+  const size_t depth_;
+  std::deque<scoped_refptr<RTCCertificate>> certificates_;
+  size_t pending_generations_ = 0;
+};
+
 // Standard implementation of |RTCCertificateGeneratorInterface|.
 // The static function |GenerateCertificate| generates a certificate on the
 // current thread. The |RTCCertificateGenerator| instance generates certificates
@@ -65,6 +115,11 @@ class RTCCertificateGenerator : public RTCCertificateGeneratorInterface {
       const absl::optional<uint64_t>& expires_ms);
 
   RTCCertificateGenerator(Thread* signaling_thread, Thread* worker_thread);
+  // Requests that |pool| can serve are answered with a certificate from it,
+  // when one is ready, instead of generating a new one.
+  RTCCertificateGenerator(Thread* signaling_thread,
+                          Thread* worker_thread,
+                          scoped_refptr<RTCCertificatePool> pool);
   ~RTCCertificateGenerator() override {}
 
   // |RTCCertificateGeneratorInterface| overrides.
@@ -80,6 +135,7 @@ class RTCCertificateGenerator : public RTCCertificateGeneratorInterface {
  private:
   Thread* const signaling_thread_;
   Thread* const worker_thread_;
+  const scoped_refptr<RTCCertificatePool> pool_;
 };
 
 }  // namespace rtc
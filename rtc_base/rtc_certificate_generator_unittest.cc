@@ -34,6 +34,8 @@ class RTCCertificateGeneratorFixture : public RTCCertificateGeneratorCallback {
   }
   ~RTCCertificateGeneratorFixture() override {}
 
+  Thread* signaling_thread() const { return signaling_thread_; }
+  Thread* worker_thread() const { return worker_thread_.get(); }
   RTCCertificateGenerator* generator() const { return generator_.get(); }
   RTCCertificate* certificate() const { return certificate_.get(); }
 
@@ -141,4 +143,31 @@ TEST_F(RTCCertificateGeneratorTest, GenerateWithInvalidParamsShouldFail) {
   EXPECT_FALSE(fixture_->certificate());
 }
 
+TEST_F(RTCCertificateGeneratorTest, GenerateAsyncFromPool) {
+  scoped_refptr<RTCCertificatePool> pool = RTCCertificatePool::Create(
+      fixture_->signaling_thread(), fixture_->worker_thread(),
+      KeyParams::ECDSA(), 2);
+  EXPECT_EQ_WAIT(2u, pool->size(), kGenerationTimeoutMs);
+
+  RTCCertificateGenerator generator(fixture_->signaling_thread(),
+                                    fixture_->worker_thread(), pool);
+  generator.GenerateCertificateAsync(KeyParams::ECDSA(), absl::nullopt,
+                                     fixture_);
+  // The certificate is taken from the pool right away, but the callback is
+  // still invoked asynchronously.
+  EXPECT_EQ(1u, pool->size());
+  EXPECT_FALSE(fixture_->GenerateAsyncCompleted());
+  EXPECT_TRUE_WAIT(fixture_->GenerateAsyncCompleted(), kGenerationTimeoutMs);
+  EXPECT_TRUE(fixture_->certificate());
+  // The pool is refilled in the background.
+  EXPECT_EQ_WAIT(2u, pool->size(), kGenerationTimeoutMs);
+
+  // Requests the pool can't serve generate a new certificate.
+  generator.GenerateCertificateAsync(KeyParams::RSA(), absl::nullopt,
+                                     fixture_);
+  EXPECT_TRUE_WAIT(fixture_->GenerateAsyncCompleted(), kGenerationTimeoutMs);
+  EXPECT_TRUE(fixture_->certificate());
+  EXPECT_EQ(2u, pool->size());
+}
+
 }  // namespace rtc
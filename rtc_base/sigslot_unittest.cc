@@ -10,7 +10,9 @@
 
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
+#include "rtc_base/logging.h"
 #include "rtc_base/sigslot_repeater.h"
+#include "rtc_base/time_utils.h"
 #include "test/gtest.h"
 
 // This function, when passed a has_slots or signalx, will break the build if
@@ -350,6 +352,41 @@ TEST(SigslotTest, CallDisconnectAllWhileSignalFiring) {
   EXPECT_EQ(0, receiver2.signal_count());
 }
 
+// Connects more receivers to a signal while it's firing.
+class Connector : public sigslot::has_slots<> {
+ public:
+  Connector(SigslotReceiver<>* receivers, int count)
+      : receivers_(receivers), count_(count) {}
+
+  void Connect(sigslot::signal<>* signal) {
+    signal_ = signal;
+    signal->connect(this, &Connector::OnSignal);
+  }
+
+ private:
+  void OnSignal() {
+    for (int i = 0; i < count_; ++i)
+      receivers_[i].Connect(signal_);
+  }
+
+  SigslotReceiver<>* const receivers_;
+  const int count_;
+  sigslot::signal<>* signal_ = nullptr;
+};
+
+// Test that slots connected while the signal is firing, which moves the
+// connections out of their inline storage, are called in the same emission.
+TEST(SigslotTest, ConnectToSignalWhileFiring) {
+  sigslot::signal<> signal;
+  SigslotReceiver<> receivers[4];
+  Connector connector(receivers, 4);
+  connector.Connect(&signal);
+  signal();
+
+  for (auto& receiver : receivers)
+    EXPECT_EQ(1, receiver.signal_count());
+}
+
 // Basic test that a sigslot repeater works.
 TEST(SigslotRepeaterTest, RepeatsSignalsAfterRepeatCalled) {
   sigslot::signal<> signal;
@@ -382,3 +419,67 @@ TEST(SigslotRepeaterTest, StopsRepeatingSignalsAfterStopCalled) {
   signal();
   EXPECT_EQ(1, receiver.signal_count());
 }
+
+// One layer of the receive path, e.g. a port or a DTLS transport, which hands
+// each packet on to the next layer.
+template <class mt_policy>
+class PacketRelay : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(const char* data, size_t size, const int64_t& time) {
+    SignalReadPacket(data, size, time);
+  }
+
+  sigslot::signal_with_thread_policy<mt_policy,
+                                     const char*,
+                                     size_t,
+                                     const int64_t&>
+      SignalReadPacket;
+};
+
+class PacketSink : public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(const char* data, size_t size, const int64_t& time) {
+    bytes_ += size;
+  }
+
+  size_t bytes() const { return bytes_; }
+
+ private:
+  size_t bytes_ = 0;
+};
+
+// Returns the time per packet, in nanoseconds, of passing packets through a
+// chain of signals as deep as the receive path: socket, port, connection,
+// transport channel, DTLS transport and SRTP transport.
+template <class mt_policy>
+int64_t MeasureReceiveChainEmitNs(int num_packets) {
+  constexpr int kNumLayers = 6;
+  PacketRelay<mt_policy> layers[kNumLayers];
+  for (int i = 0; i + 1 < kNumLayers; ++i) {
+    layers[i].SignalReadPacket.connect(&layers[i + 1],
+                                       &PacketRelay<mt_policy>::OnReadPacket);
+  }
+  PacketSink sink;
+  layers[kNumLayers - 1].SignalReadPacket.connect(&sink,
+                                                  &PacketSink::OnReadPacket);
+
+  const char packet[1200] = {};
+  const int64_t start_ns = rtc::TimeNanos();
+  for (int i = 0; i < num_packets; ++i)
+    layers[0].SignalReadPacket(packet, sizeof(packet), start_ns);
+  const int64_t elapsed_ns = rtc::TimeNanos() - start_ns;
+  EXPECT_EQ(num_packets * sizeof(packet), sink.bytes());
+  return elapsed_ns / num_packets;
+}
+
+TEST(SigslotTest, DISABLED_ReceiveChainEmitPerf) {
+  constexpr int kNumPackets = 10000000;
+  RTC_LOG(LS_INFO) << "single_threaded: "
+                   << MeasureReceiveChainEmitNs<sigslot::single_threaded>(
+                          kNumPackets)
+                   << " ns per packet.";
+  RTC_LOG(LS_INFO) << "multi_threaded_local: "
+                   << MeasureReceiveChainEmitNs<sigslot::multi_threaded_local>(
+                          kNumPackets)
+                   << " ns per packet.";
+}
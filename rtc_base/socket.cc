@@ -10,4 +10,29 @@
 
 #include "rtc_base/socket.h"
 
-namespace rtc {}  // namespace rtc
+namespace rtc {
+
+int Socket::SendToBatch(const DatagramToSend* datagrams, size_t count) {
+  size_t sent = 0;
+  for (; sent < count; ++sent) {
+    const DatagramToSend& datagram = datagrams[sent];
+    if (SendTo(datagram.data, datagram.length, datagram.address) < 0)
+      return sent == 0 ? -1 : static_cast<int>(sent);
+  }
+  return static_cast<int>(sent);
+}
+
+int Socket::RecvFromBatch(ReceivedDatagram* datagrams, size_t count) {
+  if (count == 0)
+    return 0;
+  ReceivedDatagram& datagram = datagrams[0];
+  int received = RecvFrom(datagram.buffer, datagram.capacity,
+                          &datagram.address, &datagram.timestamp);
+  if (received < 0)
+    return received;
+  datagram.length = static_cast<size_t>(received);
+  datagram.truncated = false;
+  return 1;
+}
+
+}  // namespace rtc
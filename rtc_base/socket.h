@@ -26,6 +26,7 @@
 #endif
 
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/network/ecn_marking.h"
 #include "rtc_base/socket_address.h"
 
 // Rather than converting errors into a private namespace,
@@ -122,6 +123,28 @@ inline bool IsBlockingError(int e) {
   return (e == EWOULDBLOCK) || (e == EAGAIN) || (e == EINPROGRESS);
 }
 
+// Describes a single datagram slot used by Socket::RecvFromBatch(). |buffer|
+// and |capacity| are supplied by the caller; |length|, |address| and
+// |timestamp| are filled in for each datagram that was received.
+struct ReceivedDatagram {
+  void* buffer = nullptr;
+  size_t capacity = 0;
+  size_t length = 0;
+  bool truncated = false;
+  SocketAddress address;
+  // In microseconds, -1 if the socket does not provide receive timestamps.
+  int64_t timestamp = -1;
+  // Only reported with OPT_RECV_ECN enabled, kNotEct otherwise.
+  EcnMarking ecn = EcnMarking::kNotEct;
+};
+
+// Describes a single datagram passed to Socket::SendToBatch().
+struct DatagramToSend {
+  const void* data = nullptr;
+  size_t length = 0;
+  SocketAddress address;
+};
+
 // General interface for the socket implementations of various networks.  The
 // methods match those of normal UNIX sockets very closely.
 class Socket {
@@ -140,12 +163,22 @@ class Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends |count| datagrams, in order, using as few system calls as possible.
+  // Returns the number of datagrams that were sent, or a negative value if
+  // not even the first one could be sent (with the error available through
+  // GetError()). The default implementation calls SendTo() for each datagram.
+  virtual int SendToBatch(const DatagramToSend* datagrams, size_t count);
   // |timestamp| is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   virtual int RecvFrom(void* pv,
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // Receives up to |count| datagrams in one call, one per entry of
+  // |datagrams|. Returns the number of datagrams received, or a negative
+  // value on error (with the error available through GetError()). The default
+  // implementation reads a single datagram using RecvFrom().
+  virtual int RecvFromBatch(ReceivedDatagram* datagrams, size_t count);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -163,6 +196,8 @@ class Socket {
     OPT_NODELAY,               // whether Nagle algorithm is enabled
     OPT_IPV6_V6ONLY,           // Whether the socket is IPv6 only.
     OPT_DSCP,                  // DSCP code
+    OPT_RECV_ECN,              // Whether RecvFromBatch() reports ECN marks.
+    OPT_REUSEPORT,             // Lets sockets share a port; set before Bind.
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
@@ -241,10 +241,10 @@ class SSLAdapterTestDummyServer : public sigslot::has_slots<> {
       int error;
 
       // Read data received from the client and store it in our internal
-      // buffer.
-      rtc::StreamResult r =
-          stream->Read(buffer, sizeof(buffer) - 1, &read, &error);
-      if (r == rtc::SR_SUCCESS) {
+      // buffer. A record may not fit into |buffer|, so read until the stream
+      // blocks.
+      while (stream->Read(buffer, sizeof(buffer) - 1, &read, &error) ==
+             rtc::SR_SUCCESS) {
         buffer[read] = '\0';
         RTC_LOG(LS_INFO) << "Server received '" << buffer << "'";
         data_ += buffer;
@@ -525,6 +525,27 @@ TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSTransferCustomCertVerifier) {
   TestTransfer("Hello, world!");
 }
 
+// Test that a message that spans several TLS records is sent by a single
+// Send(), and that several records are received in batches.
+TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSTransferMultipleRecords) {
+  TestHandshake(true);
+
+  std::string message;
+  for (int i = 0; message.size() < 40000; ++i) {
+    message += "Hello, world: " + rtc::ToString(i) + "\n";
+  }
+  EXPECT_EQ(static_cast<int>(message.size()), client_->Send(message));
+  EXPECT_EQ_WAIT(message, server_->GetReceivedData(), kTimeout);
+
+  std::string expected;
+  for (int i = 0; i < 100; ++i) {
+    std::string record = "Hello, client: " + rtc::ToString(i) + "\n";
+    ASSERT_EQ(static_cast<int>(record.size()), server_->Send(record));
+    expected += record;
+  }
+  EXPECT_EQ_WAIT(expected, client_->GetReceivedData(), kTimeout);
+}
+
 // Test transfer using ALPN with protos as h2 and http/1.1
 TEST_F(SSLAdapterTestTLS_ECDSA, TestTLSALPN) {
   std::vector<std::string> alpn_protos{"h2", "http/1.1"};
@@ -32,6 +32,8 @@ struct SSLCertificateStats {
                       std::string&& base64_certificate,
                       std::unique_ptr<SSLCertificateStats> issuer);
   ~SSLCertificateStats();
+  // Returns a deep copy, including the stats of the issuers.
+  std::unique_ptr<SSLCertificateStats> Copy() const;
   std::string fingerprint;
   std::string fingerprint_algorithm;
   std::string base64_certificate;
@@ -102,6 +102,8 @@ bool SSLStreamAdapter::GetSslCipherSuite(int* cipher_suite) {
   return false;
 }
 
+void SSLStreamAdapter::SetSessionResumptionEnabled(bool enabled) {}
+
 bool SSLStreamAdapter::ExportKeyingMaterial(const std::string& label,
                                             const uint8_t* context,
                                             size_t context_len,
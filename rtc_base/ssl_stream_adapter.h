@@ -147,6 +147,13 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // This should only be called before StartSSL().
   virtual void SetInitialRetransmissionTimeout(int timeout_ms) = 0;
 
+  // Enables resumption of sessions established earlier in this process with
+  // the same local certificate and peer certificate digest, which saves a round
+  // trip and the key exchange when reconnecting to a known peer. The peer
+  // certificate is still verified against the digest. Disabled by default.
+  // This should only be called before StartSSL().
+  virtual void SetSessionResumptionEnabled(bool enabled);
+
   // StartSSL starts negotiation with a peer, whose certificate is verified
   // using the certificate digest. Generally, SetIdentity() and possibly
   // SetServerRole() should have been called before this.
@@ -372,6 +372,28 @@ class SSLStreamAdapterTestBase : public ::testing::Test,
     server_ssl_->SetIdentity(server_identity_);
   }
 
+  // Recreates the client/server streams with the same identities, as when
+  // reconnecting to a known peer.
+  void ResetStreamsWithSameIdentities() {
+    rtc::SSLIdentity* client_identity = client_identity_->GetReference();
+    rtc::SSLIdentity* server_identity = server_identity_->GetReference();
+    client_ssl_.reset(nullptr);
+    server_ssl_.reset(nullptr);
+    CreateStreams();
+
+    client_ssl_.reset(rtc::SSLStreamAdapter::Create(client_stream_));
+    server_ssl_.reset(rtc::SSLStreamAdapter::Create(server_stream_));
+
+    client_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(this, &SSLStreamAdapterTestBase::OnEvent);
+
+    client_identity_ = client_identity;
+    server_identity_ = server_identity;
+    client_ssl_->SetIdentity(client_identity_);
+    server_ssl_->SetIdentity(server_identity_);
+    identities_set_ = false;
+  }
+
   virtual void OnEvent(rtc::StreamInterface* stream, int sig, int err) {
     RTC_LOG(LS_VERBOSE) << "SSLStreamAdapterTestBase::OnEvent sig=" << sig;
 
@@ -793,6 +815,9 @@ class SSLStreamAdapterTestDTLS
         sent_(0) {}
 
   void CreateStreams() override {
+    // Drop anything left over from previous streams, such as close alerts.
+    client_buffer_.Clear();
+    server_buffer_.Clear();
     client_stream_ =
         new SSLDummyStreamDTLS(this, "c2s", &client_buffer_, &server_buffer_);
     server_stream_ =
@@ -1096,6 +1121,29 @@ TEST_P(SSLStreamAdapterTestDTLS, TestDTLSConnect) {
   TestHandshake();
 }
 
+// Test that a reconnection with the same identities works with session
+// resumption, and still verifies the peer certificates.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSessionResumption) {
+  client_ssl_->SetSessionResumptionEnabled(true);
+  server_ssl_->SetSessionResumptionEnabled(true);
+  TestHandshake();
+
+  ResetStreamsWithSameIdentities();
+  client_ssl_->SetSessionResumptionEnabled(true);
+  server_ssl_->SetSessionResumptionEnabled(true);
+  TestHandshake();
+  std::unique_ptr<rtc::SSLCertificate> client_peer_cert =
+      GetPeerCertificate(true);
+  ASSERT_TRUE(client_peer_cert);
+  EXPECT_EQ(server_identity_->certificate().ToPEMString(),
+            client_peer_cert->ToPEMString());
+  std::unique_ptr<rtc::SSLCertificate> server_peer_cert =
+      GetPeerCertificate(false);
+  ASSERT_TRUE(server_peer_cert);
+  EXPECT_EQ(client_identity_->certificate().ToPEMString(),
+            server_peer_cert->ToPEMString());
+}
+
 // Test that we can make a handshake work if the first packet in
 // each direction is lost. This gives us predictable loss
 // rather than having to tune random
@@ -0,0 +1,311 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/adaptive_mutex.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <utility>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+
+#if RTC_ADAPTIVE_MUTEX_USE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace rtc {
+
+class LockSiteStats {
+ public:
+  explicit LockSiteStats(const Location& location) : location_(location) {}
+
+  void AddAcquisition(bool contended, int64_t wait_ns) {
+    acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    if (!contended)
+      return;
+    contended_acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    total_wait_ns_.fetch_add(wait_ns, std::memory_order_relaxed);
+    UpdateMax(&max_wait_ns_, wait_ns);
+  }
+
+  void AddHold(int64_t hold_ns) {
+    total_hold_ns_.fetch_add(hold_ns, std::memory_order_relaxed);
+    UpdateMax(&max_hold_ns_, hold_ns);
+  }
+
+  LockContentionProfiler::SiteStats Get() const {
+    LockContentionProfiler::SiteStats stats;
+    stats.site = location_.ToString();
+    stats.acquisitions = acquisitions_.load(std::memory_order_relaxed);
+    stats.contended_acquisitions =
+        contended_acquisitions_.load(std::memory_order_relaxed);
+    stats.total_wait_ns = total_wait_ns_.load(std::memory_order_relaxed);
+    stats.max_wait_ns = max_wait_ns_.load(std::memory_order_relaxed);
+    stats.total_hold_ns = total_hold_ns_.load(std::memory_order_relaxed);
+    stats.max_hold_ns = max_hold_ns_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  void Reset() {
+    acquisitions_.store(0, std::memory_order_relaxed);
+    contended_acquisitions_.store(0, std::memory_order_relaxed);
+    total_wait_ns_.store(0, std::memory_order_relaxed);
+    max_wait_ns_.store(0, std::memory_order_relaxed);
+    total_hold_ns_.store(0, std::memory_order_relaxed);
+    max_hold_ns_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  static void UpdateMax(std::atomic<int64_t>* max, int64_t value) {
+    int64_t current = max->load(std::memory_order_relaxed);
+    while (value > current &&
+           !max->compare_exchange_weak(current, value,
+                                       std::memory_order_relaxed)) {
+    }
+  }
+
+  const Location location_;
+  std::atomic<int64_t> acquisitions_{0};
+  std::atomic<int64_t> contended_acquisitions_{0};
+  std::atomic<int64_t> total_wait_ns_{0};
+  std::atomic<int64_t> max_wait_ns_{0};
+  std::atomic<int64_t> total_hold_ns_{0};
+  std::atomic<int64_t> max_hold_ns_{0};
+};
+
+namespace {
+
+// Upper bound for the number of spins of a contended Lock().
+constexpr int kMaxSpins = 200;
+
+inline void CpuRelax() {
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || \
+    defined(_M_X64)
+#if defined(_MSC_VER)
+  YieldProcessor();
+#else
+  __builtin_ia32_pause();
+#endif
+#elif defined(__aarch64__) || (defined(__arm__) && __ARM_ARCH >= 7)
+  asm volatile("yield");
+#endif
+}
+
+#if RTC_ADAPTIVE_MUTEX_USE_FUTEX
+void FutexWait(std::atomic<int>* address, int expected) {
+  syscall(SYS_futex, reinterpret_cast<int*>(address), FUTEX_WAIT_PRIVATE,
+          expected, nullptr, nullptr, 0);
+}
+
+void FutexWakeOne(std::atomic<int>* address) {
+  syscall(SYS_futex, reinterpret_cast<int*>(address), FUTEX_WAKE_PRIVATE, 1,
+          nullptr, nullptr, 0);
+}
+#endif
+
+// Lock sites are keyed on the string literals of their location and are
+// never deleted, so that locks can keep pointers to them.
+class SiteRegistry {
+ public:
+  LockSiteStats* Get(const Location& location) {
+    CritScope lock(&lock_);
+    auto key = std::make_pair(location.function_name(),
+                              location.file_and_line());
+    std::unique_ptr<LockSiteStats>& site = sites_[key];
+    if (!site)
+      site = std::make_unique<LockSiteStats>(location);
+    return site.get();
+  }
+
+  std::vector<LockContentionProfiler::SiteStats> GetStats() {
+    std::vector<LockContentionProfiler::SiteStats> stats;
+    CritScope lock(&lock_);
+    for (const auto& site : sites_) {
+      LockContentionProfiler::SiteStats site_stats = site.second->Get();
+      if (site_stats.acquisitions > 0)
+        stats.push_back(std::move(site_stats));
+    }
+    return stats;
+  }
+
+  void Reset() {
+    CritScope lock(&lock_);
+    for (const auto& site : sites_)
+      site.second->Reset();
+  }
+
+ private:
+  CriticalSection lock_;
+  std::map<std::pair<const char*, const char*>, std::unique_ptr<LockSiteStats>>
+      sites_ RTC_GUARDED_BY(lock_);
+};
+
+SiteRegistry* GetSiteRegistry() {
+  static SiteRegistry* const registry = new SiteRegistry();
+  return registry;
+}
+
+}  // namespace
+
+AdaptiveMutex::AdaptiveMutex() : site_stats_(nullptr) {
+#if !RTC_ADAPTIVE_MUTEX_USE_FUTEX && !defined(WEBRTC_WIN)
+  pthread_mutex_init(&mutex_, nullptr);
+#endif
+}
+
+AdaptiveMutex::AdaptiveMutex(const Location& location)
+    : site_stats_(LockContentionProfiler::GetSiteStats(location)) {
+#if !RTC_ADAPTIVE_MUTEX_USE_FUTEX && !defined(WEBRTC_WIN)
+  pthread_mutex_init(&mutex_, nullptr);
+#endif
+}
+
+AdaptiveMutex::~AdaptiveMutex() {
+#if RTC_ADAPTIVE_MUTEX_USE_FUTEX
+  RTC_DCHECK_EQ(0, state_.load(std::memory_order_relaxed));
+#elif !defined(WEBRTC_WIN)
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+
+void AdaptiveMutex::Lock() {
+  if (TryLockNative()) {
+    OnAcquired(0);
+    return;
+  }
+  const int64_t wait_start_ns =
+      site_stats_ && LockContentionProfiler::IsEnabled() ? TimeNanos() : 0;
+  LockSlow();
+  OnAcquired(wait_start_ns);
+}
+
+bool AdaptiveMutex::TryLock() {
+  if (!TryLockNative())
+    return false;
+  OnAcquired(0);
+  return true;
+}
+
+void AdaptiveMutex::Unlock() {
+  if (acquired_at_ns_ != 0) {
+    site_stats_->AddHold(TimeNanos() - acquired_at_ns_);
+    acquired_at_ns_ = 0;
+  }
+  UnlockNative();
+}
+
+void AdaptiveMutex::OnAcquired(int64_t wait_start_ns) {
+  if (!site_stats_ || !LockContentionProfiler::IsEnabled())
+    return;
+  acquired_at_ns_ = TimeNanos();
+  site_stats_->AddAcquisition(wait_start_ns != 0,
+                              acquired_at_ns_ - wait_start_ns);
+}
+
+void AdaptiveMutex::LockSlow() {
+  // Spin up to twice as long as contended calls needed recently, so that
+  // locks that are held for long stop spinning, and ones that are released
+  // quickly don't put threads to sleep.
+  const int estimate = spin_estimate_.load(std::memory_order_relaxed);
+  const int max_spins = std::min(kMaxSpins, 2 * estimate + 10);
+  int spins = 0;
+  for (; spins < max_spins; ++spins) {
+    CpuRelax();
+    if (TryLockNative()) {
+      spin_estimate_.store(estimate + (spins - estimate) / 8,
+                           std::memory_order_relaxed);
+      return;
+    }
+  }
+  spin_estimate_.store(estimate + (max_spins - estimate) / 8,
+                       std::memory_order_relaxed);
+
+#if RTC_ADAPTIVE_MUTEX_USE_FUTEX
+  // Mark the lock as having waiters, then sleep until it's released.
+  int state = state_.exchange(2, std::memory_order_acquire);
+  while (state != 0) {
+    FutexWait(&state_, 2);
+    state = state_.exchange(2, std::memory_order_acquire);
+  }
+#elif defined(WEBRTC_WIN)
+  AcquireSRWLockExclusive(&lock_);
+#else
+  pthread_mutex_lock(&mutex_);
+#endif
+}
+
+bool AdaptiveMutex::TryLockNative() {
+#if RTC_ADAPTIVE_MUTEX_USE_FUTEX
+  int expected = 0;
+  return state_.load(std::memory_order_relaxed) == 0 &&
+         state_.compare_exchange_strong(expected, 1,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed);
+#elif defined(WEBRTC_WIN)
+  return TryAcquireSRWLockExclusive(&lock_) != FALSE;
+#else
+  return pthread_mutex_trylock(&mutex_) == 0;
+#endif
+}
+
+void AdaptiveMutex::UnlockNative() {
+#if RTC_ADAPTIVE_MUTEX_USE_FUTEX
+  if (state_.exchange(0, std::memory_order_release) == 2)
+    FutexWakeOne(&state_);
+#elif defined(WEBRTC_WIN)
+  ReleaseSRWLockExclusive(&lock_);
+#else
+  pthread_mutex_unlock(&mutex_);
+#endif
+}
+
+std::atomic<bool> LockContentionProfiler::enabled_{false};
+
+void LockContentionProfiler::SetEnabled(bool enabled) {
+  enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+std::vector<LockContentionProfiler::SiteStats>
+LockContentionProfiler::GetStats() {
+  std::vector<SiteStats> stats = GetSiteRegistry()->GetStats();
+  std::sort(stats.begin(), stats.end(),
+            [](const SiteStats& a, const SiteStats& b) {
+              return a.total_wait_ns > b.total_wait_ns;
+            });
+  return stats;
+}
+
+std::string LockContentionProfiler::Report() {
+  rtc::StringBuilder sb;
+  for (const SiteStats& stats : GetStats()) {
+    sb << stats.site << ": acquisitions=" << stats.acquisitions
+       << " contended=" << stats.contended_acquisitions
+       << " wait_ns(total/max)=" << stats.total_wait_ns << "/"
+       << stats.max_wait_ns << " hold_ns(total/max)=" << stats.total_hold_ns
+       << "/" << stats.max_hold_ns << "\n";
+  }
+  return sb.Release();
+}
+
+void LockContentionProfiler::Reset() {
+  GetSiteRegistry()->Reset();
+}
+
+LockSiteStats* LockContentionProfiler::GetSiteStats(const Location& location) {
+  return GetSiteRegistry()->Get(location);
+}
+
+}  // namespace rtc
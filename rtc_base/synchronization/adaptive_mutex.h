@@ -0,0 +1,138 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_SYNCHRONIZATION_ADAPTIVE_MUTEX_H_
+#define RTC_BASE_SYNCHRONIZATION_ADAPTIVE_MUTEX_H_
+
+#include <stdint.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "rtc_base/constructor_magic.h"
+#include "rtc_base/location.h"
+#include "rtc_base/thread_annotations.h"
+
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+#define RTC_ADAPTIVE_MUTEX_USE_FUTEX 1
+#else
+#define RTC_ADAPTIVE_MUTEX_USE_FUTEX 0
+#endif
+
+#if !RTC_ADAPTIVE_MUTEX_USE_FUTEX
+#if defined(WEBRTC_WIN)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+namespace rtc {
+
+class LockSiteStats;
+
+// Non-reentrant mutex for short critical sections, as an alternative to
+// CriticalSection for hot locks. A contended Lock() first spins for a while,
+// adapting the number of spins to how long it took to get the lock
+// previously, before the thread goes to sleep (on a futex on Linux and
+// Android). Locks constructed with a location report their contention to
+// LockContentionProfiler while it is enabled.
+class RTC_LOCKABLE AdaptiveMutex {
+ public:
+  AdaptiveMutex();
+  // |location| identifies the lock site in profiler reports; typically
+  // RTC_FROM_HERE where the lock is constructed.
+  explicit AdaptiveMutex(const Location& location);
+  ~AdaptiveMutex();
+
+  void Lock() RTC_EXCLUSIVE_LOCK_FUNCTION();
+  bool TryLock() RTC_EXCLUSIVE_TRYLOCK_FUNCTION(true);
+  void Unlock() RTC_UNLOCK_FUNCTION();
+
+ private:
+  bool TryLockNative();
+  void LockSlow();
+  void UnlockNative();
+  void OnAcquired(int64_t wait_start_ns);
+
+#if RTC_ADAPTIVE_MUTEX_USE_FUTEX
+  // 0: unlocked, 1: locked, 2: locked and there may be sleeping waiters.
+  std::atomic<int> state_{0};
+#elif defined(WEBRTC_WIN)
+  SRWLOCK lock_ = SRWLOCK_INIT;
+#else
+  pthread_mutex_t mutex_;
+#endif
+  // Moving average of the number of spins contended Lock() calls needed.
+  std::atomic<int> spin_estimate_{0};
+
+  LockSiteStats* const site_stats_;
+  // When the current owner acquired the lock, while profiled. Only accessed
+  // by the owner.
+  int64_t acquired_at_ns_ = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AdaptiveMutex);
+};
+
+class RTC_SCOPED_LOCKABLE AdaptiveMutexLock {
+ public:
+  explicit AdaptiveMutexLock(AdaptiveMutex* mutex)
+      RTC_EXCLUSIVE_LOCK_FUNCTION(mutex)
+      : mutex_(mutex) {
+    mutex_->Lock();
+  }
+  ~AdaptiveMutexLock() RTC_UNLOCK_FUNCTION() { mutex_->Unlock(); }
+
+ private:
+  AdaptiveMutex* const mutex_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(AdaptiveMutexLock);
+};
+
+// Collects, per lock site, how often AdaptiveMutexes constructed with a
+// location were acquired, how long threads waited for them and how long they
+// were held. Disabled by default; when disabled, profiled locks only pay for
+// checking whether it is enabled.
+class LockContentionProfiler {
+ public:
+  struct SiteStats {
+    // Function and file:line of the lock site.
+    std::string site;
+    int64_t acquisitions = 0;
+    int64_t contended_acquisitions = 0;
+    int64_t total_wait_ns = 0;
+    int64_t max_wait_ns = 0;
+    int64_t total_hold_ns = 0;
+    int64_t max_hold_ns = 0;
+  };
+
+  static void SetEnabled(bool enabled);
+  static bool IsEnabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  // Returns the stats of all lock sites that were acquired while profiling,
+  // sorted by decreasing total wait time.
+  static std::vector<SiteStats> GetStats();
+  // Human readable table of GetStats(), one lock site per line.
+  static std::string Report();
+  static void Reset();
+
+ private:
+  friend class AdaptiveMutex;
+
+  static LockSiteStats* GetSiteStats(const Location& location);
+
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_SYNCHRONIZATION_ADAPTIVE_MUTEX_H_
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/synchronization/adaptive_mutex.h"
+
+#include <thread>  // Not allowed in production per Chromium style guide.
+#include <vector>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+constexpr int kNumThreads = 4;
+
+template <typename LockFunction>
+int64_t RunContended(int iterations_per_thread, LockFunction lock_and_work) {
+  int64_t start_us = TimeMicros();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < iterations_per_thread; ++j)
+        lock_and_work();
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+  return TimeMicros() - start_us;
+}
+
+TEST(AdaptiveMutexTest, ProvidesMutualExclusion) {
+  static constexpr int kIterations = 100000;
+  AdaptiveMutex mutex;
+  int counter = 0;
+  RunContended(kIterations, [&] {
+    AdaptiveMutexLock lock(&mutex);
+    ++counter;
+  });
+  EXPECT_EQ(kNumThreads * kIterations, counter);
+}
+
+TEST(AdaptiveMutexTest, TryLockFailsWhileHeld) {
+  AdaptiveMutex mutex;
+  mutex.Lock();
+  bool acquired = true;
+  std::thread other([&] { acquired = mutex.TryLock(); });
+  other.join();
+  EXPECT_FALSE(acquired);
+  mutex.Unlock();
+
+  ASSERT_TRUE(mutex.TryLock());
+  mutex.Unlock();
+}
+
+TEST(AdaptiveMutexTest, ProfilerReportsContentionBySite) {
+  LockContentionProfiler::Reset();
+  LockContentionProfiler::SetEnabled(true);
+  const Location location = RTC_FROM_HERE;
+  AdaptiveMutex mutex(location);
+
+  Event locked;
+  std::thread holder([&] {
+    AdaptiveMutexLock lock(&mutex);
+    locked.Set();
+    // Hold the lock for a while.
+    Event never_set;
+    never_set.Wait(20);
+  });
+  locked.Wait(Event::kForever);
+  { AdaptiveMutexLock lock(&mutex); }
+  holder.join();
+  LockContentionProfiler::SetEnabled(false);
+
+  bool found = false;
+  for (const LockContentionProfiler::SiteStats& stats :
+       LockContentionProfiler::GetStats()) {
+    if (stats.site != location.ToString())
+      continue;
+    found = true;
+    EXPECT_EQ(2, stats.acquisitions);
+    EXPECT_EQ(1, stats.contended_acquisitions);
+    EXPECT_GT(stats.max_wait_ns, 0);
+    EXPECT_GE(stats.max_hold_ns, 10 * kNumNanosecsPerMillisec);
+  }
+  EXPECT_TRUE(found);
+  EXPECT_FALSE(LockContentionProfiler::Report().empty());
+}
+
+TEST(AdaptiveMutexTest, DISABLED_ShortCriticalSectionPerf) {
+  static constexpr int kIterations = 1000000;
+  int counter = 0;
+
+  CriticalSection crit;
+  int64_t crit_us = RunContended(kIterations, [&] {
+    CritScope lock(&crit);
+    ++counter;
+  });
+
+  AdaptiveMutex mutex;
+  int64_t mutex_us = RunContended(kIterations, [&] {
+    AdaptiveMutexLock lock(&mutex);
+    ++counter;
+  });
+
+  EXPECT_EQ(2 * kNumThreads * kIterations, counter);
+  RTC_LOG(LS_INFO) << kNumThreads << " threads x " << kIterations
+                   << " lock/unlock: CriticalSection " << crit_us
+                   << " us, AdaptiveMutex " << mutex_us << " us.";
+}
+
+}  // namespace
+}  // namespace rtc
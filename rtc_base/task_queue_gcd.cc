@@ -24,6 +24,7 @@
 #include "api/task_queue/task_queue_base.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/queue_stats.h"
 
 namespace webrtc {
 namespace {
@@ -64,12 +65,14 @@ class TaskQueueGcd : public TaskQueueBase {
 
   dispatch_queue_t queue_;
   bool is_active_;
+  rtc::QueueStatsCollector stats_;
 };
 
 TaskQueueGcd::TaskQueueGcd(absl::string_view queue_name, int gcd_priority)
     : queue_(dispatch_queue_create(std::string(queue_name).c_str(),
                                    DISPATCH_QUEUE_SERIAL)),
-      is_active_(true) {
+      is_active_(true),
+      stats_(queue_name) {
   RTC_CHECK(queue_);
   dispatch_set_context(queue_, this);
   // Assign a finalizer that will delete the queue when the last reference
@@ -97,13 +100,14 @@ void TaskQueueGcd::Delete() {
 }
 
 void TaskQueueGcd::PostTask(std::unique_ptr<QueuedTask> task) {
-  auto* context = new TaskContext(this, std::move(task));
+  auto* context = new TaskContext(this, stats_.Wrap(std::move(task)));
   dispatch_async_f(queue_, context, &RunTask);
 }
 
 void TaskQueueGcd::PostDelayedTask(std::unique_ptr<QueuedTask> task,
                                    uint32_t milliseconds) {
-  auto* context = new TaskContext(this, std::move(task));
+  auto* context =
+      new TaskContext(this, stats_.Wrap(std::move(task), milliseconds));
   dispatch_after_f(
       dispatch_time(DISPATCH_TIME_NOW, milliseconds * NSEC_PER_MSEC), queue_,
       context, &RunTask);
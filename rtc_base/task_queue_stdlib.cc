@@ -13,20 +13,21 @@
 #include <string.h>
 
 #include <algorithm>
-#include <map>
+#include <atomic>
 #include <memory>
 #include <queue>
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "api/task_queue/queued_task.h"
 #include "api/task_queue/task_queue_base.h"
 #include "rtc_base/checks.h"
-#include "rtc_base/critical_section.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/platform_thread.h"
-#include "rtc_base/thread_annotations.h"
+#include "rtc_base/queue_stats.h"
 #include "rtc_base/time_utils.h"
 
 namespace webrtc {
@@ -47,6 +48,138 @@ rtc::ThreadPriority TaskQueuePriorityToThreadPriority(
   }
 }
 
+using OrderId = uint64_t;
+
+// Intrusive multi-producer single-consumer queue of posted tasks. Push() is
+// lock-free and may be called from any thread, Pop() only from the task
+// queue's thread. Pop() may return null while a Push() is in progress; the
+// posting thread wakes the task queue's thread up once it is done.
+class IncomingTaskQueue {
+ public:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    OrderId order{};
+    bool delayed{false};
+    int64_t next_fire_at_ms{};
+    std::unique_ptr<QueuedTask> task;
+  };
+
+  IncomingTaskQueue() : head_(&stub_), tail_(&stub_) {}
+  ~IncomingTaskQueue() {
+    while (Node* node = Pop())
+      delete node;
+  }
+
+  void Push(Node* node) {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  Node* Pop() {
+    Node* tail = tail_;
+    Node* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (!next)
+        return nullptr;
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire))
+      return nullptr;
+    Push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+ private:
+  Node stub_;
+  std::atomic<Node*> head_;
+  Node* tail_;
+};
+
+// 4-ary min-heap of delayed tasks, ordered by fire time and then by posting
+// order. Unlike std::priority_queue it allows moving the earliest task out,
+// and unlike std::map it doesn't allocate per task.
+class DelayedTaskHeap {
+ public:
+  struct Entry {
+    int64_t next_fire_at_ms{};
+    OrderId order{};
+    std::unique_ptr<QueuedTask> task;
+
+    bool operator<(const Entry& o) const {
+      return std::tie(next_fire_at_ms, order) <
+             std::tie(o.next_fire_at_ms, o.order);
+    }
+  };
+
+  bool empty() const { return entries_.empty(); }
+  const Entry& top() const { return entries_.front(); }
+
+  void Push(Entry entry) {
+    entries_.push_back(std::move(entry));
+    SiftUp(entries_.size() - 1);
+  }
+
+  Entry Pop() {
+    Entry result = std::move(entries_.front());
+    if (entries_.size() > 1)
+      entries_.front() = std::move(entries_.back());
+    entries_.pop_back();
+    if (!entries_.empty())
+      SiftDown(0);
+    return result;
+  }
+
+ private:
+  static constexpr size_t kArity = 4;
+
+  void SiftUp(size_t index) {
+    Entry entry = std::move(entries_[index]);
+    while (index > 0) {
+      size_t parent = (index - 1) / kArity;
+      if (!(entry < entries_[parent]))
+        break;
+      entries_[index] = std::move(entries_[parent]);
+      index = parent;
+    }
+    entries_[index] = std::move(entry);
+  }
+
+  void SiftDown(size_t index) {
+    Entry entry = std::move(entries_[index]);
+    const size_t size = entries_.size();
+    while (true) {
+      size_t first_child = index * kArity + 1;
+      if (first_child >= size)
+        break;
+      size_t last_child = std::min(first_child + kArity, size);
+      size_t smallest = first_child;
+      for (size_t child = first_child + 1; child < last_child; ++child) {
+        if (entries_[child] < entries_[smallest])
+          smallest = child;
+      }
+      if (!(entries_[smallest] < entry))
+        break;
+      entries_[index] = std::move(entries_[smallest]);
+      index = smallest;
+    }
+    entries_[index] = std::move(entry);
+  }
+
+  std::vector<Entry> entries_;
+};
+
 class TaskQueueStdlib final : public TaskQueueBase {
  public:
   TaskQueueStdlib(absl::string_view queue_name, rtc::ThreadPriority priority);
@@ -58,18 +191,6 @@ class TaskQueueStdlib final : public TaskQueueBase {
                        uint32_t milliseconds) override;
 
  private:
-  using OrderId = uint64_t;
-
-  struct DelayedEntryTimeout {
-    int64_t next_fire_at_ms_{};
-    OrderId order_{};
-
-    bool operator<(const DelayedEntryTimeout& o) const {
-      return std::tie(next_fire_at_ms_, order_) <
-             std::tie(o.next_fire_at_ms_, o.order_);
-    }
-  };
-
   struct NextTask {
     bool final_task_{false};
     std::unique_ptr<QueuedTask> run_task_;
@@ -78,6 +199,10 @@ class TaskQueueStdlib final : public TaskQueueBase {
 
   NextTask GetNextTask();
 
+  // Moves the tasks posted from other threads to |pending_queue_| and
+  // |delayed_queue_|.
+  void DrainIncomingTasks();
+
   static void ThreadMain(void* context);
 
   void ProcessTasks();
@@ -97,28 +222,31 @@ class TaskQueueStdlib final : public TaskQueueBase {
   // tasks (including delayed tasks).
   rtc::PlatformThread thread_;
 
-  rtc::CriticalSection pending_lock_;
-
   // Indicates if the worker thread needs to shutdown now.
-  bool thread_should_quit_ RTC_GUARDED_BY(pending_lock_){false};
+  std::atomic<bool> thread_should_quit_{false};
 
   // Holds the next order to use for the next task to be
   // put into one of the pending queues.
-  OrderId thread_posting_order_ RTC_GUARDED_BY(pending_lock_){};
+  std::atomic<OrderId> thread_posting_order_{0};
+
+  // Tasks posted but not yet picked up by the worker thread. Delayed tasks
+  // posted from the worker thread itself, e.g. by repeating tasks
+  // rescheduling themselves, skip this queue.
+  IncomingTaskQueue incoming_queue_;
 
   // The list of all pending tasks that need to be processed in the
-  // FIFO queue ordering on the worker thread.
-  std::queue<std::pair<OrderId, std::unique_ptr<QueuedTask>>> pending_queue_
-      RTC_GUARDED_BY(pending_lock_);
+  // FIFO queue ordering on the worker thread. Only accessed on the worker
+  // thread.
+  std::queue<std::pair<OrderId, std::unique_ptr<QueuedTask>>> pending_queue_;
 
   // The list of all pending tasks that need to be processed at a future
   // time based upon a delay. On the off change the delayed task should
   // happen at exactly the same time interval as another task then the
-  // task is processed based on FIFO ordering. std::priority_queue was
-  // considered but rejected due to its inability to extract the
-  // std::unique_ptr out of the queue without the presence of a hack.
-  std::map<DelayedEntryTimeout, std::unique_ptr<QueuedTask>> delayed_queue_
-      RTC_GUARDED_BY(pending_lock_);
+  // task is processed based on FIFO ordering. Only accessed on the worker
+  // thread.
+  DelayedTaskHeap delayed_queue_;
+
+  rtc::QueueStatsCollector stats_;
 };
 
 TaskQueueStdlib::TaskQueueStdlib(absl::string_view queue_name,
@@ -126,7 +254,8 @@ TaskQueueStdlib::TaskQueueStdlib(absl::string_view queue_name,
     : started_(/*manual_reset=*/false, /*initially_signaled=*/false),
       stopped_(/*manual_reset=*/false, /*initially_signaled=*/false),
       flag_notify_(/*manual_reset=*/false, /*initially_signaled=*/false),
-      thread_(&TaskQueueStdlib::ThreadMain, this, queue_name, priority) {
+      thread_(&TaskQueueStdlib::ThreadMain, this, queue_name, priority),
+      stats_(queue_name) {
   thread_.Start();
   started_.Wait(rtc::Event::kForever);
 }
@@ -134,10 +263,7 @@ TaskQueueStdlib::TaskQueueStdlib(absl::string_view queue_name,
 void TaskQueueStdlib::Delete() {
   RTC_DCHECK(!IsCurrent());
 
-  {
-    rtc::CritScope lock(&pending_lock_);
-    thread_should_quit_ = true;
-  }
+  thread_should_quit_.store(true);
 
   NotifyWake();
 
@@ -147,13 +273,10 @@ void TaskQueueStdlib::Delete() {
 }
 
 void TaskQueueStdlib::PostTask(std::unique_ptr<QueuedTask> task) {
-  {
-    rtc::CritScope lock(&pending_lock_);
-    OrderId order = thread_posting_order_++;
-
-    pending_queue_.push(std::pair<OrderId, std::unique_ptr<QueuedTask>>(
-        order, std::move(task)));
-  }
+  auto* node = new IncomingTaskQueue::Node();
+  node->order = thread_posting_order_.fetch_add(1);
+  node->task = stats_.Wrap(std::move(task));
+  incoming_queue_.Push(node);
 
   NotifyWake();
 }
@@ -161,53 +284,75 @@ void TaskQueueStdlib::PostTask(std::unique_ptr<QueuedTask> task) {
 void TaskQueueStdlib::PostDelayedTask(std::unique_ptr<QueuedTask> task,
                                       uint32_t milliseconds) {
   auto fire_at = rtc::TimeMillis() + milliseconds;
-
-  DelayedEntryTimeout delay;
-  delay.next_fire_at_ms_ = fire_at;
-
-  {
-    rtc::CritScope lock(&pending_lock_);
-    delay.order_ = ++thread_posting_order_;
-    delayed_queue_[delay] = std::move(task);
+  task = stats_.Wrap(std::move(task), milliseconds);
+
+  if (IsCurrent()) {
+    // The worker thread looks at |delayed_queue_| again before waiting, so
+    // there's no need to wake it up.
+    DelayedTaskHeap::Entry entry;
+    entry.next_fire_at_ms = fire_at;
+    entry.order = thread_posting_order_.fetch_add(1);
+    entry.task = std::move(task);
+    delayed_queue_.Push(std::move(entry));
+    return;
   }
 
+  auto* node = new IncomingTaskQueue::Node();
+  node->order = thread_posting_order_.fetch_add(1);
+  node->delayed = true;
+  node->next_fire_at_ms = fire_at;
+  node->task = std::move(task);
+  incoming_queue_.Push(node);
+
   NotifyWake();
 }
 
+void TaskQueueStdlib::DrainIncomingTasks() {
+  while (IncomingTaskQueue::Node* node = incoming_queue_.Pop()) {
+    if (node->delayed) {
+      DelayedTaskHeap::Entry entry;
+      entry.next_fire_at_ms = node->next_fire_at_ms;
+      entry.order = node->order;
+      entry.task = std::move(node->task);
+      delayed_queue_.Push(std::move(entry));
+    } else {
+      pending_queue_.emplace(node->order, std::move(node->task));
+    }
+    delete node;
+  }
+}
+
 TaskQueueStdlib::NextTask TaskQueueStdlib::GetNextTask() {
   NextTask result{};
 
-  auto tick = rtc::TimeMillis();
-
-  rtc::CritScope lock(&pending_lock_);
-
-  if (thread_should_quit_) {
+  if (thread_should_quit_.load()) {
     result.final_task_ = true;
     return result;
   }
 
-  if (delayed_queue_.size() > 0) {
-    auto delayed_entry = delayed_queue_.begin();
-    const auto& delay_info = delayed_entry->first;
-    auto& delay_run = delayed_entry->second;
-    if (tick >= delay_info.next_fire_at_ms_) {
+  DrainIncomingTasks();
+
+  auto tick = rtc::TimeMillis();
+
+  if (!delayed_queue_.empty()) {
+    const auto& delay_info = delayed_queue_.top();
+    if (tick >= delay_info.next_fire_at_ms) {
       if (pending_queue_.size() > 0) {
         auto& entry = pending_queue_.front();
         auto& entry_order = entry.first;
         auto& entry_run = entry.second;
-        if (entry_order < delay_info.order_) {
+        if (entry_order < delay_info.order) {
           result.run_task_ = std::move(entry_run);
           pending_queue_.pop();
           return result;
         }
       }
 
-      result.run_task_ = std::move(delay_run);
-      delayed_queue_.erase(delayed_entry);
+      result.run_task_ = delayed_queue_.Pop().task;
       return result;
     }
 
-    result.sleep_time_ms_ = delay_info.next_fire_at_ms_ - tick;
+    result.sleep_time_ms_ = delay_info.next_fire_at_ms - tick;
   }
 
   if (pending_queue_.size() > 0) {
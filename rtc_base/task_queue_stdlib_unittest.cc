@@ -0,0 +1,52 @@
+/*
+ *  Copyright 2019 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/task_queue_stdlib.h"
+
+#include "api/task_queue/task_queue_test.h"
+#include "rtc_base/event.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+INSTANTIATE_TEST_SUITE_P(Stdlib,
+                         TaskQueueTest,
+                         ::testing::Values(CreateTaskQueueStdlibFactory));
+
+// Delayed tasks posted by a task queue to itself, as done by repeating tasks,
+// are the bulk of delayed tasks in a call.
+TEST(TaskQueueStdlibTest, DISABLED_PostDelayedTaskFromQueuePerf) {
+  static constexpr int kNumTasks = 100000;
+  std::unique_ptr<TaskQueueFactory> factory = CreateTaskQueueStdlibFactory();
+  auto queue =
+      factory->CreateTaskQueue("Perf", TaskQueueFactory::Priority::NORMAL);
+
+  rtc::Event done;
+  int64_t post_us = 0;
+  queue->PostTask(ToQueuedTask([&] {
+    int64_t start_us = rtc::TimeMicros();
+    for (int i = 0; i < kNumTasks; ++i) {
+      // Spread the tasks over an hour so that none of them runs.
+      queue->PostDelayedTask(ToQueuedTask([] {}), 1000 + (i * 7919) % 3600000);
+    }
+    post_us = rtc::TimeMicros() - start_us;
+    done.Set();
+  }));
+  ASSERT_TRUE(done.Wait(60000));
+  RTC_LOG(LS_INFO) << "Posted " << kNumTasks << " delayed tasks in "
+                   << post_us << " us.";
+}
+
+}  // namespace
+}  // namespace webrtc
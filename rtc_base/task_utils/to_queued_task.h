@@ -16,12 +16,14 @@
 #include <utility>
 
 #include "api/task_queue/queued_task.h"
+#include "rtc_base/memory/small_object_pool.h"
 
 namespace webrtc {
 namespace webrtc_new_closure_impl {
 // Simple implementation of QueuedTask for use with rtc::Bind and lambdas.
+// Allocated from rtc::SmallObjectPool, since one is created per posted task.
 template <typename Closure>
-class ClosureTask : public QueuedTask {
+class ClosureTask : public QueuedTask, public rtc::SmallObject {
  public:
   explicit ClosureTask(Closure&& closure)
       : closure_(std::forward<Closure>(closure)) {}
@@ -97,9 +97,10 @@
 #define RTC_BASE_THIRD_PARTY_SIGSLOT_SIGSLOT_H_
 
 #include <cstring>
-#include <list>
 #include <set>
 
+#include "absl/container/inlined_vector.h"
+
 // On our copy of sigslot.h, we set single threading as default.
 #define SIGSLOT_DEFAULT_MT_POLICY single_threaded
 
@@ -340,12 +341,13 @@ class _opaque_connection {
 template <class mt_policy>
 class _signal_base : public _signal_base_interface, public mt_policy {
  protected:
-  typedef std::list<_opaque_connection> connections_list;
+  // Most signals have a single slot, e.g. the packet signals of the layers of
+  // the receive path, so the first connection is stored inline.
+  typedef absl::InlinedVector<_opaque_connection, 1> connections_list;
 
   _signal_base()
       : _signal_base_interface(&_signal_base::do_slot_disconnect,
-                               &_signal_base::do_slot_duplicate),
-        m_current_iterator(m_connected_slots.end()) {}
+                               &_signal_base::do_slot_duplicate) {}
 
   ~_signal_base() { disconnect_all(); }
 
@@ -355,8 +357,7 @@ class _signal_base : public _signal_base_interface, public mt_policy {
  public:
   _signal_base(const _signal_base& o)
       : _signal_base_interface(&_signal_base::do_slot_disconnect,
-                               &_signal_base::do_slot_duplicate),
-        m_current_iterator(m_connected_slots.end()) {
+                               &_signal_base::do_slot_duplicate) {
     lock_block<mt_policy> lock(this);
     for (const auto& connection : o.m_connected_slots) {
       connection.getdest()->signal_connect(this);
@@ -374,24 +375,20 @@ class _signal_base : public _signal_base_interface, public mt_policy {
 
     while (!m_connected_slots.empty()) {
       has_slots_interface* pdest = m_connected_slots.front().getdest();
-      m_connected_slots.pop_front();
+      m_connected_slots.erase(m_connected_slots.begin());
       pdest->signal_disconnect(static_cast<_signal_base_interface*>(this));
     }
-    // If disconnect_all is called while the signal is firing, advance the
-    // current slot iterator to the end to avoid an invalidated iterator from
-    // being dereferenced.
-    m_current_iterator = m_connected_slots.end();
+    // If disconnect_all is called while the signal is firing, there are no
+    // slots left to call.
+    m_current_index = 0;
   }
 
 #if !defined(NDEBUG)
   bool connected(has_slots_interface* pclass) {
     lock_block<mt_policy> lock(this);
-    connections_list::const_iterator it = m_connected_slots.begin();
-    connections_list::const_iterator itEnd = m_connected_slots.end();
-    while (it != itEnd) {
-      if (it->getdest() == pclass)
+    for (const _opaque_connection& connection : m_connected_slots) {
+      if (connection.getdest() == pclass)
         return true;
-      ++it;
     }
     return false;
   }
@@ -399,22 +396,12 @@ class _signal_base : public _signal_base_interface, public mt_policy {
 
   void disconnect(has_slots_interface* pclass) {
     lock_block<mt_policy> lock(this);
-    connections_list::iterator it = m_connected_slots.begin();
-    connections_list::iterator itEnd = m_connected_slots.end();
-
-    while (it != itEnd) {
-      if (it->getdest() == pclass) {
-        // If we're currently using this iterator because the signal is firing,
-        // advance it to avoid it being invalidated.
-        if (m_current_iterator == it) {
-          m_current_iterator = m_connected_slots.erase(it);
-        } else {
-          m_connected_slots.erase(it);
-        }
+    for (size_t i = 0; i < m_connected_slots.size(); ++i) {
+      if (m_connected_slots[i].getdest() == pclass) {
+        erase_slot(i);
         pclass->signal_disconnect(static_cast<_signal_base_interface*>(this));
         return;
       }
-      ++it;
     }
   }
 
@@ -423,24 +410,13 @@ class _signal_base : public _signal_base_interface, public mt_policy {
                                  has_slots_interface* pslot) {
     _signal_base* const self = static_cast<_signal_base*>(p);
     lock_block<mt_policy> lock(self);
-    connections_list::iterator it = self->m_connected_slots.begin();
-    connections_list::iterator itEnd = self->m_connected_slots.end();
-
-    while (it != itEnd) {
-      connections_list::iterator itNext = it;
-      ++itNext;
-
-      if (it->getdest() == pslot) {
-        // If we're currently using this iterator because the signal is firing,
-        // advance it to avoid it being invalidated.
-        if (self->m_current_iterator == it) {
-          self->m_current_iterator = self->m_connected_slots.erase(it);
-        } else {
-          self->m_connected_slots.erase(it);
-        }
+    size_t i = 0;
+    while (i < self->m_connected_slots.size()) {
+      if (self->m_connected_slots[i].getdest() == pslot) {
+        self->erase_slot(i);
+      } else {
+        ++i;
       }
-
-      it = itNext;
     }
   }
 
@@ -449,25 +425,30 @@ class _signal_base : public _signal_base_interface, public mt_policy {
                                 has_slots_interface* newtarget) {
     _signal_base* const self = static_cast<_signal_base*>(p);
     lock_block<mt_policy> lock(self);
-    connections_list::iterator it = self->m_connected_slots.begin();
-    connections_list::iterator itEnd = self->m_connected_slots.end();
-
-    while (it != itEnd) {
-      if (it->getdest() == oldtarget) {
-        self->m_connected_slots.push_back(it->duplicate(newtarget));
+    // Slots are added at the end, so only look at the ones there were before.
+    const size_t count = self->m_connected_slots.size();
+    for (size_t i = 0; i < count; ++i) {
+      if (self->m_connected_slots[i].getdest() == oldtarget) {
+        self->m_connected_slots.push_back(
+            self->m_connected_slots[i].duplicate(newtarget));
       }
-
-      ++it;
     }
   }
 
+  // Removes the slot at |index|, and keeps |m_current_index| pointing at the
+  // next slot to call if the signal is firing.
+  void erase_slot(size_t index) {
+    m_connected_slots.erase(m_connected_slots.begin() + index);
+    if (index < m_current_index)
+      --m_current_index;
+  }
+
  protected:
   connections_list m_connected_slots;
 
-  // Used to handle a slot being disconnected while a signal is
-  // firing (iterating m_connected_slots).
-  connections_list::iterator m_current_iterator;
-  bool m_erase_current_iterator = false;
+  // Index of the next slot to call while the signal is firing. Slots may be
+  // connected and disconnected by the slots being called.
+  size_t m_current_index = 0;
 };
 
 template <class mt_policy = SIGSLOT_DEFAULT_MT_POLICY>
@@ -553,10 +534,13 @@ class signal_with_thread_policy : public _signal_base<mt_policy> {
 
   void emit(Args... args) {
     lock_block<mt_policy> lock(this);
-    this->m_current_iterator = this->m_connected_slots.begin();
-    while (this->m_current_iterator != this->m_connected_slots.end()) {
-      _opaque_connection const& conn = *this->m_current_iterator;
-      ++(this->m_current_iterator);
+    this->m_current_index = 0;
+    while (this->m_current_index < this->m_connected_slots.size()) {
+      // The slot may connect or disconnect slots, which moves the connections
+      // around, but _opaque_connection::emit() is done with |conn| by the
+      // time the slot is called.
+      const _opaque_connection& conn =
+          this->m_connected_slots[this->m_current_index++];
       conn.emit<Args...>(args...);
     }
   }
@@ -31,6 +31,7 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/allocation_tracker.h"
 #include "rtc_base/null_socket_server.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
@@ -227,6 +228,7 @@ bool Thread::SetName(const std::string& name, const void* obj) {
     snprintf(buf, sizeof(buf), " 0x%p", obj);
     name_ += buf;
   }
+  stats_.SetName(name_);
   return true;
 }
 
@@ -335,6 +337,9 @@ void* Thread::PreRun(void* pv) {
   Thread* thread = static_cast<Thread*>(pv);
   ThreadManager::Instance()->SetCurrentThread(thread);
   rtc::SetCurrentThreadName(thread->name_.c_str());
+#if defined(WEBRTC_ALLOCATION_TRACKING)
+  AllocationTracker::RegisterCurrentThread(thread->name_.c_str());
+#endif
 #if defined(WEBRTC_MAC)
   ScopedAutoReleasePool pool;
 #endif
@@ -388,6 +393,8 @@ void Thread::Send(const Location& posted_from,
   Thread* current_thread = Thread::Current();
   RTC_DCHECK(current_thread != nullptr);  // AutoThread ensures this
 
+  if (QueueStatsCollector::IsEnabled())
+    msg.ready_us = TimeMicros();
   bool ready = false;
   {
     CritScope cs(&crit_);
@@ -456,8 +463,7 @@ void Thread::ReceiveSendsFromThread(const Thread* source) {
 }
 
 bool Thread::PopSendMessageFromThread(const Thread* source, _SendMessage* msg) {
-  for (std::list<_SendMessage>::iterator it = sendlist_.begin();
-       it != sendlist_.end(); ++it) {
+  for (auto it = sendlist_.begin(); it != sendlist_.end(); ++it) {
     if (it->thread == source || source == nullptr) {
       *msg = *it;
       sendlist_.erase(it);
@@ -489,7 +495,7 @@ void Thread::Clear(MessageHandler* phandler,
   // Object target cleared: remove from send list, wakeup/set ready
   // if sender not null.
 
-  std::list<_SendMessage>::iterator iter = sendlist_.begin();
+  auto iter = sendlist_.begin();
   while (iter != sendlist_.end()) {
     _SendMessage smsg = *iter;
     if (smsg.msg.Match(phandler, id)) {
@@ -23,6 +23,7 @@
 #endif
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/location.h"
+#include "rtc_base/memory/small_object_pool.h"
 #include "rtc_base/message_handler.h"
 #include "rtc_base/message_queue.h"
 #include "rtc_base/platform_thread_types.h"
@@ -45,7 +46,7 @@ class MessageLikeTask : public MessageData {
 };
 
 template <class FunctorT>
-class MessageWithFunctor final : public MessageLikeTask {
+class MessageWithFunctor final : public MessageLikeTask, public SmallObject {
  public:
   explicit MessageWithFunctor(FunctorT&& functor)
       : functor_(std::forward<FunctorT>(functor)) {}
@@ -357,7 +358,7 @@ class RTC_LOCKABLE Thread : public MessageQueue {
 
   void InvokeInternal(const Location& posted_from, MessageHandler* handler);
 
-  std::list<_SendMessage> sendlist_;
+  std::list<_SendMessage, SmallObjectAllocator<_SendMessage>> sendlist_;
   std::string name_;
 
   // TODO(tommi): Add thread checks for proper use of control methods.
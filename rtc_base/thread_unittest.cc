@@ -16,10 +16,12 @@
 #include "rtc_base/async_udp_socket.h"
 #include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/logging.h"
 #include "rtc_base/null_socket_server.h"
 #include "rtc_base/physical_socket_server.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/time_utils.h"
 
 #if defined(WEBRTC_WIN)
 #include <comdef.h>  // NOLINT
@@ -900,5 +902,26 @@ TEST(ThreadPostTaskTest, InvokesInPostedOrder) {
   fourth.Wait(Event::kForever);
 }
 
+TEST(ThreadPostTaskTest, DISABLED_PostTaskThroughputPerf) {
+  static constexpr int kNumTasks = 1000000;
+  std::unique_ptr<rtc::Thread> background_thread(rtc::Thread::Create());
+  background_thread->Start();
+
+  int tasks_run = 0;
+  Event done;
+  int64_t start_us = TimeMicros();
+  for (int i = 0; i < kNumTasks; ++i) {
+    background_thread->PostTask(RTC_FROM_HERE, [&tasks_run, &done] {
+      if (++tasks_run == kNumTasks)
+        done.Set();
+    });
+  }
+  int64_t post_us = TimeMicros() - start_us;
+  ASSERT_TRUE(done.Wait(60000));
+  int64_t total_us = TimeMicros() - start_us;
+  RTC_LOG(LS_INFO) << "Posted " << kNumTasks << " tasks in " << post_us
+                   << " us, all run after " << total_us << " us.";
+}
+
 }  // namespace
 }  // namespace rtc
@@ -9,6 +9,7 @@
 #include <string>
 
 #include "rtc_base/event_tracer.h"
+#include "rtc_base/memory/allocation_tracker.h"
 
 #if defined(TRACE_EVENT0)
 #error "Another copy of trace_event.h has already been included."
@@ -568,10 +569,20 @@
       } \
     } while (0)
 
+// Implementation detail: makes the enclosing scope an allocation tracking
+// stage when allocation tracking is built in.
+#if defined(WEBRTC_ALLOCATION_TRACKING)
+#define INTERNAL_TRACE_EVENT_ALLOCATION_STAGE(name) \
+    rtc::ScopedAllocationStage INTERNAL_TRACE_EVENT_UID(allocationStage)(name);
+#else
+#define INTERNAL_TRACE_EVENT_ALLOCATION_STAGE(name)
+#endif  // defined(WEBRTC_ALLOCATION_TRACKING)
+
 // Implementation detail: internal macro to create static category and add begin
 // event if the category is enabled. Also adds the end event when the scope
 // ends.
 #define INTERNAL_TRACE_EVENT_ADD_SCOPED(category, name, ...) \
+    INTERNAL_TRACE_EVENT_ALLOCATION_STAGE(name) \
     INTERNAL_TRACE_EVENT_GET_CATEGORY_INFO(category); \
     webrtc::trace_event_internal::TraceEndOnScopeClose  \
         INTERNAL_TRACE_EVENT_UID(profileScope); \
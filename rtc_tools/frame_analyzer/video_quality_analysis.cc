@@ -12,10 +12,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
+#include <memory>
 
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/platform_thread.h"
+#include "system_wrappers/include/cpu_info.h"
 #include "test/testsupport/perf_test.h"
 #include "third_party/libyuv/include/libyuv/compare.h"
 
@@ -53,26 +57,69 @@ double Ssim(const rtc::scoped_refptr<I420BufferInterface>& ref_buffer,
   return CalculateMetric(&libyuv::I420Ssim, ref_buffer, test_buffer);
 }
 
+namespace {
+
+// Analyzes the frames of a video on several threads, each taking the next
+// frame not yet analyzed.
+class FrameAnalyzer {
+ public:
+  FrameAnalyzer(const rtc::scoped_refptr<Video>& reference_video,
+                const rtc::scoped_refptr<Video>& test_video,
+                const std::vector<size_t>& test_frame_indices)
+      : reference_video_(reference_video),
+        test_video_(test_video),
+        test_frame_indices_(test_frame_indices),
+        results_(test_video->number_of_frames()) {}
+
+  static void RunWorker(void* obj) {
+    static_cast<FrameAnalyzer*>(obj)->AnalyzeFrames();
+  }
+
+  void AnalyzeFrames() {
+    for (size_t i = next_frame_++; i < results_.size(); i = next_frame_++) {
+      const rtc::scoped_refptr<I420BufferInterface> test_frame =
+          test_video_->GetFrame(i);
+      const rtc::scoped_refptr<I420BufferInterface> reference_frame =
+          reference_video_->GetFrame(i);
+
+      // Fill in the result struct.
+      AnalysisResult& result = results_[i];
+      result.frame_number = test_frame_indices_[i];
+      result.psnr_value = Psnr(reference_frame, test_frame);
+      result.ssim_value = Ssim(reference_frame, test_frame);
+    }
+  }
+
+  std::vector<AnalysisResult> results() const { return results_; }
+
+ private:
+  const rtc::scoped_refptr<Video> reference_video_;
+  const rtc::scoped_refptr<Video> test_video_;
+  const std::vector<size_t>& test_frame_indices_;
+  std::vector<AnalysisResult> results_;
+  std::atomic<size_t> next_frame_{0};
+};
+
+}  // namespace
+
 std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
     const std::vector<size_t>& test_frame_indices) {
-  std::vector<AnalysisResult> results;
-  for (size_t i = 0; i < test_video->number_of_frames(); ++i) {
-    const rtc::scoped_refptr<I420BufferInterface>& test_frame =
-        test_video->GetFrame(i);
-    const rtc::scoped_refptr<I420BufferInterface>& reference_frame =
-        reference_video->GetFrame(i);
-
-    // Fill in the result struct.
-    AnalysisResult result;
-    result.frame_number = test_frame_indices[i];
-    result.psnr_value = Psnr(reference_frame, test_frame);
-    result.ssim_value = Ssim(reference_frame, test_frame);
-    results.push_back(result);
+  FrameAnalyzer analyzer(reference_video, test_video, test_frame_indices);
+  // One of the threads analyzing frames is the calling thread.
+  const size_t num_threads = std::min<size_t>(
+      CpuInfo::DetectNumberOfCores(), test_video->number_of_frames());
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &FrameAnalyzer::RunWorker, &analyzer, "FrameAnalyzer"));
+    threads.back()->Start();
   }
-
-  return results;
+  analyzer.AnalyzeFrames();
+  for (auto& thread : threads)
+    thread->Stop();
+  return analyzer.results();
 }
 
 std::vector<Cluster> CalculateFrameClusters(
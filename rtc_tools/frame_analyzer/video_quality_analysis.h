@@ -50,7 +50,8 @@ struct ResultsContainer {
 // comprises the frames that were captured during the quality measurement test.
 // There may be missing or duplicate frames. Also the frames start at a random
 // position in the original video. We also need to provide a map from test frame
-// indices to reference frame indices.
+// indices to reference frame indices. Frames are analyzed in parallel, on as
+// many threads as there are cores.
 std::vector<AnalysisResult> RunAnalysis(
     const rtc::scoped_refptr<webrtc::test::Video>& reference_video,
     const rtc::scoped_refptr<webrtc::test::Video>& test_video,
@@ -18,7 +18,10 @@
 #include <cstddef>
 #include <fstream>
 #include <string>
+#include <vector>
 
+#include "rtc_tools/frame_analyzer/video_temporal_aligner.h"
+#include "rtc_tools/video_file_reader.h"
 #include "test/gtest.h"
 #include "test/testsupport/file_utils.h"
 
@@ -127,6 +130,28 @@ TEST_F(VideoQualityAnalysisTest,
   VerifyLogOutput(log_filename, expected_out);
 }
 
+TEST_F(VideoQualityAnalysisTest, RunAnalysisMatchesFrameByFrameMetrics) {
+  rtc::scoped_refptr<Video> reference_video =
+      OpenYuvFile(ResourcePath("foreman_128x96", "yuv"), 128, 96);
+  ASSERT_TRUE(reference_video);
+  std::vector<size_t> indices;
+  for (size_t i = reference_video->number_of_frames(); i > 0; --i)
+    indices.push_back(i - 1);
+  rtc::scoped_refptr<Video> test_video = ReorderVideo(reference_video, indices);
+
+  const std::vector<AnalysisResult> results =
+      RunAnalysis(reference_video, test_video, indices);
+
+  ASSERT_EQ(indices.size(), results.size());
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(static_cast<int>(indices[i]), results[i].frame_number);
+    EXPECT_EQ(Psnr(reference_video->GetFrame(i), test_video->GetFrame(i)),
+              results[i].psnr_value);
+    EXPECT_EQ(Ssim(reference_video->GetFrame(i), test_video->GetFrame(i)),
+              results[i].ssim_value);
+  }
+}
+
 TEST_F(VideoQualityAnalysisTest, CalculateFrameClustersOneValue) {
   const std::vector<Cluster> result = CalculateFrameClusters({1});
   EXPECT_EQ(1u, result.size());
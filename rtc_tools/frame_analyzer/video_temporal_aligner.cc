@@ -20,6 +20,7 @@
 
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame_buffer.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_tools/frame_analyzer/video_quality_analysis.h"
 
@@ -126,6 +127,7 @@ class CachedVideo : public rtc::RefCountedObject<Video> {
 
   rtc::scoped_refptr<I420BufferInterface> GetFrame(
       size_t index) const override {
+    rtc::CritScope lock(&lock_);
     for (const CachedFrame& cached_frame : cache_) {
       if (cached_frame.index == index)
         return cached_frame.frame;
@@ -147,7 +149,8 @@ class CachedVideo : public rtc::RefCountedObject<Video> {
 
   const size_t max_cache_size_;
   const rtc::scoped_refptr<Video> video_;
-  mutable std::deque<CachedFrame> cache_;
+  rtc::CriticalSection lock_;
+  mutable std::deque<CachedFrame> cache_ RTC_GUARDED_BY(lock_);
 };
 
 // Try matching the test frame against all frames in the reference video and
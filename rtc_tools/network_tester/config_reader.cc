@@ -44,6 +44,10 @@ absl::optional<ConfigReader::Config> ConfigReader::GetNextConfig() {
   config.packet_send_interval_ms = proto_config.packet_send_interval_ms();
   config.packet_size = proto_config.packet_size();
   config.execution_time_ms = proto_config.execution_time_ms();
+  config.packets_per_interval = proto_config.has_packets_per_interval()
+                                    ? proto_config.packets_per_interval()
+                                    : 1;
+  RTC_DCHECK_GE(config.packets_per_interval, 1);
   return config;
 #else
   return absl::nullopt;
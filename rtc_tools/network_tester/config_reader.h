@@ -35,6 +35,7 @@ class ConfigReader {
     int packet_send_interval_ms;
     int packet_size;
     int execution_time_ms;
+    int packets_per_interval;
   };
   explicit ConfigReader(const std::string& config_file_path);
   ~ConfigReader();
@@ -15,14 +15,23 @@
 
 namespace webrtc {
 
+namespace {
+constexpr size_t kBufferSize = 1 << 20;
+// The size of a logged packet is stored in a single byte.
+constexpr size_t kMaxPacketLogSize = 1 + 255;
+}  // namespace
+
 PacketLogger::PacketLogger(const std::string& log_file_path)
     : packet_logger_stream_(log_file_path,
-                            std::ios_base::out | std::ios_base::binary) {
+                            std::ios_base::out | std::ios_base::binary),
+      buffer_(kBufferSize) {
   RTC_DCHECK(packet_logger_stream_.is_open());
   RTC_DCHECK(packet_logger_stream_.good());
 }
 
-PacketLogger::~PacketLogger() = default;
+PacketLogger::~PacketLogger() {
+  Flush();
+}
 
 void PacketLogger::LogPacket(const NetworkTesterPacket& packet) {
   // The protobuffer message will be saved in the following format to the file:
@@ -32,13 +41,18 @@ void PacketLogger::LogPacket(const NetworkTesterPacket& packet) {
   // | Size of the next | proto   | Size of the next | ... | proto   |
   // | proto message    | message | proto message    |     | message |
   // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-  std::string packet_data;
-  packet.SerializeToString(&packet_data);
-  RTC_DCHECK_LE(packet_data.length(), 255);
-  RTC_DCHECK_GE(packet_data.length(), 0);
-  char proto_size = packet_data.length();
-  packet_logger_stream_.write(&proto_size, sizeof(proto_size));
-  packet_logger_stream_.write(packet_data.data(), packet_data.length());
+  if (buffer_size_ + kMaxPacketLogSize > buffer_.size())
+    Flush();
+  size_t proto_size = packet.ByteSizeLong();
+  RTC_DCHECK_LE(proto_size, 255);
+  buffer_[buffer_size_] = static_cast<char>(proto_size);
+  packet.SerializeToArray(&buffer_[buffer_size_ + 1], proto_size);
+  buffer_size_ += 1 + proto_size;
+}
+
+void PacketLogger::Flush() {
+  packet_logger_stream_.write(buffer_.data(), buffer_size_);
+  buffer_size_ = 0;
 }
 
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "rtc_base/constructor_magic.h"
 #include "rtc_base/ignore_wundef.h"
@@ -36,7 +37,13 @@ class PacketLogger {
   void LogPacket(const NetworkTesterPacket& packet);
 
  private:
+  void Flush();
+
   std::ofstream packet_logger_stream_;
+  // Packets are serialized into this buffer, and written to the file once it
+  // is full, so that logging keeps up with high packet rates.
+  std::vector<char> buffer_;
+  size_t buffer_size_ = 0;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketLogger);
 };
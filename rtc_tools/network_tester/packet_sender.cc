@@ -35,8 +35,14 @@ class SendPacketTask : public QueuedTask {
  private:
   bool Run() override {
     if (packet_sender_->IsSending()) {
-      packet_sender_->SendPacket();
-      target_time_ms_ += packet_sender_->GetSendIntervalMs();
+      // Send the packets of all the intervals that are due in one go, rather
+      // than posting a task per interval when the task runs late.
+      const int64_t now_ms = rtc::TimeMillis();
+      const int64_t send_interval_ms = packet_sender_->GetSendIntervalMs();
+      do {
+        packet_sender_->SendPackets();
+        target_time_ms_ += send_interval_ms;
+      } while (send_interval_ms > 0 && target_time_ms_ <= now_ms);
       int64_t delay_ms = std::max(static_cast<int64_t>(0),
                                   target_time_ms_ - rtc::TimeMillis());
       TaskQueueBase::Current()->PostDelayedTask(
@@ -62,7 +68,8 @@ class UpdateTestSettingTask : public QueuedTask {
     auto config = config_reader_->GetNextConfig();
     if (config) {
       packet_sender_->UpdateTestSetting((*config).packet_size,
-                                        (*config).packet_send_interval_ms);
+                                        (*config).packet_send_interval_ms,
+                                        (*config).packets_per_interval);
       TaskQueueBase::Current()->PostDelayedTask(
           std::unique_ptr<QueuedTask>(this), (*config).execution_time_ms);
       return false;
@@ -81,6 +88,7 @@ PacketSender::PacketSender(TestController* test_controller,
                            const std::string& config_file_path)
     : packet_size_(0),
       send_interval_ms_(0),
+      packets_per_interval_(1),
       sequence_number_(0),
       sending_(false),
       config_file_path_(config_file_path),
@@ -114,13 +122,15 @@ bool PacketSender::IsSending() const {
   return sending_;
 }
 
-void PacketSender::SendPacket() {
+void PacketSender::SendPackets() {
   RTC_DCHECK_RUN_ON(&worker_queue_checker_);
   NetworkTesterPacket packet;
   packet.set_type(NetworkTesterPacket::TEST_DATA);
-  packet.set_sequence_number(sequence_number_++);
-  packet.set_send_timestamp(rtc::TimeMicros());
-  test_controller_->SendData(packet, packet_size_);
+  for (int i = 0; i < packets_per_interval_; ++i) {
+    packet.set_sequence_number(sequence_number_++);
+    packet.set_send_timestamp(rtc::TimeMicros());
+    test_controller_->SendData(packet, packet_size_);
+  }
 }
 
 int64_t PacketSender::GetSendIntervalMs() const {
@@ -129,10 +139,12 @@ int64_t PacketSender::GetSendIntervalMs() const {
 }
 
 void PacketSender::UpdateTestSetting(size_t packet_size,
-                                     int64_t send_interval_ms) {
+                                     int64_t send_interval_ms,
+                                     int packets_per_interval) {
   RTC_DCHECK_RUN_ON(&worker_queue_checker_);
   send_interval_ms_ = send_interval_ms;
   packet_size_ = packet_size;
+  packets_per_interval_ = packets_per_interval;
 }
 
 }  // namespace webrtc
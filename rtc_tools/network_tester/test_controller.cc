@@ -88,9 +88,8 @@ void TestController::OnReadPacket(rtc::AsyncPacketSocket* socket,
                                   const int64_t& packet_time_us) {
   RTC_DCHECK_RUN_ON(&test_controller_thread_checker_);
   size_t packet_size = data[0];
-  std::string receive_data(&data[1], packet_size);
   NetworkTesterPacket packet;
-  packet.ParseFromString(receive_data);
+  packet.ParseFromArray(&data[1], packet_size);
   RTC_CHECK(packet.has_type());
   switch (packet.type()) {
     case NetworkTesterPacket::HAND_SHAKING: {
@@ -0,0 +1,249 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Replays the outgoing packets and the transport feedback of RTC event logs
+// into network controllers, as fast as possible, and prints metrics of the
+// resulting target rates as CSV. The logs are replayed in parallel, and every
+// log is replayed with every controller, so that the controllers can be
+// compared on the same traces.
+//
+// Note that the replay is open loop: the packets are sent as logged, whatever
+// the controller decides.
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/strings/str_split.h"
+#include "api/transport/goog_cc_factory.h"
+#include "api/transport/network_control.h"
+#include "logging/rtc_event_log/rtc_event_log_parser.h"
+#include "modules/congestion_controller/bbr/bbr_factory.h"
+#include "modules/congestion_controller/pcc/pcc_factory.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/time_utils.h"
+#include "rtc_tools/rtc_event_log_visualizer/log_simulation.h"
+#include "system_wrappers/include/field_trial.h"
+
+ABSL_FLAG(std::string,
+          controllers,
+          "goog_cc,bbr,pcc",
+          "A comma separated list of the network controllers to replay the "
+          "logs with. Valid options are goog_cc, bbr and pcc.");
+ABSL_FLAG(int, threads, 4, "The number of logs to replay in parallel.");
+ABSL_FLAG(bool,
+          include_logged,
+          true,
+          "Also print the metrics of the target rate in the log, as logged by "
+          "the controller that ran in the call.");
+ABSL_FLAG(
+    std::string,
+    force_fieldtrials,
+    "",
+    "Field trials control experimental feature code which can be forced. "
+    "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enabled/"
+    " will assign the group Enabled to field trial WebRTC-FooFeature. Multiple "
+    "trials are separated by \"/\"");
+
+namespace webrtc {
+namespace {
+
+std::unique_ptr<NetworkControllerFactoryInterface> CreateFactory(
+    const std::string& name) {
+  if (name == "goog_cc")
+    return std::make_unique<GoogCcNetworkControllerFactory>();
+  if (name == "bbr")
+    return std::make_unique<BbrNetworkControllerFactory>();
+  if (name == "pcc")
+    return std::make_unique<PccNetworkControllerFactory>();
+  return nullptr;
+}
+
+// Metrics of a target rate, seen as a step function over the log.
+class TargetRateMetrics {
+ public:
+  void OnTargetRate(Timestamp at_time, DataRate rate) {
+    AdvanceTo(at_time);
+    if (!last_rate_) {
+      min_rate_ = rate;
+      max_rate_ = rate;
+    }
+    min_rate_ = std::min(min_rate_, rate);
+    max_rate_ = std::max(max_rate_, rate);
+    last_rate_ = rate;
+    ++num_updates_;
+  }
+  void OnProbeClusters(size_t num_clusters) { num_probes_ += num_clusters; }
+
+  // Includes the time after the last update up to |end_time|, and returns the
+  // CSV columns of the metrics.
+  std::string Finish(Timestamp end_time) {
+    AdvanceTo(end_time);
+    double mean_kbps = 0;
+    if (duration_ > TimeDelta::Zero())
+      mean_kbps = integral_kbit_ / duration_.seconds<double>();
+    rtc::StringBuilder sb;
+    sb << duration_.seconds<double>() << "," << mean_kbps << ","
+       << min_rate_.kbps<double>() << "," << max_rate_.kbps<double>() << ","
+       << num_updates_ << "," << num_probes_;
+    return sb.Release();
+  }
+
+ private:
+  void AdvanceTo(Timestamp at_time) {
+    if (last_rate_ && at_time > last_time_) {
+      integral_kbit_ += last_rate_->kbps<double>() *
+                        (at_time - last_time_).seconds<double>();
+      duration_ += at_time - last_time_;
+    }
+    if (last_rate_)
+      last_time_ = std::max(last_time_, at_time);
+    else
+      last_time_ = at_time;
+  }
+
+  absl::optional<DataRate> last_rate_;
+  Timestamp last_time_ = Timestamp::MinusInfinity();
+  TimeDelta duration_ = TimeDelta::Zero();
+  double integral_kbit_ = 0;
+  DataRate min_rate_ = DataRate::Zero();
+  DataRate max_rate_ = DataRate::Zero();
+  int num_updates_ = 0;
+  size_t num_probes_ = 0;
+};
+
+class Replayer {
+ public:
+  Replayer(std::vector<std::string> log_files,
+           std::vector<std::string> controllers,
+           bool include_logged)
+      : log_files_(std::move(log_files)),
+        controllers_(std::move(controllers)),
+        include_logged_(include_logged) {}
+
+  static void RunWorker(void* obj) {
+    static_cast<Replayer*>(obj)->ReplayLogs();
+  }
+
+ private:
+  void ReplayLogs() {
+    for (size_t i = next_log_++; i < log_files_.size(); i = next_log_++)
+      ReplayLog(log_files_[i]);
+  }
+
+  void ReplayLog(const std::string& log_file) {
+    ParsedRtcEventLog parsed_log;
+    if (!parsed_log.ParseFile(log_file)) {
+      std::cerr << "Could not parse the entire log file " << log_file
+                << ", only the parsable events are replayed." << std::endl;
+    }
+    const Timestamp end_time = Timestamp::us(parsed_log.last_timestamp());
+    std::vector<std::string> lines;
+
+    if (include_logged_) {
+      TargetRateMetrics metrics;
+      for (const auto& update : parsed_log.bwe_loss_updates()) {
+        metrics.OnTargetRate(Timestamp::us(update.log_time_us()),
+                             DataRate::bps(update.bitrate_bps));
+      }
+      metrics.OnProbeClusters(
+          parsed_log.bwe_probe_cluster_created_events().size());
+      lines.push_back(log_file + ",logged," + metrics.Finish(end_time) + ",0");
+    }
+
+    for (const std::string& controller : controllers_) {
+      TargetRateMetrics metrics;
+      LogBasedNetworkControllerSimulation simulation(
+          CreateFactory(controller),
+          [&metrics](const NetworkControlUpdate& update, Timestamp at_time) {
+            if (update.target_rate)
+              metrics.OnTargetRate(at_time, update.target_rate->target_rate);
+            metrics.OnProbeClusters(update.probe_cluster_configs.size());
+          });
+      int64_t start_us = rtc::TimeMicros();
+      simulation.ProcessEventsInLog(parsed_log);
+      int64_t elapsed_us = rtc::TimeMicros() - start_us;
+      rtc::StringBuilder sb;
+      sb << log_file << "," << controller << "," << metrics.Finish(end_time)
+         << "," << elapsed_us / 1000.0;
+      lines.push_back(sb.Release());
+    }
+
+    rtc::CritScope lock(&output_crit_);
+    for (const std::string& line : lines)
+      printf("%s\n", line.c_str());
+    fflush(stdout);
+  }
+
+  const std::vector<std::string> log_files_;
+  const std::vector<std::string> controllers_;
+  const bool include_logged_;
+  std::atomic<size_t> next_log_{0};
+  rtc::CriticalSection output_crit_;
+};
+
+}  // namespace
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "A tool for comparing network controllers offline, by replaying the "
+      "send side of WebRTC event logs into them.\n"
+      "Example usage:\n"
+      "./event_log_bwe_replay --controllers=goog_cc,bbr <logfile>... > "
+      "metrics.csv\n");
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  if (args.size() < 2) {
+    std::cerr << "No log files given." << std::endl;
+    return 1;
+  }
+
+  // InitFieldTrialsFromString stores the char*, so the char array must outlive
+  // the application.
+  const std::string field_trials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(field_trials.c_str());
+
+  std::vector<std::string> controllers =
+      absl::StrSplit(absl::GetFlag(FLAGS_controllers), ',', absl::SkipEmpty());
+  for (const std::string& controller : controllers) {
+    if (!webrtc::CreateFactory(controller)) {
+      std::cerr << "Unrecognized controller \'" << controller
+                << "\'. Aborting." << std::endl;
+      return 1;
+    }
+  }
+
+  webrtc::Replayer replayer(std::vector<std::string>(args.begin() + 1,
+                                                     args.end()),
+                            controllers, absl::GetFlag(FLAGS_include_logged));
+  printf("log,controller,duration_s,mean_target_kbps,min_target_kbps,"
+         "max_target_kbps,target_updates,probe_clusters,replay_ms\n");
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  int num_threads = std::max(1, absl::GetFlag(FLAGS_threads));
+  for (int i = 0; i < num_threads; ++i) {
+    threads.push_back(std::make_unique<rtc::PlatformThread>(
+        &webrtc::Replayer::RunWorker, &replayer, "BweReplay"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+  return 0;
+}
@@ -11,6 +11,7 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -101,6 +102,11 @@ ABSL_FLAG(bool,
           false,
           "List of registered plots (for use with the --plot flag)");
 
+ABSL_FLAG(int,
+          decoding_threads,
+          1,
+          "Number of threads decoding the RTP packets of new format logs.");
+
 using webrtc::Plot;
 
 namespace {
@@ -241,7 +247,9 @@ int main(int argc, char* argv[]) {
     header_extensions = webrtc::ParsedRtcEventLog::
         UnconfiguredHeaderExtensions::kAttemptWebrtcDefaultConfig;
   }
-  webrtc::ParsedRtcEventLog parsed_log(header_extensions);
+  webrtc::ParsedRtcEventLog parsed_log(
+      header_extensions,
+      std::max(absl::GetFlag(FLAGS_decoding_threads), 1));
 
   if (args.size() == 2) {
     std::string filename = args[1];
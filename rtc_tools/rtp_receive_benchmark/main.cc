@@ -0,0 +1,135 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/flags/usage.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_split.h"
+#include "api/video_codecs/video_codec.h"
+#include "rtc_tools/rtp_receive_benchmark/rtp_receive_benchmark.h"
+
+ABSL_FLAG(std::string, input_file, "", "RTP dump or pcap file to replay");
+ABSL_FLAG(std::string, input_format, "rtpdump", "rtpdump or pcap");
+ABSL_FLAG(int, payload_type, 96, "Payload type of the video streams");
+ABSL_FLAG(std::string, codec, "VP8", "Video codec: VP8, VP9, H264 or Generic");
+ABSL_FLAG(std::string,
+          extensions,
+          "",
+          "Comma separated id:uri pairs of the RTP header extensions in use");
+ABSL_FLAG(bool, srtp, false, "Include SRTP unprotect");
+ABSL_FLAG(int, iterations, 10, "Number of times to replay the file");
+
+namespace {
+
+// Counts heap allocations made by the whole process, through the replaced
+// global operator new below.
+std::atomic<int64_t> g_allocations(0);
+
+int64_t AllocationCount() {
+  return g_allocations.load(std::memory_order_relaxed);
+}
+
+bool ParseExtensions(const std::string& flag,
+                     std::vector<webrtc::RtpExtension>* extensions) {
+  for (absl::string_view pair : absl::StrSplit(flag, ',', absl::SkipEmpty())) {
+    std::vector<absl::string_view> id_and_uri = absl::StrSplit(pair, ':');
+    int id;
+    if (id_and_uri.size() < 2 || !absl::SimpleAtoi(id_and_uri[0], &id))
+      return false;
+    // The URI itself may contain colons.
+    extensions->emplace_back(
+        std::string(pair.substr(id_and_uri[0].size() + 1)), id);
+  }
+  return true;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* p = malloc(size == 0 ? 1 : size);
+  if (!p)
+    abort();
+  return p;
+}
+
+void operator delete(void* p) noexcept {
+  free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+  free(p);
+}
+
+int main(int argc, char* argv[]) {
+  absl::SetProgramUsageMessage(
+      "Replays the video streams of an RTP dump through the receive stack and\n"
+      "reports time and heap allocations per packet for each stage.\n"
+      "Example Usage:\n"
+      "./rtp_receive_benchmark --input_file=video.rtpdump --codec=VP8\n"
+      "    --payload_type=96 --srtp\n"
+      "    --extensions=5:http://www.webrtc.org/experiments/rtp-hdrext/"
+      "transport-wide-cc-02\n");
+  absl::ParseCommandLine(argc, argv);
+
+  webrtc::RtpReceiveBenchmarkOptions options;
+  options.input_file = absl::GetFlag(FLAGS_input_file);
+  const std::string input_format = absl::GetFlag(FLAGS_input_format);
+  if (input_format == "pcap") {
+    options.input_format = webrtc::test::RtpFileReader::kPcap;
+  } else if (input_format != "rtpdump") {
+    fprintf(stderr, "Unknown input format: %s\n", input_format.c_str());
+    return EXIT_FAILURE;
+  }
+  options.video_payload_type = absl::GetFlag(FLAGS_payload_type);
+  options.video_codec =
+      webrtc::PayloadStringToCodecType(absl::GetFlag(FLAGS_codec));
+  if (!ParseExtensions(absl::GetFlag(FLAGS_extensions), &options.extensions)) {
+    fprintf(stderr, "Invalid --extensions.\n");
+    return EXIT_FAILURE;
+  }
+  options.srtp = absl::GetFlag(FLAGS_srtp);
+  options.iterations = absl::GetFlag(FLAGS_iterations);
+  options.allocation_count = &AllocationCount;
+
+  webrtc::RtpReceiveBenchmark benchmark(options);
+  if (options.input_file.empty() || !benchmark.Init()) {
+    fprintf(stderr, "Failed to read video packets from '%s'.\n",
+            options.input_file.c_str());
+    return EXIT_FAILURE;
+  }
+  webrtc::RtpReceiveBenchmarkResult result = benchmark.Run();
+  if (result.packets == 0)
+    return EXIT_FAILURE;
+
+  printf("%lld packets, %lld dropped, %lld frames decodable\n",
+         static_cast<long long>(result.packets),
+         static_cast<long long>(result.dropped_packets),
+         static_cast<long long>(result.frames));
+  printf("%.0f packets/s, %lld ns/packet\n",
+         result.packets * 1e9 / std::max<int64_t>(result.total_time_ns, 1),
+         static_cast<long long>(result.total_time_ns / result.packets));
+  for (const webrtc::RtpReceiveBenchmarkResult::Stage& stage : result.stages) {
+    printf("  %-16s %8lld ns/packet %8.2f allocations/packet\n",
+           stage.name.c_str(),
+           static_cast<long long>(stage.time_ns / result.packets),
+           static_cast<double>(stage.allocations) / result.packets);
+  }
+  return EXIT_SUCCESS;
+}
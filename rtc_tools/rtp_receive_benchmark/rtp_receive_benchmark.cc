@@ -0,0 +1,352 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_tools/rtp_receive_benchmark/rtp_receive_benchmark.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include "api/video_codecs/video_codec.h"
+#include "call/rtp_demuxer.h"
+#include "call/rtp_packet_sink_interface.h"
+#include "call/video_receive_stream.h"
+#include "modules/include/module_common_types.h"
+#include "modules/rtp_rtcp/include/receive_statistics.h"
+#include "modules/rtp_rtcp/include/rtp_header_extension_map.h"
+#include "modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "modules/utility/include/process_thread.h"
+#include "modules/video_coding/frame_buffer2.h"
+#include "modules/video_coding/rtp_frame_reference_finder.h"
+#include "modules/video_coding/timing.h"
+#include "pc/srtp_session.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/ssl_stream_adapter.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/clock.h"
+#include "test/null_transport.h"
+#include "video/rtp_video_stream_receiver.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSrtpCryptoSuite = rtc::SRTP_AES128_CM_SHA1_80;
+// Room for the SRTP authentication tag.
+constexpr size_t kSrtpOverhead = 64;
+constexpr uint32_t kLocalSsrc = 0x4c4f43;
+// The clock starts at a round time rather than zero, which some of the
+// receive stack treats as unset.
+constexpr int64_t kStartTimeMs = 100000;
+
+enum StageIndex {
+  kSrtpStage,
+  kParseStage,
+  kDemuxStage,
+  kVideoReceiverStage,
+  kFrameBufferStage,
+  kNumStages
+};
+
+const char* const kStageNames[kNumStages] = {
+    "srtp_unprotect", "parse", "demux", "video_receiver", "frame_buffer"};
+
+struct Sample {
+  int64_t time_ns;
+  int64_t allocations;
+};
+
+class Meter {
+ public:
+  explicit Meter(std::function<int64_t()> allocation_count)
+      : allocation_count_(std::move(allocation_count)) {}
+
+  Sample Now() const {
+    return {rtc::TimeNanos(), allocation_count_ ? allocation_count_() : 0};
+  }
+
+  void AddSince(const Sample& start, RtpReceiveBenchmarkResult::Stage* stage) {
+    Sample end = Now();
+    stage->time_ns += end.time_ns - start.time_ns;
+    stage->allocations += end.allocations - start.allocations;
+  }
+
+ private:
+  const std::function<int64_t()> allocation_count_;
+};
+
+std::vector<uint8_t> SrtpKey() {
+  int key_length;
+  int salt_length;
+  RTC_CHECK(rtc::GetSrtpKeyAndSaltLengths(kSrtpCryptoSuite, &key_length,
+                                          &salt_length));
+  std::vector<uint8_t> key(key_length + salt_length);
+  for (size_t i = 0; i < key.size(); ++i)
+    key[i] = static_cast<uint8_t>(i * 13 + 7);
+  return key;
+}
+
+// One video stream: the RtpVideoStreamReceiver and the FrameBuffer its
+// complete frames go to. Times the receiver and the frame buffer separately,
+// both inclusive of anything they call. NACKs and key frame requests are
+// dropped, as there is no sender to answer them.
+class VideoStream : public RtpPacketSinkInterface,
+                    public NackSender,
+                    public KeyFrameRequestSender,
+                    public video_coding::OnCompleteFrameCallback {
+ public:
+  VideoStream(uint32_t ssrc,
+              const RtpReceiveBenchmarkOptions& options,
+              Clock* clock,
+              Transport* transport,
+              ReceiveStatistics* receive_statistics,
+              ProcessThread* process_thread,
+              Meter* meter,
+              RtpReceiveBenchmarkResult::Stage* receiver_stage,
+              RtpReceiveBenchmarkResult::Stage* frame_buffer_stage,
+              int64_t* frames)
+      : config_(CreateConfig(ssrc, transport)),
+        timing_(clock),
+        frame_buffer_(clock, &timing_, /*stats_callback=*/nullptr),
+        receiver_(clock,
+                  transport,
+                  /*rtt_stats=*/nullptr,
+                  /*packet_router=*/nullptr,
+                  &config_,
+                  receive_statistics,
+                  /*receive_stats_proxy=*/nullptr,
+                  process_thread,
+                  this,
+                  this,
+                  /*keyframe_request_coordinator=*/nullptr,
+                  this,
+                  /*frame_decryptor=*/nullptr),
+        meter_(meter),
+        receiver_stage_(receiver_stage),
+        frame_buffer_stage_(frame_buffer_stage),
+        frames_(frames) {
+    VideoCodec codec;
+    codec.codecType = options.video_codec;
+    codec.plType = options.video_payload_type;
+    receiver_.AddReceiveCodec(codec, {}, /*raw_payload=*/false);
+    receiver_.StartReceive();
+  }
+
+  ~VideoStream() override { receiver_.StopReceive(); }
+
+  void OnRtpPacket(const RtpPacketReceived& packet) override {
+    Sample start = meter_->Now();
+    receiver_.OnRtpPacket(packet);
+    meter_->AddSince(start, receiver_stage_);
+  }
+
+  void SendNack(const std::vector<uint16_t>& sequence_numbers,
+                bool buffering_allowed) override {}
+
+  void RequestKeyFrame() override {}
+
+  void OnCompleteFrame(
+      std::unique_ptr<video_coding::EncodedFrame> frame) override {
+    Sample start = meter_->Now();
+    frame_buffer_.InsertFrame(std::move(frame));
+    // Pull decodable frames right away, as the decoder thread would.
+    std::unique_ptr<video_coding::EncodedFrame> decodable_frame;
+    while (frame_buffer_.NextFrame(/*max_wait_time_ms=*/0, &decodable_frame,
+                                   /*keyframe_required=*/false) ==
+           video_coding::FrameBuffer::kFrameFound) {
+      ++*frames_;
+    }
+    meter_->AddSince(start, frame_buffer_stage_);
+  }
+
+ private:
+  static VideoReceiveStream::Config CreateConfig(uint32_t ssrc,
+                                                 Transport* transport) {
+    VideoReceiveStream::Config config(transport);
+    config.rtp.remote_ssrc = ssrc;
+    config.rtp.local_ssrc = kLocalSsrc;
+    return config;
+  }
+
+  const VideoReceiveStream::Config config_;
+  VCMTiming timing_;
+  video_coding::FrameBuffer frame_buffer_;
+  RtpVideoStreamReceiver receiver_;
+  Meter* const meter_;
+  RtpReceiveBenchmarkResult::Stage* const receiver_stage_;
+  RtpReceiveBenchmarkResult::Stage* const frame_buffer_stage_;
+  int64_t* const frames_;
+};
+
+}  // namespace
+
+RtpReceiveBenchmark::RtpReceiveBenchmark(
+    const RtpReceiveBenchmarkOptions& options)
+    : options_(options) {}
+
+RtpReceiveBenchmark::~RtpReceiveBenchmark() = default;
+
+bool RtpReceiveBenchmark::Init() {
+  std::unique_ptr<test::RtpFileReader> reader(test::RtpFileReader::Create(
+      options_.input_format, options_.input_file));
+  if (!reader)
+    return false;
+
+  cricket::SrtpSession srtp_session;
+  const std::vector<uint8_t> srtp_key = SrtpKey();
+  if (options_.srtp &&
+      !srtp_session.SetSend(kSrtpCryptoSuite, srtp_key.data(), srtp_key.size(),
+                            /*extension_ids=*/{})) {
+    return false;
+  }
+
+  test::RtpPacket packet;
+  int64_t first_time_ms = -1;
+  while (reader->NextPacket(&packet)) {
+    // Header-only dumps, e.g. from event logs, can't be depacketized.
+    if (packet.length < packet.original_length)
+      continue;
+    RtpPacketReceived header;
+    if (!header.Parse(packet.data, packet.length))
+      continue;
+    if (header.PayloadType() == options_.video_payload_type &&
+        std::find(video_ssrcs_.begin(), video_ssrcs_.end(), header.Ssrc()) ==
+            video_ssrcs_.end()) {
+      video_ssrcs_.push_back(header.Ssrc());
+    }
+    if (first_time_ms < 0)
+      first_time_ms = packet.time_ms;
+
+    rtc::CopyOnWriteBuffer data(packet.data, packet.length,
+                                packet.length + kSrtpOverhead);
+    if (options_.srtp) {
+      int length;
+      if (!srtp_session.ProtectRtp(data.data(), static_cast<int>(data.size()),
+                                   static_cast<int>(data.capacity()),
+                                   &length)) {
+        continue;
+      }
+      data.SetSize(length);
+    }
+    packets_.push_back(
+        {std::move(data), kStartTimeMs + packet.time_ms - first_time_ms});
+  }
+  return !video_ssrcs_.empty();
+}
+
+RtpReceiveBenchmarkResult RtpReceiveBenchmark::Run() {
+  RtpReceiveBenchmarkResult result;
+  for (const char* name : kStageNames) {
+    result.stages.emplace_back();
+    result.stages.back().name = name;
+  }
+  if (!options_.srtp)
+    result.stages.erase(result.stages.begin() + kSrtpStage);
+  for (int i = 0; i < options_.iterations; ++i)
+    RunOnce(&result);
+  return result;
+}
+
+void RtpReceiveBenchmark::RunOnce(RtpReceiveBenchmarkResult* result) {
+  // Stages are measured inclusive of the stages they call, and made
+  // exclusive at the end.
+  RtpReceiveBenchmarkResult::Stage stages[kNumStages];
+  Meter meter(options_.allocation_count);
+
+  SimulatedClock clock(kStartTimeMs * rtc::kNumMicrosecsPerMillisec);
+  test::NullTransport transport;
+  std::unique_ptr<ProcessThread> process_thread =
+      ProcessThread::Create("RtpReceiveBenchmark");
+  std::unique_ptr<ReceiveStatistics> receive_statistics =
+      ReceiveStatistics::Create(&clock);
+  RtpHeaderExtensionMap extension_map(options_.extensions);
+  cricket::SrtpSession srtp_session;
+  const std::vector<uint8_t> srtp_key = SrtpKey();
+  if (options_.srtp) {
+    RTC_CHECK(srtp_session.SetRecv(kSrtpCryptoSuite, srtp_key.data(),
+                                   srtp_key.size(), /*extension_ids=*/{}));
+  }
+
+  RtpDemuxer demuxer;
+  std::vector<std::unique_ptr<VideoStream>> streams;
+  for (uint32_t ssrc : video_ssrcs_) {
+    streams.push_back(std::make_unique<VideoStream>(
+        ssrc, options_, &clock, &transport, receive_statistics.get(),
+        process_thread.get(), &meter, &stages[kVideoReceiverStage],
+        &stages[kFrameBufferStage], &result->frames));
+    demuxer.AddSink(ssrc, streams.back().get());
+  }
+
+  // Unprotect works in place, so each run needs its own copy.
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+  packets.reserve(packets_.size());
+  for (const InputPacket& packet : packets_)
+    packets.emplace_back(packet.data.cdata(), packet.data.size());
+
+  const Sample run_start = meter.Now();
+  for (size_t i = 0; i < packets.size(); ++i) {
+    const int64_t arrival_time_ms = packets_[i].arrival_time_ms;
+    if (arrival_time_ms > clock.TimeInMilliseconds())
+      clock.AdvanceTimeMilliseconds(arrival_time_ms -
+                                    clock.TimeInMilliseconds());
+    rtc::CopyOnWriteBuffer& data = packets[i];
+
+    Sample start = meter.Now();
+    if (options_.srtp) {
+      int length;
+      bool unprotected = srtp_session.UnprotectRtp(
+          data.data(), static_cast<int>(data.size()), &length);
+      meter.AddSince(start, &stages[kSrtpStage]);
+      if (!unprotected) {
+        ++result->dropped_packets;
+        continue;
+      }
+      data.SetSize(length);
+      start = meter.Now();
+    }
+
+    RtpPacketReceived packet(&extension_map);
+    bool parsed = packet.Parse(std::move(data));
+    if (parsed)
+      packet.set_arrival_time_ms(arrival_time_ms);
+    meter.AddSince(start, &stages[kParseStage]);
+    if (!parsed) {
+      ++result->dropped_packets;
+      continue;
+    }
+
+    start = meter.Now();
+    if (!demuxer.OnRtpPacket(packet))
+      ++result->dropped_packets;
+    meter.AddSince(start, &stages[kDemuxStage]);
+  }
+  const Sample run_end = meter.Now();
+
+  for (const auto& stream : streams)
+    demuxer.RemoveSink(stream.get());
+
+  stages[kDemuxStage].time_ns -= stages[kVideoReceiverStage].time_ns;
+  stages[kDemuxStage].allocations -= stages[kVideoReceiverStage].allocations;
+  stages[kVideoReceiverStage].time_ns -= stages[kFrameBufferStage].time_ns;
+  stages[kVideoReceiverStage].allocations -=
+      stages[kFrameBufferStage].allocations;
+
+  result->packets += packets.size();
+  result->total_time_ns += run_end.time_ns - run_start.time_ns;
+  for (RtpReceiveBenchmarkResult::Stage& stage : result->stages) {
+    for (int i = 0; i < kNumStages; ++i) {
+      if (stage.name == kStageNames[i]) {
+        stage.time_ns += stages[i].time_ns;
+        stage.allocations += stages[i].allocations;
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
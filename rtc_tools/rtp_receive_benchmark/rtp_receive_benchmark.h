@@ -0,0 +1,89 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_TOOLS_RTP_RECEIVE_BENCHMARK_RTP_RECEIVE_BENCHMARK_H_
+#define RTC_TOOLS_RTP_RECEIVE_BENCHMARK_RTP_RECEIVE_BENCHMARK_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "api/rtp_parameters.h"
+#include "api/video/video_codec_type.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "test/rtp_file_reader.h"
+
+namespace webrtc {
+
+struct RtpReceiveBenchmarkOptions {
+  std::string input_file;
+  test::RtpFileReader::FileFormat input_format = test::RtpFileReader::kRtpDump;
+  // Packets are SRTP protected up front, and unprotected as the first stage.
+  bool srtp = false;
+  int video_payload_type = 96;
+  VideoCodecType video_codec = kVideoCodecVP8;
+  std::vector<RtpExtension> extensions;
+  int iterations = 1;
+  // Returns the number of heap allocations made so far by the process. Used
+  // to report allocations per packet and stage, if set.
+  std::function<int64_t()> allocation_count;
+};
+
+struct RtpReceiveBenchmarkResult {
+  struct Stage {
+    std::string name;
+    int64_t time_ns = 0;
+    int64_t allocations = 0;
+  };
+
+  int64_t packets = 0;
+  // Packets that failed SRTP unprotect or parsing, or had no receiver.
+  int64_t dropped_packets = 0;
+  int64_t frames = 0;
+  int64_t total_time_ns = 0;
+  std::vector<Stage> stages;
+};
+
+// Replays the video streams of an RTP dump or pcap through the receive stack:
+// SRTP unprotect, RtpPacketReceived parsing, RtpDemuxer, one
+// RtpVideoStreamReceiver (PacketBuffer and reference finder) per SSRC with
+// |video_payload_type|, and a FrameBuffer per stream from which decodable
+// frames are pulled immediately. Time is simulated from the packet arrival
+// times in the file, so each run does the same work.
+class RtpReceiveBenchmark {
+ public:
+  explicit RtpReceiveBenchmark(const RtpReceiveBenchmarkOptions& options);
+  ~RtpReceiveBenchmark();
+
+  // Reads the input file. Returns false if it can't be read or has no video
+  // packets.
+  bool Init();
+
+  // Runs all iterations; results are summed over them.
+  RtpReceiveBenchmarkResult Run();
+
+ private:
+  struct InputPacket {
+    rtc::CopyOnWriteBuffer data;
+    int64_t arrival_time_ms;
+  };
+
+  void RunOnce(RtpReceiveBenchmarkResult* result);
+
+  const RtpReceiveBenchmarkOptions options_;
+  std::vector<InputPacket> packets_;
+  std::vector<uint32_t> video_ssrcs_;
+};
+
+}  // namespace webrtc
+
+#endif  // RTC_TOOLS_RTP_RECEIVE_BENCHMARK_RTP_RECEIVE_BENCHMARK_H_
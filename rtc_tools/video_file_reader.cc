@@ -10,6 +10,12 @@
 
 #include "rtc_tools/video_file_reader.h"
 
+#if defined(WEBRTC_POSIX)
+#include <errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include <cstdio>
 #include <string>
 #include <vector>
@@ -17,7 +23,9 @@
 #include "absl/strings/match.h"
 #include "absl/types/optional.h"
 #include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/ref_counted_object.h"
 #include "rtc_base/string_encode.h"
@@ -54,6 +62,7 @@ class VideoFile : public Video {
       size_t frame_index) const override {
     RTC_CHECK_LT(frame_index, frame_positions_.size());
 
+    rtc::CritScope lock(&lock_);
     fsetpos(file_, &frame_positions_[frame_index]);
     rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
 
@@ -73,9 +82,92 @@ class VideoFile : public Video {
   const int width_;
   const int height_;
   const std::vector<fpos_t> frame_positions_;
-  FILE* const file_;
+  rtc::CriticalSection lock_;
+  FILE* const file_ RTC_GUARDED_BY(lock_);
 };
 
+#if defined(WEBRTC_POSIX)
+// A .yuv or .y4m file mapped into memory. Frames point into the mapping
+// instead of being read into new buffers, so getting the same frame again is
+// cheap, and keep the file mapped for as long as they are used.
+class MappedVideoFile : public Video {
+ public:
+  MappedVideoFile(int width,
+                  int height,
+                  const std::vector<size_t>& frame_offsets,
+                  const uint8_t* data,
+                  size_t size)
+      : width_(width),
+        height_(height),
+        frame_offsets_(frame_offsets),
+        data_(data),
+        size_(size) {}
+
+  ~MappedVideoFile() override {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+
+  size_t number_of_frames() const override { return frame_offsets_.size(); }
+  int width() const override { return width_; }
+  int height() const override { return height_; }
+
+  rtc::scoped_refptr<I420BufferInterface> GetFrame(
+      size_t frame_index) const override {
+    RTC_CHECK_LT(frame_index, frame_offsets_.size());
+
+    const int chroma_width = width_ / 2;
+    const size_t luma_size = width_ * height_;
+    const size_t chroma_size = chroma_width * (height_ / 2);
+    const size_t offset = frame_offsets_[frame_index];
+    if (offset + luma_size + 2 * chroma_size > size_) {
+      RTC_LOG(LS_ERROR) << "Could not read YUV data for frame " << frame_index;
+      return nullptr;
+    }
+    const uint8_t* data_y = data_ + offset;
+    const uint8_t* data_u = data_y + luma_size;
+    const uint8_t* data_v = data_u + chroma_size;
+    rtc::scoped_refptr<const MappedVideoFile> video(this);
+    return WrapI420Buffer(width_, height_, data_y, width_, data_u,
+                          chroma_width, data_v, chroma_width, [video] {});
+  }
+
+ private:
+  const int width_;
+  const int height_;
+  const std::vector<size_t> frame_offsets_;
+  const uint8_t* const data_;
+  const size_t size_;
+};
+#endif
+
+// Maps |file| into memory if possible, and reads from it otherwise. Takes
+// ownership of |file|.
+rtc::scoped_refptr<Video> CreateVideo(int width,
+                                      int height,
+                                      const std::vector<fpos_t>& positions,
+                                      FILE* file) {
+#if defined(WEBRTC_POSIX)
+  struct stat file_stat;
+  if (fstat(fileno(file), &file_stat) == 0 && file_stat.st_size > 0) {
+    const size_t size = file_stat.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if (data != MAP_FAILED) {
+      std::vector<size_t> frame_offsets;
+      for (const fpos_t& position : positions) {
+        fsetpos(file, &position);
+        frame_offsets.push_back(ftello(file));
+      }
+      fclose(file);
+      return new rtc::RefCountedObject<MappedVideoFile>(
+          width, height, frame_offsets, static_cast<const uint8_t*>(data),
+          size);
+    }
+    RTC_LOG(LS_WARNING) << "Could not map video file, errno = " << errno;
+  }
+#endif
+  return new rtc::RefCountedObject<VideoFile>(width, height, positions, file);
+}
+
 }  // namespace
 
 Video::Iterator::Iterator(const rtc::scoped_refptr<const Video>& video,
@@ -224,8 +316,7 @@ rtc::scoped_refptr<Video> OpenY4mFile(const std::string& file_name) {
   }
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
-  return new rtc::RefCountedObject<VideoFile>(*width, *height, frame_positions,
-                                              file);
+  return CreateVideo(*width, *height, frame_positions, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
@@ -266,8 +357,7 @@ rtc::scoped_refptr<Video> OpenYuvFile(const std::string& file_name,
   }
   RTC_LOG(LS_INFO) << "Video has " << frame_positions.size() << " frames";
 
-  return new rtc::RefCountedObject<VideoFile>(width, height, frame_positions,
-                                              file);
+  return CreateVideo(width, height, frame_positions, file);
 }
 
 rtc::scoped_refptr<Video> OpenYuvOrY4mFile(const std::string& file_name,
@@ -73,6 +73,13 @@ TEST_F(Y4mFileReaderTest, TestPixelContent) {
   }
 }
 
+TEST_F(Y4mFileReaderTest, FrameOutlivesVideo) {
+  rtc::scoped_refptr<I420BufferInterface> frame = video->GetFrame(1);
+  video = nullptr;
+  for (int i = 0; i < 6 * 4; ++i)
+    EXPECT_EQ(6 * 4 * 3 / 2 + i, frame->DataY()[i]);
+}
+
 class YuvFileReaderTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -106,6 +106,7 @@ int AAudioPlayer::StopPlayout() {
   thread_checker_aaudio_.Detach();
   initialized_ = false;
   playing_ = false;
+  measured_latency_ms_.store(0, std::memory_order_relaxed);
   return 0;
 }
 
@@ -148,6 +149,18 @@ absl::optional<uint32_t> AAudioPlayer::MinSpeakerVolume() const {
   return absl::nullopt;
 }
 
+int AAudioPlayer::GetPlayoutUnderrunCount() {
+  RTC_DCHECK_RUN_ON(&main_thread_checker_);
+  return playing_ ? aaudio_.xrun_count() : -1;
+}
+
+absl::optional<int> AAudioPlayer::PlayoutLatencyMs() const {
+  const int latency_ms = measured_latency_ms_.load(std::memory_order_relaxed);
+  if (latency_ms <= 0)
+    return absl::nullopt;
+  return latency_ms;
+}
+
 void AAudioPlayer::OnErrorCallback(aaudio_result_t error) {
   RTC_LOG(LS_ERROR) << "OnErrorCallback: " << AAudio_convertResultToText(error);
   // TODO(henrika): investigate if we can use a thread checker here. Initial
@@ -192,6 +205,8 @@ aaudio_data_callback_result_t AAudioPlayer::OnDataCallback(void* audio_data,
   // Estimate latency between writing an audio frame to the output stream and
   // the time that same frame is played out on the output audio device.
   latency_millis_ = aaudio_.EstimateLatencyMillis();
+  measured_latency_ms_.store(static_cast<int>(latency_millis_ + 0.5),
+                             std::memory_order_relaxed);
   // TODO(henrika): use for development only.
   if (aaudio_.frames_written() % (1000 * aaudio_.frames_per_burst()) == 0) {
     RTC_DLOG(INFO) << "output latency: " << latency_millis_
@@ -12,6 +12,8 @@
 #define SDK_ANDROID_SRC_JNI_AUDIO_DEVICE_AAUDIO_PLAYER_H_
 
 #include <aaudio/AAudio.h>
+
+#include <atomic>
 #include <memory>
 
 #include "absl/types/optional.h"
@@ -77,6 +79,9 @@ class AAudioPlayer final : public AudioOutput,
   absl::optional<uint32_t> MaxSpeakerVolume() const override;
   absl::optional<uint32_t> MinSpeakerVolume() const override;
 
+  int GetPlayoutUnderrunCount() override;
+  absl::optional<int> PlayoutLatencyMs() const override;
+
  protected:
   // AAudioObserverInterface implementation.
 
@@ -144,6 +149,9 @@ class AAudioPlayer final : public AudioOutput,
   // Estimated latency between writing an audio frame to the output stream and
   // the time that same frame is played out on the output audio device.
   double latency_millis_ RTC_GUARDED_BY(thread_checker_aaudio_) = 0;
+  // Copy of |latency_millis_| in whole milliseconds which can be read on any
+  // thread. Zero until the latency has been measured.
+  std::atomic<int> measured_latency_ms_{0};
 };
 
 }  // namespace jni
@@ -203,10 +203,34 @@ double AAudioWrapper::EstimateLatencyMillis() const {
   RTC_DCHECK(stream_);
   double latency_millis = 0.0;
   if (direction() == AAUDIO_DIRECTION_INPUT) {
-    // For input streams. Best guess we can do is to use the current burst size
-    // as delay estimate.
-    latency_millis = static_cast<double>(frames_per_burst()) / sample_rate() *
-                     rtc::kNumMillisecsPerSec;
+    int64_t existing_frame_index;
+    int64_t existing_frame_capture_time;
+    // Get the time at which a particular frame was captured by the audio
+    // hardware.
+    aaudio_result_t result =
+        AAudioStream_getTimestamp(stream_, CLOCK_MONOTONIC,
+                                  &existing_frame_index,
+                                  &existing_frame_capture_time);
+    if (result == AAUDIO_OK) {
+      // Number of frames between the next frame to read and the existing
+      // frame.
+      int64_t frame_index_delta = frames_read() - existing_frame_index;
+      // Calculate the time when the next frame to read was captured, taking
+      // sample rate into account.
+      int64_t frame_time_delta =
+          (frame_index_delta * rtc::kNumNanosecsPerSec) / sample_rate();
+      int64_t next_frame_capture_time =
+          existing_frame_capture_time + frame_time_delta;
+      // The next frame is assumed to be read now.
+      latency_millis =
+          static_cast<double>(rtc::TimeNanos() - next_frame_capture_time) /
+          rtc::kNumNanosecsPerMillisec;
+    } else {
+      // Timestamps are not always available for input streams. Best guess we
+      // can do then is to use the current burst size as delay estimate.
+      latency_millis = static_cast<double>(frames_per_burst()) /
+                       sample_rate() * rtc::kNumMillisecsPerSec;
+    }
   } else {
     int64_t existing_frame_index;
     int64_t existing_frame_presentation_time;
@@ -370,10 +394,10 @@ void AAudioWrapper::SetStreamConfiguration(AAudioStreamBuilder* builder) {
   AAudioStreamBuilder_setChannelCount(builder, audio_parameters().channels());
   // Always use 16-bit PCM audio sample format.
   AAudioStreamBuilder_setFormat(builder, AAUDIO_FORMAT_PCM_I16);
-  // TODO(henrika): investigate effect of using AAUDIO_SHARING_MODE_EXCLUSIVE.
-  // Ask for exclusive mode since this will give us the lowest possible latency.
+  // Ask for exclusive mode since this will give us the lowest possible latency,
+  // using an MMAP buffer shared with the audio hardware where supported.
   // If exclusive mode isn't available, shared mode will be used instead.
-  AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_SHARED);
+  AAudioStreamBuilder_setSharingMode(builder, AAUDIO_SHARING_MODE_EXCLUSIVE);
   // Use the direction that was given at construction.
   AAudioStreamBuilder_setDirection(builder, direction_);
   // TODO(henrika): investigate performance using different performance modes.
@@ -444,9 +468,10 @@ bool AAudioWrapper::VerifyStreamConfiguration() {
     RTC_LOG(LS_ERROR) << "Stream unable to use requested format";
     return false;
   }
-  if (AAudioStream_getSharingMode(stream_) != AAUDIO_SHARING_MODE_SHARED) {
-    RTC_LOG(LS_ERROR) << "Stream unable to use requested sharing mode";
-    return false;
+  if (AAudioStream_getSharingMode(stream_) != AAUDIO_SHARING_MODE_EXCLUSIVE) {
+    // Not an error, AAudio falls back to shared mode if the device or an
+    // another stream prevents exclusive access.
+    RTC_LOG(LS_WARNING) << "Stream unable to use exclusive sharing mode";
   }
   if (AAudioStream_getPerformanceMode(stream_) !=
       AAUDIO_PERFORMANCE_MODE_LOW_LATENCY) {
@@ -509,8 +509,12 @@ class AndroidAudioDeviceModule : public AudioDeviceModule {
   }
 
   int32_t PlayoutDelay(uint16_t* delay_ms) const override {
-    // Best guess we can do is to use half of the estimated total delay.
-    *delay_ms = playout_delay_ms_ / 2;
+    // Use the measured output latency if the output can measure it.
+    // Otherwise, best guess we can do is to use half of the estimated total
+    // delay.
+    const absl::optional<int> latency_ms =
+        initialized_ ? output_->PlayoutLatencyMs() : absl::nullopt;
+    *delay_ms = latency_ms ? *latency_ms : playout_delay_ms_ / 2;
     RTC_DCHECK_GT(*delay_ms, 0);
     return 0;
   }
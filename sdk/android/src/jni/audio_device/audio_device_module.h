@@ -66,6 +66,9 @@ class AudioOutput {
   virtual absl::optional<uint32_t> MinSpeakerVolume() const = 0;
   virtual void AttachAudioBuffer(AudioDeviceBuffer* audioBuffer) = 0;
   virtual int GetPlayoutUnderrunCount() = 0;
+  // Returns the measured latency between writing audio to the output and it
+  // being played out, or nullopt if the output can't measure it.
+  virtual absl::optional<int> PlayoutLatencyMs() const = 0;
 };
 
 // Extract an android.media.AudioManager from an android.content.Context.
@@ -181,6 +181,10 @@ int AudioTrackJni::GetPlayoutUnderrunCount() {
   return Java_WebRtcAudioTrack_GetPlayoutUnderrunCount(env_, j_audio_track_);
 }
 
+absl::optional<int> AudioTrackJni::PlayoutLatencyMs() const {
+  return absl::nullopt;
+}
+
 // TODO(henrika): possibly add stereo support.
 void AudioTrackJni::AttachAudioBuffer(AudioDeviceBuffer* audioBuffer) {
   RTC_LOG(INFO) << "AttachAudioBuffer";
@@ -66,6 +66,7 @@ class AudioTrackJni : public AudioOutput {
   absl::optional<uint32_t> MaxSpeakerVolume() const override;
   absl::optional<uint32_t> MinSpeakerVolume() const override;
   int GetPlayoutUnderrunCount() override;
+  absl::optional<int> PlayoutLatencyMs() const override;
 
   void AttachAudioBuffer(AudioDeviceBuffer* audioBuffer) override;
 
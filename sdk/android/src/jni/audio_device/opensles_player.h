@@ -83,6 +83,9 @@ class OpenSLESPlayer : public AudioOutput {
   void AttachAudioBuffer(AudioDeviceBuffer* audioBuffer) override;
 
   int GetPlayoutUnderrunCount() override { return -1; }
+  absl::optional<int> PlayoutLatencyMs() const override {
+    return absl::nullopt;
+  }
 
  private:
   // These callback methods are called when data is required for playout.
@@ -30,6 +30,13 @@
 namespace webrtc {
 namespace jni {
 
+namespace {
+// HardwareVideoEncoder drops input once more than MAX_ENCODER_Q_SIZE (2)
+// frames are waiting for output. Dropping them before they are converted and
+// passed to Java is cheaper.
+constexpr int kMaxHardwareFramesInFlight = 3;
+}  // namespace
+
 VideoEncoderWrapper::VideoEncoderWrapper(JNIEnv* jni,
                                          const JavaRef<jobject>& j_encoder)
     : encoder_(jni, j_encoder), int_array_class_(GetClass(jni, "[I")) {
@@ -97,6 +104,8 @@ int32_t VideoEncoderWrapper::InitEncodeInternal(JNIEnv* jni) {
   encoder_info_.scaling_settings = GetScalingSettingsInternal(jni);
   encoder_info_.is_hardware_accelerated = IsHardwareVideoEncoder(jni, encoder_);
   encoder_info_.has_internal_source = false;
+  encoder_info_.max_frames_in_flight =
+      encoder_info_.is_hardware_accelerated ? kMaxHardwareFramesInFlight : 0;
 
   if (status == WEBRTC_VIDEO_CODEC_OK) {
     initialized_ = true;
@@ -136,12 +145,6 @@ int32_t VideoEncoderWrapper::Encode(
 
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
 
-  // Construct encode info.
-  ScopedJavaLocalRef<jobjectArray> j_frame_types =
-      NativeToJavaFrameTypeArray(jni, *frame_types);
-  ScopedJavaLocalRef<jobject> encode_info =
-      Java_EncodeInfo_Constructor(jni, j_frame_types);
-
   FrameExtraInfo info;
   info.capture_time_ns = frame.timestamp_us() * rtc::kNumNanosecsPerMicrosec;
   info.timestamp_rtp = frame.timestamp();
@@ -149,11 +152,24 @@ int32_t VideoEncoderWrapper::Encode(
 
   ScopedJavaLocalRef<jobject> j_frame = NativeToJavaVideoFrame(jni, frame);
   ScopedJavaLocalRef<jobject> ret =
-      Java_VideoEncoder_encode(jni, encoder_, j_frame, encode_info);
+      Java_VideoEncoder_encode(jni, encoder_, j_frame,
+                               GetEncodeInfo(jni, *frame_types));
   ReleaseJavaVideoFrame(jni, j_frame);
   return HandleReturnCode(jni, ret, "encode");
 }
 
+const ScopedJavaGlobalRef<jobject>& VideoEncoderWrapper::GetEncodeInfo(
+    JNIEnv* jni,
+    const std::vector<VideoFrameType>& frame_types) {
+  if (!encode_info_ || frame_types != encode_info_frame_types_) {
+    ScopedJavaLocalRef<jobjectArray> j_frame_types =
+        NativeToJavaFrameTypeArray(jni, frame_types);
+    encode_info_.emplace(jni, Java_EncodeInfo_Constructor(jni, j_frame_types));
+    encode_info_frame_types_ = frame_types;
+  }
+  return *encode_info_;
+}
+
 void VideoEncoderWrapper::SetRates(const RateControlParameters& parameters) {
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
 
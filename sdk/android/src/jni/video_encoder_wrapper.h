@@ -75,6 +75,12 @@ class VideoEncoderWrapper : public VideoEncoder {
       JNIEnv* jni,
       const VideoBitrateAllocation& allocation);
   std::string GetImplementationName(JNIEnv* jni) const;
+  // Returns the Java EncodeInfo for |frame_types|. The last one is reused
+  // while the frame types don't change, which is the case for the delta
+  // frames between key frames.
+  const ScopedJavaGlobalRef<jobject>& GetEncodeInfo(
+      JNIEnv* jni,
+      const std::vector<VideoFrameType>& frame_types);
 
   ScalingSettings GetScalingSettingsInternal(JNIEnv* jni) const;
 
@@ -87,6 +93,8 @@ class VideoEncoderWrapper : public VideoEncoder {
   rtc::CriticalSection encoder_queue_crit_;
   TaskQueueBase* encoder_queue_ RTC_GUARDED_BY(encoder_queue_crit_);
   std::deque<FrameExtraInfo> frame_extra_infos_;
+  std::vector<VideoFrameType> encode_info_frame_types_;
+  absl::optional<ScopedJavaGlobalRef<jobject>> encode_info_;
   EncodedImageCallback* callback_;
   bool initialized_;
   int num_resets_;
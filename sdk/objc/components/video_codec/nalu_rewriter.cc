@@ -12,6 +12,8 @@
 #include "sdk/objc/components/video_codec/nalu_rewriter.h"
 
 #include <CoreFoundation/CoreFoundation.h>
+#include <string.h>
+
 #include <memory>
 #include <vector>
 
@@ -94,44 +96,42 @@ bool H264CMSampleBufferToAnnexBBuffer(
     RTC_LOG(LS_ERROR) << "Failed to get sample buffer's block buffer.";
     return false;
   }
-  CMBlockBufferRef contiguous_buffer = nullptr;
-  // Make sure block buffer is contiguous.
-  if (!CMBlockBufferIsRangeContiguous(block_buffer, 0, 0)) {
-    status = CMBlockBufferCreateContiguous(
-        nullptr, block_buffer, nullptr, nullptr, 0, 0, 0, &contiguous_buffer);
-    if (status != noErr) {
-      RTC_LOG(LS_ERROR) << "Failed to flatten non-contiguous block buffer: "
-                        << status;
-      return false;
-    }
-  } else {
-    contiguous_buffer = block_buffer;
-    // Retain to make cleanup easier.
-    CFRetain(contiguous_buffer);
-    block_buffer = nullptr;
-  }
 
-  // Now copy the actual data.
-  char* data_ptr = nullptr;
-  size_t block_buffer_size = CMBlockBufferGetDataLength(contiguous_buffer);
-  status = CMBlockBufferGetDataPointer(contiguous_buffer, 0, nullptr, nullptr,
-                                       &data_ptr);
+  // AVCC length headers and Annex B start codes have the same size, so the
+  // NALUs are copied once, straight from the block buffer whether it is
+  // contiguous or not, and their headers are then rewritten in place.
+  const size_t block_buffer_size = CMBlockBufferGetDataLength(block_buffer);
+  const size_t annexb_offset = annexb_buffer->size();
+  annexb_buffer->AppendData(
+      block_buffer_size, [&](rtc::ArrayView<uint8_t> data) {
+        status = CMBlockBufferCopyDataBytes(block_buffer, 0, block_buffer_size,
+                                            data.data());
+        return status == noErr ? block_buffer_size : 0;
+      });
   if (status != noErr) {
-    RTC_LOG(LS_ERROR) << "Failed to get block buffer data.";
-    CFRelease(contiguous_buffer);
+    RTC_LOG(LS_ERROR) << "Failed to get block buffer data: " << status;
     return false;
   }
+
+  uint8_t* data_ptr = annexb_buffer->data() + annexb_offset;
   size_t bytes_remaining = block_buffer_size;
   while (bytes_remaining > 0) {
     // The size type here must match |nalu_header_size|, we expect 4 bytes.
     // Read the length of the next packet of data. Must convert from big endian
     // to host endian.
-    RTC_DCHECK_GE(bytes_remaining, (size_t)nalu_header_size);
-    uint32_t* uint32_data_ptr = reinterpret_cast<uint32_t*>(data_ptr);
-    uint32_t packet_size = CFSwapInt32BigToHost(*uint32_data_ptr);
+    if (bytes_remaining < kAvccHeaderByteSize) {
+      RTC_LOG(LS_ERROR) << "Truncated AVCC NALU header.";
+      return false;
+    }
+    uint32_t packet_size;
+    memcpy(&packet_size, data_ptr, sizeof(packet_size));
+    packet_size = CFSwapInt32BigToHost(packet_size);
+    if (packet_size > bytes_remaining - kAvccHeaderByteSize) {
+      RTC_LOG(LS_ERROR) << "AVCC NALU larger than the sample buffer.";
+      return false;
+    }
     // Update buffer.
-    annexb_buffer->AppendData(kAnnexBHeaderBytes, sizeof(kAnnexBHeaderBytes));
-    annexb_buffer->AppendData(data_ptr + nalu_header_size, packet_size);
+    memcpy(data_ptr, kAnnexBHeaderBytes, sizeof(kAnnexBHeaderBytes));
     // Update fragmentation.
     frag_offsets.push_back(nalu_offset + sizeof(kAnnexBHeaderBytes));
     frag_lengths.push_back(packet_size);
@@ -141,7 +141,6 @@ bool H264CMSampleBufferToAnnexBBuffer(
     bytes_remaining -= bytes_written;
     data_ptr += bytes_written;
   }
-  RTC_DCHECK_EQ(bytes_remaining, (size_t)0);
 
   std::unique_ptr<RTPFragmentationHeader> header(new RTPFragmentationHeader());
   header->VerifyAndAllocateFragmentationHeader(frag_offsets.size());
@@ -151,7 +150,6 @@ bool H264CMSampleBufferToAnnexBBuffer(
     header->fragmentationLength[i] = frag_lengths[i];
   }
   *out_header = std::move(header);
-  CFRelease(contiguous_buffer);
   return true;
 }
 
@@ -115,6 +115,38 @@ std::string RTCStats::ToJson() const {
   return sb.Release();
 }
 
+std::string RTCStats::ToJsonDelta(const RTCStats& previous) const {
+  RTC_DCHECK_EQ(type(), previous.type());
+  std::vector<const RTCStatsMemberInterface*> members = Members();
+  std::vector<const RTCStatsMemberInterface*> previous_members =
+      previous.Members();
+  RTC_DCHECK_EQ(members.size(), previous_members.size());
+  rtc::StringBuilder sb;
+  bool changed = false;
+  for (size_t i = 0; i < members.size(); ++i) {
+    const RTCStatsMemberInterface* member = members[i];
+    if (*member == *previous_members[i])
+      continue;
+    if (!changed) {
+      sb << "{\"type\":\"" << type() << "\","
+         << "\"id\":\"" << id_ << "\","
+         << "\"timestamp\":" << timestamp_us_;
+      changed = true;
+    }
+    sb << ",\"" << member->name() << "\":";
+    if (!member->is_defined())
+      sb << "null";
+    else if (member->is_string())
+      sb << "\"" << member->ValueToJson() << "\"";
+    else
+      sb << member->ValueToJson();
+  }
+  if (!changed)
+    return "";
+  sb << "}";
+  return sb.Release();
+}
+
 std::vector<const RTCStatsMemberInterface*> RTCStats::Members() const {
   return MembersOfThisObjectAndAncestors(0);
 }
@@ -132,4 +132,45 @@ std::string RTCStatsReport::ToJson() const {
   return sb.Release();
 }
 
+std::string RTCStatsReport::ToJsonDelta(const RTCStatsReport& previous) const {
+  rtc::StringBuilder changed;
+  rtc::StringBuilder removed;
+  const char* changed_separator = "";
+  const char* removed_separator = "";
+  // Both maps are ordered by ID, so they are walked side by side.
+  StatsMap::const_iterator it = stats_.begin();
+  StatsMap::const_iterator previous_it = previous.stats_.begin();
+  while (it != stats_.end() || previous_it != previous.stats_.end()) {
+    if (it == stats_.end() ||
+        (previous_it != previous.stats_.end() &&
+         previous_it->first < it->first)) {
+      removed << removed_separator << "\"" << previous_it->first << "\"";
+      removed_separator = ",";
+      ++previous_it;
+      continue;
+    }
+    std::string json;
+    if (previous_it == previous.stats_.end() ||
+        it->first < previous_it->first) {
+      json = it->second->ToJson();
+    } else {
+      if (it->second->type() == previous_it->second->type()) {
+        json = it->second->ToJsonDelta(*previous_it->second);
+      } else {
+        json = it->second->ToJson();
+      }
+      ++previous_it;
+    }
+    if (!json.empty()) {
+      changed << changed_separator << json;
+      changed_separator = ",";
+    }
+    ++it;
+  }
+  rtc::StringBuilder sb;
+  sb << "{\"timestamp\":" << timestamp_us_ << ",\"changed\":["
+     << changed.str() << "],\"removed\":[" << removed.str() << "]}";
+  return sb.Release();
+}
+
 }  // namespace webrtc
@@ -139,4 +139,40 @@ TEST(RTCStatsReport, TakeMembersFrom) {
   EXPECT_EQ(i, static_cast<int64_t>(6));
 }
 
+TEST(RTCStatsReport, ToJsonDelta) {
+  rtc::scoped_refptr<RTCStatsReport> previous = RTCStatsReport::Create(1000);
+  std::unique_ptr<RTCTestStats1> unchanged(new RTCTestStats1("A", 1000));
+  unchanged->integer = 1;
+  previous->AddStats(unchanged->copy());
+  std::unique_ptr<RTCTestStats1> changed(new RTCTestStats1("B", 1000));
+  changed->integer = 2;
+  previous->AddStats(changed->copy());
+  std::unique_ptr<RTCTestStats3> undefined(new RTCTestStats3("C", 1000));
+  undefined->string = "foo";
+  previous->AddStats(std::move(undefined));
+  previous->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats2("D", 1000)));
+
+  rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(2000);
+  report->AddStats(std::move(unchanged));
+  changed->integer = 3;
+  report->AddStats(std::move(changed));
+  report->AddStats(std::unique_ptr<RTCStats>(new RTCTestStats3("C", 2000)));
+  std::unique_ptr<RTCTestStats2> added(new RTCTestStats2("E", 2000));
+  added->number = 0.5;
+  report->AddStats(std::move(added));
+
+  EXPECT_EQ(
+      "{\"timestamp\":2000,\"changed\":["
+      "{\"type\":\"test-stats-1\",\"id\":\"B\",\"timestamp\":1000,"
+      "\"integer\":3},"
+      "{\"type\":\"test-stats-3\",\"id\":\"C\",\"timestamp\":2000,"
+      "\"string\":null},"
+      "{\"type\":\"test-stats-2\",\"id\":\"E\",\"timestamp\":2000,"
+      "\"number\":0.5}],"
+      "\"removed\":[\"D\"]}",
+      report->ToJsonDelta(*previous));
+  EXPECT_EQ("{\"timestamp\":2000,\"changed\":[],\"removed\":[]}",
+            report->ToJsonDelta(*report));
+}
+
 }  // namespace webrtc
@@ -25,7 +25,8 @@ int GetCPUInfoNoASM(CPUFeature feature) {
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
 #ifndef _MSC_VER
-// Intrinsic for "cpuid".
+// Intrinsic for "cpuid". The sub-leaf in ecx is set to zero, which is what
+// the structured extended feature leaf 7 needs.
 #if defined(__pic__) && defined(__i386__)
 static inline void __cpuid(int cpu_info[4], int info_type) {
   __asm__ volatile(
@@ -34,17 +35,29 @@ static inline void __cpuid(int cpu_info[4], int info_type) {
       "xchg %%edi, %%ebx\n"
       : "=a"(cpu_info[0]), "=D"(cpu_info[1]), "=c"(cpu_info[2]),
         "=d"(cpu_info[3])
-      : "a"(info_type));
+      : "a"(info_type), "c"(0));
 }
 #else
 static inline void __cpuid(int cpu_info[4], int info_type) {
   __asm__ volatile("cpuid\n"
                    : "=a"(cpu_info[0]), "=b"(cpu_info[1]), "=c"(cpu_info[2]),
                      "=d"(cpu_info[3])
-                   : "a"(info_type));
+                   : "a"(info_type), "c"(0));
 }
 #endif
 #endif  // _MSC_VER
+
+// xgetbv returns the value of an Intel Extended Control Register (XCR).
+// Currently only XCR0 is defined by Intel so |xcr| should always be zero.
+static inline uint64_t xgetbv(uint32_t xcr) {
+#if defined(_MSC_VER)
+  return _xgetbv(xcr);
+#else
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(xcr));
+  return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif  // _MSC_VER
+}
 #endif  // WEBRTC_ARCH_X86_FAMILY
 
 #if defined(WEBRTC_ARCH_X86_FAMILY)
@@ -58,6 +71,26 @@ static int GetCPUInfo(CPUFeature feature) {
   if (feature == kSSE3) {
     return 0 != (cpu_info[2] & 0x00000001);
   }
+  if (feature == kAVX2) {
+    int cpu_info7[4];
+    __cpuid(cpu_info7, 0);
+    if (cpu_info7[0] < 7) {
+      return 0;
+    }
+#if defined(_MSC_VER)
+    __cpuidex(cpu_info7, 7, 0);
+#else
+    __cpuid(cpu_info7, 7);
+#endif
+    // AVX2 can be used when the CPU supports AVX and AVX2, and the OS saves
+    // the YMM registers on context switches, which is indicated by OSXSAVE
+    // and the SSE and AVX state bits in XCR0.
+    // See http://software.intel.com/en-us/blogs/2011/04/14/is-avx-enabled
+    return 0 != (cpu_info[2] & 0x10000000) /* AVX */ &&
+           0 != (cpu_info[2] & 0x08000000) /* OSXSAVE */ &&
+           (xgetbv(0) & 0x00000006) == 0x00000006 &&
+           0 != (cpu_info7[1] & 0x00000020) /* AVX2 */;
+  }
   return 0;
 }
 #else
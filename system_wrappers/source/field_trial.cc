@@ -28,6 +28,13 @@ static const char* trials_init_string = NULL;
 #ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 namespace {
 constexpr char kPersistentStringSeparator = '/';
+
+// Group names by trial name, parsed once from |trials_init_string| so that
+// lookups on stream creation paths don't re-scan and copy the whole string.
+// Like |trials_init_string|, it is only replaced before any other call into
+// webrtc, and it is never destroyed.
+std::map<std::string, std::string>* parsed_trials = nullptr;
+
 // Validates the given field trial string.
 //  E.g.:
 //    "WebRTC-experimentFoo/Enabled/WebRTC-experimentBar/Enabled100kbps/"
@@ -67,38 +74,40 @@ bool FieldTrialsStringIsValid(const absl::string_view trials) {
 
   return true;
 }
-}  // namespace
-
-std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
-    return std::string();
-
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
-    return std::string();
 
+// Parses |trials| the way it was searched before, that is, up to the first
+// malformed item, with the first group of a duplicated trial winning.
+std::map<std::string, std::string>* ParseFieldTrials(
+    absl::string_view trials) {
+  auto* parsed = new std::map<std::string, std::string>();
   size_t next_item = 0;
-  while (next_item < trials_string.length()) {
+  while (next_item < trials.length()) {
     // Find next name/value pair in field trial configuration string.
-    size_t field_name_end =
-        trials_string.find(kPersistentStringSeparator, next_item);
-    if (field_name_end == trials_string.npos || field_name_end == next_item)
+    size_t field_name_end = trials.find(kPersistentStringSeparator, next_item);
+    if (field_name_end == trials.npos || field_name_end == next_item)
       break;
     size_t field_value_end =
-        trials_string.find(kPersistentStringSeparator, field_name_end + 1);
-    if (field_value_end == trials_string.npos ||
+        trials.find(kPersistentStringSeparator, field_name_end + 1);
+    if (field_value_end == trials.npos ||
         field_value_end == field_name_end + 1)
       break;
-    std::string field_name(trials_string, next_item,
-                           field_name_end - next_item);
-    std::string field_value(trials_string, field_name_end + 1,
-                            field_value_end - field_name_end - 1);
+    parsed->emplace(
+        std::string(trials.substr(next_item, field_name_end - next_item)),
+        std::string(trials.substr(field_name_end + 1,
+                                  field_value_end - field_name_end - 1)));
     next_item = field_value_end + 1;
-
-    if (name == field_name)
-      return field_value;
   }
-  return std::string();
+  return parsed;
+}
+}  // namespace
+
+std::string FindFullName(const std::string& name) {
+  if (parsed_trials == nullptr)
+    return std::string();
+  auto it = parsed_trials->find(name);
+  if (it == parsed_trials->end())
+    return std::string();
+  return it->second;
 }
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 
@@ -112,6 +121,10 @@ void InitFieldTrialsFromString(const char* trials_string) {
   };
 #endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
   trials_init_string = trials_string;
+#ifndef WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
+  delete parsed_trials;
+  parsed_trials = trials_string ? ParseFieldTrials(trials_string) : nullptr;
+#endif  // WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT
 }
 
 const char* GetFieldTrialString() {
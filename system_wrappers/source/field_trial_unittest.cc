@@ -14,6 +14,27 @@
 
 namespace webrtc {
 namespace field_trial {
+#if !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+TEST(FieldTrialTest, FindsGroupsOfTheCurrentString) {
+  const char* previous_trials = GetFieldTrialString();
+  InitFieldTrialsFromString("Audio/Enabled/Video/Disabled-2/Audio/Enabled/");
+  EXPECT_EQ("Enabled", FindFullName("Audio"));
+  EXPECT_EQ("Disabled-2", FindFullName("Video"));
+  EXPECT_EQ("", FindFullName("Vid"));
+  EXPECT_EQ("", FindFullName("Enabled"));
+  EXPECT_TRUE(IsEnabled("Audio"));
+  EXPECT_TRUE(IsDisabled("Video"));
+
+  InitFieldTrialsFromString("Video/Enabled/");
+  EXPECT_EQ("", FindFullName("Audio"));
+  EXPECT_EQ("Enabled", FindFullName("Video"));
+
+  InitFieldTrialsFromString(nullptr);
+  EXPECT_EQ("", FindFullName("Video"));
+  InitFieldTrialsFromString(previous_trials);
+}
+#endif  // !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
+
 #if GTEST_HAS_DEATH_TEST && RTC_DCHECK_IS_ON && !defined(WEBRTC_ANDROID) && \
     !defined(WEBRTC_EXCLUDE_FIELD_TRIAL_DEFAULT)
 TEST(FieldTrialValidationTest, AcceptsValidInputs) {
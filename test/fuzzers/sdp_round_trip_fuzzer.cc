@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/jsep_session_description.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+// Checks that whatever the parser accepts serializes to an SDP that parses
+// back to the same description, so that the parser and serializer stay in
+// agreement on every field they tokenize.
+void FuzzOneInput(const uint8_t* data, size_t size) {
+  if (size > 16384) {
+    return;
+  }
+  std::string message(reinterpret_cast<const char*>(data), size);
+  webrtc::SdpParseError error;
+
+  std::unique_ptr<webrtc::SessionDescriptionInterface> sdp(
+      CreateSessionDescription("offer", message, &error));
+  if (!sdp) {
+    return;
+  }
+  std::string serialized;
+  if (!sdp->ToString(&serialized)) {
+    return;
+  }
+
+  std::unique_ptr<webrtc::SessionDescriptionInterface> reparsed(
+      CreateSessionDescription("offer", serialized, &error));
+  RTC_CHECK(reparsed) << error.description << ": " << error.line;
+  std::string reserialized;
+  RTC_CHECK(reparsed->ToString(&reserialized));
+  RTC_CHECK_EQ(serialized, reserialized);
+}
+
+}  // namespace webrtc
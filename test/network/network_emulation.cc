@@ -27,54 +27,68 @@ EmulatedIpPacket::EmulatedIpPacket(const rtc::SocketAddress& from,
     : from(from), to(to), data(data), arrival_time(arrival_time) {}
 
 void LinkEmulation::OnPacketReceived(EmulatedIpPacket packet) {
-  task_queue_->PostTask([this, packet = std::move(packet)]() mutable {
+  {
+    rtc::CritScope lock(&incoming_lock_);
+    incoming_packets_.push_back(std::move(packet));
+    // Already posted for the packets received earlier.
+    if (incoming_packets_.size() > 1)
+      return;
+  }
+  task_queue_->PostTask([this]() {
     RTC_DCHECK_RUN_ON(task_queue_);
+    EnqueueIncomingPackets();
+  });
+}
 
-    uint64_t packet_id = next_packet_id_++;
-    bool sent = network_behavior_->EnqueuePacket(
-        PacketInFlightInfo(packet.size(), packet.arrival_time.us(), packet_id));
+void LinkEmulation::EnqueueIncomingPackets() {
+  std::vector<EmulatedIpPacket> incoming_packets;
+  {
+    rtc::CritScope lock(&incoming_lock_);
+    incoming_packets.swap(incoming_packets_);
+  }
+  for (EmulatedIpPacket& packet : incoming_packets) {
+    bool sent = network_behavior_->EnqueuePacket(PacketInFlightInfo(
+        packet.size(), packet.arrival_time.us(), next_packet_id_));
     if (sent) {
-      packets_.emplace_back(StoredPacket{packet_id, std::move(packet), false});
+      packets_.emplace_back(
+          StoredPacket{next_packet_id_++, std::move(packet), false});
     }
-    if (process_task_.Running())
-      return;
-    absl::optional<int64_t> next_time_us =
-        network_behavior_->NextDeliveryTimeUs();
-    if (!next_time_us)
-      return;
-    Timestamp current_time = clock_->CurrentTime();
-    process_task_ = RepeatingTaskHandle::DelayedStart(
-        task_queue_->Get(),
-        std::max(TimeDelta::Zero(),
-                 Timestamp::us(*next_time_us) - current_time),
-        [this]() {
-          RTC_DCHECK_RUN_ON(task_queue_);
-          Timestamp current_time = clock_->CurrentTime();
-          Process(current_time);
-          absl::optional<int64_t> next_time_us =
-              network_behavior_->NextDeliveryTimeUs();
-          if (!next_time_us) {
-            process_task_.Stop();
-            return TimeDelta::Zero();  // This is ignored.
-          }
-          RTC_DCHECK_GE(*next_time_us, current_time.us());
-          return Timestamp::us(*next_time_us) - current_time;
-        });
-  });
+  }
+  if (process_task_.Running())
+    return;
+  absl::optional<int64_t> next_time_us =
+      network_behavior_->NextDeliveryTimeUs();
+  if (!next_time_us)
+    return;
+  Timestamp current_time = clock_->CurrentTime();
+  process_task_ = RepeatingTaskHandle::DelayedStart(
+      task_queue_->Get(),
+      std::max(TimeDelta::Zero(), Timestamp::us(*next_time_us) - current_time),
+      [this]() {
+        RTC_DCHECK_RUN_ON(task_queue_);
+        Timestamp current_time = clock_->CurrentTime();
+        Process(current_time);
+        absl::optional<int64_t> next_time_us =
+            network_behavior_->NextDeliveryTimeUs();
+        if (!next_time_us) {
+          process_task_.Stop();
+          return TimeDelta::Zero();  // This is ignored.
+        }
+        RTC_DCHECK_GE(*next_time_us, current_time.us());
+        return Timestamp::us(*next_time_us) - current_time;
+      });
 }
 
 void LinkEmulation::Process(Timestamp at_time) {
   std::vector<PacketDeliveryInfo> delivery_infos =
       network_behavior_->DequeueDeliverablePackets(at_time.us());
   for (PacketDeliveryInfo& delivery_info : delivery_infos) {
-    StoredPacket* packet = nullptr;
-    for (auto& stored_packet : packets_) {
-      if (stored_packet.id == delivery_info.packet_id) {
-        packet = &stored_packet;
-        break;
-      }
-    }
-    RTC_CHECK(packet);
+    RTC_CHECK(!packets_.empty());
+    RTC_CHECK_GE(delivery_info.packet_id, packets_.front().id);
+    uint64_t offset = delivery_info.packet_id - packets_.front().id;
+    RTC_CHECK_LT(offset, packets_.size());
+    StoredPacket* packet = &packets_[offset];
+    RTC_DCHECK_EQ(packet->id, delivery_info.packet_id);
     RTC_DCHECK(!packet->removed);
     packet->removed = true;
 
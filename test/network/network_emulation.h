@@ -24,6 +24,7 @@
 #include "api/test/simulated_network.h"
 #include "api/units/timestamp.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/critical_section.h"
 #include "rtc_base/network.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/task_queue_for_test.h"
@@ -81,6 +82,8 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
     EmulatedIpPacket packet;
     bool removed;
   };
+  // Passes the packets received since the last call to |network_behavior_|.
+  void EnqueueIncomingPackets() RTC_RUN_ON(task_queue_);
   void Process(Timestamp at_time) RTC_RUN_ON(task_queue_);
 
   Clock* const clock_;
@@ -89,6 +92,13 @@ class LinkEmulation : public EmulatedNetworkReceiverInterface {
       RTC_GUARDED_BY(task_queue_);
   EmulatedNetworkReceiverInterface* const receiver_;
   RepeatingTaskHandle process_task_ RTC_GUARDED_BY(task_queue_);
+  // Packets received and not yet enqueued. A single task is posted to enqueue
+  // all packets received in the meantime, rather than one per packet.
+  rtc::CriticalSection incoming_lock_;
+  std::vector<EmulatedIpPacket> incoming_packets_
+      RTC_GUARDED_BY(incoming_lock_);
+  // Packets enqueued to |network_behavior_|, by increasing id, without gaps,
+  // so that a packet is looked up by its offset from the first.
   std::deque<StoredPacket> packets_ RTC_GUARDED_BY(task_queue_);
   uint64_t next_packet_id_ RTC_GUARDED_BY(task_queue_) = 1;
 };
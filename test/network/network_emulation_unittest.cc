@@ -13,12 +13,14 @@
 #include <atomic>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "api/test/simulated_network.h"
 #include "api/units/time_delta.h"
 #include "call/simulated_network.h"
 #include "rtc_base/event.h"
 #include "rtc_base/gunit.h"
+#include "rtc_base/task_queue_for_test.h"
 #include "system_wrappers/include/sleep.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -145,6 +147,37 @@ class NetworkEmulationManagerThreeNodesRoutingTest : public ::testing::Test {
   EmulatedEndpoint* e3_;
 };
 
+// Drops every third packet on enqueue and delivers the others all at once, in
+// reverse order, a millisecond after the last one was enqueued.
+class ReversingNetworkBehavior : public NetworkBehaviorInterface {
+ public:
+  bool EnqueuePacket(PacketInFlightInfo packet_info) override {
+    if (++num_enqueued_ % 3 == 0)
+      return false;
+    packets_.push_back(packet_info);
+    return true;
+  }
+  std::vector<PacketDeliveryInfo> DequeueDeliverablePackets(
+      int64_t receive_time_us) override {
+    std::vector<PacketDeliveryInfo> delivered;
+    if (packets_.empty() || receive_time_us < *NextDeliveryTimeUs())
+      return delivered;
+    for (auto it = packets_.rbegin(); it != packets_.rend(); ++it)
+      delivered.emplace_back(*it, receive_time_us);
+    packets_.clear();
+    return delivered;
+  }
+  absl::optional<int64_t> NextDeliveryTimeUs() const override {
+    if (packets_.empty())
+      return absl::nullopt;
+    return packets_.back().send_time_us + 1000;
+  }
+
+ private:
+  int num_enqueued_ = 0;
+  std::vector<PacketInFlightInfo> packets_;
+};
+
 EmulatedNetworkNode* CreateEmulatedNodeWithDefaultBuiltInConfig(
     NetworkEmulationManager* emulation) {
   return emulation->CreateEmulatedNode(
@@ -327,6 +360,40 @@ TEST(NetworkEmulationManagerTest, ThroughputStats) {
   delete s2;
 }
 
+TEST(LinkEmulationTest, DeliversPacketsInAnyOrderAfterDrops) {
+  const int kNumPackets = 30;
+  Clock* clock = Clock::GetRealTimeClock();
+  TaskQueueForTest task_queue;
+  ::testing::NiceMock<MockReceiver> receiver;
+  std::vector<uint8_t> received;
+  rtc::Event all_received;
+  EXPECT_CALL(receiver, OnPacketReceived(_))
+      .WillRepeatedly([&](EmulatedIpPacket packet) {
+        received.push_back(packet.cdata()[0]);
+        if (received.size() == static_cast<size_t>(kNumPackets * 2 / 3))
+          all_received.Set();
+      });
+  LinkEmulation link(clock, &task_queue,
+                     std::make_unique<ReversingNetworkBehavior>(), &receiver);
+  // Received as one batch, since the task queue is blocked meanwhile.
+  task_queue.SendTask([&] {
+    for (uint8_t i = 0; i < kNumPackets; ++i) {
+      rtc::CopyOnWriteBuffer data(1);
+      data[0] = i;
+      link.OnPacketReceived(EmulatedIpPacket(rtc::SocketAddress(),
+                                             rtc::SocketAddress(), data,
+                                             clock->CurrentTime()));
+    }
+  });
+  ASSERT_TRUE(all_received.Wait(kNetworkPacketWaitTimeoutMs));
+  std::vector<uint8_t> expected;
+  for (uint8_t i = kNumPackets; i > 0; --i) {
+    if (i % 3 != 0)
+      expected.push_back(i - 1);
+  }
+  task_queue.SendTask([&] { EXPECT_EQ(received, expected); });
+}
+
 // Testing that packets are delivered via all routes using a routing scheme as
 // follows:
 //  * e1 -> n1 -> e2
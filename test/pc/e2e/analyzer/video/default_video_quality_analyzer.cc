@@ -22,7 +22,6 @@ namespace webrtc {
 namespace webrtc_pc_e2e {
 namespace {
 
-constexpr int kMaxActiveComparisons = 10;
 constexpr int kFreezeThresholdMs = 150;
 constexpr int kMicrosPerSecond = 1000000;
 constexpr int kBitsInByte = 8;
@@ -43,8 +42,18 @@ void LogStreamInternalStats(const std::string& name, const StreamStats& stats) {
                 << stats.dropped_before_encoder;
 }
 
+// Returns the size of |frame| once converted to I420 for comparison.
+size_t FrameSizeBytes(const absl::optional<VideoFrame>& frame) {
+  if (!frame) {
+    return 0;
+  }
+  return CalcBufferSize(VideoType::kI420, frame->width(), frame->height());
+}
+
 }  // namespace
 
+constexpr size_t DefaultVideoQualityAnalyzer::kMaxComparisonsQueueSizeBytes;
+
 void RateCounter::AddEvent(Timestamp event_time) {
   if (event_first_time_.IsMinusInfinity()) {
     event_first_time_ = event_time;
@@ -63,9 +72,13 @@ double RateCounter::GetEventsPerSecond() const {
 }
 
 DefaultVideoQualityAnalyzer::DefaultVideoQualityAnalyzer(
-    bool heavy_metrics_computation_enabled)
+    bool heavy_metrics_computation_enabled,
+    int heavy_metrics_sampling_interval)
     : heavy_metrics_computation_enabled_(heavy_metrics_computation_enabled),
-      clock_(Clock::GetRealTimeClock()) {}
+      heavy_metrics_sampling_interval_(heavy_metrics_sampling_interval),
+      clock_(Clock::GetRealTimeClock()) {
+  RTC_CHECK_GE(heavy_metrics_sampling_interval_, 1);
+}
 DefaultVideoQualityAnalyzer::~DefaultVideoQualityAnalyzer() {
   Stop();
 }
@@ -98,19 +111,19 @@ uint16_t DefaultVideoQualityAnalyzer::OnFrameCaptured(
   Timestamp start_time = Timestamp::MinusInfinity();
   {
     rtc::CritScope crit(&lock_);
-    // Create a local copy of start_time_ to access it under |comparison_lock_|
-    // without holding a |lock_|
+    // Create a local copy of start_time_ to access it under
+    // |stream_stats_lock_| without holding a |lock_|
     start_time = start_time_;
   }
   {
     // Ensure stats for this stream exists.
-    rtc::CritScope crit(&comparison_lock_);
+    rtc::CritScope crit(&stream_stats_lock_);
     if (stream_stats_.find(stream_label) == stream_stats_.end()) {
-      stream_stats_.insert({stream_label, StreamStats()});
       // Assume that the first freeze was before first stream frame captured.
       // This way time before the first freeze would be counted as time between
       // freezes.
-      stream_last_freeze_end_time_.insert({stream_label, start_time});
+      stream_stats_.emplace(stream_label,
+                            std::make_unique<StreamStatsShard>(start_time));
     }
   }
   {
@@ -133,7 +146,8 @@ uint16_t DefaultVideoQualityAnalyzer::OnFrameCaptured(
       state->frame_ids.pop_front();
       frame_counters_.dropped++;
       stream_frame_counters_[stream_label].dropped++;
-      AddComparison(it->second, absl::nullopt, true, stats_it->second);
+      AddComparison(std::move(it->second), absl::nullopt, true,
+                    std::move(stats_it->second));
 
       captured_frames_in_flight_.erase(it);
       frame_stats_.erase(stats_it);
@@ -240,13 +254,12 @@ void DefaultVideoQualityAnalyzer::OnFrameRendered(
   // Find corresponding captured frame.
   auto frame_it = captured_frames_in_flight_.find(frame.id());
   RTC_DCHECK(frame_it != captured_frames_in_flight_.end());
-  const VideoFrame& captured_frame = frame_it->second;
 
   // After we received frame here we need to check if there are any dropped
   // frames between this one and last one, that was rendered for this video
   // stream.
 
-  const std::string& stream_label = frame_stats->stream_label;
+  const std::string stream_label = frame_stats->stream_label;
   StreamState* state = &stream_states_[stream_label];
   int dropped_count = 0;
   while (!state->frame_ids.empty() && state->frame_ids.front() != frame.id()) {
@@ -267,8 +280,8 @@ void DefaultVideoQualityAnalyzer::OnFrameRendered(
     auto dropped_frame_it = captured_frames_in_flight_.find(dropped_frame_id);
     RTC_CHECK(dropped_frame_it != captured_frames_in_flight_.end());
 
-    AddComparison(dropped_frame_it->second, absl::nullopt, true,
-                  dropped_frame_stats_it->second);
+    AddComparison(std::move(dropped_frame_it->second), absl::nullopt, true,
+                  std::move(dropped_frame_stats_it->second));
 
     frame_stats_.erase(dropped_frame_stats_it);
     captured_frames_in_flight_.erase(dropped_frame_it);
@@ -282,11 +295,14 @@ void DefaultVideoQualityAnalyzer::OnFrameRendered(
   }
   state->last_rendered_frame_time = frame_stats->rendered_time;
   {
-    rtc::CritScope cr(&comparison_lock_);
-    stream_stats_[stream_label].skipped_between_rendered.AddSample(
-        dropped_count);
+    StreamStatsShard* shard = GetStreamStatsShard(stream_label);
+    rtc::CritScope cr(&shard->lock);
+    shard->stats.skipped_between_rendered.AddSample(dropped_count);
   }
-  AddComparison(captured_frame, frame, false, *frame_stats);
+  // The frames share their buffers with the pipeline, so only references are
+  // queued.
+  AddComparison(std::move(frame_it->second), frame, false,
+                std::move(*frame_stats));
 
   captured_frames_in_flight_.erase(frame_it);
   frame_stats_.erase(stats_it);
@@ -327,18 +343,20 @@ void DefaultVideoQualityAnalyzer::Stop() {
     // Count time since the last freeze to the end of the call as time
     // between freezes.
     rtc::CritScope crit1(&lock_);
-    rtc::CritScope crit2(&comparison_lock_);
+    rtc::CritScope crit2(&stream_stats_lock_);
     for (auto& item : stream_stats_) {
       const StreamState& state = stream_states_[item.first];
+      StreamStatsShard* shard = item.second.get();
+      rtc::CritScope crit3(&shard->lock);
       // If there are no freezes in the call we have to report
       // time_between_freezes_ms as call duration and in such case
       // |stream_last_freeze_end_time_| for this stream will be |start_time_|.
       // If there is freeze, then we need add time from last rendered frame
       // to last freeze end as time between freezes.
       if (state.last_rendered_frame_time) {
-        item.second.time_between_freezes_ms.AddSample(
+        shard->stats.time_between_freezes_ms.AddSample(
             (state.last_rendered_frame_time.value() -
-             stream_last_freeze_end_time_.at(item.first))
+             shard->last_freeze_end_time)
                 .ms());
       }
     }
@@ -364,7 +382,7 @@ std::string DefaultVideoQualityAnalyzer::GetStreamLabel(uint16_t frame_id) {
 
 std::set<std::string> DefaultVideoQualityAnalyzer::GetKnownVideoStreams()
     const {
-  rtc::CritScope crit2(&comparison_lock_);
+  rtc::CritScope crit2(&stream_stats_lock_);
   std::set<std::string> out;
   for (auto& item : stream_stats_) {
     out.insert(item.first);
@@ -385,8 +403,13 @@ DefaultVideoQualityAnalyzer::GetPerStreamCounters() const {
 
 std::map<std::string, StreamStats> DefaultVideoQualityAnalyzer::GetStats()
     const {
-  rtc::CritScope cri(&comparison_lock_);
-  return stream_stats_;
+  rtc::CritScope cri(&stream_stats_lock_);
+  std::map<std::string, StreamStats> out;
+  for (auto& item : stream_stats_) {
+    rtc::CritScope crit(&item.second->lock);
+    out.insert({item.first, item.second->stats});
+  }
+  return out;
 }
 
 AnalyzerStats DefaultVideoQualityAnalyzer::GetAnalyzerStats() const {
@@ -452,16 +475,27 @@ void DefaultVideoQualityAnalyzer::AddComparison(
     absl::optional<VideoFrame> rendered,
     bool dropped,
     FrameStats frame_stats) {
+  const bool sampled =
+      !captured || captured->id() % heavy_metrics_sampling_interval_ == 0;
+  const size_t size_bytes = FrameSizeBytes(captured) + FrameSizeBytes(rendered);
   rtc::CritScope crit(&comparison_lock_);
   analyzer_stats_.comparisons_queue_size.AddSample(comparisons_.size());
-  // If there too many computations waiting in the queue, we won't provide
-  // frames itself to make future computations lighter.
-  if (comparisons_.size() >= kMaxActiveComparisons) {
-    comparisons_.emplace_back(dropped, frame_stats);
+  // If the frames waiting in the queue take up too much memory, we won't
+  // provide frames itself, which also makes future computations lighter.
+  if (!sampled) {
+    comparisons_.emplace_back(dropped, /*sampled=*/false,
+                              std::move(frame_stats));
+  } else if (comparisons_queue_size_bytes_ + size_bytes >
+             kMaxComparisonsQueueSizeBytes) {
+    comparisons_.emplace_back(dropped, /*sampled=*/true,
+                              std::move(frame_stats));
   } else {
     comparisons_.emplace_back(std::move(captured), std::move(rendered), dropped,
-                              frame_stats);
+                              std::move(frame_stats));
+    comparisons_queue_size_bytes_ += size_bytes;
   }
+  analyzer_stats_.comparisons_queue_size_bytes.AddSample(
+      comparisons_queue_size_bytes_);
   comparison_available_event_.Set();
 }
 
@@ -476,8 +510,10 @@ void DefaultVideoQualityAnalyzer::ProcessComparisons() {
     {
       rtc::CritScope crit(&comparison_lock_);
       if (!comparisons_.empty()) {
-        comparison = comparisons_.front();
+        comparison = std::move(comparisons_.front());
         comparisons_.pop_front();
+        comparisons_queue_size_bytes_ -= FrameSizeBytes(comparison->captured) +
+                                         FrameSizeBytes(comparison->rendered);
         if (!comparisons_.empty()) {
           comparison_available_event_.Set();
         }
@@ -516,14 +552,19 @@ void DefaultVideoQualityAnalyzer::ProcessComparison(
 
   const FrameStats& frame_stats = comparison.frame_stats;
 
-  rtc::CritScope crit(&comparison_lock_);
-  auto stats_it = stream_stats_.find(frame_stats.stream_label);
-  RTC_CHECK(stats_it != stream_stats_.end());
-  StreamStats* stats = &stats_it->second;
-  analyzer_stats_.comparisons_done++;
-  if (!comparison.captured) {
-    analyzer_stats_.overloaded_comparisons_done++;
+  {
+    rtc::CritScope crit(&comparison_lock_);
+    analyzer_stats_.comparisons_done++;
+    if (!comparison.sampled) {
+      analyzer_stats_.not_sampled_comparisons_done++;
+    } else if (!comparison.captured) {
+      analyzer_stats_.overloaded_comparisons_done++;
+    }
   }
+
+  StreamStatsShard* shard = GetStreamStatsShard(frame_stats.stream_label);
+  rtc::CritScope crit(&shard->lock);
+  StreamStats* stats = &shard->stats;
   if (psnr > 0) {
     stats->psnr.AddSample(psnr);
   }
@@ -566,23 +607,31 @@ void DefaultVideoQualityAnalyzer::ProcessComparison(
           std::max(kFreezeThresholdMs + average_time_between_rendered_frames_ms,
                    3 * average_time_between_rendered_frames_ms)) {
         stats->freeze_time_ms.AddSample(time_between_rendered_frames.ms());
-        auto freeze_end_it =
-            stream_last_freeze_end_time_.find(frame_stats.stream_label);
-        RTC_DCHECK(freeze_end_it != stream_last_freeze_end_time_.end());
         stats->time_between_freezes_ms.AddSample(
-            (frame_stats.prev_frame_rendered_time - freeze_end_it->second)
+            (frame_stats.prev_frame_rendered_time -
+             shard->last_freeze_end_time)
                 .ms());
-        freeze_end_it->second = frame_stats.rendered_time;
+        shard->last_freeze_end_time = frame_stats.rendered_time;
       }
     }
   }
 }
 
+DefaultVideoQualityAnalyzer::StreamStatsShard*
+DefaultVideoQualityAnalyzer::GetStreamStatsShard(
+    const std::string& stream_label) const {
+  rtc::CritScope crit(&stream_stats_lock_);
+  auto it = stream_stats_.find(stream_label);
+  RTC_CHECK(it != stream_stats_.end());
+  return it->second.get();
+}
+
 void DefaultVideoQualityAnalyzer::ReportResults() {
   rtc::CritScope crit1(&lock_);
-  rtc::CritScope crit2(&comparison_lock_);
+  rtc::CritScope crit2(&stream_stats_lock_);
   for (auto& item : stream_stats_) {
-    ReportResults(GetTestCaseName(item.first), item.second,
+    rtc::CritScope crit3(&item.second->lock);
+    ReportResults(GetTestCaseName(item.first), item.second->stats,
                   stream_frame_counters_.at(item.first));
   }
   {
@@ -593,9 +642,11 @@ void DefaultVideoQualityAnalyzer::ReportResults() {
   }
   LogFrameCounters("Global", frame_counters_);
   for (auto& item : stream_stats_) {
+    rtc::CritScope crit3(&item.second->lock);
     LogFrameCounters(item.first, stream_frame_counters_.at(item.first));
-    LogStreamInternalStats(item.first, item.second);
+    LogStreamInternalStats(item.first, item.second->stats);
   }
+  rtc::CritScope crit3(&comparison_lock_);
   if (!analyzer_stats_.comparisons_queue_size.IsEmpty()) {
     RTC_LOG(INFO) << "comparisons_queue_size min="
                   << analyzer_stats_.comparisons_queue_size.GetMin()
@@ -603,9 +654,15 @@ void DefaultVideoQualityAnalyzer::ReportResults() {
                   << "; 99%="
                   << analyzer_stats_.comparisons_queue_size.GetPercentile(0.99);
   }
+  if (!analyzer_stats_.comparisons_queue_size_bytes.IsEmpty()) {
+    RTC_LOG(INFO) << "comparisons_queue_size_bytes max="
+                  << analyzer_stats_.comparisons_queue_size_bytes.GetMax();
+  }
   RTC_LOG(INFO) << "comparisons_done=" << analyzer_stats_.comparisons_done;
   RTC_LOG(INFO) << "overloaded_comparisons_done="
                 << analyzer_stats_.overloaded_comparisons_done;
+  RTC_LOG(INFO) << "not_sampled_comparisons_done="
+                << analyzer_stats_.not_sampled_comparisons_done;
 }
 
 void DefaultVideoQualityAnalyzer::ReportVideoBweResults(
@@ -717,10 +774,12 @@ DefaultVideoQualityAnalyzer::FrameComparison::FrameComparison(
 
 DefaultVideoQualityAnalyzer::FrameComparison::FrameComparison(
     bool dropped,
+    bool sampled,
     FrameStats frame_stats)
     : captured(absl::nullopt),
       rendered(absl::nullopt),
       dropped(dropped),
+      sampled(sampled),
       frame_stats(std::move(frame_stats)) {}
 
 }  // namespace webrtc_pc_e2e
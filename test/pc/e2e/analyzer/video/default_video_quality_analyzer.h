@@ -105,14 +105,21 @@ struct AnalyzerStats {
   // Size of analyzer internal comparisons queue, measured when new element
   // id added to the queue.
   SamplesStatsCounter comparisons_queue_size;
+  // Size of the frames held by the comparisons queue, measured when new
+  // element is added to the queue.
+  SamplesStatsCounter comparisons_queue_size_bytes;
   // Amount of performed comparisons of 2 video frames from captured and
   // rendered streams.
   int64_t comparisons_done = 0;
   // Amount of overloaded comparisons. Comparison is overloaded if it is queued
-  // when there are too many not processed comparisons in the queue. Overloaded
+  // when the frames of not processed comparisons in the queue already take up
+  // kMaxComparisonsQueueSizeBytes. Overloaded
   // comparison doesn't include metrics, that require heavy computations like
   // SSIM and PSNR.
   int64_t overloaded_comparisons_done = 0;
+  // Amount of comparisons of frames left out by sampling. Like overloaded
+  // comparisons, they don't include SSIM and PSNR.
+  int64_t not_sampled_comparisons_done = 0;
 };
 
 struct VideoBweStats {
@@ -125,8 +132,16 @@ struct VideoBweStats {
 
 class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
  public:
+  // Comparisons stop holding frames once the frames already queued take up
+  // this much memory, so that memory use doesn't grow with the resolution.
+  static constexpr size_t kMaxComparisonsQueueSizeBytes = 64 * 1024 * 1024;
+
+  // SSIM and PSNR are computed for one in |heavy_metrics_sampling_interval|
+  // frames only, so that the analyzer keeps up with many streams, e.g. in load
+  // tests. All frames are still counted and timed.
   explicit DefaultVideoQualityAnalyzer(
-      bool heavy_metrics_computation_enabled = true);
+      bool heavy_metrics_computation_enabled = true,
+      int heavy_metrics_sampling_interval = 1);
   ~DefaultVideoQualityAnalyzer() override;
 
   void Start(std::string test_case_name, int max_threads_count) override;
@@ -192,14 +207,16 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
   //      presented and |dropped| is false, either |rendered| is omitted and
   //      |dropped| is true.
   //   2. Overloaded - in this case both |captured| and |rendered| are omitted
-  //      because there were too many comparisons in the queue. |dropped| can be
+  //      because the queued frames took up too much memory. |dropped| can be
   //      true or false showing was frame dropped or not.
+  //   3. Not sampled - like overloaded, but because the frame was left out by
+  //      sampling.
   struct FrameComparison {
     FrameComparison(absl::optional<VideoFrame> captured,
                     absl::optional<VideoFrame> rendered,
                     bool dropped,
                     FrameStats frame_stats);
-    FrameComparison(bool dropped, FrameStats frameStats);
+    FrameComparison(bool dropped, bool sampled, FrameStats frameStats);
 
     // Frames can be omitted if there too many computations waiting in the
     // queue.
@@ -209,9 +226,22 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
     // wasn't rendered on remote peer side. If |dropped| is true, |rendered|
     // will be |absl::nullopt|.
     bool dropped;
+    // False if the frame was left out by sampling.
+    bool sampled = true;
     FrameStats frame_stats;
   };
 
+  // Stats of a single stream. Each stream has its own lock, so that the
+  // comparisons of different streams don't contend with each other.
+  struct StreamStatsShard {
+    explicit StreamStatsShard(Timestamp last_freeze_end_time)
+        : last_freeze_end_time(last_freeze_end_time) {}
+
+    rtc::CriticalSection lock;
+    StreamStats stats RTC_GUARDED_BY(lock);
+    Timestamp last_freeze_end_time RTC_GUARDED_BY(lock);
+  };
+
   // Represents a current state of video stream.
   struct StreamState {
     // To correctly determine dropped frames we have to know sequence of frames
@@ -238,6 +268,8 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
   static void ProcessComparisonsThread(void* obj);
   void ProcessComparisons();
   void ProcessComparison(const FrameComparison& comparison);
+  // Returns the stats of the stream |stream_label|, which must exist.
+  StreamStatsShard* GetStreamStatsShard(const std::string& stream_label) const;
   // Report results for all metrics for all streams.
   void ReportResults();
   static void ReportVideoBweResults(const std::string& test_case_name,
@@ -257,6 +289,7 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
   Timestamp Now();
 
   const bool heavy_metrics_computation_enabled_;
+  const int heavy_metrics_sampling_interval_;
   webrtc::Clock* const clock_;
   std::atomic<uint16_t> next_frame_id_{0};
 
@@ -284,12 +317,16 @@ class DefaultVideoQualityAnalyzer : public VideoQualityAnalyzerInterface {
   std::map<std::string, std::set<uint16_t>> stream_to_frame_id_history_
       RTC_GUARDED_BY(lock_);
 
+  rtc::CriticalSection stream_stats_lock_;
+  // Shards are added for new streams and never removed, so pointers to them
+  // stay valid for the lifetime of the analyzer.
+  std::map<std::string, std::unique_ptr<StreamStatsShard>> stream_stats_
+      RTC_GUARDED_BY(stream_stats_lock_);
+
   rtc::CriticalSection comparison_lock_;
-  std::map<std::string, StreamStats> stream_stats_
-      RTC_GUARDED_BY(comparison_lock_);
-  std::map<std::string, Timestamp> stream_last_freeze_end_time_
-      RTC_GUARDED_BY(comparison_lock_);
   std::deque<FrameComparison> comparisons_ RTC_GUARDED_BY(comparison_lock_);
+  // Size of the frames held by |comparisons_|.
+  size_t comparisons_queue_size_bytes_ RTC_GUARDED_BY(comparison_lock_) = 0;
   AnalyzerStats analyzer_stats_ RTC_GUARDED_BY(comparison_lock_);
 
   rtc::CriticalSection video_bwe_stats_lock_;
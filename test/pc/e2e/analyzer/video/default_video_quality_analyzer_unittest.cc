@@ -0,0 +1,111 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "test/pc/e2e/analyzer/video/default_video_quality_analyzer.h"
+
+#include <map>
+#include <string>
+
+#include "api/rtp_packet_info.h"
+#include "api/rtp_packet_infos.h"
+#include "api/video/encoded_image.h"
+#include "api/video/i420_buffer.h"
+#include "api/video/video_frame.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace webrtc_pc_e2e {
+namespace {
+
+constexpr char kStreamLabel[] = "alice_video";
+constexpr int kNumFrames = 10;
+
+VideoFrame CreateFrame(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  buffer->InitializeData();
+  return VideoFrame::Builder().set_video_frame_buffer(buffer).build();
+}
+
+EncodedImage CreateEncodedImage() {
+  EncodedImage image;
+  image.SetPacketInfos(RtpPacketInfos({RtpPacketInfo(
+      /*ssrc=*/1, /*csrcs=*/{}, /*rtp_timestamp=*/0,
+      /*audio_level=*/absl::nullopt, /*absolute_capture_time=*/absl::nullopt,
+      /*receive_time_ms=*/0)}));
+  return image;
+}
+
+// Passes |num_frames| frames through all the stages of the pipeline.
+void PassFrames(DefaultVideoQualityAnalyzer* analyzer,
+                int num_frames,
+                int width = 32,
+                int height = 16) {
+  for (int i = 0; i < num_frames; ++i) {
+    VideoFrame frame = CreateFrame(width, height);
+    frame.set_id(analyzer->OnFrameCaptured(kStreamLabel, frame));
+    analyzer->OnFramePreEncode(frame);
+    analyzer->OnFrameEncoded(frame.id(), CreateEncodedImage());
+    analyzer->OnFramePreDecode(frame.id(), CreateEncodedImage());
+    analyzer->OnFrameDecoded(frame, absl::nullopt, absl::nullopt);
+    analyzer->OnFrameRendered(frame);
+  }
+}
+
+TEST(DefaultVideoQualityAnalyzer, ComputesPsnrForAllFrames) {
+  DefaultVideoQualityAnalyzer analyzer;
+  analyzer.Start("test_case", /*max_threads_count=*/1);
+  PassFrames(&analyzer, kNumFrames);
+  analyzer.Stop();
+
+  AnalyzerStats analyzer_stats = analyzer.GetAnalyzerStats();
+  EXPECT_EQ(kNumFrames, analyzer_stats.comparisons_done);
+  EXPECT_EQ(0, analyzer_stats.not_sampled_comparisons_done);
+  std::map<std::string, StreamStats> stats = analyzer.GetStats();
+  EXPECT_EQ(static_cast<size_t>(kNumFrames),
+            stats.at(kStreamLabel).psnr.GetSamples().size() +
+                analyzer_stats.overloaded_comparisons_done);
+}
+
+TEST(DefaultVideoQualityAnalyzer, ComputesPsnrForSampledFramesOnly) {
+  DefaultVideoQualityAnalyzer analyzer(
+      /*heavy_metrics_computation_enabled=*/true,
+      /*heavy_metrics_sampling_interval=*/2);
+  analyzer.Start("test_case", /*max_threads_count=*/1);
+  PassFrames(&analyzer, kNumFrames);
+  analyzer.Stop();
+
+  AnalyzerStats analyzer_stats = analyzer.GetAnalyzerStats();
+  EXPECT_EQ(kNumFrames, analyzer_stats.comparisons_done);
+  EXPECT_EQ(kNumFrames / 2, analyzer_stats.not_sampled_comparisons_done);
+  std::map<std::string, StreamStats> stats = analyzer.GetStats();
+  EXPECT_EQ(static_cast<size_t>(kNumFrames / 2),
+            stats.at(kStreamLabel).psnr.GetSamples().size() +
+                analyzer_stats.overloaded_comparisons_done);
+  // All frames are still timed.
+  EXPECT_EQ(static_cast<size_t>(kNumFrames),
+            stats.at(kStreamLabel).decode_time_ms.GetSamples().size());
+}
+
+TEST(DefaultVideoQualityAnalyzer, BoundsMemoryOfComparisonsQueue) {
+  DefaultVideoQualityAnalyzer analyzer;
+  // Without comparison threads the queue is never drained.
+  analyzer.Start("test_case", /*max_threads_count=*/0);
+  PassFrames(&analyzer, /*num_frames=*/30, /*width=*/1920, /*height=*/1080);
+
+  AnalyzerStats analyzer_stats = analyzer.GetAnalyzerStats();
+  EXPECT_GT(analyzer_stats.comparisons_queue_size_bytes.GetMax(), 0);
+  EXPECT_LE(analyzer_stats.comparisons_queue_size_bytes.GetMax(),
+            DefaultVideoQualityAnalyzer::kMaxComparisonsQueueSizeBytes);
+  analyzer.Stop();
+}
+
+}  // namespace
+}  // namespace webrtc_pc_e2e
+}  // namespace webrtc
@@ -22,6 +22,7 @@
 #include "test/pc/e2e/analyzer/audio/default_audio_quality_analyzer.h"
 #include "test/pc/e2e/analyzer/video/default_video_quality_analyzer.h"
 #include "test/pc/e2e/network_quality_metrics_reporter.h"
+#include "test/pc/e2e/resource_usage_metrics_reporter.h"
 #include "test/testsupport/file_utils.h"
 
 namespace webrtc {
@@ -102,6 +103,8 @@ class PeerConnectionE2EQualityTestSmokeTest : public ::testing::Test {
     fixture->AddQualityMetricsReporter(
         std::make_unique<NetworkQualityMetricsReporter>(alice_network,
                                                         bob_network));
+    fixture->AddQualityMetricsReporter(
+        std::make_unique<ResourceUsageMetricsReporter>());
 
     fixture->Run(run_params);
 
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "test/pc/e2e/resource_usage_metrics_reporter.h"
+
+#include <algorithm>
+
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/memory_usage.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace webrtc_pc_e2e {
+
+void ResourceUsageMetricsReporter::Start(absl::string_view test_case_name) {
+  test_case_name_ = std::string(test_case_name);
+  start_cpu_time_ns_ = rtc::GetProcessCpuTimeNanos();
+  start_time_ns_ = rtc::SystemTimeNanos();
+}
+
+void ResourceUsageMetricsReporter::OnStatsReports(
+    const std::string& pc_label,
+    const StatsReports& reports) {
+  const int64_t resident_size_bytes = rtc::GetProcessResidentSizeBytes();
+  rtc::CritScope cs(&lock_);
+  pc_labels_.insert(pc_label);
+  if (resident_size_bytes >= 0)
+    resident_size_bytes_.AddSample(resident_size_bytes);
+}
+
+void ResourceUsageMetricsReporter::StopAndReportResults() {
+  const int64_t cpu_time_ns =
+      rtc::GetProcessCpuTimeNanos() - start_cpu_time_ns_;
+  const int64_t duration_ns = rtc::SystemTimeNanos() - start_time_ns_;
+  rtc::CritScope cs(&lock_);
+  const size_t num_peers = std::max<size_t>(pc_labels_.size(), 1);
+  if (duration_ns > 0) {
+    // In percent of a single core, as CPU usage is usually given.
+    const double cpu_usage_percent = 100.0 * cpu_time_ns / duration_ns;
+    ReportResult("cpu_usage", "process", cpu_usage_percent, "percent");
+    ReportResult("cpu_usage", "per_peer", cpu_usage_percent / num_peers,
+                 "percent");
+    ReportResult("cpu_usage_of_all_cores", "process",
+                 cpu_usage_percent / CpuInfo::DetectNumberOfCores(), "percent");
+  }
+  if (!resident_size_bytes_.IsEmpty()) {
+    ReportResult("max_resident_size", "process",
+                 resident_size_bytes_.GetMax(), "sizeInBytes");
+    ReportResult("max_resident_size", "per_peer",
+                 resident_size_bytes_.GetMax() / num_peers, "sizeInBytes");
+    ReportResult("avg_resident_size", "process",
+                 resident_size_bytes_.GetAverage(), "sizeInBytes");
+  }
+}
+
+void ResourceUsageMetricsReporter::ReportResult(
+    const std::string& metric_name,
+    const std::string& label,
+    double value,
+    const std::string& unit) const {
+  test::PrintResult(metric_name, /*modifier=*/"", test_case_name_ + "/" + label,
+                    value, unit, /*important=*/false);
+}
+
+}  // namespace webrtc_pc_e2e
+}  // namespace webrtc
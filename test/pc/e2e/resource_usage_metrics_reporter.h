@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef TEST_PC_E2E_RESOURCE_USAGE_METRICS_REPORTER_H_
+#define TEST_PC_E2E_RESOURCE_USAGE_METRICS_REPORTER_H_
+
+#include <stdint.h>
+
+#include <set>
+#include <string>
+
+#include "api/test/peerconnection_quality_test_fixture.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/numerics/samples_stats_counter.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+namespace webrtc_pc_e2e {
+
+// Reports the CPU and memory used by the test process during the call, e.g.
+// to see how they scale with the number of streams in load tests. The peers
+// run in the same process, so their usage is reported together, divided by
+// the number of peer connections for the per-peer cost. Memory is sampled
+// whenever stats are polled.
+class ResourceUsageMetricsReporter
+    : public PeerConnectionE2EQualityTestFixture::QualityMetricsReporter {
+ public:
+  ResourceUsageMetricsReporter() = default;
+  ~ResourceUsageMetricsReporter() override = default;
+
+  void Start(absl::string_view test_case_name) override;
+  void OnStatsReports(const std::string& pc_label,
+                      const StatsReports& reports) override;
+  void StopAndReportResults() override;
+
+ private:
+  void ReportResult(const std::string& metric_name,
+                    const std::string& label,
+                    double value,
+                    const std::string& unit) const;
+
+  std::string test_case_name_;
+  int64_t start_cpu_time_ns_ = 0;
+  int64_t start_time_ns_ = 0;
+
+  rtc::CriticalSection lock_;
+  SamplesStatsCounter resident_size_bytes_ RTC_GUARDED_BY(lock_);
+  std::set<std::string> pc_labels_ RTC_GUARDED_BY(lock_);
+};
+
+}  // namespace webrtc_pc_e2e
+}  // namespace webrtc
+
+#endif  // TEST_PC_E2E_RESOURCE_USAGE_METRICS_REPORTER_H_
@@ -76,6 +76,9 @@ bool RtcpPacketParser::Parse(const void* data, size_t length) {
         break;
       case rtcp::Rtpfb::kPacketType:
         switch (header.fmt()) {
+          case rtcp::EcnFeedback::kFeedbackMessageType:
+            ecn_feedback_.Parse(header, &sender_ssrc_);
+            break;
           case rtcp::Nack::kFeedbackMessageType:
             nack_.Parse(header, &sender_ssrc_);
             break;
@@ -19,6 +19,7 @@
 #include "modules/rtp_rtcp/source/rtcp_packet/app.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/bye.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "modules/rtp_rtcp/source/rtcp_packet/ecn_feedback.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_jitter_report.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/extended_reports.h"
 #include "modules/rtp_rtcp/source/rtcp_packet/fir.h"
@@ -84,6 +85,7 @@ class RtcpPacketParser {
 
   PacketCounter<rtcp::App>* app() { return &app_; }
   PacketCounter<rtcp::Bye>* bye() { return &bye_; }
+  PacketCounter<rtcp::EcnFeedback>* ecn_feedback() { return &ecn_feedback_; }
   PacketCounter<rtcp::ExtendedJitterReport>* ij() { return &ij_; }
   PacketCounter<rtcp::ExtendedReports>* xr() { return &xr_; }
   PacketCounter<rtcp::Fir>* fir() { return &fir_; }
@@ -110,6 +112,7 @@ class RtcpPacketParser {
  private:
   PacketCounter<rtcp::App> app_;
   PacketCounter<rtcp::Bye> bye_;
+  PacketCounter<rtcp::EcnFeedback> ecn_feedback_;
   PacketCounter<rtcp::ExtendedJitterReport> ij_;
   PacketCounter<rtcp::ExtendedReports> xr_;
   PacketCounter<rtcp::Fir> fir_;
@@ -67,6 +67,8 @@ class SampleStats<TimeDelta> {
   TimeDelta Variance();
   TimeDelta StandardDeviation();
   int Count();
+  // The samples in seconds, along with the times they were added at.
+  const SamplesStatsCounter& samples() const { return stats_; }
 
  private:
   SampleStats<double> stats_;
@@ -87,6 +89,8 @@ class SampleStats<DataRate> {
   DataRate Variance();
   DataRate StandardDeviation();
   int Count();
+  // The samples in bits per second, along with the times they were added at.
+  const SamplesStatsCounter& samples() const { return stats_; }
 
  private:
   SampleStats<double> stats_;
@@ -152,6 +156,8 @@ struct CollectedCallStats {
   SampleStats<TimeDelta> pacer_delay;
   SampleStats<TimeDelta> round_trip_time;
   SampleStats<double> memory_usage;
+  // Process CPU time used since the previous sample.
+  SampleStats<TimeDelta> cpu_time;
 };
 
 struct CollectedAudioReceiveStats {
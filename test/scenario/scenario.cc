@@ -28,6 +28,10 @@ ABSL_FLAG(std::string,
           scenario_logs_root,
           "",
           "Output root path, based on project root if unset.");
+ABSL_FLAG(int,
+          scenario_parallel_threads,
+          1,
+          "Number of threads running simulated time task queues.");
 
 namespace webrtc {
 namespace test {
@@ -51,7 +55,8 @@ std::unique_ptr<TimeController> CreateTimeController(bool real_time) {
   if (real_time) {
     return std::make_unique<RealTimeController>();
   } else {
-    return std::make_unique<GlobalSimulatedTimeController>(kSimulatedStartTime);
+    return std::make_unique<GlobalSimulatedTimeController>(
+        kSimulatedStartTime, absl::GetFlag(FLAGS_scenario_parallel_threads));
   }
 }
 }  // namespace
@@ -11,11 +11,35 @@
 #include "test/scenario/stats_collection.h"
 
 #include "common_video/libyuv/include/webrtc_libyuv.h"
+#include "rtc_base/cpu_time.h"
 #include "rtc_base/memory_usage.h"
 #include "rtc_base/thread.h"
+#include "test/testsupport/perf_test.h"
 
 namespace webrtc {
 namespace test {
+namespace {
+constexpr double kMsPerSecond = 1000;
+constexpr double kBitsPerByte = 8;
+
+void ReportTimeDeltas(const std::string& measurement,
+                      const std::string& test_case_name,
+                      const SampleStats<TimeDelta>& stats) {
+  if (stats.samples().IsEmpty())
+    return;
+  PrintResult(measurement, "", test_case_name, stats.samples() * kMsPerSecond,
+              "ms", /*important=*/false);
+}
+
+void ReportDataRates(const std::string& measurement,
+                     const std::string& test_case_name,
+                     const SampleStats<DataRate>& stats) {
+  if (stats.samples().IsEmpty())
+    return;
+  PrintResult(measurement, "", test_case_name, stats.samples() / kBitsPerByte,
+              "bytesPerSecond", /*important=*/false);
+}
+}  // namespace
 
 VideoQualityAnalyzer::VideoQualityAnalyzer(
     VideoQualityAnalyzerConfig config,
@@ -140,6 +164,11 @@ void CallStatsCollector::AddStats(Call::Stats sample) {
   if (sample.rtt_ms > 0)
     stats_.round_trip_time.AddSample(TimeDelta::ms(sample.rtt_ms));
   stats_.memory_usage.AddSample(rtc::GetProcessResidentSizeBytes());
+  int64_t cpu_time_ns = rtc::GetProcessCpuTimeNanos();
+  if (last_cpu_time_ns_ >= 0)
+    stats_.cpu_time.AddSample(
+        TimeDelta::us((cpu_time_ns - last_cpu_time_ns_) / 1000));
+  last_cpu_time_ns_ = cpu_time_ns;
 }
 
 void AudioReceiveStatsCollector::AddStats(AudioReceiveStream::Stats sample) {
@@ -184,5 +213,32 @@ void VideoReceiveStatsCollector::AddStats(VideoReceiveStream::Stats sample) {
     stats_.resolution.AddSample(sample.height);
   }
 }
+
+void ReportPerfResults(const std::string& test_case_name,
+                       CallStatsCollectors* collectors) {
+  const CollectedCallStats& call = collectors->call.stats();
+  ReportDataRates("target_rate", test_case_name, call.target_rate);
+  ReportTimeDeltas("pacer_delay", test_case_name, call.pacer_delay);
+  ReportTimeDeltas("round_trip_time", test_case_name, call.round_trip_time);
+  ReportTimeDeltas("cpu_time", test_case_name, call.cpu_time);
+  if (!call.memory_usage.IsEmpty()) {
+    PrintResult("memory_usage", "", test_case_name, call.memory_usage,
+                "sizeInBytes", /*important=*/false);
+  }
+
+  const CollectedVideoSendStats& video_send = collectors->video_send.stats();
+  ReportTimeDeltas("encode_time", test_case_name, video_send.encode_time);
+  ReportDataRates("media_bitrate", test_case_name, video_send.media_bitrate);
+  ReportDataRates("fec_bitrate", test_case_name, video_send.fec_bitrate);
+
+  const CollectedVideoReceiveStats& video_receive =
+      collectors->video_receive.stats();
+  ReportTimeDeltas("decode_time", test_case_name, video_receive.decode_time);
+
+  const CollectedAudioReceiveStats& audio_receive =
+      collectors->audio_receive.stats();
+  ReportTimeDeltas("jitter_buffer", test_case_name,
+                   audio_receive.jitter_buffer);
+}
 }  // namespace test
 }  // namespace webrtc
@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <string>
 
 #include "absl/types/optional.h"
 #include "call/call.h"
@@ -68,6 +69,7 @@ class CallStatsCollector {
 
  private:
   CollectedCallStats stats_;
+  int64_t last_cpu_time_ns_ = -1;
 };
 class AudioReceiveStatsCollector {
  public:
@@ -103,6 +105,12 @@ struct CallStatsCollectors {
   VideoReceiveStatsCollector video_receive;
 };
 
+// Reports the collected stats as perf results under |test_case_name|. The
+// samples are kept as time series, so that running the test with --plot
+// prints them in the format read by rtc_tools/metrics_plotter.py.
+void ReportPerfResults(const std::string& test_case_name,
+                       CallStatsCollectors* collectors);
+
 }  // namespace test
 }  // namespace webrtc
 
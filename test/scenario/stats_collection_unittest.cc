@@ -11,6 +11,7 @@
 
 #include "test/gtest.h"
 #include "test/scenario/scenario.h"
+#include "test/testsupport/perf_test.h"
 
 namespace webrtc {
 namespace test {
@@ -40,6 +41,26 @@ void CreateAnalyzedStream(Scenario* s,
 }
 }  // namespace
 
+TEST(ScenarioAnalyzerTest, ReportsCallStatsAsTimeSeries) {
+  ClearPerfResults();
+  CallStatsCollectors stats;
+  Call::Stats call_stats;
+  call_stats.send_bandwidth_bps = 300000;
+  call_stats.pacer_delay_ms = 20;
+  stats.call.AddStats(call_stats);
+  stats.call.AddStats(call_stats);
+  EXPECT_EQ(stats.call.stats().cpu_time.Count(), 1);
+
+  ReportPerfResults("test_case", &stats);
+  std::string json = GetPerfResultsJSON();
+  EXPECT_NE(json.find("\"target_rate\""), std::string::npos);
+  EXPECT_NE(json.find("\"pacer_delay\""), std::string::npos);
+  EXPECT_NE(json.find("\"cpu_time\""), std::string::npos);
+  // Nothing was collected for the streams.
+  EXPECT_EQ(json.find("\"encode_time\""), std::string::npos);
+  ClearPerfResults();
+}
+
 TEST(ScenarioAnalyzerTest, PsnrIsHighWhenNetworkIsGood) {
   VideoQualityAnalyzer analyzer;
   CallStatsCollectors stats;
@@ -50,6 +71,7 @@ TEST(ScenarioAnalyzerTest, PsnrIsHighWhenNetworkIsGood) {
     CreateAnalyzedStream(&s, good_network, &analyzer, &stats);
     s.RunFor(TimeDelta::seconds(3));
   }
+  ReportPerfResults("PsnrIsHighWhenNetworkIsGood", &stats);
   // This is a change detecting test, the targets are based on previous runs and
   // might change due to changes in configuration and encoder etc. The main
   // purpose is to show how the stats can be used. To avoid being overly
@@ -72,6 +94,7 @@ TEST(ScenarioAnalyzerTest, PsnrIsLowWhenNetworkIsBad) {
     CreateAnalyzedStream(&s, bad_network, &analyzer, &stats);
     s.RunFor(TimeDelta::seconds(3));
   }
+  ReportPerfResults("PsnrIsLowWhenNetworkIsBad", &stats);
   // This is a change detecting test, the targets are based on previous runs and
   // might change due to changes in configuration and encoder etc.
   EXPECT_NEAR(analyzer.stats().psnr_with_freeze.Mean(), 16, 10);
@@ -16,11 +16,13 @@
 #include <string>
 
 #include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
 
 namespace webrtc {
-class I420Buffer;
 namespace test {
 
+class MappedFile;
+
 // Handles reading of I420 frames from video files.
 class FrameReader {
  public:
@@ -33,7 +35,7 @@ class FrameReader {
 
   // Reads a frame from the input file. On success, returns the frame.
   // Returns nullptr if encountering end of file or a read error.
-  virtual rtc::scoped_refptr<I420Buffer> ReadFrame() = 0;
+  virtual rtc::scoped_refptr<I420BufferInterface> ReadFrame() = 0;
 
   // Closes the input file if open. Essentially makes this class impossible
   // to use anymore. Will also be invoked by the destructor.
@@ -54,12 +56,17 @@ class YuvFrameReaderImpl : public FrameReader {
   YuvFrameReaderImpl(std::string input_filename, int width, int height);
   ~YuvFrameReaderImpl() override;
   bool Init() override;
-  rtc::scoped_refptr<I420Buffer> ReadFrame() override;
+  rtc::scoped_refptr<I420BufferInterface> ReadFrame() override;
   void Close() override;
   size_t FrameLength() override;
   int NumberOfFrames() override;
 
  protected:
+  // Maps the input file into memory where supported, so that frames are
+  // returned as views of the file rather than read into new buffers. Reading
+  // continues from |offset|.
+  void MapInputFile(size_t offset);
+
   const std::string input_filename_;
   // It is not const, so subclasses will be able to add frame header size.
   size_t frame_length_in_bytes_;
@@ -67,6 +74,9 @@ class YuvFrameReaderImpl : public FrameReader {
   const int height_;
   int number_of_frames_;
   FILE* input_file_;
+  // Set if the input file is mapped, along with where to read next.
+  rtc::scoped_refptr<MappedFile> mapped_file_;
+  size_t read_offset_ = 0;
 };
 
 class Y4mFrameReaderImpl : public YuvFrameReaderImpl {
@@ -78,7 +88,7 @@ class Y4mFrameReaderImpl : public YuvFrameReaderImpl {
   Y4mFrameReaderImpl(std::string input_filename, int width, int height);
   ~Y4mFrameReaderImpl() override;
   bool Init() override;
-  rtc::scoped_refptr<I420Buffer> ReadFrame() override;
+  rtc::scoped_refptr<I420BufferInterface> ReadFrame() override;
 
  private:
   // Buffer that is used to read file and frame headers.
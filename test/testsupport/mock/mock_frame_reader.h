@@ -20,7 +20,7 @@ namespace test {
 class MockFrameReader : public FrameReader {
  public:
   MOCK_METHOD0(Init, bool());
-  MOCK_METHOD0(ReadFrame, rtc::scoped_refptr<I420Buffer>());
+  MOCK_METHOD0(ReadFrame, rtc::scoped_refptr<I420BufferInterface>());
   MOCK_METHOD0(Close, void());
   MOCK_METHOD0(FrameLength, size_t());
   MOCK_METHOD0(NumberOfFrames, int());
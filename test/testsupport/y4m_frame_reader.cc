@@ -64,17 +64,21 @@ bool Y4mFrameReaderImpl::Init() {
   // Calculate total number of frames.
   number_of_frames_ = static_cast<int>((source_file_size - kFileHeaderSize) /
                                        frame_length_in_bytes_);
+  MapInputFile(kFileHeaderSize);
   return true;
 }
 
-rtc::scoped_refptr<I420Buffer> Y4mFrameReaderImpl::ReadFrame() {
+rtc::scoped_refptr<I420BufferInterface> Y4mFrameReaderImpl::ReadFrame() {
   if (input_file_ == nullptr) {
     fprintf(stderr,
             "Y4mFrameReaderImpl is not initialized (input file is NULL)\n");
     return nullptr;
   }
-  if (fread(buffer_, 1, kFrameHeaderSize, input_file_) < kFrameHeaderSize &&
-      ferror(input_file_)) {
+  if (mapped_file_) {
+    read_offset_ += kFrameHeaderSize;
+  } else if (fread(buffer_, 1, kFrameHeaderSize, input_file_) <
+                 kFrameHeaderSize &&
+             ferror(input_file_)) {
     fprintf(stderr, "Failed to read frame header from input file: %s\n",
             input_filename_.c_str());
     return nullptr;
@@ -10,10 +10,20 @@
 
 #include <stdio.h>
 
+#if defined(WEBRTC_POSIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <string>
 
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
+#include "common_video/include/video_frame_buffer.h"
+#include "rtc_base/ref_count.h"
+#include "rtc_base/ref_counted_object.h"
 #include "test/frame_utils.h"
 #include "test/testsupport/file_utils.h"
 #include "test/testsupport/frame_reader.h"
@@ -21,6 +31,39 @@
 namespace webrtc {
 namespace test {
 
+// A read-only mapping of an input file, kept alive by the frames viewing it.
+class MappedFile : public rtc::RefCountInterface {
+ public:
+  MappedFile(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+  // Asks for the pages of |size| bytes at |offset| to be read ahead, e.g.
+  // those of the next frame, without waiting for them.
+  void Prefetch(size_t offset, size_t size) const {
+#if defined(WEBRTC_POSIX)
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    const size_t start = offset / page_size * page_size;
+    if (start >= size_)
+      return;
+    madvise(const_cast<uint8_t*>(data_) + start,
+            std::min(offset + size, size_) - start, MADV_WILLNEED);
+#endif
+  }
+
+ protected:
+  ~MappedFile() override {
+#if defined(WEBRTC_POSIX)
+    munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+  }
+
+ private:
+  const uint8_t* const data_;
+  const size_t size_;
+};
+
 YuvFrameReaderImpl::YuvFrameReaderImpl(std::string input_filename,
                                        int width,
                                        int height)
@@ -56,15 +99,48 @@ bool YuvFrameReaderImpl::Init() {
   }
   number_of_frames_ =
       static_cast<int>(source_file_size / frame_length_in_bytes_);
+  MapInputFile(0);
   return true;
 }
 
-rtc::scoped_refptr<I420Buffer> YuvFrameReaderImpl::ReadFrame() {
+void YuvFrameReaderImpl::MapInputFile(size_t offset) {
+#if defined(WEBRTC_POSIX)
+  struct stat file_stat;
+  if (fstat(fileno(input_file_), &file_stat) != 0 || file_stat.st_size <= 0)
+    return;
+  const size_t size = file_stat.st_size;
+  void* data =
+      mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(input_file_), 0);
+  if (data == MAP_FAILED)
+    return;
+  madvise(data, size, MADV_SEQUENTIAL);
+  mapped_file_ = new rtc::RefCountedObject<MappedFile>(
+      static_cast<const uint8_t*>(data), size);
+  read_offset_ = offset;
+#endif
+}
+
+rtc::scoped_refptr<I420BufferInterface> YuvFrameReaderImpl::ReadFrame() {
   if (input_file_ == nullptr) {
     fprintf(stderr,
             "YuvFrameReaderImpl is not initialized (input file is NULL)\n");
     return nullptr;
   }
+  if (mapped_file_) {
+    const int chroma_width = (width_ + 1) / 2;
+    const size_t luma_size = width_ * height_;
+    const size_t chroma_size = chroma_width * ((height_ + 1) / 2);
+    const size_t frame_size = luma_size + 2 * chroma_size;
+    if (read_offset_ + frame_size > mapped_file_->size())
+      return nullptr;
+    const uint8_t* data_y = mapped_file_->data() + read_offset_;
+    read_offset_ += frame_size;
+    mapped_file_->Prefetch(read_offset_, frame_size);
+    rtc::scoped_refptr<MappedFile> mapped_file = mapped_file_;
+    return WrapI420Buffer(width_, height_, data_y, width_, data_y + luma_size,
+                          chroma_width, data_y + luma_size + chroma_size,
+                          chroma_width, [mapped_file] {});
+  }
   rtc::scoped_refptr<I420Buffer> buffer(
       ReadI420Buffer(width_, height_, input_file_));
   if (!buffer && ferror(input_file_)) {
@@ -75,6 +151,7 @@ rtc::scoped_refptr<I420Buffer> YuvFrameReaderImpl::ReadFrame() {
 }
 
 void YuvFrameReaderImpl::Close() {
+  mapped_file_ = nullptr;
   if (input_file_ != nullptr) {
     fclose(input_file_);
     input_file_ = nullptr;
@@ -78,6 +78,16 @@ TEST_F(YuvFrameReaderTest, ReadFrame) {
   EXPECT_FALSE(frame_reader_->ReadFrame());  // End of file.
 }
 
+TEST_F(YuvFrameReaderTest, FrameOutlivesReader) {
+  rtc::scoped_refptr<I420BufferInterface> buffer = frame_reader_->ReadFrame();
+  ASSERT_TRUE(buffer);
+  frame_reader_->Close();
+  frame_reader_.reset();
+  EXPECT_EQ(kInputFileContents[0], buffer->DataY()[0]);
+  EXPECT_EQ(kInputFileContents[3], buffer->DataY()[3]);
+  EXPECT_EQ(kInputFileContents[5], buffer->DataV()[0]);
+}
+
 TEST_F(YuvFrameReaderTest, ReadFrameUninitialized) {
   YuvFrameReaderImpl file_reader(temp_filename_, kFrameWidth, kFrameHeight);
   EXPECT_FALSE(file_reader.ReadFrame());
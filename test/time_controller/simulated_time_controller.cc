@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "rtc_base/platform_thread.h"
 
 namespace webrtc {
 namespace {
@@ -50,6 +51,11 @@ class SimulatedSequenceRunner : public ProcessThread, public TaskQueueBase {
   // Runs all ready tasks and modules and updates next run time.
   void Run(Timestamp at_time);
 
+  // Queue tasks without holding them back while runners run in parallel.
+  void EnqueueTask(std::unique_ptr<QueuedTask> task);
+  void EnqueueDelayedTask(std::unique_ptr<QueuedTask> task,
+                          uint32_t milliseconds);
+
   // TaskQueueBase interface
   void Delete() override;
   // Note: PostTask is also in ProcessThread interface.
@@ -69,7 +75,7 @@ class SimulatedSequenceRunner : public ProcessThread, public TaskQueueBase {
  private:
   Timestamp GetCurrentTime() const { return handler_->CurrentTime(); }
   void RunReadyTasks(Timestamp at_time) RTC_LOCKS_EXCLUDED(lock_);
-  void RunReadyModules(Timestamp at_time) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void RunReadyModules(Timestamp at_time) RTC_LOCKS_EXCLUDED(lock_);
   void UpdateNextRunTime() RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   Timestamp GetNextTime(Module* module, Timestamp at_time);
 
@@ -85,6 +91,8 @@ class SimulatedSequenceRunner : public ProcessThread, public TaskQueueBase {
   bool process_thread_running_ RTC_GUARDED_BY(lock_) = false;
   std::vector<Module*> stopped_modules_ RTC_GUARDED_BY(lock_);
   std::vector<Module*> ready_modules_ RTC_GUARDED_BY(lock_);
+  // The module being processed, if it's still registered.
+  Module* processing_module_ RTC_GUARDED_BY(lock_) = nullptr;
   std::map<Timestamp, std::list<Module*>> delayed_modules_
       RTC_GUARDED_BY(lock_);
 
@@ -116,8 +124,8 @@ void SimulatedSequenceRunner::UpdateReady(Timestamp at_time) {
 
 void SimulatedSequenceRunner::Run(Timestamp at_time) {
   RunReadyTasks(at_time);
-  rtc::CritScope lock(&lock_);
   RunReadyModules(at_time);
+  rtc::CritScope lock(&lock_);
   UpdateNextRunTime();
 }
 
@@ -127,6 +135,8 @@ void SimulatedSequenceRunner::Delete() {
     ready_tasks_.clear();
     delayed_tasks_.clear();
   }
+  if (handler_->DeleteAfterRound(this))
+    return;
   delete this;
 }
 
@@ -150,14 +160,27 @@ void SimulatedSequenceRunner::RunReadyTasks(Timestamp at_time) {
 }
 
 void SimulatedSequenceRunner::RunReadyModules(Timestamp at_time) {
-  if (!ready_modules_.empty()) {
-    CurrentTaskQueueSetter set_current(this);
-    for (auto* module : ready_modules_) {
-      module->Process();
+  // Modules are processed without holding |lock_|, so that other runners can
+  // post tasks and wake up modules meanwhile.
+  CurrentTaskQueueSetter set_current(this);
+  while (true) {
+    Module* module;
+    {
+      rtc::CritScope lock(&lock_);
+      if (ready_modules_.empty())
+        return;
+      module = ready_modules_.front();
+      ready_modules_.erase(ready_modules_.begin());
+      processing_module_ = module;
+    }
+    module->Process();
+    rtc::CritScope lock(&lock_);
+    // Unless deregistered or stopped while processed.
+    if (processing_module_ == module) {
       delayed_modules_[GetNextTime(module, at_time)].push_back(module);
+      processing_module_ = nullptr;
     }
   }
-  ready_modules_.clear();
 }
 
 void SimulatedSequenceRunner::UpdateNextRunTime() {
@@ -174,13 +197,27 @@ void SimulatedSequenceRunner::UpdateNextRunTime() {
 }
 
 void SimulatedSequenceRunner::PostTask(std::unique_ptr<QueuedTask> task) {
+  if (handler_->MaybeDeferTask(this, &task, /*delayed=*/false, 0))
+    return;
+  EnqueueTask(std::move(task));
+}
+
+void SimulatedSequenceRunner::PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                                              uint32_t milliseconds) {
+  if (handler_->MaybeDeferTask(this, &task, /*delayed=*/true, milliseconds))
+    return;
+  EnqueueDelayedTask(std::move(task), milliseconds);
+}
+
+void SimulatedSequenceRunner::EnqueueTask(std::unique_ptr<QueuedTask> task) {
   rtc::CritScope lock(&lock_);
   ready_tasks_.emplace_back(std::move(task));
   next_run_time_ = Timestamp::MinusInfinity();
 }
 
-void SimulatedSequenceRunner::PostDelayedTask(std::unique_ptr<QueuedTask> task,
-                                              uint32_t milliseconds) {
+void SimulatedSequenceRunner::EnqueueDelayedTask(
+    std::unique_ptr<QueuedTask> task,
+    uint32_t milliseconds) {
   rtc::CritScope lock(&lock_);
   Timestamp target_time = GetCurrentTime() + TimeDelta::ms(milliseconds);
   delayed_tasks_[target_time].push_back(std::move(task));
@@ -215,6 +252,10 @@ void SimulatedSequenceRunner::Stop() {
     for (auto* ready : ready_modules_)
       stopped_modules_.push_back(ready);
     ready_modules_.clear();
+    if (processing_module_) {
+      stopped_modules_.push_back(processing_module_);
+      processing_module_ = nullptr;
+    }
 
     for (auto& delayed : delayed_modules_) {
       for (auto mod : delayed.second)
@@ -235,6 +276,9 @@ void SimulatedSequenceRunner::WakeUp(Module* module) {
   for (auto mod : ready_modules_)
     if (mod == module)
       return;
+  // Being processed, it's rescheduled when done.
+  if (processing_module_ == module)
+    return;
 
   for (auto it = delayed_modules_.begin(); it != delayed_modules_.end(); ++it) {
     if (RemoveByValue(it->second, module))
@@ -266,6 +310,10 @@ void SimulatedSequenceRunner::DeRegisterModule(Module* module) {
       RemoveByValue(stopped_modules_, module);
     } else {
       bool removed = RemoveByValue(ready_modules_, module);
+      if (processing_module_ == module) {
+        processing_module_ = nullptr;
+        removed = true;
+      }
       if (!removed) {
         for (auto& pair : delayed_modules_) {
           if (RemoveByValue(pair.second, module))
@@ -285,8 +333,78 @@ Timestamp SimulatedSequenceRunner::GetNextTime(Module* module,
   return at_time + TimeDelta::ms(module->TimeUntilNextProcess());
 }
 
-SimulatedTimeControllerImpl::SimulatedTimeControllerImpl(Timestamp start_time)
-    : thread_id_(rtc::CurrentThreadId()), current_time_(start_time) {}
+// Threads that, along with the thread calling Sleep(), run the runners of a
+// round in parallel.
+class SimulatedTimeControllerImpl::WorkerPool {
+ public:
+  WorkerPool(SimulatedTimeControllerImpl* impl, int num_threads)
+      : impl_(impl) {
+    for (int i = 0; i < num_threads; ++i)
+      workers_.push_back(std::make_unique<Worker>(this));
+    for (auto& worker : workers_)
+      worker->thread.Start();
+  }
+
+  ~WorkerPool() {
+    quit_ = true;
+    for (auto& worker : workers_)
+      worker->start.Set();
+    for (auto& worker : workers_)
+      worker->thread.Stop();
+  }
+
+  void StartRound() {
+    num_in_round_ = static_cast<int>(workers_.size());
+    for (auto& worker : workers_)
+      worker->start.Set();
+  }
+
+  void WaitForRound() {
+    // Waiting must not run tasks, as it would if the yield policy of the
+    // calling thread was kept.
+    rtc::ScopedYieldPolicy no_yield(nullptr);
+    round_finished_.Wait(rtc::Event::kForever);
+  }
+
+ private:
+  struct Worker {
+    explicit Worker(WorkerPool* pool)
+        : pool(pool), thread(&WorkerPool::Run, this, "SimulatedTimeWorker") {}
+
+    WorkerPool* const pool;
+    rtc::Event start;
+    rtc::Event idle;
+    rtc::PlatformThread thread;
+  };
+
+  static void Run(void* obj) {
+    Worker* worker = static_cast<Worker*>(obj);
+    WorkerPool* pool = worker->pool;
+    while (true) {
+      worker->start.Wait(rtc::Event::kForever);
+      if (pool->quit_)
+        return;
+      pool->impl_->RunRound(&worker->idle);
+      if (--pool->num_in_round_ == 0)
+        pool->round_finished_.Set();
+    }
+  }
+
+  SimulatedTimeControllerImpl* const impl_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::atomic<bool> quit_{false};
+  std::atomic<int> num_in_round_{0};
+  rtc::Event round_finished_;
+};
+
+SimulatedTimeControllerImpl::SimulatedTimeControllerImpl(Timestamp start_time,
+                                                         int parallel_threads)
+    : thread_id_(rtc::CurrentThreadId()),
+      current_time_(start_time),
+      worker_pool_(parallel_threads > 1
+                       ? std::make_unique<WorkerPool>(this,
+                                                      parallel_threads - 1)
+                       : nullptr) {}
 
 SimulatedTimeControllerImpl::~SimulatedTimeControllerImpl() = default;
 
@@ -313,6 +431,10 @@ std::unique_ptr<ProcessThread> SimulatedTimeControllerImpl::CreateProcessThread(
 }
 
 void SimulatedTimeControllerImpl::YieldExecution() {
+  if (in_round_) {
+    YieldInRound();
+    return;
+  }
   if (rtc::CurrentThreadId() == thread_id_) {
     TaskQueueBase* yielding_from = TaskQueueBase::Current();
     // Since we might continue execution on a process thread, we should reset
@@ -334,6 +456,10 @@ void SimulatedTimeControllerImpl::YieldExecution() {
 
 void SimulatedTimeControllerImpl::RunReadyRunners() {
   RTC_DCHECK_RUN_ON(&thread_checker_);
+  if (worker_pool_) {
+    RunReadyRunnersInParallel();
+    return;
+  }
   rtc::CritScope lock(&lock_);
   RTC_DCHECK_EQ(rtc::CurrentThreadId(), thread_id_);
   Timestamp current_time = CurrentTime();
@@ -389,17 +515,230 @@ void SimulatedTimeControllerImpl::AdvanceTime(Timestamp target_time) {
 }
 
 void SimulatedTimeControllerImpl::Unregister(SimulatedSequenceRunner* runner) {
-  rtc::CritScope lock(&lock_);
-  bool removed = RemoveByValue(runners_, runner);
-  RTC_CHECK(removed);
-  RemoveByValue(ready_runners_, runner);
+  {
+    rtc::CritScope lock(&lock_);
+    bool removed = RemoveByValue(runners_, runner);
+    RTC_CHECK(removed);
+    RemoveByValue(ready_runners_, runner);
+  }
+  if (!in_round_ || TaskQueueBase::Current() == runner)
+    return;
+  // A process thread destroyed while a round runs. Wait for it to finish
+  // running, if it is.
+  while (true) {
+    {
+      rtc::CritScope lock(&round_lock_);
+      auto it = round_index_.find(runner);
+      if (it == round_index_.end())
+        return;
+      RoundEntry& entry = round_[it->second];
+      entry.runner = nullptr;
+      if (!entry.running)
+        return;
+    }
+    std::this_thread::yield();
+  }
+}
+
+bool SimulatedTimeControllerImpl::MaybeDeferTask(
+    SimulatedSequenceRunner* target,
+    std::unique_ptr<QueuedTask>* task,
+    bool delayed,
+    uint32_t milliseconds) {
+  if (!in_round_)
+    return false;
+  const TaskQueueBase* current = TaskQueueBase::Current();
+  if (!current || current == target)
+    return false;
+  rtc::CritScope lock(&round_lock_);
+  auto poster = round_index_.find(current);
+  auto receiver = round_index_.find(target);
+  if (poster == round_index_.end() || receiver == round_index_.end())
+    return false;
+  deferred_tasks_[poster->second].push_back(
+      DeferredTask{receiver->second, std::move(*task), delayed, milliseconds});
+  return true;
+}
+
+bool SimulatedTimeControllerImpl::DeleteAfterRound(
+    SimulatedSequenceRunner* runner) {
+  if (!in_round_)
+    return false;
+  rtc::CritScope lock(&round_lock_);
+  auto it = round_index_.find(runner);
+  // Runners created during the round aren't run until the next one.
+  if (it == round_index_.end())
+    return false;
+  round_[it->second].deleted = true;
+  deleted_in_round_.push_back(runner);
+  return true;
+}
+
+void SimulatedTimeControllerImpl::RunReadyRunnersInParallel() {
+  while (true) {
+    {
+      rtc::CritScope lock(&lock_);
+      const Timestamp current_time = CurrentTime();
+      if (std::none_of(runners_.begin(), runners_.end(),
+                       [&](SimulatedSequenceRunner* runner) {
+                         return runner->GetNextRunTime() <= current_time;
+                       })) {
+        return;
+      }
+      rtc::CritScope round_lock(&round_lock_);
+      round_time_ = current_time;
+      for (SimulatedSequenceRunner* runner : runners_) {
+        round_index_[runner] = round_.size();
+        round_.push_back(RoundEntry{runner});
+      }
+      deferred_tasks_.resize(round_.size());
+      next_unclaimed_ = 0;
+      num_running_ = 0;
+      round_done_ = false;
+      in_round_ = true;
+    }
+    worker_pool_->StartRound();
+    RunRound(&idle_);
+    worker_pool_->WaitForRound();
+    FinishRound();
+  }
+}
+
+void SimulatedTimeControllerImpl::RunRound(rtc::Event* idle) {
+  while (true) {
+    size_t index;
+    bool claimed;
+    {
+      rtc::CritScope lock(&round_lock_);
+      if (round_done_)
+        return;
+      claimed = ClaimRunner(&index);
+      if (!claimed) {
+        if (num_running_ == 0) {
+          round_done_ = true;
+          WakeIdleThreads();
+          return;
+        }
+        idle_threads_.push_back(idle);
+      }
+    }
+    if (claimed) {
+      RunClaimedRunner(index);
+    } else {
+      rtc::ScopedYieldPolicy no_yield(nullptr);
+      idle->Wait(rtc::Event::kForever);
+    }
+  }
+}
+
+bool SimulatedTimeControllerImpl::ClaimRunner(size_t* index) {
+  for (size_t i = 0; i < round_.size(); ++i) {
+    size_t candidate = (next_unclaimed_ + i) % round_.size();
+    RoundEntry& entry = round_[candidate];
+    if (entry.runner && !entry.running && !entry.deleted &&
+        entry.runner->GetNextRunTime() <= round_time_) {
+      entry.running = true;
+      ++num_running_;
+      next_unclaimed_ = candidate + 1;
+      *index = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+void SimulatedTimeControllerImpl::RunClaimedRunner(size_t index) {
+  SimulatedSequenceRunner* runner;
+  Timestamp round_time = Timestamp::MinusInfinity();
+  {
+    rtc::CritScope lock(&round_lock_);
+    runner = round_[index].runner;
+    round_time = round_time_;
+  }
+  {
+    // Makes tasks waiting on this thread call YieldInRound().
+    rtc::ScopedYieldPolicy yield_policy(this);
+    runner->UpdateReady(round_time);
+    runner->Run(round_time);
+  }
+  rtc::CritScope lock(&round_lock_);
+  round_[index].running = false;
+  --num_running_;
+  WakeIdleThreads();
+}
+
+void SimulatedTimeControllerImpl::YieldInRound() {
+  TaskQueueBase* yielding_from = TaskQueueBase::Current();
+  SimulatedSequenceRunner::CurrentTaskQueueSetter reset_queue(nullptr);
+  {
+    rtc::CritScope lock(&round_lock_);
+    // What's waited for is likely to depend on the tasks posted so far.
+    auto it = round_index_.find(yielding_from);
+    if (it != round_index_.end())
+      PostDeferredTasks(it->second);
+    WakeIdleThreads();
+  }
+  // The yielding runner stays claimed, so it isn't run recursively.
+  while (true) {
+    size_t index;
+    {
+      rtc::CritScope lock(&round_lock_);
+      if (!ClaimRunner(&index))
+        return;
+    }
+    RunClaimedRunner(index);
+  }
+}
+
+void SimulatedTimeControllerImpl::PostDeferredTasks(size_t index) {
+  for (DeferredTask& deferred : deferred_tasks_[index]) {
+    const RoundEntry& target = round_[deferred.target];
+    if (!target.runner || target.deleted)
+      continue;
+    if (deferred.delayed) {
+      target.runner->EnqueueDelayedTask(std::move(deferred.task),
+                                        deferred.milliseconds);
+    } else {
+      target.runner->EnqueueTask(std::move(deferred.task));
+    }
+  }
+  deferred_tasks_[index].clear();
+}
+
+void SimulatedTimeControllerImpl::WakeIdleThreads() {
+  for (rtc::Event* idle : idle_threads_)
+    idle->Set();
+  idle_threads_.clear();
+}
+
+void SimulatedTimeControllerImpl::FinishRound() {
+  std::vector<SimulatedSequenceRunner*> deleted;
+  {
+    rtc::CritScope lock(&round_lock_);
+    in_round_ = false;
+    // In the order of the runners, which is the same from one run to the
+    // next, rather than in the order the tasks were posted.
+    for (size_t i = 0; i < round_.size(); ++i)
+      PostDeferredTasks(i);
+    round_.clear();
+    round_index_.clear();
+    deferred_tasks_.clear();
+    deleted.swap(deleted_in_round_);
+  }
+  for (SimulatedSequenceRunner* runner : deleted)
+    runner->Delete();
 }
 
 }  // namespace sim_time_impl
 
 GlobalSimulatedTimeController::GlobalSimulatedTimeController(
     Timestamp start_time)
-    : sim_clock_(start_time.us()), impl_(start_time) {
+    : GlobalSimulatedTimeController(start_time, /*parallel_threads=*/1) {}
+
+GlobalSimulatedTimeController::GlobalSimulatedTimeController(
+    Timestamp start_time,
+    int parallel_threads)
+    : sim_clock_(start_time.us()), impl_(start_time, parallel_threads) {
   global_clock_.SetTime(start_time);
 }
 
@@ -10,8 +10,10 @@
 #ifndef TEST_TIME_CONTROLLER_SIMULATED_TIME_CONTROLLER_H_
 #define TEST_TIME_CONTROLLER_SIMULATED_TIME_CONTROLLER_H_
 
+#include <atomic>
 #include <list>
 #include <memory>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -20,6 +22,7 @@
 #include "modules/include/module.h"
 #include "modules/utility/include/process_thread.h"
 #include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
 #include "rtc_base/fake_clock.h"
 #include "rtc_base/platform_thread_types.h"
 #include "rtc_base/synchronization/yield_policy.h"
@@ -34,7 +37,8 @@ class SimulatedSequenceRunner;
 class SimulatedTimeControllerImpl : public TaskQueueFactory,
                                     public rtc::YieldInterface {
  public:
-  explicit SimulatedTimeControllerImpl(Timestamp start_time);
+  // See GlobalSimulatedTimeController for |parallel_threads|.
+  SimulatedTimeControllerImpl(Timestamp start_time, int parallel_threads);
   ~SimulatedTimeControllerImpl() override;
 
   std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
@@ -59,7 +63,50 @@ class SimulatedTimeControllerImpl : public TaskQueueFactory,
   // Removes |runner| from |runners_|.
   void Unregister(SimulatedSequenceRunner* runner);
 
+  // While runners run in parallel, holds back |task| posted from one runner
+  // to |target| until all of them have run. Returns false, leaving |task|
+  // alone, if it is to be posted right away.
+  bool MaybeDeferTask(SimulatedSequenceRunner* target,
+                      std::unique_ptr<QueuedTask>* task,
+                      bool delayed,
+                      uint32_t milliseconds);
+  // Returns true if |runner| is deleted once the runners running in parallel
+  // are done, rather than right away, since it may still be running.
+  bool DeleteAfterRound(SimulatedSequenceRunner* runner);
+
  private:
+  class WorkerPool;
+
+  struct DeferredTask {
+    // Index in |round_| of the runner the task was posted to.
+    size_t target;
+    std::unique_ptr<QueuedTask> task;
+    bool delayed;
+    uint32_t milliseconds;
+  };
+  struct RoundEntry {
+    // Null once destroyed.
+    SimulatedSequenceRunner* runner;
+    bool running = false;
+    bool deleted = false;
+  };
+
+  // Runs the ready runners in rounds, with the runners of each round running
+  // in parallel, until none is ready.
+  void RunReadyRunnersInParallel();
+  // Takes part in running the current round, until it's done. |idle| is
+  // signaled when there may be more to run.
+  void RunRound(rtc::Event* idle);
+  bool ClaimRunner(size_t* index) RTC_EXCLUSIVE_LOCKS_REQUIRED(round_lock_);
+  void RunClaimedRunner(size_t index);
+  // Called in place of YieldExecution() while a round runs. Posts the tasks
+  // held back for the yielding runner, then runs what is ready meanwhile.
+  void YieldInRound();
+  void PostDeferredTasks(size_t index)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(round_lock_);
+  void WakeIdleThreads() RTC_EXCLUSIVE_LOCKS_REQUIRED(round_lock_);
+  void FinishRound();
+
   const rtc::PlatformThreadId thread_id_;
   rtc::ThreadChecker thread_checker_;
   rtc::CriticalSection time_lock_;
@@ -73,6 +120,28 @@ class SimulatedTimeControllerImpl : public TaskQueueFactory,
 
   // Task queues on which YieldExecution has been called.
   std::unordered_set<TaskQueueBase*> yielded_ RTC_GUARDED_BY(thread_checker_);
+
+  // Only set when running in parallel.
+  const std::unique_ptr<WorkerPool> worker_pool_;
+  rtc::Event idle_;
+  std::atomic<bool> in_round_{false};
+  rtc::CriticalSection round_lock_;
+  Timestamp round_time_ RTC_GUARDED_BY(round_lock_) =
+      Timestamp::MinusInfinity();
+  // All runners at the start of the round, in the order of |runners_|.
+  std::vector<RoundEntry> round_ RTC_GUARDED_BY(round_lock_);
+  std::unordered_map<const TaskQueueBase*, size_t> round_index_
+      RTC_GUARDED_BY(round_lock_);
+  // Tasks held back, by the index of the runner that posted them.
+  std::vector<std::vector<DeferredTask>> deferred_tasks_
+      RTC_GUARDED_BY(round_lock_);
+  // Where ClaimRunner() starts looking for a ready runner.
+  size_t next_unclaimed_ RTC_GUARDED_BY(round_lock_) = 0;
+  int num_running_ RTC_GUARDED_BY(round_lock_) = 0;
+  bool round_done_ RTC_GUARDED_BY(round_lock_) = false;
+  std::vector<rtc::Event*> idle_threads_ RTC_GUARDED_BY(round_lock_);
+  std::vector<SimulatedSequenceRunner*> deleted_in_round_
+      RTC_GUARDED_BY(round_lock_);
 };
 }  // namespace sim_time_impl
 
@@ -84,6 +153,16 @@ class SimulatedTimeControllerImpl : public TaskQueueFactory,
 class GlobalSimulatedTimeController : public TimeController {
  public:
   explicit GlobalSimulatedTimeController(Timestamp start_time);
+  // With |parallel_threads| larger than one, the task queues and process
+  // threads with work due at the same simulated time run in parallel, on that
+  // many threads. Tasks posted from one to another are held back until all of
+  // them have run, so each task queue runs the same tasks in the same order
+  // from one run to the next, whatever the threads do, as long as the task
+  // queues share no state except through tasks. That order differs from the
+  // one of running on a single thread. A task blocking on other task queues,
+  // e.g. waiting for an rtc::Event, gets the tasks it posted run right away,
+  // giving up the ordering guarantee.
+  GlobalSimulatedTimeController(Timestamp start_time, int parallel_threads);
   ~GlobalSimulatedTimeController() override;
 
   Clock* GetClock() override;
@@ -12,9 +12,12 @@
 
 #include <atomic>
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "rtc_base/task_queue.h"
 #include "rtc_base/task_utils/repeating_task.h"
+#include "rtc_base/time_utils.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -28,6 +31,37 @@ using ::testing::MockFunction;
 using ::testing::NiceMock;
 using ::testing::Return;
 constexpr Timestamp kStartTime = Timestamp::Seconds<1000>();
+
+// Has |num_queues| task queues ping each other, with each queue logging the
+// order it receives the pings in.
+std::vector<std::vector<std::string>> RunPingPong(int parallel_threads,
+                                                   int num_queues) {
+  GlobalSimulatedTimeController time_simulation(kStartTime, parallel_threads);
+  std::vector<std::unique_ptr<rtc::TaskQueue>> task_queues;
+  for (int i = 0; i < num_queues; ++i) {
+    task_queues.push_back(std::make_unique<rtc::TaskQueue>(
+        time_simulation.GetTaskQueueFactory()->CreateTaskQueue(
+            "TestQueue", TaskQueueFactory::Priority::NORMAL)));
+  }
+  std::vector<std::vector<std::string>> logs(num_queues);
+  for (int i = 0; i < num_queues; ++i) {
+    RepeatingTaskHandle::Start(task_queues[i]->Get(), [&, i] {
+      for (int j = 0; j < num_queues; ++j) {
+        if (j == i)
+          continue;
+        std::string ping =
+            std::to_string(i) + ":" + std::to_string(rtc::TimeMillis());
+        task_queues[j]->PostTask([&logs, j, ping] { logs[j].push_back(ping); });
+        task_queues[j]->PostDelayedTask(
+            [&logs, j, ping] { logs[j].push_back(ping + "+1"); }, 1);
+      }
+      return TimeDelta::ms(1 + i % 3);
+    });
+  }
+  time_simulation.Sleep(TimeDelta::ms(50));
+  task_queues.clear();
+  return logs;
+}
 }  // namespace
 
 TEST(SimulatedTimeControllerTest, TaskIsStoppedOnStop) {
@@ -76,6 +110,17 @@ TEST(SimulatedTimeControllerTest, TaskCanStopItself) {
   time_simulation.Sleep(TimeDelta::ms(10));
   EXPECT_EQ(counter.load(), 1);
 }
+TEST(SimulatedTimeControllerTest, RunsTaskQueuesInParallelDeterministically) {
+  const int kNumQueues = 8;
+  std::vector<std::vector<std::string>> logs = RunPingPong(4, kNumQueues);
+  for (int i = 0; i < kNumQueues; ++i) {
+    // Each of the other queues pings at least once every third millisecond.
+    EXPECT_GE(logs[i].size(), (kNumQueues - 1) * 2 * 50u / 3);
+  }
+  for (int run = 0; run < 5; ++run)
+    EXPECT_EQ(logs, RunPingPong(4, kNumQueues));
+}
+
 TEST(SimulatedTimeControllerTest, Example) {
   class ObjectOnTaskQueue {
    public:
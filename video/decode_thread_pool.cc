@@ -0,0 +1,240 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_conversions.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+// A task queue that runs its tasks on the threads of a DecodeThreadPool. All
+// state but the pool pointer is guarded by the pool's lock.
+class DecodeThreadPool::Sequence final : public TaskQueueBase {
+ public:
+  explicit Sequence(DecodeThreadPool* pool) : pool_(pool) {}
+
+  void Delete() override { pool_->DeleteSequence(this); }
+  void PostTask(std::unique_ptr<QueuedTask> task) override {
+    pool_->PostTask(this, std::move(task));
+  }
+  void PostDelayedTask(std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds) override {
+    pool_->PostDelayedTask(this, std::move(task), milliseconds);
+  }
+
+  void RunTask(std::unique_ptr<QueuedTask> task) {
+    CurrentTaskQueueSetter set_current(this);
+    if (!task->Run())
+      task.release();
+  }
+
+  std::deque<std::unique_ptr<QueuedTask>> tasks;
+  // True when the sequence is waiting in a ready queue, or running.
+  bool scheduled = false;
+  bool running = false;
+  bool prioritized = false;
+  bool deleted = false;
+  // Signaled when a task finishes running after the sequence was deleted.
+  rtc::Event stopped;
+
+ private:
+  ~Sequence() override = default;
+  // Only the pool deletes sequences, once they are done running.
+  friend class DecodeThreadPool;
+
+  DecodeThreadPool* const pool_;
+};
+
+DecodeThreadPool::DecodeThreadPool(int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    // Same priority as the per stream decode queues.
+    threads_.push_back(std::make_unique<rtc::PlatformThread>(
+        &DecodeThreadPool::RunWorker, this, "DecodingThread",
+        rtc::kRealtimePriority));
+    threads_.back()->Start();
+  }
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK_EQ(num_sequences_, 0);
+    quit_ = true;
+  }
+  wake_up_.Set();
+  for (auto& thread : threads_)
+    thread->Stop();
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+DecodeThreadPool::CreateTaskQueue(absl::string_view name) {
+  rtc::CritScope lock(&crit_);
+  ++num_sequences_;
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(new Sequence(this));
+}
+
+void DecodeThreadPool::SetPrioritized(TaskQueueBase* task_queue,
+                                      bool prioritized) {
+  Sequence* sequence = static_cast<Sequence*>(task_queue);
+  rtc::CritScope lock(&crit_);
+  if (sequence->prioritized == prioritized)
+    return;
+  if (sequence->scheduled && !sequence->running) {
+    std::deque<Sequence*>& ready = ReadyQueue(sequence);
+    ready.erase(std::find(ready.begin(), ready.end(), sequence));
+    sequence->prioritized = prioritized;
+    ReadyQueue(sequence).push_back(sequence);
+  } else {
+    sequence->prioritized = prioritized;
+  }
+}
+
+void DecodeThreadPool::RunWorker(void* obj) {
+  static_cast<DecodeThreadPool*>(obj)->ProcessTasks();
+}
+
+void DecodeThreadPool::ProcessTasks() {
+  while (true) {
+    Sequence* sequence = nullptr;
+    std::unique_ptr<QueuedTask> task;
+    int wait_ms = rtc::Event::kForever;
+    {
+      rtc::CritScope lock(&crit_);
+      if (quit_) {
+        // Pass the wake up on to the next thread.
+        wake_up_.Set();
+        return;
+      }
+      int64_t now_ms = rtc::TimeMillis();
+      while (!delayed_tasks_.empty() &&
+             delayed_tasks_.begin()->first <= now_ms) {
+        auto it = delayed_tasks_.begin();
+        it->second.first->tasks.push_back(std::move(it->second.second));
+        Schedule(it->second.first);
+        delayed_tasks_.erase(it);
+      }
+
+      std::deque<Sequence*>& ready =
+          ready_prioritized_.empty() ? ready_ : ready_prioritized_;
+      if (!ready.empty()) {
+        sequence = ready.front();
+        ready.pop_front();
+        task = std::move(sequence->tasks.front());
+        sequence->tasks.pop_front();
+        sequence->running = true;
+        // Only one thread is woken up per event, so wake up another one if
+        // there is more to do.
+        if (!ready_prioritized_.empty() || !ready_.empty())
+          wake_up_.Set();
+      } else if (!delayed_tasks_.empty()) {
+        wait_ms = rtc::checked_cast<int>(delayed_tasks_.begin()->first -
+                                         now_ms);
+      }
+    }
+
+    if (!sequence) {
+      wake_up_.Wait(wait_ms);
+      continue;
+    }
+
+    sequence->RunTask(std::move(task));
+
+    rtc::CritScope lock(&crit_);
+    sequence->running = false;
+    if (sequence->deleted) {
+      // DeleteSequence() is waiting for this task and deletes the sequence.
+      sequence->stopped.Set();
+    } else if (sequence->tasks.empty()) {
+      sequence->scheduled = false;
+    } else {
+      // Go to the back of the line, so that a busy queue doesn't keep other
+      // queues from running.
+      ReadyQueue(sequence).push_back(sequence);
+    }
+  }
+}
+
+void DecodeThreadPool::PostTask(Sequence* sequence,
+                                std::unique_ptr<QueuedTask> task) {
+  {
+    rtc::CritScope lock(&crit_);
+    if (sequence->deleted)
+      return;
+    sequence->tasks.push_back(std::move(task));
+    Schedule(sequence);
+  }
+  // |task| may still hold a dropped task here, which is deleted outside the
+  // lock.
+}
+
+void DecodeThreadPool::PostDelayedTask(Sequence* sequence,
+                                       std::unique_ptr<QueuedTask> task,
+                                       uint32_t milliseconds) {
+  {
+    rtc::CritScope lock(&crit_);
+    if (sequence->deleted)
+      return;
+    delayed_tasks_.emplace(rtc::TimeMillis() + milliseconds,
+                           std::make_pair(sequence, std::move(task)));
+  }
+  // A thread may be waiting for a later delayed task.
+  wake_up_.Set();
+}
+
+void DecodeThreadPool::DeleteSequence(Sequence* sequence) {
+  RTC_DCHECK(!sequence->IsCurrent());
+  // Pending tasks are deleted outside the lock, since their destructors may
+  // post tasks.
+  std::deque<std::unique_ptr<QueuedTask>> pending_tasks;
+  std::vector<std::unique_ptr<QueuedTask>> pending_delayed_tasks;
+  bool running;
+  {
+    rtc::CritScope lock(&crit_);
+    sequence->deleted = true;
+    pending_tasks.swap(sequence->tasks);
+    if (sequence->scheduled && !sequence->running) {
+      std::deque<Sequence*>& ready = ReadyQueue(sequence);
+      ready.erase(std::find(ready.begin(), ready.end(), sequence));
+    }
+    for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+      if (it->second.first == sequence) {
+        pending_delayed_tasks.push_back(std::move(it->second.second));
+        it = delayed_tasks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    running = sequence->running;
+    --num_sequences_;
+  }
+  if (running)
+    sequence->stopped.Wait(rtc::Event::kForever);
+  delete sequence;
+}
+
+void DecodeThreadPool::Schedule(Sequence* sequence) {
+  if (sequence->scheduled)
+    return;
+  sequence->scheduled = true;
+  ReadyQueue(sequence).push_back(sequence);
+  wake_up_.Set();
+}
+
+std::deque<DecodeThreadPool::Sequence*>& DecodeThreadPool::ReadyQueue(
+    const Sequence* sequence) {
+  return sequence->prioritized ? ready_prioritized_ : ready_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODE_THREAD_POOL_H_
+#define VIDEO_DECODE_THREAD_POOL_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/queued_task.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs the decode task queues of many video receive streams on a fixed set of
+// threads, instead of on one thread per stream. Each task queue still runs its
+// tasks one at a time and in order, but the queues share the threads: when a
+// queue has pending tasks it waits in line behind the other ready queues, and
+// gets the next free thread. This keeps the thread count down with many
+// receive streams, and spreads out bursts of keyframes on all threads.
+//
+// Queues can be prioritized, e.g. the decode queue of the active speaker. A
+// prioritized queue with pending tasks runs before all other queues.
+class DecodeThreadPool {
+ public:
+  explicit DecodeThreadPool(int num_threads);
+  DecodeThreadPool(const DecodeThreadPool&) = delete;
+  DecodeThreadPool& operator=(const DecodeThreadPool&) = delete;
+  // All task queues must be deleted before the pool.
+  ~DecodeThreadPool();
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name);
+
+  // |task_queue| must be created by this pool.
+  void SetPrioritized(TaskQueueBase* task_queue, bool prioritized);
+
+ private:
+  class Sequence;
+
+  static void RunWorker(void* obj);
+  void ProcessTasks();
+
+  void PostTask(Sequence* sequence, std::unique_ptr<QueuedTask> task);
+  void PostDelayedTask(Sequence* sequence,
+                       std::unique_ptr<QueuedTask> task,
+                       uint32_t milliseconds);
+  void DeleteSequence(Sequence* sequence);
+
+  // Puts |sequence| in line to run, unless it already is or is running.
+  void Schedule(Sequence* sequence) RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  std::deque<Sequence*>& ReadyQueue(const Sequence* sequence)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Signaled when there are tasks to run, or when a new delayed task may be
+  // the next one due.
+  rtc::Event wake_up_;
+
+  rtc::CriticalSection crit_;
+  bool quit_ RTC_GUARDED_BY(crit_) = false;
+  int num_sequences_ RTC_GUARDED_BY(crit_) = 0;
+  // Sequences with pending tasks that aren't running.
+  std::deque<Sequence*> ready_prioritized_ RTC_GUARDED_BY(crit_);
+  std::deque<Sequence*> ready_ RTC_GUARDED_BY(crit_);
+  // Delayed tasks by the time they are due. Tasks due at the same time run in
+  // the order they were posted.
+  std::multimap<int64_t, std::pair<Sequence*, std::unique_ptr<QueuedTask>>>
+      delayed_tasks_ RTC_GUARDED_BY(crit_);
+
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODE_THREAD_POOL_H_
@@ -0,0 +1,134 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <memory>
+#include <vector>
+
+#include "rtc_base/event.h"
+#include "rtc_base/task_utils/to_queued_task.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWaitMs = 5000;
+
+using TaskQueue = std::unique_ptr<TaskQueueBase, TaskQueueDeleter>;
+
+TEST(DecodeThreadPoolTest, RunsTasksInOrderOnEachQueue) {
+  const int kNumQueues = 4;
+  const int kNumTasks = 100;
+  DecodeThreadPool pool(2);
+  std::vector<TaskQueue> queues;
+  std::vector<std::vector<int>> results(kNumQueues);
+  std::vector<std::unique_ptr<rtc::Event>> done;
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues.push_back(pool.CreateTaskQueue("Queue"));
+    done.push_back(std::make_unique<rtc::Event>());
+  }
+
+  for (int task = 0; task < kNumTasks; ++task) {
+    for (int i = 0; i < kNumQueues; ++i) {
+      TaskQueueBase* queue = queues[i].get();
+      std::vector<int>* result = &results[i];
+      queue->PostTask(ToQueuedTask([queue, result, task] {
+        EXPECT_TRUE(queue->IsCurrent());
+        result->push_back(task);
+      }));
+    }
+  }
+  for (int i = 0; i < kNumQueues; ++i)
+    queues[i]->PostTask(ToQueuedTask([&done, i] { done[i]->Set(); }));
+
+  for (int i = 0; i < kNumQueues; ++i) {
+    ASSERT_TRUE(done[i]->Wait(kWaitMs));
+    ASSERT_EQ(static_cast<size_t>(kNumTasks), results[i].size());
+    for (int task = 0; task < kNumTasks; ++task)
+      EXPECT_EQ(task, results[i][task]);
+  }
+}
+
+TEST(DecodeThreadPoolTest, RunsDelayedTasksAfterPendingTasks) {
+  DecodeThreadPool pool(1);
+  TaskQueue queue = pool.CreateTaskQueue("Queue");
+  std::vector<int> order;
+  rtc::Event done;
+  queue->PostDelayedTask(ToQueuedTask([&] {
+                           order.push_back(2);
+                           done.Set();
+                         }),
+                         10);
+  queue->PostTask(ToQueuedTask([&] { order.push_back(1); }));
+
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  EXPECT_EQ(std::vector<int>({1, 2}), order);
+}
+
+TEST(DecodeThreadPoolTest, PrioritizedQueueRunsFirst) {
+  DecodeThreadPool pool(1);
+  TaskQueue blocking_queue = pool.CreateTaskQueue("Blocking");
+  TaskQueue normal_queue = pool.CreateTaskQueue("Normal");
+  TaskQueue prioritized_queue = pool.CreateTaskQueue("Prioritized");
+  pool.SetPrioritized(prioritized_queue.get(), true);
+
+  // Keep the only thread busy while the other queues get their tasks.
+  rtc::Event started;
+  rtc::Event release;
+  blocking_queue->PostTask(ToQueuedTask([&] {
+    started.Set();
+    release.Wait(rtc::Event::kForever);
+  }));
+  ASSERT_TRUE(started.Wait(kWaitMs));
+
+  std::vector<TaskQueueBase*> order;
+  rtc::Event done;
+  normal_queue->PostTask(ToQueuedTask([&] {
+    order.push_back(normal_queue.get());
+    done.Set();
+  }));
+  prioritized_queue->PostTask(
+      ToQueuedTask([&] { order.push_back(prioritized_queue.get()); }));
+  release.Set();
+
+  ASSERT_TRUE(done.Wait(kWaitMs));
+  ASSERT_EQ(2u, order.size());
+  EXPECT_EQ(prioritized_queue.get(), order[0]);
+  EXPECT_EQ(normal_queue.get(), order[1]);
+}
+
+TEST(DecodeThreadPoolTest, DeleteWaitsForRunningTaskAndDropsPendingTasks) {
+  DecodeThreadPool pool(2);
+  TaskQueue queue = pool.CreateTaskQueue("Queue");
+  TaskQueue other_queue = pool.CreateTaskQueue("Other");
+
+  rtc::Event started;
+  rtc::Event release;
+  bool finished = false;
+  bool pending_task_ran = false;
+  queue->PostTask(ToQueuedTask([&] {
+    started.Set();
+    release.Wait(rtc::Event::kForever);
+    finished = true;
+  }));
+  queue->PostTask(ToQueuedTask([&] { pending_task_ran = true; }));
+  queue->PostDelayedTask(ToQueuedTask([&] { pending_task_ran = true; }), 1);
+  ASSERT_TRUE(started.Wait(kWaitMs));
+
+  // Let the running task finish while Delete() is blocked.
+  other_queue->PostDelayedTask(ToQueuedTask([&] { release.Set(); }), 10);
+  queue = nullptr;
+  EXPECT_TRUE(finished);
+  EXPECT_FALSE(pending_task_ran);
+}
+
+}  // namespace
+}  // namespace webrtc
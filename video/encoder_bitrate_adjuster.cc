@@ -45,16 +45,27 @@ constexpr size_t EncoderBitrateAdjuster::kMinFramesSinceLayoutChange;
 constexpr double EncoderBitrateAdjuster::kDefaultUtilizationFactor;
 
 EncoderBitrateAdjuster::EncoderBitrateAdjuster(const VideoCodec& codec_settings)
+    : EncoderBitrateAdjuster(codec_settings, nullptr) {}
+
+EncoderBitrateAdjuster::EncoderBitrateAdjuster(
+    const VideoCodec& codec_settings,
+    EncoderUtilizationHistory* utilization_history)
     : utilize_bandwidth_headroom_(RateControlSettings::ParseFromFieldTrials()
                                       .BitrateAdjusterCanUseNetworkHeadroom()),
+      utilization_history_(utilization_history),
+      codec_mode_(codec_settings.mode),
       frames_since_layout_change_(0),
-      min_bitrates_bps_{} {
+      min_bitrates_bps_{},
+      layer_widths_{codec_settings.width},
+      layer_heights_{codec_settings.height} {
   if (codec_settings.codecType == VideoCodecType::kVideoCodecVP9) {
     for (size_t si = 0; si < codec_settings.VP9().numberOfSpatialLayers; ++si) {
       if (codec_settings.spatialLayers[si].active) {
         min_bitrates_bps_[si] =
             std::max(codec_settings.minBitrate * 1000,
                      codec_settings.spatialLayers[si].minBitrate * 1000);
+        layer_widths_[si] = codec_settings.spatialLayers[si].width;
+        layer_heights_[si] = codec_settings.spatialLayers[si].height;
       }
     }
   } else {
@@ -63,6 +74,8 @@ EncoderBitrateAdjuster::EncoderBitrateAdjuster(const VideoCodec& codec_settings)
         min_bitrates_bps_[si] =
             std::max(codec_settings.minBitrate * 1000,
                      codec_settings.simulcastStream[si].minBitrate * 1000);
+        layer_widths_[si] = codec_settings.simulcastStream[si].width;
+        layer_heights_[si] = codec_settings.simulcastStream[si].height;
       }
     }
   }
@@ -111,10 +124,23 @@ VideoBitrateAllocation EncoderBitrateAdjuster::AdjustRateAllocation(
     layer_info.target_rate =
         DataRate::bps(rates.bitrate.GetSpatialLayerSum(si));
 
+    // Set if the utilization factors come from the overshoot detectors.
+    bool measured = false;
+
     // Adjustment is done per spatial layer only (not per temporal layer).
     if (frames_since_layout_change_ < kMinFramesSinceLayoutChange) {
-      layer_info.link_utilization_factor = kDefaultUtilizationFactor;
-      layer_info.media_utilization_factor = kDefaultUtilizationFactor;
+      absl::optional<EncoderUtilizationHistory::UtilizationFactors>
+          remembered_factors;
+      if (utilization_history_) {
+        remembered_factors = utilization_history_->Get(
+            codec_mode_, layer_widths_[si], layer_heights_[si]);
+      }
+      layer_info.link_utilization_factor =
+          remembered_factors ? remembered_factors->link_utilization_factor
+                             : kDefaultUtilizationFactor;
+      layer_info.media_utilization_factor =
+          remembered_factors ? remembered_factors->media_utilization_factor
+                             : kDefaultUtilizationFactor;
     } else if (active_tls_[si] == 0 ||
                layer_info.target_rate == DataRate::Zero()) {
       // No signaled temporal layers, or no bitrate set. Could either be unused
@@ -127,14 +153,15 @@ VideoBitrateAllocation EncoderBitrateAdjuster::AdjustRateAllocation(
       // encoder does not support temporal layers. Merge target bitrates for
       // this spatial layer.
       RTC_DCHECK(overshoot_detectors_[si][0]);
+      const absl::optional<double> link_utilization_factor =
+          overshoot_detectors_[si][0]->GetNetworkRateUtilizationFactor(now_ms);
+      const absl::optional<double> media_utilization_factor =
+          overshoot_detectors_[si][0]->GetMediaRateUtilizationFactor(now_ms);
       layer_info.link_utilization_factor =
-          overshoot_detectors_[si][0]
-              ->GetNetworkRateUtilizationFactor(now_ms)
-              .value_or(kDefaultUtilizationFactor);
+          link_utilization_factor.value_or(kDefaultUtilizationFactor);
       layer_info.media_utilization_factor =
-          overshoot_detectors_[si][0]
-              ->GetMediaRateUtilizationFactor(now_ms)
-              .value_or(kDefaultUtilizationFactor);
+          media_utilization_factor.value_or(kDefaultUtilizationFactor);
+      measured = link_utilization_factor && media_utilization_factor;
     } else if (layer_info.target_rate > DataRate::Zero()) {
       // Multiple temporal layers enabled for this spatial layer. Update rate
       // for each of them and make a weighted average of utilization factors,
@@ -142,6 +169,7 @@ VideoBitrateAllocation EncoderBitrateAdjuster::AdjustRateAllocation(
       // If any layer is missing a utilization factor, fall back to default.
       layer_info.link_utilization_factor = 0.0;
       layer_info.media_utilization_factor = 0.0;
+      measured = true;
       for (size_t ti = 0; ti < active_tls_[si]; ++ti) {
         RTC_DCHECK(overshoot_detectors_[si][ti]);
         const absl::optional<double> ti_link_utilization_factor =
@@ -152,6 +180,7 @@ VideoBitrateAllocation EncoderBitrateAdjuster::AdjustRateAllocation(
         if (!ti_link_utilization_factor || !ti_media_utilization_factor) {
           layer_info.link_utilization_factor = kDefaultUtilizationFactor;
           layer_info.media_utilization_factor = kDefaultUtilizationFactor;
+          measured = false;
           break;
         }
         const double weight =
@@ -166,6 +195,13 @@ VideoBitrateAllocation EncoderBitrateAdjuster::AdjustRateAllocation(
       RTC_NOTREACHED();
     }
 
+    if (measured && utilization_history_) {
+      utilization_history_->Update(
+          codec_mode_, layer_widths_[si], layer_heights_[si],
+          {layer_info.link_utilization_factor,
+           layer_info.media_utilization_factor});
+    }
+
     if (layer_info.link_utilization_factor < 1.0) {
       // TODO(sprang): Consider checking underuse and allowing it to cancel some
       // potential overuse by other streams.
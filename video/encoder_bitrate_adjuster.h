@@ -17,6 +17,7 @@
 #include "api/video/video_bitrate_allocation.h"
 #include "api/video_codecs/video_encoder.h"
 #include "video/encoder_overshoot_detector.h"
+#include "video/encoder_utilization_history.h"
 
 namespace webrtc {
 
@@ -35,6 +36,12 @@ class EncoderBitrateAdjuster {
   static constexpr double kDefaultUtilizationFactor = 1.2;
 
   explicit EncoderBitrateAdjuster(const VideoCodec& codec_settings);
+  // Until the overshoot statistics can be trusted, layers start out with the
+  // utilization last recorded in |utilization_history| for the same content
+  // type and resolution, if any, and trusted statistics are recorded there.
+  // |utilization_history| must outlive the adjuster.
+  EncoderBitrateAdjuster(const VideoCodec& codec_settings,
+                         EncoderUtilizationHistory* utilization_history);
   ~EncoderBitrateAdjuster();
 
   // Adjusts the given rate allocation to make it paceable within the target
@@ -53,6 +60,8 @@ class EncoderBitrateAdjuster {
 
  private:
   const bool utilize_bandwidth_headroom_;
+  EncoderUtilizationHistory* const utilization_history_;
+  const VideoCodecMode codec_mode_;
 
   VideoEncoder::RateControlParameters current_rate_control_parameters_;
   // FPS allocation of temporal layers, per spatial layer. Represented as a Q8
@@ -68,6 +77,9 @@ class EncoderBitrateAdjuster {
 
   // Minimum bitrates allowed, per spatial layer.
   uint32_t min_bitrates_bps_[kMaxSpatialLayers];
+  // Resolution of each spatial layer, keying |utilization_history_|.
+  int layer_widths_[kMaxSpatialLayers];
+  int layer_heights_[kMaxSpatialLayers];
 };
 
 }  // namespace webrtc
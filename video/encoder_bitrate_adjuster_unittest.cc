@@ -80,7 +80,8 @@ class EncoderBitrateAdjusterTest : public ::testing::Test {
       }
     }
 
-    adjuster_ = std::make_unique<EncoderBitrateAdjuster>(codec_);
+    adjuster_ = std::make_unique<EncoderBitrateAdjuster>(
+        codec_, use_utilization_history_ ? &utilization_history_ : nullptr);
     adjuster_->OnEncoderInfo(encoder_info_);
     current_adjusted_allocation_ =
         adjuster_->AdjustRateAllocation(VideoEncoder::RateControlParameters(
@@ -230,6 +231,8 @@ class EncoderBitrateAdjusterTest : public ::testing::Test {
 
   VideoCodec codec_;
   VideoEncoder::EncoderInfo encoder_info_;
+  bool use_utilization_history_ = false;
+  EncoderUtilizationHistory utilization_history_;
   std::unique_ptr<EncoderBitrateAdjuster> adjuster_;
   VideoBitrateAllocation current_input_allocation_;
   VideoBitrateAllocation current_adjusted_allocation_;
@@ -526,5 +529,35 @@ TEST_F(EncoderBitrateAdjusterTest, DontExceedMediaRateEvenWithHeadroom) {
   }
 }
 
+TEST_F(EncoderBitrateAdjusterTest, ReconfiguredAdjusterStartsFromHistory) {
+  current_input_allocation_.SetBitrate(0, 0, 300000);
+  target_framerate_fps_ = 30;
+  codec_.simulcastStream[0].width = 1280;
+  codec_.simulcastStream[0].height = 720;
+  use_utilization_history_ = true;
+  SetUpAdjuster(1, 1, false);
+  InsertFrames({{1.5}}, kWindowSizeMs);
+  current_adjusted_allocation_ =
+      adjuster_->AdjustRateAllocation(VideoEncoder::RateControlParameters(
+          current_input_allocation_, target_framerate_fps_));
+  ExpectNear(MultiplyAllocation(current_input_allocation_, 1 / 1.5),
+             current_adjusted_allocation_, 0.01);
+
+  // A new adjuster for the same content and resolution starts out with the
+  // overshoot seen before rather than the default.
+  SetUpAdjuster(1, 1, false);
+  ExpectNear(MultiplyAllocation(current_input_allocation_, 1 / 1.5),
+             current_adjusted_allocation_, 0.01);
+
+  // Other resolutions still start from the default.
+  codec_.simulcastStream[0].width = 640;
+  codec_.simulcastStream[0].height = 360;
+  SetUpAdjuster(1, 1, false);
+  ExpectNear(MultiplyAllocation(current_input_allocation_,
+                                1 / EncoderBitrateAdjuster::
+                                        kDefaultUtilizationFactor),
+             current_adjusted_allocation_, 0.01);
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -43,6 +43,11 @@ void EncoderRtcpFeedback::SetRtpVideoSender(
   rtp_video_sender_ = rtp_video_sender;
 }
 
+void EncoderRtcpFeedback::SetKeyFrameRequestObserver(
+    VideoSendStream::KeyFrameRequestObserver* observer) {
+  key_frame_request_observer_ = observer;
+}
+
 bool EncoderRtcpFeedback::HasSsrc(uint32_t ssrc) {
   for (uint32_t registered_ssrc : ssrcs_) {
     if (registered_ssrc == ssrc) {
@@ -65,6 +70,8 @@ void EncoderRtcpFeedback::OnReceivedIntraFrameRequest(uint32_t ssrc) {
 
   // Always produce key frame for all streams.
   video_stream_encoder_->SendKeyFrame();
+  if (key_frame_request_observer_)
+    key_frame_request_observer_->OnKeyFrameRequested();
 }
 
 void EncoderRtcpFeedback::OnKeyFrameRequested(uint64_t channel_id) {
@@ -75,6 +82,8 @@ void EncoderRtcpFeedback::OnKeyFrameRequested(uint64_t channel_id) {
   }
 
   video_stream_encoder_->SendKeyFrame();
+  if (key_frame_request_observer_)
+    key_frame_request_observer_->OnKeyFrameRequested();
 }
 
 void EncoderRtcpFeedback::OnReceivedLossNotification(
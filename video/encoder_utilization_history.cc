@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/encoder_utilization_history.h"
+
+#include <algorithm>
+
+namespace webrtc {
+
+constexpr size_t EncoderUtilizationHistory::kMaxEntries;
+
+EncoderUtilizationHistory::EncoderUtilizationHistory() = default;
+
+EncoderUtilizationHistory::~EncoderUtilizationHistory() = default;
+
+absl::optional<EncoderUtilizationHistory::UtilizationFactors>
+EncoderUtilizationHistory::Get(VideoCodecMode mode,
+                               int width,
+                               int height) const {
+  for (const Entry& entry : entries_) {
+    if (entry.mode == mode && entry.width == width && entry.height == height)
+      return entry.factors;
+  }
+  return absl::nullopt;
+}
+
+void EncoderUtilizationHistory::Update(VideoCodecMode mode,
+                                       int width,
+                                       int height,
+                                       const UtilizationFactors& factors) {
+  ++num_updates_;
+  for (Entry& entry : entries_) {
+    if (entry.mode == mode && entry.width == width && entry.height == height) {
+      entry.factors = factors;
+      entry.last_update = num_updates_;
+      return;
+    }
+  }
+  if (entries_.size() >= kMaxEntries) {
+    entries_.erase(std::min_element(entries_.begin(), entries_.end(),
+                                    [](const Entry& a, const Entry& b) {
+                                      return a.last_update < b.last_update;
+                                    }));
+  }
+  entries_.push_back({mode, width, height, factors, num_updates_});
+}
+
+void EncoderUtilizationHistory::Clear() {
+  entries_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_ENCODER_UTILIZATION_HISTORY_H_
+#define VIDEO_ENCODER_UTILIZATION_HISTORY_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/video_codecs/video_codec.h"
+
+namespace webrtc {
+
+// Remembers the bitrate utilization an encoder reached per content type and
+// layer resolution, so that an EncoderBitrateAdjuster created for a new
+// configuration can start from the utilization last seen for the same kind of
+// layer, instead of a fixed default, while its own overshoot detectors fill
+// up. Not thread safe.
+class EncoderUtilizationHistory {
+ public:
+  // Number of (content type, resolution) combinations remembered. The least
+  // recently updated one is forgotten first.
+  static constexpr size_t kMaxEntries = 16;
+
+  struct UtilizationFactors {
+    double link_utilization_factor;
+    double media_utilization_factor;
+  };
+
+  EncoderUtilizationHistory();
+  ~EncoderUtilizationHistory();
+
+  absl::optional<UtilizationFactors> Get(VideoCodecMode mode,
+                                         int width,
+                                         int height) const;
+  void Update(VideoCodecMode mode,
+              int width,
+              int height,
+              const UtilizationFactors& factors);
+  void Clear();
+
+ private:
+  struct Entry {
+    VideoCodecMode mode;
+    int width;
+    int height;
+    UtilizationFactors factors;
+    int64_t last_update;
+  };
+
+  std::vector<Entry> entries_;
+  int64_t num_updates_ = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_ENCODER_UTILIZATION_HISTORY_H_
@@ -0,0 +1,58 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/encoder_utilization_history.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+TEST(EncoderUtilizationHistoryTest, KeyedByContentTypeAndResolution) {
+  EncoderUtilizationHistory history;
+  history.Update(VideoCodecMode::kScreensharing, 1920, 1080, {1.5, 1.1});
+  history.Update(VideoCodecMode::kRealtimeVideo, 1920, 1080, {1.2, 1.0});
+
+  auto factors = history.Get(VideoCodecMode::kScreensharing, 1920, 1080);
+  ASSERT_TRUE(factors);
+  EXPECT_EQ(1.5, factors->link_utilization_factor);
+  EXPECT_EQ(1.1, factors->media_utilization_factor);
+  factors = history.Get(VideoCodecMode::kRealtimeVideo, 1920, 1080);
+  ASSERT_TRUE(factors);
+  EXPECT_EQ(1.2, factors->link_utilization_factor);
+  EXPECT_FALSE(history.Get(VideoCodecMode::kScreensharing, 1280, 720));
+
+  history.Update(VideoCodecMode::kScreensharing, 1920, 1080, {1.3, 1.0});
+  EXPECT_EQ(1.3, history.Get(VideoCodecMode::kScreensharing, 1920, 1080)
+                     ->link_utilization_factor);
+
+  history.Clear();
+  EXPECT_FALSE(history.Get(VideoCodecMode::kScreensharing, 1920, 1080));
+}
+
+TEST(EncoderUtilizationHistoryTest, ForgetsLeastRecentlyUpdated) {
+  EncoderUtilizationHistory history;
+  const int kNumEntries =
+      static_cast<int>(EncoderUtilizationHistory::kMaxEntries);
+  for (int i = 0; i < kNumEntries; ++i)
+    history.Update(VideoCodecMode::kRealtimeVideo, i, i, {1.0, 1.0});
+  // Refresh the oldest entry, so that the second one is forgotten.
+  history.Update(VideoCodecMode::kRealtimeVideo, 0, 0, {1.0, 1.0});
+  history.Update(VideoCodecMode::kRealtimeVideo, kNumEntries, kNumEntries,
+                 {1.0, 1.0});
+
+  EXPECT_TRUE(history.Get(VideoCodecMode::kRealtimeVideo, 0, 0));
+  EXPECT_FALSE(history.Get(VideoCodecMode::kRealtimeVideo, 1, 1));
+  for (int i = 2; i <= kNumEntries; ++i)
+    EXPECT_TRUE(history.Get(VideoCodecMode::kRealtimeVideo, i, i));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frames_in_flight_tracker.h"
+
+#include "modules/include/module_common_types_public.h"
+
+namespace webrtc {
+
+constexpr int64_t FramesInFlightTracker::kMaxFrameInFlightMs;
+
+FramesInFlightTracker::FramesInFlightTracker() = default;
+
+FramesInFlightTracker::~FramesInFlightTracker() = default;
+
+void FramesInFlightTracker::OnEncodeStarted(uint32_t rtp_timestamp,
+                                            int64_t now_ms) {
+  rtc::CritScope lock(&crit_);
+  frames_.push_back({rtp_timestamp, now_ms});
+}
+
+void FramesInFlightTracker::OnEncodeRejected(uint32_t rtp_timestamp) {
+  rtc::CritScope lock(&crit_);
+  if (!frames_.empty() && frames_.back().rtp_timestamp == rtp_timestamp)
+    frames_.pop_back();
+}
+
+void FramesInFlightTracker::OnEncodeFinished(uint32_t rtp_timestamp) {
+  rtc::CritScope lock(&crit_);
+  while (!frames_.empty() &&
+         !IsNewerTimestamp(frames_.front().rtp_timestamp, rtp_timestamp)) {
+    frames_.pop_front();
+  }
+}
+
+void FramesInFlightTracker::OnFrameDropped() {
+  rtc::CritScope lock(&crit_);
+  if (!frames_.empty())
+    frames_.pop_front();
+}
+
+int FramesInFlightTracker::FramesInFlight(int64_t now_ms) {
+  rtc::CritScope lock(&crit_);
+  while (!frames_.empty() &&
+         now_ms - frames_.front().start_time_ms > kMaxFrameInFlightMs) {
+    frames_.pop_front();
+  }
+  return static_cast<int>(frames_.size());
+}
+
+void FramesInFlightTracker::Reset() {
+  rtc::CritScope lock(&crit_);
+  frames_.clear();
+}
+
+}  // namespace webrtc
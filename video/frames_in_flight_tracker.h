@@ -0,0 +1,57 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_FRAMES_IN_FLIGHT_TRACKER_H_
+#define VIDEO_FRAMES_IN_FLIGHT_TRACKER_H_
+
+#include <stdint.h>
+
+#include <deque>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Counts the frames a pipelining encoder has been given but not yet returned,
+// see VideoEncoder::EncoderInfo::max_frames_in_flight. Frames are started on
+// the encoder queue and finished on whatever thread the encoder delivers on.
+// A frame is finished by its first encoded image, which also finishes any
+// frames started before it. Encoders that drop frames silently would leave
+// them in flight forever, so frames time out after |kMaxFrameInFlightMs|.
+class FramesInFlightTracker {
+ public:
+  static constexpr int64_t kMaxFrameInFlightMs = 1000;
+
+  FramesInFlightTracker();
+  ~FramesInFlightTracker();
+
+  void OnEncodeStarted(uint32_t rtp_timestamp, int64_t now_ms);
+  // Encode() failed or returned without taking the frame.
+  void OnEncodeRejected(uint32_t rtp_timestamp);
+  void OnEncodeFinished(uint32_t rtp_timestamp);
+  // The encoder reported a dropped frame, which finishes the oldest one.
+  void OnFrameDropped();
+  int FramesInFlight(int64_t now_ms);
+  void Reset();
+
+ private:
+  struct Frame {
+    uint32_t rtp_timestamp;
+    int64_t start_time_ms;
+  };
+
+  rtc::CriticalSection crit_;
+  std::deque<Frame> frames_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_FRAMES_IN_FLIGHT_TRACKER_H_
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/frames_in_flight_tracker.h"
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr uint32_t kFrameInterval = 3000;
+
+TEST(FramesInFlightTrackerTest, EncodedImageFinishesOlderFrames) {
+  FramesInFlightTracker tracker;
+  for (uint32_t i = 0; i < 3; ++i)
+    tracker.OnEncodeStarted(i * kFrameInterval, 0);
+  EXPECT_EQ(3, tracker.FramesInFlight(0));
+  tracker.OnEncodeFinished(kFrameInterval);
+  EXPECT_EQ(1, tracker.FramesInFlight(0));
+  tracker.OnEncodeFinished(2 * kFrameInterval);
+  EXPECT_EQ(0, tracker.FramesInFlight(0));
+}
+
+TEST(FramesInFlightTrackerTest, HandlesTimestampWrap) {
+  FramesInFlightTracker tracker;
+  tracker.OnEncodeStarted(0xffffffff - kFrameInterval + 1, 0);
+  tracker.OnEncodeStarted(0, 0);
+  tracker.OnEncodeFinished(0xffffffff - kFrameInterval + 1);
+  EXPECT_EQ(1, tracker.FramesInFlight(0));
+  tracker.OnEncodeFinished(0);
+  EXPECT_EQ(0, tracker.FramesInFlight(0));
+}
+
+TEST(FramesInFlightTrackerTest, RejectedAndDroppedFramesAreNotInFlight) {
+  FramesInFlightTracker tracker;
+  tracker.OnEncodeStarted(0, 0);
+  tracker.OnEncodeStarted(kFrameInterval, 0);
+  tracker.OnEncodeRejected(kFrameInterval);
+  EXPECT_EQ(1, tracker.FramesInFlight(0));
+  tracker.OnFrameDropped();
+  EXPECT_EQ(0, tracker.FramesInFlight(0));
+  tracker.OnFrameDropped();
+  EXPECT_EQ(0, tracker.FramesInFlight(0));
+}
+
+TEST(FramesInFlightTrackerTest, FramesTimeOut) {
+  FramesInFlightTracker tracker;
+  tracker.OnEncodeStarted(0, 0);
+  tracker.OnEncodeStarted(kFrameInterval, 500);
+  const int64_t kMaxMs = FramesInFlightTracker::kMaxFrameInFlightMs;
+  EXPECT_EQ(2, tracker.FramesInFlight(kMaxMs));
+  EXPECT_EQ(1, tracker.FramesInFlight(kMaxMs + 1));
+  EXPECT_EQ(0, tracker.FramesInFlight(kMaxMs + 501));
+}
+
+}  // namespace
+}  // namespace webrtc
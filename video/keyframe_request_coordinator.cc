@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/keyframe_request_coordinator.h"
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+KeyFrameRequestCoordinator::KeyFrameRequestCoordinator(Clock* clock,
+                                                       int64_t min_interval_ms)
+    : clock_(clock), min_interval_ms_(min_interval_ms) {
+  RTC_DCHECK_GT(min_interval_ms_, 0);
+}
+
+KeyFrameRequestCoordinator::~KeyFrameRequestCoordinator() = default;
+
+bool KeyFrameRequestCoordinator::OnKeyFrameRequest(uint32_t remote_ssrc) {
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  rtc::CritScope lock(&crit_);
+  auto it = last_request_ms_.find(remote_ssrc);
+  if (it != last_request_ms_.end() && now_ms - it->second < min_interval_ms_) {
+    ++num_coalesced_requests_;
+    return false;
+  }
+  last_request_ms_[remote_ssrc] = now_ms;
+  return true;
+}
+
+void KeyFrameRequestCoordinator::RemoveSsrc(uint32_t remote_ssrc) {
+  rtc::CritScope lock(&crit_);
+  last_request_ms_.erase(remote_ssrc);
+}
+
+int64_t KeyFrameRequestCoordinator::num_coalesced_requests() const {
+  rtc::CritScope lock(&crit_);
+  return num_coalesced_requests_;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_KEYFRAME_REQUEST_COORDINATOR_H_
+#define VIDEO_KEYFRAME_REQUEST_COORDINATOR_H_
+
+#include <stdint.h>
+
+#include <map>
+
+#include "rtc_base/critical_section.h"
+#include "rtc_base/thread_annotations.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Coalesces the key frame requests of the video receive streams of a Call.
+// After a network hiccup, the frame buffer, the packet buffer and the decoder
+// of a stream may each ask for a key frame, and every request makes the
+// sender encode one more key frame. Instead, a request for a remote SSRC is
+// only sent if no request for it was sent within the last |min_interval_ms|;
+// the key frame asked for by the request that was sent fixes the stream for
+// all of them. If that request is lost, the receive stream asks again later.
+class KeyFrameRequestCoordinator {
+ public:
+  KeyFrameRequestCoordinator(Clock* clock, int64_t min_interval_ms);
+  KeyFrameRequestCoordinator(const KeyFrameRequestCoordinator&) = delete;
+  KeyFrameRequestCoordinator& operator=(const KeyFrameRequestCoordinator&) =
+      delete;
+  ~KeyFrameRequestCoordinator();
+
+  // Returns true if a key frame request for |remote_ssrc| should be sent now,
+  // and false if it is coalesced with an earlier request.
+  bool OnKeyFrameRequest(uint32_t remote_ssrc);
+
+  // Forgets the requests for |remote_ssrc|, e.g. when its stream is deleted.
+  void RemoveSsrc(uint32_t remote_ssrc);
+
+  int64_t num_coalesced_requests() const;
+
+ private:
+  Clock* const clock_;
+  const int64_t min_interval_ms_;
+
+  rtc::CriticalSection crit_;
+  // Time of the last request sent, by remote SSRC.
+  std::map<uint32_t, int64_t> last_request_ms_ RTC_GUARDED_BY(crit_);
+  int64_t num_coalesced_requests_ RTC_GUARDED_BY(crit_) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_KEYFRAME_REQUEST_COORDINATOR_H_
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/keyframe_request_coordinator.h"
+
+#include "system_wrappers/include/clock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kMinIntervalMs = 300;
+constexpr uint32_t kSsrc = 1234;
+constexpr uint32_t kOtherSsrc = 5678;
+
+TEST(KeyFrameRequestCoordinatorTest, CoalescesRequestsWithinInterval) {
+  SimulatedClock clock(1000000);
+  KeyFrameRequestCoordinator coordinator(&clock, kMinIntervalMs);
+  EXPECT_TRUE(coordinator.OnKeyFrameRequest(kSsrc));
+  clock.AdvanceTimeMilliseconds(kMinIntervalMs - 1);
+  EXPECT_FALSE(coordinator.OnKeyFrameRequest(kSsrc));
+  clock.AdvanceTimeMilliseconds(1);
+  EXPECT_TRUE(coordinator.OnKeyFrameRequest(kSsrc));
+  EXPECT_EQ(1, coordinator.num_coalesced_requests());
+}
+
+TEST(KeyFrameRequestCoordinatorTest, CoalescedRequestsDoNotExtendInterval) {
+  SimulatedClock clock(1000000);
+  KeyFrameRequestCoordinator coordinator(&clock, kMinIntervalMs);
+  EXPECT_TRUE(coordinator.OnKeyFrameRequest(kSsrc));
+  for (int i = 0; i < 2; ++i) {
+    clock.AdvanceTimeMilliseconds(kMinIntervalMs / 3);
+    EXPECT_FALSE(coordinator.OnKeyFrameRequest(kSsrc));
+  }
+  clock.AdvanceTimeMilliseconds(kMinIntervalMs - 2 * (kMinIntervalMs / 3));
+  EXPECT_TRUE(coordinator.OnKeyFrameRequest(kSsrc));
+}
+
+TEST(KeyFrameRequestCoordinatorTest, SsrcsAreIndependent) {
+  SimulatedClock clock(1000000);
+  KeyFrameRequestCoordinator coordinator(&clock, kMinIntervalMs);
+  EXPECT_TRUE(coordinator.OnKeyFrameRequest(kSsrc));
+  EXPECT_TRUE(coordinator.OnKeyFrameRequest(kOtherSsrc));
+  EXPECT_FALSE(coordinator.OnKeyFrameRequest(kSsrc));
+
+  coordinator.RemoveSsrc(kSsrc);
+  EXPECT_TRUE(coordinator.OnKeyFrameRequest(kSsrc));
+  EXPECT_FALSE(coordinator.OnKeyFrameRequest(kOtherSsrc));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -14,7 +14,7 @@
 #include <stdio.h>
 
 #include <algorithm>
-#include <list>
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
@@ -26,6 +26,7 @@
 #include "rtc_base/numerics/exp_filter.h"
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/field_trial.h"
+#include "video/process_cpu_load_estimator.h"
 
 #if defined(WEBRTC_MAC) && !defined(WEBRTC_IOS)
 #include <mach/mach.h>
@@ -66,6 +67,41 @@ const int kMaxFramerate = 30;
 
 const auto kScaleReasonCpu = AdaptationObserverInterface::AdaptReason::kCpu;
 
+// FIFO queue with room for |kCapacity| elements, that drops its oldest element
+// when full. Does not allocate after construction.
+template <typename T, size_t kCapacity>
+class RingQueue {
+ public:
+  bool empty() const { return size_ == 0; }
+  size_t size() const { return size_; }
+  T& operator[](size_t index) {
+    RTC_DCHECK_LT(index, size_);
+    return elements_[(first_ + index) % kCapacity];
+  }
+  T& front() { return (*this)[0]; }
+
+  void push_back(const T& element) {
+    if (size_ == kCapacity)
+      pop_front();
+    elements_[(first_ + size_) % kCapacity] = element;
+    ++size_;
+  }
+  void pop_front() {
+    RTC_DCHECK_GT(size_, 0);
+    first_ = (first_ + 1) % kCapacity;
+    --size_;
+  }
+  void clear() {
+    first_ = 0;
+    size_ = 0;
+  }
+
+ private:
+  std::array<T, kCapacity> elements_;
+  size_t first_ = 0;
+  size_t size_ = 0;
+};
+
 // Class for calculating the processing usage on the send-side (the average
 // processing time of a frame divided by the average time difference between
 // captured frames).
@@ -106,6 +142,8 @@ class SendProcessingUsage1 : public OveruseFrameDetector::ProcessingUsage {
     if (last_capture_time_us != -1)
       AddCaptureSample(1e-3 * (time_when_first_seen_us - last_capture_time_us));
 
+    // Without sent frames, e.g. while the encoder drops every frame, the
+    // oldest timings are dropped rather than growing the queue.
     frame_timing_.push_back(FrameTiming(frame.timestamp_us(), frame.timestamp(),
                                         time_when_first_seen_us));
   }
@@ -122,9 +160,9 @@ class SendProcessingUsage1 : public OveruseFrameDetector::ProcessingUsage {
     // samples before one second to trigger an overuse even when this is not the
     // case).
     static const int64_t kEncodingTimeMeasureWindowMs = 1000;
-    for (auto& it : frame_timing_) {
-      if (it.timestamp == timestamp) {
-        it.last_send_us = time_sent_in_us;
+    for (size_t i = 0; i < frame_timing_.size(); ++i) {
+      if (frame_timing_[i].timestamp == timestamp) {
+        frame_timing_[i].last_send_us = time_sent_in_us;
         break;
       }
     }
@@ -167,16 +205,21 @@ class SendProcessingUsage1 : public OveruseFrameDetector::ProcessingUsage {
   }
 
  private:
+  // Frames are timed until they are a second old, which covers 120 fps with
+  // margin.
+  static constexpr size_t kMaxFrameTimings = 256;
+
   struct FrameTiming {
+    FrameTiming() = default;
     FrameTiming(int64_t capture_time_us, uint32_t timestamp, int64_t now)
         : capture_time_us(capture_time_us),
           timestamp(timestamp),
           capture_us(now),
           last_send_us(-1) {}
-    int64_t capture_time_us;
-    uint32_t timestamp;
-    int64_t capture_us;
-    int64_t last_send_us;
+    int64_t capture_time_us = -1;
+    uint32_t timestamp = 0;
+    int64_t capture_us = -1;
+    int64_t last_send_us = -1;
   };
 
   void AddCaptureSample(float sample_ms) {
@@ -208,7 +251,7 @@ class SendProcessingUsage1 : public OveruseFrameDetector::ProcessingUsage {
   const float kInitialSampleDiffMs;
 
   const CpuOveruseOptions options_;
-  std::list<FrameTiming> frame_timing_;
+  RingQueue<FrameTiming, kMaxFrameTimings> frame_timing_;
   uint64_t count_;
   int64_t last_processed_capture_time_us_;
   float max_sample_diff_ms_;
@@ -531,7 +574,11 @@ OveruseFrameDetector::OveruseFrameDetector(
       num_overuse_detections_(0),
       last_rampup_time_ms_(-1),
       in_quick_rampup_(false),
-      current_rampup_delay_ms_(kStandardRampUpDelayMs) {
+      current_rampup_delay_ms_(kStandardRampUpDelayMs),
+      process_cpu_load_(
+          field_trial::IsEnabled("WebRTC-ProcessCpuLoadEstimator")
+              ? ProcessCpuLoadEstimator::GetInstance()
+              : nullptr) {
   task_checker_.Detach();
   ParseFieldTrial({&filter_time_constant_},
                   field_trial::FindFullName("WebRTC-CpuLoadEstimator"));
@@ -642,7 +689,18 @@ void OveruseFrameDetector::CheckForOveruse(
 
   int64_t now_ms = rtc::TimeMillis();
 
-  if (IsOverusing(*encode_usage_percent_)) {
+  // Adapt to whichever is higher, this stream's encode usage or the load of
+  // the whole process, so that many streams that each look cheap still adapt
+  // when together they saturate the CPU.
+  int usage_percent = *encode_usage_percent_;
+  if (process_cpu_load_) {
+    absl::optional<int> process_load_percent =
+        process_cpu_load_->LoadPercent(now_ms * rtc::kNumMicrosecsPerMillisec);
+    if (process_load_percent)
+      usage_percent = std::max(usage_percent, *process_load_percent);
+  }
+
+  if (IsOverusing(usage_percent)) {
     // If the last thing we did was going up, and now have to back down, we need
     // to check if this peak was short. If so we should back off to avoid going
     // back and forth between this load, the system doesn't seem to handle it.
@@ -666,7 +724,7 @@ void OveruseFrameDetector::CheckForOveruse(
     ++num_overuse_detections_;
 
     observer->AdaptDown(kScaleReasonCpu);
-  } else if (IsUnderusing(*encode_usage_percent_, now_ms)) {
+  } else if (IsUnderusing(usage_percent, now_ms)) {
     last_rampup_time_ms_ = now_ms;
     in_quick_rampup_ = true;
 
@@ -678,6 +736,7 @@ void OveruseFrameDetector::CheckForOveruse(
 
   RTC_LOG(LS_VERBOSE) << " Frame stats: "
                       << " encode usage " << *encode_usage_percent_
+                      << " usage " << usage_percent
                       << " overuse detections " << num_overuse_detections_
                       << " rampup delay " << rampup_delay;
 }
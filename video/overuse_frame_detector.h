@@ -11,7 +11,6 @@
 #ifndef VIDEO_OVERUSE_FRAME_DETECTOR_H_
 #define VIDEO_OVERUSE_FRAME_DETECTOR_H_
 
-#include <list>
 #include <memory>
 
 #include "absl/types/optional.h"
@@ -27,6 +26,7 @@
 
 namespace webrtc {
 
+class ProcessCpuLoadEstimator;
 class VideoFrame;
 
 struct CpuOveruseOptions {
@@ -147,6 +147,10 @@ class OveruseFrameDetector {
 
   std::unique_ptr<ProcessingUsage> usage_ RTC_PT_GUARDED_BY(task_checker_);
 
+  // Load of the whole process, consulted on each check if the field trial
+  // WebRTC-ProcessCpuLoadEstimator is enabled. Shared by all detectors.
+  ProcessCpuLoadEstimator* const process_cpu_load_;
+
   // If set by field trial, overrides CpuOveruseOptions::filter_time_ms.
   FieldTrialOptional<TimeDelta> filter_time_constant_{"tau"};
 
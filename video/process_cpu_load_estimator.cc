@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/process_cpu_load_estimator.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+namespace {
+// Weight of the previous estimate after one second.
+constexpr float kSmoothingFactorPerSecond = 0.5f;
+}  // namespace
+
+constexpr int64_t ProcessCpuLoadEstimator::kMinSampleIntervalUs;
+
+ProcessCpuLoadEstimator* ProcessCpuLoadEstimator::GetInstance() {
+  // Never destroyed, since encoder queues may outlive static destruction.
+  static ProcessCpuLoadEstimator* const instance = new ProcessCpuLoadEstimator(
+      static_cast<int>(CpuInfo::DetectNumberOfCores()),
+      &rtc::GetProcessCpuTimeNanos);
+  return instance;
+}
+
+ProcessCpuLoadEstimator::ProcessCpuLoadEstimator(int num_cores,
+                                                 int64_t (*cpu_time_ns)())
+    : num_cores_(std::max(num_cores, 1)),
+      cpu_time_ns_(cpu_time_ns),
+      load_percent_(kSmoothingFactorPerSecond) {
+  RTC_DCHECK(cpu_time_ns_);
+}
+
+ProcessCpuLoadEstimator::~ProcessCpuLoadEstimator() = default;
+
+absl::optional<int> ProcessCpuLoadEstimator::LoadPercent(int64_t now_us) {
+  rtc::CritScope lock(&crit_);
+  if (last_sample_time_us_ == -1 ||
+      now_us - last_sample_time_us_ >= kMinSampleIntervalUs) {
+    const int64_t cpu_time_ns = cpu_time_ns_();
+    if (last_sample_time_us_ != -1) {
+      const int64_t interval_us = now_us - last_sample_time_us_;
+      const int64_t cpu_time_us =
+          (cpu_time_ns - last_sample_cpu_time_ns_) /
+          rtc::kNumNanosecsPerMicrosec;
+      const float load_percent =
+          100.0f * cpu_time_us / (interval_us * num_cores_);
+      load_percent_.Apply(
+          static_cast<float>(interval_us) / rtc::kNumMicrosecsPerSec,
+          std::max(load_percent, 0.0f));
+    }
+    last_sample_time_us_ = now_us;
+    last_sample_cpu_time_ns_ = cpu_time_ns;
+  }
+  if (load_percent_.filtered() == rtc::ExpFilter::kValueUndefined)
+    return absl::nullopt;
+  return static_cast<int>(load_percent_.filtered() + 0.5f);
+}
+
+}  // namespace webrtc
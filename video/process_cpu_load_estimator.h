@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_PROCESS_CPU_LOAD_ESTIMATOR_H_
+#define VIDEO_PROCESS_CPU_LOAD_ESTIMATOR_H_
+
+#include <stdint.h>
+
+#include "absl/types/optional.h"
+#include "rtc_base/critical_section.h"
+#include "rtc_base/numerics/exp_filter.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Estimates the CPU time used by the whole process, in percent of the
+// capacity of all cores. There is no timer: the process CPU clock is read
+// when the load is asked for, at most once per sampling interval, so any
+// number of send streams can consult one estimator at the cost of one clock
+// read per interval. Thread safe.
+class ProcessCpuLoadEstimator {
+ public:
+  static constexpr int64_t kMinSampleIntervalUs = 1000000;
+
+  // The estimator shared by the process, reading rtc::GetProcessCpuTimeNanos.
+  static ProcessCpuLoadEstimator* GetInstance();
+
+  // |cpu_time_ns| returns the process CPU time, with an arbitrary base.
+  ProcessCpuLoadEstimator(int num_cores, int64_t (*cpu_time_ns)());
+  ~ProcessCpuLoadEstimator();
+
+  // Returns the smoothed load, or nullopt until a sampling interval has
+  // passed. |now_us| is the wall clock time, e.g. rtc::TimeMicros().
+  absl::optional<int> LoadPercent(int64_t now_us);
+
+ private:
+  const int num_cores_;
+  int64_t (*const cpu_time_ns_)();
+  rtc::CriticalSection crit_;
+  int64_t last_sample_time_us_ RTC_GUARDED_BY(crit_) = -1;
+  int64_t last_sample_cpu_time_ns_ RTC_GUARDED_BY(crit_) = 0;
+  rtc::ExpFilter load_percent_ RTC_GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_PROCESS_CPU_LOAD_ESTIMATOR_H_
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2019 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/process_cpu_load_estimator.h"
+
+#include "rtc_base/time_utils.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int64_t kSecondUs = rtc::kNumMicrosecsPerSec;
+constexpr int64_t kSecondNs = rtc::kNumNanosecsPerSec;
+
+int64_t g_cpu_time_ns = 0;
+int g_cpu_time_reads = 0;
+
+int64_t FakeCpuTimeNanos() {
+  ++g_cpu_time_reads;
+  return g_cpu_time_ns;
+}
+
+class ProcessCpuLoadEstimatorTest : public ::testing::Test {
+ protected:
+  ProcessCpuLoadEstimatorTest() {
+    g_cpu_time_ns = 0;
+    g_cpu_time_reads = 0;
+  }
+};
+
+TEST_F(ProcessCpuLoadEstimatorTest, NoLoadUntilFirstInterval) {
+  ProcessCpuLoadEstimator estimator(/*num_cores=*/1, &FakeCpuTimeNanos);
+  EXPECT_FALSE(estimator.LoadPercent(0));
+  g_cpu_time_ns = kSecondNs / 2;
+  EXPECT_FALSE(estimator.LoadPercent(kSecondUs / 2));
+  EXPECT_EQ(50, estimator.LoadPercent(kSecondUs));
+}
+
+TEST_F(ProcessCpuLoadEstimatorTest, LoadIsRelativeToAllCores) {
+  ProcessCpuLoadEstimator estimator(/*num_cores=*/4, &FakeCpuTimeNanos);
+  estimator.LoadPercent(0);
+  g_cpu_time_ns = 3 * kSecondNs;
+  EXPECT_EQ(75, estimator.LoadPercent(kSecondUs));
+}
+
+TEST_F(ProcessCpuLoadEstimatorTest, ReadsCpuClockOncePerInterval) {
+  ProcessCpuLoadEstimator estimator(/*num_cores=*/2, &FakeCpuTimeNanos);
+  for (int64_t time_us = 0; time_us <= 10 * kSecondUs;
+       time_us += kSecondUs / 50) {
+    g_cpu_time_ns = time_us * rtc::kNumNanosecsPerMicrosec;
+    estimator.LoadPercent(time_us);
+  }
+  EXPECT_EQ(11, g_cpu_time_reads);
+  EXPECT_EQ(50, estimator.LoadPercent(10 * kSecondUs));
+}
+
+TEST_F(ProcessCpuLoadEstimatorTest, SmoothsLoadOverIntervals) {
+  ProcessCpuLoadEstimator estimator(/*num_cores=*/1, &FakeCpuTimeNanos);
+  estimator.LoadPercent(0);
+  g_cpu_time_ns = kSecondNs;
+  EXPECT_EQ(100, estimator.LoadPercent(kSecondUs));
+  // An idle second halves the estimate.
+  EXPECT_EQ(50, estimator.LoadPercent(2 * kSecondUs));
+  // A long idle period brings it close to zero.
+  EXPECT_GE(1, *estimator.LoadPercent(12 * kSecondUs));
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -21,6 +21,7 @@
 #include "rtc_base/time_utils.h"
 #include "system_wrappers/include/clock.h"
 #include "system_wrappers/include/metrics.h"
+#include "system_wrappers/include/ntp_time.h"
 
 namespace webrtc {
 namespace {
@@ -741,12 +742,30 @@ void ReceiveStatisticsProxy::OnRenderedFrame(const VideoFrame& frame) {
     ++num_delayed_frames_rendered_;
   }
 
+  const int64_t now_ntp_ms = clock_->CurrentNtpInMilliseconds();
   if (frame.ntp_time_ms() > 0) {
-    int64_t delay_ms = clock_->CurrentNtpInMilliseconds() - frame.ntp_time_ms();
+    int64_t delay_ms = now_ntp_ms - frame.ntp_time_ms();
     if (delay_ms >= 0) {
       content_specific_stats->e2e_delay_counter.Add(delay_ms);
     }
   }
+
+  absl::optional<int64_t> capture_time_ntp_ms;
+  for (const RtpPacketInfo& packet_info : frame.packet_infos()) {
+    if (packet_info.absolute_capture_time()) {
+      capture_time_ntp_ms = UQ32x32ToInt64Ms(
+          packet_info.absolute_capture_time()->absolute_capture_timestamp);
+      break;
+    }
+  }
+  if (!capture_time_ntp_ms && frame.ntp_time_ms() > 0)
+    capture_time_ntp_ms = frame.ntp_time_ms();
+  if (capture_time_ntp_ms && now_ntp_ms >= *capture_time_ntp_ms) {
+    const int64_t delay_ms = now_ntp_ms - *capture_time_ntp_ms;
+    stats_.capture_to_render_delay_ms = delay_ms;
+    stats_.total_capture_to_render_delay_ms += delay_ms;
+    ++stats_.capture_to_render_delay_count;
+  }
   QualitySample();
 }
 
@@ -16,12 +16,14 @@
 #include <tuple>
 #include <utility>
 
+#include "api/rtp_packet_infos.h"
 #include "api/scoped_refptr.h"
 #include "api/video/i420_buffer.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_frame_buffer.h"
 #include "api/video/video_rotation.h"
 #include "system_wrappers/include/metrics.h"
+#include "system_wrappers/include/ntp_time.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -372,6 +374,33 @@ TEST_F(ReceiveStatisticsProxyTest, OnRenderedFrameIncreasesFramesRendered) {
   }
 }
 
+TEST_F(ReceiveStatisticsProxyTest, ReportsCaptureToRenderDelay) {
+  const int64_t kRtcpDelayMs = 30;
+  const int64_t kAbsoluteCaptureDelayMs = 50;
+  EXPECT_FALSE(statistics_proxy_->GetStats().capture_to_render_delay_ms);
+
+  // Without absolute capture time, the RTCP based capture time is used.
+  webrtc::VideoFrame frame = CreateFrame(kWidth, kHeight);
+  fake_clock_.AdvanceTimeMilliseconds(kRtcpDelayMs);
+  statistics_proxy_->OnRenderedFrame(frame);
+  VideoReceiveStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(kRtcpDelayMs, stats.capture_to_render_delay_ms);
+
+  // The absolute capture time takes precedence.
+  AbsoluteCaptureTime capture_time;
+  capture_time.absolute_capture_timestamp = Int64MsToUQ32x32(
+      fake_clock_.CurrentNtpInMilliseconds() - kAbsoluteCaptureDelayMs);
+  frame = CreateFrame(kWidth, kHeight);
+  frame.set_packet_infos(RtpPacketInfos(
+      {RtpPacketInfo(kRemoteSsrc, {}, 0, absl::nullopt, capture_time, 0)}));
+  statistics_proxy_->OnRenderedFrame(frame);
+  stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(kAbsoluteCaptureDelayMs, stats.capture_to_render_delay_ms);
+  EXPECT_EQ(static_cast<uint64_t>(kRtcpDelayMs + kAbsoluteCaptureDelayMs),
+            stats.total_capture_to_render_delay_ms);
+  EXPECT_EQ(2u, stats.capture_to_render_delay_count);
+}
+
 TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsSsrc) {
   EXPECT_EQ(kRemoteSsrc, statistics_proxy_->GetStats().ssrc);
 }
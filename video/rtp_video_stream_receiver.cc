@@ -187,6 +187,7 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
     ProcessThread* process_thread,
     NackSender* nack_sender,
     KeyFrameRequestSender* keyframe_request_sender,
+    KeyFrameRequestCoordinator* keyframe_request_coordinator,
     video_coding::OnCompleteFrameCallback* complete_frame_callback,
     rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor)
     : clock_(clock),
@@ -209,6 +210,7 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
                                     config_.rtp.local_ssrc)),
       complete_frame_callback_(complete_frame_callback),
       keyframe_request_sender_(keyframe_request_sender),
+      keyframe_request_coordinator_(keyframe_request_coordinator),
       // TODO(bugs.webrtc.org/10336): Let |rtcp_feedback_buffer_| communicate
       // directly with |rtp_rtcp_|.
       rtcp_feedback_buffer_(this, nack_sender, this),
@@ -218,6 +220,7 @@ RtpVideoStreamReceiver::RtpVideoStreamReceiver(
                      this),
       has_received_frame_(false),
       frames_decryptable_(false) {
+  packet_sequence_checker_.Detach();
   constexpr bool remb_candidate = true;
   if (packet_router_)
     packet_router_->AddReceiveRtpModule(rtp_rtcp_.get(), remb_candidate);
@@ -290,6 +293,8 @@ RtpVideoStreamReceiver::~RtpVideoStreamReceiver() {
 
   if (packet_router_)
     packet_router_->RemoveReceiveRtpModule(rtp_rtcp_.get());
+  if (keyframe_request_coordinator_)
+    keyframe_request_coordinator_->RemoveSsrc(config_.rtp.remote_ssrc);
   UpdateHistograms();
 }
 
@@ -332,6 +337,19 @@ int32_t RtpVideoStreamReceiver::OnReceivedPayloadData(
     const RTPVideoHeader& video_header,
     const absl::optional<RtpGenericFrameDescriptor>& generic_descriptor,
     bool is_recovered) {
+  return InsertPayloadData(payload_data, payload_size, rtc::CopyOnWriteBuffer(),
+                           rtp_header, video_header, generic_descriptor,
+                           is_recovered);
+}
+
+int32_t RtpVideoStreamReceiver::InsertPayloadData(
+    const uint8_t* payload_data,
+    size_t payload_size,
+    const rtc::CopyOnWriteBuffer& packet_buffer,
+    const RTPHeader& rtp_header,
+    const RTPVideoHeader& video_header,
+    const absl::optional<RtpGenericFrameDescriptor>& generic_descriptor,
+    bool is_recovered) {
   VCMPacket packet(payload_data, payload_size, rtp_header, video_header,
                    ntp_estimator_.Estimate(rtp_header.timestamp),
                    clock_->TimeInMilliseconds());
@@ -388,6 +406,13 @@ int32_t RtpVideoStreamReceiver::OnReceivedPayloadData(
         break;
     }
 
+  } else if (packet_buffer.size() > 0 &&
+             packet.dataPtr >= packet_buffer.cdata() &&
+             packet.dataPtr + packet.sizeBytes <=
+                 packet_buffer.cdata() + packet_buffer.size()) {
+    // The payload is a view into the received RTP packet; share the buffer
+    // with the packet buffer instead of copying the payload out of it.
+    packet.payload_buffer = packet_buffer;
   } else {
     uint8_t* data = new uint8_t[packet.sizeBytes];
     memcpy(data, packet.dataPtr, packet.sizeBytes);
@@ -425,7 +450,7 @@ void RtpVideoStreamReceiver::OnRecoveredPacket(const uint8_t* rtp_packet,
 // This method handles both regular RTP packets and packets recovered
 // via FlexFEC.
 void RtpVideoStreamReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
-  RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
 
   if (!receiving_) {
     return;
@@ -469,6 +494,7 @@ void RtpVideoStreamReceiver::OnRtpPacket(const RtpPacketReceived& packet) {
     rtp_receive_statistics_->OnRtpPacket(packet);
   }
 
+  rtc::CritScope cs(&secondary_sinks_lock_);
   for (RtpPacketSinkInterface* secondary_sink : secondary_sinks_) {
     secondary_sink->OnRtpPacket(packet);
   }
@@ -478,6 +504,11 @@ void RtpVideoStreamReceiver::RequestKeyFrame() {
   // TODO(bugs.webrtc.org/10336): Allow the sender to ignore key frame requests
   // issued by anything other than the LossNotificationController if it (the
   // sender) is relying on LNTF alone.
+  if (keyframe_request_coordinator_ &&
+      !keyframe_request_coordinator_->OnKeyFrameRequest(
+          config_.rtp.remote_ssrc)) {
+    return;
+  }
   if (keyframe_request_sender_) {
     keyframe_request_sender_->RequestKeyFrame();
   } else {
@@ -632,6 +663,7 @@ absl::optional<int64_t> RtpVideoStreamReceiver::LastReceivedKeyframePacketMs()
 
 void RtpVideoStreamReceiver::AddSecondarySink(RtpPacketSinkInterface* sink) {
   RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  rtc::CritScope cs(&secondary_sinks_lock_);
   RTC_DCHECK(!absl::c_linear_search(secondary_sinks_, sink));
   secondary_sinks_.push_back(sink);
 }
@@ -639,6 +671,7 @@ void RtpVideoStreamReceiver::AddSecondarySink(RtpPacketSinkInterface* sink) {
 void RtpVideoStreamReceiver::RemoveSecondarySink(
     const RtpPacketSinkInterface* sink) {
   RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  rtc::CritScope cs(&secondary_sinks_lock_);
   auto it = absl::c_find(secondary_sinks_, sink);
   if (it == secondary_sinks_.end()) {
     // We might be rolling-back a call whose setup failed mid-way. In such a
@@ -759,14 +792,14 @@ void RtpVideoStreamReceiver::ReceivePacket(const RtpPacketReceived& packet) {
     generic_descriptor_wire.reset();
   }
 
-  OnReceivedPayloadData(parsed_payload.payload, parsed_payload.payload_length,
-                        rtp_header, video_header, generic_descriptor_wire,
-                        packet.recovered());
+  InsertPayloadData(parsed_payload.payload, parsed_payload.payload_length,
+                    packet.Buffer(), rtp_header, video_header,
+                    generic_descriptor_wire, packet.recovered());
 }
 
 void RtpVideoStreamReceiver::ParseAndHandleEncapsulatingHeader(
     const RtpPacketReceived& packet) {
-  RTC_DCHECK_RUN_ON(&worker_task_checker_);
+  RTC_DCHECK_RUN_ON(&packet_sequence_checker_);
   if (packet.PayloadType() == config_.rtp.red_payload_type &&
       packet.payload_size() > 0) {
     if (packet.payload()[0] == config_.rtp.ulpfec_payload_type) {
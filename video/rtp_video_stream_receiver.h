@@ -35,12 +35,14 @@
 #include "modules/video_coding/packet_buffer.h"
 #include "modules/video_coding/rtp_frame_reference_finder.h"
 #include "rtc_base/constructor_magic.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/critical_section.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/thread_annotations.h"
 #include "rtc_base/thread_checker.h"
 #include "video/buffered_frame_decryptor.h"
+#include "video/keyframe_request_coordinator.h"
 
 namespace webrtc {
 
@@ -79,6 +81,9 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
       // The KeyFrameRequestSender is optional; if not provided, key frame
       // requests are sent via the internal RtpRtcp module.
       KeyFrameRequestSender* keyframe_request_sender,
+      // The KeyFrameRequestCoordinator is optional; if provided, key frame
+      // requests it coalesces with requests of other streams aren't sent.
+      KeyFrameRequestCoordinator* keyframe_request_coordinator,
       video_coding::OnCompleteFrameCallback* complete_frame_callback,
       rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor);
   ~RtpVideoStreamReceiver() override;
@@ -240,6 +245,17 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   // Entry point doing non-stats work for a received packet. Called
   // for the same packet both before and after RED decapsulation.
   void ReceivePacket(const RtpPacketReceived& packet);
+  // Same as OnReceivedPayloadData(), but if |payload_data| points into
+  // |packet_buffer|, the payload is stored by reference to that buffer instead
+  // of being copied.
+  int32_t InsertPayloadData(
+      const uint8_t* payload_data,
+      size_t payload_size,
+      const rtc::CopyOnWriteBuffer& packet_buffer,
+      const RTPHeader& rtp_header,
+      const RTPVideoHeader& video_header,
+      const absl::optional<RtpGenericFrameDescriptor>& generic_descriptor,
+      bool is_recovered);
   // Parses and handles RED headers.
   // This function assumes that it's being called from only one thread.
   void ParseAndHandleEncapsulatingHeader(const RtpPacketReceived& packet);
@@ -261,13 +277,18 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
   std::unique_ptr<UlpfecReceiver> ulpfec_receiver_;
 
   SequenceChecker worker_task_checker_;
-  bool receiving_ RTC_GUARDED_BY(worker_task_checker_);
-  int64_t last_packet_log_ms_ RTC_GUARDED_BY(worker_task_checker_);
+  // Packets are delivered on this sequence. That is the worker thread, unless
+  // the RtpStreamReceiverController delivers packets on its own task queues.
+  SequenceChecker packet_sequence_checker_;
+  // Set on the worker thread, read when packets are delivered.
+  std::atomic<bool> receiving_;
+  int64_t last_packet_log_ms_ RTC_GUARDED_BY(packet_sequence_checker_);
 
   const std::unique_ptr<RtpRtcp> rtp_rtcp_;
 
   video_coding::OnCompleteFrameCallback* complete_frame_callback_;
   KeyFrameRequestSender* const keyframe_request_sender_;
+  KeyFrameRequestCoordinator* const keyframe_request_coordinator_;
 
   RtcpFeedbackBuffer rtcp_feedback_buffer_;
   std::unique_ptr<NackModule> nack_module_;
@@ -297,8 +318,9 @@ class RtpVideoStreamReceiver : public LossNotificationSender,
 
   bool has_received_frame_;
 
+  rtc::CriticalSection secondary_sinks_lock_;
   std::vector<RtpPacketSinkInterface*> secondary_sinks_
-      RTC_GUARDED_BY(worker_task_checker_);
+      RTC_GUARDED_BY(secondary_sinks_lock_);
 
   // Info for GetSyncInfo is updated on network or worker thread, and queried on
   // the worker thread.
@@ -42,6 +42,7 @@
 #include "rtc_base/experiments/keyframe_interval_settings.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/allocation_tracker.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/thread_registry.h"
 #include "rtc_base/time_utils.h"
@@ -170,6 +171,8 @@ namespace internal {
 
 VideoReceiveStream::VideoReceiveStream(
     TaskQueueFactory* task_queue_factory,
+    DecodeThreadPool* decode_thread_pool,
+    KeyFrameRequestCoordinator* keyframe_request_coordinator,
     RtpStreamReceiverControllerInterface* receiver_controller,
     int num_cpu_cores,
     PacketRouter* packet_router,
@@ -179,6 +182,7 @@ VideoReceiveStream::VideoReceiveStream(
     Clock* clock,
     VCMTiming* timing)
     : task_queue_factory_(task_queue_factory),
+      decode_thread_pool_(decode_thread_pool),
       transport_adapter_(config.rtcp_send_transport),
       config_(std::move(config)),
       num_cpu_cores_(num_cpu_cores),
@@ -200,6 +204,7 @@ VideoReceiveStream::VideoReceiveStream(
                                  process_thread_,
                                  this,     // NackSender
                                  nullptr,  // Use default KeyFrameRequestSender
+                                 keyframe_request_coordinator,
                                  this,     // OnCompleteFrameCallback
                                  config_.frame_decryptor),
       rtp_stream_sync_(this),
@@ -209,9 +214,11 @@ VideoReceiveStream::VideoReceiveStream(
       max_wait_for_frame_ms_(KeyframeIntervalSettings::ParseFromFieldTrials()
                                  .MaxWaitForFrameMs()
                                  .value_or(kMaxWaitForFrameMs)),
-      decode_queue_(task_queue_factory_->CreateTaskQueue(
-          "DecodingQueue",
-          TaskQueueFactory::Priority::HIGH)) {
+      decode_queue_(decode_thread_pool_
+                        ? decode_thread_pool_->CreateTaskQueue("DecodingQueue")
+                        : task_queue_factory_->CreateTaskQueue(
+                              "DecodingQueue",
+                              TaskQueueFactory::Priority::HIGH)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream: " << config_.ToString();
 
   RTC_DCHECK(config_.renderer);
@@ -232,6 +239,11 @@ VideoReceiveStream::VideoReceiveStream(
     decoder_payload_types.insert(decoder.payload_type);
   }
 
+  if (config_.low_latency_rendering) {
+    timing_->set_min_playout_delay(0);
+    timing_->set_max_playout_delay(0);
+  }
+
   timing_->set_render_delay(config_.render_delay_ms);
 
   frame_buffer_.reset(
@@ -249,8 +261,9 @@ VideoReceiveStream::VideoReceiveStream(
       rtx_receive_stream_ = std::make_unique<RtxReceiveStream>(
           &rtp_video_stream_receiver_, config.rtp.rtx_associated_payload_types,
           config_.rtp.remote_ssrc, rtp_receive_statistics_.get());
-      rtx_receiver_ = receiver_controller->CreateReceiver(
-          config_.rtp.rtx_ssrc, rtx_receive_stream_.get());
+      rtx_receiver_ = receiver_controller->CreateAssociatedReceiver(
+          config_.rtp.rtx_ssrc, config_.rtp.remote_ssrc,
+          rtx_receive_stream_.get());
     } else {
       rtp_receive_statistics_->EnableRetransmitDetection(config.rtp.remote_ssrc,
                                                          true);
@@ -260,6 +273,8 @@ VideoReceiveStream::VideoReceiveStream(
 
 VideoReceiveStream::VideoReceiveStream(
     TaskQueueFactory* task_queue_factory,
+    DecodeThreadPool* decode_thread_pool,
+    KeyFrameRequestCoordinator* keyframe_request_coordinator,
     RtpStreamReceiverControllerInterface* receiver_controller,
     int num_cpu_cores,
     PacketRouter* packet_router,
@@ -268,6 +283,8 @@ VideoReceiveStream::VideoReceiveStream(
     CallStats* call_stats,
     Clock* clock)
     : VideoReceiveStream(task_queue_factory,
+                         decode_thread_pool,
+                         keyframe_request_coordinator,
                          receiver_controller,
                          num_cpu_cores,
                          packet_router,
@@ -321,7 +338,7 @@ void VideoReceiveStream::Start() {
 
   transport_adapter_.Enable();
   rtc::VideoSinkInterface<VideoFrame>* renderer = nullptr;
-  if (config_.enable_prerenderer_smoothing) {
+  if (config_.enable_prerenderer_smoothing && !config_.low_latency_rendering) {
     incoming_video_stream_.reset(new IncomingVideoStream(
         task_queue_factory_, config_.render_delay_ms, this));
     renderer = incoming_video_stream_.get();
@@ -502,6 +519,7 @@ int VideoReceiveStream::GetBaseMinimumPlayoutDelayMs() const {
 
 // TODO(tommi): This method grabs a lock 6 times.
 void VideoReceiveStream::OnFrame(const VideoFrame& video_frame) {
+  RTC_ALLOCATION_TRACKER_ADD_FRAMES(1);
   int64_t sync_offset_ms;
   double estimated_freq_khz;
   // TODO(tommi): GetStreamSyncOffsetInMs grabs three locks.  One inside the
@@ -527,6 +545,19 @@ void VideoReceiveStream::SetFrameDecryptor(
   rtp_video_stream_receiver_.SetFrameDecryptor(std::move(frame_decryptor));
 }
 
+void VideoReceiveStream::SetDecodePrioritized(bool prioritized) {
+  RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
+  if (decode_thread_pool_)
+    decode_thread_pool_->SetPrioritized(decode_queue_.Get(), prioritized);
+}
+
+void VideoReceiveStream::GenerateKeyFrame() {
+  decode_queue_.PostTask([this] {
+    RTC_DCHECK_RUN_ON(&decode_queue_);
+    RequestKeyFrame();
+  });
+}
+
 void VideoReceiveStream::SendNack(const std::vector<uint16_t>& sequence_numbers,
                                   bool buffering_allowed) {
   RTC_DCHECK(buffering_allowed);
@@ -655,7 +686,16 @@ void VideoReceiveStream::HandleEncodedFrame(
   }
   stats_proxy_.OnPreDecode(frame->CodecSpecific()->codecType, qp);
 
-  int decode_result = video_receiver_.Decode(frame.get());
+  if (config_.encoded_frame_sink) {
+    config_.encoded_frame_sink->OnEncodedFrame(frame->EncodedImage(),
+                                               *frame->CodecSpecific());
+  }
+
+  // A frame that is only forwarded counts as decoded, so that the frame
+  // buffer and the key frame requests behave as for a decoded stream.
+  int decode_result = config_.decode_frames
+                          ? video_receiver_.Decode(frame.get())
+                          : WEBRTC_VIDEO_CODEC_OK;
   if (decode_result == WEBRTC_VIDEO_CODEC_OK ||
       decode_result == WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME) {
     keyframe_required_ = false;
@@ -703,6 +743,10 @@ void VideoReceiveStream::HandleFrameBufferTimeout() {
 }
 
 void VideoReceiveStream::UpdatePlayoutDelays() const {
+  // A zero playout delay makes the frames render as soon as they are decoded.
+  if (config_.low_latency_rendering)
+    return;
+
   const int minimum_delay_ms =
       std::max({frame_minimum_playout_delay_ms_, base_minimum_playout_delay_ms_,
                 syncable_minimum_playout_delay_ms_});
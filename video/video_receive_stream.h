@@ -26,6 +26,8 @@
 #include "rtc_base/synchronization/sequence_checker.h"
 #include "rtc_base/task_queue.h"
 #include "system_wrappers/include/clock.h"
+#include "video/decode_thread_pool.h"
+#include "video/keyframe_request_coordinator.h"
 #include "video/receive_statistics_proxy.h"
 #include "video/rtp_streams_synchronizer.h"
 #include "video/rtp_video_stream_receiver.h"
@@ -53,7 +55,12 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                            public MediaTransportVideoSinkInterface,
                            public MediaTransportRttObserver {
  public:
+  // If |decode_thread_pool| is null, the stream decodes on a task queue of
+  // its own. If |keyframe_request_coordinator| is null, every key frame
+  // request is sent.
   VideoReceiveStream(TaskQueueFactory* task_queue_factory,
+                     DecodeThreadPool* decode_thread_pool,
+                     KeyFrameRequestCoordinator* keyframe_request_coordinator,
                      RtpStreamReceiverControllerInterface* receiver_controller,
                      int num_cpu_cores,
                      PacketRouter* packet_router,
@@ -63,6 +70,8 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                      Clock* clock,
                      VCMTiming* timing);
   VideoReceiveStream(TaskQueueFactory* task_queue_factory,
+                     DecodeThreadPool* decode_thread_pool,
+                     KeyFrameRequestCoordinator* keyframe_request_coordinator,
                      RtpStreamReceiverControllerInterface* receiver_controller,
                      int num_cpu_cores,
                      PacketRouter* packet_router,
@@ -97,6 +106,9 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   void SetFrameDecryptor(
       rtc::scoped_refptr<FrameDecryptorInterface> frame_decryptor) override;
 
+  void SetDecodePrioritized(bool prioritized) override;
+  void GenerateKeyFrame() override;
+
   // Implements rtc::VideoSinkInterface<VideoFrame>.
   void OnFrame(const VideoFrame& video_frame) override;
 
@@ -148,6 +160,7 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   SequenceChecker network_sequence_checker_;
 
   TaskQueueFactory* const task_queue_factory_;
+  DecodeThreadPool* const decode_thread_pool_;
 
   TransportAdapter transport_adapter_;
   const VideoReceiveStream::Config config_;
@@ -72,6 +72,8 @@ class FrameObjectFake : public video_coding::EncodedFrame {
  public:
   void SetPayloadType(uint8_t payload_type) { _payloadType = payload_type; }
 
+  void SetFrameType(VideoFrameType frame_type) { _frameType = frame_type; }
+
   void SetRotation(const VideoRotation& rotation) { rotation_ = rotation; }
 
   void SetNtpTime(int64_t ntp_time_ms) { ntp_time_ms_ = ntp_time_ms; }
@@ -81,6 +83,13 @@ class FrameObjectFake : public video_coding::EncodedFrame {
   int64_t RenderTime() const override { return _renderTimeMs; }
 };
 
+class MockEncodedFrameSink : public VideoReceiveStream::EncodedFrameSink {
+ public:
+  MOCK_METHOD2(OnEncodedFrame,
+               void(const EncodedImage& encoded_image,
+                    const CodecSpecificInfo& codec_specific_info));
+};
+
 }  // namespace
 
 class VideoReceiveStreamTest : public ::testing::Test {
@@ -116,9 +125,11 @@ class VideoReceiveStreamTest : public ::testing::Test {
 
     video_receive_stream_ =
         std::make_unique<webrtc::internal::VideoReceiveStream>(
-            task_queue_factory_.get(), &rtp_stream_receiver_controller_,
-            kDefaultNumCpuCores, &packet_router_, config_.Copy(),
-            process_thread_.get(), &call_stats_, clock_, timing_);
+            task_queue_factory_.get(), /*decode_thread_pool=*/nullptr,
+            /*keyframe_request_coordinator=*/nullptr,
+            &rtp_stream_receiver_controller_, kDefaultNumCpuCores,
+            &packet_router_, config_.Copy(), process_thread_.get(),
+            &call_stats_, clock_, timing_);
   }
 
  protected:
@@ -228,6 +239,37 @@ TEST_F(VideoReceiveStreamTest, PlayoutDelayPreservesDefaultMinValue) {
   EXPECT_EQ(default_min_playout_latency, timing_->min_playout_delay());
 }
 
+TEST_F(VideoReceiveStreamTest, ForwardsEncodedFramesWithoutDecoding) {
+  constexpr int kDefaultNumCpuCores = 2;
+  MockEncodedFrameSink encoded_frame_sink;
+  config_.encoded_frame_sink = &encoded_frame_sink;
+  config_.decode_frames = false;
+  video_receive_stream_ =
+      std::make_unique<webrtc::internal::VideoReceiveStream>(
+          task_queue_factory_.get(), /*decode_thread_pool=*/nullptr,
+          /*keyframe_request_coordinator=*/nullptr,
+          &rtp_stream_receiver_controller_, kDefaultNumCpuCores,
+          &packet_router_, config_.Copy(), process_thread_.get(), &call_stats_,
+          clock_, new VCMTiming(clock_));
+
+  rtc::Event forwarded_event;
+  EXPECT_CALL(encoded_frame_sink, OnEncodedFrame(_, _))
+      .WillOnce(Invoke([&forwarded_event](const EncodedImage&,
+                                          const CodecSpecificInfo&) {
+        forwarded_event.Set();
+      }));
+  EXPECT_CALL(mock_h264_video_decoder_, Decode(_, _, _)).Times(0);
+  video_receive_stream_->Start();
+
+  auto test_frame = std::make_unique<FrameObjectFake>();
+  test_frame->SetPayloadType(99);
+  test_frame->SetFrameType(VideoFrameType::kVideoFrameKey);
+  test_frame->id.picture_id = 0;
+  video_receive_stream_->OnCompleteFrame(std::move(test_frame));
+  EXPECT_TRUE(forwarded_event.Wait(kDefaultTimeOutMs));
+  video_receive_stream_->Stop();
+}
+
 class VideoReceiveStreamTestWithFakeDecoder : public ::testing::Test {
  public:
   VideoReceiveStreamTestWithFakeDecoder()
@@ -252,9 +294,10 @@ class VideoReceiveStreamTestWithFakeDecoder : public ::testing::Test {
     timing_ = new VCMTiming(clock_);
 
     video_receive_stream_.reset(new webrtc::internal::VideoReceiveStream(
-        task_queue_factory_.get(), &rtp_stream_receiver_controller_,
-        kDefaultNumCpuCores, &packet_router_, config_.Copy(),
-        process_thread_.get(), &call_stats_, clock_, timing_));
+        task_queue_factory_.get(), /*decode_thread_pool=*/nullptr,
+        /*keyframe_request_coordinator=*/nullptr,
+        &rtp_stream_receiver_controller_, kDefaultNumCpuCores, &packet_router_,
+        config_.Copy(), process_thread_.get(), &call_stats_, clock_, timing_));
   }
 
  protected:
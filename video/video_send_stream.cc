@@ -183,7 +183,19 @@ VideoSendStream::Stats VideoSendStream::GetStats() {
   // TODO(perkj, solenberg): Some test cases in EndToEndTest call GetStats from
   // a network thread. See comment in Call::GetStats().
   // RTC_DCHECK_RUN_ON(&thread_checker_);
-  return stats_proxy_.GetStats();
+  Stats stats = stats_proxy_.GetStats();
+  if (send_stream_) {
+    RtpPacketHistoryStats history_stats = send_stream_->GetPacketHistoryStats();
+    stats.rtp_packet_history_bytes = history_stats.stored_bytes;
+    stats.rtp_packet_history_max_packets = history_stats.max_packets;
+  }
+  return stats;
+}
+
+void VideoSendStream::SendEncodedFrame(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info) {
+  send_stream_->SendEncodedFrame(encoded_image, codec_specific_info);
 }
 
 absl::optional<float> VideoSendStream::GetPacingFactorOverride() const {
@@ -84,6 +84,8 @@ class VideoSendStream : public webrtc::VideoSendStream {
 
   void ReconfigureVideoEncoder(VideoEncoderConfig) override;
   Stats GetStats() override;
+  void SendEncodedFrame(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo& codec_specific_info) override;
 
   void StopPermanentlyAndGetRtpStates(RtpStateMap* rtp_state_map,
                                       RtpPayloadStateMap* payload_state_map);
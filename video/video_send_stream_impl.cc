@@ -23,6 +23,7 @@
 #include "api/video_codecs/video_codec.h"
 #include "call/rtp_transport_controller_send_interface.h"
 #include "call/video_send_stream.h"
+#include "common_video/h264/h264_common.h"
 #include "modules/pacing/paced_sender.h"
 #include "rtc_base/atomic_ops.h"
 #include "rtc_base/checks.h"
@@ -277,6 +278,8 @@ VideoSendStreamImpl::VideoSendStreamImpl(
   weak_ptr_ = weak_ptr_factory_.GetWeakPtr();
 
   encoder_feedback_.SetRtpVideoSender(rtp_video_sender_);
+  encoder_feedback_.SetKeyFrameRequestObserver(
+      config_->key_frame_request_observer);
 
   if (media_transport_) {
     // The configured ssrc is interpreted as a channel id, so there must be
@@ -676,6 +679,26 @@ EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
   return result;
 }
 
+void VideoSendStreamImpl::SendEncodedFrame(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo& codec_specific_info) {
+  if (codec_specific_info.codecType != kVideoCodecH264) {
+    OnEncodedImage(encoded_image, &codec_specific_info, nullptr);
+    return;
+  }
+  // The H264 packetizer needs the NAL unit boundaries, which the encoder
+  // would have provided. Received frames are in Annex B format.
+  const std::vector<H264::NaluIndex> nalus =
+      H264::FindNaluIndices(encoded_image.data(), encoded_image.size());
+  RTPFragmentationHeader fragmentation;
+  fragmentation.VerifyAndAllocateFragmentationHeader(nalus.size());
+  for (size_t i = 0; i < nalus.size(); ++i) {
+    fragmentation.fragmentationOffset[i] = nalus[i].payload_start_offset;
+    fragmentation.fragmentationLength[i] = nalus[i].payload_size;
+  }
+  OnEncodedImage(encoded_image, &codec_specific_info, &fragmentation);
+}
+
 std::map<uint32_t, RtpState> VideoSendStreamImpl::GetRtpStates() const {
   return rtp_video_sender_->GetRtpStates();
 }
@@ -685,6 +708,10 @@ std::map<uint32_t, RtpPayloadState> VideoSendStreamImpl::GetRtpPayloadStates()
   return rtp_video_sender_->GetRtpPayloadStates();
 }
 
+RtpPacketHistoryStats VideoSendStreamImpl::GetPacketHistoryStats() const {
+  return rtp_video_sender_->GetPacketHistoryStats();
+}
+
 uint32_t VideoSendStreamImpl::OnBitrateUpdated(BitrateAllocationUpdate update) {
   RTC_DCHECK_RUN_ON(worker_queue_);
   RTC_DCHECK(rtp_video_sender_->IsActive())
@@ -109,6 +109,13 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
 
   std::map<uint32_t, RtpPayloadState> GetRtpPayloadStates() const;
 
+  RtpPacketHistoryStats GetPacketHistoryStats() const;
+
+  // Sends a frame that was not produced by the encoder, see
+  // webrtc::VideoSendStream::SendEncodedFrame().
+  void SendEncodedFrame(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo& codec_specific_info);
+
   absl::optional<float> configured_pacing_factor_;
 
  private:
@@ -74,6 +74,7 @@ class MockRtpVideoSender : public RtpVideoSenderInterface {
                      std::vector<RtpSequenceNumberMap::Info>(
                          uint32_t ssrc,
                          rtc::ArrayView<const uint16_t> sequence_numbers));
+  MOCK_CONST_METHOD0(GetPacketHistoryStats, RtpPacketHistoryStats());
 
   MOCK_METHOD1(SetFecAllowed, void(bool fec_allowed));
 };
@@ -20,6 +20,7 @@
 #include "absl/algorithm/container.h"
 #include "api/video/encoded_image.h"
 #include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
 #include "api/video/video_bitrate_allocator_factory.h"
 #include "api/video/video_codec_constants.h"
 #include "api/video_codecs/video_encoder.h"
@@ -33,6 +34,7 @@
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/location.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/memory/allocation_tracker.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/system/fallthrough.h"
 #include "rtc_base/time_utils.h"
@@ -52,6 +54,8 @@ const int64_t kPendingFrameTimeoutMs = 1000;
 
 const char kInitialFramedropFieldTrial[] = "WebRTC-InitialFramedrop";
 constexpr char kFrameDropperFieldTrial[] = "WebRTC-FrameDropper";
+constexpr char kPredictiveFrameDropFieldTrial[] =
+    "WebRTC-PredictiveFrameDrop";
 
 // The maximum number of frames to drop at beginning of stream
 // to try and achieve desired bitrate.
@@ -520,6 +524,9 @@ VideoStreamEncoder::VideoStreamEncoder(
       force_disable_frame_dropper_(false),
       input_framerate_(kFrameRateAvergingWindowSizeMs, 1000),
       pending_frame_drops_(0),
+      predictive_frame_drop_enabled_(
+          !field_trial::IsDisabled(kPredictiveFrameDropFieldTrial)),
+      drop_next_captured_frame_(false),
       next_frame_types_(1, VideoFrameType::kVideoFrameDelta),
       frame_encode_metadata_writer_(this),
       experiment_groups_(GetExperimentGroups()),
@@ -872,6 +879,7 @@ void VideoStreamEncoder::ReconfigureEncoder() {
     }
 
     frame_encode_metadata_writer_.Reset();
+    frames_in_flight_.Reset();
     last_encode_info_ms_ = absl::nullopt;
     was_encode_called_since_last_initialization_ = false;
   }
@@ -927,7 +935,8 @@ void VideoStreamEncoder::ReconfigureEncoder() {
 
   VideoEncoder::EncoderInfo info = encoder_->GetEncoderInfo();
   if (rate_control_settings_.UseEncoderBitrateAdjuster()) {
-    bitrate_adjuster_ = std::make_unique<EncoderBitrateAdjuster>(codec);
+    bitrate_adjuster_ = std::make_unique<EncoderBitrateAdjuster>(
+        codec, &encoder_utilization_history_);
     bitrate_adjuster_->OnEncoderInfo(info);
   }
 
@@ -1013,6 +1022,7 @@ void VideoStreamEncoder::ConfigureQualityScaler(
 
 void VideoStreamEncoder::OnFrame(const VideoFrame& video_frame) {
   RTC_DCHECK_RUNS_SERIALIZED(&incoming_frame_race_checker_);
+  RTC_ALLOCATION_TRACKER_ADD_FRAMES(1);
   VideoFrame incoming_frame = video_frame;
 
   // Local time in webrtc time base.
@@ -1102,6 +1112,34 @@ void VideoStreamEncoder::OnDiscardedFrame() {
       VideoStreamEncoderObserver::DropReason::kSource);
 }
 
+bool VideoStreamEncoder::WantsFrame(int64_t time_us) {
+  if (!drop_next_captured_frame_.exchange(false))
+    return true;
+  encoder_queue_.PostTask([this] {
+    RTC_DCHECK_RUN_ON(&encoder_queue_);
+    // Same bookkeeping as for a frame dropped by |frame_dropper_| in
+    // MaybeEncodeVideoFrame(), so that it sees the same input frame rate and
+    // drop pattern as if the frame had been delivered.
+    uint32_t framerate_fps = GetInputFramerateFps();
+    input_framerate_.Update(1u, clock_->TimeInMilliseconds());
+    frame_dropper_.Leak(framerate_fps);
+    if (!frame_dropper_.DropFrame()) {
+      // An encoded frame arrived after the prediction and changed the state.
+      RTC_LOG(LS_VERBOSE) << "Frame dropped before capture was not predicted "
+                             "to be dropped anymore.";
+    }
+    // The size of the skipped frame is unknown, so update it all.
+    if (last_frame_info_) {
+      accumulated_update_rect_ = VideoFrame::UpdateRect{
+          0, 0, last_frame_info_->width, last_frame_info_->height};
+    }
+    PredictNextFrameDrop();
+  });
+  OnDroppedFrame(
+      EncodedImageCallback::DropReason::kDroppedByMediaOptimizations);
+  return false;
+}
+
 bool VideoStreamEncoder::EncoderPaused() const {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   // Pause video if paused by caller or as long as the network is down or the
@@ -1329,6 +1367,19 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
 
   pending_frame_.reset();
 
+  // A pipelining encoder that is already busy with as many frames as it takes
+  // would only queue this one, adding latency, so drop it instead.
+  if (encoder_info_.max_frames_in_flight > 0 &&
+      frames_in_flight_.FramesInFlight(clock_->TimeInMilliseconds()) >=
+          encoder_info_.max_frames_in_flight) {
+    RTC_LOG(LS_VERBOSE) << "Drop Frame: " << encoder_info_.max_frames_in_flight
+                        << " frames in flight.";
+    encoder_stats_observer_->OnFrameDropped(
+        VideoStreamEncoderObserver::DropReason::kEncoderQueue);
+    accumulated_update_rect_.Union(video_frame.update_rect());
+    return;
+  }
+
   frame_dropper_.Leak(framerate_fps);
   // Frame dropping is enabled iff frame dropping is not force-disabled, and
   // rate controller is not trusted.
@@ -1347,10 +1398,28 @@ void VideoStreamEncoder::MaybeEncodeVideoFrame(const VideoFrame& video_frame,
     OnDroppedFrame(
         EncodedImageCallback::DropReason::kDroppedByMediaOptimizations);
     accumulated_update_rect_.Union(video_frame.update_rect());
+    PredictNextFrameDrop();
     return;
   }
 
   EncodeVideoFrame(video_frame, time_when_posted_us);
+  PredictNextFrameDrop();
+}
+
+void VideoStreamEncoder::PredictNextFrameDrop() {
+  // Other drops depend on the next frame itself or on how long it waits to be
+  // encoded, and are left to MaybeEncodeVideoFrame().
+  bool drop = false;
+  if (predictive_frame_drop_enabled_ && !force_disable_frame_dropper_ &&
+      !encoder_info_.has_trusted_rate_controller && !HasInternalSource() &&
+      !pending_encoder_reconfiguration_ && !EncoderPaused() &&
+      initial_framedrop_ >= kMaxInitialFramedrop) {
+    // Run the next Leak() and DropFrame() on a copy, at the current rate.
+    FrameDropper frame_dropper = frame_dropper_;
+    frame_dropper.Leak(GetInputFramerateFps());
+    drop = frame_dropper.DropFrame();
+  }
+  drop_next_captured_frame_.store(drop);
 }
 
 void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
@@ -1370,6 +1439,8 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   if (info.implementation_name != encoder_info_.implementation_name) {
     encoder_stats_observer_->OnEncoderImplementationChanged(
         info.implementation_name);
+    // What was learned about the previous implementation does not apply.
+    encoder_utilization_history_.Clear();
     if (bitrate_adjuster_) {
       // Encoder implementation changed, reset overshoot detector states.
       bitrate_adjuster_->Reset();
@@ -1393,6 +1464,8 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
       out_frame.video_frame_buffer()->type();
   const bool is_buffer_type_supported =
       buffer_type == VideoFrameBuffer::Type::kI420 ||
+      (buffer_type == VideoFrameBuffer::Type::kNV12 &&
+       info.supports_nv12_input) ||
       (buffer_type == VideoFrameBuffer::Type::kNative &&
        info.supports_native_handle);
 
@@ -1424,30 +1497,54 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   if ((crop_width_ > 0 || crop_height_ > 0) &&
       out_frame.video_frame_buffer()->type() !=
           VideoFrameBuffer::Type::kNative) {
-    // If the frame can't be converted to I420, drop it.
-    auto i420_buffer = video_frame.video_frame_buffer()->ToI420();
-    if (!i420_buffer) {
-      RTC_LOG(LS_ERROR) << "Frame conversion for crop failed, dropping frame.";
-      return;
-    }
     int cropped_width = video_frame.width() - crop_width_;
     int cropped_height = video_frame.height() - crop_height_;
-    rtc::scoped_refptr<I420Buffer> cropped_buffer =
-        I420Buffer::Create(cropped_width, cropped_height);
     // TODO(ilnik): Remove scaling if cropping is too big, as it should never
     // happen after SinkWants signaled correctly from ReconfigureEncoder.
+    const bool crop_only = crop_width_ < 4 && crop_height_ < 4;
+    rtc::scoped_refptr<VideoFrameBuffer> cropped_buffer;
+    if (out_frame.video_frame_buffer()->type() ==
+        VideoFrameBuffer::Type::kNV12) {
+      // The encoder takes NV12, so crop and scale without converting.
+      const NV12BufferInterface* nv12_buffer =
+          out_frame.video_frame_buffer()->GetNV12();
+      rtc::scoped_refptr<NV12Buffer> cropped_nv12_buffer =
+          NV12Buffer::Create(cropped_width, cropped_height);
+      if (crop_only) {
+        cropped_nv12_buffer->CropAndScaleFrom(*nv12_buffer, crop_width_ / 2,
+                                              crop_height_ / 2, cropped_width,
+                                              cropped_height);
+      } else {
+        cropped_nv12_buffer->ScaleFrom(*nv12_buffer);
+      }
+      cropped_buffer = cropped_nv12_buffer;
+    } else {
+      // If the frame can't be converted to I420, drop it.
+      auto i420_buffer = out_frame.video_frame_buffer()->ToI420();
+      if (!i420_buffer) {
+        RTC_LOG(LS_ERROR)
+            << "Frame conversion for crop failed, dropping frame.";
+        return;
+      }
+      rtc::scoped_refptr<I420Buffer> cropped_i420_buffer =
+          I420Buffer::Create(cropped_width, cropped_height);
+      if (crop_only) {
+        cropped_i420_buffer->CropAndScaleFrom(*i420_buffer, crop_width_ / 2,
+                                              crop_height_ / 2, cropped_width,
+                                              cropped_height);
+      } else {
+        cropped_i420_buffer->ScaleFrom(*i420_buffer);
+      }
+      cropped_buffer = cropped_i420_buffer;
+    }
     VideoFrame::UpdateRect update_rect = video_frame.update_rect();
-    if (crop_width_ < 4 && crop_height_ < 4) {
-      cropped_buffer->CropAndScaleFrom(*i420_buffer, crop_width_ / 2,
-                                       crop_height_ / 2, cropped_width,
-                                       cropped_height);
+    if (crop_only) {
       update_rect.offset_x -= crop_width_ / 2;
       update_rect.offset_y -= crop_height_ / 2;
       update_rect.Intersect(
           VideoFrame::UpdateRect{0, 0, cropped_width, cropped_height});
 
     } else {
-      cropped_buffer->ScaleFrom(*i420_buffer);
       if (!update_rect.IsEmpty()) {
         // Since we can't reason about pixels after scaling, we invalidate whole
         // picture, if anything changed.
@@ -1493,9 +1590,16 @@ void VideoStreamEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
                out_frame.timestamp());
 
   frame_encode_metadata_writer_.OnEncodeStarted(out_frame);
+  // Started before Encode(), which may deliver the frame before returning.
+  if (encoder_info_.max_frames_in_flight > 0) {
+    frames_in_flight_.OnEncodeStarted(out_frame.timestamp(),
+                                      clock_->TimeInMilliseconds());
+  }
 
   const int32_t encode_status = encoder_->Encode(out_frame, &next_frame_types_);
   was_encode_called_since_last_initialization_ = true;
+  if (encode_status < 0 || encode_status == WEBRTC_VIDEO_CODEC_NO_OUTPUT)
+    frames_in_flight_.OnEncodeRejected(out_frame.timestamp());
 
   if (encode_status < 0) {
     if (encode_status == WEBRTC_VIDEO_CODEC_ENCODER_FAILURE) {
@@ -1578,6 +1682,7 @@ EncodedImageCallback::Result VideoStreamEncoder::OnEncodedImage(
     const RTPFragmentationHeader* fragmentation) {
   TRACE_EVENT_INSTANT1("webrtc", "VCMEncodedFrameCallback::Encoded",
                        "timestamp", encoded_image.Timestamp());
+  frames_in_flight_.OnEncodeFinished(encoded_image.Timestamp());
   const size_t spatial_idx = encoded_image.SpatialIndex().value_or(0);
   EncodedImage image_copy(encoded_image);
 
@@ -1711,6 +1816,7 @@ void VideoStreamEncoder::OnDroppedFrame(DropReason reason) {
       });
       break;
     case DropReason::kDroppedByEncoder:
+      frames_in_flight_.OnFrameDropped();
       encoder_stats_observer_->OnFrameDropped(
           VideoStreamEncoderObserver::DropReason::kEncoder);
       encoder_queue_.PostTask([this] {
@@ -40,7 +40,9 @@
 #include "rtc_base/task_queue.h"
 #include "system_wrappers/include/clock.h"
 #include "video/encoder_bitrate_adjuster.h"
+#include "video/encoder_utilization_history.h"
 #include "video/frame_encode_metadata_writer.h"
+#include "video/frames_in_flight_tracker.h"
 #include "video/overuse_frame_detector.h"
 
 namespace webrtc {
@@ -148,12 +150,16 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   // Implements VideoSinkInterface.
   void OnFrame(const VideoFrame& video_frame) override;
   void OnDiscardedFrame() override;
+  bool WantsFrame(int64_t time_us) override;
 
   void MaybeEncodeVideoFrame(const VideoFrame& frame,
                              int64_t time_when_posted_in_ms);
 
   void EncodeVideoFrame(const VideoFrame& frame,
                         int64_t time_when_posted_in_ms);
+  // Sets |drop_next_captured_frame_| to whether |frame_dropper_| would drop
+  // the next frame, if nothing but the frame dropper stands in its way.
+  void PredictNextFrameDrop() RTC_RUN_ON(&encoder_queue_);
   // Indicates wether frame should be dropped because the pixel count is too
   // large for the current bitrate configuration.
   bool DropDueToSize(uint32_t pixel_count) const RTC_RUN_ON(&encoder_queue_);
@@ -360,9 +366,17 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
   // OnEncodedImage(), which is only called by one thread but not necessarily
   // the worker thread.
   std::atomic<int> pending_frame_drops_;
+  // Set on |encoder_queue_| when |frame_dropper_| is predicted to drop the
+  // next frame, and cleared by WantsFrame() on the capture thread when it
+  // drops that frame before it is converted and delivered.
+  const bool predictive_frame_drop_enabled_;
+  std::atomic<bool> drop_next_captured_frame_;
 
   std::unique_ptr<EncoderBitrateAdjuster> bitrate_adjuster_
       RTC_GUARDED_BY(&encoder_queue_);
+  // Outlives |bitrate_adjuster_| across reconfigurations.
+  EncoderUtilizationHistory encoder_utilization_history_
+      RTC_GUARDED_BY(&encoder_queue_);
 
   // TODO(sprang): Change actually support keyframe per simulcast stream, or
   // turn this into a simple bool |pending_keyframe_request_|.
@@ -370,6 +384,10 @@ class VideoStreamEncoder : public VideoStreamEncoderInterface,
 
   FrameEncodeMetadataWriter frame_encode_metadata_writer_;
 
+  // Frames given to a pipelining encoder and not yet returned, see
+  // VideoEncoder::EncoderInfo::max_frames_in_flight.
+  FramesInFlightTracker frames_in_flight_;
+
   // Experiment groups parsed from field trials for realtime video ([0]) and
   // screenshare ([1]). 0 means no group specified. Positive values are
   // experiment group numbers incremented by 1.
@@ -683,6 +683,7 @@ class VideoStreamEncoderTest : public ::testing::Test {
               VideoEncoder::ScalingSettings(1, 2, kMinPixelsPerFrame);
         }
         info.is_hardware_accelerated = is_hardware_accelerated_;
+        info.max_frames_in_flight = max_frames_in_flight_;
         for (int i = 0; i < kMaxSpatialLayers; ++i) {
           if (temporal_layers_supported_[i]) {
             int num_layers = temporal_layers_supported_[i].value() ? 2 : 1;
@@ -721,6 +722,18 @@ class VideoStreamEncoderTest : public ::testing::Test {
       is_hardware_accelerated_ = is_hardware_accelerated;
     }
 
+    void SetMaxFramesInFlight(int max_frames_in_flight) {
+      rtc::CritScope lock(&local_crit_sect_);
+      max_frames_in_flight_ = max_frames_in_flight;
+    }
+
+    // While set, frames are taken but not encoded, as if they were still in
+    // the pipeline of a hardware encoder.
+    void SetHoldFrames(bool hold_frames) {
+      rtc::CritScope lock(&local_crit_sect_);
+      hold_frames_ = hold_frames;
+    }
+
     void SetTemporalLayersSupported(size_t spatial_idx, bool supported) {
       RTC_DCHECK_LT(spatial_idx, kMaxSpatialLayers);
       rtc::CritScope lock(&local_crit_sect_);
@@ -805,6 +818,8 @@ class VideoStreamEncoderTest : public ::testing::Test {
       bool block_encode;
       {
         rtc::CritScope lock(&local_crit_sect_);
+        if (hold_frames_)
+          return WEBRTC_VIDEO_CODEC_OK;
         if (expect_null_frame_) {
           EXPECT_EQ(input_image.timestamp(), 0u);
           EXPECT_EQ(input_image.width(), 1);
@@ -898,6 +913,8 @@ class VideoStreamEncoderTest : public ::testing::Test {
     int last_input_height_ RTC_GUARDED_BY(local_crit_sect_) = 0;
     bool quality_scaling_ RTC_GUARDED_BY(local_crit_sect_) = true;
     bool is_hardware_accelerated_ RTC_GUARDED_BY(local_crit_sect_) = false;
+    int max_frames_in_flight_ RTC_GUARDED_BY(local_crit_sect_) = 0;
+    bool hold_frames_ RTC_GUARDED_BY(local_crit_sect_) = false;
     std::unique_ptr<Vp8FrameBufferController> frame_buffer_controller_
         RTC_GUARDED_BY(local_crit_sect_);
     absl::optional<bool>
@@ -1166,6 +1183,34 @@ TEST_F(VideoStreamEncoderTest, DropsFramesWhenRateSetToZero) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, DropsFramesWhilePipelinedEncoderIsFull) {
+  video_stream_encoder_->OnBitrateUpdated(
+      DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),
+      DataRate::bps(kTargetBitrateBps), 0, 0);
+  fake_encoder_.SetMaxFramesInFlight(2);
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  WaitForEncodedFrame(1);
+
+  fake_encoder_.SetHoldFrames(true);
+  for (int64_t ntp_time_ms = 2; ntp_time_ms <= 4; ++ntp_time_ms) {
+    video_source_.IncomingCapturedFrame(CreateFrame(ntp_time_ms, nullptr));
+    video_stream_encoder_->WaitUntilTaskQueueIsIdle();
+  }
+  EXPECT_EQ(1u, stats_proxy_->GetStats().frames_dropped_by_encoder_queue);
+
+  // Output for the third frame finishes the second one as well.
+  fake_encoder_.SetHoldFrames(false);
+  EncodedImage image;
+  image.SetTimestamp(3 * 90);
+  image.capture_time_ms_ = 3;
+  fake_encoder_.InjectEncodedImage(image);
+  EXPECT_TRUE(sink_.WaitForFrame(kDefaultTimeoutMs));
+  video_source_.IncomingCapturedFrame(CreateFrame(5, nullptr));
+  WaitForEncodedFrame(5);
+  EXPECT_EQ(1u, stats_proxy_->GetStats().frames_dropped_by_encoder_queue);
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, DropsFramesWithSameOrOldNtpTimestamp) {
   video_stream_encoder_->OnBitrateUpdated(
       DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),
@@ -4454,6 +4499,83 @@ TEST_F(VideoStreamEncoderTest, DropsFramesWhenEncoderOvershoots) {
   video_stream_encoder_->Stop();
 }
 
+TEST_F(VideoStreamEncoderTest, SourceSkipsFramesThatWouldBeDropped) {
+  // Asks the sink before forwarding a frame, like AdaptedVideoTrackSource.
+  class PredictingFrameForwarder : public test::FrameForwarder {
+   public:
+    void IncomingCapturedFrame(const VideoFrame& video_frame) override {
+      {
+        rtc::CritScope cs(&crit_);
+        if (sink_ && !sink_->WantsFrame(video_frame.timestamp_us())) {
+          ++num_skipped_;
+          return;
+        }
+      }
+      test::FrameForwarder::IncomingCapturedFrame(video_frame);
+    }
+
+    int num_skipped() const {
+      rtc::CritScope cs(&crit_);
+      return num_skipped_;
+    }
+
+   private:
+    int num_skipped_ RTC_GUARDED_BY(crit_) = 0;
+  };
+
+  const int kFrameWidth = 320;
+  const int kFrameHeight = 240;
+  const int kFps = 30;
+  const int kTargetBitrateBps = 120000;
+  const int kNumFramesInRun = kFps * 5;
+
+  PredictingFrameForwarder source;
+  video_stream_encoder_->SetSource(
+      &source, webrtc::DegradationPreference::MAINTAIN_FRAMERATE);
+  video_stream_encoder_->OnBitrateUpdated(
+      DataRate::bps(kTargetBitrateBps), DataRate::bps(kTargetBitrateBps),
+      DataRate::bps(kTargetBitrateBps), 0, 0);
+
+  int64_t timestamp_ms = fake_clock_.TimeNanos() / rtc::kNumNanosecsPerMillisec;
+  max_framerate_ = kFps;
+
+  // Warm up the frame dropper without overshoot.
+  fake_encoder_.SimulateOvershoot(1.0);
+  for (int i = 0; i < kNumFramesInRun; ++i) {
+    source.IncomingCapturedFrame(
+        CreateFrame(timestamp_ms, kFrameWidth, kFrameHeight));
+    TimedWaitForEncodedFrame(timestamp_ms, 2 * 1000 / kFps);
+    timestamp_ms += 1000 / kFps;
+  }
+  EXPECT_EQ(0, source.num_skipped());
+
+  double overshoot_factor = 2.0;
+  if (RateControlSettings::ParseFromFieldTrials().UseEncoderBitrateAdjuster()) {
+    overshoot_factor *= 2;
+  }
+  fake_encoder_.SimulateOvershoot(overshoot_factor);
+  video_stream_encoder_->OnBitrateUpdated(
+      DataRate::bps(kTargetBitrateBps + 1000),
+      DataRate::bps(kTargetBitrateBps + 1000),
+      DataRate::bps(kTargetBitrateBps + 1000), 0, 0);
+  int num_dropped = 0;
+  for (int i = 0; i < kNumFramesInRun; ++i) {
+    source.IncomingCapturedFrame(
+        CreateFrame(timestamp_ms, kFrameWidth, kFrameHeight));
+    if (!TimedWaitForEncodedFrame(timestamp_ms, 2 * 1000 / kFps)) {
+      ++num_dropped;
+    }
+    timestamp_ms += 1000 / kFps;
+  }
+
+  // Some drops are predicted, so those frames never reach the encoder queue,
+  // while the overall drop rate stays as without prediction.
+  EXPECT_GT(source.num_skipped(), 0);
+  EXPECT_NEAR(num_dropped, kNumFramesInRun / 2, 5 * kNumFramesInRun / 100);
+
+  video_stream_encoder_->Stop();
+}
+
 TEST_F(VideoStreamEncoderTest, ConfiguresCorrectFrameRate) {
   const int kFrameWidth = 320;
   const int kFrameHeight = 240;